@@ -0,0 +1,355 @@
+/**
+ * ChaosDrive - chaos effects shared by both front ends
+ *
+ * Included by the front end's backend translation unit, see chaos_core.h.
+ */
+
+#include "chaos_core.h"
+#include "chaos_backend.h"
+
+/* ======================================================================== */
+/* VDP                                                                      */
+/* ======================================================================== */
+
+void chaos_core_corrupt_vram_one_byte(void *ctx)
+{
+    uint32_t addr = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 0x10000);
+    uint8_t old_val = chaos_be_vram_read(ctx, addr);
+    uint8_t new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256);
+
+    chaos_be_vram_write(ctx, addr, new_val);
+    chaos_be_vram_done(ctx, addr, 1);
+    CHAOS_BE_LOG(ctx, VRAM_BYTE, addr, old_val, new_val);
+}
+
+void chaos_core_scroll_register_fuzzing(void *ctx)
+{
+    /* VDP registers 0-3, the scroll-related ones */
+    int r = chaos_be_rand_below(ctx, CHAOS_STREAM_VDP, 4);
+    int fuzz_amount = chaos_be_rand_below(ctx, CHAOS_STREAM_VDP, 21) - 10;
+    uint8_t old_val = chaos_be_vdp_reg_read(ctx, r);
+    uint8_t new_val = (uint8_t)(old_val + fuzz_amount);
+
+    chaos_be_vdp_reg_write(ctx, r, new_val);
+    CHAOS_BE_LOG(ctx, VDP_REG, r, old_val, new_val);
+}
+
+void chaos_core_sprite_attribute_scramble(void *ctx)
+{
+    /* Sprite attribute table base address from VDP register 5 */
+    uint8_t reg5 = chaos_be_vdp_reg_read(ctx, 5);
+    uint32_t sprite_table_base = (reg5 & 0x7F) << 9;
+    int max_sprites = 80;
+    int sprite_entry_size = 8;
+    int active_sprites[80];
+    int active_sprite_count;
+    int i, effects_to_apply, effect_num;
+
+    active_sprite_count = chaos_be_sprites(ctx, active_sprites);
+    if (active_sprite_count == 0)
+    {
+        for (i = 0; i < 5; i++)
+            active_sprites[i] = i;
+        active_sprite_count = 5;
+    }
+
+    effects_to_apply = (active_sprite_count < 10) ? active_sprite_count : chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 10) + 1;
+
+    for (effect_num = 0; effect_num < effects_to_apply; effect_num++)
+    {
+        int sprite_index = active_sprites[chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, active_sprite_count)];
+        uint32_t sprite_addr = sprite_table_base + (sprite_index * sprite_entry_size);
+        int scramble_type = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 10);
+        int pos, byte_offset;
+
+        switch (scramble_type)
+        {
+        case 0: /* Scramble Y position */
+            CHAOS_BE_LOG(ctx, SPRITE_Y, sprite_addr, 0, sprite_index);
+            pos = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 1024) - 256;
+            chaos_be_vram_write(ctx, sprite_addr + 0, (pos >> 8) & 0xFF);
+            chaos_be_vram_write(ctx, sprite_addr + 1, pos & 0xFF);
+            break;
+        case 1: /* Scramble sprite size + link */
+            CHAOS_BE_LOG(ctx, SPRITE_SIZE, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 2, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 3, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            break;
+        case 2: /* Scramble tile pattern */
+            CHAOS_BE_LOG(ctx, SPRITE_PATTERN, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 4, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 5, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            break;
+        case 3: /* Scramble X position */
+            CHAOS_BE_LOG(ctx, SPRITE_X, sprite_addr, 0, sprite_index);
+            pos = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 1024) - 256;
+            chaos_be_vram_write(ctx, sprite_addr + 6, (pos >> 8) & 0xFF);
+            chaos_be_vram_write(ctx, sprite_addr + 7, pos & 0xFF);
+            break;
+        case 4: /* Swap with another sprite */
+            if (active_sprite_count > 1)
+            {
+                int sprite2_index = active_sprites[chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, active_sprite_count)];
+                uint32_t sprite2_addr = sprite_table_base + (sprite2_index * sprite_entry_size);
+                uint8_t tmp;
+
+                CHAOS_BE_LOG(ctx, SPRITE_SWAP, sprite_addr, sprite_index, sprite2_index);
+                for (byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
+                {
+                    tmp = chaos_be_vram_read(ctx, sprite_addr + byte_offset);
+                    chaos_be_vram_write(ctx, sprite_addr + byte_offset, chaos_be_vram_read(ctx, sprite2_addr + byte_offset));
+                    chaos_be_vram_write(ctx, sprite2_addr + byte_offset, tmp);
+                }
+            }
+            break;
+        case 5: /* Completely randomize */
+            CHAOS_BE_LOG(ctx, SPRITE_RANDOM, sprite_addr, 0, sprite_index);
+            for (byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
+                chaos_be_vram_write(ctx, sprite_addr + byte_offset, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            break;
+        case 6: /* Ghost sprite (position = 0) */
+            CHAOS_BE_LOG(ctx, SPRITE_GHOST, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 0, 0);
+            chaos_be_vram_write(ctx, sprite_addr + 1, 0);
+            chaos_be_vram_write(ctx, sprite_addr + 6, 0);
+            chaos_be_vram_write(ctx, sprite_addr + 7, 0);
+            break;
+        case 7: /* Giant sprite */
+            CHAOS_BE_LOG(ctx, SPRITE_GIANT, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 2, 0xFF);
+            chaos_be_vram_write(ctx, sprite_addr + 0, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 1, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 6, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 7, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            break;
+        case 8: /* Break sprite chains */
+            CHAOS_BE_LOG(ctx, SPRITE_LINK, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 3, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            chaos_be_vram_write(ctx, sprite_addr + 2, chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 256));
+            break;
+        case 9: /* Stretchy sprite */
+        {
+            unsigned short weird_pattern = chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 0xFFFF);
+
+            CHAOS_BE_LOG(ctx, SPRITE_STRETCH, sprite_addr, 0, sprite_index);
+            chaos_be_vram_write(ctx, sprite_addr + 4, (weird_pattern >> 8) & 0xFF);
+            chaos_be_vram_write(ctx, sprite_addr + 5, weird_pattern & 0xFF);
+            chaos_be_vram_write(ctx, sprite_addr + 2, 0xFF);
+            break;
+        }
+        }
+    }
+
+    /* Only the SAT was touched */
+    chaos_be_vram_done(ctx, sprite_table_base, max_sprites * sprite_entry_size);
+
+    /* Occasionally scramble the sprite table base register */
+    if (chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 10) == 0)
+    {
+        uint8_t new_val = (reg5 & 0x80) | chaos_be_rand_below(ctx, CHAOS_STREAM_VRAM, 128);
+
+        chaos_be_vdp_reg_write(ctx, 5, new_val);
+        CHAOS_BE_LOG(ctx, SPRITE_BASE, 5, reg5, new_val);
+    }
+}
+
+/* ======================================================================== */
+/* 68k RAM                                                                  */
+/* ======================================================================== */
+
+/* RAM effects aim at the variables found by the backend once there are this many */
+#define RANKED_MIN 8
+
+/* Offset of a ranked variable, biased towards the best ones */
+static uint32_t pick_ranked(void *ctx, int count)
+{
+    int i = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, count);
+    return chaos_be_ram_candidate(ctx, chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, i + 1));
+}
+
+void chaos_core_corrupt_68k_ram_one_byte(void *ctx)
+{
+    uint32_t offset = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 0x10000);
+    uint8_t old_val = chaos_be_ram_read(ctx, offset);
+    uint8_t new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 256);
+
+    chaos_be_ram_write(ctx, offset, new_val);
+    CHAOS_BE_LOG(ctx, RAM_BYTE, CHAOS_RAM_BASE + offset, old_val, new_val);
+}
+
+void chaos_core_critical_ram_scramble(void *ctx)
+{
+    int i;
+    int ranked = chaos_be_ram_ranked(ctx);
+    uint32_t offset;
+    uint8_t old_val, new_val;
+
+    /* Corrupt random bytes in upper 32KB of RAM (likely stack space) */
+    for (i = 0; i < 32; i++)
+    {
+        offset = 0x8000 + chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 0x8000);
+        old_val = chaos_be_ram_read(ctx, offset);
+        new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 256);
+        chaos_be_ram_write(ctx, offset, new_val);
+        CHAOS_BE_LOG(ctx, RAM_CRITICAL, CHAOS_RAM_BASE + offset, old_val, new_val);
+    }
+
+    /* Also corrupt some game variables, or bytes at the beginning of RAM
+       until they are known */
+    for (i = 0; i < 16; i++)
+    {
+        offset = (ranked >= RANKED_MIN) ? pick_ranked(ctx, ranked) : (uint32_t)chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 0x1000);
+        old_val = chaos_be_ram_read(ctx, offset);
+        new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 256);
+        chaos_be_ram_write(ctx, offset, new_val);
+        CHAOS_BE_LOG(ctx, RAM_CRITICAL, CHAOS_RAM_BASE + offset, old_val, new_val);
+    }
+}
+
+static uint8_t mutate_variable(void *ctx, uint8_t value)
+{
+    switch (chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 6))
+    {
+    case 0: /* Flip all bits */
+        return ~value;
+    case 1: /* Common "bad" values */
+    {
+        static const uint8_t bad_values[] = {0xFF, 0x80, 0x7F, 0x01, 0x00};
+        return bad_values[chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 5)];
+    }
+    case 2: /* Increment, can overflow */
+        return value + chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 32) + 1;
+    case 3:
+        return value * 2;
+    case 4: /* Set a random bit */
+        return value | (1 << chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 8));
+    case 5: /* Clear a random bit */
+        return value & ~(1 << chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 8));
+    default:
+        return ~value;
+    }
+}
+
+/* Same treatment as below, on the ranked variables only */
+static void flip_ranked_variables(void *ctx, int ranked)
+{
+    int i, count = 16 + chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 16);
+
+    for (i = 0; i < count; i++)
+    {
+        uint32_t offset = pick_ranked(ctx, ranked);
+        uint8_t value = chaos_be_ram_read(ctx, offset);
+        uint8_t new_val;
+
+        if (value <= 0x01)
+            new_val = value ? 0x00 : 0xFF;
+        else if ((value <= 99) && chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 2))
+            new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 2) ? 0 : 255;
+        else
+            new_val = mutate_variable(ctx, value);
+        chaos_be_ram_write(ctx, offset, new_val);
+        CHAOS_BE_LOG(ctx, RAM_LOGIC, CHAOS_RAM_BASE + offset, value, new_val);
+    }
+}
+
+void chaos_core_flip_game_logic_variables(void *ctx)
+{
+    /* Common variable locations used by Genesis games */
+    static const struct
+    {
+        uint32_t base;
+        uint32_t range;
+    } targets[] = {
+        {0x0000, 0x400},  /* system variables and counters */
+        {0x0400, 0x400},  /* early game state */
+        {0x0800, 0x800},  /* player state and inventory */
+        {0x1000, 0x800},  /* level/world state */
+        {0x1800, 0x600},  /* enemy/object state arrays */
+        {0x2000, 0x800},  /* mid-RAM game logic */
+        {0x3000, 0x1000}, /* buffers and temporaries */
+        {0x8000, 0x1000}, /* high RAM game state */
+        {0xC000, 0x2000}, /* critical game variables */
+        {0xF000, 0x800}}; /* scores, lives, status */
+    int num_targets = sizeof(targets) / sizeof(targets[0]);
+    int area, i, hunt;
+    int ranked = chaos_be_ram_ranked(ctx);
+    uint32_t offset;
+    uint8_t value, new_val;
+
+    if (ranked >= RANKED_MIN)
+    {
+        flip_ranked_variables(ctx, ranked);
+        return;
+    }
+
+    for (area = 0; area < num_targets; area++)
+    {
+        int corruptions_in_area = 3 + chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 6);
+
+        for (i = 0; i < corruptions_in_area; i++)
+        {
+            offset = targets[area].base + chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, targets[area].range);
+            value = chaos_be_ram_read(ctx, offset);
+
+            /* Probably unused */
+            if (value == 0x00 || value == 0xFF)
+                continue;
+
+            new_val = mutate_variable(ctx, value);
+            chaos_be_ram_write(ctx, offset, new_val);
+            CHAOS_BE_LOG(ctx, RAM_LOGIC, CHAOS_RAM_BASE + offset, value, new_val);
+        }
+    }
+
+    /* Hunt for counter-like values (1-99) and set them to 0 or max */
+    for (hunt = 0; hunt < 20; hunt++)
+    {
+        offset = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 0x8000);
+        value = chaos_be_ram_read(ctx, offset);
+        if (value >= 1 && value <= 99)
+        {
+            new_val = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 2) ? 0 : 255;
+            chaos_be_ram_write(ctx, offset, new_val);
+            CHAOS_BE_LOG(ctx, RAM_COUNTER, CHAOS_RAM_BASE + offset, value, new_val);
+        }
+    }
+
+    /* Hunt for boolean-like flags, flip and amplify them */
+    for (hunt = 0; hunt < 30; hunt++)
+    {
+        offset = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 0x8000);
+        value = chaos_be_ram_read(ctx, offset);
+        if (value == 0x00 || value == 0x01)
+        {
+            new_val = value ? 0x00 : 0xFF;
+            chaos_be_ram_write(ctx, offset, new_val);
+            CHAOS_BE_LOG(ctx, RAM_FLAG, CHAOS_RAM_BASE + offset, value, new_val);
+        }
+    }
+}
+
+/* ======================================================================== */
+/* 68k registers                                                            */
+/* ======================================================================== */
+
+void chaos_core_program_counter_increment(void *ctx)
+{
+    uint32_t pc = chaos_be_cpu_reg_read(ctx, CHAOS_CPU_PC);
+    uint32_t increment = (chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 4) + 1) * 2; /* 2-8 bytes, even */
+
+    chaos_be_cpu_reg_write(ctx, CHAOS_CPU_PC, pc + increment);
+    CHAOS_BE_LOG(ctx, M68K_PC, 0, pc, pc + increment);
+}
+
+void chaos_core_random_register_corruption(void *ctx)
+{
+    int reg_type = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 2); /* 0 = data, 1 = address */
+    int reg_index = chaos_be_rand_below(ctx, CHAOS_STREAM_CPU, 8);
+    int r = (reg_type ? CHAOS_CPU_A0 : CHAOS_CPU_D0) + reg_index;
+    uint32_t old_val = chaos_be_cpu_reg_read(ctx, r);
+    uint32_t new_val = chaos_be_rand32(ctx, CHAOS_STREAM_CPU);
+
+    chaos_be_cpu_reg_write(ctx, r, new_val);
+    /* Numbered D0-D7 then A0-A7, as in the debugger */
+    CHAOS_BE_LOG(ctx, M68K_REG, r, old_val, new_val);
+}
@@ -0,0 +1,77 @@
+#ifndef _CHAOS_CORE_H_
+#define _CHAOS_CORE_H_
+
+#include <stdint.h>
+
+/* Chaos effects shared by the DGen and Genesis Plus GX front ends.
+ *
+ * The effects below only touch the emulator through the accessors of a
+ * chaos_backend.h that each front end provides (the one found first on its
+ * include path), as functions or macros:
+ *
+ *   int chaos_be_rand_below(void *ctx, enum chaos_stream s, int n)
+ *       0 to n - 1
+ *   uint32_t chaos_be_rand32(void *ctx, enum chaos_stream s)
+ *
+ *   uint8_t chaos_be_ram_read(void *ctx, uint32_t offset)
+ *   void chaos_be_ram_write(void *ctx, uint32_t offset, uint8_t val)
+ *       68k work RAM, offset 0x0000-0xffff in the backend's byte order
+ *   int chaos_be_ram_ranked(void *ctx)
+ *   uint32_t chaos_be_ram_candidate(void *ctx, int i)
+ *       offsets of the likely game variables found so far, best first
+ *       (0 when the backend does not look for them)
+ *
+ *   uint8_t chaos_be_vram_read(void *ctx, uint32_t addr)
+ *   void chaos_be_vram_write(void *ctx, uint32_t addr, uint8_t val)
+ *   void chaos_be_vram_done(void *ctx, uint32_t addr, uint32_t len)
+ *       after a block of writes, for caches derived from VRAM
+ *   int chaos_be_sprites(void *ctx, int *list)
+ *       indices of the sprites worth scrambling (80 at most), or 0
+ *   uint8_t chaos_be_vdp_reg_read(void *ctx, int r)
+ *   void chaos_be_vdp_reg_write(void *ctx, int r, uint8_t val)
+ *
+ *   uint32_t chaos_be_cpu_reg_read(void *ctx, int r)
+ *   void chaos_be_cpu_reg_write(void *ctx, int r, uint32_t val)
+ *       68k registers, see CHAOS_CPU_* below
+ *
+ *   CHAOS_BE_LOG(ctx, id, addr, old_val, new_val)
+ *       a macro, id is an effect name of DGen's chaoslog.h without its
+ *       CHAOS_ prefix
+ *
+ * ctx is whatever the front end passes to the effect. chaos_core.c is not
+ * built on its own: each front end includes it from its backend translation
+ * unit (chaos_backend.c, chaos_backend.cpp) so the accessors get inlined,
+ * and compiles it as C or C++ accordingly.
+ */
+
+/* Random number streams, the backend maps them to its own generator */
+enum chaos_stream
+{
+    CHAOS_STREAM_VRAM, /* VRAM, sprite table */
+    CHAOS_STREAM_VDP,  /* VDP registers */
+    CHAOS_STREAM_CPU   /* 68k RAM & registers */
+};
+
+/* 68k registers for chaos_be_cpu_reg_*(): D0-D7, A0-A7, then PC */
+#define CHAOS_CPU_D0 0
+#define CHAOS_CPU_A0 8
+#define CHAOS_CPU_PC 16
+
+/* 68k address of work RAM offset 0, for logging */
+#define CHAOS_RAM_BASE 0xFF0000
+
+/* VDP */
+void chaos_core_corrupt_vram_one_byte(void *ctx);
+void chaos_core_scroll_register_fuzzing(void *ctx);
+void chaos_core_sprite_attribute_scramble(void *ctx);
+
+/* 68k RAM */
+void chaos_core_corrupt_68k_ram_one_byte(void *ctx);
+void chaos_core_critical_ram_scramble(void *ctx);
+void chaos_core_flip_game_logic_variables(void *ctx);
+
+/* 68k registers */
+void chaos_core_program_counter_increment(void *ctx);
+void chaos_core_random_register_corruption(void *ctx);
+
+#endif /* _CHAOS_CORE_H_ */
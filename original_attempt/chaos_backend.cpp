@@ -0,0 +1,4 @@
+// DGen/SDL 1.17+
+// Shared chaos effects, built against chaos_backend.h
+
+#include "chaos_core.c"
@@ -0,0 +1,146 @@
+// DGen/SDL 1.17+
+// DGen accessors for the shared chaos effects (../chaos/chaos_core.h).
+//
+// The effects are called with the md_vdp they apply to. VRAM goes through
+// poke_vram() for the dirty flags, RAM and CPU registers through the md it
+// belongs to, and changes are recorded in the chaos log.
+
+#ifndef __CHAOS_BACKEND_H__
+#define __CHAOS_BACKEND_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "md.h"
+#include "system.h"
+#include "chaoslog.h"
+#include "chaos_core.h"
+
+// Friend of md_vdp.
+struct chaos_backend
+{
+	static md_vdp &vdp(void *ctx)
+	{
+		return *static_cast<md_vdp *>(ctx);
+	}
+
+	static md &megad(void *ctx)
+	{
+		return vdp(ctx).belongs;
+	}
+
+	static void vram_write(void *ctx, uint32_t addr, uint8_t val)
+	{
+		vdp(ctx).poke_vram(addr, val);
+	}
+
+	static void vram_done(void *ctx, uint32_t addr, uint32_t len)
+	{
+		vdp(ctx).vram_dirty(addr, len);
+	}
+
+	// Sprites the renderer found by following the link chain, see
+	// draw_scanline().
+	static int sprites(void *ctx, int *list)
+	{
+		md_vdp &v = vdp(ctx);
+		int n;
+
+		for (n = 0; ((n < v.sprite_count) && (n < 80)); ++n)
+			list[n] = v.sprite_order[n];
+		return n;
+	}
+
+	static uint32_t *cpu_reg(md &m, int r)
+	{
+		if (r == CHAOS_CPU_PC)
+			return &m.m68k_state.pc;
+		if (r >= CHAOS_CPU_A0)
+			return &m.m68k_state.a[(r - CHAOS_CPU_A0)];
+		return &m.m68k_state.d[r];
+	}
+};
+
+// The streams are all the same to rand().
+static inline int chaos_be_rand_below(void *, enum chaos_stream, int n)
+{
+	return (rand() % n);
+}
+
+static inline uint32_t chaos_be_rand32(void *, enum chaos_stream)
+{
+	return rand();
+}
+
+static inline uint8_t chaos_be_ram_read(void *ctx, uint32_t offset)
+{
+	return chaos_backend::megad(ctx).misc_readbyte(0xff0000 + offset);
+}
+
+static inline void chaos_be_ram_write(void *ctx, uint32_t offset, uint8_t val)
+{
+	chaos_backend::megad(ctx).misc_writebyte((0xff0000 + offset), val);
+}
+
+// Game variables are not looked for.
+static inline int chaos_be_ram_ranked(void *)
+{
+	return 0;
+}
+
+static inline uint32_t chaos_be_ram_candidate(void *, int)
+{
+	return 0;
+}
+
+static inline uint8_t chaos_be_vram_read(void *ctx, uint32_t addr)
+{
+	return chaos_backend::vdp(ctx).vram[(addr & 0xffff)];
+}
+
+static inline void chaos_be_vram_write(void *ctx, uint32_t addr, uint8_t val)
+{
+	chaos_backend::vram_write(ctx, addr, val);
+}
+
+static inline void chaos_be_vram_done(void *ctx, uint32_t addr, uint32_t len)
+{
+	chaos_backend::vram_done(ctx, addr, len);
+}
+
+static inline int chaos_be_sprites(void *ctx, int *list)
+{
+	return chaos_backend::sprites(ctx, list);
+}
+
+static inline uint8_t chaos_be_vdp_reg_read(void *ctx, int r)
+{
+	return chaos_backend::vdp(ctx).reg[r];
+}
+
+static inline void chaos_be_vdp_reg_write(void *ctx, int r, uint8_t val)
+{
+	chaos_backend::vdp(ctx).write_reg(r, val);
+}
+
+static inline uint32_t chaos_be_cpu_reg_read(void *ctx, int r)
+{
+	md &m = chaos_backend::megad(ctx);
+
+	m.m68k_state_dump();
+	return le2h32(*chaos_backend::cpu_reg(m, r));
+}
+
+static inline void chaos_be_cpu_reg_write(void *ctx, int r, uint32_t val)
+{
+	md &m = chaos_backend::megad(ctx);
+
+	m.m68k_state_dump();
+	*chaos_backend::cpu_reg(m, r) = h2le32(val);
+	m.m68k_state_restore();
+}
+
+#define CHAOS_BE_LOG(ctx, id, addr, old_val, new_val) \
+	chaos_log(CHAOS_##id, (addr), (old_val), (new_val))
+
+#endif // __CHAOS_BACKEND_H__
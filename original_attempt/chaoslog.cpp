@@ -0,0 +1,305 @@
+// DGen/SDL 1.17+
+// Chaos event log
+//
+// Chaos effects record what they change with chaos_log() instead of
+// printing it, which used to make emulation speed depend on the terminal
+// (holding a key can trigger thousands of changes per second).
+//
+// Events go to a fixed-size ring with a single writer (the emulation side)
+// and a single reader (chaos_log_poll(), called once per frame by the front
+// end), that neither locks nor allocates. The reader describes the latest
+// event for displaying and, when str_chaos_log is set, hands all of them
+// over to a separate thread that appends them to that file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef WITH_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
+#include "chaoslog.h"
+#include "rc-vars.h"
+#include "system.h"
+
+// Number of events kept in the ring and in each file buffer, power of 2.
+#define CHAOS_LOG_SIZE 4096
+
+#ifdef WITH_THREADS
+typedef std::atomic<unsigned int> chaos_log_index;
+#define CHAOS_LOAD(var, order) (var).load(std::memory_order_##order)
+#define CHAOS_STORE(var, val, order) \
+	(var).store((val), std::memory_order_##order)
+#else
+typedef unsigned int chaos_log_index;
+#define CHAOS_LOAD(var, order) (var)
+#define CHAOS_STORE(var, val, order) ((var) = (val))
+#endif
+
+static const struct
+{
+	const char *name;
+	bool show;
+} chaos_effects[CHAOS_EFFECT_NUM] = {
+#define CHAOS_EFFECT_DESC(id, desc, show) {desc, show},
+	CHAOS_EFFECTS(CHAOS_EFFECT_DESC)
+#undef CHAOS_EFFECT_DESC
+};
+
+static struct
+{
+	struct chaos_event ring[CHAOS_LOG_SIZE];
+	chaos_log_index head;	 // next event to write, chaos_log() only
+	chaos_log_index tail;	 // next event to read, chaos_log_poll() only
+	chaos_log_index frame;	 // written by chaos_log_poll()
+	chaos_log_index dropped; // events lost because the ring was full
+	unsigned int dropped_seen; // "dropped" value already counted in "lost"
+	// File output, events are collected into "fill" while "out" is written.
+	FILE *file;
+	char *name; // str_chaos_log value the file was opened for
+	struct chaos_event *fill;
+	struct chaos_event *out;
+	unsigned int fill_len;
+	unsigned int out_len;
+	unsigned long lost; // events that didn't fit into "fill"
+#ifdef WITH_THREADS
+	std::mutex lock;
+	std::condition_variable wake; // busy or quit is set
+	std::condition_variable idle; // busy is cleared
+	std::thread thread;
+	bool busy; // thread owns "out"
+	bool quit;
+#endif
+} cl;
+
+void chaos_log(enum chaos_effect effect, uint32_t addr,
+			   uint32_t old_val, uint32_t new_val)
+{
+	unsigned int head = CHAOS_LOAD(cl.head, relaxed);
+	struct chaos_event *ev;
+
+	if ((head - CHAOS_LOAD(cl.tail, acquire)) == CHAOS_LOG_SIZE)
+	{
+		CHAOS_STORE(cl.dropped, (CHAOS_LOAD(cl.dropped, relaxed) + 1),
+					relaxed);
+		return;
+	}
+	ev = &cl.ring[(head & (CHAOS_LOG_SIZE - 1))];
+	ev->frame = CHAOS_LOAD(cl.frame, relaxed);
+	ev->effect = effect;
+	ev->addr = addr;
+	ev->old_val = old_val;
+	ev->new_val = new_val;
+	CHAOS_STORE(cl.head, (head + 1), release);
+}
+
+const char *chaos_log_name(enum chaos_effect effect)
+{
+	if ((unsigned int)effect >= CHAOS_EFFECT_NUM)
+		return "unknown effect";
+	return chaos_effects[effect].name;
+}
+
+static void chaos_log_write(FILE *file, const struct chaos_event *ev,
+							unsigned int len)
+{
+	unsigned int i;
+
+	for (i = 0; (i != len); ++i)
+		fprintf(file, "%u %s 0x%06x 0x%x 0x%x\n",
+				ev[i].frame,
+				chaos_log_name((enum chaos_effect)ev[i].effect),
+				ev[i].addr, ev[i].old_val, ev[i].new_val);
+	fflush(file);
+}
+
+#ifdef WITH_THREADS
+
+static void chaos_log_thread()
+{
+	std::unique_lock<std::mutex> hold(cl.lock);
+
+	while (cl.wake.wait(hold, []
+						{ return (cl.busy || cl.quit); }),
+		   cl.busy)
+	{
+		hold.unlock();
+		chaos_log_write(cl.file, cl.out, cl.out_len);
+		hold.lock();
+		cl.busy = false;
+		cl.idle.notify_all();
+	}
+}
+
+#endif // WITH_THREADS
+
+// Write what was collected so far, from the thread if possible.
+static void chaos_log_flush(bool wait)
+{
+	struct chaos_event *tmp;
+
+#ifdef WITH_THREADS
+	if (cl.thread.joinable())
+	{
+		std::unique_lock<std::mutex> hold(cl.lock);
+
+		if (wait)
+			cl.idle.wait(hold, []
+						 { return (!cl.busy); });
+		// Try again next frame if the thread is still writing.
+		if ((cl.busy) || (cl.fill_len == 0))
+			return;
+		tmp = cl.out;
+		cl.out = cl.fill;
+		cl.fill = tmp;
+		cl.out_len = cl.fill_len;
+		cl.fill_len = 0;
+		cl.busy = true;
+		cl.wake.notify_one();
+		if (!wait)
+			return;
+		cl.idle.wait(hold, []
+					 { return (!cl.busy); });
+		return;
+	}
+#endif
+	(void)tmp;
+	(void)wait;
+	chaos_log_write(cl.file, cl.fill, cl.fill_len);
+	cl.fill_len = 0;
+}
+
+static void chaos_log_close()
+{
+	if (cl.file == NULL)
+		return;
+	chaos_log_flush(true);
+#ifdef WITH_THREADS
+	if (cl.thread.joinable())
+	{
+		cl.lock.lock();
+		cl.quit = true;
+		cl.lock.unlock();
+		cl.wake.notify_one();
+		cl.thread.join();
+		cl.quit = false;
+	}
+#endif
+	if (cl.lost)
+		fprintf(cl.file, "%lu events lost\n", cl.lost);
+	fclose(cl.file);
+	cl.file = NULL;
+	free(cl.fill);
+	free(cl.out);
+	cl.fill = NULL;
+	cl.out = NULL;
+	cl.fill_len = 0;
+	cl.lost = 0;
+}
+
+static void chaos_log_cleanup()
+{
+	chaos_log_close();
+	free(cl.name);
+	cl.name = NULL;
+}
+
+// Follow str_chaos_log changes. An empty value disables file output.
+static void chaos_log_open()
+{
+	static bool registered;
+	const char *name = dgen_chaos_log.val;
+
+	if (name == NULL)
+		name = "";
+	if ((cl.name != NULL) && (!strcmp(cl.name, name)))
+		return;
+	chaos_log_close();
+	free(cl.name);
+	// Remember it even when opening fails, so it's not retried every frame.
+	cl.name = strdup(name);
+	if ((cl.name == NULL) || (*name == '\0'))
+		return;
+	if ((!registered) && (atexit(chaos_log_cleanup) != 0))
+		return;
+	registered = true;
+	cl.fill = (struct chaos_event *)malloc(sizeof(*cl.fill) *
+										   CHAOS_LOG_SIZE);
+	cl.out = (struct chaos_event *)malloc(sizeof(*cl.out) *
+										  CHAOS_LOG_SIZE);
+	if ((cl.fill == NULL) || (cl.out == NULL) ||
+		((cl.file = dgen_fopen(NULL, name, (DGEN_APPEND | DGEN_TEXT))) ==
+		 NULL))
+	{
+		fprintf(stderr, "chaoslog: cannot open `%s'.\n", name);
+		free(cl.fill);
+		free(cl.out);
+		cl.fill = NULL;
+		cl.out = NULL;
+		return;
+	}
+#ifdef WITH_THREADS
+	try
+	{
+		cl.thread = std::thread(chaos_log_thread);
+	}
+	catch (const std::system_error &)
+	{
+		// chaos_log_flush() then writes the file directly.
+	}
+#endif
+}
+
+bool chaos_log_poll(char *msg, size_t size)
+{
+	unsigned int head = CHAOS_LOAD(cl.head, acquire);
+	unsigned int tail = CHAOS_LOAD(cl.tail, relaxed);
+	unsigned int dropped = CHAOS_LOAD(cl.dropped, relaxed);
+	unsigned int shown = 0;
+	struct chaos_event last;
+
+	chaos_log_open();
+	for (; (tail != head); ++tail)
+	{
+		const struct chaos_event *ev =
+			&cl.ring[(tail & (CHAOS_LOG_SIZE - 1))];
+
+		if (cl.file != NULL)
+		{
+			if (cl.fill_len != CHAOS_LOG_SIZE)
+				cl.fill[(cl.fill_len++)] = *ev;
+			else
+				++cl.lost;
+		}
+		if ((ev->effect < CHAOS_EFFECT_NUM) &&
+			(chaos_effects[ev->effect].show))
+		{
+			last = *ev;
+			++shown;
+		}
+	}
+	CHAOS_STORE(cl.tail, tail, release);
+	if (cl.file != NULL)
+		cl.lost += (dropped - cl.dropped_seen);
+	cl.dropped_seen = dropped;
+	CHAOS_STORE(cl.frame, (CHAOS_LOAD(cl.frame, relaxed) + 1), relaxed);
+	if (cl.fill_len != 0)
+		chaos_log_flush(false);
+	if ((shown == 0) || (!dgen_chaos_log_show))
+		return false;
+	if (shown == 1)
+		snprintf(msg, size, "%s at 0x%x: 0x%x -> 0x%x",
+				 chaos_log_name((enum chaos_effect)last.effect),
+				 last.addr, last.old_val, last.new_val);
+	else
+		snprintf(msg, size, "%s at 0x%x: 0x%x -> 0x%x (%u changes)",
+				 chaos_log_name((enum chaos_effect)last.effect),
+				 last.addr, last.old_val, last.new_val, shown);
+	return true;
+}
@@ -0,0 +1,85 @@
+// DGen/SDL 1.17+
+// Chaos event log, see chaoslog.cpp
+
+#ifndef __CHAOSLOG_H__
+#define __CHAOSLOG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Effects that can be logged: identifier, description, and whether it is
+// worth displaying (continuous effects would flood the screen otherwise).
+#define CHAOS_EFFECTS(X) \
+	X(VRAM_SHIFT_UP, "VRAM shifted up", 1) \
+	X(VRAM_SHIFT_DOWN, "VRAM shifted down", 1) \
+	X(VRAM_SHIFT_LEFT, "VRAM shifted left", 1) \
+	X(VRAM_SHIFT_RIGHT, "VRAM shifted right", 1) \
+	X(VRAM_INVERT, "VRAM inverted", 1) \
+	X(VRAM_BYTE, "VRAM byte corrupted", 1) \
+	X(CRAM_RANDOMIZE, "CRAM randomized", 1) \
+	X(CRAM_SHIFT_UP, "CRAM shifted up", 1) \
+	X(CRAM_CORRUPTION, "CRAM corruption", 1) \
+	X(CRAM_BYTE, "CRAM byte corrupted", 0) \
+	X(SPRITE_Y, "sprite Y scrambled", 1) \
+	X(SPRITE_SIZE, "sprite size scrambled", 1) \
+	X(SPRITE_PATTERN, "sprite pattern scrambled", 1) \
+	X(SPRITE_X, "sprite X scrambled", 1) \
+	X(SPRITE_SWAP, "sprites swapped", 1) \
+	X(SPRITE_RANDOM, "sprite randomized", 1) \
+	X(SPRITE_GHOST, "ghost sprite", 1) \
+	X(SPRITE_GIANT, "giant sprite", 1) \
+	X(SPRITE_LINK, "sprite chain broken", 1) \
+	X(SPRITE_STRETCH, "stretchy sprite", 1) \
+	X(SPRITE_BASE, "sprite table moved", 1) \
+	X(VDP_REG, "VDP register fuzzed", 1) \
+	X(RAM_BYTE, "68k RAM byte corrupted", 1) \
+	X(RAM_CRITICAL, "critical 68k RAM corrupted", 1) \
+	X(RAM_LOGIC, "game variable flipped", 1) \
+	X(RAM_COUNTER, "counter-like value changed", 1) \
+	X(RAM_FLAG, "boolean-like flag flipped", 1) \
+	X(M68K_PC, "68k PC moved", 1) \
+	X(M68K_REG, "68k register corrupted", 1) \
+	X(Z80_SHIFT_UP, "audio memory shifted up", 1) \
+	X(Z80_SHIFT_DOWN, "audio memory shifted down", 1) \
+	X(Z80_RAM, "audio memory corrupted", 1) \
+	X(Z80_BITCRUSH, "audio memory bitcrushed", 1) \
+	X(FM_REG, "YM2612 register corrupted", 1) \
+	X(FM_DETUNE, "YM2612 channel detuned", 1) \
+	X(FM_CORRUPTION, "FM corruption", 1) \
+	X(PSG_REG, "PSG register corrupted", 1) \
+	X(DAC_DATA, "DAC sample corrupted", 1) \
+	X(DAC_LEN, "DAC length changed", 1) \
+	X(DAC_ENABLE, "DAC toggled", 1)
+
+enum chaos_effect
+{
+#define CHAOS_EFFECT_ENUM(id, desc, show) CHAOS_##id,
+	CHAOS_EFFECTS(CHAOS_EFFECT_ENUM)
+#undef CHAOS_EFFECT_ENUM
+	CHAOS_EFFECT_NUM
+};
+
+// One logged change. When an effect does not modify a single location,
+// addr, old_val and new_val describe its parameters instead.
+struct chaos_event
+{
+	uint32_t frame;		// chaos_log_poll() calls so far
+	uint32_t effect;	// enum chaos_effect
+	uint32_t addr;
+	uint32_t old_val;
+	uint32_t new_val;
+};
+
+// Record an event. Never blocks, events are dropped when the log is full.
+void chaos_log(enum chaos_effect effect, uint32_t addr,
+			   uint32_t old_val, uint32_t new_val);
+
+// Description of an effect.
+const char *chaos_log_name(enum chaos_effect effect);
+
+// Call once per frame from the front end. Takes pending events out of the
+// log, passes them on to str_chaos_log if set, and describes the latest one
+// worth displaying into msg. Returns false when msg was not filled.
+bool chaos_log_poll(char *msg, size_t size);
+
+#endif // __CHAOSLOG_H__
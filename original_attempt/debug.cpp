@@ -252,6 +252,10 @@ void md::debug_init()
 	memset(debug_wp_m68k, 0, sizeof(debug_wp_m68k));
 	memset(debug_bp_z80, 0, sizeof(debug_bp_z80));
 	memset(debug_wp_z80, 0, sizeof(debug_wp_z80));
+	debug_update_bp_map_m68k();
+	debug_update_bp_map_z80();
+	debug_update_wp_pages_m68k();
+	debug_update_wp_pages_z80();
 
 #ifndef NO_COMPLETION
 	linenoiseSetCompletionCallback(completion);
@@ -266,6 +270,10 @@ void md::debug_init()
 	debug_m68k_instr_count = 0;
 	debug_z80_instr_count = 0;
 	debug_instr_count_enabled = false;
+	debug_tracebuf = NULL;
+	debug_tracebuf_next = 0;
+	debug_tracebuf_len = 0;
+	debug_tracebuf_on = false;
 
 #ifdef WITH_DZ80
 	memset(&disz80, 0, sizeof(disz80));
@@ -536,6 +544,9 @@ bool md::debug_m68k_check_bps()
 		}
 		goto trace;
 	}
+	if (!(debug_bp_m68k_map[((pc >> 1) & (BP_MAP_BITS - 1)) / 32] &
+	      (1u << ((pc >> 1) % 32))))
+		goto trace;
 	for (i = 0; (i < MAX_BREAKPOINTS); i++) {
 		if (!(debug_bp_m68k[i].flags & BP_FLAG_USED))
 			break; // no bps after first disabled one
@@ -546,6 +557,7 @@ bool md::debug_m68k_check_bps()
 			}
 			debug_bp_m68k[i].flags |= BP_FLAG_FIRED;
 			printf("m68k breakpoint hit @ 0x%08x\n", pc);
+			fflush(stdout);
 			debug_enter();
 			bp = true;
 			break;
@@ -553,14 +565,68 @@ bool md::debug_m68k_check_bps()
 	}
 trace:
 	if (debug_trace_m68k) {
-		if (!bp)
+		if (debug_tracebuf_on)
+			debug_m68k_trace_record(pc);
+		else if (!bp)
 			debug_print_m68k_disassemble(pc, 1);
 		--debug_trace_m68k;
 	}
-	fflush(stdout);
 	return bp;
 }
 
+/**
+ * Append the instruction at "pc" to the trace buffer.
+ *
+ * Registers are compared to those of the previous record, whatever changed
+ * is credited to the instruction it describes.
+ *
+ * @param pc Current PC, m68k_state is up to date.
+ */
+void md::debug_m68k_trace_record(uint32_t pc)
+{
+	const m68k_state_t *prev = &debug_tracebuf_regs;
+	struct dgen_trace *t;
+	unsigned int i;
+
+	if (debug_tracebuf_len) {
+		t = &debug_tracebuf[((debug_tracebuf_next - 1) &
+				     (DEBUG_TRACE_RECORDS - 1))];
+		for (i = 0; (i != 16); ++i) {
+			uint32_t old = ((i < 8) ? prev->d[i] : prev->a[i - 8]);
+			uint32_t cur = ((i < 8) ? m68k_state.d[i] :
+					m68k_state.a[i - 8]);
+
+			if (old == cur)
+				continue;
+			if (t->reg != TRACE_REG_NONE) {
+				t->more = 1;
+				break;
+			}
+			t->reg = i;
+			t->value = le2h32(cur);
+		}
+		if ((prev->sr != m68k_state.sr) && (t->more == 0)) {
+			if (t->reg != TRACE_REG_NONE)
+				t->more = 1;
+			else {
+				t->reg = TRACE_REG_SR;
+				t->value = le2h16(m68k_state.sr);
+			}
+		}
+	}
+	debug_tracebuf_regs = m68k_state;
+	t = &debug_tracebuf[debug_tracebuf_next];
+	t->pc = pc;
+	t->cycle = m68k_odo();
+	t->opcode = misc_readword(pc);
+	t->reg = TRACE_REG_NONE;
+	t->more = 0;
+	debug_tracebuf_next = ((debug_tracebuf_next + 1) &
+			       (DEBUG_TRACE_RECORDS - 1));
+	if (debug_tracebuf_len != DEBUG_TRACE_RECORDS)
+		++debug_tracebuf_len;
+}
+
 /**
  * Watchpoint handler fired after every M68K instruction.
  */
@@ -569,6 +635,15 @@ bool md::debug_m68k_check_wps()
 	unsigned int i;
 	bool wp = false;
 
+	// Memory can only have changed if a watched page has been written to,
+	// see debug_update_wp_pages_m68k() for the exceptions.
+	if ((!debug_wp_m68k_hit) && (!debug_wp_m68k_always)
+#ifdef WITH_STAR
+	    && (!((debug_wp_m68k_ram) && (cpu_emu == CPU_EMU_STAR)))
+#endif
+	    )
+		return false;
+	debug_wp_m68k_hit = false;
 	for (i = 0; (i < MAX_WATCHPOINTS); i++) {
 		if (!(debug_wp_m68k[i].flags & BP_FLAG_USED))
 			break; // no wps after first disabled one
@@ -602,6 +677,8 @@ bool md::debug_z80_check_bps()
 		}
 		goto trace;
 	}
+	if (!(debug_bp_z80_map[pc / 32] & (1u << (pc % 32))))
+		goto trace;
 	for (i = 0; (i < MAX_BREAKPOINTS); i++) {
 		if (!(debug_bp_z80[i].flags & BP_FLAG_USED))
 			break; // no bps after first disabled one
@@ -635,6 +712,10 @@ bool md::debug_z80_check_wps()
 	unsigned int i;
 	bool wp = false;
 
+	// Same as debug_m68k_check_wps().
+	if ((!debug_wp_z80_hit) && (!debug_wp_z80_always))
+		return false;
+	debug_wp_z80_hit = false;
 	for (i = 0; (i < MAX_WATCHPOINTS); i++) {
 		if (!(debug_wp_z80[i].flags & BP_FLAG_USED))
 			break;
@@ -677,6 +758,7 @@ void md::debug_rm_bp_m68k(int index)
 		debug_bp_m68k[MAX_BREAKPOINTS - 1].addr = 0;
 		debug_bp_m68k[MAX_BREAKPOINTS - 1].flags = 0;
 	}
+	debug_update_bp_map_m68k();
 }
 
 /**
@@ -703,6 +785,7 @@ void md::debug_rm_bp_z80(int index)
 		debug_bp_z80[MAX_BREAKPOINTS - 1].addr = 0;
 		debug_bp_z80[MAX_BREAKPOINTS - 1].flags = 0;
 	}
+	debug_update_bp_map_z80();
 }
 
 /**
@@ -727,11 +810,12 @@ void md::debug_rm_wp_m68k(int index)
 	} else {
 		memmove(&(debug_wp_m68k[index]),
 		    &(debug_wp_m68k[index+1]),
-		    sizeof(struct dgen_bp) * (MAX_WATCHPOINTS - index - 1));
+		    sizeof(struct dgen_wp) * (MAX_WATCHPOINTS - index - 1));
 		// disable last slot
 		debug_wp_m68k[MAX_WATCHPOINTS - 1].start_addr = 0;
 		debug_wp_m68k[MAX_WATCHPOINTS - 1].flags = 0;
 	}
+	debug_update_wp_pages_m68k();
 }
 
 /**
@@ -754,11 +838,12 @@ void md::debug_rm_wp_z80(int index)
 	else {
 		memmove(&debug_wp_z80[index],
 			&debug_wp_z80[index + 1],
-			(sizeof(struct dgen_bp) *
+			(sizeof(struct dgen_wp) *
 			 (MAX_WATCHPOINTS - index - 1)));
 		debug_wp_z80[MAX_WATCHPOINTS - 1].start_addr = 0;
 		debug_wp_z80[MAX_WATCHPOINTS - 1].flags = 0;
 	}
+	debug_update_wp_pages_z80();
 }
 
 /**
@@ -859,6 +944,7 @@ int md::debug_set_bp_m68k(uint32_t addr)
 
 	debug_bp_m68k[slot].addr = addr;
 	debug_bp_m68k[slot].flags = BP_FLAG_USED;
+	debug_update_bp_map_m68k();
 	printf("m68k breakpoint #%d set @ 0x%08x\n", slot, addr);
 out:
 	fflush(stdout);
@@ -886,12 +972,148 @@ int md::debug_set_bp_z80(uint16_t addr)
 	}
 	debug_bp_z80[slot].addr = addr;
 	debug_bp_z80[slot].flags = BP_FLAG_USED;
+	debug_update_bp_map_z80();
 	printf("z80 breakpoint #%d set @ 0x%04x\n", slot, addr);
 out:
 	fflush(stdout);
 	return 1;
 }
 
+/**
+ * Rebuild the map of M68K breakpoints from debug_bp_m68k[].
+ */
+void md::debug_update_bp_map_m68k()
+{
+	unsigned int i;
+
+	memset(debug_bp_m68k_map, 0, sizeof(debug_bp_m68k_map));
+	for (i = 0; (i < MAX_BREAKPOINTS); ++i) {
+		uint32_t bit;
+
+		if (!(debug_bp_m68k[i].flags & BP_FLAG_USED))
+			break;
+		bit = ((debug_bp_m68k[i].addr >> 1) & (BP_MAP_BITS - 1));
+		debug_bp_m68k_map[bit / 32] |= (1u << (bit % 32));
+	}
+}
+
+/**
+ * Rebuild the map of Z80 breakpoints from debug_bp_z80[].
+ */
+void md::debug_update_bp_map_z80()
+{
+	unsigned int i;
+
+	memset(debug_bp_z80_map, 0, sizeof(debug_bp_z80_map));
+	for (i = 0; (i < MAX_BREAKPOINTS); ++i) {
+		uint32_t bit;
+
+		if (!(debug_bp_z80[i].flags & BP_FLAG_USED))
+			break;
+		bit = (debug_bp_z80[i].addr & 0xffff);
+		debug_bp_z80_map[bit / 32] |= (1u << (bit % 32));
+	}
+}
+
+/**
+ * Rebuild the pages watched by debug_wp_m68k[].
+ *
+ * Only ROM/save RAM and RAM are tracked, they can't change without going
+ * through misc_writebyte(). Watchpoints elsewhere (Z80, I/O, VDP) are
+ * checked after every instruction, as are those in RAM with StarScream
+ * which doesn't call misc_writebyte() for it.
+ */
+void md::debug_update_wp_pages_m68k()
+{
+	unsigned int i;
+
+	memset(debug_wp_m68k_pages, 0, sizeof(debug_wp_m68k_pages));
+	debug_wp_m68k_hit = false;
+	debug_wp_m68k_always = false;
+	debug_wp_m68k_ram = false;
+	for (i = 0; (i < MAX_WATCHPOINTS); ++i) {
+		uint32_t start = (debug_wp_m68k[i].start_addr & 0xffffff);
+		uint32_t end = (debug_wp_m68k[i].end_addr & 0xffffff);
+		uint32_t page;
+
+		if (!(debug_wp_m68k[i].flags & WP_FLAG_USED))
+			break;
+		if ((debug_wp_m68k[i].start_addr > 0xffffff) ||
+		    (debug_wp_m68k[i].end_addr > 0xffffff) ||
+		    (start > end) ||
+		    ((start <= 0xdfffff) && (end > 0x7fffff))) {
+			debug_wp_m68k_always = true;
+			continue;
+		}
+		if (end >= 0xe00000) {
+			// RAM mirrors, see debug_wp_m68k_write().
+			debug_wp_m68k_ram = true;
+			if ((end - start) >= 0xffff) {
+				start = 0xff0000;
+				end = 0xffffff;
+			}
+			else {
+				start |= 0xff0000;
+				end |= 0xff0000;
+				if (end < start) {
+					// Wraps around.
+					start = 0xff0000;
+					end = 0xffffff;
+				}
+			}
+		}
+		for (page = (start >> WP_PAGE_SHIFT);
+		     (page <= (end >> WP_PAGE_SHIFT));
+		     ++page)
+			debug_wp_m68k_pages[page / 32] |= (1u << (page % 32));
+	}
+}
+
+/**
+ * Rebuild the pages watched by debug_wp_z80[].
+ *
+ * Only Z80 RAM is tracked, other areas (YM2612, the M68K bank) can change
+ * without going through z80_write() and are checked after every
+ * instruction.
+ */
+void md::debug_update_wp_pages_z80()
+{
+	unsigned int i;
+
+	memset(debug_wp_z80_pages, 0, sizeof(debug_wp_z80_pages));
+	debug_wp_z80_hit = false;
+	debug_wp_z80_always = false;
+	for (i = 0; (i < MAX_WATCHPOINTS); ++i) {
+		uint32_t start = debug_wp_z80[i].start_addr;
+		uint32_t end = debug_wp_z80[i].end_addr;
+		uint32_t page;
+
+		if (!(debug_wp_z80[i].flags & WP_FLAG_USED))
+			break;
+		if ((start > end) || (end > 0x3fff)) {
+			debug_wp_z80_always = true;
+			continue;
+		}
+		// RAM mirrors, see debug_wp_z80_write().
+		if ((end - start) >= 0x1fff) {
+			start = 0x0000;
+			end = 0x1fff;
+		}
+		else {
+			start &= 0x1fff;
+			end &= 0x1fff;
+			if (end < start) {
+				start = 0x0000;
+				end = 0x1fff;
+			}
+		}
+		for (page = (start >> WP_PAGE_SHIFT);
+		     (page <= (end >> WP_PAGE_SHIFT));
+		     ++page)
+			debug_wp_z80_pages[page / 32] |= (1u << (page % 32));
+	}
+}
+
 /**
  * Convert a core name to a context ID.
  *
@@ -958,10 +1180,12 @@ void md::debug_set_wp_m68k(uint32_t start_addr, uint32_t end_addr)
 	debug_wp_m68k[slot].bytes = (unsigned char *) malloc(end_addr - start_addr + 1);
 	if (debug_wp_m68k[slot].bytes == NULL) {
 		perror("malloc");
+		debug_wp_m68k[slot].flags = 0;
 		goto out;
 	}
 
 	debug_update_m68k_wp_cache(&(debug_wp_m68k[slot]));
+	debug_update_wp_pages_m68k();
 
 	printf("m68k watchpoint #%d set @ 0x%08x-0x%08x (%u bytes)\n",
 	    slot, start_addr, end_addr, end_addr - start_addr + 1);
@@ -1027,9 +1251,11 @@ void md::debug_set_wp_z80(uint16_t start_addr, uint16_t end_addr)
 		(unsigned char *)malloc(end_addr - start_addr + 1);
 	if (debug_wp_z80[slot].bytes == NULL) {
 		perror("malloc");
+		debug_wp_z80[slot].flags = 0;
 		goto out;
 	}
 	debug_update_z80_wp_cache(&(debug_wp_z80[slot]));
+	debug_update_wp_pages_z80();
 	printf("z80 watchpoint #%d set @ 0x%04x-0x%04x (%u bytes)\n",
 	       slot, start_addr, end_addr, (end_addr - start_addr + 1));
 out:
@@ -1571,6 +1797,9 @@ int md::debug_cmd_help(int n_args, char **args)
 	    "\ts/step\t\t\tstep one instruction\n"
 	    "\ts/step <num>\t\tstep 'num' instructions\n"
 	    "\tt/trace [bool|num]\ttoggle instructions tracing\n"
+	    "\ttb/tracebuf [bool]\ttrace m68k to the trace buffer\n"
+	    "\ttd/tracedump <num>\tdisasm the last 'num' traced instrs\n"
+	    "\ttd/tracedump\t\tdisasm the last %u traced instrs\n"
 	    "\t-w/-watch <#num/addr>\tremove watchpoint for current cpu\n"
 	    "\tw/watch <addr> <len>\tset multi-byte watchpoint for current cpu\n"
 	    "\tw/watch <addr>\t\tset 1-byte watchpoint for current cpu\n"
@@ -1581,6 +1810,7 @@ int md::debug_cmd_help(int n_args, char **args)
 	    "\t'ym', 'fm', 'ym2612' or '%d' refers to the fm2616 sound chip\n"
 	    "\t'sn', 'sn76489', 'psg'  or '%d' refers to the sn76489 sound chip\n",
 	    DEBUG_DFLT_DASM_LEN, DEBUG_DFLT_DASM_LEN, DEBUG_DFLT_MEMDUMP_LEN,
+	    DEBUG_DFLT_TRACE_LEN,
 	    DBG_CONTEXT_M68K, DBG_CONTEXT_Z80, DBG_CONTEXT_YM2612, DBG_CONTEXT_SN76489);
 	fflush(stdout);
 	return (1);
@@ -1862,6 +2092,110 @@ out:
 	return 1;
 }
 
+/**
+ * Trace buffer toggle (tracebuf) command handler.
+ *
+ * M68K instructions traced while the buffer is enabled are recorded with
+ * their cycle and the register they changed instead of being disassembled
+ * on the spot, see tracedump. The buffer keeps the last
+ * DEBUG_TRACE_RECORDS instructions.
+ *
+ * @param n_args Number of arguments.
+ * @param args Arguments, a boolean string if any.
+ * @return Always 1.
+ */
+int md::debug_cmd_tracebuf(int n_args, char **args)
+{
+	static const char *on[] = { "true", "yes", "on", "enable" };
+	static const char *off[] = { "false", "no", "off", "disable" };
+	bool enable = !debug_tracebuf_on;
+	unsigned int i;
+
+	if (n_args == 1) {
+		for (i = 0; (i != elemof(on)); ++i)
+			if (!strcasecmp(args[0], on[i]))
+				break;
+		if (i != elemof(on))
+			enable = true;
+		else {
+			for (i = 0; (i != elemof(off)); ++i)
+				if (!strcasecmp(args[0], off[i]))
+					break;
+			if (i == elemof(off)) {
+				printf("invalid argument: %s\n", args[0]);
+				goto out;
+			}
+			enable = false;
+		}
+	}
+	if ((enable) && (debug_tracebuf == NULL)) {
+		debug_tracebuf = (struct dgen_trace *)
+			malloc(sizeof(*debug_tracebuf) * DEBUG_TRACE_RECORDS);
+		if (debug_tracebuf == NULL) {
+			perror("malloc");
+			goto out;
+		}
+	}
+	if ((enable) && (!debug_tracebuf_on)) {
+		// Start over, previous records have a gap after them.
+		debug_tracebuf_next = 0;
+		debug_tracebuf_len = 0;
+	}
+	debug_tracebuf_on = enable;
+	printf("trace buffer %s.\n", (enable ? "enabled" : "disabled"));
+out:
+	fflush(stdout);
+	return 1;
+}
+
+/**
+ * Trace buffer dump (tracedump) command handler.
+ *
+ * Disassemble the last args[0] (default DEBUG_DFLT_TRACE_LEN) recorded
+ * instructions, oldest first, with their cycle and register changes.
+ *
+ * @param n_args Number of arguments.
+ * @param args Arguments.
+ * @return Always 1.
+ */
+int md::debug_cmd_tracedump(int n_args, char **args)
+{
+	static const char *regs[] = {
+		"d0", "d1", "d2", "d3", "d4", "d5", "d6", "d7",
+		"a0", "a1", "a2", "a3", "a4", "a5", "a6", "a7", "sr"
+	};
+	uint32_t num = DEBUG_DFLT_TRACE_LEN;
+	unsigned int i;
+
+	if ((n_args == 1) && (debug_strtou32(args[0], &num) == -1)) {
+		printf("invalid argument: %s\n", args[0]);
+		goto out;
+	}
+	if (num > debug_tracebuf_len)
+		num = debug_tracebuf_len;
+	if (num == 0) {
+		printf("trace buffer is empty.\n");
+		goto out;
+	}
+	i = ((debug_tracebuf_next - num) & (DEBUG_TRACE_RECORDS - 1));
+	while (num--) {
+		const struct dgen_trace *t = &debug_tracebuf[i];
+
+		printf("%10u", t->cycle);
+		if (t->reg != TRACE_REG_NONE)
+			printf("  %s=0x%08x%s", regs[t->reg], t->value,
+			       (t->more ? " +" : ""));
+		if (misc_readword(t->pc) != t->opcode)
+			printf("  (was %04x)", t->opcode);
+		printf("\n");
+		debug_print_m68k_disassemble(t->pc, 1);
+		i = ((i + 1) & (DEBUG_TRACE_RECORDS - 1));
+	}
+out:
+	fflush(stdout);
+	return 1;
+}
+
 /**
  * Watchpoint removal (-watch) command handler.
  *
@@ -2218,6 +2552,14 @@ const struct md::dgen_debugger_cmd md::debug_cmd_list[] = {
 		{(char *) "t",		1,	&md::debug_cmd_trace},
 		{(char *) "trace",	0,	&md::debug_cmd_trace},
 		{(char *) "t",		0,	&md::debug_cmd_trace},
+		{(char *) "tracebuf",	1,	&md::debug_cmd_tracebuf},
+		{(char *) "tb",		1,	&md::debug_cmd_tracebuf},
+		{(char *) "tracebuf",	0,	&md::debug_cmd_tracebuf},
+		{(char *) "tb",		0,	&md::debug_cmd_tracebuf},
+		{(char *) "tracedump",	1,	&md::debug_cmd_tracedump},
+		{(char *) "td",		1,	&md::debug_cmd_tracedump},
+		{(char *) "tracedump",	0,	&md::debug_cmd_tracedump},
+		{(char *) "td",		0,	&md::debug_cmd_tracedump},
 		// watch points
 		{(char *) "watch",	2,	&md::debug_cmd_watch},
 		{(char *) "w",		2,	&md::debug_cmd_watch},
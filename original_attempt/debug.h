@@ -10,12 +10,24 @@
 #define MAX_BREAKPOINTS			64
 /** Maximum number of watchpoints supported. */
 #define MAX_WATCHPOINTS			64
+/** Watchpoints are tracked by pages of (1 << WP_PAGE_SHIFT) bytes. */
+#define WP_PAGE_SHIFT			8
+/** Number of M68K watchpoint pages (24-bit address space). */
+#define WP_PAGES_M68K			(0x1000000 >> WP_PAGE_SHIFT)
+/** Number of Z80 watchpoint pages (16-bit address space). */
+#define WP_PAGES_Z80			(0x10000 >> WP_PAGE_SHIFT)
+/** Number of bits in the breakpoint maps, indexed by PC. */
+#define BP_MAP_BITS			0x10000
 /** Maximum number of tokens on the debugger command line. */
 #define MAX_DEBUG_TOKS			8
 /** Default number of instructions to disassemble. */
 #define DEBUG_DFLT_DASM_LEN		16
 /** Default number of bytes to display while dumping memory. */
 #define DEBUG_DFLT_MEMDUMP_LEN		128
+/** Number of records in the M68K trace buffer (power of two). */
+#define DEBUG_TRACE_RECORDS		0x40000
+/** Default number of trace records to dump. */
+#define DEBUG_DFLT_TRACE_LEN		64
 
 #define DBG_CONTEXT_M68K		0
 #define DBG_CONTEXT_Z80			1
@@ -40,6 +52,18 @@ struct dgen_wp {
 	unsigned char	*bytes;
 };
 
+/** M68K trace buffer record, disassembled when dumped. */
+struct dgen_trace {
+	uint32_t	pc;     /**< Instruction address. */
+	uint32_t	cycle;  /**< M68K odometer before the instruction. */
+	uint32_t	value;  /**< New value of "reg". */
+	uint16_t	opcode; /**< First word of the instruction. */
+#define TRACE_REG_NONE		0xff /**< No register changed. */
+#define TRACE_REG_SR		16   /**< 0-7: D0-D7, 8-15: A0-A7. */
+	uint8_t		reg;    /**< Register changed by the instruction. */
+	uint8_t		more;   /**< Set when others changed as well. */
+};
+
 extern "C" void		debug_show_ym2612_regs(void); // fm.c
 
 #endif
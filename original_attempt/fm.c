@@ -103,9 +103,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdarg.h>
 #include <math.h>
 #include "fm.h"
+#include "fm_core.h"
 
 
 #ifndef PI
@@ -5089,6 +5091,85 @@ int YM2612Write(int n, int a, UINT8 v)
 	return F2612->OPN.ST.irq;
 }
 
+/*
+  Write several registers at once, without going through the address ports
+  (the selected address is left alone). Phase increments and envelope rates
+  of modified channels are recomputed once at the end instead of waiting for
+  YM2612UpdateOne().
+*/
+void YM2612WriteRegs(int n, const struct ym2612_reg_write *w,
+		     unsigned int count)
+{
+	YM2612 *F2612 = &(FM2612[n]);
+	FM_OPN *OPN = &(F2612->OPN);
+	unsigned int chans = 0;
+	unsigned int i;
+	unsigned int c;
+
+	if (count == 0)
+		return;
+	YM2612UpdateReq(n);
+	for (i = 0; (i != count); ++i) {
+		unsigned int r = (w[i].reg & 0x1ff);
+		UINT8 v = w[i].val;
+
+		F2612->REGS[r] = v;
+		if ((r & 0x1f0) == 0x20) {
+			switch (r) {
+			case 0x2a:
+				F2612->dacout = ((int)v - 0x80) << 6;
+				break;
+			case 0x2b:
+				F2612->dacen = v & 0x80;
+				cur_chip = NULL;
+				break;
+			default:
+				OPNWriteMode(OPN, r, v);
+				/* 3SLOT mode may have changed. */
+				if (r == 0x27)
+					chans |= (1 << 2);
+			}
+			continue;
+		}
+		if (r < 0x30)
+			continue;
+		OPNWriteReg(OPN, r, v);
+		c = OPN_CHAN(r);
+		if (c == 3)
+			continue;
+		if (r >= 0x100)
+			c += 3;
+		chans |= (1 << c);
+		/* 0xa8-0xae: 3SLOT mode frequencies belong to channel 3. */
+		if ((r & 0x1f8) == 0xa8)
+			chans |= (1 << 2);
+	}
+	for (c = 0; (c != 6); ++c) {
+		FM_CH *CH = &(F2612->CH[c]);
+
+		if ((chans & (1 << c)) == 0)
+			continue;
+		if ((c == 2) && (OPN->ST.mode & 0xc0)) {
+			/* 3SLOT MODE, see YM2612UpdateOne(). */
+			if (CH->SLOT[SLOT1].Incr == -1) {
+				refresh_fc_eg_slot(OPN, &CH->SLOT[SLOT1],
+						   OPN->SL3.fc[1],
+						   OPN->SL3.kcode[1]);
+				refresh_fc_eg_slot(OPN, &CH->SLOT[SLOT2],
+						   OPN->SL3.fc[2],
+						   OPN->SL3.kcode[2]);
+				refresh_fc_eg_slot(OPN, &CH->SLOT[SLOT3],
+						   OPN->SL3.fc[0],
+						   OPN->SL3.kcode[0]);
+				refresh_fc_eg_slot(OPN, &CH->SLOT[SLOT4],
+						   CH->fc, CH->kcode);
+			}
+		}
+		else
+			refresh_fc_eg_chan(OPN, CH);
+	}
+}
+
 UINT8 YM2612Read(int n,int a)
 {
 	YM2612 *F2612 = &(FM2612[n]);
@@ -5159,6 +5240,47 @@ void YM2612_restore(int num, uint8_t buf[512])
 	}
 }
 
+/*
+  Native state of a chip, its whole struct prefixed with its address.
+  The struct points into itself and holds tables computed by YM2612Init(),
+  so a state can only be loaded back into the same chip at the same clock
+  and sampling rate. Use YM2612_dump() and YM2612_restore() otherwise.
+*/
+size_t YM2612_state_size(void)
+{
+	return (sizeof(YM2612 *) + sizeof(YM2612));
+}
+
+void YM2612_state_save(int num, uint8_t *buf)
+{
+	YM2612 *F2612 = &(FM2612[num]);
+
+	memcpy(buf, &F2612, sizeof(F2612));
+	memcpy(&buf[sizeof(F2612)], F2612, sizeof(*F2612));
+}
+
+int YM2612_state_load(int num, const uint8_t *buf)
+{
+	YM2612 *F2612 = &(FM2612[num]);
+	YM2612 *from;
+	int clock;
+	int rate;
+
+	/* buf is not necessarily aligned for the struct. */
+	memcpy(&from, buf, sizeof(from));
+	buf += sizeof(from);
+	memcpy(&clock, &buf[offsetof(YM2612, OPN.ST.clock)], sizeof(clock));
+	memcpy(&rate, &buf[offsetof(YM2612, OPN.ST.rate)], sizeof(rate));
+	if ((from != F2612) ||
+	    (clock != F2612->OPN.ST.clock) ||
+	    (rate != F2612->OPN.ST.rate))
+		return -1;
+	memcpy(F2612, buf, sizeof(*F2612));
+	/* Cached pointers and DAC flag, see YM2612UpdateOne(). */
+	cur_chip = NULL;
+	return 0;
+}
+
 // ---------------------------------------------------------------------------
 // Everything below this line is for the debugger.
 // It can't be in debug.c because it needs the private structs defined here
@@ -5382,7 +5504,8 @@ void debug_show_ym2612_regs()
 {
 	uint8_t			regs[512], chan;
 
-	YM2612_dump(0, regs);
+	/* from the selected core, this one may not be running */
+	fm_core_dump(0, regs);
 
 	printf("ym2612:\n");
 	debug_show_ym2612_global_regs(regs);
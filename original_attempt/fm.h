@@ -5,6 +5,7 @@
 #ifndef _H_FM_FM_
 #define _H_FM_FM_
 
+#include <stddef.h>
 #include <stdint.h>
 
 /* --- select emulation chips --- */
@@ -211,11 +212,23 @@ void YM2612UpdateOne(int num, INT16 *buffer, unsigned int length,
 		     unsigned int volume, int loud);
 
 int YM2612Write(int n, int a,unsigned char v);
+
+/* Register write for YM2612WriteRegs(), 0x100-0x1ff are on port 1. */
+struct ym2612_reg_write {
+	uint16_t reg;
+	uint8_t val;
+};
+
+void YM2612WriteRegs(int n, const struct ym2612_reg_write *w,
+		     unsigned int count);
 unsigned char YM2612Read(int n,int a);
 int YM2612TimerOver(int n, int c );
 
 void YM2612_dump(int num, uint8_t buf[512]);
 void YM2612_restore(int num, uint8_t buf[512]);
+size_t YM2612_state_size(void);
+void YM2612_state_save(int num, uint8_t *buf);
+int YM2612_state_load(int num, const uint8_t *buf);
 #endif /* BUILD_YM2612 */
 
 #if 0 //BUILD_YM2151
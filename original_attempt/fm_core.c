@@ -0,0 +1,336 @@
+/*
+  YM2612 emulator selection, see fm_core.h.
+
+  fm.c renders at the sound rate. The web tree cores render at the chip's
+  rate (clock / 144, about 53kHz) into in[], which is read back at the sound
+  rate with linear interpolation. fm.c keeps a copy of the registers for
+  YM2612_dump(), the others get one here from the writes going through.
+
+  Nuked OPN2 only takes a write on its next clocks, so each write is
+  followed by the clocks it takes (as web/src/main/c/core/sound/sound.c
+  does when it switches cores). The samples they produce are kept in in[]
+  and played first on the next update, the writes of a frame land at its
+  start like with the other cores.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fm.h"
+#include "fm_core.h"
+#include "ym3438.h"
+
+/* Samples of the chip kept in in[] (the first one already played). */
+#define NATIVE_MAX 1024
+
+/* Clocks taken by a Nuked OPN2 address or data write. */
+#define NUKED_ADDR_CLOCKS 2
+#define NUKED_DATA_CLOCKS 32
+
+/* Everything but the chip, saved with it for non-MAME cores. */
+struct fm_core_state {
+	int core;
+	uint32_t step; /* chip samples per sound sample, 16.16 */
+	uint32_t pos; /* position between in[0] and in[1], 16.16 */
+	unsigned int have; /* samples in in[] after in[0] */
+	int in[NATIVE_MAX][2];
+	uint16_t addr; /* selected register, 0x100-0x1ff on port 1 */
+	uint8_t regs[512];
+	/* Nuked OPN2 clock within the sample, and its outputs so far. */
+	unsigned int nuked_cycle;
+	int nuked_sum[2];
+};
+
+static struct fm_core_state fm;
+static ym3438_t opn2;
+
+/* One Nuked OPN2 clock, a sample to in[] every 24 (dropped if full). */
+static void nuked_clock(void)
+{
+	Bit16s accm[2];
+
+	OPN2_Clock(&opn2, accm);
+	fm.nuked_sum[0] += accm[0];
+	fm.nuked_sum[1] += accm[1];
+	if (++fm.nuked_cycle != 24)
+		return;
+	// Same level as the Genesis Plus GX core.
+	if (fm.have != (NATIVE_MAX - 1)) {
+		++fm.have;
+		fm.in[fm.have][0] = (fm.nuked_sum[0] * 11);
+		fm.in[fm.have][1] = (fm.nuked_sum[1] * 11);
+	}
+	fm.nuked_cycle = 0;
+	fm.nuked_sum[0] = 0;
+	fm.nuked_sum[1] = 0;
+}
+
+/* Make sure in[] holds samples up to in[top]. */
+static void native_fill(unsigned int top)
+{
+	if (fm.have >= top)
+		return;
+	if (fm.core == FM_CORE_GPGX) {
+		fm_gpgx_update(fm.in[(fm.have + 1)], (top - fm.have));
+		fm.have = top;
+		return;
+	}
+	while (fm.have < top)
+		nuked_clock();
+}
+
+/* Mix a sample with buffer[] like YM2612UpdateOne() does. */
+static inline int16_t mix(int s, int16_t prev, unsigned int volume, int loud)
+{
+	s += prev;
+	if (loud)
+		s = ((s * 3) >> 1);
+	if (volume != 100)
+		s = ((s * (int)volume) / 100);
+	return ((abs(s + 32767) - abs(s - 32767)) >> 1);
+}
+
+int fm_core_init(int core, int num, int clock, int rate, int mjazz)
+{
+	if (((unsigned int)core >= FM_CORE_TOTAL) ||
+	    ((core != FM_CORE_MAME) && (num != 1))) {
+		if (core != FM_CORE_MAME)
+			fprintf(stderr,
+				"fm_core: core %d unavailable%s, using mame.\n",
+				core, ((num != 1) ? " with MJazz" : ""));
+		core = FM_CORE_MAME;
+	}
+	memset(&fm, 0, sizeof(fm));
+	fm.core = core;
+	if (core == FM_CORE_MAME)
+		return YM2612Init(num, clock, rate, mjazz, NULL, NULL);
+	if ((clock <= 0) || (rate <= 0))
+		return -1;
+	fm.step = ((((uint64_t)clock) << 16) / (144 * (uint64_t)rate));
+	if (core == FM_CORE_GPGX)
+		fm_gpgx_init();
+	fm_core_reset(0);
+	return 0;
+}
+
+int fm_core_active(void)
+{
+	return fm.core;
+}
+
+void fm_core_shutdown(void)
+{
+	if (fm.core == FM_CORE_MAME)
+		YM2612Shutdown();
+}
+
+void fm_core_reset(int num)
+{
+	if (fm.core == FM_CORE_MAME) {
+		YM2612ResetChip(num);
+		return;
+	}
+	fm.pos = 0;
+	fm.have = 0;
+	memset(fm.in, 0, sizeof(fm.in[0]));
+	fm.addr = 0;
+	memset(fm.regs, 0, sizeof(fm.regs));
+	fm.nuked_cycle = 0;
+	fm.nuked_sum[0] = 0;
+	fm.nuked_sum[1] = 0;
+	if (fm.core == FM_CORE_GPGX)
+		fm_gpgx_reset();
+	else
+		OPN2_Reset(&opn2);
+}
+
+void fm_core_update(int num, int16_t *buffer, unsigned int length,
+		    unsigned int volume, int loud)
+{
+	if (fm.core == FM_CORE_MAME) {
+		YM2612UpdateOne(num, buffer, length, volume, loud);
+		return;
+	}
+	while (length) {
+		// Sound samples whose chip samples fit in in[].
+		unsigned int n = ((((NATIVE_MAX - 2) << 16) - fm.pos) / fm.step);
+		unsigned int last;
+		unsigned int end;
+		uint32_t pos = fm.pos;
+		unsigned int i;
+
+		if (n > length)
+			n = length;
+		if (n == 0)
+			n = 1;
+		last = (((pos + ((n - 1) * fm.step)) >> 16) + 1);
+		end = ((pos + (n * fm.step)) >> 16);
+		native_fill((last > end) ? last : end);
+		for (i = 0; (i != n); ++i, pos += fm.step) {
+			const int *a = fm.in[(pos >> 16)];
+			const int *b = fm.in[((pos >> 16) + 1)];
+			int64_t f = (pos & 0xffff);
+
+			buffer[0] = mix((a[0] + (int)(((b[0] - a[0]) * f) >> 16)),
+					buffer[0], volume, loud);
+			buffer[1] = mix((a[1] + (int)(((b[1] - a[1]) * f) >> 16)),
+					buffer[1], volume, loud);
+			buffer += 2;
+		}
+		// in[end] becomes in[0].
+		memmove(fm.in[0], fm.in[end],
+			((fm.have - end + 1) * sizeof(fm.in[0])));
+		fm.have -= end;
+		fm.pos = (pos & 0xffff);
+		length -= n;
+	}
+}
+
+void fm_core_write(int num, int a, uint8_t v)
+{
+	unsigned int i;
+
+	if (fm.core == FM_CORE_MAME) {
+		YM2612Write(num, a, v);
+		return;
+	}
+	a &= 3;
+	if (a & 1)
+		fm.regs[fm.addr] = v;
+	else
+		fm.addr = (((a & 2) << 7) | v);
+	if (fm.core == FM_CORE_GPGX) {
+		fm_gpgx_write(a, v);
+		return;
+	}
+	OPN2_Write(&opn2, a, v);
+	for (i = 0; (i != ((a & 1) ? NUKED_DATA_CLOCKS : NUKED_ADDR_CLOCKS));
+	     ++i)
+		nuked_clock();
+}
+
+void fm_core_write_regs(int num, const struct ym2612_reg_write *w,
+			unsigned int count)
+{
+	uint16_t addr = fm.addr;
+	unsigned int i;
+
+	if (fm.core == FM_CORE_MAME) {
+		YM2612WriteRegs(num, w, count);
+		return;
+	}
+	for (i = 0; (i != count); ++i) {
+		fm_core_write(num, ((w[i].reg >> 7) & 2), (w[i].reg & 0xff));
+		fm_core_write(num, (((w[i].reg >> 7) & 2) | 1), w[i].val);
+	}
+	// Select the game's register again.
+	if (count)
+		fm_core_write(num, ((addr >> 7) & 2), (addr & 0xff));
+}
+
+uint8_t fm_core_read(int num, int a)
+{
+	if (fm.core == FM_CORE_MAME)
+		return YM2612Read(num, a);
+	if (fm.core == FM_CORE_GPGX)
+		return fm_gpgx_read();
+	return OPN2_Read(&opn2, a);
+}
+
+void fm_core_dump(int num, uint8_t buf[512])
+{
+	if (fm.core == FM_CORE_MAME)
+		YM2612_dump(num, buf);
+	else
+		memcpy(buf, fm.regs, sizeof(fm.regs));
+}
+
+/*
+  Write the registers of a dump back, the DAC ones excepted (DGen plays the
+  DAC itself). The high frequency bytes are only latched until the low ones
+  are written.
+*/
+void fm_core_restore(int num, uint8_t buf[512])
+{
+	unsigned int port;
+	unsigned int r;
+
+	if (fm.core == FM_CORE_MAME) {
+		YM2612_restore(num, buf);
+		return;
+	}
+	for (r = 0x22; (r != 0x2a); ++r)
+		if ((r != 0x23) && (r != 0x28) && (r != 0x29)) {
+			fm_core_write(num, 0, r);
+			fm_core_write(num, 1, buf[r]);
+		}
+	for (port = 0; (port != 2); ++port) {
+		for (r = 0x30; (r != 0xb8); ++r) {
+			if (((r & 3) == 3) || ((r >= 0xa0) && (r < 0xb0)))
+				continue;
+			fm_core_write(num, (port << 1), r);
+			fm_core_write(num, ((port << 1) | 1), buf[((port << 8) | r)]);
+		}
+		for (r = 0xa0; (r != 0xb0); ++r) {
+			if (((r & 3) == 3) || ((r & 7) >= 4))
+				continue;
+			fm_core_write(num, (port << 1), (r + 4));
+			fm_core_write(num, ((port << 1) | 1),
+				      buf[((port << 8) | (r + 4))]);
+			fm_core_write(num, (port << 1), r);
+			fm_core_write(num, ((port << 1) | 1), buf[((port << 8) | r)]);
+		}
+	}
+}
+
+/*
+  Native state of the selected core, which can only be loaded back into
+  the same core at the same clock and sampling rate. fm.c adds the same
+  restrictions of its own, see YM2612_state_size().
+*/
+size_t fm_core_state_size(void)
+{
+	size_t size = YM2612_state_size();
+
+	if (size < fm_gpgx_state_size())
+		size = fm_gpgx_state_size();
+	if (size < sizeof(opn2))
+		size = sizeof(opn2);
+	return (sizeof(fm) + size);
+}
+
+void fm_core_state_save(int num, uint8_t *buf)
+{
+	memcpy(buf, &fm, sizeof(fm));
+	buf += sizeof(fm);
+	if (fm.core == FM_CORE_MAME)
+		YM2612_state_save(num, buf);
+	else if (fm.core == FM_CORE_GPGX)
+		fm_gpgx_state_save(buf);
+	else
+		memcpy(buf, &opn2, sizeof(opn2));
+}
+
+int fm_core_state_load(int num, const uint8_t *buf)
+{
+	struct fm_core_state *from = (struct fm_core_state *)buf;
+	int core;
+	uint32_t step;
+
+	/* buf is not necessarily aligned for the struct. */
+	memcpy(&core, ((const uint8_t *)from + offsetof(struct fm_core_state, core)),
+	       sizeof(core));
+	memcpy(&step, ((const uint8_t *)from + offsetof(struct fm_core_state, step)),
+	       sizeof(step));
+	if ((core != fm.core) || (step != fm.step))
+		return -1;
+	buf += sizeof(fm);
+	if (fm.core == FM_CORE_MAME)
+		return YM2612_state_load(num, buf);
+	memcpy(&fm, from, sizeof(fm));
+	if (fm.core == FM_CORE_GPGX)
+		fm_gpgx_state_load(buf);
+	else
+		memcpy(&opn2, buf, sizeof(opn2));
+	return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef FM_CORE_H
+#define FM_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define FM_CORE_H_BEGIN_ extern "C" {
+#define FM_CORE_H_END_ }
+#else
+#define FM_CORE_H_BEGIN_
+#define FM_CORE_H_END_
+#endif
+
+FM_CORE_H_BEGIN_
+
+struct ym2612_reg_write; /* fm.h */
+
+/*
+  YM2612 emulators, selected by emu_fm_startup. Keep values in sync with
+  emu_fm_names[] in rc.cpp.
+
+  FM_CORE_MAME is fm.c. The other two come from the web tree and run at the
+  chip's own rate (clock / 144), resampled to the sound rate: the Genesis
+  Plus GX core (fm_gpgx.c) and Nuked OPN2 (fm_nuked.c). They emulate a
+  single chip, MJazz falls back to fm.c.
+*/
+enum fm_core {
+	FM_CORE_MAME,
+	FM_CORE_GPGX,
+	FM_CORE_NUKED,
+	FM_CORE_TOTAL
+};
+
+/* Same as the YM2612*() functions of fm.h, for the selected core. */
+int fm_core_init(int core, int num, int clock, int rate, int mjazz);
+int fm_core_active(void);
+void fm_core_shutdown(void);
+void fm_core_reset(int num);
+void fm_core_update(int num, int16_t *buffer, unsigned int length,
+		    unsigned int volume, int loud);
+void fm_core_write(int num, int a, uint8_t v);
+void fm_core_write_regs(int num, const struct ym2612_reg_write *w,
+			unsigned int count);
+uint8_t fm_core_read(int num, int a);
+void fm_core_dump(int num, uint8_t buf[512]);
+void fm_core_restore(int num, uint8_t buf[512]);
+size_t fm_core_state_size(void);
+void fm_core_state_save(int num, uint8_t *buf);
+int fm_core_state_load(int num, const uint8_t *buf);
+
+/* Genesis Plus GX core entry points (fm_gpgx.c), its own are renamed. */
+void fm_gpgx_init(void);
+void fm_gpgx_reset(void);
+void fm_gpgx_update(int *buffer, int length);
+void fm_gpgx_write(unsigned int a, unsigned int v);
+unsigned int fm_gpgx_read(void);
+size_t fm_gpgx_state_size(void);
+void fm_gpgx_state_save(uint8_t *buf);
+void fm_gpgx_state_load(const uint8_t *buf);
+
+FM_CORE_H_END_
+
+#endif /* FM_CORE_H */
@@ -0,0 +1,61 @@
+/*
+  Genesis Plus GX YM2612 core for fm_core.c, built from the web tree
+  (web/src/main/c/core/sound/ym2612.c, gpgx/shared.h stands in for the
+  rest of the web core). Its functions have the same names as fm.c's, they
+  are renamed here and only reached through the fm_gpgx_*() ones.
+*/
+
+#define YM2612Init gpgx_YM2612Init
+#define YM2612Config gpgx_YM2612Config
+#define YM2612ResetChip gpgx_YM2612ResetChip
+#define YM2612Update gpgx_YM2612Update
+#define YM2612SetStems gpgx_YM2612SetStems
+#define YM2612Write gpgx_YM2612Write
+#define YM2612Read gpgx_YM2612Read
+#define YM2612LoadContext gpgx_YM2612LoadContext
+#define YM2612SaveContext gpgx_YM2612SaveContext
+
+#include "ym2612.c"
+#include "fm_core.h"
+
+void fm_gpgx_init(void)
+{
+	YM2612Init();
+	YM2612Config(YM2612_DISCRETE);
+}
+
+void fm_gpgx_reset(void)
+{
+	YM2612ResetChip();
+}
+
+void fm_gpgx_update(int *buffer, int length)
+{
+	YM2612Update(buffer, length);
+}
+
+void fm_gpgx_write(unsigned int a, unsigned int v)
+{
+	YM2612Write(a, v);
+}
+
+unsigned int fm_gpgx_read(void)
+{
+	return YM2612Read();
+}
+
+/* YM2612SaveContext() size: the chip, then two bytes per slot (see there). */
+size_t fm_gpgx_state_size(void)
+{
+	return (sizeof(ym2612) + (6 * 4 * 2));
+}
+
+void fm_gpgx_state_save(uint8_t *buf)
+{
+	YM2612SaveContext(buf);
+}
+
+void fm_gpgx_state_load(const uint8_t *buf)
+{
+	YM2612LoadContext((unsigned char *)buf);
+}
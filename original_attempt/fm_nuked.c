@@ -0,0 +1,7 @@
+/*
+  Nuked OPN2 for fm_core.c, built from the web tree
+  (web/src/main/c/core/sound/ym3438.c).
+*/
+
+#define HAVE_YM3438_CORE
+#include "ym3438.c"
@@ -0,0 +1,34 @@
+/*
+  Stand-in for the web core's shared.h, what its ym2612.c needs to build
+  in DGen (see fm_gpgx.c).
+*/
+#ifndef _SHARED_H_
+#define _SHARED_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+typedef int8_t INT8;
+typedef int16_t INT16;
+typedef int32_t INT32;
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+
+#define INLINE static __inline__
+
+#define load_param(param, size) \
+	memcpy(param, &state[bufferptr], size); \
+	bufferptr += size;
+
+#define save_param(param, size) \
+	memcpy(&state[bufferptr], param, size); \
+	bufferptr += size;
+
+#include "ym2612.h"
+
+#endif /* _SHARED_H_ */
@@ -42,20 +42,24 @@
 #define trU   0x00000700
 #define trV   0x00000006
 
-/* RGB to YUV lookup table */
-extern uint32_t RGBtoYUV[16777216];
+/* RGB to YUV, with the coefficients of the original lookup table in 16.16
+   fixed point. Computing it is cheaper than a random read of a 64MB table */
+static inline uint32_t rgb_to_yuv(int32_t r, int32_t g, int32_t b)
+{
+    uint32_t y = (19595 * r + 38470 * g + 7471 * b) >> 16;
+    uint32_t u = (-11076 * r - 21692 * g + 32768 * b) / 65536 + 128;
+    uint32_t v = (32768 * r - 27460 * g - 5308 * b) / 65536 + 128;
+    return (y << 16) + (u << 8) + v;
+}
 
 static inline uint32_t rgb32_to_yuv(uint32_t c)
 {
-    // Mask against MASK_RGB to discard the alpha channel
-    return RGBtoYUV[MASK_RGB & c];
+    return rgb_to_yuv((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF);
 }
 
 static inline uint32_t rgb16_to_yuv(uint16_t c)
 {
-    return RGBtoYUV[(((c & 0xF800) << 8) |
-                     ((c & 0x07E0) << 5) |
-                     ((c & 0x001F) << 3))];
+    return rgb_to_yuv((c & 0xF800) >> 8, (c & 0x07E0) >> 3, (c & 0x001F) << 3);
 }
 
 static inline uint24_t *u24cpy(uint24_t *dst, const uint24_t src)
@@ -73,7 +77,7 @@ static inline uint24_t *u24cpy(uint24_t *dst, const uint24_t src)
 
 static inline uint32_t rgb24_to_yuv(uint24_t c)
 {
-    return RGBtoYUV[((c[0] << 16) | (c[1] << 8) | c[2])];
+    return rgb_to_yuv(c[0], c[1], c[2]);
 }
 
 /* Test if there is difference in color */
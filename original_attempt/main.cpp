@@ -19,6 +19,13 @@
 #include <wincon.h>
 #endif
 
+#ifdef WITH_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
 #define IS_MAIN_CPP
 #include "system.h"
 #include "md.h"
@@ -26,6 +33,8 @@
 #include "pd-defs.h"
 #include "rc.h"
 #include "rc-vars.h"
+#include "rewind.h"
+#include "chaoslog.h"
 
 #ifdef __BEOS__
 #include <OS.h>
@@ -79,6 +88,89 @@ static inline void do_demo(md &megad, FILE *demo, enum demo_status *status)
 	}
 }
 
+// Frame pacing, see the main loop.
+#define PACE_MAX_FRAMES 10 // Never emulate more frames than this at once
+
+static struct
+{
+	unsigned long render;	// Cost of a rendered frame (usecs, average)
+	unsigned long skip;		// Cost of a skipped frame (usecs, average)
+	unsigned int emulated;	// Frames emulated since the last status
+	unsigned int skipped;	// Frames not rendered since the last status
+	unsigned int underruns; // Sound underruns since the last status
+	unsigned int level;		// Sound buffer level (percent)
+} pace;
+
+// Add the time spent since start to a running average.
+static void pace_cost(unsigned long *avg, unsigned long start)
+{
+	unsigned long cost = (pd_usecs() - start);
+
+	*avg = ((*avg * 7) + cost) / 8;
+}
+
+// Number of frames to emulate for each displayed one while fast-forwarding,
+// no more than what fits in a frame on this host.
+static int pace_fast_forward(unsigned int usec_frame)
+{
+	int frames = dgen_fast_forward_frames;
+
+	if ((pace.skip) && (pace.render < usec_frame))
+	{
+		unsigned long fit = (1 + ((usec_frame - pace.render) / pace.skip));
+
+		if ((unsigned long)frames > fit)
+			frames = fit;
+	}
+	if (frames > PACE_MAX_FRAMES)
+		frames = PACE_MAX_FRAMES;
+	if (frames < 1)
+		frames = 1;
+	return frames;
+}
+
+// Correct the number of frames due according to the sound buffer level.
+// The buffer drains at the sound card's rate, so when it gets low we are
+// behind and must catch up, and when it's almost full we are ahead.
+static int pace_frames(int frames_todo, unsigned int usec_frame)
+{
+	struct sound_stats stats;
+
+	if (pd_fast_forward)
+		return pace_fast_forward(usec_frame);
+	if (dgen_sound)
+	{
+		pd_sound_stats(&stats);
+		pace.underruns += stats.underruns;
+		if (stats.size)
+		{
+			pace.level = ((stats.level * 100) / stats.size);
+			if ((stats.underruns) || (stats.level < (stats.size / 4)))
+				++frames_todo;
+			else if (stats.level > (stats.size - (stats.size / 4)))
+				--frames_todo;
+		}
+	}
+	if (frames_todo > PACE_MAX_FRAMES)
+		frames_todo = PACE_MAX_FRAMES;
+	return frames_todo;
+}
+
+// Display pacing information, called once per second.
+static void pace_status(unsigned long fps)
+{
+	if ((dgen_show_pacing) || (pd_fast_forward))
+		pd_message("%s%lu/%u FPS, %u skipped, %lu.%lu ms, sound %u%%"
+				   " (%u underruns)",
+				   (pd_fast_forward ? "Fast-forward: " : ""), fps,
+				   pace.emulated, pace.skipped, (pace.render / 1000),
+				   ((pace.render / 100) % 10), pace.level,
+				   pace.underruns);
+	pace.emulated = 0;
+	pace.skipped = 0;
+	pace.underruns = 0;
+}
+
 // Temporary garbage can string :)
 static char temp[65536] = "";
 
@@ -106,6 +198,10 @@ static void help()
 		"    -d DEMONAME     Record a demo of the game you are playing.\n"
 		"    -D DEMONAME     Play back a previously recorded demo.\n"
 		"    -s SLOT         Load the saved state from the given slot at startup.\n"
+		"    -b FRAMES       Run the ROM for FRAMES frames on each pair of CPU\n"
+		"                    cores, store the fastest one in the configuration\n"
+		"                    file, report the speed of each YM2612 emulator\n"
+		"                    and exit.\n"
 #ifdef __MINGW32__
 		"    -m              Do not detach from console.\n"
 #endif
@@ -119,58 +215,268 @@ static void help()
 // It is externed from your implementation to change the current slot
 // (I know this is a hack :)
 int slot = 0;
+
+// States of slots 0 to STATE_SLOTS - 1 are kept in memory as returned by
+// md::state_save(), saving or loading them only copies memory. They are
+// written to disk as GST files by a separate thread when possible, right
+// away otherwise. Other slots go through GST files only.
+#define STATE_SLOTS 10
+
+static struct
+{
+	uint8_t *buf[STATE_SLOTS];	   // md::state_size() bytes each, or NULL
+	size_t size;				   // md::state_size()
+	char romname[sizeof(md::romname)]; // ROM these states belong to
+	unsigned int valid;			   // slots holding a state
+	unsigned int dirty;			   // slots not written to disk yet
+	unsigned int failed;		   // slots that could not be written
+#ifdef WITH_THREADS
+	std::mutex lock;			   // protects everything above
+	std::condition_variable wake;  // dirty is set or quit is requested
+	std::condition_variable idle;  // dirty is empty and nothing is written
+	std::thread thread;			   // writer
+	bool writing;				   // writer is busy with a slot
+	bool quit;					   // writer must return once idle
+#endif
+} states;
+
+static FILE *state_fopen(const char *romname, int num, unsigned int mode)
+{
+	char file[64];
+
+	if ((size_t)snprintf(file, sizeof(file), "%s.gs%d", romname, num) >=
+		sizeof(file))
+		return NULL;
+	return dgen_fopen("saves", file, mode);
+}
+
+static bool state_write(const char *romname, int num, const uint8_t *buf)
+{
+	FILE *save;
+	int ret;
+
+	if ((save = state_fopen(romname, num, DGEN_WRITE)) == NULL)
+		return false;
+	ret = md::state_export_gst(buf, save);
+	if (fclose(save))
+		ret = -1;
+	return (ret == 0);
+}
+
+#ifdef WITH_THREADS
+
+static void states_thread()
+{
+	std::unique_lock<std::mutex> hold(states.lock);
+	uint8_t *buf = (uint8_t *)malloc(states.size);
+	char romname[sizeof(states.romname)];
+	unsigned int num;
+	bool ok;
+
+	while (states.wake.wait(hold, []
+							{ return (states.dirty || states.quit); }),
+		   states.dirty)
+	{
+		for (num = 0; (!(states.dirty & (1u << num))); ++num)
+			continue;
+		// Write a copy, md_save() may replace this state meanwhile.
+		states.dirty &= ~(1u << num);
+		ok = false;
+		if (buf != NULL)
+		{
+			memcpy(buf, states.buf[num], states.size);
+			memcpy(romname, states.romname, sizeof(romname));
+			states.writing = true;
+			hold.unlock();
+			ok = state_write(romname, num, buf);
+			hold.lock();
+			states.writing = false;
+		}
+		if (!ok)
+		{
+			fprintf(stderr, "main: couldn't write state of slot %u.\n",
+					num);
+			states.failed |= (1u << num);
+		}
+		if (!states.dirty)
+			states.idle.notify_all();
+	}
+	free(buf);
+}
+
+#endif // WITH_THREADS
+
+// Registered with atexit(), pending states are written first.
+static void states_cleanup()
+{
+	unsigned int i;
+
+#ifdef WITH_THREADS
+	if (states.thread.joinable())
+	{
+		states.lock.lock();
+		states.quit = true;
+		states.lock.unlock();
+		states.wake.notify_one();
+		states.thread.join();
+	}
+#endif
+	for (i = 0; (i != STATE_SLOTS); ++i)
+	{
+		free(states.buf[i]);
+		states.buf[i] = NULL;
+	}
+	states.valid = 0;
+}
+
+/**
+ * Return the memory of a slot for the current ROM, NULL when it must go
+ * through files. The other states are dropped when the ROM has changed.
+ */
+static uint8_t *states_slot(md &megad, int num)
+{
+	static bool registered;
+
+	if ((num < 0) || (num >= STATE_SLOTS))
+		return NULL;
+	if ((!registered) && (atexit(states_cleanup) != 0))
+		return NULL;
+	registered = true;
+	if (strcmp(states.romname, megad.romname))
+	{
+#ifdef WITH_THREADS
+		std::unique_lock<std::mutex> hold(states.lock);
+
+		states.idle.wait(hold, []
+						 { return (!states.dirty && !states.writing); });
+#endif
+		snprintf(states.romname, sizeof(states.romname), "%s",
+				 megad.romname);
+		states.valid = 0;
+	}
+	states.size = md::state_size();
+	if (states.buf[num] == NULL)
+		states.buf[num] = (uint8_t *)malloc(states.size);
+	return states.buf[num];
+}
+
+/**
+ * Return a slot whose state could not be written since last time, -1 if
+ * none.
+ */
+static int states_failed()
+{
+	unsigned int num;
+	int ret = -1;
+
+#ifdef WITH_THREADS
+	std::lock_guard<std::mutex> hold(states.lock);
+#endif
+	for (num = 0; (num != STATE_SLOTS); ++num)
+		if (states.failed & (1u << num))
+		{
+			states.failed &= ~(1u << num);
+			ret = num;
+			break;
+		}
+	return ret;
+}
+
 void md_save(md &megad)
 {
 	FILE *save;
-	char file[64];
+	uint8_t *buf;
+	int failed;
 
 	if (!megad.plugged)
 	{
 		pd_message("Cannot save state when no ROM is loaded.");
 		return;
 	}
-	if (((size_t)snprintf(file,
-						  sizeof(file),
-						  "%s.gs%d",
-						  megad.romname,
-						  slot) >= sizeof(file)) ||
-		((save = dgen_fopen("saves", file, DGEN_WRITE)) == NULL))
+	if ((failed = states_failed()) >= 0)
 	{
 		snprintf(temp, sizeof(temp),
-				 "Couldn't save state to slot %d!", slot);
+				 "Couldn't save state to slot %d!", failed);
 		pd_message(temp);
-		return;
 	}
+	if ((buf = states_slot(megad, slot)) != NULL)
+	{
+#ifdef WITH_THREADS
+		std::unique_lock<std::mutex> hold(states.lock);
+
+		if (!states.thread.joinable())
+		{
+			try
+			{
+				states.thread = std::thread(states_thread);
+			}
+			catch (const std::system_error &)
+			{
+			}
+		}
+		if (states.thread.joinable())
+		{
+			megad.state_save(buf);
+			states.valid |= (1u << slot);
+			states.dirty |= (1u << slot);
+			hold.unlock();
+			states.wake.notify_one();
+			goto saved;
+		}
+		hold.unlock();
+#endif
+		megad.state_save(buf);
+		states.valid |= (1u << slot);
+		if (!state_write(megad.romname, slot, buf))
+			goto error;
+		goto saved;
+	}
+	if ((save = state_fopen(megad.romname, slot, DGEN_WRITE)) == NULL)
+		goto error;
 	megad.export_gst(save);
 	fclose(save);
+saved:
+	if (failed >= 0)
+		return;
 	snprintf(temp, sizeof(temp), "Saved state to slot %d.", slot);
 	pd_message(temp);
+	return;
+error:
+	snprintf(temp, sizeof(temp),
+			 "Couldn't save state to slot %d!", slot);
+	pd_message(temp);
 }
 
 void md_load(md &megad)
 {
 	FILE *load;
-	char file[64];
+	uint8_t *buf;
 
 	if (!megad.plugged)
 	{
 		pd_message("Cannot restore state when no ROM is loaded.");
 		return;
 	}
-	if (((size_t)snprintf(file,
-						  sizeof(file),
-						  "%s.gs%d",
-						  megad.romname,
-						  slot) >= sizeof(file)) ||
-		((load = dgen_fopen("saves", file, DGEN_READ)) == NULL))
+	buf = states_slot(megad, slot);
+	if ((buf != NULL) && (states.valid & (1u << slot)))
+		megad.state_load(buf);
+	else
 	{
-		snprintf(temp, sizeof(temp),
-				 "Couldn't load state from slot %d!", slot);
-		pd_message(temp);
-		return;
+		if ((load = state_fopen(megad.romname, slot, DGEN_READ)) == NULL)
+		{
+			snprintf(temp, sizeof(temp),
+					 "Couldn't load state from slot %d!", slot);
+			pd_message(temp);
+			return;
+		}
+		// Keep it in memory for next time.
+		if ((megad.import_gst(load) == 0) && (buf != NULL))
+		{
+			megad.state_save(buf);
+			states.valid |= (1u << slot);
+		}
+		fclose(load);
 	}
-	megad.import_gst(load);
-	fclose(load);
 	snprintf(temp, sizeof(temp), "Loaded state from slot %d.", slot);
 	pd_message(temp);
 }
@@ -213,9 +519,204 @@ fail:
 			megad.romname);
 }
 
+// Run the loaded ROM for some frames on each YM2612 emulator with the sound
+// rendered, and report their speed. The choice is left to emu_fm_startup,
+// they don't sound the same.
+static void bench_fm(md &megad, unsigned int frames, FILE *save)
+{
+	intptr_t fm = dgen_emu_fm;
+	struct sndinfo snd;
+	unsigned int i;
+	unsigned int n;
+
+	snd.len = (dgen_soundrate / megad.vhz);
+	snd.lr = new int16_t[(snd.len * 2)];
+	for (i = 0; (emu_fm_names[i] != NULL); ++i)
+	{
+		unsigned long start;
+		unsigned long usecs;
+
+		dgen_emu_fm = i;
+		if ((!megad.init_sound()) || (fm_core_active() != (int)i))
+		{
+			printf("main: %-8s unavailable\n", emu_fm_names[i]);
+			continue;
+		}
+		if (save != NULL)
+		{
+			rewind(save);
+			megad.get_save_ram(save);
+		}
+		megad.reset();
+		start = pd_usecs();
+		for (n = 0; (n != frames); ++n)
+		{
+			memset(snd.lr, 0, (snd.len * 2 * sizeof(snd.lr[0])));
+			megad.one_frame(NULL, NULL, &snd);
+		}
+		usecs = (pd_usecs() - start);
+		if (usecs == 0)
+			usecs = 1;
+		printf("main: %-8s %9.1f fps, hash %08x\n", emu_fm_names[i],
+			   ((frames * 1000000.0) / usecs), megad.mem_hash());
+	}
+	delete[] snd.lr;
+	dgen_emu_fm = fm;
+	megad.init_sound();
+}
+
+// Run the loaded ROM for some frames on each pair of CPU cores and make the
+// fastest one the default. Pairs that don't end with the same RAM and VRAM as
+// the first one are reported and can't win. The YM2612 emulators are then
+// compared on the fastest pair (bench_fm()).
+static void bench_cores(md &megad, unsigned int frames)
+{
+	// Values of dgen_emu_m68k and dgen_emu_z80, see md::md().
+	static const struct
+	{
+		int rc;
+		enum md::cpu_emu emu;
+	} m68k[] = {
+#ifdef WITH_STAR
+		{ 1, md::CPU_EMU_STAR },
+#endif
+#ifdef WITH_MUSA
+		{ 2, md::CPU_EMU_MUSA },
+#endif
+#ifdef WITH_CYCLONE
+		{ 3, md::CPU_EMU_CYCLONE },
+#endif
+		{ -1, md::CPU_EMU_NONE }
+	};
+	static const struct
+	{
+		int rc;
+		enum md::z80_core core;
+	} z80[] = {
+#ifdef WITH_MZ80
+		{ 1, md::Z80_CORE_MZ80 },
+#endif
+#ifdef WITH_CZ80
+		{ 2, md::Z80_CORE_CZ80 },
+#endif
+#ifdef WITH_DRZ80
+		{ 3, md::Z80_CORE_DRZ80 },
+#endif
+#if !defined(WITH_MZ80) && !defined(WITH_CZ80) && !defined(WITH_DRZ80)
+		{ 0, md::Z80_CORE_NONE },
+#endif
+		{ -1, md::Z80_CORE_NONE }
+	};
+	FILE *save = NULL;
+	FILE *file;
+	uint32_t first_hash = 0;
+	double best_fps = 0.0;
+	int best_m68k = -1;
+	int best_z80 = -1;
+	enum md::cpu_emu best_emu = md::CPU_EMU_NONE;
+	enum md::z80_core best_core = md::Z80_CORE_NONE;
+	bool first = true;
+	unsigned int i;
+	unsigned int j;
+	unsigned int n;
+
+	// reset() doesn't touch battery RAM, put it back before each run.
+	if (megad.has_save_ram())
+	{
+		save = tmpfile();
+		if ((save != NULL) && (megad.put_save_ram(save)))
+		{
+			fclose(save);
+			save = NULL;
+		}
+	}
+	printf("main: benchmarking CPU cores over %u frames.\n", frames);
+	for (i = 0; (m68k[i].rc != -1); ++i)
+		for (j = 0; (z80[j].rc != -1); ++j)
+		{
+			unsigned long start;
+			unsigned long usecs;
+			uint32_t hash;
+			double fps;
+
+			if (save != NULL)
+			{
+				rewind(save);
+				megad.get_save_ram(save);
+			}
+			megad.md_bind(false);
+			megad.cpu_emu = m68k[i].emu;
+			megad.z80_core = z80[j].core;
+			megad.reset();
+			start = pd_usecs();
+			for (n = 0; (n != frames); ++n)
+				megad.one_frame(NULL, NULL, NULL);
+			usecs = (pd_usecs() - start);
+			if (usecs == 0)
+				usecs = 1;
+			fps = ((frames * 1000000.0) / usecs);
+			hash = megad.mem_hash();
+			if (first)
+			{
+				first_hash = hash;
+				first = false;
+			}
+			printf("main: %-8s %-6s %9.1f fps, hash %08x%s\n",
+				   emu_m68k_names[m68k[i].rc],
+				   emu_z80_names[z80[j].rc], fps, hash,
+				   ((hash != first_hash) ? " (mismatch)" : ""));
+			if ((hash == first_hash) && (fps > best_fps))
+			{
+				best_fps = fps;
+				best_m68k = m68k[i].rc;
+				best_z80 = z80[j].rc;
+				best_emu = m68k[i].emu;
+				best_core = z80[j].core;
+			}
+		}
+	if (best_m68k != -1)
+	{
+		printf("main: benchmarking YM2612 emulators over %u frames.\n",
+			   frames);
+		megad.md_bind(false);
+		megad.cpu_emu = best_emu;
+		megad.z80_core = best_core;
+		bench_fm(megad, frames, save);
+	}
+	if (save != NULL)
+	{
+		rewind(save);
+		megad.get_save_ram(save);
+		fclose(save);
+	}
+	megad.reset();
+	if (best_m68k == -1)
+	{
+		fprintf(stderr, "main: no CPU core to benchmark.\n");
+		return;
+	}
+	printf("main: fastest is %s/%s.\n",
+		   emu_m68k_names[best_m68k], emu_z80_names[best_z80]);
+	dgen_emu_m68k = best_m68k;
+	dgen_emu_z80 = best_z80;
+	// Appended settings override earlier ones.
+	if ((file = dgen_fopen_rc(DGEN_APPEND)) == NULL)
+	{
+		fprintf(stderr, "main: can't write " DGEN_RC ".\n");
+		return;
+	}
+	fprintf(file,
+			"\n"
+			"# Fastest CPU cores for this host (dgen -b %u).\n"
+			"emu_m68k_startup = %s\n"
+			"emu_z80_startup = %s\n",
+			frames, emu_m68k_names[best_m68k], emu_z80_names[best_z80]);
+	fclose(file);
+}
+
 int main(int argc, char *argv[])
 {
-	int c = 0, stop = 0, usec = 0, start_slot = -1;
+	int c = 0, stop = 0, usec = 0, start_slot = -1, bench_frames = 0;
 	unsigned long frames, frames_old, fps;
 	char *patches = NULL, *rom = NULL;
 	unsigned long oldclk, newclk, startclk, fpsclk;
@@ -260,7 +761,7 @@ int main(int argc, char *argv[])
 #ifdef __MINGW32__
 			 "m"
 #endif
-			 "s:hvr:n:p:R:NPH:d:D:",
+			 "s:hvr:n:p:R:NPH:d:D:b:",
 			 pd_options);
 	while ((c = getopt(argc, argv, temp)) != EOF)
 	{
@@ -394,6 +895,16 @@ int main(int argc, char *argv[])
 			// Pick a savestate to autoload
 			start_slot = atoi(optarg);
 			break;
+		case 'b':
+			// Benchmark CPU cores
+			bench_frames = atoi(optarg);
+			if (bench_frames <= 0)
+			{
+				fprintf(stderr, "main: invalid frame count `%s'.\n",
+						optarg);
+				return 1;
+			}
+			break;
 		default:
 			// Pass it on to platform-dependent stuff
 			pd_option(c, optarg);
@@ -527,6 +1038,15 @@ next_rom:
 
 	// Load up save RAM
 	ram_load(*megad);
+	if (bench_frames)
+	{
+		if (megad->plugged)
+			bench_cores(*megad, bench_frames);
+		else
+			fprintf(stderr, "main: no ROM to benchmark.\n");
+		megad->unplug();
+		goto clean_up;
+	}
 	// If -s option was given, load the requested slot
 	if (start_slot >= 0)
 	{
@@ -557,6 +1077,7 @@ next_rom:
 	{
 		const unsigned int usec_frame = (1000000 / dgen_hz);
 		unsigned long tmp;
+		unsigned long start = 0;
 		int frames_todo;
 
 		newclk = pd_usecs();
@@ -580,6 +1101,7 @@ next_rom:
 			else
 				fps = (frames - frames_old);
 			frames_old = frames;
+			pace_status(fps);
 		}
 
 		if (dgen_frameskip == 0)
@@ -587,7 +1109,11 @@ next_rom:
 			// Check whether megad->one_frame() must be called.
 			if (pd_freeze)
 				goto frozen;
-			goto do_not_skip;
+			// Only skip frames when fast-forwarding.
+			frames_todo = 1;
+			if (pd_fast_forward)
+				frames_todo = pace_fast_forward(usec_frame);
+			goto draw;
 		}
 
 		// Measure how many frames to do this round.
@@ -595,6 +1121,8 @@ next_rom:
 		frames_todo = (usec / usec_frame);
 		usec %= usec_frame;
 		oldclk = newclk;
+		if (frames_todo != 0)
+			frames_todo = pace_frames(frames_todo, usec_frame);
 
 		if (frames_todo == 0)
 		{
@@ -620,9 +1148,17 @@ next_rom:
 			if (pd_freeze)
 				goto frozen;
 
+		draw:
+			if (pd_rewind)
+			{
+				// One snapshot back for each displayed frame.
+				rewind_step(*megad);
+				frames_todo = 1;
+			}
 			// Draw frames.
-			while (frames_todo != 1)
+			while (frames_todo > 1)
 			{
+				start = pd_usecs();
 				do_demo(*megad, file, &demo_status);
 				if (dgen_sound)
 				{
@@ -632,11 +1168,15 @@ next_rom:
 				}
 				else
 					megad->one_frame(NULL, NULL, NULL);
+				rewind_frame(*megad);
+				pace_cost(&pace.skip, start);
+				++pace.emulated;
+				++pace.skipped;
 				--frames_todo;
 				stop |= (pd_handle_events(*megad) ^ 1);
 			}
-			--frames_todo;
-		do_not_skip:
+			frames_todo = 0;
+			start = pd_usecs();
 			do_demo(*megad, file, &demo_status);
 			if (dgen_sound)
 			{
@@ -645,6 +1185,8 @@ next_rom:
 			}
 			else
 				megad->one_frame(&mdscr, mdpal, NULL);
+			if (!pd_rewind)
+				rewind_frame(*megad);
 		frozen:
 			if ((mdpal) && (pal_dirty))
 			{
@@ -652,11 +1194,30 @@ next_rom:
 				pal_dirty = 0;
 			}
 			pd_graphics_update(megad->plugged);
+			if (!pd_freeze)
+			{
+				pace_cost(&pace.render, start);
+				++pace.emulated;
+			}
 			++frames;
+#ifdef WITH_PROFILE
+			if ((frames % 60) == 0)
+				pd_message("68k %lu z80 %lu vdp %lu snd %lu / %lu us",
+					   megad->prof.m68k, megad->prof.z80,
+					   megad->prof.vdp, megad->prof.sound,
+					   megad->prof.total);
+#endif
 		}
 
 		stop |= (pd_handle_events(*megad) ^ 1);
 
+		{
+			char msg[128];
+
+			if (chaos_log_poll(msg, sizeof(msg)))
+				pd_message("%s", msg);
+		}
+
 		if (dgen_nice)
 		{
 #ifdef __BEOS__
@@ -282,6 +282,8 @@ int md::reset()
 	memset(mem, 0, 0x20000);
 	// Reset the VDP.
 	vdp.reset();
+	// Drop queued frame events.
+	sched_len = 0;
 	// Erase CPU states.
 	memset(&m68k_state, 0, sizeof(m68k_state));
 	memset(&z80_state, 0, sizeof(z80_state));
@@ -495,7 +497,7 @@ bool md::init_sound()
 		return false;
 	if (ok_ym2612)
 	{
-		YM2612Shutdown();
+		fm_core_shutdown();
 		ok_ym2612 = false;
 	}
 	if (ok_sn76496)
@@ -504,9 +506,9 @@ bool md::init_sound()
 		ok_sn76496 = false;
 	}
 	// Initialize two additional chips when MJazz is enabled.
-	if (YM2612Init((dgen_mjazz ? 3 : 1),
-				   (((pal) ? PAL_MCLK : NTSC_MCLK) / 7),
-				   dgen_soundrate, dgen_mjazz, NULL, NULL))
+	if (fm_core_init(dgen_emu_fm, (dgen_mjazz ? 3 : 1),
+					 (((pal) ? PAL_MCLK : NTSC_MCLK) / 7),
+					 dgen_soundrate, dgen_mjazz))
 		return false;
 	ok_ym2612 = true;
 	if (SN76496_init(0,
@@ -574,7 +576,8 @@ md::md(bool pal, char region) :
 								md_mz80_ref(0), md_mz80_prev(0),
 #endif
 								pal(pal), ok_ym2612(false), ok_sn76496(false),
-								vdp(*this), region(region), plugged(false)
+								vdp(*this), sched_len(0), region(region), plugged(false),
+								md_bound(false)
 {
 	// Only one MD object is allowed to exist at once.
 	if (lock)
@@ -596,7 +599,10 @@ md::md(bool pal, char region) :
 	fm_reset();
 
 #ifdef WITH_VGMDUMP
-	vgm_dump_file = NULL;
+	vgm_dump_writer = NULL;
+	vgm_dump_buf = NULL;
+	vgm_dump_len = 0;
+	vgm_dump_wait = 0;
 	vgm_dump_samples_total = 0;
 	vgm_dump_dac_wait = 0;
 	vgm_dump_dac_samples = 0;
@@ -790,7 +796,7 @@ md::md(bool pal, char region) :
 	return;
 cleanup:
 	if (ok_ym2612)
-		YM2612Shutdown();
+		fm_core_shutdown();
 	if (ok_sn76496)
 		(void)0;
 #ifdef WITH_MUSA
@@ -812,8 +818,10 @@ md::~md()
 {
 #ifdef WITH_VGMDUMP
 	vgm_dump_stop();
+	vgm_dump_join();
 #endif
 
+	md_bind(false);
 	assert(rom != NULL);
 	if (rom != no_rom)
 		unplug();
@@ -823,6 +831,7 @@ md::~md()
 
 #ifdef WITH_DEBUGGER
 	debug_leave();
+	free(debug_tracebuf);
 #endif
 #ifdef WITH_MUSA
 	free(ctx_musa);
@@ -836,7 +845,7 @@ md::~md()
 #endif
 
 	if (ok_ym2612)
-		YM2612Shutdown();
+		fm_core_shutdown();
 	if (ok_sn76496)
 		(void)0;
 	ok = 0;
@@ -875,8 +884,8 @@ int byteswap_memory(unsigned char *start, int len)
 int md::plug_in(unsigned char *cart, int len)
 {
 	// Plug in the cartridge specified by the uchar *
-	// NB - The megadrive will free() it if unplug() is called, or it exits
-	// So it must be a single piece of malloced data
+	// NB - The megadrive will unload_rom() it if unplug() is called, or it
+	// exits, so it must come from load_rom()
 	if (cart == NULL)
 		return 1;
 	if (len <= 0)
@@ -1005,6 +1014,72 @@ int md::unplug()
 	return 0;
 }
 
+/**
+ * Replace "EMULATOR" with "CHAOSDRV" in a ROM about to be plugged and compute
+ * its checksum in the same pass, a block at a time so both loops work on
+ * cached data. Only modified pages are written to, see load_rom().
+ * @param[in,out] rom ROM data, not byte swapped.
+ * @param size ROM size, at least 512 bytes.
+ * @param[out] checksum Checksum after replacement (sum of all 16-bit words
+ * from 0x200 onwards).
+ * @return true if the ROM has been modified.
+ */
+static bool easter_egg(uint8_t *rom, size_t size, unsigned short *checksum)
+{
+	static const char from[] = "EMULATOR";
+	static const char to[] = "CHAOSDRV";
+	const size_t block = 0x1000;
+	size_t end = (0x200 + ((size - 0x200) & ~(size_t)1));
+	unsigned short cs = 0;
+	bool modified = false;
+	size_t pos;
+
+	for (pos = 0; (pos < size); pos += block)
+	{
+		size_t len = ((size - pos) < block ? (size - pos) : block);
+		uint8_t *p = &rom[pos];
+		uint8_t *last = &rom[pos + len];
+		size_t i;
+
+		// Checksum, words below 0x200 don't count.
+		for (i = (pos < 0x200 ? 0x200 : pos); (i < (pos + len)); i += 2)
+			if (i < end)
+				cs += ((rom[i] << 8) | rom[i + 1]);
+		// Search, memchr() is vectorized by the C library.
+		while ((p = (uint8_t *)memchr(p, from[0], (last - p))) != NULL)
+		{
+			size_t at = (p - rom);
+			size_t j;
+
+			if (((size - at) < 8) || (memcmp(p, from, 8)))
+			{
+				++p;
+				continue;
+			}
+			// Fix the checksum for the bytes already added, those
+			// past this block will be added with their new value.
+			for (j = 0; (j != 8); ++j)
+			{
+				unsigned int w;
+
+				if (((at + j) < 0x200) || ((at + j) >= end) ||
+				    ((at + j) >= (pos + len)))
+					continue;
+				w = (((at + j) & 1) ? 1 : 0x100);
+				cs += (w * (uint8_t)to[j]);
+				cs -= (w * (uint8_t)from[j]);
+			}
+			memcpy(p, to, 8);
+			modified = true;
+			p += 8;
+			if (p >= last)
+				break;
+		}
+	}
+	*checksum = cs;
+	return modified;
+}
+
 /**
  * Load a ROM.
  * @param[in] name File name of cart to load.
@@ -1062,25 +1137,12 @@ int md::load(const char *name)
 
 	// Replace "EMULATOR" with "CHAOSDRV" in ROM data
 	// Pointless easter egg, basically.
-	bool modified = false;
-	for (size_t i = 0; i <= size - 8; i++)
-	{
-		if (memcmp(temp + i, "EMULATOR", 8) == 0)
-		{
-			memcpy(temp + i, "CHAOSDRV", 8);
-			modified = true;
-		}
-	}
+	unsigned short cs;
+	bool modified = easter_egg(temp, size, &cs);
 
-	// If we modified the ROM data, recalculate the checksum
+	// If we modified the ROM data, update the checksum
 	if (modified && size >= 0x190)
 	{
-		// Calculate checksum (sum of all 16-bit words from 0x200 onwards)
-		unsigned short cs = 0;
-		for (size_t i = 0x200; i < size - 1; i += 2)
-		{
-			cs += (temp[i] << 8) + temp[i + 1];
-		}
 		temp[0x18e] = cs >> 8;
 		temp[0x18f] = cs & 255;
 		printf("ChaosDrive: Updated ROM checksum to 0x%04x\n", cs);
@@ -1109,6 +1171,7 @@ int md::load(const char *name)
  */
 void md::cycle_z80()
 {
+	md_bind(false);
 	z80_state_dump();
 	z80_core = (enum z80_core)((z80_core + 1) % Z80_CORE_TOTAL);
 	z80_state_restore();
@@ -1119,6 +1182,7 @@ void md::cycle_z80()
  */
 void md::cycle_cpu()
 {
+	md_bind(false);
 	m68k_state_dump();
 	cpu_emu = (enum cpu_emu)((cpu_emu + 1) % CPU_EMU_TOTAL);
 	m68k_state_restore();
@@ -1140,6 +1204,25 @@ int md::z80dump()
 	return 0;
 }
 
+/**
+ * Hash 68000 RAM, Z80 RAM and VRAM (FNV-1a). Two runs of the same ROM with
+ * the same inputs should end with the same hash whatever the CPU cores.
+ * @return 32-bit hash.
+ */
+uint32_t md::mem_hash()
+{
+	const uint8_t *area[] = { ram, z80ram, vdp.vram };
+	const size_t size[] = { 0x10000, 0x2000, 0x10000 };
+	uint32_t hash = 0x811c9dc5;
+	unsigned int i;
+	size_t j;
+
+	for (i = 0; (i != 3); ++i)
+		for (j = 0; (j != size[i]); ++j)
+			hash = ((hash ^ area[i][j]) * 0x01000193);
+	return hash;
+}
+
 /**
  * This takes a comma or whitespace-separated list of Game Genie and/or hex
  * codes to patch the ROM with.
@@ -50,6 +50,7 @@ extern "C"
 {
 #include "fm.h"
 }
+#include "fm_core.h"
 
 #include "sn76496.h"
 #include "system.h"
@@ -110,10 +111,6 @@ static inline void (*(*debug_(const char *file, unsigned int line,
 #include "debug.h"
 #endif
 
-extern "C" int test_ctv(unsigned char *dest, int len);
-extern "C" int blur_bitmap_16(unsigned char *dest, int len);
-extern "C" int blur_bitmap_15(unsigned char *dest, int len);
-
 struct bmap
 {
   unsigned char *data;
@@ -147,17 +144,29 @@ public:
   bool cmd_pending; // set when first half of command arrives
   int sprite_overflow_line;
   bool cram_corruption_enabled;
+  int cram_corruption_countdown; // Lines left to the next corruption event
+  uint64_t cram_dirty; // highpal[] entries to update, bit N = CRAM word N
 
 private:
   int poke_vram(int addr, unsigned char d);
   int poke_cram(int addr, unsigned char d);
   int poke_vsram(int addr, unsigned char d);
+  // Block VRAM updates for the chaos helpers, one pass over the data
+  void vram_dirty(int addr, int len);
+  void vram_memmove(int dst, int src, int len);
+  void vram_fill(int addr, unsigned char d, int len);
+  void vram_xor(int addr, unsigned char mask, int len);
   int dma_len();
   int dma_addr();
   unsigned char dma_mem_read(int addr);
   int putword(unsigned short d);
   int putbyte(unsigned char d);
   // Used by draw_scanline to render the different display components
+  uint8_t tile_cache[0x20000]; // VRAM, one byte per pixel
+  uint8_t tile_planes[4][4][16]; // highpal[] bytes, [palette][byte][color]
+  void tile_cache_update();
+  void tile_planes_update();
+  uint64_t tile_row(int which, int line);
   void draw_tile1(int which, int line, unsigned char *where);
   void draw_tile1_solid(int which, int line, unsigned char *where);
   void draw_tile2(int which, int line, unsigned char *where);
@@ -200,6 +209,8 @@ private:
   struct bmap *bmap;
   unsigned char *dest;
   md &belongs;
+  // Accessors for the shared chaos effects, see chaos_backend.h
+  friend struct chaos_backend;
 
 public:
   md_vdp(md &);
@@ -232,6 +243,7 @@ public:
   void randomize_cram();
   void enable_cram_corruption();
   void disable_cram_corruption();
+  void cram_corruption_event();
   void sprite_attribute_scramble();
   void corrupt_vram_one_byte();
   void scroll_register_fuzzing();
@@ -418,6 +430,10 @@ public:
   void md_set_drz80_sync(bool push);
 #endif
   void md_set(bool set);
+  // Bound instance: one_frame() takes the CPU cores once and keeps them, their
+  // contexts stay live across frames and m68k_state/z80_state are only
+  // refreshed when something reads them (m68k_state_dump(), z80_state_dump())
+  void md_bind(bool bind);
 
   unsigned int mclk; // Master clock
   unsigned int clk0; // MCLK/15 for Z80, SN76489
@@ -518,6 +534,33 @@ private:
 
   int ras;
 
+  // Frame events, by M68K cycle from the start of the frame (line *
+  // M68K_CYCLES_PER_LINE + offset). one_frame() runs both CPUs to the next
+  // one, handles it, and so on: a line costs a single m68k_run()/z80_run()
+  // pair, the H-blank flag is worked out when the status is read.
+  enum md_event_type
+  {
+    MD_EVENT_LINE,          // Line start: pads, H-int counter, rendering
+    MD_EVENT_VBLANK,        // V-blank flag
+    MD_EVENT_VINT_FLAG,     // V-int flag, H-blank after the V-blank
+    MD_EVENT_VINT,          // V-int and Z80 IRQ
+    MD_EVENT_Z80_IRQ_CLEAR, // Z80 IRQ cleared a line later
+    MD_EVENT_FM_TIMER,      // Next YM2612 timer overflow
+    MD_EVENT_CALL           // sched_call()
+  };
+  struct md_event
+  {
+    int cycle;
+    enum md_event_type type;
+    void (*call)(void *);
+    void *data;
+  };
+  struct md_event sched[16]; // Sorted by cycle, same cycles first in first out
+  unsigned int sched_len;
+  bool sched_add(int cycle, enum md_event_type type,
+		 void (*call)(void *) = NULL, void *data = NULL);
+  void sched_fm();
+
   // Note order is (0) Vblank end -------- Vblank Start -- (HIGH)
   // So int6 happens in the middle of the count
 
@@ -549,7 +592,9 @@ private:
   // Number of microseconds spent in current frame
   unsigned int frame_usecs();
 
+  int fm_timer_period(int timer);
   int fm_timer_callback();
+  int fm_timer_control(int v);
   int myfm_read(int a);
   int mysn_write(int v);
   void fm_reset();
@@ -561,9 +606,20 @@ private:
   uint8_t dac_data[0x400];
   unsigned int dac_len;
   bool dac_enabled;
+  // DAC writes of the current frame, stamped with the odometer of the CPU
+  // making them and resampled into dac_data[] once the frame is over
+  struct dac_write
+  {
+    uint32_t odo; // Z80 odometer if bit 31 is set, M68K otherwise
+    uint8_t d;
+  } dac_writes[0x1000];
+  unsigned int dac_writes_len;
+  unsigned int dac_corrupt; // Writes corrupted by the next dac_resample()
   void dac_init();
   void dac_submit(uint8_t d);
   void dac_enable(uint8_t d);
+  void dac_resample();
+  void dac_corrupt_writes();
 
   uint8_t m68k_ROM_read(uint32_t a);
   uint8_t m68k_IO_read(uint32_t a);
@@ -573,17 +629,25 @@ private:
 
 public:
   int myfm_write(int a, int v, int md);
+  void myfm_write_regs(struct ym2612_reg_write *w, unsigned int n);
 
 #ifdef WITH_VGMDUMP
-  FILE *vgm_dump_file;
+  struct vgm_dump_writer *vgm_dump_writer; // see myfm.cpp
+  uint8_t *vgm_dump_buf;                   // commands not written yet
+  size_t vgm_dump_len;
+  uint32_t vgm_dump_wait; // samples to wait before the next command
   uint32_t vgm_dump_samples_total;
   uint32_t vgm_dump_dac_wait;
   unsigned int vgm_dump_dac_samples;
   bool vgm_dump;
+  void vgm_dump_submit();
+  void vgm_dump_put(const uint8_t *data, size_t len);
+  void vgm_dump_flush_wait();
   void vgm_dump_ym2612(uint8_t a1, uint8_t reg, uint8_t data);
   void vgm_dump_sn76496(uint8_t data);
   int vgm_dump_start(const char *name);
   void vgm_dump_stop();
+  void vgm_dump_join();
   void vgm_dump_frame();
 #endif
 
@@ -611,6 +675,24 @@ public:
   char region; // Emulator region.
   uint8_t region_guess();
   int one_frame(struct bmap *bm, unsigned char retpal[256], struct sndinfo *sndi);
+  // Call 'call(data)' once the frame reaches M68K cycle 'cycle' (both CPUs
+  // stopped), for effects timed on a line; calls past the end of the frame
+  // happen at its end. False when the event queue is full.
+  bool sched_call(int cycle, void (*call)(void *), void *data)
+  {
+    return sched_add(cycle, MD_EVENT_CALL, call, data);
+  }
+#ifdef WITH_PROFILE
+  // Wall-clock time spent in the last one_frame() call (microseconds)
+  struct md_profile
+  {
+    unsigned long m68k;
+    unsigned long z80;
+    unsigned long vdp;    // scanline rendering
+    unsigned long sound;  // FM/PSG/DAC buffer fill
+    unsigned long total;
+  } prof;
+#endif
   void pad_update();
   int pad[2];
   uint8_t pad_com[2];
@@ -622,6 +704,7 @@ public:
   // c000005 vint happened, (sprover, coll, oddinint)
   // invblank, inhblank, dma busy, pal
   unsigned char coo4, coo5;
+  unsigned char coo5_read(); // coo5 with the H-blank flag of the current line
   int okay() { return ok; }
   bool plugged;
   md(bool pal, char region);
@@ -678,15 +761,27 @@ public:
   } cpu_emu; // OK to read it but call cycle_cpu() to change it
   void cycle_cpu();
 
+  // Cores held by md_bind(true), released with them
+  bool md_bound;
+  enum z80_core md_bound_z80;
+  enum cpu_emu md_bound_cpu;
+
 #ifdef WITH_MZ80
   mz80context &z80_context() { return z80; }
 #endif
   int import_gst(FILE *hand);
   int export_gst(FILE *hand);
+  // Native save states, a single buffer of state_size() bytes
+  static size_t state_size();
+  void state_save(uint8_t *buf);
+  void state_load(const uint8_t *buf);
+  static int state_export_gst(const uint8_t *buf, FILE *hand);
 
   char romname[256];
 
   int z80dump();
+  // Hash of 68000 RAM, Z80 RAM and VRAM, to compare runs
+  uint32_t mem_hash();
 
   // Fix ROM checksum
   void fix_rom_checksum();
@@ -751,6 +846,25 @@ private:
   unsigned long debug_m68k_instr_count;
   unsigned long debug_z80_instr_count;
   bool debug_instr_count_enabled;
+  // One bit per PC with a breakpoint, (PC >> 1) for M68K where it is only a
+  // filter since the address space is larger.
+  uint32_t debug_bp_m68k_map[(BP_MAP_BITS / 32)];
+  uint32_t debug_bp_z80_map[(BP_MAP_BITS / 32)];
+  // One bit per watched page, set by the write path.
+  uint32_t debug_wp_m68k_pages[(WP_PAGES_M68K / 32)];
+  uint32_t debug_wp_z80_pages[(WP_PAGES_Z80 / 32)];
+  bool debug_wp_m68k_hit; // A watched page has been written to
+  bool debug_wp_z80_hit;
+  bool debug_wp_m68k_always; // Some watched memory changes by itself
+  bool debug_wp_z80_always;
+  bool debug_wp_m68k_ram; // StarScream writes RAM directly
+  // Traced M68K instructions go to this ring instead of stdout when
+  // debug_tracebuf_on is set (allocated on first use).
+  struct dgen_trace *debug_tracebuf;
+  unsigned int debug_tracebuf_next;
+  unsigned int debug_tracebuf_len;
+  bool debug_tracebuf_on;
+  m68k_state_t debug_tracebuf_regs; // Registers at the last record
 #ifdef WITH_DZ80
   DISZ80 disz80;
 #endif
@@ -775,6 +889,7 @@ private:
   uint32_t m68k_get_pc();
   uint16_t z80_get_pc();
   bool debug_m68k_check_bps();
+  void debug_m68k_trace_record(uint32_t pc);
   bool debug_m68k_check_wps();
   bool debug_z80_check_bps();
   bool debug_z80_check_wps();
@@ -788,6 +903,10 @@ private:
   void debug_list_wps_z80();
   int debug_set_bp_m68k(uint32_t);
   int debug_set_bp_z80(uint16_t);
+  void debug_update_bp_map_m68k();
+  void debug_update_bp_map_z80();
+  void debug_update_wp_pages_m68k();
+  void debug_update_wp_pages_z80();
 
 public:
   struct dgen_debugger_cmd
@@ -807,6 +926,8 @@ public:
   int debug_cmd_quit(int n_args, char **args);
   int debug_cmd_step(int n_args, char **args);
   int debug_cmd_trace(int n_args, char **args);
+  int debug_cmd_tracebuf(int n_args, char **args);
+  int debug_cmd_tracedump(int n_args, char **args);
   int debug_cmd_minus_break(int n_args, char **args);
   int debug_cmd_cpu(int n_args, char **args);
   int debug_cmd_dis(int n_args, char **args);
@@ -833,6 +954,8 @@ public:
   void debug_show_m68k_regs(void);
   void debug_show_z80_regs(void);
   void debug_dump_mem(uint32_t addr, uint32_t len);
+  void debug_wp_m68k_write(uint32_t a);
+  void debug_wp_z80_write(uint16_t a);
 #endif
 };
 
@@ -841,4 +964,30 @@ inline int md::has_save_ram()
   return save_len;
 }
 
+#ifdef WITH_DEBUGGER
+
+// Called by misc_writebyte() with a 24-bit address.
+inline void md::debug_wp_m68k_write(uint32_t a)
+{
+  // RAM is mirrored from 0xe00000.
+  if (a >= 0xe00000)
+    a |= 0xff0000;
+  a >>= WP_PAGE_SHIFT;
+  if (debug_wp_m68k_pages[(a / 32)] & (1u << (a % 32)))
+    debug_wp_m68k_hit = true;
+}
+
+// Called by z80_write().
+inline void md::debug_wp_z80_write(uint16_t a)
+{
+  // Z80 RAM is mirrored from 0x2000.
+  if (a <= 0x3fff)
+    a &= 0x1fff;
+  a >>= WP_PAGE_SHIFT;
+  if (debug_wp_z80_pages[(a / 32)] & (1u << (a % 32)))
+    debug_wp_z80_hit = true;
+}
+
+#endif
+
 #endif // __MD_H__
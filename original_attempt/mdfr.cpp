@@ -16,6 +16,18 @@
 #include "debug.h"
 #include "rc-vars.h"
 
+#ifdef WITH_PROFILE
+#include "pd.h"
+// Charge the time spent in a call to one of the md_profile counters
+#define PROF_CALL(counter, call) do { \
+		unsigned long prof_start_ = pd_usecs(); \
+		call; \
+		prof.counter += (pd_usecs() - prof_start_); \
+	} while (0)
+#else
+#define PROF_CALL(counter, call) call
+#endif
+
 // Set and unset contexts (Musashi, StarScream, MZ80)
 
 #ifdef WITH_MUSA
@@ -376,6 +388,31 @@ void md::md_set_drz80_sync(bool push)
 }
 #endif // WITH_DRZ80
 
+// Bind/unbind contexts: a bound instance holds a reference on its cores, so
+// the md_set() pairs of each frame neither push nor pull anything. Released
+// with the cores it was bound with, cpu_emu and z80_core may have changed.
+void md::md_bind(bool bind)
+{
+	enum cpu_emu cpu = cpu_emu;
+	enum z80_core z80 = z80_core;
+
+	if (bind == md_bound)
+		return;
+	if (bind) {
+		md_bound_cpu = cpu_emu;
+		md_bound_z80 = z80_core;
+		md_set(1);
+		md_bound = true;
+		return;
+	}
+	cpu_emu = md_bound_cpu;
+	z80_core = md_bound_z80;
+	md_set(0);
+	cpu_emu = cpu;
+	z80_core = z80;
+	md_bound = false;
+}
+
 // Set/unset contexts
 void md::md_set(bool set)
 {
@@ -894,13 +931,83 @@ void md::pad_update()
 		++aoo5_six_timeout;
 }
 
+// Z80 cycle matching M68K cycle 'cycle' of the frame
+static inline int z80_cycle(int cycle)
+{
+	return (((cycle / M68K_CYCLES_PER_LINE) * Z80_CYCLES_PER_LINE) +
+		(((cycle % M68K_CYCLES_PER_LINE) * Z80_CYCLES_PER_LINE) /
+		 M68K_CYCLES_PER_LINE));
+}
+
+// Queue a frame event, after those of the same cycle
+bool md::sched_add(int cycle, enum md_event_type type,
+		   void (*call)(void *), void *data)
+{
+	unsigned int i;
+
+	if (sched_len == elemof(sched))
+		return false;
+	for (i = sched_len; ((i != 0) && (sched[i - 1].cycle > cycle)); --i)
+		sched[i] = sched[i - 1];
+	sched[i].cycle = cycle;
+	sched[i].type = type;
+	sched[i].call = call;
+	sched[i].data = data;
+	++sched_len;
+	return true;
+}
+
+// (Re)schedule MD_EVENT_FM_TIMER at the next overflow of a running timer
+void md::sched_fm()
+{
+	unsigned int now = frame_usecs();
+	int next = INT_MAX;
+	unsigned int i;
+
+	for (i = 0; (i != sched_len); ++i)
+		if (sched[i].type == MD_EVENT_FM_TIMER) {
+			memmove(&sched[i], &sched[i + 1],
+				((sched_len - i - 1) * sizeof(sched[i])));
+			--sched_len;
+			break;
+		}
+	if (fm_reg[0][0x27] & 0x01)
+		next = (fm_timer_period(0) -
+			(fm_ticker[0] + (int)(now - fm_ticker[1])));
+	if (fm_reg[0][0x27] & 0x02) {
+		int b = (fm_timer_period(1) -
+			 (fm_ticker[2] + (int)(now - fm_ticker[3])));
+
+		if (b < next)
+			next = b;
+	}
+	if (next == INT_MAX)
+		return;
+	if (next < 1)
+		next = 1;
+	// Microseconds to M68K cycles, rounded up
+	sched_add((int)((((uint64_t)(now + next) * clk1) + 999999) / 1000000),
+		  MD_EVENT_FM_TIMER);
+}
+
+// Return coo5 with the H-blank flag, set during the first
+// M68K_CYCLES_HBLANK cycles of every line
+unsigned char md::coo5_read()
+{
+	int cycle = (m68k_odo() - (ras * M68K_CYCLES_PER_LINE));
+
+	if ((cycle >= 0) && (cycle < M68K_CYCLES_HBLANK))
+		return (coo5 | 0x04);
+	return coo5;
+}
+
 // Generate one frame
 int md::one_frame(struct bmap *bm, unsigned char retpal[256],
 		  struct sndinfo *sndi)
 {
 	int hints;
-	int m68k_max, z80_max;
 	unsigned int vblank = md::vblank();
+	int end = (lines * M68K_CYCLES_PER_LINE);
 
 #ifdef WITH_DEBUGGER
 	if (debug_trap)
@@ -917,9 +1024,16 @@ int md::one_frame(struct bmap *bm, unsigned char retpal[256],
 	     dgen_vdp_hide_plane_w | dgen_vdp_hide_sprites))
 		memset(bm->data, 0, (bm->pitch * bm->h));
 #endif
-	md_set(1);
+#ifdef WITH_PROFILE
+	unsigned long prof_frame = pd_usecs();
+
+	memset(&prof, 0, sizeof(prof));
+#endif
+	// Contexts stay in the cores from one frame to the next
+	md_bind(true);
 	// Reset odometers
 	memset(&odo, 0, sizeof(odo));
+	ras = 0;
 	// Reset FM tickers
 	fm_ticker[1] = 0;
 	fm_ticker[3] = 0;
@@ -929,6 +1043,7 @@ int md::one_frame(struct bmap *bm, unsigned char retpal[256],
 	if (vdp.reg[12] & 0x2)
 		coo5 ^= 0x10; // Toggle odd/even for interlace
 	coo5 &= ~0x08; // Clear vblank
+	coo5 &= ~0x04; // H-blank is coo5_read()'s
 	coo5 |= !!pal;
 	// Clear sprite overflow bit (d6).
 	coo5 &= ~0x40;
@@ -938,122 +1053,95 @@ int md::one_frame(struct bmap *bm, unsigned char retpal[256],
 	hints = vdp.reg[10]; // Set hint counter
 	// Reset sprite overflow line
 	vdp.sprite_overflow_line = INT_MIN;
-	// Video display! :D
-	for (ras = 0; ((unsigned int)ras < vblank); ++ras) {
-		pad_update(); // Update 6-button pads
-		fm_timer_callback(); // Update sound timers
-		if (--hints < 0) {
-			// Trigger hint
-			hints = vdp.reg[10];
-			vdp.hint_pending = true;
+	// The frame's events, roughly adapted from Genplus GX for the V-blank
+	// ones; sched_call() events may already be queued
+	sched_add((vblank * M68K_CYCLES_PER_LINE), MD_EVENT_VBLANK);
+	sched_add(((vblank * M68K_CYCLES_PER_LINE) + M68K_CYCLES_HBLANK),
+		  MD_EVENT_VINT_FLAG);
+	sched_add(((vblank * M68K_CYCLES_PER_LINE) + M68K_CYCLES_VDELAY),
+		  MD_EVENT_VINT);
+	sched_add(((vblank + 2) * M68K_CYCLES_PER_LINE),
+		  MD_EVENT_Z80_IRQ_CLEAR);
+	sched_add(0, MD_EVENT_LINE);
+	sched_fm();
+	while (sched_len) {
+		struct md_event ev;
+		unsigned int line;
+
+		// Run to the next event, one may be queued meanwhile
+		odo.m68k_max = ((sched[0].cycle < end) ? sched[0].cycle : end);
+		odo.z80_max = z80_cycle(odo.m68k_max);
+		PROF_CALL(m68k, m68k_run());
+		PROF_CALL(z80, z80_run());
+		ev = sched[0];
+		--sched_len;
+		memmove(&sched[0], &sched[1], (sched_len * sizeof(sched[0])));
+		switch (ev.type) {
+		case MD_EVENT_LINE:
+			ras = line = (ev.cycle / M68K_CYCLES_PER_LINE);
+			if ((line + 1) < lines)
+				sched_add((ev.cycle + M68K_CYCLES_PER_LINE),
+					  MD_EVENT_LINE);
+			if (line != vblank)
+				pad_update(); // Update 6-button pads
+			if (line > vblank)
+				break;
+			if (--hints < 0) {
+				// Trigger hint, the counter is reloaded on
+				// display lines only
+				if (line < vblank)
+					hints = vdp.reg[10];
+				vdp.hint_pending = true;
+				m68k_vdp_irq_trigger();
+				if (line < vblank)
+					PROF_CALL(vdp, may_want_to_get_pic(bm, retpal, 1));
+			}
+			else if (line < vblank)
+				PROF_CALL(vdp, may_want_to_get_pic(bm, retpal, 0));
+			break;
+		case MD_EVENT_VBLANK:
+			// Enable v-blank
+			coo5 |= 0x08;
+			break;
+		case MD_EVENT_VINT_FLAG:
+			// Delay between vint and vint flag
+			coo5 |= 0x80;
+			break;
+		case MD_EVENT_VINT:
+			// Delay between v-blank and vint
+			vdp.vint_pending = true;
 			m68k_vdp_irq_trigger();
-			may_want_to_get_pic(bm, retpal, 1);
+			if (!z80_st_reset)
+				z80_irq(0);
+			break;
+		case MD_EVENT_Z80_IRQ_CLEAR:
+			if (z80_st_irq)
+				z80_irq_clear();
+			break;
+		case MD_EVENT_FM_TIMER:
+			fm_timer_callback();
+			sched_fm();
+			break;
+		case MD_EVENT_CALL:
+			ev.call(ev.data);
+			break;
 		}
-		else
-			may_want_to_get_pic(bm, retpal, 0);
-		// Enable h-blank
-		coo5 |= 0x04;
-		// H-blank comes before, about 36/209 of the whole scanline
-		m68k_max = (odo.m68k_max + M68K_CYCLES_PER_LINE);
-		odo.m68k_max += M68K_CYCLES_HBLANK;
-		z80_max = (odo.z80_max + Z80_CYCLES_PER_LINE);
-		odo.z80_max += Z80_CYCLES_HBLANK;
-		m68k_run();
-		z80_run();
-		// Disable h-blank
-		coo5 &= ~0x04;
-		// Do hdisplay now
-		odo.m68k_max = m68k_max;
-		odo.z80_max = z80_max;
-		m68k_run();
-		z80_run();
-	}
-	// Now we're in vblank, more special things happen :)
-	// The following was roughly adapted from Genplus GX
-	// Enable v-blank
-	coo5 |= 0x08;
-	if (--hints < 0) {
-		// Trigger hint
-		vdp.hint_pending = true;
-		m68k_vdp_irq_trigger();
-	}
-	// Save m68k_max and z80_max
-	m68k_max = (odo.m68k_max + M68K_CYCLES_PER_LINE);
-	z80_max = (odo.z80_max + Z80_CYCLES_PER_LINE);
-	// Delay between vint and vint flag
-	odo.m68k_max += M68K_CYCLES_HBLANK;
-	odo.z80_max += Z80_CYCLES_HBLANK;
-	// Enable h-blank
-	coo5 |= 0x04;
-	m68k_run();
-	z80_run();
-	// Disable h-blank
-	coo5 &= ~0x04;
-	// Toggle vint flag
-	coo5 |= 0x80;
-	// Delay between v-blank and vint
-	odo.m68k_max += (M68K_CYCLES_VDELAY - M68K_CYCLES_HBLANK);
-	odo.z80_max += (Z80_CYCLES_VDELAY - Z80_CYCLES_HBLANK);
-	m68k_run();
-	z80_run();
-	// Restore m68k_max and z80_max
-	odo.m68k_max = m68k_max;
-	odo.z80_max = z80_max;
-	// Blank everything and trigger vint
-	vdp.vint_pending = true;
-	m68k_vdp_irq_trigger();
-	if (!z80_st_reset)
-		z80_irq(0);
-	fm_timer_callback();
-	// Run remaining cycles
-	m68k_run();
-	z80_run();
-	++ras;
-	// Run the course of vblank
-	pad_update();
-	fm_timer_callback();
-	// Usual h-blank stuff
-	coo5 |= 0x04;
-	m68k_max = (odo.m68k_max + M68K_CYCLES_PER_LINE);
-	odo.m68k_max += M68K_CYCLES_HBLANK;
-	z80_max = (odo.z80_max + Z80_CYCLES_PER_LINE);
-	odo.z80_max += Z80_CYCLES_HBLANK;
-	m68k_run();
-	z80_run();
-	coo5 &= ~0x04;
-	odo.m68k_max = m68k_max;
-	odo.z80_max = z80_max;
-	m68k_run();
-	z80_run();
-	// Clear Z80 interrupt
-	if (z80_st_irq)
-		z80_irq_clear();
-	++ras;
-	// Remaining lines
-	while ((unsigned int)ras < lines) {
-		pad_update();
-		fm_timer_callback();
-		// Enable h-blank
-		coo5 |= 0x04;
-		m68k_max = (odo.m68k_max + M68K_CYCLES_PER_LINE);
-		odo.m68k_max += M68K_CYCLES_HBLANK;
-		z80_max = (odo.z80_max + Z80_CYCLES_PER_LINE);
-		odo.z80_max += Z80_CYCLES_HBLANK;
-		m68k_run();
-		z80_run();
-		// Disable h-blank
-		coo5 &= ~0x04;
-		odo.m68k_max = m68k_max;
-		odo.z80_max = z80_max;
-		m68k_run();
-		z80_run();
-		++ras;
 	}
+	// Run the rest of the last line
+	odo.m68k_max = end;
+	odo.z80_max = z80_cycle(end);
+	PROF_CALL(m68k, m68k_run());
+	PROF_CALL(z80, z80_run());
+	ras = lines;
+	// DAC writes of the frame into dac_data[]
+	dac_resample();
 	// Fill the sound buffers
 	if (sndi)
-		may_want_to_get_sound(sndi);
+		PROF_CALL(sound, may_want_to_get_sound(sndi));
 	fm_timer_callback();
-	md_set(0);
+#ifdef WITH_PROFILE
+	prof.total = (pd_usecs() - prof_frame);
+#endif
 #ifdef WITH_VGMDUMP
 	vgm_dump_frame();
 #endif
@@ -1160,10 +1248,10 @@ int md::may_want_to_get_sound(struct sndinfo *sndi)
 	}
 
   // Add in the stereo FM buffer
-  YM2612UpdateOne(0, sndi->lr, len, dgen_volume, 1);
+  fm_core_update(0, sndi->lr, len, dgen_volume, 1);
   if (dgen_mjazz) {
-    YM2612UpdateOne(1, sndi->lr, len, dgen_volume, 0);
-    YM2612UpdateOne(2, sndi->lr, len, dgen_volume, 0);
+    fm_core_update(1, sndi->lr, len, dgen_volume, 0);
+    fm_core_update(2, sndi->lr, len, dgen_volume, 0);
   }
   return 0;
 }
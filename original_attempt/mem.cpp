@@ -38,6 +38,9 @@ uint8_t md::z80_read(uint16_t a)
  */
 void md::z80_write(uint16_t a, uint8_t d)
 {
+#ifdef WITH_DEBUGGER
+	debug_wp_z80_write(a);
+#endif
 	/* 0x0000-0x3fff: Z80 RAM */
 	if (a <= Z80_RAM_END) {
 		z80ram[(a & 0x1fff)] = d;
@@ -220,7 +223,7 @@ uint8_t md::m68k_VDP_read(uint32_t a)
 		vdp.cmd_pending = false;
 		if ((a & 0x01) == 0)
 			return coo4;
-		return coo5;
+		return coo5_read();
 	}
 	/* HV counters */
 	if (a == 0xc00008)
@@ -404,6 +407,9 @@ void md::misc_writebyte(uint32_t a, uint8_t d)
 {
 	/* clip to 24-bit */
 	a &= 0x00ffffff;
+#ifdef WITH_DEBUGGER
+	debug_wp_m68k_write(a);
+#endif
 	/* 0x000000-0x7fffff: ROM */
 	if (a <= M68K_ROM_END) {
 		m68k_ROM_write(a, d);
@@ -468,7 +474,7 @@ uint16_t md::misc_readword(uint32_t a)
 		if (a < 0xc00008) {
 			if (a & 0x01)
 				return 0;
-			return (((coo4 & 0xff) << 8) | (coo5 & 0xff));
+			return (((coo4 & 0xff) << 8) | (coo5_read() & 0xff));
 		}
 		if (a == 0xc00008) {
 			if (a & 0x01)
@@ -4,6 +4,19 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#ifdef WITH_VGMDUMP
+#include <unistd.h>
+#include <algorithm>
+#ifdef WITH_THREADS
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+#endif
 #include "md.h"
 #include "rc-vars.h"
 
@@ -32,36 +45,13 @@ int md::myfm_write(int a, int v, int md)
 		dac_enable((uint8_t)v);
 		pass = 0;
 	}
-	if (fm_sel[sid] == 0x27) {
-		unsigned int now = frame_usecs();
-
-		if ((v & 0x01) && ((fm_reg[0][0x27] & 0x01) == 0)) {
-			// load timer A
-			fm_ticker[0] = 0;
-			fm_ticker[1] = now;
-		}
-		if ((v & 0x02) && ((fm_reg[0][0x27] & 0x02) == 0)) {
-			// load timer B
-			fm_ticker[2] = 0;
-			fm_ticker[3] = now;
-		}
-		// (v & 0x04) enable/disable timer A
-		// (v & 0x08) enable/disable timer B
-		if (v & 0x10) {
-			// reset overflow A
-			fm_tover &= ~0x01;
-			v &= ~0x10;
-			fm_reg[0][0x27] &= ~0x10;
-		}
-		if (v & 0x20) {
-			// reset overflow B
-			fm_tover &= ~0x02;
-			v &= ~0x20;
-			fm_reg[0][0x27] &= ~0x20;
-		}
-	}
+	if (fm_sel[sid] == 0x27)
+		v = fm_timer_control(v);
 	// stash all values
 	fm_reg[sid][(fm_sel[sid])] = v;
+	// timers loaded or stopped, their next overflow moves
+	if (fm_sel[sid] == 0x27)
+		sched_fm();
 end:
 	if (pass) {
 		// Apply FM corruption if enabled
@@ -105,19 +95,91 @@ end:
 			}
 		}
 		
-		YM2612Write(0, a, corrupted_v);
+		fm_core_write(0, a, corrupted_v);
 		if (dgen_mjazz) {
-			YM2612Write(1, a, corrupted_v);
-			YM2612Write(2, a, corrupted_v);
+			fm_core_write(1, a, corrupted_v);
+			fm_core_write(2, a, corrupted_v);
 		}
 	}
 	return 0;
 }
 
+// Handle a write to register 0x27, return the value to store.
+int md::fm_timer_control(int v)
+{
+	unsigned int now = frame_usecs();
+
+	if ((v & 0x01) && ((fm_reg[0][0x27] & 0x01) == 0)) {
+		// load timer A
+		fm_ticker[0] = 0;
+		fm_ticker[1] = now;
+	}
+	if ((v & 0x02) && ((fm_reg[0][0x27] & 0x02) == 0)) {
+		// load timer B
+		fm_ticker[2] = 0;
+		fm_ticker[3] = now;
+	}
+	// (v & 0x04) enable/disable timer A
+	// (v & 0x08) enable/disable timer B
+	if (v & 0x10) {
+		// reset overflow A
+		fm_tover &= ~0x01;
+		v &= ~0x10;
+		fm_reg[0][0x27] &= ~0x10;
+	}
+	if (v & 0x20) {
+		// reset overflow B
+		fm_tover &= ~0x02;
+		v &= ~0x20;
+		fm_reg[0][0x27] &= ~0x20;
+	}
+	return v;
+}
+
+// Write several registers at once (0x100-0x1ff for the second bank), like
+// myfm_write() without going through fm_sel[] and without FM corruption.
+// The selected registers are left untouched, so the game is not disturbed.
+void md::myfm_write_regs(struct ym2612_reg_write *w, unsigned int n)
+{
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0, j = 0; (i != n); ++i) {
+		unsigned int sid = ((w[i].reg >> 8) & 1);
+		uint8_t reg = w[i].reg;
+		int v = w[i].val;
+
+#ifdef WITH_VGMDUMP
+		vgm_dump_ym2612(sid, reg, v);
+#endif
+		if (reg == 0x27)
+			v = fm_timer_control(v);
+		fm_reg[sid][reg] = v;
+		if (reg == 0x27)
+			sched_fm();
+		if (reg == 0x2a) {
+			dac_submit((uint8_t)v);
+			continue;
+		}
+		if (reg == 0x2b) {
+			dac_enable((uint8_t)v);
+			continue;
+		}
+		w[j].reg = ((sid << 8) | reg);
+		w[j].val = v;
+		++j;
+	}
+	fm_core_write_regs(0, w, j);
+	if (dgen_mjazz) {
+		fm_core_write_regs(1, w, j);
+		fm_core_write_regs(2, w, j);
+	}
+}
+
 int md::myfm_read(int a)
 {
 	fm_timer_callback();
-	return (fm_tover | (YM2612Read(0, (a & 3)) & ~0x03));
+	return (fm_tover | (fm_core_read(0, (a & 3)) & ~0x03));
 }
 
 int md::mysn_write(int d)
@@ -129,13 +191,20 @@ int md::mysn_write(int d)
 	return 0;
 }
 
+// Period in microseconds of timer A (0) or B (1)
+int md::fm_timer_period(int timer)
+{
+	if (timer == 0)
+		return (18 * (1024 -
+			      (((fm_reg[0][0x24] << 2) |
+				(fm_reg[0][0x25] & 0x03)) & 0x3ff)));
+	return (288 * (256 - (fm_reg[0][0x26] & 0xff)));
+}
+
 int md::fm_timer_callback()
 {
-	// periods in microseconds for timers A and B
-	int amax = (18 * (1024 -
-			  (((fm_reg[0][0x24] << 2) |
-			    (fm_reg[0][0x25] & 0x03)) & 0x3ff)));
-	int bmax = (288 * (256 - (fm_reg[0][0x26] & 0xff)));
+	int amax = fm_timer_period(0);
+	int bmax = fm_timer_period(1);
 	unsigned int now = frame_usecs();
 
 	if ((fm_reg[0][0x27] & 0x01) && ((now - fm_ticker[1]) > 0)) {
@@ -165,10 +234,10 @@ void md::fm_reset()
 	fm_tover = 0x00;
 	memset(fm_ticker, 0, sizeof(fm_ticker));
 	memset(fm_reg, 0, sizeof(fm_reg));
-	YM2612ResetChip(0);
+	fm_core_reset(0);
 	if (dgen_mjazz) {
-		YM2612ResetChip(1);
-		YM2612ResetChip(2);
+		fm_core_reset(1);
+		fm_core_reset(2);
 	}
 	SN76496_init(0,
 		     (((pal) ? PAL_MCLK : NTSC_MCLK) / 15),
@@ -179,6 +248,8 @@ void md::dac_init()
 {
 	dac_enabled = true;
 	dac_len = 0;
+	dac_writes_len = 0;
+	dac_corrupt = 0;
 #ifndef NDEBUG
 	memset(dac_data, 0xff, sizeof(dac_data));
 #endif
@@ -192,28 +263,50 @@ static const struct {
 	{ (44100 / 50), (1000000 / 50) },
 };
 
+// Record a DAC write, placed in dac_data[] by dac_resample()
 void md::dac_submit(uint8_t d)
 {
-	unsigned int usecs;
-	unsigned int index;
-	unsigned int i;
+	struct dac_write *w;
 
-	if (!dac_enabled)
+	if ((!dac_enabled) || (dac_writes_len == elemof(dac_writes)))
 		return;
-	if (dac_len == elemof(dac_data))
-		return;
-	usecs = frame_usecs();
-	index = ((usecs << 10) /
-		 ((per_frame[pal].usecs << 10) /
-		  elemof(dac_data)));
-	if (index >= elemof(dac_data))
-		return;
-	dac_data[index] = d;
-	if (dac_len)
-		d = dac_data[dac_len - 1];
-	for (i = dac_len; (i < index); ++i)
-		dac_data[i] = d;
-	dac_len = (index + 1);
+	w = &dac_writes[dac_writes_len++];
+	// Same clock as frame_usecs()
+	w->odo = (z80_st_running ? (z80_odo() | 0x80000000) : m68k_odo());
+	w->d = d;
+}
+
+// Place the writes of the frame in dac_data[], each repeated up to the next
+void md::dac_resample()
+{
+	// dac_data[] entries per Z80 and M68K cycle, 16.16 fixed point
+	uint64_t z80_scale = ((((uint64_t)elemof(dac_data) * 1000000) << 16) /
+			      ((uint64_t)clk0 * per_frame[pal].usecs));
+	uint64_t m68k_scale = ((((uint64_t)elemof(dac_data) * 1000000) << 16) /
+			       ((uint64_t)clk1 * per_frame[pal].usecs));
+	unsigned int i;
+
+	if (dac_corrupt)
+		dac_corrupt_writes();
+	for (i = 0; (i != dac_writes_len); ++i) {
+		const struct dac_write *w = &dac_writes[i];
+		unsigned int index;
+		uint8_t d = w->d;
+
+		if (dac_len == elemof(dac_data))
+			break;
+		index = (((w->odo & 0x7fffffff) *
+			  ((w->odo & 0x80000000) ? z80_scale : m68k_scale)) >> 16);
+		if (index >= elemof(dac_data))
+			continue;
+		dac_data[index] = d;
+		if (index > dac_len)
+			memset(&dac_data[dac_len],
+			       (dac_len ? dac_data[dac_len - 1] : d),
+			       (index - dac_len));
+		dac_len = (index + 1);
+	}
+	dac_writes_len = 0;
 }
 
 void md::dac_enable(uint8_t d)
@@ -223,12 +316,212 @@ void md::dac_enable(uint8_t d)
 
 #ifdef WITH_VGMDUMP
 
+// Commands are stored in memory and written VGM_DUMP_BUF_SIZE bytes at a
+// time, by a separate thread when possible. The emulation thread only
+// waits when it fills a buffer before the previous one is written.
+// Dumps whose name ends with ".vgz" go to a temporary file first, which is
+// compressed once dumping stops (the header must be complete by then).
+#define VGM_DUMP_BUF_SIZE (1 << 20)
+
+struct vgm_dump_writer {
+	FILE *file; // VGM data
+	FILE *vgz; // compressed output or NULL
+	uint8_t *buf[2]; // [0] is filled by md, [1] is written
+	size_t len; // bytes to write from buf[1]
+	uint32_t samples; // total number of samples, known on stop
+	bool error;
+#ifdef WITH_THREADS
+	std::mutex lock;
+	std::condition_variable wake; // busy or stop is set
+	std::condition_variable idle; // busy is cleared
+	std::thread thread;
+	bool busy; // buf[1] is being written
+	bool stop; // no more data, finish the file
+#endif
+};
+
+static void vgm_dump_write(struct vgm_dump_writer *w)
+{
+	if ((w->len) && (fwrite(w->buf[1], w->len, 1, w->file) != 1))
+		w->error = true;
+	w->len = 0;
+}
+
+#ifdef WITH_ZLIB
+
+static bool vgm_dump_compress(struct vgm_dump_writer *w)
+{
+	gzFile gz;
+	size_t len;
+	int fd;
+
+	if ((fseek(w->file, 0, SEEK_SET)) ||
+	    ((fd = dup(fileno(w->vgz))) == -1))
+		return false;
+	if ((gz = gzdopen(fd, "wb9")) == NULL) {
+		close(fd);
+		return false;
+	}
+	// buf[1] is not needed anymore.
+	while ((len = fread(w->buf[1], 1, VGM_DUMP_BUF_SIZE, w->file)) != 0)
+		if (gzwrite(gz, w->buf[1], len) != (int)len)
+			break;
+	if (ferror(w->file) || (len != 0)) {
+		gzclose(gz);
+		return false;
+	}
+	return (gzclose(gz) == Z_OK);
+}
+
+#endif // WITH_ZLIB
+
+// Fill header fields that were not known on start, compress and close.
+static void vgm_dump_finish(struct vgm_dump_writer *w)
+{
+	long pos;
+	uint32_t tmp;
+
+	vgm_dump_write(w);
+	pos = ftell(w->file);
+	// Fill EoF offset.
+	tmp = h2le32(pos - 4);
+	if ((fseek(w->file, 0x04, SEEK_SET)) ||
+	    (fwrite(&tmp, sizeof(tmp), 1, w->file) != 1))
+		w->error = true;
+	// Fill total number of samples.
+	tmp = h2le32(w->samples);
+	if ((fseek(w->file, 0x18, SEEK_SET)) ||
+	    (fwrite(&tmp, sizeof(tmp), 1, w->file) != 1))
+		w->error = true;
+#ifdef WITH_ZLIB
+	if ((w->vgz != NULL) && (!vgm_dump_compress(w)))
+		w->error = true;
+#endif
+	if (fclose(w->file))
+		w->error = true;
+	if ((w->vgz != NULL) && (fclose(w->vgz)))
+		w->error = true;
+	if (w->error)
+		fprintf(stderr, "vgm: error while writing VGM dump.\n");
+}
+
+#ifdef WITH_THREADS
+
+static void vgm_dump_thread(struct vgm_dump_writer *w)
+{
+	std::unique_lock<std::mutex> hold(w->lock);
+
+	while (w->wake.wait(hold, [w] { return (w->busy || w->stop); }),
+	       w->busy) {
+		hold.unlock();
+		vgm_dump_write(w);
+		hold.lock();
+		w->busy = false;
+		w->idle.notify_all();
+	}
+	hold.unlock();
+	vgm_dump_finish(w);
+}
+
+#endif // WITH_THREADS
+
+static void vgm_dump_free(struct vgm_dump_writer *w)
+{
+	if (w == NULL)
+		return;
+#ifdef WITH_THREADS
+	if (w->thread.joinable())
+		w->thread.join();
+#endif
+	free(w->buf[0]);
+	free(w->buf[1]);
+	delete w;
+}
+
+// Hand the filled buffer over to the writer.
+void md::vgm_dump_submit()
+{
+	struct vgm_dump_writer *w = vgm_dump_writer;
+
+#ifdef WITH_THREADS
+	if (w->thread.joinable()) {
+		std::unique_lock<std::mutex> hold(w->lock);
+
+		w->idle.wait(hold, [w] { return (!w->busy); });
+		std::swap(w->buf[0], w->buf[1]);
+		w->len = vgm_dump_len;
+		w->busy = true;
+		hold.unlock();
+		w->wake.notify_one();
+	}
+	else
+#endif
+	{
+		std::swap(w->buf[0], w->buf[1]);
+		w->len = vgm_dump_len;
+		vgm_dump_write(w);
+	}
+	vgm_dump_buf = w->buf[0];
+	vgm_dump_len = 0;
+}
+
+// Append a command, after the pending wait.
+void md::vgm_dump_put(const uint8_t *data, size_t len)
+{
+	if (vgm_dump_wait)
+		vgm_dump_flush_wait();
+	if ((vgm_dump_len + len) > VGM_DUMP_BUF_SIZE)
+		vgm_dump_submit();
+	memcpy(&vgm_dump_buf[vgm_dump_len], data, len);
+	vgm_dump_len += len;
+}
+
+// Consecutive waits are merged, write them as a few commands as possible.
+void md::vgm_dump_flush_wait()
+{
+	while (vgm_dump_wait) {
+		uint8_t buf[3];
+		size_t len;
+		uint32_t n = vgm_dump_wait;
+
+		if (n == 735) {
+			// 1/60th of a second.
+			buf[0] = 0x62;
+			len = 1;
+		}
+		else if (n == 882) {
+			// 1/50th of a second.
+			buf[0] = 0x63;
+			len = 1;
+		}
+		else if (n <= 16) {
+			buf[0] = (0x70 + (n - 1));
+			len = 1;
+		}
+		else {
+			uint16_t tmp;
+
+			if (n > 0xffff)
+				n = 0xffff;
+			tmp = h2le16(n);
+			buf[0] = 0x61;
+			memcpy(&buf[1], &tmp, sizeof(tmp));
+			len = 3;
+		}
+		vgm_dump_wait -= n;
+		if ((vgm_dump_len + len) > VGM_DUMP_BUF_SIZE)
+			vgm_dump_submit();
+		memcpy(&vgm_dump_buf[vgm_dump_len], buf, len);
+		vgm_dump_len += len;
+	}
+}
+
 void md::vgm_dump_ym2612(uint8_t a1, uint8_t reg, uint8_t data)
 {
 	if (vgm_dump) {
 		uint8_t buf[] = { (uint8_t)(0x52 + a1), reg, data };
 
-		fwrite(buf, sizeof(buf), 1, vgm_dump_file);
+		vgm_dump_put(buf, sizeof(buf));
 		if ((a1 == 0) && (reg == 0x2a)) {
 			unsigned int usecs = frame_usecs();
 			unsigned int samples;
@@ -241,7 +534,7 @@ void md::vgm_dump_ym2612(uint8_t a1, uint8_t reg, uint8_t data)
 				     per_frame[pal].usecs)) >> 20);
 			diff = (samples - vgm_dump_dac_samples);
 			if ((diff > 0) && (diff <= 16)) {
-				fputc((0x70 + (diff - 1)), vgm_dump_file);
+				vgm_dump_wait += diff;
 				vgm_dump_dac_wait += diff;
 			}
 			vgm_dump_dac_samples = samples;
@@ -254,7 +547,7 @@ void md::vgm_dump_sn76496(uint8_t data)
 	if (vgm_dump) {
 		uint8_t buf[] = { 0x50, data };
 
-		fwrite(buf, sizeof(buf), 1, vgm_dump_file);
+		vgm_dump_put(buf, sizeof(buf));
 	}
 }
 
@@ -264,13 +557,8 @@ void md::vgm_dump_frame()
 
 	if (!vgm_dump)
 		return;
-	if (vgm_dump_dac_wait < max) {
-		uint8_t buf[] = { 0x61, 0x00, 0x00 };
-		uint16_t tmp = h2le16(max - vgm_dump_dac_wait);
-
-		memcpy(&buf[1], &tmp, sizeof(tmp));
-		fwrite(buf, sizeof(buf), 1, vgm_dump_file);
-	}
+	if (vgm_dump_dac_wait < max)
+		vgm_dump_wait += (max - vgm_dump_dac_wait);
 	vgm_dump_samples_total += max;
 	vgm_dump_dac_wait = 0;
 	vgm_dump_dac_samples = 0;
@@ -280,6 +568,10 @@ void md::vgm_dump_frame()
 // http://www.smspower.org/uploads/Music/vgmspec170.txt
 int md::vgm_dump_start(const char *name)
 {
+	struct vgm_dump_writer *w;
+	size_t name_len = strlen(name);
+	bool vgz = ((name_len >= 4) &&
+		    (!strcasecmp(&name[(name_len - 4)], ".vgz")));
 	uint8_t ym2612_buf[0x200];
 	uint8_t buf[0x100] = { 0 };
 	union {
@@ -291,9 +583,44 @@ int md::vgm_dump_start(const char *name)
 
 	if (vgm_dump == true)
 		vgm_dump_stop();
-	vgm_dump_file = dgen_fopen("vgm", name, DGEN_WRITE);
-	if (vgm_dump_file == NULL)
+	vgm_dump_join();
+#ifndef WITH_ZLIB
+	if (vgz) {
+		errno = ENOSYS;
+		return -1;
+	}
+#endif
+	w = new struct vgm_dump_writer();
+	w->buf[0] = (uint8_t *)malloc(VGM_DUMP_BUF_SIZE);
+	w->buf[1] = (uint8_t *)malloc(VGM_DUMP_BUF_SIZE);
+	if ((w->buf[0] == NULL) || (w->buf[1] == NULL)) {
+		vgm_dump_free(w);
+		errno = ENOMEM;
+		return -1;
+	}
+	if (vgz) {
+		if ((w->vgz = dgen_fopen("vgm", name, DGEN_WRITE)) == NULL) {
+			err = errno;
+			vgm_dump_free(w);
+			errno = err;
+			return -1;
+		}
+		w->file = tmpfile();
+	}
+	else
+		w->file = dgen_fopen("vgm", name, DGEN_WRITE);
+	if (w->file == NULL) {
+		err = errno;
+		if (w->vgz != NULL)
+			fclose(w->vgz);
+		vgm_dump_free(w);
+		errno = err;
 		return -1;
+	}
+	vgm_dump_writer = w;
+	vgm_dump_buf = w->buf[0];
+	vgm_dump_len = 0;
+	vgm_dump_wait = 0;
 	// 0x00: file identifier.
 	memcpy(&buf[0x00], "Vgm ", 4);
 	// 0x04: EoF offset. Not known yet.
@@ -321,10 +648,9 @@ int md::vgm_dump_start(const char *name)
 	tmp.u32 = h2le32(sizeof(buf) - 0x34);
 	memcpy(&buf[0x34], &tmp.u32, 4);
 	// Dump VGM header.
-	if (fwrite(buf, sizeof(buf), 1, vgm_dump_file) != 1)
-		goto error;
+	vgm_dump_put(buf, sizeof(buf));
 	// Dump YM2612 registers directly.
-	YM2612_dump(0, ym2612_buf);
+	fm_core_dump(0, ym2612_buf);
 	// Timers.
 	{
 		uint8_t buf[] = {
@@ -334,15 +660,13 @@ int md::vgm_dump_start(const char *name)
 			0x52, 0x27, (uint8_t)fm_reg[0][0x27],
 		};
 
-		if (fwrite(buf, sizeof(buf), 1, vgm_dump_file) != 1)
-			goto error;
+		vgm_dump_put(buf, sizeof(buf));
 	}
 	// DAC.
 	{
 		uint8_t buf[] = { 0x52, 0x2b, (uint8_t)(dac_enabled << 7) };
 
-		if (fwrite(buf, sizeof(buf), 1, vgm_dump_file) != 1)
-			goto error;
+		vgm_dump_put(buf, sizeof(buf));
 	}
 	// FM CH1-CH3.
 	for (i = 0x30; (i != 0x9e); ++i) {
@@ -351,8 +675,7 @@ int md::vgm_dump_start(const char *name)
 			0x53, (uint8_t)i, ym2612_buf[i | 0x100],
 		};
 
-		if (fwrite(buf, sizeof(buf), 1, vgm_dump_file) != 1)
-			goto error;
+		vgm_dump_put(buf, sizeof(buf));
 	}
 	// FM CH4-CH6.
 	for (i = 0xb0; (i != 0xb6); ++i) {
@@ -361,46 +684,59 @@ int md::vgm_dump_start(const char *name)
 			0x53, (uint8_t)i, ym2612_buf[i | 0x100],
 		};
 
-		if (fwrite(buf, sizeof(buf), 1, vgm_dump_file) != 1)
-			goto error;
+		vgm_dump_put(buf, sizeof(buf));
+	}
+#ifdef WITH_THREADS
+	try {
+		w->thread = std::thread(vgm_dump_thread, w);
+	}
+	catch (const std::system_error &) {
+		// Buffers are then written by vgm_dump_submit() directly.
 	}
+#endif
 	vgm_dump_samples_total = 0;
 	vgm_dump_dac_wait = 0;
 	vgm_dump_dac_samples = 0;
 	vgm_dump = true;
 	return 0;
-error:
-	err = errno;
-	fclose(vgm_dump_file);
-	vgm_dump_file = NULL;
-	errno = err;
-	return -1;
 }
 
+// The file is finished in the background, see vgm_dump_join().
 void md::vgm_dump_stop()
 {
-	long pos;
-	uint32_t tmp;
+	struct vgm_dump_writer *w = vgm_dump_writer;
+	uint8_t end = 0x66;
 
 	if (!vgm_dump)
 		return;
 	// Append end of sound data.
-	fputc(0x66, vgm_dump_file);
-	pos = ftell(vgm_dump_file);
-	// Fill EoF offset.
-	fseek(vgm_dump_file, 0x04, SEEK_SET);
-	tmp = h2le32(pos - 4);
-	fwrite(&tmp, sizeof(tmp), 1, vgm_dump_file);
-	// Fill total number of samples.
-	fseek(vgm_dump_file, 0x18, SEEK_SET);
-	tmp = h2le32(vgm_dump_samples_total);
-	fwrite(&tmp, sizeof(tmp), 1, vgm_dump_file);
-	fclose(vgm_dump_file);
-	vgm_dump_file = NULL;
+	vgm_dump_put(&end, sizeof(end));
+	vgm_dump_submit();
+	w->samples = vgm_dump_samples_total;
+#ifdef WITH_THREADS
+	if (w->thread.joinable()) {
+		w->lock.lock();
+		w->stop = true;
+		w->lock.unlock();
+		w->wake.notify_one();
+	}
+	else
+#endif
+		vgm_dump_finish(w);
+	vgm_dump_buf = NULL;
+	vgm_dump_len = 0;
+	vgm_dump_wait = 0;
 	vgm_dump_samples_total = 0;
 	vgm_dump_dac_wait = 0;
 	vgm_dump_dac_samples = 0;
 	vgm_dump = false;
 }
 
+// Wait until the last dump is completely written.
+void md::vgm_dump_join()
+{
+	vgm_dump_free(vgm_dump_writer);
+	vgm_dump_writer = NULL;
+}
+
 #endif // WITH_VGMDUMP
@@ -47,6 +47,17 @@ unsigned int pd_sound_rp();
 unsigned int pd_sound_wp();
 // And this function is called to commit the sound buffers to be played.
 void pd_sound_write();
+// Playback buffer state for frame pacing: samples queued, the most that can
+// be, callbacks that found too few and samples dropped because the buffer was
+// full. The counters are reset by each call.
+struct sound_stats
+{
+	unsigned int level;
+	unsigned int size;
+	unsigned int underruns;
+	unsigned int dropped;
+};
+void pd_sound_stats(struct sound_stats *stats);
 
 // Register platform-specific rc variables
 void pd_rc();
@@ -71,6 +82,13 @@ int pd_stopped();
 // If true, stop emulation (display last frame repeatedly).
 extern bool pd_freeze;
 
+// If true, run several frames per displayed frame (see
+// int_fast_forward_frames).
+extern bool pd_fast_forward;
+
+// If true, step back through the rewind buffer (see int_rewind_interval).
+extern bool pd_rewind;
+
 // These are called to display and clear game messages.
 void pd_message(const char *fmt, ...);
 void pd_clear_message();
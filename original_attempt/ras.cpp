@@ -55,234 +55,351 @@ static inline int get_word(unsigned char *where)
   { return (where[0] << 8) | where[1]; }
 #endif
 
-// Tile pixel masks
-#ifdef WORDS_BIGENDIAN
-#  define PIXEL0 (0xf0000000)
-#  define PIXEL1 (0x0f000000)
-#  define PIXEL2 (0x00f00000)
-#  define PIXEL3 (0x000f0000)
-#  define PIXEL4 (0x0000f000)
-#  define PIXEL5 (0x00000f00)
-#  define PIXEL6 (0x000000f0)
-#  define PIXEL7 (0x0000000f)
-#  define SHIFT0 (28)
-#  define SHIFT1 (24)
-#  define SHIFT2 (20)
-#  define SHIFT3 (16)
-#  define SHIFT4 (12)
-#  define SHIFT5 ( 8)
-#  define SHIFT6 ( 4)
-#  define SHIFT7 ( 0)
-#else // WORDS_BIGENDIAN
-#  define PIXEL0 (0x000000f0)
-#  define PIXEL1 (0x0000000f)
-#  define PIXEL2 (0x0000f000)
-#  define PIXEL3 (0x00000f00)
-#  define PIXEL4 (0x00f00000)
-#  define PIXEL5 (0x000f0000)
-#  define PIXEL6 (0xf0000000)
-#  define PIXEL7 (0x0f000000)
-#  define SHIFT0 ( 4)
-#  define SHIFT1 ( 0)
-#  define SHIFT2 (12)
-#  define SHIFT3 ( 8)
-#  define SHIFT4 (20)
-#  define SHIFT5 (16)
-#  define SHIFT6 (28)
-#  define SHIFT7 (24)
-#endif // WORDS_BIGENDIAN
-
-#ifdef WITH_X86_TILES
-extern "C" {
-
-void asm_tiles_init(unsigned char *vram,
-		    unsigned char *reg,
-		    unsigned *highpal);
-
-void drawtile1(int which, int line, unsigned char *where);
-void drawtile1_solid(int which, int line, unsigned char *where);
-void drawtile2(int which, int line, unsigned char *where);
-void drawtile2_solid(int which, int line, unsigned char *where);
-void drawtile3(int which, int line, unsigned char *where);
-void drawtile3_solid(int which, int line, unsigned char *where);
-void drawtile4(int which, int line, unsigned char *where);
-void drawtile4_solid(int which, int line, unsigned char *where);
+// Tiles are blitted from tile_cache[], where every VRAM row of 8 pixels is
+// decoded to one byte per pixel. The blitters take 8 bytes at once, a byte
+// swap handles x flip, and at 16 and 32 bpp the palette expansion is done
+// with byte shuffles through tile_planes[] when the CPU has them (SSSE3 on
+// x86, always on arm64).
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TILES_SSSE3 __attribute__((target("ssse3")))
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define TILES_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(TILES_SSSE3) || defined(TILES_NEON)
+#define TILES_SIMD
+#endif
+
+// Whether the shuffle blitters are usable, checked when Bpp is set
+static bool tiles_simd;
+
+static bool tiles_simd_supported()
+{
+#if defined(TILES_SSSE3)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3");
+#elif defined(TILES_NEON)
+	return true;
+#else
+	return false;
+#endif
 }
 
-// Pass off these calls to assembler counterparts
-inline void md_vdp::draw_tile1_solid(int which, int line, unsigned char *where)
-  { drawtile1_solid(which, line, where); }
+// What the expanders do with color 0
+enum tile_fill {
+	TILE_OPAQUE, // no color 0 in this row
+	TILE_BG, // draw the background color
+	TILE_KEEP // leave the destination alone
+};
 
-inline void md_vdp::draw_tile1(int which, int line, unsigned char *where)
-  { drawtile1(which, line, where); }
+static inline uint64_t tile_swap(uint64_t px)
+{
+#ifdef __GNUC__
+	return __builtin_bswap64(px);
+#else
+	px = (((px & 0x00ff00ff00ff00ffULL) << 8) |
+	      ((px >> 8) & 0x00ff00ff00ff00ffULL));
+	px = (((px & 0x0000ffff0000ffffULL) << 16) |
+	      ((px >> 16) & 0x0000ffff0000ffffULL));
+	return ((px << 32) | (px >> 32));
+#endif
+}
 
-inline void md_vdp::draw_tile2_solid(int which, int line, unsigned char *where)
-  { drawtile2_solid(which, line, where); }
+// Color of pixel 'n' in a tile_row() value
+#ifdef WORDS_BIGENDIAN
+#define TILE_PIXEL(px, n) (((px) >> (56 - ((n) << 3))) & 0xff)
+#else
+#define TILE_PIXEL(px, n) (((px) >> ((n) << 3)) & 0xff)
+#endif
 
-inline void md_vdp::draw_tile2(int which, int line, unsigned char *where)
-  { drawtile2(which, line, where); }
+// Unrolled rows for the plain C blitters, every pixel or only those that
+// aren't color 0, see TILE_PUT*() for 'put'
+#define TILE_ALL(put) \
+	do { put(0); put(1); put(2); put(3); \
+	     put(4); put(5); put(6); put(7); } while (0)
+#define TILE_SET(put) \
+	do { \
+		if (TILE_PIXEL(px, 0)) put(0); \
+		if (TILE_PIXEL(px, 1)) put(1); \
+		if (TILE_PIXEL(px, 2)) put(2); \
+		if (TILE_PIXEL(px, 3)) put(3); \
+		if (TILE_PIXEL(px, 4)) put(4); \
+		if (TILE_PIXEL(px, 5)) put(5); \
+		if (TILE_PIXEL(px, 6)) put(6); \
+		if (TILE_PIXEL(px, 7)) put(7); \
+	} while (0)
+#define TILE_PUT(n) (wwhere[n] = pal[TILE_PIXEL(px, n)])
+#define TILE_PUT24(n) \
+	u24cpy(&wwhere[n], (uint24_t *)&pal[TILE_PIXEL(px, n)])
+
+// Nonzero if one of the 8 pixels is color 0
+static inline uint64_t tile_has_zero(uint64_t px)
+{
+	return ((px - 0x0101010101010101ULL) & ~px & 0x8080808080808080ULL);
+}
 
-inline void md_vdp::draw_tile3_solid(int which, int line, unsigned char *where)
-  { drawtile3_solid(which, line, where); }
+#ifdef TILES_SSSE3
 
-inline void md_vdp::draw_tile3(int which, int line, unsigned char *where)
-  { drawtile3(which, line, where); }
+TILES_SSSE3
+static void tile_expand2_ssse3(uint8_t *where, uint64_t px,
+			       const uint8_t (*planes)[16], enum tile_fill fill,
+			       unsigned int bg)
+{
+	__m128i idx = _mm_loadl_epi64((const __m128i *)&px);
+	__m128i lo = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[0]),
+				      idx);
+	__m128i hi = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[1]),
+				      idx);
+	__m128i out = _mm_unpacklo_epi8(lo, hi);
+
+	if (fill != TILE_OPAQUE) {
+		__m128i m = _mm_cmpeq_epi8(idx, _mm_setzero_si128());
+		__m128i under = ((fill == TILE_BG) ?
+				 _mm_set1_epi16((short)bg) :
+				 _mm_loadu_si128((__m128i *)where));
+
+		m = _mm_unpacklo_epi8(m, m);
+		out = _mm_or_si128(_mm_andnot_si128(m, out),
+				   _mm_and_si128(m, under));
+	}
+	_mm_storeu_si128((__m128i *)where, out);
+}
 
-inline void md_vdp::draw_tile4_solid(int which, int line, unsigned char *where)
-  { drawtile4_solid(which, line, where); }
+TILES_SSSE3
+static void tile_expand4_ssse3(uint8_t *where, uint64_t px,
+			       const uint8_t (*planes)[16], enum tile_fill fill,
+			       unsigned int bg)
+{
+	__m128i idx = _mm_loadl_epi64((const __m128i *)&px);
+	__m128i p0 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[0]),
+				      idx);
+	__m128i p1 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[1]),
+				      idx);
+	__m128i p2 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[2]),
+				      idx);
+	__m128i p3 = _mm_shuffle_epi8(_mm_loadu_si128((__m128i *)planes[3]),
+				      idx);
+	__m128i p01 = _mm_unpacklo_epi8(p0, p1);
+	__m128i p23 = _mm_unpacklo_epi8(p2, p3);
+	__m128i out0 = _mm_unpacklo_epi16(p01, p23);
+	__m128i out1 = _mm_unpackhi_epi16(p01, p23);
+
+	if (fill != TILE_OPAQUE) {
+		__m128i m = _mm_cmpeq_epi8(idx, _mm_setzero_si128());
+		__m128i under0;
+		__m128i under1;
+
+		if (fill == TILE_BG)
+			under0 = under1 = _mm_set1_epi32((int)bg);
+		else {
+			under0 = _mm_loadu_si128((__m128i *)&where[0]);
+			under1 = _mm_loadu_si128((__m128i *)&where[16]);
+		}
+		m = _mm_unpacklo_epi8(m, m);
+		__m128i m0 = _mm_unpacklo_epi16(m, m);
+		__m128i m1 = _mm_unpackhi_epi16(m, m);
+
+		out0 = _mm_or_si128(_mm_andnot_si128(m0, out0),
+				    _mm_and_si128(m0, under0));
+		out1 = _mm_or_si128(_mm_andnot_si128(m1, out1),
+				    _mm_and_si128(m1, under1));
+	}
+	_mm_storeu_si128((__m128i *)&where[0], out0);
+	_mm_storeu_si128((__m128i *)&where[16], out1);
+}
 
-inline void md_vdp::draw_tile4(int which, int line, unsigned char *where)
-  { drawtile4(which, line, where); }
+#define tile_expand2 tile_expand2_ssse3
+#define tile_expand4 tile_expand4_ssse3
 
-#else // WITH_X86_TILES
+#endif // TILES_SSSE3
 
-static bool has_zero_nibbles(uint32_t u32)
+#ifdef TILES_NEON
+
+static void tile_expand2_neon(uint8_t *where, uint64_t px,
+			      const uint8_t (*planes)[16], enum tile_fill fill,
+			      unsigned int bg)
 {
-	return ((u32 - 0x11111111) & ~u32 & 0x88888888);
+	uint8x8_t idx = vcreate_u8(px);
+	uint8x8x2_t out;
+
+	out.val[0] = vqtbl1_u8(vld1q_u8(planes[0]), idx);
+	out.val[1] = vqtbl1_u8(vld1q_u8(planes[1]), idx);
+	if (fill != TILE_OPAQUE) {
+		uint8x8_t m = vceq_u8(idx, vdup_n_u8(0));
+		uint8x8x2_t under;
+
+		if (fill == TILE_BG) {
+			uint8_t b[2];
+			uint16_t v = bg;
+
+			memcpy(b, &v, sizeof(b));
+			under.val[0] = vdup_n_u8(b[0]);
+			under.val[1] = vdup_n_u8(b[1]);
+		}
+		else
+			under = vld2_u8(where);
+		out.val[0] = vbsl_u8(m, under.val[0], out.val[0]);
+		out.val[1] = vbsl_u8(m, under.val[1], out.val[1]);
+	}
+	vst2_u8(where, out);
 }
 
-// Blit tile solidly, for 1 byte-per-pixel
-inline void md_vdp::draw_tile1_solid(int which, int line, unsigned char *where)
+static void tile_expand4_neon(uint8_t *where, uint64_t px,
+			      const uint8_t (*planes)[16], enum tile_fill fill,
+			      unsigned int bg)
 {
-  unsigned tile, pal;
+	uint8x8_t idx = vcreate_u8(px);
+	uint8x8x4_t out;
+	unsigned int i;
+
+	for (i = 0; (i != 4); ++i)
+		out.val[i] = vqtbl1_u8(vld1q_u8(planes[i]), idx);
+	if (fill != TILE_OPAQUE) {
+		uint8x8_t m = vceq_u8(idx, vdup_n_u8(0));
+		uint8x8x4_t under;
+
+		if (fill == TILE_BG) {
+			uint8_t b[4];
+			uint32_t v = bg;
+
+			memcpy(b, &v, sizeof(b));
+			for (i = 0; (i != 4); ++i)
+				under.val[i] = vdup_n_u8(b[i]);
+		}
+		else
+			under = vld4_u8(where);
+		for (i = 0; (i != 4); ++i)
+			out.val[i] = vbsl_u8(m, under.val[i], out.val[i]);
+	}
+	vst4_u8(where, out);
+}
 
-  pal = (which >> 9 & 0x30); // Determine which 16-color palette
+#define tile_expand2 tile_expand2_neon
+#define tile_expand4 tile_expand4_neon
 
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
+#endif // TILES_NEON
 
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
+// Decode the VRAM blocks marked in dirt[0x00-0x1f] into tile_cache[].
+// Nothing else reads these bits, they are cleared here.
+void md_vdp::tile_cache_update()
+{
+  unsigned byt, bit, i;
 
-  // Blit the tile!
-  if(which & 0x800) // x flipped
+  for(byt = 0; byt < 0x20; ++byt)
     {
-      *(where  ) = ((tile & PIXEL7)>>SHIFT7) | pal;
-      *(where+1) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      *(where+2) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      *(where+3) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      *(where+4) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      *(where+5) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      *(where+6) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      *(where+7) = ((tile & PIXEL0)>>SHIFT0) | pal;
-    } else {
-      *(where  ) = ((tile & PIXEL0)>>SHIFT0) | pal;
-      *(where+1) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      *(where+2) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      *(where+3) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      *(where+4) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      *(where+5) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      *(where+6) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      *(where+7) = ((tile & PIXEL7)>>SHIFT7) | pal;
+      if(!dirt[byt]) continue;
+      for(bit = 0; bit < 8; ++bit)
+	{
+	  if(!(dirt[byt] & (1 << bit))) continue;
+	  // 256 bytes of VRAM, 512 pixels
+	  unsigned block = ((byt << 3) | bit);
+	  const uint8_t *src = (vram + (block << 8));
+	  uint8_t *dst = (tile_cache + (block << 9));
+
+	  for(i = 0; i < 0x100; ++i)
+	    {
+	      dst[(i << 1)] = (src[i] >> 4);
+	      dst[(i << 1) + 1] = (src[i] & 0x0f);
+	    }
+	}
+      dirt[byt] = 0;
     }
 }
 
-// Blit tile, leaving color zero transparent, for 1 byte per pixel
-inline void md_vdp::draw_tile1(int which, int line, unsigned char *where)
+// Split highpal[] into byte planes for the shuffle blitters
+void md_vdp::tile_planes_update()
 {
-  unsigned tile, pal;
+  unsigned i, j;
 
-  pal = (which >> 9 & 0x30); // Determine which 16-color palette
+  for(i = 0; i < 64; ++i)
+    {
+      uint8_t b[4];
+
+      if(Bpp == 2)
+	{
+	  uint16_t v = highpal[i];
+	  memcpy(b, &v, 2);
+	  b[2] = b[3] = 0;
+	}
+      else
+	{
+	  uint32_t v = highpal[i];
+	  memcpy(b, &v, 4);
+	}
+      for(j = 0; j < 4; ++j)
+	tile_planes[(i >> 4)][j][(i & 15)] = b[j];
+    }
+}
+
+// One line of a tile from tile_cache[], pixel 0 in the first byte
+inline uint64_t md_vdp::tile_row(int which, int line)
+{
+  unsigned row;
+  uint64_t px;
 
   if(which & 0x1000) // y flipped
     line ^= 7; // take from the bottom, instead of the top
 
   if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
+    row = (((which & 0x7ff) << 4) + (line << 1));
   else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
-  // If the tile is all 0's, why waste the time?
-  if(!tile) return;
+    row = (((which & 0x7ff) << 3) + line);
+  // 8x16 tiles past 0x3ff wrap around VRAM
+  memcpy(&px, (tile_cache + ((row & 0x3fff) << 3)), sizeof(px));
+  if(which & 0x800) // x flipped
+    px = tile_swap(px);
+  return px;
+}
 
-  // If the tile doesn't have any transparent pixels, draw it solidly.
-  if (!has_zero_nibbles(tile)) {
-    if (which & 0x800) {
-      // x flipped
-      *(where  ) = ((tile & PIXEL7)>>SHIFT7) | pal;
-      *(where+1) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      *(where+2) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      *(where+3) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      *(where+4) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      *(where+5) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      *(where+6) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      *(where+7) = ((tile & PIXEL0)>>SHIFT0) | pal;
-    }
-    else {
-      *(where  ) = ((tile & PIXEL0)>>SHIFT0) | pal;
-      *(where+1) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      *(where+2) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      *(where+3) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      *(where+4) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      *(where+5) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      *(where+6) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      *(where+7) = ((tile & PIXEL7)>>SHIFT7) | pal;
-    }
-    return;
-  }
+// Blit tile solidly, for 1 byte-per-pixel
+inline void md_vdp::draw_tile1_solid(int which, int line, unsigned char *where)
+{
+  uint64_t px = tile_row(which, line);
 
-  // Blit the tile!
-  if(which & 0x800) // x flipped
-    {
-      if(tile & PIXEL7) *(where  ) = ((tile & PIXEL7)>>SHIFT7) | pal;
-      if(tile & PIXEL6) *(where+1) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      if(tile & PIXEL5) *(where+2) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      if(tile & PIXEL4) *(where+3) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      if(tile & PIXEL3) *(where+4) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      if(tile & PIXEL2) *(where+5) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      if(tile & PIXEL1) *(where+6) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      if(tile & PIXEL0) *(where+7) = ((tile & PIXEL0)>>SHIFT0) | pal;
-    } else {
-      if(tile & PIXEL0) *(where  ) = ((tile & PIXEL0)>>SHIFT0) | pal;
-      if(tile & PIXEL1) *(where+1) = ((tile & PIXEL1)>>SHIFT1) | pal;
-      if(tile & PIXEL2) *(where+2) = ((tile & PIXEL2)>>SHIFT2) | pal;
-      if(tile & PIXEL3) *(where+3) = ((tile & PIXEL3)>>SHIFT3) | pal;
-      if(tile & PIXEL4) *(where+4) = ((tile & PIXEL4)>>SHIFT4) | pal;
-      if(tile & PIXEL5) *(where+5) = ((tile & PIXEL5)>>SHIFT5) | pal;
-      if(tile & PIXEL6) *(where+6) = ((tile & PIXEL6)>>SHIFT6) | pal;
-      if(tile & PIXEL7) *(where+7) = ((tile & PIXEL7)>>SHIFT7) | pal;
-    }
+  px |= ((uint64_t)(which >> 9 & 0x30) * 0x0101010101010101ULL);
+  memcpy(where, &px, sizeof(px));
+}
+
+// Blit tile, leaving color zero transparent, for 1 byte per pixel
+inline void md_vdp::draw_tile1(int which, int line, unsigned char *where)
+{
+  uint64_t px = tile_row(which, line);
+  uint64_t pal = ((uint64_t)(which >> 9 & 0x30) * 0x0101010101010101ULL);
+  uint64_t mask, out;
+
+  // If the tile is all 0's, why waste the time?
+  if(!px) return;
+  // Colors are 0-15, bit 7 of a byte is set if it's not 0
+  mask = ((px + 0x7f7f7f7f7f7f7f7fULL) & 0x8080808080808080ULL);
+  mask = ((mask >> 7) * 0xff);
+  memcpy(&out, where, sizeof(out));
+  out = ((out & ~mask) | ((px | pal) & mask));
+  memcpy(where, &out, sizeof(out));
 }
 
 // Blit tile solidly, for 2 byte-per-pixel
 inline void md_vdp::draw_tile2_solid(int which, int line, unsigned char *where)
 {
-  unsigned tile, temp, *pal;
-  unsigned short *wwhere = (unsigned short*)where;
+  uint64_t px = tile_row(which, line);
+  unsigned temp, *pal;
+  unsigned short *wwhere = (unsigned short *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
-  temp = *pal; *pal = highpal[reg[7]&0x3f]; // Get background color
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
+#ifdef TILES_SIMD
+  if(tiles_simd)
     {
-      *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    } else {
-      *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
+      tile_expand2(where, px, tile_planes[(which >> 13 & 3)],
+		   (tile_has_zero(px) ? TILE_BG : TILE_OPAQUE),
+		   highpal[reg[7]&0x3f]);
+      return;
     }
+#endif
+  temp = *pal; *pal = highpal[reg[7]&0x3f]; // Get background color
+  TILE_ALL(TILE_PUT);
   // Restore the original color
   *pal = temp;
 }
@@ -290,247 +407,76 @@ inline void md_vdp::draw_tile2_solid(int which, int line, unsigned char *where)
 // Blit tile, leaving color zero transparent, for 2 byte per pixel
 inline void md_vdp::draw_tile2(int which, int line, unsigned char *where)
 {
-  unsigned tile, *pal;
-  unsigned short *wwhere = (unsigned short*)where;
+  uint64_t px = tile_row(which, line);
+  unsigned *pal;
+  unsigned short *wwhere = (unsigned short *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
   // If the tile is all 0's, why waste the time?
-  if(!tile) return;
-
-  // If the tile doesn't have any transparent pixels, draw it solidly.
-  if (!has_zero_nibbles(tile)) {
-    if (which & 0x800) {
-      // x flipped
-      *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    }
-    else {
-      *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
-    }
-    return;
-  }
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
+  if(!px) return;
+#ifdef TILES_SIMD
+  if(tiles_simd)
     {
-      if(tile & PIXEL7) *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      if(tile & PIXEL6) *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      if(tile & PIXEL5) *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      if(tile & PIXEL4) *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      if(tile & PIXEL3) *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      if(tile & PIXEL2) *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      if(tile & PIXEL1) *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      if(tile & PIXEL0) *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    } else {
-      if(tile & PIXEL0) *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      if(tile & PIXEL1) *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      if(tile & PIXEL2) *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      if(tile & PIXEL3) *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      if(tile & PIXEL4) *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      if(tile & PIXEL5) *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      if(tile & PIXEL6) *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      if(tile & PIXEL7) *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
+      tile_expand2(where, px, tile_planes[(which >> 13 & 3)],
+		   (tile_has_zero(px) ? TILE_KEEP : TILE_OPAQUE), 0);
+      return;
     }
+#endif
+  // If the tile doesn't have any transparent pixels, draw it solidly.
+  if(!tile_has_zero(px))
+    TILE_ALL(TILE_PUT);
+  else
+    TILE_SET(TILE_PUT);
 }
 
 inline void md_vdp::draw_tile3_solid(int which, int line, unsigned char *where)
 {
-  unsigned tile, temp, *pal;
+  uint64_t px = tile_row(which, line);
+  unsigned temp, *pal;
   uint24_t *wwhere = (uint24_t *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
   temp = *pal; *pal = highpal[reg[7]&0x3f]; // Get background color
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
-    {
-      u24cpy(&wwhere[0], (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-      u24cpy(&wwhere[1], (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      u24cpy(&wwhere[2], (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      u24cpy(&wwhere[3], (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      u24cpy(&wwhere[4], (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      u24cpy(&wwhere[5], (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      u24cpy(&wwhere[6], (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      u24cpy(&wwhere[7], (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-    } else {
-      u24cpy(&wwhere[0], (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-      u24cpy(&wwhere[1], (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      u24cpy(&wwhere[2], (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      u24cpy(&wwhere[3], (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      u24cpy(&wwhere[4], (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      u24cpy(&wwhere[5], (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      u24cpy(&wwhere[6], (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      u24cpy(&wwhere[7], (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-    }
+  TILE_ALL(TILE_PUT24);
   // Restore the original color
   *pal = temp;
 }
 
 inline void md_vdp::draw_tile3(int which, int line, unsigned char *where)
 {
-  unsigned tile, *pal;
+  uint64_t px = tile_row(which, line);
+  unsigned *pal;
   uint24_t *wwhere = (uint24_t *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
   // If it's empty, why waste the time?
-  if(!tile) return;
-
+  if(!px) return;
   // If the tile doesn't have any transparent pixels, draw it solidly.
-  if (!has_zero_nibbles(tile)) {
-    if (which & 0x800) {
-      // x flipped
-      u24cpy(&wwhere[0], (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-      u24cpy(&wwhere[1], (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      u24cpy(&wwhere[2], (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      u24cpy(&wwhere[3], (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      u24cpy(&wwhere[4], (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      u24cpy(&wwhere[5], (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      u24cpy(&wwhere[6], (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      u24cpy(&wwhere[7], (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-    }
-    else {
-      u24cpy(&wwhere[0], (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-      u24cpy(&wwhere[1], (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      u24cpy(&wwhere[2], (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      u24cpy(&wwhere[3], (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      u24cpy(&wwhere[4], (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      u24cpy(&wwhere[5], (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      u24cpy(&wwhere[6], (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      u24cpy(&wwhere[7], (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-    }
-    return;
-  }
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
-    {
-      if (tile & PIXEL7)
-		u24cpy(&wwhere[0],
-		       (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-      if(tile & PIXEL6)
-		u24cpy(&wwhere[1],
-		       (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      if(tile & PIXEL5)
-		u24cpy(&wwhere[2],
-		       (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      if(tile & PIXEL4)
-		u24cpy(&wwhere[3],
-		       (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      if(tile & PIXEL3)
-		u24cpy(&wwhere[4],
-		       (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      if(tile & PIXEL2)
-		u24cpy(&wwhere[5],
-		       (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      if(tile & PIXEL1)
-		u24cpy(&wwhere[6],
-		       (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      if(tile & PIXEL0)
-		u24cpy(&wwhere[7],
-		       (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-    } else {
-      if(tile & PIXEL0)
-		u24cpy(&wwhere[0],
-		       (uint24_t *)&pal[((tile & PIXEL0) >> SHIFT0)]);
-      if(tile & PIXEL1)
-		u24cpy(&wwhere[1],
-		       (uint24_t *)&pal[((tile & PIXEL1) >> SHIFT1)]);
-      if(tile & PIXEL2)
-		u24cpy(&wwhere[2],
-		       (uint24_t *)&pal[((tile & PIXEL2) >> SHIFT2)]);
-      if(tile & PIXEL3)
-		u24cpy(&wwhere[3],
-		       (uint24_t *)&pal[((tile & PIXEL3) >> SHIFT3)]);
-      if(tile & PIXEL4)
-		u24cpy(&wwhere[4],
-		       (uint24_t *)&pal[((tile & PIXEL4) >> SHIFT4)]);
-      if(tile & PIXEL5)
-		u24cpy(&wwhere[5],
-		       (uint24_t *)&pal[((tile & PIXEL5) >> SHIFT5)]);
-      if(tile & PIXEL6)
-		u24cpy(&wwhere[6],
-		       (uint24_t *)&pal[((tile & PIXEL6) >> SHIFT6)]);
-      if(tile & PIXEL7)
-		u24cpy(&wwhere[7],
-		       (uint24_t *)&pal[((tile & PIXEL7) >> SHIFT7)]);
-    }
+  if(!tile_has_zero(px))
+    TILE_ALL(TILE_PUT24);
+  else
+    TILE_SET(TILE_PUT24);
 }
 
 // Blit tile solidly, for 4 byte-per-pixel
 inline void md_vdp::draw_tile4_solid(int which, int line, unsigned char *where)
 {
-  unsigned tile, temp, *pal;
-  unsigned *wwhere = (unsigned*)where;
+  uint64_t px = tile_row(which, line);
+  unsigned temp, *pal;
+  unsigned *wwhere = (unsigned *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
-  temp = *pal; *pal = highpal[reg[7]&0x3f]; // Get background color
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
+#ifdef TILES_SIMD
+  if(tiles_simd)
     {
-      *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    } else {
-      *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
+      tile_expand4(where, px, tile_planes[(which >> 13 & 3)],
+		   (tile_has_zero(px) ? TILE_BG : TILE_OPAQUE),
+		   highpal[reg[7]&0x3f]);
+      return;
     }
+#endif
+  temp = *pal; *pal = highpal[reg[7]&0x3f]; // Get background color
+  TILE_ALL(TILE_PUT);
   // Restore the original color
   *pal = temp;
 }
@@ -538,70 +484,27 @@ inline void md_vdp::draw_tile4_solid(int which, int line, unsigned char *where)
 // Blit tile, leaving color zero transparent, for 4 byte per pixel
 inline void md_vdp::draw_tile4(int which, int line, unsigned char *where)
 {
-  unsigned tile, *pal;
-  unsigned *wwhere = (unsigned*)where;
+  uint64_t px = tile_row(which, line);
+  unsigned *pal;
+  unsigned *wwhere = (unsigned *)where;
 
   pal = highpal + (which >> 9 & 0x30); // Determine which 16-color palette
-
-  if(which & 0x1000) // y flipped
-    line ^= 7; // take from the bottom, instead of the top
-
-  if(reg[12] & 2) // interlace
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 6) + (line << 3));
-  else
-    tile = *(unsigned*)(vram + ((which&0x7ff) << 5) + (line << 2));
   // If the tile is all 0's, why waste the time?
-  if(!tile) return;
-
-  // If the tile doesn't have any transparent pixels, draw it solidly.
-  if (!has_zero_nibbles(tile)) {
-    if (which & 0x800) {
-      // x flipped
-      *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    }
-    else {
-      *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
-    }
-    return;
-  }
-
-  // Blit the tile!
-  if(which & 0x800) // x flipped
+  if(!px) return;
+#ifdef TILES_SIMD
+  if(tiles_simd)
     {
-      if(tile & PIXEL7) *(wwhere  ) = pal[((tile & PIXEL7)>>SHIFT7)];
-      if(tile & PIXEL6) *(wwhere+1) = pal[((tile & PIXEL6)>>SHIFT6)];
-      if(tile & PIXEL5) *(wwhere+2) = pal[((tile & PIXEL5)>>SHIFT5)];
-      if(tile & PIXEL4) *(wwhere+3) = pal[((tile & PIXEL4)>>SHIFT4)];
-      if(tile & PIXEL3) *(wwhere+4) = pal[((tile & PIXEL3)>>SHIFT3)];
-      if(tile & PIXEL2) *(wwhere+5) = pal[((tile & PIXEL2)>>SHIFT2)];
-      if(tile & PIXEL1) *(wwhere+6) = pal[((tile & PIXEL1)>>SHIFT1)];
-      if(tile & PIXEL0) *(wwhere+7) = pal[((tile & PIXEL0)>>SHIFT0)];
-    } else {
-      if(tile & PIXEL0) *(wwhere  ) = pal[((tile & PIXEL0)>>SHIFT0)];
-      if(tile & PIXEL1) *(wwhere+1) = pal[((tile & PIXEL1)>>SHIFT1)];
-      if(tile & PIXEL2) *(wwhere+2) = pal[((tile & PIXEL2)>>SHIFT2)];
-      if(tile & PIXEL3) *(wwhere+3) = pal[((tile & PIXEL3)>>SHIFT3)];
-      if(tile & PIXEL4) *(wwhere+4) = pal[((tile & PIXEL4)>>SHIFT4)];
-      if(tile & PIXEL5) *(wwhere+5) = pal[((tile & PIXEL5)>>SHIFT5)];
-      if(tile & PIXEL6) *(wwhere+6) = pal[((tile & PIXEL6)>>SHIFT6)];
-      if(tile & PIXEL7) *(wwhere+7) = pal[((tile & PIXEL7)>>SHIFT7)];
+      tile_expand4(where, px, tile_planes[(which >> 13 & 3)],
+		   (tile_has_zero(px) ? TILE_KEEP : TILE_OPAQUE), 0);
+      return;
     }
+#endif
+  // If the tile doesn't have any transparent pixels, draw it solidly.
+  if(!tile_has_zero(px))
+    TILE_ALL(TILE_PUT);
+  else
+    TILE_SET(TILE_PUT);
 }
-#endif // WITH_X86_TILES
 
 // Draw the window (front or back)
 void md_vdp::draw_window(int line, int front)
@@ -1105,6 +1008,42 @@ void md_vdp::draw_plane_front1(int line)
 #undef FRONT
 }
 
+// highpal[] value of palette entry 'which' (CRAM bytes 'c[0]', 'c[1]') in
+// the screen's color depth
+static inline unsigned highpal_entry(const unsigned char *c, unsigned which,
+				     unsigned bpp)
+{
+  switch(bpp)
+    {
+    case 24:
+#ifdef WORDS_BIGENDIAN
+      return (((c[1] & 0x0e) << 28) |
+	      ((c[1] & 0xe0) << 16) |
+	      ((c[0] & 0x0e) << 12));
+#else
+      return (((c[1] & 0x0e) << 4) |
+	      ((c[1] & 0xe0) << 16) |
+	      ((c[0] & 0x0e) << 12));
+#endif
+    case 32:
+      return ((c[1]&0x0e) << 20) |
+	     ((c[1]&0xe0) << 8 ) |
+	     ((c[0]&0x0e) << 4 );
+    case 16:
+      return ((c[1]&0x0e) << 12) |
+	     ((c[1]&0xe0) << 3 ) |
+	     ((c[0]&0x0e) << 1 );
+    case 15:
+      return ((c[1]&0x0e) << 11) |
+	     ((c[1]&0xe0) << 2 ) |
+	     ((c[0]&0x0e) << 1 );
+    case 8:
+    default:
+      // Let the hardware palette sort it out :P
+      return which;
+    }
+}
+
 // Allow frame components to be hidden when WITH_DEBUG_VDP is defined.
 #ifdef WITH_DEBUG_VDP
 #define vdp_hide_if(a, b) ((a) ? (void)0 : (void)(b))
@@ -1115,49 +1054,16 @@ void md_vdp::draw_plane_front1(int line)
 // The main interface function, to generate a scanline
 void md_vdp::draw_scanline(struct bmap *bits, int line)
 {
-  // Apply CRAM corruption every few scanlines if enabled
-  if (cram_corruption_enabled && (line % 4 == 0)) // Corrupt every 4th scanline for performance
-  {
-    // Corrupt a few random CRAM entries
-    for (int i = 0; i < 3; i++) // Corrupt 3 random entries per corruption cycle
+  // Persistent CRAM corruption is a raster effect, one event every
+  // int_cram_corruption_lines lines
+  if ((cram_corruption_enabled) && (--cram_corruption_countdown <= 0))
     {
-      int addr = rand() % 0x80;
-      unsigned char original = cram[addr];
-      
-      int corruption_type = rand() % 6;
-      switch (corruption_type)
-      {
-        case 0:
-          cram[addr] ^= (1 << (rand() % 8)); // Bit flip
-          break;
-        case 1:
-          cram[addr] = ~cram[addr]; // Invert
-          break;
-        case 2:
-          cram[addr] += (rand() % 64) - 32; // Add noise
-          break;
-        case 3:
-          cram[addr] = rand() % 256; // Random
-          break;
-        case 4:
-          cram[addr] = ((cram[addr] << 4) | (cram[addr] >> 4)) & 0xFF; // Bit shift
-          break;
-        case 5:
-          // Swap with another random entry
-          {
-            int swap_addr = rand() % 0x80;
-            unsigned char temp = cram[swap_addr];
-            cram[swap_addr] = cram[addr];
-            cram[addr] = temp;
-          }
-          break;
-      }
+      cram_corruption_countdown =
+	((dgen_cram_corruption_lines > 0) ? dgen_cram_corruption_lines : 1);
+      cram_corruption_event();
     }
-    // Mark CRAM as dirty so changes are visible
-    dirt[0x34] |= 2;
-  }
 
-  unsigned *ptr, i;
+  unsigned i;
   // Set the destination in the bmap
   bmap = bits;
   dest = bits->data + (bits->pitch * (line + 8) + 16);
@@ -1169,59 +1075,34 @@ void md_vdp::draw_scanline(struct bmap *bits, int line)
       else if(bits->bpp <= 24) Bpp = 3;
       else		       Bpp = 4;
       Bpp_times8 = Bpp << 3; // used for tile blitting
-#ifdef WITH_X86_TILES
-      asm_tiles_init(vram, reg, highpal); // pass these values to the asm tiles
-#endif
+      // highpal[] holds colors at the previous depth
+      cram_dirty = ~(uint64_t)0;
+      tiles_simd = tiles_simd_supported();
     }
 
-  // If the palette's been changed, update it
+  // dirt[0x34] & 2 asks for the whole palette, poke_cram() and the CRAM
+  // corruption only mark the entries they changed
   if(dirt[0x34] & 2)
     {
-      ptr = highpal;
-      // What color depth are we?
-      switch(bits->bpp)
-        {
-	case 24:
-#ifdef WORDS_BIGENDIAN
-		for (i = 0; (i < 128); i += 2)
-			*ptr++ = (((cram[(i + 1)] & 0x0e) << 28) |
-				  ((cram[(i + 1)] & 0xe0) << 16) |
-				  ((cram[i] & 0x0e) << 12));
-		break;
-#else
-		for (i = 0; (i < 128); i += 2)
-			*ptr++ = (((cram[(i + 1)] & 0x0e) << 4) |
-				  ((cram[(i + 1)] & 0xe0) << 16) |
-				  ((cram[i] & 0x0e) << 12));
-		break;
-#endif
-	case 32:
-	  for(i = 0; i < 128; i += 2)
-	    *ptr++ = ((cram[i+1]&0x0e) << 20) |
-		     ((cram[i+1]&0xe0) << 8 ) |
-		     ((cram[i]  &0x0e) << 4 );
-	  break;
-	case 16:
-	  for(i = 0; i < 128; i += 2)
-	    *ptr++ = ((cram[i+1]&0x0e) << 12) |
-		     ((cram[i+1]&0xe0) << 3 ) |
-		     ((cram[i]  &0x0e) << 1 );
-	  break;
-	case 15:
-	  for(i = 0; i < 128; i += 2)
-	    *ptr++ = ((cram[i+1]&0x0e) << 11) |
-		     ((cram[i+1]&0xe0) << 2 ) |
-		     ((cram[i]  &0x0e) << 1 );
-	  break;
-	case 8:
-	default:
-	  // Let the hardware palette sort it out :P
-	  for(i = 0; i < 64; ++i) *ptr++ = i;
-	}
-      // Clean up the dirt
+      cram_dirty = ~(uint64_t)0;
       dirt[0x34] &= ~2;
+    }
+  // If the palette's been changed, update the changed entries
+  if(cram_dirty)
+    {
+      uint64_t mask = cram_dirty;
+
+      for(i = 0; (mask != 0); ++i, mask >>= 1)
+	if(mask & 1)
+	  highpal[i] = highpal_entry(&cram[(i * 2)], i, bits->bpp);
+      if(tiles_simd && ((Bpp == 2) || (Bpp == 4)))
+	tile_planes_update();
+      // Clean up the dirt
+      cram_dirty = 0;
       pal_dirty = 1;
     }
+  // Decode the tiles VRAM writes have changed
+  tile_cache_update();
   // Render the screen if it's turned on
   if(reg[1] & 0x40)
     {
@@ -92,6 +92,8 @@ RCCTL(dgen_prompt, ':', 0, 0);
 RCCTL(dgen_game_genie, PDK_F9, 0, 0);
 RCCTL(dgen_fullscreen_toggle, (KEYSYM_MOD_ALT | PDK_RETURN), 0, 0);
 RCCTL(dgen_debug_enter, '`', 0, 0);
+RCCTL(dgen_fast_forward, PDK_F4, 0, 0);
+RCCTL(dgen_rewind, (KEYSYM_MOD_SHIFT | PDK_F4), 0, 0);
 RCCTL(dgen_volume_inc, '=', 0, 0);
 RCCTL(dgen_volume_dec, '-', 0, 0);
 
@@ -114,6 +116,10 @@ RCVAR(dgen_autoload, 0);
 RCVAR(dgen_autosave, 0);
 RCVAR(dgen_autoconf, 1);
 RCVAR(dgen_frameskip, 1);
+RCVAR(dgen_fast_forward_frames, 4);
+RCVAR(dgen_show_pacing, 0);
+RCVAR(dgen_rewind_interval, 4);
+RCVAR(dgen_rewind_memory, 16);
 RCVAR(dgen_show_carthead, 0);
 RCSTR(dgen_rom_path, "roms"); /* synchronize with romload.c */
 
@@ -157,8 +163,11 @@ RCVAR(dgen_opengl_stretch, 1);
 RCVAR(dgen_opengl_linear, 1);
 RCVAR(dgen_opengl_32bit, 1);
 RCVAR(dgen_opengl_square, 0);
+RCVAR(dgen_opengl_shaders, 0);
+RCVAR(dgen_opengl_pbo, 1);
 RCVAR(dgen_doublebuffer, 1);
 RCVAR(dgen_screen_thread, 0);
+RCVAR(dgen_filter_threads, 0);
 RCVAR(dgen_vdp_hide_plane_a, 0);
 RCVAR(dgen_vdp_hide_plane_b, 0);
 RCVAR(dgen_vdp_hide_plane_w, 0);
@@ -166,6 +175,9 @@ RCVAR(dgen_vdp_hide_sprites, 0);
 RCVAR(dgen_vdp_sprites_boxing, 0);
 RCVAR(dgen_vdp_sprites_boxing_fg, 0xffff00); // yellow
 RCVAR(dgen_vdp_sprites_boxing_bg, 0x00ff00); // green
+RCVAR(dgen_cram_corruption_lines, 4);
+RCSTR(dgen_chaos_log, "");
+RCVAR(dgen_chaos_log_show, 1);
 
 // Keep values in sync with rc.cpp and enums in md.h
 
@@ -189,4 +201,7 @@ RCVAR(dgen_emu_m68k, 1);
 RCVAR(dgen_emu_m68k, 0);
 #endif
 
+// Values from enum fm_core in fm_core.h
+RCVAR(dgen_emu_fm, 0);
+
 #endif // __RC_VARS_H__
@@ -45,6 +45,9 @@ const char *scaling_names[] = {
 const char *emu_z80_names[] = { "none", "mz80", "cz80", "drz80", NULL };
 const char *emu_m68k_names[] = { "none", "star", "musa", "cyclone", NULL };
 
+// YM2612 emulators, keep index in sync with enum fm_core in fm_core.h
+const char *emu_fm_names[] = { "mame", "gpgx", "nuked", NULL };
+
 // The table of strings and the keysyms they map to.
 // The order is a bit weird, since this was originally a mapping for the SVGALib
 // scancodes, and I just added the SDL stuff on top of it.
@@ -524,6 +527,16 @@ intptr_t rc_emu_m68k(const char *value, intptr_t *)
 	return -1;
 }
 
+intptr_t rc_emu_fm(const char *value, intptr_t *)
+{
+	unsigned int i;
+
+	for (i = 0; (emu_fm_names[i] != NULL); ++i)
+		if (!strcasecmp(value, emu_fm_names[i]))
+			return i;
+	return -1;
+}
+
 intptr_t rc_region(const char *value, intptr_t *)
 {
 	if (strlen(value) != 1)
@@ -745,6 +758,12 @@ struct rc_field rc_fields[RC_FIELDS_SIZE] = {
 	{ "key_debug_enter", rc_keysym, &dgen_debug_enter[RCBK] },
 	{ "joy_debug_enter", rc_joypad, &dgen_debug_enter[RCBJ] },
 	{ "mou_debug_enter", rc_mouse, &dgen_debug_enter[RCBM] },
+	{ "key_fast_forward", rc_keysym, &dgen_fast_forward[RCBK] },
+	{ "joy_fast_forward", rc_joypad, &dgen_fast_forward[RCBJ] },
+	{ "mou_fast_forward", rc_mouse, &dgen_fast_forward[RCBM] },
+	{ "key_rewind", rc_keysym, &dgen_rewind[RCBK] },
+	{ "joy_rewind", rc_joypad, &dgen_rewind[RCBJ] },
+	{ "mou_rewind", rc_mouse, &dgen_rewind[RCBM] },
 	{ "key_prompt", rc_keysym, &dgen_prompt[RCBK] },
 	{ "joy_prompt", rc_joypad, &dgen_prompt[RCBJ] },
 	{ "mou_prompt", rc_mouse, &dgen_prompt[RCBM] },
@@ -755,10 +774,17 @@ struct rc_field rc_fields[RC_FIELDS_SIZE] = {
 	{ "bool_vdp_sprites_boxing", rc_boolean, &dgen_vdp_sprites_boxing },
 	{ "int_vdp_sprites_boxing_fg", rc_number, &dgen_vdp_sprites_boxing_fg },
 	{ "int_vdp_sprites_boxing_bg", rc_number, &dgen_vdp_sprites_boxing_bg },
+	{ "int_cram_corruption_lines", rc_number, &dgen_cram_corruption_lines },
+	{ "str_chaos_log", rc_string, (intptr_t *)((void *)&dgen_chaos_log) },
+	{ "bool_chaos_log_show", rc_boolean, &dgen_chaos_log_show },
 	{ "bool_autoload", rc_boolean, &dgen_autoload },
 	{ "bool_autosave", rc_boolean, &dgen_autosave },
 	{ "bool_autoconf", rc_boolean, &dgen_autoconf },
 	{ "bool_frameskip", rc_boolean, &dgen_frameskip },
+	{ "int_fast_forward_frames", rc_number, &dgen_fast_forward_frames },
+	{ "bool_show_pacing", rc_boolean, &dgen_show_pacing },
+	{ "int_rewind_interval", rc_number, &dgen_rewind_interval },
+	{ "int_rewind_memory", rc_number, &dgen_rewind_memory },
 	{ "bool_show_carthead", rc_boolean, &dgen_show_carthead },
 	{ "str_rom_path", rc_rom_path,
 	  (intptr_t *)((void *)&dgen_rom_path) }, // SH
@@ -767,6 +793,7 @@ struct rc_field rc_fields[RC_FIELDS_SIZE] = {
 	{ "scaling_startup", rc_scaling, &dgen_scaling }, // SH
 	{ "emu_z80_startup", rc_emu_z80, &dgen_emu_z80 }, // SH
 	{ "emu_m68k_startup", rc_emu_m68k, &dgen_emu_m68k }, // SH
+	{ "emu_fm_startup", rc_emu_fm, &dgen_emu_fm }, // SH
 	{ "bool_sound", rc_boolean, &dgen_sound }, // SH
 	{ "int_soundrate", rc_soundrate, &dgen_soundrate }, // SH
 	{ "int_soundsegs", rc_number, &dgen_soundsegs }, // SH
@@ -810,8 +837,11 @@ struct rc_field rc_fields[RC_FIELDS_SIZE] = {
 	// deprecated, use bool_swab
 	{ "bool_opengl_swap", rc_boolean, &dgen_swab }, // SH
 	{ "bool_opengl_square", rc_boolean, &dgen_opengl_square }, // SH
+	{ "bool_opengl_shaders", rc_boolean, &dgen_opengl_shaders }, // SH
+	{ "bool_opengl_pbo", rc_boolean, &dgen_opengl_pbo }, // SH
 	{ "bool_doublebuffer", rc_boolean, &dgen_doublebuffer }, // SH
 	{ "bool_screen_thread", rc_boolean, &dgen_screen_thread }, // SH
+	{ "int_filter_threads", rc_number, &dgen_filter_threads },
 	{ "bool_joystick", rc_boolean, &dgen_joystick }, // SH
 	{ "int_mouse_delay", rc_number, &dgen_mouse_delay },
 	{ NULL, NULL, NULL }
@@ -1197,6 +1227,8 @@ void dump_rc(FILE *file)
 			fprintf(file, "%s", emu_z80_names[val]);
 		else if (rc->parser == rc_emu_m68k)
 			fprintf(file, "%s", emu_m68k_names[val]);
+		else if (rc->parser == rc_emu_fm)
+			fprintf(file, "%s", emu_fm_names[val]);
 		else if (rc->parser == rc_region) {
 			if (isgraph((char)val))
 				fputc((char)val, file);
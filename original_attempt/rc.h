@@ -111,6 +111,9 @@ extern const char *scaling_names[];
 extern const char *emu_z80_names[];
 extern const char *emu_m68k_names[];
 
+// YM2612 emulator names
+extern const char *emu_fm_names[];
+
 // Provide a prototype to the parse_rc function in rc.cpp
 extern void parse_rc(FILE *file, const char *name);
 
@@ -128,6 +131,7 @@ extern intptr_t rc_ctv(const char *value, intptr_t *);
 extern intptr_t rc_scaling(const char *value, intptr_t *);
 extern intptr_t rc_emu_z80(const char *value, intptr_t *);
 extern intptr_t rc_emu_m68k(const char *value, intptr_t *);
+extern intptr_t rc_emu_fm(const char *value, intptr_t *);
 extern intptr_t rc_region(const char *value, intptr_t *);
 extern intptr_t rc_string(const char *value, intptr_t *);
 extern intptr_t rc_rom_path(const char *value, intptr_t *);
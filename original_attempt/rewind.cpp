@@ -0,0 +1,407 @@
+// DGen/SDL 1.17+
+// Rewind buffer
+//
+// A snapshot (md::state_save()) is taken every int_rewind_interval frames.
+// Only the latest one (the keyframe) is kept whole, each older one is stored
+// as the run-length encoded XOR of itself and the snapshot that followed it,
+// in a ring of int_rewind_memory megabytes. Going back one step loads the
+// keyframe and XORs the newest delta into it, which turns it into the
+// previous snapshot. Oldest deltas are overwritten when the ring is full.
+//
+// Deltas are computed by a separate thread when possible, the emulation
+// thread then only fills a spare snapshot buffer and hands it over.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef WITH_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
+#include "md.h"
+#include "rc-vars.h"
+#include "rewind.h"
+
+// Identical bytes that end a literal run when encoding a delta.
+#define REWIND_RUN_MIN 8
+
+static struct
+{
+	size_t size;					   // md::state_size()
+	uint8_t *key;					   // latest snapshot
+	uint8_t *next;					   // snapshot to add after key
+	uint8_t *delta;					   // encoding buffer
+	bool key_valid;					   // key holds a snapshot
+	char romname[sizeof(md::romname)]; // ROM these snapshots belong to
+	intptr_t memory;				   // int_rewind_memory for ring
+	unsigned int frame;				   // frames since last snapshot
+	// Ring of deltas, each one is framed by its length (uint32_t) on both
+	// sides so it can be removed from either end. When wrapped, deltas
+	// go from tail to end, then from 0 to head.
+	uint8_t *ring;
+	size_t ring_size;
+	size_t head;		// end of the newest delta
+	size_t tail;		// start of the oldest delta
+	size_t end;			// end of the last delta before wrapping
+	bool wrapped;
+	unsigned long count; // number of deltas
+#ifdef WITH_THREADS
+	std::mutex lock;
+	std::condition_variable wake; // pending or quit is set
+	std::condition_variable idle; // pending is cleared
+	std::thread thread;
+	std::atomic<bool> pending; // next must be added by the thread
+	bool quit;
+#endif
+} rw;
+
+static uint8_t *varint_put(uint8_t *out, size_t val)
+{
+	while (val >= 0x80)
+	{
+		*(out++) = (val | 0x80);
+		val >>= 7;
+	}
+	*(out++) = val;
+	return out;
+}
+
+static size_t varint_get(const uint8_t **in)
+{
+	size_t val = 0;
+	unsigned int shift = 0;
+	uint8_t c;
+
+	do
+	{
+		c = *((*in)++);
+		val |= ((size_t)(c & 0x7f) << shift);
+		shift += 7;
+	} while (c & 0x80);
+	return val;
+}
+
+/**
+ * Encode the XOR of two snapshots as a series of (skip, length, bytes)
+ * runs. The output is always smaller than (size * 2) bytes.
+ */
+static size_t rewind_encode(uint8_t *out, const uint8_t *a, const uint8_t *b,
+							size_t size)
+{
+	uint8_t *o = out;
+	size_t i = 0;
+	size_t from;
+	size_t lit;
+	unsigned int same;
+
+	while (i != size)
+	{
+		// Identical bytes, 8 at a time when possible.
+		from = i;
+		while (((i + 8) <= size) && (!memcmp(&a[i], &b[i], 8)))
+			i += 8;
+		while ((i != size) && (a[i] == b[i]))
+			++i;
+		if (i == size)
+			break;
+		// Different bytes, until enough identical ones follow.
+		lit = i;
+		same = 0;
+		while ((i != size) && (same != REWIND_RUN_MIN))
+		{
+			same = ((a[i] == b[i]) ? (same + 1) : 0);
+			++i;
+		}
+		i -= same;
+		o = varint_put(o, (lit - from));
+		o = varint_put(o, (i - lit));
+		for (; (lit != i); ++lit)
+			*(o++) = (a[lit] ^ b[lit]);
+	}
+	return (o - out);
+}
+
+static void rewind_apply(uint8_t *dst, const uint8_t *in, size_t len)
+{
+	const uint8_t *end = (in + len);
+	size_t n;
+
+	while (in != end)
+	{
+		dst += varint_get(&in);
+		for (n = varint_get(&in); (n != 0); --n)
+			*(dst++) ^= *(in++);
+	}
+}
+
+static void ring_clear()
+{
+	rw.head = 0;
+	rw.tail = 0;
+	rw.end = 0;
+	rw.wrapped = false;
+	rw.count = 0;
+}
+
+static void ring_drop_oldest()
+{
+	uint32_t len;
+
+	memcpy(&len, &rw.ring[rw.tail], sizeof(len));
+	rw.tail += (sizeof(len) + len + sizeof(len));
+	if ((rw.wrapped) && (rw.tail == rw.end))
+	{
+		rw.tail = 0;
+		rw.wrapped = false;
+	}
+	if (--rw.count == 0)
+		ring_clear();
+}
+
+static bool ring_push(const uint8_t *data, uint32_t len)
+{
+	size_t total = (sizeof(len) + len + sizeof(len));
+	size_t pos;
+
+	if (total > rw.ring_size)
+		return false;
+	while (1)
+	{
+		if (rw.count == 0)
+		{
+			pos = 0;
+			break;
+		}
+		if (!rw.wrapped)
+		{
+			if ((rw.head + total) <= rw.ring_size)
+			{
+				pos = rw.head;
+				break;
+			}
+			if (total <= rw.tail)
+			{
+				rw.end = rw.head;
+				rw.wrapped = true;
+				pos = 0;
+				break;
+			}
+		}
+		else if ((rw.head + total) <= rw.tail)
+		{
+			pos = rw.head;
+			break;
+		}
+		ring_drop_oldest();
+	}
+	memcpy(&rw.ring[pos], &len, sizeof(len));
+	memcpy(&rw.ring[(pos + sizeof(len))], data, len);
+	memcpy(&rw.ring[(pos + sizeof(len) + len)], &len, sizeof(len));
+	rw.head = (pos + total);
+	++rw.count;
+	return true;
+}
+
+static bool ring_pop_newest(uint8_t *dst)
+{
+	uint32_t len;
+
+	if (rw.count == 0)
+		return false;
+	memcpy(&len, &rw.ring[(rw.head - sizeof(len))], sizeof(len));
+	rw.head -= (sizeof(len) + len + sizeof(len));
+	rewind_apply(dst, &rw.ring[(rw.head + sizeof(len))], len);
+	if ((rw.wrapped) && (rw.head == 0))
+	{
+		rw.head = rw.end;
+		rw.wrapped = false;
+	}
+	if (--rw.count == 0)
+		ring_clear();
+	return true;
+}
+
+// Make rw.next the keyframe, the previous one becomes a delta.
+static void rewind_add()
+{
+	uint8_t *tmp;
+
+	if (rw.key_valid)
+	{
+		size_t len = rewind_encode(rw.delta, rw.key, rw.next, rw.size);
+
+		// History is useless without this delta.
+		if (!ring_push(rw.delta, len))
+			ring_clear();
+	}
+	tmp = rw.key;
+	rw.key = rw.next;
+	rw.next = tmp;
+	rw.key_valid = true;
+}
+
+#ifdef WITH_THREADS
+
+static void rewind_thread()
+{
+	std::unique_lock<std::mutex> hold(rw.lock);
+
+	while (rw.wake.wait(hold, []
+						{ return (rw.pending.load() || rw.quit); }),
+		   (!rw.quit))
+	{
+		hold.unlock();
+		rewind_add();
+		hold.lock();
+		rw.pending.store(false);
+		rw.idle.notify_all();
+	}
+}
+
+// Wait until rw.next can be used, the thread is not working on it.
+static void rewind_wait()
+{
+	std::unique_lock<std::mutex> hold(rw.lock);
+
+	rw.idle.wait(hold, []
+				 { return (!rw.pending.load()); });
+}
+
+#endif // WITH_THREADS
+
+static void rewind_free()
+{
+#ifdef WITH_THREADS
+	if (rw.thread.joinable())
+	{
+		rw.lock.lock();
+		rw.quit = true;
+		rw.lock.unlock();
+		rw.wake.notify_one();
+		rw.thread.join();
+		rw.quit = false;
+		rw.pending.store(false);
+	}
+#endif
+	free(rw.key);
+	free(rw.next);
+	free(rw.delta);
+	free(rw.ring);
+	rw.key = NULL;
+	rw.next = NULL;
+	rw.delta = NULL;
+	rw.ring = NULL;
+	rw.ring_size = 0;
+	rw.memory = 0;
+	rw.key_valid = false;
+	ring_clear();
+}
+
+static bool rewind_init(md &megad)
+{
+	static bool registered;
+	size_t size = md::state_size();
+
+	if ((!registered) && (atexit(rewind_free) != 0))
+		return false;
+	registered = true;
+	rw.size = size;
+	rw.memory = dgen_rewind_memory;
+	rw.ring_size = ((size_t)dgen_rewind_memory << 20);
+	rw.key = (uint8_t *)malloc(size);
+	rw.next = (uint8_t *)malloc(size);
+	rw.delta = (uint8_t *)malloc(size * 2);
+	rw.ring = (uint8_t *)malloc(rw.ring_size);
+	if ((rw.key == NULL) || (rw.next == NULL) || (rw.delta == NULL) ||
+		(rw.ring == NULL))
+	{
+		fprintf(stderr, "rewind: not enough memory.\n");
+		rewind_free();
+		return false;
+	}
+	snprintf(rw.romname, sizeof(rw.romname), "%s", megad.romname);
+#ifdef WITH_THREADS
+	try
+	{
+		rw.thread = std::thread(rewind_thread);
+	}
+	catch (const std::system_error &)
+	{
+		// Deltas are then computed by rewind_frame() directly.
+	}
+#endif
+	return true;
+}
+
+void rewind_reset()
+{
+#ifdef WITH_THREADS
+	rewind_wait();
+#endif
+	rw.key_valid = false;
+	rw.frame = 0;
+	ring_clear();
+}
+
+void rewind_frame(md &megad)
+{
+	if ((dgen_rewind_memory <= 0) || (!megad.plugged))
+	{
+		if (rw.key != NULL)
+			rewind_free();
+		return;
+	}
+	if (++rw.frame < (unsigned int)dgen_rewind_interval)
+		return;
+	rw.frame = 0;
+	if ((rw.key != NULL) &&
+		((rw.memory != dgen_rewind_memory) ||
+		 (strcmp(rw.romname, megad.romname))))
+		rewind_free();
+	if ((rw.key == NULL) && (!rewind_init(megad)))
+	{
+		// Do not try again.
+		dgen_rewind_memory = 0;
+		return;
+	}
+#ifdef WITH_THREADS
+	if (rw.thread.joinable())
+	{
+		// Skip this snapshot if the previous one is not done yet.
+		if (rw.pending.load())
+			return;
+		megad.state_save(rw.next);
+		rw.lock.lock();
+		rw.pending.store(true);
+		rw.lock.unlock();
+		rw.wake.notify_one();
+		return;
+	}
+#endif
+	megad.state_save(rw.next);
+	rewind_add();
+}
+
+bool rewind_step(md &megad)
+{
+	bool ret;
+
+	if (rw.key == NULL)
+		return false;
+#ifdef WITH_THREADS
+	rewind_wait();
+#endif
+	if (!rw.key_valid)
+		return false;
+	megad.state_load(rw.key);
+	ret = ring_pop_newest(rw.key);
+	// Start counting again from here.
+	rw.frame = 0;
+	return ret;
+}
@@ -0,0 +1,20 @@
+// DGen/SDL 1.17+
+// Rewind buffer, see rewind.cpp
+
+#ifndef __REWIND_H__
+#define __REWIND_H__
+
+class md;
+
+// Call after each emulated frame, a snapshot is taken every
+// int_rewind_interval frames.
+void rewind_frame(md &megad);
+
+// Go back to the previous snapshot. Returns false when there is none left,
+// the oldest one is then loaded again.
+bool rewind_step(md &megad);
+
+// Forget everything.
+void rewind_reset();
+
+#endif // __REWIND_H__
@@ -8,11 +8,68 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#ifdef HAVE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
 #include "romload.h"
 #include "system.h"
 
+/* A valid ROM will surely not be bigger than 64MB. */
+#define ROM_MAX_SIZE (64 * 1024 * 1024)
+
 static const char *rom_path = "roms";
 
+#ifdef HAVE_MMAP
+
+/* ROMs returned by map_rom(), for unload_rom(). */
+static struct mapped_rom {
+	uint8_t *rom;
+	size_t size;
+	struct mapped_rom *next;
+} *mapped_roms;
+
+/*
+  Map a raw ROM file instead of reading it. Pages are private and
+  copy-on-write, patching the ROM in memory doesn't touch the file and only
+  costs the pages that are modified. Anything else (SMD, archives) returns
+  NULL and is left to load().
+*/
+static uint8_t *map_rom(size_t *rom_size, FILE *file)
+{
+	int fd = fileno(file);
+	struct stat st;
+	struct mapped_rom *m;
+	uint8_t *rom;
+	size_t size;
+
+	if ((fd == -1) || (fstat(fd, &st) == -1) || (!S_ISREG(st.st_mode)) ||
+	    (st.st_size < 512) || (st.st_size > ROM_MAX_SIZE))
+		return NULL;
+	size = st.st_size;
+	if ((m = malloc(sizeof(*m))) == NULL)
+		return NULL;
+	rom = mmap(NULL, size, (PROT_READ | PROT_WRITE), MAP_PRIVATE, fd, 0);
+	if (rom == MAP_FAILED) {
+		free(m);
+		return NULL;
+	}
+	if (memcmp(&rom[0x100], "SEGA", 4)) {
+		munmap(rom, size);
+		free(m);
+		return NULL;
+	}
+	m->rom = rom;
+	m->size = size;
+	m->next = mapped_roms;
+	mapped_roms = m;
+	*rom_size = size;
+	return rom;
+}
+
+#endif /* HAVE_MMAP */
+
 void set_rom_path(const char *path)
 {
 	rom_path = path;
@@ -59,9 +116,12 @@ uint8_t *load_rom(size_t *rom_size, const char *name)
 		fprintf(stderr, "%s: can't open ROM file.\n", name);
 		return NULL;
 	}
+#ifdef HAVE_MMAP
+	if ((rom = map_rom(&size, file)) != NULL)
+		goto done;
+#endif
 retry:
-	/* A valid ROM will surely not be bigger than 64MB. */
-	rom = load(&context, &size, file, (64 * 1024 * 1024));
+	rom = load(&context, &size, file, ROM_MAX_SIZE);
 	error = errno;
 	if (rom == NULL) {
 		if (error)
@@ -119,6 +179,9 @@ retry:
 		}
 	}
 	load_finish(&context);
+#ifdef HAVE_MMAP
+done:
+#endif
 	fclose(file);
 	if (rom_size != NULL)
 		*rom_size = size;
@@ -127,5 +190,19 @@ retry:
 
 void unload_rom(uint8_t *rom)
 {
+#ifdef HAVE_MMAP
+	struct mapped_rom **m;
+
+	for (m = &mapped_roms; (*m != NULL); m = &(*m)->next) {
+		struct mapped_rom *tmp = *m;
+
+		if (tmp->rom != rom)
+			continue;
+		munmap(tmp->rom, tmp->size);
+		*m = tmp->next;
+		free(tmp);
+		return;
+	}
+#endif
 	unload(rom);
 }
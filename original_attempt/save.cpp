@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include "md.h"
 #include "system.h"
+#include "chaoslog.h"
 
 void md::m68k_state_dump()
 {
@@ -326,7 +327,7 @@ int md::import_gst(FILE *hand)
 	fm_sel[0] = p[0];
 	fm_sel[1] = p[1];
 	p = &(*buf)[0x1e4];
-	YM2612_restore(0, p);
+	fm_core_restore(0, p);
 	fm_reg[0][0x24] = p[0x24];
 	fm_reg[0][0x25] = p[0x25];
 	fm_reg[0][0x26] = p[0x26];
@@ -379,6 +380,164 @@ int md::import_gst(FILE *hand)
 
 int md::export_gst(FILE *hand)
 {
+	uint8_t *buf = (uint8_t *)malloc(state_size());
+	int ret;
+
+	if (buf == NULL)
+		return -1;
+	state_save(buf);
+	ret = state_export_gst(buf, hand);
+	free(buf);
+	return ret;
+}
+
+/*
+  Native save state, what is needed to resume emulation exactly where it
+  was, in host byte order. The YM2612 and SN76496 states returned by
+  fm_core_state_save() and SN76496_state_save() follow it in that order.
+  Register dumps are also kept for state_export_gst() and for when the
+  sound chips no longer accept their native state (see state_load()).
+*/
+struct md_state
+{
+	m68k_state_t m68k;
+	z80_state_t z80;
+	/* VDP */
+	uint8_t vdp_mem[sizeof(md_vdp::mem)]; /* VRAM, CRAM, VSRAM, dirt */
+	uint8_t vdp_reg[sizeof(md_vdp::reg)];
+	int vdp_rw_mode;
+	int vdp_rw_addr;
+	int vdp_rw_dma;
+	bool vdp_hint_pending;
+	bool vdp_vint_pending;
+	bool vdp_cmd_pending;
+	int vdp_sprite_overflow_line;
+	unsigned char coo4;
+	unsigned char coo5;
+	/* Sound */
+	uint8_t fm_sel[2];
+	uint8_t fm_tover;
+	int fm_ticker[4];
+	signed short fm_reg[2][0x100];
+	uint8_t dac_data[0x400];
+	unsigned int dac_len;
+	bool dac_enabled;
+	uint8_t ym2612[512];
+	uint8_t sn76496[16];
+	/* Z80 */
+	uint32_t z80_bank68k;
+	bool z80_st_busreq;
+	bool z80_st_reset;
+	bool z80_st_running;
+	bool z80_st_irq;
+	bool m68k_st_running;
+	int z80_irq_vector;
+	/* Memory */
+	uint8_t z80ram[0x2000];
+	uint8_t ram[0x10000];
+};
+
+size_t md::state_size()
+{
+	return (sizeof(struct md_state) +
+		fm_core_state_size() + SN76496_state_size());
+}
+
+void md::state_save(uint8_t *buf)
+{
+	struct md_state *s = (struct md_state *)buf;
+
+	m68k_state_dump();
+	s->m68k = m68k_state;
+	z80_state_dump();
+	s->z80 = z80_state;
+	memcpy(s->vdp_mem, vdp.mem, sizeof(s->vdp_mem));
+	memcpy(s->vdp_reg, vdp.reg, sizeof(s->vdp_reg));
+	s->vdp_rw_mode = vdp.rw_mode;
+	s->vdp_rw_addr = vdp.rw_addr;
+	s->vdp_rw_dma = vdp.rw_dma;
+	s->vdp_hint_pending = vdp.hint_pending;
+	s->vdp_vint_pending = vdp.vint_pending;
+	s->vdp_cmd_pending = vdp.cmd_pending;
+	s->vdp_sprite_overflow_line = vdp.sprite_overflow_line;
+	s->coo4 = coo4;
+	s->coo5 = coo5;
+	memcpy(s->fm_sel, fm_sel, sizeof(s->fm_sel));
+	s->fm_tover = fm_tover;
+	memcpy(s->fm_ticker, fm_ticker, sizeof(s->fm_ticker));
+	memcpy(s->fm_reg, fm_reg, sizeof(s->fm_reg));
+	memcpy(s->dac_data, dac_data, sizeof(s->dac_data));
+	s->dac_len = dac_len;
+	s->dac_enabled = dac_enabled;
+	fm_core_dump(0, s->ym2612);
+	SN76496_dump(0, s->sn76496);
+	s->z80_bank68k = z80_bank68k;
+	s->z80_st_busreq = z80_st_busreq;
+	s->z80_st_reset = z80_st_reset;
+	s->z80_st_running = z80_st_running;
+	s->z80_st_irq = z80_st_irq;
+	s->m68k_st_running = m68k_st_running;
+	s->z80_irq_vector = z80_irq_vector;
+	memcpy(s->z80ram, z80ram, sizeof(s->z80ram));
+	memcpy(s->ram, ram, sizeof(s->ram));
+	buf += sizeof(*s);
+	fm_core_state_save(0, buf);
+	buf += fm_core_state_size();
+	SN76496_state_save(0, buf);
+}
+
+void md::state_load(const uint8_t *buf)
+{
+	const struct md_state *s = (const struct md_state *)buf;
+
+	// Unlike import_gst(), nothing needs to be reset first.
+	m68k_state = s->m68k;
+	m68k_state_restore();
+	z80_state = s->z80;
+	z80_state_restore();
+	memcpy(vdp.mem, s->vdp_mem, sizeof(s->vdp_mem));
+	memcpy(vdp.reg, s->vdp_reg, sizeof(s->vdp_reg));
+	vdp.rw_mode = s->vdp_rw_mode;
+	vdp.rw_addr = s->vdp_rw_addr;
+	vdp.rw_dma = s->vdp_rw_dma;
+	vdp.hint_pending = s->vdp_hint_pending;
+	vdp.vint_pending = s->vdp_vint_pending;
+	vdp.cmd_pending = s->vdp_cmd_pending;
+	vdp.sprite_overflow_line = s->vdp_sprite_overflow_line;
+	coo4 = s->coo4;
+	coo5 = s->coo5;
+	memcpy(fm_sel, s->fm_sel, sizeof(fm_sel));
+	fm_tover = s->fm_tover;
+	memcpy(fm_ticker, s->fm_ticker, sizeof(fm_ticker));
+	memcpy(fm_reg, s->fm_reg, sizeof(fm_reg));
+	memcpy(dac_data, s->dac_data, sizeof(dac_data));
+	dac_len = s->dac_len;
+	dac_enabled = s->dac_enabled;
+	z80_bank68k = s->z80_bank68k;
+	z80_st_busreq = s->z80_st_busreq;
+	z80_st_reset = s->z80_st_reset;
+	z80_st_running = s->z80_st_running;
+	z80_st_irq = s->z80_st_irq;
+	m68k_st_running = s->m68k_st_running;
+	z80_irq_vector = s->z80_irq_vector;
+	memcpy(z80ram, s->z80ram, sizeof(s->z80ram));
+	memcpy(ram, s->ram, sizeof(s->ram));
+	buf += sizeof(*s);
+	// The sound chips may have been initialized again since then.
+	if (fm_core_state_load(0, buf))
+		fm_core_restore(0, (uint8_t *)s->ym2612);
+	buf += fm_core_state_size();
+	if (SN76496_state_load(0, buf))
+		SN76496_restore(0, (uint8_t *)s->sn76496);
+	// Pending interrupts are not part of the CPU states.
+	m68k_vdp_irq_trigger();
+	/* Mark everything as changed */
+	memset(vdp.dirt, 0xff, 0x35);
+}
+
+int md::state_export_gst(const uint8_t *state, FILE *hand)
+{
+	const struct md_state *s = (const struct md_state *)state;
 	uint8_t (*buf)[0x22478] =
 		(uint8_t (*)[sizeof(*buf)])calloc(1, sizeof(*buf));
 	uint8_t *p;
@@ -398,73 +557,71 @@ int md::export_gst(FILE *hand)
 	/* System ID */
 	(*buf)[0x52] = 0;
 	/* PSG registers (8x16-bit, 16 bytes) */
-	SN76496_dump(0, &(*buf)[0x60]);
+	memcpy(&(*buf)[0x60], s->sn76496, sizeof(s->sn76496));
 	/* M68K registers (19x32-bit, 1x16-bit, 90 bytes (padding: 12)) */
-	m68k_state_dump();
 	p = &(*buf)[0x80];
 	q = &(*buf)[0xa0];
 	for (i = 0; (i != 8); ++i, p += 4, q += 4)
 	{
-		memcpy(p, &m68k_state.d[i], 4);
-		memcpy(q, &m68k_state.a[i], 4);
+		memcpy(p, &s->m68k.d[i], 4);
+		memcpy(q, &s->m68k.a[i], 4);
 	}
-	memcpy(&(*buf)[0xc8], &m68k_state.pc, 4);
-	memcpy(&(*buf)[0xd0], &m68k_state.sr, 2);
+	memcpy(&(*buf)[0xc8], &s->m68k.pc, 4);
+	memcpy(&(*buf)[0xd0], &s->m68k.sr, 2);
 	/*
 	  FIXME?
-	  memcpy(&(*buf)[0xd2], &m68k_state.usp, 4);
-	  memcpy(&(*buf)[0xd6], &m68k_state.ssp, 4);
+	  memcpy(&(*buf)[0xd2], &s->m68k.usp, 4);
+	  memcpy(&(*buf)[0xd6], &s->m68k.ssp, 4);
 	*/
 	/* VDP registers (24x8-bit VDP registers, not sizeof(vdp.reg)) */
-	memcpy(&(*buf)[0xfa], vdp.reg, 0x18);
+	memcpy(&(*buf)[0xfa], s->vdp_reg, 0x18);
 	/* CRAM (64x16-bit registers, 128 bytes), swapped */
-	swap16cpy(&(*buf)[0x112], vdp.cram, 0x80);
+	swap16cpy(&(*buf)[0x112], &s->vdp_mem[0x10000], 0x80);
 	/* VSRAM (40x16-bit words, 80 bytes), swapped */
-	swap16cpy(&(*buf)[0x192], vdp.vsram, 0x50);
+	swap16cpy(&(*buf)[0x192], &s->vdp_mem[0x10080], 0x50);
 	/* YM2612 registers */
 	p = &(*buf)[0x1e2];
-	p[0] = fm_sel[0];
-	p[1] = fm_sel[1];
+	p[0] = s->fm_sel[0];
+	p[1] = s->fm_sel[1];
 	p = &(*buf)[0x1e4];
-	YM2612_dump(0, p);
-	p[0x24] = fm_reg[0][0x24];
-	p[0x25] = fm_reg[0][0x25];
-	p[0x26] = fm_reg[0][0x26];
-	p[0x27] = fm_reg[0][0x27];
+	memcpy(p, s->ym2612, sizeof(s->ym2612));
+	p[0x24] = s->fm_reg[0][0x24];
+	p[0x25] = s->fm_reg[0][0x25];
+	p[0x26] = s->fm_reg[0][0x26];
+	p[0x27] = s->fm_reg[0][0x27];
 	p[0x2a] = 0xff;
-	p[0x2b] = (dac_enabled << 7);
+	p[0x2b] = (s->dac_enabled << 7);
 	/* Z80 registers (12x16-bit and 4x8-bit, 52 bytes (padding: 24)) */
-	z80_state_dump();
 	p = &(*buf)[0x404];
 	for (i = 0; (i != 2); ++i, p = &(*buf)[0x424])
 	{
-		memcpy(&p[0x0], &z80_state.alt[i].fa, 2);
-		memcpy(&p[0x4], &z80_state.alt[i].cb, 2);
-		memcpy(&p[0x8], &z80_state.alt[i].ed, 2);
-		memcpy(&p[0xc], &z80_state.alt[i].lh, 2);
+		memcpy(&p[0x0], &s->z80.alt[i].fa, 2);
+		memcpy(&p[0x4], &s->z80.alt[i].cb, 2);
+		memcpy(&p[0x8], &s->z80.alt[i].ed, 2);
+		memcpy(&p[0xc], &s->z80.alt[i].lh, 2);
 	}
 	p = &(*buf)[0x414];
-	memcpy(&p[0x0], &z80_state.ix, 2);
-	memcpy(&p[0x4], &z80_state.iy, 2);
-	memcpy(&p[0x8], &z80_state.pc, 2);
-	memcpy(&p[0xc], &z80_state.sp, 2);
+	memcpy(&p[0x0], &s->z80.ix, 2);
+	memcpy(&p[0x4], &s->z80.iy, 2);
+	memcpy(&p[0x8], &s->z80.pc, 2);
+	memcpy(&p[0xc], &s->z80.sp, 2);
 	p = &(*buf)[0x434];
-	p[0] = z80_state.i;
-	p[1] = z80_state.r;
-	p[2] = ((z80_state.iff >> 1) | z80_state.iff);
-	p[3] = z80_state.im;
+	p[0] = s->z80.i;
+	p[1] = s->z80.r;
+	p[2] = ((s->z80.iff >> 1) | s->z80.iff);
+	p[3] = s->z80.im;
 	/* Z80 state (8 bytes) */
 	p = &(*buf)[0x438];
-	p[0] = !z80_st_reset;
-	p[1] = z80_st_busreq;
-	tmp = h2le32(z80_bank68k);
+	p[0] = !s->z80_st_reset;
+	p[1] = s->z80_st_busreq;
+	tmp = h2le32(s->z80_bank68k);
 	memcpy(&(*buf)[0x43c], &tmp, 4);
 	/* Z80 RAM (8192 bytes) */
-	memcpy(&(*buf)[0x474], z80ram, 0x2000);
+	memcpy(&(*buf)[0x474], s->z80ram, 0x2000);
 	/* RAM (65536 bytes), swapped */
-	swap16cpy(&(*buf)[0x2478], ram, 0x10000);
+	swap16cpy(&(*buf)[0x2478], s->ram, 0x10000);
 	/* VRAM (65536 bytes) */
-	memcpy(&(*buf)[0x12478], vdp.vram, 0x10000);
+	memcpy(&(*buf)[0x12478], s->vdp_mem, 0x10000);
 	/* Output */
 	i = fwrite((*buf), sizeof(*buf), 1, hand);
 	free(buf);
@@ -493,7 +650,7 @@ void md::shift_audio_memory_up()
 	// Clear the last byte -- not sure we want this if going for max glitching
 	// z80ram[0x1FFF] = 0;
 
-	fprintf(stderr, "%s: Shifted audio memory up by one byte.\n", __func__);
+	chaos_log(CHAOS_Z80_SHIFT_UP, 0, 0, 1);
 }
 
 /**
@@ -515,7 +672,7 @@ void md::shift_audio_memory_down()
 	}
 	// Clear the first byte -- not sure we want this if going for max glitching
 	// z80ram[0] = 0;
-	fprintf(stderr, "%s: Shifted audio memory down by one byte.\n", __func__);
+	chaos_log(CHAOS_Z80_SHIFT_DOWN, 0, 0, 1);
 }
 
 /**
@@ -531,7 +688,7 @@ void md::corrupt_audio_memory()
 		return;
 	}
 
-	fprintf(stderr, "%s: Corrupting audio memory...\n", __func__);
+	unsigned int corrupted = 0;
 
 	// Corrupt entire Z80 RAM more aggressively - this might be riskier but more effective
 	for (int i = 0x100; i < 0x2000; i += 4) // Start from 0x100 to preserve some critical low memory, every 4 bytes
@@ -543,10 +700,12 @@ void md::corrupt_audio_memory()
 			// Also corrupt adjacent byte for more dramatic effect
 			if (i + 1 < 0x2000)
 				z80ram[i + 1] ^= (rand() % 256);
+			corrupted += 2;
 		}
 	}
 
-	fprintf(stderr, "%s: Audio memory corruption complete.\n", __func__);
+	// Thousands of bytes, only log how many.
+	chaos_log(CHAOS_Z80_RAM, 0x100, 0, corrupted);
 }
 
 /**
@@ -555,7 +714,15 @@ void md::corrupt_audio_memory()
  */
 void md::corrupt_ym2612_registers()
 {
-	fprintf(stderr, "%s: Corrupting YM2612 registers...\n", __func__);
+	struct ym2612_reg_write w[6 * 28 + 15];
+	unsigned int n = 0;
+	auto put = [&](int bank, int reg, int val)
+	{
+		chaos_log(CHAOS_FM_REG, ((bank << 8) | reg), fm_reg[bank][reg], val);
+		w[n].reg = ((bank << 8) | reg);
+		w[n].val = val;
+		++n;
+	};
 
 	// Corrupt FM channel parameters more aggressively - target ALL channels
 	for (int channel = 0; channel < 6; channel++)
@@ -568,13 +735,13 @@ void md::corrupt_ym2612_registers()
 		int freq_low_reg = 0xA0 + ch_offset;
 		if (channel >= 3)
 			freq_low_reg = 0xA4 + ch_offset;
-		fm_reg[reg_base][freq_low_reg] = rand() % 256;
+		put(reg_base, freq_low_reg, rand() % 256);
 
 		// Frequency high byte (registers 0xA4-0xA6 and 0xA8-0xAA)
 		int freq_high_reg = 0xA4 + ch_offset;
 		if (channel >= 3)
 			freq_high_reg = 0xA8 + ch_offset;
-		fm_reg[reg_base][freq_high_reg] = rand() % 64; // Only lower 6 bits used
+		put(reg_base, freq_high_reg, rand() % 64); // Only lower 6 bits used
 
 		// Aggressively corrupt ALL operator parameters for this channel
 		for (int op = 0; op < 4; op++)
@@ -582,22 +749,22 @@ void md::corrupt_ym2612_registers()
 			int op_base = (ch_offset * 4) + op;
 
 			// Volume/attenuation (registers 0x40-0x4F)
-			fm_reg[reg_base][0x40 + op_base] = rand() % 128;
+			put(reg_base, 0x40 + op_base, rand() % 128);
 
 			// Rate scaling and attack rate (0x50-0x5F)
-			fm_reg[reg_base][0x50 + op_base] = rand() % 256;
+			put(reg_base, 0x50 + op_base, rand() % 256);
 
 			// Amplitude modulation and decay rate (0x60-0x6F)
-			fm_reg[reg_base][0x60 + op_base] = rand() % 256;
+			put(reg_base, 0x60 + op_base, rand() % 256);
 
 			// Sustain rate (0x70-0x7F)
-			fm_reg[reg_base][0x70 + op_base] = rand() % 256;
+			put(reg_base, 0x70 + op_base, rand() % 256);
 
 			// Sustain level and release rate (0x80-0x8F)
-			fm_reg[reg_base][0x80 + op_base] = rand() % 256;
+			put(reg_base, 0x80 + op_base, rand() % 256);
 
 			// SSG-EG (0x90-0x9F)
-			fm_reg[reg_base][0x90 + op_base] = rand() % 16;
+			put(reg_base, 0x90 + op_base, rand() % 16);
 		}
 
 		// Channel-specific parameters
@@ -605,37 +772,38 @@ void md::corrupt_ym2612_registers()
 		int fb_alg_reg = 0xB0 + ch_offset;
 		if (channel >= 3)
 			fb_alg_reg = 0xB4 + ch_offset;
-		fm_reg[reg_base][fb_alg_reg] = rand() % 256;
+		put(reg_base, fb_alg_reg, rand() % 256);
 
 		// Stereo, LFO sensitivity (0xB4-0xB6, 0xB8-0xBA)
 		int stereo_reg = 0xB4 + ch_offset;
 		if (channel >= 3)
 			stereo_reg = 0xB8 + ch_offset;
-		fm_reg[reg_base][stereo_reg] = rand() % 256;
+		put(reg_base, stereo_reg, rand() % 256);
 	}
 
 	// Corrupt global registers for maximum chaos
 	// LFO register (0x22) - affects all channels
-	fm_reg[0][0x22] = rand() % 256;
+	put(0, 0x22, rand() % 256);
 
 	// Timer registers (can affect rhythm and timing)
-	fm_reg[0][0x24] = rand() % 256;
-	fm_reg[0][0x25] = rand() % 256;
-	fm_reg[0][0x26] = rand() % 256;
-	fm_reg[0][0x27] = rand() % 256;
+	put(0, 0x24, rand() % 256);
+	put(0, 0x25, rand() % 256);
+	put(0, 0x26, rand() % 256);
+	put(0, 0x27, rand() % 256);
 
 	// DAC enable/disable and data (can cause dramatic volume changes)
-	fm_reg[0][0x2A] = rand() % 256; // DAC data
-	fm_reg[0][0x2B] = rand() % 256; // DAC enable
+	put(0, 0x2A, rand() % 256); // DAC data
+	put(0, 0x2B, rand() % 256); // DAC enable
 
 	// Corrupt more global settings
 	for (int reg = 0x28; reg <= 0x2F; reg++)
 	{
 		if (rand() % 2 == 0) // 50% chance each
-			fm_reg[0][reg] = rand() % 256;
+			put(0, reg, rand() % 256);
 	}
 
-	fprintf(stderr, "%s: YM2612 register corruption complete (aggressive mode).\n", __func__);
+	// Everything reaches the chip at once.
+	myfm_write_regs(w, n);
 }
 
 /**
@@ -643,8 +811,6 @@ void md::corrupt_ym2612_registers()
  */
 void md::corrupt_psg_registers()
 {
-	fprintf(stderr, "%s: Corrupting PSG registers...\n", __func__);
-
 	// The PSG has 4 channels (3 tone + 1 noise)
 	// Corrupt frequency and volume registers
 	for (int i = 0; i < 8; i++) // 8 registers total
@@ -654,10 +820,9 @@ void md::corrupt_psg_registers()
 			// Use SN76496Write to send random values to PSG
 			int value = 0x80 | (i << 4) | (rand() % 16); // Command + data format
 			SN76496Write(0, value);
+			chaos_log(CHAOS_PSG_REG, i, 0, value);
 		}
 	}
-
-	fprintf(stderr, "%s: PSG register corruption complete.\n", __func__);
 }
 
 /**
@@ -671,7 +836,7 @@ void md::bitcrush_audio_memory(int bits_to_clear)
 		return;
 	}
 
-	fprintf(stderr, "%s: Applying bitcrush effect (clearing %d bits)...\n", __func__, bits_to_clear);
+	chaos_log(CHAOS_Z80_BITCRUSH, 0x100, 0, bits_to_clear);
 
 	uint8_t mask = 0xFF << bits_to_clear; // Create mask to clear lower bits
 
@@ -680,8 +845,6 @@ void md::bitcrush_audio_memory(int bits_to_clear)
 	{
 		z80ram[i] &= mask;
 	}
-
-	fprintf(stderr, "%s: Bitcrush effect applied.\n", __func__);
 }
 
 /**
@@ -689,7 +852,8 @@ void md::bitcrush_audio_memory(int bits_to_clear)
  */
 void md::detune_fm_registers()
 {
-	fprintf(stderr, "%s: Detuning FM registers...\n", __func__);
+	struct ym2612_reg_write w[6 * 2];
+	unsigned int n = 0;
 
 	// Apply random detuning to all FM channels
 	for (int channel = 0; channel < 6; channel++)
@@ -707,9 +871,11 @@ void md::detune_fm_registers()
 		int new_freq_low = fm_reg[reg_bank][freq_low_reg] + (rand() % 64) - 32;
 		new_freq_low = (new_freq_low < 0) ? 0 : ((new_freq_low > 255) ? 255 : new_freq_low);
 
-		// Write to hardware: first select register, then write data
-		myfm_write((reg_bank << 1) | 0, freq_low_reg, 1); // Select register
-		myfm_write((reg_bank << 1) | 1, new_freq_low, 1); // Write data
+		chaos_log(CHAOS_FM_DETUNE, ((reg_bank << 8) | freq_low_reg),
+			  fm_reg[reg_bank][freq_low_reg], new_freq_low);
+		w[n].reg = ((reg_bank << 8) | freq_low_reg);
+		w[n].val = new_freq_low;
+		++n;
 
 		// Also detune the frequency high byte
 		int freq_high_reg = 0xA4 + ch_offset;
@@ -719,12 +885,15 @@ void md::detune_fm_registers()
 		int new_freq_high = fm_reg[reg_bank][freq_high_reg] + (rand() % 16) - 8;
 		new_freq_high = (new_freq_high < 0) ? 0 : ((new_freq_high > 63) ? 63 : new_freq_high); // High byte only uses 6 bits
 
-		// Write to hardware
-		myfm_write((reg_bank << 1) | 0, freq_high_reg, 1); // Select register
-		myfm_write((reg_bank << 1) | 1, new_freq_high, 1); // Write data
+		chaos_log(CHAOS_FM_DETUNE, ((reg_bank << 8) | freq_high_reg),
+			  fm_reg[reg_bank][freq_high_reg], new_freq_high);
+		w[n].reg = ((reg_bank << 8) | freq_high_reg);
+		w[n].val = new_freq_high;
+		++n;
 	}
 
-	fprintf(stderr, "%s: FM register detuning complete.\n", __func__);
+	// Write to hardware
+	myfm_write_regs(w, n);
 }
 
 /**
@@ -732,8 +901,8 @@ void md::detune_fm_registers()
  */
 void md::enable_fm_corruption()
 {
+	chaos_log(CHAOS_FM_CORRUPTION, 0, fm_corruption_enabled, 1);
 	fm_corruption_enabled = true;
-	fprintf(stderr, "%s: FM corruption enabled - all FM writes will be corrupted.\n", __func__);
 }
 
 /**
@@ -741,8 +910,25 @@ void md::enable_fm_corruption()
  */
 void md::disable_fm_corruption()
 {
+	chaos_log(CHAOS_FM_CORRUPTION, 0, fm_corruption_enabled, 0);
 	fm_corruption_enabled = false;
-	fprintf(stderr, "%s: FM corruption disabled.\n", __func__);
+}
+
+/**
+ * Corrupt dac_corrupt random DAC writes of the frame (dac_resample()).
+ */
+void md::dac_corrupt_writes()
+{
+	unsigned int i;
+
+	for (i = 0; ((i != dac_corrupt) && (dac_writes_len)); ++i) {
+		unsigned int index = (rand() % dac_writes_len);
+		uint8_t old_value = dac_writes[index].d;
+
+		dac_writes[index].d = (rand() % 256); // Random 8-bit value
+		chaos_log(CHAOS_DAC_DATA, index, old_value, dac_writes[index].d);
+	}
+	dac_corrupt = 0;
 }
 
 /**
@@ -751,27 +937,16 @@ void md::disable_fm_corruption()
  */
 void md::corrupt_dac_data()
 {
-	fprintf(stderr, "%s: Corrupting DAC data...\n", __func__);
-
-	// Corrupt multiple DAC samples for more noticeable effect
-	int corruptions = rand() % 64 + 16; // Corrupt 16-80 samples
-	for (int i = 0; i < corruptions && i < 0x400; i++)
-	{
-		int index = rand() % 0x400; // Random index in DAC buffer
-		unsigned char old_value = dac_data[index];
-		dac_data[index] = rand() % 256; // Random 8-bit value
-		if (i < 5)
-		{ // Log first few for debugging
-			fprintf(stderr, "%s: DAC[%d]: 0x%02X -> 0x%02X\n", __func__, index, old_value, dac_data[index]);
-		}
-	}
+	// Corrupt multiple DAC samples for more noticeable effect: 16-80 of
+	// the writes of the next frame, in bulk when it is resampled
+	dac_corrupt = rand() % 64 + 16;
 
 	// Corrupt DAC length to cause buffer overruns/underruns
 	if (rand() % 3 == 0)
 	{ // 33% chance
 		unsigned int old_len = dac_len;
 		dac_len = rand() % 0x400; // Set to random length
-		fprintf(stderr, "%s: DAC length: %u -> %u\n", __func__, old_len, dac_len);
+		chaos_log(CHAOS_DAC_LEN, 0, old_len, dac_len);
 	}
 
 	// Randomly enable/disable DAC
@@ -779,8 +954,6 @@ void md::corrupt_dac_data()
 	{ // 25% chance
 		bool old_enabled = dac_enabled;
 		dac_enabled = rand() % 2;
-		fprintf(stderr, "%s: DAC enabled: %d -> %d\n", __func__, old_enabled, dac_enabled);
+		chaos_log(CHAOS_DAC_ENABLE, 0, old_enabled, dac_enabled);
 	}
-
-	fprintf(stderr, "%s: DAC data corruption complete (%d samples).\n", __func__, corruptions);
 }
@@ -0,0 +1,475 @@
+/**
+ * Vectorized rows for the CTV filters (blur, scanline, swab).
+ *
+ * SSE2 and AVX2 on x86 (chosen at runtime, AVX2 functions are compiled for
+ * that target only), NEON on ARM. Everything else uses the plain loops in
+ * sdl.cpp, which these must match bit for bit.
+ *
+ * Blur and scanline work on 32-bit lanes whatever the depth, with masks
+ * that keep each color component to itself:
+ * - blur: (a & b) + (((a ^ b) >> 1) & mask), the average of each component
+ *   rounded down, then "last" for the bits the C version drops (the top bit
+ *   of 32 bpp pixels, bit 15 at 15 bpp).
+ * - scanline: (a >> 1) & mask.
+ * Blur pixels depend on the pixel on their left and are processed from the
+ * right end of the row so that input and output can be the same. At 24 bpp
+ * vectors come in groups of three to stop on a pixel boundary.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "ctv.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CTV_X86
+#include <immintrin.h>
+#if defined(__x86_64__) || defined(__SSE2__)
+#define CTV_SSE2_ALWAYS
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CTV_NEON
+#include <arm_neon.h>
+#endif
+
+/// Lane masks for a depth.
+struct ctv_masks
+{
+	unsigned int Bpp; ///< bytes per pixel
+	uint32_t blur;	  ///< applied to ((a ^ b) >> 1)
+	uint32_t last;	  ///< applied to the blur result
+	uint32_t half;	  ///< applied to (a >> 1)
+};
+
+static const struct ctv_masks *ctv_masks(unsigned int bpp)
+{
+	static const struct ctv_masks masks[] = {
+		{4, 0x7f7f7f7f, 0x7fffffff, 0x7f7f7f7f}, // 32
+		{3, 0x7f7f7f7f, 0xffffffff, 0x7f7f7f7f}, // 24
+		{2, 0x7bef7bef, 0xffffffff, 0x7bef7bef}, // 16
+		{2, 0x3def3def, 0x7fff7fff, 0x3def3def}, // 15
+	};
+
+	switch (bpp)
+	{
+	case 32:
+		return &masks[0];
+	case 24:
+		return &masks[1];
+	case 16:
+		return &masks[2];
+	case 15:
+		return &masks[3];
+	}
+	return NULL;
+}
+
+/**
+ * Number of vectors of "size" bytes to process in "len" bytes.
+ */
+static unsigned int ctv_vectors(unsigned int len, unsigned int size,
+								unsigned int Bpp)
+{
+	unsigned int n = (len / size);
+
+	if (Bpp == 3)
+		n -= (n % 3);
+	return n;
+}
+
+static unsigned int ctv_none_blur(uint8_t *, const uint8_t *,
+								  unsigned int width, unsigned int)
+{
+	return width;
+}
+
+static unsigned int ctv_none_row(uint8_t *, const uint8_t *,
+								 unsigned int, unsigned int)
+{
+	return 0;
+}
+
+static const struct ctv_simd ctv_none = {
+	"none", ctv_none_blur, ctv_none_row, ctv_none_row};
+
+#ifdef CTV_X86
+
+#ifdef CTV_SSE2_ALWAYS
+#define CTV_SSE2
+#else
+#define CTV_SSE2 __attribute__((target("sse2")))
+#endif
+#define CTV_AVX2 __attribute__((target("avx2")))
+
+CTV_SSE2
+static unsigned int ctv_sse2_blur(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if ((m == NULL) || (width == 0))
+		return width;
+	const __m128i blur = _mm_set1_epi32(m->blur);
+	const __m128i last = _mm_set1_epi32(m->last);
+
+	i = (width * m->Bpp);
+	n = ctv_vectors((i - m->Bpp), 16, m->Bpp);
+	while (n--)
+	{
+		i -= 16;
+		__m128i a = _mm_loadu_si128((const __m128i *)&src[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&src[i - m->Bpp]);
+		__m128i x = _mm_and_si128(_mm_srli_epi32(_mm_xor_si128(a, b), 1),
+								  blur);
+
+		x = _mm_add_epi32(_mm_and_si128(a, b), x);
+		_mm_storeu_si128((__m128i *)&dst[i], _mm_and_si128(x, last));
+	}
+	return (i / m->Bpp);
+}
+
+CTV_SSE2
+static unsigned int ctv_sse2_scanline(uint8_t *dst, const uint8_t *src,
+									  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if (m == NULL)
+		return 0;
+	const __m128i half = _mm_set1_epi32(m->half);
+
+	n = ctv_vectors((width * m->Bpp), 16, m->Bpp);
+	for (i = 0; (n != 0); --n, i += 16)
+	{
+		__m128i a = _mm_loadu_si128((const __m128i *)&src[i]);
+
+		_mm_storeu_si128((__m128i *)&dst[i],
+						 _mm_and_si128(_mm_srli_epi32(a, 1), half));
+	}
+	return (i / m->Bpp);
+}
+
+CTV_SSE2
+static inline __m128i ctv_sse2_swab16(__m128i a)
+{
+	return _mm_or_si128(_mm_slli_epi16(a, 8), _mm_srli_epi16(a, 8));
+}
+
+CTV_SSE2
+static unsigned int ctv_sse2_swab(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int Bpp)
+{
+	unsigned int i = 0;
+	unsigned int n;
+
+	if ((Bpp != 2) && (Bpp != 3) && (Bpp != 4))
+		return 0;
+	n = ctv_vectors((width * Bpp), 16, Bpp);
+	if (Bpp == 3)
+	{
+		// Byte 0 of each pixel comes from 2 bytes to the right, byte 2
+		// from 2 bytes to the left, in groups of 16 pixels.
+		static const uint8_t sel[3][3][16] = {
+#define CTV_SEL(g)                                                  \
+	{(((g) % 3) == 0) * 0xff, (((g) + 1) % 3 == 0) * 0xff,          \
+	 (((g) + 2) % 3 == 0) * 0xff, (((g) + 3) % 3 == 0) * 0xff,      \
+	 (((g) + 4) % 3 == 0) * 0xff, (((g) + 5) % 3 == 0) * 0xff,      \
+	 (((g) + 6) % 3 == 0) * 0xff, (((g) + 7) % 3 == 0) * 0xff,      \
+	 (((g) + 8) % 3 == 0) * 0xff, (((g) + 9) % 3 == 0) * 0xff,      \
+	 (((g) + 10) % 3 == 0) * 0xff, (((g) + 11) % 3 == 0) * 0xff,    \
+	 (((g) + 12) % 3 == 0) * 0xff, (((g) + 13) % 3 == 0) * 0xff,    \
+	 (((g) + 14) % 3 == 0) * 0xff, (((g) + 15) % 3 == 0) * 0xff}
+			// Byte 0, vectors 0, 1 and 2.
+			{CTV_SEL(0), CTV_SEL(16), CTV_SEL(32)},
+			// Byte 1.
+			{CTV_SEL(2), CTV_SEL(18), CTV_SEL(34)},
+			// Byte 2.
+			{CTV_SEL(1), CTV_SEL(17), CTV_SEL(33)},
+#undef CTV_SEL
+		};
+		const __m128i zero = _mm_setzero_si128();
+
+		for (n /= 3; (n != 0); --n, i += 48)
+		{
+			__m128i v[5];
+			unsigned int k;
+
+			v[0] = zero;
+			v[1] = _mm_loadu_si128((const __m128i *)&src[i]);
+			v[2] = _mm_loadu_si128((const __m128i *)&src[i + 16]);
+			v[3] = _mm_loadu_si128((const __m128i *)&src[i + 32]);
+			v[4] = zero;
+			for (k = 0; (k != 3); ++k)
+			{
+				__m128i l = _mm_or_si128(_mm_slli_si128(v[k + 1], 2),
+										 _mm_srli_si128(v[k], 14));
+				__m128i r = _mm_or_si128(_mm_srli_si128(v[k + 1], 2),
+										 _mm_slli_si128(v[k + 2], 14));
+				__m128i x;
+
+				x = _mm_and_si128(r, _mm_loadu_si128((const __m128i *)
+													 sel[0][k]));
+				x = _mm_or_si128(x, _mm_and_si128(v[k + 1],
+												  _mm_loadu_si128(
+													  (const __m128i *)
+														  sel[1][k])));
+				x = _mm_or_si128(x, _mm_and_si128(l,
+												  _mm_loadu_si128(
+													  (const __m128i *)
+														  sel[2][k])));
+				_mm_storeu_si128((__m128i *)&dst[i + (k * 16)], x);
+			}
+		}
+		return (i / 3);
+	}
+	for (; (n != 0); --n, i += 16)
+	{
+		__m128i a = ctv_sse2_swab16(
+			_mm_loadu_si128((const __m128i *)&src[i]));
+
+		if (Bpp == 4)
+		{
+			a = _mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+			a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+		_mm_storeu_si128((__m128i *)&dst[i], a);
+	}
+	return (i / Bpp);
+}
+
+static const struct ctv_simd ctv_sse2 = {
+	"SSE2", ctv_sse2_blur, ctv_sse2_scanline, ctv_sse2_swab};
+
+CTV_AVX2
+static unsigned int ctv_avx2_blur(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if ((m == NULL) || (width == 0))
+		return width;
+	const __m256i blur = _mm256_set1_epi32(m->blur);
+	const __m256i last = _mm256_set1_epi32(m->last);
+
+	i = (width * m->Bpp);
+	n = ctv_vectors((i - m->Bpp), 32, m->Bpp);
+	while (n--)
+	{
+		i -= 32;
+		__m256i a = _mm256_loadu_si256((const __m256i *)&src[i]);
+		__m256i b = _mm256_loadu_si256((const __m256i *)
+									   &src[i - m->Bpp]);
+		__m256i x = _mm256_and_si256(
+			_mm256_srli_epi32(_mm256_xor_si256(a, b), 1), blur);
+
+		x = _mm256_add_epi32(_mm256_and_si256(a, b), x);
+		_mm256_storeu_si256((__m256i *)&dst[i],
+							_mm256_and_si256(x, last));
+	}
+	return (i / m->Bpp);
+}
+
+CTV_AVX2
+static unsigned int ctv_avx2_scanline(uint8_t *dst, const uint8_t *src,
+									  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if (m == NULL)
+		return 0;
+	const __m256i half = _mm256_set1_epi32(m->half);
+
+	n = ctv_vectors((width * m->Bpp), 32, m->Bpp);
+	for (i = 0; (n != 0); --n, i += 32)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i *)&src[i]);
+
+		_mm256_storeu_si256((__m256i *)&dst[i],
+							_mm256_and_si256(_mm256_srli_epi32(a, 1),
+											 half));
+	}
+	return (i / m->Bpp);
+}
+
+CTV_AVX2
+static unsigned int ctv_avx2_swab(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int Bpp)
+{
+	unsigned int len = (width * Bpp);
+	unsigned int i = 0;
+
+	if (Bpp == 3)
+	{
+		// Four pixels in each 128-bit lane, the last 4 bytes of a lane
+		// are written back unchanged and replaced by the next store.
+		const __m256i rev = _mm256_setr_epi8(
+			2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15,
+			2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15);
+
+		for (; ((i + 28) <= len); i += 24)
+		{
+			__m256i a = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(
+					_mm_loadu_si128((const __m128i *)&src[i])),
+				_mm_loadu_si128((const __m128i *)&src[i + 12]), 1);
+
+			a = _mm256_shuffle_epi8(a, rev);
+			_mm_storeu_si128((__m128i *)&dst[i],
+							 _mm256_castsi256_si128(a));
+			_mm_storeu_si128((__m128i *)&dst[i + 12],
+							 _mm256_extracti128_si256(a, 1));
+		}
+		return (i / 3);
+	}
+	if ((Bpp != 2) && (Bpp != 4))
+		return 0;
+	const __m256i rev = ((Bpp == 4) ?
+						 _mm256_setr_epi8(
+							 3, 2, 1, 0, 7, 6, 5, 4,
+							 11, 10, 9, 8, 15, 14, 13, 12,
+							 3, 2, 1, 0, 7, 6, 5, 4,
+							 11, 10, 9, 8, 15, 14, 13, 12) :
+						 _mm256_setr_epi8(
+							 1, 0, 3, 2, 5, 4, 7, 6,
+							 9, 8, 11, 10, 13, 12, 15, 14,
+							 1, 0, 3, 2, 5, 4, 7, 6,
+							 9, 8, 11, 10, 13, 12, 15, 14));
+
+	for (; ((i + 32) <= len); i += 32)
+	{
+		__m256i a = _mm256_loadu_si256((const __m256i *)&src[i]);
+
+		_mm256_storeu_si256((__m256i *)&dst[i],
+							_mm256_shuffle_epi8(a, rev));
+	}
+	return (i / Bpp);
+}
+
+static const struct ctv_simd ctv_avx2 = {
+	"AVX2", ctv_avx2_blur, ctv_avx2_scanline, ctv_avx2_swab};
+
+#endif // CTV_X86
+
+#ifdef CTV_NEON
+
+static unsigned int ctv_neon_blur(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if ((m == NULL) || (width == 0))
+		return width;
+	const uint32x4_t blur = vdupq_n_u32(m->blur);
+	const uint32x4_t last = vdupq_n_u32(m->last);
+
+	i = (width * m->Bpp);
+	n = ctv_vectors((i - m->Bpp), 16, m->Bpp);
+	while (n--)
+	{
+		i -= 16;
+		uint32x4_t a = vreinterpretq_u32_u8(vld1q_u8(&src[i]));
+		uint32x4_t b = vreinterpretq_u32_u8(vld1q_u8(&src[i - m->Bpp]));
+		uint32x4_t x = vandq_u32(vshrq_n_u32(veorq_u32(a, b), 1), blur);
+
+		x = vaddq_u32(vandq_u32(a, b), x);
+		vst1q_u8(&dst[i], vreinterpretq_u8_u32(vandq_u32(x, last)));
+	}
+	return (i / m->Bpp);
+}
+
+static unsigned int ctv_neon_scanline(uint8_t *dst, const uint8_t *src,
+									  unsigned int width, unsigned int bpp)
+{
+	const struct ctv_masks *m = ctv_masks(bpp);
+	unsigned int i;
+	unsigned int n;
+
+	if (m == NULL)
+		return 0;
+	const uint32x4_t half = vdupq_n_u32(m->half);
+
+	n = ctv_vectors((width * m->Bpp), 16, m->Bpp);
+	for (i = 0; (n != 0); --n, i += 16)
+	{
+		uint32x4_t a = vreinterpretq_u32_u8(vld1q_u8(&src[i]));
+
+		vst1q_u8(&dst[i],
+				 vreinterpretq_u8_u32(vandq_u32(vshrq_n_u32(a, 1), half)));
+	}
+	return (i / m->Bpp);
+}
+
+static unsigned int ctv_neon_swab(uint8_t *dst, const uint8_t *src,
+								  unsigned int width, unsigned int Bpp)
+{
+	unsigned int len = (width * Bpp);
+	unsigned int i = 0;
+
+	switch (Bpp)
+	{
+	case 2:
+		for (; ((i + 16) <= len); i += 16)
+			vst1q_u8(&dst[i], vrev16q_u8(vld1q_u8(&src[i])));
+		break;
+	case 3:
+		for (; ((i + 48) <= len); i += 48)
+		{
+			uint8x16x3_t a = vld3q_u8(&src[i]);
+			uint8x16_t tmp = a.val[0];
+
+			a.val[0] = a.val[2];
+			a.val[2] = tmp;
+			vst3q_u8(&dst[i], a);
+		}
+		break;
+	case 4:
+		for (; ((i + 16) <= len); i += 16)
+			vst1q_u8(&dst[i], vrev32q_u8(vld1q_u8(&src[i])));
+		break;
+	default:
+		return 0;
+	}
+	return (i / Bpp);
+}
+
+static const struct ctv_simd ctv_neon = {
+	"NEON", ctv_neon_blur, ctv_neon_scanline, ctv_neon_swab};
+
+#endif // CTV_NEON
+
+static const struct ctv_simd *ctv_simd_select()
+{
+#ifdef CTV_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return &ctv_avx2;
+#ifdef CTV_SSE2_ALWAYS
+	return &ctv_sse2;
+#else
+	if (__builtin_cpu_supports("sse2"))
+		return &ctv_sse2;
+#endif
+#endif
+#ifdef CTV_NEON
+	return &ctv_neon;
+#endif
+	return &ctv_none;
+}
+
+const struct ctv_simd *ctv_simd()
+{
+	static const struct ctv_simd *simd = ctv_simd_select();
+
+	return simd;
+}
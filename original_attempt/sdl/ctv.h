@@ -0,0 +1,40 @@
+/**
+ * Vectorized rows for the CTV filters (blur, scanline, swab).
+ */
+
+#ifndef CTV_H_
+#define CTV_H_
+
+#include <stdint.h>
+
+/**
+ * Row functions of one instruction set.
+ * They process as many pixels as they can with whole vectors and return,
+ * the caller does the others with its regular loop. Input and output may be
+ * the same buffer.
+ * @param dst Output row.
+ * @param src Input row.
+ * @param width Number of pixels in the row.
+ * @param bpp Depth (15, 16, 24 or 32), swab() takes bytes per pixel
+ * (2, 3 or 4) instead.
+ */
+struct ctv_simd
+{
+	const char *name; ///< Instruction set.
+	/// Blur, pixels from the returned index to width are done.
+	unsigned int (*blur)(uint8_t *dst, const uint8_t *src,
+						 unsigned int width, unsigned int bpp);
+	/// Darken, pixels up to the returned index are done.
+	unsigned int (*scanline)(uint8_t *dst, const uint8_t *src,
+							 unsigned int width, unsigned int bpp);
+	/// Byte swap, pixels up to the returned index are done.
+	unsigned int (*swab)(uint8_t *dst, const uint8_t *src,
+						 unsigned int width, unsigned int Bpp);
+};
+
+/**
+ * Return the fastest implementation supported by this CPU.
+ */
+extern const struct ctv_simd *ctv_simd();
+
+#endif // CTV_H_
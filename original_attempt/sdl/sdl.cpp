@@ -27,6 +27,7 @@
 #ifdef WITH_THREADS
 #include <SDL_thread.h>
 #endif
+#include <atomic>
 
 #ifdef HAVE_MEMCPY_H
 #include "memcpy.h"
@@ -54,6 +55,10 @@ extern "C"
 }
 #endif
 
+#ifdef WITH_CTV
+#include "ctv.h"
+#endif
+
 /// Number of microseconds to sustain messages
 #define MESSAGE_LIFE 3000000
 
@@ -98,11 +103,35 @@ struct texture
 		uint16_t *u16;
 		uint32_t *u32;
 	} buf; ///< 16 or 32-bit buffer
+	unsigned int shaders : 1; ///< shaders are available (mdscr is 8 bpp)
+	GLuint program;			  ///< filters stack shaders, 0 when on the CPU
+	GLint frame_loc;		  ///< location of the "frame" uniform
+	unsigned int frame;		  ///< interlace parity
+	GLuint md_id;			  ///< raw frame texture (palette indices)
+	GLuint pal_id;			  ///< palette texture
+	unsigned int md_width;	  ///< raw frame texture width
+	unsigned int md_height;	  ///< raw frame texture height
+	uint32_t pal[64];		  ///< palette at texture depth
+	bpp_t expand;			  ///< raw frame at texture depth for the CPU
+	GLuint pbo[2];			  ///< pixel buffer objects, 0 when not streaming
+	unsigned int pbo_next;	  ///< next one (or slot) to fill
+	size_t pbo_size;		  ///< bytes per frame (visible rectangle)
+	uint8_t *pbo_map;		  ///< persistent mapping of pbo[0], two slots
+	struct pbo_sync *pbo_fence[2]; ///< GLsync of each slot's last upload
 };
 
 static void release_texture(struct texture &);
 static int init_texture(struct screen *);
-static void update_texture(struct texture &);
+static void update_texture(struct texture &, const void *);
+static void pbo_release(struct texture &);
+static void pbo_init(struct texture &);
+static bool pbo_upload(struct texture &, const void *);
+static void shaders_release(struct texture &);
+static void shaders_init(struct texture &);
+static void shaders_draw(struct texture &, const void *);
+static void shaders_update();
+static void shaders_palette(struct texture &, const uint8_t *);
+static void shaders_expand(struct texture &);
 
 #endif // WITH_OPENGL
 
@@ -131,8 +160,6 @@ struct screen
 	unsigned int want_thread : 1; ///< want updates from a separate thread
 	unsigned int is_thread : 1;	  ///< thread is present
 	SDL_Thread *thread;			  ///< thread itself
-	SDL_mutex *lock;			  ///< lock for updates
-	SDL_cond *cond;				  ///< condition variable to signal updates
 #endif
 	SDL_Color color[64]; ///< SDL colors for 8bpp modes
 };
@@ -175,23 +202,29 @@ static struct
 	{0}};
 
 /**
- * Call this before accessing screen.buf.
- * No syscalls allowed before screen_unlock().
+ * Tell whether screen_lock() actually locks the surface.
  */
-static int screen_lock()
+static bool screen_must_lock()
 {
 #ifdef WITH_THREADS
+	// screen.buf is then a private buffer (see screen_frames).
 	if (screen.is_thread)
-	{
-		assert(screen.lock != NULL);
-		SDL_LockMutex(screen.lock);
-	}
+		return false;
 #endif
 #ifdef WITH_OPENGL
 	if (screen.is_opengl)
-		return 0;
+		return false;
 #endif
-	if (SDL_MUSTLOCK(screen.surface) == 0)
+	return (SDL_MUSTLOCK(screen.surface) != 0);
+}
+
+/**
+ * Call this before accessing screen.buf.
+ * No syscalls allowed before screen_unlock().
+ */
+static int screen_lock()
+{
+	if (!screen_must_lock())
 		return 0;
 	return SDL_LockSurface(screen.surface);
 }
@@ -201,34 +234,42 @@ static int screen_lock()
  */
 static void screen_unlock()
 {
-#ifdef WITH_THREADS
-	if (screen.is_thread)
-	{
-		assert(screen.lock != NULL);
-		SDL_UnlockMutex(screen.lock);
-	}
-#endif
-#ifdef WITH_OPENGL
-	if (screen.is_opengl)
-		return;
-#endif
-	if (SDL_MUSTLOCK(screen.surface) == 0)
+	if (!screen_must_lock())
 		return;
 	SDL_UnlockSurface(screen.surface);
 }
 
 /**
+ * Show a frame.
  * Do not call this directly, use screen_update() instead.
+ * @param buf Frame data (screen.pitch * screen.height bytes), screen.buf
+ * when not called from the screen thread.
  */
-static void screen_update_once()
+static void screen_present(const uint8_t *buf)
 {
 #ifdef WITH_OPENGL
 	if (screen.is_opengl)
 	{
-		update_texture(screen.texture);
+		update_texture(screen.texture, buf);
 		return;
 	}
 #endif
+	if (buf != (uint8_t *)screen.surface->pixels)
+	{
+		unsigned int y;
+
+		if ((SDL_MUSTLOCK(screen.surface)) &&
+			(SDL_LockSurface(screen.surface)))
+			return;
+		// Flipping may have moved pixels, see SDL_DOUBLEBUF.
+		for (y = 0; (y != screen.height); ++y)
+			memcpy(((uint8_t *)screen.surface->pixels +
+					(y * screen.surface->pitch)),
+				   (buf + (y * screen.pitch)),
+				   (screen.width * screen.Bpp));
+		if (SDL_MUSTLOCK(screen.surface))
+			SDL_UnlockSurface(screen.surface);
+	}
 	// Draw VRAM control window overlay
 	// vram_control_draw(); // Disabled as I think keyboard buttons are working better
 	SDL_Flip(screen.surface);
@@ -236,65 +277,122 @@ static void screen_update_once()
 
 #ifdef WITH_THREADS
 
+/**
+ * Triple buffering between the emulation and the screen thread.
+ * While the thread runs, screen.buf points to a private work buffer instead
+ * of the surface. screen_update() copies it into the free slot "back" and
+ * publishes it by swapping "back" with "ready". The thread swaps "ready"
+ * with "front" when it holds a new frame and shows "front". Neither side
+ * waits for the other: a slow SDL_Flip() (V-sync) only drops frames, and a
+ * frame published before the previous one was shown replaces it.
+ */
+#define SCREEN_FRAME_NEW 0x4 ///< set in "ready" until the thread takes it
+
+static struct
+{
+	uint8_t *work;					///< screen.buf while the thread runs
+	uint8_t *slot[3];				///< frames
+	unsigned int back;				///< slot written by screen_update()
+	unsigned int front;				///< slot shown by the thread
+	std::atomic<unsigned int> ready; ///< last published slot
+	std::atomic<bool> quit;			///< the thread must return
+	SDL_sem *wake;					///< posted after publishing
+} screen_frames;
+
 static int screen_update_thread(void *)
 {
-	assert(screen.lock != NULL);
-	assert(screen.cond != NULL);
-	SDL_LockMutex(screen.lock);
-	while (screen.want_thread)
+	assert(screen_frames.wake != NULL);
+	while ((SDL_SemWait(screen_frames.wake) == 0) &&
+		   (!screen_frames.quit.load()))
 	{
-		SDL_CondWait(screen.cond, screen.lock);
-		screen_update_once();
+		unsigned int ready = screen_frames.ready.load();
+
+		do
+			if (!(ready & SCREEN_FRAME_NEW))
+				break;
+		while (!screen_frames.ready.compare_exchange_weak
+			   (ready, screen_frames.front));
+		if (!(ready & SCREEN_FRAME_NEW))
+			continue;
+		screen_frames.front = (ready & ~SCREEN_FRAME_NEW);
+		screen_present(screen_frames.slot[screen_frames.front]);
 	}
-	SDL_UnlockMutex(screen.lock);
 	return 0;
 }
 
+static void screen_frames_free()
+{
+	unsigned int i;
+
+	free(screen_frames.work);
+	screen_frames.work = NULL;
+	for (i = 0; (i != elemof(screen_frames.slot)); ++i)
+	{
+		free(screen_frames.slot[i]);
+		screen_frames.slot[i] = NULL;
+	}
+	if (screen_frames.wake != NULL)
+	{
+		SDL_DestroySemaphore(screen_frames.wake);
+		screen_frames.wake = NULL;
+	}
+}
+
 static void screen_update_thread_start()
 {
+	size_t size = (screen.pitch * screen.height);
+	unsigned int i;
+
 	DEBUG(("starting thread..."));
 	assert(screen.want_thread);
-	assert(screen.lock == NULL);
-	assert(screen.cond == NULL);
 	assert(screen.thread == NULL);
+	assert(screen_frames.wake == NULL);
 #ifdef WITH_OPENGL
 	if (screen.is_opengl)
 	{
+		// SDL 1.2 has no way to make the context current in
+		// another thread.
 		DEBUG(("this is not supported when OpenGL is enabled"));
 		return;
 	}
 #endif
-	if ((screen.lock = SDL_CreateMutex()) == NULL)
+	if ((screen_frames.work = (uint8_t *)malloc(size)) == NULL)
 	{
-		DEBUG(("unable to create lock"));
+		DEBUG(("unable to allocate buffers"));
 		goto error;
 	}
-
-	if ((screen.cond = SDL_CreateCond()) == NULL)
+	for (i = 0; (i != elemof(screen_frames.slot)); ++i)
+		if ((screen_frames.slot[i] = (uint8_t *)malloc(size)) == NULL)
+		{
+			DEBUG(("unable to allocate buffers"));
+			goto error;
+		}
+	if ((screen_frames.wake = SDL_CreateSemaphore(0)) == NULL)
 	{
-		DEBUG(("unable to create condition variable"));
+		DEBUG(("unable to create semaphore"));
 		goto error;
 	}
+	// Keep the current picture, including the message bar.
+	if (screen_lock())
+		goto error;
+	memcpy(screen_frames.work, screen.buf.u8, size);
+	screen_unlock();
+	screen_frames.back = 0;
+	screen_frames.front = 1;
+	screen_frames.ready.store(2);
+	screen_frames.quit.store(false);
 	screen.thread = SDL_CreateThread(screen_update_thread, NULL);
 	if (screen.thread == NULL)
 	{
 		DEBUG(("unable to start thread"));
 		goto error;
 	}
+	screen.buf.u8 = screen_frames.work;
 	screen.is_thread = 1;
 	DEBUG(("thread started"));
 	return;
 error:
-	if (screen.cond != NULL)
-	{
-		SDL_DestroyCond(screen.cond);
-		screen.cond = NULL;
-	}
-	if (screen.lock != NULL)
-	{
-		SDL_DestroyMutex(screen.lock);
-		screen.lock = NULL;
-	}
+	screen_frames_free();
 }
 
 static void screen_update_thread_stop()
@@ -306,18 +404,39 @@ static void screen_update_thread_stop()
 	}
 	DEBUG(("stopping thread..."));
 	assert(screen.thread != NULL);
-	screen.want_thread = 0;
-	SDL_CondSignal(screen.cond);
+	screen_frames.quit.store(true);
+	SDL_SemPost(screen_frames.wake);
 	SDL_WaitThread(screen.thread, NULL);
 	screen.thread = NULL;
-	SDL_DestroyCond(screen.cond);
-	screen.cond = NULL;
-	SDL_DestroyMutex(screen.lock);
-	screen.lock = NULL;
 	screen.is_thread = 0;
+	// Back to drawing directly on the surface.
+	screen.buf.u8 = (uint8_t *)screen.surface->pixels;
+	if (screen_lock() == 0)
+	{
+		memcpy(screen.buf.u8, screen_frames.work,
+			   (screen.pitch * screen.height));
+		screen_unlock();
+	}
+	screen_frames_free();
 	DEBUG(("thread stopped"));
 }
 
+/**
+ * Publish the frame in screen.buf to the screen thread.
+ */
+static void screen_frames_publish()
+{
+	memcpy(screen_frames.slot[screen_frames.back], screen.buf.u8,
+		   (screen.pitch * screen.height));
+	screen_frames.back =
+		(screen_frames.ready.exchange(screen_frames.back |
+									  SCREEN_FRAME_NEW) &
+		 ~SCREEN_FRAME_NEW);
+	// Leave it at 1 if the thread has not woken up yet.
+	if (SDL_SemValue(screen_frames.wake) == 0)
+		SDL_SemPost(screen_frames.wake);
+}
+
 #endif // WITH_THREADS
 
 /**
@@ -327,10 +446,10 @@ static void screen_update()
 {
 #ifdef WITH_THREADS
 	if (screen.is_thread)
-		SDL_CondSignal(screen.cond);
+		screen_frames_publish();
 	else
 #endif // WITH_THREADS
-		screen_update_once();
+		screen_present(screen.buf.u8);
 }
 
 /**
@@ -361,89 +480,108 @@ const char *pd_options =
 
 static void mdscr_splash();
 
-/// Circular buffer and related functions.
+/**
+ * Single-producer/single-consumer ring buffer.
+ * The emulation thread writes (sring_write()), only the audio callback reads
+ * (sring_read()), no lock is needed: each side owns one of the free-running
+ * indices and publishes it with a release store after copying, the other
+ * side loads it with acquire. Storage is a power of two so positions wrap
+ * with a mask, "limit" is the level data is allowed to reach.
+ */
 typedef struct
 {
-	size_t i;	 ///< data start index
-	size_t s;	 ///< data size
-	size_t size; ///< buffer size
+	std::atomic<size_t> head;			///< write position
+	std::atomic<size_t> tail;			///< read position
+	size_t size;						///< storage size, power of two
+	size_t limit;						///< maximum level
+	std::atomic<unsigned int> underruns; ///< reads that found too little
+	std::atomic<size_t> dropped;		///< bytes not written, ring full
 	union
 	{
 		uint8_t *u8;
 		int16_t *i16;
 	} data; ///< storage
-} cbuf_t;
+} sring_t;
 
 /**
- * Write/copy data into a circular buffer.
- * @param[in,out] cbuf Destination buffer.
+ * Copy data into a ring buffer, as much as fits below its limit.
+ * Producer side only.
+ * @param[in,out] ring Destination buffer.
  * @param[in] src Buffer to copy from.
  * @param size Size of src.
  * @return Number of bytes copied.
  */
-size_t cbuf_write(cbuf_t *cbuf, uint8_t *src, size_t size)
+static size_t sring_write(sring_t *ring, const uint8_t *src, size_t size)
 {
-	size_t j;
-	size_t k;
+	size_t head = ring->head.load(std::memory_order_relaxed);
+	size_t level = (head - ring->tail.load(std::memory_order_acquire));
+	size_t pos = (head & (ring->size - 1));
+	size_t k = (ring->size - pos);
 
-	if (size > cbuf->size)
+	if (size > (ring->limit - level))
 	{
-		src += (size - cbuf->size);
-		size = cbuf->size;
+		ring->dropped.fetch_add((size - (ring->limit - level)),
+								std::memory_order_relaxed);
+		size = (ring->limit - level);
 	}
-	k = (cbuf->size - cbuf->s);
-	j = ((cbuf->i + cbuf->s) % cbuf->size);
-	if (size > k)
-	{
-		cbuf->i = ((cbuf->i + (size - k)) % cbuf->size);
-		cbuf->s = cbuf->size;
-	}
-	else
-		cbuf->s += size;
-	k = (cbuf->size - j);
 	if (k >= size)
-	{
-		memcpy(&cbuf->data.u8[j], src, size);
-	}
+		memcpy(&ring->data.u8[pos], src, size);
 	else
 	{
-		memcpy(&cbuf->data.u8[j], src, k);
-		memcpy(&cbuf->data.u8[0], &src[k], (size - k));
+		memcpy(&ring->data.u8[pos], src, k);
+		memcpy(&ring->data.u8[0], &src[k], (size - k));
 	}
+	ring->head.store((head + size), std::memory_order_release);
 	return size;
 }
 
 /**
- * Read bytes out of a circular buffer.
+ * Read bytes out of a ring buffer.
+ * Consumer side only.
  * @param[out] dst Destination buffer.
- * @param[in,out] cbuf Circular buffer to read from.
+ * @param[in,out] ring Ring buffer to read from.
  * @param size Maximum number of bytes to copy to dst.
  * @return Number of bytes copied.
  */
-size_t cbuf_read(uint8_t *dst, cbuf_t *cbuf, size_t size)
+static size_t sring_read(uint8_t *dst, sring_t *ring, size_t size)
 {
-	if (size > cbuf->s)
-		size = cbuf->s;
-	if ((cbuf->i + size) > cbuf->size)
-	{
-		size_t k = (cbuf->size - cbuf->i);
+	size_t tail = ring->tail.load(std::memory_order_relaxed);
+	size_t level = (ring->head.load(std::memory_order_acquire) - tail);
+	size_t pos = (tail & (ring->size - 1));
+	size_t k = (ring->size - pos);
 
-		memcpy(&dst[0], &cbuf->data.u8[(cbuf->i)], k);
-		memcpy(&dst[k], &cbuf->data.u8[0], (size - k));
+	if (size > level)
+	{
+		ring->underruns.fetch_add(1, std::memory_order_relaxed);
+		size = level;
 	}
+	if (k >= size)
+		memcpy(&dst[0], &ring->data.u8[pos], size);
 	else
-		memcpy(&dst[0], &cbuf->data.u8[(cbuf->i)], size);
-	cbuf->i = ((cbuf->i + size) % cbuf->size);
-	cbuf->s -= size;
+	{
+		memcpy(&dst[0], &ring->data.u8[pos], k);
+		memcpy(&dst[k], &ring->data.u8[0], (size - k));
+	}
+	ring->tail.store((tail + size), std::memory_order_release);
 	return size;
 }
 
+/**
+ * Number of bytes in a ring buffer, from either side.
+ */
+static size_t sring_level(sring_t *ring)
+{
+	size_t tail = ring->tail.load(std::memory_order_acquire);
+
+	return (ring->head.load(std::memory_order_acquire) - tail);
+}
+
 /// Sound
 static struct
 {
 	unsigned int rate;	  ///< samples rate
 	unsigned int samples; ///< number of samples required by the callback
-	cbuf_t cbuf;		  ///< circular buffer
+	sring_t ring;		  ///< playback buffer
 } sound;
 
 /// Messages
@@ -568,6 +706,8 @@ static const char game_genie_str[] = "Enter Game Genie/Hex code: ";
 
 /// Enable emulation by default.
 bool pd_freeze = false;
+bool pd_fast_forward = false;
+bool pd_rewind = false;
 static unsigned int pd_freeze_ref = 0;
 
 static void freeze(bool toggle)
@@ -1086,6 +1226,8 @@ struct filter
 	bool safe : 1;		 ///< Output buffer can be the same as input.
 	bool ctv : 1;		 ///< Part of the CTV filters set.
 	bool resize : 1;	 ///< Filter resizes input.
+	bool split : 1;		 ///< Horizontal bands can be processed separately.
+	unsigned int halo : 2; ///< Rows above/below a band its output depends on.
 };
 
 static filter_func_t filter_scale;
@@ -1107,22 +1249,24 @@ static void set_swab();
 #endif
 
 static const struct filter filters_available[] = {
-	{"stretch", filter_stretch, false, false, true},
-	{"scale", filter_scale, false, false, true},
+	{"stretch", filter_stretch, false, false, true, true, 0},
+	{"scale", filter_scale, false, false, true, true, 0},
 #ifdef WITH_SCALE2X
-	{"scale2x", filter_scale2x, false, false, true},
+	// Scale4x runs Scale2x twice, two rows around are needed.
+	{"scale2x", filter_scale2x, false, false, true, true, 2},
 #endif
 #ifdef WITH_HQX
-	{"hqx", filter_hqx, false, false, true},
+	{"hqx", filter_hqx, false, false, true, true, 1},
 #endif
-	{"none", filter_off, true, false, true},
+	{"none", filter_off, true, false, true, true, 0},
 #ifdef WITH_CTV
 	// These filters must match ctv_names in rc.cpp.
-	{"off", filter_off, true, true, false},
-	{"blur", filter_blur, true, true, false},
-	{"scanline", filter_scanline, true, true, false},
-	{"interlace", filter_interlace, true, true, false},
-	{"swab", filter_swab, true, true, false},
+	{"off", filter_off, true, true, false, true, 0},
+	{"blur", filter_blur, true, true, false, true, 0},
+	{"scanline", filter_scanline, true, true, false, true, 0},
+	// Alternates lines after each call.
+	{"interlace", filter_interlace, true, true, false, false, 0},
+	{"swab", filter_swab, true, true, false, true, 0},
 #endif
 };
 
@@ -1179,6 +1323,14 @@ static void filters_stack_update()
 	};
 	struct filter_data *prev_fd;
 
+#ifdef WITH_OPENGL
+	// The CPU gets palette indices expanded by shaders_expand().
+	if ((screen.is_opengl) && (screen.texture.shaders))
+	{
+		in_fd.buf.u8 = screen.texture.expand.u8;
+		in_fd.pitch = (video.width * screen.Bpp);
+	}
+#endif
 	DEBUG(("updating filters data"));
 retry:
 	assert(filters_stack_size <= elemof(filters_stack));
@@ -1320,6 +1472,9 @@ retry:
 			   filters_stack[i]->name,
 			   (void *)filters_stack_data[i].buf.u8,
 			   (void *)filters_stack_data[i + 1].buf.u8));
+#endif
+#ifdef WITH_OPENGL
+	shaders_update();
 #endif
 	screen_clear();
 }
@@ -1898,6 +2053,8 @@ static void release_texture(struct texture &texture)
 	}
 	free(texture.buf.u32);
 	texture.buf.u32 = NULL;
+	shaders_release(texture);
+	pbo_release(texture);
 }
 
 static int init_texture(struct screen *screen)
@@ -2012,31 +2169,1093 @@ static int init_texture(struct screen *screen)
 		(texture_init_id(texture), error = glGetError()) ||
 		(texture_init_dlist(texture), error = glGetError()))
 	{
-		// Do something with "error".
-		goto fail;
+		// Do something with "error".
+		goto fail;
+	}
+	shaders_init(texture);
+	pbo_init(texture);
+	DEBUG(("texture initialization OK"));
+	return 0;
+fail:
+	release_texture(texture);
+	DEBUG(("texture initialization failed"));
+	return -1;
+}
+
+static void update_texture(struct texture &texture, const void *buf)
+{
+	if (texture.program != 0)
+	{
+		shaders_draw(texture, buf);
+		return;
+	}
+	if ((texture.pbo[0] != 0) && (pbo_upload(texture, buf)))
+		goto draw;
+	glBindTexture(GL_TEXTURE_2D, texture.id);
+	if (texture.u32 == 0)
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+						texture.vis_width, texture.vis_height,
+						GL_RGB, TEXTURE_16_TYPE, buf);
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+						texture.vis_width, texture.vis_height,
+						GL_BGRA, TEXTURE_32_TYPE, buf);
+draw:
+	glCallList(texture.dlist);
+	SDL_GL_SwapBuffers();
+}
+
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88ec
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88e0
+#endif
+#ifndef GL_WRITE_ONLY
+#define GL_WRITE_ONLY 0x88b9
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
+/// Longest wait for the GPU to be done with a slot, in nanoseconds.
+#define PBO_FENCE_TIMEOUT 1000000000ull
+
+/**
+ * Pixel buffer object entry points (OpenGL 2.1), and those of persistent
+ * mapping (OpenGL 4.4), loaded at run time. The headers SDL comes with may
+ * predate the latter, hence the prototypes spelled out here.
+ */
+static struct
+{
+	void (APIENTRY *GenBuffers)(GLsizei, GLuint *);
+	void (APIENTRY *DeleteBuffers)(GLsizei, const GLuint *);
+	GLboolean (APIENTRY *IsBuffer)(GLuint);
+	void (APIENTRY *BindBuffer)(GLenum, GLuint);
+	void (APIENTRY *BufferData)(GLenum, GLsizeiptr, const void *, GLenum);
+	void *(APIENTRY *MapBuffer)(GLenum, GLenum);
+	GLboolean (APIENTRY *UnmapBuffer)(GLenum);
+	void (APIENTRY *BufferStorage)(GLenum, GLsizeiptr, const void *,
+								   GLbitfield);
+	void *(APIENTRY *MapBufferRange)(GLenum, GLintptr, GLsizeiptr,
+									 GLbitfield);
+	struct pbo_sync *(APIENTRY *FenceSync)(GLenum, GLbitfield);
+	GLenum (APIENTRY *ClientWaitSync)(struct pbo_sync *, GLbitfield,
+									  uint64_t);
+	void (APIENTRY *DeleteSync)(struct pbo_sync *);
+} glpbo;
+
+/**
+ * Tell whether the current context is at least OpenGL major.minor or
+ * has extension ext.
+ */
+static bool gl_has(unsigned int major, unsigned int minor, const char *ext)
+{
+	const char *version = (const char *)glGetString(GL_VERSION);
+	const char *list = (const char *)glGetString(GL_EXTENSIONS);
+	size_t len = strlen(ext);
+	unsigned int v[2];
+
+	if ((version != NULL) &&
+		(sscanf(version, "%u.%u", &v[0], &v[1]) == 2) &&
+		((v[0] > major) || ((v[0] == major) && (v[1] >= minor))))
+		return true;
+	while ((list != NULL) && ((list = strstr(list, ext)) != NULL))
+	{
+		if ((list[len] == ' ') || (list[len] == '\0'))
+			return true;
+		list += len;
+	}
+	return false;
+}
+
+/**
+ * Load pixel buffer object entry points for the current context.
+ * @return 0 when they are not available, 1 for two buffers taking turns,
+ * 2 for a persistent mapping.
+ */
+static int glpbo_load()
+{
+#define GLPBO_LOAD(name) \
+	((glpbo.name = (decltype(glpbo.name))SDL_GL_GetProcAddress("gl" #name)) \
+	 != NULL)
+	if ((!gl_has(2, 1, "GL_ARB_pixel_buffer_object")) ||
+		(!GLPBO_LOAD(GenBuffers)) ||
+		(!GLPBO_LOAD(DeleteBuffers)) ||
+		(!GLPBO_LOAD(IsBuffer)) ||
+		(!GLPBO_LOAD(BindBuffer)) ||
+		(!GLPBO_LOAD(BufferData)) ||
+		(!GLPBO_LOAD(MapBuffer)) ||
+		(!GLPBO_LOAD(UnmapBuffer)))
+		return 0;
+	if ((!gl_has(4, 4, "GL_ARB_buffer_storage")) ||
+		(!gl_has(3, 2, "GL_ARB_sync")) ||
+		(!GLPBO_LOAD(BufferStorage)) ||
+		(!GLPBO_LOAD(MapBufferRange)) ||
+		(!GLPBO_LOAD(FenceSync)) ||
+		(!GLPBO_LOAD(ClientWaitSync)) ||
+		(!GLPBO_LOAD(DeleteSync)))
+		return 1;
+	return 2;
+#undef GLPBO_LOAD
+}
+
+/**
+ * Release pixel buffer objects.
+ * Like shaders_release(), only those of the current context are deleted.
+ */
+static void pbo_release(struct texture &texture)
+{
+	unsigned int i;
+
+	if ((texture.pbo[0] != 0) && (glpbo.IsBuffer(texture.pbo[0])))
+	{
+		if (texture.pbo_map != NULL)
+		{
+			glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, texture.pbo[0]);
+			glpbo.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			for (i = 0; (i != elemof(texture.pbo_fence)); ++i)
+				if (texture.pbo_fence[i] != NULL)
+					glpbo.DeleteSync(texture.pbo_fence[i]);
+		}
+		glpbo.DeleteBuffers(((texture.pbo[1] != 0) ? 2 : 1), texture.pbo);
+	}
+	texture.pbo[0] = 0;
+	texture.pbo[1] = 0;
+	texture.pbo_next = 0;
+	texture.pbo_map = NULL;
+	texture.pbo_fence[0] = NULL;
+	texture.pbo_fence[1] = NULL;
+}
+
+/**
+ * Stream frames through pixel buffer objects when bool_opengl_pbo is
+ * enabled, so that glTexSubImage2D() returns without waiting for the copy.
+ * Two buffers take turns, each orphaned before it is filled again. With
+ * OpenGL 4.4 a single buffer of two slots stays mapped instead, a fence per
+ * slot tells when the GPU is done reading it, which is long before the
+ * slot comes back. Only the visible rectangle is streamed.
+ */
+static void pbo_init(struct texture &texture)
+{
+	int level;
+
+	pbo_release(texture);
+	if (!dgen_opengl_pbo)
+		return;
+	level = glpbo_load();
+	if (level == 0)
+	{
+		DEBUG(("pixel buffer objects are not available"));
+		return;
+	}
+	// Rows as glTexSubImage2D() reads them (GL_UNPACK_ALIGNMENT 4).
+	texture.pbo_size = ((((texture.vis_width << (1 << texture.u32)) + 3) &
+						 ~3u) * texture.vis_height);
+	if (level == 2)
+	{
+		glpbo.GenBuffers(1, texture.pbo);
+		glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, texture.pbo[0]);
+		glpbo.BufferStorage(GL_PIXEL_UNPACK_BUFFER, (texture.pbo_size * 2),
+							NULL,
+							(GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+							 GL_MAP_COHERENT_BIT));
+		texture.pbo_map = (uint8_t *)
+			glpbo.MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+								 (texture.pbo_size * 2),
+								 (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+								  GL_MAP_COHERENT_BIT));
+		glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		if ((texture.pbo_map != NULL) && (glGetError() == GL_NO_ERROR))
+		{
+			DEBUG(("persistent pixel buffer, %lu bytes per frame",
+				   (unsigned long)texture.pbo_size));
+			return;
+		}
+		DEBUG(("unable to map a persistent pixel buffer"));
+		pbo_release(texture);
+	}
+	glpbo.GenBuffers(2, texture.pbo);
+	if (glGetError() != GL_NO_ERROR)
+	{
+		DEBUG(("unable to create pixel buffers"));
+		pbo_release(texture);
+		return;
+	}
+	DEBUG(("two pixel buffers, %lu bytes per frame",
+		   (unsigned long)texture.pbo_size));
+}
+
+/**
+ * Upload a frame to the texture through the next pixel buffer.
+ * @return False when it could not be mapped, nothing was uploaded.
+ */
+static bool pbo_upload(struct texture &texture, const void *buf)
+{
+	unsigned int slot = texture.pbo_next;
+	size_t offset = 0;
+	uint8_t *dst;
+
+	if (texture.pbo_map != NULL)
+	{
+		// Filled two frames ago, the wait should be over already.
+		if (texture.pbo_fence[slot] != NULL)
+		{
+			glpbo.ClientWaitSync(texture.pbo_fence[slot],
+								 GL_SYNC_FLUSH_COMMANDS_BIT,
+								 PBO_FENCE_TIMEOUT);
+			glpbo.DeleteSync(texture.pbo_fence[slot]);
+			texture.pbo_fence[slot] = NULL;
+		}
+		offset = (slot * texture.pbo_size);
+		memcpy((texture.pbo_map + offset), buf, texture.pbo_size);
+		glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, texture.pbo[0]);
+	}
+	else
+	{
+		glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, texture.pbo[slot]);
+		// New storage, the driver may still be reading the old one.
+		glpbo.BufferData(GL_PIXEL_UNPACK_BUFFER, texture.pbo_size, NULL,
+						 GL_STREAM_DRAW);
+		dst = (uint8_t *)glpbo.MapBuffer(GL_PIXEL_UNPACK_BUFFER,
+										 GL_WRITE_ONLY);
+		if (dst == NULL)
+		{
+			glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			return false;
+		}
+		memcpy(dst, buf, texture.pbo_size);
+		glpbo.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+	texture.pbo_next = (slot ^ 1);
+	glBindTexture(GL_TEXTURE_2D, texture.id);
+	// Pixels are read from the bound buffer at this offset.
+	if (texture.u32 == 0)
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+						texture.vis_width, texture.vis_height,
+						GL_RGB, TEXTURE_16_TYPE, (const void *)offset);
+	else
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+						texture.vis_width, texture.vis_height,
+						GL_BGRA, TEXTURE_32_TYPE, (const void *)offset);
+	if (texture.pbo_map != NULL)
+		texture.pbo_fence[slot] =
+			glpbo.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glpbo.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	return true;
+}
+
+/**
+ * OpenGL 2.0 entry points, loaded at run time.
+ */
+static struct
+{
+	PFNGLACTIVETEXTUREPROC ActiveTexture;
+	PFNGLCREATESHADERPROC CreateShader;
+	PFNGLSHADERSOURCEPROC ShaderSource;
+	PFNGLCOMPILESHADERPROC CompileShader;
+	PFNGLGETSHADERIVPROC GetShaderiv;
+	PFNGLGETSHADERINFOLOGPROC GetShaderInfoLog;
+	PFNGLDELETESHADERPROC DeleteShader;
+	PFNGLCREATEPROGRAMPROC CreateProgram;
+	PFNGLATTACHSHADERPROC AttachShader;
+	PFNGLLINKPROGRAMPROC LinkProgram;
+	PFNGLGETPROGRAMIVPROC GetProgramiv;
+	PFNGLGETPROGRAMINFOLOGPROC GetProgramInfoLog;
+	PFNGLISPROGRAMPROC IsProgram;
+	PFNGLDELETEPROGRAMPROC DeleteProgram;
+	PFNGLUSEPROGRAMPROC UseProgram;
+	PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
+	PFNGLUNIFORM1IPROC Uniform1i;
+	PFNGLUNIFORM1FPROC Uniform1f;
+} gl2;
+
+/**
+ * Load OpenGL 2.0 entry points for the current context.
+ * @return True on success.
+ */
+static bool gl2_load()
+{
+#define GL2_LOAD(type, name) \
+	((gl2.name = (type)SDL_GL_GetProcAddress("gl" #name)) != NULL)
+	const char *glsl;
+
+	glsl = (const char *)glGetString(GL_SHADING_LANGUAGE_VERSION);
+	if (glsl == NULL)
+	{
+		DEBUG(("GLSL is not supported"));
+		return false;
+	}
+	DEBUG(("GLSL version: %s", glsl));
+	return (GL2_LOAD(PFNGLACTIVETEXTUREPROC, ActiveTexture) &&
+			GL2_LOAD(PFNGLCREATESHADERPROC, CreateShader) &&
+			GL2_LOAD(PFNGLSHADERSOURCEPROC, ShaderSource) &&
+			GL2_LOAD(PFNGLCOMPILESHADERPROC, CompileShader) &&
+			GL2_LOAD(PFNGLGETSHADERIVPROC, GetShaderiv) &&
+			GL2_LOAD(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog) &&
+			GL2_LOAD(PFNGLDELETESHADERPROC, DeleteShader) &&
+			GL2_LOAD(PFNGLCREATEPROGRAMPROC, CreateProgram) &&
+			GL2_LOAD(PFNGLATTACHSHADERPROC, AttachShader) &&
+			GL2_LOAD(PFNGLLINKPROGRAMPROC, LinkProgram) &&
+			GL2_LOAD(PFNGLGETPROGRAMIVPROC, GetProgramiv) &&
+			GL2_LOAD(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog) &&
+			GL2_LOAD(PFNGLISPROGRAMPROC, IsProgram) &&
+			GL2_LOAD(PFNGLDELETEPROGRAMPROC, DeleteProgram) &&
+			GL2_LOAD(PFNGLUSEPROGRAMPROC, UseProgram) &&
+			GL2_LOAD(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation) &&
+			GL2_LOAD(PFNGLUNIFORM1IPROC, Uniform1i) &&
+			GL2_LOAD(PFNGLUNIFORM1FPROC, Uniform1f));
+#undef GL2_LOAD
+}
+
+/**
+ * Release shaders resources.
+ * Objects are only deleted if they belong to the current context, they
+ * disappear with it otherwise (see release_texture()).
+ */
+static void shaders_release(struct texture &texture)
+{
+	if ((texture.program != 0) && (gl2.IsProgram(texture.program)))
+		gl2.DeleteProgram(texture.program);
+	texture.program = 0;
+	if ((texture.md_id != 0) && (glIsTexture(texture.md_id)))
+		glDeleteTextures(1, &texture.md_id);
+	texture.md_id = 0;
+	if ((texture.pal_id != 0) && (glIsTexture(texture.pal_id)))
+		glDeleteTextures(1, &texture.pal_id);
+	texture.pal_id = 0;
+	free(texture.expand.u8);
+	texture.expand.u8 = NULL;
+	texture.shaders = 0;
+}
+
+/**
+ * Create an 8-bit per component texture sampled with GL_NEAREST.
+ */
+static GLuint shaders_texture(GLint internal, GLenum format,
+							  unsigned int width, unsigned int height)
+{
+	GLuint id;
+
+	glGenTextures(1, &id);
+	glBindTexture(GL_TEXTURE_2D, id);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, internal, width, height, 0,
+				 format, GL_UNSIGNED_BYTE, NULL);
+	return id;
+}
+
+/**
+ * Prepare the raw frame and palette textures when bool_opengl_shaders is
+ * enabled. The program itself depends on the filters stack and is built by
+ * shaders_update().
+ */
+static void shaders_init(struct texture &texture)
+{
+	void *tmp;
+
+	shaders_release(texture);
+	if (!dgen_opengl_shaders)
+		return;
+	if (!gl2_load())
+	{
+		DEBUG(("OpenGL 2.0 is not available"));
+		return;
+	}
+	tmp = malloc(video.width * video.height * sizeof(uint32_t));
+	if (tmp == NULL)
+		return;
+	texture.expand.u8 = (uint8_t *)tmp;
+	texture.md_width = roundup2(video.width);
+	texture.md_height = roundup2(video.height);
+	if (dgen_opengl_square)
+	{
+		if (texture.md_width < texture.md_height)
+			texture.md_width = texture.md_height;
+		else
+			texture.md_height = texture.md_width;
+	}
+	texture.md_id = shaders_texture(GL_LUMINANCE8, GL_LUMINANCE,
+									texture.md_width, texture.md_height);
+	texture.pal_id = shaders_texture(GL_RGBA, GL_RGBA, 64, 1);
+	if (glGetError() != GL_NO_ERROR)
+	{
+		DEBUG(("unable to create textures"));
+		shaders_release(texture);
+		return;
+	}
+	DEBUG(("raw frame texture width=%u height=%u",
+		   texture.md_width, texture.md_height));
+	texture.shaders = 1;
+}
+
+/**
+ * Fragment shader generated from the filters stack.
+ * Each filter defines a function returning the color of a pixel in its
+ * output from the function of the previous one, f0() reads the raw frame.
+ */
+struct shader_gen
+{
+	char buf[0x4000];	 ///< GLSL source
+	size_t len;			 ///< length of buf
+	bool overflow;		 ///< buf is too small
+	unsigned int func;	 ///< last function defined
+	unsigned int width;	 ///< its output width
+	unsigned int height; ///< its output height
+	unsigned int x_off;	 ///< first column of the picture in its output
+	unsigned int y_off;	 ///< first row of the picture in its output
+	unsigned int pic_width; ///< picture width
+};
+
+static void shader_printf(struct shader_gen *gen, const char *fmt, ...)
+{
+	va_list vl;
+	int ret;
+
+	if (gen->overflow)
+		return;
+	va_start(vl, fmt);
+	ret = vsnprintf(&gen->buf[gen->len], (sizeof(gen->buf) - gen->len),
+					fmt, vl);
+	va_end(vl);
+	if ((ret < 0) || ((size_t)ret >= (sizeof(gen->buf) - gen->len)))
+	{
+		gen->overflow = true;
+		return;
+	}
+	gen->len += ret;
+}
+
+/**
+ * Start a new function, its input is f<gen->func - 1>().
+ */
+static void shader_begin(struct shader_gen *gen)
+{
+	++gen->func;
+	shader_printf(gen, "vec3 f%u(vec2 p)\n{\n", gen->func);
+}
+
+/**
+ * Define a neighbor of input pixel "c" for the Scale2x/Scale3x rules,
+ * clamped to the edges like scale2x does.
+ */
+static void shader_fetch(struct shader_gen *gen, const char *name,
+						 int x, int y)
+{
+	shader_printf(gen,
+				  "\tvec3 %s = f%u(clamp((c + vec2(%d.0, %d.0)), vec2(0.0),"
+				  " vec2(%u.0, %u.0)));\n",
+				  name, (gen->func - 1), x, y,
+				  (gen->width - 1), (gen->height - 1));
+}
+
+/**
+ * Put the picture (width x height, magnified to dst_w x dst_h) at x_off,
+ * y_off in a new output of out_w x out_h, the rest is black.
+ * Input pixels are picked with the fixed point ratios of filter_stretch().
+ */
+static void shader_place(struct shader_gen *gen,
+						 unsigned int dst_w, unsigned int dst_h,
+						 unsigned int x_off, unsigned int y_off,
+						 unsigned int out_w, unsigned int out_h)
+{
+	shader_begin(gen);
+	shader_printf(gen,
+				  "\tp -= vec2(%u.0, %u.0);\n"
+				  "\tif ((p.x < 0.0) || (p.y < 0.0) ||"
+				  " (p.x >= %u.0) || (p.y >= %u.0))\n"
+				  "\t\treturn vec3(0.0);\n"
+				  "\treturn f%u(floor(((p * 1024.0) + 0.5) /"
+				  " vec2(%u.0, %u.0)));\n"
+				  "}\n",
+				  x_off, y_off, dst_w, dst_h, (gen->func - 1),
+				  ((dst_w << 10) / gen->width),
+				  ((dst_h << 10) / gen->height));
+	gen->width = out_w;
+	gen->height = out_h;
+	gen->x_off = x_off;
+	gen->y_off = y_off;
+	gen->pic_width = dst_w;
+}
+
+/**
+ * Center the picture without scaling it, like filter_off().
+ */
+static void shader_center(struct shader_gen *gen,
+						  unsigned int out_w, unsigned int out_h)
+{
+	unsigned int width = gen->width;
+	unsigned int height = gen->height;
+	unsigned int x_off = 0;
+	unsigned int y_off = 0;
+
+	if (height > out_h)
+		height = out_h;
+	if (width <= out_w)
+	{
+		x_off = ((out_w - width) / 2);
+		y_off = ((out_h - height) / 2);
+	}
+	shader_place(gen, width, height, x_off, y_off, out_w, out_h);
+}
+
+/**
+ * Scale2x rule, doubles the picture horizontally and multiplies its height
+ * by y_scale (2 to 4). Rows between the first and last ones of each input
+ * pixel use the center rule of scale2x3 and scale2x4.
+ */
+static void shader_scale2x(struct shader_gen *gen, unsigned int y_scale)
+{
+	shader_begin(gen);
+	shader_printf(gen,
+				  "\tvec2 c = floor(p / vec2(2.0, %u.0));\n"
+				  "\tvec2 s = (p - (c * vec2(2.0, %u.0)));\n"
+				  "\tvec3 E = f%u(c);\n",
+				  y_scale, y_scale, (gen->func - 1));
+	shader_fetch(gen, "B", 0, -1);
+	shader_fetch(gen, "D", -1, 0);
+	shader_fetch(gen, "F", 1, 0);
+	shader_fetch(gen, "H", 0, 1);
+	shader_printf(gen,
+				  "\tif ((B == H) || (D == F))\n"
+				  "\t\treturn E;\n");
+	if (y_scale > 2)
+	{
+		shader_fetch(gen, "A", -1, -1);
+		shader_fetch(gen, "C", 1, -1);
+		shader_fetch(gen, "G", -1, 1);
+		shader_fetch(gen, "I", 1, 1);
+		shader_printf(gen,
+					  "\tif ((s.y >= 1.0) && (s.y < %u.0)) {\n"
+					  "\t\tif (s.x < 1.0)\n"
+					  "\t\t\treturn ((((D == B) && (E != G)) ||"
+					  " ((D == H) && (E != A))) ? D : E);\n"
+					  "\t\treturn ((((F == B) && (E != I)) ||"
+					  " ((F == H) && (E != C))) ? F : E);\n"
+					  "\t}\n",
+					  (y_scale - 1));
+	}
+	shader_printf(gen,
+				  "\tvec3 V = ((s.y < 1.0) ? B : H);\n"
+				  "\tvec3 W = ((s.x < 1.0) ? D : F);\n"
+				  "\treturn ((V == W) ? W : E);\n"
+				  "}\n");
+	gen->width *= 2;
+	gen->height *= y_scale;
+}
+
+/**
+ * Scale3x rule, triples the picture.
+ */
+static void shader_scale3x(struct shader_gen *gen)
+{
+	shader_begin(gen);
+	shader_printf(gen,
+				  "\tvec2 c = floor(p / 3.0);\n"
+				  "\tvec2 s = (p - (c * 3.0));\n"
+				  "\tvec3 E = f%u(c);\n",
+				  (gen->func - 1));
+	shader_fetch(gen, "A", -1, -1);
+	shader_fetch(gen, "B", 0, -1);
+	shader_fetch(gen, "C", 1, -1);
+	shader_fetch(gen, "D", -1, 0);
+	shader_fetch(gen, "F", 1, 0);
+	shader_fetch(gen, "G", -1, 1);
+	shader_fetch(gen, "H", 0, 1);
+	shader_fetch(gen, "I", 1, 1);
+	shader_printf(gen,
+				  "\tif ((B == H) || (D == F))\n"
+				  "\t\treturn E;\n"
+				  "\tif (s.y < 1.0) {\n"
+				  "\t\tif (s.x < 1.0)\n"
+				  "\t\t\treturn ((D == B) ? D : E);\n"
+				  "\t\tif (s.x < 2.0)\n"
+				  "\t\t\treturn ((((D == B) && (E != C)) ||"
+				  " ((B == F) && (E != A))) ? B : E);\n"
+				  "\t\treturn ((B == F) ? F : E);\n"
+				  "\t}\n"
+				  "\tif (s.y < 2.0) {\n"
+				  "\t\tif (s.x < 1.0)\n"
+				  "\t\t\treturn ((((D == B) && (E != G)) ||"
+				  " ((D == H) && (E != A))) ? D : E);\n"
+				  "\t\tif (s.x < 2.0)\n"
+				  "\t\t\treturn E;\n"
+				  "\t\treturn ((((B == F) && (E != I)) ||"
+				  " ((H == F) && (E != C))) ? F : E);\n"
+				  "\t}\n"
+				  "\tif (s.x < 1.0)\n"
+				  "\t\treturn ((D == H) ? D : E);\n"
+				  "\tif (s.x < 2.0)\n"
+				  "\t\treturn ((((D == H) && (E != I)) ||"
+				  " ((H == F) && (E != G))) ? H : E);\n"
+				  "\treturn ((H == F) ? F : E);\n"
+				  "}\n");
+	gen->width *= 3;
+	gen->height *= 3;
+}
+
+/**
+ * Add a filter to the fragment shader, following what its CPU version does
+ * when initialized with the same input and output sizes.
+ * @param last Filter is the last one, its output is not its input.
+ * @return False if the filter has no shader equivalent.
+ */
+static bool shader_filter(struct shader_gen *gen, const struct filter *f,
+						  bool last, unsigned int out_w, unsigned int out_h)
+{
+	unsigned int x_scale;
+	unsigned int y_scale;
+	unsigned int width;
+	unsigned int height;
+
+	if (f->func == filter_stretch)
+	{
+		width = out_w;
+		height = out_h;
+		if (dgen_aspect)
+		{
+			unsigned int w = ((out_h * gen->width) / gen->height);
+			unsigned int h = ((out_w * gen->height) / gen->width);
+
+			if (w >= out_w)
+			{
+				w = out_w;
+				if (h == 0)
+					++h;
+			}
+			else
+			{
+				h = out_h;
+				if (w == 0)
+					++w;
+			}
+			width = w;
+			height = h;
+		}
+		shader_place(gen, width, height, ((out_w - width) / 2),
+					 ((out_h - height) / 2), out_w, out_h);
+		return true;
+	}
+	if (f->func == filter_scale)
+	{
+		x_scale = screen.x_scale;
+		y_scale = screen.y_scale;
+		while ((x_scale != 0) && ((gen->width * x_scale) > out_w))
+			--x_scale;
+		while ((y_scale != 0) && ((gen->height * y_scale) > out_h))
+			--y_scale;
+		if ((x_scale == 0) || (y_scale == 0) ||
+			((x_scale == 1) && (y_scale == 1)))
+			goto center;
+		width = (gen->width * x_scale);
+		height = (gen->height * y_scale);
+		shader_place(gen, width, height, ((out_w - width) / 2),
+					 ((out_h - height) / 2), out_w, out_h);
+		return true;
+	}
+#ifdef WITH_SCALE2X
+	if (f->func == filter_scale2x)
+	{
+		static const struct
+		{
+			unsigned int x_scale;
+			unsigned int y_scale;
+		} scale2x_mode[] = {
+			{2, 2}, {2, 3}, {2, 4}, {3, 3}, {4, 4}};
+		unsigned int i;
+
+		x_scale = screen.x_scale;
+		y_scale = screen.y_scale;
+	retry:
+		while ((x_scale != 0) && ((gen->width * x_scale) > out_w))
+			--x_scale;
+		while ((y_scale != 0) && ((gen->height * y_scale) > out_h))
+			--y_scale;
+		if ((x_scale == 0) || (y_scale == 0))
+			goto center;
+		for (i = 0; (i != elemof(scale2x_mode)); ++i)
+			if ((scale2x_mode[i].x_scale == x_scale) &&
+				(scale2x_mode[i].y_scale == y_scale))
+				break;
+		if (i == elemof(scale2x_mode))
+		{
+			do
+			{
+				--i;
+				if ((scale2x_mode[i].x_scale <= x_scale) &&
+					(scale2x_mode[i].y_scale <= y_scale))
+				{
+					x_scale = scale2x_mode[i].x_scale;
+					y_scale = scale2x_mode[i].y_scale;
+					goto retry;
+				}
+			} while (i != 0);
+			goto center;
+		}
+		width = (gen->width * x_scale);
+		height = (gen->height * y_scale);
+		// Scale4x is Scale2x twice.
+		if (x_scale == 3)
+			shader_scale3x(gen);
+		else if (x_scale == 4)
+		{
+			shader_scale2x(gen, 2);
+			shader_scale2x(gen, 2);
+		}
+		else
+			shader_scale2x(gen, y_scale);
+		shader_place(gen, width, height, ((out_w - width) / 2),
+					 ((out_h - height) / 2), out_w, out_h);
+		return true;
+	}
+#endif
+	if ((f->func == filter_off) && (f->resize == true))
+		goto center;
+#ifdef WITH_CTV
+	if ((f->func == filter_off) || (f->func == filter_swab))
+	{
+		// Colors come from the palette in the right order, there is
+		// nothing to swap.
+		return true;
+	}
+	if (f->func == filter_blur)
+	{
+		shader_begin(gen);
+		shader_printf(gen,
+					  "\tvec3 c = f%u(p);\n"
+					  "\tif ((p.x < %u.0) || (p.x >= %u.0))\n"
+					  "\t\treturn c;\n"
+					  "\tvec3 l = f%u(vec2(((p.x > %u.0) ? (p.x - 1.0) : p.x),"
+					  " p.y));\n"
+					  "\treturn (floor((c + l) * 127.5) / 255.0);\n"
+					  "}\n",
+					  (gen->func - 1), gen->x_off,
+					  (gen->x_off + gen->pic_width),
+					  (gen->func - 1), gen->x_off);
+		return true;
+	}
+	// When last, these filters write every other row to the screen, the
+	// others are black (scanline) or remain from the previous frame
+	// (interlace).
+	if ((f->func == filter_scanline) || (f->func == filter_interlace))
+	{
+		shader_begin(gen);
+		if ((last) && (f->func == filter_interlace))
+			shader_printf(gen,
+						  "\tp.y -= mod((p.y - %u.0), 2.0);\n"
+						  "\treturn (floor(f%u(p) * 127.5) / 255.0);\n"
+						  "}\n",
+						  gen->y_off, (gen->func - 1));
+		else
+			shader_printf(gen,
+						  "\tvec3 c = f%u(p);\n"
+						  "\tif (mod((p.y - %u.0), 2.0) == %s)\n"
+						  "\t\treturn (floor(c * 127.5) / 255.0);\n"
+						  "\treturn %s;\n"
+						  "}\n",
+						  (gen->func - 1), gen->y_off,
+						  ((f->func == filter_interlace) ? "frame" : "0.0"),
+						  (last ? "vec3(0.0)" : "c"));
+		return true;
+	}
+#endif
+	// hqx and text.
+	return false;
+center:
+	shader_center(gen, out_w, out_h);
+	return true;
+}
+
+/**
+ * Generate the fragment shader for the current filters stack.
+ * @return False if some filters must run on the CPU.
+ */
+static bool shaders_source(struct shader_gen *gen)
+{
+	const struct texture &texture = screen.texture;
+	unsigned int out_w = screen.width;
+	unsigned int out_h = (screen.height - screen.info_height);
+	size_t i;
+
+	gen->len = 0;
+	gen->overflow = false;
+	gen->func = 0;
+	gen->width = video.width;
+	gen->height = video.height;
+	gen->x_off = 0;
+	gen->y_off = 0;
+	gen->pic_width = video.width;
+	shader_printf(gen,
+				  "#version 110\n"
+				  "uniform sampler2D md;\n"
+				  "uniform sampler2D pal;\n"
+				  "uniform float frame;\n"
+				  "varying vec2 pos;\n"
+				  "vec3 f0(vec2 p)\n"
+				  "{\n"
+				  "\tif ((p.x < 0.0) || (p.y < 0.0) ||"
+				  " (p.x >= %u.0) || (p.y >= %u.0))\n"
+				  "\t\treturn vec3(0.0);\n"
+				  "\tfloat i = texture2D(md, ((p + 0.5) /"
+				  " vec2(%u.0, %u.0))).r;\n"
+				  "\treturn texture2D(pal, vec2((((i * 255.0) + 0.5) /"
+				  " 64.0), 0.5)).rgb;\n"
+				  "}\n",
+				  gen->width, gen->height,
+				  texture.md_width, texture.md_height);
+	for (i = 0; (i != filters_stack_size); ++i)
+		if (!shader_filter(gen, filters_stack[i],
+						   (i == (filters_stack_size - 1)), out_w, out_h))
+			return false;
+	// The last filter writes to the screen.
+	if ((gen->width != out_w) || (gen->height != out_h))
+		shader_center(gen, out_w, out_h);
+	shader_printf(gen,
+				  "void main()\n"
+				  "{\n"
+				  "\tgl_FragColor = vec4(f%u(floor(pos)), 1.0);\n"
+				  "}\n",
+				  gen->func);
+	return (!gen->overflow);
+}
+
+/**
+ * Compile a shader.
+ * @return Shader object, 0 on error.
+ */
+static GLuint shaders_compile(GLenum type, const char *src)
+{
+	GLuint id = gl2.CreateShader(type);
+	GLint ok;
+
+	if (id == 0)
+		return 0;
+	gl2.ShaderSource(id, 1, &src, NULL);
+	gl2.CompileShader(id);
+	gl2.GetShaderiv(id, GL_COMPILE_STATUS, &ok);
+	if (ok == GL_FALSE)
+	{
+		char info[1024];
+
+		info[0] = '\0';
+		gl2.GetShaderInfoLog(id, sizeof(info), NULL, info);
+		DEBUG(("shader compilation failed: %s", info));
+		gl2.DeleteShader(id);
+		return 0;
+	}
+	return id;
+}
+
+/**
+ * Rebuild the shaders program after a change of the filters stack, or
+ * leave texture.program to 0 if the CPU must process it.
+ */
+static void shaders_update()
+{
+	static const char vertex[] =
+		"#version 110\n"
+		"varying vec2 pos;\n"
+		"void main()\n"
+		"{\n"
+		"\tpos = gl_MultiTexCoord0.xy;\n"
+		"\tgl_Position = ftransform();\n"
+		"}\n";
+	static struct shader_gen gen;
+	struct texture &texture = screen.texture;
+	GLuint vs;
+	GLuint fs;
+	GLuint program;
+	GLint ok;
+
+	if ((!screen.is_opengl) || (!texture.shaders))
+		return;
+	if (texture.program != 0)
+	{
+		gl2.DeleteProgram(texture.program);
+		texture.program = 0;
+	}
+	if (!shaders_source(&gen))
+	{
+		DEBUG(("filters stack must be processed by the CPU"));
+		return;
+	}
+	if ((vs = shaders_compile(GL_VERTEX_SHADER, vertex)) == 0)
+		return;
+	if ((fs = shaders_compile(GL_FRAGMENT_SHADER, gen.buf)) == 0)
+	{
+		gl2.DeleteShader(vs);
+		return;
+	}
+	program = gl2.CreateProgram();
+	if (program != 0)
+	{
+		gl2.AttachShader(program, vs);
+		gl2.AttachShader(program, fs);
+		gl2.LinkProgram(program);
+	}
+	// Attached shaders are only flagged for deletion.
+	gl2.DeleteShader(vs);
+	gl2.DeleteShader(fs);
+	if (program == 0)
+		return;
+	gl2.GetProgramiv(program, GL_LINK_STATUS, &ok);
+	if (ok == GL_FALSE)
+	{
+		char info[1024];
+
+		info[0] = '\0';
+		gl2.GetProgramInfoLog(program, sizeof(info), NULL, info);
+		DEBUG(("shaders link failed: %s", info));
+		gl2.DeleteProgram(program);
+		return;
+	}
+	gl2.UseProgram(program);
+	gl2.Uniform1i(gl2.GetUniformLocation(program, "md"), 0);
+	gl2.Uniform1i(gl2.GetUniformLocation(program, "pal"), 1);
+	gl2.UseProgram(0);
+	texture.frame_loc = gl2.GetUniformLocation(program, "frame");
+	texture.frame = 0;
+	texture.program = program;
+	DEBUG(("filters stack runs on the GPU (%u functions)", gen.func));
+}
+
+/**
+ * Update the palette texture, and the copy used for expand.
+ * @param mdpal Palette (64 entries of R, G, B and padding).
+ */
+static void shaders_palette(struct texture &texture, const uint8_t *mdpal)
+{
+	unsigned int i;
+
+	for (i = 0; (i != elemof(texture.pal)); ++i)
+	{
+		const uint8_t *c = &mdpal[(i << 2)];
+
+		if (texture.u32)
+			texture.pal[i] = ((c[0] << 16) | (c[1] << 8) | c[2]);
+		else
+			texture.pal[i] = (((c[0] & 0xf8) << 8) |
+							  ((c[1] & 0xfc) << 3) |
+							  (c[2] >> 3));
+	}
+	glBindTexture(GL_TEXTURE_2D, texture.pal_id);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 64, 1,
+					GL_RGBA, GL_UNSIGNED_BYTE, mdpal);
+}
+
+/**
+ * Convert the raw frame to texture depth when the CPU processes the
+ * filters stack.
+ */
+static void shaders_expand(struct texture &texture)
+{
+	const uint8_t *src = ((uint8_t *)mdscr.data + (mdscr.pitch * 8) + 16);
+	bpp_t dst = texture.expand;
+	unsigned int x;
+	unsigned int y;
+
+	for (y = 0; (y != video.height); ++y)
+	{
+		if (texture.u32)
+			for (x = 0; (x != video.width); ++x)
+				dst.u32[x] = texture.pal[(src[x] & 0x3f)];
+		else
+			for (x = 0; (x != video.width); ++x)
+				dst.u16[x] = texture.pal[(src[x] & 0x3f)];
+		src += mdscr.pitch;
+		dst.u8 += (video.width << (1 << texture.u32));
 	}
-	DEBUG(("texture initialization OK"));
-	return 0;
-fail:
-	release_texture(texture);
-	DEBUG(("texture initialization failed"));
-	return -1;
 }
 
-static void update_texture(struct texture &texture)
+/**
+ * Draw the raw frame through the shaders program and the message bar from
+ * the texture.
+ * @param buf Screen buffer, only the message bar rows are used.
+ */
+static void shaders_draw(struct texture &texture, const void *buf)
 {
+	unsigned int top = (texture.vis_height - screen.info_height);
+	unsigned int pitch = (texture.vis_width << (1 << texture.u32));
+	const uint8_t *md = ((uint8_t *)mdscr.data + (mdscr.pitch * 8) + 16);
+
 	glBindTexture(GL_TEXTURE_2D, texture.id);
-	if (texture.u32 == 0)
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
-						texture.vis_width, texture.vis_height,
-						GL_RGB, TEXTURE_16_TYPE,
-						texture.buf.u16);
-	else
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
-						texture.vis_width, texture.vis_height,
-						GL_BGRA, TEXTURE_32_TYPE,
-						texture.buf.u32);
-	glCallList(texture.dlist);
+	if (screen.info_height != 0)
+	{
+		const uint8_t *info = ((const uint8_t *)buf + (pitch * top));
+
+		if (texture.u32 == 0)
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, top,
+							texture.vis_width, screen.info_height,
+							GL_RGB, TEXTURE_16_TYPE, info);
+		else
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, top,
+							texture.vis_width, screen.info_height,
+							GL_BGRA, TEXTURE_32_TYPE, info);
+	}
+	gl2.ActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, texture.pal_id);
+	gl2.ActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture.md_id);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, mdscr.pitch);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, video.width, video.height,
+					GL_LUMINANCE, GL_UNSIGNED_BYTE, md);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0, texture.vis_width, texture.vis_height, 0, 0, 1);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	// Texture coordinates are output pixels.
+	gl2.UseProgram(texture.program);
+	gl2.Uniform1f(texture.frame_loc, texture.frame);
+	texture.frame ^= 1;
+	glBegin(GL_QUADS);
+	glTexCoord2i(0, top);
+	glVertex2i(0, top); // lower left
+	glTexCoord2i(0, 0);
+	glVertex2i(0, 0); // upper left
+	glTexCoord2i(texture.vis_width, 0);
+	glVertex2i(texture.vis_width, 0); // upper right
+	glTexCoord2i(texture.vis_width, top);
+	glVertex2i(texture.vis_width, top); // lower right
+	glEnd();
+	gl2.UseProgram(0);
+	// Message bar.
+	glBindTexture(GL_TEXTURE_2D, texture.id);
+	glEnable(GL_TEXTURE_2D);
+	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+	glBegin(GL_QUADS);
+	glTexCoord2f(0, ((float)texture.vis_height / texture.height));
+	glVertex2i(0, texture.vis_height);
+	glTexCoord2f(0, ((float)top / texture.height));
+	glVertex2i(0, top);
+	glTexCoord2f(((float)texture.vis_width / texture.width),
+				 ((float)top / texture.height));
+	glVertex2i(texture.vis_width, top);
+	glTexCoord2f(((float)texture.vis_width / texture.width),
+				 ((float)texture.vis_height / texture.height));
+	glVertex2i(texture.vis_width, texture.vis_height);
+	glEnd();
+	glDisable(GL_TEXTURE_2D);
+	glPopMatrix();
 	SDL_GL_SwapBuffers();
 }
 
@@ -2551,7 +3770,6 @@ static void filter_hqx(const struct filter_data *in, struct filter_data *out)
 		{4, 3, (hqx_func_t *)hq3x_32_rb},
 		{4, 4, (hqx_func_t *)hq4x_32_rb},
 	};
-	static bool hqx_initialized = false;
 	unsigned int width;
 	unsigned int height;
 	unsigned int x_off;
@@ -2647,15 +3865,6 @@ retry:
 	out->width = width;
 	out->height = height;
 	out->updated = true;
-	// Initialize HQX if necessary.
-	if (hqx_initialized == false)
-	{
-		pd_message_cursor(~0u, "Initializing hqx...");
-		stopped = 1;
-		hqxInit();
-		pd_message_cursor(~0u, "");
-		hqx_initialized = true;
-	}
 	goto process;
 }
 
@@ -2784,6 +3993,7 @@ retry:
 static void filter_blur_32(const struct filter_data *in,
 						   struct filter_data *out)
 {
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf = in->buf;
 	bpp_t out_buf = out->buf;
 	unsigned int xsize = out->width;
@@ -2792,10 +4002,11 @@ static void filter_blur_32(const struct filter_data *in,
 
 	for (y = 0; (y < ysize); ++y)
 	{
+		unsigned int end = simd->blur(out_buf.u8, in_buf.u8, xsize, 32);
 		uint32_t old = *in_buf.u32;
 		unsigned int x;
 
-		for (x = 0; (x < xsize); ++x)
+		for (x = 0; (x < end); ++x)
 		{
 			uint32_t tmp = in_buf.u32[x];
 
@@ -2818,6 +4029,7 @@ static void filter_blur_32(const struct filter_data *in,
 static void filter_blur_24(const struct filter_data *in,
 						   struct filter_data *out)
 {
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf = in->buf;
 	bpp_t out_buf = out->buf;
 	unsigned int xsize = out->width;
@@ -2826,11 +4038,12 @@ static void filter_blur_24(const struct filter_data *in,
 
 	for (y = 0; (y < ysize); ++y)
 	{
+		unsigned int end = simd->blur(out_buf.u8, in_buf.u8, xsize, 24);
 		uint24_t old;
 		unsigned int x;
 
 		u24cpy(&old, in_buf.u24);
-		for (x = 0; (x < xsize); ++x)
+		for (x = 0; (x < end); ++x)
 		{
 			uint24_t tmp;
 
@@ -2848,30 +4061,20 @@ static void filter_blur_24(const struct filter_data *in,
 static void filter_blur_16(const struct filter_data *in,
 						   struct filter_data *out)
 {
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf = in->buf;
 	bpp_t out_buf = out->buf;
 	unsigned int xsize = out->width;
 	unsigned int ysize = out->height;
 	unsigned int y;
 
-#ifdef WITH_X86_CTV
-	if (in_buf.u16 == out_buf.u16)
-	{
-		for (y = 0; (y < ysize); ++y)
-		{
-			// Blur, by Dave
-			blur_bitmap_16((uint8_t *)out_buf.u16, (xsize - 1));
-			out_buf.u8 += out->pitch;
-		}
-		return;
-	}
-#endif
 	for (y = 0; (y < ysize); ++y)
 	{
+		unsigned int end = simd->blur(out_buf.u8, in_buf.u8, xsize, 16);
 		uint16_t old = *in_buf.u16;
 		unsigned int x;
 
-		for (x = 0; (x < xsize); ++x)
+		for (x = 0; (x < end); ++x)
 		{
 			uint16_t tmp = in_buf.u16[x];
 
@@ -2894,30 +4097,20 @@ static void filter_blur_16(const struct filter_data *in,
 static void filter_blur_15(const struct filter_data *in,
 						   struct filter_data *out)
 {
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf = in->buf;
 	bpp_t out_buf = out->buf;
 	unsigned int xsize = out->width;
 	unsigned int ysize = out->height;
 	unsigned int y;
 
-#ifdef WITH_X86_CTV
-	if (in_buf.u15 == out_buf.u15)
-	{
-		for (y = 0; (y < ysize); ++y)
-		{
-			// Blur, by Dave
-			blur_bitmap_15((uint8_t *)out_buf.u15, (xsize - 1));
-			out_buf.u8 += out->pitch;
-		}
-		return;
-	}
-#endif
 	for (y = 0; (y < ysize); ++y)
 	{
+		unsigned int end = simd->blur(out_buf.u8, in_buf.u8, xsize, 15);
 		uint16_t old = *in_buf.u15;
 		unsigned int x;
 
-		for (x = 0; (x < xsize); ++x)
+		for (x = 0; (x < end); ++x)
 		{
 			uint16_t tmp = in_buf.u15[x];
 
@@ -3005,6 +4198,7 @@ static void filter_scanline_frame(const struct filter_data *in,
 {
 	unsigned int frame = ((unsigned int *)out->data)[0];
 	unsigned int bpp = ((unsigned int *)out->data)[1];
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf = in->buf;
 	bpp_t out_buf = out->buf;
 	unsigned int xsize = out->width;
@@ -3019,7 +4213,8 @@ static void filter_scanline_frame(const struct filter_data *in,
 	case 32:
 		for (y = frame; (y < ysize); y += 2)
 		{
-			for (x = 0; (x < xsize); ++x)
+			x = simd->scanline(out_buf.u8, in_buf.u8, xsize, 32);
+			for (; (x < xsize); ++x)
 				out_buf.u32[x] =
 					((in_buf.u32[x] >> 1) & 0x7f7f7f7f);
 			in_buf.u8 += (in->pitch * 2);
@@ -3029,7 +4224,8 @@ static void filter_scanline_frame(const struct filter_data *in,
 	case 24:
 		for (y = frame; (y < ysize); y += 2)
 		{
-			for (x = 0; (x < xsize); ++x)
+			x = simd->scanline(out_buf.u8, in_buf.u8, xsize, 24);
+			for (; (x < xsize); ++x)
 			{
 				out_buf.u24[x][0] = (in_buf.u24[x][0] >> 1);
 				out_buf.u24[x][1] = (in_buf.u24[x][1] >> 1);
@@ -3042,17 +4238,9 @@ static void filter_scanline_frame(const struct filter_data *in,
 	case 16:
 		for (y = frame; (y < ysize); y += 2)
 		{
-#ifdef WITH_X86_CTV
-			if (in_buf.u16 == out_buf.u16)
-			{
-				// Scanline, by Phil
-				test_ctv((uint8_t *)out_buf.u16, xsize);
-			}
-			else
-#endif
-				for (x = 0; (x < xsize); ++x)
-					out_buf.u16[x] =
-						((in_buf.u16[x] >> 1) & 0x7bef);
+			x = simd->scanline(out_buf.u8, in_buf.u8, xsize, 16);
+			for (; (x < xsize); ++x)
+				out_buf.u16[x] = ((in_buf.u16[x] >> 1) & 0x7bef);
 			in_buf.u8 += (in->pitch * 2);
 			out_buf.u8 += (out->pitch * 2);
 		}
@@ -3060,17 +4248,9 @@ static void filter_scanline_frame(const struct filter_data *in,
 	case 15:
 		for (y = frame; (y < ysize); y += 2)
 		{
-#ifdef WITH_X86_CTV
-			if (in_buf.u15 == out_buf.u15)
-			{
-				// Scanline, by Phil
-				test_ctv((uint8_t *)out_buf.u16, xsize);
-			}
-			else
-#endif
-				for (x = 0; (x < xsize); ++x)
-					out_buf.u15[x] =
-						((in_buf.u15[x] >> 1) & 0x3def);
+			x = simd->scanline(out_buf.u8, in_buf.u8, xsize, 15);
+			for (; (x < xsize); ++x)
+				out_buf.u15[x] = ((in_buf.u15[x] >> 1) & 0x3def);
 			in_buf.u8 += (in->pitch * 2);
 			out_buf.u8 += (out->pitch * 2);
 		}
@@ -3173,6 +4353,7 @@ static void filter_interlace(const struct filter_data *in,
 static void filter_swab(const struct filter_data *in,
 						struct filter_data *out)
 {
+	const struct ctv_simd *simd = ctv_simd();
 	bpp_t in_buf;
 	bpp_t out_buf;
 	unsigned int xsize;
@@ -3219,7 +4400,8 @@ static void filter_swab(const struct filter_data *in,
 	case 4:
 		for (y = 0; (y < ysize); ++y)
 		{
-			for (x = 0; (x < xsize); ++x)
+			x = simd->swab(out_buf.u8, in_buf.u8, xsize, 4);
+			for (; (x < xsize); ++x)
 			{
 				union
 				{
@@ -3241,7 +4423,8 @@ static void filter_swab(const struct filter_data *in,
 	case 3:
 		for (y = 0; (y < ysize); ++y)
 		{
-			for (x = 0; (x < xsize); ++x)
+			x = simd->swab(out_buf.u8, in_buf.u8, xsize, 3);
+			for (; (x < xsize); ++x)
 			{
 				uint24_t tmp = {
 					in_buf.u24[x][2],
@@ -3257,7 +4440,8 @@ static void filter_swab(const struct filter_data *in,
 	case 2:
 		for (y = 0; (y < ysize); ++y)
 		{
-			for (x = 0; (x < xsize); ++x)
+			x = simd->swab(out_buf.u8, in_buf.u8, xsize, 2);
+			for (; (x < xsize); ++x)
 				out_buf.u16[x] = ((in_buf.u16[x] << 8) |
 								  (in_buf.u16[x] >> 8));
 			in_buf.u8 += in->pitch;
@@ -3473,7 +4657,370 @@ static void filter_text(const struct filter_data *in,
 }
 
 static const struct filter filter_text_def = {
-	"text", filter_text, true, false, false};
+	"text", filter_text, true, false, false, false, 0};
+
+/**
+ * Return the output row matching an input row for a filter that has already
+ * been initialized (out->updated).
+ * @param f Filter.
+ * @param in Input buffer data.
+ * @param out Output buffer data.
+ * @param y Input row.
+ * @return Output row.
+ */
+static unsigned int filter_row(const struct filter *f,
+							   const struct filter_data *in,
+							   const struct filter_data *out,
+							   unsigned int y)
+{
+	// Failed filters fall back to filter_off().
+	if (out->failed == true)
+		return y;
+	if (f->func == filter_stretch)
+	{
+		struct filter_stretch_data *data =
+			(struct filter_stretch_data *)out->data;
+		unsigned int ret = 0;
+		unsigned int i;
+
+		for (i = 0; (i != y); ++i)
+			ret += data->v_table[i];
+		return ret;
+	}
+	if (out->height > in->height)
+		return (y * (out->height / in->height));
+	return y;
+}
+
+/**
+ * Number of input rows a filter processes.
+ */
+static unsigned int filter_rows(const struct filter *f,
+								const struct filter_data *in,
+								const struct filter_data *out)
+{
+	if ((out->failed == false) &&
+		((f->func == filter_stretch) || (out->height > in->height)))
+		return in->height;
+	if (out->height < in->height)
+		return out->height;
+	return in->height;
+}
+
+#ifdef WITH_THREADS
+
+#define FILTERS_THREADS_MAX 8 ///< including the calling thread
+#define FILTERS_BAND_MIN 16	  ///< minimum number of rows per band
+
+/**
+ * Thread pool for the filters stack.
+ * Filters with the "split" property are run on horizontal bands of input
+ * rows, handed out to the workers and the calling thread which then waits
+ * for all of them before returning (filters_run()). Each band is written
+ * where the whole frame would have put it, except for rows near the band
+ * edges of filters with a "halo" (Scale2x, HQX), which clamp neighbours at
+ * the edges of their input: these rows are produced again from a slightly
+ * larger window into a scratch buffer and copied over, so the output does not
+ * depend on the number of threads.
+ */
+static struct
+{
+	unsigned int threads;					 ///< worker threads
+	SDL_Thread *thread[FILTERS_THREADS_MAX]; ///< workers, from index 1
+	SDL_sem *start;							 ///< posted once per worker
+	SDL_sem *done;							 ///< posted by each worker
+	std::atomic<unsigned int> next;			 ///< next band to process
+	std::atomic<bool> quit;					 ///< workers must return
+	const struct filter *f;					 ///< current filter
+	const struct filter_data *in;			 ///< its input
+	const struct filter_data *out;			 ///< its output
+	unsigned int rows;						 ///< input rows
+	unsigned int bands;						 ///< number of bands
+	struct
+	{
+		uint8_t *buf;
+		size_t size;
+	} scratch[FILTERS_THREADS_MAX]; ///< halo buffers, per thread
+} filters_pool;
+
+/**
+ * First input row of a band, always even for filter_scanline().
+ */
+static unsigned int filters_band_start(unsigned int band)
+{
+	if (band == filters_pool.bands)
+		return filters_pool.rows;
+	return (((filters_pool.rows * band) / filters_pool.bands) & ~1u);
+}
+
+/**
+ * Make filter data for input rows y0 to y1 (excluded).
+ * @param y0 First input row.
+ * @param y1 Last input row + 1.
+ * @param[out] in Input buffer data.
+ * @param[out] out Output buffer data.
+ * @param[out] stretch Storage for filter_stretch() data.
+ */
+static void filters_band_data(unsigned int y0, unsigned int y1,
+							  struct filter_data *in,
+							  struct filter_data *out,
+							  struct filter_stretch_data *stretch)
+{
+	const struct filter *f = filters_pool.f;
+	unsigned int out_y0 =
+		filter_row(f, filters_pool.in, filters_pool.out, y0);
+	unsigned int out_y1 =
+		filter_row(f, filters_pool.in, filters_pool.out, y1);
+
+	*in = *filters_pool.in;
+	in->buf.u8 += (in->pitch * y0);
+	in->height = (y1 - y0);
+	*out = *filters_pool.out;
+	out->buf.u8 += (out->pitch * out_y0);
+	out->height = (out_y1 - out_y0);
+	if ((f->func == filter_stretch) && (out->failed == false))
+	{
+		// Vertical repeat counts start with the band.
+		*stretch = *(struct filter_stretch_data *)out->data;
+		stretch->v_table += y0;
+		out->data = (void *)stretch;
+	}
+}
+
+/**
+ * Produce output rows y0 to y1 (excluded) again with enough rows around
+ * them for filters that have a halo and copy them over the band output.
+ * @param y0 First input row.
+ * @param y1 Last input row + 1.
+ * @param worker Thread index, for its scratch buffer.
+ */
+static void filters_band_halo(unsigned int y0, unsigned int y1,
+							  unsigned int worker)
+{
+	const struct filter_data *out = filters_pool.out;
+	unsigned int halo = filters_pool.f->halo;
+	unsigned int w0 = ((y0 > halo) ? (y0 - halo) : 0);
+	unsigned int w1 = (((y1 + halo) < filters_pool.rows) ?
+					   (y1 + halo) : filters_pool.rows);
+	unsigned int ratio = (out->height / filters_pool.in->height);
+	unsigned int size = (out->width * screen.Bpp);
+	struct filter_data win_in;
+	struct filter_data win_out;
+	struct filter_stretch_data unused;
+	uint8_t *src;
+	uint8_t *dst;
+	unsigned int i;
+
+	filters_band_data(w0, w1, &win_in, &win_out, &unused);
+	if (filters_pool.scratch[worker].size < (size * win_out.height))
+	{
+		uint8_t *buf = (uint8_t *)realloc(filters_pool.scratch[worker].buf,
+										  (size * win_out.height));
+
+		// Keep the band as it is, warn once.
+		if (buf == NULL)
+		{
+			static bool warned = false;
+
+			if (!warned)
+				fprintf(stderr, "sdl: filters: allocation failure\n");
+			warned = true;
+			return;
+		}
+		filters_pool.scratch[worker].buf = buf;
+		filters_pool.scratch[worker].size = (size * win_out.height);
+	}
+	win_out.buf.u8 = filters_pool.scratch[worker].buf;
+	win_out.pitch = size;
+	filters_pool.f->func(&win_in, &win_out);
+	src = (win_out.buf.u8 + (size * (y0 - w0) * ratio));
+	dst = (out->buf.u8 + (out->pitch * y0 * ratio));
+	for (i = 0; (i != ((y1 - y0) * ratio)); ++i)
+	{
+		memcpy(dst, src, size);
+		src += size;
+		dst += out->pitch;
+	}
+}
+
+/**
+ * Process bands until there are none left.
+ * @param worker Thread index, 0 for the calling thread.
+ */
+static void filters_pool_work(unsigned int worker)
+{
+	unsigned int band;
+
+	while ((band = filters_pool.next.fetch_add(1)) < filters_pool.bands)
+	{
+		unsigned int y0 = filters_band_start(band);
+		unsigned int y1 = filters_band_start(band + 1);
+		unsigned int halo = filters_pool.f->halo;
+		struct filter_data in;
+		struct filter_data out;
+		struct filter_stretch_data stretch;
+
+		filters_band_data(y0, y1, &in, &out, &stretch);
+		filters_pool.f->func(&in, &out);
+		if ((halo == 0) || (filters_pool.out->failed == true))
+			continue;
+		if (y0 != 0)
+			filters_band_halo(y0, (y0 + halo), worker);
+		if (y1 != filters_pool.rows)
+			filters_band_halo((y1 - halo), y1, worker);
+	}
+}
+
+static int filters_pool_thread(void *arg)
+{
+	unsigned int worker = (unsigned int)(uintptr_t)arg;
+
+	while ((SDL_SemWait(filters_pool.start) == 0) &&
+		   (!filters_pool.quit.load()))
+	{
+		filters_pool_work(worker);
+		SDL_SemPost(filters_pool.done);
+	}
+	return 0;
+}
+
+static void filters_pool_stop()
+{
+	unsigned int i;
+
+	if (filters_pool.threads)
+		DEBUG(("stopping %u threads...", filters_pool.threads));
+	filters_pool.quit.store(true);
+	for (i = 0; (i != filters_pool.threads); ++i)
+		SDL_SemPost(filters_pool.start);
+	for (i = 0; (i != filters_pool.threads); ++i)
+	{
+		SDL_WaitThread(filters_pool.thread[i + 1], NULL);
+		filters_pool.thread[i + 1] = NULL;
+	}
+	filters_pool.threads = 0;
+	if (filters_pool.start != NULL)
+	{
+		SDL_DestroySemaphore(filters_pool.start);
+		filters_pool.start = NULL;
+	}
+	if (filters_pool.done != NULL)
+	{
+		SDL_DestroySemaphore(filters_pool.done);
+		filters_pool.done = NULL;
+	}
+	for (i = 0; (i != elemof(filters_pool.scratch)); ++i)
+	{
+		free(filters_pool.scratch[i].buf);
+		filters_pool.scratch[i].buf = NULL;
+		filters_pool.scratch[i].size = 0;
+	}
+}
+
+/**
+ * Start or stop workers according to int_filter_threads.
+ * @return Number of worker threads.
+ */
+static unsigned int filters_pool_update()
+{
+	static int configured = 1;
+	unsigned int threads;
+	unsigned int i;
+
+	if (dgen_filter_threads == configured)
+		return filters_pool.threads;
+	configured = dgen_filter_threads;
+	if (configured > 0)
+		threads = configured;
+	else
+	{
+#ifdef _SC_NPROCESSORS_ONLN
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+		threads = ((cpus > 0) ? cpus : 1);
+#else
+		threads = 1;
+#endif
+	}
+	if (threads > FILTERS_THREADS_MAX)
+		threads = FILTERS_THREADS_MAX;
+	// The calling thread is one of them.
+	--threads;
+	filters_pool_stop();
+	if (threads == 0)
+		return 0;
+	filters_pool.start = SDL_CreateSemaphore(0);
+	filters_pool.done = SDL_CreateSemaphore(0);
+	if ((filters_pool.start == NULL) || (filters_pool.done == NULL))
+	{
+		DEBUG(("unable to create semaphores"));
+		filters_pool_stop();
+		return 0;
+	}
+	filters_pool.quit.store(false);
+	for (i = 0; (i != threads); ++i)
+	{
+		filters_pool.thread[i + 1] =
+			SDL_CreateThread(filters_pool_thread,
+							 (void *)(uintptr_t)(i + 1));
+		if (filters_pool.thread[i + 1] == NULL)
+		{
+			DEBUG(("unable to start thread %u", (i + 1)));
+			break;
+		}
+	}
+	filters_pool.threads = i;
+	DEBUG(("%u threads started", filters_pool.threads));
+	return filters_pool.threads;
+}
+
+#endif // WITH_THREADS
+
+/**
+ * Run a filter, on several threads when possible.
+ * @param f Filter.
+ * @param in Input buffer data.
+ * @param out Output buffer data.
+ * @param split False if the output must be done from this thread only.
+ */
+static void filters_run(const struct filter *f,
+						const struct filter_data *in,
+						struct filter_data *out, bool split)
+{
+#ifdef WITH_THREADS
+	unsigned int threads = filters_pool_update();
+	unsigned int rows;
+	unsigned int bands;
+	unsigned int i;
+
+	// Initialization must be done once, on the whole frame.
+	if ((threads == 0) || (!split) || (!f->split) ||
+		(out->updated == false))
+		goto whole;
+	rows = filter_rows(f, in, out);
+	bands = (rows / FILTERS_BAND_MIN);
+	if (bands > (threads + 1))
+		bands = (threads + 1);
+	if (bands < 2)
+		goto whole;
+	filters_pool.f = f;
+	filters_pool.in = in;
+	filters_pool.out = out;
+	filters_pool.rows = rows;
+	filters_pool.bands = bands;
+	filters_pool.next.store(0);
+	for (i = 0; (i != threads); ++i)
+		SDL_SemPost(filters_pool.start);
+	filters_pool_work(0);
+	for (i = 0; (i != threads); ++i)
+		SDL_SemWait(filters_pool.done);
+	return;
+whole:
+#else
+	(void)split;
+#endif
+	f->func(in, out);
+}
 
 #ifdef WITH_CTV
 
@@ -3727,6 +5274,7 @@ static int screen_init(unsigned int width, unsigned int height)
 					  SDL_HWSURFACE);
 	struct screen scrtmp;
 	const struct dgen_font *font;
+	unsigned int md_bpp;
 
 #ifdef WITH_THREADS
 	screen_update_thread_stop();
@@ -3762,8 +5310,6 @@ static int screen_init(unsigned int width, unsigned int height)
 		scrtmp.want_thread = 0;
 		scrtmp.is_thread = 0;
 		scrtmp.thread = 0;
-		scrtmp.lock = 0;
-		scrtmp.cond = 0;
 #endif
 		memset(scrtmp.color, 0, sizeof(scrtmp.color));
 		once = false;
@@ -3972,15 +5518,21 @@ opengl_failed:
 #endif
 	// Set up the Mega Drive screen.
 	// Could not be done earlier because bpp was unknown.
+	md_bpp = screen.bpp;
+#ifdef WITH_OPENGL
+	// Shaders look up palette indices themselves.
+	if ((screen.is_opengl) && (screen.texture.shaders))
+		md_bpp = 8;
+#endif
 	if ((mdscr.data == NULL) ||
-		((unsigned int)mdscr.bpp != screen.bpp) ||
+		((unsigned int)mdscr.bpp != md_bpp) ||
 		((unsigned int)mdscr.w != (video.width + 16)) ||
 		((unsigned int)mdscr.h != (video.height + 16)))
 	{
 		mdscr.w = (video.width + 16);
 		mdscr.h = (video.height + 16);
-		mdscr.pitch = (mdscr.w * screen.Bpp);
-		mdscr.bpp = screen.bpp;
+		mdscr.pitch = (mdscr.w * ((md_bpp + 1) / 8));
+		mdscr.bpp = md_bpp;
 		free(mdscr.data);
 		mdscr.data = (uint8_t *)calloc(mdscr.h, mdscr.pitch);
 		if (mdscr.data == NULL)
@@ -3989,19 +5541,24 @@ opengl_failed:
 			memset(&mdscr, 0, sizeof(mdscr));
 			return -2;
 		}
+		memset(video.palette, 0x00, sizeof(video.palette));
 		mdscr_splash();
 	}
 	DEBUG(("md screen configuration: w=%d h=%d bpp=%d pitch=%d data=%p",
 		   mdscr.w, mdscr.h, mdscr.bpp, mdscr.pitch, (void *)mdscr.data));
 	// If we're in 8 bit mode, set color 0xff to white for the text,
 	// and make a palette buffer.
-	if (screen.bpp == 8)
+	if (mdscr.bpp == 8)
 	{
-		SDL_Color color = {0xff, 0xff, 0xff, 0x00};
+		if (screen.bpp == 8)
+		{
+			SDL_Color color = {0xff, 0xff, 0xff, 0x00};
 
-		SDL_SetColors(screen.surface, &color, 0xff, 1);
-		memset(video.palette, 0x00, sizeof(video.palette));
+			SDL_SetColors(screen.surface, &color, 0xff, 1);
+		}
 		mdpal = video.palette;
+		// The surface or textures are new.
+		pd_graphics_palette_update();
 	}
 	else
 		mdpal = NULL;
@@ -4243,7 +5800,12 @@ void pd_graphics_palette_update()
 		screen.color[i].b = mdpal[((i << 2) + 2)];
 	}
 #ifdef WITH_OPENGL
-	if (!screen.is_opengl)
+	if (screen.is_opengl)
+	{
+		if (screen.texture.shaders)
+			shaders_palette(screen.texture, mdpal);
+	}
+	else
 #endif
 		SDL_SetColors(screen.surface, screen.color, 0, 64);
 }
@@ -4293,6 +5855,18 @@ void pd_graphics_update(bool update)
 	}
 	if (update == false)
 		mdscr_splash();
+#ifdef WITH_OPENGL
+	if (screen.is_opengl && screen.texture.shaders)
+	{
+		// Filtering is done by the GPU.
+		if (screen.texture.program != 0)
+		{
+			screen_update();
+			return;
+		}
+		shaders_expand(screen.texture);
+	}
+#endif
 	// Process output through filters.
 	for (i = 0; (i != elemof(filters_stack)); ++i)
 	{
@@ -4301,13 +5875,14 @@ void pd_graphics_update(bool update)
 		if ((filters_stack_size == 0) ||
 			(i == (filters_stack_size - 1)))
 			break;
-		f->func(fd, (fd + 1));
+		filters_run(f, fd, (fd + 1), true);
 	}
 	// Lock screen.
 	if (screen_lock())
 		return;
-	// Generate screen output with the last filter.
-	f->func(fd, (fd + 1));
+	// Generate screen output with the last filter, other threads must
+	// not touch a locked surface.
+	filters_run(f, fd, (fd + 1), !screen_must_lock());
 	// Unlock screen.
 	screen_unlock();
 	// Update the screen.
@@ -4324,7 +5899,7 @@ static void snd_callback(void *, Uint8 *stream, int len)
 	size_t wrote;
 
 	// Slurp off the play buffer
-	wrote = cbuf_read(stream, &sound.cbuf, len);
+	wrote = sring_read(stream, &sound.ring, len);
 	if (wrote == (size_t)len)
 		return;
 	// Not enough data, fill remaining space with silence.
@@ -4391,18 +5966,23 @@ int pd_sound_init(long &freq, unsigned int &samples)
 	samples += sound.samples;
 
 	// Calculate buffer size (sample size = (channels * (bits / 8))).
-	sound.cbuf.size = (samples * (2 * (16 / 8)));
-	sound.cbuf.i = 0;
-	sound.cbuf.s = 0;
+	sound.ring.limit = (samples * (2 * (16 / 8)));
+	for (sound.ring.size = 1; (sound.ring.size < sound.ring.limit);
+		 sound.ring.size <<= 1)
+		;
+	sound.ring.head.store(0);
+	sound.ring.tail.store(0);
+	sound.ring.underruns.store(0);
+	sound.ring.dropped.store(0);
 
 	fprintf(stderr, "sound: %uHz, %d samples, buffer: %u bytes\n",
-			sound.rate, spec.samples, (unsigned int)sound.cbuf.size);
+			sound.rate, spec.samples, (unsigned int)sound.ring.limit);
 
 	// Allocate zero-filled play buffer.
 	sndi.lr = (int16_t *)calloc(2, (sndi.len * sizeof(sndi.lr[0])));
 
-	sound.cbuf.data.i16 = (int16_t *)calloc(1, sound.cbuf.size);
-	if ((sndi.lr == NULL) || (sound.cbuf.data.i16 == NULL))
+	sound.ring.data.i16 = (int16_t *)calloc(1, sound.ring.size);
+	if ((sndi.lr == NULL) || (sound.ring.data.i16 == NULL))
 	{
 		fprintf(stderr, "sdl: couldn't allocate sound buffers.\n");
 		goto snd_error;
@@ -4420,9 +6000,10 @@ snd_error:
 	free((void *)sndi.lr);
 	sndi.lr = NULL;
 	sndi.len = 0;
-	free((void *)sound.cbuf.data.i16);
-	sound.cbuf.data.i16 = NULL;
-	memset(&sound, 0, sizeof(sound));
+	free((void *)sound.ring.data.i16);
+	sound.ring.data.i16 = NULL;
+	sound.ring.size = 0;
+	sound.ring.limit = 0;
 	return 0;
 }
 
@@ -4431,13 +6012,17 @@ snd_error:
  */
 void pd_sound_deinit()
 {
-	if (sound.cbuf.data.i16 != NULL)
+	if (sound.ring.data.i16 != NULL)
 	{
 		SDL_PauseAudio(1);
 		SDL_CloseAudio();
-		free((void *)sound.cbuf.data.i16);
+		free((void *)sound.ring.data.i16);
 	}
-	memset(&sound, 0, sizeof(sound));
+	sound.rate = 0;
+	sound.samples = 0;
+	sound.ring.data.i16 = NULL;
+	sound.ring.size = 0;
+	sound.ring.limit = 0;
 	free((void *)sndi.lr);
 	sndi.lr = NULL;
 }
@@ -4447,38 +6032,45 @@ void pd_sound_deinit()
  */
 unsigned int pd_sound_rp()
 {
-	unsigned int ret;
-
-	if (!sound.cbuf.size)
+	if (!sound.ring.size)
 		return 0;
-	SDL_LockAudio();
-	ret = sound.cbuf.i;
-	SDL_UnlockAudio();
-	return (ret >> 2);
+	return ((sound.ring.tail.load(std::memory_order_acquire) &
+			 (sound.ring.size - 1)) >> 2);
 }
 
 unsigned int pd_sound_wp()
 {
-	unsigned int ret;
-
-	if (!sound.cbuf.size)
+	if (!sound.ring.size)
 		return 0;
-	SDL_LockAudio();
-	ret = ((sound.cbuf.i + sound.cbuf.s) % sound.cbuf.size);
-	SDL_UnlockAudio();
-	return (ret >> 2);
+	return ((sound.ring.head.load(std::memory_order_acquire) &
+			 (sound.ring.size - 1)) >> 2);
+}
+
+/**
+ * Return the playback buffer level and the underruns and dropped samples
+ * since the previous call.
+ */
+void pd_sound_stats(struct sound_stats *stats)
+{
+	if (!sound.ring.size)
+	{
+		memset(stats, 0, sizeof(*stats));
+		return;
+	}
+	stats->level = (sring_level(&sound.ring) >> 2);
+	stats->size = (sound.ring.limit >> 2);
+	stats->underruns = sound.ring.underruns.exchange(0);
+	stats->dropped = (sound.ring.dropped.exchange(0) >> 2);
 }
 
 /**
- * Write contents of sndi to sound.cbuf.
+ * Write contents of sndi to sound.ring, the whole frame at once.
  */
 void pd_sound_write()
 {
-	if (!sound.cbuf.size)
+	if (!sound.ring.size)
 		return;
-	SDL_LockAudio();
-	cbuf_write(&sound.cbuf, (uint8_t *)sndi.lr, (sndi.len * 4));
-	SDL_UnlockAudio();
+	sring_write(&sound.ring, (uint8_t *)sndi.lr, (sndi.len * 4));
 }
 
 /**
@@ -4741,7 +6333,8 @@ static int prompt_rehash_rc_field(const struct rc_field *rc, md &megad)
 			 (rc->variable == &dgen_soundrate) ||
 			 (rc->variable == &dgen_soundsegs) ||
 			 (rc->variable == &dgen_soundsamples) ||
-			 (rc->variable == &dgen_mjazz))
+			 (rc->variable == &dgen_mjazz) ||
+			 (rc->variable == &dgen_emu_fm))
 		init_sound = true;
 	else if (rc->variable == &dgen_fullscreen)
 	{
@@ -4778,7 +6371,9 @@ static int prompt_rehash_rc_field(const struct rc_field *rc, md &megad)
 			 (rc->variable == &dgen_opengl_stretch) ||
 			 (rc->variable == &dgen_opengl_linear) ||
 			 (rc->variable == &dgen_opengl_32bit) ||
-			 (rc->variable == &dgen_opengl_square))
+			 (rc->variable == &dgen_opengl_square) ||
+			 (rc->variable == &dgen_opengl_shaders) ||
+			 (rc->variable == &dgen_opengl_pbo))
 	{
 #ifdef WITH_OPENGL
 		init_video = true;
@@ -4895,11 +6490,11 @@ static int prompt_rehash_rc_field(const struct rc_field *rc, md &megad)
 			samples = (dgen_soundsegs * (rate / video.hz));
 			if (!pd_sound_init(rate, samples))
 				fail = true;
-			YM2612_dump(0, ym2612_buf);
+			fm_core_dump(0, ym2612_buf);
 			SN76496_dump(0, sn76496_buf);
 			megad.init_sound();
 			SN76496_restore(0, sn76496_buf);
-			YM2612_restore(0, ym2612_buf);
+			fm_core_restore(0, ym2612_buf);
 		}
 	}
 	if (init_joystick)
@@ -5008,6 +6603,17 @@ static void prompt_show_rc_field(const struct rc_field *rc)
 			pd_message("%s is \"%s\"", rc->fieldname,
 					   emu_m68k_names[i]);
 	}
+	else if (rc->parser == rc_emu_fm)
+	{
+		for (i = 0; (emu_fm_names[i] != NULL); ++i)
+			if (i == (size_t)val)
+				break;
+		if (emu_fm_names[i] == NULL)
+			pd_message("%s is undefined", rc->fieldname);
+		else
+			pd_message("%s is \"%s\"", rc->fieldname,
+					   emu_fm_names[i]);
+	}
 	else if (rc->parser == rc_region)
 	{
 		const char *s;
@@ -5374,11 +6980,12 @@ static int handle_prompt_complete(class md &md, bool rwd)
 			}
 			s = strdup(buf);
 		}
-		// CTV filters, scaling algorithms, Z80, M68K.
+		// CTV filters, scaling algorithms, Z80, M68K, FM.
 		else if ((names = ctv_names, rc->parser == rc_ctv) ||
 				 (names = scaling_names, rc->parser == rc_scaling) ||
 				 (names = emu_z80_names, rc->parser == rc_emu_z80) ||
-				 (names = emu_m68k_names, rc->parser == rc_emu_m68k))
+				 (names = emu_m68k_names, rc->parser == rc_emu_m68k) ||
+				 (names = emu_fm_names, rc->parser == rc_emu_fm))
 		{
 		rc_names_retry:
 			skip = prompt.skip;
@@ -5633,6 +7240,8 @@ enum ctl_e
 	CTL_DGEN_FIX_CHECKSUM,
 	CTL_DGEN_SCREENSHOT,
 	CTL_DGEN_DEBUG_ENTER,
+	CTL_DGEN_FAST_FORWARD,
+	CTL_DGEN_REWIND,
 	CTL_
 };
 
@@ -6123,6 +7732,45 @@ static int ctl_dgen_debug_enter(struct ctl &, md &megad)
 	return 1;
 }
 
+static int ctl_dgen_fast_forward(struct ctl &, md &)
+{
+	if (!pd_fast_forward)
+		pd_message("Fast-forward.");
+	pd_fast_forward = true;
+	return 1;
+}
+
+static int ctl_dgen_fast_forward_release(struct ctl &, md &)
+{
+	if (pd_fast_forward)
+		pd_clear_message();
+	pd_fast_forward = false;
+	return 1;
+}
+
+static int ctl_dgen_rewind(struct ctl &, md &megad)
+{
+	if (!megad.plugged)
+		return 1;
+	if (dgen_rewind_memory <= 0)
+	{
+		pd_message("Rewind is disabled (int_rewind_memory).");
+		return 1;
+	}
+	if (!pd_rewind)
+		pd_message("Rewind.");
+	pd_rewind = true;
+	return 1;
+}
+
+static int ctl_dgen_rewind_release(struct ctl &, md &)
+{
+	if (pd_rewind)
+		pd_clear_message();
+	pd_rewind = false;
+	return 1;
+}
+
 static struct ctl control[] = {
 	// Array indices and control[].type must match enum ctl_e's order.
 	{CTL_PAD1_UP, &pad1_up, ctl_pad1, ctl_pad1_release, DEF},
@@ -6201,6 +7849,11 @@ static struct ctl control[] = {
 	 &dgen_screenshot, ctl_dgen_screenshot, NULL, DEF},
 	{CTL_DGEN_DEBUG_ENTER,
 	 &dgen_debug_enter, ctl_dgen_debug_enter, NULL, DEF},
+	{CTL_DGEN_FAST_FORWARD,
+	 &dgen_fast_forward, ctl_dgen_fast_forward,
+	 ctl_dgen_fast_forward_release, DEF},
+	{CTL_DGEN_REWIND,
+	 &dgen_rewind, ctl_dgen_rewind, ctl_dgen_rewind_release, DEF},
 	{CTL_, NULL, NULL, NULL, DEF}};
 
 static struct
@@ -6759,7 +8412,7 @@ int pd_handle_events(md &megad)
 		debug_trap = megad.debug_trap;
 		if (debug_trap)
 			mouse_grab(false);
-		if (sound.cbuf.size)
+		if (sound.ring.size)
 			SDL_PauseAudio(debug_trap == true);
 	}
 #endif
@@ -7675,6 +9328,7 @@ void pd_quit()
 
 #ifdef WITH_THREADS
 	screen_update_thread_stop();
+	filters_pool_stop();
 #endif
 	// Cleanup VRAM control window
 	vram_control_deinit();
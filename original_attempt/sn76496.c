@@ -85,6 +85,34 @@ void SN76496_restore(int chip, uint8_t buf[16])
 	}
 }
 
+/*
+  Native state of a chip. It includes tables computed for the current clock
+  and sampling rate, a state taken with different ones is refused.
+*/
+size_t SN76496_state_size(void)
+{
+	return sizeof(struct SN76496);
+}
+
+void SN76496_state_save(int chip, uint8_t *buf)
+{
+	memcpy(buf, &sn[chip], sizeof(sn[chip]));
+}
+
+int SN76496_state_load(int chip, const uint8_t *buf)
+{
+	struct SN76496 *R = &sn[chip];
+	int rate;
+	unsigned int step;
+
+	memcpy(&rate, &buf[offsetof(struct SN76496, SampleRate)], sizeof(rate));
+	memcpy(&step, &buf[offsetof(struct SN76496, UpdateStep)], sizeof(step));
+	if ((rate != R->SampleRate) || (step != R->UpdateStep))
+		return -1;
+	memcpy(R, buf, sizeof(*R));
+	return 0;
+}
+
 void SN76496Write(int chip,int data)
 {
     struct SN76496 *R = &sn[chip];
@@ -168,6 +196,123 @@ void SN76496_3_w(int offset, int data) { (void)offset; SN76496Write(3, data); }
 
 
 
+/* Samples rendered at a time by SN76496Update_*() */
+#define BLOCK 512
+
+/* vol[] of each voice times its volume, summed, for one block */
+static unsigned int mix[BLOCK];
+
+static void mix_fill(int pos, int length, unsigned int add)
+{
+    unsigned int *p = &mix[pos];
+    int i;
+
+    for (i = 0;i < length;i++)
+        p[i] += add;
+}
+
+/* Whole samples before the next edge: Count stays above 0 after STEP is
+   taken away, so the voice stays in one position for the whole sample */
+static int steady_samples(int count, int length)
+{
+    int run = (count > STEP) ? ((count - 1) / STEP) : 0;
+
+    return (run < length) ? run : length;
+}
+
+/* Tone voice 'i' over 'length' samples, one voice at a time: runs of steady
+   samples are filled at once, and the samples with edges take the k half
+   periods that end in them in one step (same result as adding Period twice
+   at a time, see below) */
+static void render_tone(struct SN76496 *R, int i, int length)
+{
+    int pos = 0;
+
+    while (pos < length)
+    {
+        int run = steady_samples(R->Count[i], length - pos);
+        int vol, count;
+        unsigned int k;
+
+        if (run)
+        {
+            if (R->Output[i] && R->Volume[i])
+                mix_fill(pos, run, STEP * R->Volume[i]);
+            R->Count[i] -= run * STEP;
+            pos += run;
+            continue;
+        }
+
+        /* k: smallest number of Period to add for Count to be above 0 */
+        vol = R->Output[i] ? R->Count[i] : 0;
+        count = R->Count[i] - STEP;
+        k = (unsigned int)(-count) / R->Period[i] + 1;
+        count += k * R->Period[i];
+
+        /* the wave is 1 half of the time of each pair of half periods, and
+           the last one (k odd) inverts it */
+        vol += (k >> 1) * R->Period[i];
+        if (k & 1)
+        {
+            R->Output[i] ^= 1;
+            if (R->Output[i]) vol += R->Period[i];
+        }
+        if (R->Output[i]) vol -= count;
+
+        R->Count[i] = count;
+        mix[pos++] += vol * R->Volume[i];
+    }
+}
+
+/* Noise voice over 'length' samples: steady runs between shifts are filled
+   at once, the samples with shifts run as before */
+static void render_noise(struct SN76496 *R, int length)
+{
+    int pos = 0;
+
+    while (pos < length)
+    {
+        int run = steady_samples(R->Count[3], length - pos);
+        int vol, left;
+
+        if (run)
+        {
+            if (R->Output[3] && R->Volume[3])
+                mix_fill(pos, run, STEP * R->Volume[3]);
+            R->Count[3] -= run * STEP;
+            pos += run;
+            continue;
+        }
+
+        vol = 0;
+        left = STEP;
+        do
+        {
+            int nextevent;
+
+
+            if (R->Count[3] < left) nextevent = R->Count[3];
+            else nextevent = left;
+
+            if (R->Output[3]) vol += R->Count[3];
+            R->Count[3] -= nextevent;
+            if (R->Count[3] <= 0)
+            {
+                if (R->RNG & 1) R->RNG ^= R->NoiseFB;
+                R->RNG >>= 1;
+                R->Output[3] = R->RNG & 1;
+                R->Count[3] += R->Period[3];
+                if (R->Output[3]) vol += R->Period[3];
+            }
+            if (R->Output[3]) vol -= R->Count[3];
+
+            left -= nextevent;
+        } while (left > 0);
+
+        mix[pos++] += vol * R->Volume[3];
+    }
+}
+
 void SN76496Update_8_2(int chip,void *buffer,int length)
 {
 #define DATATYPE unsigned char
@@ -1,6 +1,7 @@
 #ifndef SN76496_H
 #define SN76496_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -29,6 +30,9 @@ void SN76496_2_w(int offset,int data);
 void SN76496_3_w(int offset,int data);
 void SN76496_dump(int chip, uint8_t buf[16]);
 void SN76496_restore(int chip, uint8_t buf[16]);
+size_t SN76496_state_size(void);
+void SN76496_state_save(int chip, uint8_t *buf);
+int SN76496_state_load(int chip, const uint8_t *buf);
 void SN76496_set_clock(int chip,int _clock);
 int SN76496_init(int chip, int clock, int sample_rate, int sample_bits);
 void SN76496Write(int chip, int data);
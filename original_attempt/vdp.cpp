@@ -14,6 +14,8 @@
 #include <limits.h>
 #include <algorithm>
 #include "md.h"
+#include "chaoslog.h"
+#include "chaos_core.h"
 
 /** Reset the VDP. */
 void md_vdp::reset()
@@ -29,6 +31,7 @@ void md_vdp::reset()
   memset(reg, 0, 0x20);
   memset(dirt, 0xff, 0x35); // mark everything as changed
   memset(highpal, 0, sizeof(highpal));
+  cram_dirty = ~(uint64_t)0;
   memset(sprite_order, 0, sizeof(sprite_order));
   memset(sprite_mask, 0xff, sizeof(sprite_mask));
   sprite_base = NULL;
@@ -39,6 +42,7 @@ void md_vdp::reset()
   dest = NULL;
   bmap = NULL;
   cram_corruption_enabled = false;
+  cram_corruption_countdown = 0;
   fprintf(stderr, "VDP RESET COMPLETE! Flag now: %d\n", (int)cram_corruption_enabled);
 }
 
@@ -147,7 +151,8 @@ int md_vdp::poke_cram(int addr, unsigned char d)
     byt >>= 3;
     byt &= 0x0f;
     dirt[0x20 + byt] |= (1 << bit);
-    dirt[0x34] |= 2;
+    // Only this palette entry needs to be recomputed
+    cram_dirty |= ((uint64_t)1 << (addr >> 1));
     cram[addr] = d;
   }
 
@@ -173,6 +178,100 @@ int md_vdp::poke_vsram(int addr, unsigned char d)
   return 0;
 }
 
+/**
+ * Limit a VRAM block to the end of VRAM.
+ *
+ * @param addr Start address, masked to 16 bits.
+ * @param len Length in bytes.
+ * @return Length of the block within VRAM, 0 if none.
+ */
+static int vram_clip(int &addr, int len)
+{
+  addr &= 0xffff;
+  if (len > (0x10000 - addr))
+    len = (0x10000 - addr);
+  return ((len > 0) ? len : 0);
+}
+
+/**
+ * Mark a block of VRAM dirty.
+ * Sets the same dirt[0x00-0x1f] bits as poke_vram(), one 32-bit OR for
+ * every 8KB instead of one OR per byte.
+ *
+ * @param addr Start address.
+ * @param len Length in bytes.
+ */
+void md_vdp::vram_dirty(int addr, int len)
+{
+  if ((len = vram_clip(addr, len)) == 0)
+    return;
+  int first = (addr >> 8);
+  int last = ((addr + len - 1) >> 8);
+  for (int word = (first >> 5); (word <= (last >> 5)); ++word)
+  {
+    uint32_t mask = ~(uint32_t)0;
+    uint32_t bits;
+
+    if (word == (first >> 5))
+      mask &= (~(uint32_t)0 << (first & 31));
+    if (word == (last >> 5))
+      mask &= (~(uint32_t)0 >> (31 - (last & 31)));
+    // Bit N of dirt[] byte B is block (B * 8 + N), little-endian words
+    memcpy(&bits, &dirt[(word * 4)], sizeof(bits));
+    bits |= h2le32(mask);
+    memcpy(&dirt[(word * 4)], &bits, sizeof(bits));
+  }
+  dirt[0x34] |= 1;
+}
+
+/**
+ * Copy a block of VRAM, source and destination may overlap.
+ *
+ * @param dst Destination address.
+ * @param src Source address.
+ * @param len Length in bytes, clipped to the end of VRAM for both.
+ */
+void md_vdp::vram_memmove(int dst, int src, int len)
+{
+  len = vram_clip(dst, len);
+  len = vram_clip(src, len);
+  if (len == 0)
+    return;
+  memmove(&vram[dst], &vram[src], len);
+  vram_dirty(dst, len);
+}
+
+/**
+ * Fill a block of VRAM with a byte.
+ *
+ * @param addr Start address.
+ * @param d Byte to write.
+ * @param len Length in bytes, clipped to the end of VRAM.
+ */
+void md_vdp::vram_fill(int addr, unsigned char d, int len)
+{
+  if ((len = vram_clip(addr, len)) == 0)
+    return;
+  memset(&vram[addr], d, len);
+  vram_dirty(addr, len);
+}
+
+/**
+ * XOR a block of VRAM with a byte.
+ *
+ * @param addr Start address.
+ * @param mask Byte to XOR each byte with.
+ * @param len Length in bytes, clipped to the end of VRAM.
+ */
+void md_vdp::vram_xor(int addr, unsigned char mask, int len)
+{
+  if ((len = vram_clip(addr, len)) == 0)
+    return;
+  for (int i = 0; (i < len); ++i)
+    vram[(addr + i)] ^= mask;
+  vram_dirty(addr, len);
+}
+
 /**
  * Write a word to memory and update dirty flags.
  *
@@ -487,14 +586,9 @@ void md_vdp::write_reg(uint8_t addr, uint8_t data)
  */
 void md_vdp::shift_vram_up()
 {
-  fprintf(stderr, "Shifting VRAM up by 1 byte...\n");
+  chaos_log(CHAOS_VRAM_SHIFT_UP, 0, 0, 1);
   // Move all bytes one position up (toward lower addresses)
-  for (int i = 0; i < 0xFFFF; i++)
-  {
-    poke_vram(i, vram[i + 1]);
-  }
-  // Clear the last byte
-  // poke_vram(0xFFFF, 0);
+  vram_memmove(0, 1, 0xFFFF);
 }
 
 /**
@@ -503,14 +597,9 @@ void md_vdp::shift_vram_up()
  */
 void md_vdp::shift_vram_down()
 {
-  fprintf(stderr, "Shifting VRAM down by 1 byte...\n");
+  chaos_log(CHAOS_VRAM_SHIFT_DOWN, 0, 0, 1);
   // Move all bytes one position down (toward higher addresses)
-  for (int i = 0xFFFF; i > 0; i--)
-  {
-    poke_vram(i, vram[i - 1]);
-  }
-  // Clear the first byte
-  // poke_vram(0, 0);
+  vram_memmove(1, 0, 0xFFFF);
 }
 
 /**
@@ -519,17 +608,11 @@ void md_vdp::shift_vram_down()
 void md_vdp::shift_vram_down_random()
 {
   int shift_amount = rand() % 64; // Get a random number between 0 and 63
-  fprintf(stderr, "Shifting VRAM down by %d bytes...\n", shift_amount);
+  chaos_log(CHAOS_VRAM_SHIFT_DOWN, 0, 0, shift_amount);
   // Move all bytes down by the shift amount
-  for (int i = 0xFFFF; i > shift_amount; i--)
-  {
-    poke_vram(i, vram[i - shift_amount]);
-  }
+  vram_memmove(shift_amount, 0, (0x10000 - shift_amount));
   // Clear the first few bytes
-  for (int i = 0; i < shift_amount; i++)
-  {
-    poke_vram(i, 0);
-  }
+  vram_fill(0, 0, shift_amount);
 }
 
 /**
@@ -538,17 +621,12 @@ void md_vdp::shift_vram_down_random()
  */
 void md_vdp::shift_vram_left()
 {
-  fprintf(stderr, "Shifting VRAM left by 1 byte within each 256-byte block...\n");
+  chaos_log(CHAOS_VRAM_SHIFT_LEFT, 0, 0, 1);
   // Move all bytes one position left within each 256-byte block
   for (int block = 0; block < 0x100; block++)
   {
     int base = block * 256;
-    for (int i = 0; i < 255; i++)
-    {
-      poke_vram(base + i, vram[base + i + 1]);
-    }
-    // Clear the last byte of the block
-    // poke_vram(base + 255, 0);
+    vram_memmove(base, (base + 1), 255);
   }
 }
 
@@ -558,17 +636,12 @@ void md_vdp::shift_vram_left()
  */
 void md_vdp::shift_vram_right()
 {
-  fprintf(stderr, "Shifting VRAM right by 1 byte within each 256-byte block...\n");
+  chaos_log(CHAOS_VRAM_SHIFT_RIGHT, 0, 0, 1);
   // Move all bytes one position right within each 256-byte block
   for (int block = 0; block < 0x100; block++)
   {
     int base = block * 256;
-    for (int i = 255; i > 0; i--)
-    {
-      poke_vram(base + i, vram[base + i - 1]);
-    }
-    // Clear the first byte of the block
-    // poke_vram(base + 0, 0);
+    vram_memmove((base + 1), base, 255);
   }
 }
 
@@ -577,7 +650,7 @@ void md_vdp::shift_vram_right()
  */
 void md_vdp::randomize_cram()
 {
-  fprintf(stderr, "Randomizing CRAM...\n");
+  chaos_log(CHAOS_CRAM_RANDOMIZE, 0, 0, 0);
   // Randomly swap color entries in CRAM
   for (int i = 0; i < 0x100; i++)
   {
@@ -595,7 +668,7 @@ void md_vdp::randomize_cram()
  */
 void md_vdp::shift_cram_up()
 {
-  fprintf(stderr, "Shifting CRAM up by 1 byte...\n");
+  chaos_log(CHAOS_CRAM_SHIFT_UP, 0, 0, 1);
   // Move all bytes one position up (toward lower addresses)
   for (int i = 0; i < 0x7F; i++)
   {
@@ -615,10 +688,8 @@ void md_vdp::shift_cram_up()
  */
 void md_vdp::enable_cram_corruption()
 {
-  fprintf(stderr, "Enabling persistent CRAM corruption mode...\n");
-  fprintf(stderr, "Flag address: %p, current value: %d\n", (void *)&cram_corruption_enabled, (int)cram_corruption_enabled);
+  chaos_log(CHAOS_CRAM_CORRUPTION, 0, cram_corruption_enabled, 1);
   cram_corruption_enabled = true;
-  fprintf(stderr, "Flag set to: %d\n", (int)cram_corruption_enabled);
   // Mark all CRAM as dirty so changes are visible
   memset(dirt + 0x20, 0xFF, 0x10);
   dirt[0x34] |= 2;
@@ -629,236 +700,64 @@ void md_vdp::enable_cram_corruption()
  */
 void md_vdp::disable_cram_corruption()
 {
-  fprintf(stderr, "Disabling persistent CRAM corruption mode...\n");
-  fprintf(stderr, "Flag address: %p, current value: %d\n", (void *)&cram_corruption_enabled, (int)cram_corruption_enabled);
+  chaos_log(CHAOS_CRAM_CORRUPTION, 0, cram_corruption_enabled, 0);
   cram_corruption_enabled = false;
-  fprintf(stderr, "Flag set to: %d\n", (int)cram_corruption_enabled);
 }
 
 /**
- * Scramble sprite attribute table in VRAM.
- * This can cause sprites to flicker or disappear.
+ * One event of the persistent CRAM corruption.
+ * Scheduled by draw_scanline() every int_cram_corruption_lines lines while
+ * enabled. Corrupts 3 random CRAM bytes and marks only their palette entries
+ * for update.
  */
-void md_vdp::sprite_attribute_scramble()
+void md_vdp::cram_corruption_event()
 {
-  fprintf(stderr, "INTELLIGENTLY scrambling sprite attribute table...\n");
-
-  // Get sprite attribute table base address from VDP register 5
-  // Bits 15-9 of reg[5] contain the base address (in units of $200)
-  int sprite_table_base = (reg[5] & 0x7F) << 9;
-
-  // Genesis supports up to 80 sprites, each sprite entry is 8 bytes
-  int max_sprites = 80;
-  int sprite_entry_size = 8;
-
-  fprintf(stderr, "Sprite table base: 0x%04X\n", sprite_table_base);
-
-  // First, scan the sprite table to find sprites that actually exist
-  // A sprite exists if it has valid positioning data (not all zeros)
-  int active_sprites[80];
-  int active_sprite_count = 0;
-
-  for (int i = 0; i < max_sprites; i++)
+  for (int i = 0; i < 3; i++)
   {
-    int sprite_addr = sprite_table_base + (i * sprite_entry_size);
-
-    // Read sprite attributes
-    unsigned char y_high = vram[sprite_addr + 0];
-    unsigned char y_low = vram[sprite_addr + 1];
-    unsigned char size_link = vram[sprite_addr + 2];
-    unsigned char pattern_high = vram[sprite_addr + 4];
-    unsigned char pattern_low = vram[sprite_addr + 5];
-    unsigned char x_high = vram[sprite_addr + 6];
-    unsigned char x_low = vram[sprite_addr + 7];
+    int addr = rand() % 0x80;
+    unsigned char old_value = cram[addr];
 
-    // Check if this sprite appears to be active (has non-zero data or reasonable coordinates)
-    bool has_position = (y_high != 0 || y_low != 0 || x_high != 0 || x_low != 0);
-    bool has_pattern = (pattern_high != 0 || pattern_low != 0);
-    bool reasonable_y = (y_high < 8); // Y position should be reasonable (< 2048)
-
-    if ((has_position || has_pattern) && reasonable_y)
-    {
-      active_sprites[active_sprite_count] = i;
-      active_sprite_count++;
-    }
-  }
-
-  fprintf(stderr, "Found %d active sprites out of %d total\n", active_sprite_count, max_sprites);
-
-  if (active_sprite_count == 0)
-  {
-    fprintf(stderr, "No active sprites found! Creating chaos with first few sprites anyway...\n");
-    // If no sprites are found, target the first 5 sprites anyway
-    for (int i = 0; i < 5; i++)
-    {
-      active_sprites[i] = i;
-    }
-    active_sprite_count = 5;
-  }
-
-  // Now apply effects to a random selection of active sprites
-  int effects_to_apply = (active_sprite_count < 10) ? active_sprite_count : (rand() % 10) + 1;
-
-  for (int effect_num = 0; effect_num < effects_to_apply; effect_num++)
-  {
-    // Pick a random active sprite
-    int sprite_index = active_sprites[rand() % active_sprite_count];
-    int sprite_addr = sprite_table_base + (sprite_index * sprite_entry_size);
-
-    fprintf(stderr, "Applying effect %d/%d to active sprite %d at address 0x%04X\n",
-            effect_num + 1, effects_to_apply, sprite_index, sprite_addr);
-
-    int scramble_type = rand() % 10; // More scramble types
-    switch (scramble_type)
+    int corruption_type = rand() % 6;
+    switch (corruption_type)
     {
-    case 0:
-      // AGGRESSIVELY scramble Y position - make sprites fly all over
-      {
-        fprintf(stderr, "  Effect: Scrambling Y position for sprite %d\n", sprite_index);
-        int y_pos = rand() % 1024 - 256; // Allow negative positions too
-        poke_vram(sprite_addr + 0, (y_pos >> 8) & 0xFF);
-        poke_vram(sprite_addr + 1, y_pos & 0xFF);
-      }
-      break;
-
-    case 1:
-      // AGGRESSIVELY scramble sprite size - create huge or tiny sprites
-      {
-        fprintf(stderr, "  Effect: Scrambling sprite size for sprite %d\n", sprite_index);
-        unsigned char size_byte = rand() % 256;
-        // Force extreme sizes more often
-        if (rand() % 3 == 0)
-        {
-          size_byte = 0xFF; // Maximum size
-        }
-        poke_vram(sprite_addr + 2, size_byte);
-
-        // Also scramble the link field to break sprite chains
-        poke_vram(sprite_addr + 3, rand() % 256);
-      }
-      break;
-
-    case 2:
-      // MASSIVELY scramble tile pattern and attributes
-      {
-        fprintf(stderr, "  Effect: Scrambling tile pattern for sprite %d\n", sprite_index);
-        // Completely randomize both bytes
-        poke_vram(sprite_addr + 4, rand() % 256);
-        poke_vram(sprite_addr + 5, rand() % 256);
-      }
-      break;
-
-    case 3:
-      // AGGRESSIVELY scramble X position
-      {
-        fprintf(stderr, "  Effect: Scrambling X position for sprite %d\n", sprite_index);
-        int x_pos = rand() % 1024 - 256; // Allow off-screen positions
-        poke_vram(sprite_addr + 6, (x_pos >> 8) & 0xFF);
-        poke_vram(sprite_addr + 7, x_pos & 0xFF);
-      }
-      break;
-
-    case 4:
-      // Swap with another active sprite (create chaos)
-      {
-        if (active_sprite_count > 1)
-        {
-          int sprite2_index = active_sprites[rand() % active_sprite_count];
-          int sprite2_addr = sprite_table_base + (sprite2_index * sprite_entry_size);
-
-          fprintf(stderr, "  Effect: Swapping sprite %d with sprite %d\n", sprite_index, sprite2_index);
-
-          for (int byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
-          {
-            unsigned char temp = vram[sprite_addr + byte_offset];
-            poke_vram(sprite_addr + byte_offset, vram[sprite2_addr + byte_offset]);
-            poke_vram(sprite2_addr + byte_offset, temp);
-          }
-        }
-        else
-        {
-          fprintf(stderr, "  Effect: Only one active sprite, randomizing it instead\n");
-          for (int byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
-          {
-            poke_vram(sprite_addr + byte_offset, rand() % 256);
-          }
-        }
-      }
-      break;
-
-    case 5:
-      // COMPLETELY randomize the entire sprite entry
-      {
-        fprintf(stderr, "  Effect: Completely randomizing sprite %d\n", sprite_index);
-        for (int byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
+      case 0:
+        cram[addr] ^= (1 << (rand() % 8)); // Bit flip
+        break;
+      case 1:
+        cram[addr] = ~cram[addr]; // Invert
+        break;
+      case 2:
+        cram[addr] += (rand() % 64) - 32; // Add noise
+        break;
+      case 3:
+        cram[addr] = rand() % 256; // Random
+        break;
+      case 4:
+        cram[addr] = ((cram[addr] << 4) | (cram[addr] >> 4)) & 0xFF; // Bit shift
+        break;
+      case 5:
+        // Swap with another random entry
         {
-          poke_vram(sprite_addr + byte_offset, rand() % 256);
+          int swap_addr = rand() % 0x80;
+          unsigned char temp = cram[swap_addr];
+          cram[swap_addr] = cram[addr];
+          cram[addr] = temp;
+          cram_dirty |= ((uint64_t)1 << (swap_addr >> 1));
         }
-      }
-      break;
-
-    case 6:
-      // Create "ghost sprites" by setting positions to 0
-      {
-        fprintf(stderr, "  Effect: Creating ghost sprite %d (position = 0)\n", sprite_index);
-        poke_vram(sprite_addr + 0, 0); // Y = 0
-        poke_vram(sprite_addr + 1, 0);
-        poke_vram(sprite_addr + 6, 0); // X = 0
-        poke_vram(sprite_addr + 7, 0);
-      }
-      break;
-
-    case 7:
-      // Force sprites to maximum size and random positions
-      {
-        fprintf(stderr, "  Effect: Creating giant sprite %d (max size + random position)\n", sprite_index);
-        poke_vram(sprite_addr + 2, 0xFF);         // Max size
-        poke_vram(sprite_addr + 0, rand() % 256); // Random Y
-        poke_vram(sprite_addr + 1, rand() % 256);
-        poke_vram(sprite_addr + 6, rand() % 256); // Random X
-        poke_vram(sprite_addr + 7, rand() % 256);
-      }
-      break;
-
-    case 8:
-      // Break sprite chains by corrupting link fields
-      {
-        fprintf(stderr, "  Effect: Breaking sprite chains for sprite %d\n", sprite_index);
-        poke_vram(sprite_addr + 3, rand() % 256); // Random link
-        // Also corrupt the size/link byte
-        poke_vram(sprite_addr + 2, rand() % 256);
-      }
-      break;
-
-    case 9:
-      // Create "stretchy" sprites by manipulating tile patterns
-      {
-        fprintf(stderr, "  Effect: Creating stretchy sprite %d (weird tile patterns)\n", sprite_index);
-        // Set weird tile patterns that might stretch
-        unsigned short weird_pattern = rand() % 0xFFFF;
-        poke_vram(sprite_addr + 4, (weird_pattern >> 8) & 0xFF);
-        poke_vram(sprite_addr + 5, weird_pattern & 0xFF);
-
-        // Also set maximum size
-        poke_vram(sprite_addr + 2, 0xFF);
-      }
-      break;
+        break;
     }
+    cram_dirty |= ((uint64_t)1 << (addr >> 1));
+    chaos_log(CHAOS_CRAM_BYTE, addr, old_value, cram[addr]);
   }
+}
 
-  // ALSO corrupt the sprite table location register itself sometimes!
-  if (rand() % 10 == 0)
-  {
-    unsigned char new_sprite_base = rand() % 128;
-    write_reg(5, (reg[5] & 0x80) | new_sprite_base); // Keep bit 7, scramble bits 6-0
-    fprintf(stderr, "Also scrambled sprite table base register!\n");
-  }
-
-  // Mark ALL of VRAM as dirty for maximum effect
-  memset(dirt + 0x00, 0xFF, 0x20);
-  dirt[0x34] |= 1;
-
-  fprintf(stderr, "Intelligent sprite scrambling complete! Applied %d effects to active sprites.\n", effects_to_apply);
+/**
+ * Scramble sprite attribute table in VRAM.
+ * This can cause sprites to flicker or disappear.
+ */
+void md_vdp::sprite_attribute_scramble()
+{
+  chaos_core_sprite_attribute_scramble(this);
 }
 
 /**
@@ -867,11 +766,7 @@ void md_vdp::sprite_attribute_scramble()
  */
 void md_vdp::corrupt_vram_one_byte()
 {
-  int addr = rand() % 0x10000; // Random address in VRAM
-  unsigned char original_value = vram[addr];
-  unsigned char new_value = rand() % 256; // New random byte value
-  poke_vram(addr, new_value);
-  fprintf(stderr, "Corrupted VRAM at address 0x%04X: 0x%02X -> 0x%02X\n", addr, original_value, new_value);
+  chaos_core_corrupt_vram_one_byte(this);
 }
 
 /**
@@ -880,13 +775,7 @@ void md_vdp::corrupt_vram_one_byte()
  */
 void md_vdp::scroll_register_fuzzing()
 {
-  // VDP scroll registers are 0, 1 (horizontal) and 2, 3 (vertical)
-  int reg_to_fuzz = (rand() % 4); // Randomly pick one of the four scroll registers
-  unsigned char original_value = reg[reg_to_fuzz];
-  unsigned char fuzz_amount = (rand() % 21) - 10; // Random change between -10 and +10
-  unsigned char new_value = original_value + fuzz_amount;
-  write_reg(reg_to_fuzz, new_value);
-  fprintf(stderr, "Fuzzed scroll register %d: 0x%02X -> 0x%02X\n", reg_to_fuzz, original_value, new_value);
+  chaos_core_scroll_register_fuzzing(this);
 }
 
 /**
@@ -895,11 +784,7 @@ void md_vdp::scroll_register_fuzzing()
  */
 void md_vdp::corrupt_68k_ram_one_byte()
 {
-  int addr = 0xFF0000 + (rand() % 0x10000); // Random address in 68k RAM (64KB at 0xFF0000-0xFFFFFF)
-  unsigned char original_value = belongs.misc_readbyte(addr);
-  unsigned char new_value = rand() % 256; // New random byte value
-  belongs.misc_writebyte(addr, new_value);
-  fprintf(stderr, "Corrupted 68k RAM at address 0x%05X: 0x%02X -> 0x%02X\n", addr, original_value, new_value);
+  chaos_core_corrupt_68k_ram_one_byte(this);
 }
 
 /**
@@ -908,37 +793,7 @@ void md_vdp::corrupt_68k_ram_one_byte()
  */
 void md_vdp::critical_ram_scramble()
 {
-  fprintf(stderr, "Scrambling critical 68k RAM areas...\n");
-
-  // Target the top of RAM where stack and critical variables are likely stored
-  // Stack typically grows down from 0xFFFFFF
-  int corruptions_made = 0;
-
-  // Corrupt random bytes in the upper RAM area (likely stack space)
-  for (int i = 0; i < 32; i++)
-  {
-    int addr = 0xFF8000 + (rand() % 0x8000); // Upper 32KB of RAM
-    unsigned char original_value = belongs.misc_readbyte(addr);
-    unsigned char new_value = rand() % 256;
-    belongs.misc_writebyte(addr, new_value);
-    fprintf(stderr, "Corrupted critical RAM at 0x%05X: 0x%02X -> 0x%02X\n",
-            addr, original_value, new_value);
-    corruptions_made++;
-  }
-
-  // Also corrupt some bytes at the very beginning of RAM (might contain variables)
-  for (int i = 0; i < 16; i++)
-  {
-    int addr = 0xFF0000 + (rand() % 0x1000); // First 4KB of RAM
-    unsigned char original_value = belongs.misc_readbyte(addr);
-    unsigned char new_value = rand() % 256;
-    belongs.misc_writebyte(addr, new_value);
-    fprintf(stderr, "Corrupted low RAM at 0x%05X: 0x%02X -> 0x%02X\n",
-            addr, original_value, new_value);
-    corruptions_made++;
-  }
-
-  fprintf(stderr, "Critical RAM scrambling complete! Made %d corruptions.\n", corruptions_made);
+  chaos_core_critical_ram_scramble(this);
 }
 
 /**
@@ -947,25 +802,7 @@ void md_vdp::critical_ram_scramble()
  */
 void md_vdp::program_counter_increment()
 {
-  fprintf(stderr, "Corrupting 68k processor state...\n");
-
-  // Dump current state to ensure we have the latest values
-  belongs.m68k_state_dump();
-
-  // Get current PC for logging
-  uint32_t current_pc = le2h32(belongs.m68k_state.pc);
-
-  // Corrupt the PC by adding a small random offset (must be even for 68k)
-  uint32_t increment = ((rand() % 4) + 1) * 2; // 2-8 bytes, even numbers only
-  uint32_t new_pc = current_pc + increment;
-
-  // Modify the PC in the state structure
-  belongs.m68k_state.pc = h2le32(new_pc);
-
-  // Restore the state to apply changes
-  belongs.m68k_state_restore();
-
-  fprintf(stderr, "PC corrupted: 0x%08X -> 0x%08X (offset: +%d)\n", current_pc, new_pc, increment);
+  chaos_core_program_counter_increment(this);
 }
 
 /**
@@ -974,45 +811,7 @@ void md_vdp::program_counter_increment()
  */
 void md_vdp::random_register_corruption()
 {
-  fprintf(stderr, "Corrupting a random 68k CPU register...\n");
-
-  // Dump current state to ensure we have the latest values
-  belongs.m68k_state_dump();
-
-  // Choose a random data or address register (D0-D7, A0-A7)
-  int reg_type = rand() % 2;  // 0 = data register, 1 = address register
-  int reg_index = rand() % 8; // Register index 0-7
-
-  uint32_t *reg_ptr = nullptr;
-  const char *reg_name = nullptr;
-  static char reg_name_buffer[8]; // Static buffer for register name
-
-  if (reg_type == 0)
-  {
-    // Data register D0-D7
-    reg_ptr = &belongs.m68k_state.d[reg_index];
-    snprintf(reg_name_buffer, sizeof(reg_name_buffer), "D%d", reg_index);
-    reg_name = reg_name_buffer;
-  }
-  else
-  {
-    // Address register A0-A7
-    reg_ptr = &belongs.m68k_state.a[reg_index];
-    snprintf(reg_name_buffer, sizeof(reg_name_buffer), "A%d", reg_index);
-    reg_name = reg_name_buffer;
-  }
-
-  if (reg_ptr)
-  {
-    uint32_t original_value = le2h32(*reg_ptr);
-    uint32_t new_value = rand(); // New random value
-    *reg_ptr = h2le32(new_value);
-
-    // Restore the state to apply changes
-    belongs.m68k_state_restore();
-
-    fprintf(stderr, "Corrupted register %s: 0x%08X -> 0x%08X\n", reg_name, original_value, new_value);
-  }
+  chaos_core_random_register_corruption(this);
 }
 
 /**
@@ -1022,149 +821,12 @@ void md_vdp::random_register_corruption()
  */
 void md_vdp::invert_vram_contents()
 {
-  fprintf(stderr, "Inverting VRAM contents...\n");
-  for (int addr = 0; addr < 0x10000; addr++)
-  {
-    unsigned char original_value = vram[addr];
-    unsigned char new_value = ~original_value; // Bitwise NOT
-    poke_vram(addr, new_value);
-  }
-  fprintf(stderr, "VRAM inversion complete!\n");
+  chaos_log(CHAOS_VRAM_INVERT, 0, 0, 0xff);
+  vram_xor(0, 0xFF, 0x10000); // Bitwise NOT
 }
 
 // Flip variables in memory used for game logic.
 void md_vdp::flip_game_logic_variables()
 {
-  fprintf(stderr, "Intelligently flipping game logic variables in 68k RAM...\n");
-
-  // Define common variable location patterns used by Genesis games
-  struct VariableTarget
-  {
-    int base_addr;
-    int range;
-    const char *description;
-  };
-
-  VariableTarget targets[] = {
-      {0xFF0000, 0x400, "Low RAM - system variables and counters"},
-      {0xFF0400, 0x400, "Early game state variables"},
-      {0xFF0800, 0x800, "Player state and inventory"},
-      {0xFF1000, 0x800, "Level/world state variables"},
-      {0xFF1800, 0x600, "Enemy/object state arrays"},
-      {0xFF2000, 0x800, "Mid-RAM game logic variables"},
-      {0xFF3000, 0x1000, "Buffer areas and temporary variables"},
-      {0xFF8000, 0x1000, "High RAM - often used for game state"},
-      {0xFFC000, 0x2000, "Upper RAM - critical game variables"},
-      {0xFFF000, 0x800, "Top RAM - scores, lives, status"}};
-
-  int num_targets = sizeof(targets) / sizeof(targets[0]);
-  int corruptions_made = 0;
-
-  // Apply chaos to each target area
-  for (int area = 0; area < num_targets; area++)
-  {
-    VariableTarget &target = targets[area];
-
-    // Corrupt 3-8 variables in this area
-    int corruptions_in_area = 3 + (rand() % 6);
-
-    for (int i = 0; i < corruptions_in_area; i++)
-    {
-      int addr = target.base_addr + (rand() % target.range);
-
-      // Read current value
-      unsigned char original_value = belongs.misc_readbyte(addr);
-
-      // Skip if the location appears to be unused (all zeros or 0xFF)
-      if (original_value == 0x00 || original_value == 0xFF)
-      {
-        continue;
-      }
-
-      // Choose chaos type based on variable patterns
-      unsigned char new_value;
-      int chaos_type = rand() % 6;
-
-      switch (chaos_type)
-      {
-      case 0:
-        // Bitwise NOT (flip all bits)
-        new_value = ~original_value;
-        break;
-      case 1:
-        // Set to common "bad" values that cause issues
-        {
-          unsigned char bad_values[] = {0xFF, 0x80, 0x7F, 0x01, 0x00};
-          new_value = bad_values[rand() % 5];
-        }
-        break;
-      case 2:
-        // Increment by random amount (can cause overflows)
-        new_value = original_value + (rand() % 32) + 1;
-        break;
-      case 3:
-        // Multiply by 2 (common source of issues)
-        new_value = original_value * 2;
-        break;
-      case 4:
-        // Set random bit
-        new_value = original_value | (1 << (rand() % 8));
-        break;
-      case 5:
-        // Clear random bit
-        new_value = original_value & ~(1 << (rand() % 8));
-        break;
-      default:
-        new_value = ~original_value;
-        break;
-      }
-
-      // Apply the corruption
-      belongs.misc_writebyte(addr, new_value);
-      corruptions_made++;
-
-      fprintf(stderr, "Chaos in %s at 0x%05X: 0x%02X -> 0x%02X (type %d)\n",
-              target.description, addr, original_value, new_value, chaos_type);
-    }
-  }
-
-  // Also target some specific patterns that are common in games
-
-  // Look for byte values that might be counters/lives (1-9) and mess with them
-  fprintf(stderr, "Hunting for counter-like values...\n");
-  for (int hunt = 0; hunt < 20; hunt++)
-  {
-    int addr = 0xFF0000 + (rand() % 0x8000);
-    unsigned char value = belongs.misc_readbyte(addr);
-
-    // If it looks like a counter, lives, or small number
-    if (value >= 1 && value <= 99)
-    {
-      unsigned char new_value = (rand() % 2) ? 0 : 255; // Set to 0 or max
-      belongs.misc_writebyte(addr, new_value);
-      corruptions_made++;
-      fprintf(stderr, "Found counter-like value at 0x%05X: %d -> %d\n",
-              addr, value, new_value);
-    }
-  }
-
-  // Look for boolean-like values (0x00, 0x01) and flip them
-  fprintf(stderr, "Hunting for boolean-like flags...\n");
-  for (int hunt = 0; hunt < 30; hunt++)
-  {
-    int addr = 0xFF0000 + (rand() % 0x8000);
-    unsigned char value = belongs.misc_readbyte(addr);
-
-    // If it looks like a boolean flag
-    if (value == 0x00 || value == 0x01)
-    {
-      unsigned char new_value = value ? 0x00 : 0xFF; // Flip and amplify
-      belongs.misc_writebyte(addr, new_value);
-      corruptions_made++;
-      fprintf(stderr, "Flipped boolean-like flag at 0x%05X: %d -> %d\n",
-              addr, value, new_value);
-    }
-  }
-
-  fprintf(stderr, "Intelligent game logic chaos complete! Applied %d corruptions.\n", corruptions_made);
+  chaos_core_flip_game_logic_variables(this);
 }
\ No newline at end of file
@@ -32,13 +32,33 @@ fi
 info "Building WASM …"
 (cd "$BUILD_DIR" && emmake make -j"$(nproc 2>/dev/null || sysctl -n hw.ncpu)")
 
+# Speed build (genplus_fast.js), picked by the page when the browser can run it
+FAST_BUILD_DIR="$SCRIPT_DIR/build-fast"
+if [ ! -f "$FAST_BUILD_DIR/Makefile" ]; then
+    info "Configuring CMake speed build …"
+    mkdir -p "$FAST_BUILD_DIR"
+    (cd "$FAST_BUILD_DIR" && emcmake cmake -DCHAOS_BUILD_PROFILE=speed ..)
+fi
+info "Building WASM speed build …"
+(cd "$FAST_BUILD_DIR" && emmake make -j"$(nproc 2>/dev/null || sysctl -n hw.ncpu)")
+
+# Full core (genplus_full.js, Mega CD and SVP hardware), only fetched for ROMs that need it
+FULL_BUILD_DIR="$SCRIPT_DIR/build-full"
+if [ ! -f "$FULL_BUILD_DIR/Makefile" ]; then
+    info "Configuring CMake full core build …"
+    mkdir -p "$FULL_BUILD_DIR"
+    (cd "$FULL_BUILD_DIR" && emcmake cmake -DCHAOS_FULL_CORE=ON ..)
+fi
+info "Building WASM full core …"
+(cd "$FULL_BUILD_DIR" && emmake make -j"$(nproc 2>/dev/null || sysctl -n hw.ncpu)")
+
 # npm install + webpack production build
 if [ ! -d "$SCRIPT_DIR/node_modules" ]; then
     info "Installing npm dependencies …"
     npm install
 fi
 info "Building webpack bundle …"
-npx webpack --mode production
+npx webpack --config webpack.prod.js
 
 #──────────────────────────────────────────────
 # 2. Deploy to Netlify
@@ -0,0 +1,408 @@
+/**
+ * ChaosDrive - headless benchmark harness
+ *
+ * Runs the web core (wasm.c front-end, same chaos queue as the page) without
+ * a browser: loads a ROM, plays a scripted chaos schedule for N frames and
+ * reports frames/sec, per-subsystem time and VDP traffic (CHAOS_PROFILE
+ * builds) and CRC32s of the final frame and of the whole audio output, so
+ * builds can be compared both for speed and for bit-exact output.
+ *
+ * Built natively (plain cmake) or with emcmake for Node / wasmtime.
+ *
+ *   genplus_bench [-f frames] [-k frames_per_tick] [-s seed] [-c script]
+ *                 [-v out.vgm] [-w out.wav] [-m] [-i off|ram|vdp]
+ *                 [-n composite|svideo|rgb|mono] [-l] [-r] [-x scale]
+ *                 [-o m68k_clock[,z80_clock]] [-p period]
+ *                 [-g golden.txt | -G golden.txt] rom.bin|-
+ *
+ * Script lines: <frame>[/<every>] <effect> [intensity [line]]
+ *   effect is a chaos registry name (e.g. xor_vram) or "reset"; with 'every'
+ *   the command repeats every that many frames; with 'line' it is applied
+ *   before that active display line instead of at the frame/VBlank sync
+ *   point the page would use. '#' starts a comment.
+ *
+ * -v / -w capture the session (capture.h) and drain the rings after every
+ * tick like the page does. -m generates the audio through the per-channel
+ * stems (unit gains), for comparing the stem mode cost and mix. -i sets the
+ * 68k idle loop skipping mode (m68k_idle_skip()); the share of the 68k cycles
+ * it skipped is reported. -n renders through the NTSC filter (set_ntsc()).
+ * -l turns on the line cache (set_line_cache()) and reports the share of
+ * lines it reused; the frame CRC must not change. -r composites the Mode 5
+ * lines from the GPU line log (set_gpu_render(), gpu_log.h) with the CPU
+ * reference compositor and reports the share of lines logged; against a
+ * golden file recorded without it, the ticks the two renderers draw
+ * differently are reported. -x sets the output scale
+ * (set_output_scale(), 2 by default); the CRC covers the whole scaled frame.
+ * -o runs the 68k (and the Z80) at a multiple of the console's clock, 0.25
+ * to 4 (the m68k_clock / z80_clock chaos parameters), for the cost of the
+ * emulation against the CPU speed. -p samples the 68k PC every 'period'
+ * master clock cycles (CHAOS_PC_PROFILE builds, pcprof.h) and lists the
+ * hottest 256-byte regions and PCs of the whole run.
+ *
+ * -G records the CRC32 of the frame buffer and of the audio samples after
+ * every tick into a golden file, -g compares a run with one: the first
+ * differing ticks are reported and the exit status is 1 if any differs. The
+ * golden suite (golden.sh) runs both over a set of ROMs and scripts.
+ */
+
+#include <emscripten/emscripten.h>
+#include "harness.h"
+#include "chaos.h"
+#include "chaos_mod.h"
+#include "chaos_rand.h"
+#include "capture.h"
+#include "profile.h"
+#include "gpu_log.h"
+#ifdef CHAOS_PC_PROFILE
+#include "pcprof.h"
+
+#define BENCH_HOT_SPOTS 16
+
+static void print_hot_spots(int exact)
+{
+    pcprof_spot_t spots[BENCH_HOT_SPOTS];
+    unsigned int total = pcprof_total();
+    int i, count = pcprof_report(spots, BENCH_HOT_SPOTS, exact);
+
+    printf("\n%-15s  samples      %%\n", exact ? "68k pc" : "68k region");
+    for (i = 0; i < count; i++)
+    {
+        if (spots[i].address == 0xffffffff)
+            printf("%-15s", "elsewhere");
+        else if (exact)
+            printf("%06x         ", spots[i].address);
+        else
+            printf("%06x-%06x  ", spots[i].address, spots[i].address + (1 << PCPROF_REGION_SHIFT) - 1);
+        printf("%9u %6.2f\n", spots[i].samples, total ? spots[i].samples * 100.0 / total : 0.0);
+    }
+}
+#endif
+
+/* capture output: drained data goes to a temporary file, the header is only known at the end */
+typedef struct
+{
+    int stream;
+    const char *path;
+    FILE *body;
+} bench_capture_t;
+
+static bench_capture_t captures[2] = {{CAPTURE_VGM}, {CAPTURE_WAV}};
+
+static void drain_capture(bench_capture_t *c)
+{
+    capture_ring_t *ring = capture_ring(c->stream);
+
+    for (; ring->tail != ring->head; ring->tail++)
+    {
+        int chunk = ring->tail & (CAPTURE_CHUNKS - 1);
+        fwrite(ring->data[chunk], 1, ring->length[chunk], c->body);
+    }
+}
+
+static int write_capture(bench_capture_t *c)
+{
+    FILE *fp = fopen(c->path, "wb");
+    char buf[4096];
+    size_t n;
+
+    if (!fp)
+    {
+        fprintf(stderr, "bench: cannot create %s\n", c->path);
+        return 0;
+    }
+
+    fwrite(capture_header(c->stream), 1, capture_header_size(c->stream), fp);
+    rewind(c->body);
+    while ((n = fread(buf, 1, sizeof(buf), c->body)) > 0)
+        fwrite(buf, 1, n, fp);
+
+    fclose(fp);
+    fclose(c->body);
+    if (capture_ring(c->stream)->dropped)
+        fprintf(stderr, "bench: %s: %u bytes dropped\n", c->path, capture_ring(c->stream)->dropped);
+    return 1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_bench [-f frames] [-k frames_per_tick] [-s seed] [-c script] [-v out.vgm] [-w out.wav] [-m] [-i off|ram|vdp] [-n composite|svideo|rgb|mono] [-l] [-r] [-x scale] [-o m68k_clock[,z80_clock]] [-p period] [-g golden.txt | -G golden.txt] rom.bin|-\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *rom = NULL;
+    const char *script_path = NULL;
+    int frames = 3600;
+    int step = 1;
+    int stems = 0;
+    int idle = -1;
+    int ntsc = 0;
+    int line_cache = 0;
+    int gpu_render = 0;
+    unsigned int pc_period = 0;
+    int scale = 2;
+    double clocks[2] = {1.0, 1.0};
+    const char *golden = NULL;
+    int golden_record = 0;
+    int golden_diffs = 0;
+    char golden_header[256];
+    unsigned int video_size;
+    uint32 lines = 0, reused = 0, logged = 0;
+    uint32 seed = 0;
+    int frame, i, n;
+    unsigned long frame_crc, audio_crc[2] = {0, 0};
+    int samples;
+    double begin, elapsed;
+    double idle_cycles = 0;
+#ifdef CHAOS_PROFILE
+    double usec[PROF_COUNT] = {0};
+    double vdp[VDP_COUNTERS] = {0};
+#endif
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f") && (i + 1 < argc))
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-k") && (i + 1 < argc))
+            step = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && (i + 1 < argc))
+            seed = (uint32)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-c") && (i + 1 < argc))
+            script_path = argv[++i];
+        else if (!strcmp(argv[i], "-v") && (i + 1 < argc))
+            captures[0].path = argv[++i];
+        else if (!strcmp(argv[i], "-w") && (i + 1 < argc))
+            captures[1].path = argv[++i];
+        else if (!strcmp(argv[i], "-m"))
+            stems = 1;
+        else if (!strcmp(argv[i], "-i") && (i + 1 < argc))
+        {
+            static const char *const modes[] = { "off", "ram", "vdp" };
+            for (++i, idle = 2; (idle >= 0) && strcmp(argv[i], modes[idle]); idle--);
+            if (idle < 0)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "-l"))
+            line_cache = 1;
+        else if (!strcmp(argv[i], "-r"))
+            gpu_render = 1;
+        else if (!strcmp(argv[i], "-x") && (i + 1 < argc))
+            scale = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-p") && (i + 1 < argc))
+            pc_period = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-o") && (i + 1 < argc))
+        {
+            char *z80 = strchr(argv[++i], ',');
+            clocks[0] = atof(argv[i]);
+            if (z80)
+                clocks[1] = atof(z80 + 1);
+        }
+        else if ((!strcmp(argv[i], "-g") || !strcmp(argv[i], "-G")) && (i + 1 < argc))
+        {
+            golden_record = (argv[i][1] == 'G');
+            golden = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-n") && (i + 1 < argc))
+        {
+            static const char *const modes[] = { "", "composite", "svideo", "rgb", "mono" };
+            for (++i, ntsc = 4; (ntsc > 0) && strcmp(argv[i], modes[ntsc]); ntsc--);
+            if (!ntsc)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if ((argv[i][0] != '-' || !argv[i][1]) && !rom)
+            rom = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!rom || (frames < 1) || (step < 1) || (scale < 1) || (scale > 4) ||
+        (clocks[0] < 0.25) || (clocks[0] > 4.0) || (clocks[1] < 0.25) || (clocks[1] > 4.0))
+    {
+        usage();
+        return 1;
+    }
+
+#ifndef CHAOS_PC_PROFILE
+    if (pc_period)
+    {
+        fprintf(stderr, "bench: -p needs a -DCHAOS_PC_PROFILE=ON build\n");
+        return 1;
+    }
+#endif
+
+    init();
+    chaos_seed(seed);
+
+    if (script_path && !harness_load_script(script_path))
+        return 1;
+    if (!harness_load_rom(rom))
+        return 1;
+
+    if (idle >= 0)
+        set_idle_skip(idle);
+    if (ntsc && !set_ntsc(ntsc))
+        return 1;
+    if (line_cache)
+        set_line_cache(1);
+    if (gpu_render)
+        set_gpu_render(1);
+    set_output_scale(scale);
+    start();
+    /* 4^(2 * level - 1) times the console's clock */
+    chaos_param_set(CHAOS_PARAM_M68K_CLOCK, (float)((log2(clocks[0]) + 2.0) / 4.0));
+    chaos_param_set(CHAOS_PARAM_Z80_CLOCK, (float)((log2(clocks[1]) + 2.0) / 4.0));
+    chaos_stats_reset();
+    get_idle_skipped();
+#ifdef CHAOS_PC_PROFILE
+    pcprof_reset();
+    pcprof_start(pc_period);
+#endif
+
+    if (stems && !set_audio_stems(1))
+        fprintf(stderr, "bench: stem mode not available, using the mixed output\n");
+
+    video_size = (HARNESS_VIDEO_WIDTH / 2) * (HARNESS_VIDEO_HEIGHT / 2) * scale * scale * sizeof(uint32_t);
+    snprintf(golden_header, sizeof(golden_header), "genplus_bench rom %08x seed %u frames %d -k %d -x %d script %s",
+             get_rom_crc(), seed, frames, step, scale, script_path ? script_path : "-");
+    if ((clocks[0] != 1.0) || (clocks[1] != 1.0))
+        snprintf(golden_header + strlen(golden_header), sizeof(golden_header) - strlen(golden_header),
+                 " -o %g,%g", clocks[0], clocks[1]);
+    if (golden && !harness_golden_open(golden, golden_record, golden_header))
+        return 1;
+
+    for (i = 0; i < 2; i++)
+    {
+        if (captures[i].path && !(captures[i].body = tmpfile()))
+            return 1;
+        if (captures[i].path)
+            capture_start(captures[i].stream | (captures[i ^ 1].path ? captures[i ^ 1].stream : 0));
+    }
+
+    begin = emscripten_get_now();
+    for (frame = 0; frame < frames; frame += n)
+    {
+        n = (frames - frame < step) ? (frames - frame) : step;
+
+        /* commands are consumed at the start of each tick, as in the page loop
+         * (with -k, everything due within the run is applied on its first frame) */
+        for (i = frame; i < frame + n; i++)
+            harness_submit_events(i);
+        if (step == 1)
+            tick();
+        else
+            n = tick_n(n, 1);
+
+        samples = sound();
+        idle_cycles += get_idle_skipped();
+        /* one CRC per channel so the result does not depend on -k */
+        audio_crc[0] = crc32(audio_crc[0], (const unsigned char *)get_web_audio_l_ref(), samples * sizeof(float_t));
+        audio_crc[1] = crc32(audio_crc[1], (const unsigned char *)get_web_audio_r_ref(), samples * sizeof(float_t));
+        harness_golden_frame(frame + n, get_frame_buffer_ref(), video_size, get_web_audio_l_ref(), get_web_audio_r_ref(), samples * sizeof(float_t));
+
+        for (i = 0; i < 2; i++)
+        {
+            if (captures[i].body)
+                drain_capture(&captures[i]);
+        }
+
+#ifdef CHAOS_PROFILE
+        for (i = 0; i < PROF_COUNT; i++)
+            usec[i] += frame_profile.usec[i];
+        for (i = 0; i < VDP_COUNTERS; i++)
+            vdp[i] += vdp_counters[i];
+#endif
+    }
+    elapsed = emscripten_get_now() - begin;
+
+    capture_stop();
+    for (i = 0; i < 2; i++)
+    {
+        if (captures[i].body)
+        {
+            drain_capture(&captures[i]);
+            if (!write_capture(&captures[i]))
+                return 1;
+        }
+    }
+
+    frame_crc = crc32(0, (const unsigned char *)get_frame_buffer_ref(), video_size);
+    golden_diffs = harness_golden_close();
+
+    printf("rom:          %s\n", rom);
+    printf("frames:       %d\n", frames);
+    printf("time:         %.3f s\n", elapsed / 1000.0);
+    printf("fps:          %.1f\n", frames * 1000.0 / elapsed);
+    if ((clocks[0] != 1.0) || (clocks[1] != 1.0))
+        printf("cpu clocks:   68k x%g, z80 x%g\n", clocks[0], clocks[1]);
+    printf("frame crc32:  %08lx\n", frame_crc & 0xffffffffUL);
+    printf("audio crc32:  %08lx %08lx\n", audio_crc[0] & 0xffffffffUL, audio_crc[1] & 0xffffffffUL);
+    printf("idle skip:    %.1f%% of 68k cycles\n", idle_cycles * 100.0 / ((double)frames * lines_per_frame * MCYCLES_PER_LINE));
+    if (line_cache)
+    {
+        render_line_cache_stats(&lines, &reused);
+        printf("line cache:   %.1f%% of %u Mode 5 lines reused\n", lines ? reused * 100.0 / lines : 0.0, lines);
+    }
+    if (gpu_render)
+    {
+        gpu_log_stats(&logged, &lines);
+        printf("gpu log:      %.1f%% of %u lines logged\n", lines ? logged * 100.0 / lines : 0.0, lines);
+    }
+    if (golden)
+    {
+        if (golden_record)
+            printf("golden:       %s\n", golden_diffs ? "write error" : "recorded");
+        else if (golden_diffs)
+            printf("golden:       %d ticks differ\n", golden_diffs);
+        else
+            printf("golden:       identical\n");
+    }
+
+#ifdef CHAOS_PROFILE
+    printf("\nsubsystem     usec/frame      %%\n");
+    for (i = 0; i < PROF_COUNT; i++)
+    {
+        printf("%-12s %11.1f %6.1f\n", profile_name(i), usec[i] / frames, usec[i] * 0.1 / elapsed);
+    }
+
+    printf("\nvdp              per frame\n");
+    for (i = 0; i < VDP_COUNTERS; i++)
+    {
+        printf("%-12s %14.1f\n", profile_vdp_name(i), vdp[i] / frames);
+    }
+#endif
+
+#ifdef CHAOS_PC_PROFILE
+    if (pc_period)
+    {
+        printf("\npc profile:   %u samples every %u cycles", pcprof_total(), pc_period);
+        if (pcprof_dropped())
+            printf(", %u at PCs the table had no room for", pcprof_dropped());
+        printf("\n");
+        print_hot_spots(0);
+        print_hot_spots(1);
+    }
+#endif
+
+    if (harness_script_count())
+    {
+        const float *stats = chaos_stats();
+
+        printf("\neffect                          calls   usec/call\n");
+        for (i = 0; i < chaos_effect_count(); i++)
+        {
+            if (stats[i * 2] > 0.0f)
+                printf("%-30s %6.0f %11.2f\n", chaos_effect_name(i), stats[i * 2], stats[i * 2 + 1] / stats[i * 2]);
+        }
+    }
+
+    return golden_diffs ? 1 : 0;
+}
@@ -0,0 +1,276 @@
+/**
+ * ChaosDrive - per-effect cost benchmark
+ *
+ * Times every chaos effect of the registry on representative machine
+ * states: the game after -f frames of play, and any save state given with
+ * -S (save_state() format, as the page and genplus_farm store them). For
+ * each state and effect, every iteration restores the state, renders a warm
+ * frame, then times the effect (chaos_apply()) and the frame rendered right
+ * after it. The render time above the same frame without the effect is the
+ * effect's follow-on cost: pattern cache rebuilds of the tiles it touched,
+ * lines the renderer could skip before. Medians are reported, so an outlier
+ * iteration (page fault, preemption) does not move the result.
+ *
+ *   genplus_effects [-f frames] [-n iterations] [-s seed] [-S state]...
+ *                   [-b baseline.txt | -B baseline.txt [-t percent]] rom.bin
+ *
+ * -B records the total cost of each effect on each state into a baseline
+ * file, -b compares a run with one: an effect whose total grew by more than
+ * -t percent (50 by default) and EFFECTS_SLACK_USEC is reported and the exit
+ * status is 1, so the table can gate a CI run on the same machine.
+ */
+
+#include <emscripten/emscripten.h>
+#include "harness.h"
+#include "chaos.h"
+#include "chaos_rand.h"
+
+#define EFFECTS_STATES_MAX 8
+#define EFFECTS_SLACK_USEC 5.0
+
+typedef struct
+{
+    const char *name;
+    uint8 *state;
+    int size;
+} effects_state_t;
+
+static effects_state_t states[EFFECTS_STATES_MAX];
+static int state_count;
+
+/* the active display as the frame loop renders it */
+static void render_frame(void)
+{
+    int line;
+
+    parse_satb(-1);
+    for (line = 0; line < bitmap.viewport.h; line++)
+        render_line(line);
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double *values, int count)
+{
+    qsort(values, count, sizeof(double), compare_double);
+    return values[count / 2];
+}
+
+/* the running machine as a state to come back to */
+static int add_state(const char *name)
+{
+    effects_state_t *s = &states[state_count];
+
+    s->state = malloc(STATE_SIZE);
+    if (!s->state)
+        return 0;
+    s->size = state_save(s->state, 0);
+    s->name = name;
+    state_count++;
+    return 1;
+}
+
+static int load_state_file(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8 *buffer = malloc(STATE_SIZE);
+    int ok;
+
+    if (!fp || !buffer)
+    {
+        fprintf(stderr, "effects: cannot open state %s\n", path);
+        if (fp)
+            fclose(fp);
+        free(buffer);
+        return 0;
+    }
+    fread(buffer, 1, STATE_SIZE, fp);
+    fclose(fp);
+
+    ok = state_load(buffer, 0);
+    free(buffer);
+    if (!ok)
+    {
+        fprintf(stderr, "effects: %s is not a save state of this core\n", path);
+        return 0;
+    }
+    return add_state(path);
+}
+
+/* restore state 's' with the chaos parameters at their defaults and caches
+ * warm; the chaos RNG keeps running, so iterations draw different targets */
+static void prepare(const effects_state_t *s)
+{
+    state_load(s->state, STATE_INPLACE);
+    chaos_reset();
+    render_frame();
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_effects [-f frames] [-n iterations] [-s seed] [-S state]... [-b baseline.txt | -B baseline.txt [-t percent]] rom.bin\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *rom = NULL;
+    const char *state_paths[EFFECTS_STATES_MAX];
+    int state_paths_count = 0;
+    const char *baseline = NULL;
+    int baseline_record = 0;
+    double tolerance = 50.0;
+    int frames = 600;
+    int iterations = 50;
+    uint32 seed = 0;
+    FILE *base_fp = NULL;
+    double *apply, *render;
+    double render_base;
+    int regressions = 0;
+    int frame, s, id, i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f") && (i + 1 < argc))
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && (i + 1 < argc))
+            iterations = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && (i + 1 < argc))
+            seed = (uint32)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-S") && (i + 1 < argc) && (state_paths_count < EFFECTS_STATES_MAX - 1))
+            state_paths[state_paths_count++] = argv[++i];
+        else if (!strcmp(argv[i], "-t") && (i + 1 < argc))
+            tolerance = atof(argv[++i]);
+        else if ((!strcmp(argv[i], "-b") || !strcmp(argv[i], "-B")) && (i + 1 < argc))
+        {
+            baseline_record = (argv[i][1] == 'B');
+            baseline = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && !rom)
+            rom = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!rom || (frames < 0) || (iterations < 1))
+    {
+        usage();
+        return 1;
+    }
+
+    harness_name = "effects";
+    init();
+    chaos_seed(seed);
+    if (!harness_load_rom(rom))
+        return 1;
+    start();
+
+    for (frame = 0; frame < frames; frame++)
+    {
+        tick();
+        sound();
+    }
+    if (!add_state("play"))
+        return 1;
+    for (i = 0; i < state_paths_count; i++)
+    {
+        if (!load_state_file(state_paths[i]))
+            return 1;
+    }
+
+    if (baseline && !(base_fp = fopen(baseline, baseline_record ? "w" : "r")))
+    {
+        fprintf(stderr, "effects: cannot %s baseline %s\n", baseline_record ? "create" : "open", baseline);
+        return 1;
+    }
+    if (base_fp && baseline_record)
+        fprintf(base_fp, "# genplus_effects rom %08x frames %d seed %u: <state> <effect> <total usec>\n", get_rom_crc(), frames, seed);
+
+    apply = malloc(iterations * sizeof(double));
+    render = malloc(iterations * sizeof(double));
+    if (!apply || !render)
+        return 1;
+
+    for (s = 0; s < state_count; s++)
+    {
+        /* the same frame without an effect */
+        for (i = 0; i < iterations; i++)
+        {
+            double t0;
+            prepare(&states[s]);
+            t0 = emscripten_get_now();
+            render_frame();
+            render[i] = emscripten_get_now() - t0;
+        }
+        render_base = median(render, iterations) * 1000.0;
+
+        printf("state %d: %s (frame render %.1f usec)\n", s, states[s].name, render_base);
+        printf("effect                          apply us  render +us   total us\n");
+
+        for (id = 0; id < chaos_effect_count(); id++)
+        {
+            double cost_apply, cost_render, total;
+
+            for (i = 0; i < iterations; i++)
+            {
+                double t0, t1;
+                prepare(&states[s]);
+                t0 = emscripten_get_now();
+                chaos_apply(id, 1.0f);
+                t1 = emscripten_get_now();
+                render_frame();
+                apply[i] = t1 - t0;
+                render[i] = emscripten_get_now() - t1;
+            }
+            cost_apply = median(apply, iterations) * 1000.0;
+            /* below the plain frame: noise */
+            cost_render = median(render, iterations) * 1000.0 - render_base;
+            if (cost_render < 0.0)
+                cost_render = 0.0;
+            total = cost_apply + cost_render;
+            printf("%-30s %10.2f %11.2f %10.2f", chaos_effect_name(id), cost_apply, cost_render, total);
+
+            if (base_fp && baseline_record)
+            {
+                fprintf(base_fp, "%d %s %.2f\n", s, chaos_effect_name(id), total);
+            }
+            else if (base_fp)
+            {
+                char line[256], name[64];
+                int state;
+                double before;
+
+                /* the baseline entry of this state and effect, if any */
+                rewind(base_fp);
+                while (fgets(line, sizeof(line), base_fp))
+                {
+                    if ((line[0] == '#') || (sscanf(line, "%d %63s %lf", &state, name, &before) != 3))
+                        continue;
+                    if ((state != s) || strcmp(name, chaos_effect_name(id)))
+                        continue;
+                    if (total > before * (1.0 + tolerance / 100.0) + EFFECTS_SLACK_USEC)
+                    {
+                        printf("   REGRESSION (was %.2f)", before);
+                        regressions++;
+                    }
+                    break;
+                }
+            }
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    if (base_fp)
+        fclose(base_fp);
+    if (baseline && !baseline_record)
+        printf("baseline:     %d effects regressed\n", regressions);
+
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,765 @@
+/**
+ * ChaosDrive - batch glitch farm
+ *
+ * Plays the same chaos script on a ROM once per seed of a range, on every
+ * core of the host, scores the last frame of each run and keeps the best
+ * ones as save states and PNGs, for the gallery.
+ *
+ * The core is not re-entrant (one set of globals per process), so every run
+ * is a fork() of a process that has the ROM loaded and started: the child gets
+ * a copy-on-write image of the power-on machine, including the cartridge ROM
+ * that chaos effects may corrupt, and a run that takes the emulator down only
+ * loses its own seed. One worker per hardware thread takes the next seed from
+ * a counter in shared memory, so a worker that drew short runs (crashes end a
+ * run early) just takes more of them.
+ *
+ * Native only.
+ *
+ *   genplus_farm [-f frames] [-s first[-last]] [-c script] [-j jobs] [-k top]
+ *                [-o dir] [-i off|ram|vdp] [-x] rom.bin
+ *
+ * Score: Shannon entropy of the last frame's colours, in bits, then its
+ * number of unique colours. A run counts as crashed when the 68k is in its
+ * address error handler (no RTE yet) or halted on a double fault, when the
+ * PC stays within 16 bytes with interrupts masked for 2 seconds, or when the
+ * child dies. Crashed runs end there and rank below the others unless -x is
+ * given. All runs are listed in <dir>/farm.tsv; the top ones are played
+ * again (runs are deterministic) to write <dir>/seed-<n>.state (save_state()
+ * format, as the page stores its slots) and <dir>/seed-<n>.png.
+ *
+ * The seed only changes what the chaos effects draw, so the frames before
+ * the first command of the script are the same for every seed: the parent
+ * plays them once and the runs are forked from there.
+ *
+ * With -b, the runs make a tree instead of a seed range. The parent plays
+ * up to the first frame with commands; there each node forks 'branches'
+ * children, each reseeds the chaos RNG for itself (from -s first, its
+ * depth and its index) and plays up to the start of the next level, down
+ * to -d levels (3 by default) spread evenly over the run, each starting on
+ * a frame with commands; the last one plays to the end. A frame
+ * shared by a subtree is played once, and the children share the pages
+ * their parent left unchanged (fork() is copy-on-write). A node that
+ * crashes ends its whole subtree. Leaves are numbered in order and listed
+ * as leaf-<n> instead of seed-<n>.
+ */
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <emscripten/emscripten.h>
+#include "harness.h"
+#include "chaos.h"
+#include "chaos_rand.h"
+
+#define FARM_STUCK_FRAMES 120
+#define FARM_STUCK_RANGE  16
+
+enum
+{
+    FARM_OK,
+    FARM_STUCK,
+    FARM_ADDRESS_ERROR,
+    FARM_HALT,
+    FARM_SIGNAL,
+    FARM_FAILED
+};
+
+static const char *const crash_names[] = { "-", "stuck", "address error", "halt", "signal", "failed" };
+
+#define FARM_LEVELS_MAX 16
+#define FARM_LEAVES_MAX (1 << 20)
+
+typedef struct
+{
+    uint32 seed;    /* leaf number with -b */
+    int crash;
+    int frames;     /* frames run, 0 until the run is over */
+    int colours;
+    float entropy;
+} farm_result_t;
+
+/* in shared memory */
+typedef struct
+{
+    int next;
+    int64_t simulated; /* frames played by all the processes */
+    farm_result_t result[1];
+} farm_jobs_t;
+
+/* state of a run between two of its segments */
+typedef struct
+{
+    uint32 stuck_pc;
+    int stuck_frames;
+    int frame;      /* next one */
+    int crash;
+} farm_run_t;
+
+static int frames = 1800;
+static int keep_crashed;
+static const char *out_dir = ".";
+
+static farm_jobs_t *jobs;
+static farm_run_t prefix; /* what the parent played */
+
+/* tree (-b): children per node, levels, and where each level starts
+   (branch_frame[levels]: the end of the runs) */
+static int branches;
+static int levels;
+static int branch_frame[FARM_LEVELS_MAX + 1];
+static uint32 root_seed;
+
+/* ======================================================================== */
+/* Scoring                                                                  */
+/* ======================================================================== */
+
+/* the core draws every pixel twice in both directions (see the presenter) */
+static int frame_size(int *w, int *h)
+{
+    const int32_t *info = get_frame_info_ref();
+
+    *w = info[2] + 2 * info[0];
+    *h = info[3] + 2 * info[1];
+    if (*w > HARNESS_VIDEO_WIDTH / 2)
+        *w = HARNESS_VIDEO_WIDTH / 2;
+    if (*h > HARNESS_VIDEO_HEIGHT / 2)
+        *h = HARNESS_VIDEO_HEIGHT / 2;
+    return (*w > 0) && (*h > 0);
+}
+
+static uint32 frame_pixel(int x, int y)
+{
+    /* RGBA bytes, alpha dropped */
+    return get_frame_buffer_ref()[y * 2 * HARNESS_VIDEO_WIDTH + x * 2] & 0xFFFFFF;
+}
+
+static int compare_colours(const void *a, const void *b)
+{
+    uint32 x = *(const uint32 *)a;
+    uint32 y = *(const uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+static void score_frame(farm_result_t *r)
+{
+    int w, h, x, y, i, n, run;
+    uint32 *pixels;
+    double entropy = 0.0;
+
+    if (!frame_size(&w, &h) || !(pixels = malloc(w * h * sizeof(uint32))))
+        return;
+
+    for (y = n = 0; y < h; y++)
+    {
+        for (x = 0; x < w; x++)
+            pixels[n++] = frame_pixel(x, y);
+    }
+
+    /* runs of equal colours: the histogram without a 16M entry table */
+    qsort(pixels, n, sizeof(uint32), compare_colours);
+    for (i = 0; i < n; i += run)
+    {
+        double p;
+
+        for (run = 1; (i + run < n) && (pixels[i + run] == pixels[i]); run++);
+        p = (double)run / n;
+        entropy -= p * log2(p);
+        r->colours++;
+    }
+    r->entropy = (float)entropy;
+
+    free(pixels);
+}
+
+/* ======================================================================== */
+/* Output                                                                   */
+/* ======================================================================== */
+
+static void put_be32(uint8 *p, uint32 v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void write_chunk(FILE *fp, const char *type, const uint8 *data, uint32 len)
+{
+    uint8 buf[4];
+    unsigned long crc = crc32(0, (const unsigned char *)type, 4);
+
+    put_be32(buf, len);
+    fwrite(buf, 1, 4, fp);
+    fwrite(type, 1, 4, fp);
+    fwrite(data, 1, len, fp);
+    if (len)
+        crc = crc32(crc, data, len);
+    put_be32(buf, (uint32)crc);
+    fwrite(buf, 1, 4, fp);
+}
+
+/* 24-bit RGB, the pixel data in stored deflate blocks (there is no zlib in the tree) */
+static int write_png(const char *path)
+{
+    static const uint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8 header[13] = {0};
+    uint8 *raw, *idat, *p;
+    uint32 raw_size, idat_size, pos, a = 1, b = 0;
+    int w, h, x, y;
+    FILE *fp;
+
+    if (!frame_size(&w, &h))
+        return 0;
+
+    raw_size = h * (1 + 3 * w);
+    idat_size = 2 + raw_size + 5 * ((raw_size + 0xFFFE) / 0xFFFF) + 4;
+    raw = malloc(raw_size);
+    idat = malloc(idat_size);
+    fp = (raw && idat) ? fopen(path, "wb") : NULL;
+    if (!fp)
+    {
+        fprintf(stderr, "farm: cannot create %s\n", path);
+        free(raw);
+        free(idat);
+        return 0;
+    }
+
+    for (y = 0, p = raw; y < h; y++)
+    {
+        *p++ = 0;   /* no filter */
+        for (x = 0; x < w; x++)
+        {
+            uint32 c = frame_pixel(x, y);
+            *p++ = c;
+            *p++ = c >> 8;
+            *p++ = c >> 16;
+        }
+    }
+
+    p = idat;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    for (pos = 0; pos < raw_size; pos += 0xFFFF)
+    {
+        uint32 len = (raw_size - pos < 0xFFFF) ? (raw_size - pos) : 0xFFFF;
+        *p++ = (pos + len == raw_size);
+        *p++ = len;
+        *p++ = len >> 8;
+        *p++ = ~len;
+        *p++ = ~len >> 8;
+        memcpy(p, raw + pos, len);
+        p += len;
+    }
+    for (pos = 0; pos < raw_size; pos++)
+    {
+        a = (a + raw[pos]) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_be32(p, (b << 16) | a);
+
+    put_be32(header, w);
+    put_be32(header + 4, h);
+    header[8] = 8;  /* bits per channel */
+    header[9] = 2;  /* RGB */
+
+    fwrite(signature, 1, sizeof(signature), fp);
+    write_chunk(fp, "IHDR", header, sizeof(header));
+    write_chunk(fp, "IDAT", idat, idat_size);
+    write_chunk(fp, "IEND", NULL, 0);
+    fclose(fp);
+
+    free(raw);
+    free(idat);
+    return 1;
+}
+
+static int write_state(const char *path)
+{
+    int size = save_state(0);
+    FILE *fp = size ? fopen(path, "wb") : NULL;
+
+    if (!fp)
+    {
+        fprintf(stderr, "farm: cannot create %s\n", path);
+        return 0;
+    }
+    fwrite(get_state_buffer_ref(), 1, size, fp);
+    fclose(fp);
+    return 1;
+}
+
+/* ======================================================================== */
+/* Runs                                                                     */
+/* ======================================================================== */
+
+static int crash_state(uint32 *stuck_pc, int *stuck_frames)
+{
+    /* the SMS modes do not run the 68k */
+    if ((system_hw & SYSTEM_PBC) != SYSTEM_MD)
+        return FARM_OK;
+
+    /* STOP_LEVEL_HALT: an address error in the address error handler */
+    if (m68k.stopped & 2)
+        return FARM_HALT;
+
+    /* RUN_MODE_BERR_AERR_RESET outside of a reset, until the handler returns */
+    if (m68k.run_mode)
+        return FARM_ADDRESS_ERROR;
+
+    if ((m68k.int_mask == 0x0700) && (abs((int)(m68k.pc - *stuck_pc)) < FARM_STUCK_RANGE))
+        return (++*stuck_frames >= FARM_STUCK_FRAMES) ? FARM_STUCK : FARM_OK;
+
+    *stuck_pc = m68k.pc;
+    *stuck_frames = 0;
+    return FARM_OK;
+}
+
+/* play up to 'end' or a crash */
+static void run_frames(farm_run_t *run, int end)
+{
+    int start = run->frame;
+
+    for (; (run->frame < end) && !run->crash; run->frame++)
+    {
+        harness_submit_events(run->frame);
+        tick();
+        sound();
+        run->crash = crash_state(&run->stuck_pc, &run->stuck_frames);
+    }
+    if (jobs)
+        __atomic_fetch_add(&jobs->simulated, run->frame - start, __ATOMIC_RELAXED);
+}
+
+/* score the run that ended, and with 'save' write its state and frame */
+static void run_end(farm_result_t *r, const farm_run_t *run, int save)
+{
+    r->crash = run->crash;
+    r->colours = 0;
+    r->entropy = 0.0f;
+    score_frame(r);
+    r->frames = run->frame;
+
+    if (save)
+    {
+        const char *name = branches ? "leaf" : "seed";
+        char path[1024];
+
+        snprintf(path, sizeof(path), "%s/%s-%u.state", out_dir, name, r->seed);
+        write_state(path);
+        snprintf(path, sizeof(path), "%s/%s-%u.png", out_dir, name, r->seed);
+        write_png(path);
+    }
+}
+
+/* in the forked child, from the end of the prefix */
+static void run_seed(farm_result_t *r, int save)
+{
+    farm_run_t run = prefix;
+
+    chaos_seed(r->seed);
+    run_frames(&run, frames);
+    run_end(r, &run, save);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Tree                                                                     */
+/* ------------------------------------------------------------------------ */
+
+/* chaos seed of node 'node' of 'level' (1 for the root's children) */
+static uint32 node_seed(int level, int node)
+{
+    return (root_seed ^ ((uint32)level * 0x9E3779B9u)) + (uint32)node * 0x85EBCA6Bu;
+}
+
+/* nodes 'depth' levels below one */
+static int power(int depth)
+{
+    int n = 1;
+
+    while (depth-- > 0)
+        n *= branches;
+    return n;
+}
+
+static int leaves_below(int level)
+{
+    return power(levels - level);
+}
+
+/* node 'node' of 'level' ended with 'run' (crashed, or a leaf): every leaf
+   below it gets its result */
+static void tree_end(int level, int node, const farm_run_t *run)
+{
+    int count = leaves_below(level);
+    farm_result_t *first = &jobs->result[node * count];
+    int i;
+
+    run_end(first, run, 0);
+    for (i = 1; i < count; i++)
+    {
+        uint32 leaf = first[i].seed;
+
+        first[i] = *first;
+        first[i].seed = leaf;
+    }
+}
+
+/* leaves below node 'node' of 'level' without a result: the process
+   playing them died */
+static void tree_lost(int level, int node, int crash)
+{
+    int count = leaves_below(level);
+    int i;
+
+    for (i = node * count; i < (node + 1) * count; i++)
+    {
+        if (!jobs->result[i].frames)
+            jobs->result[i].crash = crash;
+    }
+}
+
+/* in a process at the end of node 'node' of 'level': its subtree, one
+   child at a time */
+static void run_subtree(int level, int node, const farm_run_t *run)
+{
+    int j;
+
+    if ((level == levels) || run->crash)
+    {
+        tree_end(level, node, run);
+        return;
+    }
+
+    for (j = 0; j < branches; j++)
+    {
+        int child = node * branches + j;
+        int status;
+        pid_t pid = fork();
+
+        if (!pid)
+        {
+            farm_run_t sub = *run;
+
+            chaos_seed(node_seed(level + 1, child));
+            run_frames(&sub, branch_frame[level + 1]);
+            run_subtree(level + 1, child, &sub);
+            _exit(0);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+            tree_lost(level + 1, child, FARM_FAILED);
+        else if (WIFSIGNALED(status))
+            tree_lost(level + 1, child, FARM_SIGNAL);
+    }
+}
+
+/* from the prefix, down the nodes leading to 'node' of 'level'; returns
+   the level it stopped at (above 'level' if the run crashed on the way)
+   and its node in '*at' */
+static int run_path(farm_run_t *run, int level, int node, int *at)
+{
+    int k;
+
+    *at = 0;
+    for (k = 0; (k < level) && !run->crash; k++)
+    {
+        *at = node / power(level - k - 1);
+        chaos_seed(node_seed(k + 1, *at));
+        run_frames(run, branch_frame[k + 1]);
+    }
+    return k;
+}
+
+/* job 'i': with 'save', replay leaf jobs->result[i].seed; otherwise the
+   subtree 'i' of level 'split' */
+static void run_tree_job(int i, int split, int save)
+{
+    farm_run_t run = prefix;
+    int level, node;
+
+    if (save)
+    {
+        farm_result_t *r = &jobs->result[i];
+
+        run_path(&run, levels, r->seed, &node);
+        run_end(r, &run, 1);
+        return;
+    }
+
+    level = run_path(&run, split, i, &node);
+    run_subtree(level, node, &run);
+}
+
+/* ------------------------------------------------------------------------ */
+
+static void worker(int count, int split, int save)
+{
+    int i;
+
+    while ((i = __atomic_fetch_add(&jobs->next, 1, __ATOMIC_RELAXED)) < count)
+    {
+        farm_result_t *r = &jobs->result[i];
+        int status;
+        pid_t pid = fork();
+
+        if (!pid)
+        {
+            if (branches)
+                run_tree_job(i, split, save);
+            else
+                run_seed(r, save);
+            _exit(0);
+        }
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid))
+            status = -1;
+        else if (!WIFSIGNALED(status))
+            continue;
+
+        if (branches && !save)
+            tree_lost(split, i, (status < 0) ? FARM_FAILED : FARM_SIGNAL);
+        else
+            r->crash = (status < 0) ? FARM_FAILED : FARM_SIGNAL;
+    }
+}
+
+/* runs every job on 'workers' processes, 0 if one could not be started;
+   with -b, the jobs are the subtrees of level 'split' */
+static int run_jobs(int count, int split, int workers, int save)
+{
+    int i, started = 0, ok = 1;
+
+    jobs->next = 0;
+    for (i = 0; i < workers; i++)
+    {
+        pid_t pid = fork();
+
+        if (!pid)
+        {
+            worker(count, split, save);
+            _exit(0);
+        }
+        if (pid < 0)
+        {
+            fprintf(stderr, "farm: cannot start worker %d\n", i);
+            ok = 0;
+            break;
+        }
+        started++;
+    }
+
+    while (started--)
+        wait(NULL);
+    return ok;
+}
+
+/* runs that died never have a frame to score */
+static int ranked_crashed(const farm_result_t *r)
+{
+    return r->crash && (!keep_crashed || (r->crash >= FARM_SIGNAL));
+}
+
+static int compare_results(const void *a, const void *b)
+{
+    const farm_result_t *x = a;
+    const farm_result_t *y = b;
+    int crash_x = ranked_crashed(x);
+    int crash_y = ranked_crashed(y);
+
+    if (crash_x != crash_y)
+        return crash_x - crash_y;
+    if (x->entropy != y->entropy)
+        return (x->entropy < y->entropy) ? 1 : -1;
+    if (x->colours != y->colours)
+        return y->colours - x->colours;
+    return (x->seed > y->seed) - (x->seed < y->seed);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_farm [-f frames] [-s first[-last]] [-b branches [-d levels]] [-c script] [-j jobs] [-k top] [-o dir] [-i off|ram|vdp] [-x] rom.bin|-\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *rom = NULL;
+    const char *script_path = NULL;
+    uint32 first = 0, last = 99;
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int top = 10;
+    int idle = -1;
+    int depth = 3;
+    int count, jobs_count, split, crashes, i;
+    size_t size;
+    double begin, elapsed;
+    char path[1024];
+    FILE *fp;
+
+    harness_name = "farm";
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-f") && (i + 1 < argc))
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && (i + 1 < argc))
+        {
+            char *end;
+            first = last = (uint32)strtoul(argv[++i], &end, 0);
+            if (*end == '-')
+                last = (uint32)strtoul(end + 1, NULL, 0);
+        }
+        else if (!strcmp(argv[i], "-b") && (i + 1 < argc))
+            branches = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-d") && (i + 1 < argc))
+            depth = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && (i + 1 < argc))
+            script_path = argv[++i];
+        else if (!strcmp(argv[i], "-j") && (i + 1 < argc))
+            workers = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-k") && (i + 1 < argc))
+            top = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && (i + 1 < argc))
+            out_dir = argv[++i];
+        else if (!strcmp(argv[i], "-x"))
+            keep_crashed = 1;
+        else if (!strcmp(argv[i], "-i") && (i + 1 < argc))
+        {
+            static const char *const modes[] = { "off", "ram", "vdp" };
+            for (++i, idle = 2; (idle >= 0) && strcmp(argv[i], modes[idle]); idle--);
+            if (idle < 0)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if ((argv[i][0] != '-' || !argv[i][1]) && !rom)
+            rom = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!rom || (frames < 1) || (last < first) || (top < 0) || (branches < 0) || (branches == 1) ||
+        (depth < 0) || (depth > FARM_LEVELS_MAX))
+    {
+        usage();
+        return 1;
+    }
+    if (workers < 1)
+        workers = 1;
+
+    init();
+    if (script_path && !harness_load_script(script_path))
+        return 1;
+    if (!harness_load_rom(rom))
+        return 1;
+    if (idle >= 0)
+        set_idle_skip(idle);
+    start();
+    if (!script_path)
+        fprintf(stderr, "farm: no script, every seed plays the game unchanged\n");
+
+    /* the seed changes nothing before the first command */
+    prefix.frame = harness_next_event(0);
+    if ((prefix.frame < 0) || (prefix.frame > frames))
+        prefix.frame = frames;
+
+    count = jobs_count = (int)(last - first + 1);
+    split = 0;
+    if (branches)
+    {
+        /* levels spread over the run, each starting on a frame with
+           commands, as many as the leaves allow */
+        root_seed = first;
+        for (levels = 0; levels < depth; levels++)
+        {
+            int from = levels ? branch_frame[0] + (frames - branch_frame[0]) * levels / depth : 0;
+            int next;
+
+            if (levels && (from <= branch_frame[levels - 1]))
+                from = branch_frame[levels - 1] + 1;
+            next = harness_next_event(from);
+
+            if ((next < 0) || (next >= frames) || (power(levels + 1) > FARM_LEAVES_MAX))
+                break;
+            branch_frame[levels] = next;
+        }
+        branch_frame[levels] = frames;
+        prefix.frame = branch_frame[0];
+        count = power(levels);
+
+        /* enough subtrees to keep the workers busy */
+        while ((split < levels) && (power(split) < workers * 4))
+            split++;
+        jobs_count = power(split);
+    }
+
+    size = sizeof(farm_jobs_t) + (count - 1) * sizeof(farm_result_t);
+    jobs = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (jobs == MAP_FAILED)
+    {
+        fprintf(stderr, "farm: cannot map %d results\n", count);
+        return 1;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        memset(&jobs->result[i], 0, sizeof(farm_result_t));
+        jobs->result[i].seed = branches ? (uint32)i : first + i;
+    }
+
+    begin = emscripten_get_now();
+    i = prefix.frame;
+    prefix.frame = 0;
+    run_frames(&prefix, i);
+    if (!run_jobs(jobs_count, split, workers, 0))
+        return 1;
+    elapsed = emscripten_get_now() - begin;
+
+    qsort(jobs->result, count, sizeof(farm_result_t), compare_results);
+
+    snprintf(path, sizeof(path), "%s/farm.tsv", out_dir);
+    if (!(fp = fopen(path, "w")))
+    {
+        fprintf(stderr, "farm: cannot create %s\n", path);
+        return 1;
+    }
+    fprintf(fp, "%s\tentropy\tcolours\tframes\tcrash\n", branches ? "leaf" : "seed");
+    for (i = crashes = 0; i < count; i++)
+    {
+        const farm_result_t *r = &jobs->result[i];
+        fprintf(fp, "%u\t%.3f\t%d\t%d\t%s\n", r->seed, r->entropy, r->colours, r->frames, crash_names[r->crash]);
+        crashes += (r->crash != FARM_OK);
+    }
+    fclose(fp);
+
+    printf("rom:          %s\n", rom);
+    if (branches)
+        printf("tree:         %d branches, %d levels (%d leaves) from seed %u on %d workers\n",
+               branches, levels, count, first, workers);
+    else
+        printf("seeds:        %u-%u on %d workers\n", first, last, workers);
+    printf("frames:       %d per run, %lld played (%.1f%% of runs from power-on)\n", frames,
+           (long long)jobs->simulated, jobs->simulated * 100.0 / ((double)count * frames));
+    printf("time:         %.3f s (%.1f runs/s)\n", elapsed / 1000.0, count * 1000.0 / elapsed);
+    printf("crashed:      %d\n", crashes);
+
+    /* the machine image of the script runs is gone, play the best seeds again */
+    if (top > count)
+        top = count;
+    while (top && ranked_crashed(&jobs->result[top - 1]))
+        top--;
+    if (!top)
+        return 0;
+    if (!run_jobs(top, split, workers, 1))
+        return 1;
+
+    printf("\n%s          entropy  colours  frames  crash\n", branches ? "leaf" : "seed");
+    for (i = 0; i < top; i++)
+    {
+        const farm_result_t *r = &jobs->result[i];
+        printf("%-12u %8.3f %8d %7d  %s\n", r->seed, r->entropy, r->colours, r->frames, crash_names[r->crash]);
+    }
+
+    return 0;
+}
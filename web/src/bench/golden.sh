@@ -0,0 +1,77 @@
+#!/usr/bin/env bash
+# Golden image regression suite: plays every ROM of a directory through
+# genplus_bench for each run of golden.txt and compares the CRC32 of every
+# frame and of its audio with the hashes recorded in <dir>/golden/. VGM
+# files of the directory go through genplus_vgm with both YM2612 cores.
+#
+#   src/bench/golden.sh [-u] <build dir> <rom dir>
+#
+# -u records the hashes again, after a change that is meant to alter the
+# output. ROMs stay out of the repository, and so do their hashes.
+set -uo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+
+UPDATE=0
+if [ "${1:-}" = "-u" ]; then
+    UPDATE=1
+    shift
+fi
+if [ $# -ne 2 ]; then
+    echo "usage: $0 [-u] <build dir> <rom dir>" >&2
+    exit 2
+fi
+
+BENCH="$1/genplus_bench"
+VGM="$1/genplus_vgm"
+ROMS="$2"
+mkdir -p "$ROMS/golden"
+
+failed=0
+count=0
+for rom in "$ROMS"/*.bin "$ROMS"/*.md "$ROMS"/*.gen; do
+    [ -f "$rom" ] || continue
+    base="$(basename "${rom%.*}")"
+    while read -r name frames seed script options; do
+        case "$name" in ''|'#'*) continue ;; esac
+        golden="$ROMS/golden/$base.$name.txt"
+        args=(-f "$frames" -s "$seed")
+        [ "$script" != "-" ] && args+=(-c "$SCRIPT_DIR/$script")
+        if [ $UPDATE = 1 ] || [ ! -f "$golden" ]; then
+            args+=(-G "$golden")
+        else
+            args+=(-g "$golden")
+        fi
+        # shellcheck disable=SC2086
+        if result="$("$BENCH" "${args[@]}" $options "$rom" | grep '^golden:')"; then
+            printf '%-40s %s\n' "$base $name" "${result#golden: }"
+        else
+            printf '%-40s FAILED\n' "$base $name"
+            failed=$((failed + 1))
+        fi
+        count=$((count + 1))
+    done < "$SCRIPT_DIR/golden.txt"
+done
+
+for vgm in "$ROMS"/*.vgm; do
+    [ -f "$vgm" ] || continue
+    base="$(basename "${vgm%.*}")"
+    for core in mame nuked; do
+        golden="$ROMS/golden/$base.vgm-$core.txt"
+        if [ $UPDATE = 1 ] || [ ! -f "$golden" ]; then
+            args=(-G "$golden")
+        else
+            args=(-g "$golden")
+        fi
+        if result="$("$VGM" -t 60 -y "$core" "${args[@]}" "$vgm" | grep '^golden:')"; then
+            printf '%-40s %s\n' "$base vgm-$core" "${result#golden: }"
+        else
+            printf '%-40s FAILED\n' "$base vgm-$core"
+            failed=$((failed + 1))
+        fi
+        count=$((count + 1))
+    done
+done
+
+echo "$count runs, $failed failed"
+[ $failed = 0 ]
@@ -0,0 +1,303 @@
+/**
+ * ChaosDrive - code shared by the headless harnesses
+ *
+ * ROMs are streamed into the core in chunks and scripts submitted through the
+ * chaos queue, as the page does.
+ */
+
+#include "harness.h"
+#include "chaos.h"
+#include "chaos_queue.h"
+
+const char *harness_name = "bench";
+
+#define HARNESS_SCRIPT_MAX 256
+
+/* same split as the page: video effects after VBlank DMA, others at frame start */
+#define HARNESS_TARGET_VIDEO (CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM | CHAOS_TARGET_VDP_REGS)
+
+typedef struct
+{
+    int frame;
+    int every;      /* 0 = once */
+    int op;
+    int line;       /* -1 = frame/VBlank sync */
+    float intensity;
+} harness_event_t;
+
+static harness_event_t script[HARNESS_SCRIPT_MAX];
+static int script_count;
+
+int harness_effect_id(const char *name)
+{
+    int id;
+
+    if (!strcmp(name, "reset"))
+        return CHAOS_OP_RESET;
+
+    for (id = 0; id < chaos_effect_count(); id++)
+    {
+        if (!strcmp(name, chaos_effect_name(id)))
+            return id;
+    }
+    return -1;
+}
+
+int harness_load_script(const char *path)
+{
+    char buf[256];
+    int lineno = 0;
+    FILE *fp = fopen(path, "r");
+
+    if (!fp)
+    {
+        fprintf(stderr, "%s: cannot open script %s\n", harness_name, path);
+        return 0;
+    }
+
+    while (fgets(buf, sizeof(buf), fp))
+    {
+        char name[64];
+        char *comment = strchr(buf, '#');
+        harness_event_t *ev = &script[script_count];
+        int fields;
+
+        lineno++;
+        if (comment)
+            *comment = 0;
+
+        ev->every = 0;
+        ev->line = -1;
+        ev->intensity = 1.0f;
+        fields = sscanf(buf, "%d/%d %63s %f %d", &ev->frame, &ev->every, name, &ev->intensity, &ev->line);
+        if (fields < 2)
+        {
+            ev->every = 0;
+            fields = sscanf(buf, "%d %63s %f %d", &ev->frame, name, &ev->intensity, &ev->line);
+            if (fields <= 0)
+                continue;
+            fields++;
+        }
+        if (fields < 3)
+        {
+            fprintf(stderr, "%s: %s:%d: expected <frame>[/<every>] <effect> [intensity [line]]\n", harness_name, path, lineno);
+            fclose(fp);
+            return 0;
+        }
+
+        ev->op = harness_effect_id(name);
+        if (ev->op < 0)
+        {
+            fprintf(stderr, "%s: %s:%d: unknown effect '%s'\n", harness_name, path, lineno, name);
+            fclose(fp);
+            return 0;
+        }
+
+        if (++script_count == HARNESS_SCRIPT_MAX)
+            break;
+    }
+
+    fclose(fp);
+    return 1;
+}
+
+/* streamed into the core in 64KB chunks, as the page does */
+#define HARNESS_ROM_CHUNK 0x10000
+
+int harness_load_rom(const char *path)
+{
+    FILE *fp = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+    uint8_t *buffer = fp ? malloc(MAXROMSIZE) : NULL;
+    uint8_t *dst;
+    size_t size, pos;
+
+    if (!buffer)
+    {
+        fprintf(stderr, "%s: cannot open ROM %s\n", harness_name, path);
+        if (fp && (fp != stdin))
+            fclose(fp);
+        return 0;
+    }
+
+    size = fread(buffer, 1, MAXROMSIZE, fp);
+    if (fp != stdin)
+        fclose(fp);
+
+    dst = size ? rom_stream_begin((uint32_t)size) : NULL;
+    if (!dst)
+    {
+        fprintf(stderr, "%s: empty ROM %s\n", harness_name, path);
+        free(buffer);
+        return 0;
+    }
+
+    for (pos = 0; dst; pos += HARNESS_ROM_CHUNK)
+    {
+        size_t len = (size - pos < HARNESS_ROM_CHUNK) ? (size - pos) : HARNESS_ROM_CHUNK;
+        memcpy(dst, buffer + pos, len);
+        dst = rom_stream_write((uint32_t)len);
+    }
+
+    free(buffer);
+    return 1;
+}
+
+void harness_submit(int op, float intensity, int line)
+{
+    chaos_queue_t *queue = chaos_command_queue();
+    chaos_cmd_t *cmd = &queue->cmd[queue->head & (CHAOS_QUEUE_SIZE - 1)];
+
+    cmd->op = (uint8_t)op;
+    cmd->line = (line < 0) ? 0 : (uint16_t)line;
+    cmd->intensity = intensity;
+    if (line >= 0)
+        cmd->sync = CHAOS_SYNC_LINE;
+    else if ((op != CHAOS_OP_RESET) && (chaos_effect_targets(op) & HARNESS_TARGET_VIDEO))
+        cmd->sync = CHAOS_SYNC_VBLANK;
+    else
+        cmd->sync = CHAOS_SYNC_FRAME;
+    queue->head++;
+}
+
+void harness_submit_events(int frame)
+{
+    int i;
+
+    for (i = 0; i < script_count; i++)
+    {
+        const harness_event_t *ev = &script[i];
+
+        if ((frame < ev->frame) || (frame != ev->frame && (!ev->every || (frame - ev->frame) % ev->every)))
+            continue;
+
+        harness_submit(ev->op, ev->intensity, ev->line);
+    }
+}
+
+int harness_next_event(int frame)
+{
+    int i, next = -1;
+
+    for (i = 0; i < script_count; i++)
+    {
+        const harness_event_t *ev = &script[i];
+        int due = ev->frame;
+
+        if ((due < frame) && ev->every)
+            due += (frame - due + ev->every - 1) / ev->every * ev->every;
+        if ((due >= frame) && ((next < 0) || (due < next)))
+            next = due;
+    }
+    return next;
+}
+
+int harness_script_count(void)
+{
+    return script_count;
+}
+
+/* golden hash files */
+#define HARNESS_GOLDEN_REPORT 8
+
+static FILE *golden_fp;
+static int golden_record;
+static int golden_diffs;
+static int golden_errors;
+
+int harness_golden_open(const char *path, int record, const char *header)
+{
+    golden_fp = fopen(path, record ? "w" : "r");
+    golden_record = record;
+    golden_diffs = 0;
+    golden_errors = 0;
+
+    if (!golden_fp)
+    {
+        fprintf(stderr, "%s: cannot %s golden file %s\n", harness_name, record ? "create" : "open", path);
+        return 0;
+    }
+
+    if (record)
+        fprintf(golden_fp, "# %s\n", header);
+    return 1;
+}
+
+/* next "<frame> <video> <audio>" line, 0 at the end of the file */
+static int golden_read(int *frame, unsigned long *video, unsigned long *audio)
+{
+    char buf[128];
+
+    while (fgets(buf, sizeof(buf), golden_fp))
+    {
+        if ((buf[0] != '#') && (sscanf(buf, "%d %lx %lx", frame, video, audio) == 3))
+            return 1;
+    }
+    return 0;
+}
+
+static void golden_report(int frame, const char *what, unsigned long got, unsigned long want)
+{
+    if (golden_diffs++ < HARNESS_GOLDEN_REPORT)
+        fprintf(stderr, "%s: frame %d: %s %08lx, golden %08lx\n", harness_name, frame, what, got, want);
+}
+
+void harness_golden_frame(int frame, const void *video, unsigned int video_size,
+                          const void *l, const void *r, unsigned int audio_size)
+{
+    unsigned long video_crc, audio_crc, want_video, want_audio;
+    int want_frame;
+
+    if (!golden_fp)
+        return;
+
+    video_crc = crc32(0, (const unsigned char *)video, video_size) & 0xffffffffUL;
+    audio_crc = crc32(0, (const unsigned char *)l, audio_size);
+    if (r)
+        audio_crc = crc32(audio_crc, (const unsigned char *)r, audio_size);
+    audio_crc &= 0xffffffffUL;
+
+    if (golden_record)
+    {
+        if (fprintf(golden_fp, "%d %08lx %08lx\n", frame, video_crc, audio_crc) < 0)
+            golden_errors++;
+        return;
+    }
+
+    if (!golden_read(&want_frame, &want_video, &want_audio))
+    {
+        if (golden_diffs++ < HARNESS_GOLDEN_REPORT)
+            fprintf(stderr, "%s: frame %d: not in the golden file\n", harness_name, frame);
+    }
+    else if (want_frame != frame)
+    {
+        if (golden_diffs++ < HARNESS_GOLDEN_REPORT)
+            fprintf(stderr, "%s: frame %d: golden file has frame %d (other -k?)\n", harness_name, frame, want_frame);
+    }
+    else if (want_video != video_crc)
+        golden_report(frame, "frame crc32", video_crc, want_video);
+    else if (want_audio != audio_crc)
+        golden_report(frame, "audio crc32", audio_crc, want_audio);
+}
+
+int harness_golden_close(void)
+{
+    unsigned long video, audio;
+    int frame, extra = 0;
+
+    if (!golden_fp)
+        return 0;
+
+    if (!golden_record)
+    {
+        while (golden_read(&frame, &video, &audio))
+            extra++;
+        if (extra)
+            fprintf(stderr, "%s: golden file has %d more ticks\n", harness_name, extra);
+        golden_diffs += extra;
+    }
+
+    if (fclose(golden_fp))
+        golden_errors++;
+    golden_fp = NULL;
+    return golden_errors ? -1 : golden_diffs;
+}
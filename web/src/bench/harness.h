@@ -0,0 +1,88 @@
+/**
+ * ChaosDrive - code shared by the harnesses (bench.c, farm.c) and the desktop
+ * front end (src/desktop/desktop.c)
+ *
+ * The wasm.c front-end entry points, ROM loading, the chaos script (see the
+ * top of bench.c for its format) and the golden hash files.
+ */
+
+#ifndef _HARNESS_H_
+#define _HARNESS_H_
+
+#include "shared.h"
+
+/* wasm.c front-end */
+extern void init(void);
+extern void start(void);
+extern void soft_reset(int boot);
+extern void tick(void);
+extern int tick_n(int frames, int render_last_only);
+extern int sound(void);
+extern int set_audio_stems(int enabled);
+extern void set_idle_skip(int mode);
+extern int set_ntsc(int mode);
+extern void set_line_cache(int enabled);
+extern int set_output_scale(int scale);
+extern unsigned int get_idle_skipped(void);
+extern uint8_t *rom_stream_begin(uint32_t size);
+extern uint8_t *rom_stream_write(uint32_t len);
+extern uint32_t *get_frame_buffer_ref(void);
+extern uint32_t get_rom_crc(void);
+extern int32_t *get_frame_info_ref(void);
+extern float_t *get_web_audio_l_ref(void);
+extern float_t *get_web_audio_r_ref(void);
+extern uint8_t *get_state_buffer_ref(void);
+extern int save_state(int flags);
+extern int set_audio_rate(int rate, double skew);
+extern void set_indexed_output(int enabled);
+extern int replay_start(void);
+extern int replay_seek(int frame);
+extern int32_t input_bits;
+
+/* frame buffer size at the default output scale (2x) */
+#define HARNESS_VIDEO_WIDTH  640
+#define HARNESS_VIDEO_HEIGHT 480
+
+/* prefix of the error messages */
+extern const char *harness_name;
+
+/* 0 on error (reported on stderr) */
+extern int harness_load_script(const char *path);
+extern int harness_load_rom(const char *path);
+
+/* chaos registry id of an effect name, or CHAOS_OP_RESET for "reset"; -1 if
+ * unknown */
+extern int harness_effect_id(const char *name);
+
+/* submit a command to the core's queue, synced like the page does: video
+ * effects after VBlank DMA, others at the frame start ('line' -1), or before
+ * active display line 'line' */
+extern void harness_submit(int op, float intensity, int line);
+
+/* number of commands in the script */
+extern int harness_script_count(void);
+
+/* submit the script commands due on 'frame' to the core's queue */
+extern void harness_submit_events(int frame);
+
+/* first frame from 'frame' on with script commands due, -1 if none */
+extern int harness_next_event(int frame);
+
+/* Golden hash file: one "<frame> <video crc32> <audio crc32>" line per tick,
+ * '#' lines are comments. With 'record' the hashes are written to 'path'
+ * (after 'header', a comment), otherwise they are compared with the ones
+ * stored there and the first differences are reported on stderr. 0 on
+ * error */
+extern int harness_golden_open(const char *path, int record, const char *header);
+
+/* hashes of the tick that ended on 'frame': the frame buffer and the audio
+ * samples, 'audio_size' bytes of each channel ('r' NULL for interleaved
+ * samples) */
+extern void harness_golden_frame(int frame, const void *video, unsigned int video_size,
+                                 const void *l, const void *r, unsigned int audio_size);
+
+/* number of ticks that differ from the golden file or are missing on either
+ * side (0 when recording), -1 on error */
+extern int harness_golden_close(void);
+
+#endif /* _HARNESS_H_ */
@@ -0,0 +1,30 @@
+#ifndef _NATIVE_EMSCRIPTEN_H_
+#define _NATIVE_EMSCRIPTEN_H_
+
+/* Native stand-in for <emscripten/emscripten.h> (benchmark harness only).
+ *
+ * Covers what the web core uses: exported function markers, EM_ASM() and
+ * performance.now() timing. Kept out of src/main/c so the WASM build never
+ * picks it up.
+ */
+
+/* the real header pulls these in, the core relies on it */
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#define EMSCRIPTEN_KEEPALIVE
+
+#define EM_ASM(...)  ((void)0)
+#define EM_ASM_(...) ((void)0)
+#define EM_ASM_INT(...) 0
+
+/* performance.now(): milliseconds from an arbitrary origin */
+static inline double emscripten_get_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+#endif /* _NATIVE_EMSCRIPTEN_H_ */
@@ -0,0 +1,473 @@
+/**
+ * ChaosDrive - server-side clip renderer
+ *
+ * Renders a recorded chaos session (a recipe, see chaos_record.h) for the
+ * gallery: plays the recording without rendering up to the capture frame,
+ * as replay_seek() does for the page, then draws a short clip through the
+ * instant replay frame (clip.h) and writes it as an animated GIF, plus the
+ * first frame as a PNG thumbnail. Both keep the core's 8-bit pixel indices
+ * with each frame's palette, nothing is quantized.
+ *
+ * There is no DOM and no audio output: the tool only reads files, so it
+ * builds natively, for Node (-DCHAOS_BENCH=ON under emcmake) and as a WASI
+ * module (-DCHAOS_BENCH_STANDALONE=ON). The core is not re-entrant, so
+ * concurrent jobs are separate processes or module instances; an instance
+ * holds the core, the ROM and the recipe, and streams the clip out frame by
+ * frame instead of keeping it.
+ *
+ *   genplus_render [-a frame] [-n frames] [-o clip.gif] [-p thumb.png] rom.bin recipe.cdrm
+ *
+ * The clip starts at frame -a (default: -n frames before the end of the
+ * recording) and lasts -n frames (default 120); it goes on past the end of
+ * the recording with the game running on its own. Frames in the GIF are
+ * every GIF_STEP frames, as the page's clips (clipworker.js).
+ */
+
+#include <emscripten/emscripten.h>
+#include "harness.h"
+#include "chaos_record.h"
+#include "clip.h"
+
+#define GIF_STEP    2
+#define LZW_HSIZE   5003
+#define LZW_CODES   4096
+
+/* ======================================================================== */
+/* GIF                                                                      */
+/* ======================================================================== */
+
+typedef struct
+{
+    FILE *fp;
+    uint32 acc;
+    int acc_bits;
+    int bits;
+    uint8 block[255];
+    int block_length;
+} lzw_t;
+
+static int32 lzw_htab[LZW_HSIZE];
+static int32 lzw_codetab[LZW_HSIZE];
+
+static void put_le16(FILE *fp, int v)
+{
+    fputc(v & 0xFF, fp);
+    fputc((v >> 8) & 0xFF, fp);
+}
+
+static void lzw_flush(lzw_t *s)
+{
+    if (!s->block_length)
+        return;
+    fputc(s->block_length, s->fp);
+    fwrite(s->block, 1, s->block_length, s->fp);
+    s->block_length = 0;
+}
+
+static void lzw_emit(lzw_t *s, int code)
+{
+    s->acc |= (uint32)code << s->acc_bits;
+    s->acc_bits += s->bits;
+    while (s->acc_bits >= 8)
+    {
+        s->block[s->block_length++] = s->acc & 0xFF;
+        if (s->block_length == 255)
+            lzw_flush(s);
+        s->acc >>= 8;
+        s->acc_bits -= 8;
+    }
+}
+
+/* 8-bit codes, hashed string table as in the classic compress / GIF encoders */
+static void lzw_encode(FILE *fp, const uint8 *pixels, int count)
+{
+    const int clear_code = 256;
+    const int end_code = 257;
+    int free_code = end_code + 1;
+    int max_code = 511;
+    int ent, i;
+    lzw_t s;
+
+    memset(&s, 0, sizeof(s));
+    s.fp = fp;
+    s.bits = 9;
+    memset(lzw_htab, 0xFF, sizeof(lzw_htab));
+
+    fputc(8, fp);
+    lzw_emit(&s, clear_code);
+    ent = pixels[0];
+    for (i = 1; i < count; i++)
+    {
+        int c = pixels[i];
+        int32 fcode = (c << 12) + ent;
+        int h = (c << 4) ^ ent;
+
+        if (lzw_htab[h] >= 0)
+        {
+            int disp = h ? (LZW_HSIZE - h) : 1;
+
+            while ((lzw_htab[h] >= 0) && (lzw_htab[h] != fcode))
+            {
+                h -= disp;
+                if (h < 0)
+                    h += LZW_HSIZE;
+            }
+            if (lzw_htab[h] == fcode)
+            {
+                ent = lzw_codetab[h];
+                continue;
+            }
+        }
+
+        lzw_emit(&s, ent);
+        ent = c;
+        if (free_code < LZW_CODES)
+        {
+            /* the decoder adds a code per code read, one behind: widen once it has
+               the code that no longer fits */
+            if (free_code > max_code)
+            {
+                s.bits++;
+                max_code = (1 << s.bits) - 1;
+            }
+            lzw_codetab[h] = free_code++;
+            lzw_htab[h] = fcode;
+        }
+        else
+        {
+            lzw_emit(&s, clear_code);
+            memset(lzw_htab, 0xFF, sizeof(lzw_htab));
+            free_code = end_code + 1;
+            s.bits = 9;
+            max_code = 511;
+        }
+    }
+    lzw_emit(&s, ent);
+    if (free_code > max_code && free_code < LZW_CODES)
+        s.bits++;
+    lzw_emit(&s, end_code);
+    if (s.acc_bits > 0)
+        s.block[s.block_length++] = s.acc & 0xFF;
+    lzw_flush(&s);
+    fputc(0, fp);
+}
+
+/* top left w x h of the active area of the clip frame, packed */
+static uint8 *clip_area(const clip_info_t *info, int w, int h)
+{
+    uint8 *pixels = malloc(w * h);
+    int y;
+
+    if (!pixels)
+        return NULL;
+    for (y = 0; y < h; y++)
+        memcpy(pixels + y * w, clip_pixels() + (info->y + y) * clip_pitch() + info->x, w);
+    return pixels;
+}
+
+static void gif_begin(FILE *fp, int width, int height)
+{
+    fwrite("GIF89a", 1, 6, fp);
+    put_le16(fp, width);
+    put_le16(fp, height);
+    fputc(0, fp);
+    fputc(0, fp);
+    fputc(0, fp);
+    /* loop forever */
+    fputc(0x21, fp);
+    fputc(0xFF, fp);
+    fputc(11, fp);
+    fwrite("NETSCAPE2.0", 1, 11, fp);
+    fputc(3, fp);
+    fputc(1, fp);
+    put_le16(fp, 0);
+    fputc(0, fp);
+}
+
+/* frames larger than the first one are cropped to it */
+static int gif_frame(FILE *fp, const clip_info_t *info, int width, int height, int delay)
+{
+    int w = (info->w < width) ? info->w : width;
+    int h = (info->h < height) ? info->h : height;
+    uint8 *pixels = clip_area(info, w, h);
+    int c;
+
+    if (!pixels)
+        return 0;
+
+    fputc(0x21, fp);
+    fputc(0xF9, fp);
+    fputc(4, fp);
+    fputc(((w < width) || (h < height)) ? 0x08 : 0x04, fp);
+    put_le16(fp, delay);
+    fputc(0, fp);
+    fputc(0, fp);
+
+    fputc(0x2C, fp);
+    put_le16(fp, 0);
+    put_le16(fp, 0);
+    put_le16(fp, w);
+    put_le16(fp, h);
+    fputc(0x87, fp);    /* 256 colour local table */
+    for (c = 0; c < CLIP_PALETTE_SIZE; c++)
+    {
+        fputc((info->palette[c] >> 16) & 0xFF, fp);
+        fputc((info->palette[c] >> 8) & 0xFF, fp);
+        fputc(info->palette[c] & 0xFF, fp);
+    }
+    lzw_encode(fp, pixels, w * h);
+
+    free(pixels);
+    return 1;
+}
+
+/* ======================================================================== */
+/* PNG                                                                      */
+/* ======================================================================== */
+
+static void put_be32(uint8 *p, uint32 v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void write_chunk(FILE *fp, const char *type, const uint8 *data, uint32 len)
+{
+    uint8 buf[4];
+    unsigned long crc = crc32(0, (const unsigned char *)type, 4);
+
+    put_be32(buf, len);
+    fwrite(buf, 1, 4, fp);
+    fwrite(type, 1, 4, fp);
+    fwrite(data, 1, len, fp);
+    if (len)
+        crc = crc32(crc, data, len);
+    put_be32(buf, (uint32)crc);
+    fwrite(buf, 1, 4, fp);
+}
+
+/* 8-bit indexed, the pixel data in stored deflate blocks as farm.c does */
+static int write_png(const char *path, const clip_info_t *info)
+{
+    static const uint8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    uint8 header[13] = {0};
+    uint8 palette[3 * CLIP_PALETTE_SIZE];
+    uint8 *pixels, *raw, *idat, *p;
+    uint32 raw_size, idat_size, pos, a = 1, b = 0;
+    int y, c;
+    FILE *fp;
+
+    raw_size = info->h * (1 + info->w);
+    idat_size = 2 + raw_size + 5 * ((raw_size + 0xFFFE) / 0xFFFF) + 4;
+    pixels = clip_area(info, info->w, info->h);
+    raw = malloc(raw_size);
+    idat = malloc(idat_size);
+    fp = (pixels && raw && idat) ? fopen(path, "wb") : NULL;
+    if (!fp)
+    {
+        fprintf(stderr, "render: cannot create %s\n", path);
+        free(pixels);
+        free(raw);
+        free(idat);
+        return 0;
+    }
+
+    for (y = 0, p = raw; y < info->h; y++)
+    {
+        *p++ = 0;   /* no filter */
+        memcpy(p, pixels + y * info->w, info->w);
+        p += info->w;
+    }
+
+    p = idat;
+    *p++ = 0x78;
+    *p++ = 0x01;
+    for (pos = 0; pos < raw_size; pos += 0xFFFF)
+    {
+        uint32 len = (raw_size - pos < 0xFFFF) ? (raw_size - pos) : 0xFFFF;
+        *p++ = (pos + len == raw_size);
+        *p++ = len;
+        *p++ = len >> 8;
+        *p++ = ~len;
+        *p++ = ~len >> 8;
+        memcpy(p, raw + pos, len);
+        p += len;
+    }
+    for (pos = 0; pos < raw_size; pos++)
+    {
+        a = (a + raw[pos]) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_be32(p, (b << 16) | a);
+
+    for (c = 0; c < CLIP_PALETTE_SIZE; c++)
+    {
+        palette[3 * c] = info->palette[c] >> 16;
+        palette[3 * c + 1] = info->palette[c] >> 8;
+        palette[3 * c + 2] = info->palette[c];
+    }
+
+    put_be32(header, info->w);
+    put_be32(header + 4, info->h);
+    header[8] = 8;  /* bits per index */
+    header[9] = 3;  /* palette */
+
+    fwrite(signature, 1, sizeof(signature), fp);
+    write_chunk(fp, "IHDR", header, sizeof(header));
+    write_chunk(fp, "PLTE", palette, sizeof(palette));
+    write_chunk(fp, "IDAT", idat, idat_size);
+    write_chunk(fp, "IEND", NULL, 0);
+    fclose(fp);
+
+    free(pixels);
+    free(raw);
+    free(idat);
+    return 1;
+}
+
+/* ======================================================================== */
+/* Main                                                                     */
+/* ======================================================================== */
+
+static int load_recipe(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8_t *buffer;
+    long size;
+
+    if (!fp)
+    {
+        fprintf(stderr, "render: cannot open recipe %s\n", path);
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buffer = (size > 0) ? chaos_replay_buffer((int)size) : NULL;
+    if (!buffer || (fread(buffer, 1, size, fp) != (size_t)size))
+    {
+        fprintf(stderr, "render: cannot read recipe %s\n", path);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+    return 1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_render [-a frame] [-n frames] [-o clip.gif] [-p thumb.png] rom.bin recipe.cdrm\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *rom = NULL;
+    const char *recipe = NULL;
+    const char *gif_path = "clip.gif";
+    const char *png_path = NULL;
+    int capture = -1;
+    int frames = 120;
+    int width = 0, height = 0, fps;
+    int frame, shown = 0, ok = 1, i;
+    const chaos_record_header_t *header;
+    double begin, elapsed;
+    FILE *fp;
+
+    harness_name = "render";
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-a") && (i + 1 < argc))
+            capture = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && (i + 1 < argc))
+            frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && (i + 1 < argc))
+            gif_path = argv[++i];
+        else if (!strcmp(argv[i], "-p") && (i + 1 < argc))
+            png_path = argv[++i];
+        else if ((argv[i][0] != '-') && !rom)
+            rom = argv[i];
+        else if ((argv[i][0] != '-') && !recipe)
+            recipe = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!rom || !recipe || (frames < 1))
+    {
+        usage();
+        return 1;
+    }
+
+    init();
+    if (!harness_load_rom(rom))
+        return 1;
+    start();
+    if (!load_recipe(recipe))
+        return 1;
+    header = chaos_replay_header();
+    if (!header || !replay_start())
+    {
+        fprintf(stderr, "render: %s is not a recording of %s\n", recipe, rom);
+        return 1;
+    }
+    if (capture < 0)
+        capture = ((int)header->frames > frames) ? (int)header->frames - frames : 0;
+
+    begin = emscripten_get_now();
+    frame = replay_seek(capture);
+    if (frame < capture)
+    {
+        fprintf(stderr, "render: the recording ends at frame %d\n", frame);
+        return 1;
+    }
+    elapsed = emscripten_get_now() - begin;
+    fprintf(stderr, "render: frame %d reached in %.0f ms\n", frame, elapsed);
+
+    /* the clip frame is all that is drawn: no RGB conversion */
+    fps = vdp_pal ? 50 : 60;
+    set_indexed_output(1);
+    clip_enable(1);
+
+    fp = fopen(gif_path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "render: cannot create %s\n", gif_path);
+        return 1;
+    }
+
+    for (i = 0; (i < frames) && ok; i++)
+    {
+        const clip_info_t *info;
+
+        tick();
+        sound();
+        if (i % GIF_STEP)
+            continue;
+
+        info = clip_info();
+        if (!shown)
+        {
+            width = info->w;
+            height = info->h;
+            gif_begin(fp, width, height);
+            if (png_path)
+                ok = write_png(png_path, info);
+        }
+        /* delays rounded on the running time so they add up to the clip length */
+        ok = ok && gif_frame(fp, info, width, height,
+                             (shown + 1) * GIF_STEP * 100 / fps - shown * GIF_STEP * 100 / fps);
+        shown++;
+    }
+    fputc(0x3B, fp);
+    fclose(fp);
+
+    elapsed = emscripten_get_now() - begin;
+    fprintf(stderr, "render: %d frames from %d, %d in %s, %.0f ms\n", frames, capture, shown, gif_path, elapsed);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+/**
+ * ChaosDrive - VGM sound chip harness
+ *
+ * Replays the YM2612 and PSG writes of a VGM file (as written by bench -v or
+ * the page's capture, or any Mega Drive VGM) straight into fm_write() and
+ * psg_write(), at the master clock time of each write, and renders the
+ * output through sound_update() and the blip buffers like a frame of the
+ * emulator would. Nothing else of the machine runs, so the figures are the
+ * cost of the sound path alone and the PCM CRC changes only with it.
+ *
+ *   genplus_vgm [-t seconds] [-y mame|nuked] [-g golden.txt | -G golden.txt]
+ *               in.vgm
+ *
+ * Frames are 1/60 s of NTSC master clocks; a file that ends before
+ * 'seconds' (60 by default) restarts at its loop point, or ends the run
+ * when it has none. -y picks the YM2612 core (config.ym3438). -g / -G
+ * compare with / record a golden file of per-frame audio CRCs (harness.h).
+ *
+ * Supported commands: 0x50 PSG, 0x52 / 0x53 YM2612, waits, 0x67 PCM data
+ * blocks with 0x8n DAC writes and 0xE0 seeks. Other chips are skipped;
+ * compressed .vgz files have to be gunzipped first.
+ */
+
+#include <emscripten/emscripten.h>
+#include "harness.h"
+
+#define VGM_RATE        44100
+#define VGM_HEADER_SIZE 0x40
+#define VGM_FRAME_CLOCKS (MCYCLES_PER_LINE * 262)
+#define VGM_FRAME_SAMPLES 2048 /* stereo pairs, a frame is 735 */
+
+static uint8 *vgm;
+static uint32 vgm_size;
+static uint32 data_start;
+static uint32 loop_start;
+
+/* YM2612 PCM data bank (0x67 blocks) and DAC stream position (0xE0) */
+static const uint8 *pcm;
+static uint32 pcm_size;
+static uint32 pcm_pos;
+
+static uint32 get32(const uint8 *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+static int load_vgm(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    long size;
+
+    if (!fp)
+    {
+        fprintf(stderr, "%s: cannot open %s\n", harness_name, path);
+        return 0;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    vgm = (size > VGM_HEADER_SIZE) ? malloc(size) : NULL;
+    if (!vgm || (fread(vgm, 1, size, fp) != (size_t)size) || memcmp(vgm, "Vgm ", 4))
+    {
+        fprintf(stderr, "%s: %s is not a VGM file\n", harness_name, path);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+    vgm_size = size;
+
+    /* data offset is relative to 0x34 since 1.50, 0x40 before */
+    data_start = ((get32(vgm + 0x08) >= 0x150) && get32(vgm + 0x34)) ? 0x34 + get32(vgm + 0x34) : VGM_HEADER_SIZE;
+    loop_start = get32(vgm + 0x1C) ? 0x1C + get32(vgm + 0x1C) : 0;
+    if ((data_start >= vgm_size) || (loop_start >= vgm_size))
+    {
+        fprintf(stderr, "%s: %s: bad data or loop offset\n", harness_name, path);
+        return 0;
+    }
+    return 1;
+}
+
+/* bytes following each command that is skipped */
+static int skip_length(uint8 cmd)
+{
+    if (cmd >= 0xE0) return 4;
+    if (cmd >= 0xC0) return 3;
+    if (cmd >= 0xA0) return 2;
+    if ((cmd >= 0x51) && (cmd <= 0x5F)) return 2;
+    if ((cmd >= 0x40) && (cmd <= 0x4F)) return (cmd == 0x4F) ? 1 : 2;
+    if ((cmd >= 0x30) && (cmd <= 0x3F)) return 1;
+    switch (cmd)
+    {
+        case 0x90: case 0x91: case 0x95: return 4;
+        case 0x92: return 5;
+        case 0x93: return 10;
+        case 0x94: return 1;
+    }
+    return -1;
+}
+
+/* run the commands until the next wait; returns the samples to wait, -1 at the end */
+static int play(uint32 *pos, unsigned int clocks)
+{
+    while (*pos < vgm_size)
+    {
+        const uint8 *p = vgm + *pos;
+        int length;
+
+        switch (p[0])
+        {
+            case 0x50:
+                psg_write(clocks, p[1]);
+                *pos += 2;
+                break;
+
+            case 0x52:
+            case 0x53:
+                fm_write(clocks, (p[0] & 1) << 1, p[1]);
+                fm_write(clocks, ((p[0] & 1) << 1) | 1, p[2]);
+                *pos += 3;
+                break;
+
+            case 0x61:
+                *pos += 3;
+                return p[1] | (p[2] << 8);
+
+            case 0x62:
+                *pos += 1;
+                return 735;
+
+            case 0x63:
+                *pos += 1;
+                return 882;
+
+            case 0x66:
+                return -1;
+
+            case 0x67:
+                /* 0x67 0x66 type size32: YM2612 PCM data is type 0 */
+                if (p[2] == 0x00)
+                {
+                    pcm = p + 7;
+                    pcm_size = get32(p + 3);
+                }
+                *pos += 7 + get32(p + 3);
+                break;
+
+            case 0xE0:
+                pcm_pos = get32(p + 1);
+                *pos += 5;
+                break;
+
+            default:
+                if ((p[0] & 0xF0) == 0x70)
+                {
+                    *pos += 1;
+                    return (p[0] & 0x0F) + 1;
+                }
+                if ((p[0] & 0xF0) == 0x80)
+                {
+                    fm_write(clocks, 0, 0x2A);
+                    fm_write(clocks, 1, (pcm_pos < pcm_size) ? pcm[pcm_pos] : 0x80);
+                    pcm_pos++;
+                    *pos += 1;
+                    if (p[0] & 0x0F)
+                        return p[0] & 0x0F;
+                    break;
+                }
+                length = skip_length(p[0]);
+                if (length < 0)
+                {
+                    fprintf(stderr, "%s: unknown command %02x at %x\n", harness_name, p[0], *pos);
+                    return -1;
+                }
+                *pos += 1 + length;
+                break;
+        }
+    }
+    return -1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_vgm [-t seconds] [-y mame|nuked] [-g golden.txt | -G golden.txt] in.vgm\n");
+}
+
+int main(int argc, char **argv)
+{
+    static int16 buffer[VGM_FRAME_SAMPLES * 2];
+    const char *path = NULL;
+    const char *golden = NULL;
+    int golden_record = 0;
+    int golden_diffs = 0;
+    char golden_header[256];
+    int seconds = 60;
+    int nuked = 0;
+    int frames, frame, samples;
+    uint64_t total = 0;
+    uint64_t now = 0;       /* master clocks since the start */
+    uint64_t next = 0;      /* time of the next command */
+    uint32 pos;
+    unsigned long crc = 0;
+    double begin, elapsed;
+    int i;
+
+    harness_name = "vgm";
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-t") && (i + 1 < argc))
+            seconds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-y") && (i + 1 < argc))
+        {
+            ++i;
+            if (!strcmp(argv[i], "nuked"))
+                nuked = 1;
+            else if (strcmp(argv[i], "mame"))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if ((!strcmp(argv[i], "-g") || !strcmp(argv[i], "-G")) && (i + 1 < argc))
+        {
+            golden_record = (argv[i][1] == 'G');
+            golden = argv[++i];
+        }
+        else if ((argv[i][0] != '-') && !path)
+            path = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!path || (seconds < 1))
+    {
+        usage();
+        return 1;
+    }
+#ifndef HAVE_YM3438_CORE
+    if (nuked)
+    {
+        fprintf(stderr, "vgm: built without the Nuked OPN2 core\n");
+        return 1;
+    }
+#endif
+
+    if (!load_vgm(path))
+        return 1;
+
+    /* a Mega Drive with nothing but its sound chips */
+    set_config_defaults();
+    config.ym3438 = nuked;
+    system_hw = SYSTEM_MD;
+    system_clock = MCLOCK_NTSC;
+    vdp_pal = 0;
+    sound_init();
+    if (audio_init(VGM_RATE, 0) < 0)
+        return 1;
+    sound_reset();
+
+    snprintf(golden_header, sizeof(golden_header), "genplus_vgm %s crc %08lx seconds %d -y %s",
+             path, crc32(0, vgm, vgm_size) & 0xffffffffUL, seconds, nuked ? "nuked" : "mame");
+    if (golden && !harness_golden_open(golden, golden_record, golden_header))
+        return 1;
+
+    frames = seconds * 60;
+    pos = data_start;
+    begin = emscripten_get_now();
+    for (frame = 0; frame < frames; frame++)
+    {
+        uint64_t end = now + VGM_FRAME_CLOCKS;
+
+        while (next < end)
+        {
+            int wait = play(&pos, (unsigned int)(next - now));
+
+            if (wait < 0)
+            {
+                if (!loop_start)
+                    break;
+                pos = loop_start;
+                continue;
+            }
+            next += (uint64_t)wait * system_clock / VGM_RATE;
+        }
+        if ((next < end) && !loop_start)
+            break;
+
+        mcycles_vdp = VGM_FRAME_CLOCKS;
+        samples = audio_update(buffer);
+        crc = crc32(crc, (const unsigned char *)buffer, samples * 2 * sizeof(int16));
+        harness_golden_frame(frame + 1, NULL, 0, buffer, NULL, samples * 2 * sizeof(int16));
+        total += samples;
+        now = end;
+    }
+    elapsed = emscripten_get_now() - begin;
+    golden_diffs = harness_golden_close();
+
+    printf("vgm:          %s\n", path);
+    printf("ym2612 core:  %s\n", nuked ? "nuked" : "mame");
+    printf("frames:       %d\n", frame);
+    printf("time:         %.3f s\n", elapsed / 1000.0);
+    printf("samples/sec:  %.0f (%.1fx real time)\n", total * 1000.0 / elapsed, frame * 1000.0 / 60 / elapsed);
+    printf("pcm crc32:    %08lx\n", crc & 0xffffffffUL);
+    if (golden)
+    {
+        if (golden_record)
+            printf("golden:       %s\n", golden_diffs ? "write error" : "recorded");
+        else if (golden_diffs)
+            printf("golden:       %d frames differ\n", golden_diffs);
+        else
+            printf("golden:       identical\n");
+    }
+
+    return golden_diffs ? 1 : 0;
+}
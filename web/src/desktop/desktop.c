@@ -0,0 +1,528 @@
+/**
+ * ChaosDrive - SDL3 desktop front end
+ *
+ * Runs the web core (wasm.c front-end, same chaos queue and bindings as the
+ * page) natively, on three threads:
+ *
+ *   main        SDL events and presentation: takes the newest frame of the
+ *               triple buffer, uploads it to a streaming texture and
+ *               presents with vsync
+ *   emulation   the only thread calling into the core: consumes the
+ *               commands, runs a frame, writes its samples to the audio
+ *               ring and publishes the frame; paced by the audio ring
+ *               (LATENCY_FRAMES of samples ahead), or by the clock without
+ *               an audio device
+ *   audio       SDL's device thread, draining the ring from the stream
+ *               callback
+ *
+ * See pipeline.h for the hand-over. The emulation thread never waits for the
+ * display and the display never waits for a frame: a slow vsync drops frames,
+ * a fast one presents a frame twice.
+ *
+ *   genplus_desktop [-s seed] [-c script] [-x scale] [-i off|ram|vdp]
+ *                   [-n composite|svideo|rgb|mono] [-l] rom.bin
+ *
+ * The options are the benchmark harness's (bench.c), the script runs from
+ * the first frame. Keys are the page's: arrows, A/S/D for A/B/C, Enter for
+ * Start, the chaos keys of index.js, Tab restarts the game and Escape quits.
+ * CHAOS_PROFILE builds print the per-subsystem time every PROFILE_FRAMES
+ * frames; the session telemetry (telemetry.h) is printed on exit.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <emscripten/emscripten.h>
+#include "harness.h"
+#include "chaos.h"
+#include "chaos_rand.h"
+#include "chaos_queue.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "pipeline.h"
+
+#define DESKTOP_RATE   44100
+/* frames of samples the emulation keeps ahead of the audio device */
+#define LATENCY_FRAMES 3
+/* without audio: the clock is reset rather than caught up past this */
+#define BEHIND_FRAMES  4
+#define PROFILE_FRAMES 60
+
+typedef struct
+{
+    SDL_Scancode key;
+    const char *effect;
+    float intensity;
+} desktop_binding_t;
+
+/* index.js chaosBindings, once per press */
+static const desktop_binding_t bindings[] =
+{
+    { SDL_SCANCODE_Q,            "corrupt_vsram",              1.0f },
+    { SDL_SCANCODE_W,            "hscroll_waviness",           1.0f },
+    { SDL_SCANCODE_E,            "flip_vdp_mode",              1.0f },
+    { SDL_SCANCODE_Z,            "psg_noise_blast",            1.0f },
+    { SDL_SCANCODE_O,            "shift_vram_up",              1.0f },
+    { SDL_SCANCODE_L,            "shift_vram_down",            1.0f },
+    { SDL_SCANCODE_K,            "shift_vram_left",            1.0f },
+    { SDL_SCANCODE_SEMICOLON,    "shift_vram_right",           1.0f },
+    { SDL_SCANCODE_I,            "shift_vram_down_random",     1.0f },
+    { SDL_SCANCODE_P,            "corrupt_vram_one_byte",      1.0f },
+    { SDL_SCANCODE_BACKSLASH,    "invert_vram",                1.0f },
+    { SDL_SCANCODE_LEFTBRACKET,  "randomize_cram",             1.0f },
+    { SDL_SCANCODE_RIGHTBRACKET, "shift_cram_up",              1.0f },
+    { SDL_SCANCODE_Y,            "cram_corruption",            1.0f },
+    { SDL_SCANCODE_U,            "cram_corruption",            0.0f },
+    { SDL_SCANCODE_R,            "scroll_register_fuzzing",    1.0f },
+    { SDL_SCANCODE_T,            "sprite_attribute_scramble",  1.0f },
+    { SDL_SCANCODE_X,            "fm_corruption",              1.0f },
+    { SDL_SCANCODE_C,            "fm_corruption",              0.0f },
+    { SDL_SCANCODE_V,            "corrupt_dac_data",           1.0f },
+    { SDL_SCANCODE_B,            "bitcrush_audio_memory",      1.0f },
+    { SDL_SCANCODE_N,            "detune_fm_registers",        1.0f },
+    { SDL_SCANCODE_COMMA,        "shift_audio_memory_up",      1.0f },
+    { SDL_SCANCODE_PERIOD,       "shift_audio_memory_down",    1.0f },
+    { SDL_SCANCODE_F,            "corrupt_68k_ram_one_byte",   1.0f },
+    { SDL_SCANCODE_G,            "critical_ram_scramble",      1.0f },
+    { SDL_SCANCODE_H,            "program_counter_increment",  1.0f },
+    { SDL_SCANCODE_J,            "random_register_corruption", 1.0f },
+    { SDL_SCANCODE_SLASH,        "flip_game_logic_variables",  1.0f },
+};
+
+/* input.js keyBits */
+static const struct { SDL_Scancode key; uint32_t bit; } pad_keys[] =
+{
+    { SDL_SCANCODE_UP,     INPUT_UP },
+    { SDL_SCANCODE_DOWN,   INPUT_DOWN },
+    { SDL_SCANCODE_LEFT,   INPUT_LEFT },
+    { SDL_SCANCODE_RIGHT,  INPUT_RIGHT },
+    { SDL_SCANCODE_A,      INPUT_A },
+    { SDL_SCANCODE_S,      INPUT_B },
+    { SDL_SCANCODE_D,      INPUT_C },
+    { SDL_SCANCODE_RETURN, INPUT_START },
+};
+
+static pipeline_audio_t audio_ring;
+static pipeline_triple_t frames;
+static pipeline_commands_t commands;
+static _Atomic int running = 1;
+
+/* set before the emulation thread starts */
+static int scale = 2;
+static int audio_open;
+static uint32_t audio_latency;
+
+/* audio callback: only primed once the latency built up again after running dry */
+static void SDLCALL audio_callback(void *userdata, SDL_AudioStream *stream, int additional, int total)
+{
+    static int primed;
+    float buf[512 * 2];
+    int wanted = additional / (int)(2 * sizeof(float));
+
+    if (!primed && (pipeline_audio_fill(&audio_ring) < audio_latency))
+        return;
+    while (wanted > 0)
+    {
+        int count = pipeline_audio_read(&audio_ring, buf, (wanted < 512) ? wanted : 512, audio_latency);
+        if (!count)
+            break;
+        SDL_PutAudioStreamData(stream, buf, count * 2 * sizeof(float));
+        wanted -= count;
+    }
+    /* ran dry while playing: SDL plays silence, reported to the session telemetry */
+    if (primed && (wanted > 0))
+        atomic_fetch_add_explicit(&audio_ring.underruns, 1, memory_order_relaxed);
+    primed = (wanted <= 0);
+}
+
+static void run_command(const pipeline_cmd_t *cmd)
+{
+    if (cmd->op == PIPELINE_CMD_PAD)
+    {
+        input_bits = (int32_t)cmd->value;
+    }
+    else if (cmd->op == PIPELINE_CMD_RESTART)
+    {
+        /* the page's Tab */
+        soft_reset(0);
+    }
+    else
+    {
+        harness_submit(cmd->op, cmd->intensity, -1);
+    }
+}
+
+#ifdef CHAOS_PROFILE
+static void print_profile(const double *usec, int count)
+{
+    int i;
+
+    printf("profile:");
+    for (i = 0; i < PROF_COUNT; i++)
+    {
+        if (usec[i] >= count * 0.05)
+            printf(" %s %.0f", profile_name(i), usec[i] / count);
+    }
+    printf(" usec/frame\n");
+    fflush(stdout);
+}
+#endif
+
+static int SDLCALL emulation_main(void *data)
+{
+    const int32_t *info = get_frame_info_ref();
+    uint64_t frame_ns, next_ns = 0;
+    uint32_t frame = 0;
+    int samples;
+#ifdef CHAOS_PROFILE
+    double usec[PROF_COUNT] = {0};
+    int i;
+#endif
+
+    /* samples per frame at the running video mode */
+    samples = set_audio_rate(DESKTOP_RATE, 0);
+    frame_ns = (uint64_t)samples * SDL_NS_PER_SECOND / DESKTOP_RATE;
+
+    while (atomic_load_explicit(&running, memory_order_relaxed))
+    {
+        pipeline_frame_t *slot;
+        pipeline_cmd_t cmd;
+        int count, height, pitch;
+
+        if (audio_open)
+        {
+            if (pipeline_audio_fill(&audio_ring) >= audio_latency)
+            {
+                SDL_DelayNS(SDL_NS_PER_MS);
+                continue;
+            }
+        }
+        else
+        {
+            uint64_t now = SDL_GetTicksNS();
+            if (now < next_ns)
+            {
+                SDL_DelayPrecise(next_ns - now);
+                continue;
+            }
+            next_ns = (now - next_ns > BEHIND_FRAMES * frame_ns) ? now + frame_ns : next_ns + frame_ns;
+        }
+
+        while (pipeline_command_pop(&commands, &cmd))
+        {
+            run_command(&cmd);
+            if (cmd.op == PIPELINE_CMD_RESTART)
+            {
+                samples = set_audio_rate(DESKTOP_RATE, 0);
+                frame_ns = (uint64_t)samples * SDL_NS_PER_SECOND / DESKTOP_RATE;
+            }
+        }
+        harness_submit_events(frame);
+
+        tick();
+        count = sound();
+        if (audio_open)
+        {
+            pipeline_audio_write(&audio_ring, get_web_audio_l_ref(), get_web_audio_r_ref(), count);
+            telemetry_count(TELEMETRY_UNDERRUNS, atomic_exchange_explicit(&audio_ring.underruns, 0, memory_order_relaxed));
+        }
+
+        /* the active area, as presenter.js crops it */
+        slot = pipeline_frame_back(&frames);
+        memcpy(slot->info, info, sizeof(slot->info));
+        slot->frame = frame;
+        pitch = (HARNESS_VIDEO_WIDTH / 2) * scale * sizeof(uint32_t);
+        height = (info[3] + 2 * info[1]) * scale;
+        if (height > (HARNESS_VIDEO_HEIGHT / 2) * scale)
+            height = (HARNESS_VIDEO_HEIGHT / 2) * scale;
+        memcpy(slot->pixels, get_frame_buffer_ref(), height * pitch);
+        pipeline_frame_publish(&frames);
+        frame++;
+
+#ifdef CHAOS_PROFILE
+        for (i = 0; i < PROF_COUNT; i++)
+            usec[i] += frame_profile.usec[i];
+        if (!(frame % PROFILE_FRAMES))
+        {
+            print_profile(usec, PROFILE_FRAMES);
+            memset(usec, 0, sizeof(usec));
+        }
+#endif
+    }
+    return 0;
+}
+
+/* lower bound of a telemetry bucket in usec (telemetry.js telemetryBucketFloor) */
+static uint32_t bucket_floor(int bucket)
+{
+    return (bucket < 4) ? bucket : (uint32_t)(4 | (bucket & 3)) << ((bucket >> 2) - 1);
+}
+
+static uint32_t percentile(const uint32_t *counts, double fraction)
+{
+    uint32_t total = 0, seen = 0;
+    int b;
+
+    for (b = 0; b < TELEMETRY_BUCKETS; b++)
+        total += counts[b];
+    for (b = 0; b < TELEMETRY_BUCKETS; b++)
+    {
+        seen += counts[b];
+        if (seen && (seen >= total * fraction))
+            return bucket_floor(b);
+    }
+    return 0;
+}
+
+static void print_telemetry(void)
+{
+    static const char *const names[TELEMETRY_HISTOGRAMS] = { "run", "emulation", "render", "audio", "chaos" };
+    const telemetry_t *t = telemetry_export();
+    int i;
+
+    printf("frames:       %u (%u late, %u audio underruns)\n", t->counters[TELEMETRY_FRAMES],
+           t->counters[TELEMETRY_LATE], t->counters[TELEMETRY_UNDERRUNS]);
+    printf("\npart              p50 us     p95 us     p99 us\n");
+    for (i = 0; i < TELEMETRY_HISTOGRAMS; i++)
+    {
+        printf("%-12s %11u %10u %10u\n", names[i], percentile(t->histogram[i], 0.5),
+               percentile(t->histogram[i], 0.95), percentile(t->histogram[i], 0.99));
+    }
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: genplus_desktop [-s seed] [-c script] [-x scale] [-i off|ram|vdp] [-n composite|svideo|rgb|mono] [-l] rom.bin\n");
+}
+
+static void send_pad(uint32_t bits)
+{
+    pipeline_cmd_t cmd = { PIPELINE_CMD_PAD, 0.0f, bits };
+    pipeline_command_push(&commands, &cmd);
+}
+
+int main(int argc, char **argv)
+{
+    const char *rom = NULL;
+    const char *script_path = NULL;
+    int idle = -1;
+    int ntsc = 0;
+    int line_cache = 0;
+    uint32 seed = 0;
+    uint32_t pad = 0;
+    int effects[sizeof(bindings) / sizeof(bindings[0])];
+    int width, height, shown_w = 0, shown_h = 0;
+    SDL_Window *window;
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    SDL_AudioStream *stream = NULL;
+    SDL_Thread *thread;
+    SDL_AudioSpec spec;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-s") && (i + 1 < argc))
+            seed = (uint32)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-c") && (i + 1 < argc))
+            script_path = argv[++i];
+        else if (!strcmp(argv[i], "-x") && (i + 1 < argc))
+            scale = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-l"))
+            line_cache = 1;
+        else if (!strcmp(argv[i], "-i") && (i + 1 < argc))
+        {
+            static const char *const modes[] = { "off", "ram", "vdp" };
+            for (++i, idle = 2; (idle >= 0) && strcmp(argv[i], modes[idle]); idle--);
+            if (idle < 0)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "-n") && (i + 1 < argc))
+        {
+            static const char *const modes[] = { "", "composite", "svideo", "rgb", "mono" };
+            for (++i, ntsc = 4; (ntsc > 0) && strcmp(argv[i], modes[ntsc]); ntsc--);
+            if (!ntsc)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if ((argv[i][0] != '-') && !rom)
+            rom = argv[i];
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (!rom || (scale < 1) || (scale > 4))
+    {
+        usage();
+        return 1;
+    }
+
+    harness_name = "desktop";
+    init();
+    chaos_seed(seed);
+    for (i = 0; i < (int)(sizeof(bindings) / sizeof(bindings[0])); i++)
+        effects[i] = harness_effect_id(bindings[i].effect);
+
+    if (script_path && !harness_load_script(script_path))
+        return 1;
+    if (!harness_load_rom(rom))
+        return 1;
+
+    if (idle >= 0)
+        set_idle_skip(idle);
+    if (ntsc && !set_ntsc(ntsc))
+        return 1;
+    if (line_cache)
+        set_line_cache(1);
+    set_output_scale(scale);
+    set_audio_rate(DESKTOP_RATE, 0);
+    start();
+    telemetry_reset();
+
+    if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO))
+    {
+        fprintf(stderr, "desktop: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    width = (HARNESS_VIDEO_WIDTH / 2) * scale;
+    height = (HARNESS_VIDEO_HEIGHT / 2) * scale;
+    if (!SDL_CreateWindowAndRenderer("ChaosDrive", (HARNESS_VIDEO_WIDTH / 2) * 3, (HARNESS_VIDEO_HEIGHT / 2) * 3,
+                                     SDL_WINDOW_RESIZABLE, &window, &renderer) ||
+        !(texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_XRGB8888, SDL_TEXTUREACCESS_STREAMING, width, height)))
+    {
+        fprintf(stderr, "desktop: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetRenderVSync(renderer, 1);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+    for (i = 0; i < 3; i++)
+    {
+        frames.slot[i].pixels = calloc(width * height, sizeof(uint32_t));
+        if (!frames.slot[i].pixels)
+            return 1;
+    }
+    frames.back = 0;
+    frames.middle = 1;
+    frames.front = 2;
+
+    /* without a device the emulation runs on the clock */
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = 2;
+    spec.freq = DESKTOP_RATE;
+    audio_latency = (uint32_t)set_audio_rate(DESKTOP_RATE, 0) * LATENCY_FRAMES;
+    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, audio_callback, NULL);
+    audio_open = (stream != NULL);
+    if (!audio_open)
+        fprintf(stderr, "desktop: no audio (%s), paced by the clock\n", SDL_GetError());
+
+    thread = SDL_CreateThread(emulation_main, "emulation", NULL);
+    if (!thread)
+    {
+        fprintf(stderr, "desktop: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    if (audio_open)
+        SDL_ResumeAudioStreamDevice(stream);
+
+    while (atomic_load_explicit(&running, memory_order_relaxed))
+    {
+        pipeline_frame_t *frame;
+        SDL_Event event;
+
+        while (SDL_PollEvent(&event))
+        {
+            if (event.type == SDL_EVENT_QUIT)
+            {
+                atomic_store(&running, 0);
+            }
+            else if ((event.type == SDL_EVENT_KEY_DOWN) || (event.type == SDL_EVENT_KEY_UP))
+            {
+                int down = (event.type == SDL_EVENT_KEY_DOWN);
+                uint32_t bits = pad;
+
+                for (i = 0; i < (int)(sizeof(pad_keys) / sizeof(pad_keys[0])); i++)
+                {
+                    if (event.key.scancode == pad_keys[i].key)
+                        bits = down ? (bits | pad_keys[i].bit) : (bits & ~pad_keys[i].bit);
+                }
+                if (bits != pad)
+                    send_pad(pad = bits);
+
+                if (!down || event.key.repeat)
+                    continue;
+                if (event.key.scancode == SDL_SCANCODE_ESCAPE)
+                {
+                    atomic_store(&running, 0);
+                }
+                else if (event.key.scancode == SDL_SCANCODE_TAB)
+                {
+                    pipeline_cmd_t cmd = { PIPELINE_CMD_RESTART, 0.0f, 0 };
+                    pipeline_command_push(&commands, &cmd);
+                }
+                for (i = 0; i < (int)(sizeof(bindings) / sizeof(bindings[0])); i++)
+                {
+                    if ((event.key.scancode == bindings[i].key) && (effects[i] >= 0))
+                    {
+                        pipeline_cmd_t cmd = { effects[i], bindings[i].intensity, 0 };
+                        pipeline_command_push(&commands, &cmd);
+                    }
+                }
+            }
+        }
+
+        frame = pipeline_frame_take(&frames);
+        if (frame)
+        {
+            int w = (frame->info[2] + 2 * frame->info[0]) * scale;
+            int h = (frame->info[3] + 2 * frame->info[1]) * scale;
+            SDL_Rect rect;
+
+            rect.x = 0;
+            rect.y = 0;
+            rect.w = (w < width) ? w : width;
+            rect.h = (h < height) ? h : height;
+            SDL_UpdateTexture(texture, &rect, frame->pixels, width * sizeof(uint32_t));
+            if ((rect.w != shown_w) || (rect.h != shown_h))
+            {
+                shown_w = rect.w;
+                shown_h = rect.h;
+                SDL_SetRenderLogicalPresentation(renderer, shown_w, shown_h, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+            }
+        }
+
+        if (shown_w)
+        {
+            SDL_FRect source = { 0.0f, 0.0f, (float)shown_w, (float)shown_h };
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            SDL_RenderTexture(renderer, texture, &source, NULL);
+            SDL_RenderPresent(renderer);
+        }
+        else
+        {
+            SDL_Delay(1);
+        }
+    }
+
+    SDL_WaitThread(thread, NULL);
+    if (stream)
+        SDL_DestroyAudioStream(stream);
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    print_telemetry();
+    return 0;
+}
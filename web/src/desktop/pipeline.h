@@ -0,0 +1,177 @@
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+/* Hand-over between the desktop front end's threads (desktop.c).
+ *
+ * The emulation thread is the only one calling into the core. It produces
+ * into three lock-free structures, each with exactly one consumer:
+ *
+ *   audio ring    interleaved stereo float samples, read by the audio
+ *                 device callback (the same ring as audio.js, native)
+ *   frame triple  three frame buffers: the emulation thread fills the back
+ *                 one and swaps it with the middle one, the presentation
+ *                 thread swaps the middle one with the front one when it
+ *                 holds a newer frame; neither side ever waits
+ *   command ring  the other way round: chaos commands and pad changes from
+ *                 the presentation thread (SDL events), consumed before
+ *                 each frame
+ *
+ * Counters are free running uint32; a side only writes its own counter, with
+ * release ordering after the data and acquire ordering on the other's.
+ */
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PIPELINE_AUDIO_FRAMES    8192 /* must be a power of 2 (~186ms at 44.1kHz) */
+#define PIPELINE_COMMANDS        64   /* must be a power of 2 */
+
+typedef struct
+{
+    _Atomic uint32_t write;
+    _Atomic uint32_t read;
+    _Atomic uint32_t underruns;
+    float data[PIPELINE_AUDIO_FRAMES * 2];
+} pipeline_audio_t;
+
+/* samples in the ring */
+static inline uint32_t pipeline_audio_fill(pipeline_audio_t *ring)
+{
+    return atomic_load_explicit(&ring->write, memory_order_acquire) -
+           atomic_load_explicit(&ring->read, memory_order_acquire);
+}
+
+/* producer: appends 'count' samples of each channel, the ones that do not
+ * fit are dropped; returns the number written */
+static inline int pipeline_audio_write(pipeline_audio_t *ring, const float *l, const float *r, int count)
+{
+    uint32_t w = atomic_load_explicit(&ring->write, memory_order_relaxed);
+    uint32_t room = PIPELINE_AUDIO_FRAMES - (w - atomic_load_explicit(&ring->read, memory_order_acquire));
+    int i;
+
+    if ((uint32_t)count > room)
+        count = room;
+    for (i = 0; i < count; i++, w++)
+    {
+        float *p = &ring->data[(w & (PIPELINE_AUDIO_FRAMES - 1)) * 2];
+        p[0] = l[i];
+        p[1] = r[i];
+    }
+    atomic_store_explicit(&ring->write, w, memory_order_release);
+    return count;
+}
+
+/* consumer: up to 'count' interleaved samples into 'out'; returns the number
+ * read. A producer more than 'keep' * 2 samples ahead (the device stalled)
+ * is caught up to 'keep' first */
+static inline int pipeline_audio_read(pipeline_audio_t *ring, float *out, int count, uint32_t keep)
+{
+    uint32_t w = atomic_load_explicit(&ring->write, memory_order_acquire);
+    uint32_t r = atomic_load_explicit(&ring->read, memory_order_relaxed);
+    uint32_t first;
+    int i;
+
+    if (w - r > keep * 2)
+        r = w - keep;
+    if ((uint32_t)count > w - r)
+        count = w - r;
+    /* at most two runs around the end of the ring */
+    first = PIPELINE_AUDIO_FRAMES - (r & (PIPELINE_AUDIO_FRAMES - 1));
+    for (i = 0; i < count; )
+    {
+        int run = ((uint32_t)(count - i) < first) ? count - i : (int)first;
+        memcpy(out + i * 2, &ring->data[(r & (PIPELINE_AUDIO_FRAMES - 1)) * 2], run * 2 * sizeof(float));
+        i += run;
+        r += run;
+        first = PIPELINE_AUDIO_FRAMES;
+    }
+    atomic_store_explicit(&ring->read, r, memory_order_release);
+    return count;
+}
+
+/* frame triple buffer: 'middle' holds the slot index, with PIPELINE_FRESH
+ * set until the consumer took it */
+#define PIPELINE_FRESH 4
+
+typedef struct
+{
+    uint32_t *pixels;
+    int32_t info[4];    /* viewport x, y, w, h (frame_info) */
+    uint32_t frame;
+} pipeline_frame_t;
+
+typedef struct
+{
+    pipeline_frame_t slot[3];
+    int back;                   /* producer's */
+    int front;                  /* consumer's */
+    _Atomic int middle;
+} pipeline_triple_t;
+
+/* producer: the slot to fill */
+static inline pipeline_frame_t *pipeline_frame_back(pipeline_triple_t *triple)
+{
+    return &triple->slot[triple->back];
+}
+
+/* producer: the back slot is complete, it becomes the newest frame (an
+ * older one the consumer did not take is reused) */
+static inline void pipeline_frame_publish(pipeline_triple_t *triple)
+{
+    triple->back = atomic_exchange_explicit(&triple->middle, triple->back | PIPELINE_FRESH, memory_order_acq_rel) & 3;
+}
+
+/* consumer: the newest frame, or NULL when there was none since the last call */
+static inline pipeline_frame_t *pipeline_frame_take(pipeline_triple_t *triple)
+{
+    if (!(atomic_load_explicit(&triple->middle, memory_order_relaxed) & PIPELINE_FRESH))
+        return NULL;
+    triple->front = atomic_exchange_explicit(&triple->middle, triple->front, memory_order_acq_rel) & 3;
+    return &triple->slot[triple->front];
+}
+
+/* commands: a chaos registry id (or one of the PIPELINE_CMD_* below) and
+ * its intensity */
+#define PIPELINE_CMD_PAD     -1 /* 'value' holds the pad bits */
+#define PIPELINE_CMD_RESTART -2 /* restart the game, chaos back to defaults */
+
+typedef struct
+{
+    int op;
+    float intensity;
+    uint32_t value;
+} pipeline_cmd_t;
+
+typedef struct
+{
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    pipeline_cmd_t cmd[PIPELINE_COMMANDS];
+} pipeline_commands_t;
+
+/* producer: 0 when the ring is full (the command is dropped) */
+static inline int pipeline_command_push(pipeline_commands_t *ring, const pipeline_cmd_t *cmd)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= PIPELINE_COMMANDS)
+        return 0;
+    ring->cmd[head & (PIPELINE_COMMANDS - 1)] = *cmd;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return 1;
+}
+
+/* consumer: 0 when there is none */
+static inline int pipeline_command_pop(pipeline_commands_t *ring, pipeline_cmd_t *cmd)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    if (tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+        return 0;
+    *cmd = ring->cmd[tail & (PIPELINE_COMMANDS - 1)];
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+#endif /* _PIPELINE_H_ */
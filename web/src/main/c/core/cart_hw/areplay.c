@@ -211,6 +211,7 @@ void areplay_set_status(int status)
           *(uint16 *)(cart.rom + action_replay.addr[1]) = action_replay.old[1];
           *(uint16 *)(cart.rom + action_replay.addr[2]) = action_replay.old[2];
           *(uint16 *)(cart.rom + action_replay.addr[3]) = action_replay.old[3];
+          m68k_cache_flush();
         }
         break;
       }
@@ -243,6 +244,7 @@ void areplay_set_status(int status)
           *(uint16 *)(cart.rom + action_replay.addr[1]) = action_replay.data[1];
           *(uint16 *)(cart.rom + action_replay.addr[2]) = action_replay.data[2];
           *(uint16 *)(cart.rom + action_replay.addr[3]) = action_replay.data[3];
+          m68k_cache_flush();
         }
         break;
       }
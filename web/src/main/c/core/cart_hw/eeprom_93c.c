@@ -117,6 +117,7 @@ void eeprom_93c_write(unsigned char data)
                 if (eeprom_93c.we)
                 {
                   *(uint16 *)(sram.sram + ((eeprom_93c.opcode & 0x3F) << 1)) = 0xFFFF;
+                  SRAM_DIRTY(0);
                 }
 
                 /* wait for next command */
@@ -144,6 +145,7 @@ void eeprom_93c_write(unsigned char data)
                     if (eeprom_93c.we)
                     {
                       memset(sram.sram, 0xFF, 128);
+                      SRAM_DIRTY(0);
                     }
 
                     /* wait for next command */
@@ -183,6 +185,7 @@ void eeprom_93c_write(unsigned char data)
               {
                 /* write one word */
                 *(uint16 *)(sram.sram + ((eeprom_93c.opcode & 0x3F) << 1)) = eeprom_93c.buffer;
+                SRAM_DIRTY(0);
               }
               else
               {
@@ -193,6 +196,7 @@ void eeprom_93c_write(unsigned char data)
                   *(uint16 *)(sram.sram + (i << 1)) = eeprom_93c.buffer;
 
                 }
+                SRAM_DIRTY(0);
               }
             }
 
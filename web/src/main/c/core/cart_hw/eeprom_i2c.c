@@ -576,6 +576,7 @@ static void eeprom_i2c_update(void)
         {
           /* write back to memory array (max 64kB) */
           sram.sram[(eeprom_i2c.device_address | eeprom_i2c.word_address) & 0xffff] = eeprom_i2c.buffer;
+          SRAM_DIRTY((eeprom_i2c.device_address | eeprom_i2c.word_address) & 0xffff);
           
           /* clear write buffer */
           eeprom_i2c.buffer = 0;
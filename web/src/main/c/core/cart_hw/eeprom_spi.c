@@ -265,6 +265,7 @@ void eeprom_spi_write(unsigned char data)
                       if (spi_eeprom.addr < 0xC000)
                       {
                         sram.sram[spi_eeprom.addr] = spi_eeprom.buffer;
+                        SRAM_DIRTY(spi_eeprom.addr);
                       }
                       break;
                     }
@@ -275,6 +276,7 @@ void eeprom_spi_write(unsigned char data)
                       if (spi_eeprom.addr < 0x8000)
                       {
                         sram.sram[spi_eeprom.addr] = spi_eeprom.buffer;
+                        SRAM_DIRTY(spi_eeprom.addr);
                       }
                       break;
                     }
@@ -289,6 +291,7 @@ void eeprom_spi_write(unsigned char data)
                     {
                       /* no sectors protected */
                       sram.sram[spi_eeprom.addr] = spi_eeprom.buffer;
+                      SRAM_DIRTY(spi_eeprom.addr);
                       break;
                     }
                   }
@@ -154,6 +154,9 @@ void ggenie_switch(int enable)
       }
     }
   }
+
+  /* patched instructions must be decoded again */
+  m68k_cache_flush();
 }
 
 static unsigned int ggenie_read_byte(unsigned int address)
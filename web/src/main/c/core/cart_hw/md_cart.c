@@ -899,6 +899,7 @@ int md_cart_context_load(uint8 *state)
     load_param(svp->iram_rom, 0x800);
     load_param(svp->dram,sizeof(svp->dram));
     load_param(&svp->ssp1601,sizeof(ssp1601_t));
+    ssp1601_invalidate();
   }
 
   return bufferptr;
@@ -1618,6 +1619,9 @@ static void mapper_seganet_w(uint32 address, uint32 data)
         m68k.memory_map[i].write16  = NULL;
         zbank_memory_map[i].write   = NULL;
       }
+
+      /* writable ROM is not cached (see m68k_cache_set_rom) */
+      m68k_cache_flush();
     }
   }
 }
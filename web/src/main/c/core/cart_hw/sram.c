@@ -227,9 +227,11 @@ unsigned int sram_read_word(unsigned int address)
 void sram_write_byte(unsigned int address, unsigned int data)
 {
   sram.sram[address & 0xffff] = data;
+  SRAM_DIRTY(address & 0xffff);
 }
 
 void sram_write_word(unsigned int address, unsigned int data)
 {
   WRITE_WORD(sram.sram, address & 0xfffe, data);
+  SRAM_DIRTY(address & 0xfffe);
 }
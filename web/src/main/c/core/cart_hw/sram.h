@@ -48,8 +48,12 @@ typedef struct
   uint32 end;
   uint32 crc;
   uint8 *sram;
+  uint32 dirty[8];  /* 256-byte blocks written since the front-end last saved them */
 } T_SRAM;
 
+/* mark the 256-byte block of 'address' as written */
+#define SRAM_DIRTY(address) (sram.dirty[((address) >> 13) & 7] |= 1u << (((address) >> 8) & 31))
+
 /* Function prototypes */
 extern void sram_init();
 extern unsigned int sram_read_byte(unsigned int address);
@@ -343,6 +343,12 @@ static ssp1601_t *ssp = NULL;
 static unsigned short *PC;
 static int g_cycles;
 
+/* predecoded MAC runs: number of identical mpya/mpys opcodes starting at
+   each program word (0: not decoded yet), IRAM entries dropped when IRAM
+   was written since */
+static unsigned char mac_run[0x10000];
+static int iram_dirty = 0;
+
 #ifdef USE_DEBUGGER
 static int running = 0;
 static int last_iram = 0;
@@ -532,6 +538,7 @@ static u32 pm_io(int reg, int write, u32 d)
         elprintf(EL_SVP, "ssp IRAM w [%06x] %04x (inc %i)", (addr<<1)&0x7ff, d, inc >> 16);
 #endif
         ((unsigned short *)svp->iram_rom)[addr&0x3ff] = d;
+        iram_dirty = 1;
         ssp->pmac[1][reg] += inc;
       }
 #ifdef LOG_SVP
@@ -968,6 +975,84 @@ static u32 ptr2_read(int op)
   return ((unsigned short *)svp->iram_rom)[mv];
 }
 
+/* ----------------------------------------------------- */
+/* MAC runs */
+
+/* unrolled multiply-accumulate loops repeat the same mpya/mpys opcode:
+   count them once per program word */
+static int mac_run_length(unsigned int pc)
+{
+  unsigned short *code = (unsigned short *)svp->iram_rom;
+  int n = 1;
+
+  if (pc < 0x400 && iram_dirty)
+  {
+    memset(mac_run, 0, 0x400);
+    iram_dirty = 0;
+  }
+
+  if (!mac_run[pc])
+  {
+    while ((n < 0xff) && (pc + n < 0x10000) && (code[pc + n] == code[pc])) n++;
+    mac_run[pc] = n;
+  }
+
+  return mac_run[pc];
+}
+
+/* execute 'n' mpya (sub=0) or mpys (sub=1) opcodes 'op' back to back, with
+   the same result as one at a time: X, Y and A are kept in locals and ZN
+   flags are only updated from the last sum */
+static void mac_run_exec(int op, int n, int sub)
+{
+  static const signed char step[4] = { 0, 1, -1, 1 };
+  int ri = op & 3, modi = (op << 1) & 0x18;
+  int rj = (op >> 4) & 3, modj = (op >> 3) & 0x18;
+  u32 a = rA32, x = rX, y = rY, p = 0;
+
+  if ((ri < 3) && (rj < 3) && (!(rST & 7) || !((modi | modj) & 0x10)))
+  {
+    /* (ri), (ri+!), (ri-), (ri+) without modulo: plain pointer steps */
+    unsigned char pi = ssp->ptr.bank.r0[ri], pj = ssp->ptr.bank.r1[rj];
+    int si = step[modi >> 3], sj = step[modj >> 3];
+
+    while (n--)
+    {
+      int m1 = (signed short)x;
+      int m2 = (signed short)y;
+      p = (m1 * m2 * 2);
+      if (sub) a -= p;
+      else a += p;
+      x = ssp->mem.bank.RAM0[pi];
+      y = ssp->mem.bank.RAM1[pj];
+      pi += si;
+      pj += sj;
+    }
+
+    ssp->ptr.bank.r0[ri] = pi;
+    ssp->ptr.bank.r1[rj] = pj;
+  }
+  else
+  {
+    while (n--)
+    {
+      int m1 = (signed short)x;
+      int m2 = (signed short)y;
+      p = (m1 * m2 * 2);
+      if (sub) a -= p;
+      else a += p;
+      x = ptr1_read_(ri, 0, modi);
+      y = ptr1_read_(rj, 4, modj);
+    }
+  }
+
+  rP.v = p;
+  rA32 = a;
+  UPD_ACC_ZN
+  rX = x;
+  rY = y;
+}
+
 
 /* ----------------------------------------------------- */
 
@@ -979,6 +1064,15 @@ void ssp1601_reset(ssp1601_t *l_ssp)
   rPC = 0x400;
   rSTACK = 0; /* ? using ascending stack */
   rST = 0;
+
+  /* program ROM was copied again */
+  memset(mac_run, 0, sizeof(mac_run));
+  iram_dirty = 0;
+}
+
+void ssp1601_invalidate(void)
+{
+  iram_dirty = 1;
 }
 
 
@@ -1192,6 +1286,18 @@ void ssp1601_run(int cycles)
 #ifdef LOG_SVP
         if (!(op&0x100)) elprintf(EL_SVP|EL_ANOMALY, "ssp FIXME: no b bit @ %04x", GET_PPC_OFFS());
 #endif
+        if ((*PC == op) && (g_cycles > 1))
+        {
+          int n = mac_run_length(GET_PC() - 1);
+          if (n > g_cycles) n = g_cycles;
+          if (n > 1)
+          {
+            mac_run_exec(op, n, 1);
+            PC += n - 1;
+            g_cycles -= n - 1;
+            break;
+          }
+        }
         read_P(); /* update P */
         rA32 -= rP.v;  /* maybe only upper word? */
         UPD_ACC_ZN      /* there checking flags after this */
@@ -1204,6 +1310,18 @@ void ssp1601_run(int cycles)
 #ifdef LOG_SVP
         if (!(op&0x100)) elprintf(EL_SVP|EL_ANOMALY, "ssp FIXME: no b bit @ %04x", GET_PPC_OFFS());
 #endif
+        if ((*PC == op) && (g_cycles > 1))
+        {
+          int n = mac_run_length(GET_PC() - 1);
+          if (n > g_cycles) n = g_cycles;
+          if (n > 1)
+          {
+            mac_run_exec(op, n, 0);
+            PC += n - 1;
+            g_cycles -= n - 1;
+            break;
+          }
+        }
         read_P(); /* update P */
         rA32 += rP.v; /* confirmed to be 32bit */
         UPD_ACC_ZN /* ? */
@@ -76,4 +76,7 @@ typedef struct
 void ssp1601_reset(ssp1601_t *ssp);
 void ssp1601_run(int cycles);
 
+/* IRAM was written outside of the SSP (state load) */
+void ssp1601_invalidate(void);
+
 #endif
@@ -179,6 +179,47 @@ int cdc_context_load(uint8 *state)
   return bufferptr;
 }
 
+/* DMA transfer of 'words' words from CDC RAM buffer (at 'src_index') to 'dst' (at 'dst_index',
+   wrapping at 'dst_mask'): copied as blocks up to the end of either buffer, as 16-bit words
+   ('swap', big-endian format in CDC RAM buffer) or as bytes */
+void cdc_dma_copy(uint32 src_index, uint8 *dst, uint32 dst_index, uint32 dst_mask, unsigned int words, int swap)
+{
+  while (words)
+  {
+    /* contiguous words up to the end of the CDC buffer or of the destination */
+    unsigned int n = (0x4000 - src_index) >> 1;
+    if (n > ((dst_mask + 2 - dst_index) >> 1))
+    {
+      n = (dst_mask + 2 - dst_index) >> 1;
+    }
+    if (n > words)
+    {
+      n = words;
+    }
+
+    if (swap)
+    {
+      /* 16-bit words (big-endian format in CDC RAM buffer) */
+      uint16 *out = (uint16 *)(dst + dst_index);
+      const uint8 *in = cdc.ram + src_index;
+      unsigned int i;
+
+      for (i = 0; i < n; i++)
+      {
+        out[i] = READ_WORD(in, i << 1);
+      }
+    }
+    else
+    {
+      memcpy(dst + dst_index, cdc.ram + src_index, n << 1);
+    }
+
+    src_index = (src_index + (n << 1)) & 0x3ffe;
+    dst_index = (dst_index + (n << 1)) & dst_mask;
+    words -= n;
+  }
+}
+
 void cdc_dma_update(void)
 {
   /* maximal transfer length */
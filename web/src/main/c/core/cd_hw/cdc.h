@@ -53,7 +53,7 @@ typedef struct
   uint8 head[2][4];
   uint8 stat[4];
   int cycles;
-  void (*dma_w)(unsigned int words);  /* DMA transfer callback */
+  void (*dma_w)(unsigned int words);  /* DMA transfer callback (copies through cdc_dma_copy) */
   uint8 ram[0x4000 + 2352]; /* 16K external RAM (with one block overhead to handle buffer overrun) */
 } cdc_t; 
 
@@ -63,6 +63,7 @@ extern void cdc_reset(void);
 extern int cdc_context_save(uint8 *state);
 extern int cdc_context_load(uint8 *state);
 extern void cdc_dma_update(void);
+extern void cdc_dma_copy(uint32 src_index, uint8 *dst, uint32 dst_index, uint32 dst_mask, unsigned int words, int swap);
 extern void cdc_decoder_update(uint32 header);
 extern void cdc_reg_w(unsigned char data);
 extern unsigned char cdc_reg_r(void);
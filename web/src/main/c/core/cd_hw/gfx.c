@@ -43,8 +43,6 @@
 
 void word_ram_0_dma_w(unsigned int words)
 {
-  uint16 data;
-
   /* CDC buffer source address */
   uint16 src_index = cdc.dac.w & 0x3ffe;
 
@@ -58,26 +56,11 @@ void word_ram_0_dma_w(unsigned int words)
   cdc.dac.w += (words << 1);
 
   /* DMA transfer */
-  while (words--)
-  {
-    /* read 16-bit word from CDC RAM buffer (big-endian format) */
-    data = READ_WORD(cdc.ram, src_index);
-
-    /* write 16-bit word to WORD-RAM */
-    *(uint16 *)(scd.word_ram[0] + dst_index) = data ;
-
-    /* increment CDC buffer source address */
-    src_index = (src_index + 2) & 0x3ffe;
-
-    /* increment WORD-RAM destination address */
-    dst_index = (dst_index + 2) & 0x1fffe;
-  }
+  cdc_dma_copy(src_index, scd.word_ram[0], dst_index, 0x1fffe, words, 1);
 }
 
 void word_ram_1_dma_w(unsigned int words)
 {
-  uint16 data;
-
   /* CDC buffer source address */
   uint16 src_index = cdc.dac.w & 0x3ffe;
 
@@ -91,26 +74,11 @@ void word_ram_1_dma_w(unsigned int words)
   cdc.dac.w += (words << 1);
 
   /* DMA transfer */
-  while (words--)
-  {
-    /* read 16-bit word from CDC RAM buffer (big-endian format) */
-    data = READ_WORD(cdc.ram, src_index);
-
-    /* write 16-bit word to WORD-RAM */
-    *(uint16 *)(scd.word_ram[1] + dst_index) = data ;
-
-    /* increment CDC buffer source address */
-    src_index = (src_index + 2) & 0x3ffe;
-
-    /* increment WORD-RAM destination address */
-    dst_index = (dst_index + 2) & 0x1fffe;
-  }
+  cdc_dma_copy(src_index, scd.word_ram[1], dst_index, 0x1fffe, words, 1);
 }
 
 void word_ram_2M_dma_w(unsigned int words)
 {
-  uint16 data;
-
   /* CDC buffer source address */
   uint16 src_index = cdc.dac.w & 0x3ffe;
 
@@ -124,20 +92,7 @@ void word_ram_2M_dma_w(unsigned int words)
   cdc.dac.w += (words << 1);
 
   /* DMA transfer */
-  while (words--)
-  {
-    /* read 16-bit word from CDC RAM buffer (big-endian format) */
-    data = READ_WORD(cdc.ram, src_index);
-
-    /* write 16-bit word to WORD-RAM */
-    *(uint16 *)(scd.word_ram_2M + dst_index) = data ;
-
-    /* increment CDC buffer source address */
-    src_index = (src_index + 2) & 0x3ffe;
-
-    /* increment WORD-RAM destination address */
-    dst_index = (dst_index + 2) & 0x3fffe;
-  }
+  cdc_dma_copy(src_index, scd.word_ram_2M, dst_index, 0x3fffe, words, 1);
 }
 
 
@@ -468,22 +423,31 @@ INLINE void gfx_render(uint32 bufferIndex, uint32 width)
   uint32 xoffset = (int16) *gfx.tracePtr++;
   uint32 yoffset = (int16) *gfx.tracePtr++;
 
+  /* register settings do not change during a line (stamp map range if repeated, 24-bit range otherwise) */
+  uint32 posMask = (scd.regs[0x58>>1].byte.l & 0x01) ? gfx.dotMask : 0xffffff;
+  uint32 stampSize = (scd.regs[0x58>>1].byte.l & 0x02) << 2;
+  int prio = (scd.regs[0x02>>1].w >> 3) & 0x03;
+
+  /* stamp map table location in WORD-RAM (byte offset & size) */
+  uint32 mapStart = (uint8 *)gfx.mapPtr - scd.word_ram_2M;
+  uint32 mapSize = (((gfx.dotMask >> gfx.stampShift) + 1) << gfx.mapShift) << 1;
+
+  /* last 8x8 dots cell read from the stamp map: stamp generator base index with cell offset, HFLIP & ROTATION bits */
+  uint32 cell = 0xffffffff;
+  uint32 cell_index = 0;
+  uint32 cell_flags = 0;
+
+  /* invalid priority mode writes back image buffer data unmodified */
+  if (prio == 3)
+  {
+    return;
+  }
+
   /* process all dots */
   while (width--)
   {
-    /* check if stamp map is repeated */
-    if (scd.regs[0x58>>1].byte.l & 0x01)
-    {
-      /* stamp map range */
-      xpos &= gfx.dotMask;
-      ypos &= gfx.dotMask;
-    }
-    else
-    {
-      /* 24-bit range */
-      xpos &= 0xffffff;
-      ypos &= 0xffffff;
-    }
+    xpos &= posMask;
+    ypos &= posMask;
 
     /* check if pixel is outside stamp map */
     if ((xpos | ypos) & ~gfx.dotMask)
@@ -493,21 +457,24 @@ INLINE void gfx_render(uint32 bufferIndex, uint32 width)
     }
     else
     {
-      /* read stamp map table data */
-      stamp_data = gfx.mapPtr[(xpos >> gfx.stampShift) | ((ypos >> gfx.stampShift) << gfx.mapShift)];
-
-      /* stamp generator base index                                     */
-      /* sss ssssssss ccyyyxxx (16x16) or sss sssssscc ccyyyxxx (32x32) */
-      /* with:  s = stamp number (1 stamp = 16x16 or 32x32 pixels)      */
-      /*        c = cell offset  (0-3 for 16x16, 0-15 for 32x32)        */
-      /*      yyy = line offset  (0-7)                                  */
-      /*      xxx = pixel offset (0-7)                                  */
-      stamp_index = (stamp_data & 0x7ff) << 8;
-
-      if (stamp_index)
+      /* stamp map data only needs to be read again when entering a new 8x8 dots cell */
+      if (((xpos >> 14) | ((ypos >> 14) << 10)) != cell)
       {
+        cell = (xpos >> 14) | ((ypos >> 14) << 10);
+
+        /* read stamp map table data */
+        stamp_data = gfx.mapPtr[(xpos >> gfx.stampShift) | ((ypos >> gfx.stampShift) << gfx.mapShift)];
+
+        /* stamp generator base index                                     */
+        /* sss ssssssss ccyyyxxx (16x16) or sss sssssscc ccyyyxxx (32x32) */
+        /* with:  s = stamp number (1 stamp = 16x16 or 32x32 pixels)      */
+        /*        c = cell offset  (0-3 for 16x16, 0-15 for 32x32)        */
+        /*      yyy = line offset  (0-7)                                  */
+        /*      xxx = pixel offset (0-7)                                  */
+        cell_index = (stamp_data & 0x7ff) << 8;
+
         /* extract HFLIP & ROTATION bits */
-        stamp_data = (stamp_data >> 13) & 7;
+        cell_flags = (stamp_data >> 13) & 7;
 
         /* cell offset (0-3 or 0-15)                             */
         /* table entry = yyxxshrr (8 bits)                       */
@@ -515,14 +482,20 @@ INLINE void gfx_render(uint32 bufferIndex, uint32 width)
         /*       xx = cell column (0-3) = (xpos >> (11 + 3)) & 3 */
         /*        s = stamp size (0=16x16, 1=32x32)              */
         /*      hrr = HFLIP & ROTATION bits                      */
-        stamp_index |= gfx.lut_cell[stamp_data | ((scd.regs[0x58>>1].byte.l & 0x02) << 2 ) | ((ypos >> 8) & 0xc0) | ((xpos >> 10) & 0x30)] << 6;
-            
+        if (cell_index)
+        {
+          cell_index |= gfx.lut_cell[cell_flags | stampSize | ((ypos >> 8) & 0xc0) | ((xpos >> 10) & 0x30)] << 6;
+        }
+      }
+
+      if (cell_index)
+      {
         /* pixel  offset (0-63)                              */
         /* table entry = yyyxxxhrr (9 bits)                  */
         /* with: yyy = pixel row  (0-7) = (ypos >> 11) & 7   */
         /*       xxx = pixel column (0-7) = (xpos >> 11) & 7 */
         /*       hrr = HFLIP & ROTATION bits                 */
-        stamp_index |= gfx.lut_pixel[stamp_data | ((xpos >> 8) & 0x38) | ((ypos >> 5) & 0x1c0)];
+        stamp_index = cell_index | gfx.lut_pixel[cell_flags | ((xpos >> 8) & 0x38) | ((ypos >> 5) & 0x1c0)];
 
         /* read pixel pair (2 pixels/byte) */
         pixel_out = READ_BYTE(scd.word_ram_2M, stamp_index >> 1);
@@ -557,12 +530,21 @@ INLINE void gfx_render(uint32 bufferIndex, uint32 width)
       pixel_out = (pixel_out << 4) | (pixel_in & 0x0f);
     }
 
-    /* priority mode write */
-    pixel_out = gfx.lut_prio[(scd.regs[0x02>>1].w >> 3) & 0x03][pixel_in][pixel_out];
+    /* priority mode write (normal mode always writes new pixel) */
+    if (prio)
+    {
+      pixel_out = gfx.lut_prio[prio][pixel_in][pixel_out];
+    }
 
     /* write data to image buffer */
     WRITE_BYTE(scd.word_ram_2M, bufferIndex >> 1, pixel_out);
 
+    /* image buffer overlapping stamp map: read stamp map data again */
+    if (((bufferIndex >> 1) - mapStart) < mapSize)
+    {
+      cell = 0xffffffff;
+    }
+
     /* check current pixel position  */
     if ((bufferIndex & 7) != 7)
     {
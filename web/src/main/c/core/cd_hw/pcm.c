@@ -41,6 +41,117 @@
 
 #define pcm scd.pcm_hw
 
+/* Samples are rendered in blocks: each enabled channel reads its block of
+   WAVE RAM data (the address and loop logic stay sample by sample), then
+   the block is scaled by the channel's ENV & PAN multipliers and added to
+   the L/R outputs four samples at a time when vectors are available */
+#define PCM_BLOCK 256
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define PCM_VEC
+typedef v128_t pcm_vec_t;
+#define VEC_LOAD(p)     wasm_v128_load(p)
+#define VEC_STORE(p, v) wasm_v128_store(p, v)
+#define VEC_SPLAT(n)    wasm_i32x4_splat(n)
+#define VEC_ADD(a, b)   wasm_i32x4_add(a, b)
+#define VEC_MUL(a, b)   wasm_i32x4_mul(a, b)
+#define VEC_SRA5(v)     wasm_i32x4_shr(v, 5)
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define PCM_VEC
+typedef __m128i pcm_vec_t;
+#define VEC_LOAD(p)     _mm_loadu_si128((const __m128i *)(p))
+#define VEC_STORE(p, v) _mm_storeu_si128((__m128i *)(p), v)
+#define VEC_SPLAT(n)    _mm_set1_epi32(n)
+#define VEC_ADD(a, b)   _mm_add_epi32(a, b)
+#define VEC_MUL(a, b)   _mm_mullo_epi32(a, b)
+#define VEC_SRA5(v)     _mm_srai_epi32(v, 5)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PCM_VEC
+typedef int32x4_t pcm_vec_t;
+#define VEC_LOAD(p)     vld1q_s32(p)
+#define VEC_STORE(p, v) vst1q_s32(p, v)
+#define VEC_SPLAT(n)    vdupq_n_s32(n)
+#define VEC_ADD(a, b)   vaddq_s32(a, b)
+#define VEC_MUL(a, b)   vmulq_s32(a, b)
+#define VEC_SRA5(v)     vshrq_n_s32(v, 5)
+#endif
+
+static int32 chan_data[PCM_BLOCK]; /* samples of one channel */
+static int32 mix_l[PCM_BLOCK];     /* L/R outputs (14.5 fixed point) */
+static int32 mix_r[PCM_BLOCK];
+
+/* read 'length' samples of a channel, centered around 0, to chan_data */
+static void pcm_channel_read(chan_t *ch, unsigned int length)
+{
+  unsigned int i;
+
+  for (i=0; i<length; i++)
+  {
+    /* read from current WAVE RAM address */
+    int data = pcm.ram[(ch->addr >> 11) & 0xffff];
+
+    /* loop data ? */
+    if (data == 0xff)
+    {
+      /* reset WAVE RAM address */
+      ch->addr = ch->ls.w << 11;
+
+      /* read again from WAVE RAM address */
+      data = pcm.ram[ch->ls.w];
+    }
+    else
+    {
+      /* increment WAVE RAM address */
+      ch->addr += ch->fd.w;
+    }
+
+    /* infinite loop should not output any data */
+    if (data == 0xff)
+    {
+      chan_data[i] = 0;
+    }
+
+    /* check sign bit (output centered around 0) */
+    else if (data & 0x80)
+    {
+      /* PCM data is positive */
+      chan_data[i] = data & 0x7f;
+    }
+    else
+    {
+      /* PCM data is negative */
+      chan_data[i] = -(data & 0x7f);
+    }
+  }
+}
+
+/* multiply chan_data with ENV & stereo PAN data then add to L/R outputs */
+static void pcm_channel_mix(int gain_l, int gain_r, unsigned int length)
+{
+  unsigned int i = 0;
+
+#ifdef PCM_VEC
+  pcm_vec_t vl = VEC_SPLAT(gain_l);
+  pcm_vec_t vr = VEC_SPLAT(gain_r);
+
+  for (; i+4<=length; i+=4)
+  {
+    pcm_vec_t data = VEC_LOAD(&chan_data[i]);
+    VEC_STORE(&mix_l[i], VEC_ADD(VEC_LOAD(&mix_l[i]), VEC_SRA5(VEC_MUL(data, vl))));
+    VEC_STORE(&mix_r[i], VEC_ADD(VEC_LOAD(&mix_r[i]), VEC_SRA5(VEC_MUL(data, vr))));
+  }
+#endif
+
+  for (; i<length; i++)
+  {
+    mix_l[i] += (chan_data[i] * gain_l) >> 5;
+    mix_r[i] += (chan_data[i] * gain_r) >> 5;
+  }
+}
+
 void pcm_init(double clock, int samplerate)
 {
   /* PCM chip is running at original rate and is synchronized with SUB-CPU  */
@@ -123,13 +234,21 @@ void pcm_run(unsigned int length)
   /* check if PCM chip is running */
   if (pcm.enabled)
   {
-    int i, j, l, r;
-  
-    /* generate PCM samples */
-    for (i=0; i<length; i++)
+    unsigned int i, k, n;
+    int j, l, r;
+
+    /* generate PCM samples, one block at a time */
+    for (i=0; i<length; i+=n)
     {
-      /* clear output */
-      l = r = 0;
+      n = length - i;
+      if (n > PCM_BLOCK)
+      {
+        n = PCM_BLOCK;
+      }
+
+      /* clear outputs */
+      memset(mix_l, 0, n * sizeof(int32));
+      memset(mix_r, 0, n * sizeof(int32));
 
       /* run eight PCM channels */
       for (j=0; j<8; j++)
@@ -137,56 +256,35 @@ void pcm_run(unsigned int length)
         /* check if channel is enabled */
         if (pcm.status & (1 << j))
         {
-          /* read from current WAVE RAM address */
-          short data = pcm.ram[(pcm.chan[j].addr >> 11) & 0xffff];
+          /* ENV & stereo PAN multipliers */
+          int gain_l = pcm.chan[j].env * (pcm.chan[j].pan & 0x0F);
+          int gain_r = pcm.chan[j].env * (pcm.chan[j].pan >> 4);
 
-          /* loop data ? */
-          if (data == 0xff)
-          {
-            /* reset WAVE RAM address */
-            pcm.chan[j].addr = pcm.chan[j].ls.w << 11;
+          pcm_channel_read(&pcm.chan[j], n);
 
-            /* read again from WAVE RAM address */
-            data = pcm.ram[pcm.chan[j].ls.w];
-          }
-          else
-          {
-            /* increment WAVE RAM address */
-            pcm.chan[j].addr += pcm.chan[j].fd.w;
-          }
-
-          /* infinite loop should not output any data */
-          if (data != 0xff)
+          if (gain_l | gain_r)
           {
-            /* check sign bit (output centered around 0) */
-            if (data & 0x80)
-            {
-              /* PCM data is positive */
-              data = data & 0x7f;
-            }
-            else
-            {
-              /* PCM data is negative */
-              data = -(data & 0x7f);
-            }
-
-            /* multiply PCM data with ENV & stereo PAN data then add to L/R outputs (14.5 fixed point) */
-            l += ((data * pcm.chan[j].env * (pcm.chan[j].pan & 0x0F)) >> 5);
-            r += ((data * pcm.chan[j].env * (pcm.chan[j].pan >> 4)) >> 5);
+            pcm_channel_mix(gain_l, gain_r, n);
           }
         }
       }
 
-      /* limiter */
-      if (l < -32768) l = -32768;
-      else if (l > 32767) l = 32767;
-      if (r < -32768) r = -32768;
-      else if (r > 32767) r = 32767;
-
-      /* update Blip Buffer */
-      blip_add_delta_fast(snd.blips[1], i, l-prev_l, r-prev_r);
-      prev_l = l;
-      prev_r = r;
+      for (k=0; k<n; k++)
+      {
+        l = mix_l[k];
+        r = mix_r[k];
+
+        /* limiter */
+        if (l < -32768) l = -32768;
+        else if (l > 32767) l = 32767;
+        if (r < -32768) r = -32768;
+        else if (r > 32767) r = 32767;
+
+        /* update Blip Buffer */
+        blip_add_delta_fast(snd.blips[1], i + k, l-prev_l, r-prev_r);
+        prev_l = l;
+        prev_r = r;
+      }
     }
 
     /* save last audio outputs */
@@ -393,8 +491,6 @@ unsigned char pcm_read(unsigned int address)
 
 void pcm_ram_dma_w(unsigned int words)
 {
-  uint16 data;
-
   /* CDC buffer source address */
   uint16 src_index = cdc.dac.w & 0x3ffe;
   
@@ -408,19 +504,6 @@ void pcm_ram_dma_w(unsigned int words)
   cdc.dac.w += (words << 1);
 
   /* DMA transfer */
-  while (words--)
-  {
-    /* read 16-bit word from CDC buffer */
-    data = *(uint16 *)(cdc.ram + src_index);
-
-    /* write 16-bit word to PCM RAM (endianness does not matter since PCM RAM is always accessed as byte)*/
-    *(uint16 *)(pcm.bank + dst_index) = data ;
-
-    /* increment CDC buffer source address */
-    src_index = (src_index + 2) & 0x3ffe;
-
-    /* increment PCM-RAM destination address */
-    dst_index = (dst_index + 2) & 0xffe;
-  }
+  cdc_dma_copy(src_index, pcm.bank, dst_index, 0xffe, words, 0);
 }
 
@@ -78,8 +78,6 @@ static void s68k_unused_16_w(unsigned int address, unsigned int data)
 /*--------------------------------------------------------------------------*/
 void prg_ram_dma_w(unsigned int words)
 {
-  uint16 data;
-
   /* CDC buffer source address */
   uint16 src_index = cdc.dac.w & 0x3ffe;
 
@@ -99,20 +97,7 @@ void prg_ram_dma_w(unsigned int words)
   }
 
   /* DMA transfer */
-  while (words--)
-  {
-    /* read 16-bit word from CDC RAM buffer (big-endian format) */
-    data = READ_WORD(cdc.ram, src_index);
-
-    /* write 16-bit word to PRG-RAM */
-    *(uint16 *)(scd.prg_ram + dst_index) = data ;
-
-    /* increment CDC buffer source address */
-    src_index = (src_index + 2) & 0x3ffe;
-
-    /* increment PRG-RAM destination address */
-    dst_index = (dst_index + 2) & 0x7fffe;
-  }
+  cdc_dma_copy(src_index, scd.prg_ram, dst_index, 0x7fffe, words, 1);
 }
 
 /*--------------------------------------------------------------------------*/
@@ -44,7 +44,10 @@
 #include "pcm.h"
 #include "cd_cart.h"
 
-#ifdef USE_DYNAMIC_ALLOC
+#ifdef MD_ONLY
+/* no CD hardware in ext: only used behind system_hw == SYSTEM_MCD (md_only.c) */
+#define scd (*scd_none)
+#elif defined(USE_DYNAMIC_ALLOC)
 #define scd ext->cd_hw
 #else
 #define scd ext.cd_hw
@@ -82,6 +85,10 @@ typedef struct
   pcm_t pcm_hw;               /* PCM chip */
 } cd_hw_t;
 
+#ifdef MD_ONLY
+extern cd_hw_t *const scd_none;
+#endif
+
 /* Function prototypes */
 extern void scd_init(void);
 extern void scd_reset(int hard);
@@ -41,13 +41,17 @@
 #ifdef HOOK_CPU
 
 #include <stdio.h>
+#include <string.h>
 #include "cpuhook.h"
 
 void(*cpu_hook)(hook_type_t type, int width, unsigned int address, unsigned int value) = NULL;
 
+unsigned char cpu_hook_pages[3][HOOK_PAGES >> 3];
+
 void set_cpu_hook(void(*hook)(hook_type_t type, int width, unsigned int address, unsigned int value))
 {
 	cpu_hook = hook;
+	memset(cpu_hook_pages, hook ? 0xff : 0x00, sizeof(cpu_hook_pages));
 }
 
 #endif /* HOOK_CPU */
\ No newline at end of file
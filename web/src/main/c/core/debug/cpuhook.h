@@ -80,7 +80,23 @@ typedef enum {
 
 /* CPU hook is called on read, write, and execute.
  */
-void (*cpu_hook)(hook_type_t type, int width, unsigned int address, unsigned int value);
+extern void (*cpu_hook)(hook_type_t type, int width, unsigned int address, unsigned int value);
+
+/* 68k accesses only call cpu_hook() for the 4KB pages of the 24-bit address
+ * space whose bit is set, one bitmap per access kind (HOOK_PAGE_E/R/W), so that
+ * unwatched accesses cost a single bit test. set_cpu_hook() sets every page (or
+ * clears them all for a NULL hook); the watch engine (watch.c) only sets the
+ * pages it watches.
+ */
+#define HOOK_PAGE_SHIFT 12
+#define HOOK_PAGES      (0x1000000 >> HOOK_PAGE_SHIFT)
+
+enum { HOOK_PAGE_E, HOOK_PAGE_R, HOOK_PAGE_W };
+
+extern unsigned char cpu_hook_pages[3][HOOK_PAGES >> 3];
+
+#define cpu_hook_page(KIND, A) \
+  (cpu_hook_pages[KIND][((A) & 0xffffff) >> (HOOK_PAGE_SHIFT + 3)] & (1 << ((((A) & 0xffffff) >> HOOK_PAGE_SHIFT) & 7)))
 
 /* Use set_cpu_hook() to assign a callback that can process the data provided
  * by cpu_hook().
@@ -0,0 +1,141 @@
+/***************************************************************************************
+ *  Genesis Plus GX
+ *  Sampling 68k PC profiler
+ *
+ *  CHAOS_PC_PROFILE should be defined (CHAOS_PC_PROFILE=ON) to enable this functionality
+ *
+ ****************************************************************************************/
+
+#ifdef CHAOS_PC_PROFILE
+
+#include "shared.h"
+#include "pcprof.h"
+
+unsigned int pcprof_next = 0xffffffff;
+
+static unsigned int period;
+static unsigned int left;       /* cycles to the next sample point between two m68k_run() */
+static unsigned int regions[PCPROF_REGIONS];
+static pcprof_spot_t exact[PCPROF_EXACT];   /* address: PC + 1, 0 for a free slot */
+static unsigned int total;
+static unsigned int dropped;
+
+void pcprof_start(unsigned int cycles)
+{
+  period = cycles;
+  left = cycles;
+}
+
+void pcprof_reset(void)
+{
+  memset(regions, 0, sizeof(regions));
+  memset(exact, 0, sizeof(exact));
+  total = dropped = 0;
+  left = period;
+}
+
+void pcprof_enter(unsigned int cycles)
+{
+  pcprof_next = period ? (cycles + left) : 0xffffffff;
+}
+
+void pcprof_leave(unsigned int pc, unsigned int cycles)
+{
+  if (!period)
+    return;
+
+  /* cycles run past the last instruction (idle loop skipping) */
+  if (cycles >= pcprof_next)
+    pcprof_sample(pc, cycles);
+  left = pcprof_next - cycles;
+}
+
+void pcprof_sample(unsigned int pc, unsigned int cycles)
+{
+  unsigned int n = (cycles - pcprof_next) / period + 1;
+  unsigned int slot;
+  int i;
+
+  pcprof_next += n * period;
+  total += n;
+
+  pc &= 0xffffff;
+  if (pc < 0x400000)
+    regions[pc >> PCPROF_REGION_SHIFT] += n;
+  else if (pc >= 0xe00000)
+    regions[PCPROF_ROM_REGIONS + ((pc & 0xffff) >> PCPROF_REGION_SHIFT)] += n;
+  else
+    regions[PCPROF_REGIONS - 1] += n;
+
+  slot = ((pc >> 1) * 0x9e3779b1) >> 20;
+  for (i = 0; i < PCPROF_PROBES; i++, slot++)
+  {
+    pcprof_spot_t *spot = &exact[slot & (PCPROF_EXACT - 1)];
+
+    if (spot->address == pc + 1)
+    {
+      spot->samples += n;
+      return;
+    }
+    if (!spot->address)
+    {
+      spot->address = pc + 1;
+      spot->samples = n;
+      return;
+    }
+  }
+  dropped += n;
+}
+
+/* keeps 'spots' sorted: inserts the entry if it beats the last one */
+static int pcprof_insert(pcprof_spot_t *spots, int count, int max, unsigned int address, unsigned int samples)
+{
+  int i;
+
+  if (!samples || ((count == max) && (samples <= spots[max - 1].samples)))
+    return count;
+
+  if (count < max)
+    count++;
+  for (i = count - 1; (i > 0) && (spots[i - 1].samples < samples); i--)
+    spots[i] = spots[i - 1];
+  spots[i].address = address;
+  spots[i].samples = samples;
+  return count;
+}
+
+int pcprof_report(pcprof_spot_t *spots, int max, int exact_pcs)
+{
+  int i, count = 0;
+
+  if (max <= 0)
+    return 0;
+
+  if (exact_pcs)
+  {
+    for (i = 0; i < PCPROF_EXACT; i++)
+    {
+      if (exact[i].address)
+        count = pcprof_insert(spots, count, max, exact[i].address - 1, exact[i].samples);
+    }
+    return count;
+  }
+
+  for (i = 0; i < PCPROF_ROM_REGIONS; i++)
+    count = pcprof_insert(spots, count, max, i << PCPROF_REGION_SHIFT, regions[i]);
+  for (i = 0; i < PCPROF_RAM_REGIONS; i++)
+    count = pcprof_insert(spots, count, max, 0xff0000 | (i << PCPROF_REGION_SHIFT), regions[PCPROF_ROM_REGIONS + i]);
+  return pcprof_insert(spots, count, max, 0xffffffff, regions[PCPROF_REGIONS - 1]);
+}
+
+unsigned int pcprof_total(void)
+{
+  return total;
+}
+
+unsigned int pcprof_dropped(void)
+{
+  return dropped;
+}
+
+#endif /* CHAOS_PC_PROFILE */
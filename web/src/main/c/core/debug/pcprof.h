@@ -0,0 +1,66 @@
+/***************************************************************************************
+ *  Genesis Plus GX
+ *  Sampling 68k PC profiler
+ *
+ *  CHAOS_PC_PROFILE should be defined (CHAOS_PC_PROFILE=ON) to enable this functionality
+ *
+ ****************************************************************************************/
+
+#ifndef _PCPROF_H_
+#define _PCPROF_H_
+
+/* Every 'period' master clock cycles of 68k time, m68k_run() hands the PC of
+ * the instruction about to run to pcprof_sample(). The loop only compares the
+ * cycle count it keeps anyway with the next sample point; cycles that pass
+ * without instructions (idle loop skipping, compiled traces, DMA and FIFO
+ * waits) count as several samples of the PC that follows them. STOP time is
+ * not sampled.
+ *
+ * Samples go into a histogram of 256-byte regions of the cartridge area
+ * ($000000-$3FFFFF) and of work RAM (mirrors included), plus one bucket for
+ * anywhere else, and into a table counting exact PCs, as long as it has
+ * room. Nothing is cleared until pcprof_reset(), so a profile can cover a
+ * whole session.
+ */
+
+#define PCPROF_REGION_SHIFT   8
+#define PCPROF_ROM_REGIONS    (0x400000 >> PCPROF_REGION_SHIFT)
+#define PCPROF_RAM_REGIONS    (0x10000 >> PCPROF_REGION_SHIFT)
+#define PCPROF_REGIONS        (PCPROF_ROM_REGIONS + PCPROF_RAM_REGIONS + 1)
+#define PCPROF_EXACT          4096  /* exact PCs (power of 2) */
+#define PCPROF_PROBES         16    /* slots tried for a new PC */
+
+/* hot spot: first address of a region (the other bucket: 0xffffffff) or a PC */
+typedef struct
+{
+  unsigned int address;
+  unsigned int samples;
+} pcprof_spot_t;
+
+/* next sample point in m68k.cycles, 0xffffffff when off (m68k_run()) */
+extern unsigned int pcprof_next;
+
+/* Starts sampling every 'period' master clock cycles, stops with 0 (the data is kept) */
+extern void pcprof_start(unsigned int period);
+
+/* Clears the histogram and the PC table */
+extern void pcprof_reset(void);
+
+/* m68k_run() entry and exit: the sample point is kept as cycles left, since
+ * m68k.cycles is rebased every frame; a sample point passed after the last
+ * instruction goes to 'pc' */
+extern void pcprof_enter(unsigned int cycles);
+extern void pcprof_leave(unsigned int pc, unsigned int cycles);
+
+/* Sample point reached at 'cycles' with the instruction at 'pc' next */
+extern void pcprof_sample(unsigned int pc, unsigned int cycles);
+
+/* Up to 'max' hottest regions (exact = 0) or PCs (exact = 1), most samples
+ * first, into 'spots'; returns the count */
+extern int pcprof_report(pcprof_spot_t *spots, int max, int exact);
+
+/* Samples taken, and those the PC table had no room for */
+extern unsigned int pcprof_total(void);
+extern unsigned int pcprof_dropped(void);
+
+#endif /* _PCPROF_H_ */
@@ -0,0 +1,194 @@
+/***************************************************************************************
+ *  Genesis Plus GX
+ *  68k watchpoints and tracepoints on top of the CPU hook
+ *
+ *  HOOK_CPU should be defined (CHAOS_WATCH=ON) to enable this functionality
+ *
+ ****************************************************************************************/
+
+#ifdef HOOK_CPU
+
+#include "shared.h"
+#include "watch.h"
+
+typedef struct
+{
+  unsigned int type;  /* HOOK_M68K_E/R/W bits, 0: free slot */
+  unsigned int start;
+  unsigned int end;
+  unsigned int cond;
+  unsigned int ref;
+  unsigned int mask;
+  unsigned int last;  /* value of the previous access */
+  unsigned int count;
+} watch_t;
+
+static watch_t watches[WATCH_MAX];
+static watch_hit_t hits[WATCH_HITS];
+static unsigned int total;
+
+/* sets the page bits of every watch (and of the pages just below them, for
+   long-word accesses starting there) */
+static void watch_pages(void)
+{
+  int i;
+
+  memset(cpu_hook_pages, 0, sizeof(cpu_hook_pages));
+
+  for (i = 0; i < WATCH_MAX; i++)
+  {
+    watch_t *w = &watches[i];
+    unsigned int page;
+
+    if (!w->type)
+      continue;
+
+    for (page = ((w->start < 3) ? 0 : (w->start - 3)) >> HOOK_PAGE_SHIFT; page <= (w->end >> HOOK_PAGE_SHIFT); page++)
+    {
+      if (w->type & HOOK_M68K_E) cpu_hook_pages[HOOK_PAGE_E][page >> 3] |= 1 << (page & 7);
+      if (w->type & HOOK_M68K_R) cpu_hook_pages[HOOK_PAGE_R][page >> 3] |= 1 << (page & 7);
+      if (w->type & HOOK_M68K_W) cpu_hook_pages[HOOK_PAGE_W][page >> 3] |= 1 << (page & 7);
+    }
+  }
+}
+
+/* memory about to be overwritten, if it is mapped directly */
+static unsigned int watch_old(int width, unsigned int address, unsigned int last)
+{
+  cpu_memory_map *temp = &m68k.memory_map[(address >> 16) & 0xff];
+
+  switch (width)
+  {
+    case 1:
+      return temp->write8 ? last : READ_BYTE(temp->base, address & 0xffff);
+
+    case 2:
+      return temp->write16 ? last : *(uint16 *)(temp->base + (address & 0xffff));
+
+    default:
+      if (temp->write16 || ((address & 0xffff) == 0xfffe))
+        return last;
+      return (*(uint16 *)(temp->base + (address & 0xffff)) << 16) | *(uint16 *)(temp->base + (address & 0xffff) + 2);
+  }
+}
+
+static void watch_hook(hook_type_t type, int width, unsigned int address, unsigned int value)
+{
+  int i;
+  unsigned int top = address + (width ? (width - 1) : 0);
+
+  if (!(type & (HOOK_M68K_E | HOOK_M68K_RW)))
+    return;
+
+  if (type == HOOK_M68K_E)
+    value = m68k.dar[0];
+
+  for (i = 0; i < WATCH_MAX; i++)
+  {
+    watch_t *w = &watches[i];
+    watch_hit_t *hit;
+    unsigned int old;
+    int match;
+
+    if (!(w->type & type) || (address > w->end) || (top < w->start))
+      continue;
+
+    old = (type == HOOK_M68K_W) ? watch_old(width, address, w->last) : w->last;
+    w->last = value;
+
+    switch (w->cond)
+    {
+      case WATCH_EQ:      match = (value & w->mask) == (w->ref & w->mask); break;
+      case WATCH_NE:      match = (value & w->mask) != (w->ref & w->mask); break;
+      case WATCH_LT:      match = (value & w->mask) <  (w->ref & w->mask); break;
+      case WATCH_GT:      match = (value & w->mask) >  (w->ref & w->mask); break;
+      case WATCH_CHANGED: match = ((value ^ old) & w->mask) != 0; break;
+      case WATCH_INC:     match = (value & w->mask) >  (old & w->mask); break;
+      case WATCH_DEC:     match = (value & w->mask) <  (old & w->mask); break;
+      default:            match = 1; break;
+    }
+
+    if (!match)
+      continue;
+
+    w->count++;
+    hit = &hits[total++ & (WATCH_HITS - 1)];
+    hit->id = i + 1;
+    hit->type = type;
+    hit->width = width;
+    hit->address = address;
+    hit->value = value;
+    hit->old = old;
+    hit->pc = m68k.pc;
+  }
+}
+
+int watch_add(int type, unsigned int start, unsigned int end, int cond, unsigned int ref, unsigned int mask)
+{
+  int i;
+
+  type &= HOOK_M68K_E | HOOK_M68K_RW;
+  start &= 0xffffff;
+  end &= 0xffffff;
+  if (!type || (start > end) || (cond < WATCH_ANY) || (cond > WATCH_DEC))
+    return 0;
+
+  for (i = 0; i < WATCH_MAX; i++)
+  {
+    if (!watches[i].type)
+    {
+      watch_t *w = &watches[i];
+
+      w->type = type;
+      w->start = start;
+      w->end = end;
+      w->cond = cond;
+      w->ref = ref;
+      w->mask = mask;
+      w->last = ref;
+      w->count = 0;
+
+      if (cpu_hook != watch_hook)
+        set_cpu_hook(watch_hook);
+      watch_pages();
+      return i + 1;
+    }
+  }
+
+  return 0;
+}
+
+void watch_remove(int id)
+{
+  if ((id > 0) && (id <= WATCH_MAX))
+  {
+    watches[id - 1].type = 0;
+    if (cpu_hook == watch_hook)
+      watch_pages();
+  }
+}
+
+void watch_clear(void)
+{
+  memset(watches, 0, sizeof(watches));
+  total = 0;
+  if (cpu_hook == watch_hook)
+    set_cpu_hook(NULL);
+}
+
+unsigned int watch_count(int id)
+{
+  return ((id > 0) && (id <= WATCH_MAX)) ? watches[id - 1].count : 0;
+}
+
+const watch_hit_t *watch_hits(void)
+{
+  return hits;
+}
+
+unsigned int watch_total(void)
+{
+  return total;
+}
+
+#endif /* HOOK_CPU */
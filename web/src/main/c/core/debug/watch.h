@@ -0,0 +1,60 @@
+/***************************************************************************************
+ *  Genesis Plus GX
+ *  68k watchpoints and tracepoints on top of the CPU hook
+ *
+ *  HOOK_CPU should be defined (CHAOS_WATCH=ON) to enable this functionality
+ *
+ ****************************************************************************************/
+
+#ifndef _WATCH_H_
+#define _WATCH_H_
+
+#include "cpuhook.h"
+
+#define WATCH_MAX  32   /* watches at once */
+#define WATCH_HITS 256  /* hit ring size (power of 2) */
+
+/* hit conditions, on (value & mask) against (ref & mask); CHANGED, INC and DEC
+ * compare against the previous value: the memory being overwritten for writes
+ * to RAM, the value of the previous access seen by the same watch otherwise.
+ */
+typedef enum {
+  WATCH_ANY,
+  WATCH_EQ,
+  WATCH_NE,
+  WATCH_LT,
+  WATCH_GT,
+  WATCH_CHANGED,
+  WATCH_INC,
+  WATCH_DEC
+} watch_cond_t;
+
+typedef struct
+{
+  unsigned int id;      /* watch_add() result */
+  unsigned int type;    /* HOOK_M68K_E, HOOK_M68K_R or HOOK_M68K_W */
+  unsigned int width;   /* access size in bytes (0: execution) */
+  unsigned int address; /* accessed address (execution: PC) */
+  unsigned int value;   /* read or written value (execution: D0) */
+  unsigned int old;     /* previous value (see watch_cond_t) */
+  unsigned int pc;      /* 68k PC (read/write: past the words fetched so far) */
+} watch_hit_t;
+
+/* Adds a watch of the 68k accesses of 'type' (HOOK_M68K_E/R/W/RW) overlapping
+ * [start, end], whose hits are logged when 'cond' holds. Returns its id (> 0),
+ * or 0 when all watches are used. Replaces any other cpu_hook.
+ */
+extern int watch_add(int type, unsigned int start, unsigned int end, int cond, unsigned int ref, unsigned int mask);
+extern void watch_remove(int id);
+extern void watch_clear(void);
+
+/* Hits of a watch since it was added */
+extern unsigned int watch_count(int id);
+
+/* Last WATCH_HITS hits, the n-th one at [n & (WATCH_HITS - 1)]; watch_total()
+ * counts all of them since watch_clear().
+ */
+extern const watch_hit_t *watch_hits(void);
+extern unsigned int watch_total(void);
+
+#endif /* _WATCH_H_ */
@@ -72,6 +72,7 @@ void gen_init(void)
     /* initialize main 68k */
     m68k_init();
     m68k.aerr_enabled = config.addr_error; 
+    m68k_idle_skip(config.idle_skip);
 
     /* initialize main 68k memory map */
 
@@ -147,6 +148,13 @@ void gen_init(void)
         z80_readmap[i] = &zram[(i & 7) << 10];
       }
 
+      /* Z80 RAM data accesses go through the map too (RM/WM in z80.c), */
+      /* the other pages use the memory handlers */
+      for (i=0; i<16; i++)
+      {
+        z80_writemap[i] = &zram[(i & 7) << 10];
+      }
+
       /* initialize Z80 memory handlers */
       z80_writemem  = z80_memory_w;
       z80_readmem   = z80_memory_r;
@@ -164,11 +172,17 @@ void gen_init(void)
 
       /* initialize CD hardware */
       scd_init();
+
+      /* main CPU runs from BIOS or RAM */
+      m68k_cache_set_rom(NULL, 0);
     }
     else
     {
       /* Cartridge hardware */
       md_cart_init();
+
+      /* cartridge ROM is decoded once (see m68kconf.h) */
+      m68k_cache_set_rom(cart.rom, cart.romsize);
     }
   }
   else
@@ -256,7 +270,8 @@ void gen_reset(int hard_reset)
   else
   {
     /* when RESET button is pressed, 68k could be anywhere in VDP frame (Bonkers, Eternal Champions, X-Men 2) */
-    m68k.cycles = (uint32)((MCYCLES_PER_LINE * lines_per_frame) * ((double)rand() / (double)RAND_MAX));
+    /* keep its current position rather than a random one, so a replayed session resets the same way */
+    m68k.cycles = m68k.cycles % (MCYCLES_PER_LINE * lines_per_frame);
 
     /* reset YM2612 (on hard reset, this is done by sound_reset) */
     fm_reset(0);
@@ -494,6 +509,12 @@ void gen_zbusreq_w(unsigned int data, unsigned int cycles)
 
     /* update Z80 bus status */
     zstate &= 1;
+
+    /* a batch of VBlank lines ends with the line the Z80 restarts on */
+    if (zstate == 1)
+    {
+      vblank_z80_started(cycles);
+    }
   }
 }
 
@@ -528,6 +549,12 @@ void gen_zreset_w(unsigned int data, unsigned int cycles)
 
     /* update Z80 bus status */
     zstate |= 1;
+
+    /* a batch of VBlank lines ends with the line the Z80 restarts on */
+    if (zstate == 1)
+    {
+      vblank_z80_started(cycles);
+    }
   }
   else  /* !ZRESET asserted */
   {
@@ -50,7 +50,9 @@
 typedef union
 {
   md_cart_t md_cart;
+#ifndef MD_ONLY
   cd_hw_t cd_hw;
+#endif
 } external_t;
 
 /* Global variables */
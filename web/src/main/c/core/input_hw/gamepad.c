@@ -103,7 +103,11 @@ INLINE unsigned char gamepad_read(int port)
   unsigned int data = gamepad[port].State | 0x3F;
 
   /* pad state */
+#ifdef osd_input_poll
+  unsigned int pad = osd_input_poll(port);
+#else
   unsigned int pad = input.pad[port];
+#endif
 
   /* get current TH input pulse counter */
   unsigned int step = gamepad[port].Counter | (data >> 6);
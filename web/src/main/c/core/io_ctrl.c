@@ -358,6 +358,8 @@ void io_reset(void)
 
 void io_68k_write(unsigned int offset, unsigned int data)
 {
+  VBLANK_SYNC(m68k.cycles);
+
   switch (offset)
   {
     case 0x01:  /* Port A Data */
@@ -435,6 +437,8 @@ void io_68k_write(unsigned int offset, unsigned int data)
 
 unsigned int io_68k_read(unsigned int offset)
 {
+  VBLANK_SYNC(m68k.cycles);
+
   switch(offset)
   {
     case 0x01:  /* Port A Data */
@@ -94,6 +94,21 @@ uint8 romtype;
 
 static uint8 rom_region;
 
+/* ROM file streamed into cart.rom (see load_rom_stream_begin) */
+static struct
+{
+  int size;         /* file size, 0 when the ROM is loaded by load_archive() */
+  int received;     /* file bytes written so far */
+  int detected;     /* format known (byte-swapped dump, .smd header) */
+  int hw;           /* SYSTEM_MD, or SYSTEM_SMS2 / SYSTEM_GG for a 8-bit cartridge */
+  int swapped;      /* byte-swapped dump */
+  int smd;          /* 512-byte header and interleaved 16KB blocks */
+  int unswapped;    /* file bytes swapped back */
+  int done;         /* ROM bytes in their final form */
+  uint16 checksum;  /* real checksum of the final bytes */
+  uint8 header[0x400]; /* ROM header, before the LSB_FIRST byteswap */
+} rom_stream;
+
 /***************************************************************************
  * Genesis ROM Manufacturers
  *
@@ -228,6 +243,227 @@ static void deinterleave_block(uint8 * src)
   }
 }
 
+/***************************************************************************
+ * Streamed ROM loading
+ *
+ * The ROM file is written in chunks straight into cart.rom, each at its file
+ * offset, and converted in place behind the last chunk: byte-swapped dumps
+ * are swapped back, .smd blocks are deinterleaved 512 bytes down over the
+ * header, and final bytes are summed into the real checksum then byteswapped
+ * (LSB_FIRST). load_rom() then only has to set up the hardware, on every
+ * reset as well, since the streamed image stays in place until the next one.
+ ***************************************************************************/
+static int rom_stream_romsize(void)
+{
+  return rom_stream.smd ? (rom_stream.size - 512) : rom_stream.size;
+}
+
+/* ROM bytes [start, end) are final */
+static void rom_stream_final(int start, int end)
+{
+  int i;
+
+  /* header, as getrominfo() and get_region() expect it */
+  if (start < (int)sizeof(rom_stream.header))
+  {
+    int stop = (end < (int)sizeof(rom_stream.header)) ? end : (int)sizeof(rom_stream.header);
+    memcpy(rom_stream.header + start, cart.rom + start, stop - start);
+  }
+
+  /* same words as getchecksum() */
+  for (i = (start < 0x200) ? 0x200 : start; i < end; i += 2)
+  {
+    rom_stream.checksum += ((cart.rom[i] << 8) + cart.rom[i + 1]);
+  }
+
+#ifdef LSB_FIRST
+  /* Byteswap ROM to optimize 16-bit access */
+  if (rom_stream.hw == SYSTEM_MD)
+  {
+    for (i = start; i < end; i += 2)
+    {
+      uint8 temp = cart.rom[i];
+      cart.rom[i] = cart.rom[i+1];
+      cart.rom[i+1] = temp;
+    }
+  }
+#endif
+
+  rom_stream.done = end;
+}
+
+/* a streamed file has no extension to tell the hardware (load_rom()): a
+   Master System or Game Gear cartridge is the one without a Mega Drive header
+   but with a "TMR SEGA" one, whose region code tells the Game Gear apart */
+static int rom_stream_hw(void)
+{
+  static const int offsets[3] = {0x7ff0, 0x3ff0, 0x1ff0};
+  int i;
+
+  if (!memcmp((char *)(cart.rom + 0x100), "SEGA", 4) || !memcmp((char *)(cart.rom + 0x101), "SEGA", 4))
+  {
+    return SYSTEM_MD;
+  }
+
+  for (i = 0; i < 3; i++)
+  {
+    if (((offsets[i] + 16) <= rom_stream.received) && !memcmp((char *)(cart.rom + offsets[i]), "TMR SEGA", 8))
+    {
+      return ((cart.rom[offsets[i] + 15] >> 4) >= 5) ? SYSTEM_GG : SYSTEM_SMS2;
+    }
+  }
+
+  return SYSTEM_MD;
+}
+
+/* same checks as load_rom(), once enough of the file is there */
+static void rom_stream_detect(void)
+{
+  uint8 sega[4];
+  int i;
+
+  rom_stream.detected = 1;
+  rom_stream.hw = rom_stream_hw();
+  if (rom_stream.hw != SYSTEM_MD)
+  {
+    /* 8-bit cartridges are neither byte-swapped nor interleaved */
+    return;
+  }
+
+  rom_stream.swapped = !memcmp((char *)(cart.rom + 0x100),"ESAGM GE ARDVI E", 16) ||
+                       !memcmp((char *)(cart.rom + 0x100),"ESAGG NESESI", 12);
+  if (rom_stream.size >= 0x80110)
+  {
+    rom_stream.swapped |= !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGM GE ARDVI E", 16) ||
+                          !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGG NESESI", 12);
+  }
+
+  /* header check on the swapped back bytes */
+  for (i = 0; i < 4; i++)
+  {
+    sega[i] = cart.rom[0x100 + (i ^ rom_stream.swapped)];
+  }
+  rom_stream.smd = memcmp(sega, "SEGA", 4) && ((rom_stream.size / 512) & 1) && !(rom_stream.size % 512);
+}
+
+/* convert what has been received so far */
+static void rom_stream_update(void)
+{
+  int complete = (rom_stream.received == rom_stream.size);
+  int ready = rom_stream.received & ~1;
+
+  if (!rom_stream.detected)
+  {
+    if (!complete && (rom_stream.received < 0x80110))
+      return;
+    rom_stream_detect();
+  }
+
+  /* swap back byte-swapped dumps */
+  if (rom_stream.swapped)
+  {
+    for (; rom_stream.unswapped < (complete ? rom_stream.size : ready); rom_stream.unswapped += 2)
+    {
+      uint8 temp = cart.rom[rom_stream.unswapped];
+      cart.rom[rom_stream.unswapped] = cart.rom[rom_stream.unswapped + 1];
+      cart.rom[rom_stream.unswapped + 1] = temp;
+    }
+    ready = rom_stream.unswapped;
+  }
+
+  if (rom_stream.smd)
+  {
+    /* complete blocks, one block down from where they were received */
+    while ((512 + rom_stream.done + 0x4000) <= ready)
+    {
+      memmove(cart.rom + rom_stream.done, cart.rom + 512 + rom_stream.done, 0x4000);
+      deinterleave_block(cart.rom + rom_stream.done);
+      rom_stream_final(rom_stream.done, rom_stream.done + 0x4000);
+    }
+
+    /* the remainder is not interleaved */
+    if (complete)
+    {
+      memmove(cart.rom + rom_stream.done, cart.rom + 512 + rom_stream.done, rom_stream_romsize() - rom_stream.done);
+      rom_stream_final(rom_stream.done, rom_stream_romsize());
+    }
+  }
+  else
+  {
+    rom_stream_final(rom_stream.done, complete ? rom_stream.size : ready);
+  }
+}
+
+/* Start streaming a 'size' bytes ROM file; returns where its first bytes go,
+   NULL when it does not fit */
+uint8 *load_rom_stream_begin(int size)
+{
+#ifdef USE_DYNAMIC_ALLOC
+  if (!ext)
+  {
+    /* allocate & initialize memory for Cartridge / CD hardware if required */
+    ext = (external_t *)calloc(1, sizeof(external_t));
+    if (!ext) return NULL;
+  }
+#endif
+
+  memset(&rom_stream, 0, sizeof(rom_stream));
+
+  if ((size <= 0) || (size > MAXROMSIZE))
+  {
+    return NULL;
+  }
+
+  rom_stream.size = size;
+  return cart.rom;
+}
+
+/* 'len' more bytes of the file have been written; returns where the next ones
+   go, NULL once the file is complete */
+uint8 *load_rom_stream_write(int len)
+{
+  if (!rom_stream.size || (rom_stream.received == rom_stream.size))
+  {
+    return NULL;
+  }
+
+  rom_stream.received += len;
+  if (rom_stream.received > rom_stream.size)
+  {
+    rom_stream.received = rom_stream.size;
+  }
+
+  rom_stream_update();
+
+  return (rom_stream.received < rom_stream.size) ? (cart.rom + rom_stream.received) : NULL;
+}
+
+/* 1 when the streamed ROM needs hardware left out of MD_ONLY builds (Mega CD
+   BOOTROM, SVP cartridge, Master System or Game Gear cartridge), so that the
+   full core has to run it */
+int load_rom_stream_needs_full_core(void)
+{
+#ifdef MD_ONLY
+  char world[49];
+
+  if (!rom_stream.size || (rom_stream.done < 0x200))
+  {
+    return 0;
+  }
+
+  if (rom_stream.hw != SYSTEM_MD)
+  {
+    return 1;
+  }
+
+  memcpy(world, rom_stream.header + ROMWORLD, 48);
+  world[48] = 0;
+  return !memcmp(rom_stream.header + ROMTYPE, "BR", 2) || (strstr(world, "Virtua Racing") != NULL);
+#else
+  return 0;
+#endif
+}
+
 /***************************************************************************
  *
  * Pass a pointer to the ROM base address.
@@ -283,7 +519,7 @@ void getrominfo(char *romheader)
 #ifdef LSB_FIRST
     rominfo.checksum =  (rominfo.checksum >> 8) | ((rominfo.checksum & 0xff) << 8);
 #endif
-    rominfo.realchecksum = getchecksum(((uint8 *) cart.rom) + 0x200, cart.romsize - 0x200);
+    rominfo.realchecksum = rom_stream.size ? rom_stream.checksum : getchecksum(((uint8 *) cart.rom) + 0x200, cart.romsize - 0x200);
 
     /* Supported peripherals */
     rominfo.peripherals = 0;
@@ -561,12 +797,14 @@ int load_rom(char *filename)
   ggenie_shutdown();
   areplay_shutdown();
 
+#ifndef MD_ONLY
   /* check previous loaded ROM size */
   if (cart.romsize > 0x800000)
   {
     /* assume no CD is currently loaded */
     cdd.loaded = 0;
   }
+#endif
 
   /* auto-detect CD image file */
 #ifndef WASM_GENPLUS
@@ -576,6 +814,13 @@ int load_rom(char *filename)
     /* error opening file */
     return (0);
   }
+#elif !defined(MD_ONLY)
+  /* WASM: disc image streamed from the front-end (cdstream.h), if one is mounted */
+  size = cd_stream_image() ? cdd_load(cd_stream_image(), (char *)(cart.rom)) : 0;
+  if (size < 0)
+  {
+    return (0);
+  }
 #else
   size = 0;
 #endif
@@ -591,9 +836,27 @@ int load_rom(char *filename)
   }
   else
   {
-    /* load file into ROM buffer */
     char extension[4];
-    size = load_archive(filename, cart.rom, cdd.loaded ? 0x800000 : MAXROMSIZE, extension);
+
+    if (rom_stream.size)
+    {
+      /* streamed ROM, already converted */
+      if (rom_stream.done < rom_stream_romsize())
+      {
+        return 0;
+      }
+      size = rom_stream_romsize();
+      strcpy(extension, (rom_stream.hw == SYSTEM_GG) ? ".GG" : ((rom_stream.hw == SYSTEM_SMS2) ? "SMS" : "BIN"));
+    }
+    else
+    {
+      /* load file into ROM buffer */
+#ifdef MD_ONLY
+      size = load_archive(filename, cart.rom, MAXROMSIZE, extension);
+#else
+      size = load_archive(filename, cart.rom, cdd.loaded ? 0x800000 : MAXROMSIZE, extension);
+#endif
+    }
 
     /* mark BOOTROM as unloaded if they have been overwritten by cartridge ROM */
     if (size > 0x800000)
@@ -650,10 +913,11 @@ int load_rom(char *filename)
       }
 
       /* auto-detect byte-swapped dumps */
-      if (!memcmp((char *)(cart.rom + 0x100),"ESAGM GE ARDVI E", 16) ||
-          !memcmp((char *)(cart.rom + 0x100),"ESAGG NESESI", 12) ||
-          !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGM GE ARDVI E", 16) ||
-          !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGG NESESI", 12))
+      if (!rom_stream.size &&
+          (!memcmp((char *)(cart.rom + 0x100),"ESAGM GE ARDVI E", 16) ||
+           !memcmp((char *)(cart.rom + 0x100),"ESAGG NESESI", 12) ||
+           !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGM GE ARDVI E", 16) ||
+           !memcmp((char *)(cart.rom + 0x80000 + 0x100),"ESAGG NESESI", 12)))
       {
         for(i = 0; i < size; i += 2)
         {
@@ -665,7 +929,7 @@ int load_rom(char *filename)
     }
 
     /* auto-detect 512 byte extra header */
-    if (memcmp((char *)(cart.rom + 0x100), "SEGA", 4) && ((size / 512) & 1) && !(size % 512))
+    if (!rom_stream.size && memcmp((char *)(cart.rom + 0x100), "SEGA", 4) && ((size / 512) & 1) && !(size % 512))
     {
       /* remove header */
       size -= 512;
@@ -686,14 +950,14 @@ int load_rom(char *filename)
   cart.romsize = size;
 
   /* get infos from ROM header */
-  getrominfo((char *)(cart.rom));
+  getrominfo(rom_stream.size ? (char *)(rom_stream.header) : (char *)(cart.rom));
 
   /* set console region */
-  get_region((char *)(cart.rom));
+  get_region(rom_stream.size ? (char *)(rom_stream.header) : (char *)(cart.rom));
 
 #ifdef LSB_FIRST
-  /* 16-bit ROM specific */
-  if (system_hw == SYSTEM_MD)
+  /* 16-bit ROM specific (streamed ROMs are byteswapped as they arrive) */
+  if ((system_hw == SYSTEM_MD) && !rom_stream.size)
   {
     /* Byteswap ROM to optimize 16-bit access */
     for (i = 0; i < cart.romsize; i += 2)
@@ -715,6 +979,7 @@ int load_rom(char *filename)
   /* Save auto-detected system hardware  */
   romtype = system_hw;
   
+#ifndef MD_ONLY
   /* CD image file */
   if (system_hw == SYSTEM_MCD)
   {   
@@ -795,6 +1060,7 @@ int load_rom(char *filename)
       }
     }
   }
+#endif
 
   /* Force system hardware if requested */
   if (config.system == SYSTEM_MD)
@@ -818,6 +1084,19 @@ int load_rom(char *filename)
     system_hw = config.system;
   }
 
+#ifdef MD_ONLY
+  /* Mega CD, SVP and 8-bit hardware are only in the full core */
+  if (((system_hw != SYSTEM_MD) && (system_hw != SYSTEM_PICO)) || (strstr(rominfo.ROMType, "BR") != NULL) ||
+      (strstr(rominfo.international, "Virtua Racing") != NULL))
+  {
+    error("load_rom: %s needs the full core\n", filename);
+
+    /* never start the missing hardware */
+    system_hw = romtype = SYSTEM_MD;
+    return (0);
+  }
+#endif
+
   /* restore previous input settings */
   if (old_system[0] != -1)
   {
@@ -41,8 +41,12 @@
 #define _LOADROM_H_
 
 #ifndef MAXROMSIZE
+#ifdef MD_ONLY
+#define MAXROMSIZE 0x840000 /* 8MB ROM, then SRAM, Game Genie and Action Replay (cart_hw/) */
+#else
 #define MAXROMSIZE 10485760
 #endif
+#endif
 
 typedef struct
 {
@@ -72,6 +76,9 @@ extern void get_region(char *romheader);
 extern char *get_company(void);
 extern char *get_peripheral(int index);
 extern void getrominfo(char *romheader);
+extern uint8 *load_rom_stream_begin(int size);
+extern uint8 *load_rom_stream_write(int len);
+extern int load_rom_stream_needs_full_core(void);
 
 #endif /* _LOADROM_H_ */
 
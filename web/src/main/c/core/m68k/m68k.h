@@ -41,11 +41,16 @@
 /* ================================ INCLUDES ============================== */
 /* ======================================================================== */
 
-#include <setjmp.h>
 #include "macros.h"
 #ifdef HOOK_CPU
 #include "cpuhook.h"
 #endif
+#ifdef CHAOS_BUS_NOISE
+#include "chaos_bus.h"
+#endif
+#ifdef CHAOS_PC_PROFILE
+#include "pcprof.h"
+#endif
 
 /* ======================================================================== */
 /* ==================== ARCHITECTURE-DEPENDANT DEFINES ==================== */
@@ -259,10 +264,14 @@ typedef struct
   uint pref_addr;       /* Last prefetch address */
   uint pref_data;       /* Data in the prefetch queue */
 
+  uint fetch_bank;      /* 64KB bank of the last instruction fetch, 0x100 for none */
+  unsigned char *fetch_base; /* its memory map base */
+
   uint instr_mode;      /* Stores whether we are in instruction mode or group 0/1 exception mode */
   uint run_mode;        /* Stores whether we are processing a reset, bus error, address error, or something else */
   uint aerr_enabled;    /* Enables/deisables address error checks at runtime */
-  jmp_buf aerr_trap;    /* Address error jump */
+  uint aerr_pending;    /* Address error raised by the current instruction (taken at its end) */
+  uint aerr_pc;         /* PC when it was raised */
   uint aerr_address;    /* Address error location */
   uint aerr_write_mode; /* Address error write mode */
   uint aerr_fc;         /* Address error FC code */
@@ -271,6 +280,9 @@ typedef struct
 
   uint address_space;   /* Current FC code */
 
+  uint faults;          /* Error exceptions taken (address error, illegal, line A/F, privilege), free running */
+  uint lockups;         /* Lockup area accesses (mem68k.c), free running */
+
 #ifdef M68K_OVERCLOCK_SHIFT
   int cycle_ratio;
 #endif
@@ -353,6 +365,9 @@ void m68k_set_fc_callback(void  (*callback)(unsigned int new_fc));
 extern void m68k_init(void);
 extern void s68k_init(void);
 
+/* Add the decode cache to the memory report (memmap.h) */
+extern void m68k_memory_report(void);
+
 /* Pulse the RESET pin on the CPU.
  * You *MUST* reset the CPU at least once to initialize the emulation
  */
@@ -363,10 +378,96 @@ extern void s68k_pulse_reset(void);
 extern void m68k_run(unsigned int cycles);
 extern void s68k_run(unsigned int cycles);
 
+/* End the running m68k_run() at the given cycle count instead, if it is earlier */
+extern void m68k_end_timeslice(unsigned int cycles);
+
+/* Cycle timer: m68k_run() stops at the given cycle count (the first run ending
+ * past it, if the CPU is already further), calls 'callback' with the count
+ * reached and goes on to its end. The timer is disarmed first, so the callback can set the next one.
+ * The callback runs in the middle of a line: before touching the VDP it must
+ * call RENDER_SYNC() and VDP_RUN_FLUSH(), like the line hooks of system.c.
+ * M68K_TIMER_OFF or a NULL callback disarms it; disarmed, it costs one compare
+ * per m68k_run().
+ */
+#define M68K_TIMER_OFF 0xffffffff
+extern void m68k_set_timer(unsigned int cycles, void (*callback)(unsigned int cycles));
+
 /* Get current instruction execution time */
 extern int m68k_cycles(void);
 extern int s68k_cycles(void);
 
+/* Instruction fetches look the memory map up again after the PC or the
+ * map was changed from outside the CPU while it runs (between two runs
+ * this is done anyway) */
+extern void m68k_fetch_invalidate(void);
+
+/* Decode cache (M68K_DECODE_CACHE): area treated as read-only, and
+ * invalidation after it was modified (cheat patches, ROM loading)
+ */
+extern void m68k_cache_set_rom(const unsigned char *rom, unsigned int size);
+extern void m68k_cache_flush(void);
+
+/* Cartridge ROM pages (4KB) instructions were decoded from since
+ * m68k_cache_set_rom(): bit (offset >> 12) & 7 of byte offset >> 15, for
+ * the 16MB the 68k can address. NULL without the decode cache.
+ */
+#define M68K_CACHE_PAGE_SHIFT 12
+extern const unsigned char *m68k_cache_pages(void);
+
+/* Marks the pages set in the first 'size' bytes of 'bits' (same layout) as
+ * decoded from, as if their code had run (learned profile) */
+extern void m68k_cache_mark_pages(const unsigned char *bits, int size);
+
+/* Trace compiler (M68K_JIT). The callback gets the trace slot, the host base of
+ * its bank and 'count' instructions as (pc, opcode, handler) triplets, and returns
+ * a function running them, or NULL. Like m68k_run(), the function sets REG_IR and
+ * REG_PC and calls the handler (which uses up its cycles) for each instruction;
+ * it returns after the first one that leaves the trace, changes the bank base or
+ * reaches the target cycle count. m68k_jit_layout() returns the addresses it
+ * needs, indexed as below.
+ */
+enum
+{
+  M68K_JIT_PC,            /* REG_PC */
+  M68K_JIT_IR,            /* REG_IR */
+  M68K_JIT_CYCLES,        /* current master cycle count */
+  M68K_JIT_END,           /* target cycle count of the running m68k_run() */
+  M68K_JIT_MEMORY_MAP,    /* memory_map[0].base */
+  M68K_JIT_MAP_STRIDE,    /* sizeof(cpu_memory_map) */
+  M68K_JIT_LAYOUT_SIZE
+};
+
+typedef void (*m68k_jit_block)(void);
+
+/* Trace compiler warm start (learned profile): m68k_jit_hot() stores the PCs
+ * of up to 'max' compiled traces in 'pcs' and returns their count; a trace
+ * started later at one of the PCs given to m68k_jit_warm() (M68K_JIT_WARM at
+ * most) is compiled on its second entry instead of its M68K_JIT_THRESHOLD-th.
+ * m68k_cache_set_rom() forgets them. Nothing happens without M68K_JIT.
+ */
+#define M68K_JIT_WARM 256
+extern int m68k_jit_hot(unsigned int *pcs, int max);
+extern void m68k_jit_warm(const unsigned int *pcs, int count);
+extern void m68k_set_jit_callback(m68k_jit_block (*callback)(int slot, const unsigned char *base, const unsigned int *ops, int count));
+extern const unsigned int *m68k_jit_layout(void);
+
+/* Idle loop skipping (M68K_IDLE_SKIP): loops which only read RAM or ROM
+ * (M68K_IDLE_RAM) are skipped exactly, as nothing else can modify them while
+ * m68k_run() executes; M68K_IDLE_VDP also skips loops polling the VDP status
+ * port, whose HBLANK, FIFO and DMA bits do change within a line (per-game
+ * setting). m68k_idle_skipped() returns the master cycles skipped since its
+ * previous call.
+ */
+enum
+{
+  M68K_IDLE_OFF,
+  M68K_IDLE_RAM,
+  M68K_IDLE_VDP
+};
+
+extern void m68k_idle_skip(int mode);
+extern unsigned int m68k_idle_skipped(void);
+
 /* Set the IPL0-IPL2 pins on the CPU (IRQ).
  * A transition from < 7 to 7 will cause a non-maskable interrupt (NMI).
  * Setting IRQ to 0 will clear an interrupt request.
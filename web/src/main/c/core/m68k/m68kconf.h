@@ -72,6 +72,61 @@
  */
 #define M68K_CHECK_PC_ADDRESS_ERROR OPT_OFF
 
+/* If ON, instructions executed from cartridge ROM (see m68k_cache_set_rom())
+ * are decoded once into traces of up to M68K_CACHE_OPS instructions, which
+ * m68k_run() replays without fetching the opcode and looking up its handler.
+ * Anything modifying the ROM area must call m68k_cache_flush().
+ */
+#ifndef M68K_DECODE_CACHE
+#define M68K_DECODE_CACHE           OPT_ON
+#endif
+#define M68K_CACHE_BLOCKS           512
+#define M68K_CACHE_OPS              32
+
+/* If ON (and the decode cache is), traces entered M68K_JIT_THRESHOLD times are
+ * passed to the callback set with m68k_set_jit_callback(), which may return a
+ * compiled function replaying them (WASM: see jit.js).
+ */
+#ifndef M68K_JIT
+#define M68K_JIT                    OPT_OFF
+#endif
+#define M68K_JIT_THRESHOLD          64
+
+/* If ON, a pass of a loop that only read memory (or the VDP status port, see
+ * m68k_idle_skip()) and ended with the registers it started with is repeated
+ * without interpreting it again until the end of m68k_run() (OFF with the CPU
+ * hook or bus noise, which would miss the accesses of the skipped passes).
+ */
+#ifndef M68K_IDLE_SKIP
+#if defined(HOOK_CPU) || defined(CHAOS_BUS_NOISE)
+#define M68K_IDLE_SKIP              OPT_OFF
+#else
+#define M68K_IDLE_SKIP              OPT_ON
+#endif
+#endif
+
+/* If ON, data reads count down to the bus noise faults of their region
+ * (main CPU only, see wasm/chaos_bus.h).
+ */
+#ifndef M68K_BUS_NOISE
+#ifdef CHAOS_BUS_NOISE
+#define M68K_BUS_NOISE              OPT_ON
+#else
+#define M68K_BUS_NOISE              OPT_OFF
+#endif
+#endif
+
+/* If ON, m68k_run() hands the PC to the sampling profiler at its sample
+ * points (main CPU only, see debug/pcprof.h).
+ */
+#ifndef M68K_PC_PROFILE
+#ifdef CHAOS_PC_PROFILE
+#define M68K_PC_PROFILE             OPT_ON
+#else
+#define M68K_PC_PROFILE             OPT_OFF
+#endif
+#endif
+
 
 /* ----------------------------- COMPATIBILITY ---------------------------- */
 
@@ -86,6 +141,15 @@
 #define M68K_USE_64_BIT  OPT_OFF
 
 
+/* If ON, the carry of 32-bit ADD, SUB, CMP and NEG is bit 32 of the 64-bit
+ * result (a native type under WASM and on 64-bit hosts) instead of being
+ * rebuilt from the operand and result MSBs. The condition codes stay eager:
+ * the core already stores them unnormalized (Z is the result, N and C are
+ * shifted results), so a lazy record would cost as many stores as it saves.
+ */
+#define M68K_CARRY_64  OPT_ON
+
+
 /* ======================================================================== */
 /* ============================== END OF FILE ============================= */
 /* ======================================================================== */
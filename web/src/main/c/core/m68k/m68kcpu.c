@@ -18,6 +18,7 @@ extern int vdp_68k_irq_ack(int int_level);
 #include "m68kconf.h"
 #include "m68kcpu.h"
 #include "m68kops.h"
+#include "memmap.h"
 
 /* ======================================================================== */
 /* ================================= DATA ================================= */
@@ -31,6 +32,66 @@ static int irq_latency;
 
 m68ki_cpu_core m68k;
 
+/* cycle timer (m68k_set_timer()) and end of the m68k_run() it splits */
+static uint m68ki_timer_cycle = M68K_TIMER_OFF;
+static void (*m68ki_timer_callback)(unsigned int cycles);
+static uint m68ki_run_end;
+
+#if M68K_DECODE_CACHE
+/* Decoded instruction: opcode and handler of the instruction at 'pc' */
+typedef struct
+{
+  void (*handler)(void);  /* NULL until executed once */
+  uint pc;                /* odd: end of trace */
+  uint ir;
+} m68ki_cached_op;
+
+/* Trace of the instructions executed from one PC in a ROM bank, in execution order.
+ * Each op also records the PC the next one starts at: a branch taken differently
+ * simply ends the trace there.
+ */
+typedef struct
+{
+  unsigned char *base;    /* bank mapping the trace was decoded from */
+#if M68K_JIT
+  uint hits;              /* times the trace was entered */
+  m68k_jit_block compiled;
+#endif
+  m68ki_cached_op op[M68K_CACHE_OPS + 1];
+} m68ki_cached_block;
+
+static m68ki_cached_block m68ki_cache[M68K_CACHE_BLOCKS];
+static m68ki_cached_block *m68ki_cache_block;
+static m68ki_cached_op m68ki_cache_miss = { NULL, 1, 0 };
+static m68ki_cached_op *m68ki_cache_op = &m68ki_cache_miss;
+static unsigned char *m68ki_cache_base;
+
+/* cacheable area (cartridge ROM) */
+static const unsigned char *m68ki_cache_rom;
+static unsigned int m68ki_cache_rom_size;
+
+/* ROM pages instructions were decoded from (m68k_cache_pages()) */
+static unsigned char m68ki_cache_page_bits[0x1000000 >> (M68K_CACHE_PAGE_SHIFT + 3)];
+
+#if M68K_JIT
+#if defined(HOOK_CPU) || M68K_EMULATE_TRACE
+#error "M68K_JIT: compiled traces do not call the CPU hook"
+#endif
+/* compiled traces do not scale their cycles: run interpreted at another clock */
+#ifdef M68K_OVERCLOCK_SHIFT
+#define m68ki_jit_clock() (m68ki_cpu.cycle_ratio == (1 << M68K_OVERCLOCK_SHIFT))
+#else
+#define m68ki_jit_clock() 1
+#endif
+static m68k_jit_block (*m68ki_jit_callback)(int slot, const unsigned char *base, const unsigned int *ops, int count);
+static unsigned int m68ki_jit_ops[M68K_CACHE_OPS * 3];
+static uint m68ki_jit_warm_pcs[M68K_JIT_WARM];  /* sorted */
+static int m68ki_jit_warm_count;
+static unsigned int m68ki_jit_layout[M68K_JIT_LAYOUT_SIZE];
+static uint m68ki_jit_end;
+#endif
+#endif
+
 
 /* ======================================================================== */
 /* =============================== CALLBACKS ============================== */
@@ -72,6 +133,239 @@ static void default_set_fc_callback(unsigned int new_fc)
 #endif
 
 
+/* ======================================================================== */
+/* ============================= DECODE CACHE ============================= */
+/* ======================================================================== */
+
+#if M68K_DECODE_CACHE
+/* ROM bytes at 'pc' are only modified through m68k_cache_flush() callers */
+INLINE int m68ki_cache_rom_pc(unsigned char *base, uint pc)
+{
+  return !(pc & 1) && ((size_t)(base + (pc & 0xffff) - m68ki_cache_rom) < m68ki_cache_rom_size);
+}
+
+#if M68K_JIT
+/* Hand the decoded part of a hot trace to the compiler */
+static void m68ki_jit_compile(m68ki_cached_block *block)
+{
+  int count = 0;
+
+  while ((count < M68K_CACHE_OPS) && block->op[count].handler && !(block->op[count].pc & 1))
+  {
+    m68ki_jit_ops[count * 3 + 0] = block->op[count].pc;
+    m68ki_jit_ops[count * 3 + 1] = block->op[count].ir;
+    m68ki_jit_ops[count * 3 + 2] = (unsigned int)(size_t)block->op[count].handler;
+    count++;
+  }
+
+  block->compiled = m68ki_jit_callback(block - m68ki_cache, block->base, m68ki_jit_ops, count);
+}
+
+/* Hits a new trace at 'pc' starts with: one entry short of compiling when it was hot before */
+static uint m68ki_jit_start_hits(uint pc)
+{
+  int low = 0, high = m68ki_jit_warm_count;
+
+  while (low < high)
+  {
+    int mid = (low + high) >> 1;
+    if (m68ki_jit_warm_pcs[mid] < pc)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return ((low < m68ki_jit_warm_count) && (m68ki_jit_warm_pcs[low] == pc)) ? (M68K_JIT_THRESHOLD - 1) : 0;
+}
+#endif
+
+/* Trace starting at PC, or the miss slot if PC is not in ROM */
+static m68ki_cached_op *m68ki_cache_lookup(void)
+{
+  uint pc = REG_PC;
+  cpu_memory_map *map = &m68ki_cpu.memory_map[(pc >> 16) & 0xff];
+  unsigned char *base = map->base;
+  m68ki_cached_block *block;
+
+  /* not ROM, or write-enabled ROM (direct writes) */
+  if (!map->write16 || !m68ki_cache_rom_pc(base, pc))
+  {
+    return &m68ki_cache_miss;
+  }
+
+  block = &m68ki_cache[(pc >> 1) & (M68K_CACHE_BLOCKS - 1)];
+  if ((block->op[0].pc != pc) || (block->base != base))
+  {
+    /* start a new trace (replaces the one using this slot) */
+    block->base = base;
+    block->op[0].pc = pc;
+    block->op[0].handler = NULL;
+#if M68K_JIT
+    block->hits = m68ki_jit_warm_count ? m68ki_jit_start_hits(pc) : 0;
+    block->compiled = NULL;
+#endif
+  }
+#if M68K_JIT
+  else if ((++block->hits == M68K_JIT_THRESHOLD) && m68ki_jit_callback)
+  {
+    m68ki_jit_compile(block);
+  }
+#endif
+
+  m68ki_cache_block = block;
+  m68ki_cache_base = base;
+  return block->op;
+}
+
+/* Instruction 'op' was decoded and executed: continue the trace at the new PC */
+static void m68ki_cache_record(m68ki_cached_op *op)
+{
+  m68ki_cached_block *block = m68ki_cache_block;
+  uint pc = REG_PC;
+
+  /* the trace ends when it is full, loops back to its start or leaves the bank */
+  if ((op + 1 < &block->op[M68K_CACHE_OPS]) && (pc != block->op[0].pc) &&
+      !((pc ^ block->op[0].pc) & 0xff0000) && m68ki_cache_rom_pc(block->base, pc))
+  {
+    op[1].pc = pc;
+    op[1].handler = NULL;
+    m68ki_cache_op = op + 1;
+  }
+}
+#endif
+
+void m68k_cache_set_rom(const unsigned char *rom, unsigned int size)
+{
+#if M68K_DECODE_CACHE
+  m68ki_cache_rom = rom;
+  m68ki_cache_rom_size = size;
+  memset(m68ki_cache_page_bits, 0, sizeof(m68ki_cache_page_bits));
+#if M68K_JIT
+  m68ki_jit_warm_count = 0;
+#endif
+  m68k_cache_flush();
+#endif
+}
+
+void m68k_cache_mark_pages(const unsigned char *bits, int size)
+{
+#if M68K_DECODE_CACHE
+  int i;
+
+  if (size > (int)sizeof(m68ki_cache_page_bits))
+    size = sizeof(m68ki_cache_page_bits);
+  for (i = 0; i < size; i++)
+    m68ki_cache_page_bits[i] |= bits[i];
+#endif
+}
+
+const unsigned char *m68k_cache_pages(void)
+{
+#if M68K_DECODE_CACHE
+  return m68ki_cache_page_bits;
+#else
+  return NULL;
+#endif
+}
+
+void m68k_fetch_invalidate(void)
+{
+  m68ki_fetch_invalidate();
+}
+
+void m68k_cache_flush(void)
+{
+#if M68K_DECODE_CACHE
+  int i;
+
+  /* traces are only entered through their first op */
+  for (i = 0; i < M68K_CACHE_BLOCKS; i++)
+  {
+    m68ki_cache[i].op[0].pc = 1;
+    m68ki_cache[i].op[M68K_CACHE_OPS].pc = 1;
+#if M68K_JIT
+    m68ki_cache[i].compiled = NULL;
+#endif
+  }
+
+  m68ki_cache_op = &m68ki_cache_miss;
+#endif
+}
+
+void m68k_set_jit_callback(m68k_jit_block (*callback)(int slot, const unsigned char *base, const unsigned int *ops, int count))
+{
+#if M68K_DECODE_CACHE && M68K_JIT
+  m68ki_jit_callback = callback;
+  m68k_cache_flush();
+#endif
+}
+
+int m68k_jit_hot(unsigned int *pcs, int max)
+{
+  int count = 0;
+#if M68K_DECODE_CACHE && M68K_JIT
+  int i;
+
+  for (i = 0; (i < M68K_CACHE_BLOCKS) && (count < max); i++)
+  {
+    if (m68ki_cache[i].compiled && !(m68ki_cache[i].op[0].pc & 1))
+      pcs[count++] = m68ki_cache[i].op[0].pc;
+  }
+#endif
+  return count;
+}
+
+void m68k_jit_warm(const unsigned int *pcs, int count)
+{
+#if M68K_DECODE_CACHE && M68K_JIT
+  int i, j;
+
+  if (count > M68K_JIT_WARM)
+    count = M68K_JIT_WARM;
+  for (i = 0; i < count; i++)
+  {
+    for (j = i; (j > 0) && (m68ki_jit_warm_pcs[j - 1] > pcs[i]); j--)
+      m68ki_jit_warm_pcs[j] = m68ki_jit_warm_pcs[j - 1];
+    m68ki_jit_warm_pcs[j] = pcs[i];
+  }
+  m68ki_jit_warm_count = count;
+#endif
+}
+
+const unsigned int *m68k_jit_layout(void)
+{
+#if M68K_DECODE_CACHE && M68K_JIT
+  m68ki_jit_layout[M68K_JIT_PC] = (unsigned int)(size_t)&REG_PC;
+  m68ki_jit_layout[M68K_JIT_IR] = (unsigned int)(size_t)&REG_IR;
+  m68ki_jit_layout[M68K_JIT_CYCLES] = (unsigned int)(size_t)&m68ki_cpu.cycles;
+  m68ki_jit_layout[M68K_JIT_END] = (unsigned int)(size_t)&m68ki_jit_end;
+  m68ki_jit_layout[M68K_JIT_MEMORY_MAP] = (unsigned int)(size_t)&m68ki_cpu.memory_map[0].base;
+  m68ki_jit_layout[M68K_JIT_MAP_STRIDE] = sizeof(cpu_memory_map);
+  return m68ki_jit_layout;
+#else
+  return NULL;
+#endif
+}
+
+void m68k_idle_skip(int mode)
+{
+#if M68K_IDLE_SKIP
+  m68ki_idle.mode = mode;
+  m68ki_idle.pc = 1;
+#endif
+}
+
+unsigned int m68k_idle_skipped(void)
+{
+#if M68K_IDLE_SKIP
+  unsigned int skipped = m68ki_idle.skipped;
+  m68ki_idle.skipped = 0;
+  return skipped;
+#else
+  return 0;
+#endif
+}
+
+
 /* ======================================================================== */
 /* ================================= API ================================== */
 /* ======================================================================== */
@@ -218,6 +512,14 @@ void m68k_set_irq(unsigned int int_level)
 #endif
 }
 
+#if M68K_EMULATE_ADDRESS_ERROR
+/* Address error left pending by the last instruction run (see m68kcpu.h), taken
+ * before any interrupt check */
+#define m68ki_take_address_error() if (m68ki_cpu.aerr_pending) m68ki_exception_address_error();
+#else
+#define m68ki_take_address_error()
+#endif
+
 /* IRQ latency (Fatal Rewind, Sesame's Street Counting Cafe)*/
 void m68k_set_irq_delay(unsigned int int_level)
 {
@@ -229,8 +531,10 @@ void m68k_set_irq_delay(unsigned int int_level)
     /* the middle of its execution (first memory write).                   */
     if ((REG_IR & 0xF000) != 0x2000)
     {
-      /* Finish executing current instruction */
+      /* Finish executing current instruction (its handler adds the cycles again when it returns) */
+      uint cycles = m68ki_cpu.cycles;
       USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+      cycles = m68ki_cpu.cycles - cycles;
 
       /* One instruction delay before interrupt */
       irq_latency = 1;
@@ -239,6 +543,8 @@ void m68k_set_irq_delay(unsigned int int_level)
       REG_IR = m68ki_read_imm_16();
       m68ki_instruction_jump_table[REG_IR]();
       m68ki_exception_if_trace() /* auto-disable (see m68kcpu.h) */
+      m68ki_take_address_error()
+      m68ki_cpu.cycles -= cycles;
       irq_latency = 0;
     }
 
@@ -256,12 +562,35 @@ void m68k_set_irq_delay(unsigned int int_level)
 
 void m68k_run(unsigned int cycles) 
 {
+  /* Timer due in this slice: run up to it, fire it, then go on (the inner
+     run ends on the cycle_end check like any other) */
+  while (m68ki_timer_cycle < cycles)
+  {
+    uint at = m68ki_timer_cycle;
+
+    m68ki_run_end = cycles;
+    m68k_run(at);
+
+    /* m68k_end_timeslice() stopped it first */
+    if (m68k.cycles < at)
+    {
+      return;
+    }
+
+    m68ki_timer_cycle = M68K_TIMER_OFF;
+    m68ki_timer_callback(m68k.cycles);
+    cycles = m68ki_run_end;
+  }
+
   /* Make sure CPU is not already ahead */
   if (m68k.cycles >= cycles)
   {
     return;
   }
 
+  /* Address error raised by the last instruction of the previous slice */
+  m68ki_take_address_error()
+
   /* Check interrupt mask to process IRQ if needed */
   m68ki_check_interrupts();
 
@@ -275,37 +604,182 @@ void m68k_run(unsigned int cycles)
   /* Save end cycles count for when CPU is stopped */
   m68k.cycle_end = cycles;
 
-  /* Return point for when we have an address error (TODO: use goto) */
-  m68ki_set_address_error_trap() /* auto-disable (see m68kcpu.h) */
+#if M68K_IDLE_SKIP
+  /* memory may have been modified since the last call */
+  m68ki_idle.dirty = 1;
+#endif
+
+  /* so may the memory map (mappers, state load, chaos effects) */
+  m68ki_fetch_invalidate();
+
+#if M68K_PC_PROFILE
+  pcprof_enter(m68k.cycles);
+#endif
 
 #ifdef LOGERROR
   error("[%d][%d] m68k run to %d cycles (%x), irq mask = %x (%x)\n", v_counter, m68k.cycles, cycles, m68k.pc,FLAG_INT_MASK, CPU_INT_LEVEL);
 #endif
 
-  while (m68k.cycles < cycles)
+  /* cycle_end rather than 'cycles': m68k_end_timeslice() can bring it forward */
+  while (m68k.cycles < m68k.cycle_end)
   {
+#if M68K_DECODE_CACHE
+    m68ki_cached_op *op;
+#endif
+
+#if M68K_EMULATE_ADDRESS_ERROR
+    /* Address error raised by the previous instruction (or an interrupt frame) */
+    if (m68ki_cpu.aerr_pending)
+    {
+      m68ki_exception_address_error();
+      if (CPU_STOPPED)
+        break;
+
+      /* interrupt held back while it was pending */
+      m68ki_check_interrupts();
+    }
+#endif
+
     /* Set tracing accodring to T1. */
     m68ki_trace_t1() /* auto-disable (see m68kcpu.h) */
 
     /* Set the address space for reads */
     m68ki_use_data_space() /* auto-disable (see m68kcpu.h) */
 
+#if M68K_PC_PROFILE
+    /* Sample point passed (one compare per instruction) */
+    if (m68k.cycles >= pcprof_next)
+      pcprof_sample(REG_PC, m68k.cycles);
+#endif
+
 #ifdef HOOK_CPU
     /* Trigger execution hook */
-    if (cpu_hook)
+    if (cpu_hook_page(HOOK_PAGE_E, REG_PC))
       cpu_hook(HOOK_M68K_E, 0, REG_PC, 0);
 #endif
 
+#if M68K_DECODE_CACHE
+    /* Next cached instruction of the trace, or find the trace starting at PC */
+    op = m68ki_cache_op;
+    if ((op->pc != REG_PC) || (m68ki_cpu.memory_map[(REG_PC >> 16) & 0xff].base != m68ki_cache_base))
+    {
+      op = m68ki_cache_lookup();
+
+#if M68K_JIT
+      /* Compiled trace: runs until it leaves the trace or the cycle count is reached */
+      if ((op != &m68ki_cache_miss) && m68ki_cache_block->compiled && m68ki_jit_clock())
+      {
+        m68ki_jit_end = m68k.cycle_end;
+        m68ki_cache_op = &m68ki_cache_miss;
+        m68ki_cache_block->compiled();
+        m68ki_fetch_invalidate();
+        continue;
+      }
+#endif
+    }
+
+    if (op->handler)
+    {
+      /* Already decoded */
+      REG_IR = op->ir;
+      REG_PC += 2;
+      m68ki_cache_op = op + 1;
+      op->handler();
+    }
+    else
+    {
+      /* Decode next instruction */
+      REG_IR = m68ki_read_imm_16();
+      m68ki_cache_op = &m68ki_cache_miss;
+
+      /* Add it to the trace (ended first, in case the instruction does not return) */
+      if (op != &m68ki_cache_miss)
+      {
+        uint page = (uint)(m68ki_cache_base + (op->pc & 0xffff) - m68ki_cache_rom) >> M68K_CACHE_PAGE_SHIFT;
+        m68ki_cache_page_bits[page >> 3] |= 1 << (page & 7);
+        op->ir = REG_IR;
+        op->handler = m68ki_instruction_jump_table[REG_IR];
+        op[1].pc = 1;
+        m68ki_instruction_jump_table[REG_IR]();
+        m68ki_cache_record(op);
+      }
+      else
+      {
+        m68ki_instruction_jump_table[REG_IR]();
+      }
+    }
+#else
     /* Decode next instruction */
     REG_IR = m68ki_read_imm_16();
 
-    /* Execute instruction */
+    /* Execute instruction (the handler uses up its cycles) */
     m68ki_instruction_jump_table[REG_IR]();
-    USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+#endif
 
     /* Trace m68k_exception, if necessary */
     m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
   }
+
+#if M68K_PC_PROFILE
+  pcprof_leave(REG_PC, m68k.cycles);
+#endif
+}
+
+#if M68K_EMULATE_ADDRESS_ERROR
+/* Odd word or long access (or any once one is pending): returns 1 if it must be
+ * dropped. The first one is recorded for the exception frame, which m68k_run()
+ * stacks once the instruction has returned.
+ */
+static int m68ki_address_error(uint address, uint write_mode, uint fc)
+{
+  if (m68ki_cpu.aerr_pending)
+  {
+    return 1;
+  }
+
+  if (!m68ki_cpu.aerr_enabled)
+  {
+    return 0;
+  }
+
+  m68ki_cpu.aerr_pending = 1;
+  m68ki_cpu.aerr_pc = REG_PC;
+  m68ki_cpu.aerr_address = address;
+  m68ki_cpu.aerr_write_mode = write_mode;
+  m68ki_cpu.aerr_fc = fc;
+
+#if M68K_JIT
+  /* a compiled trace returns after this instruction */
+  m68ki_jit_end = 0;
+#endif
+
+  return 1;
+}
+#endif
+
+void m68k_end_timeslice(unsigned int cycles)
+{
+  if (cycles < m68ki_run_end)
+  {
+    m68ki_run_end = cycles;
+  }
+
+  if (cycles < m68k.cycle_end)
+  {
+    m68k.cycle_end = cycles;
+#if M68K_JIT
+    if (cycles < m68ki_jit_end)
+    {
+      m68ki_jit_end = cycles;
+    }
+#endif
+  }
+}
+
+void m68k_set_timer(unsigned int cycles, void (*callback)(unsigned int cycles))
+{
+  m68ki_timer_cycle = callback ? cycles : M68K_TIMER_OFF;
+  m68ki_timer_callback = callback;
 }
 
 int m68k_cycles(void)
@@ -344,6 +818,13 @@ void m68k_init(void)
 #endif
 }
 
+void m68k_memory_report(void)
+{
+#if M68K_DECODE_CACHE
+  memory_region("m68k decode cache", m68ki_cache, sizeof(m68ki_cache));
+#endif
+}
+
 /* Pulse the RESET line on the CPU */
 void m68k_pulse_reset(void)
 {
@@ -351,6 +832,7 @@ void m68k_pulse_reset(void)
   CPU_STOPPED = 0;
 #if M68K_EMULATE_ADDRESS_ERROR
   CPU_RUN_MODE = RUN_MODE_BERR_AERR_RESET;
+  m68ki_cpu.aerr_pending = 0;
 #endif
 
   /* Turn off tracing */
@@ -372,6 +854,7 @@ void m68k_pulse_reset(void)
 #endif /* M68K_EMULATE_PREFETCH */
 
   /* Read the initial stack pointer and program counter */
+  m68ki_fetch_invalidate();
   m68ki_jump(0);
   REG_SP = m68ki_read_imm_32();
   REG_PC = m68ki_read_imm_32();
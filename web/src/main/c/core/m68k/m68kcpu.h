@@ -8,10 +8,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
-
-#if M68K_EMULATE_ADDRESS_ERROR
-#include <setjmp.h>
-#endif /* M68K_EMULATE_ADDRESS_ERROR */
+#include <string.h>
+#include <stddef.h>
 
 #include "m68k.h"
 
@@ -214,6 +212,10 @@
 #define CPU_RUN_MODE     m68ki_cpu.run_mode
 #endif
 
+/* Base cycles of each opcode. The handlers of m68kops.h add theirs as constants
+ * when they return, the table is only read by exceptions undoing them and by
+ * m68k_cycles().
+ */
 #define CYC_INSTRUCTION   m68ki_cycles
 #define CYC_EXCEPTION     m68ki_exception_cycle_table
 #define CYC_BCC_NOTAKE_B  ( -2 * MUL)
@@ -310,28 +312,52 @@
 #endif /* M68K_EMULATE_TRACE */
 
 
-/* Enable or disable Address error emulation */
-#if M68K_EMULATE_ADDRESS_ERROR
-  #define m68ki_set_address_error_trap() \
-    if(setjmp(m68ki_cpu.aerr_trap) != 0) \
-    { \
-      m68ki_exception_address_error(); \
-    }
+/* Enable or disable idle loop skipping (main CPU only, see m68kconf.h) */
+#if M68K_IDLE_SKIP
+  /* Memory write: a pass of the loop cannot be repeated without executing it */
+  #define m68ki_idle_write() m68ki_idle.dirty = 1;
+  /* I/O read: same, except for the VDP status port in M68K_IDLE_VDP mode */
+  #define m68ki_idle_read_io(A) if ((m68ki_idle.mode != M68K_IDLE_VDP) || (((A) & 0xe000fc) != 0xc00004)) m68ki_idle.dirty = 1;
+  /* Taken branch */
+  #define m68ki_idle_branch(OFFSET) if (((OFFSET) & 0x80000000) && m68ki_idle.mode) m68ki_idle_check();
+#else
+  #define m68ki_idle_write()
+  #define m68ki_idle_read_io(A)
+  #define m68ki_idle_branch(OFFSET)
+#endif /* M68K_IDLE_SKIP */
 
-  #define m68ki_check_address_error(ADDR, WRITE_MODE, FC) \
-    if((ADDR)&1) \
+
+/* Enable or disable bus noise (main CPU only, see m68kconf.h) */
+#if M68K_BUS_NOISE
+  /* Data read: count down, the value read is faulted when the region's count is out */
+  #define m68ki_bus_noise(A, V, W) if (chaos_bus_tick(A)) V = chaos_bus_fault(A, V, W);
+#else
+  #define m68ki_bus_noise(A, V, W)
+#endif /* M68K_BUS_NOISE */
+
+
+/* Enable or disable Address error emulation.
+ * An odd word or long access does not unwind the instruction (a setjmp() in
+ * every m68k_run() call is costly under Emscripten): it is recorded as pending
+ * by m68ki_address_error() and dropped, like the word and long accesses left in
+ * the instruction, and the exception is taken at the next instruction boundary.
+ * No interrupt is taken while it is pending (m68ki_check_interrupts()), its
+ * frame would be dropped the same way; m68k_run() checks for one right after
+ * the address error frame.
+ * Unlike on the real CPU, the rest of the instruction still runs with its
+ * dropped reads returning 0: ALU results, MOVEM loads and the flags are
+ * written back (and the SR stacked is the one it left). Only its word and
+ * long accesses are dropped, byte writes still land (gating them would cost
+ * every byte access a test). Crashing code is all that takes address errors.
+ */
+#if M68K_EMULATE_ADDRESS_ERROR
+  #define m68ki_check_address_error(ADDR, WRITE_MODE, FC, ABORT) \
+    if((((ADDR) | m68ki_cpu.aerr_pending) & 1) && m68ki_address_error(ADDR, WRITE_MODE, FC)) \
     { \
-      if (m68ki_cpu.aerr_enabled) \
-      { \
-        m68ki_cpu.aerr_address = ADDR; \
-        m68ki_cpu.aerr_write_mode = WRITE_MODE; \
-        m68ki_cpu.aerr_fc = FC; \
-        longjmp(m68ki_cpu.aerr_trap, 1); \
-      } \
+      ABORT; \
     }
 #else
-  #define m68ki_set_address_error_trap()
-  #define m68ki_check_address_error(ADDR, WRITE_MODE, FC)
+  #define m68ki_check_address_error(ADDR, WRITE_MODE, FC, ABORT)
 #endif /* M68K_ADDRESS_ERROR */
 
 
@@ -415,9 +441,20 @@
 #if M68K_INT_GT_32_BIT
   #define CFLAG_ADD_32(S, D, R) ((R)>>24)
   #define CFLAG_SUB_32(S, D, R) ((R)>>24)
+  #define CFLAG_ADDX_32(S, D, R) ((R)>>24)
+  #define CFLAG_SUBX_32(S, D, R) ((R)>>24)
 #else
-  #define CFLAG_ADD_32(S, D, R) (((S & D) | (~R & (S | D)))>>23)
-  #define CFLAG_SUB_32(S, D, R) (((S & R) | (~D & (S | R)))>>23)
+  /* ADDX, SUBX and NEGX also add X into R */
+  #define CFLAG_ADDX_32(S, D, R) (((S & D) | (~R & (S | D)))>>23)
+  #define CFLAG_SUBX_32(S, D, R) (((S & R) | (~D & (S | R)))>>23)
+#if M68K_CARRY_64
+  /* R = D + S or D - S: bit 32 of the 64-bit result, one add and one shift */
+  #define CFLAG_ADD_32(S, D, R) ((uint)(((unsigned long long)(S) + (D))>>24))
+  #define CFLAG_SUB_32(S, D, R) ((uint)(((unsigned long long)(D) - (S))>>24))
+#else
+  #define CFLAG_ADD_32(S, D, R) CFLAG_ADDX_32(S, D, R)
+  #define CFLAG_SUB_32(S, D, R) CFLAG_SUBX_32(S, D, R)
+#endif /* M68K_CARRY_64 */
 #endif /* M68K_INT_GT_32_BIT */
 
 #define VFLAG_ADD_8(S, D, R) ((S^R) & (D^R))
@@ -524,8 +561,8 @@
 
 /* ----------------------------- Read / Write ----------------------------- */
 
-/* Read data immediately following the PC */
-#define m68k_read_immediate_16(address) *(uint16 *)(m68ki_cpu.memory_map[((address)>>16)&0xff].base + ((address) & 0xffff))
+/* Read data immediately following the PC (through the fetch bank, see m68ki_fetch_16()) */
+#define m68k_read_immediate_16(address) m68ki_fetch_16(address)
 #define m68k_read_immediate_32(address) (m68k_read_immediate_16(address) << 16) | (m68k_read_immediate_16(address+2))
 
 /* Read data relative to the PC */
@@ -541,6 +578,10 @@
 #define m68ki_read_pcrel_16(A) m68k_read_pcrelative_16(A)
 #define m68ki_read_pcrel_32(A) m68k_read_pcrelative_32(A)
 
+/* The fetch bank is looked up again on the next fetch: the memory map may
+ * have changed (I/O handler call, anything done between two m68k_run()) */
+#define m68ki_fetch_invalidate() m68ki_cpu.fetch_bank = 0x100
+
 
 /* ======================================================================== */
 /* =============================== PROTOTYPES ============================= */
@@ -664,6 +705,7 @@ static const uint16 m68ki_exception_cycle_table[256] =
 };
 
 /* Read data immediately after the program counter */
+INLINE uint m68ki_fetch_16(uint address);
 INLINE uint m68ki_read_imm_16(void);
 INLINE uint m68ki_read_imm_32(void);
 
@@ -765,11 +807,28 @@ INLINE void m68ki_exception_1010(void);
 INLINE void m68ki_exception_1111(void);
 INLINE void m68ki_exception_illegal(void);
 #if M68K_EMULATE_ADDRESS_ERROR
+static int m68ki_address_error(uint address, uint write_mode, uint fc); /* not inlined either, odd accesses are rare */
 INLINE void m68ki_exception_address_error(void);
 #endif
 INLINE void m68ki_exception_interrupt(uint int_level);
 INLINE void m68ki_check_interrupts(void);            /* ASG: check for interrupts */
 
+#if M68K_IDLE_SKIP
+/* Idle loop detection: CPU state when a backward branch last landed on 'pc' */
+#define M68KI_IDLE_REGS ((offsetof(m68ki_cpu_core, int_level) - offsetof(m68ki_cpu_core, dar)) / sizeof(uint))
+static struct
+{
+  uint mode;                    /* M68K_IDLE_OFF, M68K_IDLE_RAM or M68K_IDLE_VDP */
+  uint pc;                      /* loop start (odd: not armed) */
+  uint cycles;                  /* cycle count at the end of the branch */
+  uint dirty;                   /* write or I/O read since the loop start */
+  uint skipped;                 /* see m68k_idle_skipped() */
+  uint regs[M68KI_IDLE_REGS];   /* dar[] to int_mask */
+} m68ki_idle;
+
+static void m68ki_idle_check(void);
+#endif
+
 /* ======================================================================== */
 /* =========================== UTILITY FUNCTIONS ========================== */
 /* ======================================================================== */
@@ -777,6 +836,23 @@ INLINE void m68ki_check_interrupts(void);            /* ASG: check for interrupt
 
 /* ---------------------------- Read Immediate ---------------------------- */
 
+/* Instruction stream read: the host base of the 64KB bank of the last fetch
+ * is kept, so fetches in the same bank (all of them between two jumps, most
+ * of them across) are a compare and a load. Another bank, an exception or a
+ * jump out of the bank looks it up in the memory map again.
+ */
+INLINE uint m68ki_fetch_16(uint address)
+{
+  uint bank = (address >> 16) & 0xff;
+
+  if (bank != m68ki_cpu.fetch_bank)
+  {
+    m68ki_cpu.fetch_bank = bank;
+    m68ki_cpu.fetch_base = m68ki_cpu.memory_map[bank].base;
+  }
+  return *(uint16 *)(m68ki_cpu.fetch_base + (address & 0xffff));
+}
+
 /* Handles all immediate reads, does address error check, function code setting,
  * and prefetching if they are enabled in m68kconf.h
  */
@@ -784,7 +860,7 @@ INLINE uint m68ki_read_imm_16(void)
 {
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
 #if M68K_CHECK_PC_ADDRESS_ERROR
-  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM, return 0) /* auto-disable (see m68kcpu.h) */
 #endif
 #if M68K_EMULATE_PREFETCH
   if(MASK_OUT_BELOW_2(REG_PC) != CPU_PREF_ADDR)
@@ -808,7 +884,7 @@ INLINE uint m68ki_read_imm_32(void)
 
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
 #if M68K_CHECK_PC_ADDRESS_ERROR
-  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM, return 0) /* auto-disable (see m68kcpu.h) */
 #endif
   if(MASK_OUT_BELOW_2(REG_PC) != CPU_PREF_ADDR)
   {
@@ -829,7 +905,7 @@ INLINE uint m68ki_read_imm_32(void)
 #else
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
 #if M68K_CHECK_PC_ADDRESS_ERROR
-  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(REG_PC, MODE_READ, FLAG_S | FUNCTION_CODE_USER_PROGRAM, return 0) /* auto-disable (see m68kcpu.h) */
 #endif
   uint pc = REG_PC;
   REG_PC += 4;
@@ -854,11 +930,18 @@ INLINE uint m68ki_read_8(uint address)
 
   m68ki_set_fc(FLAG_S | m68ki_get_address_space()) /* auto-disable (see m68kcpu.h) */
 
-  if (temp->read8) val = (*temp->read8)(ADDRESS_68K(address));
+  if (temp->read8)
+  {
+    val = (*temp->read8)(ADDRESS_68K(address));
+    m68ki_fetch_invalidate();
+    m68ki_idle_read_io(address) /* auto-disable (see m68kcpu.h) */
+  }
   else val = READ_BYTE(temp->base, (address) & 0xffff);
 
+  m68ki_bus_noise(address, val, 1) /* auto-disable (see m68kcpu.h) */
+
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_R, address))
     cpu_hook(HOOK_M68K_R, 1, address, val);
 #endif
 
@@ -871,14 +954,21 @@ INLINE uint m68ki_read_16(uint address)
   uint val;
 
   m68ki_set_fc(FLAG_S | m68ki_get_address_space()) /* auto-disable (see m68kcpu.h) */
-  m68ki_check_address_error(address, MODE_READ, FLAG_S | m68ki_get_address_space()) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(address, MODE_READ, FLAG_S | m68ki_get_address_space(), return 0) /* auto-disable (see m68kcpu.h) */
   
   temp = &m68ki_cpu.memory_map[((address)>>16)&0xff];
-  if (temp->read16) val = (*temp->read16)(ADDRESS_68K(address));
+  if (temp->read16)
+  {
+    val = (*temp->read16)(ADDRESS_68K(address));
+    m68ki_fetch_invalidate();
+    m68ki_idle_read_io(address) /* auto-disable (see m68kcpu.h) */
+  }
   else val = *(uint16 *)(temp->base + ((address) & 0xffff));
 
+  m68ki_bus_noise(address, val, 2) /* auto-disable (see m68kcpu.h) */
+
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_R, address))
     cpu_hook(HOOK_M68K_R, 2, address, val);
 #endif
 
@@ -891,14 +981,27 @@ INLINE uint m68ki_read_32(uint address)
   uint val;
 
   m68ki_set_fc(FLAG_S | m68ki_get_address_space()) /* auto-disable (see m68kcpu.h) */
-  m68ki_check_address_error(address, MODE_READ, FLAG_S | m68ki_get_address_space()) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(address, MODE_READ, FLAG_S | m68ki_get_address_space(), return 0) /* auto-disable (see m68kcpu.h) */
 
   temp = &m68ki_cpu.memory_map[((address)>>16)&0xff];
-  if (temp->read16) val = ((*temp->read16)(ADDRESS_68K(address)) << 16) | ((*temp->read16)(ADDRESS_68K(address + 2)));
+  if (temp->read16)
+  {
+    val = ((*temp->read16)(ADDRESS_68K(address)) << 16) | ((*temp->read16)(ADDRESS_68K(address + 2)));
+    m68ki_fetch_invalidate();
+    m68ki_idle_read_io(address) /* auto-disable (see m68kcpu.h) */
+  }
+  else if ((address & 0xffff) != 0xfffe)
+  {
+    /* both words in the same bank */
+    uint16 *ptr = (uint16 *)(temp->base + ((address) & 0xffff));
+    val = (ptr[0] << 16) | ptr[1];
+  }
   else val = m68k_read_immediate_32(address);
 
+  m68ki_bus_noise(address, val, 4) /* auto-disable (see m68kcpu.h) */
+
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_R, address))
     cpu_hook(HOOK_M68K_R, 4, address, val);
 #endif
 
@@ -912,13 +1015,19 @@ INLINE void m68ki_write_8(uint address, uint value)
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_DATA) /* auto-disable (see m68kcpu.h) */
 
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_W, address))
     cpu_hook(HOOK_M68K_W, 1, address, value);
 #endif
 
   temp = &m68ki_cpu.memory_map[((address)>>16)&0xff];
-  if (temp->write8) (*temp->write8)(ADDRESS_68K(address),value);
+  if (temp->write8)
+  {
+    (*temp->write8)(ADDRESS_68K(address),value);
+    m68ki_fetch_invalidate();
+  }
   else WRITE_BYTE(temp->base, (address) & 0xffff, value);
+
+  m68ki_idle_write() /* auto-disable (see m68kcpu.h) */
 }
 
 INLINE void m68ki_write_16(uint address, uint value)
@@ -926,16 +1035,22 @@ INLINE void m68ki_write_16(uint address, uint value)
   cpu_memory_map *temp;
 
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_DATA) /* auto-disable (see m68kcpu.h) */
-  m68ki_check_address_error(address, MODE_WRITE, FLAG_S | FUNCTION_CODE_USER_DATA); /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(address, MODE_WRITE, FLAG_S | FUNCTION_CODE_USER_DATA, return) /* auto-disable (see m68kcpu.h) */
 
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_W, address))
     cpu_hook(HOOK_M68K_W, 2, address, value);
 #endif
 
   temp = &m68ki_cpu.memory_map[((address)>>16)&0xff];
-  if (temp->write16) (*temp->write16)(ADDRESS_68K(address),value);
+  if (temp->write16)
+  {
+    (*temp->write16)(ADDRESS_68K(address),value);
+    m68ki_fetch_invalidate();
+  }
   else *(uint16 *)(temp->base + ((address) & 0xffff)) = value;
+
+  m68ki_idle_write() /* auto-disable (see m68kcpu.h) */
 }
 
 INLINE void m68ki_write_32(uint address, uint value)
@@ -943,20 +1058,34 @@ INLINE void m68ki_write_32(uint address, uint value)
   cpu_memory_map *temp;
 
   m68ki_set_fc(FLAG_S | FUNCTION_CODE_USER_DATA) /* auto-disable (see m68kcpu.h) */
-  m68ki_check_address_error(address, MODE_WRITE, FLAG_S | FUNCTION_CODE_USER_DATA) /* auto-disable (see m68kcpu.h) */
+  m68ki_check_address_error(address, MODE_WRITE, FLAG_S | FUNCTION_CODE_USER_DATA, return) /* auto-disable (see m68kcpu.h) */
 
 #ifdef HOOK_CPU
-  if (cpu_hook)
+  if (cpu_hook_page(HOOK_PAGE_W, address))
     cpu_hook(HOOK_M68K_W, 4, address, value);
 #endif
 
   temp = &m68ki_cpu.memory_map[((address)>>16)&0xff];
-  if (temp->write16) (*temp->write16)(ADDRESS_68K(address),value>>16);
-  else *(uint16 *)(temp->base + ((address) & 0xffff)) = value >> 16;
+  if (!temp->write16 && ((address & 0xffff) != 0xfffe))
+  {
+    /* both words in the same bank */
+    uint16 *ptr = (uint16 *)(temp->base + ((address) & 0xffff));
+    ptr[0] = value >> 16;
+    ptr[1] = value;
+  }
+  else
+  {
+    /* the first write may switch banks */
+    if (temp->write16) (*temp->write16)(ADDRESS_68K(address),value>>16);
+    else *(uint16 *)(temp->base + ((address) & 0xffff)) = value >> 16;
+
+    temp = &m68ki_cpu.memory_map[((address + 2)>>16)&0xff];
+    if (temp->write16) (*temp->write16)(ADDRESS_68K(address+2),value&0xffff);
+    else *(uint16 *)(temp->base + ((address + 2) & 0xffff)) = value;
+    m68ki_fetch_invalidate();
+  }
 
-  temp = &m68ki_cpu.memory_map[((address + 2)>>16)&0xff];
-  if (temp->write16) (*temp->write16)(ADDRESS_68K(address+2),value&0xffff);
-  else *(uint16 *)(temp->base + ((address + 2) & 0xffff)) = value;
+  m68ki_idle_write() /* auto-disable (see m68kcpu.h) */
 }
 
 
@@ -1146,11 +1275,13 @@ INLINE void m68ki_jump_vector(uint vector)
 INLINE void m68ki_branch_8(uint offset)
 {
   REG_PC += MAKE_INT_8(offset);
+  m68ki_idle_branch(MAKE_INT_8(offset)) /* auto-disable (see m68kcpu.h) */
 }
 
 INLINE void m68ki_branch_16(uint offset)
 {
   REG_PC += MAKE_INT_16(offset);
+  m68ki_idle_branch(MAKE_INT_16(offset)) /* auto-disable (see m68kcpu.h) */
 }
 
 INLINE void m68ki_branch_32(uint offset)
@@ -1231,7 +1362,7 @@ INLINE void m68ki_stack_frame_3word(uint pc, uint sr)
  */
 INLINE void m68ki_stack_frame_buserr(uint sr)
 {
-  m68ki_push_32(REG_PC);
+  m68ki_push_32(m68ki_cpu.aerr_pc);
   m68ki_push_16(sr);
   m68ki_push_16(REG_IR);
   m68ki_push_32(m68ki_cpu.aerr_address);  /* access address */
@@ -1295,6 +1426,8 @@ static void m68ki_exception_privilege_violation(void)
 {
   uint sr = m68ki_init_exception();
 
+  m68ki_cpu.faults++;
+
   #if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
   CPU_INSTR_MODE = INSTRUCTION_NO;
   #endif /* M68K_EMULATE_ADDRESS_ERROR */
@@ -1310,6 +1443,7 @@ static void m68ki_exception_privilege_violation(void)
 INLINE void m68ki_exception_1010(void)
 {
   uint sr = m68ki_init_exception();
+  m68ki_cpu.faults++;
   m68ki_stack_frame_3word(REG_PC-2, sr);
   m68ki_jump_vector(EXCEPTION_1010);
 
@@ -1321,6 +1455,7 @@ INLINE void m68ki_exception_1010(void)
 INLINE void m68ki_exception_1111(void)
 {
   uint sr = m68ki_init_exception();
+  m68ki_cpu.faults++;
   m68ki_stack_frame_3word(REG_PC-2, sr);
   m68ki_jump_vector(EXCEPTION_1111);
 
@@ -1333,6 +1468,8 @@ INLINE void m68ki_exception_illegal(void)
 {
   uint sr = m68ki_init_exception();
 
+  m68ki_cpu.faults++;
+
   #if M68K_EMULATE_ADDRESS_ERROR == OPT_ON
   CPU_INSTR_MODE = INSTRUCTION_NO;
   #endif /* M68K_EMULATE_ADDRESS_ERROR */
@@ -1349,7 +1486,13 @@ INLINE void m68ki_exception_illegal(void)
 /* Exception for address error */
 INLINE void m68ki_exception_address_error(void)
 {
-  uint sr = m68ki_init_exception();
+  uint sr;
+
+  /* Stacking the frame must not be dropped */
+  m68ki_cpu.aerr_pending = 0;
+  m68ki_cpu.faults++;
+
+  sr = m68ki_init_exception();
 
   /* If we were processing a bus error, address error, or reset,
      * this is a catastrophic failure.
@@ -1358,7 +1501,7 @@ INLINE void m68ki_exception_address_error(void)
   if(CPU_RUN_MODE == RUN_MODE_BERR_AERR_RESET)
   {
     CPU_STOPPED = STOP_LEVEL_HALT;
-    SET_CYCLES(m68ki_cpu.cycle_end - CYC_INSTRUCTION[REG_IR]);
+    SET_CYCLES(m68ki_cpu.cycle_end);
     return;
   }
   CPU_RUN_MODE = RUN_MODE_BERR_AERR_RESET;
@@ -1368,7 +1511,7 @@ INLINE void m68ki_exception_address_error(void)
 
   m68ki_jump_vector(EXCEPTION_ADDRESS_ERROR);
 
-  /* Use up some clock cycles and undo the instruction's cycles */
+  /* Use up some clock cycles and undo the aborted instruction's cycles */
   USE_CYCLES(CYC_EXCEPTION[EXCEPTION_ADDRESS_ERROR] - CYC_INSTRUCTION[REG_IR]);
 }
 #endif
@@ -1421,10 +1564,57 @@ INLINE void m68ki_exception_interrupt(uint int_level)
 /* ASG: Check for interrupts */
 INLINE void m68ki_check_interrupts(void)
 {
+#if M68K_EMULATE_ADDRESS_ERROR
+  /* held back until the address error frame is stacked (m68k_run()) */
+  if(m68ki_cpu.aerr_pending)
+    return;
+#endif
+
   if(CPU_INT_LEVEL > FLAG_INT_MASK)
     m68ki_exception_interrupt(CPU_INT_LEVEL>>8);
 }
 
+#if M68K_IDLE_SKIP
+/* Called after a taken backward branch. A pass of the loop without writes or
+ * I/O reads that ends with the registers it started with repeats identically:
+ * interrupts, DMA, the Z80 and the other chips only change something between
+ * two m68k_run() calls, or from a write. The passes that fit before the end
+ * of the current one are skipped at once.
+ */
+static void m68ki_idle_check(void)
+{
+  uint start = m68ki_cpu.cycles;
+  uint cycles;
+
+  /* instruction boundary after the branch (the handler adds its cycles last) */
+  USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
+  cycles = m68ki_cpu.cycles;
+  m68ki_cpu.cycles = start;
+
+  if ((REG_PC == m68ki_idle.pc) && !m68ki_idle.dirty &&
+      !memcmp(m68ki_idle.regs, REG_DA, sizeof(m68ki_idle.regs)))
+  {
+    uint pass = cycles - m68ki_idle.cycles;
+
+    if (m68ki_cpu.cycle_end > cycles)
+    {
+      uint skip = ((m68ki_cpu.cycle_end - cycles) / pass) * pass;
+      m68ki_cpu.cycles += skip;
+      m68ki_idle.skipped += skip;
+      cycles += skip;
+    }
+  }
+  else
+  {
+    m68ki_idle.pc = REG_PC;
+    memcpy(m68ki_idle.regs, REG_DA, sizeof(m68ki_idle.regs));
+  }
+
+  m68ki_idle.cycles = cycles;
+  m68ki_idle.dirty = 0;
+}
+#endif
+
 
 /* ======================================================================== */
 /* ============================== END OF FILE ============================= */
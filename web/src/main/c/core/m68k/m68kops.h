@@ -128,12 +128,14 @@ INLINE void UseMulsCycles(sint16 src)
 static void m68k_op_1010(void)
 {
   m68ki_exception_1010();
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_1111(void)
 {
   m68ki_exception_1111();
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -162,6 +164,7 @@ static void m68k_op_abcd_8_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | res;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -190,6 +193,7 @@ static void m68k_op_abcd_8_mm_ax7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -218,6 +222,7 @@ static void m68k_op_abcd_8_mm_ay7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -246,6 +251,7 @@ static void m68k_op_abcd_8_mm_axy7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -274,6 +280,7 @@ static void m68k_op_abcd_8_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -290,6 +297,7 @@ static void m68k_op_add_8_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -306,6 +314,7 @@ static void m68k_op_add_8_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -322,6 +331,7 @@ static void m68k_op_add_8_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -338,6 +348,7 @@ static void m68k_op_add_8_er_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -354,6 +365,7 @@ static void m68k_op_add_8_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -370,6 +382,7 @@ static void m68k_op_add_8_er_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -386,6 +399,7 @@ static void m68k_op_add_8_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -402,6 +416,7 @@ static void m68k_op_add_8_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -418,6 +433,7 @@ static void m68k_op_add_8_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -434,6 +450,7 @@ static void m68k_op_add_8_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -450,6 +467,7 @@ static void m68k_op_add_8_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -466,6 +484,7 @@ static void m68k_op_add_8_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -482,6 +501,7 @@ static void m68k_op_add_8_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -498,6 +518,7 @@ static void m68k_op_add_16_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -514,6 +535,7 @@ static void m68k_op_add_16_er_a(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -530,6 +552,7 @@ static void m68k_op_add_16_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -546,6 +569,7 @@ static void m68k_op_add_16_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -562,6 +586,7 @@ static void m68k_op_add_16_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -578,6 +603,7 @@ static void m68k_op_add_16_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -594,6 +620,7 @@ static void m68k_op_add_16_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -610,6 +637,7 @@ static void m68k_op_add_16_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -626,6 +654,7 @@ static void m68k_op_add_16_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -642,6 +671,7 @@ static void m68k_op_add_16_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -658,6 +688,7 @@ static void m68k_op_add_16_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -674,6 +705,7 @@ static void m68k_op_add_16_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -690,6 +722,7 @@ static void m68k_op_add_32_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -706,6 +739,7 @@ static void m68k_op_add_32_er_a(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -722,6 +756,7 @@ static void m68k_op_add_32_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -738,6 +773,7 @@ static void m68k_op_add_32_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -754,6 +790,7 @@ static void m68k_op_add_32_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -770,6 +807,7 @@ static void m68k_op_add_32_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -786,6 +824,7 @@ static void m68k_op_add_32_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -802,6 +841,7 @@ static void m68k_op_add_32_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -818,6 +858,7 @@ static void m68k_op_add_32_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -834,6 +875,7 @@ static void m68k_op_add_32_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -850,6 +892,7 @@ static void m68k_op_add_32_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -866,6 +909,7 @@ static void m68k_op_add_32_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -882,6 +926,7 @@ static void m68k_op_add_8_re_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -898,6 +943,7 @@ static void m68k_op_add_8_re_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -914,6 +960,7 @@ static void m68k_op_add_8_re_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -930,6 +977,7 @@ static void m68k_op_add_8_re_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -946,6 +994,7 @@ static void m68k_op_add_8_re_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -962,6 +1011,7 @@ static void m68k_op_add_8_re_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -978,6 +1028,7 @@ static void m68k_op_add_8_re_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -994,6 +1045,7 @@ static void m68k_op_add_8_re_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1010,6 +1062,7 @@ static void m68k_op_add_8_re_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1026,6 +1079,7 @@ static void m68k_op_add_16_re_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1042,6 +1096,7 @@ static void m68k_op_add_16_re_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1058,6 +1113,7 @@ static void m68k_op_add_16_re_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1074,6 +1130,7 @@ static void m68k_op_add_16_re_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1090,6 +1147,7 @@ static void m68k_op_add_16_re_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1106,6 +1164,7 @@ static void m68k_op_add_16_re_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1122,6 +1181,7 @@ static void m68k_op_add_16_re_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1138,6 +1198,7 @@ static void m68k_op_add_32_re_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1154,6 +1215,7 @@ static void m68k_op_add_32_re_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1170,6 +1232,7 @@ static void m68k_op_add_32_re_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -1186,6 +1249,7 @@ static void m68k_op_add_32_re_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -1202,6 +1266,7 @@ static void m68k_op_add_32_re_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -1218,6 +1283,7 @@ static void m68k_op_add_32_re_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -1234,6 +1300,7 @@ static void m68k_op_add_32_re_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -1242,6 +1309,7 @@ static void m68k_op_adda_16_d(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + MAKE_INT_16(DY));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1250,6 +1318,7 @@ static void m68k_op_adda_16_a(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + MAKE_INT_16(AY));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1259,6 +1328,7 @@ static void m68k_op_adda_16_ai(void)
   uint src = MAKE_INT_16(OPER_AY_AI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1268,6 +1338,7 @@ static void m68k_op_adda_16_pi(void)
   uint src = MAKE_INT_16(OPER_AY_PI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1277,6 +1348,7 @@ static void m68k_op_adda_16_pd(void)
   uint src = MAKE_INT_16(OPER_AY_PD_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1286,6 +1358,7 @@ static void m68k_op_adda_16_di(void)
   uint src = MAKE_INT_16(OPER_AY_DI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1295,6 +1368,7 @@ static void m68k_op_adda_16_ix(void)
   uint src = MAKE_INT_16(OPER_AY_IX_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1304,6 +1378,7 @@ static void m68k_op_adda_16_aw(void)
   uint src = MAKE_INT_16(OPER_AW_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1313,6 +1388,7 @@ static void m68k_op_adda_16_al(void)
   uint src = MAKE_INT_16(OPER_AL_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1322,6 +1398,7 @@ static void m68k_op_adda_16_pcdi(void)
   uint src = MAKE_INT_16(OPER_PCDI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1331,6 +1408,7 @@ static void m68k_op_adda_16_pcix(void)
   uint src = MAKE_INT_16(OPER_PCIX_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1340,6 +1418,7 @@ static void m68k_op_adda_16_i(void)
   uint src = MAKE_INT_16(OPER_I_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1348,6 +1427,7 @@ static void m68k_op_adda_32_d(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + DY);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1356,6 +1436,7 @@ static void m68k_op_adda_32_a(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + AY);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1364,6 +1445,7 @@ static void m68k_op_adda_32_ai(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AY_AI_32() + *r_dst);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1372,6 +1454,7 @@ static void m68k_op_adda_32_pi(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AY_PI_32() + *r_dst);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1380,6 +1463,7 @@ static void m68k_op_adda_32_pd(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AY_PD_32() + *r_dst);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1388,6 +1472,7 @@ static void m68k_op_adda_32_di(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AY_DI_32() + *r_dst);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1396,6 +1481,7 @@ static void m68k_op_adda_32_ix(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AY_IX_32() + *r_dst);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1404,6 +1490,7 @@ static void m68k_op_adda_32_aw(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AW_32() + *r_dst);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1412,6 +1499,7 @@ static void m68k_op_adda_32_al(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_AL_32() + *r_dst);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -1420,6 +1508,7 @@ static void m68k_op_adda_32_pcdi(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_PCDI_32() + *r_dst);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1428,6 +1517,7 @@ static void m68k_op_adda_32_pcix(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_PCIX_32() + *r_dst);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1436,6 +1526,7 @@ static void m68k_op_adda_32_i(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(OPER_I_32() + *r_dst);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1452,6 +1543,7 @@ static void m68k_op_addi_8_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1468,6 +1560,7 @@ static void m68k_op_addi_8_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1484,6 +1577,7 @@ static void m68k_op_addi_8_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1500,6 +1594,7 @@ static void m68k_op_addi_8_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1516,6 +1611,7 @@ static void m68k_op_addi_8_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1532,6 +1628,7 @@ static void m68k_op_addi_8_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1548,6 +1645,7 @@ static void m68k_op_addi_8_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1564,6 +1662,7 @@ static void m68k_op_addi_8_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -1580,6 +1679,7 @@ static void m68k_op_addi_8_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1596,6 +1696,7 @@ static void m68k_op_addi_8_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -1612,6 +1713,7 @@ static void m68k_op_addi_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -1628,6 +1730,7 @@ static void m68k_op_addi_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1644,6 +1747,7 @@ static void m68k_op_addi_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1660,6 +1764,7 @@ static void m68k_op_addi_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1676,6 +1781,7 @@ static void m68k_op_addi_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1692,6 +1798,7 @@ static void m68k_op_addi_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -1708,6 +1815,7 @@ static void m68k_op_addi_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -1724,6 +1832,7 @@ static void m68k_op_addi_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -1740,6 +1849,7 @@ static void m68k_op_addi_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1756,6 +1866,7 @@ static void m68k_op_addi_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -1772,6 +1883,7 @@ static void m68k_op_addi_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -1788,6 +1900,7 @@ static void m68k_op_addi_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -1804,6 +1917,7 @@ static void m68k_op_addi_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -1820,6 +1934,7 @@ static void m68k_op_addi_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -1836,6 +1951,7 @@ static void m68k_op_addi_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -1852,6 +1968,7 @@ static void m68k_op_addi_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(36*MUL);
 }
 
 
@@ -1868,6 +1985,7 @@ static void m68k_op_addq_8_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -1884,6 +2002,7 @@ static void m68k_op_addq_8_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1900,6 +2019,7 @@ static void m68k_op_addq_8_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1916,6 +2036,7 @@ static void m68k_op_addq_8_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -1932,6 +2053,7 @@ static void m68k_op_addq_8_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1948,6 +2070,7 @@ static void m68k_op_addq_8_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -1964,6 +2087,7 @@ static void m68k_op_addq_8_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -1980,6 +2104,7 @@ static void m68k_op_addq_8_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -1996,6 +2121,7 @@ static void m68k_op_addq_8_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2012,6 +2138,7 @@ static void m68k_op_addq_8_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2028,6 +2155,7 @@ static void m68k_op_addq_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2036,6 +2164,7 @@ static void m68k_op_addq_16_a(void)
   uint* r_dst = &AY;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + (((REG_IR >> 9) - 1) & 7) + 1);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2052,6 +2181,7 @@ static void m68k_op_addq_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2068,6 +2198,7 @@ static void m68k_op_addq_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2084,6 +2215,7 @@ static void m68k_op_addq_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2100,6 +2232,7 @@ static void m68k_op_addq_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2116,6 +2249,7 @@ static void m68k_op_addq_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2132,6 +2266,7 @@ static void m68k_op_addq_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2148,6 +2283,7 @@ static void m68k_op_addq_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2164,6 +2300,7 @@ static void m68k_op_addq_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2172,6 +2309,7 @@ static void m68k_op_addq_32_a(void)
   uint* r_dst = &AY;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst + (((REG_IR >> 9) - 1) & 7) + 1);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2189,6 +2327,7 @@ static void m68k_op_addq_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2206,6 +2345,7 @@ static void m68k_op_addq_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2223,6 +2363,7 @@ static void m68k_op_addq_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -2240,6 +2381,7 @@ static void m68k_op_addq_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -2257,6 +2399,7 @@ static void m68k_op_addq_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -2274,6 +2417,7 @@ static void m68k_op_addq_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -2291,6 +2435,7 @@ static void m68k_op_addq_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -2309,6 +2454,7 @@ static void m68k_op_addx_8_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2327,6 +2473,7 @@ static void m68k_op_addx_16_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2339,12 +2486,13 @@ static void m68k_op_addx_32_rr(void)
 
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_ADD_32(src, dst, res);
-  FLAG_X = FLAG_C = CFLAG_ADD_32(src, dst, res);
+  FLAG_X = FLAG_C = CFLAG_ADDX_32(src, dst, res);
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   *r_dst = res;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2363,6 +2511,7 @@ static void m68k_op_addx_8_mm_ax7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2381,6 +2530,7 @@ static void m68k_op_addx_8_mm_ay7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2399,6 +2549,7 @@ static void m68k_op_addx_8_mm_axy7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2417,6 +2568,7 @@ static void m68k_op_addx_8_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2435,6 +2587,7 @@ static void m68k_op_addx_16_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2447,12 +2600,13 @@ static void m68k_op_addx_32_mm(void)
 
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_ADD_32(src, dst, res);
-  FLAG_X = FLAG_C = CFLAG_ADD_32(src, dst, res);
+  FLAG_X = FLAG_C = CFLAG_ADDX_32(src, dst, res);
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -2463,6 +2617,7 @@ static void m68k_op_and_8_er_d(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2473,6 +2628,7 @@ static void m68k_op_and_8_er_ai(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2483,6 +2639,7 @@ static void m68k_op_and_8_er_pi(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2493,6 +2650,7 @@ static void m68k_op_and_8_er_pi7(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2503,6 +2661,7 @@ static void m68k_op_and_8_er_pd(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -2513,6 +2672,7 @@ static void m68k_op_and_8_er_pd7(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -2523,6 +2683,7 @@ static void m68k_op_and_8_er_di(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2533,6 +2694,7 @@ static void m68k_op_and_8_er_ix(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2543,6 +2705,7 @@ static void m68k_op_and_8_er_aw(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2553,6 +2716,7 @@ static void m68k_op_and_8_er_al(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2563,6 +2727,7 @@ static void m68k_op_and_8_er_pcdi(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2573,6 +2738,7 @@ static void m68k_op_and_8_er_pcix(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2583,6 +2749,7 @@ static void m68k_op_and_8_er_i(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2593,6 +2760,7 @@ static void m68k_op_and_16_er_d(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -2603,6 +2771,7 @@ static void m68k_op_and_16_er_ai(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2613,6 +2782,7 @@ static void m68k_op_and_16_er_pi(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2623,6 +2793,7 @@ static void m68k_op_and_16_er_pd(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -2633,6 +2804,7 @@ static void m68k_op_and_16_er_di(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2643,6 +2815,7 @@ static void m68k_op_and_16_er_ix(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2653,6 +2826,7 @@ static void m68k_op_and_16_er_aw(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2663,6 +2837,7 @@ static void m68k_op_and_16_er_al(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2673,6 +2848,7 @@ static void m68k_op_and_16_er_pcdi(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2683,6 +2859,7 @@ static void m68k_op_and_16_er_pcix(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2693,6 +2870,7 @@ static void m68k_op_and_16_er_i(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2703,6 +2881,7 @@ static void m68k_op_and_32_er_d(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -2713,6 +2892,7 @@ static void m68k_op_and_32_er_ai(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2723,6 +2903,7 @@ static void m68k_op_and_32_er_pi(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2733,6 +2914,7 @@ static void m68k_op_and_32_er_pd(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2743,6 +2925,7 @@ static void m68k_op_and_32_er_di(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2753,6 +2936,7 @@ static void m68k_op_and_32_er_ix(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2763,6 +2947,7 @@ static void m68k_op_and_32_er_aw(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2773,6 +2958,7 @@ static void m68k_op_and_32_er_al(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -2783,6 +2969,7 @@ static void m68k_op_and_32_er_pcdi(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2793,6 +2980,7 @@ static void m68k_op_and_32_er_pcix(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2803,6 +2991,7 @@ static void m68k_op_and_32_er_i(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2817,6 +3006,7 @@ static void m68k_op_and_8_re_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2831,6 +3021,7 @@ static void m68k_op_and_8_re_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2845,6 +3036,7 @@ static void m68k_op_and_8_re_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2859,6 +3051,7 @@ static void m68k_op_and_8_re_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2873,6 +3066,7 @@ static void m68k_op_and_8_re_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2887,6 +3081,7 @@ static void m68k_op_and_8_re_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2901,6 +3096,7 @@ static void m68k_op_and_8_re_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -2915,6 +3111,7 @@ static void m68k_op_and_8_re_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2929,6 +3126,7 @@ static void m68k_op_and_8_re_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -2943,6 +3141,7 @@ static void m68k_op_and_16_re_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2957,6 +3156,7 @@ static void m68k_op_and_16_re_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -2971,6 +3171,7 @@ static void m68k_op_and_16_re_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -2985,6 +3186,7 @@ static void m68k_op_and_16_re_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -2999,6 +3201,7 @@ static void m68k_op_and_16_re_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -3013,6 +3216,7 @@ static void m68k_op_and_16_re_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3027,6 +3231,7 @@ static void m68k_op_and_16_re_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3041,6 +3246,7 @@ static void m68k_op_and_32_re_ai(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3055,6 +3261,7 @@ static void m68k_op_and_32_re_pi(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3069,6 +3276,7 @@ static void m68k_op_and_32_re_pd(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -3083,6 +3291,7 @@ static void m68k_op_and_32_re_di(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -3097,6 +3306,7 @@ static void m68k_op_and_32_re_ix(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -3111,6 +3321,7 @@ static void m68k_op_and_32_re_aw(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -3125,6 +3336,7 @@ static void m68k_op_and_32_re_al(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -3135,6 +3347,7 @@ static void m68k_op_andi_8_d(void)
   FLAG_N = NFLAG_8(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -3150,6 +3363,7 @@ static void m68k_op_andi_8_ai(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3165,6 +3379,7 @@ static void m68k_op_andi_8_pi(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3180,6 +3395,7 @@ static void m68k_op_andi_8_pi7(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3195,6 +3411,7 @@ static void m68k_op_andi_8_pd(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -3210,6 +3427,7 @@ static void m68k_op_andi_8_pd7(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -3225,6 +3443,7 @@ static void m68k_op_andi_8_di(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3240,6 +3459,7 @@ static void m68k_op_andi_8_ix(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -3255,6 +3475,7 @@ static void m68k_op_andi_8_aw(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3270,6 +3491,7 @@ static void m68k_op_andi_8_al(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -3280,6 +3502,7 @@ static void m68k_op_andi_16_d(void)
   FLAG_N = NFLAG_16(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -3295,6 +3518,7 @@ static void m68k_op_andi_16_ai(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3310,6 +3534,7 @@ static void m68k_op_andi_16_pi(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3325,6 +3550,7 @@ static void m68k_op_andi_16_pd(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -3340,6 +3566,7 @@ static void m68k_op_andi_16_di(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3355,6 +3582,7 @@ static void m68k_op_andi_16_ix(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -3370,6 +3598,7 @@ static void m68k_op_andi_16_aw(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3385,6 +3614,7 @@ static void m68k_op_andi_16_al(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -3395,6 +3625,7 @@ static void m68k_op_andi_32_d(void)
   FLAG_N = NFLAG_32(FLAG_Z);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -3410,6 +3641,7 @@ static void m68k_op_andi_32_ai(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -3425,6 +3657,7 @@ static void m68k_op_andi_32_pi(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -3440,6 +3673,7 @@ static void m68k_op_andi_32_pd(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -3455,6 +3689,7 @@ static void m68k_op_andi_32_di(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -3470,6 +3705,7 @@ static void m68k_op_andi_32_ix(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -3485,6 +3721,7 @@ static void m68k_op_andi_32_aw(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -3500,12 +3737,14 @@ static void m68k_op_andi_32_al(void)
   FLAG_V = VFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(36*MUL);
 }
 
 
 static void m68k_op_andi_16_toc(void)
 {
   m68ki_set_ccr(m68ki_get_ccr() & OPER_I_16());
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3515,9 +3754,11 @@ static void m68k_op_andi_16_tos(void)
   {
     uint src = OPER_I_16();
     m68ki_set_sr(m68ki_get_sr() & src);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3540,6 +3781,7 @@ static void m68k_op_asr_8_s(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_X = FLAG_C = src << (9-shift);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3562,6 +3804,7 @@ static void m68k_op_asr_16_s(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_X = FLAG_C = src << (9-shift);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3584,6 +3827,7 @@ static void m68k_op_asr_32_s(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_X = FLAG_C = src << (9-shift);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -3609,6 +3853,7 @@ static void m68k_op_asr_8_r(void)
       FLAG_N = NFLAG_8(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3620,6 +3865,7 @@ static void m68k_op_asr_8_r(void)
       FLAG_N = NFLAG_SET;
       FLAG_Z = ZFLAG_CLEAR;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3629,6 +3875,7 @@ static void m68k_op_asr_8_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -3636,6 +3883,7 @@ static void m68k_op_asr_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3661,6 +3909,7 @@ static void m68k_op_asr_16_r(void)
       FLAG_N = NFLAG_16(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3672,6 +3921,7 @@ static void m68k_op_asr_16_r(void)
       FLAG_N = NFLAG_SET;
       FLAG_Z = ZFLAG_CLEAR;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3681,6 +3931,7 @@ static void m68k_op_asr_16_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -3688,6 +3939,7 @@ static void m68k_op_asr_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3713,6 +3965,7 @@ static void m68k_op_asr_32_r(void)
       FLAG_N = NFLAG_32(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -3724,6 +3977,7 @@ static void m68k_op_asr_32_r(void)
       FLAG_N = NFLAG_SET;
       FLAG_Z = ZFLAG_CLEAR;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -3733,6 +3987,7 @@ static void m68k_op_asr_32_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -3740,6 +3995,7 @@ static void m68k_op_asr_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -3758,6 +4014,7 @@ static void m68k_op_asr_16_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -3776,6 +4033,7 @@ static void m68k_op_asr_16_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -3794,6 +4052,7 @@ static void m68k_op_asr_16_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -3812,6 +4071,7 @@ static void m68k_op_asr_16_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3830,6 +4090,7 @@ static void m68k_op_asr_16_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -3848,6 +4109,7 @@ static void m68k_op_asr_16_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -3866,6 +4128,7 @@ static void m68k_op_asr_16_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = FLAG_X = src << 8;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -3886,6 +4149,7 @@ static void m68k_op_asl_8_s(void)
   FLAG_Z = res;
   src &= m68ki_shift_8_table[shift + 1];
   FLAG_V = (!(src == 0 || (src == m68ki_shift_8_table[shift + 1] && shift < 8)))<<7;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3906,6 +4170,7 @@ static void m68k_op_asl_16_s(void)
   FLAG_X = FLAG_C = src >> (8-shift);
   src &= m68ki_shift_16_table[shift + 1];
   FLAG_V = (!(src == 0 || src == m68ki_shift_16_table[shift + 1]))<<7;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3926,6 +4191,7 @@ static void m68k_op_asl_32_s(void)
   FLAG_X = FLAG_C = src >> (24-shift);
   src &= m68ki_shift_32_table[shift + 1];
   FLAG_V = (!(src == 0 || src == m68ki_shift_32_table[shift + 1]))<<7;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -3948,6 +4214,7 @@ static void m68k_op_asl_8_r(void)
       FLAG_Z = res;
       src &= m68ki_shift_8_table[shift + 1];
       FLAG_V = (!(src == 0 || src == m68ki_shift_8_table[shift + 1]))<<7;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3956,6 +4223,7 @@ static void m68k_op_asl_8_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = (!(src == 0))<<7;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -3963,6 +4231,7 @@ static void m68k_op_asl_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -3985,6 +4254,7 @@ static void m68k_op_asl_16_r(void)
       FLAG_Z = res;
       src &= m68ki_shift_16_table[shift + 1];
       FLAG_V = (!(src == 0 || src == m68ki_shift_16_table[shift + 1]))<<7;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -3993,6 +4263,7 @@ static void m68k_op_asl_16_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = (!(src == 0))<<7;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -4000,6 +4271,7 @@ static void m68k_op_asl_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -4022,6 +4294,7 @@ static void m68k_op_asl_32_r(void)
       FLAG_Z = res;
       src &= m68ki_shift_32_table[shift + 1];
       FLAG_V = (!(src == 0 || src == m68ki_shift_32_table[shift + 1]))<<7;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -4030,6 +4303,7 @@ static void m68k_op_asl_32_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = (!(src == 0))<<7;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -4037,6 +4311,7 @@ static void m68k_op_asl_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -4053,6 +4328,7 @@ static void m68k_op_asl_16_ai(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4069,6 +4345,7 @@ static void m68k_op_asl_16_pi(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4085,6 +4362,7 @@ static void m68k_op_asl_16_pd(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -4101,6 +4379,7 @@ static void m68k_op_asl_16_di(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4117,6 +4396,7 @@ static void m68k_op_asl_16_ix(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -4133,6 +4413,7 @@ static void m68k_op_asl_16_aw(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4149,6 +4430,7 @@ static void m68k_op_asl_16_al(void)
   FLAG_X = FLAG_C = src >> 7;
   src &= 0xc000;
   FLAG_V = (!(src == 0 || src == 0xc000))<<7;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -4157,9 +4439,11 @@ static void m68k_op_bhi_8(void)
   if(COND_HI())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4168,9 +4452,11 @@ static void m68k_op_bls_8(void)
   if(COND_LS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4179,9 +4465,11 @@ static void m68k_op_bcc_8(void)
   if(COND_CC())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4190,9 +4478,11 @@ static void m68k_op_bcs_8(void)
   if(COND_CS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4201,9 +4491,11 @@ static void m68k_op_bne_8(void)
   if(COND_NE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4212,9 +4504,11 @@ static void m68k_op_beq_8(void)
   if(COND_EQ())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4223,9 +4517,11 @@ static void m68k_op_bvc_8(void)
   if(COND_VC())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4234,9 +4530,11 @@ static void m68k_op_bvs_8(void)
   if(COND_VS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4245,9 +4543,11 @@ static void m68k_op_bpl_8(void)
   if(COND_PL())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4256,9 +4556,11 @@ static void m68k_op_bmi_8(void)
   if(COND_MI())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4267,9 +4569,11 @@ static void m68k_op_bge_8(void)
   if(COND_GE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4278,9 +4582,11 @@ static void m68k_op_blt_8(void)
   if(COND_LT())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4289,9 +4595,11 @@ static void m68k_op_bgt_8(void)
   if(COND_GT())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4300,9 +4608,11 @@ static void m68k_op_ble_8(void)
   if(COND_LE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4313,10 +4623,12 @@ static void m68k_op_bhi_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4327,10 +4639,12 @@ static void m68k_op_bls_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4341,10 +4655,12 @@ static void m68k_op_bcc_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4355,10 +4671,12 @@ static void m68k_op_bcs_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4369,10 +4687,12 @@ static void m68k_op_bne_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4383,10 +4703,12 @@ static void m68k_op_beq_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4397,10 +4719,12 @@ static void m68k_op_bvc_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4411,10 +4735,12 @@ static void m68k_op_bvs_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4425,10 +4751,12 @@ static void m68k_op_bpl_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4439,10 +4767,12 @@ static void m68k_op_bmi_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4453,10 +4783,12 @@ static void m68k_op_bge_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4467,10 +4799,12 @@ static void m68k_op_blt_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4481,10 +4815,12 @@ static void m68k_op_bgt_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4495,10 +4831,12 @@ static void m68k_op_ble_16(void)
     uint offset = OPER_I_16();
     REG_PC -= 2;
     m68ki_branch_16(offset);
+    USE_CYCLES(10*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_BCC_NOTAKE_W);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4507,9 +4845,11 @@ static void m68k_op_bhi_32(void)
   if(COND_HI())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4518,9 +4858,11 @@ static void m68k_op_bls_32(void)
   if(COND_LS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4529,9 +4871,11 @@ static void m68k_op_bcc_32(void)
   if(COND_CC())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4540,9 +4884,11 @@ static void m68k_op_bcs_32(void)
   if(COND_CS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4551,9 +4897,11 @@ static void m68k_op_bne_32(void)
   if(COND_NE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4562,9 +4910,11 @@ static void m68k_op_beq_32(void)
   if(COND_EQ())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4573,9 +4923,11 @@ static void m68k_op_bvc_32(void)
   if(COND_VC())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4584,9 +4936,11 @@ static void m68k_op_bvs_32(void)
   if(COND_VS())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4595,9 +4949,11 @@ static void m68k_op_bpl_32(void)
   if(COND_PL())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4606,9 +4962,11 @@ static void m68k_op_bmi_32(void)
   if(COND_MI())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4617,9 +4975,11 @@ static void m68k_op_bge_32(void)
   if(COND_GE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4628,9 +4988,11 @@ static void m68k_op_blt_32(void)
   if(COND_LT())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4639,9 +5001,11 @@ static void m68k_op_bgt_32(void)
   if(COND_GT())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4650,9 +5014,11 @@ static void m68k_op_ble_32(void)
   if(COND_LE())
   {
     m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+    USE_CYCLES(10*MUL);
     return;
   }
   USE_CYCLES(CYC_BCC_NOTAKE_B);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4663,6 +5029,7 @@ static void m68k_op_bchg_32_r_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst ^= mask;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -4674,6 +5041,7 @@ static void m68k_op_bchg_8_r_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4685,6 +5053,7 @@ static void m68k_op_bchg_8_r_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4696,6 +5065,7 @@ static void m68k_op_bchg_8_r_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4707,6 +5077,7 @@ static void m68k_op_bchg_8_r_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -4718,6 +5089,7 @@ static void m68k_op_bchg_8_r_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -4729,6 +5101,7 @@ static void m68k_op_bchg_8_r_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4740,6 +5113,7 @@ static void m68k_op_bchg_8_r_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -4751,6 +5125,7 @@ static void m68k_op_bchg_8_r_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4762,6 +5137,7 @@ static void m68k_op_bchg_8_r_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -4772,6 +5148,7 @@ static void m68k_op_bchg_32_s_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst ^= mask;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4783,6 +5160,7 @@ static void m68k_op_bchg_8_s_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4794,6 +5172,7 @@ static void m68k_op_bchg_8_s_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4805,6 +5184,7 @@ static void m68k_op_bchg_8_s_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4816,6 +5196,7 @@ static void m68k_op_bchg_8_s_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -4827,6 +5208,7 @@ static void m68k_op_bchg_8_s_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -4838,6 +5220,7 @@ static void m68k_op_bchg_8_s_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -4849,6 +5232,7 @@ static void m68k_op_bchg_8_s_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -4860,6 +5244,7 @@ static void m68k_op_bchg_8_s_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -4871,6 +5256,7 @@ static void m68k_op_bchg_8_s_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src ^ mask);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -4881,6 +5267,7 @@ static void m68k_op_bclr_32_r_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst &= ~mask;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -4892,6 +5279,7 @@ static void m68k_op_bclr_8_r_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4903,6 +5291,7 @@ static void m68k_op_bclr_8_r_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4914,6 +5303,7 @@ static void m68k_op_bclr_8_r_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -4925,6 +5315,7 @@ static void m68k_op_bclr_8_r_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -4936,6 +5327,7 @@ static void m68k_op_bclr_8_r_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -4947,6 +5339,7 @@ static void m68k_op_bclr_8_r_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4958,6 +5351,7 @@ static void m68k_op_bclr_8_r_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -4969,6 +5363,7 @@ static void m68k_op_bclr_8_r_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -4980,6 +5375,7 @@ static void m68k_op_bclr_8_r_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -4990,6 +5386,7 @@ static void m68k_op_bclr_32_s_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst &= ~mask;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5001,6 +5398,7 @@ static void m68k_op_bclr_8_s_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5012,6 +5410,7 @@ static void m68k_op_bclr_8_s_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5023,6 +5422,7 @@ static void m68k_op_bclr_8_s_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5034,6 +5434,7 @@ static void m68k_op_bclr_8_s_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5045,6 +5446,7 @@ static void m68k_op_bclr_8_s_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5056,6 +5458,7 @@ static void m68k_op_bclr_8_s_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5067,6 +5470,7 @@ static void m68k_op_bclr_8_s_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -5078,6 +5482,7 @@ static void m68k_op_bclr_8_s_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5089,12 +5494,14 @@ static void m68k_op_bclr_8_s_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src & ~mask);
+  USE_CYCLES(24*MUL);
 }
 
 
 static void m68k_op_bra_8(void)
 {
   m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -5103,12 +5510,14 @@ static void m68k_op_bra_16(void)
   uint offset = OPER_I_16();
   REG_PC -= 2;
   m68ki_branch_16(offset);
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_bra_32(void)
 {
   m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -5119,6 +5528,7 @@ static void m68k_op_bset_32_r_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst |= mask;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -5130,6 +5540,7 @@ static void m68k_op_bset_8_r_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5141,6 +5552,7 @@ static void m68k_op_bset_8_r_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5152,6 +5564,7 @@ static void m68k_op_bset_8_r_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5163,6 +5576,7 @@ static void m68k_op_bset_8_r_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5174,6 +5588,7 @@ static void m68k_op_bset_8_r_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5185,6 +5600,7 @@ static void m68k_op_bset_8_r_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5196,6 +5612,7 @@ static void m68k_op_bset_8_r_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5207,6 +5624,7 @@ static void m68k_op_bset_8_r_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5218,6 +5636,7 @@ static void m68k_op_bset_8_r_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5228,6 +5647,7 @@ static void m68k_op_bset_32_s_d(void)
 
   FLAG_Z = *r_dst & mask;
   *r_dst |= mask;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5239,6 +5659,7 @@ static void m68k_op_bset_8_s_ai(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5250,6 +5671,7 @@ static void m68k_op_bset_8_s_pi(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5261,6 +5683,7 @@ static void m68k_op_bset_8_s_pi7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5272,6 +5695,7 @@ static void m68k_op_bset_8_s_pd(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5283,6 +5707,7 @@ static void m68k_op_bset_8_s_pd7(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5294,6 +5719,7 @@ static void m68k_op_bset_8_s_di(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5305,6 +5731,7 @@ static void m68k_op_bset_8_s_ix(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -5316,6 +5743,7 @@ static void m68k_op_bset_8_s_aw(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5327,6 +5755,7 @@ static void m68k_op_bset_8_s_al(void)
 
   FLAG_Z = src & mask;
   m68ki_write_8(ea, src | mask);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -5334,6 +5763,7 @@ static void m68k_op_bsr_8(void)
 {
   m68ki_push_32(REG_PC);
   m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5343,6 +5773,7 @@ static void m68k_op_bsr_16(void)
   m68ki_push_32(REG_PC);
   REG_PC -= 2;
   m68ki_branch_16(offset);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5350,90 +5781,106 @@ static void m68k_op_bsr_32(void)
 {
   m68ki_push_32(REG_PC);
   m68ki_branch_8(MASK_OUT_ABOVE_8(REG_IR));
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_btst_32_r_d(void)
 {
   FLAG_Z = DY & (1 << (DX & 0x1f));
+  USE_CYCLES(6*MUL);
 }
 
 
 static void m68k_op_btst_8_r_ai(void)
 {
   FLAG_Z = OPER_AY_AI_8() & (1 << (DX & 7));
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pi(void)
 {
   FLAG_Z = OPER_AY_PI_8() & (1 << (DX & 7));
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pi7(void)
 {
   FLAG_Z = OPER_A7_PI_8() & (1 << (DX & 7));
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pd(void)
 {
   FLAG_Z = OPER_AY_PD_8() & (1 << (DX & 7));
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pd7(void)
 {
   FLAG_Z = OPER_A7_PD_8() & (1 << (DX & 7));
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_btst_8_r_di(void)
 {
   FLAG_Z = OPER_AY_DI_8() & (1 << (DX & 7));
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_btst_8_r_ix(void)
 {
   FLAG_Z = OPER_AY_IX_8() & (1 << (DX & 7));
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_btst_8_r_aw(void)
 {
   FLAG_Z = OPER_AW_8() & (1 << (DX & 7));
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_btst_8_r_al(void)
 {
   FLAG_Z = OPER_AL_8() & (1 << (DX & 7));
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pcdi(void)
 {
   FLAG_Z = OPER_PCDI_8() & (1 << (DX & 7));
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_btst_8_r_pcix(void)
 {
   FLAG_Z = OPER_PCIX_8() & (1 << (DX & 7));
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_btst_8_r_i(void)
 {
   FLAG_Z = OPER_I_8() & (1 << (DX & 7));
+  /* table: 10 cycles, 8 for BTST D7,#imm on the sub 68k (s68ki_cycles.h) */
+  USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
 }
 
 
 static void m68k_op_btst_32_s_d(void)
 {
   FLAG_Z = DY & (1 << (OPER_I_8() & 0x1f));
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -5442,6 +5889,7 @@ static void m68k_op_btst_8_s_ai(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AY_AI_8() & (1 << bit);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5450,6 +5898,7 @@ static void m68k_op_btst_8_s_pi(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AY_PI_8() & (1 << bit);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5458,6 +5907,7 @@ static void m68k_op_btst_8_s_pi7(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_A7_PI_8() & (1 << bit);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5466,6 +5916,7 @@ static void m68k_op_btst_8_s_pd(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AY_PD_8() & (1 << bit);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5474,6 +5925,7 @@ static void m68k_op_btst_8_s_pd7(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_A7_PD_8() & (1 << bit);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5482,6 +5934,7 @@ static void m68k_op_btst_8_s_di(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AY_DI_8() & (1 << bit);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5490,6 +5943,7 @@ static void m68k_op_btst_8_s_ix(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AY_IX_8() & (1 << bit);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5498,6 +5952,7 @@ static void m68k_op_btst_8_s_aw(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AW_8() & (1 << bit);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5506,6 +5961,7 @@ static void m68k_op_btst_8_s_al(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_AL_8() & (1 << bit);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5514,6 +5970,7 @@ static void m68k_op_btst_8_s_pcdi(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_PCDI_8() & (1 << bit);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5522,6 +5979,7 @@ static void m68k_op_btst_8_s_pcix(void)
   uint bit = OPER_I_8() & 7;
 
   FLAG_Z = OPER_PCIX_8() & (1 << bit);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5536,10 +5994,12 @@ static void m68k_op_chk_16_d(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(10*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -5554,10 +6014,12 @@ static void m68k_op_chk_16_ai(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(14*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5572,10 +6034,12 @@ static void m68k_op_chk_16_pi(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(14*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5590,10 +6054,12 @@ static void m68k_op_chk_16_pd(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(16*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5608,10 +6074,12 @@ static void m68k_op_chk_16_di(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(18*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5626,10 +6094,12 @@ static void m68k_op_chk_16_ix(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(20*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5644,10 +6114,12 @@ static void m68k_op_chk_16_aw(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(18*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5662,10 +6134,12 @@ static void m68k_op_chk_16_al(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(22*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -5680,10 +6154,12 @@ static void m68k_op_chk_16_pcdi(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(18*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5698,10 +6174,12 @@ static void m68k_op_chk_16_pcix(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(20*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5716,10 +6194,12 @@ static void m68k_op_chk_16_i(void)
 
   if(src >= 0 && src <= bound)
   {
+    USE_CYCLES(14*MUL);
     return;
   }
   FLAG_N = (src < 0)<<7;
   m68ki_exception_trap(EXCEPTION_CHK);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5731,6 +6211,7 @@ static void m68k_op_clr_8_d(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -5742,6 +6223,7 @@ static void m68k_op_clr_8_ai(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5753,6 +6235,7 @@ static void m68k_op_clr_8_pi(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5764,6 +6247,7 @@ static void m68k_op_clr_8_pi7(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5775,6 +6259,7 @@ static void m68k_op_clr_8_pd(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5786,6 +6271,7 @@ static void m68k_op_clr_8_pd7(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5797,6 +6283,7 @@ static void m68k_op_clr_8_di(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5808,6 +6295,7 @@ static void m68k_op_clr_8_ix(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5819,6 +6307,7 @@ static void m68k_op_clr_8_aw(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5830,6 +6319,7 @@ static void m68k_op_clr_8_al(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5841,6 +6331,7 @@ static void m68k_op_clr_16_d(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -5852,6 +6343,7 @@ static void m68k_op_clr_16_ai(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5863,6 +6355,7 @@ static void m68k_op_clr_16_pi(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -5874,6 +6367,7 @@ static void m68k_op_clr_16_pd(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -5885,6 +6379,7 @@ static void m68k_op_clr_16_di(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5896,6 +6391,7 @@ static void m68k_op_clr_16_ix(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -5907,6 +6403,7 @@ static void m68k_op_clr_16_aw(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -5918,6 +6415,7 @@ static void m68k_op_clr_16_al(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5929,6 +6427,7 @@ static void m68k_op_clr_32_d(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -5940,6 +6439,7 @@ static void m68k_op_clr_32_ai(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5951,6 +6451,7 @@ static void m68k_op_clr_32_pi(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -5962,6 +6463,7 @@ static void m68k_op_clr_32_pd(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -5973,6 +6475,7 @@ static void m68k_op_clr_32_di(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -5984,6 +6487,7 @@ static void m68k_op_clr_32_ix(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -5995,6 +6499,7 @@ static void m68k_op_clr_32_aw(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -6006,6 +6511,7 @@ static void m68k_op_clr_32_al(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   FLAG_Z = ZFLAG_SET;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -6019,6 +6525,7 @@ static void m68k_op_cmp_8_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -6032,6 +6539,7 @@ static void m68k_op_cmp_8_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6045,6 +6553,7 @@ static void m68k_op_cmp_8_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6058,6 +6567,7 @@ static void m68k_op_cmp_8_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6071,6 +6581,7 @@ static void m68k_op_cmp_8_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6084,6 +6595,7 @@ static void m68k_op_cmp_8_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6097,6 +6609,7 @@ static void m68k_op_cmp_8_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6110,6 +6623,7 @@ static void m68k_op_cmp_8_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6123,6 +6637,7 @@ static void m68k_op_cmp_8_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6136,6 +6651,7 @@ static void m68k_op_cmp_8_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6149,6 +6665,7 @@ static void m68k_op_cmp_8_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6162,6 +6679,7 @@ static void m68k_op_cmp_8_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6175,6 +6693,7 @@ static void m68k_op_cmp_8_i(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6188,6 +6707,7 @@ static void m68k_op_cmp_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -6201,6 +6721,7 @@ static void m68k_op_cmp_16_a(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -6214,6 +6735,7 @@ static void m68k_op_cmp_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6227,6 +6749,7 @@ static void m68k_op_cmp_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6240,6 +6763,7 @@ static void m68k_op_cmp_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6253,6 +6777,7 @@ static void m68k_op_cmp_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6266,6 +6791,7 @@ static void m68k_op_cmp_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6279,6 +6805,7 @@ static void m68k_op_cmp_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6292,6 +6819,7 @@ static void m68k_op_cmp_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6305,6 +6833,7 @@ static void m68k_op_cmp_16_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6318,6 +6847,7 @@ static void m68k_op_cmp_16_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6331,6 +6861,7 @@ static void m68k_op_cmp_16_i(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6344,6 +6875,7 @@ static void m68k_op_cmp_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6357,6 +6889,7 @@ static void m68k_op_cmp_32_a(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6370,6 +6903,7 @@ static void m68k_op_cmp_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6383,6 +6917,7 @@ static void m68k_op_cmp_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6396,6 +6931,7 @@ static void m68k_op_cmp_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6409,6 +6945,7 @@ static void m68k_op_cmp_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6422,6 +6959,7 @@ static void m68k_op_cmp_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -6435,6 +6973,7 @@ static void m68k_op_cmp_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6448,6 +6987,7 @@ static void m68k_op_cmp_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -6461,6 +7001,7 @@ static void m68k_op_cmp_32_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6474,6 +7015,7 @@ static void m68k_op_cmp_32_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -6487,6 +7029,7 @@ static void m68k_op_cmp_32_i(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6500,6 +7043,7 @@ static void m68k_op_cmpa_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6513,6 +7057,7 @@ static void m68k_op_cmpa_16_a(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6526,6 +7071,7 @@ static void m68k_op_cmpa_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6539,6 +7085,7 @@ static void m68k_op_cmpa_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6552,6 +7099,7 @@ static void m68k_op_cmpa_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6565,6 +7113,7 @@ static void m68k_op_cmpa_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6578,6 +7127,7 @@ static void m68k_op_cmpa_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6591,6 +7141,7 @@ static void m68k_op_cmpa_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6604,6 +7155,7 @@ static void m68k_op_cmpa_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6617,6 +7169,7 @@ static void m68k_op_cmpa_16_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6630,6 +7183,7 @@ static void m68k_op_cmpa_16_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6643,6 +7197,7 @@ static void m68k_op_cmpa_16_i(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -6656,6 +7211,7 @@ static void m68k_op_cmpa_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6669,6 +7225,7 @@ static void m68k_op_cmpa_32_a(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -6682,6 +7239,7 @@ static void m68k_op_cmpa_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6695,6 +7253,7 @@ static void m68k_op_cmpa_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6708,6 +7267,7 @@ static void m68k_op_cmpa_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6721,6 +7281,7 @@ static void m68k_op_cmpa_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6734,6 +7295,7 @@ static void m68k_op_cmpa_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -6747,6 +7309,7 @@ static void m68k_op_cmpa_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6760,6 +7323,7 @@ static void m68k_op_cmpa_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -6773,6 +7337,7 @@ static void m68k_op_cmpa_32_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6786,6 +7351,7 @@ static void m68k_op_cmpa_32_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -6799,6 +7365,7 @@ static void m68k_op_cmpa_32_i(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6812,6 +7379,7 @@ static void m68k_op_cmpi_8_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6825,6 +7393,7 @@ static void m68k_op_cmpi_8_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6838,6 +7407,7 @@ static void m68k_op_cmpi_8_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6851,6 +7421,7 @@ static void m68k_op_cmpi_8_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6864,6 +7435,7 @@ static void m68k_op_cmpi_8_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6877,6 +7449,7 @@ static void m68k_op_cmpi_8_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6890,6 +7463,7 @@ static void m68k_op_cmpi_8_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6903,6 +7477,7 @@ static void m68k_op_cmpi_8_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -6916,6 +7491,7 @@ static void m68k_op_cmpi_8_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -6929,6 +7505,7 @@ static void m68k_op_cmpi_8_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -6942,6 +7519,7 @@ static void m68k_op_cmpi_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -6955,6 +7533,7 @@ static void m68k_op_cmpi_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6968,6 +7547,7 @@ static void m68k_op_cmpi_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -6981,6 +7561,7 @@ static void m68k_op_cmpi_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -6994,6 +7575,7 @@ static void m68k_op_cmpi_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -7007,6 +7589,7 @@ static void m68k_op_cmpi_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -7020,6 +7603,7 @@ static void m68k_op_cmpi_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -7033,6 +7617,7 @@ static void m68k_op_cmpi_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -7046,6 +7631,7 @@ static void m68k_op_cmpi_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -7059,6 +7645,7 @@ static void m68k_op_cmpi_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -7072,6 +7659,7 @@ static void m68k_op_cmpi_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -7085,6 +7673,7 @@ static void m68k_op_cmpi_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -7098,6 +7687,7 @@ static void m68k_op_cmpi_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -7111,6 +7701,7 @@ static void m68k_op_cmpi_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -7124,6 +7715,7 @@ static void m68k_op_cmpi_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -7137,6 +7729,7 @@ static void m68k_op_cmpi_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -7150,6 +7743,7 @@ static void m68k_op_cmpm_8_ax7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7163,6 +7757,7 @@ static void m68k_op_cmpm_8_ay7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7176,6 +7771,7 @@ static void m68k_op_cmpm_8_axy7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7189,6 +7785,7 @@ static void m68k_op_cmpm_8(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
   FLAG_V = VFLAG_SUB_8(src, dst, res);
   FLAG_C = CFLAG_8(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7202,6 +7799,7 @@ static void m68k_op_cmpm_16(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
   FLAG_V = VFLAG_SUB_16(src, dst, res);
   FLAG_C = CFLAG_16(res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7215,12 +7813,14 @@ static void m68k_op_cmpm_32(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
   FLAG_C = CFLAG_SUB_32(src, dst, res);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_dbt_16(void)
 {
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7239,10 +7839,12 @@ static void m68k_op_dbf_16(void)
 
     /* reset idle loop detection */
     m68ki_cpu.poll.detected = 0;
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
   USE_CYCLES(CYC_DBCC_F_EXP);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7263,13 +7865,16 @@ static void m68k_op_dbhi_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7290,13 +7895,16 @@ static void m68k_op_dbls_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7317,13 +7925,16 @@ static void m68k_op_dbcc_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7344,13 +7955,16 @@ static void m68k_op_dbcs_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7371,13 +7985,16 @@ static void m68k_op_dbne_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7398,13 +8015,16 @@ static void m68k_op_dbeq_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7425,13 +8045,16 @@ static void m68k_op_dbvc_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7452,13 +8075,16 @@ static void m68k_op_dbvs_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7479,13 +8105,16 @@ static void m68k_op_dbpl_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7506,13 +8135,16 @@ static void m68k_op_dbmi_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7533,13 +8165,16 @@ static void m68k_op_dbge_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7560,13 +8195,16 @@ static void m68k_op_dblt_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7587,13 +8225,16 @@ static void m68k_op_dbgt_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7614,13 +8255,16 @@ static void m68k_op_dble_16(void)
 
       /* reset idle loop detection */
       m68ki_cpu.poll.detected = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
     REG_PC += 2;
     USE_CYCLES(CYC_DBCC_F_EXP);
+    USE_CYCLES(12*MUL);
     return;
   }
   REG_PC += 2;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7685,6 +8329,7 @@ static void m68k_op_divs_16_ai(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(4*MUL);
       return;
     }
 
@@ -7698,15 +8343,18 @@ static void m68k_op_divs_16_ai(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -7728,6 +8376,7 @@ static void m68k_op_divs_16_pi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(4*MUL);
       return;
     }
 
@@ -7741,15 +8390,18 @@ static void m68k_op_divs_16_pi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -7771,6 +8423,7 @@ static void m68k_op_divs_16_pd(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -7784,15 +8437,18 @@ static void m68k_op_divs_16_pd(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(6*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -7814,6 +8470,7 @@ static void m68k_op_divs_16_di(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -7827,15 +8484,18 @@ static void m68k_op_divs_16_di(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -7857,6 +8517,7 @@ static void m68k_op_divs_16_ix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(10*MUL);
       return;
     }
 
@@ -7870,15 +8531,18 @@ static void m68k_op_divs_16_ix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(10*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(10*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -7900,6 +8564,7 @@ static void m68k_op_divs_16_aw(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -7913,15 +8578,18 @@ static void m68k_op_divs_16_aw(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -7943,6 +8611,7 @@ static void m68k_op_divs_16_al(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(12*MUL);
       return;
     }
 
@@ -7956,15 +8625,18 @@ static void m68k_op_divs_16_al(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(12*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(12*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -7986,6 +8658,7 @@ static void m68k_op_divs_16_pcdi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -7999,15 +8672,18 @@ static void m68k_op_divs_16_pcdi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8029,6 +8705,7 @@ static void m68k_op_divs_16_pcix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(10*MUL);
       return;
     }
 
@@ -8042,15 +8719,18 @@ static void m68k_op_divs_16_pcix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(10*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(10*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -8072,6 +8752,7 @@ static void m68k_op_divs_16_i(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = 0;
+      USE_CYCLES(4*MUL);
       return;
     }
 
@@ -8085,15 +8766,18 @@ static void m68k_op_divs_16_i(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8146,16 +8830,19 @@ static void m68k_op_divu_16_ai(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8177,16 +8864,19 @@ static void m68k_op_divu_16_pi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8208,16 +8898,19 @@ static void m68k_op_divu_16_pd(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(6*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -8239,16 +8932,19 @@ static void m68k_op_divu_16_di(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8270,16 +8966,19 @@ static void m68k_op_divu_16_ix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(10*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(10*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -8301,16 +9000,19 @@ static void m68k_op_divu_16_aw(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8332,16 +9034,19 @@ static void m68k_op_divu_16_al(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(12*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(12*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8363,16 +9068,19 @@ static void m68k_op_divu_16_pcdi(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(8*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8394,16 +9102,19 @@ static void m68k_op_divu_16_pcix(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(10*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(10*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -8425,16 +9136,19 @@ static void m68k_op_divu_16_i(void)
       FLAG_V = VFLAG_CLEAR;
       FLAG_C = CFLAG_CLEAR;
       *r_dst = MASK_OUT_ABOVE_32(MASK_OUT_ABOVE_16(quotient) | (remainder << 16));
+      USE_CYCLES(4*MUL);
       return;
     }
     USE_CYCLES(MUL * 10);
     FLAG_V = VFLAG_SET;
     FLAG_N = NFLAG_SET; /* undocumented behavior (fixes Blood Shot on Genesis) */
     FLAG_C = CFLAG_CLEAR;
+    USE_CYCLES(4*MUL);
     return;
   }
   FLAG_C = CFLAG_CLEAR;
   m68ki_exception_trap(EXCEPTION_ZERO_DIVIDE);
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8446,6 +9160,7 @@ static void m68k_op_eor_8_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8460,6 +9175,7 @@ static void m68k_op_eor_8_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8474,6 +9190,7 @@ static void m68k_op_eor_8_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8488,6 +9205,7 @@ static void m68k_op_eor_8_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8502,6 +9220,7 @@ static void m68k_op_eor_8_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -8516,6 +9235,7 @@ static void m68k_op_eor_8_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -8530,6 +9250,7 @@ static void m68k_op_eor_8_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8544,6 +9265,7 @@ static void m68k_op_eor_8_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -8558,6 +9280,7 @@ static void m68k_op_eor_8_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8572,6 +9295,7 @@ static void m68k_op_eor_8_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8583,6 +9307,7 @@ static void m68k_op_eor_16_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -8597,6 +9322,7 @@ static void m68k_op_eor_16_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8611,6 +9337,7 @@ static void m68k_op_eor_16_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -8625,6 +9352,7 @@ static void m68k_op_eor_16_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -8639,6 +9367,7 @@ static void m68k_op_eor_16_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8653,6 +9382,7 @@ static void m68k_op_eor_16_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -8667,6 +9397,7 @@ static void m68k_op_eor_16_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8681,6 +9412,7 @@ static void m68k_op_eor_16_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8692,6 +9424,7 @@ static void m68k_op_eor_32_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8706,6 +9439,7 @@ static void m68k_op_eor_32_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8720,6 +9454,7 @@ static void m68k_op_eor_32_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8734,6 +9469,7 @@ static void m68k_op_eor_32_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -8748,6 +9484,7 @@ static void m68k_op_eor_32_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -8762,6 +9499,7 @@ static void m68k_op_eor_32_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -8776,6 +9514,7 @@ static void m68k_op_eor_32_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -8790,6 +9529,7 @@ static void m68k_op_eor_32_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -8801,6 +9541,7 @@ static void m68k_op_eori_8_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8816,6 +9557,7 @@ static void m68k_op_eori_8_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8831,6 +9573,7 @@ static void m68k_op_eori_8_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8846,6 +9589,7 @@ static void m68k_op_eori_8_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8861,6 +9605,7 @@ static void m68k_op_eori_8_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -8876,6 +9621,7 @@ static void m68k_op_eori_8_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -8891,6 +9637,7 @@ static void m68k_op_eori_8_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8906,6 +9653,7 @@ static void m68k_op_eori_8_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -8921,6 +9669,7 @@ static void m68k_op_eori_8_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -8936,6 +9685,7 @@ static void m68k_op_eori_8_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -8947,6 +9697,7 @@ static void m68k_op_eori_16_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -8962,6 +9713,7 @@ static void m68k_op_eori_16_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8977,6 +9729,7 @@ static void m68k_op_eori_16_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -8992,6 +9745,7 @@ static void m68k_op_eori_16_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9007,6 +9761,7 @@ static void m68k_op_eori_16_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9022,6 +9777,7 @@ static void m68k_op_eori_16_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -9037,6 +9793,7 @@ static void m68k_op_eori_16_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9052,6 +9809,7 @@ static void m68k_op_eori_16_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -9063,6 +9821,7 @@ static void m68k_op_eori_32_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9078,6 +9837,7 @@ static void m68k_op_eori_32_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -9093,6 +9853,7 @@ static void m68k_op_eori_32_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -9108,6 +9869,7 @@ static void m68k_op_eori_32_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -9123,6 +9885,7 @@ static void m68k_op_eori_32_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -9138,6 +9901,7 @@ static void m68k_op_eori_32_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -9153,6 +9917,7 @@ static void m68k_op_eori_32_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -9168,12 +9933,14 @@ static void m68k_op_eori_32_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(36*MUL);
 }
 
 
 static void m68k_op_eori_16_toc(void)
 {
   m68ki_set_ccr(m68ki_get_ccr() ^ OPER_I_16());
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9183,9 +9950,11 @@ static void m68k_op_eori_16_tos(void)
   {
     uint src = OPER_I_16();
     m68ki_set_sr(m68ki_get_sr() ^ src);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9196,6 +9965,7 @@ static void m68k_op_exg_32_dd(void)
   uint tmp = *reg_a;
   *reg_a = *reg_b;
   *reg_b = tmp;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9206,6 +9976,7 @@ static void m68k_op_exg_32_aa(void)
   uint tmp = *reg_a;
   *reg_a = *reg_b;
   *reg_b = tmp;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9216,6 +9987,7 @@ static void m68k_op_exg_32_da(void)
   uint tmp = *reg_a;
   *reg_a = *reg_b;
   *reg_b = tmp;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9229,6 +10001,7 @@ static void m68k_op_ext_16(void)
   FLAG_Z = MASK_OUT_ABOVE_16(*r_dst);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -9242,54 +10015,63 @@ static void m68k_op_ext_32(void)
   FLAG_Z = *r_dst;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_illegal(void)
 {
   m68ki_exception_illegal();
+  USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
 }
 
 
 static void m68k_op_jmp_32_ai(void)
 {
   m68ki_jump(EA_AY_AI_32());
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_jmp_32_di(void)
 {
   m68ki_jump(EA_AY_DI_32());
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_jmp_32_ix(void)
 {
   m68ki_jump(EA_AY_IX_32());
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_jmp_32_aw(void)
 {
   m68ki_jump(EA_AW_32());
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_jmp_32_al(void)
 {
   m68ki_jump(EA_AL_32());
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_jmp_32_pcdi(void)
 {
   m68ki_jump(EA_PCDI_32());
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_jmp_32_pcix(void)
 {
   m68ki_jump(EA_PCIX_32());
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -9298,6 +10080,7 @@ static void m68k_op_jsr_32_ai(void)
   uint ea = EA_AY_AI_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9306,6 +10089,7 @@ static void m68k_op_jsr_32_di(void)
   uint ea = EA_AY_DI_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9314,6 +10098,7 @@ static void m68k_op_jsr_32_ix(void)
   uint ea = EA_AY_IX_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -9322,6 +10107,7 @@ static void m68k_op_jsr_32_aw(void)
   uint ea = EA_AW_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9330,6 +10116,7 @@ static void m68k_op_jsr_32_al(void)
   uint ea = EA_AL_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9338,6 +10125,7 @@ static void m68k_op_jsr_32_pcdi(void)
   uint ea = EA_PCDI_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9346,48 +10134,56 @@ static void m68k_op_jsr_32_pcix(void)
   uint ea = EA_PCIX_32();
   m68ki_push_32(REG_PC);
   m68ki_jump(ea);
+  USE_CYCLES(22*MUL);
 }
 
 
 static void m68k_op_lea_32_ai(void)
 {
   AX = EA_AY_AI_32();
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_lea_32_di(void)
 {
   AX = EA_AY_DI_32();
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_lea_32_ix(void)
 {
   AX = EA_AY_IX_32();
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_lea_32_aw(void)
 {
   AX = EA_AW_32();
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_lea_32_al(void)
 {
   AX = EA_AL_32();
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_lea_32_pcdi(void)
 {
   AX = EA_PCDI_32();
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_lea_32_pcix(void)
 {
   AX = EA_PCIX_32();
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -9396,6 +10192,7 @@ static void m68k_op_link_16_a7(void)
   REG_A[7] -= 4;
   m68ki_write_32(REG_A[7], REG_A[7]);
   REG_A[7] = MASK_OUT_ABOVE_32(REG_A[7] + MAKE_INT_16(OPER_I_16()));
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9406,6 +10203,7 @@ static void m68k_op_link_16(void)
   m68ki_push_32(*r_dst);
   *r_dst = REG_A[7];
   REG_A[7] = MASK_OUT_ABOVE_32(REG_A[7] + MAKE_INT_16(OPER_I_16()));
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9425,6 +10223,7 @@ static void m68k_op_lsr_8_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src << (9-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9444,6 +10243,7 @@ static void m68k_op_lsr_16_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src << (9-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9463,6 +10263,7 @@ static void m68k_op_lsr_32_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src << (9-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -9484,6 +10285,7 @@ static void m68k_op_lsr_8_r(void)
       FLAG_N = NFLAG_CLEAR;
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -9493,6 +10295,7 @@ static void m68k_op_lsr_8_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -9500,6 +10303,7 @@ static void m68k_op_lsr_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9521,6 +10325,7 @@ static void m68k_op_lsr_16_r(void)
       FLAG_N = NFLAG_CLEAR;
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -9530,6 +10335,7 @@ static void m68k_op_lsr_16_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -9537,6 +10343,7 @@ static void m68k_op_lsr_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9558,6 +10365,7 @@ static void m68k_op_lsr_32_r(void)
       FLAG_N = NFLAG_CLEAR;
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -9566,6 +10374,7 @@ static void m68k_op_lsr_32_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -9573,6 +10382,7 @@ static void m68k_op_lsr_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -9588,6 +10398,7 @@ static void m68k_op_lsr_16_ai(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -9603,6 +10414,7 @@ static void m68k_op_lsr_16_pi(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -9618,6 +10430,7 @@ static void m68k_op_lsr_16_pd(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -9633,6 +10446,7 @@ static void m68k_op_lsr_16_di(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9648,6 +10462,7 @@ static void m68k_op_lsr_16_ix(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9663,6 +10478,7 @@ static void m68k_op_lsr_16_aw(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9678,6 +10494,7 @@ static void m68k_op_lsr_16_al(void)
   FLAG_Z = res;
   FLAG_C = FLAG_X = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9697,6 +10514,7 @@ static void m68k_op_lsl_8_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src << shift;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9716,6 +10534,7 @@ static void m68k_op_lsl_16_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> (8-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9735,6 +10554,7 @@ static void m68k_op_lsl_32_s(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> (24-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -9756,6 +10576,7 @@ static void m68k_op_lsl_8_r(void)
       FLAG_N = NFLAG_8(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -9765,6 +10586,7 @@ static void m68k_op_lsl_8_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -9772,6 +10594,7 @@ static void m68k_op_lsl_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9793,6 +10616,7 @@ static void m68k_op_lsl_16_r(void)
       FLAG_N = NFLAG_16(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
 
@@ -9802,6 +10626,7 @@ static void m68k_op_lsl_16_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -9809,6 +10634,7 @@ static void m68k_op_lsl_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -9830,6 +10656,7 @@ static void m68k_op_lsl_32_r(void)
       FLAG_N = NFLAG_32(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(8*MUL);
       return;
     }
 
@@ -9838,6 +10665,7 @@ static void m68k_op_lsl_32_r(void)
     FLAG_N = NFLAG_CLEAR;
     FLAG_Z = ZFLAG_SET;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -9845,6 +10673,7 @@ static void m68k_op_lsl_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -9860,6 +10689,7 @@ static void m68k_op_lsl_16_ai(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -9875,6 +10705,7 @@ static void m68k_op_lsl_16_pi(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -9890,6 +10721,7 @@ static void m68k_op_lsl_16_pd(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -9905,6 +10737,7 @@ static void m68k_op_lsl_16_di(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9920,6 +10753,7 @@ static void m68k_op_lsl_16_ix(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -9935,6 +10769,7 @@ static void m68k_op_lsl_16_aw(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -9950,6 +10785,7 @@ static void m68k_op_lsl_16_al(void)
   FLAG_Z = res;
   FLAG_X = FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -9964,6 +10800,7 @@ static void m68k_op_move_8_d_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -9978,6 +10815,7 @@ static void m68k_op_move_8_d_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -9992,6 +10830,7 @@ static void m68k_op_move_8_d_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10006,6 +10845,7 @@ static void m68k_op_move_8_d_pi7(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10020,6 +10860,7 @@ static void m68k_op_move_8_d_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -10034,6 +10875,7 @@ static void m68k_op_move_8_d_pd7(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -10048,6 +10890,7 @@ static void m68k_op_move_8_d_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10062,6 +10905,7 @@ static void m68k_op_move_8_d_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10076,6 +10920,7 @@ static void m68k_op_move_8_d_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10090,6 +10935,7 @@ static void m68k_op_move_8_d_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10104,6 +10950,7 @@ static void m68k_op_move_8_d_pcdi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10118,6 +10965,7 @@ static void m68k_op_move_8_d_pcix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10132,6 +10980,7 @@ static void m68k_op_move_8_d_i(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10146,6 +10995,7 @@ static void m68k_op_move_8_ai_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10160,6 +11010,7 @@ static void m68k_op_move_8_ai_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10174,6 +11025,7 @@ static void m68k_op_move_8_ai_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10188,6 +11040,7 @@ static void m68k_op_move_8_ai_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10202,6 +11055,7 @@ static void m68k_op_move_8_ai_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10216,6 +11070,7 @@ static void m68k_op_move_8_ai_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10230,6 +11085,7 @@ static void m68k_op_move_8_ai_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10244,6 +11100,7 @@ static void m68k_op_move_8_ai_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10258,6 +11115,7 @@ static void m68k_op_move_8_ai_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10272,6 +11130,7 @@ static void m68k_op_move_8_ai_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -10286,6 +11145,7 @@ static void m68k_op_move_8_ai_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10300,6 +11160,7 @@ static void m68k_op_move_8_ai_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10314,6 +11175,7 @@ static void m68k_op_move_8_ai_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10328,6 +11190,7 @@ static void m68k_op_move_8_pi7_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10342,6 +11205,7 @@ static void m68k_op_move_8_pi_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10356,6 +11220,7 @@ static void m68k_op_move_8_pi7_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10370,6 +11235,7 @@ static void m68k_op_move_8_pi7_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10384,6 +11250,7 @@ static void m68k_op_move_8_pi7_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10398,6 +11265,7 @@ static void m68k_op_move_8_pi7_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10412,6 +11280,7 @@ static void m68k_op_move_8_pi7_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10426,6 +11295,7 @@ static void m68k_op_move_8_pi7_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10440,6 +11310,7 @@ static void m68k_op_move_8_pi7_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10454,6 +11325,7 @@ static void m68k_op_move_8_pi7_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10468,6 +11340,7 @@ static void m68k_op_move_8_pi7_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -10482,6 +11355,7 @@ static void m68k_op_move_8_pi7_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10496,6 +11370,7 @@ static void m68k_op_move_8_pi7_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10510,6 +11385,7 @@ static void m68k_op_move_8_pi7_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10524,6 +11400,7 @@ static void m68k_op_move_8_pi_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10538,6 +11415,7 @@ static void m68k_op_move_8_pi_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10552,6 +11430,7 @@ static void m68k_op_move_8_pi_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10566,6 +11445,7 @@ static void m68k_op_move_8_pi_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10580,6 +11460,7 @@ static void m68k_op_move_8_pi_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10594,6 +11475,7 @@ static void m68k_op_move_8_pi_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10608,6 +11490,7 @@ static void m68k_op_move_8_pi_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10622,6 +11505,7 @@ static void m68k_op_move_8_pi_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10636,6 +11520,7 @@ static void m68k_op_move_8_pi_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -10650,6 +11535,7 @@ static void m68k_op_move_8_pi_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10664,6 +11550,7 @@ static void m68k_op_move_8_pi_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10678,6 +11565,7 @@ static void m68k_op_move_8_pi_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10692,6 +11580,7 @@ static void m68k_op_move_8_pd7_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10706,6 +11595,7 @@ static void m68k_op_move_8_pd_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -10720,6 +11610,7 @@ static void m68k_op_move_8_pd7_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10734,6 +11625,7 @@ static void m68k_op_move_8_pd7_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10748,6 +11640,7 @@ static void m68k_op_move_8_pd7_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10762,6 +11655,7 @@ static void m68k_op_move_8_pd7_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10776,6 +11670,7 @@ static void m68k_op_move_8_pd7_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10790,6 +11685,7 @@ static void m68k_op_move_8_pd7_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10804,6 +11700,7 @@ static void m68k_op_move_8_pd7_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10818,6 +11715,7 @@ static void m68k_op_move_8_pd7_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10832,6 +11730,7 @@ static void m68k_op_move_8_pd7_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -10846,6 +11745,7 @@ static void m68k_op_move_8_pd7_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10860,6 +11760,7 @@ static void m68k_op_move_8_pd7_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10874,6 +11775,7 @@ static void m68k_op_move_8_pd7_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10888,6 +11790,7 @@ static void m68k_op_move_8_pd_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10902,6 +11805,7 @@ static void m68k_op_move_8_pd_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10916,6 +11820,7 @@ static void m68k_op_move_8_pd_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -10930,6 +11835,7 @@ static void m68k_op_move_8_pd_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10944,6 +11850,7 @@ static void m68k_op_move_8_pd_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -10958,6 +11865,7 @@ static void m68k_op_move_8_pd_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -10972,6 +11880,7 @@ static void m68k_op_move_8_pd_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -10986,6 +11895,7 @@ static void m68k_op_move_8_pd_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11000,6 +11910,7 @@ static void m68k_op_move_8_pd_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11014,6 +11925,7 @@ static void m68k_op_move_8_pd_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11028,6 +11940,7 @@ static void m68k_op_move_8_pd_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11042,6 +11955,7 @@ static void m68k_op_move_8_pd_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11056,6 +11970,7 @@ static void m68k_op_move_8_di_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11070,6 +11985,7 @@ static void m68k_op_move_8_di_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11084,6 +12000,7 @@ static void m68k_op_move_8_di_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11098,6 +12015,7 @@ static void m68k_op_move_8_di_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11112,6 +12030,7 @@ static void m68k_op_move_8_di_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11126,6 +12045,7 @@ static void m68k_op_move_8_di_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11140,6 +12060,7 @@ static void m68k_op_move_8_di_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11154,6 +12075,7 @@ static void m68k_op_move_8_di_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11168,6 +12090,7 @@ static void m68k_op_move_8_di_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11182,6 +12105,7 @@ static void m68k_op_move_8_di_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11196,6 +12120,7 @@ static void m68k_op_move_8_di_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11210,6 +12135,7 @@ static void m68k_op_move_8_di_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11224,6 +12150,7 @@ static void m68k_op_move_8_di_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11238,6 +12165,7 @@ static void m68k_op_move_8_ix_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -11252,6 +12180,7 @@ static void m68k_op_move_8_ix_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11266,6 +12195,7 @@ static void m68k_op_move_8_ix_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11280,6 +12210,7 @@ static void m68k_op_move_8_ix_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11294,6 +12225,7 @@ static void m68k_op_move_8_ix_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11308,6 +12240,7 @@ static void m68k_op_move_8_ix_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11322,6 +12255,7 @@ static void m68k_op_move_8_ix_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11336,6 +12270,7 @@ static void m68k_op_move_8_ix_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11350,6 +12285,7 @@ static void m68k_op_move_8_ix_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11364,6 +12300,7 @@ static void m68k_op_move_8_ix_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -11378,6 +12315,7 @@ static void m68k_op_move_8_ix_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11392,6 +12330,7 @@ static void m68k_op_move_8_ix_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11406,6 +12345,7 @@ static void m68k_op_move_8_ix_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11420,6 +12360,7 @@ static void m68k_op_move_8_aw_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11434,6 +12375,7 @@ static void m68k_op_move_8_aw_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11448,6 +12390,7 @@ static void m68k_op_move_8_aw_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11462,6 +12405,7 @@ static void m68k_op_move_8_aw_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11476,6 +12420,7 @@ static void m68k_op_move_8_aw_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11490,6 +12435,7 @@ static void m68k_op_move_8_aw_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -11504,6 +12450,7 @@ static void m68k_op_move_8_aw_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11518,6 +12465,7 @@ static void m68k_op_move_8_aw_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11532,6 +12480,7 @@ static void m68k_op_move_8_aw_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11546,6 +12495,7 @@ static void m68k_op_move_8_aw_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11560,6 +12510,7 @@ static void m68k_op_move_8_aw_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11574,6 +12525,7 @@ static void m68k_op_move_8_aw_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11588,6 +12540,7 @@ static void m68k_op_move_8_aw_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11602,6 +12555,7 @@ static void m68k_op_move_8_al_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11616,6 +12570,7 @@ static void m68k_op_move_8_al_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11630,6 +12585,7 @@ static void m68k_op_move_8_al_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11644,6 +12600,7 @@ static void m68k_op_move_8_al_pi7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11658,6 +12615,7 @@ static void m68k_op_move_8_al_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11672,6 +12630,7 @@ static void m68k_op_move_8_al_pd7(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -11686,6 +12645,7 @@ static void m68k_op_move_8_al_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11700,6 +12660,7 @@ static void m68k_op_move_8_al_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -11714,6 +12675,7 @@ static void m68k_op_move_8_al_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11728,6 +12690,7 @@ static void m68k_op_move_8_al_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -11742,6 +12705,7 @@ static void m68k_op_move_8_al_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -11756,6 +12720,7 @@ static void m68k_op_move_8_al_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -11770,6 +12735,7 @@ static void m68k_op_move_8_al_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -11784,6 +12750,7 @@ static void m68k_op_move_16_d_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -11798,6 +12765,7 @@ static void m68k_op_move_16_d_a(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -11812,6 +12780,7 @@ static void m68k_op_move_16_d_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -11826,6 +12795,7 @@ static void m68k_op_move_16_d_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -11840,6 +12810,7 @@ static void m68k_op_move_16_d_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -11854,6 +12825,7 @@ static void m68k_op_move_16_d_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11868,6 +12840,7 @@ static void m68k_op_move_16_d_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -11882,6 +12855,7 @@ static void m68k_op_move_16_d_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11896,6 +12870,7 @@ static void m68k_op_move_16_d_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -11910,6 +12885,7 @@ static void m68k_op_move_16_d_pcdi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11924,6 +12900,7 @@ static void m68k_op_move_16_d_pcix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -11938,6 +12915,7 @@ static void m68k_op_move_16_d_i(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -11952,6 +12930,7 @@ static void m68k_op_move_16_ai_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -11966,6 +12945,7 @@ static void m68k_op_move_16_ai_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -11980,6 +12960,7 @@ static void m68k_op_move_16_ai_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -11994,6 +12975,7 @@ static void m68k_op_move_16_ai_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12008,6 +12990,7 @@ static void m68k_op_move_16_ai_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -12022,6 +13005,7 @@ static void m68k_op_move_16_ai_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12036,6 +13020,7 @@ static void m68k_op_move_16_ai_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12050,6 +13035,7 @@ static void m68k_op_move_16_ai_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12064,6 +13050,7 @@ static void m68k_op_move_16_ai_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12078,6 +13065,7 @@ static void m68k_op_move_16_ai_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12092,6 +13080,7 @@ static void m68k_op_move_16_ai_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12106,6 +13095,7 @@ static void m68k_op_move_16_ai_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12120,6 +13110,7 @@ static void m68k_op_move_16_pi_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -12134,6 +13125,7 @@ static void m68k_op_move_16_pi_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -12148,6 +13140,7 @@ static void m68k_op_move_16_pi_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12162,6 +13155,7 @@ static void m68k_op_move_16_pi_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12176,6 +13170,7 @@ static void m68k_op_move_16_pi_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -12190,6 +13185,7 @@ static void m68k_op_move_16_pi_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12204,6 +13200,7 @@ static void m68k_op_move_16_pi_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12218,6 +13215,7 @@ static void m68k_op_move_16_pi_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12232,6 +13230,7 @@ static void m68k_op_move_16_pi_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12246,6 +13245,7 @@ static void m68k_op_move_16_pi_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12260,6 +13260,7 @@ static void m68k_op_move_16_pi_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12274,6 +13275,7 @@ static void m68k_op_move_16_pi_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12288,6 +13290,7 @@ static void m68k_op_move_16_pd_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -12302,6 +13305,7 @@ static void m68k_op_move_16_pd_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -12316,6 +13320,7 @@ static void m68k_op_move_16_pd_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12330,6 +13335,7 @@ static void m68k_op_move_16_pd_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12344,6 +13350,7 @@ static void m68k_op_move_16_pd_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -12358,6 +13365,7 @@ static void m68k_op_move_16_pd_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12372,6 +13380,7 @@ static void m68k_op_move_16_pd_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12386,6 +13395,7 @@ static void m68k_op_move_16_pd_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12400,6 +13410,7 @@ static void m68k_op_move_16_pd_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12414,6 +13425,7 @@ static void m68k_op_move_16_pd_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12428,6 +13440,7 @@ static void m68k_op_move_16_pd_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12442,6 +13455,7 @@ static void m68k_op_move_16_pd_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12456,6 +13470,7 @@ static void m68k_op_move_16_di_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12470,6 +13485,7 @@ static void m68k_op_move_16_di_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12484,6 +13500,7 @@ static void m68k_op_move_16_di_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12498,6 +13515,7 @@ static void m68k_op_move_16_di_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12512,6 +13530,7 @@ static void m68k_op_move_16_di_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12526,6 +13545,7 @@ static void m68k_op_move_16_di_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12540,6 +13560,7 @@ static void m68k_op_move_16_di_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12554,6 +13575,7 @@ static void m68k_op_move_16_di_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12568,6 +13590,7 @@ static void m68k_op_move_16_di_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -12582,6 +13605,7 @@ static void m68k_op_move_16_di_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12596,6 +13620,7 @@ static void m68k_op_move_16_di_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12610,6 +13635,7 @@ static void m68k_op_move_16_di_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12624,6 +13650,7 @@ static void m68k_op_move_16_ix_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -12638,6 +13665,7 @@ static void m68k_op_move_16_ix_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -12652,6 +13680,7 @@ static void m68k_op_move_16_ix_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12666,6 +13695,7 @@ static void m68k_op_move_16_ix_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12680,6 +13710,7 @@ static void m68k_op_move_16_ix_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12694,6 +13725,7 @@ static void m68k_op_move_16_ix_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12708,6 +13740,7 @@ static void m68k_op_move_16_ix_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -12722,6 +13755,7 @@ static void m68k_op_move_16_ix_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12736,6 +13770,7 @@ static void m68k_op_move_16_ix_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -12750,6 +13785,7 @@ static void m68k_op_move_16_ix_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12764,6 +13800,7 @@ static void m68k_op_move_16_ix_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -12778,6 +13815,7 @@ static void m68k_op_move_16_ix_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12792,6 +13830,7 @@ static void m68k_op_move_16_aw_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12806,6 +13845,7 @@ static void m68k_op_move_16_aw_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -12820,6 +13860,7 @@ static void m68k_op_move_16_aw_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12834,6 +13875,7 @@ static void m68k_op_move_16_aw_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12848,6 +13890,7 @@ static void m68k_op_move_16_aw_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -12862,6 +13905,7 @@ static void m68k_op_move_16_aw_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12876,6 +13920,7 @@ static void m68k_op_move_16_aw_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12890,6 +13935,7 @@ static void m68k_op_move_16_aw_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12904,6 +13950,7 @@ static void m68k_op_move_16_aw_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -12918,6 +13965,7 @@ static void m68k_op_move_16_aw_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -12932,6 +13980,7 @@ static void m68k_op_move_16_aw_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -12946,6 +13995,7 @@ static void m68k_op_move_16_aw_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12960,6 +14010,7 @@ static void m68k_op_move_16_al_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12974,6 +14025,7 @@ static void m68k_op_move_16_al_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -12988,6 +14040,7 @@ static void m68k_op_move_16_al_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13002,6 +14055,7 @@ static void m68k_op_move_16_al_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13016,6 +14070,7 @@ static void m68k_op_move_16_al_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -13030,6 +14085,7 @@ static void m68k_op_move_16_al_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13044,6 +14100,7 @@ static void m68k_op_move_16_al_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13058,6 +14115,7 @@ static void m68k_op_move_16_al_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13072,6 +14130,7 @@ static void m68k_op_move_16_al_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13086,6 +14145,7 @@ static void m68k_op_move_16_al_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13100,6 +14160,7 @@ static void m68k_op_move_16_al_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13114,6 +14175,7 @@ static void m68k_op_move_16_al_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13128,6 +14190,7 @@ static void m68k_op_move_32_d_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -13142,6 +14205,7 @@ static void m68k_op_move_32_d_a(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -13156,6 +14220,7 @@ static void m68k_op_move_32_d_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13170,6 +14235,7 @@ static void m68k_op_move_32_d_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13184,6 +14250,7 @@ static void m68k_op_move_32_d_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -13198,6 +14265,7 @@ static void m68k_op_move_32_d_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -13212,6 +14280,7 @@ static void m68k_op_move_32_d_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -13226,6 +14295,7 @@ static void m68k_op_move_32_d_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -13240,6 +14310,7 @@ static void m68k_op_move_32_d_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13254,6 +14325,7 @@ static void m68k_op_move_32_d_pcdi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -13268,6 +14340,7 @@ static void m68k_op_move_32_d_pcix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -13282,6 +14355,7 @@ static void m68k_op_move_32_d_i(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13296,6 +14370,7 @@ static void m68k_op_move_32_ai_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13310,6 +14385,7 @@ static void m68k_op_move_32_ai_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13324,6 +14400,7 @@ static void m68k_op_move_32_ai_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13338,6 +14415,7 @@ static void m68k_op_move_32_ai_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13352,6 +14430,7 @@ static void m68k_op_move_32_ai_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -13366,6 +14445,7 @@ static void m68k_op_move_32_ai_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13380,6 +14460,7 @@ static void m68k_op_move_32_ai_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13394,6 +14475,7 @@ static void m68k_op_move_32_ai_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13408,6 +14490,7 @@ static void m68k_op_move_32_ai_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13422,6 +14505,7 @@ static void m68k_op_move_32_ai_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13436,6 +14520,7 @@ static void m68k_op_move_32_ai_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13450,6 +14535,7 @@ static void m68k_op_move_32_ai_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13464,6 +14550,7 @@ static void m68k_op_move_32_pi_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13478,6 +14565,7 @@ static void m68k_op_move_32_pi_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13492,6 +14580,7 @@ static void m68k_op_move_32_pi_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13506,6 +14595,7 @@ static void m68k_op_move_32_pi_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13520,6 +14610,7 @@ static void m68k_op_move_32_pi_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -13534,6 +14625,7 @@ static void m68k_op_move_32_pi_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13548,6 +14640,7 @@ static void m68k_op_move_32_pi_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13562,6 +14655,7 @@ static void m68k_op_move_32_pi_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13576,6 +14670,7 @@ static void m68k_op_move_32_pi_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13590,6 +14685,7 @@ static void m68k_op_move_32_pi_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13604,6 +14700,7 @@ static void m68k_op_move_32_pi_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13618,6 +14715,7 @@ static void m68k_op_move_32_pi_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13633,6 +14731,7 @@ static void m68k_op_move_32_pd_d(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13648,6 +14747,7 @@ static void m68k_op_move_32_pd_a(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -13663,6 +14763,7 @@ static void m68k_op_move_32_pd_ai(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13678,6 +14779,7 @@ static void m68k_op_move_32_pd_pi(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13693,6 +14795,7 @@ static void m68k_op_move_32_pd_pd(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -13708,6 +14811,7 @@ static void m68k_op_move_32_pd_di(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13723,6 +14827,7 @@ static void m68k_op_move_32_pd_ix(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13738,6 +14843,7 @@ static void m68k_op_move_32_pd_aw(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13753,6 +14859,7 @@ static void m68k_op_move_32_pd_al(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13768,6 +14875,7 @@ static void m68k_op_move_32_pd_pcdi(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13783,6 +14891,7 @@ static void m68k_op_move_32_pd_pcix(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13798,6 +14907,7 @@ static void m68k_op_move_32_pd_i(void)
 
   m68ki_write_16(ea+2, res & 0xFFFF );
   m68ki_write_16(ea, (res >> 16) & 0xFFFF );
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -13812,6 +14922,7 @@ static void m68k_op_move_32_di_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -13826,6 +14937,7 @@ static void m68k_op_move_32_di_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -13840,6 +14952,7 @@ static void m68k_op_move_32_di_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13854,6 +14967,7 @@ static void m68k_op_move_32_di_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13868,6 +14982,7 @@ static void m68k_op_move_32_di_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -13882,6 +14997,7 @@ static void m68k_op_move_32_di_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13896,6 +15012,7 @@ static void m68k_op_move_32_di_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -13910,6 +15027,7 @@ static void m68k_op_move_32_di_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13924,6 +15042,7 @@ static void m68k_op_move_32_di_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -13938,6 +15057,7 @@ static void m68k_op_move_32_di_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -13952,6 +15072,7 @@ static void m68k_op_move_32_di_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -13966,6 +15087,7 @@ static void m68k_op_move_32_di_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -13980,6 +15102,7 @@ static void m68k_op_move_32_ix_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -13994,6 +15117,7 @@ static void m68k_op_move_32_ix_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -14008,6 +15132,7 @@ static void m68k_op_move_32_ix_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -14022,6 +15147,7 @@ static void m68k_op_move_32_ix_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -14036,6 +15162,7 @@ static void m68k_op_move_32_ix_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14050,6 +15177,7 @@ static void m68k_op_move_32_ix_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14064,6 +15192,7 @@ static void m68k_op_move_32_ix_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14078,6 +15207,7 @@ static void m68k_op_move_32_ix_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14092,6 +15222,7 @@ static void m68k_op_move_32_ix_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -14106,6 +15237,7 @@ static void m68k_op_move_32_ix_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14120,6 +15252,7 @@ static void m68k_op_move_32_ix_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14134,6 +15267,7 @@ static void m68k_op_move_32_ix_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -14148,6 +15282,7 @@ static void m68k_op_move_32_aw_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14162,6 +15297,7 @@ static void m68k_op_move_32_aw_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14176,6 +15312,7 @@ static void m68k_op_move_32_aw_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -14190,6 +15327,7 @@ static void m68k_op_move_32_aw_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -14204,6 +15342,7 @@ static void m68k_op_move_32_aw_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -14218,6 +15357,7 @@ static void m68k_op_move_32_aw_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14232,6 +15372,7 @@ static void m68k_op_move_32_aw_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14246,6 +15387,7 @@ static void m68k_op_move_32_aw_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14260,6 +15402,7 @@ static void m68k_op_move_32_aw_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14274,6 +15417,7 @@ static void m68k_op_move_32_aw_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14288,6 +15432,7 @@ static void m68k_op_move_32_aw_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14302,6 +15447,7 @@ static void m68k_op_move_32_aw_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -14316,6 +15462,7 @@ static void m68k_op_move_32_al_d(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14330,6 +15477,7 @@ static void m68k_op_move_32_al_a(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14344,6 +15492,7 @@ static void m68k_op_move_32_al_ai(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14358,6 +15507,7 @@ static void m68k_op_move_32_al_pi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -14372,6 +15522,7 @@ static void m68k_op_move_32_al_pd(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -14386,6 +15537,7 @@ static void m68k_op_move_32_al_di(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14400,6 +15552,7 @@ static void m68k_op_move_32_al_ix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -14414,6 +15567,7 @@ static void m68k_op_move_32_al_aw(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14428,6 +15582,7 @@ static void m68k_op_move_32_al_al(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(36*MUL);
 }
 
 
@@ -14442,6 +15597,7 @@ static void m68k_op_move_32_al_pcdi(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -14456,6 +15612,7 @@ static void m68k_op_move_32_al_pcix(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -14470,221 +15627,258 @@ static void m68k_op_move_32_al_i(void)
   FLAG_C = CFLAG_CLEAR;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
 static void m68k_op_movea_16_d(void)
 {
   AX = MAKE_INT_16(DY);
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_movea_16_a(void)
 {
   AX = MAKE_INT_16(AY);
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_movea_16_ai(void)
 {
   AX = MAKE_INT_16(OPER_AY_AI_16());
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_movea_16_pi(void)
 {
   AX = MAKE_INT_16(OPER_AY_PI_16());
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_movea_16_pd(void)
 {
   AX = MAKE_INT_16(OPER_AY_PD_16());
+  USE_CYCLES(10*MUL);
 }
 
 
 static void m68k_op_movea_16_di(void)
 {
   AX = MAKE_INT_16(OPER_AY_DI_16());
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_movea_16_ix(void)
 {
   AX = MAKE_INT_16(OPER_AY_IX_16());
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_movea_16_aw(void)
 {
   AX = MAKE_INT_16(OPER_AW_16());
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_movea_16_al(void)
 {
   AX = MAKE_INT_16(OPER_AL_16());
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_movea_16_pcdi(void)
 {
   AX = MAKE_INT_16(OPER_PCDI_16());
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_movea_16_pcix(void)
 {
   AX = MAKE_INT_16(OPER_PCIX_16());
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_movea_16_i(void)
 {
   AX = MAKE_INT_16(OPER_I_16());
+  USE_CYCLES(8*MUL);
 }
 
 
 static void m68k_op_movea_32_d(void)
 {
   AX = DY;
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_movea_32_a(void)
 {
   AX = AY;
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_movea_32_ai(void)
 {
   AX = OPER_AY_AI_32();
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_movea_32_pi(void)
 {
   AX = OPER_AY_PI_32();
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_movea_32_pd(void)
 {
   AX = OPER_AY_PD_32();
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_movea_32_di(void)
 {
   AX = OPER_AY_DI_32();
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_movea_32_ix(void)
 {
   AX = OPER_AY_IX_32();
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_movea_32_aw(void)
 {
   AX = OPER_AW_32();
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_movea_32_al(void)
 {
   AX = OPER_AL_32();
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_movea_32_pcdi(void)
 {
   AX = OPER_PCDI_32();
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_movea_32_pcix(void)
 {
   AX = OPER_PCIX_32();
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_movea_32_i(void)
 {
   AX = OPER_I_32();
+  USE_CYCLES(12*MUL);
 }
 
 static void m68k_op_move_16_toc_d(void)
 {
   m68ki_set_ccr(DY);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_move_16_toc_ai(void)
 {
   m68ki_set_ccr(OPER_AY_AI_16());
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_move_16_toc_pi(void)
 {
   m68ki_set_ccr(OPER_AY_PI_16());
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_move_16_toc_pd(void)
 {
   m68ki_set_ccr(OPER_AY_PD_16());
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_move_16_toc_di(void)
 {
   m68ki_set_ccr(OPER_AY_DI_16());
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_move_16_toc_ix(void)
 {
   m68ki_set_ccr(OPER_AY_IX_16());
+  USE_CYCLES(22*MUL);
 }
 
 
 static void m68k_op_move_16_toc_aw(void)
 {
   m68ki_set_ccr(OPER_AW_16());
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_move_16_toc_al(void)
 {
   m68ki_set_ccr(OPER_AL_16());
+  USE_CYCLES(24*MUL);
 }
 
 
 static void m68k_op_move_16_toc_pcdi(void)
 {
   m68ki_set_ccr(OPER_PCDI_16());
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_move_16_toc_pcix(void)
 {
   m68ki_set_ccr(OPER_PCIX_16());
+  USE_CYCLES(22*MUL);
 }
 
 
 static void m68k_op_move_16_toc_i(void)
 {
   m68ki_set_ccr(OPER_I_16());
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_move_16_frs_d(void)
 {
   DY = MASK_OUT_BELOW_16(DY) | m68ki_get_sr();
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -14692,6 +15886,7 @@ static void m68k_op_move_16_frs_ai(void)
 {
   uint ea = EA_AY_AI_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -14699,6 +15894,7 @@ static void m68k_op_move_16_frs_pi(void)
 {
   uint ea = EA_AY_PI_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -14706,6 +15902,7 @@ static void m68k_op_move_16_frs_pd(void)
 {
   uint ea = EA_AY_PD_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -14713,6 +15910,7 @@ static void m68k_op_move_16_frs_di(void)
 {
   uint ea = EA_AY_DI_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14720,6 +15918,7 @@ static void m68k_op_move_16_frs_ix(void)
 {
   uint ea = EA_AY_IX_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -14727,6 +15926,7 @@ static void m68k_op_move_16_frs_aw(void)
 {
   uint ea = EA_AW_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14734,6 +15934,7 @@ static void m68k_op_move_16_frs_al(void)
 {
   uint ea = EA_AL_16();
   m68ki_write_16(ea, m68ki_get_sr());
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14742,9 +15943,11 @@ static void m68k_op_move_16_tos_d(void)
   if(FLAG_S)
   {
     m68ki_set_sr(DY);
+    USE_CYCLES(12*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -14754,9 +15957,11 @@ static void m68k_op_move_16_tos_ai(void)
   {
     uint new_sr = OPER_AY_AI_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(16*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14766,9 +15971,11 @@ static void m68k_op_move_16_tos_pi(void)
   {
     uint new_sr = OPER_AY_PI_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(16*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14778,9 +15985,11 @@ static void m68k_op_move_16_tos_pd(void)
   {
     uint new_sr = OPER_AY_PD_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(18*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -14790,9 +15999,11 @@ static void m68k_op_move_16_tos_di(void)
   {
     uint new_sr = OPER_AY_DI_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14802,9 +16013,11 @@ static void m68k_op_move_16_tos_ix(void)
   {
     uint new_sr = OPER_AY_IX_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(22*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -14814,9 +16027,11 @@ static void m68k_op_move_16_tos_aw(void)
   {
     uint new_sr = OPER_AW_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14826,9 +16041,11 @@ static void m68k_op_move_16_tos_al(void)
   {
     uint new_sr = OPER_AL_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(24*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -14838,9 +16055,11 @@ static void m68k_op_move_16_tos_pcdi(void)
   {
     uint new_sr = OPER_PCDI_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -14850,9 +16069,11 @@ static void m68k_op_move_16_tos_pcix(void)
   {
     uint new_sr = OPER_PCIX_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(22*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -14862,9 +16083,11 @@ static void m68k_op_move_16_tos_i(void)
   {
     uint new_sr = OPER_I_16();
     m68ki_set_sr(new_sr);
+    USE_CYCLES(16*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -14873,9 +16096,11 @@ static void m68k_op_move_32_fru(void)
   if(FLAG_S)
   {
     AY = REG_USP;
+    USE_CYCLES(4*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -14884,9 +16109,11 @@ static void m68k_op_move_32_tou(void)
   if(FLAG_S)
   {
     REG_USP = AY;
+    USE_CYCLES(4*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -14907,6 +16134,7 @@ static void m68k_op_movem_16_re_pd(void)
   AY = ea;
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -14926,6 +16154,7 @@ static void m68k_op_movem_16_re_ai(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -14945,6 +16174,7 @@ static void m68k_op_movem_16_re_di(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -14964,6 +16194,7 @@ static void m68k_op_movem_16_re_ix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -14983,6 +16214,7 @@ static void m68k_op_movem_16_re_aw(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15002,6 +16234,7 @@ static void m68k_op_movem_16_re_al(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15023,6 +16256,7 @@ static void m68k_op_movem_32_re_pd(void)
   AY = ea;
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15042,6 +16276,7 @@ static void m68k_op_movem_32_re_ai(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15061,6 +16296,7 @@ static void m68k_op_movem_32_re_di(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15080,6 +16316,7 @@ static void m68k_op_movem_32_re_ix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -15099,6 +16336,7 @@ static void m68k_op_movem_32_re_aw(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15118,6 +16356,7 @@ static void m68k_op_movem_32_re_al(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15138,6 +16377,7 @@ static void m68k_op_movem_16_er_pi(void)
   AY = ea;
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15157,6 +16397,7 @@ static void m68k_op_movem_16_er_pcdi(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15176,6 +16417,7 @@ static void m68k_op_movem_16_er_pcix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -15195,6 +16437,7 @@ static void m68k_op_movem_16_er_ai(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15214,6 +16457,7 @@ static void m68k_op_movem_16_er_di(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15233,6 +16477,7 @@ static void m68k_op_movem_16_er_ix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -15252,6 +16497,7 @@ static void m68k_op_movem_16_er_aw(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15271,6 +16517,7 @@ static void m68k_op_movem_16_er_al(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_W);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -15291,6 +16538,7 @@ static void m68k_op_movem_32_er_pi(void)
   AY = ea;
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15310,6 +16558,7 @@ static void m68k_op_movem_32_er_pcdi(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15329,6 +16578,7 @@ static void m68k_op_movem_32_er_pcix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -15348,6 +16598,7 @@ static void m68k_op_movem_32_er_ai(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15367,6 +16618,7 @@ static void m68k_op_movem_32_er_di(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15386,6 +16638,7 @@ static void m68k_op_movem_32_er_ix(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -15405,6 +16658,7 @@ static void m68k_op_movem_32_er_aw(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15424,6 +16678,7 @@ static void m68k_op_movem_32_er_al(void)
     }
 
   USE_CYCLES(count * CYC_MOVEM_L);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -15434,6 +16689,7 @@ static void m68k_op_movep_16_re(void)
 
   m68ki_write_8(ea, MASK_OUT_ABOVE_8(src >> 8));
   m68ki_write_8(ea += 2, MASK_OUT_ABOVE_8(src));
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15446,6 +16702,7 @@ static void m68k_op_movep_32_re(void)
   m68ki_write_8(ea += 2, MASK_OUT_ABOVE_8(src >> 16));
   m68ki_write_8(ea += 2, MASK_OUT_ABOVE_8(src >> 8));
   m68ki_write_8(ea += 2, MASK_OUT_ABOVE_8(src));
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -15455,6 +16712,7 @@ static void m68k_op_movep_16_er(void)
   uint* r_dst = &DX;
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | ((m68ki_read_8(ea) << 8) + m68ki_read_8(ea + 2));
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -15464,6 +16722,7 @@ static void m68k_op_movep_32_er(void)
 
   DX = (m68ki_read_8(ea) << 24) + (m68ki_read_8(ea + 2) << 16)
     + (m68ki_read_8(ea + 4) << 8) + m68ki_read_8(ea + 6);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -15475,6 +16734,7 @@ static void m68k_op_moveq_32(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15509,6 +16769,7 @@ static void m68k_op_muls_16_ai(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15526,6 +16787,7 @@ static void m68k_op_muls_16_pi(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15543,6 +16805,7 @@ static void m68k_op_muls_16_pd(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -15560,6 +16823,7 @@ static void m68k_op_muls_16_di(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15577,6 +16841,7 @@ static void m68k_op_muls_16_ix(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -15594,6 +16859,7 @@ static void m68k_op_muls_16_aw(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15611,6 +16877,7 @@ static void m68k_op_muls_16_al(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15628,6 +16895,7 @@ static void m68k_op_muls_16_pcdi(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15645,6 +16913,7 @@ static void m68k_op_muls_16_pcix(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -15662,6 +16931,7 @@ static void m68k_op_muls_16_i(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15696,6 +16966,7 @@ static void m68k_op_mulu_16_ai(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15713,6 +16984,7 @@ static void m68k_op_mulu_16_pi(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15730,6 +17002,7 @@ static void m68k_op_mulu_16_pd(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -15747,6 +17020,7 @@ static void m68k_op_mulu_16_di(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15764,6 +17038,7 @@ static void m68k_op_mulu_16_ix(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -15781,6 +17056,7 @@ static void m68k_op_mulu_16_aw(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15798,6 +17074,7 @@ static void m68k_op_mulu_16_al(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15815,6 +17092,7 @@ static void m68k_op_mulu_16_pcdi(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -15832,6 +17110,7 @@ static void m68k_op_mulu_16_pcix(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -15849,6 +17128,7 @@ static void m68k_op_mulu_16_i(void)
   FLAG_N = NFLAG_32(res);
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -15883,6 +17163,7 @@ static void m68k_op_nbcd_8_d(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -15917,6 +17198,7 @@ static void m68k_op_nbcd_8_ai(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15951,6 +17233,7 @@ static void m68k_op_nbcd_8_pi(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -15985,6 +17268,7 @@ static void m68k_op_nbcd_8_pi7(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16019,6 +17303,7 @@ static void m68k_op_nbcd_8_pd(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16053,6 +17338,7 @@ static void m68k_op_nbcd_8_pd7(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16087,6 +17373,7 @@ static void m68k_op_nbcd_8_di(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16121,6 +17408,7 @@ static void m68k_op_nbcd_8_ix(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -16155,6 +17443,7 @@ static void m68k_op_nbcd_8_aw(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16189,6 +17478,7 @@ static void m68k_op_nbcd_8_al(void)
     FLAG_X = XFLAG_CLEAR;
     FLAG_N = NFLAG_CLEAR;
   }
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16203,6 +17493,7 @@ static void m68k_op_neg_8_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -16218,6 +17509,7 @@ static void m68k_op_neg_8_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16233,6 +17525,7 @@ static void m68k_op_neg_8_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16248,6 +17541,7 @@ static void m68k_op_neg_8_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16263,6 +17557,7 @@ static void m68k_op_neg_8_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16278,6 +17573,7 @@ static void m68k_op_neg_8_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16293,6 +17589,7 @@ static void m68k_op_neg_8_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16308,6 +17605,7 @@ static void m68k_op_neg_8_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -16323,6 +17621,7 @@ static void m68k_op_neg_8_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16338,6 +17637,7 @@ static void m68k_op_neg_8_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16352,6 +17652,7 @@ static void m68k_op_neg_16_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -16367,6 +17668,7 @@ static void m68k_op_neg_16_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16382,6 +17684,7 @@ static void m68k_op_neg_16_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16397,6 +17700,7 @@ static void m68k_op_neg_16_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16412,6 +17716,7 @@ static void m68k_op_neg_16_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16427,6 +17732,7 @@ static void m68k_op_neg_16_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -16442,6 +17748,7 @@ static void m68k_op_neg_16_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16457,6 +17764,7 @@ static void m68k_op_neg_16_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16471,6 +17779,7 @@ static void m68k_op_neg_32_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -16486,6 +17795,7 @@ static void m68k_op_neg_32_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16501,6 +17811,7 @@ static void m68k_op_neg_32_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16516,6 +17827,7 @@ static void m68k_op_neg_32_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -16531,6 +17843,7 @@ static void m68k_op_neg_32_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -16546,6 +17859,7 @@ static void m68k_op_neg_32_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -16561,6 +17875,7 @@ static void m68k_op_neg_32_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -16576,6 +17891,7 @@ static void m68k_op_neg_32_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -16592,6 +17908,7 @@ static void m68k_op_negx_8_d(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -16609,6 +17926,7 @@ static void m68k_op_negx_8_ai(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16626,6 +17944,7 @@ static void m68k_op_negx_8_pi(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16643,6 +17962,7 @@ static void m68k_op_negx_8_pi7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16660,6 +17980,7 @@ static void m68k_op_negx_8_pd(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16677,6 +17998,7 @@ static void m68k_op_negx_8_pd7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16694,6 +18016,7 @@ static void m68k_op_negx_8_di(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16711,6 +18034,7 @@ static void m68k_op_negx_8_ix(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -16728,6 +18052,7 @@ static void m68k_op_negx_8_aw(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16745,6 +18070,7 @@ static void m68k_op_negx_8_al(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16761,6 +18087,7 @@ static void m68k_op_negx_16_d(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -16778,6 +18105,7 @@ static void m68k_op_negx_16_ai(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16795,6 +18123,7 @@ static void m68k_op_negx_16_pi(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -16812,6 +18141,7 @@ static void m68k_op_negx_16_pd(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -16829,6 +18159,7 @@ static void m68k_op_negx_16_di(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16846,6 +18177,7 @@ static void m68k_op_negx_16_ix(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -16863,6 +18195,7 @@ static void m68k_op_negx_16_aw(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -16880,6 +18213,7 @@ static void m68k_op_negx_16_al(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16889,13 +18223,14 @@ static void m68k_op_negx_32_d(void)
   uint res = 0 - MASK_OUT_ABOVE_32(*r_dst) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(*r_dst, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(*r_dst, 0, res);
   FLAG_V = (*r_dst & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   *r_dst = res;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -16906,13 +18241,14 @@ static void m68k_op_negx_32_ai(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16923,13 +18259,14 @@ static void m68k_op_negx_32_pi(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -16940,13 +18277,14 @@ static void m68k_op_negx_32_pd(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -16957,13 +18295,14 @@ static void m68k_op_negx_32_di(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -16974,13 +18313,14 @@ static void m68k_op_negx_32_ix(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -16991,13 +18331,14 @@ static void m68k_op_negx_32_aw(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -17008,18 +18349,20 @@ static void m68k_op_negx_32_al(void)
   uint res = 0 - MASK_OUT_ABOVE_32(src) - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, 0, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, 0, res);
   FLAG_V = (src & res)>>24;
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(28*MUL);
 }
 
 
 static void m68k_op_nop(void)
 {
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -17034,6 +18377,7 @@ static void m68k_op_not_8_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -17048,6 +18392,7 @@ static void m68k_op_not_8_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17062,6 +18407,7 @@ static void m68k_op_not_8_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17076,6 +18422,7 @@ static void m68k_op_not_8_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17090,6 +18437,7 @@ static void m68k_op_not_8_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17104,6 +18452,7 @@ static void m68k_op_not_8_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17118,6 +18467,7 @@ static void m68k_op_not_8_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17132,6 +18482,7 @@ static void m68k_op_not_8_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17146,6 +18497,7 @@ static void m68k_op_not_8_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17160,6 +18512,7 @@ static void m68k_op_not_8_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17174,6 +18527,7 @@ static void m68k_op_not_16_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -17188,6 +18542,7 @@ static void m68k_op_not_16_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17202,6 +18557,7 @@ static void m68k_op_not_16_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17216,6 +18572,7 @@ static void m68k_op_not_16_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17230,6 +18587,7 @@ static void m68k_op_not_16_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17244,6 +18602,7 @@ static void m68k_op_not_16_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17258,6 +18617,7 @@ static void m68k_op_not_16_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17272,6 +18632,7 @@ static void m68k_op_not_16_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17284,6 +18645,7 @@ static void m68k_op_not_32_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -17298,6 +18660,7 @@ static void m68k_op_not_32_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17312,6 +18675,7 @@ static void m68k_op_not_32_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17326,6 +18690,7 @@ static void m68k_op_not_32_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -17340,6 +18705,7 @@ static void m68k_op_not_32_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -17354,6 +18720,7 @@ static void m68k_op_not_32_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -17368,6 +18735,7 @@ static void m68k_op_not_32_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -17382,6 +18750,7 @@ static void m68k_op_not_32_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -17393,6 +18762,7 @@ static void m68k_op_or_8_er_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -17404,6 +18774,7 @@ static void m68k_op_or_8_er_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17415,6 +18786,7 @@ static void m68k_op_or_8_er_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17426,6 +18798,7 @@ static void m68k_op_or_8_er_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17437,6 +18810,7 @@ static void m68k_op_or_8_er_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -17448,6 +18822,7 @@ static void m68k_op_or_8_er_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -17459,6 +18834,7 @@ static void m68k_op_or_8_er_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17470,6 +18846,7 @@ static void m68k_op_or_8_er_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17481,6 +18858,7 @@ static void m68k_op_or_8_er_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17492,6 +18870,7 @@ static void m68k_op_or_8_er_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17503,6 +18882,7 @@ static void m68k_op_or_8_er_pcdi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17514,6 +18894,7 @@ static void m68k_op_or_8_er_pcix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17525,6 +18906,7 @@ static void m68k_op_or_8_er_i(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17536,6 +18918,7 @@ static void m68k_op_or_16_er_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -17547,6 +18930,7 @@ static void m68k_op_or_16_er_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17558,6 +18942,7 @@ static void m68k_op_or_16_er_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17569,6 +18954,7 @@ static void m68k_op_or_16_er_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -17580,6 +18966,7 @@ static void m68k_op_or_16_er_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17591,6 +18978,7 @@ static void m68k_op_or_16_er_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17602,6 +18990,7 @@ static void m68k_op_or_16_er_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17613,6 +19002,7 @@ static void m68k_op_or_16_er_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17624,6 +19014,7 @@ static void m68k_op_or_16_er_pcdi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17635,6 +19026,7 @@ static void m68k_op_or_16_er_pcix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17646,6 +19038,7 @@ static void m68k_op_or_16_er_i(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17657,6 +19050,7 @@ static void m68k_op_or_32_er_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -17668,6 +19062,7 @@ static void m68k_op_or_32_er_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17679,6 +19074,7 @@ static void m68k_op_or_32_er_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17690,6 +19086,7 @@ static void m68k_op_or_32_er_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17701,6 +19098,7 @@ static void m68k_op_or_32_er_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17712,6 +19110,7 @@ static void m68k_op_or_32_er_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17723,6 +19122,7 @@ static void m68k_op_or_32_er_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17734,6 +19134,7 @@ static void m68k_op_or_32_er_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -17745,6 +19146,7 @@ static void m68k_op_or_32_er_pcdi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17756,6 +19158,7 @@ static void m68k_op_or_32_er_pcix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17767,6 +19170,7 @@ static void m68k_op_or_32_er_i(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17781,6 +19185,7 @@ static void m68k_op_or_8_re_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17795,6 +19200,7 @@ static void m68k_op_or_8_re_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17809,6 +19215,7 @@ static void m68k_op_or_8_re_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17823,6 +19230,7 @@ static void m68k_op_or_8_re_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17837,6 +19245,7 @@ static void m68k_op_or_8_re_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17851,6 +19260,7 @@ static void m68k_op_or_8_re_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17865,6 +19275,7 @@ static void m68k_op_or_8_re_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17879,6 +19290,7 @@ static void m68k_op_or_8_re_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17893,6 +19305,7 @@ static void m68k_op_or_8_re_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -17907,6 +19320,7 @@ static void m68k_op_or_16_re_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17921,6 +19335,7 @@ static void m68k_op_or_16_re_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -17935,6 +19350,7 @@ static void m68k_op_or_16_re_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -17949,6 +19365,7 @@ static void m68k_op_or_16_re_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17963,6 +19380,7 @@ static void m68k_op_or_16_re_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -17977,6 +19395,7 @@ static void m68k_op_or_16_re_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -17991,6 +19410,7 @@ static void m68k_op_or_16_re_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18005,6 +19425,7 @@ static void m68k_op_or_32_re_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18019,6 +19440,7 @@ static void m68k_op_or_32_re_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18033,6 +19455,7 @@ static void m68k_op_or_32_re_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -18047,6 +19470,7 @@ static void m68k_op_or_32_re_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -18061,6 +19485,7 @@ static void m68k_op_or_32_re_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -18075,6 +19500,7 @@ static void m68k_op_or_32_re_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -18089,6 +19515,7 @@ static void m68k_op_or_32_re_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -18100,6 +19527,7 @@ static void m68k_op_ori_8_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18115,6 +19543,7 @@ static void m68k_op_ori_8_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18130,6 +19559,7 @@ static void m68k_op_ori_8_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18145,6 +19575,7 @@ static void m68k_op_ori_8_pi7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18160,6 +19591,7 @@ static void m68k_op_ori_8_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -18175,6 +19607,7 @@ static void m68k_op_ori_8_pd7(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -18190,6 +19623,7 @@ static void m68k_op_ori_8_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18205,6 +19639,7 @@ static void m68k_op_ori_8_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -18220,6 +19655,7 @@ static void m68k_op_ori_8_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18235,6 +19671,7 @@ static void m68k_op_ori_8_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -18246,6 +19683,7 @@ static void m68k_op_ori_16_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18261,6 +19699,7 @@ static void m68k_op_ori_16_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18276,6 +19715,7 @@ static void m68k_op_ori_16_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18291,6 +19731,7 @@ static void m68k_op_ori_16_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -18306,6 +19747,7 @@ static void m68k_op_ori_16_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18321,6 +19763,7 @@ static void m68k_op_ori_16_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -18336,6 +19779,7 @@ static void m68k_op_ori_16_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18351,6 +19795,7 @@ static void m68k_op_ori_16_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -18362,6 +19807,7 @@ static void m68k_op_ori_32_d(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18377,6 +19823,7 @@ static void m68k_op_ori_32_ai(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -18392,6 +19839,7 @@ static void m68k_op_ori_32_pi(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -18407,6 +19855,7 @@ static void m68k_op_ori_32_pd(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -18422,6 +19871,7 @@ static void m68k_op_ori_32_di(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -18437,6 +19887,7 @@ static void m68k_op_ori_32_ix(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -18452,6 +19903,7 @@ static void m68k_op_ori_32_aw(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -18467,12 +19919,14 @@ static void m68k_op_ori_32_al(void)
   FLAG_Z = res;
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(36*MUL);
 }
 
 
 static void m68k_op_ori_16_toc(void)
 {
   m68ki_set_ccr(m68ki_get_ccr() | OPER_I_16());
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18482,9 +19936,11 @@ static void m68k_op_ori_16_tos(void)
   {
     uint src = OPER_I_16();
     m68ki_set_sr(m68ki_get_sr() | src);
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18493,6 +19949,7 @@ static void m68k_op_pea_32_ai(void)
   uint ea = EA_AY_AI_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -18501,6 +19958,7 @@ static void m68k_op_pea_32_di(void)
   uint ea = EA_AY_DI_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18509,6 +19967,7 @@ static void m68k_op_pea_32_ix(void)
   uint ea = EA_AY_IX_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18517,6 +19976,7 @@ static void m68k_op_pea_32_aw(void)
   uint ea = EA_AW_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18525,6 +19985,7 @@ static void m68k_op_pea_32_al(void)
   uint ea = EA_AL_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18533,6 +19994,7 @@ static void m68k_op_pea_32_pcdi(void)
   uint ea = EA_PCDI_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18541,6 +20003,7 @@ static void m68k_op_pea_32_pcix(void)
   uint ea = EA_PCIX_32();
 
   m68ki_push_32(ea);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18573,6 +20036,7 @@ static void m68k_op_ror_8_s(void)
   FLAG_Z = res;
   FLAG_C = src << (9-orig_shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18592,6 +20056,7 @@ static void m68k_op_ror_16_s(void)
   FLAG_Z = res;
   FLAG_C = src << (9-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18611,6 +20076,7 @@ static void m68k_op_ror_32_s(void)
   FLAG_Z = res;
   FLAG_C = src << (9-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18631,6 +20097,7 @@ static void m68k_op_ror_8_r(void)
     FLAG_N = NFLAG_8(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -18638,6 +20105,7 @@ static void m68k_op_ror_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18658,6 +20126,7 @@ static void m68k_op_ror_16_r(void)
     FLAG_N = NFLAG_16(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -18665,6 +20134,7 @@ static void m68k_op_ror_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18685,6 +20155,7 @@ static void m68k_op_ror_32_r(void)
     FLAG_N = NFLAG_32(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -18692,6 +20163,7 @@ static void m68k_op_ror_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18707,6 +20179,7 @@ static void m68k_op_ror_16_ai(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -18722,6 +20195,7 @@ static void m68k_op_ror_16_pi(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -18737,6 +20211,7 @@ static void m68k_op_ror_16_pd(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -18752,6 +20227,7 @@ static void m68k_op_ror_16_di(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18767,6 +20243,7 @@ static void m68k_op_ror_16_ix(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -18782,6 +20259,7 @@ static void m68k_op_ror_16_aw(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -18797,6 +20275,7 @@ static void m68k_op_ror_16_al(void)
   FLAG_Z = res;
   FLAG_C = src << 8;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -18817,6 +20296,7 @@ static void m68k_op_rol_8_s(void)
   FLAG_Z = res;
   FLAG_C = src << orig_shift;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18836,6 +20316,7 @@ static void m68k_op_rol_16_s(void)
   FLAG_Z = res;
   FLAG_C = src >> (8-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18855,6 +20336,7 @@ static void m68k_op_rol_32_s(void)
   FLAG_Z = res;
   FLAG_C = src >> (24-shift);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18877,12 +20359,14 @@ static void m68k_op_rol_8_r(void)
       FLAG_N = NFLAG_8(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
     FLAG_C = (src & 1)<<8;
     FLAG_N = NFLAG_8(src);
     FLAG_Z = src;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -18890,6 +20374,7 @@ static void m68k_op_rol_8_r(void)
   FLAG_N = NFLAG_8(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18912,12 +20397,14 @@ static void m68k_op_rol_16_r(void)
       FLAG_N = NFLAG_16(res);
       FLAG_Z = res;
       FLAG_V = VFLAG_CLEAR;
+      USE_CYCLES(6*MUL);
       return;
     }
     FLAG_C = (src & 1)<<8;
     FLAG_N = NFLAG_16(src);
     FLAG_Z = src;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -18925,6 +20412,7 @@ static void m68k_op_rol_16_r(void)
   FLAG_N = NFLAG_16(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -18946,6 +20434,7 @@ static void m68k_op_rol_32_r(void)
     FLAG_N = NFLAG_32(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -18953,6 +20442,7 @@ static void m68k_op_rol_32_r(void)
   FLAG_N = NFLAG_32(src);
   FLAG_Z = src;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -18968,6 +20458,7 @@ static void m68k_op_rol_16_ai(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -18983,6 +20474,7 @@ static void m68k_op_rol_16_pi(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -18998,6 +20490,7 @@ static void m68k_op_rol_16_pd(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -19013,6 +20506,7 @@ static void m68k_op_rol_16_di(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19028,6 +20522,7 @@ static void m68k_op_rol_16_ix(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19043,6 +20538,7 @@ static void m68k_op_rol_16_aw(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19058,6 +20554,7 @@ static void m68k_op_rol_16_al(void)
   FLAG_Z = res;
   FLAG_C = src >> 7;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -19079,6 +20576,7 @@ static void m68k_op_roxr_8_s(void)
   FLAG_N = NFLAG_8(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19100,6 +20598,7 @@ static void m68k_op_roxr_16_s(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19145,6 +20644,7 @@ static void m68k_op_roxr_32_s(void)
   FLAG_V = VFLAG_CLEAR;
 
 #endif
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -19168,6 +20668,7 @@ static void m68k_op_roxr_8_r(void)
     FLAG_N = NFLAG_8(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -19175,6 +20676,7 @@ static void m68k_op_roxr_8_r(void)
   FLAG_N = NFLAG_8(*r_dst);
   FLAG_Z = MASK_OUT_ABOVE_8(*r_dst);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19198,6 +20700,7 @@ static void m68k_op_roxr_16_r(void)
     FLAG_N = NFLAG_16(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -19205,6 +20708,7 @@ static void m68k_op_roxr_16_r(void)
   FLAG_N = NFLAG_16(*r_dst);
   FLAG_Z = MASK_OUT_ABOVE_16(*r_dst);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19232,6 +20736,7 @@ static void m68k_op_roxr_32_r(void)
     FLAG_N = NFLAG_32(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -19265,6 +20770,7 @@ static void m68k_op_roxr_32_r(void)
   FLAG_V = VFLAG_CLEAR;
 
 #endif
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -19282,6 +20788,7 @@ static void m68k_op_roxr_16_ai(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -19299,6 +20806,7 @@ static void m68k_op_roxr_16_pi(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -19316,6 +20824,7 @@ static void m68k_op_roxr_16_pd(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -19333,6 +20842,7 @@ static void m68k_op_roxr_16_di(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19350,6 +20860,7 @@ static void m68k_op_roxr_16_ix(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19367,6 +20878,7 @@ static void m68k_op_roxr_16_aw(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19384,6 +20896,7 @@ static void m68k_op_roxr_16_al(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -19405,6 +20918,7 @@ static void m68k_op_roxl_8_s(void)
   FLAG_N = NFLAG_8(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19426,6 +20940,7 @@ static void m68k_op_roxl_16_s(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19471,6 +20986,7 @@ static void m68k_op_roxl_32_s(void)
   FLAG_V = VFLAG_CLEAR;
 
 #endif
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -19495,6 +21011,7 @@ static void m68k_op_roxl_8_r(void)
     FLAG_N = NFLAG_8(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -19502,6 +21019,7 @@ static void m68k_op_roxl_8_r(void)
   FLAG_N = NFLAG_8(*r_dst);
   FLAG_Z = MASK_OUT_ABOVE_8(*r_dst);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19525,6 +21043,7 @@ static void m68k_op_roxl_16_r(void)
     FLAG_N = NFLAG_16(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(6*MUL);
     return;
   }
 
@@ -19532,6 +21051,7 @@ static void m68k_op_roxl_16_r(void)
   FLAG_N = NFLAG_16(*r_dst);
   FLAG_Z = MASK_OUT_ABOVE_16(*r_dst);
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19559,6 +21079,7 @@ static void m68k_op_roxl_32_r(void)
     FLAG_N = NFLAG_32(res);
     FLAG_Z = res;
     FLAG_V = VFLAG_CLEAR;
+    USE_CYCLES(8*MUL);
     return;
   }
 
@@ -19592,6 +21113,7 @@ static void m68k_op_roxl_32_r(void)
   FLAG_V = VFLAG_CLEAR;
 
 #endif
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -19609,6 +21131,7 @@ static void m68k_op_roxl_16_ai(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -19626,6 +21149,7 @@ static void m68k_op_roxl_16_pi(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -19643,6 +21167,7 @@ static void m68k_op_roxl_16_pd(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -19660,6 +21185,7 @@ static void m68k_op_roxl_16_di(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19677,6 +21203,7 @@ static void m68k_op_roxl_16_ix(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19694,6 +21221,7 @@ static void m68k_op_roxl_16_aw(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19711,6 +21239,7 @@ static void m68k_op_roxl_16_al(void)
   FLAG_N = NFLAG_16(res);
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -19731,9 +21260,11 @@ static void m68k_op_rte_32(void)
     CPU_RUN_MODE = RUN_MODE_NORMAL;
 #endif
 
+    USE_CYCLES(20*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -19741,12 +21272,14 @@ static void m68k_op_rtr_32(void)
 {
   m68ki_set_ccr(m68ki_pull_16());
   m68ki_jump(m68ki_pull_32());
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_rts_32(void)
 {
   m68ki_jump(m68ki_pull_32());
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -19781,6 +21314,7 @@ static void m68k_op_sbcd_8_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | res;
+  USE_CYCLES(6*MUL);
 }
 
 
@@ -19814,6 +21348,7 @@ static void m68k_op_sbcd_8_mm_ax7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19847,6 +21382,7 @@ static void m68k_op_sbcd_8_mm_ay7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19880,6 +21416,7 @@ static void m68k_op_sbcd_8_mm_axy7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -19913,126 +21450,147 @@ static void m68k_op_sbcd_8_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_st_8_d(void)
 {
   DY |= 0xff;
+  USE_CYCLES(6*MUL);
 }
 
 
 static void m68k_op_st_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), 0xff);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_st_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), 0xff);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_st_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), 0xff);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_st_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), 0xff);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_st_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), 0xff);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_st_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), 0xff);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_st_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), 0xff);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_st_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), 0xff);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_st_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), 0xff);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sf_8_d(void)
 {
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_sf_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sf_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sf_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sf_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sf_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sf_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sf_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sf_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sf_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), 0);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -20042,9 +21600,11 @@ static void m68k_op_shi_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20054,9 +21614,11 @@ static void m68k_op_sls_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20066,9 +21628,11 @@ static void m68k_op_scc_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20078,9 +21642,11 @@ static void m68k_op_scs_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20090,9 +21656,11 @@ static void m68k_op_sne_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20102,9 +21670,11 @@ static void m68k_op_seq_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20114,9 +21684,11 @@ static void m68k_op_svc_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20126,9 +21698,11 @@ static void m68k_op_svs_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20138,9 +21712,11 @@ static void m68k_op_spl_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20150,9 +21726,11 @@ static void m68k_op_smi_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20162,9 +21740,11 @@ static void m68k_op_sge_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20174,9 +21754,11 @@ static void m68k_op_slt_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20186,9 +21768,11 @@ static void m68k_op_sgt_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20198,765 +21782,893 @@ static void m68k_op_sle_8_d(void)
   {
     DY |= 0xff;
     USE_CYCLES(CYC_SCC_R_TRUE);
+    USE_CYCLES(4*MUL);
     return;
   }
   DY &= 0xffffff00;
+  USE_CYCLES(4*MUL);
 }
 
 
 static void m68k_op_shi_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_shi_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_shi_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_shi_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_shi_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_shi_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_shi_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_shi_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_shi_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_HI() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sls_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sls_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sls_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sls_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sls_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sls_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sls_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sls_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sls_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_LS() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_scc_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scc_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scc_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scc_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_scc_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_scc_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_scc_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_scc_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_scc_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_CC() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_scs_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scs_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scs_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_scs_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_scs_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_scs_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_scs_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_scs_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_scs_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_CS() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sne_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sne_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sne_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sne_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sne_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sne_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sne_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sne_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sne_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_NE() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_seq_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_seq_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_seq_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_seq_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_seq_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_seq_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_seq_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_seq_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_seq_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_EQ() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_svc_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svc_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svc_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svc_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_svc_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_svc_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_svc_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_svc_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_svc_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_VC() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_svs_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svs_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svs_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_svs_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_svs_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_svs_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_svs_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_svs_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_svs_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_VS() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_spl_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_spl_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_spl_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_spl_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_spl_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_spl_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_spl_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_spl_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_spl_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_PL() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_smi_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_smi_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_smi_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_smi_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_smi_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_smi_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_smi_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_smi_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_smi_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_MI() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sge_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sge_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sge_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sge_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sge_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sge_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sge_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sge_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sge_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_GE() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_slt_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_slt_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_slt_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_slt_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_slt_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_slt_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_slt_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_slt_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_slt_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_LT() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sgt_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sgt_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sgt_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sgt_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sgt_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sgt_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sgt_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sgt_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sgt_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_GT() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_sle_8_ai(void)
 {
   m68ki_write_8(EA_AY_AI_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sle_8_pi(void)
 {
   m68ki_write_8(EA_AY_PI_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sle_8_pi7(void)
 {
   m68ki_write_8(EA_A7_PI_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(12*MUL);
 }
 
 
 static void m68k_op_sle_8_pd(void)
 {
   m68ki_write_8(EA_AY_PD_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sle_8_pd7(void)
 {
   m68ki_write_8(EA_A7_PD_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(14*MUL);
 }
 
 
 static void m68k_op_sle_8_di(void)
 {
   m68ki_write_8(EA_AY_DI_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sle_8_ix(void)
 {
   m68ki_write_8(EA_AY_IX_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(18*MUL);
 }
 
 
 static void m68k_op_sle_8_aw(void)
 {
   m68ki_write_8(EA_AW_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(16*MUL);
 }
 
 
 static void m68k_op_sle_8_al(void)
 {
   m68ki_write_8(EA_AL_8(), COND_LE() ? 0xff : 0);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -20971,9 +22683,11 @@ static void m68k_op_stop(void)
     {
       SET_CYCLES(m68ki_cpu.cycle_end - 4*MUL); 
     }
+    USE_CYCLES(4*MUL);
     return;
   }
   m68ki_exception_privilege_violation();
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -20990,6 +22704,7 @@ static void m68k_op_sub_8_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -21006,6 +22721,7 @@ static void m68k_op_sub_8_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21022,6 +22738,7 @@ static void m68k_op_sub_8_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21038,6 +22755,7 @@ static void m68k_op_sub_8_er_pi7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21054,6 +22772,7 @@ static void m68k_op_sub_8_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -21070,6 +22789,7 @@ static void m68k_op_sub_8_er_pd7(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -21086,6 +22806,7 @@ static void m68k_op_sub_8_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21102,6 +22823,7 @@ static void m68k_op_sub_8_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21118,6 +22840,7 @@ static void m68k_op_sub_8_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21134,6 +22857,7 @@ static void m68k_op_sub_8_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21150,6 +22874,7 @@ static void m68k_op_sub_8_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21166,6 +22891,7 @@ static void m68k_op_sub_8_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21182,6 +22908,7 @@ static void m68k_op_sub_8_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_8(res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21198,6 +22925,7 @@ static void m68k_op_sub_16_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -21214,6 +22942,7 @@ static void m68k_op_sub_16_er_a(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -21230,6 +22959,7 @@ static void m68k_op_sub_16_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21246,6 +22976,7 @@ static void m68k_op_sub_16_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21262,6 +22993,7 @@ static void m68k_op_sub_16_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -21278,6 +23010,7 @@ static void m68k_op_sub_16_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21294,6 +23027,7 @@ static void m68k_op_sub_16_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21310,6 +23044,7 @@ static void m68k_op_sub_16_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21326,6 +23061,7 @@ static void m68k_op_sub_16_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21342,6 +23078,7 @@ static void m68k_op_sub_16_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21358,6 +23095,7 @@ static void m68k_op_sub_16_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21374,6 +23112,7 @@ static void m68k_op_sub_16_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_16(res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21390,6 +23129,7 @@ static void m68k_op_sub_32_er_d(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21406,6 +23146,7 @@ static void m68k_op_sub_32_er_a(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21422,6 +23163,7 @@ static void m68k_op_sub_32_er_ai(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21438,6 +23180,7 @@ static void m68k_op_sub_32_er_pi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21454,6 +23197,7 @@ static void m68k_op_sub_32_er_pd(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21470,6 +23214,7 @@ static void m68k_op_sub_32_er_di(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -21486,6 +23231,7 @@ static void m68k_op_sub_32_er_ix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21502,6 +23248,7 @@ static void m68k_op_sub_32_er_aw(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -21518,6 +23265,7 @@ static void m68k_op_sub_32_er_al(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -21534,6 +23282,7 @@ static void m68k_op_sub_32_er_pcdi(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -21550,6 +23299,7 @@ static void m68k_op_sub_32_er_pcix(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21566,6 +23316,7 @@ static void m68k_op_sub_32_er_i(void)
   FLAG_Z = MASK_OUT_ABOVE_32(res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21582,6 +23333,7 @@ static void m68k_op_sub_8_re_ai(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21598,6 +23350,7 @@ static void m68k_op_sub_8_re_pi(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21614,6 +23367,7 @@ static void m68k_op_sub_8_re_pi7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21630,6 +23384,7 @@ static void m68k_op_sub_8_re_pd(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21646,6 +23401,7 @@ static void m68k_op_sub_8_re_pd7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21662,6 +23418,7 @@ static void m68k_op_sub_8_re_di(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21678,6 +23435,7 @@ static void m68k_op_sub_8_re_ix(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -21694,6 +23452,7 @@ static void m68k_op_sub_8_re_aw(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21710,6 +23469,7 @@ static void m68k_op_sub_8_re_al(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21726,6 +23486,7 @@ static void m68k_op_sub_16_re_ai(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21742,6 +23503,7 @@ static void m68k_op_sub_16_re_pi(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21758,6 +23520,7 @@ static void m68k_op_sub_16_re_pd(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21774,6 +23537,7 @@ static void m68k_op_sub_16_re_di(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21790,6 +23554,7 @@ static void m68k_op_sub_16_re_ix(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -21806,6 +23571,7 @@ static void m68k_op_sub_16_re_aw(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21822,6 +23588,7 @@ static void m68k_op_sub_16_re_al(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21838,6 +23605,7 @@ static void m68k_op_sub_32_re_ai(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21854,6 +23622,7 @@ static void m68k_op_sub_32_re_pi(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -21870,6 +23639,7 @@ static void m68k_op_sub_32_re_pd(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -21886,6 +23656,7 @@ static void m68k_op_sub_32_re_di(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -21902,6 +23673,7 @@ static void m68k_op_sub_32_re_ix(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -21918,6 +23690,7 @@ static void m68k_op_sub_32_re_aw(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -21934,6 +23707,7 @@ static void m68k_op_sub_32_re_al(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -21942,6 +23716,7 @@ static void m68k_op_suba_16_d(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - MAKE_INT_16(DY));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21950,6 +23725,7 @@ static void m68k_op_suba_16_a(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - MAKE_INT_16(AY));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -21959,6 +23735,7 @@ static void m68k_op_suba_16_ai(void)
   uint src = MAKE_INT_16(OPER_AY_AI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21968,6 +23745,7 @@ static void m68k_op_suba_16_pi(void)
   uint src = MAKE_INT_16(OPER_AY_PI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -21977,6 +23755,7 @@ static void m68k_op_suba_16_pd(void)
   uint src = MAKE_INT_16(OPER_AY_PD_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -21986,6 +23765,7 @@ static void m68k_op_suba_16_di(void)
   uint src = MAKE_INT_16(OPER_AY_DI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -21995,6 +23775,7 @@ static void m68k_op_suba_16_ix(void)
   uint src = MAKE_INT_16(OPER_AY_IX_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22004,6 +23785,7 @@ static void m68k_op_suba_16_aw(void)
   uint src = MAKE_INT_16(OPER_AW_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22013,6 +23795,7 @@ static void m68k_op_suba_16_al(void)
   uint src = MAKE_INT_16(OPER_AL_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22022,6 +23805,7 @@ static void m68k_op_suba_16_pcdi(void)
   uint src = MAKE_INT_16(OPER_PCDI_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22031,6 +23815,7 @@ static void m68k_op_suba_16_pcix(void)
   uint src = MAKE_INT_16(OPER_PCIX_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22040,6 +23825,7 @@ static void m68k_op_suba_16_i(void)
   uint src = MAKE_INT_16(OPER_I_16());
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22048,6 +23834,7 @@ static void m68k_op_suba_32_d(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - DY);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22056,6 +23843,7 @@ static void m68k_op_suba_32_a(void)
   uint* r_dst = &AX;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - AY);
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22065,6 +23853,7 @@ static void m68k_op_suba_32_ai(void)
   uint src = OPER_AY_AI_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -22074,6 +23863,7 @@ static void m68k_op_suba_32_pi(void)
   uint src = OPER_AY_PI_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -22083,6 +23873,7 @@ static void m68k_op_suba_32_pd(void)
   uint src = OPER_AY_PD_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22092,6 +23883,7 @@ static void m68k_op_suba_32_di(void)
   uint src = OPER_AY_DI_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22101,6 +23893,7 @@ static void m68k_op_suba_32_ix(void)
   uint src = OPER_AY_IX_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22110,6 +23903,7 @@ static void m68k_op_suba_32_aw(void)
   uint src = OPER_AW_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22119,6 +23913,7 @@ static void m68k_op_suba_32_al(void)
   uint src = OPER_AL_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -22128,6 +23923,7 @@ static void m68k_op_suba_32_pcdi(void)
   uint src = OPER_PCDI_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22137,6 +23933,7 @@ static void m68k_op_suba_32_pcix(void)
   uint src = OPER_PCIX_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22146,6 +23943,7 @@ static void m68k_op_suba_32_i(void)
   uint src = OPER_I_32();
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - src);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22162,6 +23960,7 @@ static void m68k_op_subi_8_d(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22178,6 +23977,7 @@ static void m68k_op_subi_8_ai(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22194,6 +23994,7 @@ static void m68k_op_subi_8_pi(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22210,6 +24011,7 @@ static void m68k_op_subi_8_pi7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22226,6 +24028,7 @@ static void m68k_op_subi_8_pd(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22242,6 +24045,7 @@ static void m68k_op_subi_8_pd7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22258,6 +24062,7 @@ static void m68k_op_subi_8_di(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22274,6 +24079,7 @@ static void m68k_op_subi_8_ix(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -22290,6 +24096,7 @@ static void m68k_op_subi_8_aw(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22306,6 +24113,7 @@ static void m68k_op_subi_8_al(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -22322,6 +24130,7 @@ static void m68k_op_subi_16_d(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22338,6 +24147,7 @@ static void m68k_op_subi_16_ai(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22354,6 +24164,7 @@ static void m68k_op_subi_16_pi(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22370,6 +24181,7 @@ static void m68k_op_subi_16_pd(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22386,6 +24198,7 @@ static void m68k_op_subi_16_di(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22402,6 +24215,7 @@ static void m68k_op_subi_16_ix(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -22418,6 +24232,7 @@ static void m68k_op_subi_16_aw(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22434,6 +24249,7 @@ static void m68k_op_subi_16_al(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -22450,6 +24266,7 @@ static void m68k_op_subi_32_d(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22466,6 +24283,7 @@ static void m68k_op_subi_32_ai(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -22482,6 +24300,7 @@ static void m68k_op_subi_32_pi(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -22498,6 +24317,7 @@ static void m68k_op_subi_32_pd(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -22514,6 +24334,7 @@ static void m68k_op_subi_32_di(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -22530,6 +24351,7 @@ static void m68k_op_subi_32_ix(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(34*MUL);
 }
 
 
@@ -22546,6 +24368,7 @@ static void m68k_op_subi_32_aw(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(32*MUL);
 }
 
 
@@ -22562,6 +24385,7 @@ static void m68k_op_subi_32_al(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(36*MUL);
 }
 
 
@@ -22578,6 +24402,7 @@ static void m68k_op_subq_8_d(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -22594,6 +24419,7 @@ static void m68k_op_subq_8_ai(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22610,6 +24436,7 @@ static void m68k_op_subq_8_pi(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22626,6 +24453,7 @@ static void m68k_op_subq_8_pi7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22642,6 +24470,7 @@ static void m68k_op_subq_8_pd(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -22658,6 +24487,7 @@ static void m68k_op_subq_8_pd7(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -22674,6 +24504,7 @@ static void m68k_op_subq_8_di(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22690,6 +24521,7 @@ static void m68k_op_subq_8_ix(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22706,6 +24538,7 @@ static void m68k_op_subq_8_aw(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22722,6 +24555,7 @@ static void m68k_op_subq_8_al(void)
   FLAG_V = VFLAG_SUB_8(src, dst, res);
 
   m68ki_write_8(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22738,6 +24572,7 @@ static void m68k_op_subq_16_d(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | FLAG_Z;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -22746,6 +24581,7 @@ static void m68k_op_subq_16_a(void)
   uint* r_dst = &AY;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - ((((REG_IR >> 9) - 1) & 7) + 1));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22762,6 +24598,7 @@ static void m68k_op_subq_16_ai(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22778,6 +24615,7 @@ static void m68k_op_subq_16_pi(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -22794,6 +24632,7 @@ static void m68k_op_subq_16_pd(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -22810,6 +24649,7 @@ static void m68k_op_subq_16_di(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22826,6 +24666,7 @@ static void m68k_op_subq_16_ix(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -22842,6 +24683,7 @@ static void m68k_op_subq_16_aw(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -22858,6 +24700,7 @@ static void m68k_op_subq_16_al(void)
   FLAG_V = VFLAG_SUB_16(src, dst, res);
 
   m68ki_write_16(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22874,6 +24717,7 @@ static void m68k_op_subq_32_d(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   *r_dst = FLAG_Z;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22882,6 +24726,7 @@ static void m68k_op_subq_32_a(void)
   uint* r_dst = &AY;
 
   *r_dst = MASK_OUT_ABOVE_32(*r_dst - ((((REG_IR >> 9) - 1) & 7) + 1));
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -22898,6 +24743,7 @@ static void m68k_op_subq_32_ai(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22914,6 +24760,7 @@ static void m68k_op_subq_32_pi(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -22930,6 +24777,7 @@ static void m68k_op_subq_32_pd(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -22946,6 +24794,7 @@ static void m68k_op_subq_32_di(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -22962,6 +24811,7 @@ static void m68k_op_subq_32_ix(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -22978,6 +24828,7 @@ static void m68k_op_subq_32_aw(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -22994,6 +24845,7 @@ static void m68k_op_subq_32_al(void)
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   m68ki_write_32(ea, FLAG_Z);
+  USE_CYCLES(28*MUL);
 }
 
 
@@ -23012,6 +24864,7 @@ static void m68k_op_subx_8_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_8(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23030,6 +24883,7 @@ static void m68k_op_subx_16_rr(void)
   FLAG_Z |= res;
 
   *r_dst = MASK_OUT_BELOW_16(*r_dst) | res;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23041,13 +24895,14 @@ static void m68k_op_subx_32_rr(void)
   uint res = dst - src - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, dst, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, dst, res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   *r_dst = res;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23066,6 +24921,7 @@ static void m68k_op_subx_8_mm_ax7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23084,6 +24940,7 @@ static void m68k_op_subx_8_mm_ay7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23102,6 +24959,7 @@ static void m68k_op_subx_8_mm_axy7(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23120,6 +24978,7 @@ static void m68k_op_subx_8_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_8(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23138,6 +24997,7 @@ static void m68k_op_subx_16_mm(void)
   FLAG_Z |= res;
 
   m68ki_write_16(ea, res);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23149,13 +25009,14 @@ static void m68k_op_subx_32_mm(void)
   uint res = dst - src - XFLAG_AS_1();
 
   FLAG_N = NFLAG_32(res);
-  FLAG_X = FLAG_C = CFLAG_SUB_32(src, dst, res);
+  FLAG_X = FLAG_C = CFLAG_SUBX_32(src, dst, res);
   FLAG_V = VFLAG_SUB_32(src, dst, res);
 
   res = MASK_OUT_ABOVE_32(res);
   FLAG_Z |= res;
 
   m68ki_write_32(ea, res);
+  USE_CYCLES(30*MUL);
 }
 
 
@@ -23170,6 +25031,7 @@ static void m68k_op_swap_32(void)
   FLAG_N = NFLAG_32(*r_dst);
   FLAG_C = CFLAG_CLEAR;
   FLAG_V = VFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23182,6 +25044,7 @@ static void m68k_op_tas_8_d(void)
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
   *r_dst |= 0x80;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23200,6 +25063,7 @@ static void m68k_op_tas_8_ai(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23218,6 +25082,7 @@ static void m68k_op_tas_8_pi(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23236,6 +25101,7 @@ static void m68k_op_tas_8_pi7(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23254,6 +25120,7 @@ static void m68k_op_tas_8_pd(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -23272,6 +25139,7 @@ static void m68k_op_tas_8_pd7(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(20*MUL);
 }
 
 
@@ -23290,6 +25158,7 @@ static void m68k_op_tas_8_di(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -23308,6 +25177,7 @@ static void m68k_op_tas_8_ix(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(24*MUL);
 }
 
 
@@ -23326,6 +25196,7 @@ static void m68k_op_tas_8_aw(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(22*MUL);
 }
 
 
@@ -23344,6 +25215,7 @@ static void m68k_op_tas_8_al(void)
        on this, but only when accessing specific addresses so additional functionality
        will be needed. */
   if (m68ki_tas_callback()) m68ki_write_8(ea, dst | 0x80);
+  USE_CYCLES(26*MUL);
 }
 
 
@@ -23351,6 +25223,7 @@ static void m68k_op_trap(void)
 {
   /* Trap#n stacks exception frame type 0 */
   m68ki_exception_trapN(EXCEPTION_TRAP_BASE + (REG_IR & 0xf));  /* HJB 990403 */
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23358,9 +25231,11 @@ static void m68k_op_trapv(void)
 {
   if(COND_VC())
   {
+    USE_CYCLES(4*MUL);
     return;
   }
   m68ki_exception_trap(EXCEPTION_TRAPV);  /* HJB 990403 */
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23372,6 +25247,7 @@ static void m68k_op_tst_8_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23383,6 +25259,7 @@ static void m68k_op_tst_8_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23394,6 +25271,7 @@ static void m68k_op_tst_8_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23405,6 +25283,7 @@ static void m68k_op_tst_8_pi7(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23416,6 +25295,7 @@ static void m68k_op_tst_8_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -23427,6 +25307,7 @@ static void m68k_op_tst_8_pd7(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -23438,6 +25319,7 @@ static void m68k_op_tst_8_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23449,6 +25331,7 @@ static void m68k_op_tst_8_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -23460,6 +25343,7 @@ static void m68k_op_tst_8_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23471,6 +25355,7 @@ static void m68k_op_tst_8_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -23482,6 +25367,7 @@ static void m68k_op_tst_16_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23493,6 +25379,7 @@ static void m68k_op_tst_16_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23504,6 +25391,7 @@ static void m68k_op_tst_16_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(8*MUL);
 }
 
 
@@ -23515,6 +25403,7 @@ static void m68k_op_tst_16_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(10*MUL);
 }
 
 
@@ -23526,6 +25415,7 @@ static void m68k_op_tst_16_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23537,6 +25427,7 @@ static void m68k_op_tst_16_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -23548,6 +25439,7 @@ static void m68k_op_tst_16_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23559,6 +25451,7 @@ static void m68k_op_tst_16_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -23570,6 +25463,7 @@ static void m68k_op_tst_32_d(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(4*MUL);
 }
 
 
@@ -23581,6 +25475,7 @@ static void m68k_op_tst_32_ai(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23592,6 +25487,7 @@ static void m68k_op_tst_32_pi(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23603,6 +25499,7 @@ static void m68k_op_tst_32_pd(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(14*MUL);
 }
 
 
@@ -23614,6 +25511,7 @@ static void m68k_op_tst_32_di(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -23625,6 +25523,7 @@ static void m68k_op_tst_32_ix(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(18*MUL);
 }
 
 
@@ -23636,6 +25535,7 @@ static void m68k_op_tst_32_aw(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(16*MUL);
 }
 
 
@@ -23647,12 +25547,14 @@ static void m68k_op_tst_32_al(void)
   FLAG_Z = res;
   FLAG_V = VFLAG_CLEAR;
   FLAG_C = CFLAG_CLEAR;
+  USE_CYCLES(20*MUL);
 }
 
 
 static void m68k_op_unlk_32_a7(void)
 {
   REG_A[7] = m68ki_read_32(REG_A[7]);
+  USE_CYCLES(12*MUL);
 }
 
 
@@ -23662,6 +25564,7 @@ static void m68k_op_unlk_32(void)
 
   REG_A[7] = *r_dst;
   *r_dst = m68ki_pull_32();
+  USE_CYCLES(12*MUL);
 }
 
 
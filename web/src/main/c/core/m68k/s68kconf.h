@@ -86,6 +86,15 @@
 #define M68K_USE_64_BIT  OPT_OFF
 
 
+/* If ON, the carry of 32-bit ADD, SUB, CMP and NEG is bit 32 of the 64-bit
+ * result (a native type under WASM and on 64-bit hosts) instead of being
+ * rebuilt from the operand and result MSBs. The condition codes stay eager:
+ * the core already stores them unnormalized (Z is the result, N and C are
+ * shifted results), so a lazy record would cost as many stores as it saves.
+ */
+#define M68K_CARRY_64  OPT_ON
+
+
 /* ======================================================================== */
 /* ============================== END OF FILE ============================= */
 /* ======================================================================== */
@@ -238,8 +238,8 @@ void s68k_run(unsigned int cycles)
   /* Save end cycles count for when CPU is stopped */
   s68k.cycle_end = cycles;
 
-  /* Return point for when we have an address error (TODO: use goto) */
-  m68ki_set_address_error_trap() /* auto-disable (see m68kcpu.h) */
+  /* the memory map may have changed since the last call */
+  m68ki_fetch_invalidate();
 
 #ifdef LOG_SCD
   error("[%d][%d] s68k run to %d cycles (%x), irq mask = %x (%x)\n", v_counter, s68k.cycles, cycles, s68k.pc,FLAG_INT_MASK, CPU_INT_LEVEL);
@@ -256,9 +256,8 @@ void s68k_run(unsigned int cycles)
     /* Decode next instruction */
     REG_IR = m68ki_read_imm_16();
 
-    /* Execute instruction */
+    /* Execute instruction (the handler uses up its cycles) */
     m68ki_instruction_jump_table[REG_IR]();
-    USE_CYCLES(CYC_INSTRUCTION[REG_IR]);
 
     /* Trace m68k_exception, if necessary */
     m68ki_exception_if_trace(); /* auto-disable (see m68kcpu.h) */
@@ -330,6 +329,7 @@ void s68k_pulse_reset(void)
 #endif /* M68K_EMULATE_PREFETCH */
 
   /* Read the initial stack pointer and program counter */
+  m68ki_fetch_invalidate();
   m68ki_jump(0);
   REG_SP = m68ki_read_imm_32();
   REG_PC = m68ki_read_imm_32();
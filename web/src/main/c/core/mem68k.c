@@ -86,6 +86,7 @@ void m68k_lockup_w_8 (unsigned int address, unsigned int data)
 #ifdef LOGERROR
   error ("Lockup %08X = %02X (%08X)\n", address, data, m68k_get_reg(M68K_REG_PC));
 #endif
+  m68k.lockups++;
   if (!config.force_dtack)
   {
     m68k_pulse_halt();
@@ -98,6 +99,7 @@ void m68k_lockup_w_16 (unsigned int address, unsigned int data)
 #ifdef LOGERROR
   error ("Lockup %08X = %04X (%08X)\n", address, data, m68k_get_reg(M68K_REG_PC));
 #endif
+  m68k.lockups++;
   if (!config.force_dtack)
   {
     m68k_pulse_halt();
@@ -110,6 +112,7 @@ unsigned int m68k_lockup_r_8 (unsigned int address)
 #ifdef LOGERROR
   error ("Lockup %08X.b (%08X)\n", address, m68k_get_reg(M68K_REG_PC));
 #endif
+  m68k.lockups++;
   if (!config.force_dtack)
   {
     m68k_pulse_halt();
@@ -124,6 +127,7 @@ unsigned int m68k_lockup_r_16 (unsigned int address)
 #ifdef LOGERROR
   error ("Lockup %08X.w (%08X)\n", address, m68k_get_reg(M68K_REG_PC));
 #endif
+  m68k.lockups++;
   if (!config.force_dtack)
   {
     m68k_pulse_halt();
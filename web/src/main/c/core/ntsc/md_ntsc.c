@@ -85,7 +85,122 @@ void md_ntsc_init( md_ntsc_t* ntsc, md_ntsc_setup_t const* setup )
   }
 }
 
-#ifndef CUSTOM_BLITTER
+/* The built-in blitter also serves the WASM 32-bit output, whose regular path is a custom blitter */
+#if !defined(CUSTOM_BLITTER) || (MD_NTSC_OUT_DEPTH == 32)
+
+/* 32-bit output: every pair of output pixels (x, x + 1) with x even reads 8 pairs of
+   adjacent kernel entries, so two pairs are summed, clamped and packed at once in
+   4 x 32-bit vector lanes */
+#if (MD_NTSC_OUT_DEPTH == 32) && defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MD_NTSC_VEC128
+typedef v128_t md_ntsc_vec_t;
+#define VEC_LOAD64(p)       wasm_v128_load64_zero(p)
+#define VEC_JOIN64(a, b)    wasm_i64x2_shuffle(a, b, 0, 2)
+#define VEC_STORE(p, v)     wasm_v128_store(p, v)
+#define VEC_SPLAT32(n)      wasm_i32x4_splat(n)
+#define VEC_ADD32(a, b)     wasm_i32x4_add(a, b)
+#define VEC_SUB32(a, b)     wasm_i32x4_sub(a, b)
+#define VEC_AND(a, b)       wasm_v128_and(a, b)
+#define VEC_OR(a, b)        wasm_v128_or(a, b)
+#define VEC_SHL32(v, n)     wasm_i32x4_shl(v, n)
+#define VEC_SHR32(v, n)     wasm_u32x4_shr(v, n)
+#elif (MD_NTSC_OUT_DEPTH == 32) && defined(__SSE2__)
+#include <emmintrin.h>
+#define MD_NTSC_VEC128
+typedef __m128i md_ntsc_vec_t;
+#define VEC_LOAD64(p)       _mm_loadl_epi64((const __m128i *)(p))
+#define VEC_JOIN64(a, b)    _mm_unpacklo_epi64(a, b)
+#define VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+#define VEC_SPLAT32(n)      _mm_set1_epi32((int)(n))
+#define VEC_ADD32(a, b)     _mm_add_epi32(a, b)
+#define VEC_SUB32(a, b)     _mm_sub_epi32(a, b)
+#define VEC_AND(a, b)       _mm_and_si128(a, b)
+#define VEC_OR(a, b)        _mm_or_si128(a, b)
+#define VEC_SHL32(v, n)     _mm_slli_epi32(v, n)
+#define VEC_SHR32(v, n)     _mm_srli_epi32(v, n)
+#endif
+
+#ifdef MD_NTSC_VEC128
+
+/* Raw sums of output pixels x and x + 1 (x even) in the low half */
+#define MD_NTSC_PAIR_SUM( x ) \
+  VEC_ADD32(\
+    VEC_ADD32(\
+      VEC_ADD32( VEC_LOAD64( &kernel0 [x+ 0] ),      VEC_LOAD64( &kernel1 [(x+6)%8+16] ) ),\
+      VEC_ADD32( VEC_LOAD64( &kernel2 [(x+4)%8] ),   VEC_LOAD64( &kernel3 [(x+2)%8+16] ) ) ),\
+    VEC_ADD32(\
+      VEC_ADD32( VEC_LOAD64( &kernelx0 [x+ 8] ),     VEC_LOAD64( &kernelx1 [(x+6)%8+24] ) ),\
+      VEC_ADD32( VEC_LOAD64( &kernelx2 [(x+4)%8+8] ), VEC_LOAD64( &kernelx3 [(x+2)%8+24] ) ) ) )
+
+/* MD_NTSC_CLAMP_ and MD_NTSC_RGB_OUT_ on 4 pixels */
+#define MD_NTSC_VEC_OUT( out, v ) {\
+  md_ntsc_vec_t io_ = (v);\
+  md_ntsc_vec_t sub_ = VEC_AND( VEC_SHR32( io_, 9 ), VEC_SPLAT32( md_ntsc_clamp_mask ) );\
+  md_ntsc_vec_t clamp_ = VEC_SUB32( VEC_SPLAT32( md_ntsc_clamp_add ), sub_ );\
+  io_ = VEC_OR( io_, clamp_ );\
+  clamp_ = VEC_SUB32( clamp_, sub_ );\
+  io_ = VEC_AND( io_, clamp_ );\
+  VEC_STORE( out, VEC_OR( VEC_OR( VEC_SPLAT32( 0xFF000000 ),\
+      VEC_AND( VEC_SHL32( io_, 15 ), VEC_SPLAT32( 0xFF0000 ) ) ),\
+      VEC_OR( VEC_AND( VEC_SHR32( io_, 3 ), VEC_SPLAT32( 0xFF00 ) ),\
+      VEC_AND( VEC_SHR32( io_, 21 ), VEC_SPLAT32( 0x00FF ) ) ) ) );\
+}
+
+void md_ntsc_blit( md_ntsc_t const* ntsc, MD_NTSC_IN_T const* table, unsigned char* input,
+                   int in_width, int vline)
+{
+  int const chunk_count = in_width / md_ntsc_in_chunk - 1;
+
+  /* use palette entry 0 for unused pixels */
+  MD_NTSC_IN_T border = table[0];
+
+  MD_NTSC_BEGIN_ROW( ntsc, border,
+        MD_NTSC_ADJ_IN( table[*input++] ),
+        MD_NTSC_ADJ_IN( table[*input++] ),
+        MD_NTSC_ADJ_IN( table[*input++] ) );
+
+  md_ntsc_out_t* restrict line_out  = (md_ntsc_out_t*)(&bitmap.data[(vline * bitmap.pitch)]);
+
+  md_ntsc_vec_t lo;
+  int n;
+
+  (void) raw_;
+
+  for ( n = chunk_count; n; --n )
+  {
+    /* order of input and output pixels must not be altered */
+    MD_NTSC_COLOR_IN( 0, ntsc, MD_NTSC_ADJ_IN( table[*input++] ) );
+    lo = MD_NTSC_PAIR_SUM( 0 );
+
+    MD_NTSC_COLOR_IN( 1, ntsc, MD_NTSC_ADJ_IN( table[*input++] ) );
+    MD_NTSC_VEC_OUT( line_out, VEC_JOIN64( lo, MD_NTSC_PAIR_SUM( 2 ) ) );
+
+    MD_NTSC_COLOR_IN( 2, ntsc, MD_NTSC_ADJ_IN( table[*input++] ) );
+    lo = MD_NTSC_PAIR_SUM( 4 );
+
+    MD_NTSC_COLOR_IN( 3, ntsc, MD_NTSC_ADJ_IN( table[*input++] ) );
+    MD_NTSC_VEC_OUT( line_out + 4, VEC_JOIN64( lo, MD_NTSC_PAIR_SUM( 6 ) ) );
+
+    line_out += 8;
+  }
+
+  /* finish final pixels */
+  MD_NTSC_COLOR_IN( 0, ntsc, MD_NTSC_ADJ_IN( table[*input++] ) );
+  lo = MD_NTSC_PAIR_SUM( 0 );
+
+  MD_NTSC_COLOR_IN( 1, ntsc, border );
+  MD_NTSC_VEC_OUT( line_out, VEC_JOIN64( lo, MD_NTSC_PAIR_SUM( 2 ) ) );
+
+  MD_NTSC_COLOR_IN( 2, ntsc, border );
+  lo = MD_NTSC_PAIR_SUM( 4 );
+
+  MD_NTSC_COLOR_IN( 3, ntsc, border );
+  MD_NTSC_VEC_OUT( line_out + 4, VEC_JOIN64( lo, MD_NTSC_PAIR_SUM( 6 ) ) );
+}
+
+#else
+
 void md_ntsc_blit( md_ntsc_t const* ntsc, MD_NTSC_IN_T const* table, unsigned char* input,
                    int in_width, int vline)
 {
@@ -141,3 +256,4 @@ void md_ntsc_blit( md_ntsc_t const* ntsc, MD_NTSC_IN_T const* table, unsigned ch
   MD_NTSC_RGB_OUT( 7, *line_out++ );
 }
 #endif
+#endif
@@ -101,7 +101,12 @@ Declares variables, so must be before first statement in a block (unless you're
 
 /* private */
 enum { md_ntsc_entry_size = 2 * 16 };
+#if MD_NTSC_OUT_DEPTH == 32
+/* 32-bit entries whatever the size of long, so that the kernel sums can run in 32-bit lanes */
+typedef unsigned int md_ntsc_rgb_t;
+#else
 typedef unsigned long md_ntsc_rgb_t;
+#endif
 struct md_ntsc_t {
   md_ntsc_rgb_t table [md_ntsc_palette_size] [md_ntsc_entry_size];
 };
@@ -118,6 +123,9 @@ struct md_ntsc_t {
   ((n << 8 & 0x1C00) | (n & 0x0380) | (n >> 8 & 0x0070)) *\
   (md_ntsc_entry_size * sizeof (md_ntsc_rgb_t) / 16))
 
+#define MD_NTSC_RGB32( ntsc, n ) \
+  (ntsc)->table [(n >> 5 & 7) << 6 | (n >> 10 & 0x38) | (n >> 21 & 7)]
+
 /* common ntsc macros */
 #define md_ntsc_rgb_builder    ((1L << 21) | (1 << 11) | (1 << 1))
 #define md_ntsc_clamp_mask     (md_ntsc_rgb_builder * 3 / 2)
@@ -145,6 +153,11 @@ struct md_ntsc_t {
 #define MD_NTSC_RGB_OUT_( rgb_out, x ) {\
     rgb_out = (raw_>>(13-x)& 0xF800)|(raw_>>(8-x)&0x07E0)|(raw_>>(4-x)&0x001F);\
    }
+#elif MD_NTSC_OUT_DEPTH == 32
+/* ABGR (canvas byte order) */
+#define MD_NTSC_RGB_OUT_( rgb_out, x ) {\
+    rgb_out = 0xFF000000|(raw_<<(15+x)&0xFF0000)|(raw_>>(3-x)&0xFF00)|(raw_>>(21-x)&0x00FF);\
+   }
 #endif
 
 #ifdef __cplusplus
@@ -6,6 +6,9 @@
 /*  - added blip_mix_samples function (see blip_buf.h)              */
 /*  - added stereo buffer support (define #BLIP_MONO to disable)    */
 /*  - added inverted stereo output (define #BLIP_INVERT to enable)*/
+/*  - added vector blip_add_delta (WASM SIMD128, SSE4.1, NEON)      */
+/*  - added float output (blip_read_samples_f32)                    */
+/*  - added float mixed output (blip_mix_samples_f32)               */
 
 #include "blip_buf.h"
 
@@ -32,6 +35,46 @@ Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA */
 	#include "blargg_test.h"
 #endif
 
+/* Vector delta synthesis (see blip_add_delta) */
+#ifndef BLIP_MONO
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define BLIP_VEC
+typedef v128_t blip_vec_t;
+#define VEC_LOAD(p)     wasm_v128_load(p)
+#define VEC_STORE(p, v) wasm_v128_store(p, v)
+#define VEC_SPLAT(n)    wasm_i32x4_splat(n)
+#define VEC_ADD(a, b)   wasm_i32x4_add(a, b)
+#define VEC_MUL(a, b)   wasm_i32x4_mul(a, b)
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#define BLIP_VEC
+typedef __m128i blip_vec_t;
+#define VEC_LOAD(p)     _mm_loadu_si128((const __m128i *)(p))
+#define VEC_STORE(p, v) _mm_storeu_si128((__m128i *)(p), v)
+#define VEC_SPLAT(n)    _mm_set1_epi32(n)
+#define VEC_ADD(a, b)   _mm_add_epi32(a, b)
+#define VEC_MUL(a, b)   _mm_mullo_epi32(a, b)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BLIP_VEC
+typedef int32x4_t blip_vec_t;
+#define VEC_LOAD(p)     vld1q_s32(p)
+#define VEC_STORE(p, v) vst1q_s32(p, v)
+#define VEC_SPLAT(n)    vdupq_n_s32(n)
+#define VEC_ADD(a, b)   vaddq_s32(a, b)
+#define VEC_MUL(a, b)   vmulq_s32(a, b)
+#endif
+
+#ifdef BLIP_VEC
+/* taps i..i+3 of delta (k1 * d1 + k2 * d2) */
+#define VEC_TAPS( k1, k2, d1, d2, i ) \
+  VEC_ADD( VEC_MUL( VEC_LOAD( (k1) + (i) ), d1 ), VEC_MUL( VEC_LOAD( (k2) + (i) ), d2 ) )
+#define VEC_ACC( out, v, i ) \
+  VEC_STORE( (out) + (i), VEC_ADD( VEC_LOAD( (out) + (i) ), v ) )
+#endif
+#endif
+
 /* Equivalent to ULONG_MAX >= 0xFFFFFFFF00000000.
 Avoids constants that don't fit in 32 bits. */
 #if ULONG_MAX/0xFFFFFFFF > 0xFFFFFFFF
@@ -84,11 +127,21 @@ struct blip_t
 #endif
 };
 
+#ifdef BLIP_VEC
+static void init_kernel( void );
+#endif
+
 #ifdef BLIP_MONO
 /* probably not totally portable */
 #define SAMPLES( blip ) ((buf_t*) ((blip) + 1))
 #endif
 
+#if defined(__GNUC__)
+#define BLIP_INLINE static __inline__ __attribute__((always_inline))
+#else
+#define BLIP_INLINE static
+#endif
+
 /* Arithmetic (sign-preserving) right shift */
 #define ARITH_SHIFT( n, shift ) \
 	((n) >> (shift))
@@ -149,6 +202,9 @@ blip_t* blip_new( int size )
       blip_delete(m);
       return 0;
     }
+#endif
+#ifdef BLIP_VEC
+    init_kernel();
 #endif
 		m->factor = time_unit / blip_max_ratio;
 		m->size   = size;
@@ -328,6 +384,61 @@ int blip_read_samples( blip_t* m, short out [], int count)
 	return count;
 }
 
+#ifndef BLIP_MONO
+int blip_read_samples_f32( blip_t* m, float out_l [], float out_r [], int count)
+{
+#ifdef BLIP_ASSERT
+  assert( count >= 0 );
+
+  if ( count > (m->offset >> time_bits) )
+    count = m->offset >> time_bits;
+
+  if ( count )
+#endif
+  {
+    float const scale = 1.0f / 32768.0f;
+    buf_t const* in = m->buffer[0];
+    buf_t const* in2 = m->buffer[1];
+    buf_t const* end = in + count;
+    int sum = m->integrator[0];
+    int sum2 = m->integrator[1];
+    do
+    {
+      /* Eliminate fraction */
+      int s = ARITH_SHIFT( sum, delta_bits );
+
+      sum += *in++;
+
+      CLAMP( s );
+
+      *out_l++ = s * scale;
+
+      /* High-pass filter */
+      sum -= s << (delta_bits - bass_shift);
+
+      /* Eliminate fraction */
+      s = ARITH_SHIFT( sum2, delta_bits );
+
+      sum2 += *in2++;
+
+      CLAMP( s );
+
+      *out_r++ = s * scale;
+
+      /* High-pass filter */
+      sum2 -= s << (delta_bits - bass_shift);
+    }
+    while ( in != end );
+
+    m->integrator[0] = sum;
+    m->integrator[1] = sum2;
+    remove_samples( m, count );
+  }
+
+  return count;
+}
+#endif
+
 int blip_mix_samples( blip_t* m1, blip_t* m2, blip_t* m3, short out [], int count)
 {
 #ifdef BLIP_ASSERT
@@ -411,6 +522,79 @@ int blip_mix_samples( blip_t* m1, blip_t* m2, blip_t* m3, short out [], int coun
   return count;
 }
 
+#ifndef BLIP_MONO
+int blip_mix_samples_f32( blip_t* m1, blip_t* m2, blip_t* m3, float out_l [], float out_r [], int count)
+{
+#ifdef BLIP_ASSERT
+  assert( count >= 0 );
+
+  if ( count > (m1->offset >> time_bits) )
+    count = m1->offset >> time_bits;
+  if ( count > (m2->offset >> time_bits) )
+    count = m2->offset >> time_bits;
+  if ( count > (m3->offset >> time_bits) )
+    count = m3->offset >> time_bits;
+
+  if ( count )
+#endif
+  {
+    float const scale = 1.0f / 32768.0f;
+    buf_t const* in[3];
+    buf_t const* in2[3];
+    buf_t const* end;
+    int sum = m1->integrator[0];
+    int sum2 = m1->integrator[1];
+    in[0] = m1->buffer[0];
+    in[1] = m2->buffer[0];
+    in[2] = m3->buffer[0];
+    in2[0] = m1->buffer[1];
+    in2[1] = m2->buffer[1];
+    in2[2] = m3->buffer[1];
+
+    end = in[0] + count;
+    do
+    {
+      /* Eliminate fraction */
+      int s = ARITH_SHIFT( sum, delta_bits );
+
+      sum += *in[0]++;
+      sum += *in[1]++;
+      sum += *in[2]++;
+
+      CLAMP( s );
+
+      *out_l++ = s * scale;
+
+      /* High-pass filter */
+      sum -= s << (delta_bits - bass_shift);
+
+      /* Eliminate fraction */
+      s = ARITH_SHIFT( sum2, delta_bits );
+
+      sum2 += *in2[0]++;
+      sum2 += *in2[1]++;
+      sum2 += *in2[2]++;
+
+      CLAMP( s );
+
+      *out_r++ = s * scale;
+
+      /* High-pass filter */
+      sum2 -= s << (delta_bits - bass_shift);
+    }
+    while ( in[0] != end );
+
+    m1->integrator[0] = sum;
+    m1->integrator[1] = sum2;
+    remove_samples( m1, count );
+    remove_samples( m2, count );
+    remove_samples( m3, count );
+  }
+
+  return count;
+}
+#endif
+
 /* Things that didn't help performance on x86:
 	__attribute__((aligned(128)))
 	#define short int
@@ -462,14 +646,50 @@ simply ignoring the low half. */
 
 #ifndef BLIP_MONO
 
-void blip_add_delta( blip_t* m, unsigned time, int delta_l, int delta_r )
+#ifdef BLIP_VEC
+/* bl_step rearranged so that the 16 taps of a phase are two straight rows
+(row 0 applied to delta - delta*interp, row 1 to delta*interp, the reversed
+half unrolled) and blip_add_delta() can use 4 x 32-bit vector multiply-adds.
+Same products as the bl_step indexing, so the output is unchanged. */
+static int bl_kernel [phase_count] [2] [half_width*2];
+static int bl_kernel_init;
+
+static void init_kernel( void )
+{
+  int phase, i;
+
+  if (bl_kernel_init)
+    return;
+
+  for (phase = 0; phase < phase_count; phase++)
+  {
+    for (i = 0; i < half_width; i++)
+    {
+      bl_kernel[phase][0][i] = bl_step[phase][i];
+      bl_kernel[phase][1][i] = bl_step[phase + 1][i];
+      bl_kernel[phase][0][half_width*2-1-i] = bl_step[phase_count - phase][i];
+      bl_kernel[phase][1][half_width*2-1-i] = bl_step[phase_count - phase - 1][i];
+    }
+  }
+
+  bl_kernel_init = 1;
+}
+#endif
+
+/* Stereo deltas at fixed point time t (time * m->factor + m->offset) */
+BLIP_INLINE void add_delta( blip_t* m, fixed_t t, int delta_l, int delta_r )
 {
   if (delta_l | delta_r)
   {
-    unsigned fixed = (unsigned) ((time * m->factor + m->offset) >> pre_shift);
+    unsigned fixed = (unsigned) (t >> pre_shift);
     int phase = fixed >> phase_shift & (phase_count - 1);
+#ifdef BLIP_VEC
+    int const* k1 = bl_kernel [phase] [0];
+    int const* k2 = bl_kernel [phase] [1];
+#else
     short const* in  = bl_step [phase];
     short const* rev = bl_step [phase_count - phase];
+#endif
     int interp = fixed >> (phase_shift - delta_bits) & (delta_unit - 1);
     int pos = fixed >> frac_bits;
 
@@ -488,6 +708,45 @@ void blip_add_delta( blip_t* m, unsigned time, int delta_l, int delta_r )
     assert( pos <= m->size + end_frame_extra );
 #endif
 
+#ifdef BLIP_VEC
+    if (delta_l == delta_r)
+    {
+      blip_vec_t d1, d2, v;
+      delta = (delta_l * interp) >> delta_bits;
+      d1 = VEC_SPLAT(delta_l - delta);
+      d2 = VEC_SPLAT(delta);
+      v = VEC_TAPS(k1, k2, d1, d2, 0);
+      VEC_ACC(out_l, v, 0);
+      VEC_ACC(out_r, v, 0);
+      v = VEC_TAPS(k1, k2, d1, d2, 4);
+      VEC_ACC(out_l, v, 4);
+      VEC_ACC(out_r, v, 4);
+      v = VEC_TAPS(k1, k2, d1, d2, 8);
+      VEC_ACC(out_l, v, 8);
+      VEC_ACC(out_r, v, 8);
+      v = VEC_TAPS(k1, k2, d1, d2, 12);
+      VEC_ACC(out_l, v, 12);
+      VEC_ACC(out_r, v, 12);
+    }
+    else
+    {
+      blip_vec_t l1, l2, r1, r2;
+      delta = (delta_l * interp) >> delta_bits;
+      l1 = VEC_SPLAT(delta_l - delta);
+      l2 = VEC_SPLAT(delta);
+      delta = (delta_r * interp) >> delta_bits;
+      r1 = VEC_SPLAT(delta_r - delta);
+      r2 = VEC_SPLAT(delta);
+      VEC_ACC(out_l, VEC_TAPS(k1, k2, l1, l2, 0), 0);
+      VEC_ACC(out_l, VEC_TAPS(k1, k2, l1, l2, 4), 4);
+      VEC_ACC(out_l, VEC_TAPS(k1, k2, l1, l2, 8), 8);
+      VEC_ACC(out_l, VEC_TAPS(k1, k2, l1, l2, 12), 12);
+      VEC_ACC(out_r, VEC_TAPS(k1, k2, r1, r2, 0), 0);
+      VEC_ACC(out_r, VEC_TAPS(k1, k2, r1, r2, 4), 4);
+      VEC_ACC(out_r, VEC_TAPS(k1, k2, r1, r2, 8), 8);
+      VEC_ACC(out_r, VEC_TAPS(k1, k2, r1, r2, 12), 12);
+    }
+#else
     if (delta_l == delta_r)
     {
       buf_t out;
@@ -582,14 +841,15 @@ void blip_add_delta( blip_t* m, unsigned time, int delta_l, int delta_r )
       out_r [14] += rev[1]*delta_r + rev[1-half_width]*delta;
       out_r [15] += rev[0]*delta_r + rev[0-half_width]*delta;
     }
+#endif
   }
 }
 
-void blip_add_delta_fast( blip_t* m, unsigned time, int delta_l, int delta_r )
+BLIP_INLINE void add_delta_fast( blip_t* m, fixed_t t, int delta_l, int delta_r )
 {
   if (delta_l | delta_r)
   {
-    unsigned fixed = (unsigned) ((time * m->factor + m->offset) >> pre_shift);
+    unsigned fixed = (unsigned) (t >> pre_shift);
     int interp = fixed >> (frac_bits - delta_bits) & (delta_unit - 1);
     int pos = fixed >> frac_bits;
 
@@ -627,6 +887,71 @@ void blip_add_delta_fast( blip_t* m, unsigned time, int delta_l, int delta_r )
   }
 }
 
+void blip_add_delta( blip_t* m, unsigned time, int delta_l, int delta_r )
+{
+  add_delta( m, time * m->factor + m->offset, delta_l, delta_r );
+}
+
+void blip_add_delta_fast( blip_t* m, unsigned time, int delta_l, int delta_r )
+{
+  add_delta_fast( m, time * m->factor + m->offset, delta_l, delta_r );
+}
+
+/* Fixed point time steps are added up, which gives the same times as
+time * m->factor + m->offset for each delta */
+
+void blip_add_square( blip_t* m, unsigned time, unsigned period, int count, int delta_l, int delta_r )
+{
+  fixed_t t = time * m->factor + m->offset;
+  fixed_t step = period * m->factor;
+
+  for (; count > 0; count--, t += step)
+  {
+    add_delta( m, t, delta_l, delta_r );
+    delta_l = -delta_l;
+    delta_r = -delta_r;
+  }
+}
+
+void blip_add_square_fast( blip_t* m, unsigned time, unsigned period, int count, int delta_l, int delta_r )
+{
+  fixed_t t = time * m->factor + m->offset;
+  fixed_t step = period * m->factor;
+
+  for (; count > 0; count--, t += step)
+  {
+    add_delta_fast( m, t, delta_l, delta_r );
+    delta_l = -delta_l;
+    delta_r = -delta_r;
+  }
+}
+
+void blip_add_steps( blip_t* m, unsigned time, unsigned period, signed char const steps [], int count, int delta_l, int delta_r )
+{
+  fixed_t t = time * m->factor + m->offset;
+  fixed_t step = period * m->factor;
+  int i;
+
+  for (i = 0; i < count; i++, t += step)
+  {
+    if (steps[i])
+      add_delta( m, t, steps[i] * delta_l, steps[i] * delta_r );
+  }
+}
+
+void blip_add_steps_fast( blip_t* m, unsigned time, unsigned period, signed char const steps [], int count, int delta_l, int delta_r )
+{
+  fixed_t t = time * m->factor + m->offset;
+  fixed_t step = period * m->factor;
+  int i;
+
+  for (i = 0; i < count; i++, t += step)
+  {
+    if (steps[i])
+      add_delta_fast( m, t, steps[i] * delta_l, steps[i] * delta_r );
+  }
+}
+
 #else
 
 void blip_add_delta( blip_t* m, unsigned time, int delta )
@@ -36,6 +36,15 @@ void blip_add_delta( blip_t*, unsigned time, int delta_l, int delta_r );
 /** Same as blip_add_delta(), but uses faster, lower-quality synthesis. */
 void blip_add_delta_fast( blip_t*, unsigned int clock_time, int delta_l, int delta_r );
 
+/** Adds 'count' deltas 'period' clocks apart from clock time 'time', alternately
++delta and -delta (a square wave starting with +delta). */
+void blip_add_square( blip_t*, unsigned int time, unsigned int period, int count, int delta_l, int delta_r );
+void blip_add_square_fast( blip_t*, unsigned int time, unsigned int period, int count, int delta_l, int delta_r );
+
+/** Adds steps[i] * delta at clock time time + i * period, for i < count. */
+void blip_add_steps( blip_t*, unsigned int time, unsigned int period, signed char const steps [], int count, int delta_l, int delta_r );
+void blip_add_steps_fast( blip_t*, unsigned int time, unsigned int period, signed char const steps [], int count, int delta_l, int delta_r );
+
 #else
 
 /** Adds positive/negative delta into buffer at specified clock time. */
@@ -68,9 +77,21 @@ element of 'out', allowing easy interleaving of two buffers into a stereo sample
 stream. Outputs 16-bit signed samples. Returns number of samples actually read.  */
 int blip_read_samples( blip_t*, short out [], int count);
 
+#ifndef BLIP_MONO
+/** Same as blip_read_samples(), but writes left and right samples to separate
+buffers as floats in [-1, 1). */
+int blip_read_samples_f32( blip_t*, float out_l [], float out_r [], int count);
+#endif
+
 /* Same as above function except sample is mixed from three blip buffers source */
 int blip_mix_samples( blip_t* m1, blip_t* m2, blip_t* m3, short out [], int count);
 
+#ifndef BLIP_MONO
+/* Same as blip_mix_samples(), but writes left and right samples to separate
+buffers as floats in [-1, 1) */
+int blip_mix_samples_f32( blip_t* m1, blip_t* m2, blip_t* m3, float out_l [], float out_r [], int count);
+#endif
+
 /** Frees buffer. No effect if NULL is passed. */
 void blip_delete( blip_t* );
 
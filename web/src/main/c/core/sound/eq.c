@@ -84,7 +84,7 @@ void init_3band_state(EQSTATE * es, int lowfreq, int highfreq, int mixfreq)
 // (especially the bass) so may require clipping before output, but you 
 // knew that anyway :)*/
 
-double do_3band(EQSTATE * es, int sample)
+double do_3band_float(EQSTATE * es, double sample)
 {
     /* Locals */
 
@@ -128,5 +128,10 @@ double do_3band(EQSTATE * es, int sample)
 
     /* Return result */
 
-    return (int) (l + m + h);
+    return l + m + h;
+}
+
+double do_3band(EQSTATE * es, int sample)
+{
+    return (int) do_3band_float(es, sample);
 }
@@ -63,5 +63,8 @@ extern void init_3band_state(EQSTATE * es, int lowfreq, int highfreq,
            int mixfreq);
 extern double do_3band(EQSTATE * es, int sample);
 
+/* Same as do_3band() for samples of any scale, without integer truncation */
+extern double do_3band_float(EQSTATE * es, double sample);
+
 
 #endif        /* #ifndef __EQ3BAND__ */
@@ -49,6 +49,9 @@
 /* maximal channel output (roughly adjusted to match VA4 MD1 PSG/FM balance with 1.5x amplification of PSG output) */
 #define PSG_MAX_VOLUME 2800
 
+/* noise channel transitions passed to the blip buffer at once */
+#define PSG_NOISE_BATCH 256
+
 static const uint8 noiseShiftWidth[2] = {14,15};
 
 static const uint8 noiseBitMask[2] = {0x6,0x9};
@@ -91,6 +94,9 @@ static struct
   int chanAmp[4][2];
 } psg;
 
+/* per-channel blip buffers (stem mode), NULL when channels are mixed */
+static blip_t **psg_stems;
+
 static void psg_update(unsigned int clocks);
 
 void psg_init(PSG_TYPE type)
@@ -158,28 +164,30 @@ int psg_context_save(uint8 *state)
 
 int psg_context_load(uint8 *state)
 {
-  int delta[2];
+  int delta[4][2];
   int i, bufferptr = 0;
 
   /* initialize delta with current noise channel output */
   if (psg.noiseShiftValue & 1)
   {
-    delta[0] = -psg.chanOut[3][0];
-    delta[1] = -psg.chanOut[3][1];
+    delta[3][0] = -psg.chanOut[3][0];
+    delta[3][1] = -psg.chanOut[3][1];
   }
   else
   {
-    delta[0] = 0;
-    delta[1] = 0;
+    delta[3][0] = 0;
+    delta[3][1] = 0;
   }
 
   /* add current tone channels output */
   for (i=0; i<3; i++)
   {
+    delta[i][0] = 0;
+    delta[i][1] = 0;
     if (psg.polarity[i] > 0)
     {
-      delta[0] -= psg.chanOut[i][0];
-      delta[1] -= psg.chanOut[i][1];
+      delta[i][0] -= psg.chanOut[i][0];
+      delta[i][1] -= psg.chanOut[i][1];
     }
   }
 
@@ -195,8 +203,8 @@ int psg_context_load(uint8 *state)
   /* add noise channel output variation */
   if (psg.noiseShiftValue & 1)
   {
-    delta[0] += psg.chanOut[3][0];
-    delta[1] += psg.chanOut[3][1];
+    delta[3][0] += psg.chanOut[3][0];
+    delta[3][1] += psg.chanOut[3][1];
   }
 
   /* add tone channels output variation */
@@ -204,19 +212,38 @@ int psg_context_load(uint8 *state)
   {
     if (psg.polarity[i] > 0)
     {
-      delta[0] += psg.chanOut[i][0];
-      delta[1] += psg.chanOut[i][1];
+      delta[i][0] += psg.chanOut[i][0];
+      delta[i][1] += psg.chanOut[i][1];
     }
   }
 
+  /* stem mode: update each channel output */
+  if (psg_stems)
+  {
+    for (i=0; i<4; i++)
+    {
+      if (config.hq_psg)
+      {
+        blip_add_delta(psg_stems[i], psg.clocks, delta[i][0], delta[i][1]);
+      }
+      else
+      {
+        blip_add_delta_fast(psg_stems[i], psg.clocks, delta[i][0], delta[i][1]);
+      }
+    }
+    return bufferptr;
+  }
+
   /* update mixed channels output */
+  delta[0][0] += delta[1][0] + delta[2][0] + delta[3][0];
+  delta[0][1] += delta[1][1] + delta[2][1] + delta[3][1];
   if (config.hq_psg)
   {
-    blip_add_delta(snd.blips[0], psg.clocks, delta[0], delta[1]);
+    blip_add_delta(snd.blips[0], psg.clocks, delta[0][0], delta[0][1]);
   }
   else
   {
-    blip_add_delta_fast(snd.blips[0], psg.clocks, delta[0], delta[1]);
+    blip_add_delta_fast(snd.blips[0], psg.clocks, delta[0][0], delta[0][1]);
   }
 
   return bufferptr;
@@ -226,6 +253,11 @@ void psg_write(unsigned int clocks, unsigned int data)
 {
   int index;
 
+#ifdef WASM_GENPLUS
+  /* ChaosDrive: VGM capture */
+  { extern void capture_psg_write(unsigned int clocks, unsigned int data); capture_psg_write(clocks, data); }
+#endif
+
   /* PSG chip synchronization */
   if (clocks > psg.clocks)
   {
@@ -452,23 +484,46 @@ void psg_end_frame(unsigned int clocks)
   }
 }
 
+void psg_set_stems(blip_t **blips)
+{
+  psg_stems = blips;
+}
+
+int psg_level(void)
+{
+  int i, energy = 0;
+
+  /* channels output is either 0 or their volume (50% duty cycle square wave or noise): */
+  /* RMS is about half the volume per channel, channel powers add up                   */
+  for (i=0; i<4; i++)
+  {
+    energy += psg.chanOut[i][0] * psg.chanOut[i][0] + psg.chanOut[i][1] * psg.chanOut[i][1];
+  }
+
+  /* average of both stereo channels */
+  return (int)sqrt(energy / 8);
+}
+
 static void psg_update(unsigned int clocks)
 {
   int i, timestamp, polarity;
 
   for (i=0; i<4; i++)
   {
+    /* channel output buffer */
+    blip_t *out = psg_stems ? psg_stems[i] : snd.blips[0];
+
     /* apply any pending channel volume variations */
     if (psg.chanDelta[i][0] | psg.chanDelta[i][1])
     {
       /* update channel output */
       if (config.hq_psg)
       {
-        blip_add_delta(snd.blips[0], psg.clocks, psg.chanDelta[i][0], psg.chanDelta[i][1]);
+        blip_add_delta(out, psg.clocks, psg.chanDelta[i][0], psg.chanDelta[i][1]);
       }
       else
       {
-        blip_add_delta_fast(snd.blips[0], psg.clocks, psg.chanDelta[i][0], psg.chanDelta[i][1]);
+        blip_add_delta_fast(out, psg.clocks, psg.chanDelta[i][0], psg.chanDelta[i][1]);
       }
 
       /* clear pending channel volume variations */
@@ -486,23 +541,32 @@ static void psg_update(unsigned int clocks)
     if (i < 3)
     {
       /* process all transitions occurring until current clock timestamp */
-      while (timestamp < clocks)
+      if (timestamp < clocks)
       {
-        /* invert tone generator polarity */
-        polarity = -polarity;
+        /* number of transitions */
+        int count = (clocks - timestamp + psg.freqInc[i] - 1) / psg.freqInc[i];
 
-        /* update channel output */
-        if (config.hq_psg)
+        /* update channel output (nothing to add when channel is muted) */
+        if (psg.chanOut[i][0] | psg.chanOut[i][1])
         {
-          blip_add_delta(snd.blips[0], timestamp, polarity*psg.chanOut[i][0], polarity*psg.chanOut[i][1]);
+          if (config.hq_psg)
+          {
+            blip_add_square(out, timestamp, psg.freqInc[i], count, -polarity*psg.chanOut[i][0], -polarity*psg.chanOut[i][1]);
+          }
+          else
+          {
+            blip_add_square_fast(out, timestamp, psg.freqInc[i], count, -polarity*psg.chanOut[i][0], -polarity*psg.chanOut[i][1]);
+          }
         }
-        else
+
+        /* tone generator polarity is inverted at each transition */
+        if (count & 1)
         {
-          blip_add_delta_fast(snd.blips[0], timestamp, polarity*psg.chanOut[i][0], polarity*psg.chanOut[i][1]);
+          polarity = -polarity;
         }
 
         /* timestamp of next transition */
-        timestamp += psg.freqInc[i];
+        timestamp += count * psg.freqInc[i];
       }
     }
 
@@ -512,48 +576,65 @@ static void psg_update(unsigned int clocks)
       /* current noise shift register value */
       int shiftValue = psg.noiseShiftValue;
 
-      /* process all transitions occurring until current clock timestamp */
+      /* noise channel output variations, one per transition */
+      signed char steps[PSG_NOISE_BATCH];
+
+      /* process all transitions occurring until current clock timestamp, in batches */
       while (timestamp < clocks)
       {
-        /* invert noise generator polarity */
-        polarity = -polarity;
+        int start = timestamp;
+        int count = 0;
 
-        /* noise register is shifted on positive edge only */
-        if (polarity > 0)
+        do
         {
-          /* current shift register output */
-          int shiftOutput = shiftValue & 0x01;
+          /* invert noise generator polarity */
+          polarity = -polarity;
 
-          /* White noise (-----1xx) */
-          if (psg.regs[6] & 0x04)
+          /* noise register is shifted on positive edge only */
+          if (polarity > 0)
           {
-            /* shift and apply XOR feedback network */
-            shiftValue = (shiftValue >> 1) | (noiseFeedback[shiftValue & psg.noiseBitMask] << psg.noiseShiftWidth);
+            /* current shift register output */
+            int shiftOutput = shiftValue & 0x01;
+
+            /* White noise (-----1xx) */
+            if (psg.regs[6] & 0x04)
+            {
+              /* shift and apply XOR feedback network */
+              shiftValue = (shiftValue >> 1) | (noiseFeedback[shiftValue & psg.noiseBitMask] << psg.noiseShiftWidth);
+            }
+
+            /* Periodic noise (-----0xx) */
+            else
+            {
+              /* shift and feedback current output */
+              shiftValue = (shiftValue >> 1) | (shiftOutput << psg.noiseShiftWidth);
+            }
+
+            /* shift register output variation */
+            steps[count] = (shiftValue & 0x1) - shiftOutput;
           }
-
-          /* Periodic noise (-----0xx) */
           else
           {
-            /* shift and feedback current output */
-            shiftValue = (shiftValue >> 1) | (shiftOutput << psg.noiseShiftWidth);
+            steps[count] = 0;
           }
 
-          /* shift register output variation */
-          shiftOutput = (shiftValue & 0x1) - shiftOutput;
+          /* timestamp of next transition */
+          timestamp += psg.freqInc[3];
+        }
+        while ((++count < PSG_NOISE_BATCH) && (timestamp < clocks));
 
-          /* update noise channel output */
+        /* update noise channel output (nothing to add when channel is muted) */
+        if (psg.chanOut[3][0] | psg.chanOut[3][1])
+        {
           if (config.hq_psg)
           {
-            blip_add_delta(snd.blips[0], timestamp, shiftOutput*psg.chanOut[3][0], shiftOutput*psg.chanOut[3][1]);
+            blip_add_steps(out, start, psg.freqInc[3], steps, count, psg.chanOut[3][0], psg.chanOut[3][1]);
           }
           else
           {
-            blip_add_delta_fast(snd.blips[0], timestamp, shiftOutput*psg.chanOut[3][0], shiftOutput*psg.chanOut[3][1]);
+            blip_add_steps_fast(out, start, psg.freqInc[3], steps, count, psg.chanOut[3][0], psg.chanOut[3][1]);
           }
         }
-
-        /* timestamp of next transition */
-        timestamp += psg.freqInc[3];
       }
 
       /* save shift register value */
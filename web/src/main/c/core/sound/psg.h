@@ -56,5 +56,7 @@ extern int psg_context_load(uint8 *state);
 extern void psg_write(unsigned int clocks, unsigned int data);
 extern void psg_config(unsigned int clocks, unsigned int preamp, unsigned int panning);
 extern void psg_end_frame(unsigned int clocks);
+extern int psg_level(void);
+extern void psg_set_stems(blip_t **blips);
 
 #endif /* _PSG_H_ */
@@ -53,6 +53,26 @@ static int fm_buffer[1080 * 2];
 static int fm_last[2];
 static int *fm_ptr;
 
+/* Chip output levels */
+t_sound_meter sound_meter;
+
+/* YM2612 register writes seen by the meter (DAC samples, key on) */
+static unsigned int meter_address;
+static int meter_dac_enabled;
+static int meter_dac_energy;
+static int meter_dac_count;
+static int meter_key_on;
+static uint8 meter_keys[6];
+
+/* Stem mode (allocated only while enabled) */
+t_sound_stems sound_stems;
+static int stems_enabled;
+static int stems_size;          /* blip buffers & stem outputs size, in samples */
+static double stems_clock_rate;
+static int stems_sample_rate;
+static int *stems_fm_buffer;    /* FM channels output of the frame (YM2612_STEMS pairs per sample) */
+static int stems_fm_last[YM2612_STEMS][2];
+
 /* Cycle-accurate FM samples */
 static int fm_cycles_ratio;
 static int fm_cycles_start;
@@ -99,6 +119,337 @@ INLINE void fm_update(int cycles)
   }
 }
 
+/* Meter YM2612 port writes (register address is latched like on the chip) */
+INLINE void meter_write(unsigned int a, unsigned int v)
+{
+  if (!(a & 1))
+  {
+    /* only port 0 registers are metered */
+    meter_address = (a & 2) ? 0x100 : v;
+    return;
+  }
+
+  switch (meter_address)
+  {
+    case 0x28:  /* key on / off */
+    {
+      int ch = v & 3;
+      if (ch != 3)
+      {
+        if (v & 4) ch += 3;
+
+        /* any operator going from off to on */
+        if ((v >> 4) & ~meter_keys[ch])
+        {
+          meter_key_on |= (1 << ch);
+        }
+        meter_keys[ch] = v >> 4;
+      }
+      break;
+    }
+
+    case 0x2a:  /* DAC data (8-bit unsigned) */
+    {
+      if (meter_dac_enabled)
+      {
+        int sample = (int)v - 0x80;
+        meter_dac_energy += sample * sample;
+        meter_dac_count++;
+      }
+      break;
+    }
+
+    case 0x2b:  /* DAC enable */
+    {
+      meter_dac_enabled = v & 0x80;
+      break;
+    }
+  }
+}
+
+/* Update chip output levels from the frame FM samples */
+static void meter_update(const int *buffer, int length)
+{
+  double energy = 0.0;
+  int i;
+
+  for (i = 0; i < length; i++)
+  {
+    energy += (double)buffer[i] * buffer[i];
+  }
+
+  /* FM output RMS (both stereo channels) */
+  sound_meter.fm = length ? (int)((sqrt(energy / length) * config.fm_preamp) / 100) : 0;
+
+  /* DAC samples RMS, converted to 14-bit DAC output */
+  sound_meter.dac = meter_dac_count ? (int)((sqrt((double)meter_dac_energy / meter_dac_count) * 64 * config.fm_preamp) / 100) : 0;
+  sound_meter.dac_writes = meter_dac_count;
+  meter_dac_energy = 0;
+  meter_dac_count = 0;
+
+  sound_meter.key_on = meter_key_on;
+  meter_key_on = 0;
+}
+
+static void stems_free(void)
+{
+  int i;
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    blip_delete(sound_stems.blips[i]);
+    free(sound_stems.out[i][0]);
+    sound_stems.blips[i] = 0;
+    sound_stems.out[i][0] = sound_stems.out[i][1] = 0;
+  }
+
+  free(stems_fm_buffer);
+  stems_fm_buffer = 0;
+  stems_size = 0;
+}
+
+static int stems_alloc(int size)
+{
+  int i;
+
+  stems_free();
+
+  /* MAME YM2612 core: up to 1080 samples per frame, as fm_buffer */
+  stems_fm_buffer = malloc(sizeof(int) * 1080 * 2 * YM2612_STEMS);
+  if (!stems_fm_buffer)
+  {
+    return 0;
+  }
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    sound_stems.blips[i] = blip_new(size);
+    sound_stems.out[i][0] = malloc(sizeof(float) * size * 2);
+    if (!sound_stems.blips[i] || !sound_stems.out[i][0])
+    {
+      stems_free();
+      return 0;
+    }
+    sound_stems.out[i][1] = sound_stems.out[i][0] + size;
+    blip_set_rates(sound_stems.blips[i], stems_clock_rate, stems_sample_rate);
+  }
+
+  stems_size = size;
+  return 1;
+}
+
+/* route chips output to the stems or to the mixed buffer */
+static void stems_attach(void)
+{
+  /* per-channel FM output is only available from the MAME YM2612 core, Mega CD mixes blips[0] with PCM & CD-DA */
+  int supported = (system_hw != SYSTEM_MCD) && (!YM_Update || (YM_Update == YM2612Update));
+
+  sound_stems.active = stems_enabled && stems_size && supported;
+  YM2612SetStems(sound_stems.active ? stems_fm_buffer : NULL);
+  psg_set_stems(sound_stems.active ? &sound_stems.blips[SOUND_STEM_PSG] : NULL);
+}
+
+/* FM channels output of the frame to the stems, returns the number of samples */
+static int stems_fm_flush(int time, unsigned int cycles, int preamp)
+{
+  int i, count = 0;
+
+  for (i = 0; i < YM2612_STEMS; i++)
+  {
+    blip_t *blip = sound_stems.blips[SOUND_STEM_FM + i];
+    int *ptr = stems_fm_buffer + (i * 2);
+    int prev_l = stems_fm_last[i][0];
+    int prev_r = stems_fm_last[i][1];
+    int t = time;
+    int l, r;
+
+    count = 0;
+    do
+    {
+      l = ((ptr[0] * preamp) / 100);
+      r = ((ptr[1] * preamp) / 100);
+      if (config.hq_fm)
+      {
+        blip_add_delta(blip, t, l-prev_l, r-prev_r);
+      }
+      else
+      {
+        blip_add_delta_fast(blip, t, l-prev_l, r-prev_r);
+      }
+      prev_l = l;
+      prev_r = r;
+      ptr += YM2612_STEMS * 2;
+      t += fm_cycles_ratio;
+      count++;
+    }
+    while (t < cycles);
+
+    stems_fm_last[i][0] = prev_l;
+    stems_fm_last[i][1] = prev_r;
+  }
+
+  /* rewind FM channels output for next frame */
+  YM2612SetStems(stems_fm_buffer);
+
+  return count;
+}
+
+/* Enable or disable stem mode (between frames); returns 1 when stems are generated */
+int sound_stems_enable(int enabled)
+{
+  int i;
+
+  /* already running: keep the gains and the buffered samples */
+  if (enabled && stems_enabled)
+  {
+    return sound_stems.active;
+  }
+
+  stems_enabled = enabled;
+
+  if (!enabled)
+  {
+    stems_free();
+  }
+  else if (!stems_size && snd.sample_rate)
+  {
+    stems_alloc(snd.sample_rate / 10);
+  }
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    sound_stems.gain[i] = 1.0f;
+  }
+
+  /* outputs restart from silence (a single click, the blip high-pass removes the DC offset) */
+  if (snd.blips[0])
+  {
+    blip_clear(snd.blips[0]);
+  }
+  fm_last[0] = fm_last[1] = 0;
+  sound_stems_clear();
+
+  stems_attach();
+  return sound_stems.active;
+}
+
+void sound_stems_set_rates(double clock_rate, int sample_rate)
+{
+  int i;
+
+  stems_clock_rate = clock_rate;
+  stems_sample_rate = sample_rate;
+
+  if (!stems_enabled)
+  {
+    return;
+  }
+
+  /* output rate increased: buffers are reallocated */
+  if (stems_size < sample_rate / 10)
+  {
+    stems_alloc(sample_rate / 10);
+    stems_attach();
+    return;
+  }
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    blip_set_rates(sound_stems.blips[i], clock_rate, sample_rate);
+  }
+}
+
+void sound_stems_clear(void)
+{
+  int i;
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    if (sound_stems.blips[i])
+    {
+      blip_clear(sound_stems.blips[i]);
+    }
+  }
+
+  memset(stems_fm_last, 0, sizeof(stems_fm_last));
+}
+
+/* resample each stem to its output buffer, returns the samples read (same for all stems) */
+static int stems_read(int count)
+{
+  int i, read = count;
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    int n = blip_read_samples_f32(sound_stems.blips[i], sound_stems.out[i][0], sound_stems.out[i][1], count);
+    if (n < read) read = n;
+  }
+
+  return read;
+}
+
+/* resample the stems and mix them with their gains, as float samples */
+void sound_stems_read_f32(float *out_l, float *out_r, int count)
+{
+  int i, j;
+
+  count = stems_read(count);
+
+  memset(out_l, 0, count * sizeof(float));
+  memset(out_r, 0, count * sizeof(float));
+
+  for (i = 0; i < SOUND_STEMS; i++)
+  {
+    const float gain = sound_stems.gain[i];
+    const float *l = sound_stems.out[i][0];
+    const float *r = sound_stems.out[i][1];
+
+    if (gain == 0.0f)
+    {
+      continue;
+    }
+
+    for (j = 0; j < count; j++)
+    {
+      out_l[j] += l[j] * gain;
+      out_r[j] += r[j] * gain;
+    }
+  }
+
+  /* clipping (16-bit range), as the mixed blip buffer */
+  for (j = 0; j < count; j++)
+  {
+    if (out_l[j] > 32767.0f / 32768.0f) out_l[j] = 32767.0f / 32768.0f;
+    else if (out_l[j] < -1.0f) out_l[j] = -1.0f;
+    if (out_r[j] > 32767.0f / 32768.0f) out_r[j] = 32767.0f / 32768.0f;
+    else if (out_r[j] < -1.0f) out_r[j] = -1.0f;
+  }
+}
+
+/* resample the stems and mix them with their gains, as interleaved 16-bit samples */
+void sound_stems_read(int16 *buffer, int count)
+{
+  int i, j;
+
+  count = stems_read(count);
+
+  for (j = 0; j < count; j++)
+  {
+    float l = 0.0f, r = 0.0f;
+
+    for (i = 0; i < SOUND_STEMS; i++)
+    {
+      l += sound_stems.out[i][0][j] * sound_stems.gain[i];
+      r += sound_stems.out[i][1][j] * sound_stems.gain[i];
+    }
+
+    l *= 32768.0f;
+    r *= 32768.0f;
+    *buffer++ = (l > 32767.0f) ? 32767 : ((l < -32768.0f) ? -32768 : (int16)l);
+    *buffer++ = (r > 32767.0f) ? 32767 : ((r < -32768.0f) ? -32768 : (int16)r);
+  }
+}
+
 static void YM2612_Reset(unsigned int cycles)
 {
   /* synchronize FM chip with CPU */
@@ -111,6 +462,11 @@ static void YM2612_Reset(unsigned int cycles)
 
 static void YM2612_Write(unsigned int cycles, unsigned int a, unsigned int v)
 {
+#ifdef WASM_GENPLUS
+  /* ChaosDrive: VGM capture */
+  { extern void capture_fm_write(unsigned int cycles, unsigned int a, unsigned int v); capture_fm_write(cycles, a, v); }
+#endif
+
   /* detect DATA port write */
   if (a & 1)
   {
@@ -126,6 +482,7 @@ static void YM2612_Write(unsigned int cycles, unsigned int a, unsigned int v)
 
   /* write FM register */
   YM2612Write(a, v);
+  meter_write(a, v);
 }
 
 static unsigned int YM2612_Read(unsigned int cycles, unsigned int a)
@@ -214,11 +571,17 @@ static void YM3438_Reset(unsigned int cycles)
 
 static void YM3438_Write(unsigned int cycles, unsigned int a, unsigned int v)
 {
+#ifdef WASM_GENPLUS
+  /* ChaosDrive: VGM capture */
+  { extern void capture_fm_write(unsigned int cycles, unsigned int a, unsigned int v); capture_fm_write(cycles, a, v); }
+#endif
+
   /* synchronize FM chip with CPU */
   fm_update(cycles);
 
   /* write FM register */
   OPN2_Write(&ym3438, a, v);
+  meter_write(a, v);
 }
 
 static unsigned int YM3438_Read(unsigned int cycles, unsigned int a)
@@ -284,41 +647,127 @@ static unsigned int OPLL2413_Read(unsigned int cycles, unsigned int a)
 
 #endif
 
-void sound_init( void )
+/* FM output buffer, for the memory report (memmap.h) */
+void sound_memory_report(void)
 {
-  /* Initialize FM chip */
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  memory_region("fm_buffer", fm_buffer, sizeof(fm_buffer));
+}
+
+/* YM2612 emulator selected by config.ym3438 */
+static void fm_select(void)
+{
+#ifdef HAVE_YM3438_CORE
+  if (config.ym3438)
   {
-    /* YM2612 */
+    /* Nuked OPN2 */
+    memset(&ym3438, 0, sizeof(ym3438));
+    memset(&ym3438_sample, 0, sizeof(ym3438_sample));
+    memset(&ym3438_accm, 0, sizeof(ym3438_accm));
+    ym3438_cycles = 0;
+    YM_Update = YM3438_Update;
+    fm_reset = YM3438_Reset;
+    fm_write = YM3438_Write;
+    fm_read = YM3438_Read;
+
+    /* chip is running at internal clock */
+    fm_cycles_ratio = YM2612_CLOCK_RATIO;
+  }
+  else
+#endif
+  {
+    /* MAME OPN2*/
+    YM2612Init();
+    YM2612Config(config.ym2612);
+    YM_Update = YM2612Update;
+    fm_reset = YM2612_Reset;
+    fm_write = YM2612_Write;
+    fm_read = YM2612_Read;
+
+    /* chip is running at sample clock */
+    fm_cycles_ratio = YM2612_CLOCK_RATIO * 24;
+  }
+}
+
 #ifdef HAVE_YM3438_CORE
-    if (config.ym3438)
+/* Register write to the chip being restored: Nuked OPN2 only latches a port
+   write on its next clock and applies it to the operator registers as its
+   slots come round, so it runs a busy period after each (output dropped) */
+static void fm_restore_write(int port, int reg, int value)
+{
+  int scratch[32 * 2];
+
+  if (config.ym3438)
+  {
+    OPN2_Write(&ym3438, port << 1, reg);
+    YM3438_Update(scratch, 2);
+    OPN2_Write(&ym3438, (port << 1) | 1, value);
+    YM3438_Update(scratch, 32);
+  }
+  else
+  {
+    YM2612Write(port << 1, reg);
+    YM2612Write((port << 1) | 1, value);
+  }
+}
+
+void sound_fm_switch(int ym3438, const uint8 *regs)
+{
+  int port, reg, ch;
+
+  if (((system_hw & SYSTEM_PBC) != SYSTEM_MD) || (config.ym3438 == ym3438))
+    return;
+
+  config.ym3438 = ym3438;
+  fm_select();
+  fm_reset(0);
+
+  /* timers and DAC, then channels with frequencies high byte first */
+  for (reg = 0x22; reg < 0x2C; reg++)
+  {
+    if ((reg != 0x23) && (reg != 0x28) && (reg != 0x29))
+      fm_restore_write(0, reg, regs[reg]);
+  }
+  for (port = 0; port < 2; port++)
+  {
+    for (reg = 0x30; reg < 0xB8; reg++)
     {
-      /* Nuked OPN2 */
-      memset(&ym3438, 0, sizeof(ym3438));
-      memset(&ym3438_sample, 0, sizeof(ym3438_sample));
-      memset(&ym3438_accm, 0, sizeof(ym3438_accm));
-      YM_Update = YM3438_Update;
-      fm_reset = YM3438_Reset;
-      fm_write = YM3438_Write;
-      fm_read = YM3438_Read;
+      if (((reg & 3) == 3) || ((reg >= 0xA0) && (reg < 0xB0)))
+        continue;
+      fm_restore_write(port, reg, regs[(port << 8) | reg]);
+    }
 
-      /* chip is running at internal clock */
-      fm_cycles_ratio = YM2612_CLOCK_RATIO;
+    /* the high byte is latched until the low byte is written */
+    for (reg = 0xA0; reg < 0xAB; reg++)
+    {
+      if ((reg & 3) == 3)
+        continue;
+      fm_restore_write(port, reg + 4, regs[(port << 8) | (reg + 4)]);
+      fm_restore_write(port, reg, regs[(port << 8) | reg]);
+      if (reg == 0xA2)
+        reg = 0xA7;
     }
-    else
+  }
+
+  /* notes being played */
+  for (ch = 0; ch < 6; ch++)
+  {
+    if (meter_keys[ch])
+      fm_restore_write(0, 0x28, (meter_keys[ch] << 4) | ((ch < 3) ? ch : (ch + 1)));
+  }
+
+  fm_cycles_start = fm_cycles_count = 0;
+  fm_cycles_busy = 0;
+  stems_attach();
+}
 #endif
-    {
-      /* MAME OPN2*/
-      YM2612Init();
-      YM2612Config(config.ym2612);
-      YM_Update = YM2612Update;
-      fm_reset = YM2612_Reset;
-      fm_write = YM2612_Write;
-      fm_read = YM2612_Read;
 
-      /* chip is running at sample clock */
-      fm_cycles_ratio = YM2612_CLOCK_RATIO * 24;
-    }
+void sound_init( void )
+{
+  /* Initialize FM chip */
+  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  {
+    /* YM2612 */
+    fm_select();
   }
   else
   {
@@ -355,6 +804,9 @@ void sound_init( void )
 
   /* Initialize PSG chip */
   psg_init((system_hw == SYSTEM_SG) ? PSG_DISCRETE : PSG_INTEGRATED);
+
+  /* FM chip may have changed */
+  stems_attach();
 }
 
 void sound_reset(void)
@@ -367,8 +819,19 @@ void sound_reset(void)
   /* reset FM buffer ouput */
   fm_last[0] = fm_last[1] = 0;
 
+  /* reset chip meter */
+  memset(&sound_meter, 0, sizeof(sound_meter));
+  memset(meter_keys, 0, sizeof(meter_keys));
+  meter_address = 0;
+  meter_dac_enabled = 0;
+  meter_dac_energy = 0;
+  meter_dac_count = 0;
+  meter_key_on = 0;
+
   /* reset FM buffer pointer */
   fm_ptr = fm_buffer;
+  stems_attach();
+  memset(stems_fm_last, 0, sizeof(stems_fm_last));
   
   /* reset FM cycle counters */
   fm_cycles_start = fm_cycles_count = 0;
@@ -378,6 +841,7 @@ int sound_update(unsigned int cycles)
 {
   /* Run PSG chip until end of frame */
   psg_end_frame(cycles);
+  sound_meter.psg = psg_level();
 
   /* FM chip is enabled ? */
   if (YM_Update)
@@ -401,7 +865,14 @@ int sound_update(unsigned int cycles)
     ptr = fm_buffer;
 
     /* flush FM samples */
-    if (config.hq_fm)
+    if (sound_stems.active)
+    {
+      /* stem mode: each channel to its own blip buffer */
+      int count = stems_fm_flush(time, cycles, preamp);
+      ptr += count * 2;
+      time += count * fm_cycles_ratio;
+    }
+    else if (config.hq_fm)
     {
       /* high-quality Band-Limited synthesis */
       do
@@ -436,6 +907,9 @@ int sound_update(unsigned int cycles)
       while (time < cycles);
     }
 
+    /* FM output levels of the frame */
+    meter_update(fm_buffer, ptr - fm_buffer);
+
     /* reset FM buffer pointer */
     fm_ptr = fm_buffer;
 
@@ -455,6 +929,21 @@ int sound_update(unsigned int cycles)
     }
   }
 
+  /* stem mode: blips[0] is not used */
+  if (sound_stems.active)
+  {
+    int i;
+
+    /* end of blip buffers time frame */
+    for (i = 0; i < SOUND_STEMS; i++)
+    {
+      blip_end_frame(sound_stems.blips[i], cycles);
+    }
+
+    /* return number of available samples */
+    return blip_samples_avail(sound_stems.blips[0]);
+  }
+
   /* end of blip buffer time frame */
   blip_end_frame(snd.blips[0], cycles);
 
@@ -462,7 +951,7 @@ int sound_update(unsigned int cycles)
   return blip_samples_avail(snd.blips[0]);
 }
 
-int sound_context_save(uint8 *state)
+int sound_fm_context_save(uint8 *state)
 {
   int bufferptr = 0;
   
@@ -504,6 +993,13 @@ int sound_context_save(uint8 *state)
     }
   }
 
+  return bufferptr;
+}
+
+int sound_context_save(uint8 *state)
+{
+  int bufferptr = sound_fm_context_save(state);
+
   bufferptr += psg_context_save(&state[bufferptr]);
 
   save_param(&fm_cycles_start,sizeof(fm_cycles_start));
@@ -511,7 +1007,7 @@ int sound_context_save(uint8 *state)
   return bufferptr;
 }
 
-int sound_context_load(uint8 *state)
+int sound_fm_context_load(uint8 *state)
 {
   int bufferptr = 0;
 
@@ -520,6 +1016,13 @@ int sound_context_load(uint8 *state)
 #ifdef HAVE_YM3438_CORE
     uint8 config_ym3438;
     load_param(&config_ym3438, sizeof(config_ym3438));
+    if (config_ym3438 != config.ym3438)
+    {
+      /* saved with the other emulator (switched since, see sound_fm_switch()) */
+      config.ym3438 = config_ym3438;
+      fm_select();
+      stems_attach();
+    }
     if (config_ym3438)
     {
       load_param(&ym3438, sizeof(ym3438));
@@ -555,6 +1058,13 @@ int sound_context_load(uint8 *state)
     }
   }
 
+  return bufferptr;
+}
+
+int sound_context_load(uint8 *state)
+{
+  int bufferptr = sound_fm_context_load(state);
+
   bufferptr += psg_context_load(&state[bufferptr]);
 
   load_param(&fm_cycles_start,sizeof(fm_cycles_start));
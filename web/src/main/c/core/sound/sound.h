@@ -40,12 +40,53 @@
 #ifndef _SOUND_H_
 #define _SOUND_H_
 
+/* Chip output levels of the last sound_update() frame (output sample units) */
+typedef struct
+{
+  int fm;       /* FM output RMS (YM2612 including DAC, or YM2413) */
+  int psg;      /* PSG output level, from the channel volumes at the end of the frame */
+  int dac;      /* RMS of the YM2612 DAC samples written during the frame */
+  int key_on;   /* YM2612 channels keyed on during the frame (bit n = channel n+1) */
+  int dac_writes; /* YM2612 DAC samples written during the frame */
+} t_sound_meter;
+
+extern t_sound_meter sound_meter;
+
+/* Stem mode: each FM channel, the DAC and each PSG channel resampled to its own blip buffer */
+#define SOUND_STEM_FM   0   /* FM channels 1-6 */
+#define SOUND_STEM_DAC  6   /* YM2612 DAC (channel 6 in DAC mode) */
+#define SOUND_STEM_PSG  7   /* PSG tone channels 1-3, noise */
+#define SOUND_STEMS     11
+
+typedef struct
+{
+  int active;                 /* stems are generated (MAME YM2612 core or no FM chip, not in Mega CD mode) */
+  blip_t *blips[SOUND_STEMS];
+  float gain[SOUND_STEMS];    /* output mix gains (0 mutes a stem) */
+  float *out[SOUND_STEMS][2]; /* last frame of each stem, left & right */
+} t_sound_stems;
+
+extern t_sound_stems sound_stems;
+
 /* Function prototypes */
 extern void sound_init(void);
+extern void sound_memory_report(void);
 extern void sound_reset(void);
 extern int sound_context_save(uint8 *state);
 extern int sound_context_load(uint8 *state);
+extern int sound_fm_context_save(uint8 *state);
+extern int sound_fm_context_load(uint8 *state);
 extern int sound_update(unsigned int cycles);
+
+/* Switch the YM2612 emulator between frames, to Nuked OPN2 (ym3438) or MAME,
+   with the registers as last written ([port * 0x100 + register]) and the
+   keyed on operators carried over */
+extern void sound_fm_switch(int ym3438, const uint8 *regs);
+extern int sound_stems_enable(int enabled);
+extern void sound_stems_set_rates(double clock_rate, int sample_rate);
+extern void sound_stems_clear(void);
+extern void sound_stems_read(int16 *buffer, int count);
+extern void sound_stems_read_f32(float *out_l, float *out_r, int count);
 extern void (*fm_reset)(unsigned int cycles);
 extern void (*fm_write)(unsigned int cycles, unsigned int address, unsigned int data);
 extern unsigned int (*fm_read)(unsigned int cycles, unsigned int address);
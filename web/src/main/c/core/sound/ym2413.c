@@ -1007,10 +1007,16 @@ INLINE void rhythm_calc( YM2413_OPLL_CH *CH, unsigned int noise )
 /* generic table initialize */
 static int init_tables(void)
 {
+  static int tables_built = 0;
   signed int i,x;
   signed int n;
   double o,m;
 
+  /* constant tables: built once, kept across resets */
+  if (tables_built)
+    return 1;
+  tables_built = 1;
+
   for (x=0; x<TL_RES_LEN; x++)
   {
     m = (1<<16) / pow(2, (x+1) * (ENV_STEP/4.0) / 8.0);
@@ -180,13 +180,9 @@
 *   TL_RES_LEN - sinus resolution (X axis)
 */
 #define TL_TAB_LEN (13*2*TL_RES_LEN)
-static signed int tl_tab[TL_TAB_LEN];
 
 #define ENV_QUIET    (TL_TAB_LEN>>3)
 
-/* sin waveform table in 'decibel' scale */
-static unsigned int sin_tab[SIN_LEN];
-
 /* sustain level table (3dB per step) */
 /* bit0, bit1, bit2, bit3, bit4, bit5, bit6 */
 /* 1,    2,    4,    8,    16,   32,   64   (value)*/
@@ -390,7 +386,7 @@ static const UINT8 lfo_ams_depth_shift[4] = {8, 3, 1, 0};
   (bits 8,9,10 = FNUM MSB from OCT/FNUM register)
 
   Here we store only first quarter (positive one) of full waveform.
-  Full table (lfo_pm_table) containing all 128 waveforms is build
+  The first quarter of all 128 waveforms (tables.lfo_pm) is build
   at run (init) time.
 
   One value in table below represents 4 (four) basic LFO steps
@@ -477,8 +473,19 @@ static const UINT8 lfo_pm_output[7*8][8]={
 
 };
 
-/* all 128 LFO PM waveforms */
-static INT32 lfo_pm_table[128*8*32]; /* 128 combinations of 7 bits meaningful (of F-NUMBER), 8 LFO depths, 32 LFO output levels per one depth */
+/* Tables read for every sample, packed together (23KB instead of 158KB
+   with int-sized entries and the full PM waveforms) so they stay cached:
+   - tl_tab: 14-bit signed power values
+   - sin_tab: 13-bit log sine values
+   - lfo_pm: first quarter of all 128 LFO PM waveforms (128 combinations
+     of 7 bits meaningful of F-NUMBER, 8 LFO depths, 8 LFO output levels),
+     the other three mirrored and negated by lfo_pm_offset() */
+static struct
+{
+  INT16 tl_tab[TL_TAB_LEN];
+  UINT16 sin_tab[SIN_LEN];
+  UINT8 lfo_pm[128*8*8];
+} tables;
 
 /* register number to channel number , slot offset */
 #define OPN_CHAN(N) (N&3)
@@ -628,6 +635,7 @@ static YM2612 ym2612;
 static INT32  m2,c1,c2;   /* Phase Modulation input for operators 2,3,4 */
 static INT32  mem;        /* one sample delay memory */
 static INT32  out_fm[6];  /* outputs of working channels */
+static int   *stem_out;   /* per-channel outputs (YM2612SetStems) */
 
 /* chip type */
 static UINT32 op_mask[8][4];  /* operator output bitmasking (DAC quantization) */
@@ -1060,7 +1068,7 @@ INLINE void advance_lfo()
 }
 
 
-INLINE void advance_eg_channels(FM_CH *CH, unsigned int eg_cnt)
+INLINE void advance_eg_channels(FM_CH *CH, unsigned int eg_cnt, unsigned int mask)
 {
   unsigned int i = 6; /* six channels */
   unsigned int j;
@@ -1068,6 +1076,13 @@ INLINE void advance_eg_channels(FM_CH *CH, unsigned int eg_cnt)
 
   do
   {
+    /* channels with all operators off are left out (see active_channels) */
+    if (!(mask & (1 << (6 - i))))
+    {
+      CH++;
+      continue;
+    }
+
     SLOT = &CH->SLOT[SLOT1];
     j = 4; /* four operators per channel */
     do
@@ -1219,7 +1234,7 @@ INLINE void advance_eg_channels(FM_CH *CH, unsigned int eg_cnt)
 /* SSG-EG update process */
 /* The behavior is based upon Nemesis tests on real hardware */
 /* This is actually executed before each samples */
-INLINE void update_ssg_eg_channels(FM_CH *CH)
+INLINE void update_ssg_eg_channels(FM_CH *CH, unsigned int mask)
 {
   unsigned int i = 6; /* six channels */
   unsigned int j;
@@ -1227,6 +1242,12 @@ INLINE void update_ssg_eg_channels(FM_CH *CH)
 
   do
   {
+    if (!(mask & (1 << (6 - i))))
+    {
+      CH++;
+      continue;
+    }
+
     j = 4; /* four operators per channel */
     SLOT = &CH->SLOT[SLOT1];
 
@@ -1287,9 +1308,17 @@ INLINE void update_ssg_eg_channels(FM_CH *CH)
   } while (--i);
 }
 
+/* LFO PM offset for F-NUMBER 'fc' at 'pm' (PM depth * 32 + LFO PM step):
+   steps 8-15 mirror the first quarter, steps 16-31 negate the first half */
+INLINE INT32 lfo_pm_offset(UINT32 fc, UINT32 pm)
+{
+  INT32 value = tables.lfo_pm[((fc & 0x7f0) << 2) + ((pm >> 2) & 0x38) + ((pm ^ ((pm & 8) ? 7 : 0)) & 7)];
+  return (pm & 16) ? -value : value;
+}
+
 INLINE void update_phase_lfo_slot(FM_SLOT *SLOT, UINT32 pm, UINT8 kc, UINT32 fc)
 {
-  INT32 lfo_fn_offset = lfo_pm_table[((fc & 0x7f0) << 4) + pm];
+  INT32 lfo_fn_offset = lfo_pm_offset(fc, pm);
   
   if (lfo_fn_offset)  /* LFO phase modulation active */
   {
@@ -1315,7 +1344,7 @@ INLINE void update_phase_lfo_channel(FM_CH *CH)
 {
   UINT32 fc = CH->block_fnum;
   
-  INT32 lfo_fn_offset = lfo_pm_table[((fc & 0x7f0) << 4) + CH->pms + ym2612.OPN.LFO_PM];
+  INT32 lfo_fn_offset = lfo_pm_offset(fc, CH->pms + ym2612.OPN.LFO_PM);
 
   if (lfo_fn_offset)  /* LFO phase modulation active */
   {
@@ -1414,20 +1443,20 @@ INLINE void refresh_fc_eg_chan(FM_CH *CH )
 
 INLINE signed int op_calc(UINT32 phase, unsigned int env, unsigned int pm, unsigned int opmask)
 {
-  UINT32 p = (env<<3) + sin_tab[ ( (phase >> SIN_BITS) + (pm >> 1) ) & SIN_MASK ];
+  UINT32 p = (env<<3) + tables.sin_tab[ ( (phase >> SIN_BITS) + (pm >> 1) ) & SIN_MASK ];
 
   if (p >= TL_TAB_LEN)
     return 0;
-  return (tl_tab[p] & opmask);
+  return (tables.tl_tab[p] & opmask);
 }
 
 INLINE signed int op_calc1(UINT32 phase, unsigned int env, unsigned int pm, unsigned int opmask)
 {
-  UINT32 p = (env<<3) + sin_tab[ ( ( phase >> SIN_BITS ) + pm ) & SIN_MASK ];
+  UINT32 p = (env<<3) + tables.sin_tab[ ( ( phase >> SIN_BITS ) + pm ) & SIN_MASK ];
 
   if (p >= TL_TAB_LEN)
     return 0;
-  return (tl_tab[p] & opmask);
+  return (tables.tl_tab[p] & opmask);
 }
 
 INLINE void chan_calc(FM_CH *CH, int num)
@@ -1742,7 +1771,7 @@ INLINE void OPNWriteReg(int r, int v)
         }
         case 1:    /* 0xb4-0xb6 : L , R , AMS , PMS */
           /* b0-2 PMS */
-          CH->pms = (v & 7) * 32; /* CH->pms = PM depth * 32 (index in lfo_pm_table) */
+          CH->pms = (v & 7) * 32; /* CH->pms = PM depth * 32 (see lfo_pm_offset()) */
 
           /* b4-5 AMS */
           CH->ams = lfo_ams_depth_shift[(v>>4) & 0x03];
@@ -1779,12 +1808,18 @@ static void reset_channels(FM_CH *CH , int num )
 }
 
 /* initialize generic tables */
+/* constant tables: built once, kept across resets */
 static void init_tables(void)
 {
-  signed int d,i,x;
+  static int tables_built = 0;
+  signed int i,x;
   signed int n;
   double o,m;
 
+  if (tables_built)
+    return;
+  tables_built = 1;
+
   /* build Linear Power Table */
   for (x=0; x<TL_RES_LEN; x++)
   {
@@ -1804,8 +1839,8 @@ static void init_tables(void)
     n <<= 2;    /* 13 bits here (as in real chip) */
 
     /* 14 bits (with sign bit) */
-    tl_tab[ x*2 + 0 ] = n;
-    tl_tab[ x*2 + 1 ] = -tl_tab[ x*2 + 0 ];
+    tables.tl_tab[ x*2 + 0 ] = n;
+    tables.tl_tab[ x*2 + 1 ] = -tables.tl_tab[ x*2 + 0 ];
 
     /* one entry in the 'Power' table use the following format, xxxxxyyyyyyyys with:            */
     /*        s = sign bit                                                                      */
@@ -1814,8 +1849,8 @@ static void init_tables(void)
     /*            any value above 13 (included) would be discarded.                             */
     for (i=1; i<13; i++)
     {
-      tl_tab[ x*2+0 + i*2*TL_RES_LEN ] =  tl_tab[ x*2+0 ]>>i;
-      tl_tab[ x*2+1 + i*2*TL_RES_LEN ] = -tl_tab[ x*2+0 + i*2*TL_RES_LEN ];
+      tables.tl_tab[ x*2+0 + i*2*TL_RES_LEN ] =  tables.tl_tab[ x*2+0 ]>>i;
+      tables.tl_tab[ x*2+1 + i*2*TL_RES_LEN ] = -tables.tl_tab[ x*2+0 + i*2*TL_RES_LEN ];
     }
   }
 
@@ -1840,7 +1875,7 @@ static void init_tables(void)
       n = n>>1;
 
     /* 13-bits (8.5) value is formatted for above 'Power' table */
-    sin_tab[ i ] = n*2 + (m>=0.0? 0: 1 );
+    tables.sin_tab[ i ] = n*2 + (m>=0.0? 0: 1 );
   }
 
   /* build LFO PM modulation table */
@@ -1866,14 +1901,17 @@ static void init_tables(void)
             value += lfo_pm_output[offset_fnum_bit + offset_depth][step];
           }
         }
-        /* 32 steps for LFO PM (sinus) */
-        lfo_pm_table[(fnum*32*8) + (i*32) + step   + 0] = value;
-        lfo_pm_table[(fnum*32*8) + (i*32) +(step^7)+ 8] = value;
-        lfo_pm_table[(fnum*32*8) + (i*32) + step   +16] = -value;
-        lfo_pm_table[(fnum*32*8) + (i*32) +(step^7)+24] = -value;
+        /* first 8 of the 32 steps for LFO PM (sinus) */
+        tables.lfo_pm[(fnum*8*8) + (i*8) + step] = value;
       }
     }
   }
+}
+
+/* tables in the chip state or changed by YM2612Config() */
+static void init_chip_tables(void)
+{
+  int d,i;
 
   /* build DETUNE table */
   for (d = 0;d <= 3;d++)
@@ -1903,6 +1941,7 @@ void YM2612Init(void)
 {
   memset(&ym2612,0,sizeof(YM2612));
   init_tables();
+  init_chip_tables();
 }
 
 /* reset OPN registers */
@@ -1999,11 +2038,109 @@ unsigned int YM2612Read(void)
   return ym2612.OPN.ST.status;
 }
 
+/* Channel skipping is decided once per block of samples */
+#define FM_BLOCK_SIZE 32
+
+/* Return the channels among the first 'num' that need chan_calc() for the next
+   'samples' samples (bit n = channel n). A channel whose four operators are off
+   (envelope below ENV_QUIET) with no feedback or MEM value left only outputs
+   zero until its next key on, which cannot happen during an update (CSM mode
+   excepted): its phase counters are advanced for the whole block instead.
+   Channels with LFO phase modulation always run, their phase step varies. */
+INLINE unsigned int active_channels(int num, int samples)
+{
+  unsigned int active = 0;
+  int c, s;
+
+  for (c = 0; c < num; c++)
+  {
+    FM_CH *CH = &ym2612.CH[c];
+
+    if (CH->pms || CH->op1_out[0] || CH->op1_out[1] || CH->mem_value ||
+        ((c == 2) && (ym2612.OPN.ST.mode & 0x80)))
+    {
+      active |= (1 << c);
+      continue;
+    }
+
+    for (s = 0; s < 4; s++)
+    {
+      if ((CH->SLOT[s].state != EG_OFF) || (CH->SLOT[s].vol_out < ENV_QUIET))
+        break;
+    }
+
+    if (s < 4)
+    {
+      active |= (1 << c);
+      continue;
+    }
+
+    for (s = 0; s < 4; s++)
+    {
+      CH->SLOT[s].phase += (UINT32)CH->SLOT[s].Incr * samples;
+    }
+  }
+
+  return active;
+}
+
+/* Per-channel panned outputs of the current sample, ladder effect included (they add up to the mix) */
+static void stems_update(int *out)
+{
+  int i;
+
+  for (i=0; i<6; i++)
+  {
+    int lt = out_fm[i] & ym2612.OPN.pan[(2*i)+0];
+    int rt = out_fm[i] & ym2612.OPN.pan[(2*i)+1];
+
+    if (chip_type == YM2612_DISCRETE)
+    {
+      if (out_fm[i] < 0)
+      {
+        lt -= ((4 - (ym2612.OPN.pan[(2*i)+0] & 1)) << 5);
+        rt -= ((4 - (ym2612.OPN.pan[(2*i)+1] & 1)) << 5);
+      }
+      else
+      {
+        lt += (4 << 5);
+        rt += (4 << 5);
+      }
+    }
+
+    out[(2*i)+0] = lt;
+    out[(2*i)+1] = rt;
+  }
+
+  /* DAC output goes to its own stem */
+  if (ym2612.dacen)
+  {
+    out[12] = out[10];
+    out[13] = out[11];
+    out[10] = 0;
+    out[11] = 0;
+  }
+  else
+  {
+    out[12] = 0;
+    out[13] = 0;
+  }
+}
+
+/* Per-channel outputs written by YM2612Update() from 'buffer' on (YM2612_STEMS stereo pairs per sample), NULL when disabled */
+void YM2612SetStems(int *buffer)
+{
+  stem_out = buffer;
+}
+
 /* Generate samples for ym2612 */
 void YM2612Update(int *buffer, int length)
 {
   int i;
   int lt,rt;
+  int num = ym2612.dacen ? 5 : 6;
+  unsigned int active = 0;
+  unsigned int eg_active = 0;
 
   /* refresh PG increments and EG rates if required */
   refresh_fc_eg_chan(&ym2612.CH[0]);
@@ -2040,20 +2177,43 @@ void YM2612Update(int *buffer, int length)
     out_fm[4] = 0;
     out_fm[5] = 0;
 
+    /* skip silent channels for the next block (the DAC channel envelope keeps running) */
+    if (!(i & (FM_BLOCK_SIZE - 1)))
+    {
+      active = active_channels(num, (length - i < FM_BLOCK_SIZE) ? (length - i) : FM_BLOCK_SIZE);
+      eg_active = active | (ym2612.dacen ? 0x20 : 0);
+    }
+
     /* update SSG-EG output */
-    update_ssg_eg_channels(&ym2612.CH[0]);
+    update_ssg_eg_channels(&ym2612.CH[0], eg_active);
+
+    /* DAC Mode */
+    if (ym2612.dacen)
+    {
+      out_fm[5] = ym2612.dacout;
+    }
 
     /* calculate FM */
-    if (!ym2612.dacen)
+    if (active == 0x3F)
     {
       chan_calc(&ym2612.CH[0],6);
     }
-    else
+    else if (active == 0x1F)
     {
-      /* DAC Mode */
-      out_fm[5] = ym2612.dacout;
+      /* DAC Mode (or channel 6 off) */
       chan_calc(&ym2612.CH[0],5);
     }
+    else if (active)
+    {
+      int c;
+      for (c = 0; c < num; c++)
+      {
+        if (active & (1 << c))
+        {
+          chan_calc(&ym2612.CH[c],1);
+        }
+      }
+    }
 
     /* advance LFO */
     advance_lfo();
@@ -2073,7 +2233,7 @@ void YM2612Update(int *buffer, int length)
         ym2612.OPN.eg_cnt = 1;
 
       /* advance envelope generator */
-      advance_eg_channels(&ym2612.CH[0], ym2612.OPN.eg_cnt);
+      advance_eg_channels(&ym2612.CH[0], ym2612.OPN.eg_cnt, eg_active);
     }
 
     /* channels accumulator output clipping (14-bit max) */
@@ -2131,6 +2291,13 @@ void YM2612Update(int *buffer, int length)
     *buffer++ = lt;
     *buffer++ = rt;
 
+    /* per-channel outputs (stem mode only) */
+    if (stem_out)
+    {
+      stems_update(stem_out);
+      stem_out += YM2612_STEMS * 2;
+    }
+
     /* CSM mode: if CSM Key ON has occurred, CSM Key OFF need to be sent      */
     /* only if Timer A does not overflow again (i.e CSM Key ON not set again) */
     ym2612.OPN.SL3.key_csm <<= 1;
@@ -16,6 +16,9 @@
 #ifndef _H_YM2612_
 #define _H_YM2612_
 
+/* per-channel outputs: FM channels 1-6, then channel 6 in DAC mode */
+#define YM2612_STEMS 7
+
 enum {
   YM2612_DISCRETE = 0,
   YM2612_INTEGRATED,
@@ -26,6 +29,7 @@ extern void YM2612Init(void);
 extern void YM2612Config(int type);
 extern void YM2612ResetChip(void);
 extern void YM2612Update(int *buffer, int length);
+extern void YM2612SetStems(int *buffer);
 extern void YM2612Write(unsigned int a, unsigned int v);
 extern unsigned int YM2612Read(void);
 extern int YM2612LoadContext(unsigned char *state);
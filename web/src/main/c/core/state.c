@@ -38,27 +38,346 @@
 
 #include "shared.h"
 
-int state_load(unsigned char *state)
+/* Sectioned format: STATE_SIGNATURE, then one section per hardware block, each
+   one a 4-character tag, a 32-bit length and its data. STATE_PACKED in the
+   length marks data packed by state_pack(), preceded by its unpacked length.
+   An "END " section closes the list. Hardware that is not emulated for the
+   loaded game (CD unit, Z80 side of SMS games...) is not saved at all. */
+
+#define STATE_PACKED   0x80000000
+#define STATE_PACK_MIN 0x400        /* smaller sections are always stored */
+
+typedef struct
+{
+  char tag[4];
+  int (*present)(void);
+  int (*save)(uint8 *state);
+  int (*load)(uint8 *state, int size);  /* 0: bad section */
+} state_section_t;
+
+/*--------------------------------------------------------------------------*/
+/* Packing (PackBits: n < 128: n + 1 literal bytes, else next byte n - 125 times) */
+/*--------------------------------------------------------------------------*/
+
+static int state_pack(uint8 *out, const uint8 *in, int size)
+{
+  int i = 0, o = 0;
+
+  while (i < size)
+  {
+    int run = 1;
+    while ((i + run < size) && (run < 130) && (in[i + run] == in[i]))
+      run++;
+
+    if (run >= 3)
+    {
+      out[o++] = run + 125;
+      out[o++] = in[i];
+      i += run;
+    }
+    else
+    {
+      /* literals up to the next run of 3 */
+      int start = i;
+      while ((i < size) && (i - start < 128) &&
+             !((i + 2 < size) && (in[i] == in[i + 1]) && (in[i] == in[i + 2])))
+        i++;
+      out[o++] = i - start - 1;
+      memcpy(&out[o], &in[start], i - start);
+      o += i - start;
+    }
+
+    /* not worth it */
+    if (o >= size)
+      return 0;
+  }
+
+  return o;
+}
+
+static int state_unpack(uint8 *out, int max, const uint8 *in, int size)
 {
-  int i, bufferptr = 0;
+  int i = 0, o = 0;
 
-  /* signature check (GENPLUS-GX x.x.x) */
-  char version[17];
-  load_param(version,16);
-  version[16] = 0;
-  if (memcmp(version,STATE_VERSION,11))
+  while (i < size)
   {
+    int n = in[i++];
+    if (n < 128)
+    {
+      n++;
+      if ((o + n > max) || (i + n > size))
+        return -1;
+      memcpy(&out[o], &in[i], n);
+      i += n;
+    }
+    else
+    {
+      n -= 125;
+      if ((o + n > max) || (i >= size))
+        return -1;
+      memset(&out[o], in[i++], n);
+    }
+    o += n;
+  }
+
+  return o;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Sections                                                                 */
+/*--------------------------------------------------------------------------*/
+
+static int state_md(void)
+{
+  return (system_hw & SYSTEM_PBC) == SYSTEM_MD;
+}
+
+static int state_always(void)
+{
+  return 1;
+}
+
+static int state_mcd(void)
+{
+  return system_hw == SYSTEM_MCD;
+}
+
+static int state_cart(void)
+{
+  return system_hw != SYSTEM_MCD;
+}
+
+static int work_ram_size(void)
+{
+  return state_md() ? sizeof(work_ram) : 0x2000;
+}
+
+static int ram_save(uint8 *state)
+{
+  memcpy(state, work_ram, work_ram_size());
+  return work_ram_size();
+}
+
+static int ram_load(uint8 *state, int size)
+{
+  if (size != work_ram_size())
     return 0;
+  memcpy(work_ram, state, size);
+  return 1;
+}
+
+static int zram_save(uint8 *state)
+{
+  int bufferptr = 0;
+  save_param(zram, sizeof(zram));
+  save_param(&zstate, sizeof(zstate));
+  save_param(&zbank, sizeof(zbank));
+  return bufferptr;
+}
+
+static int zram_load(uint8 *state, int size)
+{
+  int bufferptr = 0;
+
+  if (size != (sizeof(zram) + sizeof(zstate) + sizeof(zbank)))
+    return 0;
+
+  load_param(zram, sizeof(zram));
+  load_param(&zstate, sizeof(zstate));
+  load_param(&zbank, sizeof(zbank));
+  if (zstate == 3)
+  {
+    m68k.memory_map[0xa0].read8   = z80_read_byte;
+    m68k.memory_map[0xa0].read16  = z80_read_word;
+    m68k.memory_map[0xa0].write8  = z80_write_byte;
+    m68k.memory_map[0xa0].write16 = z80_write_word;
+  }
+  else
+  {
+    m68k.memory_map[0xa0].read8   = m68k_read_bus_8;
+    m68k.memory_map[0xa0].read16  = m68k_read_bus_16;
+    m68k.memory_map[0xa0].write8  = m68k_unused_8_w;
+    m68k.memory_map[0xa0].write16 = m68k_unused_16_w;
   }
+  return 1;
+}
 
-  /* version check */
-  if ((version[11] < 0x31) || (version[13] < 0x37) || (version[15] < 0x35))
+static int io_save(uint8 *state)
+{
+  memcpy(state, io_reg, sizeof(io_reg));
+  return sizeof(io_reg);
+}
+
+static int io_load(uint8 *state, int size)
+{
+  if (size != sizeof(io_reg))
+    return 0;
+
+  memcpy(io_reg, state, size);
+  if (state_md())
+  {
+    io_reg[0] = region_code | 0x20 | (config.bios & 1);
+  }
+  else
   {
+    io_reg[0] = 0x80 | (region_code >> 1);
+  }
+  return 1;
+}
+
+static int vdp_load(uint8 *state, int size)
+{
+  return vdp_context_load(state) == size;
+}
+
+static int sound_load(uint8 *state, int size)
+{
+  if (sound_context_load(state) != size)
     return 0;
+
+  if (state_md())
+  {
+    psg_config(0, config.psg_preamp, 0xff);
+  }
+  else
+  {
+    psg_config(0, config.psg_preamp, io_reg[6]);
   }
+  return 1;
+}
 
-  /* reset system */
-  system_reset();
+static int m68k_save(uint8 *state)
+{
+  int bufferptr = 0;
+  uint16 tmp16;
+  uint32 tmp32;
+
+  tmp32 = m68k_get_reg(M68K_REG_D0);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D1);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D2);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D3);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D4);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D5);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D6);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_D7);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A0);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A1);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A2);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A3);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A4);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A5);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A6);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_A7);  save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_PC);  save_param(&tmp32, 4);
+  tmp16 = m68k_get_reg(M68K_REG_SR);  save_param(&tmp16, 2); 
+  tmp32 = m68k_get_reg(M68K_REG_USP); save_param(&tmp32, 4);
+  tmp32 = m68k_get_reg(M68K_REG_ISP); save_param(&tmp32, 4);
+
+  save_param(&m68k.cycles, sizeof(m68k.cycles));
+  save_param(&m68k.int_level, sizeof(m68k.int_level));
+  save_param(&m68k.stopped, sizeof(m68k.stopped));
+  return bufferptr;
+}
+
+static int m68k_load(uint8 *state, int size)
+{
+  int bufferptr = 0;
+  uint16 tmp16;
+  uint32 tmp32;
+
+  if (size != (17 * 4 + 2 + 2 * 4 + sizeof(m68k.cycles) + sizeof(m68k.int_level) + sizeof(m68k.stopped)))
+    return 0;
+
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D0, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D1, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D2, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D3, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D4, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D5, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D6, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D7, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A0, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A1, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A2, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A3, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A4, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A5, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A6, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A7, tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_PC, tmp32);  
+  load_param(&tmp16, 2); m68k_set_reg(M68K_REG_SR, tmp16);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_USP,tmp32);
+  load_param(&tmp32, 4); m68k_set_reg(M68K_REG_ISP,tmp32);
+
+  load_param(&m68k.cycles, sizeof(m68k.cycles));
+  load_param(&m68k.int_level, sizeof(m68k.int_level));
+  load_param(&m68k.stopped, sizeof(m68k.stopped));
+
+  /* not saved: an address error the last instruction raised is dropped */
+  m68k.aerr_pending = 0;
+  return 1;
+}
+
+static int z80_save(uint8 *state)
+{
+  memcpy(state, &Z80, sizeof(Z80_Regs));
+  return sizeof(Z80_Regs);
+}
+
+static int z80_load(uint8 *state, int size)
+{
+  if (size != sizeof(Z80_Regs))
+    return 0;
+  memcpy(&Z80, state, size);
+  Z80.irq_callback = z80_irq_callback;
+  return 1;
+}
+
+static int scd_load(uint8 *state, int size)
+{
+  return scd_context_load(state) == size;
+}
+
+static int cart_save(uint8 *state)
+{
+  return state_md() ? md_cart_context_save(state) : sms_cart_context_save(state);
+}
+
+static int cart_load(uint8 *state, int size)
+{
+  if (state_md())
+  {
+    return md_cart_context_load(state) == size;
+  }
+
+  if (sms_cart_context_load(state) != size)
+    return 0;
+  sms_cart_switch(~io_reg[0x0E]);
+  return 1;
+}
+
+static const state_section_t state_sections[] =
+{
+  {"WRAM", state_always, ram_save,           ram_load},
+  {"ZRAM", state_md,     zram_save,          zram_load},
+  {"IO  ", state_always, io_save,            io_load},
+  {"VDP ", state_always, vdp_context_save,   vdp_load},
+  {"SND ", state_always, sound_context_save, sound_load},
+  {"M68K", state_md,     m68k_save,          m68k_load},
+  {"Z80 ", state_always, z80_save,           z80_load},
+  {"SCD ", state_mcd,    scd_context_save,   scd_load},
+  {"CART", state_cart,   cart_save,          cart_load}
+};
+
+#define STATE_SECTIONS (sizeof(state_sections) / sizeof(state_sections[0]))
+
+/*--------------------------------------------------------------------------*/
+/* Legacy flat format (GENPLUS-GX 1.7.5 and later)                          */
+/*--------------------------------------------------------------------------*/
+
+static void state_enable_vdp(void)
+{
+  int i;
 
   /* enable VDP access for TMSS systems */
   for (i=0xc0; i<0xe0; i+=8)
@@ -70,112 +389,73 @@ int state_load(unsigned char *state)
     zbank_memory_map[i].read    = zbank_read_vdp;
     zbank_memory_map[i].write   = zbank_write_vdp;
   }
+}
 
-  /* GENESIS */
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
-  {
-    load_param(work_ram, sizeof(work_ram));
-    load_param(zram, sizeof(zram));
-    load_param(&zstate, sizeof(zstate));
-    load_param(&zbank, sizeof(zbank));
-    if (zstate == 3)
-    {
-      m68k.memory_map[0xa0].read8   = z80_read_byte;
-      m68k.memory_map[0xa0].read16  = z80_read_word;
-      m68k.memory_map[0xa0].write8  = z80_write_byte;
-      m68k.memory_map[0xa0].write16 = z80_write_word;
-    }
-    else
-    {
-      m68k.memory_map[0xa0].read8   = m68k_read_bus_8;
-      m68k.memory_map[0xa0].read16  = m68k_read_bus_16;
-      m68k.memory_map[0xa0].write8  = m68k_unused_8_w;
-      m68k.memory_map[0xa0].write16 = m68k_unused_16_w;
-    }
-  }
-  else
+static int state_load_flat(unsigned char *state)
+{
+  int bufferptr = 16;
+
+  /* version check */
+  if ((state[11] < 0x31) || (state[13] < 0x37) || (state[15] < 0x35))
   {
-    load_param(work_ram, 0x2000);
+    return 0;
   }
 
-  /* IO */
-  load_param(io_reg, sizeof(io_reg));
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  /* reset system */
+  system_reset();
+  state_enable_vdp();
+
+  /* GENESIS */
+  if (state_md())
   {
-    io_reg[0] = region_code | 0x20 | (config.bios & 1);
+    ram_load(&state[bufferptr], sizeof(work_ram));
+    bufferptr += sizeof(work_ram);
+    zram_load(&state[bufferptr], sizeof(zram) + sizeof(zstate) + sizeof(zbank));
+    bufferptr += sizeof(zram) + sizeof(zstate) + sizeof(zbank);
   }
   else
   {
-    io_reg[0] = 0x80 | (region_code >> 1);
+    ram_load(&state[bufferptr], 0x2000);
+    bufferptr += 0x2000;
   }
 
+  /* IO */
+  io_load(&state[bufferptr], sizeof(io_reg));
+  bufferptr += sizeof(io_reg);
+
   /* VDP */
   bufferptr += vdp_context_load(&state[bufferptr]);
 
   /* SOUND */
   bufferptr += sound_context_load(&state[bufferptr]);
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
-  {
-    psg_config(0, config.psg_preamp, 0xff);
-  }
-  else
-  {
-    psg_config(0, config.psg_preamp, io_reg[6]);
-  }
+  psg_config(0, config.psg_preamp, state_md() ? 0xff : io_reg[6]);
 
   /* 68000 */
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  if (state_md())
   {
-    uint16 tmp16;
-    uint32 tmp32;
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D0, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D1, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D2, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D3, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D4, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D5, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D6, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_D7, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A0, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A1, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A2, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A3, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A4, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A5, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A6, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_A7, tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_PC, tmp32);  
-    load_param(&tmp16, 2); m68k_set_reg(M68K_REG_SR, tmp16);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_USP,tmp32);
-    load_param(&tmp32, 4); m68k_set_reg(M68K_REG_ISP,tmp32);
-
-  	load_param(&m68k.cycles, sizeof(m68k.cycles));
-    load_param(&m68k.int_level, sizeof(m68k.int_level));
-    load_param(&m68k.stopped, sizeof(m68k.stopped));
+    int size = 17 * 4 + 2 + 2 * 4 + sizeof(m68k.cycles) + sizeof(m68k.int_level) + sizeof(m68k.stopped);
+    m68k_load(&state[bufferptr], size);
+    bufferptr += size;
   }
 
   /* Z80 */ 
-  load_param(&Z80, sizeof(Z80_Regs));
-  Z80.irq_callback = z80_irq_callback;
+  z80_load(&state[bufferptr], sizeof(Z80_Regs));
+  bufferptr += sizeof(Z80_Regs);
 
   /* Extra HW */
   if (system_hw == SYSTEM_MCD)
   {
-    /* handle case of MD cartridge using or not CD hardware */
-    char id[5];
-    load_param(id,4);
-    id[4] = 0;
-
     /* check if CD hardware was enabled before attempting to restore */
-    if (memcmp(id,"SCD!",4))
+    if (memcmp(&state[bufferptr],"SCD!",4))
     {
        return 0;
     }
+    bufferptr += 4;
 
     /* CD hardware */
     bufferptr += scd_context_load(&state[bufferptr]);
   }
-  else if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  else if (state_md())
   {  
     /* MD cartridge hardware */
     bufferptr += md_cart_context_load(&state[bufferptr]);
@@ -190,94 +470,146 @@ int state_load(unsigned char *state)
   return bufferptr;
 }
 
-int state_save(unsigned char *state)
+/*--------------------------------------------------------------------------*/
+/* Load / save                                                              */
+/*--------------------------------------------------------------------------*/
+
+static const state_section_t *state_find(const unsigned char *tag)
 {
-  /* buffer size */
-  int bufferptr = 0;
+  int i;
+  for (i = 0; i < STATE_SECTIONS; i++)
+  {
+    if (!memcmp(tag, state_sections[i].tag, 4))
+      return &state_sections[i];
+  }
+  return NULL;
+}
 
-  /* version string */
-  char version[16];
-  memcpy(version,STATE_VERSION,16);
-  save_param(version, 16);
+int state_load(unsigned char *state, int flags)
+{
+  unsigned int found = 0;
+  int i, bufferptr;
 
-  /* GENESIS */
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  if (!memcmp(state, STATE_VERSION, 11))
   {
-    save_param(work_ram, sizeof(work_ram));
-    save_param(zram, sizeof(zram));
-    save_param(&zstate, sizeof(zstate));
-    save_param(&zbank, sizeof(zbank));
+    return state_load_flat(state);
   }
-  else
+
+  /* signature check */
+  if (memcmp(state, STATE_SIGNATURE, 16))
   {
-    save_param(work_ram, 0x2000);
+    return 0;
   }
 
-  /* IO */
-  save_param(io_reg, sizeof(io_reg));
+  /* check the section list before touching anything */
+  for (bufferptr = 16; memcmp(&state[bufferptr], "END ", 4); )
+  {
+    const state_section_t *section = state_find(&state[bufferptr]);
+    uint32 size;
 
-  /* VDP */
-  bufferptr += vdp_context_save(&state[bufferptr]);
+    memcpy(&size, &state[bufferptr + 4], 4);
+    bufferptr += 8 + (size & ~STATE_PACKED);
+    if (bufferptr + 8 > STATE_SIZE)
+    {
+      return 0;
+    }
 
-  /* SOUND */
-  bufferptr += sound_context_save(&state[bufferptr]);
+    /* sections of hardware this game does not use */
+    if (section)
+    {
+      if (!section->present())
+        return 0;
+      found |= 1 << (section - state_sections);
+    }
+  }
 
-  /* 68000 */ 
-  if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  for (i = 0; i < STATE_SECTIONS; i++)
   {
-    uint16 tmp16;
-    uint32 tmp32;
-    tmp32 = m68k_get_reg(M68K_REG_D0);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D1);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D2);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D3);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D4);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D5);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D6);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_D7);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A0);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A1);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A2);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A3);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A4);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A5);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A6);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_A7);  save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_PC);  save_param(&tmp32, 4);
-    tmp16 = m68k_get_reg(M68K_REG_SR);  save_param(&tmp16, 2); 
-    tmp32 = m68k_get_reg(M68K_REG_USP); save_param(&tmp32, 4);
-    tmp32 = m68k_get_reg(M68K_REG_ISP); save_param(&tmp32, 4);
-
-    save_param(&m68k.cycles, sizeof(m68k.cycles));
-    save_param(&m68k.int_level, sizeof(m68k.int_level));
-    save_param(&m68k.stopped, sizeof(m68k.stopped));
+    if (state_sections[i].present() && !(found & (1 << i)))
+      return 0;
   }
 
-  /* Z80 */ 
-  save_param(&Z80, sizeof(Z80_Regs));
-
-  /* External HW */
-  if (system_hw == SYSTEM_MCD)
+  if (!(flags & STATE_INPLACE))
   {
-    /* CD hardware ID flag */
-    char id[4];
-    memcpy(id,"SCD!",4);
-    save_param(id, 4);
-
-    /* CD hardware */
-    bufferptr += scd_context_save(&state[bufferptr]);
+    system_reset();
   }
-  else if ((system_hw & SYSTEM_PBC) == SYSTEM_MD)
+  state_enable_vdp();
+
+  for (bufferptr = 16; memcmp(&state[bufferptr], "END ", 4); )
   {
-    /* MD cartridge hardware */
-    bufferptr += md_cart_context_save(&state[bufferptr]);
+    const state_section_t *section = state_find(&state[bufferptr]);
+    uint8 *data = &state[bufferptr + 8];
+    uint32 size;
+
+    memcpy(&size, &state[bufferptr + 4], 4);
+    bufferptr += 8 + (size & ~STATE_PACKED);
+
+    if (!section)
+      continue;
+
+    if (size & STATE_PACKED)
+    {
+      uint32 unpacked;
+      uint8 *buffer;
+      int ok;
+
+      memcpy(&unpacked, data, 4);
+      if ((unpacked > STATE_SIZE) || !(buffer = malloc(unpacked)))
+        return 0;
+      ok = (state_unpack(buffer, unpacked, data + 4, (size & ~STATE_PACKED) - 4) == unpacked) &&
+           section->load(buffer, unpacked);
+      free(buffer);
+      if (!ok)
+        return 0;
+    }
+    else if (!section->load(data, size))
+    {
+      return 0;
+    }
   }
-  else
+
+  return bufferptr + 8;
+}
+
+int state_save(unsigned char *state, int flags)
+{
+  uint8 *buffer = NULL;
+  int i, bufferptr = 16;
+
+  memcpy(state, STATE_SIGNATURE, 16);
+
+  for (i = 0; i < STATE_SECTIONS; i++)
   {
-    /* MS cartridge hardware */
-    bufferptr += sms_cart_context_save(&state[bufferptr]);
+    const state_section_t *section = &state_sections[i];
+    uint8 *data = &state[bufferptr + 8];
+    uint32 size;
+
+    if (!section->present())
+      continue;
+
+    size = section->save(data);
+
+    /* packed copy, when smaller (staged in a scratch buffer) */
+    if ((flags & STATE_PACK) && (size >= STATE_PACK_MIN) && (buffer || (buffer = malloc(STATE_SIZE + 256))))
+    {
+      int packed = state_pack(buffer, data, size);
+      if (packed && (packed + 4 < size))
+      {
+        memcpy(data, &size, 4);
+        memcpy(data + 4, buffer, packed);
+        size = (packed + 4) | STATE_PACKED;
+      }
+    }
+
+    memcpy(&state[bufferptr], section->tag, 4);
+    memcpy(&state[bufferptr + 4], &size, 4);
+    bufferptr += 8 + (size & ~STATE_PACKED);
   }
 
+  memcpy(&state[bufferptr], "END ", 4);
+  memset(&state[bufferptr + 4], 0, 4);
+  free(buffer);
+
   /* return total size */
-  return bufferptr;
+  return bufferptr + 8;
 }
@@ -39,8 +39,19 @@
 #ifndef _STATE_H_
 #define _STATE_H_
 
-#define STATE_SIZE    0xfd000
-#define STATE_VERSION "GENPLUS-GX 1.7.5"
+#ifdef MD_ONLY
+#define STATE_SIZE      0x30000   /* no Mega CD or SVP sections (~0x23400 used) */
+#else
+#define STATE_SIZE      0xfd000
+#endif
+#define STATE_VERSION   "GENPLUS-GX 1.7.5"  /* flat format, still loaded */
+#define STATE_SIGNATURE "GENPLUS-GX/SECT1"  /* sectioned format (see state.c) */
+
+/* state_save() flags */
+#define STATE_PACK    0x01  /* RLE-pack the larger sections (smaller, slower) */
+
+/* state_load() flags */
+#define STATE_INPLACE 0x01  /* restore over the running machine, without system_reset() */
 
 #define load_param(param, size) \
   memcpy(param, &state[bufferptr], size); \
@@ -51,7 +62,7 @@
   bufferptr+= size;
 
 /* Function prototypes */
-extern int state_load(unsigned char *state);
-extern int state_save(unsigned char *state);
+extern int state_load(unsigned char *state, int flags);
+extern int state_save(unsigned char *state, int flags);
 
 #endif
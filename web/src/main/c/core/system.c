@@ -42,6 +42,21 @@
 #include "shared.h"
 #include "eq.h"
 
+#ifdef WASM_GENPLUS
+#include "profile.h"
+#include "telemetry.h"
+#else
+#define TELEMETRY_CALL(id, call) call
+#endif
+
+#ifdef CHAOS_PROFILE
+/* Frame profiling: charge CPU and DMA time to their own counters */
+#define m68k_run(cycles)        PROFILE_CALL(PROF_M68K, m68k_run(cycles))
+#define z80_run(cycles)         PROFILE_CALL(PROF_Z80, z80_run(cycles))
+#define vdp_dma_update(cycles)  PROFILE_CALL(PROF_DMA, vdp_dma_update(cycles))
+#define ssp1601_run(cycles)     PROFILE_CALL(PROF_SVP, ssp1601_run(cycles))
+#endif
+
 /* Global variables */
 t_bitmap bitmap;
 t_snd snd;
@@ -50,10 +65,14 @@ uint8 system_hw;
 uint8 system_bios;
 uint32 system_clock;
 int16 SVP_cycles = 800; 
+uint32 vblank_batch_end;
+
+static uint32 vblank_batch_start;
 
 static uint8 pause_b;
 static EQSTATE eq[2];
 static int16 llp,rrp;
+static float lp_l,lp_r;
 
 /******************************************************************************************/
 /* Audio subsystem                                                                        */
@@ -130,6 +149,9 @@ void audio_set_rate(int samplerate, double framerate)
   /* resampled to desired rate at the end of each frame, using Blip Buffer.            */
   blip_set_rates(snd.blips[0], mclk, samplerate);
 
+  /* FM/PSG stems (stem mode only) */
+  sound_stems_set_rates(mclk, samplerate);
+
   /* Mega CD sound hardware */
   if (system_hw == SYSTEM_MCD)
   {
@@ -160,10 +182,13 @@ void audio_reset(void)
       blip_clear(snd.blips[i]);
     }
   }
+  sound_stems_clear();
 
   /* Low-Pass filter */
   llp = 0;
   rrp = 0;
+  lp_l = 0;
+  lp_r = 0;
 
   /* 3 band EQ */
   audio_set_equalizer();
@@ -219,8 +244,15 @@ int audio_update(int16 *buffer)
     size &= ALIGN_SND;
 #endif
 
-    /* resample FM/PSG mixed stream to output buffer */
-    blip_read_samples(snd.blips[0], buffer, size);
+    /* resample FM/PSG mixed stream (or stems) to output buffer */
+    if (sound_stems.active)
+    {
+      sound_stems_read(buffer, size);
+    }
+    else
+    {
+      blip_read_samples(snd.blips[0], buffer, size);
+    }
   }
 
   /* Audio filtering */
@@ -303,6 +335,97 @@ int audio_update(int16 *buffer)
   return size;
 }
 
+/* audio_update() to separate left/right float buffers */
+int audio_update_f32(float *out_l, float *out_r)
+{
+  int i, size;
+  int lowpass = config.filter & 1;
+  int equalizer = (config.filter & 3) == 2;
+  int mono = config.mono;
+  float factora = config.lp_range / 65536.0f;
+  float factorb = 1.0f - factora;
+  float l, r;
+
+  /* run sound chips until end of frame */
+  size = sound_update(mcycles_vdp);
+
+  /* Mega CD specific */
+  if (system_hw == SYSTEM_MCD)
+  {
+    /* sync PCM chip with other sound chips */
+    pcm_update(size);
+
+    /* read CDDA samples */
+    cdd_read_audio(size);
+
+#ifdef ALIGN_SND
+    /* return an aligned number of samples if required */
+    size &= ALIGN_SND;
+#endif
+
+    /* resample & mix FM/PSG, PCM & CD-DA streams to float output buffers */
+    blip_mix_samples_f32(snd.blips[0], snd.blips[1], snd.blips[2], out_l, out_r, size);
+  }
+  else
+  {
+#ifdef ALIGN_SND
+    /* return an aligned number of samples if required */
+    size &= ALIGN_SND;
+#endif
+
+    /* resample FM/PSG mixed stream (or stems) to float output buffers */
+    if (sound_stems.active)
+    {
+      sound_stems_read_f32(out_l, out_r, size);
+    }
+    else
+    {
+      blip_read_samples_f32(snd.blips[0], out_l, out_r, size);
+    }
+  }
+
+  if (!lowpass && !equalizer && !mono)
+  {
+    return size;
+  }
+
+  /* Audio filtering & mono output mixing, in a single pass over float samples */
+  for (i = 0; i < size; i++)
+  {
+    l = out_l[i];
+    r = out_r[i];
+
+    if (lowpass)
+    {
+      /* single-pole low-pass filter (6 dB/octave) */
+      lp_l = l = lp_l * factora + l * factorb;
+      lp_r = r = lp_r * factora + r * factorb;
+    }
+    else if (equalizer)
+    {
+      /* 3 Band EQ */
+      l = do_3band_float(&eq[0], l);
+      r = do_3band_float(&eq[1], r);
+
+      /* clipping (16-bit range) */
+      if (l > 32767.0f / 32768.0f) l = 32767.0f / 32768.0f;
+      else if (l < -1.0f) l = -1.0f;
+      if (r > 32767.0f / 32768.0f) r = 32767.0f / 32768.0f;
+      else if (r < -1.0f) r = -1.0f;
+    }
+
+    if (mono)
+    {
+      l = r = (l + r) * 0.5f;
+    }
+
+    out_l[i] = l;
+    out_r[i] = r;
+  }
+
+  return size;
+}
+
 /****************************************************************
  * Virtual System emulation
  ****************************************************************/
@@ -325,10 +448,79 @@ void system_reset(void)
   audio_reset();
 }
 
+/******************************************************************************************/
+/* VBlank line batching                                                                   */
+/******************************************************************************************/
+
+/* nothing but the 68k runs until the next VDP or I/O access: the Z80 is stopped and the
+   SVP and lightguns (which trigger on a given line) are absent. VDP status polling loops
+   are not skipped further than the end of the line either. */
+static int vblank_batch_allowed(void)
+{
+  int i;
+
+  if ((zstate == 1) || svp || (config.idle_skip == M68K_IDLE_VDP))
+  {
+    return 0;
+  }
+
+  for (i = 0; i < MAX_DEVICES; i++)
+  {
+    if (input.dev[i] == DEVICE_LIGHTGUN)
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/* run the 68k from the start of 'line' up to the end of line 'last' - 1, returns the
+   line it stopped on (the last one, or the one the Z80 was restarted on) */
+static int vblank_batch(int line, int last)
+{
+  vblank_batch_start = mcycles_vdp;
+  vblank_batch_end = mcycles_vdp + (last - line) * MCYCLES_PER_LINE;
+  m68k_run(vblank_batch_end);
+
+  /* catch up to the start of the line the batch ended on */
+  vblank_sync(vblank_batch_end - MCYCLES_PER_LINE);
+  vblank_batch_end = 0;
+  return v_counter;
+}
+
+void vblank_sync(unsigned int cycles)
+{
+  /* the per-line updates of the frame loop, for each line the 68k went past */
+  while ((cycles >= (mcycles_vdp + MCYCLES_PER_LINE)) && ((mcycles_vdp + MCYCLES_PER_LINE) < vblank_batch_end))
+  {
+    mcycles_vdp += MCYCLES_PER_LINE;
+    v_counter++;
+    input_refresh();
+  }
+}
+
+void vblank_z80_started(unsigned int cycles)
+{
+  if (vblank_batch_end)
+  {
+    /* the Z80 runs after the 68k on each line from now on */
+    uint32 end = vblank_batch_start + ((cycles - vblank_batch_start) / MCYCLES_PER_LINE + 1) * MCYCLES_PER_LINE;
+    if (end < vblank_batch_end)
+    {
+      vblank_batch_end = end;
+      m68k_end_timeslice(end);
+    }
+  }
+}
+
 void system_frame_gen(int do_skip)
 {
   /* line counters */
-  int start, end, line;
+  int start, end, line, batch_last;
+
+  /* lines are only remapped to the frame buffer when the frame is drawn */
+  render_skipped = do_skip;
 
   /* reset frame cycle counter */
   mcycles_vdp = 0;
@@ -360,12 +552,12 @@ void system_frame_gen(int do_skip)
       {
         if (im2_flag)
         {
-          render_bg = (reg[11] & 0x04) ? render_bg_m5_im2_vs : render_bg_m5_im2;
+          render_bg = render_bg_m5_select();
           render_obj = (reg[12] & 0x08) ? render_obj_m5_im2_ste : render_obj_m5_im2;
         }
         else
         {
-          render_bg = (reg[11] & 0x04) ? render_bg_m5_vs : render_bg_m5;
+          render_bg = render_bg_m5_select();
           render_obj = (reg[12] & 0x08) ? render_obj_m5_ste : render_obj_m5;
         }
       }
@@ -509,6 +701,9 @@ void system_frame_gen(int do_skip)
   start = lines_per_frame - bitmap.viewport.y;
   end = bitmap.viewport.h + bitmap.viewport.y;
 
+  /* VBlank lines can be batched up to the bottom overscan or the last line */
+  batch_last = (start < (lines_per_frame - 1)) ? start : (lines_per_frame - 1);
+
   /* Vertical Blanking */
   do
   {
@@ -524,6 +719,12 @@ void system_frame_gen(int do_skip)
     /* update 6-Buttons & Lightguns */
     input_refresh();
 
+    /* run the 68k through the following lines at once when nothing else happens on them */
+    if ((line >= end) && ((batch_last - line) > 1) && vblank_batch_allowed())
+    {
+      line = vblank_batch(line, batch_last);
+    }
+
     /* run 68k & Z80 until end of line */
     m68k_run(mcycles_vdp + MCYCLES_PER_LINE);
     if (zstate == 1)
@@ -591,14 +792,19 @@ void system_frame_gen(int do_skip)
   /* reset line count */
   line = 0;
 
+  VDP_RUN_FLUSH();
+
 #ifdef WASM_GENPLUS
   /* ChaosDrive: apply CRAM corruption after VBlank DMA but before rendering */
-  { extern void chaos_pre_render_hook(void); chaos_pre_render_hook(); }
+  { extern void chaos_pre_render_hook(void); TELEMETRY_CALL(TELEMETRY_CHAOS, PROFILE_CALL(PROF_CHAOS, chaos_pre_render_hook())); }
 #endif
   
   /* Active Display */
   do
   {
+    /* previous line must be rendered before the VDP moves on (RENDER_THREAD) */
+    RENDER_SYNC();
+
     /* update VCounter */
     v_counter = line;
 
@@ -608,10 +814,28 @@ void system_frame_gen(int do_skip)
       vdp_dma_update(mcycles_vdp);
     }
 
-    /* render scanline */
+#ifdef WASM_GENPLUS
+    /* ChaosDrive: apply raster-timed effects scheduled on this line */
+    {
+      extern int chaos_next_line;
+      extern void chaos_line_hook(int line);
+      if (line == chaos_next_line)
+      {
+        VDP_RUN_FLUSH();
+        TELEMETRY_CALL(TELEMETRY_CHAOS, PROFILE_CALL(PROF_CHAOS, chaos_line_hook(line)));
+      }
+    }
+#endif
+
+    /* render scanline (with the VRAM upload run the 68k left) */
+    VDP_RUN_FLUSH();
     if (!do_skip)
     {
-      render_line(line);
+      TELEMETRY_CALL(TELEMETRY_RENDER, render_line_async(line));
+    }
+    else
+    {
+      skip_line(line);
     }
 
     /* update 6-Buttons & Lightguns */
@@ -655,6 +879,9 @@ void system_frame_gen(int do_skip)
   }
   while (++line < bitmap.viewport.h);
 
+  RENDER_SYNC();
+  VDP_RUN_FLUSH();
+
   /* check viewport changes */
   if (bitmap.viewport.w != bitmap.viewport.ow)
   {
@@ -662,6 +889,8 @@ void system_frame_gen(int do_skip)
     bitmap.viewport.changed |= 1;
   }
 
+  render_skipped = 0;
+
   /* adjust timings for next frame */
   input_end_frame(mcycles_vdp);
   m68k.cycles -= mcycles_vdp;
@@ -673,6 +902,9 @@ void system_frame_scd(int do_skip)
   /* line counters */
   int start, end, line;
 
+  /* lines are only remapped to the frame buffer when the frame is drawn */
+  render_skipped = do_skip;
+
   /* reset frame cycle counter */
   mcycles_vdp = 0;
   scd.cycles = 0;
@@ -704,12 +936,12 @@ void system_frame_scd(int do_skip)
       {
         if (im2_flag)
         {
-          render_bg = (reg[11] & 0x04) ? render_bg_m5_im2_vs : render_bg_m5_im2;
+          render_bg = render_bg_m5_select();
           render_obj = (reg[12] & 0x08) ? render_obj_m5_im2_ste : render_obj_m5_im2;
         }
         else
         {
-          render_bg = (reg[11] & 0x04) ? render_bg_m5_vs : render_bg_m5;
+          render_bg = render_bg_m5_select();
           render_obj = (reg[12] & 0x08) ? render_obj_m5_ste : render_obj_m5;
         }
       }
@@ -935,10 +1167,15 @@ void system_frame_scd(int do_skip)
       vdp_dma_update(mcycles_vdp);
     }
 
-    /* render scanline */
+    /* render scanline (with the VRAM upload run the 68k left) */
+    VDP_RUN_FLUSH();
     if (!do_skip)
     {
-      render_line(line);
+      TELEMETRY_CALL(TELEMETRY_RENDER, render_line(line));
+    }
+    else
+    {
+      skip_line(line);
     }
     
     /* update 6-Buttons & Lightguns */
@@ -985,6 +1222,10 @@ void system_frame_scd(int do_skip)
     bitmap.viewport.changed |= 1;
   }
   
+  render_skipped = 0;
+
+  VDP_RUN_FLUSH();
+
   /* adjust timings for next frame */
   scd_end_frame(scd.cycles);
   input_end_frame(mcycles_vdp);
@@ -997,6 +1238,9 @@ void system_frame_sms(int do_skip)
   /* line counter */
   int start, end, line;
 
+  /* lines are only remapped to the frame buffer when the frame is drawn */
+  render_skipped = do_skip;
+
   /* reset frame cycle count */
   mcycles_vdp = 0;
 
@@ -1031,12 +1275,12 @@ void system_frame_sms(int do_skip)
         {
           if (im2_flag)
           {
-            render_bg = (reg[11] & 0x04) ? render_bg_m5_im2_vs : render_bg_m5_im2;
+            render_bg = render_bg_m5_select();
             render_obj = (reg[12] & 0x08) ? render_obj_m5_im2_ste : render_obj_m5_im2;
           }
           else
           {
-            render_bg = (reg[11] & 0x04) ? render_bg_m5_vs : render_bg_m5;
+            render_bg = render_bg_m5_select();
             render_obj = (reg[12] & 0x08) ? render_obj_m5_ste : render_obj_m5;
           }
         }
@@ -1280,6 +1524,7 @@ void system_frame_sms(int do_skip)
 
   /* 3-D glasses faking: skip rendering of left lens frame */
   do_skip |= (work_ram[0x1ffb] & cart.special & HW_3D_GLASSES);
+  render_skipped = do_skip;
 
   /* Mega Drive VDP specific */
   if (system_hw & SYSTEM_MD)
@@ -1322,6 +1567,11 @@ void system_frame_sms(int do_skip)
   /* reset line count */
   line = 0;
 
+#ifdef WASM_GENPLUS
+  /* ChaosDrive: trimmed hooks, no FM or Mode 5 palette effects */
+  { extern void chaos_pre_render_hook_sms(void); TELEMETRY_CALL(TELEMETRY_CHAOS, PROFILE_CALL(PROF_CHAOS, chaos_pre_render_hook_sms())); }
+#endif
+
   /* Active Display */
   do
   {
@@ -1331,6 +1581,18 @@ void system_frame_sms(int do_skip)
       vdp_dma_update(mcycles_vdp);
     }
 
+#ifdef WASM_GENPLUS
+    /* ChaosDrive: apply raster-timed effects scheduled on this line */
+    {
+      extern int chaos_next_line;
+      extern void chaos_line_hook(int line);
+      if (line == chaos_next_line)
+      {
+        TELEMETRY_CALL(TELEMETRY_CHAOS, PROFILE_CALL(PROF_CHAOS, chaos_line_hook(line)));
+      }
+    }
+#endif
+
     /* make sure that line has not already been rendered */
     if (v_counter != line)
     {
@@ -1340,7 +1602,11 @@ void system_frame_sms(int do_skip)
       /* render scanline */
       if (!do_skip)
       {
-        render_line(line);
+        TELEMETRY_CALL(TELEMETRY_RENDER, render_line(line));
+      }
+      else
+      {
+        skip_line(line);
       }
     }
 
@@ -1391,6 +1657,8 @@ void system_frame_sms(int do_skip)
     bitmap.viewport.changed |= 1;
   }
 
+  render_skipped = 0;
+
   /* adjust timings for next frame */
   input_end_frame(mcycles_vdp);
   Z80.cycles -= mcycles_vdp;
@@ -104,12 +104,21 @@ extern uint8 system_hw;
 extern uint8 system_bios;
 extern uint32 system_clock;
 
+/* VBlank lines where only the 68k runs are run in one go by system_frame_gen():
+   the VDP line counters and per-line input updates catch up on the next VDP or
+   I/O access, and restarting the Z80 ends the batch at the end of its line */
+extern uint32 vblank_batch_end;
+extern void vblank_sync(unsigned int cycles);
+extern void vblank_z80_started(unsigned int cycles);
+#define VBLANK_SYNC(cycles) if (vblank_batch_end) vblank_sync(cycles)
+
 /* Function prototypes */
 extern int audio_init(int samplerate, double framerate);
 extern void audio_set_rate(int samplerate, double framerate);
 extern void audio_reset(void);
 extern void audio_shutdown(void);
 extern int audio_update(int16 *buffer);
+extern int audio_update_f32(float *out_l, float *out_r);
 extern void audio_set_equalizer(void);
 extern void system_init(void);
 extern void system_reset(void);
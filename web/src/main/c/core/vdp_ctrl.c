@@ -42,9 +42,18 @@
 #include "shared.h"
 #include "hvc.h"
 
+#ifdef WASM_GENPLUS
+#include "profile.h"
+#include "gpu_log.h"
+#else
+#define PROFILE_COUNT(id, n)
+#define GPU_LOG_INVALIDATE()
+#endif
+
 /* Mark a pattern as modified */
 #define MARK_BG_DIRTY(addr)                         \
 {                                                   \
+  GPU_LOG_INVALIDATE();                             \
   name = (addr >> 5) & 0x7FF;                       \
   if (bg_name_dirty[name] == 0)                     \
   {                                                 \
@@ -53,6 +62,23 @@
   bg_name_dirty[name] |= (1 << ((addr >> 2) & 7));  \
 }
 
+/* Write to a protected VRAM pattern, CRAM color or VSRAM word */
+#define VDP_PROTECTED(t, mask, index) ((vdp_protect & (t)) && (mask)[index])
+
+/* Append a record to the VDP write log */
+#define VDP_LOG(t, s, a, d)                                                   \
+{                                                                             \
+  if (vdp_log_users)                                                          \
+  {                                                                           \
+    vdp_log_t *entry = &vdp_log[vdp_log_count++ & (VDP_LOG_SIZE - 1)];        \
+    entry->target = (t);                                                      \
+    entry->step = (s);                                                        \
+    entry->addr = (a);                                                        \
+    entry->data = (d);                                                        \
+    entry->line = v_counter;                                                  \
+  }                                                                           \
+}
+
 /* VDP context */
 uint8 ALIGNED_(4) sat[0x400];    /* Internal copy of sprite attribute table */
 uint8 ALIGNED_(4) vram[0x10000]; /* Video RAM (64K x 8-bit) */
@@ -92,6 +118,17 @@ uint32 fifo_slots;                /* VDP FIFO access slot count */
 uint32 hvc_latch;                 /* latched HV counter */
 const uint8 *hctab;               /* pointer to H Counter table */
 
+/* VDP write log */
+uint8 vdp_log_users;              /* consumer bits, nothing is logged when 0 */
+uint32 vdp_log_count;             /* records since the consumers last cleared it */
+vdp_log_t vdp_log[VDP_LOG_SIZE];  /* last VDP_LOG_SIZE records */
+
+/* Write protection (vdp_ctrl.h) */
+uint8 vdp_protect;                /* VDP_PROTECT_xxx bits, nothing is checked when 0 */
+uint8 vdp_protect_vram[0x800];    /* 1: pattern protected */
+uint8 vdp_protect_cram[0x40];     /* 1: color protected */
+uint8 vdp_protect_vsram[0x40];    /* 1: word protected */
+
 /* Function pointers */
 void (*vdp_68k_data_w)(unsigned int data);
 void (*vdp_z80_data_w)(unsigned int data);
@@ -113,11 +150,16 @@ static void vdp_z80_data_w_sg(unsigned int data);
 static void vdp_bus_w(unsigned int data);
 static void vdp_fifo_update(unsigned int cycles);
 static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles);
+static int vdp_dma_vram_direct(void);
+static unsigned int vdp_dma_vram_words(uint32 source, unsigned int length);
+static void vdp_dma_vram_block(const uint8 *src, unsigned int words);
 static void vdp_dma_68k_ext(unsigned int length);
 static void vdp_dma_68k_ram(unsigned int length);
 static void vdp_dma_68k_io(unsigned int length);
 static void vdp_dma_copy(unsigned int length);
 static void vdp_dma_fill(unsigned int length);
+static void vdp_dma_glitch_run(unsigned int length);
+static void vdp_run_store(void);
 
 /* Tables that define the playfield layout */
 static const uint8 hscroll_mask_table[] = { 0x00, 0x07, 0xF8, 0xFF };
@@ -137,6 +179,13 @@ static uint16 dma_src;        /* DMA source address */
 static uint32 dma_endCycles;  /* 68k cycles to DMA end */
 static int dmafill;           /* DMA Fill pending flag */
 static int cached_write;      /* 2nd part of 32-bit CTRL port write (Genesis mode) or LSB of CRAM data (Game Gear mode) */
+
+/* 68k VRAM upload run (see vdp_run_flush) */
+#define RUN_WORDS 256
+static uint16 run_buffer[RUN_WORDS]; /* words written from run_start on, not stored yet */
+static uint16 run_start;
+static uint8 run_armed;       /* last data port write was a plain VRAM write */
+uint32 vdp_run_words;
 static uint16 fifo[4];        /* FIFO ring-buffer */
 static int fifo_idx;          /* FIFO write index */
 static int fifo_byte_access;  /* FIFO byte access flag */
@@ -178,8 +227,9 @@ static const uint8 dma_timing[2][2] =
   {166, 204}  /* blank display */
 };
 
-/* DMA processing functions (set by VDP register 23 high nibble) */
-static void (*const dma_func[16])(unsigned int length) =
+/* DMA processing functions (set by VDP register 23 high nibble), the
+   entries swapped for vdp_dma_glitch_run() while a DMA glitch is armed */
+static void (*dma_func[16])(unsigned int length) =
 {
   /* 0x0-0x3 : DMA from 68k bus $000000-$7FFFFF (external area) */
   vdp_dma_68k_ext,vdp_dma_68k_ext,vdp_dma_68k_ext,vdp_dma_68k_ext,
@@ -194,6 +244,13 @@ static void (*const dma_func[16])(unsigned int length) =
   vdp_dma_copy,vdp_dma_copy,vdp_dma_copy,vdp_dma_copy
 };
 
+/* DMA glitch (vdp_ctrl.h) */
+static void (*dma_func_normal[16])(unsigned int length); /* dma_func entries while armed */
+static uint8 dma_glitch_armed;
+static int dma_glitch_source;
+static int dma_glitch_dest;
+static unsigned int dma_glitch_keep = 256;
+
 /* BG rendering functions */
 static void (*const render_bg_modes[16])(int line) =
 {
@@ -244,6 +301,7 @@ void vdp_reset(void)
   int i;
 
   memset ((char *) sat, 0, sizeof (sat));
+  obj_index_dirty = 1;
   memset ((char *) vram, 0, sizeof (vram));
   memset ((char *) cram, 0, sizeof (cram));
   memset ((char *) vsram, 0, sizeof (vsram));
@@ -291,6 +349,10 @@ void vdp_reset(void)
   memset ((char *) bg_name_dirty, 0, sizeof (bg_name_dirty));
   memset ((char *) bg_name_list, 0, sizeof (bg_name_list));
 
+  /* drop any VRAM upload run */
+  vdp_run_words = 0;
+  run_armed = 0;
+
   /* default Window clipping */
   window_clip(0,0);
 
@@ -440,6 +502,8 @@ int vdp_context_save(uint8 *state)
 {
   int bufferptr = 0;
 
+  VDP_RUN_FLUSH();
+
   save_param(sat, sizeof(sat));
   save_param(vram, sizeof(vram));
   save_param(cram, sizeof(cram));
@@ -449,6 +513,7 @@ int vdp_context_save(uint8 *state)
   save_param(&addr_latch, sizeof(addr_latch));
   save_param(&code, sizeof(code));
   save_param(&pending, sizeof(pending));
+  spr_col_latch();
   save_param(&status, sizeof(status));
   save_param(&dmafill, sizeof(dmafill));
   save_param(&fifo_idx, sizeof(fifo_idx));
@@ -463,18 +528,10 @@ int vdp_context_save(uint8 *state)
   return bufferptr;
 }
 
-int vdp_context_load(uint8 *state)
+void vdp_restore_regs(const uint8 *regs)
 {
-  int i, bufferptr = 0;
-  uint8 temp_reg[0x20];
-
-  load_param(sat, sizeof(sat));
-  load_param(vram, sizeof(vram));
-  load_param(cram, sizeof(cram));
-  load_param(vsram, sizeof(vsram));
-  load_param(temp_reg, sizeof(temp_reg));
+  int i;
 
-  /* restore VDP registers */
   if (system_hw < SYSTEM_MD)
   {
     if (system_hw >= SYSTEM_MARKIII)
@@ -482,7 +539,7 @@ int vdp_context_load(uint8 *state)
       for (i=0;i<0x10;i++) 
       {
         pending = 1;
-        addr_latch = temp_reg[i];
+        addr_latch = regs[i];
         vdp_sms_ctrl_w(0x80 | i);
       }
     }
@@ -491,7 +548,7 @@ int vdp_context_load(uint8 *state)
       /* TMS-99xx registers are updated directly to prevent spurious 4K->16K VRAM switching */
       for (i=0;i<0x08;i++) 
       {
-        reg[i] = temp_reg[i];
+        reg[i] = regs[i];
       }
 
       /* Rendering mode */
@@ -502,15 +559,36 @@ int vdp_context_load(uint8 *state)
   {
     for (i=0;i<0x20;i++) 
     {
-      vdp_reg_w(i, temp_reg[i], 0);
+      vdp_reg_w(i, regs[i], 0);
     }
   }
+}
+
+int vdp_context_load(uint8 *state)
+{
+  int i, bufferptr = 0;
+  uint8 temp_reg[0x20];
+
+  /* the run was written to the VRAM being replaced */
+  vdp_run_words = 0;
+  run_armed = 0;
+
+  load_param(sat, sizeof(sat));
+  obj_index_dirty = 1;
+  load_param(vram, sizeof(vram));
+  load_param(cram, sizeof(cram));
+  load_param(vsram, sizeof(vsram));
+  load_param(temp_reg, sizeof(temp_reg));
+
+  /* restore VDP registers */
+  vdp_restore_regs(temp_reg);
 
   load_param(&addr, sizeof(addr));
   load_param(&addr_latch, sizeof(addr_latch));
   load_param(&code, sizeof(code));
   load_param(&pending, sizeof(pending));
   load_param(&status, sizeof(status));
+  spr_hit = 0;
   load_param(&dmafill, sizeof(dmafill));
   load_param(&fifo_idx, sizeof(fifo_idx));
   load_param(&fifo, sizeof(fifo));
@@ -575,6 +653,10 @@ void vdp_dma_update(unsigned int cycles)
 {
   unsigned int dma_cycles, dma_bytes;
 
+  /* VDP state changes must not be seen by a line still being rendered (RENDER_THREAD) */
+  RENDER_SYNC();
+  VDP_RUN_FLUSH();
+
   /* DMA transfer rate (bytes per line) 
 
       DMA Mode      Width       Display      Transfer Count
@@ -638,6 +720,7 @@ void vdp_dma_update(unsigned int cycles)
   {
     /* 68K is frozen during DMA from 68k bus */
     m68k.cycles = cycles + dma_cycles;
+    PROFILE_COUNT(VDP_DMA_STALL, dma_cycles);
 #ifdef LOGVDP
     error("-->CPU frozen for %d cycles\n", dma_cycles);
 #endif
@@ -691,6 +774,15 @@ void vdp_dma_update(unsigned int cycles)
 
 void vdp_68k_ctrl_w(unsigned int data)
 {
+  PROFILE_COUNT(VDP_CTRL_WRITES, 1);
+
+  RENDER_SYNC();
+  VBLANK_SYNC(m68k.cycles);
+
+  /* code, address, increment or DMA may change: the run ends here */
+  VDP_RUN_FLUSH();
+  run_armed = 0;
+
   /* Check pending flag */
   if (pending == 0)
   {
@@ -839,6 +931,12 @@ void vdp_68k_ctrl_w(unsigned int data)
 /* Mega Drive VDP control port specific (MS compatibility mode) */
 void vdp_z80_ctrl_w(unsigned int data)
 {
+  PROFILE_COUNT(VDP_CTRL_WRITES, 1);
+
+  RENDER_SYNC();
+  VDP_RUN_FLUSH();
+  run_armed = 0;
+
   switch (pending)
   {
     case 0:
@@ -963,6 +1061,10 @@ void vdp_z80_ctrl_w(unsigned int data)
 /* Master System & Game Gear VDP control port specific */
 void vdp_sms_ctrl_w(unsigned int data)
 {
+  PROFILE_COUNT(VDP_CTRL_WRITES, 1);
+
+  RENDER_SYNC();
+
   if (pending == 0)
   {
     /* Update address register LSB */
@@ -1086,6 +1188,10 @@ void vdp_sms_ctrl_w(unsigned int data)
 /* SG-1000 VDP (TMS99xx) control port specific */
 void vdp_tms_ctrl_w(unsigned int data)
 {
+  PROFILE_COUNT(VDP_CTRL_WRITES, 1);
+
+  RENDER_SYNC();
+
   if (pending == 0)
   {
     /* Latch LSB */
@@ -1151,6 +1257,11 @@ unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 {
   unsigned int temp;
 
+  PROFILE_COUNT(VDP_STATUS_READS, 1);
+
+  RENDER_SYNC();
+  VBLANK_SYNC(cycles);
+
   /* Cycle-accurate VDP status read (adjust CPU time with current instruction execution time) */
   cycles += m68k_cycles();
 
@@ -1171,6 +1282,9 @@ unsigned int vdp_68k_ctrl_r(unsigned int cycles)
     }
   }
 
+  /* Sprite collision recorded since last read */
+  spr_col_latch();
+
   /* Return VDP status */
   temp = status;
 
@@ -1214,6 +1328,10 @@ unsigned int vdp_z80_ctrl_r(unsigned int cycles)
 {
   unsigned int temp;
 
+  PROFILE_COUNT(VDP_STATUS_READS, 1);
+
+  RENDER_SYNC();
+
   /* Check if DMA busy flag is set (Mega Drive VDP specific) */
   if (status & 2)
   {
@@ -1254,6 +1372,9 @@ unsigned int vdp_z80_ctrl_r(unsigned int cycles)
     }
   }
 
+  /* Sprite collision recorded since last read */
+  spr_col_latch();
+
   /* Return VDP status */
   temp = status;
 
@@ -1329,6 +1450,8 @@ unsigned int vdp_hvc_r(unsigned int cycles)
   int vc;
   unsigned int data = hvc_latch;
 
+  VBLANK_SYNC(cycles);
+
   /* Check if HVC latch is enabled */
   if (data)
   {
@@ -1404,6 +1527,8 @@ void vdp_test_w(unsigned int data)
 
 int vdp_68k_irq_ack(int int_level)
 {
+  RENDER_SYNC();
+
 #ifdef LOGVDP
   error("[%d(%d)][%d(%d)] INT Level %d ack (%x)\n", v_counter, (v_counter + (m68k.cycles - mcycles_vdp)/MCYCLES_PER_LINE)%lines_per_frame, m68k.cycles, m68k.cycles%MCYCLES_PER_LINE,int_level, m68k_get_reg(M68K_REG_PC));
 #endif
@@ -1415,6 +1540,8 @@ int vdp_68k_irq_ack(int int_level)
     error("---> VINT cleared\n");
 #endif
 
+    PROFILE_COUNT(VDP_VINT, 1);
+
     /* Clear VINT pending flag */
     vint_pending = 0;
     status &= ~0x80;
@@ -1435,6 +1562,8 @@ int vdp_68k_irq_ack(int int_level)
     error("---> HINT cleared\n");
 #endif
 
+    PROFILE_COUNT(VDP_HINT, 1);
+
     /* Clear HINT pending flag */
     hint_pending = 0;
 
@@ -1462,6 +1591,8 @@ static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles)
     return;
   }
 
+  VDP_LOG(VDP_LOG_REG, 0, r, d);
+
   switch(r)
   {
     case 0: /* CTRL #1 */
@@ -1686,12 +1817,12 @@ static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles)
             update_bg_pattern_cache = update_bg_pattern_cache_m5;
             if (im2_flag)
             {
-              render_bg = (reg[11] & 0x04) ? render_bg_m5_im2_vs : render_bg_m5_im2;
+              render_bg = render_bg_m5_select();
               render_obj = (reg[12] & 0x08) ? render_obj_m5_im2_ste : render_obj_m5_im2;
             }
             else
             {
-              render_bg = (reg[11] & 0x04) ? render_bg_m5_vs : render_bg_m5;
+              render_bg = render_bg_m5_select();
               render_obj = (reg[12] & 0x08) ? render_obj_m5_ste : render_obj_m5;
             }
 
@@ -1900,14 +2031,7 @@ static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles)
       hscroll_mask = hscroll_mask_table[d & 0x03];
 
       /* Vertical Scrolling mode */
-      if (d & 0x04)
-      {
-        render_bg = im2_flag ? render_bg_m5_im2_vs : render_bg_m5_vs;
-      }
-      else
-      {
-        render_bg = im2_flag ? render_bg_m5_im2 : render_bg_m5;
-      }
+      render_bg = render_bg_m5_select();
       break;
     }
 
@@ -2040,6 +2164,9 @@ static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles)
       playfield_shift = shift_table[(d & 3)];
       playfield_col_mask = col_mask_table[(d & 3)];
       playfield_row_mask = row_mask_table[(d >> 4) & 3];
+
+      /* Renderer specialized on plane width */
+      render_bg = render_bg_m5_select();
       break;
     }
 
@@ -2142,17 +2269,28 @@ static void vdp_bus_w(unsigned int data)
       /* Pointer to VRAM */
       uint16 *p = (uint16 *)&vram[index];
 
+      /* Protected pattern */
+      if (VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, index >> 5))
+      {
+        break;
+      }
+
       /* Byte-swap data if A0 is set */
       if (addr & 1)
       {
         data = ((data >> 8) | (data << 8)) & 0xFFFF;
       }
 
+      VDP_LOG(VDP_LOG_VRAM, 0, index, data);
+
       /* Intercept writes to Sprite Attribute Table */
       if ((index & sat_base_mask) == satb)
       {
         /* Update internal SAT */
         *(uint16 *) &sat[index & sat_addr_mask] = data;
+
+        /* Y position, size & link words are indexed by line */
+        obj_index_dirty |= !(index & 4);
       }
 
       /* Only write unique data to VRAM */
@@ -2183,9 +2321,17 @@ static void vdp_bus_w(unsigned int data)
       /* Pointer to CRAM 9-bit word */
       uint16 *p = (uint16 *)&cram[addr & 0x7E];
 
+      /* Protected color */
+      if (VDP_PROTECTED(VDP_PROTECT_CRAM, vdp_protect_cram, (addr >> 1) & 0x3F))
+      {
+        break;
+      }
+
       /* Pack 16-bit bus data (BBB0GGG0RRR0) to 9-bit CRAM data (BBBGGGRRR) */
       data = ((data & 0xE00) >> 3) | ((data & 0x0E0) >> 2) | ((data & 0x00E) >> 1);
 
+      VDP_LOG(VDP_LOG_CRAM, 0, addr & 0x7E, data);
+
       /* Check if CRAM data is being modified */
       if (data != *p)
       {
@@ -2229,8 +2375,16 @@ static void vdp_bus_w(unsigned int data)
 
     case 0x05:  /* VSRAM */
     {
+      /* Protected word */
+      if (VDP_PROTECTED(VDP_PROTECT_VSRAM, vdp_protect_vsram, (addr >> 1) & 0x3F))
+      {
+        break;
+      }
+
       *(uint16 *)&vsram[addr & 0x7E] = data;
 
+      VDP_LOG(VDP_LOG_VSRAM, 0, addr & 0x7E, data);
+
       /* 2-cell Vscroll mode */
       if (reg[11] & 0x04)
       {
@@ -2275,6 +2429,11 @@ static void vdp_bus_w(unsigned int data)
 
 static void vdp_68k_data_w_m4(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+  VBLANK_SYNC(m68k.cycles);
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2299,6 +2458,8 @@ static void vdp_68k_data_w_m4(unsigned int data)
     else
     {
       /* CPU is halted until next FIFO entry processing */
+      PROFILE_COUNT(VDP_FIFO_STALLS, 1);
+      PROFILE_COUNT(VDP_FIFO_WAIT, fifo_cycles - m68k.cycles);
       m68k.cycles = fifo_cycles;
 
       /* Update FIFO access slot counter */
@@ -2367,9 +2528,35 @@ static void vdp_68k_data_w_m4(unsigned int data)
 
 static void vdp_68k_data_w_m5(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+  VBLANK_SYNC(m68k.cycles);
+
   /* Clear pending flag */
   pending = 0;
 
+  /* Next word of a VRAM upload outside active display (no FIFO timing):
+     buffered, stored in bulk when the run ends (see vdp_run_flush) */
+  if (run_armed && ((status & 8) || !(reg[1] & 0x40)) && vdp_dma_vram_direct())
+  {
+    if (!vdp_run_words)
+    {
+      run_start = addr;
+    }
+    run_buffer[vdp_run_words++] = data;
+    addr += 2;
+
+    /* full, or at the end of VRAM */
+    if ((vdp_run_words == RUN_WORDS) || !addr)
+    {
+      vdp_run_store();
+    }
+    return;
+  }
+
+  VDP_RUN_FLUSH();
+
   /* Restricted VDP writes during active display */
   if (!(status & 8) && (reg[1] & 0x40))
   {
@@ -2391,6 +2578,8 @@ static void vdp_68k_data_w_m5(unsigned int data)
     else
     {
       /* CPU is halted until next FIFO entry processing (Chaos Engine / Soldiers of Fortune, Double Clutch, Titan Overdrive Demo) */
+      PROFILE_COUNT(VDP_FIFO_STALLS, 1);
+      PROFILE_COUNT(VDP_FIFO_WAIT, fifo_cycles - m68k.cycles);
       m68k.cycles = fifo_cycles;
 
       /* Update FIFO access slot counter */
@@ -2401,6 +2590,9 @@ static void vdp_68k_data_w_m5(unsigned int data)
   /* Write data */
   vdp_bus_w(data);
 
+  /* the words that follow this one may be buffered */
+  run_armed = !dmafill && vdp_dma_vram_direct();
+
   /* Check if DMA Fill is pending */
   if (dmafill)
   {
@@ -2426,6 +2618,8 @@ static unsigned int vdp_68k_data_r_m4(void)
   /* VRAM address (interleaved format) */
   int index = ((addr << 1) & 0x3FC) | ((addr & 0x200) >> 8) | (addr & 0x3C00);
 
+  PROFILE_COUNT(VDP_DATA_READS, 1);
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2440,6 +2634,10 @@ static unsigned int vdp_68k_data_r_m5(void)
 {
   uint16 data = 0;
 
+  PROFILE_COUNT(VDP_DATA_READS, 1);
+
+  VDP_RUN_FLUSH();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2556,6 +2754,10 @@ static unsigned int vdp_68k_data_r_m5(void)
 
 static void vdp_z80_data_w_m4(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2608,6 +2810,11 @@ static void vdp_z80_data_w_m4(unsigned int data)
 
 static void vdp_z80_data_w_m5(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+  VDP_RUN_FLUSH();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2623,11 +2830,18 @@ static void vdp_z80_data_w_m5(unsigned int data)
       /* VRAM address (write low byte to even address & high byte to odd address) */
       int index = addr ^ 1;
 
+      /* Protected pattern */
+      if (VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, index >> 5))
+      {
+        break;
+      }
+
       /* Intercept writes to Sprite Attribute Table */
       if ((index & sat_base_mask) == satb)
       {
         /* Update internal SAT */
         WRITE_BYTE(sat, index & sat_addr_mask, data);
+        obj_index_dirty |= !(index & 4);
       }
 
       /* Only write unique data to VRAM */
@@ -2649,6 +2863,12 @@ static void vdp_z80_data_w_m5(unsigned int data)
       /* Pointer to CRAM word */
       uint16 *p = (uint16 *)&cram[addr & 0x7E];
 
+      /* Protected color */
+      if (VDP_PROTECTED(VDP_PROTECT_CRAM, vdp_protect_cram, (addr >> 1) & 0x3F))
+      {
+        break;
+      }
+
       /* Pack 8-bit value into 9-bit CRAM data */
       if (addr & 1)
       {
@@ -2688,8 +2908,11 @@ static void vdp_z80_data_w_m5(unsigned int data)
 
     case 0x05: /* VSRAM */
     {
-      /* Write low byte to even address & high byte to odd address */
-      WRITE_BYTE(vsram, (addr & 0x7F) ^ 1, data);
+      /* Write low byte to even address & high byte to odd address (unless protected) */
+      if (!VDP_PROTECTED(VDP_PROTECT_VSRAM, vdp_protect_vsram, (addr >> 1) & 0x3F))
+      {
+        WRITE_BYTE(vsram, (addr & 0x7F) ^ 1, data);
+      }
       break;
     }
   }
@@ -2719,6 +2942,8 @@ static void vdp_z80_data_w_m5(unsigned int data)
 
 static unsigned int vdp_z80_data_r_m4(void)
 {
+  PROFILE_COUNT(VDP_DATA_READS, 1);
+
   /* Read buffer */
   unsigned int data = fifo[0];
 
@@ -2739,6 +2964,10 @@ static unsigned int vdp_z80_data_r_m5(void)
 {
   unsigned int data = 0;
 
+  PROFILE_COUNT(VDP_DATA_READS, 1);
+
+  VDP_RUN_FLUSH();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2792,6 +3021,10 @@ static unsigned int vdp_z80_data_r_m5(void)
 
 static void vdp_z80_data_w_ms(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2868,6 +3101,10 @@ static void vdp_z80_data_w_ms(unsigned int data)
 
 static void vdp_z80_data_w_gg(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
+  RENDER_SYNC();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2954,9 +3191,13 @@ static void vdp_z80_data_w_gg(unsigned int data)
 
 static void vdp_z80_data_w_sg(unsigned int data)
 {
+  PROFILE_COUNT(VDP_DATA_WRITES, 1);
+
   /* VRAM address */
   int index = addr & 0x3FFF;
 
+  RENDER_SYNC();
+
   /* Clear pending flag */
   pending = 0;
 
@@ -2975,14 +3216,256 @@ static void vdp_z80_data_w_sg(unsigned int data)
 /* DMA operations (Mega Drive VDP only)                                     */
 /*--------------------------------------------------------------------------*/
 
+/* 68k bus DMA to VRAM with auto-increment 2 from an even address: source
+   words are stored the way they land in VRAM, so a whole block is compared
+   and copied one pattern row (4 bytes) at a time, skipping unchanged
+   patterns, and each modified row is marked once. Byte-swapped (odd
+   address) or other increments, CRAM, VSRAM and the CPU hook go through
+   vdp_bus_w() word by word. DMA timings are not affected (vdp_dma_update).
+*/
+static int vdp_dma_vram_direct(void)
+{
+#ifdef HOOK_CPU
+  if (cpu_hook)
+    return 0;
+#endif
+  return ((code & 0x0F) == 0x01) && (reg[15] == 2) && !(addr & 1);
+}
+
+/* words up to the end of the source 64k bank (or 128k window) or of VRAM */
+static unsigned int vdp_dma_vram_words(uint32 source, unsigned int length)
+{
+  unsigned int words = (0x10000 - (source & 0xFFFF)) >> 1;
+
+  if (words > ((0x10000 - addr) >> 1))
+  {
+    words = (0x10000 - addr) >> 1;
+  }
+
+  return (length < words) ? length : words;
+}
+
+static void vdp_dma_vram_block(const uint8 *src, unsigned int words)
+{
+  unsigned int index = addr;
+  unsigned int end = index + (words << 1);
+  unsigned int sat_end = satb + sat_addr_mask + 1;
+  int i, name;
+
+  VDP_LOG(VDP_LOG_VRAM_RUN, 1, index, (words << 1) - 1);
+
+  /* Intercept writes to Sprite Attribute Table */
+  if ((index < sat_end) && (end > satb))
+  {
+    unsigned int a = (index > satb) ? index : satb;
+    unsigned int b = (end < sat_end) ? end : sat_end;
+
+    for (; a < b; a += 2)
+    {
+      /* Protected pattern */
+      if (VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, a >> 5))
+      {
+        continue;
+      }
+
+      /* Update internal SAT */
+      *(uint16 *) &sat[a & sat_addr_mask] = *(const uint16 *)(src + (a - index));
+
+      /* Y position, size & link words are indexed by line */
+      obj_index_dirty |= !(a & 4);
+    }
+  }
+
+  /* last words written stay in the FIFO */
+  for (i = (words > 4) ? (words - 4) : 0; i < (int)words; i++)
+  {
+    fifo[fifo_idx] = ((const uint16 *)src)[i];
+    fifo_idx = (fifo_idx + 1) & 3;
+  }
+
+  while (index < end)
+  {
+    /* protected pattern: skipped up to the next one */
+    if (VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, index >> 5))
+    {
+      unsigned int skip = 32 - (index & 31);
+
+      if (skip > (end - index))
+      {
+        skip = end - index;
+      }
+      index += skip;
+      src += skip;
+    }
+
+    /* unchanged pattern */
+    else if (!(index & 31) && ((end - index) >= 32) && !memcmp(&vram[index], src, 32))
+    {
+      index += 32;
+      src += 32;
+    }
+
+    /* pattern row */
+    else if (!(index & 2) && ((end - index) >= 4))
+    {
+      uint32 data;
+      memcpy(&data, src, 4);
+
+      /* Only write unique data to VRAM */
+      if (data != *(uint32 *)&vram[index])
+      {
+        *(uint32 *)&vram[index] = data;
+
+        /* Update pattern cache */
+        MARK_BG_DIRTY (index);
+      }
+      index += 4;
+      src += 4;
+    }
+
+    /* first or last word of a row */
+    else
+    {
+      uint16 data = *(const uint16 *)src;
+
+      if (data != *(uint16 *)&vram[index])
+      {
+        *(uint16 *)&vram[index] = data;
+        MARK_BG_DIRTY (index);
+      }
+      index += 2;
+      src += 2;
+    }
+  }
+
+  /* Increment address register */
+  addr = end;
+}
+
+/*--------------------------------------------------------------------------*/
+/* 68k VRAM upload runs                                                     */
+/*--------------------------------------------------------------------------*/
+
+/* Tiles are often uploaded with 68k loops (move.l (a0)+,(a1)) rather than
+   DMA. Outside active display a data port write only stores one word, so
+   once a plain VRAM write went through vdp_68k_data_w_m5() (auto-increment
+   2, even address), the words that follow are only buffered, with the
+   address register moving on. The run is stored like a 68k bus DMA block
+   (pattern rows compared and marked dirty once, SAT updated, a single
+   VDP_LOG_VRAM_RUN record) when it is full, and before anything that could
+   see VRAM, the FIFO or the address register: any other VDP port write or
+   data read, DMA, line rendering, chaos hooks, state saves and the end of
+   the frame. Writes during active display (FIFO timing) stay one by one.
+*/
+static void vdp_run_store(void)
+{
+  addr = run_start;
+  vdp_dma_vram_block((const uint8 *)run_buffer, vdp_run_words);
+  vdp_run_words = 0;
+}
+
+void vdp_run_flush(void)
+{
+  /* the render thread does not see the store */
+  RENDER_SYNC();
+  vdp_run_store();
+}
+
+/*--------------------------------------------------------------------------*/
+/* DMA glitches                                                             */
+/*--------------------------------------------------------------------------*/
+
+void vdp_dma_glitch(int source, int dest, int keep)
+{
+  int i, armed;
+
+  if (keep < 1)
+  {
+    keep = 1;
+  }
+  else if (keep > 256)
+  {
+    keep = 256;
+  }
+
+  dma_glitch_source = source;
+  dma_glitch_dest = dest;
+  dma_glitch_keep = keep;
+
+  armed = source || dest || (keep < 256);
+  if (armed == dma_glitch_armed)
+  {
+    return;
+  }
+  dma_glitch_armed = armed;
+
+  if (armed)
+  {
+    memcpy(dma_func_normal, dma_func, sizeof(dma_func));
+    for (i = 0; i < 16; i++)
+    {
+      dma_func[i] = vdp_dma_glitch_run;
+    }
+  }
+  else
+  {
+    memcpy(dma_func, dma_func_normal, sizeof(dma_func));
+  }
+}
+
+/* Each block vdp_dma_update() runs, with the source and destination moved
+   and the end of the block skipped (address and source still moving past
+   it, so what was there stays) */
+static void vdp_dma_glitch_run(unsigned int length)
+{
+  unsigned int keep = (length * dma_glitch_keep) >> 8;
+
+  if (!keep)
+  {
+    keep = 1;
+  }
+
+  dma_src += dma_glitch_source;
+  addr += dma_glitch_dest;
+
+  dma_func_normal[reg[23] >> 4](keep);
+
+  if (length > keep)
+  {
+    dma_src += length - keep;
+    addr += reg[15] * (length - keep);
+  }
+}
+
 /* DMA from 68K bus: $000000-$7FFFFF (external area) */
 static void vdp_dma_68k_ext(unsigned int length)
 {
   uint16 data;
 
+  PROFILE_COUNT(VDP_DMA_EXT, 1);
+  PROFILE_COUNT(VDP_DMA_EXT_LENGTH, length);
+
   /* 68k bus source address */
   uint32 source = (reg[23] << 17) | (dma_src << 1);
 
+  /* VRAM destination: whole blocks from directly mapped banks */
+  while (vdp_dma_vram_direct() && !m68k.memory_map[source>>16].read16)
+  {
+    unsigned int words = vdp_dma_vram_words(source, length);
+
+    vdp_dma_vram_block(m68k.memory_map[source>>16].base + (source & 0xFFFF), words);
+
+    /* 128k DMA window */
+    source = (reg[23] << 17) | ((source + (words << 1)) & 0x1FFFF);
+
+    length -= words;
+    if (!length)
+    {
+      dma_src = (source >> 1) & 0xffff;
+      return;
+    }
+  }
+
   do
   {
     /* Read data word from 68k bus */
@@ -3015,9 +3498,33 @@ static void vdp_dma_68k_ram(unsigned int length)
 {
   uint16 data;
 
+  PROFILE_COUNT(VDP_DMA_RAM, 1);
+  PROFILE_COUNT(VDP_DMA_RAM_LENGTH, length);
+
   /* 68k bus source address */
   uint32 source = (reg[23] << 17) | (dma_src << 1);
 
+  /* VRAM destination: whole blocks */
+  if (vdp_dma_vram_direct())
+  {
+    do
+    {
+      unsigned int words = vdp_dma_vram_words(source, length);
+
+      vdp_dma_vram_block(work_ram + (source & 0xFFFF), words);
+
+      /* 128k DMA window */
+      source = (reg[23] << 17) | ((source + (words << 1)) & 0x1FFFF);
+
+      length -= words;
+    }
+    while (length);
+
+    /* Update DMA source address */
+    dma_src = (source >> 1) & 0xffff;
+    return;
+  }
+
   do
   {
     /* access Work-RAM by default  */
@@ -3043,6 +3550,9 @@ static void vdp_dma_68k_io(unsigned int length)
 {
   uint16 data;
 
+  PROFILE_COUNT(VDP_DMA_IO, 1);
+  PROFILE_COUNT(VDP_DMA_IO_LENGTH, length);
+
   /* 68k bus source address */
   uint32 source = (reg[23] << 17) | (dma_src << 1);
 
@@ -3089,6 +3599,9 @@ static void vdp_dma_68k_io(unsigned int length)
 /*  VRAM Copy */
 static void vdp_dma_copy(unsigned int length)
 {
+  PROFILE_COUNT(VDP_DMA_COPY, 1);
+  PROFILE_COUNT(VDP_DMA_COPY_LENGTH, length);
+
   /* CD4 should be set (CD0-CD3 ignored) otherwise VDP locks (hard reset needed) */
   if (code & 0x10)
   {
@@ -3098,23 +3611,30 @@ static void vdp_dma_copy(unsigned int length)
     /* VRAM source address */
     uint16 source = dma_src;
 
+    VDP_LOG(VDP_LOG_VRAM_RUN, reg[15], addr, length - 1);
+
     do
     {
-      /* Read byte from adjacent VRAM source address */
-      data = READ_BYTE(vram, source ^ 1);
-
-      /* Intercept writes to Sprite Attribute Table */
-      if ((addr & sat_base_mask) == satb)
+      /* Protected destination pattern */
+      if (!VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, addr >> 5))
       {
-        /* Update internal SAT */
-        WRITE_BYTE(sat, (addr & sat_addr_mask) ^ 1, data);
-      }
+        /* Read byte from adjacent VRAM source address */
+        data = READ_BYTE(vram, source ^ 1);
 
-      /* Write byte to adjacent VRAM destination address */
-      WRITE_BYTE(vram, addr ^ 1, data);
+        /* Intercept writes to Sprite Attribute Table */
+        if ((addr & sat_base_mask) == satb)
+        {
+          /* Update internal SAT */
+          WRITE_BYTE(sat, (addr & sat_addr_mask) ^ 1, data);
+          obj_index_dirty |= !(addr & 4);
+        }
 
-      /* Update pattern cache */
-      MARK_BG_DIRTY(addr);
+        /* Write byte to adjacent VRAM destination address */
+        WRITE_BYTE(vram, addr ^ 1, data);
+
+        /* Update pattern cache */
+        MARK_BG_DIRTY(addr);
+      }
 
       /* Increment VRAM source address */
       source++;
@@ -3132,6 +3652,9 @@ static void vdp_dma_copy(unsigned int length)
 /* DMA Fill */
 static void vdp_dma_fill(unsigned int length)
 {
+  PROFILE_COUNT(VDP_DMA_FILL, 1);
+  PROFILE_COUNT(VDP_DMA_FILL_LENGTH, length);
+
   /* Check destination code (CD0-CD3) */
   switch (code & 0x0F)
   {
@@ -3142,20 +3665,27 @@ static void vdp_dma_fill(unsigned int length)
       /* Get source data from last written FIFO  entry */
       uint8 data = fifo[(fifo_idx+3)&3] >> 8;
 
+      VDP_LOG(VDP_LOG_VRAM_RUN, reg[15], addr, length - 1);
+
       do
       {
-        /* Intercept writes to Sprite Attribute Table */
-        if ((addr & sat_base_mask) == satb)
+        /* Protected pattern */
+        if (!VDP_PROTECTED(VDP_PROTECT_VRAM, vdp_protect_vram, addr >> 5))
         {
-          /* Update internal SAT */
-          WRITE_BYTE(sat, (addr & sat_addr_mask) ^ 1, data);
-        }
+          /* Intercept writes to Sprite Attribute Table */
+          if ((addr & sat_base_mask) == satb)
+          {
+            /* Update internal SAT */
+            WRITE_BYTE(sat, (addr & sat_addr_mask) ^ 1, data);
+            obj_index_dirty |= !(addr & 4);
+          }
 
-        /* Write byte to adjacent VRAM address */
-        WRITE_BYTE(vram, addr ^ 1, data);
+          /* Write byte to adjacent VRAM address */
+          WRITE_BYTE(vram, addr ^ 1, data);
 
-        /* Update pattern cache */
-        MARK_BG_DIRTY (addr);
+          /* Update pattern cache */
+          MARK_BG_DIRTY (addr);
+        }
 
         /* Increment VRAM address */
         addr += reg[15];
@@ -3177,8 +3707,8 @@ static void vdp_dma_fill(unsigned int length)
         /* Pointer to CRAM 9-bit word */
         uint16 *p = (uint16 *)&cram[addr & 0x7E];
 
-        /* Check if CRAM data is being modified */
-        if (data != *p)
+        /* Check if CRAM data is being modified (and not protected) */
+        if ((data != *p) && !VDP_PROTECTED(VDP_PROTECT_CRAM, vdp_protect_cram, (addr >> 1) & 0x3F))
         {
           /* CRAM index (64 words) */
           int index = (addr >> 1) & 0x3F;
@@ -3214,8 +3744,11 @@ static void vdp_dma_fill(unsigned int length)
 
       do
       {
-        /* Write VSRAM data */
-        *(uint16 *)&vsram[addr & 0x7E] = data;
+        /* Write VSRAM data (unless protected) */
+        if (!VDP_PROTECTED(VDP_PROTECT_VSRAM, vdp_protect_vsram, (addr >> 1) & 0x3F))
+        {
+          *(uint16 *)&vsram[addr & 0x7E] = data;
+        }
           
         /* Increment VSRAM address */
         addr += reg[15];
@@ -81,6 +81,65 @@ extern uint32 fifo_slots;
 extern uint32 hvc_latch;
 extern const uint8 *hctab;
 
+/* VDP write log: when a consumer sets a bit of vdp_log_users, the Mode 5
+   data port writes (VRAM, CRAM, VSRAM), the VRAM runs written by DMA and the
+   register writes are appended to vdp_log[], the n-th record at
+   [n & (VDP_LOG_SIZE - 1)]. Consumers read it in bulk (once per frame) and
+   clear vdp_log_count; past VDP_LOG_SIZE records the oldest are overwritten.
+*/
+#define VDP_LOG_SIZE 0x1000
+
+#define VDP_LOG_VRAM     0  /* word write, addr: VRAM address (even), data: VRAM word */
+#define VDP_LOG_CRAM     1  /* word write, addr: CRAM address, data: 9-bit color */
+#define VDP_LOG_VSRAM    2  /* word write, addr: VSRAM address, data: VSRAM word */
+#define VDP_LOG_REG      3  /* register write, addr: register, data: value */
+#define VDP_LOG_VRAM_RUN 4  /* DMA: data + 1 bytes, the n-th one at (addr + n * step) ^ 1 */
+
+typedef struct
+{
+  uint8 target;   /* VDP_LOG_xxx */
+  uint8 step;     /* VDP_LOG_VRAM_RUN address increment */
+  uint16 addr;
+  uint16 data;
+  uint16 line;    /* v_counter */
+} vdp_log_t;
+
+extern uint8 vdp_log_users;
+extern uint32 vdp_log_count;
+extern vdp_log_t vdp_log[VDP_LOG_SIZE];
+
+/* Write protection: while a bit of vdp_protect is set, Mode 5 data port and
+   DMA writes to the flagged VRAM patterns (32 bytes each), CRAM colors or
+   VSRAM words are dropped; the FIFO, the address register and DMA timings
+   are unchanged. Set by the chaos layer (chaos_freeze.h) so that a
+   corruption stays without being applied again every frame. */
+#define VDP_PROTECT_VRAM  1
+#define VDP_PROTECT_CRAM  2
+#define VDP_PROTECT_VSRAM 4
+
+extern uint8 vdp_protect;
+extern uint8 vdp_protect_vram[0x800];
+extern uint8 vdp_protect_cram[0x40];
+extern uint8 vdp_protect_vsram[0x40];
+
+/* DMA glitches: while one is armed, every entry of the DMA function table
+   is swapped for a wrapper that moves the source by 'source' (68k words, or
+   bytes for a VRAM copy) and the destination by 'dest' bytes, then runs the
+   normal function on the first 'keep'/256 of the transfer and skips the
+   rest. The offsets apply again to each block of a DMA spread over several
+   lines. The normal functions are put back once everything is at its
+   neutral value (0, 0, 256): DMA costs nothing more when no glitch is set.
+   Set by the chaos layer. */
+extern void vdp_dma_glitch(int source, int dest, int keep);
+
+/* 68k VRAM upload run: words written to the data port and not stored in
+   VRAM yet. VDP_RUN_FLUSH() stores them, before VRAM, the pattern cache or
+   the FIFO are used outside of the VDP port handlers (line rendering, chaos
+   hooks, end of frame). */
+extern uint32 vdp_run_words;
+extern void vdp_run_flush(void);
+#define VDP_RUN_FLUSH() if (vdp_run_words) vdp_run_flush()
+
 /* Function pointers */
 extern void (*vdp_68k_data_w)(unsigned int data);
 extern void (*vdp_z80_data_w)(unsigned int data);
@@ -92,6 +151,7 @@ extern void vdp_init(void);
 extern void vdp_reset(void);
 extern int vdp_context_save(uint8 *state);
 extern int vdp_context_load(uint8 *state);
+extern void vdp_restore_regs(const uint8 *regs);
 extern void vdp_dma_update(unsigned int cycles);
 extern void vdp_68k_ctrl_w(unsigned int data);
 extern void vdp_z80_ctrl_w(unsigned int data);
@@ -43,6 +43,28 @@
 #include "md_ntsc.h"
 #include "sms_ntsc.h"
 
+/* the profile counters are not thread-safe: render stages are not timed
+   separately when lines are rendered on the render thread */
+#if defined(WASM_GENPLUS) && !defined(RENDER_THREAD)
+#include "profile.h"
+#else
+#define PROFILE_CALL(id, call) call
+#endif
+
+#ifdef WASM_GENPLUS
+#include "gpu_log.h"
+#endif
+
+#ifdef RENDER_THREAD
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#endif
+#endif
+
 #ifndef HAVE_NO_SPRITE_LIMIT
 #define MAX_SPRITES_PER_LINE 20
 #define TMS_MAX_SPRITES_PER_LINE 4
@@ -117,6 +139,18 @@ INLINE void WRITE_LONG(void *address, uint32 data)
 #endif  /* ALIGN_LONG */
 
 
+/* Build flipped pattern on first use (Mode 5, see update_bg_flip_cache) */
+#ifdef BG_CACHE_LAZY_FLIP
+#define BG_FLIP_CACHE(OFFSET) \
+  { \
+    uint32 index_ = (OFFSET) >> 6; \
+    if (bg_flip_dirty[index_ & 0x7FF] & (1 << (index_ >> 11))) \
+      update_bg_flip_cache(index_); \
+  }
+#else
+#define BG_FLIP_CACHE(OFFSET)
+#endif
+
 /* Draw 2-cell column (8-pixels high) */
 /*
    Pattern cache base address: VHN NNNNNNNN NNYYYxxx
@@ -129,9 +163,11 @@ INLINE void WRITE_LONG(void *address, uint32 data)
 */
 #define GET_LSB_TILE(ATTR, LINE) \
   atex = atex_table[(ATTR >> 13) & 7]; \
+  BG_FLIP_CACHE((ATTR & 0x00001FFF) << 6) \
   src = (uint32 *)&bg_pattern_cache[(ATTR & 0x00001FFF) << 6 | (LINE)];
 #define GET_MSB_TILE(ATTR, LINE) \
   atex = atex_table[(ATTR >> 29) & 7]; \
+  BG_FLIP_CACHE((ATTR & 0x1FFF0000) >> 10) \
   src = (uint32 *)&bg_pattern_cache[(ATTR & 0x1FFF0000) >> 10 | (LINE)];
 
 /* Draw 2-cell column (16 pixels high) */
@@ -146,9 +182,11 @@ INLINE void WRITE_LONG(void *address, uint32 data)
 */
 #define GET_LSB_TILE_IM2(ATTR, LINE) \
   atex = atex_table[(ATTR >> 13) & 7]; \
+  BG_FLIP_CACHE(((ATTR & 0x000003FF) << 7 | (ATTR & 0x00001800) << 6 | (LINE)) ^ ((ATTR & 0x00001000) >> 6)) \
   src = (uint32 *)&bg_pattern_cache[((ATTR & 0x000003FF) << 7 | (ATTR & 0x00001800) << 6 | (LINE)) ^ ((ATTR & 0x00001000) >> 6)];
 #define GET_MSB_TILE_IM2(ATTR, LINE) \
   atex = atex_table[(ATTR >> 29) & 7]; \
+  BG_FLIP_CACHE(((ATTR & 0x03FF0000) >> 9 | (ATTR & 0x18000000) >> 10 | (LINE)) ^ ((ATTR & 0x10000000) >> 22)) \
   src = (uint32 *)&bg_pattern_cache[((ATTR & 0x03FF0000) >> 9 | (ATTR & 0x18000000) >> 10 | (LINE)) ^ ((ATTR & 0x10000000) >> 22)];
 
 /*
@@ -425,7 +463,7 @@ INLINE void WRITE_LONG(void *address, uint32 data)
     { \
       temp |= (lb[i] << 8); \
       lb[i] = TABLE[temp | ATTR]; \
-      status |= ((temp & 0x8000) >> 10); \
+      hit |= temp; \
     } \
   }
 
@@ -563,6 +601,16 @@ static const uint32 tms_palette[16] =
 /* Cached and flipped patterns */
 static uint8 ALIGNED_(4) bg_pattern_cache[0x80000];
 
+#ifdef BG_CACHE_LAZY_FLIP
+/* Stale flipped patterns (Mode 5), bit n = cache offset n * 0x20000 */
+static uint8 bg_flip_dirty[0x800];
+#endif
+
+#ifdef LSB_FIRST
+/* Byteplane data to pixel pair look-up table (Mode 4 & 5) */
+static uint16 bg_nibble_lut[0x100];
+#endif
+
 /* Sprite pattern name offset look-up table (Mode 5) */
 static uint8 name_lut[0x400];
 
@@ -572,6 +620,30 @@ static uint32 bp_lut[0x10000];
 /* Layer priority pixel look-up tables */
 static uint8 lut[LUT_MAX][LUT_SIZE];
 
+#ifdef WASM_GENPLUS
+/* Mode 5 tables composing the layers differently (render_layers()), and the
+   set the renderers use */
+static uint8 layer_glitch_lut[LUT_MAX - 1][LUT_SIZE];
+static uint8 (*layer_lut)[LUT_SIZE] = lut;
+static int layer_flags;
+
+/* Line cache (render_line_cache()): signature of the inputs each output row
+   was last drawn from, and generation of the inputs the signature does not
+   read (VRAM, palette, layer tables, output mode) */
+#define LINE_CACHE_ROWS 512
+static uint64_t line_cache_sig[LINE_CACHE_ROWS];
+static uint32 line_cache_gen;
+static int line_cache_on;
+static int line_cache_served = -1; /* line kept from the previous frame, not in linebuf */
+static uint32 line_cache_lines;
+static uint32 line_cache_reused;
+#define LINE_CACHE_DIRTY() line_cache_gen++
+#else
+#define layer_lut lut
+#define layer_flags 0
+#define LINE_CACHE_DIRTY()
+#endif
+
 /* Output pixel data look-up tables*/
 static PIXEL_OUT_T pixel[0x100];
 static PIXEL_OUT_T pixel_lut[3][0x200];
@@ -597,9 +669,46 @@ static object_info_t obj_info[2][MAX_SPRITES_PER_LINE];
 /* Sprite Counter */
 static uint8 object_count[2];
 
+/* Sprite line index (Mode 5): the SAT link chain as walked by the VDP, and for
+   each line the chain entries covering it (only as many as can be displayed,
+   plus one for the overflow flag) */
+#define OBJ_INDEX_LINES 256
+
+/* index rebuilds per frame before falling back to walking the chain */
+#define OBJ_INDEX_MAX_BUILDS 4
+
+typedef struct
+{
+  uint16 link;
+  uint16 ypos;
+  uint16 size;
+} object_chain_t;
+
+static object_chain_t obj_chain[80];
+static int obj_chain_count;
+static uint8 obj_index[OBJ_INDEX_LINES][MAX_SPRITES_PER_LINE + 1];
+static uint8 obj_index_count[OBJ_INDEX_LINES];
+static uint32 obj_index_key;
+static int obj_index_builds;
+uint8 obj_index_dirty = 1;
+
+/* Chaos sprite offsets (wasm/chaos_sprite.h), added to the Y position and
+   size of each SAT entry as the line index is built (chaos_sprite_on) and to
+   its X position as it is parsed (zero when unused) */
+extern uint8 chaos_sprite_on;
+extern int16 chaos_sprite_dx[80];
+extern int16 chaos_sprite_dy[80];
+extern uint8 chaos_sprite_size[80];
+
 /* Sprite Collision Info */
 uint16 spr_col;
 
+/* Mode 5 sprite collision (0x20) not yet latched to VDP status, see spr_col_latch() */
+uint8 spr_hit;
+
+/* Frame run without rendering (system_frame_*() do_skip): lines are not remapped */
+uint8 render_skipped;
+
 /* Function pointers */
 void (*render_bg)(int line);
 void (*render_obj)(int line);
@@ -607,6 +716,48 @@ void (*parse_satb)(int line);
 void (*update_bg_pattern_cache)(int index);
 
 
+/*--------------------------------------------------------------------------*/
+/* Flipped pattern cache functions (Mode 5)                                 */
+/*--------------------------------------------------------------------------*/
+
+/* Copy one cached pattern line into its flipped variants */
+/* hflip = reversed byte order, vflip = line (y ^ 7) */
+INLINE void flip_pattern_line(uint8 *dst, uint8 *src, int hflip)
+{
+  if (hflip)
+  {
+    int x;
+    for (x = 0; x < 8; x++)
+    {
+      dst[x] = src[x ^ 7];
+    }
+  }
+  else
+  {
+    *(uint32 *)&dst[0] = *(uint32 *)&src[0];
+    *(uint32 *)&dst[4] = *(uint32 *)&src[4];
+  }
+}
+
+#ifdef BG_CACHE_LAZY_FLIP
+/* Build one flipped pattern (index = VHN NNNNNNNNNN) from the unflipped one */
+static void update_bg_flip_cache(uint32 index)
+{
+  int y;
+  int flip = index >> 11;
+  uint8 *src = &bg_pattern_cache[(index & 0x7FF) << 6];
+  uint8 *dst = &bg_pattern_cache[index << 6];
+
+  for (y = 0; y < 8; y++)
+  {
+    flip_pattern_line(&dst[y << 3], &src[((flip & 2) ? (y ^ 7) : y) << 3], flip & 1);
+  }
+
+  bg_flip_dirty[index & 0x7FF] &= ~(1 << flip);
+}
+#endif
+
+
 /*--------------------------------------------------------------------------*/
 /* Sprite pattern name offset look-up table function (Mode 5)               */
 /*--------------------------------------------------------------------------*/
@@ -1019,6 +1170,11 @@ static void palette_init(void)
 
 void color_update_m4(int index, unsigned int data)
 {
+#ifdef WASM_GENPLUS
+  blit_palette_dirty = 1;
+  LINE_CACHE_DIRTY();
+#endif
+
   switch (system_hw)
   {
     case SYSTEM_GG:
@@ -1118,8 +1274,35 @@ void color_update_m4(int index, unsigned int data)
   }
 }
 
+#ifdef WASM_GENPLUS
+/* Chaos palette layer (wasm/chaos_palette.h): slot showing each CRAM entry
+   and XOR mask of each slot */
+extern uint8 chaos_palette_on;
+extern uint8 chaos_palette_dest[64];
+extern uint16 chaos_palette_xor[64];
+
+/* Chaos per-line palette overrides (wasm/chaos_linepal.h), patched into the
+   pixel table for the blit of each line they cover (remap_line()) */
+extern uint8 chaos_linepal_on;
+extern uint8 chaos_linepal_phase;
+extern uint8 chaos_linepal_count[256];
+extern uint8 chaos_linepal_slot[256][8];
+extern uint16 chaos_linepal_color[256][8];
+#endif
+
 void color_update_m5(int index, unsigned int data)
 {
+#ifdef WASM_GENPLUS
+  blit_palette_dirty = 1;
+  LINE_CACHE_DIRTY();
+
+  if (chaos_palette_on)
+  {
+    index = chaos_palette_dest[index];
+    data ^= chaos_palette_xor[index];
+  }
+#endif
+
   /* Palette Mode */
   if (!(reg[0] & 0x04))
   {
@@ -1506,7 +1689,34 @@ void render_bg_m4(int line)
 
 /* Mode 5 */
 #ifndef ALT_RENDERER
-void render_bg_m5(int line)
+
+/* With BG_M5_SPECIALIZE (speed build), the renderers below are specialized on
+   the plane width (see BG_M5_WIDTHS): the column mask and name table row shift
+   then are constants. Otherwise the variants share one copy of each. */
+#ifdef BG_M5_SPECIALIZE
+#define BG_M5_INLINE static __inline__ __attribute__((always_inline))
+#else
+#define BG_M5_INLINE static
+#endif
+
+/* Chaos scroll offsets (wasm/chaos_scroll.h), added to the scroll values as
+   they are fetched: bit 0 of chaos_scroll_on enables the line offsets, bit 1
+   the column offsets, which need the per-column renderers */
+extern uint8 chaos_scroll_on;
+extern uint8 chaos_scroll_phase;
+extern uint32 chaos_hscroll[256];
+extern uint32 *chaos_scroll_columns(void);
+
+/* add packed plane A/B offsets, each plane wrapping on its own */
+static __inline__ uint32 chaos_scroll_add(uint32 v, uint32 o)
+{
+  return ((v + o) & 0xFFFF) | ((v & 0xFFFF0000) + (o & 0xFFFF0000));
+}
+
+BG_M5_INLINE void render_bg_m5_vs_w(int line, const uint32 pf_col_mask, const uint32 pf_shift);
+BG_M5_INLINE void render_bg_m5_im2_vs_w(int line, const uint32 pf_col_mask, const uint32 pf_shift);
+
+BG_M5_INLINE void render_bg_m5_w(int line, const uint32 pf_col_mask, const uint32 pf_shift)
 {
   int column;
   uint32 atex, atbuf, *src, *dst;
@@ -1514,9 +1724,17 @@ void render_bg_m5(int line)
   /* Common data */
   uint32 xscroll      = *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)];
   uint32 yscroll      = *(uint32 *)&vsram[0];
-  uint32 pf_col_mask  = playfield_col_mask;
   uint32 pf_row_mask  = playfield_row_mask;
-  uint32 pf_shift     = playfield_shift;
+
+  if (chaos_scroll_on & 2)
+  {
+    render_bg_m5_vs_w(line, pf_col_mask, pf_shift);
+    return;
+  }
+  if (chaos_scroll_on & 1)
+  {
+    xscroll = chaos_scroll_add(xscroll, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
 
   /* Window & Plane A */
   int a = (reg[18] & 0x1F) << 3;
@@ -1563,7 +1781,7 @@ void render_bg_m5(int line)
     DRAW_COLUMN(atbuf, v_line)
   }
 
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -1654,10 +1872,10 @@ void render_bg_m5(int line)
   }
 
   /* Merge background layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
 }
 
-void render_bg_m5_vs(int line)
+BG_M5_INLINE void render_bg_m5_vs_w(int line, const uint32 pf_col_mask, const uint32 pf_shift)
 {
   int column;
   uint32 atex, atbuf, *src, *dst;
@@ -1666,11 +1884,18 @@ void render_bg_m5_vs(int line)
   /* Common data */
   uint32 xscroll      = *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)];
   uint32 yscroll      = 0;
-  uint32 pf_col_mask  = playfield_col_mask;
   uint32 pf_row_mask  = playfield_row_mask;
-  uint32 pf_shift     = playfield_shift;
   uint32 *vs          = (uint32 *)&vsram[0];
 
+  if (chaos_scroll_on & 1)
+  {
+    xscroll = chaos_scroll_add(xscroll, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
+  if (chaos_scroll_on & 2)
+  {
+    vs = chaos_scroll_columns();
+  }
+
   /* Window & Plane A */
   int a = (reg[18] & 0x1F) << 3;
   int w = (reg[18] >> 7) & 1;
@@ -1739,7 +1964,7 @@ void render_bg_m5_vs(int line)
     DRAW_COLUMN(atbuf, v_line)
   }
 
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -1844,10 +2069,10 @@ void render_bg_m5_vs(int line)
   }
 
   /* Merge background layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
 }
 
-void render_bg_m5_im2(int line)
+BG_M5_INLINE void render_bg_m5_im2_w(int line, const uint32 pf_col_mask, const uint32 pf_shift)
 {
   int column;
   uint32 atex, atbuf, *src, *dst;
@@ -1856,9 +2081,17 @@ void render_bg_m5_im2(int line)
   int odd = odd_frame;
   uint32 xscroll      = *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)];
   uint32 yscroll      = *(uint32 *)&vsram[0];
-  uint32 pf_col_mask  = playfield_col_mask;
   uint32 pf_row_mask  = playfield_row_mask;
-  uint32 pf_shift     = playfield_shift;
+
+  if (chaos_scroll_on & 2)
+  {
+    render_bg_m5_im2_vs_w(line, pf_col_mask, pf_shift);
+    return;
+  }
+  if (chaos_scroll_on & 1)
+  {
+    xscroll = chaos_scroll_add(xscroll, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
 
   /* Window & Plane A */
   int a = (reg[18] & 0x1F) << 3;
@@ -1905,7 +2138,7 @@ void render_bg_m5_im2(int line)
     DRAW_COLUMN_IM2(atbuf, v_line)
   }
 
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -1996,10 +2229,10 @@ void render_bg_m5_im2(int line)
   }
 
   /* Merge background layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
 }
 
-void render_bg_m5_im2_vs(int line)
+BG_M5_INLINE void render_bg_m5_im2_vs_w(int line, const uint32 pf_col_mask, const uint32 pf_shift)
 {
   int column;
   uint32 atex, atbuf, *src, *dst;
@@ -2009,11 +2242,18 @@ void render_bg_m5_im2_vs(int line)
   int odd = odd_frame;
   uint32 xscroll      = *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)];
   uint32 yscroll      = 0;
-  uint32 pf_col_mask  = playfield_col_mask;
   uint32 pf_row_mask  = playfield_row_mask;
-  uint32 pf_shift     = playfield_shift;
   uint32 *vs          = (uint32 *)&vsram[0];
 
+  if (chaos_scroll_on & 1)
+  {
+    xscroll = chaos_scroll_add(xscroll, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
+  if (chaos_scroll_on & 2)
+  {
+    vs = chaos_scroll_columns();
+  }
+
   /* Window & Plane A */
   int a = (reg[18] & 0x1F) << 3;
   int w = (reg[18] >> 7) & 1;
@@ -2082,7 +2322,7 @@ void render_bg_m5_im2_vs(int line)
     DRAW_COLUMN_IM2(atbuf, v_line)
   }
 
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -2187,9 +2427,35 @@ void render_bg_m5_im2_vs(int line)
   }
 
   /* Merge background layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[(reg[12] & 0x08) >> 2], bitmap.viewport.w);
 }
 
+
+/* Plane width (reg[16] bits 0-1): column mask and name table row shift, as
+   col_mask_table[] and shift_table[] in vdp_ctrl.c (2 is invalid) */
+#define BG_M5_WIDTHS(X) \
+  X(0, 0x0F, 6) \
+  X(1, 0x1F, 7) \
+  X(2, 0x0F, 0) \
+  X(3, 0x3F, 8)
+
+#define BG_M5_VARIANTS(n, col_mask, shift) \
+  static void render_bg_m5_##n(int line) { render_bg_m5_w(line, col_mask, shift); } \
+  static void render_bg_m5_vs_##n(int line) { render_bg_m5_vs_w(line, col_mask, shift); } \
+  static void render_bg_m5_im2_##n(int line) { render_bg_m5_im2_w(line, col_mask, shift); } \
+  static void render_bg_m5_im2_vs_##n(int line) { render_bg_m5_im2_vs_w(line, col_mask, shift); }
+BG_M5_WIDTHS(BG_M5_VARIANTS)
+
+#define BG_M5(n, col_mask, shift) render_bg_m5_##n,
+#define BG_M5_VS(n, col_mask, shift) render_bg_m5_vs_##n,
+#define BG_M5_IM2(n, col_mask, shift) render_bg_m5_im2_##n,
+#define BG_M5_IM2_VS(n, col_mask, shift) render_bg_m5_im2_vs_##n,
+
+void (*const render_bg_m5_table[2][2][4])(int line) =
+{
+  {{BG_M5_WIDTHS(BG_M5)}, {BG_M5_WIDTHS(BG_M5_VS)}},
+  {{BG_M5_WIDTHS(BG_M5_IM2)}, {BG_M5_WIDTHS(BG_M5_IM2_VS)}}
+};
 #else
 
 void render_bg_m5(int line)
@@ -2210,7 +2476,7 @@ void render_bg_m5(int line)
   int width = bitmap.viewport.w >> 4;
 
   /* Layer priority table */
-  uint8 *table = lut[(reg[12] & 8) >> 2];
+  uint8 *table = layer_lut[(reg[12] & 8) >> 2];
 
   /* Window vertical range (cell 0-31) */
   int a = (reg[18] & 0x1F) << 3;
@@ -2219,7 +2485,7 @@ void render_bg_m5(int line)
   int w = (reg[18] >> 7) & 1;
 
   /* Test against current line */
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -2368,7 +2634,7 @@ void render_bg_m5_vs(int line)
   int width = bitmap.viewport.w >> 4;
 
   /* Layer priority table */
-  uint8 *table = lut[(reg[12] & 8) >> 2];
+  uint8 *table = layer_lut[(reg[12] & 8) >> 2];
 
   /* Window vertical range (cell 0-31) */
   int a = (reg[18] & 0x1F) << 3;
@@ -2377,7 +2643,7 @@ void render_bg_m5_vs(int line)
   int w = (reg[18] >> 7) & 1;
 
   /* Test against current line */
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -2562,7 +2828,7 @@ void render_bg_m5_im2(int line)
   int width = bitmap.viewport.w >> 4;
 
   /* Layer priority table */
-  uint8 *table = lut[(reg[12] & 8) >> 2];
+  uint8 *table = layer_lut[(reg[12] & 8) >> 2];
 
   /* Window vertical range (cell 0-31) */
   int a = (reg[18] & 0x1F) << 3;
@@ -2571,7 +2837,7 @@ void render_bg_m5_im2(int line)
   int w = (reg[18] >> 7) & 1;
 
   /* Test against current line */
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -2721,7 +2987,7 @@ void render_bg_m5_im2_vs(int line)
   int width = bitmap.viewport.w >> 4;
 
   /* Layer priority table */
-  uint8 *table = lut[(reg[12] & 8) >> 2];
+  uint8 *table = layer_lut[(reg[12] & 8) >> 2];
 
   /* Window vertical range (cell 0-31) */
   uint32 a = (reg[18] & 0x1F) << 3;
@@ -2730,7 +2996,7 @@ void render_bg_m5_im2_vs(int line)
   uint32 w = (reg[18] >> 7) & 1;
 
   /* Test against current line */
-  if (w == (line >= a))
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
   {
     /* Window takes up entire line */
     a = 0;
@@ -2896,6 +3162,15 @@ void render_bg_m5_im2_vs(int line)
     DRAW_BG_COLUMN_IM2(atbuf, v_line, xscroll, yscroll)
   }
 }
+
+/* Not specialized, same renderer for every plane width */
+void (*const render_bg_m5_table[2][2][4])(int line) =
+{
+  {{render_bg_m5, render_bg_m5, render_bg_m5, render_bg_m5},
+   {render_bg_m5_vs, render_bg_m5_vs, render_bg_m5_vs, render_bg_m5_vs}},
+  {{render_bg_m5_im2, render_bg_m5_im2, render_bg_m5_im2, render_bg_m5_im2},
+   {render_bg_m5_im2_vs, render_bg_m5_im2_vs, render_bg_m5_im2_vs, render_bg_m5_im2_vs}}
+};
 #endif
 
 
@@ -3162,6 +3437,7 @@ void render_obj_m5(int line)
   uint8 *src, *s, *lb;
   uint32 temp, v_line;
   uint32 attr, name, atex;
+  uint32 hit = 0;
 
   /* Sprite list for current line */
   object_info_t *object_info = obj_info[line];
@@ -3238,9 +3514,13 @@ void render_obj_m5(int line)
       for (column = 0; column < width; column++, lb+=8)
       {
         temp = attr | ((name + s[column]) & 0x07FF);
+        BG_FLIP_CACHE(temp << 6)
         src = &bg_pattern_cache[(temp << 6) | (v_line)];
-        DRAW_SPRITE_TILE(8,atex,lut[1])
+        DRAW_SPRITE_TILE(8,atex,layer_lut[1])
       }
+
+      /* Sprite collision (pixel drawn over an opaque sprite pixel) */
+      spr_hit |= (hit >> 10) & 0x20;
     }
 
     /* Sprite limit */
@@ -3272,6 +3552,7 @@ void render_obj_m5_ste(int line)
   uint8 *src, *s, *lb;
   uint32 temp, v_line;
   uint32 attr, name, atex;
+  uint32 hit = 0;
 
   /* Sprite list for current line */
   object_info_t *object_info = obj_info[line];
@@ -3350,9 +3631,13 @@ void render_obj_m5_ste(int line)
       for (column = 0; column < width; column++, lb+=8)
       {
         temp = attr | ((name + s[column]) & 0x07FF);
+        BG_FLIP_CACHE(temp << 6)
         src = &bg_pattern_cache[(temp << 6) | (v_line)];
-        DRAW_SPRITE_TILE(8,atex,lut[3])
+        DRAW_SPRITE_TILE(8,atex,layer_lut[3])
       }
+
+      /* Sprite collision (pixel drawn over an opaque sprite pixel) */
+      spr_hit |= (hit >> 10) & 0x20;
     }
 
     /* Sprite limit */
@@ -3362,7 +3647,7 @@ void render_obj_m5_ste(int line)
       spr_ovr = (pixelcount >= bitmap.viewport.w);
 
       /* Merge background & sprite layers */
-      merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[4], bitmap.viewport.w);
+      merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[4], bitmap.viewport.w);
 
       /* Stop sprite rendering */
       return;
@@ -3376,7 +3661,7 @@ void render_obj_m5_ste(int line)
   spr_ovr = 0;
 
   /* Merge background & sprite layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[4], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[4], bitmap.viewport.w);
 }
 
 void render_obj_m5_im2(int line)
@@ -3391,6 +3676,7 @@ void render_obj_m5_im2(int line)
   uint8 *src, *s, *lb;
   uint32 temp, v_line;
   uint32 attr, name, atex;
+  uint32 hit = 0;
 
   /* Sprite list for current line */
   object_info_t *object_info = obj_info[line];
@@ -3466,9 +3752,13 @@ void render_obj_m5_im2(int line)
       for(column = 0; column < width; column ++, lb+=8)
       {
         temp = attr | (((name + s[column]) & 0x3ff) << 1);
+        BG_FLIP_CACHE(((temp << 6) | (v_line)) ^ ((attr & 0x1000) >> 6))
         src = &bg_pattern_cache[((temp << 6) | (v_line)) ^ ((attr & 0x1000) >> 6)];
-        DRAW_SPRITE_TILE(8,atex,lut[1])
+        DRAW_SPRITE_TILE(8,atex,layer_lut[1])
       }
+
+      /* Sprite collision (pixel drawn over an opaque sprite pixel) */
+      spr_hit |= (hit >> 10) & 0x20;
     }
 
     /* Sprite Limit */
@@ -3501,6 +3791,7 @@ void render_obj_m5_im2_ste(int line)
   uint8 *src, *s, *lb;
   uint32 temp, v_line;
   uint32 attr, name, atex;
+  uint32 hit = 0;
 
   /* Sprite list for current line */
   object_info_t *object_info = obj_info[line];
@@ -3579,9 +3870,13 @@ void render_obj_m5_im2_ste(int line)
       for(column = 0; column < width; column ++, lb+=8)
       {
         temp = attr | (((name + s[column]) & 0x3ff) << 1);
+        BG_FLIP_CACHE(((temp << 6) | (v_line)) ^ ((attr & 0x1000) >> 6))
         src = &bg_pattern_cache[((temp << 6) | (v_line)) ^ ((attr & 0x1000) >> 6)];
-        DRAW_SPRITE_TILE(8,atex,lut[3])
+        DRAW_SPRITE_TILE(8,atex,layer_lut[3])
       }
+
+      /* Sprite collision (pixel drawn over an opaque sprite pixel) */
+      spr_hit |= (hit >> 10) & 0x20;
     }
 
     /* Sprite Limit */
@@ -3591,7 +3886,7 @@ void render_obj_m5_im2_ste(int line)
       spr_ovr = (pixelcount >= bitmap.viewport.w);
 
       /* Merge background & sprite layers */
-      merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[4], bitmap.viewport.w);
+      merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[4], bitmap.viewport.w);
 
       /* Stop sprite rendering */
       return;
@@ -3605,7 +3900,7 @@ void render_obj_m5_im2_ste(int line)
   spr_ovr = 0;
 
   /* Merge background & sprite layers */
-  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], lut[4], bitmap.viewport.w);
+  merge(&linebuf[1][0x20], &linebuf[0][0x20], &linebuf[0][0x20], layer_lut[4], bitmap.viewport.w);
 }
 
 
@@ -3790,6 +4085,72 @@ void parse_satb_m4(int line)
   object_count[(line + 1) & 1] = count;
 }
 
+/* Walk the link chain once (same rules as the line by line walk) and bucket
+   the visited entries by line */
+static void build_obj_index(int max)
+{
+  uint16 *q = (uint16 *) &sat[0];
+  int link = 0;
+  int total = max_sprite_pixels >> 2;
+  int n = 0;
+
+  memset(obj_index_count, 0, sizeof(obj_index_count));
+
+  do
+  {
+    int ypos = (q[link] >> im2_flag) & 0x1FF;
+    int size = q[link + 1] >> 8;
+    int height, y, end;
+
+    if (chaos_sprite_on)
+    {
+      ypos = (ypos + chaos_sprite_dy[link >> 2]) & 0x1FF;
+      size ^= chaos_sprite_size[link >> 2];
+    }
+
+    height = 8 + ((size & 3) << 3);
+    y = ypos - 0x80;
+    end = y + height;
+
+    obj_chain[n].link = link;
+    obj_chain[n].ypos = ypos;
+    obj_chain[n].size = size;
+
+    if (y < 0) y = 0;
+    if (end > OBJ_INDEX_LINES) end = OBJ_INDEX_LINES;
+
+    for (; y < end; y++)
+    {
+      if (obj_index_count[y] <= max)
+      {
+        obj_index[y][obj_index_count[y]++] = n;
+      }
+    }
+
+    n++;
+
+    link = (q[link + 1] & 0x7F) << 2;
+    if ((link == 0) || (link >= bitmap.viewport.w)) break;
+  }
+  while (--total);
+
+  obj_chain_count = n;
+}
+
+/* Sprites of the link chain from the last line index build (SAT entry
+   numbers, in chain order), so others don't have to walk the SAT again */
+int render_obj_chain(int *list)
+{
+  int i;
+
+  for (i = 0; i < obj_chain_count; i++)
+  {
+    list[i] = obj_chain[i].link >> 2;
+  }
+
+  return obj_chain_count;
+}
+
 void parse_satb_m5(int line)
 {
   /* Y position */
@@ -3822,6 +4183,57 @@ void parse_satb_m5(int line)
   /* Sprite list for next line */
   object_info_t *object_info = obj_info[(line + 1) & 1];
 
+  /* Sprite line index (rebuilt after SAT cache or display mode changes) */
+  uint32 key = im2_flag | (bitmap.viewport.w << 1) | (max_sprite_pixels << 12);
+
+  /* first line of a new frame */
+  if (line < 0)
+  {
+    obj_index_builds = 0;
+  }
+
+  if ((obj_index_dirty || (key != obj_index_key)) && (obj_index_builds < OBJ_INDEX_MAX_BUILDS))
+  {
+    build_obj_index(max);
+    obj_index_dirty = 0;
+    obj_index_key = key;
+    obj_index_builds++;
+  }
+
+  if (!obj_index_dirty && (key == obj_index_key) && (line + 1 < OBJ_INDEX_LINES))
+  {
+    uint8 *entry = obj_index[line + 1];
+    int n = obj_index_count[line + 1];
+
+    /* Adjust line offset */
+    line += 0x81;
+
+    for (; n > 0; n--, entry++)
+    {
+      const object_chain_t *e = &obj_chain[*entry];
+
+      /* Sprite overflow */
+      if (count == max)
+      {
+        status |= 0x40;
+        break;
+      }
+
+      object_info->attr  = p[e->link + 2];
+      object_info->xpos  = (p[e->link + 3] + chaos_sprite_dx[e->link >> 2]) & 0x1ff;
+      object_info->ypos  = line - e->ypos;
+      object_info->size  = e->size & 0x0f;
+
+      ++count;
+      object_info++;
+    }
+
+    object_count[line & 1] = count;
+    return;
+  }
+
+  /* SAT cache rewritten too often this frame: walk the chain line by line */
+
   /* Adjust line offset */
   line += 0x81;
 
@@ -3830,11 +4242,17 @@ void parse_satb_m5(int line)
     /* Read Y position from internal SAT cache */
     ypos = (q[link] >> im2_flag) & 0x1FF;
 
+    /* Chaos sprite offsets */
+    if (chaos_sprite_on)
+    {
+      ypos = (ypos + chaos_sprite_dy[link >> 2]) & 0x1FF;
+    }
+
     /* Check if sprite Y position has been reached */
     if (line >= ypos)
     {
       /* Read sprite size from internal SAT cache */
-      size = q[link + 1] >> 8;
+      size = (q[link + 1] >> 8) ^ chaos_sprite_size[link >> 2];
 
       /* Sprite height */
       height = 8 + ((size & 3) << 3);
@@ -3854,7 +4272,7 @@ void parse_satb_m5(int line)
 
         /* Update sprite list (only name, attribute & xpos are parsed from VRAM) */
         object_info->attr  = p[link + 2];
-        object_info->xpos  = p[link + 3] & 0x1ff;
+        object_info->xpos  = (p[link + 3] + chaos_sprite_dx[link >> 2]) & 0x1ff;
         object_info->ypos  = ypos;
         object_info->size  = size & 0x0f;
 
@@ -3886,8 +4304,8 @@ void parse_satb_m5(int line)
 void update_bg_pattern_cache_m4(int index)
 {
   int i;
-  uint8 x, y, c;
-  uint8 *dst;
+  uint8 y;
+  uint8 *dst, *line;
   uint16 name, bp01, bp23;
   uint32 bp;
 
@@ -3912,23 +4330,42 @@ void update_bg_pattern_cache_m4(int index)
         /* (msb) p7p6 p5p4 p3p2 p1p0 (lsb) */
         bp = (bp_lut[bp01] >> 2) | (bp_lut[bp23]);
 
-        /* Update cached line (8 pixels = 8 bytes) */
-        for(x = 0; x < 8; x++)
+        /* Pattern cache data (one pattern = 8 bytes) */
+        /* byte0 <-> p0 p1 p2 p3 p4 p5 p6 p7 <-> byte7 (hflip = 0) */
+        /* byte0 <-> p7 p6 p5 p4 p3 p2 p1 p0 <-> byte7 (hflip = 1) */
+#ifdef LSB_FIRST
+        /* Mode 5 pixel pair table, high nibble first: (msb) p7p6 .. p1p0 (lsb) */
+        /* gives the hflip line as is, the unflipped one once nibbles are swapped */
+        {
+          uint32 sw = ((bp >> 4) & 0x0F0F0F0F) | ((bp & 0x0F0F0F0F) << 4);
+
+          line = &dst[y << 3];
+          *(uint32 *)&line[0] = bg_nibble_lut[sw & 0xFF] | (bg_nibble_lut[(sw >> 8) & 0xFF] << 16);
+          *(uint32 *)&line[4] = bg_nibble_lut[(sw >> 16) & 0xFF] | (bg_nibble_lut[sw >> 24] << 16);
+          flip_pattern_line(&dst[0x10000 | ((y ^ 7) << 3)], line, 0);  /* vflip=1, hflip=0 */
+
+          line = &dst[0x08000 | (y << 3)];
+          *(uint32 *)&line[0] = bg_nibble_lut[bp >> 24] | (bg_nibble_lut[(bp >> 16) & 0xFF] << 16);
+          *(uint32 *)&line[4] = bg_nibble_lut[(bp >> 8) & 0xFF] | (bg_nibble_lut[bp & 0xFF] << 16);
+          flip_pattern_line(&dst[0x18000 | ((y ^ 7) << 3)], line, 0);  /* vflip=1, hflip=1 */
+        }
+#else
         {
-          /* Extract pixel data */
-          c = bp & 0x0F;
-
-          /* Pattern cache data (one pattern = 8 bytes) */
-          /* byte0 <-> p0 p1 p2 p3 p4 p5 p6 p7 <-> byte7 (hflip = 0) */
-          /* byte0 <-> p7 p6 p5 p4 p3 p2 p1 p0 <-> byte7 (hflip = 1) */
-          dst[0x00000 | (y << 3) | (x)] = (c);            /* vflip=0 & hflip=0 */
-          dst[0x08000 | (y << 3) | (x ^ 7)] = (c);        /* vflip=0 & hflip=1 */
-          dst[0x10000 | ((y ^ 7) << 3) | (x)] = (c);      /* vflip=1 & hflip=0 */
-          dst[0x18000 | ((y ^ 7) << 3) | (x ^ 7)] = (c);  /* vflip=1 & hflip=1 */
-
-          /* Next pixel */
-          bp = bp >> 4;
+          uint8 x;
+
+          line = &dst[y << 3];
+          for(x = 0; x < 8; x++)
+          {
+            line[x] = bp & 0x0F;
+            bp = bp >> 4;
+          }
         }
+
+        /* Flipped patterns */
+        flip_pattern_line(&dst[0x08000 | (y << 3)], line, 1);         /* vflip=0, hflip=1 */
+        flip_pattern_line(&dst[0x10000 | ((y ^ 7) << 3)], line, 0);  /* vflip=1, hflip=0 */
+        flip_pattern_line(&dst[0x18000 | ((y ^ 7) << 3)], line, 1);  /* vflip=1, hflip=1 */
+#endif
       }
     }
 
@@ -3940,8 +4377,8 @@ void update_bg_pattern_cache_m4(int index)
 void update_bg_pattern_cache_m5(int index)
 {
   int i;
-  uint8 x, y, c;
-  uint8 *dst;
+  uint8 y;
+  uint8 *dst, *line;
   uint16 name;
   uint32 bp;
 
@@ -3963,34 +4400,40 @@ void update_bg_pattern_cache_m5(int index)
         /* BIG_ENDIAN: byte0 (msb) p0p1 p2p3 p4p5 p6p7 (lsb) byte3 */
         bp = *(uint32 *)&vram[(name << 5) | (y << 2)];
 
-        /* Update cached line (8 pixels = 8 bytes) */
-        for(x = 0; x < 8; x ++)
-        {
-          /* Extract pixel data */
-          c = bp & 0x0F;
-
-          /* Pattern cache data (one pattern = 8 bytes) */
-          /* byte0 <-> p0 p1 p2 p3 p4 p5 p6 p7 <-> byte7 (hflip = 0) */
-          /* byte0 <-> p7 p6 p5 p4 p3 p2 p1 p0 <-> byte7 (hflip = 1) */
+        /* Pattern cache data (one pattern = 8 bytes) */
+        /* byte0 <-> p0 p1 p2 p3 p4 p5 p6 p7 <-> byte7 (hflip = 0) */
+        line = &dst[y << 3];
 #ifdef LSB_FIRST
-          /* Byteplane data = (msb) p4p5 p6p7 p0p1 p2p3 (lsb) */
-          dst[0x00000 | (y << 3) | (x ^ 3)] = (c);        /* vflip=0, hflip=0 */
-          dst[0x20000 | (y << 3) | (x ^ 4)] = (c);        /* vflip=0, hflip=1 */
-          dst[0x40000 | ((y ^ 7) << 3) | (x ^ 3)] = (c);  /* vflip=1, hflip=0 */
-          dst[0x60000 | ((y ^ 7) << 3) | (x ^ 4)] = (c);  /* vflip=1, hflip=1 */
+        /* Byteplane data = (msb) p4p5 p6p7 p0p1 p2p3 (lsb), two pixels per byte */
+        *(uint32 *)&line[0] = bg_nibble_lut[(bp >> 8) & 0xFF] | (bg_nibble_lut[bp & 0xFF] << 16);
+        *(uint32 *)&line[4] = bg_nibble_lut[bp >> 24] | (bg_nibble_lut[(bp >> 16) & 0xFF] << 16);
 #else
+        {
+          uint8 x;
+
           /* Byteplane data = (msb) p0p1 p2p3 p4p5 p6p7 (lsb) */
-          dst[0x00000 | (y << 3) | (x ^ 7)] = (c);        /* vflip=0, hflip=0 */
-          dst[0x20000 | (y << 3) | (x)] = (c);            /* vflip=0, hflip=1 */
-          dst[0x40000 | ((y ^ 7) << 3) | (x ^ 7)] = (c);  /* vflip=1, hflip=0 */
-          dst[0x60000 | ((y ^ 7) << 3) | (x)] = (c);      /* vflip=1, hflip=1 */
-#endif
-          /* Next pixel */
-          bp = bp >> 4;
+          for(x = 0; x < 8; x ++)
+          {
+            line[x ^ 7] = bp & 0x0F;
+            bp = bp >> 4;
+          }
         }
+#endif
+
+#ifndef BG_CACHE_LAZY_FLIP
+        /* Flipped patterns */
+        flip_pattern_line(&dst[0x20000 | (y << 3)], line, 1);         /* vflip=0, hflip=1 */
+        flip_pattern_line(&dst[0x40000 | ((y ^ 7) << 3)], line, 0);  /* vflip=1, hflip=0 */
+        flip_pattern_line(&dst[0x60000 | ((y ^ 7) << 3)], line, 1);  /* vflip=1, hflip=1 */
+#endif
       }
     }
 
+#ifdef BG_CACHE_LAZY_FLIP
+    /* Flipped patterns are rebuilt on first use */
+    bg_flip_dirty[name] = 0x0E;
+#endif
+
     /* Clear modified pattern flag */
     bg_name_dirty[name] = 0;
   }
@@ -4050,53 +4493,203 @@ void window_clip(unsigned int data, unsigned int sw)
 /* Init, reset routines                                                     */
 /*--------------------------------------------------------------------------*/
 
-void render_init(void)
+/* pattern cache and look-up tables, for the memory report (memmap.h) */
+void render_memory_report(void)
+{
+  memory_region("bg_pattern_cache", bg_pattern_cache, sizeof(bg_pattern_cache));
+  memory_region("bp_lut", bp_lut, sizeof(bp_lut));
+  memory_region("priority lut", lut, sizeof(lut));
+#ifdef WASM_GENPLUS
+  memory_region("layer glitch lut", layer_glitch_lut, sizeof(layer_glitch_lut));
+#endif
+}
+
+#ifdef WASM_GENPLUS
+void render_layers(int flags)
 {
   int bx, ax;
 
-  /* Initialize layers priority pixel look-up tables */
-  uint16 index;
+  /* the render thread may be drawing with the current tables */
+  RENDER_SYNC();
+
+  gpu_log_layers();
+  LINE_CACHE_DIRTY();
+  layer_flags = flags;
+  if (!(flags & ~RENDER_LAYER_WINDOW))
+  {
+    layer_lut = lut;
+    return;
+  }
+
   for (bx = 0; bx < 0x100; bx++)
   {
     for (ax = 0; ax < 0x100; ax++)
     {
-      index = (bx << 8) | (ax);
+      uint16 index = (bx << 8) | (ax);
 
-      lut[0][index] = make_lut_bg(bx, ax);
-      lut[1][index] = make_lut_bgobj(bx, ax);
-      lut[2][index] = make_lut_bg_ste(bx, ax);
-      lut[3][index] = make_lut_obj(bx, ax);
-      lut[4][index] = make_lut_bgobj_ste(bx, ax);
-      lut[5][index] = make_lut_bgobj_m4(bx,ax);
-    }
-  }
+      /* Planes: B (bx) and A or window (ax) pixels */
+      uint32 b = (flags & RENDER_LAYER_HIDE_B) ? 0 : bx;
+      uint32 a = (flags & RENDER_LAYER_HIDE_A) ? 0 : ax;
 
-  /* Initialize pixel color look-up tables */
-  palette_init();
+      /* Sprites: merged planes (bx) and sprite (ax) pixels */
+      uint32 bg = bx;
+      uint32 obj = (flags & RENDER_LAYER_HIDE_SPRITES) ? 0 : ax;
 
-  /* Make sprite pattern name index look-up table (Mode 5) */
-  make_name_lut();
+      if (flags & RENDER_LAYER_FLIP_PRIORITY)
+      {
+        b ^= 0x40;
+        a ^= 0x40;
+      }
+      if (flags & RENDER_LAYER_SWAP_PLANES)
+      {
+        uint32 tmp = a;
+        a = b;
+        b = tmp;
+      }
+      if (flags & RENDER_LAYER_SPRITES_BEHIND)
+      {
+        /* any opaque plane pixel is in front of any sprite */
+        obj &= ~0x40;
+        if (bg & 0x0F)
+          bg |= 0x40;
+      }
 
-  /* Make bitplane to pixel look-up table (Mode 4) */
-  make_bp_lut();
+      layer_glitch_lut[0][index] = make_lut_bg(b, a);
+      layer_glitch_lut[1][index] = make_lut_bgobj(bg, obj);
+      layer_glitch_lut[2][index] = make_lut_bg_ste(b, a);
+      layer_glitch_lut[3][index] = make_lut_obj(bx, obj);
+      layer_glitch_lut[4][index] = make_lut_bgobj_ste(bg, obj);
+    }
+  }
+  layer_lut = layer_glitch_lut;
 }
 
-void render_reset(void)
+void render_patterns(int op, int param, int name, int count)
 {
-  /* Clear display bitmap */
-  memset(bitmap.data, 0, bitmap.pitch * bitmap.height);
+  int i;
+  uint8 *dst;
 
-  /* Clear line buffers */
-  memset(linebuf, 0, sizeof(linebuf));
+  /* Mode 5 cache layout only */
+  if (update_bg_pattern_cache != update_bg_pattern_cache_m5) return;
 
-  /* Clear color palettes */
-  memset(pixel, 0, sizeof(pixel));
+  /* the render thread may be drawing with the current patterns */
+  RENDER_SYNC();
 
-  /* Clear pattern cache */
-  memset ((char *) bg_pattern_cache, 0, sizeof (bg_pattern_cache));
+  GPU_LOG_INVALIDATE();
+  LINE_CACHE_DIRTY();
+  for (name &= 0x7FF; (count > 0) && (name < 0x800); count--, name++)
+  {
+    dst = &bg_pattern_cache[name << 6];
 
-  /* Reset Sprite infos */
+    switch (op)
+    {
+      case RENDER_PATTERN_XOR:
+      {
+        uint32 mask = (param & 0x0F) * 0x01010101;
+        for (i = 0; i < 64; i += 4)
+        {
+          *(uint32 *)&dst[i] ^= mask;
+        }
+        break;
+      }
+
+      case RENDER_PATTERN_ROLL:
+      {
+        uint8 tmp[64];
+        int n = param & 63;
+        memcpy(tmp, dst, 64);
+        memcpy(dst, &tmp[64 - n], n);
+        memcpy(&dst[n], tmp, 64 - n);
+        break;
+      }
+    }
+
+#ifdef BG_CACHE_LAZY_FLIP
+    /* Flipped patterns are rebuilt from the corrupted one on first use */
+    bg_flip_dirty[name] = 0x0E;
+#else
+    for (i = 0; i < 8; i++)
+    {
+      flip_pattern_line(&dst[0x20000 | (i << 3)], &dst[i << 3], 1);
+      flip_pattern_line(&dst[0x40000 | ((i ^ 7) << 3)], &dst[i << 3], 0);
+      flip_pattern_line(&dst[0x60000 | ((i ^ 7) << 3)], &dst[i << 3], 1);
+    }
+#endif
+  }
+}
+#endif
+
+void render_init(void)
+{
+  static int tables_built = 0;
+  int bx, ax;
+  uint16 index;
+
+  /* The tables below are constant: built on the first call, kept across resets */
+  if (tables_built)
+    return;
+  tables_built = 1;
+
+  /* Initialize layers priority pixel look-up tables */
+  for (bx = 0; bx < 0x100; bx++)
+  {
+    for (ax = 0; ax < 0x100; ax++)
+    {
+      index = (bx << 8) | (ax);
+
+      lut[0][index] = make_lut_bg(bx, ax);
+      lut[1][index] = make_lut_bgobj(bx, ax);
+      lut[2][index] = make_lut_bg_ste(bx, ax);
+      lut[3][index] = make_lut_obj(bx, ax);
+      lut[4][index] = make_lut_bgobj_ste(bx, ax);
+      lut[5][index] = make_lut_bgobj_m4(bx,ax);
+    }
+  }
+
+  /* Initialize pixel color look-up tables */
+  palette_init();
+
+  /* Make sprite pattern name index look-up table (Mode 5) */
+  make_name_lut();
+
+  /* Make bitplane to pixel look-up table (Mode 4) */
+  make_bp_lut();
+
+#ifdef LSB_FIRST
+  /* Make byteplane to pixel pair look-up table (Mode 4 & 5) */
+  /* byte (msb) p0p1 (lsb) -> byte0 = p1, byte1 = p0 */
+  for (bx = 0; bx < 0x100; bx++)
+  {
+    bg_nibble_lut[bx] = (bx >> 4) | ((bx & 0x0F) << 8);
+  }
+#endif
+}
+
+void render_reset(void)
+{
+  /* Clear display bitmap */
+  memset(bitmap.data, 0, bitmap.pitch * bitmap.height);
+
+  /* Clear line buffers */
+  memset(linebuf, 0, sizeof(linebuf));
+
+  /* Clear color palettes */
+  memset(pixel, 0, sizeof(pixel));
+#ifdef WASM_GENPLUS
+  blit_palette_dirty = 1;
+  LINE_CACHE_DIRTY();
+#endif
+
+  /* Clear pattern cache */
+  memset ((char *) bg_pattern_cache, 0, sizeof (bg_pattern_cache));
+#ifdef BG_CACHE_LAZY_FLIP
+  memset (bg_flip_dirty, 0, sizeof (bg_flip_dirty));
+#endif
+
+  /* Reset Sprite infos */
   spr_ovr = spr_col = object_count[0] = object_count[1] = 0;
+  spr_hit = 0;
+  obj_chain_count = 0;
 }
 
 
@@ -4104,8 +4697,280 @@ void render_reset(void)
 /* Line rendering functions                                                 */
 /*--------------------------------------------------------------------------*/
 
+#ifdef WASM_GENPLUS
+#define LINE_HASH(h, v) h = ((h) ^ (uint32)(v)) * 0x100000001B3ULL
+
+static int line_cache_row(int line)
+{
+  /* Adjust for interlaced output */
+  if (interlaced && config.render)
+  {
+    line = (line * 2) + odd_frame;
+  }
+
+  return line & (LINE_CACHE_ROWS - 1);
+}
+
+/* Mode 5 line inputs besides VRAM and CRAM contents: registers, scroll values
+   (with the chaos offsets), sprites found on the line and output position */
+static uint64_t line_signature(int line)
+{
+  uint64_t h = 0xCBF29CE484222325ULL;
+  const uint32 *vs = (const uint32 *)&vsram[0];
+  object_info_t *object_info = obj_info[line & 1];
+  int count = object_count[line & 1];
+  uint32 data;
+  int i;
+
+  LINE_HASH(h, line_cache_gen);
+  LINE_HASH(h, line | (odd_frame << 16) | (spr_ovr << 24) | ((interlaced && config.render) << 25));
+  LINE_HASH(h, bitmap.viewport.x | (bitmap.viewport.y << 16));
+  LINE_HASH(h, bitmap.viewport.w | (lines_per_frame << 16));
+
+  for (i = 0; i < 0x18; i += 4)
+  {
+    memcpy(&data, &reg[i], 4);
+    LINE_HASH(h, data);
+  }
+
+  LINE_HASH(h, *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)]);
+  LINE_HASH(h, chaos_scroll_on | (chaos_scroll_phase << 8));
+  if (chaos_scroll_on & 1)
+  {
+    LINE_HASH(h, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
+  if (chaos_scroll_on & 2)
+  {
+    vs = chaos_scroll_columns();
+  }
+  for (i = ((reg[11] & 4) || (chaos_scroll_on & 2)) ? 20 : 1; i > 0; i--)
+  {
+    LINE_HASH(h, *vs++);
+  }
+
+  LINE_HASH(h, count);
+  for (i = 0; i < count; i++, object_info++)
+  {
+    LINE_HASH(h, object_info->ypos | (object_info->xpos << 16));
+    LINE_HASH(h, object_info->attr | (object_info->size << 16));
+  }
+
+  return h;
+}
+
+/* Whether the output row of this line still holds what it would render */
+static int line_cache_hit(int line)
+{
+  uint64_t sig;
+  int row;
+
+  if (!(system_hw & SYSTEM_MD) || !(reg[1] & 0x04) || config.lcd)
+  {
+    return 0;
+  }
+
+  row = line_cache_row(line);
+  line_cache_lines++;
+
+  /* Palette overrides: blit the line again (they roll from frame to frame) */
+  if (chaos_linepal_on && chaos_linepal_count[(line + chaos_linepal_phase) & 0xFF])
+  {
+    line_cache_sig[row] = 0;
+    return 0;
+  }
+
+  sig = line_signature(line);
+
+  if (line_cache_sig[row] == sig)
+  {
+    line_cache_reused++;
+    line_cache_served = line;
+    return 1;
+  }
+
+  line_cache_sig[row] = sig;
+  return 0;
+}
+
+void render_line_cache(int enabled)
+{
+  RENDER_SYNC();
+  line_cache_on = enabled;
+  memset(line_cache_sig, 0, sizeof(line_cache_sig));
+}
+
+void render_line_cache_dirty(void)
+{
+  RENDER_SYNC();
+  LINE_CACHE_DIRTY();
+}
+
+void render_line_cache_stats(uint32 *lines, uint32 *reused)
+{
+  *lines = line_cache_lines;
+  *reused = line_cache_reused;
+  line_cache_lines = line_cache_reused = 0;
+}
+
+/* GPU compositing (wasm/gpu_log.h): the inputs of a Mode 5 line as the
+   renderers above resolve them, 0 when the log does not cover the line */
+int render_log_line(int line, uint16 *rec)
+{
+  object_info_t *object_info = obj_info[line & 1];
+  int count = object_count[line & 1];
+  const uint32 *vs = (const uint32 *)&vsram[0];
+  uint32 xscroll, left;
+  int width = bitmap.viewport.w >> 4;
+  int a, w, i, xpos, size, pixels, pixelcount, masked, ovr;
+  uint16 *spr;
+
+  if (!(reg[1] & 0x40) || ((render_obj != render_obj_m5) && (render_obj != render_obj_m5_ste)) ||
+      (count > GPU_LOG_SPRITES) || config.lcd || config.ntsc)
+  {
+    return 0;
+  }
+
+  /* the planes follow reg 12, the sprite layer the renderer set by the last mode change */
+  rec[GPU_LINE_FLAGS] = GPU_LINE_LOGGED | ((reg[12] & 0x08) ? GPU_LINE_STE : 0) | ((reg[0] & 0x20) ? GPU_LINE_BLANK_LEFT : 0) |
+                        ((render_obj == render_obj_m5_ste) ? GPU_LINE_OBJ_STE : 0);
+  rec[GPU_LINE_WIDTH] = bitmap.viewport.w;
+  rec[GPU_LINE_BORDER] = bitmap.viewport.x;
+  rec[GPU_LINE_Y] = line;
+  rec[GPU_LINE_NTAB] = ntab;
+  rec[GPU_LINE_NTBB] = ntbb;
+  rec[GPU_LINE_WINDOW] = ntwb | ((line >> 3) << (6 + (reg[12] & 1)));
+  rec[GPU_LINE_COLS] = playfield_col_mask;
+  rec[GPU_LINE_ROWS] = playfield_row_mask;
+  rec[GPU_LINE_SHIFT] = playfield_shift;
+
+  /* Scroll values */
+  xscroll = *(uint32 *)&vram[hscb + ((line & hscroll_mask) << 2)];
+  if (chaos_scroll_on & 1)
+  {
+    xscroll = chaos_scroll_add(xscroll, chaos_hscroll[(line + chaos_scroll_phase) & 0xFF]);
+  }
+#ifdef LSB_FIRST
+  rec[GPU_LINE_HSCROLL_A] = xscroll;
+  rec[GPU_LINE_HSCROLL_B] = xscroll >> 16;
+#else
+  rec[GPU_LINE_HSCROLL_A] = xscroll >> 16;
+  rec[GPU_LINE_HSCROLL_B] = xscroll;
+#endif
+
+  if ((reg[11] & 4) || (chaos_scroll_on & 2))
+  {
+    /* 2-cell columns (render_bg_m5_vs): the partly shown column uses the
+       last one of both planes in 40-cell mode, no scrolling in 32-cell mode */
+    if (chaos_scroll_on & 2)
+    {
+      vs = chaos_scroll_columns();
+    }
+    left = (reg[12] & 1) ? (vs[19] & (vs[19] >> 16)) : 0;
+    for (i = 0; i < 20; i++)
+    {
+      memcpy(&rec[GPU_LINE_VSCROLL + 2 + (i << 1)], &vs[i], 4);
+    }
+    rec[GPU_LINE_VSCROLL] = rec[GPU_LINE_VSCROLL + 1] = left;
+  }
+  else
+  {
+    for (i = 0; i < 42; i += 2)
+    {
+      memcpy(&rec[GPU_LINE_VSCROLL + i], vs, 4);
+    }
+  }
+#ifndef LSB_FIRST
+  for (i = 0; i < 42; i += 2)
+  {
+    uint16 tmp = rec[GPU_LINE_VSCROLL + i];
+    rec[GPU_LINE_VSCROLL + i] = rec[GPU_LINE_VSCROLL + i + 1];
+    rec[GPU_LINE_VSCROLL + i + 1] = tmp;
+  }
+#endif
+
+  /* Window and plane A columns */
+  a = (reg[18] & 0x1F) << 3;
+  w = (reg[18] >> 7) & 1;
+  if ((w == (line >= a)) || (layer_flags & RENDER_LAYER_WINDOW))
+  {
+    a = 0;
+    w = 1;
+  }
+  else
+  {
+    a = clip[0].enable;
+    w = clip[1].enable;
+  }
+  rec[GPU_LINE_A_LEFT] = a ? clip[0].left : 0;
+  rec[GPU_LINE_A_RIGHT] = a ? clip[0].right : 0;
+  rec[GPU_LINE_W_LEFT] = !w ? 0 : a ? clip[1].left : 0;
+  rec[GPU_LINE_W_RIGHT] = !w ? 0 : a ? clip[1].right : width;
+
+  /* Sprites, masked and cut as render_obj_m5() draws them */
+  rec[GPU_LINE_SPRITES] = count;
+  spr = &rec[GPU_LINE_SPRITE];
+  pixelcount = 0;
+  masked = 0;
+  ovr = spr_ovr;
+  for (i = 0; i < count; i++, object_info++, spr += 4)
+  {
+    xpos = object_info->xpos;
+    if (xpos)
+    {
+      ovr = 1;
+    }
+    else if (ovr)
+    {
+      masked = 1;
+    }
+
+    size = object_info->size;
+    pixels = 8 + ((size & 0x0C) << 1);
+    pixelcount += pixels;
+    if (pixelcount > max_sprite_pixels)
+    {
+      pixels -= pixelcount - max_sprite_pixels;
+    }
+
+    spr[0] = xpos - 0x80;
+    spr[1] = object_info->attr;
+    spr[2] = size | (object_info->ypos << 8);
+    spr[3] = masked ? 0 : (pixels & ~7);
+
+    if (pixelcount >= max_sprite_pixels)
+    {
+      rec[GPU_LINE_SPRITES] = i + 1;
+      break;
+    }
+  }
+
+  return 1;
+}
+
+uint8 *render_pattern_cache_ref(void)
+{
+  return bg_pattern_cache;
+}
+
+uint8 *render_layer_lut_ref(void)
+{
+  return layer_lut[0];
+}
+#endif
+
 void render_line(int line)
 {
+#ifdef WASM_GENPLUS
+  line_cache_served = -1;
+
+  /* Composited by the front-end from the line's inputs: only keep the sprite state in sync */
+  if (gpu_log_on && gpu_log_line(line))
+  {
+    skip_line(line);
+    return;
+  }
+#endif
+
   /* Check display status */
   if (reg[1] & 0x40)
   {
@@ -4114,13 +4979,30 @@ void render_line(int line)
     {
       update_bg_pattern_cache(bg_list_index);
       bg_list_index = 0;
+      LINE_CACHE_DIRTY();
     }
 
+#ifdef WASM_GENPLUS
+    /* Same output as in the previous frame: only keep the sprite state in sync */
+    if (line_cache_on && !gpu_log_on && line_cache_hit(line))
+    {
+      skip_line(line);
+      return;
+    }
+#endif
+
     /* Render BG layer(s) */
-    render_bg(line);
+    PROFILE_CALL(PROF_RENDER_BG, render_bg(line));
 
-    /* Render sprite layer */
-    render_obj(line & 1);
+    /* Render sprite layer (Mode 5 lines without sprites only need the masking reset, S/TE modes still merge layers) */
+    if (object_count[line & 1] || ((render_obj != render_obj_m5) && (render_obj != render_obj_m5_im2)))
+    {
+      PROFILE_CALL(PROF_RENDER_OBJ, render_obj(line & 1));
+    }
+    else
+    {
+      spr_ovr = 0;
+    }
 
     /* Left-most column blanking */
     if (reg[0] & 0x20)
@@ -4134,7 +5016,7 @@ void render_line(int line)
     /* Parse sprites for next line */
     if (line < (bitmap.viewport.h - 1))
     {
-      parse_satb(line);
+      PROFILE_CALL(PROF_PARSE_SATB, parse_satb(line));
     }
 
     /* Horizontal borders */
@@ -4154,7 +5036,7 @@ void render_line(int line)
       spr_ovr = 0;
 
       /* Sprites are still parsed when display is disabled */
-      parse_satb(line);
+      PROFILE_CALL(PROF_PARSE_SATB, parse_satb(line));
     }
 
     /* Blanked line */
@@ -4162,15 +5044,267 @@ void render_line(int line)
   }
 
   /* Pixel color remapping */
-  remap_line(line);
+  PROFILE_CALL(PROF_REMAP, remap_line(line));
 }
 
+/* Frame skipping: keep the sprite state that is visible to software (SOVR &
+   SCOL flags, sprite collision position) in sync without rendering the line */
+void skip_line(int line)
+{
+  /* Check display status */
+  if (reg[1] & 0x40)
+  {
+    /* Update pattern cache (sprite layer) */
+    if (bg_list_index)
+    {
+      update_bg_pattern_cache(bg_list_index);
+      bg_list_index = 0;
+      LINE_CACHE_DIRTY();
+    }
+
+    /* Sprite layer is drawn over an empty background (collision only) */
+    memset(&linebuf[0][0x20], 0, bitmap.viewport.w);
+    PROFILE_CALL(PROF_RENDER_OBJ, render_obj(line & 1));
+
+    /* Parse sprites for next line */
+    if (line < (bitmap.viewport.h - 1))
+    {
+      PROFILE_CALL(PROF_PARSE_SATB, parse_satb(line));
+    }
+  }
+  else
+  {
+    /* Master System & Game Gear VDP specific */
+    if (system_hw < SYSTEM_MD)
+    {
+      /* Update SOVR flag */
+      status |= spr_ovr;
+      spr_ovr = 0;
+
+      /* Sprites are still parsed when display is disabled */
+      PROFILE_CALL(PROF_PARSE_SATB, parse_satb(line));
+    }
+  }
+}
+
+#ifdef WASM_GENPLUS
+/* WASM: current pixel lookup table, for front-end side palette lookup */
+uint32 *render_palette_ref(void)
+{
+  return (uint32 *)pixel;
+}
+#endif
+
 void blank_line(int line, int offset, int width)
 {
+#ifdef WASM_GENPLUS
+  if (line_cache_on)
+  {
+    int row = line_cache_row(line);
+
+    /* Partially blanked line: its pixels are needed in the line buffer */
+    if (line == line_cache_served)
+    {
+      line_cache_sig[row] = 0;
+      render_line(line);
+    }
+    line_cache_sig[row] = 0;
+  }
+
+  /* Logged line: composite it into the line buffer */
+  if (gpu_log_on)
+  {
+    gpu_log_blank(line, &linebuf[0][0x20 - bitmap.viewport.x]);
+  }
+#endif
+
   memset(&linebuf[0][0x20 + offset], 0x40, width);
-  remap_line(line);
+  PROFILE_CALL(PROF_REMAP, remap_line(line));
+}
+
+#ifdef RENDER_THREAD
+/* Pipelined rendering: active lines are handed to a second thread, which
+   renders line N while the CPUs run line N on the main thread. VDP state is
+   not copied. VDP port accesses, DMA updates and interrupt acknowledges call
+   RENDER_SYNC() first instead, so the render thread only ever sees the state
+   render_line() would have seen before the CPUs ran, and a mid-line register
+   write re-renders the line once it is complete, as it does without the
+   thread. Only one line is in flight at a time. */
+
+#define RENDER_IDLE (-1)
+
+/* polls before the render thread goes to sleep (idle between frames) */
+#define RENDER_SPIN 20000
+
+/* polls before the main thread yields its core (oversubscribed host) */
+#define RENDER_SYNC_SPIN 2000
+
+#if defined(__i386__) || defined(__x86_64__)
+#define RENDER_PAUSE() __builtin_ia32_pause()
+#else
+#define RENDER_PAUSE()
+#endif
+
+static atomic_int render_request = RENDER_IDLE;
+static atomic_int render_sleeping;
+static pthread_mutex_t render_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t render_cond = PTHREAD_COND_INITIALIZER;
+
+/* 0: not started, 1: running, -1: single core or no thread (render inline) */
+static int render_thread_state;
+
+static int render_thread_cores(void)
+{
+#ifdef __EMSCRIPTEN__
+  return emscripten_num_logical_cores();
+#else
+  return sysconf(_SC_NPROCESSORS_ONLN);
+#endif
 }
 
+static void *render_thread_main(void *arg)
+{
+  while (1)
+  {
+    int line;
+    int spins = 0;
+
+    while ((line = atomic_load_explicit(&render_request, memory_order_acquire)) == RENDER_IDLE)
+    {
+      if (++spins < RENDER_SPIN)
+      {
+        RENDER_PAUSE();
+        continue;
+      }
+
+      pthread_mutex_lock(&render_mutex);
+      atomic_store(&render_sleeping, 1);
+      while (atomic_load(&render_request) == RENDER_IDLE)
+      {
+        pthread_cond_wait(&render_cond, &render_mutex);
+      }
+      atomic_store(&render_sleeping, 0);
+      pthread_mutex_unlock(&render_mutex);
+      spins = 0;
+    }
+
+    render_line(line);
+    atomic_store_explicit(&render_request, RENDER_IDLE, memory_order_release);
+  }
+
+  return NULL;
+}
+
+void render_sync(void)
+{
+  int spins = 0;
+
+  while (atomic_load_explicit(&render_request, memory_order_acquire) != RENDER_IDLE)
+  {
+    if (++spins < RENDER_SYNC_SPIN)
+    {
+      RENDER_PAUSE();
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+}
+
+void render_line_async(int line)
+{
+  render_sync();
+
+  if (!render_thread_state)
+  {
+    /* both threads spin while waiting on each other: no gain without a second core */
+    pthread_t thread;
+    render_thread_state = -1;
+    if ((render_thread_cores() > 1) && !pthread_create(&thread, NULL, render_thread_main, NULL))
+    {
+      pthread_detach(thread);
+      render_thread_state = 1;
+    }
+  }
+
+  if (render_thread_state < 0)
+  {
+    render_line(line);
+    return;
+  }
+
+  /* sequentially consistent pair with the render thread's sleep check */
+  atomic_store(&render_request, line);
+  if (atomic_load(&render_sleeping))
+  {
+    pthread_mutex_lock(&render_mutex);
+    pthread_cond_signal(&render_cond);
+    pthread_mutex_unlock(&render_mutex);
+  }
+}
+#endif
+
+#ifdef WASM_GENPLUS
+/* Show the palette overrides of a line in the pixel table (Mode 5 colors as
+   color_update_m5() computes them); returns the count, 'saved' the entries
+   replaced */
+static int linepal_patch(int line, PIXEL_OUT_T saved[8][3])
+{
+  int i, count;
+  const uint8 *slot;
+  const uint16 *color;
+
+  line = (line + chaos_linepal_phase) & 0xFF;
+  count = chaos_linepal_count[line];
+  slot = chaos_linepal_slot[line];
+  color = chaos_linepal_color[line];
+
+  for (i = 0; i < count; i++)
+  {
+    int index = slot[i];
+    unsigned int data = color[i];
+
+    saved[i][0] = pixel[0x00 | index];
+    saved[i][1] = pixel[0x40 | index];
+    saved[i][2] = pixel[0x80 | index];
+
+    if (!(reg[0] & 0x04))
+    {
+      data &= 0x49;
+    }
+
+    if (reg[12] & 0x08)
+    {
+      pixel[0x00 | index] = pixel_lut[0][data];
+      pixel[0x40 | index] = pixel_lut[1][data];
+      pixel[0x80 | index] = pixel_lut[2][data];
+    }
+    else
+    {
+      pixel[0x00 | index] = pixel[0x40 | index] = pixel[0x80 | index] = pixel_lut[1][data];
+    }
+  }
+
+  return count;
+}
+
+/* Put back what linepal_patch() replaced, last override first (two may
+   share a slot on the way through) */
+static void linepal_restore(int line, int count, PIXEL_OUT_T saved[8][3])
+{
+  const uint8 *slot = chaos_linepal_slot[(line + chaos_linepal_phase) & 0xFF];
+
+  while (count--)
+  {
+    int index = slot[count];
+    pixel[0x00 | index] = saved[count][0];
+    pixel[0x40 | index] = saved[count][1];
+    pixel[0x80 | index] = saved[count][2];
+  }
+}
+#endif
+
 void remap_line(int line)
 {
   /* Line width */
@@ -4179,6 +5313,16 @@ void remap_line(int line)
   /* Pixel line buffer */
   uint8 *src = &linebuf[0][0x20 - bitmap.viewport.x];
 
+#ifdef WASM_GENPLUS
+  /* Palette overrides patched in for this line */
+  PIXEL_OUT_T saved[8][3];
+  int patched = 0;
+  int vline = line;
+#endif
+
+  /* Skipped frame: the line buffer only holds sprite collision data (skip_line) */
+  if (render_skipped) return;
+
   /* Adjust line offset in framebuffer */
   line = (line + bitmap.viewport.y) % lines_per_frame;
 
@@ -4191,6 +5335,25 @@ void remap_line(int line)
     line = (line * 2) + odd_frame;
   }
 
+#ifdef WASM_GENPLUS
+  /* Logged line: the line buffer does not hold its pixels */
+  if (gpu_log_on && gpu_log_remap(WASM_FIELD_ROWS ? (line >> 1) : line, src))
+  {
+    return;
+  }
+#endif
+
+#ifdef CLIP_LINE
+  CLIP_LINE(line, width, src)
+#endif
+
+#ifdef WASM_GENPLUS
+  if (chaos_linepal_on && (system_hw & SYSTEM_MD) && (reg[1] & 0x04))
+  {
+    patched = linepal_patch(vline, saved);
+  }
+#endif
+
 #if defined(USE_15BPP_RENDERING) || defined(USE_16BPP_RENDERING)
   /* NTSC Filter (only supported for 15 or 16-bit pixels rendering) */
   if (config.ntsc)
@@ -4205,6 +5368,13 @@ void remap_line(int line)
     }
   }
   else
+#elif defined(NTSC_BLITTER)
+  /* NTSC Filter (WASM 32-bit output at 2x or 4x, the MD filter in every mode) */
+  if (config.ntsc && !wasm_indexed_output && !(wasm_output_scale & 1))
+  {
+    NTSC_BLITTER(line, width, pixel, src)
+  }
+  else
 #endif
   {
 #ifdef CUSTOM_BLITTER
@@ -4230,4 +5400,11 @@ void remap_line(int line)
     }
  #endif
   }
+
+#ifdef WASM_GENPLUS
+  if (patched)
+  {
+    linepal_restore(vline, patched, saved);
+  }
+#endif
 }
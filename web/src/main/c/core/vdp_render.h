@@ -98,38 +98,113 @@
   *out++ = PIXEL(r,g,b); \
 }
 
-/* WASM: 2x scale blitter with RGB -> ABGR swizzle for Canvas ImageData */
+/* WASM: integer scale blitter (wasm_output_scale, 1x to 4x) with RGB -> ABGR swizzle for Canvas ImageData (see wasm/blitter.c) */
+/* Lines whose output differs from the previous frame are flagged in wasm_dirty_lines[] */
+/* In indexed mode, raw pixel indices are copied to wasm_index_buffer[] instead (palette lookup done by the front-end) */
+/* Double resolution interlaced output (WASM_FIELD_ROWS, even scales): 'line' is the field line (line * 2 + odd_frame), */
+/* each field only draws its own rows and the other field's rows are kept from the previous frame (indexed mode shows the */
+/* current field) */
 #ifdef WASM_GENPLUS
+#define WASM_FIELD_ROWS (interlaced && config.render)
+#define WASM_LINE_ROWS (WASM_FIELD_ROWS ? (wasm_output_scale >> 1) : wasm_output_scale)
+#define WASM_INDEX_PITCH 512
+#define WASM_INDEX_LINES 256
+extern uint8 wasm_dirty_lines[];
+extern uint8 wasm_index_buffer[];
+extern int wasm_indexed_output;
+extern int wasm_output_scale;
+extern uint32 *render_palette_ref(void); /* 32bpp rendering only */
+extern int blit_palette_dirty;
+extern int blit_line(uint32_t *dst, int pitch, int rows, int scale, const uint8_t *src, int width, const uint32_t *palette);
+extern void blit_widen(uint32_t *row, int width, int factor);
+/* Instant replay (wasm/clip.c): drawn lines are also kept as pixel indices, in any output mode */
+#define WASM_CLIP_PITCH 320
+#define WASM_CLIP_LINES 240
+extern uint8 wasm_clip_pixels[];
+extern int wasm_clip_output;
+#define CLIP_LINE(line, width, src)  \
+if (wasm_clip_output) \
+{ \
+    int frame_line = WASM_FIELD_ROWS ? (line >> 1) : line; \
+    if (frame_line < WASM_CLIP_LINES) \
+        memcpy(&wasm_clip_pixels[frame_line * WASM_CLIP_PITCH], src, (width < WASM_CLIP_PITCH) ? width : WASM_CLIP_PITCH); \
+}
 #define CUSTOM_BLITTER(line, width, pixel, src)  \
+if (wasm_indexed_output) \
+{ \
+    int frame_line = WASM_FIELD_ROWS ? (line >> 1) : line; \
+    if (frame_line < WASM_INDEX_LINES) \
+    { \
+        uint8 *idx = &wasm_index_buffer[frame_line * WASM_INDEX_PITCH]; \
+        if (memcmp(idx, src, width)) \
+        { \
+            memcpy(idx, src, width); \
+            wasm_dirty_lines[frame_line] = 1; \
+        } \
+    } \
+} \
+else \
 { \
+    int rows = WASM_LINE_ROWS; \
     int pitch_px = bitmap.pitch / (int)sizeof(PIXEL_OUT_T); \
-    PIXEL_OUT_T *dst = ((PIXEL_OUT_T *)&bitmap.data[(line * 2 * bitmap.pitch)]); \
-    do \
+    PIXEL_OUT_T *dst = ((PIXEL_OUT_T *)&bitmap.data[(line * rows * bitmap.pitch)]); \
+    if (blit_line(dst, pitch_px, rows, wasm_output_scale, src, width, pixel)) \
+        wasm_dirty_lines[WASM_FIELD_ROWS ? (line >> 1) : line] = 1; \
+}
+
+/* NTSC filter (config.ntsc, any mode, even scales): md_ntsc already doubles the width, 4x widens
+   its output again. The filtered row is repeated on the other output rows of the line, the
+   second of which still holds the previous frame's row (a single row is always flagged) */
+#define NTSC_BLITTER(line, width, pixel, src)  \
+{ \
+    int rows = WASM_LINE_ROWS; \
+    int pitch_px = bitmap.pitch / (int)sizeof(PIXEL_OUT_T); \
+    int out_width; \
+    PIXEL_OUT_T *dst = ((PIXEL_OUT_T *)&bitmap.data[(line * rows * bitmap.pitch)]); \
+    if (width > bitmap.width / wasm_output_scale) width = bitmap.width / wasm_output_scale; \
+    md_ntsc_blit(md_ntsc, (MD_NTSC_IN_T const *)pixel, src, width, line * rows); \
+    out_width = MD_NTSC_OUT_WIDTH(width); \
+    if (wasm_output_scale > 2) \
+    { \
+        blit_widen(dst, out_width, wasm_output_scale >> 1); \
+        out_width *= wasm_output_scale >> 1; \
+    } \
+    if ((rows == 1) || memcmp(dst, dst + pitch_px, out_width * sizeof(PIXEL_OUT_T))) \
     { \
-        uint32_t px = pixel[*src++]; \
-        uint8_t r = (px & 0xff0000) >> 16; \
-        uint8_t g = (px & 0x00ff00) >> 8; \
-        uint8_t b = (px & 0x0000ff) >> 0; \
-        PIXEL_OUT_T pset = (0xff << 24) | (b << 16) | (g << 8) | (r); \
-        dst[0] = pset; \
-        dst[1] = pset; \
-        dst[pitch_px]     = pset; \
-        dst[pitch_px + 1] = pset; \
-        dst += 2; \
+        int row_; \
+        for (row_ = 1; row_ < rows; row_++) \
+            memcpy(dst + row_ * pitch_px, dst, out_width * sizeof(PIXEL_OUT_T)); \
+        wasm_dirty_lines[WASM_FIELD_ROWS ? (line >> 1) : line] = 1; \
     } \
-    while (--width); \
 }
 #endif
 
 /* Global variables */
 extern uint16 spr_col;
+extern uint8 spr_hit;
+extern uint8 obj_index_dirty;
+extern uint8 render_skipped;
 
 /* Function prototypes */
 extern void render_init(void);
+extern void render_memory_report(void);
 extern void render_reset(void);
 extern void render_line(int line);
+extern void skip_line(int line);
 extern void blank_line(int line, int offset, int width);
 extern void remap_line(int line);
+#ifdef RENDER_THREAD
+extern void render_line_async(int line);
+extern void render_sync(void);
+#define RENDER_SYNC() render_sync()
+#else
+#define render_line_async(line) render_line(line)
+#define RENDER_SYNC()
+#endif
+
+/* Latch mode 5 sprite collision to VDP status (status reads, state save) */
+#define spr_col_latch() { status |= spr_hit; spr_hit = 0; }
+
 extern void window_clip(unsigned int data, unsigned int sw);
 extern void render_bg_m0(int line);
 extern void render_bg_m1(int line);
@@ -139,10 +214,9 @@ extern void render_bg_m3(int line);
 extern void render_bg_m3x(int line);
 extern void render_bg_inv(int line);
 extern void render_bg_m4(int line);
-extern void render_bg_m5(int line);
-extern void render_bg_m5_vs(int line);
-extern void render_bg_m5_im2(int line);
-extern void render_bg_m5_im2_vs(int line);
+/* Mode 5 renderers, [interlace mode 2][vertical 2-cell scroll][plane width] */
+extern void (*const render_bg_m5_table[2][2][4])(int line);
+#define render_bg_m5_select() render_bg_m5_table[im2_flag][(reg[11] >> 2) & 1][reg[16] & 3]
 extern void render_obj_tms(int line);
 extern void render_obj_m4(int line);
 extern void render_obj_m5(int line);
@@ -152,11 +226,46 @@ extern void render_obj_m5_im2_ste(int line);
 extern void parse_satb_tms(int line);
 extern void parse_satb_m4(int line);
 extern void parse_satb_m5(int line);
+extern int render_obj_chain(int *list);
 extern void update_bg_pattern_cache_m4(int index);
 extern void update_bg_pattern_cache_m5(int index);
 extern void color_update_m4(int index, unsigned int data);
 extern void color_update_m5(int index, unsigned int data);
 
+#ifdef WASM_GENPLUS
+/* Mode 5 layer glitches (chaos effects): the priority tables are rebuilt
+   with the planes and sprites hidden or reordered, at no cost per line */
+#define RENDER_LAYER_HIDE_B          0x01 /* plane B transparent */
+#define RENDER_LAYER_HIDE_A          0x02 /* plane A and window transparent */
+#define RENDER_LAYER_HIDE_SPRITES    0x04
+#define RENDER_LAYER_SPRITES_BEHIND  0x08 /* sprites only where the planes are transparent */
+#define RENDER_LAYER_SWAP_PLANES     0x10 /* plane B drawn as plane A and back */
+#define RENDER_LAYER_FLIP_PRIORITY   0x20 /* plane priority bits inverted */
+#define RENDER_LAYER_WINDOW          0x40 /* window over plane A on every line */
+extern void render_layers(int flags);
+
+/* Mode 5 pattern cache glitches (chaos effects): 'count' decoded patterns
+   from 'name' on are corrupted in place. VRAM is not, so the game never reads
+   the glitch back and a pattern heals when the game writes it again */
+#define RENDER_PATTERN_XOR   0 /* param: pixel mask (1-15) */
+#define RENDER_PATTERN_ROLL  1 /* param: pixels rolled through the pattern (1-63) */
+extern void render_patterns(int op, int param, int name, int count);
+
+/* Line cache: a Mode 5 line drawn from the same registers, scroll values and
+   sprites as in the previous frame, with no VRAM, palette or table change in
+   between, keeps its output row (no render, no upload); stats are counted
+   since the last call */
+extern void render_line_cache(int enabled);
+extern void render_line_cache_dirty(void);
+extern void render_line_cache_stats(uint32 *lines, uint32 *reused);
+
+/* GPU compositing (wasm/gpu_log.h): record of a Mode 5 line's inputs (0 when
+   the log does not cover it), the pattern cache and the layer tables in use */
+extern int render_log_line(int line, uint16 *rec);
+extern uint8 *render_pattern_cache_ref(void);
+extern uint8 *render_layer_lut_ref(void);
+#endif
+
 /* Function pointers */
 extern void (*render_bg)(int line);
 extern void (*render_obj)(int line);
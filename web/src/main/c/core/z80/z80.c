@@ -124,12 +124,24 @@
  *    to a detailed description by Sean Young which can be found at:
  *      http://www.msxnet.org/tech/z80-documented.pdf
  *****************************************************************************/
+#include <stddef.h>
 #include "shared.h"
 #include "z80.h"
 
 /* execute main opcodes inside a big switch statement */
 #define BIG_SWITCH 1
 
+/* native GCC/Clang builds thread the main opcodes with computed gotos instead:
+   each one dispatches the next, so every dispatch has its own branch history
+   (WASM has no indirect goto, it keeps the switch) */
+#ifndef Z80_THREADED
+#if defined(__GNUC__) && !defined(__EMSCRIPTEN__)
+#define Z80_THREADED 1
+#else
+#define Z80_THREADED 0
+#endif
+#endif
+
 #define VERBOSE 0
 
 #if VERBOSE
@@ -221,6 +233,21 @@ unsigned char (*z80_readport)(unsigned int port);
 
 static UINT32 EA;
 
+/* Idle loop detection: Z80 state when a backward jump last landed on 'pc'. A pass
+ * of the loop without writes, I/O or reads outside Z80 RAM that ends in the same
+ * state repeats identically until the 68k, an IRQ or the YM can change something,
+ * i.e. until the end of the running z80_run() slice.
+ */
+static struct
+{
+  UINT32 pc;      /* loop start (above $FFFF: not armed) */
+  UINT32 cycles;
+  UINT32 end;     /* target cycle of the running z80_run() */
+  UINT8 r;
+  UINT8 dirty;    /* side effect or volatile read since the loop start */
+  Z80_Regs regs;
+} z80_idle;
+
 static UINT8 SZ[256];       /* zero and sign flags */
 static UINT8 SZ_BIT[256];   /* zero, sign and parity/overflow (=zero) flags for BIT opcode */
 static UINT8 SZP[256];      /* zero, sign and parity flags */
@@ -593,6 +620,127 @@ INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 #define EXEC_INLINE EXEC
 #endif
 
+#if Z80_THREADED
+/***************************************************************
+ * threaded main opcodes (see z80_run)
+ ***************************************************************/
+#define THREADED_LABELS \
+  &&l_00, &&l_01, &&l_02, &&l_03, &&l_04, &&l_05, &&l_06, &&l_07, \
+  &&l_08, &&l_09, &&l_0a, &&l_0b, &&l_0c, &&l_0d, &&l_0e, &&l_0f, \
+  &&l_10, &&l_11, &&l_12, &&l_13, &&l_14, &&l_15, &&l_16, &&l_17, \
+  &&l_18, &&l_19, &&l_1a, &&l_1b, &&l_1c, &&l_1d, &&l_1e, &&l_1f, \
+  &&l_20, &&l_21, &&l_22, &&l_23, &&l_24, &&l_25, &&l_26, &&l_27, \
+  &&l_28, &&l_29, &&l_2a, &&l_2b, &&l_2c, &&l_2d, &&l_2e, &&l_2f, \
+  &&l_30, &&l_31, &&l_32, &&l_33, &&l_34, &&l_35, &&l_36, &&l_37, \
+  &&l_38, &&l_39, &&l_3a, &&l_3b, &&l_3c, &&l_3d, &&l_3e, &&l_3f, \
+  &&l_40, &&l_41, &&l_42, &&l_43, &&l_44, &&l_45, &&l_46, &&l_47, \
+  &&l_48, &&l_49, &&l_4a, &&l_4b, &&l_4c, &&l_4d, &&l_4e, &&l_4f, \
+  &&l_50, &&l_51, &&l_52, &&l_53, &&l_54, &&l_55, &&l_56, &&l_57, \
+  &&l_58, &&l_59, &&l_5a, &&l_5b, &&l_5c, &&l_5d, &&l_5e, &&l_5f, \
+  &&l_60, &&l_61, &&l_62, &&l_63, &&l_64, &&l_65, &&l_66, &&l_67, \
+  &&l_68, &&l_69, &&l_6a, &&l_6b, &&l_6c, &&l_6d, &&l_6e, &&l_6f, \
+  &&l_70, &&l_71, &&l_72, &&l_73, &&l_74, &&l_75, &&l_76, &&l_77, \
+  &&l_78, &&l_79, &&l_7a, &&l_7b, &&l_7c, &&l_7d, &&l_7e, &&l_7f, \
+  &&l_80, &&l_81, &&l_82, &&l_83, &&l_84, &&l_85, &&l_86, &&l_87, \
+  &&l_88, &&l_89, &&l_8a, &&l_8b, &&l_8c, &&l_8d, &&l_8e, &&l_8f, \
+  &&l_90, &&l_91, &&l_92, &&l_93, &&l_94, &&l_95, &&l_96, &&l_97, \
+  &&l_98, &&l_99, &&l_9a, &&l_9b, &&l_9c, &&l_9d, &&l_9e, &&l_9f, \
+  &&l_a0, &&l_a1, &&l_a2, &&l_a3, &&l_a4, &&l_a5, &&l_a6, &&l_a7, \
+  &&l_a8, &&l_a9, &&l_aa, &&l_ab, &&l_ac, &&l_ad, &&l_ae, &&l_af, \
+  &&l_b0, &&l_b1, &&l_b2, &&l_b3, &&l_b4, &&l_b5, &&l_b6, &&l_b7, \
+  &&l_b8, &&l_b9, &&l_ba, &&l_bb, &&l_bc, &&l_bd, &&l_be, &&l_bf, \
+  &&l_c0, &&l_c1, &&l_c2, &&l_c3, &&l_c4, &&l_c5, &&l_c6, &&l_c7, \
+  &&l_c8, &&l_c9, &&l_ca, &&l_cb, &&l_cc, &&l_cd, &&l_ce, &&l_cf, \
+  &&l_d0, &&l_d1, &&l_d2, &&l_d3, &&l_d4, &&l_d5, &&l_d6, &&l_d7, \
+  &&l_d8, &&l_d9, &&l_da, &&l_db, &&l_dc, &&l_dd, &&l_de, &&l_df, \
+  &&l_e0, &&l_e1, &&l_e2, &&l_e3, &&l_e4, &&l_e5, &&l_e6, &&l_e7, \
+  &&l_e8, &&l_e9, &&l_ea, &&l_eb, &&l_ec, &&l_ed, &&l_ee, &&l_ef, \
+  &&l_f0, &&l_f1, &&l_f2, &&l_f3, &&l_f4, &&l_f5, &&l_f6, &&l_f7, \
+  &&l_f8, &&l_f9, &&l_fa, &&l_fb, &&l_fc, &&l_fd, &&l_fe, &&l_ff
+
+/* fetch and jump to the next opcode */
+#define THREADED_DISPATCH \
+{                         \
+  R++;                    \
+  op = ROP();             \
+  CC(op,op);              \
+  goto *labels[op];       \
+}
+
+/* back to the z80_run() loop when one of its checks is due */
+#define THREADED_NEXT \
+  if ((Z80.cycles >= cycles) || HALT || Z80.after_ei || (Z80.irq_state && IFF1)) continue; \
+  THREADED_DISPATCH
+
+#define THREADED_OP(opcode) l_##opcode: op_##opcode(); THREADED_NEXT
+
+#define THREADED_OPS \
+  THREADED_OP(00) THREADED_OP(01) THREADED_OP(02) THREADED_OP(03) \
+  THREADED_OP(04) THREADED_OP(05) THREADED_OP(06) THREADED_OP(07) \
+  THREADED_OP(08) THREADED_OP(09) THREADED_OP(0a) THREADED_OP(0b) \
+  THREADED_OP(0c) THREADED_OP(0d) THREADED_OP(0e) THREADED_OP(0f) \
+  THREADED_OP(10) THREADED_OP(11) THREADED_OP(12) THREADED_OP(13) \
+  THREADED_OP(14) THREADED_OP(15) THREADED_OP(16) THREADED_OP(17) \
+  THREADED_OP(18) THREADED_OP(19) THREADED_OP(1a) THREADED_OP(1b) \
+  THREADED_OP(1c) THREADED_OP(1d) THREADED_OP(1e) THREADED_OP(1f) \
+  THREADED_OP(20) THREADED_OP(21) THREADED_OP(22) THREADED_OP(23) \
+  THREADED_OP(24) THREADED_OP(25) THREADED_OP(26) THREADED_OP(27) \
+  THREADED_OP(28) THREADED_OP(29) THREADED_OP(2a) THREADED_OP(2b) \
+  THREADED_OP(2c) THREADED_OP(2d) THREADED_OP(2e) THREADED_OP(2f) \
+  THREADED_OP(30) THREADED_OP(31) THREADED_OP(32) THREADED_OP(33) \
+  THREADED_OP(34) THREADED_OP(35) THREADED_OP(36) THREADED_OP(37) \
+  THREADED_OP(38) THREADED_OP(39) THREADED_OP(3a) THREADED_OP(3b) \
+  THREADED_OP(3c) THREADED_OP(3d) THREADED_OP(3e) THREADED_OP(3f) \
+  THREADED_OP(40) THREADED_OP(41) THREADED_OP(42) THREADED_OP(43) \
+  THREADED_OP(44) THREADED_OP(45) THREADED_OP(46) THREADED_OP(47) \
+  THREADED_OP(48) THREADED_OP(49) THREADED_OP(4a) THREADED_OP(4b) \
+  THREADED_OP(4c) THREADED_OP(4d) THREADED_OP(4e) THREADED_OP(4f) \
+  THREADED_OP(50) THREADED_OP(51) THREADED_OP(52) THREADED_OP(53) \
+  THREADED_OP(54) THREADED_OP(55) THREADED_OP(56) THREADED_OP(57) \
+  THREADED_OP(58) THREADED_OP(59) THREADED_OP(5a) THREADED_OP(5b) \
+  THREADED_OP(5c) THREADED_OP(5d) THREADED_OP(5e) THREADED_OP(5f) \
+  THREADED_OP(60) THREADED_OP(61) THREADED_OP(62) THREADED_OP(63) \
+  THREADED_OP(64) THREADED_OP(65) THREADED_OP(66) THREADED_OP(67) \
+  THREADED_OP(68) THREADED_OP(69) THREADED_OP(6a) THREADED_OP(6b) \
+  THREADED_OP(6c) THREADED_OP(6d) THREADED_OP(6e) THREADED_OP(6f) \
+  THREADED_OP(70) THREADED_OP(71) THREADED_OP(72) THREADED_OP(73) \
+  THREADED_OP(74) THREADED_OP(75) THREADED_OP(76) THREADED_OP(77) \
+  THREADED_OP(78) THREADED_OP(79) THREADED_OP(7a) THREADED_OP(7b) \
+  THREADED_OP(7c) THREADED_OP(7d) THREADED_OP(7e) THREADED_OP(7f) \
+  THREADED_OP(80) THREADED_OP(81) THREADED_OP(82) THREADED_OP(83) \
+  THREADED_OP(84) THREADED_OP(85) THREADED_OP(86) THREADED_OP(87) \
+  THREADED_OP(88) THREADED_OP(89) THREADED_OP(8a) THREADED_OP(8b) \
+  THREADED_OP(8c) THREADED_OP(8d) THREADED_OP(8e) THREADED_OP(8f) \
+  THREADED_OP(90) THREADED_OP(91) THREADED_OP(92) THREADED_OP(93) \
+  THREADED_OP(94) THREADED_OP(95) THREADED_OP(96) THREADED_OP(97) \
+  THREADED_OP(98) THREADED_OP(99) THREADED_OP(9a) THREADED_OP(9b) \
+  THREADED_OP(9c) THREADED_OP(9d) THREADED_OP(9e) THREADED_OP(9f) \
+  THREADED_OP(a0) THREADED_OP(a1) THREADED_OP(a2) THREADED_OP(a3) \
+  THREADED_OP(a4) THREADED_OP(a5) THREADED_OP(a6) THREADED_OP(a7) \
+  THREADED_OP(a8) THREADED_OP(a9) THREADED_OP(aa) THREADED_OP(ab) \
+  THREADED_OP(ac) THREADED_OP(ad) THREADED_OP(ae) THREADED_OP(af) \
+  THREADED_OP(b0) THREADED_OP(b1) THREADED_OP(b2) THREADED_OP(b3) \
+  THREADED_OP(b4) THREADED_OP(b5) THREADED_OP(b6) THREADED_OP(b7) \
+  THREADED_OP(b8) THREADED_OP(b9) THREADED_OP(ba) THREADED_OP(bb) \
+  THREADED_OP(bc) THREADED_OP(bd) THREADED_OP(be) THREADED_OP(bf) \
+  THREADED_OP(c0) THREADED_OP(c1) THREADED_OP(c2) THREADED_OP(c3) \
+  THREADED_OP(c4) THREADED_OP(c5) THREADED_OP(c6) THREADED_OP(c7) \
+  THREADED_OP(c8) THREADED_OP(c9) THREADED_OP(ca) THREADED_OP(cb) \
+  THREADED_OP(cc) THREADED_OP(cd) THREADED_OP(ce) THREADED_OP(cf) \
+  THREADED_OP(d0) THREADED_OP(d1) THREADED_OP(d2) THREADED_OP(d3) \
+  THREADED_OP(d4) THREADED_OP(d5) THREADED_OP(d6) THREADED_OP(d7) \
+  THREADED_OP(d8) THREADED_OP(d9) THREADED_OP(da) THREADED_OP(db) \
+  THREADED_OP(dc) THREADED_OP(dd) THREADED_OP(de) THREADED_OP(df) \
+  THREADED_OP(e0) THREADED_OP(e1) THREADED_OP(e2) THREADED_OP(e3) \
+  THREADED_OP(e4) THREADED_OP(e5) THREADED_OP(e6) THREADED_OP(e7) \
+  THREADED_OP(e8) THREADED_OP(e9) THREADED_OP(ea) THREADED_OP(eb) \
+  THREADED_OP(ec) THREADED_OP(ed) THREADED_OP(ee) THREADED_OP(ef) \
+  THREADED_OP(f0) THREADED_OP(f1) THREADED_OP(f2) THREADED_OP(f3) \
+  THREADED_OP(f4) THREADED_OP(f5) THREADED_OP(f6) THREADED_OP(f7) \
+  THREADED_OP(f8) THREADED_OP(f9) THREADED_OP(fa) THREADED_OP(fb) \
+  THREADED_OP(fc) THREADED_OP(fd) THREADED_OP(fe) THREADED_OP(ff)
+#endif
+
 
 /***************************************************************
  * Enter HALT state; write 1 to fake port on first execution
@@ -616,22 +764,70 @@ INLINE void BURNODD(int cycles, int opcodes, int cyclesum)
 /***************************************************************
  * Input a byte from given I/O port
  ***************************************************************/
-#define IN(port) z80_readport(port)
+#define IN(port) (z80_idle.dirty = 1, z80_readport(port))
 
 /***************************************************************
  * Output a byte to given I/O port
  ***************************************************************/
-#define OUT(port,value) z80_writeport(port,value)
+#define OUT(port,value) (z80_idle.dirty = 1, z80_writeport(port,value))
+
+/***************************************************************
+ * Bus noise on a Genesis mode read of 68k address A (see wasm/chaos_bus.h;
+ * Z80 RAM is $A00000-$A01FFF, and its reads are not idle either)
+ ***************************************************************/
+#ifdef CHAOS_BUS_NOISE
+#define BUS_NOISE(A,V) (z80_idle.dirty = 1, chaos_bus_tick(A) ? chaos_bus_fault(A, V, 1) : (V))
+#else
+#define BUS_NOISE(A,V) (V)
+#endif
 
 /***************************************************************
  * Read a byte from given memory location
+ * (only Z80 RAM in Genesis mode is known not to change while the Z80 runs;
+ * it is read straight from the page map, and the 68k bank window straight
+ * from the 68k page when no handler covers it, as z80_memory_r() would:
+ * the handler only sees the YM2612, VDP and 68k hardware)
  ***************************************************************/
-#define RM(addr) z80_readmem(addr)
+INLINE UINT8 RM(UINT32 addr)
+{
+  if (z80_readmem == z80_memory_r)
+  {
+    if (addr < 0x4000)
+    {
+      return BUS_NOISE(0xA00000 | (addr & 0x1FFF), z80_readmap[addr >> 10][addr & 0x03FF]);
+    }
+    z80_idle.dirty = 1;
+    if (addr & 0x8000)
+    {
+      UINT32 bank = zbank | (addr & 0x7FFF);
+      if (!zbank_memory_map[bank >> 16].read)
+      {
+        /* average Z80 wait-states when accessing 68k area */
+        Z80.cycles += 3 * 15;
+        return BUS_NOISE(bank, READ_BYTE(m68k.memory_map[bank >> 16].base, bank & 0xFFFF));
+      }
+      return BUS_NOISE(bank, z80_memory_r(addr));
+    }
+    return z80_memory_r(addr);
+  }
+  z80_idle.dirty = 1;
+  return z80_readmem(addr);
+}
 
 /***************************************************************
  * Write a byte to given memory location
+ * (Z80 RAM in Genesis mode through the page map, as above)
  ***************************************************************/
-#define WM(addr,value) z80_writemem(addr,value)
+INLINE void WM(UINT32 addr, UINT8 value)
+{
+  z80_idle.dirty = 1;
+  if ((addr < 0x4000) && (z80_writemem == z80_memory_w))
+  {
+    z80_writemap[addr >> 10][addr & 0x03FF] = value;
+    return;
+  }
+  z80_writemem(addr, value);
+}
 
 /***************************************************************
  * Read a word from given memory location
@@ -700,12 +896,43 @@ INLINE UINT32 ARG16(void)
  ***************************************************************/
 #define PUSH(SR) do { SP -= 2; WM16( SPD, &Z80.SR ); } while (0)
 
+/***************************************************************
+ * Idle loop check after a backward jump
+ ***************************************************************/
+static void z80_idle_check(void)
+{
+  if ((PCD == z80_idle.pc) && !z80_idle.dirty &&
+      !memcmp(&Z80, &z80_idle.regs, offsetof(Z80_Regs, r)) &&
+      !memcmp(&Z80.r2, &z80_idle.regs.r2, offsetof(Z80_Regs, nmi_state) - offsetof(Z80_Regs, r2)) &&
+      !(Z80.irq_state && IFF1))
+  {
+    /* idle: skip the passes that fit before the end of the slice */
+    UINT32 pass = Z80.cycles - z80_idle.cycles;
+    UINT32 count = (z80_idle.end > Z80.cycles) ? ((z80_idle.end - Z80.cycles) / pass) : 0;
+    UINT8 refresh = R - z80_idle.r;
+
+    Z80.cycles += count * pass;
+    R += count * refresh;
+  }
+  else
+  {
+    z80_idle.pc = PCD;
+    z80_idle.regs = Z80;
+  }
+
+  z80_idle.cycles = Z80.cycles;
+  z80_idle.r = R;
+  z80_idle.dirty = 0;
+}
+
 /***************************************************************
  * JP
  ***************************************************************/
 #define JP {                                    \
+  UINT32 from = PCD;                            \
   PCD = ARG16();                                \
   WZ = PCD;                                     \
+  if (PCD < from) z80_idle_check();             \
 }
 
 /***************************************************************
@@ -714,8 +941,10 @@ INLINE UINT32 ARG16(void)
 #define JP_COND(cond) {                         \
   if (cond)                                     \
   {                                             \
+    UINT32 from = PCD;                          \
     PCD = ARG16();                              \
     WZ = PCD;                                   \
+    if (PCD < from) z80_idle_check();           \
   }                                             \
   else                                          \
   {                                             \
@@ -732,14 +961,23 @@ INLINE UINT32 ARG16(void)
   WZ = PC;                                                \
 }
 
+/* same, with the idle loop check on backward jumps (not DJNZ, B changes every pass) */
+#define JR_IDLE() {                                       \
+  INT8 arg = (INT8)ARG();                                 \
+  PC += arg;                                              \
+  WZ = PC;                                                \
+  if (arg < 0) z80_idle_check();                          \
+}
+
 /***************************************************************
  * JR_COND
  ***************************************************************/
 #define JR_COND(cond, opcode) {   \
   if (cond)                       \
   {                               \
-    JR();                         \
     CC(ex, opcode);               \
+    if (opcode == 0x10) JR()      \
+    else JR_IDLE()                \
   }                               \
   else PC++;                      \
 }
@@ -2968,7 +3206,7 @@ OP(op,15) { D = DEC(D);
 OP(op,16) { D = ARG();                                                                                     } /* LD   D,n         */
 OP(op,17) { RLA;                                                                                           } /* RLA              */
 
-OP(op,18) { JR();                                                                                          } /* JR   o           */
+OP(op,18) { JR_IDLE();                                                                                      } /* JR   o           */
 OP(op,19) { ADD16(hl, de);                                                                                 } /* ADD  HL,DE       */
 OP(op,1a) { A = RM( DE ); WZ=DE+1;                                                                         } /* LD   A,(DE)      */
 OP(op,1b) { DE--;                                                                                          } /* DEC  DE          */
@@ -3295,11 +3533,19 @@ static void take_interrupt(void)
   WZ=PCD;
 }
 
+/* flag tables, for the memory report (memmap.h) */
+void z80_memory_report(void)
+{
+  memory_region("z80 SZHVC_add", SZHVC_add, sizeof(SZHVC_add));
+  memory_region("z80 SZHVC_sub", SZHVC_sub, sizeof(SZHVC_sub));
+}
+
 /****************************************************************************
  * Processor initialization
  ****************************************************************************/
 void z80_init(const void *config, int (*irqcallback)(int))
 {
+  static int tables_built = 0;
   int i, p;
 
   int oldval, newval, val;
@@ -3307,70 +3553,76 @@ void z80_init(const void *config, int (*irqcallback)(int))
   UINT8 *padc = &SZHVC_add[256*256];
   UINT8 *psub = &SZHVC_sub[  0*256];
   UINT8 *psbc = &SZHVC_sub[256*256];
-  for (oldval = 0; oldval < 256; oldval++)
+
+  /* flag tables are constant: built on the first call, kept across resets */
+  if (!tables_built)
   {
-    for (newval = 0; newval < 256; newval++)
+    tables_built = 1;
+    for (oldval = 0; oldval < 256; oldval++)
     {
-      /* add or adc w/o carry set */
-      val = newval - oldval;
-      *padd = (newval) ? ((newval & 0x80) ? SF : 0) : ZF;
-      *padd |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
-      if( (newval & 0x0f) < (oldval & 0x0f) ) *padd |= HF;
-      if( newval < oldval ) *padd |= CF;
-      if( (val^oldval^0x80) & (val^newval) & 0x80 ) *padd |= VF;
-      padd++;
-
-      /* adc with carry set */
-      val = newval - oldval - 1;
-      *padc = (newval) ? ((newval & 0x80) ? SF : 0) : ZF;
-      *padc |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
-      if( (newval & 0x0f) <= (oldval & 0x0f) ) *padc |= HF;
-      if( newval <= oldval ) *padc |= CF;
-      if( (val^oldval^0x80) & (val^newval) & 0x80 ) *padc |= VF;
-      padc++;
-
-      /* cp, sub or sbc w/o carry set */
-      val = oldval - newval;
-      *psub = NF | ((newval) ? ((newval & 0x80) ? SF : 0) : ZF);
-      *psub |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
-      if( (newval & 0x0f) > (oldval & 0x0f) ) *psub |= HF;
-      if( newval > oldval ) *psub |= CF;
-      if( (val^oldval) & (oldval^newval) & 0x80 ) *psub |= VF;
-      psub++;
-
-      /* sbc with carry set */
-      val = oldval - newval - 1;
-      *psbc = NF | ((newval) ? ((newval & 0x80) ? SF : 0) : ZF);
-      *psbc |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
-      if( (newval & 0x0f) >= (oldval & 0x0f) ) *psbc |= HF;
-      if( newval >= oldval ) *psbc |= CF;
-      if( (val^oldval) & (oldval^newval) & 0x80 ) *psbc |= VF;
-      psbc++;
+      for (newval = 0; newval < 256; newval++)
+      {
+        /* add or adc w/o carry set */
+        val = newval - oldval;
+        *padd = (newval) ? ((newval & 0x80) ? SF : 0) : ZF;
+        *padd |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
+        if( (newval & 0x0f) < (oldval & 0x0f) ) *padd |= HF;
+        if( newval < oldval ) *padd |= CF;
+        if( (val^oldval^0x80) & (val^newval) & 0x80 ) *padd |= VF;
+        padd++;
+
+        /* adc with carry set */
+        val = newval - oldval - 1;
+        *padc = (newval) ? ((newval & 0x80) ? SF : 0) : ZF;
+        *padc |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
+        if( (newval & 0x0f) <= (oldval & 0x0f) ) *padc |= HF;
+        if( newval <= oldval ) *padc |= CF;
+        if( (val^oldval^0x80) & (val^newval) & 0x80 ) *padc |= VF;
+        padc++;
+
+        /* cp, sub or sbc w/o carry set */
+        val = oldval - newval;
+        *psub = NF | ((newval) ? ((newval & 0x80) ? SF : 0) : ZF);
+        *psub |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
+        if( (newval & 0x0f) > (oldval & 0x0f) ) *psub |= HF;
+        if( newval > oldval ) *psub |= CF;
+        if( (val^oldval) & (oldval^newval) & 0x80 ) *psub |= VF;
+        psub++;
+
+        /* sbc with carry set */
+        val = oldval - newval - 1;
+        *psbc = NF | ((newval) ? ((newval & 0x80) ? SF : 0) : ZF);
+        *psbc |= (newval & (YF | XF));  /* undocumented flag bits 5+3 */
+        if( (newval & 0x0f) >= (oldval & 0x0f) ) *psbc |= HF;
+        if( newval >= oldval ) *psbc |= CF;
+        if( (val^oldval) & (oldval^newval) & 0x80 ) *psbc |= VF;
+        psbc++;
+      }
     }
-  }
 
-  for (i = 0; i < 256; i++)
-  {
-    p = 0;
-    if( i&0x01 ) ++p;
-    if( i&0x02 ) ++p;
-    if( i&0x04 ) ++p;
-    if( i&0x08 ) ++p;
-    if( i&0x10 ) ++p;
-    if( i&0x20 ) ++p;
-    if( i&0x40 ) ++p;
-    if( i&0x80 ) ++p;
-    SZ[i] = i ? i & SF : ZF;
-    SZ[i] |= (i & (YF | XF));    /* undocumented flag bits 5+3 */
-    SZ_BIT[i] = i ? i & SF : ZF | PF;
-    SZ_BIT[i] |= (i & (YF | XF));  /* undocumented flag bits 5+3 */
-    SZP[i] = SZ[i] | ((p & 1) ? 0 : PF);
-    SZHV_inc[i] = SZ[i];
-    if( i == 0x80 ) SZHV_inc[i] |= VF;
-    if( (i & 0x0f) == 0x00 ) SZHV_inc[i] |= HF;
-    SZHV_dec[i] = SZ[i] | NF;
-    if( i == 0x7f ) SZHV_dec[i] |= VF;
-    if( (i & 0x0f) == 0x0f ) SZHV_dec[i] |= HF;
+    for (i = 0; i < 256; i++)
+    {
+      p = 0;
+      if( i&0x01 ) ++p;
+      if( i&0x02 ) ++p;
+      if( i&0x04 ) ++p;
+      if( i&0x08 ) ++p;
+      if( i&0x10 ) ++p;
+      if( i&0x20 ) ++p;
+      if( i&0x40 ) ++p;
+      if( i&0x80 ) ++p;
+      SZ[i] = i ? i & SF : ZF;
+      SZ[i] |= (i & (YF | XF));    /* undocumented flag bits 5+3 */
+      SZ_BIT[i] = i ? i & SF : ZF | PF;
+      SZ_BIT[i] |= (i & (YF | XF));  /* undocumented flag bits 5+3 */
+      SZP[i] = SZ[i] | ((p & 1) ? 0 : PF);
+      SZHV_inc[i] = SZ[i];
+      if( i == 0x80 ) SZHV_inc[i] |= VF;
+      if( (i & 0x0f) == 0x00 ) SZHV_inc[i] |= HF;
+      SZHV_dec[i] = SZ[i] | NF;
+      if( i == 0x7f ) SZHV_dec[i] |= VF;
+      if( (i & 0x0f) == 0x0f ) SZHV_dec[i] |= HF;
+    }
   }
 
   /* Initialize Z80 */
@@ -3417,6 +3669,10 @@ void z80_reset(void)
  ****************************************************************************/
 void z80_run(unsigned int cycles)
 {
+  /* Z80 RAM may have been written by the 68k since the last slice */
+  z80_idle.end = cycles;
+  z80_idle.dirty = 1;
+
   while( Z80.cycles < cycles )
   {
     /* check for IRQs before each instruction */
@@ -3427,8 +3683,33 @@ void z80_run(unsigned int cycles)
     }
 
     Z80.after_ei = FALSE;
+
+    /* halted with no IRQ to take: HALT is fetched again until the end of the slice */
+    if (HALT)
+    {
+      UINT32 step = cc[Z80_TABLE_op][0x76];
+      UINT32 count;
+#ifdef Z80_OVERCLOCK_SHIFT
+      step = (step * z80_cycle_ratio) >> Z80_OVERCLOCK_SHIFT;
+#endif
+      count = (cycles - Z80.cycles + step - 1) / step;
+      R += count;
+      Z80.cycles += count * step;
+      return;
+    }
+#if Z80_THREADED
+    /* an opcode goes on with the next one until a check above is due */
+    {
+      static const void *const labels[0x100] = { THREADED_LABELS };
+      unsigned op;
+
+      THREADED_DISPATCH
+      THREADED_OPS
+    }
+#else
     R++;
     EXEC_INLINE(op,ROP());
+#endif
   }
 } 
 
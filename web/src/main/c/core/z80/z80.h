@@ -64,6 +64,7 @@ extern void (*z80_writeport)(unsigned int port, unsigned char data);
 extern unsigned char (*z80_readport)(unsigned int port);
 
 extern void z80_init(const void *config, int (*irqcallback)(int));
+extern void z80_memory_report(void);
 extern void z80_reset (void);
 extern void z80_run(unsigned int cycles);
 extern void z80_get_context (void *dst);
@@ -0,0 +1,87 @@
+/**
+ * ChaosDrive - battery backed memory persistence
+ *
+ * Taking the marks is a copy of 32 bytes; only Master System games pay for
+ * a comparison of their cartridge RAM with the copy of the last take.
+ */
+
+#include "shared.h"
+#include "memmap.h"
+#include "backup.h"
+
+static int attached;
+static uint32_t taken[BACKUP_BLOCKS / 32];
+
+#ifndef MD_ONLY
+static uint8 shadow[BACKUP_BLOCKS * BACKUP_BLOCK];
+
+/* blocks of the Z80 mapped cartridge RAM that differ from the last take */
+static void compare_blocks(void)
+{
+    int i;
+
+    for (i = 0; i < BACKUP_BLOCKS; i++)
+    {
+        uint8 *block = sram.sram + i * BACKUP_BLOCK;
+
+        if (memcmp(block, shadow + i * BACKUP_BLOCK, BACKUP_BLOCK))
+        {
+            memcpy(shadow + i * BACKUP_BLOCK, block, BACKUP_BLOCK);
+            SRAM_DIRTY(i * BACKUP_BLOCK);
+        }
+    }
+}
+#endif
+
+int backup_size(void)
+{
+    return (sram.on && sram.sram) ? BACKUP_BLOCKS * BACKUP_BLOCK : 0;
+}
+
+uint8_t *backup_data(void)
+{
+    return sram.sram;
+}
+
+void backup_attach(void)
+{
+    attached = backup_size() != 0;
+    memset(sram.dirty, 0, sizeof(sram.dirty));
+#ifndef MD_ONLY
+    if (attached)
+        memcpy(shadow, sram.sram, sizeof(shadow));
+#endif
+}
+
+void backup_detach(void)
+{
+    attached = 0;
+}
+
+const uint32_t *backup_take(void)
+{
+    int i, dirty = 0;
+
+    if (!attached)
+        return NULL;
+
+#ifndef MD_ONLY
+    if ((system_hw & SYSTEM_PBC) != SYSTEM_MD)
+        compare_blocks();
+#endif
+
+    for (i = 0; i < BACKUP_BLOCKS / 32; i++)
+    {
+        taken[i] = sram.dirty[i];
+        dirty |= taken[i];
+        sram.dirty[i] = 0;
+    }
+    return dirty ? taken : NULL;
+}
+
+void backup_memory_report(void)
+{
+#ifndef MD_ONLY
+    memory_region("backup copy", shadow, sizeof(shadow));
+#endif
+}
@@ -0,0 +1,44 @@
+#ifndef _BACKUP_H_
+#define _BACKUP_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Battery backed cartridge memory persistence (backup.js).
+ *
+ * SRAM and serial EEPROM contents live in sram.sram (64K at most). The core
+ * marks the 256-byte blocks it writes there (SRAM_DIRTY() in sram.h); the
+ * front end takes the marks after each run of frames, copies those blocks
+ * and stores them a little later, so a game writing its save every frame
+ * costs one small write every second or so.
+ *
+ * Master System cartridge RAM is mapped straight into the Z80 pages, with
+ * no handler to mark it: its blocks are compared with a copy instead.
+ *
+ * A session reset (recording, replay, netplay) starts from a blank backup
+ * memory that is not the player's: tracking stops until backup_attach().
+ */
+
+#define BACKUP_BLOCK  256
+#define BACKUP_BLOCKS 256
+
+/* Backup memory of the running game: backup_size() bytes at backup_data(),
+ * 0 when the cartridge has none */
+int EMSCRIPTEN_KEEPALIVE backup_size(void);
+uint8_t* EMSCRIPTEN_KEEPALIVE backup_data(void);
+
+/* Start tracking once the front end wrote the saved blocks back (nothing is
+ * dirty then) */
+void EMSCRIPTEN_KEEPALIVE backup_attach(void);
+
+/* Stop tracking until the next backup_attach() */
+void backup_detach(void);
+
+/* Blocks written since the last take: BACKUP_BLOCKS bits, block n is bit
+ * n & 31 of word n >> 5; NULL when there are none or nothing is tracked */
+const uint32_t* EMSCRIPTEN_KEEPALIVE backup_take(void);
+
+/* Add the comparison copy to the memory report */
+void backup_memory_report(void);
+
+#endif /* _BACKUP_H_ */
@@ -0,0 +1,262 @@
+/**
+ * ChaosDrive - integer scale line blitter
+ *
+ * The vector path keeps the red, green and blue bytes of the first 192
+ * palette entries (normal, shadow and highlight colors) in separate planes
+ * and looks up 16 pixel indices at once, one 16-entry shuffle per palette
+ * slice, instead of gathering 32-bit palette words one pixel at a time. The
+ * converted pixels are repeated across with 32-bit lane shuffles; the other
+ * rows of a scaled line are copies of the first one.
+ */
+
+#include <string.h>
+#include "blitter.h"
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define BLIT_VEC128
+typedef v128_t vec128_t;
+#define VEC_LOAD(p)         wasm_v128_load(p)
+#define VEC_STORE(p, v)     wasm_v128_store(p, v)
+#define VEC_SPLAT(b)        wasm_i8x16_splat(b)
+#define VEC_AND(a, b)       wasm_v128_and(a, b)
+#define VEC_OR(a, b)        wasm_v128_or(a, b)
+#define VEC_XOR(a, b)       wasm_v128_xor(a, b)
+#define VEC_SHR4(v)         wasm_u8x16_shr(v, 4)
+#define VEC_EQ(a, b)        wasm_i8x16_eq(a, b)
+#define VEC_MAX(a, b)       wasm_u8x16_max(a, b)
+#define VEC_TBL(t, i)       wasm_i8x16_swizzle(t, i)
+#define VEC_ANY(v)          wasm_v128_any_true(v)
+#define VEC_ZIPLO8(a, b)    wasm_i8x16_shuffle(a, b, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23)
+#define VEC_ZIPHI8(a, b)    wasm_i8x16_shuffle(a, b, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31)
+#define VEC_ZIPLO16(a, b)   wasm_i16x8_shuffle(a, b, 0, 8, 1, 9, 2, 10, 3, 11)
+#define VEC_ZIPHI16(a, b)   wasm_i16x8_shuffle(a, b, 4, 12, 5, 13, 6, 14, 7, 15)
+#define VEC_ZIPLO32(a, b)   wasm_i32x4_shuffle(a, b, 0, 4, 1, 5)
+#define VEC_ZIPHI32(a, b)   wasm_i32x4_shuffle(a, b, 2, 6, 3, 7)
+#define VEC_SHUF32(v, a, b, c, d) wasm_i32x4_shuffle(v, v, a, b, c, d)
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define BLIT_VEC128
+typedef __m128i vec128_t;
+#define VEC_LOAD(p)         _mm_loadu_si128((const __m128i *)(p))
+#define VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+#define VEC_SPLAT(b)        _mm_set1_epi8((char)(b))
+#define VEC_AND(a, b)       _mm_and_si128(a, b)
+#define VEC_OR(a, b)        _mm_or_si128(a, b)
+#define VEC_XOR(a, b)       _mm_xor_si128(a, b)
+#define VEC_SHR4(v)         _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F))
+#define VEC_EQ(a, b)        _mm_cmpeq_epi8(a, b)
+#define VEC_MAX(a, b)       _mm_max_epu8(a, b)
+#define VEC_TBL(t, i)       _mm_shuffle_epi8(t, i)
+#define VEC_ANY(v)          (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF)
+#define VEC_ZIPLO8(a, b)    _mm_unpacklo_epi8(a, b)
+#define VEC_ZIPHI8(a, b)    _mm_unpackhi_epi8(a, b)
+#define VEC_ZIPLO16(a, b)   _mm_unpacklo_epi16(a, b)
+#define VEC_ZIPHI16(a, b)   _mm_unpackhi_epi16(a, b)
+#define VEC_ZIPLO32(a, b)   _mm_unpacklo_epi32(a, b)
+#define VEC_ZIPHI32(a, b)   _mm_unpackhi_epi32(a, b)
+#define VEC_SHUF32(v, a, b, c, d) _mm_shuffle_epi32(v, _MM_SHUFFLE(d, c, b, a))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BLIT_VEC128
+typedef uint8x16_t vec128_t;
+#define VEC_LOAD(p)         vld1q_u8((const uint8_t *)(p))
+#define VEC_STORE(p, v)     vst1q_u8((uint8_t *)(p), v)
+#define VEC_SPLAT(b)        vdupq_n_u8(b)
+#define VEC_AND(a, b)       vandq_u8(a, b)
+#define VEC_OR(a, b)        vorrq_u8(a, b)
+#define VEC_XOR(a, b)       veorq_u8(a, b)
+#define VEC_SHR4(v)         vshrq_n_u8(v, 4)
+#define VEC_EQ(a, b)        vceqq_u8(a, b)
+#define VEC_MAX(a, b)       vmaxq_u8(a, b)
+#define VEC_TBL(t, i)       vqtbl1q_u8(t, i)
+#define VEC_ANY(v)          (vmaxvq_u8(v) != 0)
+#define VEC_ZIPLO8(a, b)    vzip1q_u8(a, b)
+#define VEC_ZIPHI8(a, b)    vzip2q_u8(a, b)
+#define VEC_ZIPLO16(a, b)   vreinterpretq_u8_u16(vzip1q_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)))
+#define VEC_ZIPHI16(a, b)   vreinterpretq_u8_u16(vzip2q_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)))
+#define VEC_ZIPLO32(a, b)   vreinterpretq_u8_u32(vzip1q_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)))
+#define VEC_ZIPHI32(a, b)   vreinterpretq_u8_u32(vzip2q_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)))
+#define VEC_LANE32(k)       (0x03020100u + 0x04040404u * (k))
+#define VEC_SHUF32(v, a, b, c, d) vqtbl1q_u8(v, vreinterpretq_u8_u32((uint32x4_t){ VEC_LANE32(a), VEC_LANE32(b), VEC_LANE32(c), VEC_LANE32(d) }))
+#endif
+
+int blit_palette_dirty = 1;
+
+/* RGB -> ABGR, one index, 'scale' pixels across */
+#define BLIT_PIXEL(dst, scale, palette, index, diff) \
+{ \
+    uint32_t px = palette[index]; \
+    uint32_t pset = 0xff000000 | ((px & 0x0000ff) << 16) | (px & 0x00ff00) | ((px & 0xff0000) >> 16); \
+    int k_; \
+    diff |= dst[0] ^ pset; \
+    for (k_ = 0; k_ < scale; k_++) \
+        dst[k_] = pset; \
+    dst += scale; \
+}
+
+#ifdef BLIT_VEC128
+
+/* Palette entries covered by the vector path */
+#define BLIT_PLANE_SIZE 0xC0
+
+/* red, green and blue bytes of each palette entry */
+static uint8_t planes[3][BLIT_PLANE_SIZE] __attribute__((aligned(16)));
+
+/* 16-entry palette slices to look up (4 = shadow/highlight entries are copies) */
+static int slices;
+
+static void update_planes(const uint32_t *palette)
+{
+    int i;
+
+    for (i = 0; i < BLIT_PLANE_SIZE; i++)
+    {
+        planes[0][i] = (palette[i] >> 16) & 0xff;
+        planes[1][i] = (palette[i] >> 8) & 0xff;
+        planes[2][i] = palette[i] & 0xff;
+    }
+
+    /* without shadow/highlight (and in Mode 4), only the first 64 entries are distinct */
+    slices = (memcmp(palette, palette + 0x40, 0x40 * sizeof(uint32_t)) ||
+              memcmp(palette, palette + 0x80, 0x40 * sizeof(uint32_t))) ? 12 : 4;
+
+    blit_palette_dirty = 0;
+}
+
+/* store 4 output pixels */
+#define STORE_VEC(dst, v, diff) \
+{ \
+    vec128_t v_ = v; \
+    diff = VEC_OR(diff, VEC_XOR(v_, VEC_LOAD(dst))); \
+    VEC_STORE(dst, v_); \
+    dst += 4; \
+}
+
+/* 4 ABGR pixels of src, each 'scale' times */
+#define STORE_SCALED(dst, scale, v, diff) \
+switch (scale) \
+{ \
+    case 1: \
+        STORE_VEC(dst, v, diff) \
+        break; \
+    case 2: \
+        STORE_VEC(dst, VEC_ZIPLO32(v, v), diff) \
+        STORE_VEC(dst, VEC_ZIPHI32(v, v), diff) \
+        break; \
+    case 3: \
+        STORE_VEC(dst, VEC_SHUF32(v, 0, 0, 0, 1), diff) \
+        STORE_VEC(dst, VEC_SHUF32(v, 1, 1, 2, 2), diff) \
+        STORE_VEC(dst, VEC_SHUF32(v, 2, 3, 3, 3), diff) \
+        break; \
+    default: \
+        STORE_VEC(dst, VEC_SHUF32(v, 0, 0, 0, 0), diff) \
+        STORE_VEC(dst, VEC_SHUF32(v, 1, 1, 1, 1), diff) \
+        STORE_VEC(dst, VEC_SHUF32(v, 2, 2, 2, 2), diff) \
+        STORE_VEC(dst, VEC_SHUF32(v, 3, 3, 3, 3), diff) \
+        break; \
+}
+
+static int blit_row(uint32_t *dst, int scale, const uint8_t *src, int width, const uint32_t *palette)
+{
+    uint32_t diff = 0;
+    vec128_t vdiff = VEC_SPLAT(0);
+    const vec128_t last = VEC_SPLAT(BLIT_PLANE_SIZE - 1);
+    const vec128_t alpha = VEC_SPLAT(0xff);
+
+    if (blit_palette_dirty)
+    {
+        update_planes(palette);
+    }
+
+    for (; width >= 16; width -= 16, src += 16)
+    {
+        int k;
+        vec128_t index = VEC_LOAD(src);
+        vec128_t r = VEC_SPLAT(0);
+        vec128_t g = VEC_SPLAT(0);
+        vec128_t b = VEC_SPLAT(0);
+        vec128_t lo, hi, rg, ba;
+
+        /* indices past the planes are never written by the renderer (black) */
+        vec128_t valid = VEC_EQ(VEC_MAX(index, last), last);
+
+        if (slices == 4)
+        {
+            index = VEC_AND(index, VEC_SPLAT(0x3F));
+        }
+
+        /* look up each 16-entry slice, keeping lanes whose index falls in it */
+        lo = VEC_AND(index, VEC_SPLAT(0x0F));
+        hi = VEC_SHR4(index);
+        for (k = 0; k < slices; k++)
+        {
+            vec128_t in = VEC_EQ(hi, VEC_SPLAT(k));
+            r = VEC_OR(r, VEC_AND(VEC_TBL(VEC_LOAD(&planes[0][k << 4]), lo), in));
+            g = VEC_OR(g, VEC_AND(VEC_TBL(VEC_LOAD(&planes[1][k << 4]), lo), in));
+            b = VEC_OR(b, VEC_AND(VEC_TBL(VEC_LOAD(&planes[2][k << 4]), lo), in));
+        }
+        r = VEC_AND(r, valid);
+        g = VEC_AND(g, valid);
+        b = VEC_AND(b, valid);
+
+        /* interleave into ABGR words (byte order r, g, b, a) */
+        rg = VEC_ZIPLO8(r, g);
+        ba = VEC_ZIPLO8(b, alpha);
+        STORE_SCALED(dst, scale, VEC_ZIPLO16(rg, ba), vdiff)
+        STORE_SCALED(dst, scale, VEC_ZIPHI16(rg, ba), vdiff)
+        rg = VEC_ZIPHI8(r, g);
+        ba = VEC_ZIPHI8(b, alpha);
+        STORE_SCALED(dst, scale, VEC_ZIPLO16(rg, ba), vdiff)
+        STORE_SCALED(dst, scale, VEC_ZIPHI16(rg, ba), vdiff)
+    }
+
+    for (; width > 0; width--)
+    {
+        BLIT_PIXEL(dst, scale, palette, *src++, diff)
+    }
+
+    return diff || VEC_ANY(vdiff);
+}
+
+#else
+
+static int blit_row(uint32_t *dst, int scale, const uint8_t *src, int width, const uint32_t *palette)
+{
+    uint32_t diff = 0;
+
+    for (; width > 0; width--)
+    {
+        BLIT_PIXEL(dst, scale, palette, *src++, diff)
+    }
+
+    return diff != 0;
+}
+
+#endif
+
+int blit_line(uint32_t *dst, int pitch, int rows, int scale, const uint8_t *src, int width, const uint32_t *palette)
+{
+    int changed = blit_row(dst, scale, src, width, palette);
+    int i;
+
+    for (i = 1; i < rows; i++)
+    {
+        memcpy(dst + i * pitch, dst, width * scale * sizeof(uint32_t));
+    }
+
+    return changed;
+}
+
+void blit_widen(uint32_t *row, int width, int factor)
+{
+    uint32_t *dst = row + width * factor;
+    int k;
+
+    while (width-- > 0)
+    {
+        uint32_t px = row[width];
+        for (k = 0; k < factor; k++)
+            *--dst = px;
+    }
+}
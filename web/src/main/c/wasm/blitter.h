@@ -0,0 +1,26 @@
+#ifndef _BLITTER_H_
+#define _BLITTER_H_
+
+#include <stdint.h>
+
+/* Integer scale line blitter used by the WASM CUSTOM_BLITTER (32bpp rendering).
+ *
+ * Pixel indices are converted to ABGR (Canvas ImageData byte order) and each
+ * pixel is repeated 1 to 4 times across. When built with -msimd128 (WASM) or
+ * on SSSE3/NEON hosts, 16 pixels are converted at once with byte shuffles over
+ * per-channel copies of the palette and replicated with lane shuffles;
+ * otherwise each pixel is looked up in the palette one at a time.
+ */
+
+/* Set whenever the renderer palette is modified */
+extern int blit_palette_dirty;
+
+/* Convert 'width' indices from src through palette into 'rows' output rows
+ * of width * scale pixels starting at dst ('pitch' pixels apart). Returns
+ * non-zero if the output differs from what was already in the first row. */
+int blit_line(uint32_t *dst, int pitch, int rows, int scale, const uint8_t *src, int width, const uint32_t *palette);
+
+/* Repeat each of the first 'width' pixels of row 'factor' times across, in place */
+void blit_widen(uint32_t *row, int width, int factor);
+
+#endif /* _BLITTER_H_ */
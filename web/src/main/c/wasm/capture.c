@@ -0,0 +1,408 @@
+/**
+ * ChaosDrive - streaming VGM / WAV capture
+ *
+ * VGM 1.50: the stream starts with the chip registers as last written
+ * (keys off), then every YM2612 / PSG write, with waits in 44.1 kHz
+ * samples computed from the master clock time of the write. 68k and Z80
+ * writes of a line are not strictly in time order, a write is never
+ * moved before the previous one.
+ */
+
+#include "shared.h"
+#include "capture.h"
+#include "memmap.h"
+
+#define VGM_RATE 44100
+
+/* VGM commands */
+#define VGM_PSG         0x50
+#define VGM_YM2612      0x52 /* + port */
+#define VGM_WAIT        0x61 /* 16-bit sample count */
+#define VGM_WAIT_60HZ   0x62 /* 735 samples */
+#define VGM_WAIT_50HZ   0x63 /* 882 samples */
+#define VGM_END         0x66
+#define VGM_WAIT_SHORT  0x70 /* + n: n + 1 samples */
+
+#define VGM_HEADER_SIZE 0x40
+#define WAV_HEADER_SIZE 44
+
+#define STREAM_VGM 0
+#define STREAM_WAV 1
+
+static capture_ring_t rings[2];
+static int fill[2];             /* bytes in the open chunk */
+static uint32 total[2];         /* bytes stored since the start */
+static uint8 header[2][CAPTURE_HEADER_MAX];
+static int header_size[2];
+static int active;
+
+/* chip registers as last written */
+static uint8 fm_regs[2][0x100];
+static unsigned int fm_address;
+static uint16 psg_regs[8];
+static int psg_latch;
+
+/* VGM timing: master clocks up to the current frame, samples waited */
+static uint64_t frame_origin;
+static uint64_t samples_written;
+static uint32 vgm_clock;
+
+static void put32(uint8 *p, uint32 value)
+{
+    p[0] = value;
+    p[1] = value >> 8;
+    p[2] = value >> 16;
+    p[3] = value >> 24;
+}
+
+static void ring_seal(int stream)
+{
+    capture_ring_t *ring = &rings[stream];
+
+    ring->length[ring->head & (CAPTURE_CHUNKS - 1)] = fill[stream];
+    fill[stream] = 0;
+    ring->head++;
+}
+
+/* append 'size' bytes, or drop all of them when the ring is full (no torn commands) */
+static void ring_put(int stream, const uint8 *p, int size)
+{
+    capture_ring_t *ring = &rings[stream];
+    int room = (CAPTURE_CHUNKS - (int)(ring->head - ring->tail)) * CAPTURE_CHUNK_SIZE - fill[stream];
+
+    if (size > room)
+    {
+        ring->dropped += size;
+        return;
+    }
+
+    total[stream] += size;
+
+    while (size > 0)
+    {
+        int n = CAPTURE_CHUNK_SIZE - fill[stream];
+        if (n > size)
+            n = size;
+
+        memcpy(ring->data[ring->head & (CAPTURE_CHUNKS - 1)] + fill[stream], p, n);
+        fill[stream] += n;
+        p += n;
+        size -= n;
+
+        if (fill[stream] == CAPTURE_CHUNK_SIZE)
+            ring_seal(stream);
+    }
+}
+
+static void vgm_put(uint8 a, uint8 b, uint8 c, int size)
+{
+    uint8 cmd[3];
+
+    cmd[0] = a;
+    cmd[1] = b;
+    cmd[2] = c;
+    ring_put(STREAM_VGM, cmd, size);
+}
+
+/* wait until 'cycles' master clocks into the current frame */
+static void vgm_sync(unsigned int cycles)
+{
+    uint64_t now = (frame_origin + cycles) * VGM_RATE / vgm_clock;
+
+    while (now > samples_written)
+    {
+        uint64_t wait = now - samples_written;
+
+        if (wait <= 16)
+        {
+            vgm_put(VGM_WAIT_SHORT + wait - 1, 0, 0, 1);
+        }
+        else if (wait == 735)
+        {
+            vgm_put(VGM_WAIT_60HZ, 0, 0, 1);
+        }
+        else if (wait == 882)
+        {
+            vgm_put(VGM_WAIT_50HZ, 0, 0, 1);
+        }
+        else
+        {
+            if (wait > 0xFFFF)
+                wait = 0xFFFF;
+            vgm_put(VGM_WAIT, wait & 0xFF, wait >> 8, 3);
+        }
+
+        samples_written += wait;
+    }
+}
+
+static int has_ym2612(void)
+{
+    return (system_hw & SYSTEM_PBC) == SYSTEM_MD;
+}
+
+/* registers as last written: FM setup, then frequencies (high byte first), PSG */
+static void vgm_dump_state(void)
+{
+    int port, reg, i;
+
+    if (has_ym2612())
+    {
+        vgm_put(VGM_YM2612, 0x22, fm_regs[0][0x22], 3);
+        vgm_put(VGM_YM2612, 0x27, fm_regs[0][0x27], 3);
+        vgm_put(VGM_YM2612, 0x2B, fm_regs[0][0x2B], 3);
+        if (fm_regs[0][0x2B] & 0x80)
+            vgm_put(VGM_YM2612, 0x2A, fm_regs[0][0x2A], 3);
+
+        for (port = 0; port < 2; port++)
+        {
+            for (reg = 0x30; reg < 0xB8; reg++)
+            {
+                /* no channel 4 slot; frequencies below */
+                if (((reg & 3) == 3) || ((reg >= 0xA0) && (reg < 0xB0)))
+                    continue;
+                vgm_put(VGM_YM2612 + port, reg, fm_regs[port][reg], 3);
+            }
+
+            for (reg = 0xA0; reg < 0xAB; reg++)
+            {
+                if ((reg & 3) == 3)
+                    continue;
+                vgm_put(VGM_YM2612 + port, reg + 4, fm_regs[port][reg + 4], 3);
+                vgm_put(VGM_YM2612 + port, reg, fm_regs[port][reg], 3);
+                if (reg == 0xA2)
+                    reg = 0xA7;
+            }
+        }
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        vgm_put(VGM_PSG, 0x80 | (i << 4) | (psg_regs[i] & 0x0F), 0, 2);
+
+        /* tone channels frequency high bits */
+        if (!(i & 1) && (i < 6))
+            vgm_put(VGM_PSG, (psg_regs[i] >> 4) & 0x3F, 0, 2);
+    }
+}
+
+static void vgm_header(void)
+{
+    uint8 *p = header[STREAM_VGM];
+
+    memset(p, 0, VGM_HEADER_SIZE);
+    memcpy(p, "Vgm ", 4);
+    put32(p + 0x04, VGM_HEADER_SIZE + total[STREAM_VGM] - 0x04);
+    put32(p + 0x08, 0x150);
+    put32(p + 0x0C, vgm_clock / 15);
+    put32(p + 0x18, (uint32)samples_written);
+    put32(p + 0x24, vdp_pal ? 50 : 60);
+
+    /* PSG noise feedback and shift register width (SN76489 or Sega integrated PSG) */
+    if (system_hw == SYSTEM_SG)
+    {
+        p[0x28] = 0x06;
+        p[0x2A] = 15;
+    }
+    else
+    {
+        p[0x28] = 0x09;
+        p[0x2A] = 16;
+    }
+
+    if (has_ym2612())
+        put32(p + 0x2C, vgm_clock / 7);
+
+    put32(p + 0x34, VGM_HEADER_SIZE - 0x34);
+    header_size[STREAM_VGM] = VGM_HEADER_SIZE;
+}
+
+static void wav_header(void)
+{
+    uint8 *p = header[STREAM_WAV];
+
+    memcpy(p, "RIFF", 4);
+    put32(p + 4, WAV_HEADER_SIZE - 8 + total[STREAM_WAV]);
+    memcpy(p + 8, "WAVEfmt ", 8);
+    put32(p + 16, 16);
+    put32(p + 20, 1 | (2 << 16));  /* PCM, stereo */
+    put32(p + 24, snd.sample_rate);
+    put32(p + 28, snd.sample_rate * 4);
+    put32(p + 32, 4 | (16 << 16)); /* block align, bits per sample */
+    memcpy(p + 36, "data", 4);
+    put32(p + 40, total[STREAM_WAV]);
+    header_size[STREAM_WAV] = WAV_HEADER_SIZE;
+}
+
+int capture_start(int streams)
+{
+    int i;
+
+    if (active)
+        capture_stop();
+
+    streams &= CAPTURE_VGM | CAPTURE_WAV;
+
+    for (i = 0; i < 2; i++)
+    {
+        if (!(streams & (1 << i)))
+            continue;
+        rings[i].head = 0;
+        rings[i].tail = 0;
+        rings[i].dropped = 0;
+        fill[i] = 0;
+        total[i] = 0;
+        header_size[i] = 0;
+    }
+
+    if (streams & CAPTURE_VGM)
+    {
+        frame_origin = 0;
+        samples_written = 0;
+        vgm_clock = system_clock;
+        vgm_dump_state();
+    }
+
+    active = streams;
+    return streams;
+}
+
+void capture_stop(void)
+{
+    if (active & CAPTURE_VGM)
+    {
+        vgm_put(VGM_END, 0, 0, 1);
+        if (fill[STREAM_VGM])
+            ring_seal(STREAM_VGM);
+        vgm_header();
+    }
+
+    if (active & CAPTURE_WAV)
+    {
+        if (fill[STREAM_WAV])
+            ring_seal(STREAM_WAV);
+        wav_header();
+    }
+
+    active = 0;
+}
+
+capture_ring_t *capture_ring(int stream)
+{
+    return &rings[(stream == CAPTURE_WAV) ? STREAM_WAV : STREAM_VGM];
+}
+
+int capture_chunk_count(void)
+{
+    return CAPTURE_CHUNKS;
+}
+
+int capture_chunk_size(void)
+{
+    return CAPTURE_CHUNK_SIZE;
+}
+
+uint8_t *capture_header(int stream)
+{
+    return header[(stream == CAPTURE_WAV) ? STREAM_WAV : STREAM_VGM];
+}
+
+int capture_header_size(int stream)
+{
+    return header_size[(stream == CAPTURE_WAV) ? STREAM_WAV : STREAM_VGM];
+}
+
+void capture_fm_write(unsigned int cycles, unsigned int a, unsigned int v)
+{
+    /* address port 0 or 1, data goes to the latched address (as YM2612Write()) */
+    if (!(a & 1))
+    {
+        fm_address = (a & 2) ? (v | 0x100) : v;
+        return;
+    }
+
+    fm_regs[fm_address >> 8][fm_address & 0xFF] = v;
+
+    if (active & CAPTURE_VGM)
+    {
+        vgm_sync(cycles);
+        vgm_put(VGM_YM2612 + (fm_address >> 8), fm_address & 0xFF, v, 3);
+    }
+}
+
+const uint8_t *capture_fm_regs(void)
+{
+    return fm_regs[0];
+}
+
+void capture_psg_write(unsigned int clocks, unsigned int data)
+{
+    int index;
+
+    /* same latch logic as psg_write() */
+    if (data & 0x80)
+    {
+        psg_latch = index = (data >> 4) & 0x07;
+        if (!(index & 1) && (index < 6))
+            psg_regs[index] = (psg_regs[index] & 0x3F0) | (data & 0x0F);
+        else
+            psg_regs[index] = data & 0x0F;
+    }
+    else
+    {
+        index = psg_latch;
+        if (!(index & 1) && (index < 6))
+            psg_regs[index] = (psg_regs[index] & 0x0F) | ((data & 0x3F) << 4);
+        else
+            psg_regs[index] = data & 0x0F;
+    }
+
+    if (active & CAPTURE_VGM)
+    {
+        vgm_sync(clocks);
+        vgm_put(VGM_PSG, data, 0, 2);
+    }
+}
+
+void capture_frame(unsigned int cycles, const float *l, const float *r, int count)
+{
+    if (active & CAPTURE_VGM)
+    {
+        frame_origin += cycles;
+        vgm_sync(0);
+    }
+
+    if (active & CAPTURE_WAV)
+    {
+        uint8 pcm[256 * 4];
+        int i, n = 0;
+
+        for (i = 0; i < count; i++)
+        {
+            int sl = (int)(l[i] * 32768.0f);
+            int sr = (int)(r[i] * 32768.0f);
+
+            if (sl > 32767) sl = 32767;
+            else if (sl < -32768) sl = -32768;
+            if (sr > 32767) sr = 32767;
+            else if (sr < -32768) sr = -32768;
+
+            pcm[n++] = sl;
+            pcm[n++] = sl >> 8;
+            pcm[n++] = sr;
+            pcm[n++] = sr >> 8;
+
+            if (n == sizeof(pcm))
+            {
+                ring_put(STREAM_WAV, pcm, n);
+                n = 0;
+            }
+        }
+        ring_put(STREAM_WAV, pcm, n);
+    }
+}
+
+void capture_memory_report(void)
+{
+    memory_region("capture rings", rings, sizeof(rings));
+}
@@ -0,0 +1,75 @@
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Streaming session capture: a VGM command stream of the YM2612 and PSG
+ * writes (hooked in sound.c / psg.c) and, optionally, the 16-bit PCM output.
+ *
+ * Each stream goes into its own ring of CAPTURE_CHUNKS chunks in WASM
+ * memory. The core fills the chunk at 'head' and seals it when full; the
+ * front-end copies sealed chunks out (tail..head) and bumps 'tail', so a
+ * long capture never needs the whole file in WASM memory. When the
+ * front-end falls behind, data is dropped (counted in 'dropped') rather
+ * than stalling the frame loop. capture_stop() seals the last partial
+ * chunk and builds the file header, which goes in front of the drained
+ * data (the sizes are only known at the end).
+ *
+ * State loads (rewind, chaos checkpoints) are not part of the stream: the
+ * VGM keeps the register writes only.
+ */
+
+#define CAPTURE_VGM 1
+#define CAPTURE_WAV 2
+
+#define CAPTURE_CHUNK_SIZE 0x8000
+#ifdef MD_ONLY
+#define CAPTURE_CHUNKS 8 /* must be a power of 2 (fits the fixed heap, memmap.h) */
+#else
+#define CAPTURE_CHUNKS 16 /* must be a power of 2 */
+#endif
+
+#define CAPTURE_HEADER_MAX 0x40
+
+typedef struct
+{
+    volatile uint32_t head;                 /* sealed chunks (written by the core) */
+    volatile uint32_t tail;                 /* drained chunks (written by JS) */
+    uint32_t dropped;                       /* bytes lost while the ring was full */
+    uint32_t length[CAPTURE_CHUNKS];        /* bytes used in each sealed chunk */
+    uint8_t data[CAPTURE_CHUNKS][CAPTURE_CHUNK_SIZE];
+} capture_ring_t;
+
+/* Start capturing 'streams' (CAPTURE_VGM | CAPTURE_WAV); returns the
+ * streams started (no VGM without a YM2612/PSG system) */
+int EMSCRIPTEN_KEEPALIVE capture_start(int streams);
+
+/* End the capture: seal the last chunks and build the headers */
+void EMSCRIPTEN_KEEPALIVE capture_stop(void);
+
+/* Ring of a stream (CAPTURE_VGM or CAPTURE_WAV) */
+capture_ring_t* EMSCRIPTEN_KEEPALIVE capture_ring(int stream);
+int EMSCRIPTEN_KEEPALIVE capture_chunk_count(void);
+int EMSCRIPTEN_KEEPALIVE capture_chunk_size(void);
+
+/* File header of a stopped stream, and its size */
+uint8_t* EMSCRIPTEN_KEEPALIVE capture_header(int stream);
+int EMSCRIPTEN_KEEPALIVE capture_header_size(int stream);
+
+/* Add the rings to the memory report */
+void capture_memory_report(void);
+
+/* Core hooks: chip writes (always called, the VGM start needs the
+ * registers written earlier) */
+void capture_fm_write(unsigned int cycles, unsigned int a, unsigned int v);
+void capture_psg_write(unsigned int clocks, unsigned int data);
+
+/* YM2612 registers as last written, [port * 0x100 + register] */
+const uint8_t *capture_fm_regs(void);
+
+/* End of frame: 'cycles' master clocks were emulated, 'count' output
+ * samples produced */
+void capture_frame(unsigned int cycles, const float *l, const float *r, int count);
+
+#endif /* _CAPTURE_H_ */
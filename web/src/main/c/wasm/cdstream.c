@@ -0,0 +1,361 @@
+/**
+ * ChaosDrive - streamed disc images
+ *
+ * See cdstream.h. The cache is looked up by a scan of its slots: the drive
+ * reads a few sectors per frame, far from enough to need an index.
+ */
+
+#include "shared.h"
+#include "cdstream.h"
+#include "memmap.h"
+
+#define SLOT_EMPTY   0
+#define SLOT_PENDING 1
+#define SLOT_READY   2
+
+/* CDD interrupts (75 Hz) left before the drive reads, under which a block
+   still being fetched holds the frames back: a little more than a tick_n()
+   run of fast-forward frames */
+#define READY_LATENCY 12
+
+typedef struct
+{
+    char name[CD_STREAM_NAME];
+    int64_t size;
+} file_t;
+
+typedef struct
+{
+    int32 file;
+    int32 block;
+    uint32 used;
+    uint8 state;
+} slot_t;
+
+static file_t files[CD_STREAM_FILES];
+static int file_count;
+static char name_buffer[CD_STREAM_NAME];
+static char image[CD_STREAM_NAME];
+static int mounted;
+
+static uint8 cache[CD_STREAM_BLOCKS][CD_STREAM_BLOCK];
+static slot_t slots[CD_STREAM_BLOCKS];
+static uint32 use_clock;
+static cd_stream_request_t requests[CD_STREAM_BLOCKS];
+static int request_count;
+static int misses;
+
+static int find(int file, int block)
+{
+    int i;
+
+    for (i = 0; i < CD_STREAM_BLOCKS; i++)
+    {
+        if ((slots[i].state != SLOT_EMPTY) && (slots[i].file == file) && (slots[i].block == block))
+            return i;
+    }
+    return -1;
+}
+
+#ifndef __EMSCRIPTEN__
+static void fill(int slot)
+{
+    FILE *f = fopen(files[slots[slot].file].name, "rb");
+
+    memset(cache[slot], 0, CD_STREAM_BLOCK);
+    if (f)
+    {
+        fseek(f, (long)slots[slot].block * CD_STREAM_BLOCK, SEEK_SET);
+        if (fread(cache[slot], 1, CD_STREAM_BLOCK, f)) {}
+        fclose(f);
+    }
+    slots[slot].state = SLOT_READY;
+}
+#endif
+
+/* Slot holding or about to hold a block: the least recently used one is
+   reused, blocks being fetched stay. -1 when all are being fetched */
+static int request(int file, int block)
+{
+    int i, slot = find(file, block);
+
+    if (slot >= 0)
+        return slot;
+    if ((int64_t)block * CD_STREAM_BLOCK >= files[file].size)
+        return -1;
+
+    for (i = 0; i < CD_STREAM_BLOCKS; i++)
+    {
+        if (slots[i].state == SLOT_EMPTY)
+        {
+            slot = i;
+            break;
+        }
+        if ((slots[i].state == SLOT_READY) && ((slot < 0) || (slots[i].used < slots[slot].used)))
+            slot = i;
+    }
+    if (slot < 0)
+        return -1;
+
+    slots[slot].file = file;
+    slots[slot].block = block;
+    slots[slot].used = ++use_clock;
+    slots[slot].state = SLOT_PENDING;
+#ifdef __EMSCRIPTEN__
+    requests[request_count].slot = slot;
+    requests[request_count].file = file;
+    requests[request_count].block = block;
+    request_count++;
+#else
+    fill(slot);
+#endif
+    return slot;
+}
+
+/* Request the blocks from 'pos' on; 1 when those covering 'need' bytes are in */
+static int window(cd_stream_t *s, int blocks, int need)
+{
+    int i, ready = 1;
+    int first = (int)(s->pos / CD_STREAM_BLOCK);
+    int last = (int)((s->pos + need - 1) / CD_STREAM_BLOCK);
+
+    for (i = 0; i < blocks; i++)
+    {
+        int slot = request(s->file, first + i);
+        if ((first + i <= last) && (slot >= 0) && (slots[slot].state != SLOT_READY))
+            ready = 0;
+    }
+    return ready;
+}
+
+static const char *base_name(const char *name)
+{
+    const char *p = name + strlen(name);
+
+    while ((p > name) && (p[-1] != '/') && (p[-1] != '\\'))
+        p--;
+    return p;
+}
+
+cd_stream_t *cd_stream_open(const char *name)
+{
+    cd_stream_t *s;
+    int i;
+
+    /* cue sheets name their tracks relative to their own path */
+    name = base_name(name);
+    for (i = 0; i < file_count; i++)
+    {
+        if (!strcmp(base_name(files[i].name), name))
+            break;
+    }
+    if (i == file_count)
+    {
+        for (i = 0; i < file_count; i++)
+        {
+            if (!strcasecmp(base_name(files[i].name), name))
+                break;
+        }
+    }
+    if (i == file_count)
+        return NULL;
+
+    s = malloc(sizeof(cd_stream_t));
+    if (!s)
+        return NULL;
+    s->file = i;
+    s->pos = 0;
+    return s;
+}
+
+int cd_stream_close(cd_stream_t *s)
+{
+    free(s);
+    return 0;
+}
+
+size_t cd_stream_read(void *ptr, size_t size, size_t count, cd_stream_t *s)
+{
+    uint8 *dst = ptr;
+    int64_t left, done;
+
+    if ((s->file >= file_count) || !size)
+        return 0;
+
+    left = (int64_t)size * count;
+    if (left > files[s->file].size - s->pos)
+        left = files[s->file].size - s->pos;
+    if (left <= 0)
+        return 0;
+    done = left;
+
+    while (left > 0)
+    {
+        int block = (int)(s->pos / CD_STREAM_BLOCK);
+        int offset = (int)(s->pos % CD_STREAM_BLOCK);
+        int length = CD_STREAM_BLOCK - offset;
+        int slot = request(s->file, block);
+
+        if (length > left)
+            length = (int)left;
+        if ((slot >= 0) && (slots[slot].state == SLOT_READY))
+        {
+            memcpy(dst, &cache[slot][offset], length);
+            slots[slot].used = ++use_clock;
+        }
+        else
+        {
+            memset(dst, 0, length);
+            misses++;
+        }
+        dst += length;
+        s->pos += length;
+        left -= length;
+    }
+
+    return (size_t)(done / size);
+}
+
+int cd_stream_seek(cd_stream_t *s, long offset, int whence)
+{
+    int64_t pos = offset;
+
+    if (s->file >= file_count)
+        return -1;
+    if (whence == SEEK_CUR)
+        pos += s->pos;
+    else if (whence == SEEK_END)
+        pos += files[s->file].size;
+    if (pos < 0)
+        return -1;
+
+    /* CDD seek: the block is fetched during the emulated seek time */
+    s->pos = pos;
+    request(s->file, (int)(pos / CD_STREAM_BLOCK));
+    return 0;
+}
+
+long cd_stream_tell(cd_stream_t *s)
+{
+    return (long)s->pos;
+}
+
+char *cd_stream_gets(char *str, int size, cd_stream_t *s)
+{
+    int i = 0;
+
+    while (i < size - 1)
+    {
+        char c;
+        if (!cd_stream_read(&c, 1, 1, s))
+            break;
+        str[i++] = c;
+        if (c == '\n')
+            break;
+    }
+    str[i] = 0;
+    return i ? str : NULL;
+}
+
+char *cd_stream_name(void)
+{
+    return name_buffer;
+}
+
+int cd_stream_add(double size)
+{
+    if (file_count == CD_STREAM_FILES)
+        return -1;
+    strncpy(files[file_count].name, name_buffer, CD_STREAM_NAME - 1);
+    files[file_count].size = (int64_t)size;
+    return file_count++;
+}
+
+void cd_stream_mount(void)
+{
+    strncpy(image, name_buffer, CD_STREAM_NAME - 1);
+    mounted = 1;
+}
+
+char *cd_stream_image(void)
+{
+    return mounted ? image : NULL;
+}
+
+void cd_stream_clear(void)
+{
+    file_count = 0;
+    mounted = 0;
+    memset(slots, 0, sizeof(slots));
+    request_count = 0;
+    misses = 0;
+}
+
+int cd_stream_take_requests(void)
+{
+    int count = request_count;
+    request_count = 0;
+    return count;
+}
+
+cd_stream_request_t *cd_stream_requests(void)
+{
+    return requests;
+}
+
+uint8_t *cd_stream_block(int slot)
+{
+    return cache[slot];
+}
+
+void cd_stream_loaded(int slot)
+{
+    if (slots[slot].state == SLOT_PENDING)
+        slots[slot].state = SLOT_READY;
+}
+
+int cd_stream_misses(void)
+{
+    int count = misses;
+    misses = 0;
+    return count;
+}
+
+int cd_stream_booted(void)
+{
+    return mounted && (system_hw == SYSTEM_MCD) && cdd.loaded && (system_bios & 0x10);
+}
+
+int cd_stream_ready(void)
+{
+    int ready = 1;
+
+    if ((system_hw != SYSTEM_MCD) || !cdd.loaded)
+        return 1;
+
+    /* the drive's track and subcode streams, the reads of a few frames */
+    if ((cdd.index < cdd.toc.last) && cdd.toc.tracks[cdd.index].fd)
+        ready &= window(cdd.toc.tracks[cdd.index].fd, CD_STREAM_AHEAD, CD_STREAM_BLOCK);
+    if (cdd.toc.sub)
+        ready &= window(cdd.toc.sub, 1, 96 * 8);
+
+    /* still seeking: the blocks have the rest of the seek time to come in */
+    return ready || (cdd.status != CD_PLAY) || (cdd.latency > READY_LATENCY);
+}
+
+int cd_stream_load(const char *name, unsigned char *buffer, int maxsize)
+{
+    cd_stream_t *s = cd_stream_open(name);
+    int size;
+
+    if (!s)
+        return 0;
+    size = (int)cd_stream_read(buffer, 1, maxsize, s);
+    cd_stream_close(s);
+    return size;
+}
+
+void cd_stream_memory_report(void)
+{
+    memory_region("cd stream cache", cache, sizeof(cache));
+}
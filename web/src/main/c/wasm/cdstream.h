@@ -0,0 +1,105 @@
+#ifndef _CDSTREAM_H_
+#define _CDSTREAM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <emscripten/emscripten.h>
+
+/* Disc images streamed from the front-end (full core only).
+ *
+ * There is no file system: the page registers the files the player picked
+ * (cue sheet, tracks, CD BIOS) by name and size, and cdd.c opens them
+ * through the cdStream functions below (macros.h) like regular files. Reads
+ * are served from a cache of CD_STREAM_BLOCKS blocks of CD_STREAM_BLOCK
+ * bytes, least recently used first out, so a 600MB image runs in a few MB.
+ *
+ * A block not in the cache is requested from the page, which reads it with
+ * Blob.slice() and hands it back between two frames. Seeking a stream and
+ * reading on request the CD_STREAM_AHEAD blocks that follow, so the blocks
+ * of a CDD seek are fetched while the emulated seek time runs out.
+ * cd_stream_ready() holds the frames back on the rare occasion the drive is
+ * about to read a block that is not in yet. A read that misses anyway
+ * (the synchronous reads of cdd_load() and the BIOS, on the first try)
+ * gets zeros and is counted: the page fetches the blocks and starts again.
+ *
+ * Native builds read the registered files straight from disk.
+ */
+
+#define CD_STREAM_BLOCK   0x8000
+#define CD_STREAM_BLOCKS  128 /* 4MB */
+#define CD_STREAM_AHEAD   4
+#define CD_STREAM_FILES   128
+#define CD_STREAM_NAME    256
+
+typedef struct
+{
+    int file;
+    int64_t pos;
+} cd_stream_t;
+
+/* stdio-like access for cdd.c */
+#define cdStream            cd_stream_t
+#define cdStreamOpen        cd_stream_open
+#define cdStreamClose       cd_stream_close
+#define cdStreamRead        cd_stream_read
+#define cdStreamSeek        cd_stream_seek
+#define cdStreamTell        cd_stream_tell
+#define cdStreamGets        cd_stream_gets
+
+cd_stream_t *cd_stream_open(const char *name);
+int cd_stream_close(cd_stream_t *s);
+size_t cd_stream_read(void *ptr, size_t size, size_t count, cd_stream_t *s);
+int cd_stream_seek(cd_stream_t *s, long offset, int whence);
+long cd_stream_tell(cd_stream_t *s);
+char *cd_stream_gets(char *str, int size, cd_stream_t *s);
+
+/* Name buffer for cd_stream_add() and cd_stream_mount() (CD_STREAM_NAME bytes) */
+char* EMSCRIPTEN_KEEPALIVE cd_stream_name(void);
+
+/* Register the file named in cd_stream_name(), of 'size' bytes: returns its
+ * id, -1 when the table is full */
+int EMSCRIPTEN_KEEPALIVE cd_stream_add(double size);
+
+/* Mount the registered image named in cd_stream_name() (.cue, .iso or .bin)
+ * at the next start() */
+void EMSCRIPTEN_KEEPALIVE cd_stream_mount(void);
+
+/* Image to mount, NULL when none (load_rom()) */
+char *cd_stream_image(void);
+
+/* Forget the files and the cache (another ROM picked) */
+void EMSCRIPTEN_KEEPALIVE cd_stream_clear(void);
+
+/* Blocks requested and not handed out yet: stores them in 'requests' as
+ * (slot, file, block) triplets and returns their count */
+typedef struct
+{
+    int32_t slot;
+    int32_t file;
+    int32_t block;
+} cd_stream_request_t;
+int EMSCRIPTEN_KEEPALIVE cd_stream_take_requests(void);
+cd_stream_request_t* EMSCRIPTEN_KEEPALIVE cd_stream_requests(void);
+
+/* Memory of a cache slot; the page writes the block there, then calls
+ * cd_stream_loaded() */
+uint8_t* EMSCRIPTEN_KEEPALIVE cd_stream_block(int slot);
+void EMSCRIPTEN_KEEPALIVE cd_stream_loaded(int slot);
+
+/* Reads that missed the cache since the last call */
+int EMSCRIPTEN_KEEPALIVE cd_stream_misses(void);
+
+/* 1 when start() runs the mounted image (the disc and its BIOS loaded) */
+int EMSCRIPTEN_KEEPALIVE cd_stream_booted(void);
+
+/* 0 while the drive is about to read blocks still being fetched (the frame
+ * has to wait); requests the blocks ahead of the drive either way */
+int EMSCRIPTEN_KEEPALIVE cd_stream_ready(void);
+
+/* Read a whole registered file (BIOS): size read, 0 when not registered */
+int cd_stream_load(const char *name, unsigned char *buffer, int maxsize);
+
+/* Add the cache to the memory report */
+void cd_stream_memory_report(void);
+
+#endif /* _CDSTREAM_H_ */
@@ -6,219 +6,1123 @@
  * audio memory, CPU registers, and more at runtime.
  */
 
+#include <math.h>
 #include "shared.h"
 #include "chaos.h"
+#include "chaos_bind.h"
+#include "chaos_bus.h"
+#include "chaos_cheat.h"
+#include "chaos_core.h"
+#include "chaos_dirty.h"
+#include "chaos_fm.h"
+#include "chaos_freeze.h"
+#include "chaos_kernels.h"
+#include "chaos_linepal.h"
+#include "chaos_mod.h"
+#include "chaos_palette.h"
+#include "chaos_preset.h"
+#include "chaos_queue.h"
+#include "chaos_ram.h"
+#include "chaos_rand.h"
+#include "chaos_record.h"
+#include "chaos_rom.h"
+#include "chaos_schedule.h"
+#include "chaos_scroll.h"
+#include "chaos_sprite.h"
+#include "chaos_undo.h"
+#include "chaos_vm.h"
+#include "chaos_vdplog.h"
+#include "chaos_vram.h"
+#include "chaos_watchdog.h"
+#include "chaos_zdrv.h"
+#include "netplay.h"
 
 /* ======================================================================== */
-/* Persistent corruption flags                                              */
+/* Intensity                                                                */
 /* ======================================================================== */
 
-static int cram_corruption_enabled = 0;
-static int fm_corruption_enabled = 0;
-static int cram_randomize_pending = 0;
-static int cram_shift_pending = 0;
-static int vsram_corrupt_pending = 0;
-static int hscroll_wave_pending = 0;
+/* Intensity of the effect chaos_apply() is running (1 for direct calls) */
+static float fx_intensity = 1.0f;
+
+/* 'n' scaled by an intensity, at least 1 */
+static int scale(int n, float level)
+{
+    int v = (int)(n * level + 0.5f);
+    return (v < 1) ? 1 : v;
+}
+
+/* One draw, true with probability 'odds' (0..1) */
+static int chance(int stream, float odds)
+{
+    return (double)chaos_rand(stream) < odds * 4294967296.0;
+}
+
+/* ======================================================================== */
+/* Deferred effects (0: none), the persistent corruption levels are         */
+/* parameters (chaos_mod.h)                                                 */
+/* ======================================================================== */
+
+
+/* ======================================================================== */
+/* VRAM Manipulation                                                        */
+/* ======================================================================== */
+
+/* Patterns named by the planes and sprites: the tile effects leave the
+   tables and unused VRAM alone, so the whole change is visible and only
+   those patterns are decoded again */
+static chaos_vram_run_t tile_runs[0x400];
+
+static int vram_tile_runs(void)
+{
+    int count = chaos_vram_runs(CHAOS_VRAM_TILES, tile_runs);
+
+    /* Mode 4 or nothing on screen: all of VRAM */
+    if (!count)
+    {
+        tile_runs[0].start = 0;
+        tile_runs[0].len = 0x10000;
+        count = 1;
+    }
+    return count;
+}
+
+/* Bulk operations on the tile runs */
+#define TILE_SHIFT        0 /* param: amount */
+#define TILE_SHIFT_CLEAR  1 /* param: amount, vacated bytes cleared */
+#define TILE_SHIFT_BLOCKS 2 /* param: amount, per 256-byte block */
+#define TILE_XOR          3 /* param: mask */
+#define TILE_NIBBLE_SWAP  4
+
+static void tile_op(int op, int param, uint8 *buf, int len)
+{
+    switch (op)
+    {
+        case TILE_SHIFT:
+        case TILE_SHIFT_CLEAR:
+            chaos_kernel_shift(buf, len, param, op == TILE_SHIFT_CLEAR);
+            break;
+
+        case TILE_SHIFT_BLOCKS:
+            /* Shift each 256-byte block independently, then any shorter tail */
+            chaos_kernel_shift_blocks(buf, len, 256, param);
+            if (len & 0xFF)
+                chaos_kernel_shift(buf + (len & ~0xFF), len & 0xFF, param, 0);
+            break;
+
+        case TILE_XOR:
+            chaos_kernel_xor(buf, len, (uint8)param);
+            break;
+
+        case TILE_NIBBLE_SWAP:
+            chaos_kernel_nibble_swap(buf, len);
+            break;
+    }
+}
+
+/* Undo record for tile_op() on VRAM [from, from + len), before it runs */
+static void tile_op_undo(int op, int param, int from, int len)
+{
+    switch (op)
+    {
+        case TILE_SHIFT:
+        case TILE_SHIFT_CLEAR:
+            chaos_undo_shift(CHAOS_UNDO_VRAM, from, len, 0, param);
+            break;
+
+        case TILE_SHIFT_BLOCKS:
+            chaos_undo_shift(CHAOS_UNDO_VRAM, from, len, 256, param);
+            break;
+
+        case TILE_XOR:
+            chaos_undo_swap_xor(CHAOS_UNDO_VRAM, from, len, 0, param);
+            break;
+
+        case TILE_NIBBLE_SWAP:
+            chaos_undo_swap_xor(CHAOS_UNDO_VRAM, from, len, 1, 0);
+            break;
+    }
+}
+
+/* Apply 'op' to the parts of the tile runs within [start, end) */
+static void tiles_apply(int op, int param, int start, int end)
+{
+    int i, count = vram_tile_runs();
+
+    for (i = 0; i < count; i++)
+    {
+        int from = tile_runs[i].start;
+        int to = from + tile_runs[i].len;
+
+        if (from < start)
+            from = start;
+        if (to > end)
+            to = end;
+        if (from >= to)
+            continue;
+
+        tile_op_undo(op, param, from, to - from);
+        tile_op(op, param, vram + from, to - from);
+        chaos_dirty_vram(from, to - from);
+    }
+}
+
+/* Spread effects: instead of all the patterns at once, a bulk effect can
+   sweep VRAM one slice per frame (chaos_set_spread()). The slice is
+   intersected with the tile runs of the frame it is applied in, so the
+   sweep follows the tables if the game moves them meanwhile. */
+#define SWEEP_ALIGN 0x100
+
+typedef struct
+{
+    uint8 op;
+    uint8 frames;  /* left */
+    int param;
+    int cursor;    /* next VRAM address */
+    int slice;     /* bytes per frame */
+} chaos_sweep_t;
+
+static uint8 spread[CHAOS_FX_COUNT];
+static chaos_sweep_t sweeps[CHAOS_FX_COUNT];
+
+/* Run 'op' for effect 'id', at once or as a sweep; a trigger while the
+   effect's sweep is still running is dropped */
+static void tiles_run(int id, int op, int param)
+{
+    chaos_sweep_t *sweep = &sweeps[id];
+
+    if (spread[id] <= 1)
+    {
+        tiles_apply(op, param, 0, 0x10000);
+        return;
+    }
+
+    if (sweep->frames)
+        return;
+
+    sweep->op = op;
+    sweep->param = param;
+    sweep->frames = spread[id];
+    sweep->cursor = 0;
+    sweep->slice = ((0x10000 / spread[id]) + SWEEP_ALIGN - 1) & ~(SWEEP_ALIGN - 1);
+}
+
+static void chaos_account(int id, double start);
+
+/* Fused sweep pass: the slices of all the running sweeps are applied one
+   tile run at a time, in effect id order within each run, which gives the
+   same bytes as one sweep after the other. XOR and nibble swap only change
+   each byte in place, so consecutive ones are composed (swap, then XOR with
+   one mask) and applied in a single pass per 256-byte block: slices are
+   SWEEP_ALIGN aligned, so the sweeps covering a block are the same all
+   through it. Shifts move bytes across their slice and run on their own.
+   The tile runs are classified once and each covered range is reported
+   dirty once, however many sweeps are stacked. */
+static int tile_op_bytewise(int op)
+{
+    return (op == TILE_XOR) || (op == TILE_NIBBLE_SWAP);
+}
+
+/* Bytewise sweeps 'ids' over tile run [from, to) */
+static void sweeps_bytewise(const int *ids, int count, int from, int to)
+{
+    int block, i;
+    int start = from, swap = 0, mask = 0;
+
+    for (block = from & ~(SWEEP_ALIGN - 1); block < to; block += SWEEP_ALIGN)
+    {
+        int s = 0, m = 0;
+        int lo = (block > from) ? block : from;
+
+        for (i = 0; i < count; i++)
+        {
+            const chaos_sweep_t *sweep = &sweeps[ids[i]];
+
+            if ((block < sweep->cursor) || (block >= sweep->cursor + sweep->slice))
+                continue;
+
+            if (sweep->op == TILE_XOR)
+            {
+                m ^= sweep->param;
+            }
+            else
+            {
+                s ^= 1;
+                m = ((m << 4) | (m >> 4)) & 0xFF;
+            }
+        }
+
+        /* same chain as the blocks before: one longer pass */
+        if ((s != swap) || (m != mask))
+        {
+            if (swap || mask)
+            {
+                chaos_undo_swap_xor(CHAOS_UNDO_VRAM, start, lo - start, swap, mask);
+                chaos_kernel_swap_xor(vram + start, lo - start, swap, mask);
+            }
+            start = lo;
+            swap = s;
+            mask = m;
+        }
+    }
+
+    if (swap || mask)
+    {
+        chaos_undo_swap_xor(CHAOS_UNDO_VRAM, start, to - start, swap, mask);
+        chaos_kernel_swap_xor(vram + start, to - start, swap, mask);
+    }
+}
+
+/* Next slice of each running sweep (pre-render hook) */
+static void sweeps_frame(void)
+{
+    int ids[CHAOS_FX_COUNT];
+    uint8 covered[0x10000 / SWEEP_ALIGN];
+    int id, i, j, k, count, active = 0;
+    double start;
+
+    for (id = 0; id < CHAOS_FX_COUNT; id++)
+    {
+        if (sweeps[id].frames)
+            ids[active++] = id;
+    }
+    if (!active)
+        return;
+
+    start = emscripten_get_now();
+    chaos_undo_begin();
+
+    memset(covered, 0, sizeof(covered));
+    for (i = 0; i < active; i++)
+    {
+        const chaos_sweep_t *sweep = &sweeps[ids[i]];
+        int end = sweep->cursor + sweep->slice;
+
+        if (end > 0x10000)
+            end = 0x10000;
+        memset(covered + sweep->cursor / SWEEP_ALIGN, 1, (end - sweep->cursor) / SWEEP_ALIGN);
+    }
+
+    count = vram_tile_runs();
+    for (i = 0; i < count; i++)
+    {
+        int from = tile_runs[i].start;
+        int to = from + tile_runs[i].len;
+        int block;
+
+        for (j = 0; j < active; j = k)
+        {
+            const chaos_sweep_t *sweep = &sweeps[ids[j]];
+
+            if (tile_op_bytewise(sweep->op))
+            {
+                for (k = j + 1; (k < active) && tile_op_bytewise(sweeps[ids[k]].op); k++);
+                sweeps_bytewise(ids + j, k - j, from, to);
+            }
+            else
+            {
+                int lo = (sweep->cursor > from) ? sweep->cursor : from;
+                int hi = (sweep->cursor + sweep->slice < to) ? sweep->cursor + sweep->slice : to;
+
+                if (lo < hi)
+                {
+                    tile_op_undo(sweep->op, sweep->param, lo, hi - lo);
+                    tile_op(sweep->op, sweep->param, vram + lo, hi - lo);
+                }
+                k = j + 1;
+            }
+        }
+
+        /* covered parts of the run */
+        for (block = from; block < to; )
+        {
+            int end = (block | (SWEEP_ALIGN - 1)) + 1;
+
+            if (end > to)
+                end = to;
+            if (covered[block / SWEEP_ALIGN])
+            {
+                int lo = block;
+
+                while ((end < to) && covered[end / SWEEP_ALIGN])
+                    end = (end + SWEEP_ALIGN < to) ? end + SWEEP_ALIGN : to;
+                chaos_dirty_vram(lo, end - lo);
+            }
+            block = end;
+        }
+    }
+
+    for (i = 0; i < active; i++)
+    {
+        chaos_sweep_t *sweep = &sweeps[ids[i]];
+
+        sweep->cursor += sweep->slice;
+        sweep->frames--;
+        if (sweep->cursor >= 0x10000)
+            sweep->frames = 0;
+    }
+    chaos_undo_end();
+
+    /* the pass is shared: each sweep is charged an equal part */
+    start += (emscripten_get_now() - start) * (active - 1) / active;
+    for (i = 0; i < active; i++)
+        chaos_account(ids[i], start);
+}
+
+int chaos_set_spread(int id, int frames)
+{
+    if ((unsigned int)id >= CHAOS_FX_COUNT)
+        return 0;
+
+    switch (id)
+    {
+        case CHAOS_FX_SHIFT_VRAM_UP:
+        case CHAOS_FX_SHIFT_VRAM_DOWN:
+        case CHAOS_FX_SHIFT_VRAM_LEFT:
+        case CHAOS_FX_SHIFT_VRAM_RIGHT:
+        case CHAOS_FX_SHIFT_VRAM_DOWN_RANDOM:
+        case CHAOS_FX_INVERT_VRAM:
+        case CHAOS_FX_XOR_VRAM:
+        case CHAOS_FX_NIBBLE_SWAP_VRAM:
+            break;
+
+        default:
+            return 0;
+    }
+
+    if (frames < 1)
+        frames = 1;
+    if (frames > 0xFF)
+        frames = 0xFF;
+
+    chaos_record_call(CHAOS_RECORD_SPREAD, id, frames, 0, 0);
+    spread[id] = frames;
+    return 1;
+}
+
+void chaos_shift_vram_up(void)
+{
+    tiles_run(CHAOS_FX_SHIFT_VRAM_UP, TILE_SHIFT, -1);
+}
+
+void chaos_shift_vram_down(void)
+{
+    tiles_run(CHAOS_FX_SHIFT_VRAM_DOWN, TILE_SHIFT, 1);
+}
+
+void chaos_shift_vram_left(void)
+{
+    tiles_run(CHAOS_FX_SHIFT_VRAM_LEFT, TILE_SHIFT_BLOCKS, -1);
+}
+
+void chaos_shift_vram_right(void)
+{
+    tiles_run(CHAOS_FX_SHIFT_VRAM_RIGHT, TILE_SHIFT_BLOCKS, 1);
+}
+
+void chaos_shift_vram_down_random(void)
+{
+    /* Up to 64 bytes at full intensity */
+    int shift_amount = chaos_rand_below(CHAOS_RNG_VRAM, scale(64, fx_intensity));
+    tiles_run(CHAOS_FX_SHIFT_VRAM_DOWN_RANDOM, TILE_SHIFT_CLEAR, shift_amount);
+}
+
+void chaos_corrupt_vram_one_byte(void)
+{
+    chaos_core_corrupt_vram_one_byte(NULL);
+}
+
+void chaos_invert_vram_contents(void)
+{
+    tiles_run(CHAOS_FX_INVERT_VRAM, TILE_XOR, 0xFF);
+}
+
+void chaos_rotate_vram(void)
+{
+    /* Rotate by a random number of pattern lines (4 bytes each) */
+    int amount = (chaos_rand_below(CHAOS_RNG_VRAM, 64) + 1) * 4;
+
+    chaos_undo_rotate(CHAOS_UNDO_VRAM, 0, 0x10000, amount);
+    chaos_kernel_rotate(vram, 0x10000, amount);
+    chaos_dirty_vram_all();
+}
+
+void chaos_xor_vram(void)
+{
+    tiles_run(CHAOS_FX_XOR_VRAM, TILE_XOR, chaos_rand_below(CHAOS_RNG_VRAM, 255) + 1);
+}
+
+void chaos_nibble_swap_vram(void)
+{
+    /* Swaps adjacent pixels of every pattern line */
+    tiles_run(CHAOS_FX_NIBBLE_SWAP_VRAM, TILE_NIBBLE_SWAP, 0);
+}
 
 /* ======================================================================== */
-/* Helper: mark VRAM dirty so the renderer picks up changes                 */
+/* CRAM / Color Manipulation                                                */
 /* ======================================================================== */
 
-static void mark_all_vram_dirty(void)
+/* The color effects go through the palette layer (chaos_palette.h): CRAM
+   is left to the game */
+
+#define VISIBLE_COLORS 60 /* CRAM entries that are not transparent */
+
+void chaos_randomize_cram(void)
+{
+    chaos_palette_scramble(scale(VISIBLE_COLORS / 2, fx_intensity));
+}
+
+void chaos_shift_cram_up(void)
+{
+    chaos_palette_rotate(1);
+}
+
+void chaos_enable_cram_corruption(void)
+{
+    chaos_param_set(CHAOS_PARAM_CRAM_CORRUPTION, fx_intensity);
+}
+
+void chaos_disable_cram_corruption(void)
+{
+    chaos_param_set(CHAOS_PARAM_CRAM_CORRUPTION, 0.0f);
+    chaos_palette_denoise();
+}
+
+void chaos_restore_palette(void)
+{
+    chaos_palette_clear();
+}
+
+/* Raster colors go through the per-line overrides (chaos_linepal.h) */
+
+#define COPPER_PERIOD 32 /* lines per bar */
+
+void chaos_copper_bars(void)
+{
+    int line, hue = 0;
+
+    /* Backdrop ramps up and down over each bar, in a random mix of red,
+       green and blue per bar, rolling down the screen */
+    for (line = 0; line < CHAOS_LINEPAL_LINES; line++)
+    {
+        int t = line % COPPER_PERIOD;
+        int level = (t < COPPER_PERIOD / 2) ? (t >> 1) : ((COPPER_PERIOD - 1 - t) >> 1);
+
+        if (!t)
+        {
+            hue = 1 + chaos_rand_below(CHAOS_RNG_CRAM, 7);
+            hue = ((hue & 1) ? 0x001 : 0) | ((hue & 2) ? 0x008 : 0) | ((hue & 4) ? 0x040 : 0);
+        }
+        chaos_linepal_set(line, 0, level * hue, 0);
+    }
+    chaos_linepal_speed(scale(4, fx_intensity));
+}
+
+void chaos_raster_palette_glitch(void)
+{
+    int bands = scale(12, fx_intensity);
+
+    /* A color swapped out over a few lines, for one frame */
+    while (bands--)
+    {
+        int line = chaos_rand_below(CHAOS_RNG_CRAM, CHAOS_LINEPAL_LINES);
+        int height = 1 + chaos_rand_below(CHAOS_RNG_CRAM, 8);
+        int slot = chaos_rand_below(CHAOS_RNG_CRAM, 64);
+        int color = chaos_rand_below(CHAOS_RNG_CRAM, 0x200);
+
+        while (height--)
+            chaos_linepal_set(line++, slot, color, 1);
+    }
+}
+
+void chaos_post_rgb_split(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_RGB_SPLIT, fx_intensity);
+}
+
+void chaos_post_trails(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_TRAILS, fx_intensity);
+}
+
+void chaos_post_block_smear(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_BLOCK_SMEAR, fx_intensity);
+}
+
+void chaos_post_scanline_jitter(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_SCANLINE_JITTER, fx_intensity);
+}
+
+void chaos_audio_stutter(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_STUTTER, fx_intensity);
+}
+
+void chaos_audio_reverse(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_REVERSE, fx_intensity);
+}
+
+void chaos_audio_decimate(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_DECIMATE, fx_intensity);
+}
+
+static void post_rgb_split_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_RGB_SPLIT, 0.0f);
+}
+
+static void post_trails_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_TRAILS, 0.0f);
+}
+
+static void post_block_smear_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_BLOCK_SMEAR, 0.0f);
+}
+
+static void post_scanline_jitter_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_POST_SCANLINE_JITTER, 0.0f);
+}
+
+static void audio_stutter_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_STUTTER, 0.0f);
+}
+
+static void audio_reverse_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_REVERSE, 0.0f);
+}
+
+static void audio_decimate_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_AUDIO_DECIMATE, 0.0f);
+}
+
+/* ======================================================================== */
+/* CPU Clocks                                                               */
+/* ======================================================================== */
+
+void chaos_cpu_overclock(void)
+{
+    chaos_param_set(CHAOS_PARAM_M68K_CLOCK, 0.5f + 0.5f * fx_intensity);
+}
+
+void chaos_z80_underclock(void)
+{
+    chaos_param_set(CHAOS_PARAM_Z80_CLOCK, 0.5f - 0.5f * fx_intensity);
+}
+
+static void cpu_overclock_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_M68K_CLOCK, 0.5f);
+}
+
+static void z80_underclock_off(void)
+{
+    chaos_param_set(CHAOS_PARAM_Z80_CLOCK, 0.5f);
+}
+
+/* Instruction cycles scale (M68K_OVERCLOCK_SHIFT / Z80_OVERCLOCK_SHIFT fixed
+   point) at a CHAOS_PARAM_*_CLOCK level: 4^(1 - 2 * level), exactly 1 at 0.5 */
+static int clock_ratio(float level)
+{
+    return (int)(pow(2.0, M68K_OVERCLOCK_SHIFT + 2 - 4.0 * level) + 0.5);
+}
+
+/* Clocks of this frame, m68k_init() and z80_init() set them back to 1 */
+static void cpu_clocks(void)
+{
+    m68k.cycle_ratio = clock_ratio(chaos_params[CHAOS_PARAM_M68K_CLOCK]);
+    z80_cycle_ratio = clock_ratio(chaos_params[CHAOS_PARAM_Z80_CLOCK]);
+}
+
+/* ======================================================================== */
+/* Write Protection                                                         */
+/* ======================================================================== */
+
+/* What the game writes next to the frozen areas is dropped (chaos_freeze.h):
+   a corruption made before stays without being applied again */
+
+static int scroll_frozen;
+
+void chaos_freeze_tiles(void)
+{
+    chaos_freeze_vram_class(CHAOS_VRAM_TILES, 1);
+}
+
+void chaos_freeze_palette(void)
+{
+    chaos_freeze_cram(0, 0x40, 1);
+}
+
+void chaos_freeze_scroll(void)
+{
+    chaos_freeze_vram_class(CHAOS_VRAM_HSCROLL, 1);
+    chaos_freeze_vsram(0, 0x40, 1);
+    scroll_frozen = 1;
+}
+
+static void freeze_tiles_off(void)
+{
+    chaos_freeze_vram(0, 0x10000, 0);
+    if (scroll_frozen)
+        chaos_freeze_vram_class(CHAOS_VRAM_HSCROLL, 1);
+}
+
+static void freeze_palette_off(void)
+{
+    chaos_freeze_cram(0, 0x40, 0);
+}
+
+static void freeze_scroll_off(void)
+{
+    chaos_freeze_vram_class(CHAOS_VRAM_HSCROLL, 0);
+    chaos_freeze_vsram(0, 0x40, 0);
+    scroll_frozen = 0;
+}
+
+/* ======================================================================== */
+/* VSRAM / H-Scroll / CPU SR                                                */
+/* ======================================================================== */
+
+/* The scroll effects go through the renderer's offset tables
+   (chaos_scroll.h): VSRAM and the H-scroll table are left to the game */
+
+void chaos_corrupt_vsram(void)
 {
     int i;
-    for (i = 0; i < 0x800; i++)
+    int num_entries = scale(20, fx_intensity); /* 20 column pairs */
+    int range = scale(16, fx_intensity); /* -16 to +16 */
+
+    for (i = 0; i < num_entries; i++)
     {
-        bg_name_list[i] = i;
-        bg_name_dirty[i] = 0xFF;
+        int offset_a = chaos_rand_below(CHAOS_RNG_VDP, range * 2 + 1) - range;
+        int offset_b = chaos_rand_below(CHAOS_RNG_VDP, range * 2 + 1) - range;
+        chaos_scroll_column(i, offset_a, offset_b, 1);
     }
-    bg_list_index = 0x800;
 }
 
-static void mark_all_cram_dirty(void)
+void chaos_hscroll_waviness(void)
 {
+    int line;
+    int num_lines = 224;
+    int range = scale(8, fx_intensity); /* -8 to +8 */
+    uint8 noise[224];
+
+    chaos_rand_fill(CHAOS_RNG_VDP, noise, num_lines);
+    chaos_scroll_speed(0);
+    for (line = 0; line < num_lines; line++)
+    {
+        int offset = (noise[line] % (range * 2 + 1)) - range;
+        chaos_scroll_line(line, offset, offset, 1);
+    }
+}
+
+void chaos_scroll_wave(void)
+{
+    /* sine over 64 lines, both planes, rolling down one line per frame */
+    int line;
+    float amplitude = 16.0f * fx_intensity;
+
+    for (line = 0; line < CHAOS_SCROLL_LINE_COUNT; line++)
+    {
+        int offset = (int)(amplitude * sinf(line * (6.2831853f / 64.0f)));
+        chaos_scroll_line(line, offset, offset, 0);
+    }
+    chaos_scroll_speed(1);
+}
+
+void chaos_scroll_melt(void)
+{
+    /* columns sag by a random depth, plane A further than plane B */
     int i;
-    /* Force palette recalculation */
-    for (i = 0; i < 0x40; i++)
+    int depth = scale(64, fx_intensity);
+
+    for (i = 0; i < CHAOS_SCROLL_COLUMN_COUNT; i++)
     {
-        color_update_m5(i, *(uint16 *)&cram[i << 1]);
+        int sag = chaos_rand_below(CHAOS_RNG_VDP, depth + 1);
+        chaos_scroll_column(i, -sag, -sag / 2, 0);
+    }
+}
+
+void chaos_scroll_shear(void)
+{
+    /* planes slide apart around the middle of the screen */
+    int line;
+    float slope = 0.5f * fx_intensity;
+
+    chaos_scroll_speed(0);
+    for (line = 0; line < CHAOS_SCROLL_LINE_COUNT; line++)
+    {
+        int offset = (int)(slope * (line - 112));
+        chaos_scroll_line(line, offset, -offset, 0);
+    }
+}
+
+static void chaos_scroll_lines_off(void)
+{
+    chaos_scroll_clear(CHAOS_SCROLL_LINES);
+}
+
+static void chaos_scroll_columns_off(void)
+{
+    chaos_scroll_clear(CHAOS_SCROLL_COLUMNS);
+}
+
+void chaos_flip_vdp_mode(void)
+{
+    /* Flip random bits in VDP register 12 (display mode control).
+     * Bit 0: display width (32-col vs 40-col)
+     * Bits 1-2: interlace mode
+     * Bit 3: shadow/highlight mode
+     * This produces dramatic visual tearing and resolution glitches. */
+    int bits_to_flip = 1 << chaos_rand_below(CHAOS_RNG_VDP, 4); /* flip one of bits 0-3 */
+    chaos_undo_save(CHAOS_UNDO_VDP_REGS, 12, 1);
+    reg[12] ^= bits_to_flip;
+    /* Signal that viewport/interlace may have changed */
+    bitmap.viewport.changed |= 2;
+}
+
+void chaos_psg_noise_blast(void)
+{
+    /* Blast random noise through the SN76489 PSG chip.
+     * Write noise channel to white noise at random rate + max volume,
+     * and randomize tone channel frequencies and volumes. */
+    unsigned int clk = m68k.cycles;
+
+    /* Noise channel: white noise (bit 2 set), random rate */
+    int noise_mode = 0xE0 | 0x04 | chaos_rand_below(CHAOS_RNG_AUDIO, 4); /* 0xE4-0xE7 */
+    psg_write(clk, noise_mode);
+
+    /* Noise channel volume = max (attenuation 0) */
+    psg_write(clk, 0xF0);
+
+    /* Also blast random tones on channels 0-2 for extra chaos (fewer
+     * channels at lower intensities) */
+    int ch, channels = scale(3, fx_intensity);
+    for (ch = 0; ch < channels; ch++)
+    {
+        /* Set random frequency (latch + low 4 bits) */
+        psg_write(clk, 0x80 | (ch << 5) | chaos_rand_below(CHAOS_RNG_AUDIO, 16));
+        /* High 6 bits of frequency */
+        psg_write(clk, chaos_rand_below(CHAOS_RNG_AUDIO, 64));
+        /* Random volume (0=loud, 0xF=silent) — bias toward loud */
+        psg_write(clk, 0x90 | (ch << 5) | chaos_rand_below(CHAOS_RNG_AUDIO, 6));
     }
 }
 
 /* ======================================================================== */
-/* VRAM Manipulation                                                        */
+/* Layer glitches                                                           */
 /* ======================================================================== */
 
-void chaos_shift_vram_up(void)
+/* Renderer layer flags (RENDER_LAYER_*), whatever the game does with its
+   VDP registers and tables */
+static int layers;
+
+static void layer_set(int flag, int on)
 {
-    int i;
-    for (i = 0; i < 0xFFFF; i++)
+    int flags = on ? (layers | flag) : (layers & ~flag);
+
+    if (flags != layers)
     {
-        vram[i] = vram[i + 1];
+        layers = flags;
+        render_layers(layers);
     }
-    mark_all_vram_dirty();
 }
 
-void chaos_shift_vram_down(void)
+void chaos_hide_plane_a(void)
+{
+    layer_set(RENDER_LAYER_HIDE_A, 1);
+}
+
+void chaos_hide_plane_b(void)
+{
+    layer_set(RENDER_LAYER_HIDE_B, 1);
+}
+
+void chaos_hide_sprites(void)
+{
+    layer_set(RENDER_LAYER_HIDE_SPRITES, 1);
+}
+
+void chaos_sprites_behind(void)
+{
+    layer_set(RENDER_LAYER_SPRITES_BEHIND, 1);
+}
+
+void chaos_swap_planes(void)
+{
+    layer_set(RENDER_LAYER_SWAP_PLANES, 1);
+}
+
+void chaos_flip_priority(void)
+{
+    layer_set(RENDER_LAYER_FLIP_PRIORITY, 1);
+}
+
+void chaos_window_everywhere(void)
+{
+    layer_set(RENDER_LAYER_WINDOW, 1);
+}
+
+static void show_plane_a(void)
+{
+    layer_set(RENDER_LAYER_HIDE_A, 0);
+}
+
+static void show_plane_b(void)
+{
+    layer_set(RENDER_LAYER_HIDE_B, 0);
+}
+
+static void show_sprites(void)
+{
+    layer_set(RENDER_LAYER_HIDE_SPRITES, 0);
+}
+
+static void sprites_in_front(void)
+{
+    layer_set(RENDER_LAYER_SPRITES_BEHIND, 0);
+}
+
+static void unswap_planes(void)
+{
+    layer_set(RENDER_LAYER_SWAP_PLANES, 0);
+}
+
+static void unflip_priority(void)
+{
+    layer_set(RENDER_LAYER_FLIP_PRIORITY, 0);
+}
+
+static void window_as_set(void)
+{
+    layer_set(RENDER_LAYER_WINDOW, 0);
+}
+
+/* ======================================================================== */
+/* Pattern cache glitches                                                   */
+/* ======================================================================== */
+
+/* The tile effects without VRAM: the patterns the planes and sprites name
+   are corrupted where the renderer decoded them. Nothing is decoded again,
+   and a pattern heals when the game writes it */
+static void patterns_apply(int op, int param)
+{
+    int i, count = vram_tile_runs();
+
+    for (i = 0; i < count; i++)
+    {
+        int first = tile_runs[i].start >> 5;
+        int end = (tile_runs[i].start + tile_runs[i].len + 31) >> 5;
+        render_patterns(op, param, first, end - first);
+    }
+}
+
+void chaos_xor_patterns(void)
+{
+    patterns_apply(RENDER_PATTERN_XOR, chaos_rand_below(CHAOS_RNG_VRAM, 15) + 1);
+}
+
+void chaos_roll_patterns(void)
+{
+    /* Up to 63 pixels (almost 8 pattern lines) at full intensity */
+    patterns_apply(RENDER_PATTERN_ROLL, chaos_rand_below(CHAOS_RNG_VRAM, scale(63, fx_intensity)) + 1);
+}
+
+/* ======================================================================== */
+/* ROM corruption                                                           */
+/* ======================================================================== */
+
+static uint16 rom_code_pages[CHAOS_ROM_PAGES];
+
+void chaos_corrupt_rom(void)
 {
-    int i;
-    for (i = 0xFFFF; i > 0; i--)
+    int i, bytes = scale(8, fx_intensity); /* 8 bytes at full intensity */
+    int pages = chaos_rom_code_pages(rom_code_pages);
+
+    if (!cart.romsize)
+        return;
+
+    for (i = 0; i < bytes; i++)
     {
-        vram[i] = vram[i - 1];
+        int offset;
+        uint8 *byte;
+
+        /* in a page code ran from, anywhere until some did */
+        if (pages)
+            offset = (rom_code_pages[chaos_rand_below(CHAOS_RNG_CPU, pages)] << M68K_CACHE_PAGE_SHIFT) |
+                     chaos_rand_below(CHAOS_RNG_CPU, 1 << M68K_CACHE_PAGE_SHIFT);
+        else
+            offset = chaos_rand_below(CHAOS_RNG_CPU, cart.romsize);
+
+        /* out of clones: only the banks already cloned can still change */
+        byte = chaos_rom_byte(offset);
+        if (!byte)
+            return;
+        *byte ^= chaos_rand_below(CHAOS_RNG_CPU, 255) + 1;
     }
-    mark_all_vram_dirty();
 }
 
-void chaos_shift_vram_left(void)
+void chaos_restore_rom(void)
 {
-    int block, i, base;
-    for (block = 0; block < 0x100; block++)
-    {
-        base = block * 256;
-        for (i = 0; i < 255; i++)
-        {
-            vram[base + i] = vram[base + i + 1];
-        }
-    }
-    mark_all_vram_dirty();
+    chaos_cheat_select(-1);
+    chaos_rom_restore();
 }
 
-void chaos_shift_vram_right(void)
+/* Cheat code sets (chaos_cheat.h): random_cheats fills the next set and
+   makes it active, cycle_cheats fills them all and moves to the next one
+   every frame */
+static int cheat_next;
+static int cheat_cycling;
+
+void chaos_random_cheats(void)
 {
-    int block, i, base;
-    for (block = 0; block < 0x100; block++)
-    {
-        base = block * 256;
-        for (i = 255; i > 0; i--)
-        {
-            vram[base + i] = vram[base + i - 1];
-        }
-    }
-    mark_all_vram_dirty();
+    chaos_cheat_generate(cheat_next, 1, scale(CHAOS_CHEAT_CODES, fx_intensity));
+    chaos_cheat_select(cheat_next);
+    cheat_next = (cheat_next + 1) % CHAOS_CHEAT_SETS;
 }
 
-void chaos_shift_vram_down_random(void)
+void chaos_cycle_cheats(void)
 {
-    int shift_amount = rand() % 64;
-    int i;
-    for (i = 0xFFFF; i > shift_amount; i--)
-    {
-        vram[i] = vram[i - shift_amount];
-    }
-    for (i = 0; i < shift_amount; i++)
-    {
-        vram[i] = 0;
-    }
-    mark_all_vram_dirty();
+    chaos_cheat_generate(0, CHAOS_CHEAT_SETS, scale(CHAOS_CHEAT_CODES, fx_intensity));
+    cheat_cycling = 1;
 }
 
-void chaos_corrupt_vram_one_byte(void)
+static void cycle_cheats_off(void)
 {
-    int addr = rand() % 0x10000;
-    vram[addr] = rand() % 256;
-    mark_all_vram_dirty();
+    cheat_cycling = 0;
+    chaos_cheat_select(-1);
 }
 
-void chaos_invert_vram_contents(void)
+static void cheats_frame(void)
 {
-    int addr;
-    for (addr = 0; addr < 0x10000; addr++)
-    {
-        vram[addr] = ~vram[addr];
-    }
-    mark_all_vram_dirty();
+    if (cheat_cycling)
+        chaos_cheat_select((chaos_cheat_active() + 1) % CHAOS_CHEAT_SETS);
+    chaos_cheat_frame();
 }
 
-/* ======================================================================== */
-/* CRAM / Color Manipulation                                                */
-/* ======================================================================== */
+/* DMA glitches (vdp_dma_glitch()): a wrong source, a wrong destination or
+   a truncated length for every DMA the game starts while armed */
+static int dma_source;
+static int dma_dest;
+static int dma_keep = 256;
 
-void chaos_randomize_cram(void)
+static void dma_glitch_update(void)
 {
-    /* Defer to pre-render hook so it runs after VBlank DMA */
-    cram_randomize_pending = 1;
+    vdp_dma_glitch(dma_source, dma_dest, dma_keep);
 }
 
-void chaos_shift_cram_up(void)
+/* 'n' or -'n' */
+static int random_sign(int n)
 {
-    /* Defer to pre-render hook so it runs after VBlank DMA */
-    cram_shift_pending = 1;
+    return chaos_rand_below(CHAOS_RNG_VDP, 2) ? -n : n;
 }
 
-void chaos_enable_cram_corruption(void)
+void chaos_dma_wrong_source(void)
 {
-    cram_corruption_enabled = 1;
+    /* Up to 2K words (4KB) away at full intensity */
+    dma_source = random_sign(chaos_rand_below(CHAOS_RNG_VDP, scale(0x800, fx_intensity)) + 1);
+    dma_glitch_update();
 }
 
-void chaos_disable_cram_corruption(void)
+void chaos_dma_wrong_dest(void)
 {
-    cram_corruption_enabled = 0;
+    /* Up to 2KB away (even) at full intensity */
+    dma_dest = random_sign((chaos_rand_below(CHAOS_RNG_VDP, scale(0x400, fx_intensity)) + 1) * 2);
+    dma_glitch_update();
 }
 
-/* ======================================================================== */
-/* VSRAM / H-Scroll / CPU SR                                                */
-/* ======================================================================== */
-
-void chaos_corrupt_vsram(void)
+void chaos_dma_truncate(void)
 {
-    /* Defer to pre-render hook so it runs after VBlank DMA */
-    vsram_corrupt_pending = 1;
+    /* A quarter of each transfer left at full intensity */
+    dma_keep = 256 - scale(192, fx_intensity);
+    dma_glitch_update();
 }
 
-void chaos_hscroll_waviness(void)
+static void dma_wrong_source_off(void)
 {
-    /* Defer to pre-render hook so it runs after VBlank DMA */
-    hscroll_wave_pending = 1;
+    dma_source = 0;
+    dma_glitch_update();
 }
 
-void chaos_flip_vdp_mode(void)
+static void dma_wrong_dest_off(void)
 {
-    /* Flip random bits in VDP register 12 (display mode control).
-     * Bit 0: display width (32-col vs 40-col)
-     * Bits 1-2: interlace mode
-     * Bit 3: shadow/highlight mode
-     * This produces dramatic visual tearing and resolution glitches. */
-    int bits_to_flip = 1 << (rand() % 4); /* flip one of bits 0-3 */
-    reg[12] ^= bits_to_flip;
-    /* Signal that viewport/interlace may have changed */
-    bitmap.viewport.changed |= 2;
+    dma_dest = 0;
+    dma_glitch_update();
 }
 
-void chaos_psg_noise_blast(void)
+static void dma_truncate_off(void)
 {
-    /* Blast random noise through the SN76489 PSG chip.
-     * Write noise channel to white noise at random rate + max volume,
-     * and randomize tone channel frequencies and volumes. */
-    unsigned int clk = m68k.cycles;
-
-    /* Noise channel: white noise (bit 2 set), random rate */
-    int noise_mode = 0xE0 | 0x04 | (rand() % 4); /* 0xE4-0xE7 */
-    psg_write(clk, noise_mode);
+    dma_keep = 256;
+    dma_glitch_update();
+}
 
-    /* Noise channel volume = max (attenuation 0) */
-    psg_write(clk, 0xF0);
+void chaos_reset(void)
+{
+    chaos_palette_clear();
+    layer_set(layers, 0);
+    chaos_scroll_clear(CHAOS_SCROLL_LINES | CHAOS_SCROLL_COLUMNS);
+    chaos_fm_clear();
+    chaos_schedule_clear();
+    chaos_bind_reset();
+    chaos_mod_reset();
+    chaos_vm_reset();
+    chaos_preset_reset();
+    chaos_cheat_clear();
+    cheat_cycling = 0;
+    cheat_next = 0;
+    dma_source = dma_dest = 0;
+    dma_keep = 256;
+    dma_glitch_update();
+    chaos_rom_restore();
+    chaos_freeze_clear();
+    scroll_frozen = 0;
+    chaos_sprite_clear();
+    chaos_linepal_clear();
+#ifdef CHAOS_BUS_NOISE
+    chaos_bus_reset();
+#endif
+    memset(sweeps, 0, sizeof(sweeps));
+    chaos_undo_clear();
+}
 
-    /* Also blast random tones on channels 0-2 for extra chaos */
-    int ch;
-    for (ch = 0; ch < 3; ch++)
-    {
-        /* Set random frequency (latch + low 4 bits) */
-        psg_write(clk, 0x80 | (ch << 5) | (rand() % 16));
-        /* High 6 bits of frequency */
-        psg_write(clk, rand() % 64);
-        /* Random volume (0=loud, 0xF=silent) — bias toward loud */
-        psg_write(clk, 0x90 | (ch << 5) | (rand() % 6));
-    }
+int chaos_context_save(uint8_t *state)
+{
+    int size = 0;
+
+    memcpy(state, chaos_rng_state, sizeof(chaos_rng_state));
+    size += sizeof(chaos_rng_state);
+    memcpy(state + size, sweeps, sizeof(sweeps));
+    size += sizeof(sweeps);
+    size += chaos_freeze_save(state + size);
+    size += chaos_sprite_save(state + size);
+#ifdef CHAOS_BUS_NOISE
+    size += chaos_bus_save(state + size);
+#endif
+    return size + chaos_param_save(state + size);
 }
 
-void chaos_reset(void)
+int chaos_context_load(const uint8_t *state)
 {
-    cram_corruption_enabled = 0;
-    fm_corruption_enabled = 0;
-    cram_randomize_pending = 0;
-    cram_shift_pending = 0;
-    vsram_corrupt_pending = 0;
-    hscroll_wave_pending = 0;
+    int size = 0;
+
+    memcpy(chaos_rng_state, state, sizeof(chaos_rng_state));
+    size += sizeof(chaos_rng_state);
+    memcpy(sweeps, state + size, sizeof(sweeps));
+    size += sizeof(sweeps);
+    size += chaos_freeze_load(state + size);
+    size += chaos_sprite_load(state + size);
+#ifdef CHAOS_BUS_NOISE
+    size += chaos_bus_load(state + size);
+#endif
+    return size + chaos_param_load(state + size);
 }
 
 /* ======================================================================== */
@@ -227,134 +1131,17 @@ void chaos_reset(void)
 
 void chaos_scroll_register_fuzzing(void)
 {
-    /* Fuzz one of the first 4 VDP registers (scroll-related) */
-    int reg_to_fuzz = rand() % 4;
-    int fuzz_amount = (rand() % 21) - 10;
-    reg[reg_to_fuzz] = reg[reg_to_fuzz] + fuzz_amount;
+    chaos_core_scroll_register_fuzzing(NULL);
 }
 
 void chaos_sprite_attribute_scramble(void)
 {
-    /* Get sprite attribute table base address from VDP register 5 */
-    int sprite_table_base = (reg[5] & 0x7F) << 9;
-    int max_sprites = 80;
-    int sprite_entry_size = 8;
-    int active_sprites[80];
-    int active_sprite_count = 0;
-    int i, effects_to_apply, effect_num;
-
-    /* Find active sprites */
-    for (i = 0; i < max_sprites; i++)
-    {
-        int sprite_addr = sprite_table_base + (i * sprite_entry_size);
-        uint8 y_high = vram[sprite_addr + 0];
-        uint8 y_low = vram[sprite_addr + 1];
-        uint8 pattern_high = vram[sprite_addr + 4];
-        uint8 pattern_low = vram[sprite_addr + 5];
-        uint8 x_high = vram[sprite_addr + 6];
-        uint8 x_low = vram[sprite_addr + 7];
-
-        int has_position = (y_high != 0 || y_low != 0 || x_high != 0 || x_low != 0);
-        int has_pattern = (pattern_high != 0 || pattern_low != 0);
-        int reasonable_y = (y_high < 8);
-
-        if ((has_position || has_pattern) && reasonable_y)
-        {
-            active_sprites[active_sprite_count] = i;
-            active_sprite_count++;
-        }
-    }
-
-    if (active_sprite_count == 0)
-    {
-        for (i = 0; i < 5; i++)
-            active_sprites[i] = i;
-        active_sprite_count = 5;
-    }
-
-    effects_to_apply = (active_sprite_count < 10) ? active_sprite_count : (rand() % 10) + 1;
-
-    for (effect_num = 0; effect_num < effects_to_apply; effect_num++)
-    {
-        int sprite_index = active_sprites[rand() % active_sprite_count];
-        int sprite_addr = sprite_table_base + (sprite_index * sprite_entry_size);
-        int scramble_type = rand() % 10;
-        int pos, byte_offset;
-
-        switch (scramble_type)
-        {
-        case 0: /* Scramble Y position */
-            pos = rand() % 1024 - 256;
-            vram[sprite_addr + 0] = (pos >> 8) & 0xFF;
-            vram[sprite_addr + 1] = pos & 0xFF;
-            break;
-        case 1: /* Scramble sprite size + link */
-            vram[sprite_addr + 2] = rand() % 256;
-            vram[sprite_addr + 3] = rand() % 256;
-            break;
-        case 2: /* Scramble tile pattern */
-            vram[sprite_addr + 4] = rand() % 256;
-            vram[sprite_addr + 5] = rand() % 256;
-            break;
-        case 3: /* Scramble X position */
-            pos = rand() % 1024 - 256;
-            vram[sprite_addr + 6] = (pos >> 8) & 0xFF;
-            vram[sprite_addr + 7] = pos & 0xFF;
-            break;
-        case 4: /* Swap with another sprite */
-            if (active_sprite_count > 1)
-            {
-                int sprite2_index = active_sprites[rand() % active_sprite_count];
-                int sprite2_addr = sprite_table_base + (sprite2_index * sprite_entry_size);
-                uint8 tmp;
-                for (byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
-                {
-                    tmp = vram[sprite_addr + byte_offset];
-                    vram[sprite_addr + byte_offset] = vram[sprite2_addr + byte_offset];
-                    vram[sprite2_addr + byte_offset] = tmp;
-                }
-            }
-            break;
-        case 5: /* Completely randomize */
-            for (byte_offset = 0; byte_offset < sprite_entry_size; byte_offset++)
-                vram[sprite_addr + byte_offset] = rand() % 256;
-            break;
-        case 6: /* Ghost sprite (position = 0) */
-            vram[sprite_addr + 0] = 0;
-            vram[sprite_addr + 1] = 0;
-            vram[sprite_addr + 6] = 0;
-            vram[sprite_addr + 7] = 0;
-            break;
-        case 7: /* Giant sprite */
-            vram[sprite_addr + 2] = 0xFF;
-            vram[sprite_addr + 0] = rand() % 256;
-            vram[sprite_addr + 1] = rand() % 256;
-            vram[sprite_addr + 6] = rand() % 256;
-            vram[sprite_addr + 7] = rand() % 256;
-            break;
-        case 8: /* Break sprite chains */
-            vram[sprite_addr + 3] = rand() % 256;
-            vram[sprite_addr + 2] = rand() % 256;
-            break;
-        case 9: /* Stretchy sprite */
-        {
-            unsigned short weird_pattern = rand() % 0xFFFF;
-            vram[sprite_addr + 4] = (weird_pattern >> 8) & 0xFF;
-            vram[sprite_addr + 5] = weird_pattern & 0xFF;
-            vram[sprite_addr + 2] = 0xFF;
-            break;
-        }
-        }
-    }
-
-    /* Occasionally scramble sprite table base register */
-    if (rand() % 10 == 0)
-    {
-        reg[5] = (reg[5] & 0x80) | (rand() % 128);
-        satb = (reg[5] << 9) & 0xFE00;
-    }
+    chaos_core_sprite_attribute_scramble(NULL);
+}
 
-    mark_all_vram_dirty();
+void chaos_jitter_sprites(void)
+{
+    chaos_sprite_jitter(scale(8, fx_intensity), scale(8, fx_intensity), 1);
 }
 
 /* ======================================================================== */
@@ -363,31 +1150,44 @@ void chaos_sprite_attribute_scramble(void)
 
 void chaos_enable_fm_corruption(void)
 {
-    fm_corruption_enabled = 1;
+    chaos_param_set(CHAOS_PARAM_FM_CORRUPTION, fx_intensity);
 }
 
 void chaos_disable_fm_corruption(void)
 {
-    fm_corruption_enabled = 0;
+    chaos_param_set(CHAOS_PARAM_FM_CORRUPTION, 0.0f);
 }
 
 void chaos_corrupt_dac_data(void)
 {
-    /* Corrupt Z80 RAM region commonly used for DAC/PCM data */
-    int corruptions = rand() % 64 + 16;
-    int i;
+    int corruptions, i;
+
+    /* A few writes to the sound driver structures found (1 to 4 a frame,
+     * nudges of up to 8 steps at full intensity) */
+    if (chaos_zdrv_corrupt(scale(4, fx_intensity), scale(8, fx_intensity)))
+        return;
+
+    /* Otherwise corrupt Z80 RAM region commonly used for DAC/PCM data: 16
+     * to 79 bytes at full intensity */
+    corruptions = chaos_rand_below(CHAOS_RNG_AUDIO, scale(64, fx_intensity)) + scale(16, fx_intensity);
     for (i = 0; i < corruptions; i++)
     {
-        int index = 0x100 + (rand() % 0x1F00); /* Skip first 0x100 bytes */
-        zram[index] = rand() % 256;
+        int index = 0x100 + chaos_rand_below(CHAOS_RNG_AUDIO, 0x1F00); /* Skip first 0x100 bytes */
+        chaos_undo_save(CHAOS_UNDO_ZRAM, index, 1);
+        zram[index] = chaos_rand_below(CHAOS_RNG_AUDIO, 256);
     }
 }
 
 void chaos_bitcrush_audio_memory(void)
 {
-    int bits_to_clear = 4; /* Moderate bitcrush */
+    int bits_to_clear = scale(4, fx_intensity); /* Moderate bitcrush at full intensity */
     uint8 mask = 0xFF << bits_to_clear;
     int i;
+
+    /* quantized note tables, or every byte past the first 0x100 */
+    if (chaos_zdrv_bitcrush(bits_to_clear))
+        return;
+    chaos_undo_save(CHAOS_UNDO_ZRAM, 0x100, 0x1F00);
     for (i = 0x100; i < 0x2000; i++)
     {
         zram[i] &= mask;
@@ -396,7 +1196,7 @@ void chaos_bitcrush_audio_memory(void)
 
 void chaos_detune_fm_registers(void)
 {
-    int channel;
+    int channel, line;
     /* Detune all 6 FM channels by writing random frequency offsets */
     for (channel = 0; channel < 6; channel++)
     {
@@ -405,49 +1205,49 @@ void chaos_detune_fm_registers(void)
 
         /* Frequency low byte register (0xA0 + ch_offset) */
         int freq_low_reg = 0xA0 + ch_offset;
-        int detune = (rand() % 64) - 32;
+        int range = scale(32, fx_intensity);
+        int detune = chaos_rand_below(CHAOS_RNG_AUDIO, range * 2) - range;
         int new_val = detune; /* Just add random offset; wraps naturally via uint8 */
         if (new_val < 0)
             new_val = 0;
         if (new_val > 255)
             new_val = 255;
 
-        /* Select register, then write data */
-        YM2612Write(bank, freq_low_reg); /* address write */
-        YM2612Write(bank + 1, new_val);  /* data write */
+        /* Select register, then write data (on a random line of this frame) */
+        line = chaos_fm_random_line();
+        chaos_fm_write(line, bank, freq_low_reg, new_val);
 
         /* Frequency high byte register (0xA4 + ch_offset) */
         {
             int freq_high_reg = 0xA4 + ch_offset;
-            int detune_hi = (rand() % 16) - 8;
+            int range_hi = scale(8, fx_intensity);
+            int detune_hi = chaos_rand_below(CHAOS_RNG_AUDIO, range_hi * 2) - range_hi;
             int new_hi = detune_hi;
             if (new_hi < 0)
                 new_hi = 0;
             if (new_hi > 63)
                 new_hi = 63;
 
-            YM2612Write(bank, freq_high_reg);
-            YM2612Write(bank + 1, new_hi);
+            chaos_fm_write(line, bank, freq_high_reg, new_hi);
         }
     }
 }
 
 void chaos_shift_audio_memory_up(void)
 {
-    int i;
-    for (i = 0; i < 0x1FFF; i++)
-    {
-        zram[i] = zram[i + 1];
-    }
+    /* a semitone up if the note tables were found */
+    if (chaos_zdrv_transpose(1))
+        return;
+    chaos_undo_shift(CHAOS_UNDO_ZRAM, 0, 0x2000, 0, -1);
+    chaos_kernel_shift(zram, 0x2000, -1, 0);
 }
 
 void chaos_shift_audio_memory_down(void)
 {
-    int i;
-    for (i = 0x1FFF; i > 0; i--)
-    {
-        zram[i] = zram[i - 1];
-    }
+    if (chaos_zdrv_transpose(-1))
+        return;
+    chaos_undo_shift(CHAOS_UNDO_ZRAM, 0, 0x2000, 0, 1);
+    chaos_kernel_shift(zram, 0x2000, 1, 0);
 }
 
 /* ======================================================================== */
@@ -456,301 +1256,406 @@ void chaos_shift_audio_memory_down(void)
 
 void chaos_corrupt_68k_ram_one_byte(void)
 {
-    int addr = rand() % 0x10000;
-    work_ram[addr] = rand() % 256;
+    chaos_core_corrupt_68k_ram_one_byte(NULL);
 }
 
 void chaos_critical_ram_scramble(void)
 {
-    int i, addr;
-
-    /* Corrupt random bytes in upper 32KB of RAM (likely stack space) */
-    for (i = 0; i < 32; i++)
-    {
-        addr = 0x8000 + (rand() % 0x8000);
-        work_ram[addr] = rand() % 256;
-    }
-
-    /* Also corrupt some bytes at the beginning of RAM */
-    for (i = 0; i < 16; i++)
-    {
-        addr = rand() % 0x1000;
-        work_ram[addr] = rand() % 256;
-    }
+    chaos_core_critical_ram_scramble(NULL);
 }
 
 void chaos_program_counter_increment(void)
 {
-    unsigned int pc = m68k_get_reg(M68K_REG_PC);
-    unsigned int increment = ((rand() % 4) + 1) * 2; /* 2-8 bytes, even */
-    m68k_set_reg(M68K_REG_PC, pc + increment);
+    chaos_core_program_counter_increment(NULL);
+    m68k_fetch_invalidate();
 }
 
 void chaos_random_register_corruption(void)
 {
-    int reg_type = rand() % 2;
-    int reg_index = rand() % 8;
-    m68k_register_t reg_id;
+    chaos_core_random_register_corruption(NULL);
+}
 
-    if (reg_type == 0)
-    {
-        reg_id = (m68k_register_t)(M68K_REG_D0 + reg_index);
-    }
-    else
-    {
-        reg_id = (m68k_register_t)(M68K_REG_A0 + reg_index);
-    }
+void chaos_flip_game_logic_variables(void)
+{
+    chaos_core_flip_game_logic_variables(NULL);
+}
+
+/* ======================================================================== */
+/* Effect registry                                                          */
+/* ======================================================================== */
 
-    m68k_set_reg(reg_id, (unsigned int)rand());
+static const chaos_effect_t chaos_effects[CHAOS_FX_COUNT] =
+{
+    {"shift_vram_up",             CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_shift_vram_up,               NULL},
+    {"shift_vram_down",           CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_shift_vram_down,             NULL},
+    {"shift_vram_left",           CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_shift_vram_left,             NULL},
+    {"shift_vram_right",          CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_shift_vram_right,            NULL},
+    {"shift_vram_down_random",    CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_shift_vram_down_random,      NULL},
+    {"corrupt_vram_one_byte",     CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_corrupt_vram_one_byte,       NULL},
+    {"invert_vram",               CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_invert_vram_contents,        NULL},
+    {"rotate_vram",               CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_rotate_vram,                 NULL},
+    {"xor_vram",                  CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_xor_vram,                    NULL},
+    {"nibble_swap_vram",          CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_nibble_swap_vram,            NULL},
+    {"randomize_cram",            CHAOS_KIND_HELD,       CHAOS_TARGET_CRAM,     chaos_randomize_cram,              NULL},
+    {"shift_cram_up",             CHAOS_KIND_HELD,       CHAOS_TARGET_CRAM,     chaos_shift_cram_up,               NULL},
+    {"cram_corruption",           CHAOS_KIND_PERSISTENT, CHAOS_TARGET_CRAM,     chaos_enable_cram_corruption,      chaos_disable_cram_corruption},
+    {"corrupt_vsram",             CHAOS_KIND_HELD,       CHAOS_TARGET_VSRAM,    chaos_corrupt_vsram,               NULL},
+    {"hscroll_waviness",          CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_hscroll_waviness,            NULL},
+    {"flip_vdp_mode",             CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VDP_REGS, chaos_flip_vdp_mode,               NULL},
+    {"scroll_register_fuzzing",   CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VDP_REGS, chaos_scroll_register_fuzzing,     NULL},
+    {"sprite_attribute_scramble", CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_sprite_attribute_scramble,   NULL},
+    {"fm_corruption",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_FM,       chaos_enable_fm_corruption,        chaos_disable_fm_corruption},
+    {"corrupt_dac_data",          CHAOS_KIND_HELD,       CHAOS_TARGET_ZRAM,     chaos_corrupt_dac_data,            NULL},
+    {"bitcrush_audio_memory",     CHAOS_KIND_HELD,       CHAOS_TARGET_ZRAM,     chaos_bitcrush_audio_memory,       NULL},
+    {"detune_fm_registers",       CHAOS_KIND_HELD,       CHAOS_TARGET_FM,       chaos_detune_fm_registers,         NULL},
+    {"psg_noise_blast",           CHAOS_KIND_HELD,       CHAOS_TARGET_PSG,      chaos_psg_noise_blast,             NULL},
+    {"shift_audio_memory_up",     CHAOS_KIND_ONESHOT,    CHAOS_TARGET_ZRAM,     chaos_shift_audio_memory_up,       NULL},
+    {"shift_audio_memory_down",   CHAOS_KIND_ONESHOT,    CHAOS_TARGET_ZRAM,     chaos_shift_audio_memory_down,     NULL},
+    {"corrupt_68k_ram_one_byte",  CHAOS_KIND_HELD,       CHAOS_TARGET_WORK_RAM, chaos_corrupt_68k_ram_one_byte,    NULL},
+    {"critical_ram_scramble",     CHAOS_KIND_HELD,       CHAOS_TARGET_WORK_RAM, chaos_critical_ram_scramble,       NULL},
+    {"program_counter_increment", CHAOS_KIND_ONESHOT,    CHAOS_TARGET_CPU,      chaos_program_counter_increment,   NULL},
+    {"random_register_corruption",CHAOS_KIND_ONESHOT,    CHAOS_TARGET_CPU,      chaos_random_register_corruption,  NULL},
+    {"flip_game_logic_variables", CHAOS_KIND_ONESHOT,    CHAOS_TARGET_WORK_RAM, chaos_flip_game_logic_variables,   NULL},
+    {"scroll_wave",               CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VSRAM,    chaos_scroll_wave,                 chaos_scroll_lines_off},
+    {"scroll_melt",               CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VSRAM,    chaos_scroll_melt,                 chaos_scroll_columns_off},
+    {"scroll_shear",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VSRAM,    chaos_scroll_shear,                chaos_scroll_lines_off},
+    {"restore_palette",           CHAOS_KIND_ONESHOT,    CHAOS_TARGET_CRAM,     chaos_restore_palette,             NULL},
+    {"hide_plane_a",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_hide_plane_a,                show_plane_a},
+    {"hide_plane_b",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_hide_plane_b,                show_plane_b},
+    {"hide_sprites",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_hide_sprites,                show_sprites},
+    {"sprites_behind",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_sprites_behind,              sprites_in_front},
+    {"swap_planes",               CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_swap_planes,                 unswap_planes},
+    {"flip_priority",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_flip_priority,               unflip_priority},
+    {"window_everywhere",         CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VDP_REGS, chaos_window_everywhere,           window_as_set},
+    {"xor_patterns",              CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_xor_patterns,                NULL},
+    {"roll_patterns",             CHAOS_KIND_ONESHOT,    CHAOS_TARGET_VRAM,     chaos_roll_patterns,               NULL},
+    {"corrupt_rom",               CHAOS_KIND_ONESHOT,    CHAOS_TARGET_ROM,      chaos_corrupt_rom,                 NULL},
+    {"restore_rom",               CHAOS_KIND_ONESHOT,    CHAOS_TARGET_ROM,      chaos_restore_rom,                 NULL},
+    {"post_rgb_split",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_POST,     chaos_post_rgb_split,              post_rgb_split_off},
+    {"post_trails",               CHAOS_KIND_PERSISTENT, CHAOS_TARGET_POST,     chaos_post_trails,                 post_trails_off},
+    {"post_block_smear",          CHAOS_KIND_PERSISTENT, CHAOS_TARGET_POST,     chaos_post_block_smear,            post_block_smear_off},
+    {"post_scanline_jitter",      CHAOS_KIND_PERSISTENT, CHAOS_TARGET_POST,     chaos_post_scanline_jitter,        post_scanline_jitter_off},
+    {"audio_stutter",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_OUTPUT,   chaos_audio_stutter,               audio_stutter_off},
+    {"audio_reverse",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_OUTPUT,   chaos_audio_reverse,               audio_reverse_off},
+    {"audio_decimate",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_OUTPUT,   chaos_audio_decimate,              audio_decimate_off},
+    {"cpu_overclock",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_CPU,      chaos_cpu_overclock,               cpu_overclock_off},
+    {"z80_underclock",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_CPU,      chaos_z80_underclock,              z80_underclock_off},
+    {"freeze_tiles",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VRAM,     chaos_freeze_tiles,                freeze_tiles_off},
+    {"freeze_palette",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_CRAM,     chaos_freeze_palette,              freeze_palette_off},
+    {"freeze_scroll",             CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VSRAM | CHAOS_TARGET_VRAM, chaos_freeze_scroll, freeze_scroll_off},
+    {"jitter_sprites",            CHAOS_KIND_HELD,       CHAOS_TARGET_VRAM,     chaos_jitter_sprites,              NULL},
+    {"copper_bars",               CHAOS_KIND_PERSISTENT, CHAOS_TARGET_CRAM,     chaos_copper_bars,                 chaos_linepal_clear},
+    {"raster_palette_glitch",     CHAOS_KIND_HELD,       CHAOS_TARGET_CRAM,     chaos_raster_palette_glitch,       NULL},
+    {"random_cheats",             CHAOS_KIND_ONESHOT,    CHAOS_TARGET_ROM | CHAOS_TARGET_WORK_RAM, chaos_random_cheats, NULL},
+    {"cycle_cheats",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_ROM | CHAOS_TARGET_WORK_RAM, chaos_cycle_cheats, cycle_cheats_off},
+    {"dma_wrong_source",          CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM, chaos_dma_wrong_source, dma_wrong_source_off},
+    {"dma_wrong_dest",            CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM, chaos_dma_wrong_dest, dma_wrong_dest_off},
+    {"dma_truncate",              CHAOS_KIND_PERSISTENT, CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM, chaos_dma_truncate, dma_truncate_off}
+};
+
+/* Per-effect cost accounting */
+static uint32 effect_calls[CHAOS_FX_COUNT];
+static double effect_msec[CHAOS_FX_COUNT];
+static float effect_stats[CHAOS_FX_COUNT * 2];
+
+/* Add time spent since 'start' (deferred or per-frame work) to an effect */
+static void chaos_account(int id, double start)
+{
+    effect_msec[id] += emscripten_get_now() - start;
 }
 
-void chaos_flip_game_logic_variables(void)
+int chaos_effect_count(void)
 {
-    /* Target common variable locations used by Genesis games */
-    struct
-    {
-        int base_addr;
-        int range;
-    } targets[] = {
-        {0x0000, 0x400},
-        {0x0400, 0x400},
-        {0x0800, 0x800},
-        {0x1000, 0x800},
-        {0x1800, 0x600},
-        {0x2000, 0x800},
-        {0x3000, 0x1000},
-        {0x8000, 0x1000},
-        {0xC000, 0x2000},
-        {0xF000, 0x800}};
-    int num_targets = 10;
-    int area, i, addr, hunt;
-
-    for (area = 0; area < num_targets; area++)
-    {
-        int corruptions_in_area = 3 + (rand() % 6);
-        for (i = 0; i < corruptions_in_area; i++)
-        {
-            uint8 value, new_value;
-            int chaos_type;
+    return CHAOS_FX_COUNT;
+}
 
-            addr = targets[area].base_addr + (rand() % targets[area].range);
-            if (addr >= 0x10000)
-                continue;
-            value = work_ram[addr];
+const char *chaos_effect_name(int id)
+{
+    return ((unsigned int)id < CHAOS_FX_COUNT) ? chaos_effects[id].name : NULL;
+}
 
-            if (value == 0x00 || value == 0xFF)
-                continue;
+int chaos_effect_kind(int id)
+{
+    if ((unsigned int)(id - CHAOS_FX_USER) < CHAOS_VM_PROGRAMS)
+        return CHAOS_KIND_ONESHOT;
+    return ((unsigned int)id < CHAOS_FX_COUNT) ? chaos_effects[id].kind : -1;
+}
 
-            chaos_type = rand() % 6;
-            switch (chaos_type)
-            {
-            case 0:
-                new_value = ~value;
-                break;
-            case 1:
-            {
-                uint8 bad_values[] = {0xFF, 0x80, 0x7F, 0x01, 0x00};
-                new_value = bad_values[rand() % 5];
-                break;
-            }
-            case 2:
-                new_value = value + (rand() % 32) + 1;
-                break;
-            case 3:
-                new_value = value * 2;
-                break;
-            case 4:
-                new_value = value | (1 << (rand() % 8));
-                break;
-            case 5:
-                new_value = value & ~(1 << (rand() % 8));
-                break;
-            default:
-                new_value = ~value;
-                break;
-            }
+int chaos_effect_targets(int id)
+{
+    if ((unsigned int)(id - CHAOS_FX_USER) < CHAOS_VM_PROGRAMS)
+        return chaos_vm_targets(id - CHAOS_FX_USER);
+    return ((unsigned int)id < CHAOS_FX_COUNT) ? chaos_effects[id].targets : 0;
+}
 
-            work_ram[addr] = new_value;
-        }
+int chaos_apply(int id, float intensity)
+{
+    const chaos_effect_t *fx;
+    double start;
+
+    int done;
+
+    if ((unsigned int)(id - CHAOS_FX_USER) < CHAOS_VM_PROGRAMS)
+    {
+        chaos_undo_begin();
+        done = chaos_vm_run(id - CHAOS_FX_USER, intensity);
+        chaos_undo_end();
+        return done;
     }
+    if ((unsigned int)id >= CHAOS_FX_COUNT)
+        return 0;
+
+    fx = &chaos_effects[id];
 
-    /* Hunt for counter-like values (1-99) and flip them */
-    for (hunt = 0; hunt < 20; hunt++)
+    /* per-effect gain, 0 mutes the effect */
+    if ((fx->kind != CHAOS_KIND_PERSISTENT) && (chaos_params[id] <= 0.0f))
+        return 0;
+
+    start = emscripten_get_now();
+    chaos_undo_begin();
+
+    if ((fx->kind == CHAOS_KIND_PERSISTENT) && (intensity <= 0.0f))
     {
-        addr = rand() % 0x8000;
-        if (work_ram[addr] >= 1 && work_ram[addr] <= 99)
-        {
-            work_ram[addr] = (rand() % 2) ? 0 : 255;
-        }
+        fx->release();
+    }
+    else
+    {
+        intensity *= chaos_params[id];
+
+        fx_intensity = (intensity > 1.0f) ? 1.0f : (intensity < 0.0f) ? 0.0f : intensity;
+        fx->apply();
+        fx_intensity = 1.0f;
     }
 
-    /* Hunt for boolean-like flags and flip them */
-    for (hunt = 0; hunt < 30; hunt++)
+    chaos_undo_end();
+
+    effect_calls[id]++;
+    chaos_account(id, start);
+    return 1;
+}
+
+float *chaos_stats(void)
+{
+    int i;
+    for (i = 0; i < CHAOS_FX_COUNT; i++)
     {
-        addr = rand() % 0x8000;
-        if (work_ram[addr] == 0x00 || work_ram[addr] == 0x01)
-        {
-            work_ram[addr] = work_ram[addr] ? 0x00 : 0xFF;
-        }
+        effect_stats[i * 2 + 0] = (float)effect_calls[i];
+        effect_stats[i * 2 + 1] = (float)(effect_msec[i] * 1000.0);
     }
+    return effect_stats;
+}
+
+void chaos_stats_reset(void)
+{
+    memset(effect_calls, 0, sizeof(effect_calls));
+    memset(effect_msec, 0, sizeof(effect_msec));
 }
 
 /* ======================================================================== */
 /* Pre-render hook: called after VBlank DMA, before Active Display          */
-/* This ensures CRAM modifications aren't overwritten by game palette DMA   */
 /* ======================================================================== */
 
+/* Persistent CRAM corruption: new palette noise every frame */
+static void cram_corruption_frame(void)
+{
+    double start;
+
+    if (chaos_params[CHAOS_PARAM_CRAM_CORRUPTION] <= 0.0f)
+        return;
+
+    start = emscripten_get_now();
+    chaos_palette_noise(scale(8, chaos_params[CHAOS_PARAM_CRAM_CORRUPTION]),
+                        scale(64, chaos_params[CHAOS_PARAM_CRAM_RANGE]));
+    chaos_account(CHAOS_FX_CRAM_CORRUPTION, start);
+}
+
 void chaos_pre_render_hook(void)
 {
-    int dirty = 0;
+    /* VBlank DMA may have rewritten the name tables and the SAT */
+    chaos_vram_invalidate();
 
-    /* Apply deferred CRAM randomize */
-    if (cram_randomize_pending)
-    {
-        int i, j;
-        uint8 tmp;
-        for (i = 0; i < 0x80; i++)
-        {
-            j = rand() % 0x80;
-            tmp = cram[i];
-            cram[i] = cram[j];
-            cram[j] = tmp;
-        }
-        cram_randomize_pending = 0;
-        dirty = 1;
-    }
+    /* Held scroll effects last one frame, the rest keep rolling */
+    chaos_scroll_frame();
+    chaos_sprite_frame();
+    chaos_linepal_frame();
 
-    /* Apply deferred CRAM shift */
-    if (cram_shift_pending)
-    {
-        int i;
-        for (i = 0; i < 0x7F; i++)
-        {
-            cram[i] = cram[i + 1];
-        }
-        cram_shift_pending = 0;
-        dirty = 1;
-    }
+    /* Queued commands synced to this point */
+    chaos_queue_run(CHAOS_SYNC_VBLANK);
 
-    /* Persistent CRAM corruption */
-    if (cram_corruption_enabled)
-    {
-        int i;
-        for (i = 0; i < 8; i++)
-        {
-            int idx = rand() % 0x80;
-            cram[idx] = rand() % 256;
-        }
-        dirty = 1;
-    }
+    cram_corruption_frame();
 
-    if (dirty)
-    {
-        mark_all_cram_dirty();
-    }
+    /* Next slice of the effects spread over several frames */
+    sweeps_frame();
 
-    /* Apply deferred VSRAM corruption (after game's DMA has written scroll values) */
-    if (vsram_corrupt_pending)
-    {
-        int i;
-        int num_entries = 20; /* 20 column pairs */
-        for (i = 0; i < num_entries; i++)
-        {
-            int addr = i * 4;
-            int offset_a = (rand() % 33) - 16; /* -16 to +16 */
-            int offset_b = (rand() % 33) - 16;
-            int val_a = (vsram[addr] << 8) | vsram[addr + 1];
-            int val_b = (vsram[addr + 2] << 8) | vsram[addr + 3];
-            val_a = (val_a + offset_a) & 0x07FF;
-            val_b = (val_b + offset_b) & 0x07FF;
-            vsram[addr] = (val_a >> 8) & 0xFF;
-            vsram[addr + 1] = val_a & 0xFF;
-            vsram[addr + 2] = (val_b >> 8) & 0xFF;
-            vsram[addr + 3] = val_b & 0xFF;
-        }
-        vsram_corrupt_pending = 0;
-    }
+    /* Sticky glitch presets, over what the game and VBlank DMA wrote */
+    chaos_preset_frame();
 
-    /* Apply deferred H-scroll waviness (after game's DMA has written scroll table) */
-    if (hscroll_wave_pending)
-    {
-        int line;
-        int num_lines = 224;
-        /* Force per-line h-scroll mode so our per-line offsets take effect */
-        hscroll_mask = 0xFF;
-        for (line = 0; line < num_lines; line++)
-        {
-            int addr = hscb + (line * 4);
-            if (addr + 3 >= 0x10000)
-                break;
-            int offset = (rand() % 17) - 8; /* -8 to +8 */
-            int val_a = (vram[addr] << 8) | vram[addr + 1];
-            int val_b = (vram[addr + 2] << 8) | vram[addr + 3];
-            val_a = (val_a + offset) & 0x03FF;
-            val_b = (val_b + offset) & 0x03FF;
-            vram[addr] = (val_a >> 8) & 0xFF;
-            vram[addr + 1] = val_a & 0xFF;
-            vram[addr + 2] = (val_b >> 8) & 0xFF;
-            vram[addr + 3] = val_b & 0xFF;
-        }
-        mark_all_vram_dirty();
-        hscroll_wave_pending = 0;
-    }
+    /* Rewind raster events for the upcoming active display */
+    chaos_schedule_begin_frame();
+}
+
+void chaos_pre_render_hook_sms(void)
+{
+    chaos_vram_invalidate();
+    chaos_scroll_frame();
+    chaos_queue_run(CHAOS_SYNC_VBLANK);
+    sweeps_frame();
+    chaos_preset_frame();
+    chaos_schedule_begin_frame();
 }
 
 /* ======================================================================== */
 /* Per-frame update (persistent effects)                                    */
 /* ======================================================================== */
 
+/* Commands submitted by the front-end since the last frame, those fired by
+ * the key bindings and the modulators */
+static void frame_commands(void)
+{
+    chaos_vm_frame();
+    chaos_queue_begin_frame();
+    chaos_bind_frame();
+    chaos_mod_frame();
+    chaos_queue_run(CHAOS_SYNC_FRAME);
+}
+
+void chaos_per_frame_update_sms(void)
+{
+    if (!netplay_active())
+        chaos_ram_sample();
+    chaos_vram_invalidate();
+    chaos_vdplog_frame();
+    frame_commands();
+    cpu_clocks();
+}
+
 void chaos_per_frame_update(void)
 {
-    /* Persistent FM corruption: inject random frequency/volume corruption */
-    if (fm_corruption_enabled)
+    /* FM writes can be queued from line 0 again */
+    chaos_fm_begin_frame();
+
+    /* Next work RAM slice for the variable ranking, next Z80 RAM half for
+     * the sound driver structures (not during netplay, see netplay.h) */
+    if (!netplay_active())
+    {
+        chaos_ram_sample();
+        chaos_zdrv_sample();
+    }
+
+    /* Tables may have moved since the last frame */
+    chaos_vram_invalidate();
+
+    /* Mappers and state loads may have mapped the original ROM banks again */
+    chaos_rom_frame();
+    cheats_frame();
+
+    /* What the game wrote to the VDP last frame */
+    chaos_vdplog_frame();
+
+    /* Dead game: back to the checkpoint before this frame's effects */
+    chaos_watchdog_frame();
+
+    frame_commands();
+    cpu_clocks();
+
+#ifdef CHAOS_BUS_NOISE
+    /* Bus noise odds of this frame */
+    chaos_bus_frame();
+#endif
+
+    /* Persistent FM corruption: inject random frequency/volume corruption,
+     * spread over the frame's lines */
+    if (chaos_params[CHAOS_PARAM_FM_CORRUPTION] > 0.0f)
     {
-        int channel;
-        for (channel = 0; channel < 6; channel++)
+        double start = emscripten_get_now();
+        float level = chaos_params[CHAOS_PARAM_FM_CORRUPTION];
+        int channel, channels = scale(6, chaos_params[CHAOS_PARAM_FM_CHANNELS]);
+        for (channel = 0; channel < channels; channel++)
         {
             int bank = (channel < 3) ? 0 : 2;
             int ch_offset = channel % 3;
 
             /* Corrupt frequency registers (most noticeable) */
-            if (rand() % 3 == 0) /* 33% chance per channel per frame */
+            if (chance(CHAOS_RNG_AUDIO, chaos_params[CHAOS_PARAM_FM_FREQ] * level)) /* 33% chance per channel per frame */
             {
                 int freq_reg = 0xA0 + ch_offset;
-                int corrupted_val = rand() % 256;
-                YM2612Write(bank, freq_reg);
-                YM2612Write(bank + 1, corrupted_val);
+                int corrupted_val = chaos_rand_below(CHAOS_RNG_AUDIO, 256);
+                chaos_fm_write(chaos_fm_random_line(), bank, freq_reg, corrupted_val);
             }
 
             /* Corrupt volume registers occasionally */
-            if (rand() % 5 == 0) /* 20% chance */
+            if (chance(CHAOS_RNG_AUDIO, chaos_params[CHAOS_PARAM_FM_VOLUME] * level)) /* 20% chance */
             {
-                int op = rand() % 4;
+                int op = chaos_rand_below(CHAOS_RNG_AUDIO, 4);
                 int vol_reg = 0x40 + ch_offset + (op * 4);
-                YM2612Write(bank, vol_reg);
-                YM2612Write(bank + 1, rand() % 128);
+                chaos_fm_write(chaos_fm_random_line(), bank, vol_reg, chaos_rand_below(CHAOS_RNG_AUDIO, 128));
             }
 
             /* Corrupt envelope parameters occasionally */
-            if (rand() % 8 == 0) /* 12.5% chance */
+            if (chance(CHAOS_RNG_AUDIO, chaos_params[CHAOS_PARAM_FM_ENVELOPE] * level)) /* 12.5% chance */
             {
-                int op = rand() % 4;
-                int env_base = 0x50 + (rand() % 5) * 0x10; /* 0x50-0x90 range */
+                int op = chaos_rand_below(CHAOS_RNG_AUDIO, 4);
+                int env_base = 0x50 + chaos_rand_below(CHAOS_RNG_AUDIO, 5) * 0x10; /* 0x50-0x90 range */
                 int env_reg = env_base + ch_offset + (op * 4);
-                YM2612Write(bank, env_reg);
-                YM2612Write(bank + 1, rand() % 256);
+                chaos_fm_write(chaos_fm_random_line(), bank, env_reg, chaos_rand_below(CHAOS_RNG_AUDIO, 256));
             }
         }
 
         /* Occasionally corrupt algorithm/feedback */
-        if (rand() % 10 == 0)
+        if (chance(CHAOS_RNG_AUDIO, chaos_params[CHAOS_PARAM_FM_ALGORITHM] * level)) /* 10% chance */
         {
-            int ch = rand() % 6;
+            int ch = chaos_rand_below(CHAOS_RNG_AUDIO, 6);
             int bank = (ch < 3) ? 0 : 2;
             int ch_offset = ch % 3;
             int alg_reg = 0xB0 + ch_offset;
-            YM2612Write(bank, alg_reg);
-            YM2612Write(bank + 1, rand() % 256);
+            chaos_fm_write(chaos_fm_random_line(), bank, alg_reg, chaos_rand_below(CHAOS_RNG_AUDIO, 256));
+        }
+        chaos_account(CHAOS_FX_FM_CORRUPTION, start);
+    }
+}
+
+/* ======================================================================== */
+/* Kernel micro-benchmark                                                   */
+/* ======================================================================== */
+
+static uint8 bench_buffer[0x10000];
+static float bench_results[CHAOS_BENCH_KERNELS];
+
+float *chaos_bench_kernels(int iterations)
+{
+    int k, i;
+
+    if (iterations < 1)
+        iterations = 1;
+
+    for (k = 0; k < CHAOS_BENCH_KERNELS; k++)
+    {
+        double start = emscripten_get_now();
+        for (i = 0; i < iterations; i++)
+        {
+            switch (k)
+            {
+            case 0:
+                chaos_kernel_shift(bench_buffer, sizeof(bench_buffer), (i & 1) ? 1 : -1, 0);
+                break;
+            case 1:
+                chaos_kernel_shift_blocks(bench_buffer, sizeof(bench_buffer), 256, (i & 1) ? 1 : -1);
+                break;
+            case 2:
+                chaos_kernel_rotate(bench_buffer, sizeof(bench_buffer), 4);
+                break;
+            case 3:
+                chaos_kernel_xor(bench_buffer, sizeof(bench_buffer), 0xFF);
+                break;
+            case 4:
+                chaos_kernel_nibble_swap(bench_buffer, sizeof(bench_buffer));
+                break;
+            }
         }
+
+        /* emscripten_get_now() is in milliseconds, report ns per KB */
+        bench_results[k] = (float)((emscripten_get_now() - start) * 1e6 / iterations / (sizeof(bench_buffer) >> 10));
     }
+
+    return bench_results;
 }
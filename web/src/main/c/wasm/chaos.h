@@ -11,16 +11,27 @@ void EMSCRIPTEN_KEEPALIVE chaos_shift_vram_right(void);
 void EMSCRIPTEN_KEEPALIVE chaos_shift_vram_down_random(void);
 void EMSCRIPTEN_KEEPALIVE chaos_corrupt_vram_one_byte(void);
 void EMSCRIPTEN_KEEPALIVE chaos_invert_vram_contents(void);
+void EMSCRIPTEN_KEEPALIVE chaos_rotate_vram(void);
+void EMSCRIPTEN_KEEPALIVE chaos_xor_vram(void);
+void EMSCRIPTEN_KEEPALIVE chaos_nibble_swap_vram(void);
 
 /* CRAM/Color manipulation */
 void EMSCRIPTEN_KEEPALIVE chaos_randomize_cram(void);
 void EMSCRIPTEN_KEEPALIVE chaos_shift_cram_up(void);
 void EMSCRIPTEN_KEEPALIVE chaos_enable_cram_corruption(void);
 void EMSCRIPTEN_KEEPALIVE chaos_disable_cram_corruption(void);
+void EMSCRIPTEN_KEEPALIVE chaos_restore_palette(void);
+/* Raster colors in the renderer only (chaos_linepal.h): rolling backdrop
+ * bars, and colors swapped over a few lines for one frame */
+void EMSCRIPTEN_KEEPALIVE chaos_copper_bars(void);
+void EMSCRIPTEN_KEEPALIVE chaos_raster_palette_glitch(void);
 
 /* Sprite/Scroll manipulation */
 void EMSCRIPTEN_KEEPALIVE chaos_scroll_register_fuzzing(void);
 void EMSCRIPTEN_KEEPALIVE chaos_sprite_attribute_scramble(void);
+/* Moves and resizes a few sprites on screen for one frame, in the renderer
+ * only (chaos_sprite.h): the game's sprite table is left alone */
+void EMSCRIPTEN_KEEPALIVE chaos_jitter_sprites(void);
 
 /* Audio controls */
 void EMSCRIPTEN_KEEPALIVE chaos_enable_fm_corruption(void);
@@ -44,13 +55,217 @@ void EMSCRIPTEN_KEEPALIVE chaos_hscroll_waviness(void);
 void EMSCRIPTEN_KEEPALIVE chaos_flip_vdp_mode(void);
 void EMSCRIPTEN_KEEPALIVE chaos_psg_noise_blast(void);
 
+/* Scroll offsets (chaos_scroll.h) */
+void EMSCRIPTEN_KEEPALIVE chaos_scroll_wave(void);
+void EMSCRIPTEN_KEEPALIVE chaos_scroll_melt(void);
+void EMSCRIPTEN_KEEPALIVE chaos_scroll_shear(void);
+
+/* Layer glitches (render_layers()) */
+void EMSCRIPTEN_KEEPALIVE chaos_hide_plane_a(void);
+void EMSCRIPTEN_KEEPALIVE chaos_hide_plane_b(void);
+void EMSCRIPTEN_KEEPALIVE chaos_hide_sprites(void);
+void EMSCRIPTEN_KEEPALIVE chaos_sprites_behind(void);
+void EMSCRIPTEN_KEEPALIVE chaos_swap_planes(void);
+void EMSCRIPTEN_KEEPALIVE chaos_flip_priority(void);
+void EMSCRIPTEN_KEEPALIVE chaos_window_everywhere(void);
+
+/* Pattern cache glitches (render_patterns()) */
+void EMSCRIPTEN_KEEPALIVE chaos_xor_patterns(void);
+void EMSCRIPTEN_KEEPALIVE chaos_roll_patterns(void);
+
+/* Cartridge ROM (chaos_rom.h) */
+void EMSCRIPTEN_KEEPALIVE chaos_corrupt_rom(void);
+void EMSCRIPTEN_KEEPALIVE chaos_restore_rom(void);
+/* Random Game Genie / Action Replay style code sets (chaos_cheat.h): a new
+ * one made active, or all of them in turn, one per frame */
+void EMSCRIPTEN_KEEPALIVE chaos_random_cheats(void);
+void EMSCRIPTEN_KEEPALIVE chaos_cycle_cheats(void);
+
+/* DMA glitches (vdp_dma_glitch()): the game's transfers read from the wrong
+ * place, land in the wrong place or stop short while active */
+void EMSCRIPTEN_KEEPALIVE chaos_dma_wrong_source(void);
+void EMSCRIPTEN_KEEPALIVE chaos_dma_wrong_dest(void);
+void EMSCRIPTEN_KEEPALIVE chaos_dma_truncate(void);
+
+/* Presentation effects: set the level of a CHAOS_PARAM_POST_* parameter,
+ * the WebGL presenter draws them (the emulated machine is left alone) */
+void EMSCRIPTEN_KEEPALIVE chaos_post_rgb_split(void);
+void EMSCRIPTEN_KEEPALIVE chaos_post_trails(void);
+void EMSCRIPTEN_KEEPALIVE chaos_post_block_smear(void);
+void EMSCRIPTEN_KEEPALIVE chaos_post_scanline_jitter(void);
+
+/* Audio output effects: set the level of a CHAOS_PARAM_AUDIO_* parameter,
+ * the AudioWorklet applies them to the output stream (the sound chips are
+ * left alone) */
+void EMSCRIPTEN_KEEPALIVE chaos_audio_stutter(void);
+void EMSCRIPTEN_KEEPALIVE chaos_audio_reverse(void);
+void EMSCRIPTEN_KEEPALIVE chaos_audio_decimate(void);
+
+/* CPU clocks: set CHAOS_PARAM_M68K_CLOCK up to 4x the console's clock (no
+ * slowdown) and CHAOS_PARAM_Z80_CLOCK down to 1/4 of it (dragging sound
+ * drivers); the VDP and sound chips keep their timing */
+void EMSCRIPTEN_KEEPALIVE chaos_cpu_overclock(void);
+void EMSCRIPTEN_KEEPALIVE chaos_z80_underclock(void);
+
+/* Write protection (chaos_freeze.h): the game's writes to the tiles on
+ * screen, to CRAM, or to VSRAM and the H-scroll table are dropped until the
+ * effect is turned off, so earlier corruption stays */
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_tiles(void);
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_palette(void);
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_scroll(void);
+
+/* ======================================================================== */
+/* Effect registry                                                          */
+/* ======================================================================== */
+
+/* Effect ids (index in the registry table) */
+enum
+{
+    CHAOS_FX_SHIFT_VRAM_UP = 0,
+    CHAOS_FX_SHIFT_VRAM_DOWN,
+    CHAOS_FX_SHIFT_VRAM_LEFT,
+    CHAOS_FX_SHIFT_VRAM_RIGHT,
+    CHAOS_FX_SHIFT_VRAM_DOWN_RANDOM,
+    CHAOS_FX_CORRUPT_VRAM_ONE_BYTE,
+    CHAOS_FX_INVERT_VRAM,
+    CHAOS_FX_ROTATE_VRAM,
+    CHAOS_FX_XOR_VRAM,
+    CHAOS_FX_NIBBLE_SWAP_VRAM,
+    CHAOS_FX_RANDOMIZE_CRAM,
+    CHAOS_FX_SHIFT_CRAM_UP,
+    CHAOS_FX_CRAM_CORRUPTION,
+    CHAOS_FX_CORRUPT_VSRAM,
+    CHAOS_FX_HSCROLL_WAVINESS,
+    CHAOS_FX_FLIP_VDP_MODE,
+    CHAOS_FX_SCROLL_REGISTER_FUZZING,
+    CHAOS_FX_SPRITE_ATTRIBUTE_SCRAMBLE,
+    CHAOS_FX_FM_CORRUPTION,
+    CHAOS_FX_CORRUPT_DAC_DATA,
+    CHAOS_FX_BITCRUSH_AUDIO_MEMORY,
+    CHAOS_FX_DETUNE_FM_REGISTERS,
+    CHAOS_FX_PSG_NOISE_BLAST,
+    CHAOS_FX_SHIFT_AUDIO_MEMORY_UP,
+    CHAOS_FX_SHIFT_AUDIO_MEMORY_DOWN,
+    CHAOS_FX_CORRUPT_68K_RAM_ONE_BYTE,
+    CHAOS_FX_CRITICAL_RAM_SCRAMBLE,
+    CHAOS_FX_PROGRAM_COUNTER_INCREMENT,
+    CHAOS_FX_RANDOM_REGISTER_CORRUPTION,
+    CHAOS_FX_FLIP_GAME_LOGIC_VARIABLES,
+    CHAOS_FX_SCROLL_WAVE,
+    CHAOS_FX_SCROLL_MELT,
+    CHAOS_FX_SCROLL_SHEAR,
+    CHAOS_FX_RESTORE_PALETTE,
+    CHAOS_FX_HIDE_PLANE_A,
+    CHAOS_FX_HIDE_PLANE_B,
+    CHAOS_FX_HIDE_SPRITES,
+    CHAOS_FX_SPRITES_BEHIND,
+    CHAOS_FX_SWAP_PLANES,
+    CHAOS_FX_FLIP_PRIORITY,
+    CHAOS_FX_WINDOW_EVERYWHERE,
+    CHAOS_FX_XOR_PATTERNS,
+    CHAOS_FX_ROLL_PATTERNS,
+    CHAOS_FX_CORRUPT_ROM,
+    CHAOS_FX_RESTORE_ROM,
+    CHAOS_FX_POST_RGB_SPLIT,
+    CHAOS_FX_POST_TRAILS,
+    CHAOS_FX_POST_BLOCK_SMEAR,
+    CHAOS_FX_POST_SCANLINE_JITTER,
+    CHAOS_FX_AUDIO_STUTTER,
+    CHAOS_FX_AUDIO_REVERSE,
+    CHAOS_FX_AUDIO_DECIMATE,
+    CHAOS_FX_CPU_OVERCLOCK,
+    CHAOS_FX_Z80_UNDERCLOCK,
+    CHAOS_FX_FREEZE_TILES,
+    CHAOS_FX_FREEZE_PALETTE,
+    CHAOS_FX_FREEZE_SCROLL,
+    CHAOS_FX_JITTER_SPRITES,
+    CHAOS_FX_COPPER_BARS,
+    CHAOS_FX_RASTER_PALETTE_GLITCH,
+    CHAOS_FX_RANDOM_CHEATS,
+    CHAOS_FX_CYCLE_CHEATS,
+    CHAOS_FX_DMA_WRONG_SOURCE,
+    CHAOS_FX_DMA_WRONG_DEST,
+    CHAOS_FX_DMA_TRUNCATE,
+    CHAOS_FX_COUNT
+};
+
+/* Ids from CHAOS_FX_USER on: user programs (chaos_vm.h), one-shot effects
+ * outside the registry tables */
+#define CHAOS_FX_USER CHAOS_FX_COUNT
+
+/* Effect kinds */
+#define CHAOS_KIND_ONESHOT    0 /* applied once per trigger */
+#define CHAOS_KIND_HELD       1 /* applied every frame while triggered */
+#define CHAOS_KIND_PERSISTENT 2 /* toggled on (intensity > 0) or off */
+
+/* Memory targeted by an effect (bitmask) */
+#define CHAOS_TARGET_VRAM     0x0001
+#define CHAOS_TARGET_CRAM     0x0002
+#define CHAOS_TARGET_VSRAM    0x0004
+#define CHAOS_TARGET_VDP_REGS 0x0008
+#define CHAOS_TARGET_WORK_RAM 0x0010
+#define CHAOS_TARGET_ZRAM     0x0020
+#define CHAOS_TARGET_FM       0x0040
+#define CHAOS_TARGET_PSG      0x0080
+#define CHAOS_TARGET_CPU      0x0100
+#define CHAOS_TARGET_ROM      0x0200
+#define CHAOS_TARGET_POST     0x0400 /* presentation only */
+#define CHAOS_TARGET_OUTPUT   0x0800 /* audio output only */
+
+typedef struct
+{
+    const char *name;
+    unsigned char kind;
+    unsigned short targets;
+    void (*apply)(void);
+    void (*release)(void); /* persistent effects only */
+} chaos_effect_t;
+
+int EMSCRIPTEN_KEEPALIVE chaos_effect_count(void);
+const char* EMSCRIPTEN_KEEPALIVE chaos_effect_name(int id);
+int EMSCRIPTEN_KEEPALIVE chaos_effect_kind(int id);
+int EMSCRIPTEN_KEEPALIVE chaos_effect_targets(int id);
+
+/* Apply effect 'id'; returns 0 if the id is unknown. 'intensity' is the
+ * strength in 0..1 (1: the full effect, lower values scale its amount of
+ * corruption down; effects without a natural amount ignore it), or <= 0 to
+ * release a persistent effect */
+int EMSCRIPTEN_KEEPALIVE chaos_apply(int id, float intensity);
+
+/* Spread a bulk VRAM effect (shifts, invert, xor, nibble swap) over 'frames'
+ * frames, one slice of VRAM per frame (1: all at once, the default); a
+ * trigger while the effect is still sweeping is dropped. Returns 0 if the
+ * effect cannot be spread */
+int EMSCRIPTEN_KEEPALIVE chaos_set_spread(int id, int frames);
+
+/* Per-effect statistics: CHAOS_FX_COUNT pairs of (calls, accumulated usec) */
+float* EMSCRIPTEN_KEEPALIVE chaos_stats(void);
+void EMSCRIPTEN_KEEPALIVE chaos_stats_reset(void);
+
 /* Reset all chaos state */
 void EMSCRIPTEN_KEEPALIVE chaos_reset(void);
 
+/* The chaos state a frame hands over to the next one (RNG streams, running
+ * sweeps, parameter bases), saved and restored with the machine by netplay
+ * rollbacks; both return the size, at most CHAOS_CONTEXT_MAX bytes */
+#define CHAOS_CONTEXT_MAX 4096
+int chaos_context_save(uint8_t *state);
+int chaos_context_load(const uint8_t *state);
+
+/* Bulk kernel micro-benchmark: returns ns per KB for shift, block shift,
+ * rotate, xor and nibble swap (in that order) */
+#define CHAOS_BENCH_KERNELS 5
+float* EMSCRIPTEN_KEEPALIVE chaos_bench_kernels(int iterations);
+
 /* Pre-render hook (called after VBlank DMA, before Active Display) */
 void chaos_pre_render_hook(void);
 
 /* Per-frame update (called from tick) */
 void chaos_per_frame_update(void);
 
+/* Master System / Game Gear versions, from system_frame_sms() and tick:
+ * no YM2612 to corrupt and no Mode 5 palette to add noise to */
+void chaos_pre_render_hook_sms(void);
+void chaos_per_frame_update_sms(void);
+
 #endif /* _CHAOS_H_ */
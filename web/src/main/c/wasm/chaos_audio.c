@@ -0,0 +1,191 @@
+/**
+ * ChaosDrive - audio analysis
+ *
+ * The last CHAOS_AUDIO_WINDOW output samples (mono) are kept in a ring.
+ * Once per frame they are Hann windowed and run through a real FFT: the
+ * even/odd samples are packed as one half size complex sequence, and the
+ * spectrum of the real signal is split out of its FFT. Bin powers are then
+ * summed into log-spaced bands. The tables are built on first use and
+ * nothing is allocated; the whole update is a few microseconds.
+ */
+
+#include "shared.h"
+#include "chaos_audio.h"
+
+#define WINDOW CHAOS_AUDIO_WINDOW
+#define HALF (CHAOS_AUDIO_WINDOW / 2)
+
+/* band edges in FFT bins (~86 Hz per bin at 44.1 kHz), up to the Nyquist bin */
+static const uint16 band_edges[CHAOS_AUDIO_BANDS + 1] =
+{
+    1, 2, 3, 4, 5, 7, 9, 12, 16, 22, 30, 41, 56, 77, 106, 146, HALF
+};
+
+/* onset: band above ONSET_RATIO times its running average, plus a floor for silence */
+#define ONSET_RATIO 1.5f
+#define ONSET_FLOOR 0.01f
+#define AVERAGE_RATE 0.125f
+
+chaos_audio_t chaos_audio;
+
+static float ring[WINDOW];
+static int ring_pos;
+
+static float average[CHAOS_AUDIO_BANDS];
+
+/* Hann window, e^(-2*pi*i*k/WINDOW) and HALF point bit reversal */
+static float hann[WINDOW];
+static float twiddle_re[HALF];
+static float twiddle_im[HALF];
+static uint16 bit_reverse[HALF];
+static int tables_ready;
+
+static float fft_re[HALF];
+static float fft_im[HALF];
+
+static void init_tables(void)
+{
+    int i;
+
+    for (i = 0; i < WINDOW; i++)
+    {
+        hann[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * i / WINDOW));
+    }
+
+    for (i = 0; i < HALF; i++)
+    {
+        int bit, r = 0;
+
+        twiddle_re[i] = (float)cos(2.0 * M_PI * i / WINDOW);
+        twiddle_im[i] = (float)-sin(2.0 * M_PI * i / WINDOW);
+
+        for (bit = 1; bit < HALF; bit <<= 1)
+        {
+            r = (r << 1) | ((i & bit) ? 1 : 0);
+        }
+        bit_reverse[i] = r;
+    }
+
+    tables_ready = 1;
+}
+
+/* in-place radix-2 FFT of fft_re/fft_im (input in bit reversed order) */
+static void fft_half(void)
+{
+    int size, i, k;
+
+    for (size = 2; size <= HALF; size <<= 1)
+    {
+        int half = size >> 1;
+        int stride = WINDOW / size;
+
+        for (i = 0; i < HALF; i += size)
+        {
+            for (k = 0; k < half; k++)
+            {
+                int a = i + k;
+                int b = a + half;
+                float wr = twiddle_re[k * stride];
+                float wi = twiddle_im[k * stride];
+                float tr = fft_re[b] * wr - fft_im[b] * wi;
+                float ti = fft_re[b] * wi + fft_im[b] * wr;
+
+                fft_re[b] = fft_re[a] - tr;
+                fft_im[b] = fft_im[a] - ti;
+                fft_re[a] += tr;
+                fft_im[a] += ti;
+            }
+        }
+    }
+}
+
+static void analyse_window(void)
+{
+    int i, band;
+    uint32 onset = 0;
+
+    /* oldest sample first: x[2i] + j x[2i+1], windowed */
+    for (i = 0; i < HALF; i++)
+    {
+        int n = (ring_pos + 2 * i) & (WINDOW - 1);
+        fft_re[bit_reverse[i]] = ring[n] * hann[2 * i];
+        fft_im[bit_reverse[i]] = ring[(n + 1) & (WINDOW - 1)] * hann[2 * i + 1];
+    }
+
+    fft_half();
+
+    for (band = 0; band < CHAOS_AUDIO_BANDS; band++)
+    {
+        float power = 0.0f;
+        float magnitude;
+
+        for (i = band_edges[band]; i < band_edges[band + 1]; i++)
+        {
+            /* even/odd sample spectra from Z[i] and conj(Z[HALF - i]) */
+            float even_re = (fft_re[i] + fft_re[HALF - i]) * 0.5f;
+            float even_im = (fft_im[i] - fft_im[HALF - i]) * 0.5f;
+            float odd_re = (fft_im[i] + fft_im[HALF - i]) * 0.5f;
+            float odd_im = (fft_re[HALF - i] - fft_re[i]) * 0.5f;
+
+            /* X[i] = E[i] + e^(-2*pi*j*i/WINDOW) O[i] */
+            float re = even_re + twiddle_re[i] * odd_re - twiddle_im[i] * odd_im;
+            float im = even_im + twiddle_re[i] * odd_im + twiddle_im[i] * odd_re;
+
+            power += re * re + im * im;
+        }
+
+        /* a Hann windowed sine of amplitude A peaks at A * WINDOW / 4 */
+        magnitude = sqrtf(power) * (4.0f / WINDOW);
+
+        if (magnitude > average[band] * ONSET_RATIO + ONSET_FLOOR)
+            onset |= 1 << band;
+        average[band] += (magnitude - average[band]) * AVERAGE_RATE;
+
+        chaos_audio.bands[band] = magnitude;
+    }
+
+    chaos_audio.onset = onset;
+}
+
+void chaos_audio_update(const float *l, const float *r, int count)
+{
+    float energy = 0.0f;
+    int i;
+
+    if (!tables_ready)
+        init_tables();
+
+    for (i = 0; i < count; i++)
+    {
+        energy += l[i] * l[i] + r[i] * r[i];
+
+        /* only the last WINDOW samples end up in the ring */
+        if (i >= count - WINDOW)
+        {
+            ring[ring_pos] = (l[i] + r[i]) * 0.5f;
+            ring_pos = (ring_pos + 1) & (WINDOW - 1);
+        }
+    }
+
+    chaos_audio.rms = count ? sqrtf(energy / (2 * count)) : 0.0f;
+    chaos_audio.rms_fm = sound_meter.fm / 32768.0f;
+    chaos_audio.rms_psg = sound_meter.psg / 32768.0f;
+    chaos_audio.rms_dac = sound_meter.dac / 32768.0f;
+    chaos_audio.key_on = sound_meter.key_on;
+
+    analyse_window();
+    chaos_audio.frame++;
+}
+
+void chaos_audio_reset(void)
+{
+    memset(&chaos_audio, 0, sizeof(chaos_audio));
+    memset(ring, 0, sizeof(ring));
+    memset(average, 0, sizeof(average));
+    ring_pos = 0;
+}
+
+chaos_audio_t *chaos_audio_ref(void)
+{
+    return &chaos_audio;
+}
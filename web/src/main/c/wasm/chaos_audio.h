@@ -0,0 +1,46 @@
+#ifndef _CHAOS_AUDIO_H_
+#define _CHAOS_AUDIO_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Audio analysis for audio-reactive chaos.
+ *
+ * Updated once per emulated frame from the samples audio_update() just
+ * produced, so effects and the front-end read a few numbers instead of
+ * scanning sample buffers: per-chip levels (from the core sound meter), a
+ * CHAOS_AUDIO_BANDS band spectrum of the last CHAOS_AUDIO_WINDOW output
+ * samples, per-band onsets and YM2612 key on events.
+ *
+ * Levels and band magnitudes are in [-1, 1) output units (a full scale sine
+ * is about 0.7 RMS, and its magnitude in a band about 1).
+ */
+
+#define CHAOS_AUDIO_WINDOW 512 /* FFT size, must be a power of 2 */
+#define CHAOS_AUDIO_BANDS 16
+
+/* 32-bit fields only, JS reads it through Uint32Array/Float32Array views */
+typedef struct
+{
+    uint32_t frame;                     /* frames analysed */
+    uint32_t key_on;                    /* YM2612 channels keyed on (bit n = channel n+1) */
+    uint32_t onset;                     /* bands well above their recent average (bit n = band n) */
+    float rms;                          /* mixed output of the frame */
+    float rms_fm;                       /* YM2612 (including DAC) or YM2413 */
+    float rms_psg;
+    float rms_dac;                      /* YM2612 DAC samples written */
+    float bands[CHAOS_AUDIO_BANDS];     /* low to high, log spaced from ~86 Hz at 44.1 kHz */
+} chaos_audio_t;
+
+extern chaos_audio_t chaos_audio;
+
+/* Analyse the samples of the last frame */
+void chaos_audio_update(const float *l, const float *r, int count);
+
+/* Clear the window and running averages (new ROM loaded) */
+void chaos_audio_reset(void);
+
+/* chaos_audio, for the front-end */
+chaos_audio_t* EMSCRIPTEN_KEEPALIVE chaos_audio_ref(void);
+
+#endif /* _CHAOS_AUDIO_H_ */
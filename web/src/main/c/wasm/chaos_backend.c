@@ -0,0 +1,5 @@
+/**
+ * ChaosDrive - shared chaos effects, built against chaos_backend.h
+ */
+
+#include "chaos_core.c"
@@ -0,0 +1,108 @@
+#ifndef _CHAOS_BACKEND_H_
+#define _CHAOS_BACKEND_H_
+
+#include "shared.h"
+#include "chaos_core.h"
+#include "chaos_dirty.h"
+#include "chaos_ram.h"
+#include "chaos_rand.h"
+#include "chaos_undo.h"
+#include "chaos_vdplog.h"
+
+/* Genesis Plus GX accessors for the shared chaos effects (chaos_core.h).
+ *
+ * Everything is global here, the effects are called with a NULL context.
+ */
+
+static const int chaos_be_streams[] = {CHAOS_RNG_VRAM, CHAOS_RNG_VDP, CHAOS_RNG_CPU};
+
+INLINE int chaos_be_rand_below(void *ctx, enum chaos_stream s, int n)
+{
+    return chaos_rand_below(chaos_be_streams[s], n);
+}
+
+INLINE uint32_t chaos_be_rand32(void *ctx, enum chaos_stream s)
+{
+    return chaos_rand(chaos_be_streams[s]);
+}
+
+/* work_ram[] indices, as chaos_ram.c ranks them */
+INLINE uint8_t chaos_be_ram_read(void *ctx, uint32_t offset)
+{
+    return work_ram[offset & 0xFFFF];
+}
+
+INLINE void chaos_be_ram_write(void *ctx, uint32_t offset, uint8_t val)
+{
+    chaos_undo_save(CHAOS_UNDO_WORK_RAM, offset & 0xFFFF, 1);
+    work_ram[offset & 0xFFFF] = val;
+}
+
+INLINE int chaos_be_ram_ranked(void *ctx)
+{
+    return chaos_ram_candidate_count();
+}
+
+INLINE uint32_t chaos_be_ram_candidate(void *ctx, int i)
+{
+    return chaos_ram_candidates()[i] & 0xFFFF;
+}
+
+/* VRAM is written directly, chaos_be_vram_done() then refreshes the
+   pattern cache and the internal SAT copy */
+INLINE uint8_t chaos_be_vram_read(void *ctx, uint32_t addr)
+{
+    return vram[addr & 0xFFFF];
+}
+
+INLINE void chaos_be_vram_write(void *ctx, uint32_t addr, uint8_t val)
+{
+    chaos_undo_save(CHAOS_UNDO_VRAM, addr & 0xFFFF, 1);
+    vram[addr & 0xFFFF] = val;
+}
+
+INLINE void chaos_be_vram_done(void *ctx, uint32_t addr, uint32_t len)
+{
+    chaos_dirty_vram(addr, len);
+}
+
+/* Sprites the game moved or changed during the last second, or those the
+   renderer found in the link chain of a static SAT */
+INLINE int chaos_be_sprites(void *ctx, int *list)
+{
+    int count = chaos_vdplog_sprites(60, list);
+
+    return count ? count : render_obj_chain(list);
+}
+
+/* reg[] only, without the side effects of vdp_reg_w() */
+INLINE uint8_t chaos_be_vdp_reg_read(void *ctx, int r)
+{
+    return reg[r];
+}
+
+INLINE void chaos_be_vdp_reg_write(void *ctx, int r, uint8_t val)
+{
+    chaos_undo_save(CHAOS_UNDO_VDP_REGS, r, 1);
+    reg[r] = val;
+    if (r == 5)
+        satb = (reg[5] << 9) & 0xFE00;
+}
+
+/* CHAOS_CPU_* is the M68K_REG_* order */
+INLINE uint32_t chaos_be_cpu_reg_read(void *ctx, int r)
+{
+    return m68k_get_reg((m68k_register_t)(M68K_REG_D0 + r));
+}
+
+INLINE void chaos_be_cpu_reg_write(void *ctx, int r, uint32_t val)
+{
+    chaos_undo_save(CHAOS_UNDO_CPU_REGS, r, 1);
+    m68k_set_reg((m68k_register_t)(M68K_REG_D0 + r), val);
+}
+
+/* Not logged */
+#define CHAOS_BE_LOG(ctx, id, addr, old_val, new_val) \
+    ((void)(ctx), (void)(addr), (void)(old_val), (void)(new_val))
+
+#endif /* _CHAOS_BACKEND_H_ */
@@ -0,0 +1,140 @@
+/**
+ * ChaosDrive - chaos key bindings
+ *
+ * One pass over the table per frame: a binding fires on the press edge of
+ * its key slot, then (hold mode) again each time its repeat countdown runs
+ * out while the key stays down.
+ */
+
+#include <string.h>
+#include "chaos.h"
+#include "chaos_bind.h"
+#include "chaos_queue.h"
+#include "chaos_record.h"
+#include "chaos_vm.h"
+#include "netplay.h"
+
+#define TARGET_VIDEO (CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM | CHAOS_TARGET_VDP_REGS)
+
+static chaos_binding_t table[CHAOS_BIND_MAX];
+static int count;
+
+/* per binding: frames to the next repeat, toggle state */
+static uint8_t countdown[CHAOS_BIND_MAX];
+static uint8_t toggled[CHAOS_BIND_MAX];
+
+/* key slots down last frame */
+static uint32_t prev_keys[2];
+
+static int fired = -1;
+
+chaos_binding_t *chaos_bind_table(void)
+{
+    return table;
+}
+
+int chaos_bind_commit(int n)
+{
+    int i;
+
+    if (n < 0)
+        n = 0;
+    if (n > CHAOS_BIND_MAX)
+        n = CHAOS_BIND_MAX;
+
+    count = 0;
+    for (i = 0; i < n; i++)
+    {
+        /* entries with an unknown effect or key slot are dropped */
+        if ((table[i].effect >= CHAOS_FX_USER + CHAOS_VM_PROGRAMS) || (table[i].slot >= CHAOS_BIND_MAX))
+            continue;
+
+        table[count++] = table[i];
+    }
+    chaos_bind_reset();
+    return count;
+}
+
+int chaos_bind_take_fired(void)
+{
+    int index = fired;
+    fired = -1;
+    return index;
+}
+
+void chaos_bind_reset(void)
+{
+    memset(countdown, 0, sizeof(countdown));
+    memset(toggled, 0, sizeof(toggled));
+}
+
+static void fire(int index, float intensity)
+{
+    chaos_cmd_t cmd;
+
+    /* sync point of the effect (a user program may be loaded after the table) */
+    cmd.op = table[index].effect;
+    cmd.sync = (chaos_effect_targets(cmd.op) & TARGET_VIDEO) ? CHAOS_SYNC_VBLANK : CHAOS_SYNC_FRAME;
+    cmd.line = 0;
+    cmd.intensity = intensity;
+    chaos_queue_push(&cmd, 1);
+    fired = index;
+}
+
+void chaos_bind_frame(void)
+{
+    uint32_t keys[2];
+    int i;
+
+    if (!count)
+        return;
+
+    keys[0] = EM_ASM_INT({ var keys = Module['chaosKeys']; return keys ? Atomics.load(keys, 0) : 0; });
+    keys[1] = EM_ASM_INT({ var keys = Module['chaosKeys']; return keys ? Atomics.load(keys, 1) : 0; });
+
+    /* the replayed stream has the commands the bindings fired; netplay sends the bound
+       keys' effects as commands of the frame (netplay.js) */
+    if ((chaos_record_mode() != CHAOS_RECORD_REPLAY) && !netplay_active())
+    {
+        for (i = 0; i < count; i++)
+        {
+            const chaos_binding_t *binding = &table[i];
+            uint32_t bit = 1u << (binding->slot & 31);
+            int word = binding->slot >> 5;
+
+            if (!(keys[word] & bit))
+                continue;
+
+            if (!(prev_keys[word] & bit))
+            {
+                /* press */
+                if (binding->mode == CHAOS_BIND_TOGGLE)
+                {
+                    toggled[i] ^= 1;
+                    fire(i, toggled[i] ? binding->intensity : 0.0f);
+                }
+                else
+                {
+                    countdown[i] = binding->repeat;
+                    fire(i, binding->intensity);
+                }
+            }
+            else if (binding->mode == CHAOS_BIND_HOLD)
+            {
+                /* held: rate limited repeats */
+                if (countdown[i] > 1)
+                {
+                    countdown[i]--;
+                }
+                else
+                {
+                    countdown[i] = binding->repeat;
+                    fire(i, binding->intensity);
+                }
+            }
+        }
+    }
+
+    prev_keys[0] = keys[0];
+    prev_keys[1] = keys[1];
+}
@@ -0,0 +1,53 @@
+#ifndef _CHAOS_BIND_H_
+#define _CHAOS_BIND_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos key bindings.
+ *
+ * The front-end uploads its bindings once as a table and keeps the state of
+ * the bound keys (and gamepad buttons) in a shared bitfield, one bit per key
+ * slot (Module.chaosKeys, two Int32 words, see input.js). The core reads the
+ * bitfield at the start of each frame and evaluates the table against it, so
+ * a held key costs nothing on the JS side and its repeats are rate limited
+ * here instead of firing on every frame.
+ *
+ * Effects fired by a binding go through the command queue like submitted
+ * ones (same sync points, recorded in sessions). Bindings are not evaluated
+ * while a session is replayed: the recorded commands stand in for them.
+ */
+
+#define CHAOS_BIND_MAX  64 /* bindings, also the number of key slots */
+
+/* Trigger modes */
+#define CHAOS_BIND_PRESS  0 /* once per press */
+#define CHAOS_BIND_HOLD   1 /* on the press, then every 'repeat' frames while held */
+#define CHAOS_BIND_TOGGLE 2 /* each press alternates 'intensity' and 0 (persistent effects) */
+
+typedef struct
+{
+    uint8_t slot;    /* key slot, bit in the bitfield */
+    uint8_t effect;  /* chaos registry id */
+    uint8_t mode;
+    uint8_t repeat;  /* CHAOS_BIND_HOLD: frames between two repeats (0: every frame) */
+    float intensity;
+} chaos_binding_t;
+
+/* Table for the front-end to fill, then chaos_bind_commit() with the
+ * number of entries written (the previous table is dropped) */
+chaos_binding_t* EMSCRIPTEN_KEEPALIVE chaos_bind_table(void);
+int EMSCRIPTEN_KEEPALIVE chaos_bind_commit(int count);
+
+/* Index of the last binding fired since the previous call, -1 if none
+ * (front-end messages) */
+int EMSCRIPTEN_KEEPALIVE chaos_bind_take_fired(void);
+
+/* Evaluate the table against the keys of this frame (frame start, after
+ * chaos_queue_begin_frame()) */
+void chaos_bind_frame(void);
+
+/* Forget toggles and held keys (chaos_reset()) */
+void chaos_bind_reset(void);
+
+#endif /* _CHAOS_BIND_H_ */
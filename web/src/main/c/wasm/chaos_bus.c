@@ -0,0 +1,130 @@
+/**
+ * ChaosDrive - bus noise
+ *
+ * See chaos_bus.h. The countdowns are geometric, the number of reads before
+ * the first fault of a Bernoulli process with the region's odds per read:
+ * drawing one per fault gives the same faults as drawing for every read,
+ * and as the distribution is memoryless a countdown can be drawn again
+ * whenever the odds change without biasing the faults.
+ */
+
+#include "shared.h"
+#include "chaos_bus.h"
+#include "chaos_mod.h"
+#include "chaos_rand.h"
+
+#ifdef CHAOS_BUS_NOISE
+
+uint8_t chaos_bus_region[256];
+int32_t chaos_bus_count[CHAOS_BUS_REGIONS] = { INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX, INT32_MAX };
+
+static float armed[CHAOS_BUS_REGIONS]; /* level each countdown was drawn for */
+static int mapped;
+
+static void map_regions(void)
+{
+    int i;
+
+    for (i = 0; i < 256; i++)
+    {
+        if (i < 0x40)
+            chaos_bus_region[i] = CHAOS_BUS_ROM;
+        else if (i == 0xa0)
+            chaos_bus_region[i] = CHAOS_BUS_ZRAM;
+        else if ((i >= 0xc0) && (i < 0xe0))
+            chaos_bus_region[i] = CHAOS_BUS_VDP;
+        else if (i >= 0xe0)
+            chaos_bus_region[i] = CHAOS_BUS_RAM;
+        else
+            chaos_bus_region[i] = CHAOS_BUS_NONE;
+    }
+    mapped = 1;
+}
+
+/* Reads before the next fault at 'level': odds of 2^-shift per read */
+static int32_t countdown(float level)
+{
+    double odds, u, k;
+
+    if (level <= 0.0f)
+        return INT32_MAX;
+
+    odds = pow(2.0, -(CHAOS_BUS_MIN_SHIFT + (1.0 - level) * (CHAOS_BUS_MAX_SHIFT - CHAOS_BUS_MIN_SHIFT)));
+    u = (chaos_rand(CHAOS_RNG_CPU) + 1.0) / 4294967296.0;
+    k = floor(log(u) / log1p(-odds));
+    return (k >= INT32_MAX) ? INT32_MAX : (int32_t)k;
+}
+
+unsigned int chaos_bus_fault(unsigned int address, unsigned int value, int width)
+{
+    int region = chaos_bus_region[(address >> 16) & 0xff];
+    unsigned int mask;
+
+    if (armed[region] <= 0.0f)
+    {
+        chaos_bus_count[region] = INT32_MAX;
+        return value;
+    }
+
+    mask = (unsigned int)(chaos_params[CHAOS_PARAM_BUS_NOISE_MASK] * 0xffff + 0.5f);
+    switch (width)
+    {
+        case 1:
+            mask = mask ? ((address & 1) ? (mask & 0xff) : (mask >> 8)) : (1 << chaos_rand_below(CHAOS_RNG_CPU, 8));
+            break;
+        case 2:
+            mask = mask ? mask : (1 << chaos_rand_below(CHAOS_RNG_CPU, 16));
+            break;
+        default:
+            mask = (mask ? mask : (1 << chaos_rand_below(CHAOS_RNG_CPU, 16))) << 16;
+            break;
+    }
+
+    chaos_bus_count[region] = countdown(armed[region]);
+    return value ^ mask;
+}
+
+void chaos_bus_frame(void)
+{
+    int region;
+
+    if (!mapped)
+        map_regions();
+
+    for (region = CHAOS_BUS_ROM; region < CHAOS_BUS_REGIONS; region++)
+    {
+        float level = chaos_params[CHAOS_PARAM_BUS_NOISE_ROM + region - CHAOS_BUS_ROM];
+        if (level != armed[region])
+        {
+            armed[region] = level;
+            chaos_bus_count[region] = countdown(level);
+        }
+    }
+}
+
+void chaos_bus_reset(void)
+{
+    int region;
+
+    for (region = 0; region < CHAOS_BUS_REGIONS; region++)
+    {
+        armed[region] = 0.0f;
+        chaos_bus_count[region] = INT32_MAX;
+    }
+}
+
+int chaos_bus_save(uint8_t *state)
+{
+    memcpy(state, chaos_bus_count, sizeof(chaos_bus_count));
+    memcpy(state + sizeof(chaos_bus_count), armed, sizeof(armed));
+    return sizeof(chaos_bus_count) + sizeof(armed);
+}
+
+int chaos_bus_load(const uint8_t *state)
+{
+    memcpy(chaos_bus_count, state, sizeof(chaos_bus_count));
+    memcpy(armed, state + sizeof(chaos_bus_count), sizeof(armed));
+    return sizeof(chaos_bus_count) + sizeof(armed);
+}
+
+#endif /* CHAOS_BUS_NOISE */
@@ -0,0 +1,58 @@
+#ifndef _CHAOS_BUS_H_
+#define _CHAOS_BUS_H_
+
+#include <stdint.h>
+
+/* Bus noise: random bit flips on the data the CPUs read (CHAOS_BUS_NOISE
+ * builds only, see CMakeLists.txt).
+ *
+ * Each region keeps a countdown of the reads left before its next fault,
+ * drawn from a geometric distribution whose mean follows the region's level
+ * parameter (CHAOS_PARAM_BUS_NOISE_*). A read only decrements the counter
+ * of its 68k page's region; the random number generator runs when the
+ * counter goes below zero, to flip the bits of CHAOS_PARAM_BUS_NOISE_MASK
+ * (one random bit at 0) in the value read and draw the next countdown.
+ *
+ * Data reads of the 68k (m68ki_read_8/16/32(), not opcode and immediate
+ * fetches) and memory reads of the Z80 in Mega Drive mode (its RAM and the
+ * 68k bank window) are covered; a byte read takes the high byte of the mask
+ * at an even address and the low byte at an odd one, like the 68k data bus
+ * lanes, and a long word read the high word. Nothing is written back.
+ */
+
+enum
+{
+    CHAOS_BUS_NONE,         /* pages outside the regions below */
+    CHAOS_BUS_ROM,          /* $000000-$3FFFFF: cartridge */
+    CHAOS_BUS_RAM,          /* $E00000-$FFFFFF: 68k work RAM */
+    CHAOS_BUS_ZRAM,         /* $A00000-$A0FFFF: Z80 area, Z80 RAM of the Z80 */
+    CHAOS_BUS_VDP,          /* $C00000-$DFFFFF: VDP ports */
+    CHAOS_BUS_REGIONS
+};
+
+/* Mean reads between two faults at levels 1 and 0+ (log2) */
+#define CHAOS_BUS_MIN_SHIFT 6
+#define CHAOS_BUS_MAX_SHIFT 26
+
+/* Region of each 64KB 68k page, reads left before the fault of each region */
+extern uint8_t chaos_bus_region[256];
+extern int32_t chaos_bus_count[CHAOS_BUS_REGIONS];
+
+/* Countdown of the page of 68k address 'A' (the fast path of a read) */
+#define chaos_bus_tick(A) (--chaos_bus_count[chaos_bus_region[((A) >> 16) & 0xff]] < 0)
+
+/* Counter of the region of 68k address 'address' gone below zero: returns
+ * 'value' ('width' bytes) with the fault applied and draws the next countdown */
+unsigned int chaos_bus_fault(unsigned int address, unsigned int value, int width);
+
+/* Draw the countdowns of the regions whose level changed (frame start) */
+void chaos_bus_frame(void);
+
+/* Regions back to no countdown (chaos_reset()) */
+void chaos_bus_reset(void);
+
+/* Countdowns (chaos_context_save()); return the bytes written / read */
+int chaos_bus_save(uint8_t *state);
+int chaos_bus_load(const uint8_t *state);
+
+#endif /* _CHAOS_BUS_H_ */
@@ -0,0 +1,183 @@
+/**
+ * ChaosDrive - random cheat code sets
+ *
+ * A ROM code keeps the word it replaced while its set is active, as the
+ * Game Genie does, and the words are put back in reverse order in case two
+ * codes share an address. Clones are outside the area the 68k decode cache
+ * treats as read-only, so patched code is decoded again with no flush.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_cheat.h"
+#include "chaos_ram.h"
+#include "chaos_rand.h"
+#include "chaos_rom.h"
+
+#define CODE_ROM     0 /* addr: ROM offset (even), value: low byte of the word */
+#define CODE_RAM     1 /* addr: work_ram[] index */
+#define CODE_APPLIED 2 /* ROM code written, 'old' holds the word */
+
+typedef struct
+{
+    uint32 addr;
+    uint16 old;
+    uint8 value;
+    uint8 flags;
+} chaos_cheat_code_t;
+
+typedef struct
+{
+    chaos_cheat_code_t codes[CHAOS_CHEAT_CODES];
+    int count;
+} chaos_cheat_set_t;
+
+static chaos_cheat_set_t sets[CHAOS_CHEAT_SETS];
+static int active = -1;
+
+static uint16 code_pages[CHAOS_ROM_PAGES];
+
+/* Write the ROM codes of 'set' (to the clones) */
+static void apply(chaos_cheat_set_t *set)
+{
+    int i;
+
+    for (i = 0; i < set->count; i++)
+    {
+        chaos_cheat_code_t *code = &set->codes[i];
+        uint16 *word;
+
+        if (code->flags & CODE_RAM)
+            continue;
+
+        /* out of clones: the code is left out */
+        word = (uint16 *)chaos_rom_byte(code->addr);
+        if (!word)
+            continue;
+
+        code->old = *word;
+        *word = (code->old & 0xFF00) | code->value;
+        code->flags |= CODE_APPLIED;
+    }
+}
+
+/* Put back the words 'set' replaced */
+static void revert(chaos_cheat_set_t *set)
+{
+    int i;
+
+    for (i = set->count - 1; i >= 0; i--)
+    {
+        chaos_cheat_code_t *code = &set->codes[i];
+        uint16 *word;
+
+        if (!(code->flags & CODE_APPLIED))
+            continue;
+
+        word = (uint16 *)chaos_rom_byte(code->addr);
+        if (word)
+            *word = code->old;
+        code->flags &= ~CODE_APPLIED;
+    }
+}
+
+/* Random codes for 's' */
+static void fill(chaos_cheat_set_t *s, int codes, int pages, int ram)
+{
+    int i;
+
+    for (i = 0; i < codes; i++)
+    {
+        chaos_cheat_code_t *code = &s->codes[i];
+
+        /* one code in four on a game variable, once some were found */
+        if (ram && (chaos_rand_below(CHAOS_RNG_CPU, 4) == 0))
+        {
+            code->addr = chaos_ram_candidates()[chaos_rand_below(CHAOS_RNG_CPU, ram)] & 0xFFFF;
+            code->flags = CODE_RAM;
+        }
+        else
+        {
+            /* in a page code ran from, anywhere until some did */
+            if (pages)
+                code->addr = (code_pages[chaos_rand_below(CHAOS_RNG_CPU, pages)] << M68K_CACHE_PAGE_SHIFT) |
+                             chaos_rand_below(CHAOS_RNG_CPU, 1 << M68K_CACHE_PAGE_SHIFT);
+            else
+                code->addr = chaos_rand_below(CHAOS_RNG_CPU, cart.romsize);
+            code->addr &= ~1;
+            code->flags = CODE_ROM;
+        }
+        code->value = chaos_rand_below(CHAOS_RNG_CPU, 256);
+    }
+    s->count = codes;
+}
+
+void chaos_cheat_generate(int first, int count, int codes)
+{
+    int pages, ram, set;
+
+    if (first < 0)
+        first = 0;
+    if (count > CHAOS_CHEAT_SETS - first)
+        count = CHAOS_CHEAT_SETS - first;
+    if ((count <= 0) || !cart.romsize)
+        return;
+
+    if (codes < 1)
+        codes = 1;
+    if (codes > CHAOS_CHEAT_CODES)
+        codes = CHAOS_CHEAT_CODES;
+
+    pages = chaos_rom_code_pages(code_pages);
+    ram = chaos_ram_candidate_count();
+
+    for (set = first; set < first + count; set++)
+    {
+        if (set == active)
+            revert(&sets[set]);
+        fill(&sets[set], codes, pages, ram);
+        if (set == active)
+            apply(&sets[set]);
+    }
+}
+
+void chaos_cheat_select(int set)
+{
+    if ((unsigned int)set >= CHAOS_CHEAT_SETS)
+        set = -1;
+    if (set == active)
+        return;
+
+    if (active >= 0)
+        revert(&sets[active]);
+    active = set;
+    if (active >= 0)
+        apply(&sets[active]);
+}
+
+int chaos_cheat_active(void)
+{
+    return active;
+}
+
+void chaos_cheat_frame(void)
+{
+    const chaos_cheat_set_t *s;
+    int i;
+
+    if (active < 0)
+        return;
+
+    s = &sets[active];
+    for (i = 0; i < s->count; i++)
+    {
+        if (s->codes[i].flags & CODE_RAM)
+            work_ram[s->codes[i].addr] = s->codes[i].value;
+    }
+}
+
+void chaos_cheat_clear(void)
+{
+    memset(sets, 0, sizeof(sets));
+    active = -1;
+}
@@ -0,0 +1,43 @@
+#ifndef _CHAOS_CHEAT_H_
+#define _CHAOS_CHEAT_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Random cheat code sets.
+ *
+ * Like a Game Genie or an Action Replay, a set holds a few patches: ROM
+ * words in the pages code ran from (chaos_rom_code_pages()), of which only
+ * the low byte changes (the immediate or branch offset of many opcodes, so
+ * the game mostly keeps running), and work RAM bytes among the ranked
+ * variables (chaos_ram.h), written again every frame as the Action Replay
+ * does. ROM patches go to the copy-on-write banks of chaos_rom.h, never to
+ * cart.rom.
+ *
+ * One set is active at a time. Selecting another puts back the words of the
+ * active one and writes its own, a few words whatever the ROM size, so the
+ * front end can flip through hundreds of variants per second; the banks
+ * stay cloned and mapped meanwhile.
+ */
+
+#define CHAOS_CHEAT_SETS  256
+#define CHAOS_CHEAT_CODES 8 /* per set */
+
+/* New random codes for 'count' sets from 'first' ('codes' codes each, at
+ * least 1); the active one is reapplied */
+void EMSCRIPTEN_KEEPALIVE chaos_cheat_generate(int first, int count, int codes);
+
+/* Make 'set' the active one (-1: none, the ROM words put back) */
+void EMSCRIPTEN_KEEPALIVE chaos_cheat_select(int set);
+
+/* Active set, -1 if none */
+int EMSCRIPTEN_KEEPALIVE chaos_cheat_active(void);
+
+/* RAM codes of the active set (called once per frame) */
+void chaos_cheat_frame(void);
+
+/* Forget the sets, without putting the ROM words back (the clones are
+ * dropped or a new ROM is loaded) */
+void chaos_cheat_clear(void);
+
+#endif /* _CHAOS_CHEAT_H_ */
@@ -0,0 +1,165 @@
+/**
+ * ChaosDrive - chaos checkpoints
+ *
+ * Game code writes work RAM and VRAM without going through anything we can
+ * hook cheaply, so dirty pages are found by comparing each page against
+ * the checkpoint copy. Only differing pages are copied, and on restore only
+ * those are reported to the renderer (pattern cache, SAT cache, palette).
+ */
+
+#include "shared.h"
+#include "chaos_dirty.h"
+#include "chaos_checkpoint.h"
+#include "chaos_record.h"
+#include "chaos_undo.h"
+#include "memmap.h"
+
+/* FM chip context (sound_fm_context_save(), a few KB) */
+#define CHECKPOINT_FM_SIZE 0x2000
+
+#define REGION_VRAM 0
+#define REGION_CRAM 1
+#define REGION_COUNT 5
+
+typedef struct
+{
+    uint8 *live;
+    uint8 *saved;
+    int size;
+} checkpoint_region_t;
+
+static uint8 saved_vram[0x10000];
+static uint8 saved_cram[0x80];
+static uint8 saved_vsram[0x80];
+static uint8 saved_work_ram[0x10000];
+static uint8 saved_zram[0x2000];
+
+static const checkpoint_region_t regions[REGION_COUNT] =
+{
+    {vram,     saved_vram,     sizeof(saved_vram)},
+    {cram,     saved_cram,     sizeof(saved_cram)},
+    {vsram,    saved_vsram,    sizeof(saved_vsram)},
+    {work_ram, saved_work_ram, sizeof(saved_work_ram)},
+    {zram,     saved_zram,     sizeof(saved_zram)}
+};
+
+static uint8 saved_reg[0x20];
+static uint8 saved_fm[CHECKPOINT_FM_SIZE];
+static uint8 current_fm[CHECKPOINT_FM_SIZE];
+static int saved_fm_size;
+
+/* D0-D7, A0-A7, PC, SR, USP, ISP (state.c order) */
+static const m68k_register_t cpu_regs[] =
+{
+    M68K_REG_D0, M68K_REG_D1, M68K_REG_D2, M68K_REG_D3,
+    M68K_REG_D4, M68K_REG_D5, M68K_REG_D6, M68K_REG_D7,
+    M68K_REG_A0, M68K_REG_A1, M68K_REG_A2, M68K_REG_A3,
+    M68K_REG_A4, M68K_REG_A5, M68K_REG_A6, M68K_REG_A7,
+    M68K_REG_PC, M68K_REG_SR, M68K_REG_USP, M68K_REG_ISP
+};
+
+#define CPU_REG_COUNT (sizeof(cpu_regs) / sizeof(cpu_regs[0]))
+
+static unsigned int saved_cpu[CPU_REG_COUNT];
+
+static int valid;
+
+int chaos_checkpoint(void)
+{
+    int i, offset;
+    int pages = 0;
+
+    chaos_record_call(CHAOS_RECORD_CHECKPOINT, 0, 0, 0, 0);
+
+    for (i = 0; i < REGION_COUNT; i++)
+    {
+        const checkpoint_region_t *r = &regions[i];
+
+        for (offset = 0; offset < r->size; offset += CHAOS_CHECKPOINT_PAGE)
+        {
+            int len = (r->size - offset < CHAOS_CHECKPOINT_PAGE) ? (r->size - offset) : CHAOS_CHECKPOINT_PAGE;
+
+            if (!valid || memcmp(r->live + offset, r->saved + offset, len))
+            {
+                memcpy(r->saved + offset, r->live + offset, len);
+                pages++;
+            }
+        }
+    }
+
+    memcpy(saved_reg, reg, sizeof(saved_reg));
+    saved_fm_size = sound_fm_context_save(saved_fm);
+
+    for (i = 0; i < CPU_REG_COUNT; i++)
+    {
+        saved_cpu[i] = m68k_get_reg(cpu_regs[i]);
+    }
+
+    /* the checkpoint now holds what the log could take back */
+    chaos_undo_clear();
+    valid = 1;
+    return pages;
+}
+
+int chaos_restore(void)
+{
+    int i, offset;
+    int pages = 0;
+
+    if (!valid)
+        return -1;
+
+    chaos_record_call(CHAOS_RECORD_RESTORE, 0, 0, 0, 0);
+
+    /* registers first: the VRAM layout decides how restored pages are cached */
+    if (memcmp(reg, saved_reg, sizeof(saved_reg)))
+    {
+        vdp_restore_regs(saved_reg);
+        bitmap.viewport.changed |= 2;
+    }
+
+    for (i = 0; i < REGION_COUNT; i++)
+    {
+        const checkpoint_region_t *r = &regions[i];
+
+        for (offset = 0; offset < r->size; offset += CHAOS_CHECKPOINT_PAGE)
+        {
+            int len = (r->size - offset < CHAOS_CHECKPOINT_PAGE) ? (r->size - offset) : CHAOS_CHECKPOINT_PAGE;
+
+            if (!memcmp(r->live + offset, r->saved + offset, len))
+                continue;
+
+            memcpy(r->live + offset, r->saved + offset, len);
+            pages++;
+
+            if (i == REGION_VRAM)
+                chaos_dirty_vram(offset, len);
+            else if (i == REGION_CRAM)
+                chaos_dirty_cram(offset, len);
+        }
+    }
+
+    if ((sound_fm_context_save(current_fm) != saved_fm_size) || memcmp(current_fm, saved_fm, saved_fm_size))
+    {
+        sound_fm_context_load(saved_fm);
+    }
+
+    for (i = 0; i < CPU_REG_COUNT; i++)
+    {
+        m68k_set_reg(cpu_regs[i], saved_cpu[i]);
+    }
+
+    chaos_undo_clear();
+    return pages;
+}
+
+void chaos_checkpoint_clear(void)
+{
+    valid = 0;
+}
+
+void chaos_checkpoint_memory_report(void)
+{
+    memory_region("checkpoint vram", saved_vram, sizeof(saved_vram));
+    memory_region("checkpoint work_ram", saved_work_ram, sizeof(saved_work_ram));
+}
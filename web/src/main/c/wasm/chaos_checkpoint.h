@@ -0,0 +1,31 @@
+#ifndef _CHAOS_CHECKPOINT_H_
+#define _CHAOS_CHECKPOINT_H_
+
+#include <emscripten/emscripten.h>
+
+/* Chaos checkpoint: a copy of only the state chaos effects corrupt (VRAM,
+ * CRAM, VSRAM, VDP registers, 68k work RAM, Z80 RAM, FM chip registers and
+ * the 68k registers), for a quick "undo that glitch".
+ *
+ * Memory is compared in CHAOS_CHECKPOINT_PAGE byte pages: taking a new
+ * checkpoint only copies the pages that differ from the previous one, and
+ * restoring only writes back (and invalidates renderer caches for) pages
+ * that changed since. Z80 registers, PSG and timers are left running.
+ */
+
+#define CHAOS_CHECKPOINT_PAGE 256
+
+/* Save a checkpoint; returns the number of pages copied */
+int EMSCRIPTEN_KEEPALIVE chaos_checkpoint(void);
+
+/* Return to the last checkpoint; returns the number of pages restored, or
+ * -1 when no checkpoint was taken */
+int EMSCRIPTEN_KEEPALIVE chaos_restore(void);
+
+/* Forget the checkpoint (new ROM loaded) */
+void chaos_checkpoint_clear(void);
+
+/* Add the saved copies to the memory report */
+void chaos_checkpoint_memory_report(void);
+
+#endif /* _CHAOS_CHECKPOINT_H_ */
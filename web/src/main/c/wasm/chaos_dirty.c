@@ -0,0 +1,211 @@
+/**
+ * ChaosDrive - dirty-range tracking for chaos memory edits
+ *
+ * Chaos effects write vram[]/cram[] directly, bypassing the VDP ports and
+ * therefore the renderer bookkeeping done in vdp_bus_w(). Effects report the
+ * byte ranges they touched here, so only the affected patterns are queued
+ * for update_bg_pattern_cache() instead of all 0x800 of them (0x200 in
+ * Mode 4).
+ */
+
+#include "shared.h"
+#include "chaos_dirty.h"
+#include "gpu_log.h"
+
+/* Max. number of VRAM tables excluded from pattern cache updates */
+#define MAX_TABLES 5
+
+typedef struct
+{
+    int start;
+    int end;
+} vram_table_t;
+
+/* ======================================================================== */
+/* VRAM layout (Mode 5)                                                     */
+/* ======================================================================== */
+
+static int mode5(void)
+{
+    return (system_hw & SYSTEM_MD) && (reg[1] & 0x04);
+}
+
+/* VRAM the display reads: 16KB in Mode 4, whose 512 patterns have their
+ * flipped copies cached right above them (names past 0x1FF would overwrite
+ * those) */
+static int vram_size(void)
+{
+    return mode5() ? 0x10000 : 0x4000;
+}
+
+static int sat_cache_size(void)
+{
+    /* sat[] mirrors 1KB of VRAM in H40 mode, 512 bytes in H32 mode */
+    return (reg[12] & 0x01) ? 0x400 : 0x200;
+}
+
+static int get_vram_tables(vram_table_t *t)
+{
+    int n = 0;
+    int size;
+
+    /* Mode 4 VRAM layout is not handled, treat everything as patterns */
+    if (!mode5())
+        return 0;
+
+    /* Plane A & B name tables (row size is 1 << playfield_shift bytes) */
+    size = ((playfield_row_mask + 1) >> 3) << (playfield_shift ? playfield_shift : 6);
+    if (size > 0x2000)
+        size = 0x2000;
+    t[n].start = ntab;
+    t[n++].end = ntab + size;
+    t[n].start = ntbb;
+    t[n++].end = ntbb + size;
+
+    /* Window name table, only when the window plane is displayed */
+    if ((reg[17] & 0x1F) || (reg[18] & 0x9F))
+    {
+        t[n].start = ntwb;
+        t[n++].end = ntwb + ((reg[12] & 0x01) ? 0x1000 : 0x800);
+    }
+
+    /* Sprite attribute table (80 or 64 entries) */
+    t[n].start = satb;
+    t[n++].end = satb + ((reg[12] & 0x01) ? 0x280 : 0x200);
+
+    /* Horizontal scroll table (240 lines max.) */
+    t[n].start = hscb;
+    t[n++].end = hscb + 0x3C0;
+
+    return n;
+}
+
+static int in_table(const vram_table_t *t, int count, int start, int end)
+{
+    int i;
+    for (i = 0; i < count; i++)
+    {
+        if ((start >= t[i].start) && (end <= t[i].end))
+            return 1;
+    }
+    return 0;
+}
+
+/* ======================================================================== */
+/* VRAM                                                                     */
+/* ======================================================================== */
+
+static void update_sat_cache(int start, int end)
+{
+    int sat_start = satb;
+    int sat_end = satb + sat_cache_size();
+    int mask = sat_cache_size() - 1;
+
+    if (start < sat_start)
+        start = sat_start;
+    if (end > sat_end)
+        end = sat_end;
+
+    /* sat[] uses the same byte layout as VRAM */
+    for (; start < end; start++)
+    {
+        sat[start & mask] = vram[start];
+    }
+
+    obj_index_dirty = 1;
+}
+
+void chaos_dirty_vram(int addr, int len)
+{
+    vram_table_t tables[MAX_TABLES];
+    int count, end, name;
+
+    end = addr + len;
+    if (addr < 0)
+        addr = 0;
+    if (end > vram_size())
+        end = vram_size();
+    if (addr >= end)
+        return;
+
+    /* Name table and H-scroll edits are not queued: drop the cached lines */
+    render_line_cache_dirty();
+
+    /* Lines logged for the GPU were read from the VRAM before the edit */
+    GPU_LOG_INVALIDATE();
+
+    count = get_vram_tables(tables);
+
+    /* Writes to the SAT must reach the internal copy used by parse_satb() */
+    if (count)
+    {
+        update_sat_cache(addr, end);
+    }
+
+    /* Queue modified pattern lines, skipping tables the renderer reads raw */
+    for (name = addr >> 5; name <= ((end - 1) >> 5); name++)
+    {
+        int start = name << 5;
+        int stop = start + 32;
+        uint8 mask;
+
+        if (start < addr)
+            start = addr;
+        if (stop > end)
+            stop = end;
+
+        if (in_table(tables, count, start, stop))
+            continue;
+
+        /* Pattern lines are 4 bytes each */
+        mask = (0xFF << ((start >> 2) & 7)) & (0xFF >> (7 - (((stop - 1) >> 2) & 7)));
+
+        if (bg_name_dirty[name] == 0)
+        {
+            bg_name_list[bg_list_index++] = name;
+        }
+        bg_name_dirty[name] |= mask;
+    }
+}
+
+void chaos_dirty_vram_all(void)
+{
+    chaos_dirty_vram(0, vram_size());
+}
+
+/* ======================================================================== */
+/* CRAM                                                                     */
+/* ======================================================================== */
+
+void chaos_dirty_cram(int addr, int len)
+{
+    int index, last;
+    int border = reg[7] & 0x3F;
+
+    last = (addr + len - 1) >> 1;
+    if (last > 0x3F)
+        last = 0x3F;
+
+    for (index = addr >> 1; index <= last; index++)
+    {
+        /* Chaos writes raw bytes, keep within the 9-bit palette range */
+        unsigned int data = *(uint16 *)&cram[index << 1] & 0x1FF;
+
+        /* Color entry 0 of each palette is never displayed (transparent pixel) */
+        if (index & 0x0F)
+        {
+            color_update_m5(index, data);
+        }
+
+        /* Backdrop color */
+        if (index == border)
+        {
+            color_update_m5(0x00, data);
+        }
+    }
+}
+
+void chaos_dirty_cram_all(void)
+{
+    chaos_dirty_cram(0, 0x80);
+}
@@ -0,0 +1,19 @@
+#ifndef _CHAOS_DIRTY_H_
+#define _CHAOS_DIRTY_H_
+
+/* Report a modified VRAM byte range [addr, addr + len) to the renderer.
+ * Only pattern data is queued for the bg_pattern_cache; name tables and the
+ * H-scroll table are read straight from VRAM, and writes that land in the
+ * sprite attribute table are mirrored into the internal SAT cache instead. */
+void chaos_dirty_vram(int addr, int len);
+
+/* Same as above for the whole of VRAM (64KB, 16KB in Mode 4) */
+void chaos_dirty_vram_all(void);
+
+/* Report modified CRAM bytes [addr, addr + len) (Mode 5 palette update) */
+void chaos_dirty_cram(int addr, int len);
+
+/* Same as above for the whole 128 bytes of CRAM */
+void chaos_dirty_cram_all(void);
+
+#endif /* _CHAOS_DIRTY_H_ */
@@ -0,0 +1,118 @@
+/**
+ * ChaosDrive - line-timed chaos FM writes
+ *
+ * The queue is kept sorted by line, writes queued for the same line keep
+ * their order (an effect's address/data pairs are never reordered).
+ */
+
+#include "shared.h"
+#include "chaos_fm.h"
+#include "chaos_rand.h"
+
+typedef struct
+{
+    int line;
+    uint8 bank;
+    uint8 reg;
+    uint8 value;
+} chaos_fm_write_t;
+
+int chaos_fm_next_line = -1;
+
+static chaos_fm_write_t queue[CHAOS_FM_QUEUE_SIZE];
+static int queue_count;
+
+/* last line flushed this frame */
+static int current_line = -1;
+
+static int has_ym2612(void)
+{
+    return (system_hw & SYSTEM_PBC) == SYSTEM_MD;
+}
+
+static void issue(unsigned int cycles, int bank, int reg, int value)
+{
+    fm_write(cycles, bank, reg);
+    fm_write(cycles, bank + 1, value);
+}
+
+void chaos_fm_begin_frame(void)
+{
+    int i;
+
+    /* left over from lines the last frame did not reach (viewport change) */
+    for (i = 0; i < queue_count; i++)
+    {
+        issue(m68k.cycles, queue[i].bank, queue[i].reg, queue[i].value);
+    }
+
+    queue_count = 0;
+    chaos_fm_next_line = -1;
+    current_line = -1;
+}
+
+void chaos_fm_write(int line, int bank, int reg, int value)
+{
+    int i;
+
+    if (!has_ym2612())
+        return;
+
+    if (line <= current_line)
+        line = current_line + 1;
+
+    /* no room left: write now */
+    if (queue_count == CHAOS_FM_QUEUE_SIZE)
+    {
+        issue(m68k.cycles, bank, reg, value);
+        return;
+    }
+
+    for (i = queue_count; (i > 0) && (queue[i - 1].line > line); i--)
+    {
+        queue[i] = queue[i - 1];
+    }
+
+    queue[i].line = line;
+    queue[i].bank = bank;
+    queue[i].reg = reg;
+    queue[i].value = value;
+    queue_count++;
+
+    chaos_fm_next_line = queue[0].line;
+}
+
+int chaos_fm_random_line(void)
+{
+    int lines = bitmap.viewport.h ? bitmap.viewport.h : 224;
+    return chaos_rand_below(CHAOS_RNG_AUDIO, lines);
+}
+
+void chaos_fm_flush(int line)
+{
+    int i, n = 0;
+
+    current_line = line;
+
+    if (chaos_fm_next_line < 0 || chaos_fm_next_line > line)
+        return;
+
+    for (i = 0; (i < queue_count) && (queue[i].line <= line); i++)
+    {
+        issue(mcycles_vdp, queue[i].bank, queue[i].reg, queue[i].value);
+    }
+
+    for (; i < queue_count; i++)
+    {
+        queue[n++] = queue[i];
+    }
+    queue_count = n;
+
+    chaos_fm_next_line = queue_count ? queue[0].line : -1;
+}
+
+void chaos_fm_clear(void)
+{
+    queue_count = 0;
+    chaos_fm_next_line = -1;
+}
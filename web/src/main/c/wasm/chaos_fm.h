@@ -0,0 +1,34 @@
+#ifndef _CHAOS_FM_H_
+#define _CHAOS_FM_H_
+
+/* Line-timed chaos FM writes.
+ *
+ * Chaos effects do not write the YM2612 directly. Register writes are queued
+ * on an active display line of the current frame and issued from the line
+ * hook through fm_write(), stamped with the VDP cycle count of that line like
+ * 68k and Z80 port writes: the FM chip is run up to that point first, so the
+ * corruption lands mid-frame and the generated samples follow the register
+ * state. Writes queued for a line that is already past go to the next line.
+ */
+
+#define CHAOS_FM_QUEUE_SIZE 128
+
+/* earliest queued line, -1 when the queue is empty */
+extern int chaos_fm_next_line;
+
+/* Start of frame: writes can be queued from line 0 again */
+void chaos_fm_begin_frame(void);
+
+/* Queue register 'reg' = 'value' on address port 'bank' (0 or 2) for 'line' */
+void chaos_fm_write(int line, int bank, int reg, int value);
+
+/* A random active display line, to spread writes across the frame */
+int chaos_fm_random_line(void);
+
+/* Issue writes queued up to 'line' (line hook) */
+void chaos_fm_flush(int line);
+
+/* Drop queued writes */
+void chaos_fm_clear(void);
+
+#endif /* _CHAOS_FM_H_ */
@@ -0,0 +1,128 @@
+/**
+ * ChaosDrive - VDP write protection
+ *
+ * The core checks one byte per pattern, color or word, and only while the
+ * matching vdp_protect bit is set: a bit is cleared again as soon as its
+ * mask is empty, so unprotected games pay a single test per write.
+ */
+
+#include "shared.h"
+#include "chaos_freeze.h"
+#include "chaos_vram.h"
+
+/* Recompute the vdp_protect bit of one mask */
+static void update_flag(int flag, const uint8 *mask, int size)
+{
+    int i;
+
+    vdp_protect &= ~flag;
+    for (i = 0; i < size; i++)
+    {
+        if (mask[i])
+        {
+            vdp_protect |= flag;
+            return;
+        }
+    }
+}
+
+static void mark(uint8 *mask, int size, int first, int count, int on)
+{
+    int i;
+
+    if (first < 0)
+    {
+        count += first;
+        first = 0;
+    }
+    if (count > size - first)
+        count = size - first;
+
+    for (i = 0; i < count; i++)
+        mask[first + i] = on ? 1 : 0;
+}
+
+void chaos_freeze_vram(int start, int len, int on)
+{
+    if (len <= 0)
+        return;
+
+    mark(vdp_protect_vram, 0x800, start >> 5, ((start + len - 1) >> 5) - (start >> 5) + 1, on);
+    update_flag(VDP_PROTECT_VRAM, vdp_protect_vram, 0x800);
+}
+
+int chaos_freeze_vram_class(int type, int on)
+{
+    static chaos_vram_run_t runs[0x400];
+    int i, count = chaos_vram_runs(type, runs), patterns = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        mark(vdp_protect_vram, 0x800, runs[i].start >> 5, runs[i].len >> 5, on);
+        patterns += runs[i].len >> 5;
+    }
+    update_flag(VDP_PROTECT_VRAM, vdp_protect_vram, 0x800);
+    return patterns;
+}
+
+void chaos_freeze_cram(int first, int count, int on)
+{
+    mark(vdp_protect_cram, 0x40, first, count, on);
+    update_flag(VDP_PROTECT_CRAM, vdp_protect_cram, 0x40);
+}
+
+void chaos_freeze_vsram(int first, int count, int on)
+{
+    mark(vdp_protect_vsram, 0x40, first, count, on);
+    update_flag(VDP_PROTECT_VSRAM, vdp_protect_vsram, 0x40);
+}
+
+void chaos_freeze_clear(void)
+{
+    memset(vdp_protect_vram, 0, sizeof(vdp_protect_vram));
+    memset(vdp_protect_cram, 0, sizeof(vdp_protect_cram));
+    memset(vdp_protect_vsram, 0, sizeof(vdp_protect_vsram));
+    vdp_protect = 0;
+}
+
+/* ======================================================================== */
+/* Context: one bit per entry                                               */
+/* ======================================================================== */
+
+static int pack(uint8_t *state, const uint8 *mask, int size)
+{
+    int i;
+
+    memset(state, 0, size >> 3);
+    for (i = 0; i < size; i++)
+        state[i >> 3] |= mask[i] << (i & 7);
+    return size >> 3;
+}
+
+static int unpack(const uint8_t *state, uint8 *mask, int size)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+        mask[i] = (state[i >> 3] >> (i & 7)) & 1;
+    return size >> 3;
+}
+
+int chaos_freeze_save(uint8_t *state)
+{
+    int size = pack(state, vdp_protect_vram, 0x800);
+    size += pack(state + size, vdp_protect_cram, 0x40);
+    return size + pack(state + size, vdp_protect_vsram, 0x40);
+}
+
+int chaos_freeze_load(const uint8_t *state)
+{
+    int size = unpack(state, vdp_protect_vram, 0x800);
+    size += unpack(state + size, vdp_protect_cram, 0x40);
+    size += unpack(state + size, vdp_protect_vsram, 0x40);
+
+    update_flag(VDP_PROTECT_VRAM, vdp_protect_vram, 0x800);
+    update_flag(VDP_PROTECT_CRAM, vdp_protect_cram, 0x40);
+    update_flag(VDP_PROTECT_VSRAM, vdp_protect_vsram, 0x40);
+    return size;
+}
@@ -0,0 +1,39 @@
+#ifndef _CHAOS_FREEZE_H_
+#define _CHAOS_FREEZE_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* VDP write protection for the chaos effects.
+ *
+ * Protected VRAM patterns (32 bytes), CRAM colors and VSRAM words keep what
+ * they hold: the game's data port writes and DMA to them are dropped by the
+ * core (vdp_protect masks, vdp_ctrl.h), so a corruption made once stays on
+ * screen with no work per frame, and the game's uploads to those areas are
+ * not even copied. A tile row or a plane row is a VRAM range. Mode 5 only:
+ * Master System / Game Gear writes are never dropped.
+ *
+ * The masks are part of the chaos context (rollbacks) and are cleared by
+ * chaos_reset().
+ */
+
+/* Protect (on = 1) or release (on = 0) the patterns overlapping VRAM
+ * [start, start + len) */
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_vram(int start, int len, int on);
+
+/* Same for the patterns of a chaos_vram.h class (CHAOS_VRAM_TILES, ...);
+ * returns the patterns of that class */
+int chaos_freeze_vram_class(int type, int on);
+
+/* Same for 'count' CRAM colors / VSRAM words from 'first' (0-63) */
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_cram(int first, int count, int on);
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_vsram(int first, int count, int on);
+
+/* Release everything */
+void EMSCRIPTEN_KEEPALIVE chaos_freeze_clear(void);
+
+/* Masks (chaos_context_save()); return the bytes written / read */
+int chaos_freeze_save(uint8_t *state);
+int chaos_freeze_load(const uint8_t *state);
+
+#endif /* _CHAOS_FREEZE_H_ */
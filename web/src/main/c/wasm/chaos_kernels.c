@@ -0,0 +1,228 @@
+/**
+ * ChaosDrive - bulk memory transform kernels
+ *
+ * Shifts and rotations are plain memmove() calls, which Emscripten lowers to
+ * memory.copy. Per-byte transforms use 128-bit vectors when available.
+ */
+
+#include <string.h>
+#include "chaos_kernels.h"
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define CHAOS_VEC128
+typedef v128_t vec128_t;
+#define VEC_LOAD(p)         wasm_v128_load(p)
+#define VEC_STORE(p, v)     wasm_v128_store(p, v)
+#define VEC_SPLAT(b)        wasm_i8x16_splat(b)
+#define VEC_XOR(a, b)       wasm_v128_xor(a, b)
+#define VEC_OR(a, b)        wasm_v128_or(a, b)
+#define VEC_SHL4(v)         wasm_i8x16_shl(v, 4)
+#define VEC_SHR4(v)         wasm_u8x16_shr(v, 4)
+#define VEC_ANY(v)          wasm_v128_any_true(v)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CHAOS_VEC128
+typedef __m128i vec128_t;
+#define VEC_LOAD(p)         _mm_loadu_si128((const __m128i *)(p))
+#define VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+#define VEC_SPLAT(b)        _mm_set1_epi8((char)(b))
+#define VEC_XOR(a, b)       _mm_xor_si128(a, b)
+#define VEC_OR(a, b)        _mm_or_si128(a, b)
+#define VEC_SHL4(v)         _mm_and_si128(_mm_slli_epi16(v, 4), _mm_set1_epi8((char)0xF0))
+#define VEC_SHR4(v)         _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F))
+#define VEC_ANY(v)          (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128())) != 0xFFFF)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CHAOS_VEC128
+typedef uint8x16_t vec128_t;
+#define VEC_LOAD(p)         vld1q_u8(p)
+#define VEC_STORE(p, v)     vst1q_u8(p, v)
+#define VEC_SPLAT(b)        vdupq_n_u8(b)
+#define VEC_XOR(a, b)       veorq_u8(a, b)
+#define VEC_OR(a, b)        vorrq_u8(a, b)
+#define VEC_SHL4(v)         vshlq_n_u8(v, 4)
+#define VEC_SHR4(v)         vshrq_n_u8(v, 4)
+#define VEC_ANY(v)          ((vgetq_lane_u64(vreinterpretq_u64_u8(v), 0) | vgetq_lane_u64(vreinterpretq_u64_u8(v), 1)) != 0)
+#endif
+
+/* ======================================================================== */
+/* Shift / rotate                                                           */
+/* ======================================================================== */
+
+void chaos_kernel_shift(uint8_t *buf, int len, int amount, int clear)
+{
+    if (amount >= len || -amount >= len)
+    {
+        if (clear)
+            memset(buf, 0, len);
+        return;
+    }
+
+    if (amount > 0)
+    {
+        memmove(buf + amount, buf, len - amount);
+        if (clear)
+            memset(buf, 0, amount);
+    }
+    else if (amount < 0)
+    {
+        amount = -amount;
+        memmove(buf, buf + amount, len - amount);
+        if (clear)
+            memset(buf + len - amount, 0, amount);
+    }
+}
+
+void chaos_kernel_shift_blocks(uint8_t *buf, int len, int block, int amount)
+{
+    for (; len >= block; len -= block, buf += block)
+    {
+        chaos_kernel_shift(buf, block, amount, 0);
+    }
+}
+
+void chaos_kernel_rotate(uint8_t *buf, int len, int amount)
+{
+    uint8_t tmp[256];
+
+    if (len <= 0)
+        return;
+
+    /* normalize to a right rotation in [0, len) */
+    amount %= len;
+    if (amount < 0)
+        amount += len;
+
+    /* rotate in 256-byte steps through a small stack buffer */
+    while (amount > 0)
+    {
+        int step = (amount > (int)sizeof(tmp)) ? (int)sizeof(tmp) : amount;
+        memcpy(tmp, buf + len - step, step);
+        memmove(buf + step, buf, len - step);
+        memcpy(buf, tmp, step);
+        amount -= step;
+    }
+}
+
+/* ======================================================================== */
+/* Per-byte transforms                                                      */
+/* ======================================================================== */
+
+void chaos_kernel_xor(uint8_t *buf, int len, uint8_t mask)
+{
+    int i = 0;
+
+#ifdef CHAOS_VEC128
+    vec128_t m = VEC_SPLAT(mask);
+    for (; i + 16 <= len; i += 16)
+    {
+        VEC_STORE(buf + i, VEC_XOR(VEC_LOAD(buf + i), m));
+    }
+#else
+    uint32_t m = mask * 0x01010101u;
+    for (; i + 4 <= len; i += 4)
+    {
+        uint32_t w;
+        memcpy(&w, buf + i, 4);
+        w ^= m;
+        memcpy(buf + i, &w, 4);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        buf[i] ^= mask;
+    }
+}
+
+void chaos_kernel_nibble_swap(uint8_t *buf, int len)
+{
+    int i = 0;
+
+#ifdef CHAOS_VEC128
+    for (; i + 16 <= len; i += 16)
+    {
+        vec128_t v = VEC_LOAD(buf + i);
+        VEC_STORE(buf + i, VEC_OR(VEC_SHL4(v), VEC_SHR4(v)));
+    }
+#else
+    for (; i + 4 <= len; i += 4)
+    {
+        uint32_t w;
+        memcpy(&w, buf + i, 4);
+        w = ((w & 0x0F0F0F0Fu) << 4) | ((w >> 4) & 0x0F0F0F0Fu);
+        memcpy(buf + i, &w, 4);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        buf[i] = (uint8_t)((buf[i] << 4) | (buf[i] >> 4));
+    }
+}
+
+void chaos_kernel_swap_xor(uint8_t *buf, int len, int swap, uint8_t mask)
+{
+    int i = 0;
+
+    if (!swap)
+    {
+        chaos_kernel_xor(buf, len, mask);
+        return;
+    }
+
+#ifdef CHAOS_VEC128
+    vec128_t m = VEC_SPLAT(mask);
+    for (; i + 16 <= len; i += 16)
+    {
+        vec128_t v = VEC_LOAD(buf + i);
+        VEC_STORE(buf + i, VEC_XOR(VEC_OR(VEC_SHL4(v), VEC_SHR4(v)), m));
+    }
+#else
+    uint32_t m = mask * 0x01010101u;
+    for (; i + 4 <= len; i += 4)
+    {
+        uint32_t w;
+        memcpy(&w, buf + i, 4);
+        w = (((w & 0x0F0F0F0Fu) << 4) | ((w >> 4) & 0x0F0F0F0Fu)) ^ m;
+        memcpy(buf + i, &w, 4);
+    }
+#endif
+
+    for (; i < len; i++)
+    {
+        buf[i] = (uint8_t)((buf[i] << 4) | (buf[i] >> 4)) ^ mask;
+    }
+}
+
+/* ======================================================================== */
+/* Compare                                                                  */
+/* ======================================================================== */
+
+int chaos_kernel_diff(const uint8_t *a, const uint8_t *b, int len, uint8_t *blocks)
+{
+    int i, count = 0;
+
+    memset(blocks, 0, len >> 7);
+
+    for (i = 0; i + 16 <= len; i += 16)
+    {
+#ifdef CHAOS_VEC128
+        int differ = VEC_ANY(VEC_XOR(VEC_LOAD(a + i), VEC_LOAD(b + i)));
+#else
+        uint32_t wa[4], wb[4];
+        int differ;
+        memcpy(wa, a + i, 16);
+        memcpy(wb, b + i, 16);
+        differ = ((wa[0] ^ wb[0]) | (wa[1] ^ wb[1]) | (wa[2] ^ wb[2]) | (wa[3] ^ wb[3])) != 0;
+#endif
+        if (differ)
+        {
+            blocks[i >> 7] |= 1 << ((i >> 4) & 7);
+            count++;
+        }
+    }
+
+    return count;
+}
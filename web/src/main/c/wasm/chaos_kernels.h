@@ -0,0 +1,39 @@
+#ifndef _CHAOS_KERNELS_H_
+#define _CHAOS_KERNELS_H_
+
+#include <stdint.h>
+
+/* Bulk memory transforms used by chaos effects.
+ *
+ * All kernels work in place on an arbitrary byte buffer. When built with
+ * -msimd128 (WASM) or on SSE2/NEON hosts, the per-byte kernels process 16
+ * bytes at a time; otherwise a 32-bit scalar fallback is used.
+ */
+
+/* Move buf contents by 'amount' bytes (> 0 towards higher addresses, < 0
+ * towards lower addresses). Vacated bytes keep their previous value unless
+ * 'clear' is set, in which case they are zeroed. */
+void chaos_kernel_shift(uint8_t *buf, int len, int amount, int clear);
+
+/* Same as chaos_kernel_shift() applied independently to each 'block' bytes */
+void chaos_kernel_shift_blocks(uint8_t *buf, int len, int block, int amount);
+
+/* Rotate buf contents by 'amount' bytes (> 0 towards higher addresses) */
+void chaos_kernel_rotate(uint8_t *buf, int len, int amount);
+
+/* XOR every byte with 'mask' (mask = 0xFF inverts) */
+void chaos_kernel_xor(uint8_t *buf, int len, uint8_t mask);
+
+/* Swap the high and low nibble of every byte */
+void chaos_kernel_nibble_swap(uint8_t *buf, int len);
+
+/* Any chain of the two above in one pass: nibbles swapped if 'swap', then
+ * XOR with 'mask' */
+void chaos_kernel_swap_xor(uint8_t *buf, int len, int swap, uint8_t mask);
+
+/* Compare a and b in 16-byte blocks (len a multiple of 128): bit n & 7 of
+ * blocks[n >> 3] is set when block n differs. Returns the number of
+ * differing blocks. */
+int chaos_kernel_diff(const uint8_t *a, const uint8_t *b, int len, uint8_t *blocks);
+
+#endif /* _CHAOS_KERNELS_H_ */
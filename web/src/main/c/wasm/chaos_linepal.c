@@ -0,0 +1,115 @@
+/**
+ * ChaosDrive - per-line palette overrides
+ *
+ * Only the line blit reads the table; the effects write it once. The
+ * per-frame cost is the phase step and, after a held effect, one pass
+ * dropping its overrides.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_linepal.h"
+
+uint8 chaos_linepal_on;
+uint8 chaos_linepal_phase;
+uint8 chaos_linepal_count[CHAOS_LINEPAL_LINES];
+uint8 chaos_linepal_slot[CHAOS_LINEPAL_LINES][CHAOS_LINEPAL_SLOTS];
+uint16 chaos_linepal_color[CHAOS_LINEPAL_LINES][CHAOS_LINEPAL_SLOTS];
+
+static uint8 speed;
+static uint8 temp[CHAOS_LINEPAL_LINES]; /* overrides to drop next frame, one bit each */
+static uint8 transient;                 /* any temp[] bit set */
+
+void chaos_linepal_set(int line, int slot, int color, int temporary)
+{
+    int i, n;
+
+    if ((unsigned int)slot >= 64)
+        return;
+
+    line &= CHAOS_LINEPAL_LINES - 1;
+    n = chaos_linepal_count[line];
+
+    for (i = 0; (i < n) && (chaos_linepal_slot[line][i] != slot); i++);
+    if (i == CHAOS_LINEPAL_SLOTS)
+        return;
+
+    /* A lasting override is not traded for one frame's */
+    if (temporary && (i < n) && !(temp[line] & (1 << i)))
+        return;
+
+    chaos_linepal_slot[line][i] = slot;
+    chaos_linepal_color[line][i] = color & 0x1FF;
+    if (i == n)
+        chaos_linepal_count[line] = n + 1;
+
+    if (temporary)
+    {
+        temp[line] |= 1 << i;
+        transient = 1;
+    }
+    else
+    {
+        temp[line] &= ~(1 << i);
+    }
+
+    chaos_linepal_on = 1;
+    render_line_cache_dirty();
+}
+
+void chaos_linepal_speed(int lines)
+{
+    speed = lines;
+    if (!speed)
+        chaos_linepal_phase = 0;
+}
+
+void chaos_linepal_clear(void)
+{
+    chaos_linepal_speed(0);
+    if (!chaos_linepal_on)
+        return;
+
+    memset(chaos_linepal_count, 0, sizeof(chaos_linepal_count));
+    memset(temp, 0, sizeof(temp));
+    chaos_linepal_on = 0;
+    transient = 0;
+    render_line_cache_dirty();
+}
+
+/* Drop the temporary overrides, keeping the others in order */
+static void drop_transient(void)
+{
+    int line, i, n, on = 0;
+
+    for (line = 0; line < CHAOS_LINEPAL_LINES; line++)
+    {
+        if (temp[line])
+        {
+            for (i = n = 0; i < chaos_linepal_count[line]; i++)
+            {
+                if (!(temp[line] & (1 << i)))
+                {
+                    chaos_linepal_slot[line][n] = chaos_linepal_slot[line][i];
+                    chaos_linepal_color[line][n] = chaos_linepal_color[line][i];
+                    n++;
+                }
+            }
+            chaos_linepal_count[line] = n;
+            temp[line] = 0;
+        }
+        on |= chaos_linepal_count[line];
+    }
+
+    chaos_linepal_on = on ? 1 : 0;
+    transient = 0;
+    render_line_cache_dirty();
+}
+
+void chaos_linepal_frame(void)
+{
+    if (transient)
+        drop_transient();
+
+    chaos_linepal_phase += speed;
+}
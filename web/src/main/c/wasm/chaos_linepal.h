@@ -0,0 +1,48 @@
+#ifndef _CHAOS_LINEPAL_H_
+#define _CHAOS_LINEPAL_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos per-line palette overrides.
+ *
+ * Up to CHAOS_LINEPAL_SLOTS displayed colors per line (slot 0-63 like the
+ * palette layer, 0: backdrop) replaced by a 9-bit color (BBBGGGRRR). The
+ * Mode 5 line blit (remap_line()) patches those entries of the pixel table
+ * for the line and restores them after it, so a raster color effect costs
+ * the overrides of each line, not a CRAM write and 64 palette updates, and
+ * CRAM keeps what the game wrote. The CPU blitters only: like mid-frame CRAM
+ * changes, the overrides are not seen by the WebGL presenter's per-frame
+ * palette.
+ *
+ * Lines are read at (line + phase) & 0xFF: a non-zero speed rolls the table
+ * down the screen, the only work done per frame. Transient overrides (held
+ * effects) are cleared at the start of the next frame unless set again.
+ */
+
+#define CHAOS_LINEPAL_LINES 256
+#define CHAOS_LINEPAL_SLOTS 8
+
+/* Renderer side (core/vdp_render.c): overrides present, current phase,
+ * overrides of each table line */
+extern uint8_t chaos_linepal_on;
+extern uint8_t chaos_linepal_phase;
+extern uint8_t chaos_linepal_count[CHAOS_LINEPAL_LINES];
+extern uint8_t chaos_linepal_slot[CHAOS_LINEPAL_LINES][CHAOS_LINEPAL_SLOTS];
+extern uint16_t chaos_linepal_color[CHAOS_LINEPAL_LINES][CHAOS_LINEPAL_SLOTS];
+
+/* Show 'color' in 'slot' on table line 'line' (replaces an override of the
+ * same slot; dropped when the line has no room left); a temporary override
+ * only lasts until the next frame, and does not replace a lasting one */
+void EMSCRIPTEN_KEEPALIVE chaos_linepal_set(int line, int slot, int color, int temporary);
+
+/* Lines moved per frame (wraps at 256) */
+void EMSCRIPTEN_KEEPALIVE chaos_linepal_speed(int lines);
+
+/* Drop all overrides */
+void EMSCRIPTEN_KEEPALIVE chaos_linepal_clear(void);
+
+/* Phase and transient overrides (pre-render hook) */
+void chaos_linepal_frame(void);
+
+#endif /* _CHAOS_LINEPAL_H_ */
@@ -0,0 +1,435 @@
+/**
+ * ChaosDrive - chaos parameter automation
+ *
+ * The modulators live in a fixed array and are walked once per frame: each
+ * computes its source value, scales it by its depth and adds it to its
+ * target's contribution, then the touched parameters are clamped into
+ * chaos_params[]. LFOs keep a phase accumulator, so a raster event line
+ * only needs the phase offset of the line.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_audio.h"
+#include "chaos_mod.h"
+#include "chaos_queue.h"
+#include "chaos_rand.h"
+#include "chaos_record.h"
+
+#define TARGET_VIDEO (CHAOS_TARGET_VRAM | CHAOS_TARGET_CRAM | CHAOS_TARGET_VSRAM | CHAOS_TARGET_VDP_REGS)
+
+#define SINE_SIZE 256
+
+typedef struct
+{
+    chaos_mod_config_t config;
+    float phase;  /* LFO: 0..1 */
+    float value;  /* envelope, walk and audio state; last output */
+    int stage;    /* envelope: 0 idle, 1 attack, 2 release */
+} chaos_mod_t;
+
+float chaos_params[CHAOS_PARAM_COUNT];
+
+static float base[CHAOS_PARAM_COUNT];
+/* sum of the modulators of each parameter this frame, and of those not
+   evaluated per line */
+static float contrib[CHAOS_PARAM_COUNT];
+static float contrib_frame[CHAOS_PARAM_COUNT];
+
+static chaos_mod_t mods[CHAOS_MOD_MAX];
+static int mod_count;   /* highest used slot + 1 */
+static int line_mods;   /* CHAOS_MOD_LINE modulators */
+
+static float sine[SINE_SIZE];
+
+static const char *const param_names[CHAOS_PARAM_COUNT - CHAOS_FX_COUNT] =
+{
+    "cram_corruption_level",
+    "cram_corruption_range",
+    "fm_corruption_level",
+    "fm_corruption_channels",
+    "fm_corruption_freq",
+    "fm_corruption_volume",
+    "fm_corruption_envelope",
+    "fm_corruption_algorithm",
+    "post_rgb_split_level",
+    "post_trails_level",
+    "post_block_smear_level",
+    "post_scanline_jitter_level",
+    "audio_stutter_level",
+    "audio_reverse_level",
+    "audio_decimate_level",
+    "bus_noise_rom_level",
+    "bus_noise_ram_level",
+    "bus_noise_zram_level",
+    "bus_noise_vdp_level",
+    "bus_noise_mask",
+    "m68k_clock",
+    "z80_clock"
+};
+
+static float clamp01(float v)
+{
+    return (v < 0.0f) ? 0.0f : (v > 1.0f) ? 1.0f : v;
+}
+
+static void param_update(int param)
+{
+    chaos_params[param] = clamp01(base[param] + contrib[param]);
+}
+
+static void defaults(void)
+{
+    int i;
+
+    for (i = 0; i < CHAOS_FX_COUNT; i++)
+        base[i] = 1.0f;
+
+    base[CHAOS_PARAM_CRAM_CORRUPTION] = 0.0f;
+    base[CHAOS_PARAM_CRAM_RANGE] = 1.0f;
+    base[CHAOS_PARAM_FM_CORRUPTION] = 0.0f;
+    base[CHAOS_PARAM_FM_CHANNELS] = 1.0f;
+    base[CHAOS_PARAM_FM_FREQ] = 1.0f / 3;
+    base[CHAOS_PARAM_FM_VOLUME] = 1.0f / 5;
+    base[CHAOS_PARAM_FM_ENVELOPE] = 1.0f / 8;
+    base[CHAOS_PARAM_FM_ALGORITHM] = 1.0f / 10;
+    for (i = CHAOS_PARAM_POST_RGB_SPLIT; i < CHAOS_PARAM_COUNT; i++)
+        base[i] = 0.0f;
+    base[CHAOS_PARAM_M68K_CLOCK] = 0.5f;
+    base[CHAOS_PARAM_Z80_CLOCK] = 0.5f;
+
+    memset(contrib, 0, sizeof(contrib));
+    memset(contrib_frame, 0, sizeof(contrib_frame));
+    for (i = 0; i < CHAOS_PARAM_COUNT; i++)
+        param_update(i);
+}
+
+/* ======================================================================== */
+/* Configuration                                                            */
+/* ======================================================================== */
+
+static void count_mods(void)
+{
+    int i;
+
+    mod_count = 0;
+    line_mods = 0;
+    for (i = 0; i < CHAOS_MOD_MAX; i++)
+    {
+        if (mods[i].config.source == CHAOS_MOD_NONE)
+            continue;
+
+        mod_count = i + 1;
+        if (mods[i].config.flags & CHAOS_MOD_LINE)
+            line_mods++;
+    }
+}
+
+int chaos_mod_set(int slot, int source, int shape, int target, int flags, float rate, float rate2, float depth)
+{
+    chaos_mod_t *m;
+    int old_target;
+
+    if (((unsigned int)slot >= CHAOS_MOD_MAX) || ((unsigned int)target >= CHAOS_PARAM_COUNT) ||
+        ((unsigned int)source > CHAOS_MOD_AUDIO))
+        return 0;
+
+    m = &mods[slot];
+    old_target = m->config.target;
+
+    /* the old settings let go of their parameter right away */
+    if (m->config.source != CHAOS_MOD_NONE)
+    {
+        contrib[old_target] = 0.0f;
+        contrib_frame[old_target] = 0.0f;
+        param_update(old_target);
+    }
+
+    memset(m, 0, sizeof(*m));
+    m->config.source = source;
+    m->config.shape = shape;
+    m->config.target = target;
+    m->config.flags = flags;
+    m->config.rate = rate;
+    m->config.rate2 = rate2;
+    m->config.depth = depth;
+    if (source == CHAOS_MOD_WALK)
+        m->value = 0.5f;
+
+    chaos_record_bytes(CHAOS_RECORD_MOD_SET, slot, &m->config, sizeof(m->config));
+    count_mods();
+    return 1;
+}
+
+int chaos_mod_add(int source, int shape, int target, int flags, float rate, float rate2, float depth)
+{
+    int slot;
+
+    for (slot = 0; slot < CHAOS_MOD_MAX; slot++)
+    {
+        if (mods[slot].config.source == CHAOS_MOD_NONE)
+            return chaos_mod_set(slot, source, shape, target, flags, rate, rate2, depth) ? slot : -1;
+    }
+    return -1;
+}
+
+void chaos_mod_trigger(int slot)
+{
+    if ((unsigned int)slot >= CHAOS_MOD_MAX)
+        return;
+
+    chaos_record_call(CHAOS_RECORD_MOD_TRIGGER, slot, 0, 0, 0);
+    mods[slot].stage = 1;
+}
+
+void chaos_mod_reset(void)
+{
+    int i;
+
+    for (i = 0; i < SINE_SIZE; i++)
+        sine[i] = (float)sin(i * 2.0 * M_PI / SINE_SIZE);
+
+    memset(mods, 0, sizeof(mods));
+    count_mods();
+    defaults();
+}
+
+void chaos_mod_clear(void)
+{
+    chaos_record_call(CHAOS_RECORD_MOD_CLEAR, 0, 0, 0, 0);
+    chaos_mod_reset();
+}
+
+void chaos_param_set(int param, float value)
+{
+    if ((unsigned int)param >= CHAOS_PARAM_COUNT)
+        return;
+
+    chaos_record_call(CHAOS_RECORD_PARAM, param, 0, 0, value);
+    base[param] = value;
+    param_update(param);
+}
+
+float chaos_param_base(int param)
+{
+    return ((unsigned int)param < CHAOS_PARAM_COUNT) ? base[param] : 0.0f;
+}
+
+int chaos_param_save(uint8_t *state)
+{
+    memcpy(state, base, sizeof(base));
+    return sizeof(base);
+}
+
+int chaos_param_load(const uint8_t *state)
+{
+    int i;
+
+    memcpy(base, state, sizeof(base));
+    for (i = 0; i < CHAOS_PARAM_COUNT; i++)
+        param_update(i);
+    return sizeof(base);
+}
+
+const char *chaos_param_name(int param)
+{
+    if ((unsigned int)param >= CHAOS_PARAM_COUNT)
+        return NULL;
+    return (param < CHAOS_FX_COUNT) ? chaos_effect_name(param) : param_names[param - CHAOS_FX_COUNT];
+}
+
+float *chaos_params_ref(void)
+{
+    return chaos_params;
+}
+
+float *chaos_post_params_ref(void)
+{
+    return &chaos_params[CHAOS_PARAM_POST_RGB_SPLIT];
+}
+
+float *chaos_audio_out_params_ref(void)
+{
+    return &chaos_params[CHAOS_PARAM_AUDIO_STUTTER];
+}
+
+/* ======================================================================== */
+/* Evaluation                                                               */
+/* ======================================================================== */
+
+static float lfo(int shape, float phase)
+{
+    switch (shape)
+    {
+        case CHAOS_LFO_TRIANGLE:
+            return 1.0f - 4.0f * fabsf(phase - 0.5f);
+        case CHAOS_LFO_SQUARE:
+            return (phase < 0.5f) ? 1.0f : -1.0f;
+        case CHAOS_LFO_SAW:
+            return 2.0f * phase - 1.0f;
+        default:
+            return sine[(int)(phase * SINE_SIZE) & (SINE_SIZE - 1)];
+    }
+}
+
+static float audio_level(int source)
+{
+    switch (source)
+    {
+        case CHAOS_AUDIO_SRC_RMS:
+            return chaos_audio.rms;
+        case CHAOS_AUDIO_SRC_FM:
+            return chaos_audio.rms_fm;
+        case CHAOS_AUDIO_SRC_PSG:
+            return chaos_audio.rms_psg;
+        case CHAOS_AUDIO_SRC_DAC:
+            return chaos_audio.rms_dac;
+        default:
+            source -= CHAOS_AUDIO_SRC_BAND;
+            return (source < CHAOS_AUDIO_BANDS) ? chaos_audio.bands[source] : 0.0f;
+    }
+}
+
+/* advance a modulator by one frame, returns its output */
+static float mod_step(chaos_mod_t *m)
+{
+    const chaos_mod_config_t *c = &m->config;
+
+    switch (c->source)
+    {
+        case CHAOS_MOD_LFO:
+            m->phase += c->rate;
+            m->phase -= (int)m->phase;
+            if (m->phase < 0.0f)
+                m->phase += 1.0f;
+            m->value = lfo(c->shape, m->phase);
+            break;
+
+        case CHAOS_MOD_ENV:
+            if (c->shape & chaos_audio.key_on)
+                m->stage = 1;
+            if (m->stage == 1)
+            {
+                m->value = (c->rate > 0.0f) ? m->value + c->rate : 1.0f;
+                if (m->value >= 1.0f)
+                {
+                    m->value = 1.0f;
+                    m->stage = 2;
+                }
+            }
+            else if (m->stage == 2)
+            {
+                m->value = (c->rate2 > 0.0f) ? m->value - c->rate2 : 0.0f;
+                if (m->value <= 0.0f)
+                {
+                    m->value = 0.0f;
+                    m->stage = 0;
+                }
+            }
+            break;
+
+        case CHAOS_MOD_WALK:
+            m->value = clamp01(m->value + c->rate * (chaos_rand_below(CHAOS_RNG_MOD, 0x10001) - 0x8000) * (1.0f / 0x8000));
+            break;
+
+        case CHAOS_MOD_AUDIO:
+            m->value = m->value * c->rate2 + clamp01(audio_level(c->shape) * c->rate) * (1.0f - c->rate2);
+            break;
+    }
+    return m->value * c->depth;
+}
+
+void chaos_mod_frame(void)
+{
+    int i;
+
+    if (!mod_count)
+        return;
+
+    for (i = 0; i < mod_count; i++)
+    {
+        contrib[mods[i].config.target] = 0.0f;
+        contrib_frame[mods[i].config.target] = 0.0f;
+    }
+
+    for (i = 0; i < mod_count; i++)
+    {
+        chaos_mod_t *m = &mods[i];
+        float out;
+
+        if (m->config.source == CHAOS_MOD_NONE)
+            continue;
+
+        out = mod_step(m);
+        contrib[m->config.target] += out;
+        if (!(m->config.flags & CHAOS_MOD_LINE))
+            contrib_frame[m->config.target] += out;
+    }
+
+    for (i = 0; i < mod_count; i++)
+    {
+        const chaos_mod_config_t *c = &mods[i].config;
+        int target = c->target;
+
+        param_update(target);
+
+        /* continuous effects, through the queue for their sync point */
+        if ((c->flags & CHAOS_MOD_FIRE) && (target < CHAOS_FX_COUNT) && (chaos_params[target] > 0.0f) &&
+            (chaos_effect_kind(target) != CHAOS_KIND_PERSISTENT))
+        {
+            chaos_cmd_t cmd;
+
+            cmd.op = target;
+            cmd.sync = (chaos_effect_targets(target) & TARGET_VIDEO) ? CHAOS_SYNC_VBLANK : CHAOS_SYNC_FRAME;
+            cmd.line = 0;
+            cmd.intensity = 1.0f;
+            /* not recorded: a replay evaluates the same modulators */
+            chaos_queue_push(&cmd, 0);
+        }
+    }
+}
+
+void chaos_mod_line(int line)
+{
+    float offset;
+    int i;
+
+    if (!line_mods)
+        return;
+
+    /* the LFO phase runs on through the active display */
+    offset = (float)line / (bitmap.viewport.h ? bitmap.viewport.h : 224);
+
+    for (i = 0; i < mod_count; i++)
+    {
+        if (mods[i].config.flags & CHAOS_MOD_LINE)
+            contrib[mods[i].config.target] = contrib_frame[mods[i].config.target];
+    }
+
+    for (i = 0; i < mod_count; i++)
+    {
+        const chaos_mod_t *m = &mods[i];
+
+        if (!(m->config.flags & CHAOS_MOD_LINE))
+            continue;
+
+        if (m->config.source == CHAOS_MOD_LFO)
+        {
+            float phase = m->phase + m->config.rate * offset;
+            phase -= (int)phase;
+            if (phase < 0.0f)
+                phase += 1.0f;
+            contrib[m->config.target] += lfo(m->config.shape, phase) * m->config.depth;
+        }
+        else
+        {
+            contrib[m->config.target] += m->value * m->config.depth;
+        }
+    }
+
+    for (i = 0; i < mod_count; i++)
+    {
+        if (mods[i].config.flags & CHAOS_MOD_LINE)
+            param_update(mods[i].config.target);
+    }
+}
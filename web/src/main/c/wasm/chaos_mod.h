@@ -0,0 +1,142 @@
+#ifndef _CHAOS_MOD_H_
+#define _CHAOS_MOD_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+#include "chaos.h"
+
+/* Chaos parameter automation.
+ *
+ * Effect parameters are floats in chaos_params[], nominally 0..1: each has
+ * a base value (chaos_param_set()) and up to CHAOS_MOD_MAX modulators add
+ * to it. A modulator is an LFO, an envelope, a random walk or an audio
+ * level (chaos_audio.h) scaled by its depth. All of them are evaluated in
+ * one pass at the start of each frame; those flagged CHAOS_MOD_LINE are
+ * evaluated again on the raster event lines (chaos_schedule.h), so effects
+ * scheduled down the screen see the value at their line.
+ *
+ * Parameters 0 to CHAOS_FX_COUNT - 1 are per-effect gains (base 1) that
+ * scale the intensity of each application of the effect. A modulator
+ * flagged CHAOS_MOD_FIRE on an effect gain also fires that effect once per
+ * frame, with the gain as intensity, while the gain is above 0.
+ *
+ * Modulator and parameter changes are recorded in chaos sessions.
+ */
+
+/* Named parameters, after the effect gains */
+enum
+{
+    CHAOS_PARAM_CRAM_CORRUPTION = CHAOS_FX_COUNT, /* persistent CRAM corruption level (0: off) */
+    CHAOS_PARAM_CRAM_RANGE,     /* share of CRAM it hits, from entry 0 */
+    CHAOS_PARAM_FM_CORRUPTION,  /* persistent FM corruption level (0: off) */
+    CHAOS_PARAM_FM_CHANNELS,    /* share of the 6 FM channels it hits */
+    CHAOS_PARAM_FM_FREQ,        /* per channel and frame odds of a frequency write */
+    CHAOS_PARAM_FM_VOLUME,      /* ... of a total level write */
+    CHAOS_PARAM_FM_ENVELOPE,    /* ... of an envelope write */
+    CHAOS_PARAM_FM_ALGORITHM,   /* per frame odds of an algorithm/feedback write */
+    CHAOS_PARAM_POST_RGB_SPLIT, /* presentation effect levels (0: off), in this order */
+    CHAOS_PARAM_POST_TRAILS,
+    CHAOS_PARAM_POST_BLOCK_SMEAR,
+    CHAOS_PARAM_POST_SCANLINE_JITTER,
+    CHAOS_PARAM_AUDIO_STUTTER,  /* audio output effect levels (0: off), in this order */
+    CHAOS_PARAM_AUDIO_REVERSE,
+    CHAOS_PARAM_AUDIO_DECIMATE,
+    CHAOS_PARAM_BUS_NOISE_ROM,  /* bus noise levels (0: off, CHAOS_BUS_NOISE builds), in */
+    CHAOS_PARAM_BUS_NOISE_RAM,  /* the order of the CHAOS_BUS_* regions */
+    CHAOS_PARAM_BUS_NOISE_ZRAM,
+    CHAOS_PARAM_BUS_NOISE_VDP,
+    CHAOS_PARAM_BUS_NOISE_MASK, /* bits flipped by a fault / 65535, 0: one random bit */
+    CHAOS_PARAM_M68K_CLOCK,     /* CPU clock multipliers, 4^(2 * level - 1): 1/4 at 0, */
+    CHAOS_PARAM_Z80_CLOCK,      /* the console's clock at 0.5 (default), 4x at 1 */
+    CHAOS_PARAM_COUNT
+};
+
+/* Sources */
+#define CHAOS_MOD_NONE  0
+#define CHAOS_MOD_LFO   1 /* shape: CHAOS_LFO_*, rate: cycles per frame; -1..1 */
+#define CHAOS_MOD_ENV   2 /* attack/release envelope; rate: 1 / attack frames, rate2: 1 / release
+                             frames; started by chaos_mod_trigger() or by a YM2612 key on of
+                             the channels in shape (bit n = channel n+1); 0..1 */
+#define CHAOS_MOD_WALK  3 /* random walk; rate: largest step per frame; 0..1 */
+#define CHAOS_MOD_AUDIO 4 /* shape: CHAOS_AUDIO_SRC_*, rate: gain, rate2: smoothing (0: none,
+                             towards 1: slower); 0..1 */
+
+/* LFO shapes */
+#define CHAOS_LFO_SINE     0
+#define CHAOS_LFO_TRIANGLE 1
+#define CHAOS_LFO_SQUARE   2
+#define CHAOS_LFO_SAW      3
+
+/* Audio sources: levels, then bands 0 to CHAOS_AUDIO_BANDS - 1 */
+#define CHAOS_AUDIO_SRC_RMS  0
+#define CHAOS_AUDIO_SRC_FM   1
+#define CHAOS_AUDIO_SRC_PSG  2
+#define CHAOS_AUDIO_SRC_DAC  3
+#define CHAOS_AUDIO_SRC_BAND 4
+
+/* Flags */
+#define CHAOS_MOD_LINE 0x01 /* also evaluated on raster event lines */
+#define CHAOS_MOD_FIRE 0x02 /* effect gains: fire the effect every frame */
+
+#define CHAOS_MOD_MAX 16
+
+typedef struct
+{
+    uint8_t source;
+    uint8_t shape;
+    uint8_t target;  /* parameter */
+    uint8_t flags;
+    float rate;
+    float rate2;
+    float depth;
+} chaos_mod_config_t;
+
+extern float chaos_params[CHAOS_PARAM_COUNT];
+
+/* Set modulator 'slot' (source CHAOS_MOD_NONE frees it), its state starts
+ * over; returns 0 if the slot or target is out of range */
+int EMSCRIPTEN_KEEPALIVE chaos_mod_set(int slot, int source, int shape, int target, int flags,
+    float rate, float rate2, float depth);
+
+/* chaos_mod_set() on the first free slot; returns the slot or -1 */
+int EMSCRIPTEN_KEEPALIVE chaos_mod_add(int source, int shape, int target, int flags,
+    float rate, float rate2, float depth);
+
+/* Start an envelope */
+void EMSCRIPTEN_KEEPALIVE chaos_mod_trigger(int slot);
+
+/* Free all modulators, parameters back to their defaults; chaos_mod_reset()
+ * does the same for chaos_reset(), without recording it */
+void EMSCRIPTEN_KEEPALIVE chaos_mod_clear(void);
+void chaos_mod_reset(void);
+
+/* Base value of a parameter */
+void EMSCRIPTEN_KEEPALIVE chaos_param_set(int param, float base);
+float EMSCRIPTEN_KEEPALIVE chaos_param_base(int param);
+
+/* All the bases (chaos_context_save()); return the bytes written / read */
+int chaos_param_save(uint8_t *state);
+int chaos_param_load(const uint8_t *state);
+
+/* Name of a parameter: the effect name for the gains, NULL past the end */
+const char* EMSCRIPTEN_KEEPALIVE chaos_param_name(int param);
+
+/* Current (modulated) values, CHAOS_PARAM_COUNT floats */
+float* EMSCRIPTEN_KEEPALIVE chaos_params_ref(void);
+
+/* Current presentation effect levels, CHAOS_POST_PARAMS floats from
+ * CHAOS_PARAM_POST_RGB_SPLIT on (the presenter's shader uniforms) */
+#define CHAOS_POST_PARAMS 4
+float* EMSCRIPTEN_KEEPALIVE chaos_post_params_ref(void);
+
+/* Current audio output effect levels, CHAOS_AUDIO_OUT_PARAMS floats from
+ * CHAOS_PARAM_AUDIO_STUTTER on (handed to the AudioWorklet with the samples) */
+#define CHAOS_AUDIO_OUT_PARAMS 3
+float* EMSCRIPTEN_KEEPALIVE chaos_audio_out_params_ref(void);
+
+/* Evaluate the modulators for this frame (frame start) and on a raster
+ * event line */
+void chaos_mod_frame(void);
+void chaos_mod_line(int line);
+
+#endif /* _CHAOS_MOD_H_ */
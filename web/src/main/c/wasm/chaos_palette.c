@@ -0,0 +1,154 @@
+/**
+ * ChaosDrive - palette layer
+ *
+ * The effects edit 'dest', 'mask' and 'noise'; refresh() then publishes them
+ * to the tables read by color_update_m5() and pushes the CRAM entries whose
+ * slot or mask changed through it again.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_palette.h"
+#include "chaos_rand.h"
+#include "chaos_undo.h"
+
+#define VISIBLE 60 /* entry 0 of each palette is transparent */
+
+uint8 chaos_palette_on;
+uint8 chaos_palette_dest[64];
+uint16 chaos_palette_xor[64];
+
+static uint8 dest[64];
+static uint16 mask[64];
+static uint16 noise[64];
+
+/* k-th visible entry and back */
+static int visible_index(int k)
+{
+    return ((k / 15) << 4) | ((k % 15) + 1);
+}
+
+static int visible_rank(int index)
+{
+    return (index >> 4) * 15 + (index & 15) - 1;
+}
+
+static void refresh(void)
+{
+    uint8 old_dest[64];
+    uint16 old_xor[64];
+    int i, on = 0;
+
+    memcpy(old_dest, chaos_palette_dest, sizeof(old_dest));
+    memcpy(old_xor, chaos_palette_xor, sizeof(old_xor));
+
+    for (i = 0; i < 64; i++)
+    {
+        chaos_palette_dest[i] = dest[i];
+        chaos_palette_xor[i] = (mask[i] ^ noise[i]) & 0x1FF;
+        on |= (dest[i] != i) || chaos_palette_xor[i];
+    }
+    chaos_palette_on = on;
+
+    for (i = 0; i < 64; i++)
+    {
+        int slot = dest[i];
+
+        if ((i & 0x0F) && ((old_dest[i] != slot) || (old_xor[slot] != chaos_palette_xor[slot])))
+            color_update_m5(i, *(uint16 *)&cram[i << 1] & 0x1FF);
+    }
+
+    /* Backdrop color */
+    if (old_xor[0] != chaos_palette_xor[0])
+        color_update_m5(0x00, *(uint16 *)&cram[(reg[7] & 0x3F) << 1] & 0x1FF);
+}
+
+void chaos_palette_scramble(int count)
+{
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+    while (count-- > 0)
+    {
+        int a = visible_index(chaos_rand_below(CHAOS_RNG_CRAM, VISIBLE));
+        int b = visible_index(chaos_rand_below(CHAOS_RNG_CRAM, VISIBLE));
+        uint8 tmp = dest[a];
+
+        dest[a] = dest[b];
+        dest[b] = tmp;
+    }
+    refresh();
+}
+
+void chaos_palette_rotate(int count)
+{
+    int i;
+
+    count %= VISIBLE;
+    if (count < 0)
+        count += VISIBLE;
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+
+    for (i = 0; i < 64; i++)
+    {
+        if (i & 0x0F)
+            dest[i] = visible_index((visible_rank(dest[i]) + VISIBLE - count) % VISIBLE);
+    }
+    refresh();
+}
+
+void chaos_palette_noise(int count, int range)
+{
+    if (range > 64)
+        range = 64;
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+
+    while (count-- > 0)
+    {
+        int index = chaos_rand_below(CHAOS_RNG_CRAM, range);
+        noise[index] ^= chaos_rand_below(CHAOS_RNG_CRAM, 0x200);
+    }
+    refresh();
+}
+
+void chaos_palette_denoise(void)
+{
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+    memset(noise, 0, sizeof(noise));
+    refresh();
+}
+
+void chaos_palette_mask(int index, int value)
+{
+    if ((unsigned int)index >= 64)
+        return;
+
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+    mask[index] = value & 0x1FF;
+    refresh();
+}
+
+void chaos_palette_clear(void)
+{
+    int i;
+
+    chaos_undo_save(CHAOS_UNDO_PALETTE, 0, 1);
+    for (i = 0; i < 64; i++)
+        dest[i] = i;
+    memset(mask, 0, sizeof(mask));
+    memset(noise, 0, sizeof(noise));
+    refresh();
+}
+
+void chaos_palette_save(uint8 *state)
+{
+    memcpy(state, dest, sizeof(dest));
+    memcpy(state + sizeof(dest), mask, sizeof(mask));
+    memcpy(state + sizeof(dest) + sizeof(mask), noise, sizeof(noise));
+}
+
+void chaos_palette_load(const uint8 *state)
+{
+    memcpy(dest, state, sizeof(dest));
+    memcpy(mask, state + sizeof(dest), sizeof(mask));
+    memcpy(noise, state + sizeof(dest) + sizeof(mask), sizeof(noise));
+    refresh();
+}
@@ -0,0 +1,50 @@
+#ifndef _CHAOS_PALETTE_H_
+#define _CHAOS_PALETTE_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos palette layer.
+ *
+ * A transform between CRAM and the Mode 5 pixel lookup, applied by
+ * color_update_m5(): each CRAM entry is shown in the slot of another one
+ * (a permutation of the 60 visible entries, built from swaps and shifts)
+ * with some of its 9 color bits flipped (explicit XOR masks and the noise of
+ * the persistent CRAM corruption). CRAM itself keeps what the game wrote, so
+ * palette DMA cannot undo the glitch: the game's new colors come through the
+ * same transform. Changing the transform only redoes the lookup entries
+ * whose source or mask changed.
+ *
+ * The layer stays until chaos_palette_clear() (or chaos_reset()).
+ */
+
+/* Renderer side (core/vdp_render.c): whether the layer is not the
+ * identity, slot showing each CRAM entry (0: backdrop) and XOR mask of each
+ * slot */
+extern uint8_t chaos_palette_on;
+extern uint8_t chaos_palette_dest[64];
+extern uint16_t chaos_palette_xor[64];
+
+/* Swap 'count' random pairs of visible entries */
+void chaos_palette_scramble(int count);
+
+/* Show every visible entry 'count' visible slots lower (wraps) */
+void chaos_palette_rotate(int count);
+
+/* Flip random bits of 'count' random slots among the first 'range' ones
+ * (noise, dropped by chaos_palette_denoise()) */
+void chaos_palette_noise(int count, int range);
+void chaos_palette_denoise(void);
+
+/* XOR mask of slot 'index' (0: backdrop), combined with the noise */
+void EMSCRIPTEN_KEEPALIVE chaos_palette_mask(int index, int mask);
+
+/* Back to the identity */
+void EMSCRIPTEN_KEEPALIVE chaos_palette_clear(void);
+
+/* Copy of the layer (CHAOS_PALETTE_STATE_SIZE bytes) and back */
+#define CHAOS_PALETTE_STATE_SIZE (64 + 64 * 2 + 64 * 2)
+void chaos_palette_save(uint8_t *state);
+void chaos_palette_load(const uint8_t *state);
+
+#endif /* _CHAOS_PALETTE_H_ */
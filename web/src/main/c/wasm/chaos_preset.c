@@ -0,0 +1,301 @@
+/**
+ * ChaosDrive - glitch presets
+ *
+ * Captures compare each memory with its baseline in 16-byte blocks
+ * (chaos_kernel_diff()) and only scan the differing blocks byte by byte.
+ * Runs of changed bytes separated by fewer than RUN_GAP unchanged ones are
+ * merged into one record; a run of a single value is stored once.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_dirty.h"
+#include "chaos_kernels.h"
+#include "chaos_preset.h"
+#include "memmap.h"
+
+#define RUN_GAP 6  /* a record header costs 5 bytes */
+#define RUN_MAX 0x7FFF
+
+#define MEM_COUNT 4
+
+typedef struct
+{
+    uint8 data[CHAOS_PRESET_SIZE];
+    int size; /* 0: empty */
+} chaos_preset_t;
+
+static uint8 base_vram[0x10000];
+static uint8 base_cram[0x80];
+static uint8 base_vsram[0x80];
+static uint8 base_reg[0x20];
+static int has_baseline;
+
+static chaos_preset_t presets[CHAOS_PRESET_SLOTS];
+static uint32 sticky;
+
+static uint8 blocks[0x10000 / 16 / 8];
+
+static uint8 *const live_mem[MEM_COUNT] = {vram, cram, vsram, reg};
+static uint8 *const base_mem[MEM_COUNT] = {base_vram, base_cram, base_vsram, base_reg};
+static const int mem_sizes[MEM_COUNT] = {0x10000, 0x80, 0x80, 0x20};
+
+void chaos_preset_baseline(void)
+{
+    int i;
+
+    for (i = 0; i < MEM_COUNT; i++)
+        memcpy(base_mem[i], live_mem[i], mem_sizes[i]);
+    has_baseline = 1;
+}
+
+/* ======================================================================== */
+/* Capture                                                                  */
+/* ======================================================================== */
+
+/* append one record for [start, end) of 'mem'; returns 0 when full */
+static int emit(chaos_preset_t *p, int mem, int start, int end)
+{
+    const uint8 *live = live_mem[mem];
+
+    while (start < end)
+    {
+        int len = (end - start > RUN_MAX) ? RUN_MAX : (end - start);
+        int repeat = 1;
+        int i;
+
+        for (i = 1; (i < len) && repeat; i++)
+            repeat = (live[start + i] == live[start]);
+
+        if (p->size + 5 + (repeat ? 1 : len) + 1 > CHAOS_PRESET_SIZE)
+            return 0;
+
+        p->data[p->size++] = mem;
+        p->data[p->size++] = start & 0xFF;
+        p->data[p->size++] = start >> 8;
+        p->data[p->size++] = len & 0xFF;
+        p->data[p->size++] = (len | (repeat ? CHAOS_PRESET_REPEAT : 0)) >> 8;
+        if (repeat)
+        {
+            p->data[p->size++] = live[start];
+        }
+        else
+        {
+            memcpy(p->data + p->size, live + start, len);
+            p->size += len;
+        }
+        start += len;
+    }
+    return 1;
+}
+
+static int capture_mem(chaos_preset_t *p, int mem)
+{
+    const uint8 *live = live_mem[mem];
+    const uint8 *base = base_mem[mem];
+    int size = mem_sizes[mem];
+    int use_blocks = !(size & 127);
+    int i = 0;
+
+    if (use_blocks && !chaos_kernel_diff(live, base, size, blocks))
+        return 1;
+
+    while (i < size)
+    {
+        int start, end, j;
+
+        /* unchanged 16-byte block */
+        if (use_blocks && !(blocks[i >> 7] & (1 << ((i >> 4) & 7))))
+        {
+            i = (i | 15) + 1;
+            continue;
+        }
+        if (live[i] == base[i])
+        {
+            i++;
+            continue;
+        }
+
+        /* run up to RUN_GAP unchanged bytes */
+        start = i;
+        end = i + 1;
+        for (j = end; (j < size) && (j - end < RUN_GAP); j++)
+        {
+            if (live[j] != base[j])
+                end = j + 1;
+        }
+
+        if (!emit(p, mem, start, end))
+            return 0;
+        i = end;
+    }
+    return 1;
+}
+
+int chaos_preset_capture(int slot)
+{
+    chaos_preset_t *p;
+    int mem;
+
+    if (((unsigned int)slot >= CHAOS_PRESET_SLOTS) || !has_baseline)
+        return 0;
+
+    p = &presets[slot];
+    p->size = 0;
+
+    /* registers first, they decide how the VRAM records are cached */
+    for (mem = MEM_COUNT - 1; mem >= 0; mem--)
+    {
+        if (!capture_mem(p, mem))
+        {
+            p->size = 0;
+            sticky &= ~(1 << slot);
+            return -1;
+        }
+    }
+
+    p->data[p->size++] = CHAOS_PRESET_END;
+    return p->size;
+}
+
+/* ======================================================================== */
+/* Apply                                                                    */
+/* ======================================================================== */
+
+/* walk the records of a patch, writing them when 'write' is set; returns
+   0 if the patch is malformed */
+static int patch(const uint8 *data, int size, int write)
+{
+    uint8 regs[0x20];
+    int pos = 0;
+
+    memcpy(regs, reg, sizeof(regs));
+
+    while (pos < size)
+    {
+        int mem = data[pos];
+        int addr, len, repeat;
+
+        if (mem == CHAOS_PRESET_END)
+            break;
+        if ((mem >= MEM_COUNT) || (pos + 6 > size))
+            return 0;
+
+        addr = data[pos + 1] | (data[pos + 2] << 8);
+        len = data[pos + 3] | (data[pos + 4] << 8);
+        repeat = len & CHAOS_PRESET_REPEAT;
+        len &= RUN_MAX;
+        pos += 5;
+
+        if (!len || (addr + len > mem_sizes[mem]) || (pos + (repeat ? 1 : len) > size))
+            return 0;
+
+        if (write)
+        {
+            /* registers go through the VDP so its derived state follows */
+            uint8 *dst = (mem == CHAOS_PRESET_VDP_REGS) ? regs : live_mem[mem];
+
+            if (repeat)
+                memset(dst + addr, data[pos], len);
+            else
+                memcpy(dst + addr, data + pos, len);
+
+            if (mem == CHAOS_PRESET_VDP_REGS)
+            {
+                /* before the memories (first records) */
+                if (memcmp(regs, reg, sizeof(regs)))
+                {
+                    vdp_restore_regs(regs);
+                    bitmap.viewport.changed |= 2;
+                }
+            }
+            else if (mem == CHAOS_PRESET_VRAM)
+            {
+                chaos_dirty_vram(addr, len);
+            }
+            else if (mem == CHAOS_PRESET_CRAM)
+            {
+                chaos_dirty_cram(addr, len);
+            }
+        }
+        pos += repeat ? 1 : len;
+    }
+
+    return pos < size;
+}
+
+int chaos_preset_apply(int slot)
+{
+    if (((unsigned int)slot >= CHAOS_PRESET_SLOTS) || !presets[slot].size)
+        return 0;
+
+    patch(presets[slot].data, presets[slot].size, 1);
+    return 1;
+}
+
+void chaos_preset_sticky(int slot, int on)
+{
+    if ((unsigned int)slot >= CHAOS_PRESET_SLOTS)
+        return;
+
+    if (on)
+        sticky |= 1 << slot;
+    else
+        sticky &= ~(1 << slot);
+}
+
+void chaos_preset_frame(void)
+{
+    uint32 slots = sticky;
+    int slot;
+
+    for (slot = 0; slots; slot++, slots >>= 1)
+    {
+        if (slots & 1)
+            chaos_preset_apply(slot);
+    }
+}
+
+void chaos_preset_reset(void)
+{
+    sticky = 0;
+}
+
+/* ======================================================================== */
+/* Front-end access                                                         */
+/* ======================================================================== */
+
+uint8_t *chaos_preset_data(int slot)
+{
+    return ((unsigned int)slot < CHAOS_PRESET_SLOTS) ? presets[slot].data : NULL;
+}
+
+int chaos_preset_size(int slot)
+{
+    return ((unsigned int)slot < CHAOS_PRESET_SLOTS) ? presets[slot].size : 0;
+}
+
+int chaos_preset_commit(int slot, int size)
+{
+    chaos_preset_t *p;
+
+    if ((unsigned int)slot >= CHAOS_PRESET_SLOTS)
+        return 0;
+
+    p = &presets[slot];
+    p->size = 0;
+    if ((size <= 0) || (size > CHAOS_PRESET_SIZE) || !patch(p->data, size, 0))
+    {
+        sticky &= ~(1 << slot);
+        return 0;
+    }
+
+    p->size = size;
+    return 1;
+}
+
+void chaos_preset_memory_report(void)
+{
+    memory_region("preset baseline", base_vram, sizeof(base_vram));
+    memory_region("presets", presets, sizeof(presets));
+}
@@ -0,0 +1,68 @@
+#ifndef _CHAOS_PRESET_H_
+#define _CHAOS_PRESET_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Glitch presets: the video corruption of a scene as a patch.
+ *
+ * chaos_preset_baseline() copies VRAM, CRAM, VSRAM and the VDP registers,
+ * typically on a clean frame; after some chaos, chaos_preset_capture()
+ * stores what differs from that copy as run-length records. Applying the
+ * patch writes the records back in one pass, without the effect chain that
+ * produced them or the rest of the machine state (no game progress, works
+ * on another scene). A sticky preset is applied again every frame, after
+ * VBlank DMA, so the game cannot repair it.
+ *
+ * Whatever the game changed between the baseline and the capture is part
+ * of the patch too: capture soon after the glitch.
+ *
+ * Patch (little-endian), records up to a 0xFF byte:
+ *   uint8 memory (CHAOS_PRESET_VRAM...), uint16 address, uint16 length,
+ *   then 'length' bytes, or one byte repeated when bit 15 of the length is
+ *   set
+ * Presets are not recorded in chaos sessions.
+ */
+
+#define CHAOS_PRESET_SLOTS 8
+#define CHAOS_PRESET_SIZE  0x4000 /* largest patch */
+
+/* Memories */
+#define CHAOS_PRESET_VRAM     0
+#define CHAOS_PRESET_CRAM     1
+#define CHAOS_PRESET_VSRAM    2
+#define CHAOS_PRESET_VDP_REGS 3
+
+#define CHAOS_PRESET_END    0xFF
+#define CHAOS_PRESET_REPEAT 0x8000
+
+/* Copy the video state as the baseline of the next captures */
+void EMSCRIPTEN_KEEPALIVE chaos_preset_baseline(void);
+
+/* Store the difference with the baseline in 'slot'; returns the patch size,
+ * 0 without a baseline, -1 if the patch is larger than CHAOS_PRESET_SIZE */
+int EMSCRIPTEN_KEEPALIVE chaos_preset_capture(int slot);
+
+/* Write the patch of 'slot' now; returns 0 if the slot is empty */
+int EMSCRIPTEN_KEEPALIVE chaos_preset_apply(int slot);
+
+/* Apply 'slot' every frame (pre-render hook) while 'on' */
+void EMSCRIPTEN_KEEPALIVE chaos_preset_sticky(int slot, int on);
+
+/* Patch of 'slot' for the front-end to save (chaos_preset_size() bytes), or
+ * to fill and chaos_preset_commit() with its size; commit returns 0 and
+ * empties the slot if the patch is malformed */
+uint8_t* EMSCRIPTEN_KEEPALIVE chaos_preset_data(int slot);
+int EMSCRIPTEN_KEEPALIVE chaos_preset_size(int slot);
+int EMSCRIPTEN_KEEPALIVE chaos_preset_commit(int slot, int size);
+
+/* Sticky presets (pre-render hook) */
+void chaos_preset_frame(void);
+
+/* Drop the sticky presets (chaos_reset(), the patches are kept) */
+void chaos_preset_reset(void);
+
+/* Add the baseline and patches to the memory report */
+void chaos_preset_memory_report(void);
+
+#endif /* _CHAOS_PRESET_H_ */
@@ -0,0 +1,121 @@
+/**
+ * ChaosDrive - chaos command queue
+ *
+ * Commands are moved out of the shared ring at the start of each frame so
+ * JS can keep submitting while the frame runs; the ones waiting for a later
+ * sync point stay in a local list until the core reaches it.
+ */
+
+#include <string.h>
+#include "chaos.h"
+#include "chaos_queue.h"
+#include "chaos_schedule.h"
+#include "chaos_record.h"
+#include "chaos_bind.h"
+#include "chaos_mod.h"
+
+static chaos_queue_t queue;
+
+/* Commands consumed this frame (and fired by the bindings and modulators),
+ * waiting for their sync point */
+static chaos_cmd_t waiting[CHAOS_QUEUE_SIZE + CHAOS_BIND_MAX + CHAOS_MOD_MAX];
+static int waiting_count;
+
+chaos_queue_t *chaos_command_queue(void)
+{
+    return &queue;
+}
+
+int chaos_command_queue_size(void)
+{
+    return CHAOS_QUEUE_SIZE;
+}
+
+static void run_command(const chaos_cmd_t *cmd)
+{
+    if (cmd->op == CHAOS_OP_RESET)
+    {
+        chaos_reset();
+    }
+    else if (cmd->op == CHAOS_OP_PARAM)
+    {
+        chaos_param_set(cmd->line, cmd->intensity);
+    }
+    else
+    {
+        chaos_apply(cmd->op, cmd->intensity);
+    }
+}
+
+void chaos_queue_begin_frame(void)
+{
+    uint32_t head = queue.head;
+    uint32_t tail = queue.tail;
+
+    waiting_count = 0;
+
+    /* producer overran the ring, only the last CHAOS_QUEUE_SIZE commands are valid */
+    if ((head - tail) > CHAOS_QUEUE_SIZE)
+        tail = head - CHAOS_QUEUE_SIZE;
+
+    for (; tail != head; tail++)
+    {
+        const chaos_cmd_t *cmd = &queue.cmd[tail & (CHAOS_QUEUE_SIZE - 1)];
+
+        chaos_record_command(cmd);
+
+        /* line-synced effects go to the raster scheduler for this frame */
+        if ((cmd->sync == CHAOS_SYNC_LINE) && (cmd->op < CHAOS_OP_PARAM))
+        {
+            chaos_schedule_once(cmd->op, cmd->line, cmd->intensity);
+            continue;
+        }
+
+        waiting[waiting_count++] = *cmd;
+    }
+    queue.tail = tail;
+}
+
+void chaos_queue_push(const chaos_cmd_t *cmd, int record)
+{
+    if (waiting_count < (int)(sizeof(waiting) / sizeof(waiting[0])))
+    {
+        if (record)
+            chaos_record_command(cmd);
+        waiting[waiting_count++] = *cmd;
+    }
+}
+
+void chaos_queue_submit(const chaos_cmd_t *cmd)
+{
+    queue.cmd[queue.head & (CHAOS_QUEUE_SIZE - 1)] = *cmd;
+    queue.head = queue.head + 1;
+}
+
+void chaos_queue_run(int sync)
+{
+    int i, n = 0;
+
+    /* apply matching commands in submission order, keep the others */
+    for (i = 0; i < waiting_count; i++)
+    {
+        /* unknown sync points (and line-synced special opcodes) are treated as frame start */
+        int cmd_sync = (waiting[i].sync > CHAOS_SYNC_VBLANK) ? CHAOS_SYNC_FRAME : waiting[i].sync;
+
+        if (cmd_sync == sync)
+        {
+            run_command(&waiting[i]);
+        }
+        else
+        {
+            waiting[n++] = waiting[i];
+        }
+    }
+    waiting_count = n;
+}
+
+void chaos_queue_clear(void)
+{
+    queue.tail = queue.head;
+    waiting_count = 0;
+}
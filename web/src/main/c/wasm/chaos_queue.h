@@ -0,0 +1,68 @@
+#ifndef _CHAOS_QUEUE_H_
+#define _CHAOS_QUEUE_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos command queue.
+ *
+ * A single-producer/single-consumer ring buffer living in WASM memory. The
+ * front-end writes commands at 'head' and bumps it; the core consumes
+ * everything up to 'head' once per frame and applies each command at its
+ * sync point, so effect timing no longer depends on when JS happened to run.
+ *
+ * Layout (little-endian):
+ *   0x00  uint32  head   (written by JS)
+ *   0x04  uint32  tail   (written by the core)
+ *   0x08  chaos_cmd_t cmd[CHAOS_QUEUE_SIZE]
+ */
+
+#define CHAOS_QUEUE_SIZE 256 /* must be a power of 2 */
+
+/* Sync points */
+#define CHAOS_SYNC_FRAME  0 /* start of frame, before the CPUs run */
+#define CHAOS_SYNC_VBLANK 1 /* after VBlank DMA, before the active display */
+#define CHAOS_SYNC_LINE   2 /* before rendering active display line 'line' */
+
+/* Special opcodes (other values are chaos registry effect ids) */
+#define CHAOS_OP_PARAM 0xFE /* base of parameter 'line' (chaos_mod.h) to 'intensity' */
+#define CHAOS_OP_RESET 0xFF
+
+typedef struct
+{
+    uint8_t op;
+    uint8_t sync;
+    uint16_t line;  /* CHAOS_SYNC_LINE, or the parameter of CHAOS_OP_PARAM */
+    float intensity;
+} chaos_cmd_t;
+
+typedef struct
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    chaos_cmd_t cmd[CHAOS_QUEUE_SIZE];
+} chaos_queue_t;
+
+chaos_queue_t* EMSCRIPTEN_KEEPALIVE chaos_command_queue(void);
+int EMSCRIPTEN_KEEPALIVE chaos_command_queue_size(void);
+
+/* Consume submitted commands, chaos_queue_run(CHAOS_SYNC_FRAME) applies
+ * those synced to the frame start */
+void chaos_queue_begin_frame(void);
+
+/* Add a command generated by the core (key bindings, modulators) to this
+ * frame's, after chaos_queue_begin_frame(); 'record': log it in the session
+ * being recorded (not when a replay generates it again) */
+void chaos_queue_push(const chaos_cmd_t *cmd, int record);
+
+/* Submit a command on the front-end's behalf, consumed by the next
+ * chaos_queue_begin_frame() (netplay input) */
+void chaos_queue_submit(const chaos_cmd_t *cmd);
+
+/* Apply consumed commands waiting for 'sync' */
+void chaos_queue_run(int sync);
+
+/* Drop submitted and waiting commands */
+void EMSCRIPTEN_KEEPALIVE chaos_queue_clear(void);
+
+#endif /* _CHAOS_QUEUE_H_ */
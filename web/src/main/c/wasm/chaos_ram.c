@@ -0,0 +1,280 @@
+/**
+ * ChaosDrive - work RAM variable discovery
+ *
+ * The statistics are kept as one 64KB table per field (structure of arrays)
+ * indexed like work_ram[], so a pass over a slice walks them linearly and
+ * the 16-byte blocks found unchanged by chaos_kernel_diff() cost nothing.
+ * Per-slice counters are halved every 255 passes, so the ranking follows
+ * the game from one screen to the next.
+ */
+
+#include "shared.h"
+#include "chaos_kernels.h"
+#include "chaos_ram.h"
+#include "memmap.h"
+
+#define SLICES    CHAOS_RAM_SLICES
+
+/* largest change still counted as a counter step */
+#define STEP_MAX  16
+
+/* changes per 256 passes from which a byte is frame driven (frame counter,
+   RNG seed, stack) rather than a game variable */
+#define CHURN     224
+
+static uint8 prev[0x10000];     /* work_ram[] at the last pass */
+static uint8 changes[0x10000];  /* passes where the byte changed */
+static uint8 with_pad[0x10000]; /* ... while the pad state changed too */
+static int8 trend[0x10000];     /* run of small steps, > 0 up, < 0 down */
+
+static uint8 passes[SLICES];      /* passes since the slice was primed */
+static uint8 pad_passes[SLICES];  /* ... with pad changes */
+static uint16 pad_changed[SLICES]; /* pad bits changed since the last pass */
+static uint16 primed;
+static uint16 last_pad;
+static int slice;
+
+static uint32_t ranked[CHAOS_RAM_CANDIDATES];
+static int ranked_count;
+
+void chaos_ram_clear(void)
+{
+    memset(changes, 0, sizeof(changes));
+    memset(with_pad, 0, sizeof(with_pad));
+    memset(trend, 0, sizeof(trend));
+    memset(passes, 0, sizeof(passes));
+    memset(pad_passes, 0, sizeof(pad_passes));
+    memset(pad_changed, 0, sizeof(pad_changed));
+    primed = 0;
+    last_pad = 0;
+    slice = 0;
+    ranked_count = 0;
+}
+
+void chaos_ram_memory_report(void)
+{
+    memory_region("chaos ram prev", prev, sizeof(prev));
+    memory_region("chaos ram changes", changes, sizeof(changes));
+    memory_region("chaos ram with_pad", with_pad, sizeof(with_pad));
+    memory_region("chaos ram trend", trend, sizeof(trend));
+}
+
+/* 0 (not a candidate) to 255 */
+static int score(int offset, int s)
+{
+    int freq, value, run, conf;
+
+    if (!changes[offset])
+        return 0;
+
+    /* rarity and pad correlation only count fully from 8 changes on */
+    conf = (changes[offset] < 8) ? changes[offset] : 8;
+
+    /* changing now and then, the less often the better */
+    freq = (changes[offset] << 8) / passes[s];
+    if (freq >= CHURN)
+        return 0;
+    value = 32 + ((((CHURN - freq) >> 2) * conf) >> 3);
+
+    /* counters and timers */
+    run = (trend[offset] < 0) ? -trend[offset] : trend[offset];
+    value += ((run > 15) ? 15 : run) * 6;
+
+    /* changes more likely while the player is pressing buttons */
+    if (with_pad[offset])
+    {
+        int corr = (with_pad[offset] << 8) / changes[offset] - (pad_passes[s] << 8) / passes[s];
+        if (corr > 0)
+            value += ((corr >> 1) * conf) >> 3;
+    }
+
+    return (value > 255) ? 255 : value;
+}
+
+static void rank_insert(uint32_t entry)
+{
+    int i;
+
+    if ((ranked_count == CHAOS_RAM_CANDIDATES) && (entry <= ranked[CHAOS_RAM_CANDIDATES - 1]))
+        return;
+
+    if (ranked_count < CHAOS_RAM_CANDIDATES)
+        ranked_count++;
+
+    for (i = ranked_count - 1; (i > 0) && (ranked[i - 1] < entry); i--)
+    {
+        ranked[i] = ranked[i - 1];
+    }
+    ranked[i] = entry;
+}
+
+static void rank_slice(int s)
+{
+    int base = s * CHAOS_RAM_SLICE;
+    int i, j;
+
+    /* replace the entries of this slice */
+    for (i = j = 0; i < ranked_count; i++)
+    {
+        if (((ranked[i] & 0xFFFF) / CHAOS_RAM_SLICE) != s)
+            ranked[j++] = ranked[i];
+    }
+    ranked_count = j;
+
+    for (i = base; i < base + CHAOS_RAM_SLICE; i++)
+    {
+        if (changes[i])
+        {
+            int value = score(i, s);
+            if (value)
+                rank_insert((value << 16) | i);
+        }
+    }
+}
+
+/* halve the slice statistics (runs are kept) */
+static void decay_slice(int s)
+{
+    int i;
+
+    for (i = s * CHAOS_RAM_SLICE; i < (s + 1) * CHAOS_RAM_SLICE; i++)
+    {
+        changes[i] >>= 1;
+        with_pad[i] >>= 1;
+    }
+    passes[s] >>= 1;
+    pad_passes[s] >>= 1;
+}
+
+void chaos_ram_sample(void)
+{
+    uint8 blocks[CHAOS_RAM_SLICE >> 7];
+    int s = slice;
+    int base = s * CHAOS_RAM_SLICE;
+    int pad = input.pad[0];
+    int i, j, active;
+
+    slice = (slice + 1) & (SLICES - 1);
+
+    /* pad changes are seen by the next pass of every slice */
+    if (pad != last_pad)
+    {
+        for (i = 0; i < SLICES; i++)
+        {
+            pad_changed[i] |= pad ^ last_pad;
+        }
+        last_pad = pad;
+    }
+
+    active = (pad_changed[s] != 0);
+    pad_changed[s] = 0;
+
+    /* first pass since clear: only take the reference copy */
+    if (!(primed & (1 << s)))
+    {
+        memcpy(prev + base, work_ram + base, CHAOS_RAM_SLICE);
+        primed |= 1 << s;
+        return;
+    }
+
+    if (passes[s] == 255)
+        decay_slice(s);
+    passes[s]++;
+    pad_passes[s] += active;
+
+    if (chaos_kernel_diff(work_ram + base, prev + base, CHAOS_RAM_SLICE, blocks))
+    {
+        for (i = 0; i < CHAOS_RAM_SLICE; i += 16)
+        {
+            if (!(blocks[i >> 7] & (1 << ((i >> 4) & 7))))
+                continue;
+
+            for (j = base + i; j < base + i + 16; j++)
+            {
+                int step = (int8)(work_ram[j] - prev[j]);
+
+                if (!step)
+                    continue;
+
+                changes[j]++;
+                with_pad[j] += active;
+
+                if ((step > 0) && (step <= STEP_MAX))
+                    trend[j] = (trend[j] > 0) ? ((trend[j] < 127) ? (trend[j] + 1) : 127) : 1;
+                else if ((step < 0) && (step >= -STEP_MAX))
+                    trend[j] = (trend[j] < 0) ? ((trend[j] > -127) ? (trend[j] - 1) : -127) : -1;
+                else
+                    trend[j] = 0;
+
+                prev[j] = work_ram[j];
+            }
+        }
+    }
+
+    rank_slice(s);
+}
+
+int chaos_ram_export(uint8_t *dst)
+{
+    uint8_t *p = dst;
+    int i;
+
+    memcpy(p, passes, SLICES);
+    memcpy(p + SLICES, pad_passes, SLICES);
+    p += SLICES * 2;
+    *p++ = ranked_count;
+    for (i = 0; i < ranked_count; i++)
+    {
+        int offset = ranked[i] & 0xFFFF;
+        *p++ = offset & 0xFF;
+        *p++ = offset >> 8;
+        *p++ = changes[offset];
+        *p++ = with_pad[offset];
+        *p++ = (uint8)trend[offset];
+    }
+    return p - dst;
+}
+
+int chaos_ram_import(const uint8_t *src, int size)
+{
+    const uint8_t *p = src + SLICES * 2;
+    int count, i, s;
+
+    if (size < SLICES * 2 + 1)
+        return 0;
+    count = p[0];
+    if ((count > CHAOS_RAM_CANDIDATES) || (size != SLICES * 2 + 1 + count * 5))
+        return 0;
+
+    memcpy(passes, src, SLICES);
+    memcpy(pad_passes, src + SLICES, SLICES);
+    for (p++, i = 0; i < count; i++, p += 5)
+    {
+        int offset = p[0] | (p[1] << 8);
+
+        /* a slice with no passes has nothing ranked (score() divides by them) */
+        if (!passes[offset / CHAOS_RAM_SLICE] || (p[3] > p[2]))
+            continue;
+        changes[offset] = p[2];
+        with_pad[offset] = p[3];
+        trend[offset] = (int8)p[4];
+    }
+    for (s = 0; s < SLICES; s++)
+    {
+        if (pad_passes[s] > passes[s])
+            pad_passes[s] = passes[s];
+        if (passes[s])
+            rank_slice(s);
+    }
+    return 1;
+}
+
+int chaos_ram_candidate_count(void)
+{
+    return ranked_count;
+}
+
+const uint32_t *chaos_ram_candidates(void)
+{
+    return ranked;
+}
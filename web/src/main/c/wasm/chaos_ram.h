@@ -0,0 +1,50 @@
+#ifndef _CHAOS_RAM_H_
+#define _CHAOS_RAM_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Work RAM variable discovery for the RAM effects.
+ *
+ * Every frame one CHAOS_RAM_SLICE byte slice of work_ram[] is compared with
+ * its copy from the previous pass (16 frames ago), and per-byte statistics
+ * are updated for the bytes that changed: how often they change, runs of
+ * small steps in one direction (counters, timers) and changes seen while the
+ * pad state changed too. The bytes that look like game variables are kept
+ * ranked, and flip_game_logic_variables / critical_ram_scramble aim at them
+ * once enough have been found.
+ *
+ * Offsets are work_ram[] indices, like the chaos effects use (68k address
+ * 0xFF0000 + (offset ^ 1)).
+ */
+
+#define CHAOS_RAM_SLICE      0x1000
+#define CHAOS_RAM_SLICES     (0x10000 / CHAOS_RAM_SLICE)
+#define CHAOS_RAM_CANDIDATES 64
+
+/* Learned profile part (learned.h): pass counters of the slices, then the
+ * candidates with their statistics */
+#define CHAOS_RAM_PROFILE_SIZE (CHAOS_RAM_SLICES * 2 + 1 + CHAOS_RAM_CANDIDATES * 5)
+
+/* Analyse the next slice (called once per frame) */
+void chaos_ram_sample(void);
+
+/* Forget all statistics (new ROM loaded) */
+void chaos_ram_clear(void);
+
+/* Statistics of the ranked candidates into 'dst' (CHAOS_RAM_PROFILE_SIZE
+ * bytes at most); returns the size */
+int chaos_ram_export(uint8_t *dst);
+
+/* Statistics from chaos_ram_export() back after chaos_ram_clear(), ranked
+ * at once; returns 0 if they do not look like an export */
+int chaos_ram_import(const uint8_t *src, int size);
+
+/* Add the statistics to the memory report */
+void chaos_ram_memory_report(void);
+
+/* Ranked candidates, best first: (score << 16) | offset; returns their count */
+int EMSCRIPTEN_KEEPALIVE chaos_ram_candidate_count(void);
+const uint32_t* EMSCRIPTEN_KEEPALIVE chaos_ram_candidates(void);
+
+#endif /* _CHAOS_RAM_H_ */
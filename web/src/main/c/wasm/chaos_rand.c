@@ -0,0 +1,51 @@
+/**
+ * ChaosDrive - seedable PRNG streams
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_rand.h"
+
+uint32 chaos_rng_state[CHAOS_RNG_STREAMS][4];
+
+/* splitmix32, used to expand the seed into non-zero stream states */
+static uint32 splitmix32(uint32 *x)
+{
+    uint32 z = (*x += 0x9E3779B9);
+    z = (z ^ (z >> 16)) * 0x85EBCA6B;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35;
+    return z ^ (z >> 16);
+}
+
+void chaos_seed(uint32 seed)
+{
+    int i, j;
+    uint32 x = seed;
+
+    for (i = 0; i < CHAOS_RNG_STREAMS; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            chaos_rng_state[i][j] = splitmix32(&x);
+        }
+
+        /* all-zero state would lock the generator */
+        if (!(chaos_rng_state[i][0] | chaos_rng_state[i][1] | chaos_rng_state[i][2] | chaos_rng_state[i][3]))
+            chaos_rng_state[i][0] = 1;
+    }
+}
+
+void chaos_rand_fill(int stream, uint8 *buf, int len)
+{
+    for (; len >= 4; len -= 4, buf += 4)
+    {
+        uint32 r = chaos_rand(stream);
+        memcpy(buf, &r, 4);
+    }
+
+    if (len > 0)
+    {
+        uint32 r = chaos_rand(stream);
+        memcpy(buf, &r, len);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef _CHAOS_RAND_H_
+#define _CHAOS_RAND_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Seedable PRNG for chaos effects (xoshiro128**).
+ *
+ * Each subsystem draws from its own stream so that, for a given seed and
+ * input sequence, a glitch session replays exactly and one kind of effect
+ * does not shift the random sequence seen by another.
+ */
+
+/* Streams */
+#define CHAOS_RNG_VRAM  0 /* VRAM, sprite table */
+#define CHAOS_RNG_CRAM  1 /* palette */
+#define CHAOS_RNG_VDP   2 /* VSRAM, H-scroll, VDP registers */
+#define CHAOS_RNG_AUDIO 3 /* FM, PSG, Z80 RAM */
+#define CHAOS_RNG_CPU   4 /* 68K RAM & registers, cartridge ROM */
+#define CHAOS_RNG_MOD   5 /* random walk modulators */
+#define CHAOS_RNG_VM    6 /* user programs */
+#define CHAOS_RNG_STREAMS 7
+
+extern uint32 chaos_rng_state[CHAOS_RNG_STREAMS][4];
+
+/* (Re)seed all streams */
+void EMSCRIPTEN_KEEPALIVE chaos_seed(uint32 seed);
+
+/* Fill 'len' bytes of 'buf' with random data */
+void chaos_rand_fill(int stream, uint8 *buf, int len);
+
+/* Next 32-bit value from 'stream' */
+INLINE uint32 chaos_rand(int stream)
+{
+    uint32 *s = chaos_rng_state[stream];
+    uint32 result = s[1] * 5;
+    uint32 t = s[1] << 9;
+
+    result = ((result << 7) | (result >> 25)) * 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+
+    return result;
+}
+
+/* Uniform value in [0, n), drop-in for rand() % n */
+INLINE int chaos_rand_below(int stream, int n)
+{
+    return (int)(((uint64_t)chaos_rand(stream) * (uint32)n) >> 32);
+}
+
+#endif /* _CHAOS_RAND_H_ */
@@ -0,0 +1,573 @@
+/**
+ * ChaosDrive - chaos session recording and replay
+ *
+ * Most frames only end: they are counted and written as one run byte, and a
+ * pad is only written when it changes, so an idle minute costs a few bytes.
+ * Replay pushes the recorded commands into the command queue at the start
+ * of their frame (live ones are dropped meanwhile), so they go through the
+ * same sync points and raster scheduler as when they were recorded.
+ *
+ * The state hash covers what a session desync shows up in quickly: RAM,
+ * video memory, the 68k registers and the chaos generators.
+ */
+
+#include "shared.h"
+#include "chaos.h"
+#include "chaos_rand.h"
+#include "chaos_checkpoint.h"
+#include "chaos_mod.h"
+#include "chaos_schedule.h"
+#include "chaos_undo.h"
+#include "chaos_vm.h"
+#include "chaos_record.h"
+
+#define TAG_RUN_MAX 0x80
+#define TAG_PAD     0x80
+#define TAG_COMMAND 0x88
+#define TAG_END     0xFF
+
+#define SYNC_INTENSITY 0x80
+
+static int mode;
+static int in_frame;
+static int frames;
+static int run;
+static int handle_base;
+
+/* recording */
+static uint8_t *record;
+static int record_size;
+static int record_used;
+static int record_taken;
+static int record_chunk;
+static uint16 last_pad[MAX_INPUTS];
+
+/* replay */
+static uint8_t *replay;
+static int replay_size;
+static int replay_pos;
+static int replay_live;
+static int replay_desync = -1;
+static uint16 replay_pad[MAX_INPUTS];
+
+static uint32_t state_hash(void)
+{
+    uint32_t hash = crc32(0, work_ram, sizeof(work_ram));
+
+    hash = crc32(hash, zram, sizeof(zram));
+    hash = crc32(hash, vram, sizeof(vram));
+    hash = crc32(hash, cram, sizeof(cram));
+    hash = crc32(hash, vsram, sizeof(vsram));
+    hash = crc32(hash, reg, sizeof(reg));
+    hash = crc32(hash, (const uint8 *)m68k.dar, sizeof(m68k.dar));
+    hash = crc32(hash, (const uint8 *)&m68k.pc, sizeof(m68k.pc));
+    return crc32(hash, (const uint8 *)chaos_rng_state, sizeof(chaos_rng_state));
+}
+
+static void put(const void *data, int len)
+{
+    if (record_used + len > record_size)
+    {
+        int size = record_size ? record_size * 2 : 0x1000;
+        uint8_t *grown = realloc(record, size);
+
+        if (!grown)
+        {
+            /* out of memory: the recording is dropped */
+            mode = CHAOS_RECORD_IDLE;
+            record_used = 0;
+            return;
+        }
+        record = grown;
+        record_size = size;
+    }
+    memcpy(record + record_used, data, len);
+    record_used += len;
+}
+
+static void put8(int value)
+{
+    uint8_t v = value;
+    put(&v, 1);
+}
+
+static void put16(int value)
+{
+    uint8_t v[2] = { value & 0xFF, (value >> 8) & 0xFF };
+    put(v, 2);
+}
+
+static void put32(uint32_t value)
+{
+    uint8_t v[4] = { value & 0xFF, (value >> 8) & 0xFF, (value >> 16) & 0xFF, value >> 24 };
+    put(v, 4);
+}
+
+static void put_float(float value)
+{
+    put(&value, 4);
+}
+
+static void flush_run(void)
+{
+    if (run)
+    {
+        put8(run - 1);
+        run = 0;
+    }
+}
+
+void chaos_record_begin(uint32_t seed, uint32_t rom_crc, int idle_skip)
+{
+    chaos_record_header_t header;
+
+    chaos_record_stop();
+
+    memset(&header, 0, sizeof(header));
+    header.magic = CHAOS_RECORD_MAGIC;
+    header.version = CHAOS_RECORD_VERSION;
+    header.idle_skip = idle_skip;
+    header.rom_crc = rom_crc;
+    header.seed = seed;
+
+    record_used = 0;
+    record_taken = 0;
+    record_chunk = 0;
+    memset(last_pad, 0, sizeof(last_pad));
+    handle_base = chaos_schedule_next_handle();
+    frames = 0;
+    run = 0;
+    in_frame = 0;
+    mode = CHAOS_RECORD_ACTIVE;
+    put(&header, sizeof(header));
+}
+
+const chaos_record_header_t *chaos_replay_header(void)
+{
+    const chaos_record_header_t *header = (const chaos_record_header_t *)replay;
+
+    if (!replay || (replay_size < (int)sizeof(*header)) ||
+        (header->magic != CHAOS_RECORD_MAGIC) || (header->version != CHAOS_RECORD_VERSION))
+        return NULL;
+
+    return header;
+}
+
+int chaos_replay_begin(void)
+{
+    chaos_record_stop();
+
+    if (!chaos_replay_header())
+        return 0;
+
+    replay_pos = sizeof(chaos_record_header_t);
+    replay_desync = -1;
+    memset(replay_pad, 0, sizeof(replay_pad));
+    handle_base = chaos_schedule_next_handle();
+    frames = 0;
+    run = 0;
+    in_frame = 0;
+    mode = CHAOS_RECORD_REPLAY;
+    return 1;
+}
+
+int chaos_record_stop(void)
+{
+    if (mode != CHAOS_RECORD_ACTIVE)
+    {
+        mode = CHAOS_RECORD_IDLE;
+        return 0;
+    }
+
+    flush_run();
+    put8(TAG_END);
+    if (mode != CHAOS_RECORD_ACTIVE)
+        return 0;
+    mode = CHAOS_RECORD_IDLE;
+
+    ((chaos_record_header_t *)record)->frames = frames;
+    return record_used;
+}
+
+int chaos_record_mode(void)
+{
+    return mode;
+}
+
+int chaos_record_frame(void)
+{
+    return frames;
+}
+
+const uint8_t *chaos_record_data(void)
+{
+    return record;
+}
+
+int chaos_record_take(void)
+{
+    /* the frames counted so far go in this chunk */
+    if (mode == CHAOS_RECORD_ACTIVE)
+        flush_run();
+
+    record_chunk = record_taken;
+    record_taken = record_used;
+    return record_taken - record_chunk;
+}
+
+const uint8_t *chaos_record_chunk(void)
+{
+    return record + record_chunk;
+}
+
+uint8_t *chaos_replay_buffer(int size)
+{
+    if (mode == CHAOS_RECORD_REPLAY)
+        chaos_record_stop();
+    replay_live = 0;
+
+    if (size > replay_size)
+    {
+        uint8_t *grown = realloc(replay, size);
+        if (!grown)
+            return NULL;
+        replay = grown;
+    }
+    replay_size = size;
+    return replay;
+}
+
+uint8_t *chaos_replay_append(int size)
+{
+    uint8_t *grown = realloc(replay, replay_size + size);
+
+    if (!grown)
+        return NULL;
+    replay = grown;
+    replay_size += size;
+    return replay + replay_size - size;
+}
+
+void chaos_replay_live(int on)
+{
+    replay_live = on;
+}
+
+int chaos_replay_desync(void)
+{
+    return replay_desync;
+}
+
+/* ======================================================================== */
+/* Replay                                                                   */
+/* ======================================================================== */
+
+static int get8(void)
+{
+    return (replay_pos < replay_size) ? replay[replay_pos++] : TAG_END;
+}
+
+static int get16(void)
+{
+    int value = get8();
+    return value | (get8() << 8);
+}
+
+static uint32_t get32(void)
+{
+    uint32_t value = get16();
+    return value | ((uint32_t)get16() << 16);
+}
+
+static float get_float(void)
+{
+    float value = 1.0f;
+
+    if (replay_pos + 4 <= replay_size)
+        memcpy(&value, replay + replay_pos, 4);
+    replay_pos += 4;
+    return value;
+}
+
+static void get(void *data, int len)
+{
+    memset(data, 0, len);
+    if (replay_pos + len <= replay_size)
+        memcpy(data, replay + replay_pos, len);
+    replay_pos += len;
+}
+
+static void replay_command(void)
+{
+    chaos_queue_t *queue = chaos_command_queue();
+    chaos_cmd_t *cmd = &queue->cmd[queue->head & (CHAOS_QUEUE_SIZE - 1)];
+    int sync;
+
+    cmd->op = get8();
+    sync = get8();
+    cmd->sync = sync & ~SYNC_INTENSITY;
+    cmd->line = ((cmd->sync == CHAOS_SYNC_LINE) || (cmd->op == CHAOS_OP_PARAM)) ? get16() : 0;
+    cmd->intensity = (sync & SYNC_INTENSITY) ? get_float() : 1.0f;
+    queue->head++;
+}
+
+/* events up to the end of this frame */
+static void replay_events(void)
+{
+    while (!run)
+    {
+        int tag = get8();
+
+        if (tag < TAG_RUN_MAX)
+        {
+            run = tag + 1;
+        }
+        else if (tag < TAG_COMMAND)
+        {
+            replay_pad[tag & (MAX_INPUTS - 1)] = get16();
+        }
+        else
+        {
+            switch (tag)
+            {
+                case TAG_COMMAND:
+                    replay_command();
+                    break;
+
+                case CHAOS_RECORD_CHECKPOINT:
+                    chaos_checkpoint();
+                    break;
+
+                case CHAOS_RECORD_RESTORE:
+                    chaos_restore();
+                    break;
+
+                case CHAOS_RECORD_SCHEDULE:
+                {
+                    int id = get8();
+                    int line = get16();
+                    int every = get16();
+                    chaos_schedule(id, line, every, get_float());
+                    break;
+                }
+
+                case CHAOS_RECORD_UNSCHEDULE:
+                    chaos_unschedule((handle_base + get32()) & 0x7FFFFFFF);
+                    break;
+
+                case CHAOS_RECORD_AT_CYCLE:
+                {
+                    int id = get8();
+                    int cycle = get32();
+                    int repeat = get8();
+                    chaos_at_cycle(id, cycle, repeat, get_float());
+                    break;
+                }
+
+                case CHAOS_RECORD_CLEAR:
+                    chaos_schedule_clear();
+                    break;
+
+                case CHAOS_RECORD_UNDO:
+                    chaos_undo(get8());
+                    break;
+
+                case CHAOS_RECORD_SPREAD:
+                {
+                    int id = get8();
+                    chaos_set_spread(id, get8());
+                    break;
+                }
+
+                case CHAOS_RECORD_MOD_SET:
+                {
+                    chaos_mod_config_t config;
+                    int slot = get8();
+                    get(&config, sizeof(config));
+                    chaos_mod_set(slot, config.source, config.shape, config.target, config.flags,
+                        config.rate, config.rate2, config.depth);
+                    break;
+                }
+
+                case CHAOS_RECORD_MOD_TRIGGER:
+                    chaos_mod_trigger(get8());
+                    break;
+
+                case CHAOS_RECORD_MOD_CLEAR:
+                    chaos_mod_clear();
+                    break;
+
+                case CHAOS_RECORD_PARAM:
+                {
+                    int param = get8();
+                    chaos_param_set(param, get_float());
+                    break;
+                }
+
+                case CHAOS_RECORD_VM_LOAD:
+                {
+                    uint8_t *staging = chaos_vm_buffer();
+                    int slot = get8();
+                    int count = get16();
+                    if (count > CHAOS_VM_CODE_MAX)
+                    {
+                        mode = CHAOS_RECORD_IDLE;
+                        return;
+                    }
+                    staging[0] = count;
+                    staging[1] = count >> 8;
+                    get(staging + 2, count * 4);
+                    chaos_vm_load(slot);
+                    break;
+                }
+
+                case CHAOS_RECORD_HASH:
+                    if ((get32() != state_hash()) && (replay_desync < 0))
+                        replay_desync = frames;
+                    break;
+
+                default:
+                    /* truncated or unknown: stop here */
+                    mode = CHAOS_RECORD_IDLE;
+                    return;
+            }
+        }
+    }
+}
+
+/* ======================================================================== */
+/* Hooks                                                                    */
+/* ======================================================================== */
+
+void chaos_record_frame_begin(void)
+{
+    in_frame = 1;
+
+    if (mode == CHAOS_RECORD_REPLAY)
+    {
+        chaos_queue_clear();
+        if (!run)
+            replay_events();
+    }
+    else if ((mode == CHAOS_RECORD_ACTIVE) && frames && !(frames % CHAOS_RECORD_HASH_FRAMES))
+    {
+        flush_run();
+        put8(CHAOS_RECORD_HASH);
+        put32(state_hash());
+    }
+}
+
+void chaos_record_input(void)
+{
+    int i;
+
+    if (mode == CHAOS_RECORD_REPLAY)
+    {
+        for (i = 0; i < MAX_INPUTS; i++)
+        {
+            input.pad[i] = replay_pad[i];
+        }
+    }
+    else if (mode == CHAOS_RECORD_ACTIVE)
+    {
+        for (i = 0; i < MAX_INPUTS; i++)
+        {
+            if (input.pad[i] != last_pad[i])
+            {
+                flush_run();
+                put8(TAG_PAD | i);
+                put16(input.pad[i]);
+                last_pad[i] = input.pad[i];
+            }
+        }
+    }
+}
+
+void chaos_record_frame_end(void)
+{
+    in_frame = 0;
+
+    if (mode == CHAOS_RECORD_ACTIVE)
+    {
+        frames++;
+        if (++run == TAG_RUN_MAX)
+            flush_run();
+    }
+    else if (mode == CHAOS_RECORD_REPLAY)
+    {
+        frames++;
+
+        /* the front-end has control again from the frame after the last one */
+        if (!--run && ((replay_pos >= replay_size) ? !replay_live : (replay[replay_pos] == TAG_END)))
+            mode = CHAOS_RECORD_IDLE;
+    }
+}
+
+void chaos_record_command(const chaos_cmd_t *cmd)
+{
+    int explicit = (cmd->intensity != 1.0f);
+
+    if (mode != CHAOS_RECORD_ACTIVE)
+        return;
+
+    flush_run();
+    put8(TAG_COMMAND);
+    put8(cmd->op);
+    put8(cmd->sync | (explicit ? SYNC_INTENSITY : 0));
+    if ((cmd->sync == CHAOS_SYNC_LINE) || (cmd->op == CHAOS_OP_PARAM))
+        put16(cmd->line);
+    if (explicit)
+        put_float(cmd->intensity);
+}
+
+void chaos_record_call(int tag, int id, int line, int every, float intensity)
+{
+    if ((mode != CHAOS_RECORD_ACTIVE) || in_frame)
+        return;
+
+    flush_run();
+    put8(tag);
+    if (tag == CHAOS_RECORD_SCHEDULE)
+    {
+        put8(id);
+        put16(line);
+        put16(every);
+        put_float(intensity);
+    }
+    else if (tag == CHAOS_RECORD_UNSCHEDULE)
+    {
+        put32((id - handle_base) & 0x7FFFFFFF);
+    }
+    else if (tag == CHAOS_RECORD_AT_CYCLE)
+    {
+        put8(id);
+        put32(line);
+        put8(every);
+        put_float(intensity);
+    }
+    else if (tag == CHAOS_RECORD_SPREAD)
+    {
+        put8(id);
+        put8(line);
+    }
+    else if ((tag == CHAOS_RECORD_MOD_TRIGGER) || (tag == CHAOS_RECORD_UNDO))
+    {
+        put8(id);
+    }
+    else if (tag == CHAOS_RECORD_PARAM)
+    {
+        put8(id);
+        put_float(intensity);
+    }
+}
+
+void chaos_record_bytes(int tag, int id, const void *data, int len)
+{
+    if ((mode != CHAOS_RECORD_ACTIVE) || in_frame)
+        return;
+
+    flush_run();
+    put8(tag);
+    put8(id);
+    put(data, len);
+}
@@ -0,0 +1,142 @@
+#ifndef _CHAOS_RECORD_H_
+#define _CHAOS_RECORD_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+#include "chaos_queue.h"
+
+/* Chaos session recording and replay.
+ *
+ * A recording starts from a reset with a known chaos seed (record_start()
+ * in wasm.c) and logs, per frame, the input.pad[] changes, every chaos
+ * command consumed from the queue (op, sync point, line, intensity) and the
+ * chaos calls the front-end makes between frames (checkpoint, restore,
+ * raster schedules and cycle timers). Replaying the stream from the same reset and seed runs
+ * the same session, so a glitch recipe is a few hundred bytes.
+ *
+ * Stream (little-endian): a header, then one byte tag per event:
+ *   0x00-0x7F  n + 1 frames end (no more events in them)
+ *   0x80-0x87  input.pad[tag & 7] = uint16
+ *   0x88       queue command: uint8 op, uint8 sync (bit 7: intensity
+ *              follows, 1.0 otherwise), [uint16 line, for CHAOS_SYNC_LINE
+ *              and CHAOS_OP_PARAM], [float intensity]
+ *   0x89       chaos_checkpoint()
+ *   0x8A       chaos_restore()
+ *   0x8B       chaos_schedule(): uint8 id, uint16 line, uint16 every, float
+ *   0x8C       chaos_unschedule(): uint32 handle, counted from the first
+ *              handle of the session
+ *   0x8D       chaos_schedule_clear()
+ *   0x8E       chaos_set_spread(): uint8 id, uint8 frames
+ *   0x8F       chaos_mod_set(): uint8 slot, chaos_mod_config_t (16 bytes)
+ *   0x90       chaos_mod_trigger(): uint8 slot
+ *   0x91       chaos_mod_clear()
+ *   0x92       chaos_param_set(): uint8 param, float base
+ *   0x93       chaos_vm_load(): uint8 slot, uint16 count, count 4-byte
+ *              instructions
+ *   0x94       uint32 hash of the state at the start of the frame, every
+ *              CHAOS_RECORD_HASH_FRAMES frames
+ *   0x95       chaos_at_cycle(): uint8 id, uint32 cycle, uint8 repeat, float
+ *   0x96       chaos_undo(): uint8 count
+ *   0xFF       end
+ * Events of a frame come before its end; calls made between two frames
+ * belong to the next one and are replayed at its start.
+ *
+ * The stream can also be sent while it is recorded (broadcast.js):
+ * chaos_record_take() hands out what was recorded since the last take, a
+ * viewer appends it to its replay with chaos_replay_append() and runs the
+ * frames it has. The replay compares the state hashes with its own and
+ * remembers the first frame that differed (chaos_replay_desync()).
+ */
+
+#define CHAOS_RECORD_MAGIC   0x4D524443 /* "CDRM" */
+#define CHAOS_RECORD_VERSION 1
+
+typedef struct
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t idle_skip;  /* config.idle_skip of the session */
+    uint16_t reserved;
+    uint32_t rom_crc;
+    uint32_t seed;      /* chaos_seed() at the reset */
+    uint32_t frames;    /* set when the recording stops */
+} chaos_record_header_t;
+
+#define CHAOS_RECORD_HASH_FRAMES 300
+
+#define CHAOS_RECORD_IDLE   0
+#define CHAOS_RECORD_ACTIVE 1
+#define CHAOS_RECORD_REPLAY 2
+
+/* Begin a recording; the system must have just been reset and seeded */
+void chaos_record_begin(uint32_t seed, uint32_t rom_crc, int idle_skip);
+
+/* Begin replaying the stream in chaos_replay_buffer(), after the same
+ * reset; returns 0 if the stream header is not valid */
+int chaos_replay_begin(void);
+
+/* End the recording or replay; returns the recording size in bytes (0 when
+ * nothing was recorded) */
+int EMSCRIPTEN_KEEPALIVE chaos_record_stop(void);
+
+/* CHAOS_RECORD_IDLE/ACTIVE/REPLAY */
+int EMSCRIPTEN_KEEPALIVE chaos_record_mode(void);
+
+/* Frames recorded or replayed so far */
+int EMSCRIPTEN_KEEPALIVE chaos_record_frame(void);
+
+/* Recording, valid after chaos_record_stop() until the next recording */
+const uint8_t* EMSCRIPTEN_KEEPALIVE chaos_record_data(void);
+
+/* Bytes recorded since the last take, at chaos_record_chunk(); frames
+ * recorded so far are complete in them. Also takes the end of a stopped
+ * recording. */
+int EMSCRIPTEN_KEEPALIVE chaos_record_take(void);
+const uint8_t* EMSCRIPTEN_KEEPALIVE chaos_record_chunk(void);
+
+/* Buffer for a stream to replay ('size' bytes), NULL if out of memory */
+uint8_t* EMSCRIPTEN_KEEPALIVE chaos_replay_buffer(int size);
+
+/* Room for 'size' more bytes at the end of the stream being replayed, NULL
+ * if out of memory */
+uint8_t* EMSCRIPTEN_KEEPALIVE chaos_replay_append(int size);
+
+/* While 'on', more of the stream is coming: the replay does not end when it
+ * runs out of data, only at the end tag. The front end must not run frames
+ * it does not have yet. */
+void EMSCRIPTEN_KEEPALIVE chaos_replay_live(int on);
+
+/* First frame whose state hash differed from the recorded one, -1 while the
+ * replay is in sync */
+int EMSCRIPTEN_KEEPALIVE chaos_replay_desync(void);
+
+/* Header of the stream in chaos_replay_buffer() */
+const chaos_record_header_t *chaos_replay_header(void);
+
+/* Frame hooks (wasm.c frame loop and input update) */
+void chaos_record_frame_begin(void);
+void chaos_record_input(void);
+void chaos_record_frame_end(void);
+
+/* Event hooks: commands as they are consumed, front-end calls as they are
+ * made (calls from inside a frame are ignored, they replay by themselves) */
+void chaos_record_command(const chaos_cmd_t *cmd);
+void chaos_record_call(int tag, int id, int line, int every, float intensity);
+void chaos_record_bytes(int tag, int id, const void *data, int len);
+
+#define CHAOS_RECORD_CHECKPOINT 0x89
+#define CHAOS_RECORD_RESTORE    0x8A
+#define CHAOS_RECORD_SCHEDULE   0x8B
+#define CHAOS_RECORD_UNSCHEDULE 0x8C
+#define CHAOS_RECORD_CLEAR      0x8D
+#define CHAOS_RECORD_SPREAD     0x8E
+#define CHAOS_RECORD_MOD_SET    0x8F
+#define CHAOS_RECORD_MOD_TRIGGER 0x90
+#define CHAOS_RECORD_MOD_CLEAR  0x91
+#define CHAOS_RECORD_PARAM      0x92
+#define CHAOS_RECORD_VM_LOAD    0x93
+#define CHAOS_RECORD_HASH       0x94
+#define CHAOS_RECORD_AT_CYCLE   0x95
+#define CHAOS_RECORD_UNDO       0x96
+
+#endif /* _CHAOS_RECORD_H_ */
@@ -0,0 +1,114 @@
+/**
+ * ChaosDrive - copy-on-write cartridge ROM
+ *
+ * A clone is mapped by rewriting the base of the 68k memory map entries
+ * that point at its bank, so reads, DMA and the Z80 bank window see it with
+ * no extra cost per access. Clones are outside the area the 68k decode
+ * cache treats as read-only (m68k_cache_set_rom()), so their code is always
+ * decoded again and nothing needs flushing either way.
+ */
+
+#include "shared.h"
+#include "chaos_rom.h"
+#include "memmap.h"
+
+#define BANK_SHIFT 16
+#define BANKS      (MAXROMSIZE >> BANK_SHIFT)
+
+static uint8 clones[CHAOS_ROM_CLONES][1 << BANK_SHIFT];
+static int16 clone_bank[CHAOS_ROM_CLONES]; /* bank held by each clone */
+static uint8 bank_clone[BANKS];            /* clone + 1 of each bank, 0: none */
+static int clone_count;
+
+static int rom_banks(void)
+{
+    if (system_hw != SYSTEM_MD)
+        return 0;
+    return (cart.romsize + (1 << BANK_SHIFT) - 1) >> BANK_SHIFT;
+}
+
+/* Point the memory map entries showing bank 'from' of cart.rom or a clone
+   at 'to' */
+static void remap(const uint8 *from, uint8 *to)
+{
+    int i;
+
+    for (i = 0; i < 0x100; i++)
+    {
+        if (m68k.memory_map[i].base == from)
+            m68k.memory_map[i].base = to;
+    }
+}
+
+uint8 *chaos_rom_byte(int offset)
+{
+    int bank = offset >> BANK_SHIFT;
+    int clone;
+
+    if ((unsigned int)offset >= cart.romsize || bank >= rom_banks())
+        return NULL;
+
+    if (!bank_clone[bank])
+    {
+        if (clone_count == CHAOS_ROM_CLONES)
+            return NULL;
+
+        clone = clone_count++;
+        memcpy(clones[clone], cart.rom + (bank << BANK_SHIFT), 1 << BANK_SHIFT);
+        clone_bank[clone] = bank;
+        bank_clone[bank] = clone + 1;
+        remap(cart.rom + (bank << BANK_SHIFT), clones[clone]);
+    }
+
+    return &clones[bank_clone[bank] - 1][offset & ((1 << BANK_SHIFT) - 1)];
+}
+
+int chaos_rom_code_pages(uint16_t *pages)
+{
+    const unsigned char *bits = m68k_cache_pages();
+    int page, count = 0;
+    int end = rom_banks() << (BANK_SHIFT - M68K_CACHE_PAGE_SHIFT);
+
+    if (!bits)
+        return 0;
+
+    for (page = 0; page < end; page++)
+    {
+        if ((bits[page >> 3] >> (page & 7)) & 1)
+            pages[count++] = page;
+    }
+    return count;
+}
+
+void chaos_rom_frame(void)
+{
+    int i;
+
+    for (i = 0; i < clone_count; i++)
+        remap(cart.rom + (clone_bank[i] << BANK_SHIFT), clones[i]);
+}
+
+void chaos_rom_restore(void)
+{
+    int i;
+
+    for (i = 0; i < clone_count; i++)
+        remap(clones[i], cart.rom + (clone_bank[i] << BANK_SHIFT));
+    chaos_rom_clear();
+}
+
+int chaos_rom_clone_count(void)
+{
+    return clone_count;
+}
+
+void chaos_rom_clear(void)
+{
+    memset(bank_clone, 0, sizeof(bank_clone));
+    clone_count = 0;
+}
+
+void chaos_rom_memory_report(void)
+{
+    memory_region("chaos rom clones", clones, sizeof(clones));
+}
@@ -0,0 +1,50 @@
+#ifndef _CHAOS_ROM_H_
+#define _CHAOS_ROM_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Cartridge ROM corruption through copy-on-write banks.
+ *
+ * cart.rom itself is never written. The first corruption of a 64KB bank
+ * (the granularity of the 68k memory map) copies it to one of
+ * CHAOS_ROM_CLONES clones, and the memory map entries mapping the bank are
+ * pointed at the clone; the Z80 bank window reads through the same entries.
+ * Restoring the ROM points them back, without reloading or copying it.
+ * Entries a mapper or a state load points at the original bank again are
+ * moved back to the clone by chaos_rom_frame().
+ *
+ * Offsets are cart.rom[] indices, the 68k address of the unmapped ROM.
+ * Mega Drive cartridges only (not Pico, Mega CD or Master System).
+ */
+
+#define CHAOS_ROM_CLONES 16
+
+/* Byte at ROM 'offset', made writable (its bank cloned and mapped), or NULL
+ * if it is outside the ROM or all clones are in use */
+uint8_t *chaos_rom_byte(int offset);
+
+/* 4KB pages of the ROM instructions were decoded from since it was loaded
+ * (m68k_cache_pages()), so effects can land in code that runs: stores their
+ * numbers (offset >> 12) in 'pages' and returns their count, 0 without the
+ * decode cache. The code run again in frames a netplay rollback replays is
+ * seen too */
+#define CHAOS_ROM_PAGES (MAXROMSIZE >> M68K_CACHE_PAGE_SHIFT)
+int chaos_rom_code_pages(uint16_t *pages);
+
+/* Map the clones again (called once per frame) */
+void chaos_rom_frame(void);
+
+/* Point the memory map back at cart.rom and drop the clones */
+void EMSCRIPTEN_KEEPALIVE chaos_rom_restore(void);
+
+/* Banks cloned so far */
+int EMSCRIPTEN_KEEPALIVE chaos_rom_clone_count(void);
+
+/* Forget the clones without remapping (new ROM loaded) */
+void chaos_rom_clear(void);
+
+/* Add the clones to the memory report */
+void chaos_rom_memory_report(void);
+
+#endif /* _CHAOS_ROM_H_ */
@@ -0,0 +1,286 @@
+/**
+ * ChaosDrive - scanline scheduled chaos effects
+ *
+ * Events are kept sorted by first line so that effects due on the same line
+ * run in a stable order. Each event tracks the next line it fires on during
+ * the current frame; chaos_next_line caches the earliest one. Cycle timers
+ * are kept sorted by cycle the same way, the earliest one armed in the 68k
+ * core.
+ */
+
+#include "shared.h"
+#include "chaos.h"
+#include "chaos_fm.h"
+#include "chaos_mod.h"
+#include "chaos_schedule.h"
+#include "chaos_record.h"
+
+typedef struct
+{
+    int handle;
+    int id;
+    int line;
+    int every;
+    int once;
+    int next;
+    float intensity;
+} chaos_event_t;
+
+typedef struct
+{
+    int handle;
+    int id;
+    int cycle;
+    int once;
+    int due;        /* cycle count it fires at this frame, -1 if not armed */
+    float intensity;
+} chaos_timer_t;
+
+int chaos_next_line = -1;
+
+static chaos_event_t events[CHAOS_SCHEDULE_MAX];
+static int event_count;
+static int next_handle;
+
+static chaos_timer_t timers[CHAOS_TIMER_MAX];
+static int timer_count;
+
+static void timer_hook(unsigned int cycles);
+
+/* Arm the 68k timer on the earliest timer left this frame */
+static void arm_timer(void)
+{
+    int i;
+
+    for (i = 0; i < timer_count; i++)
+    {
+        if (timers[i].due >= 0)
+        {
+            m68k_set_timer(timers[i].due, timer_hook);
+            return;
+        }
+    }
+
+    m68k_set_timer(M68K_TIMER_OFF, NULL);
+}
+
+/* The 68k reached the armed timer: apply the ones due */
+static void timer_hook(unsigned int cycles)
+{
+    int i, n = 0;
+
+    /* mid-line, like the line hook: the render thread done with the line,
+     * the VRAM run the 68k left stored before the effects and their undo
+     * snapshot see VRAM */
+    RENDER_SYNC();
+    VDP_RUN_FLUSH();
+
+    for (i = 0; i < timer_count; i++)
+    {
+        chaos_timer_t *t = &timers[i];
+
+        if ((t->due >= 0) && ((unsigned int)t->due <= cycles))
+        {
+            chaos_apply(t->id, t->intensity);
+            t->due = -1;
+
+            if (t->once)
+                continue;
+        }
+
+        timers[n++] = *t;
+    }
+    timer_count = n;
+
+    arm_timer();
+}
+
+static void update_next_line(void)
+{
+    int i;
+    int next = -1;
+
+    for (i = 0; i < event_count; i++)
+    {
+        if ((events[i].next >= 0) && ((next < 0) || (events[i].next < next)))
+            next = events[i].next;
+    }
+
+    /* queued FM writes are issued from the same hook */
+    if ((chaos_fm_next_line >= 0) && ((next < 0) || (chaos_fm_next_line < next)))
+        next = chaos_fm_next_line;
+
+    chaos_next_line = next;
+}
+
+static int add_event(int id, int line, int every, int once, float intensity)
+{
+    int i;
+
+    if ((event_count == CHAOS_SCHEDULE_MAX) || (line < 0) || (every < 0) || !chaos_effect_name(id))
+        return -1;
+
+    /* insert after events starting on the same line or earlier */
+    for (i = event_count; (i > 0) && (events[i - 1].line > line); i--)
+    {
+        events[i] = events[i - 1];
+    }
+
+    events[i].handle = next_handle;
+    events[i].id = id;
+    events[i].line = line;
+    events[i].every = every;
+    events[i].once = once;
+    events[i].intensity = intensity;
+
+    /* armed by chaos_schedule_begin_frame() before the next active display */
+    events[i].next = -1;
+    event_count++;
+
+    next_handle = (next_handle + 1) & 0x7FFFFFFF;
+    return events[i].handle;
+}
+
+int chaos_at_cycle(int id, int cycle, int repeat, float intensity)
+{
+    int i;
+
+    chaos_record_call(CHAOS_RECORD_AT_CYCLE, id, cycle, repeat, intensity);
+
+    if ((timer_count == CHAOS_TIMER_MAX) || (cycle < 0) || !chaos_effect_name(id))
+        return -1;
+
+    /* insert after timers due on the same cycle or earlier */
+    for (i = timer_count; (i > 0) && (timers[i - 1].cycle > cycle); i--)
+    {
+        timers[i] = timers[i - 1];
+    }
+
+    timers[i].handle = next_handle;
+    timers[i].id = id;
+    timers[i].cycle = cycle;
+    timers[i].once = !repeat;
+    timers[i].intensity = intensity;
+
+    /* armed by chaos_schedule_begin_frame() before the next active display */
+    timers[i].due = -1;
+    timer_count++;
+
+    next_handle = (next_handle + 1) & 0x7FFFFFFF;
+    return timers[i].handle;
+}
+
+int chaos_schedule(int id, int line, int every, float intensity)
+{
+    chaos_record_call(CHAOS_RECORD_SCHEDULE, id, line, every, intensity);
+    return add_event(id, line, every, 0, intensity);
+}
+
+int chaos_schedule_next_handle(void)
+{
+    return next_handle;
+}
+
+int chaos_schedule_once(int id, int line, float intensity)
+{
+    return add_event(id, line, 0, 1, intensity);
+}
+
+void chaos_unschedule(int handle)
+{
+    int i, n = 0;
+
+    chaos_record_call(CHAOS_RECORD_UNSCHEDULE, handle, 0, 0, 0);
+
+    for (i = 0; i < event_count; i++)
+    {
+        if (events[i].handle != handle)
+            events[n++] = events[i];
+    }
+    event_count = n;
+
+    for (i = n = 0; i < timer_count; i++)
+    {
+        if (timers[i].handle != handle)
+            timers[n++] = timers[i];
+    }
+    timer_count = n;
+
+    update_next_line();
+    arm_timer();
+}
+
+void chaos_schedule_clear(void)
+{
+    chaos_record_call(CHAOS_RECORD_CLEAR, 0, 0, 0, 0);
+    event_count = 0;
+    timer_count = 0;
+    update_next_line();
+    arm_timer();
+}
+
+void chaos_schedule_begin_frame(void)
+{
+    int i, n = 0;
+
+    for (i = 0; i < event_count; i++)
+    {
+        /* one-shot event armed last frame on a line that was never reached */
+        if (events[i].once && (events[i].next >= 0))
+            continue;
+
+        events[i].next = events[i].line;
+        events[n++] = events[i];
+    }
+    event_count = n;
+
+    update_next_line();
+
+    /* Timers count from here (the start of line 0) to the end of the frame */
+    for (i = n = 0; i < timer_count; i++)
+    {
+        chaos_timer_t *t = &timers[i];
+
+        /* one-shot timer armed last frame and never reached */
+        if (t->once && (t->due >= 0))
+            continue;
+
+        t->due = (t->cycle < bitmap.viewport.h * MCYCLES_PER_LINE) ? (int)(mcycles_vdp + t->cycle) : -1;
+        timers[n++] = *t;
+    }
+    timer_count = n;
+
+    arm_timer();
+}
+
+void chaos_line_hook(int line)
+{
+    int i, n = 0;
+    int fired = 0;
+
+    chaos_fm_flush(line);
+
+    for (i = 0; i < event_count; i++)
+    {
+        chaos_event_t *e = &events[i];
+
+        if (e->next == line)
+        {
+            /* per line modulators, once for the line's events */
+            if (!fired)
+                chaos_mod_line(line);
+            chaos_apply(e->id, e->intensity);
+            fired = 1;
+
+            if (e->once)
+                continue;
+
+            e->next = e->every ? (line + e->every) : -1;
+        }
+
+        events[n++] = *e;
+    }
+    event_count = n;
+
+    update_next_line();
+}
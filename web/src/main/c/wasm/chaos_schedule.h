@@ -0,0 +1,53 @@
+#ifndef _CHAOS_SCHEDULE_H_
+#define _CHAOS_SCHEDULE_H_
+
+#include <emscripten/emscripten.h>
+
+/* Raster-timed chaos effects.
+ *
+ * Effects can be scheduled on an active display line, optionally repeating
+ * every N lines, and are applied from system_frame_gen() just before that
+ * line is rendered. Repeating events stay active until removed; one-shot
+ * events fire once and are dropped.
+ *
+ * The frame loop only compares the current line against chaos_next_line,
+ * which is -1 when nothing is left to fire this frame. It also covers the
+ * queued chaos FM writes (chaos_fm.h), flushed from the same hook.
+ *
+ * Cycle timers fire inside a line: the 68k core ends its run at the master
+ * cycle of the earliest one (m68k_set_timer()), the effect is applied there
+ * and the run goes on. The count starts at line 0 of the active display and
+ * stops at its last line; a timer past it never fires. Mega Drive frames
+ * only.
+ */
+
+#define CHAOS_SCHEDULE_MAX 64
+#define CHAOS_TIMER_MAX    16
+
+extern int chaos_next_line;
+
+/* Schedule effect 'id' on 'line' then every 'every' lines (0 = that line
+ * only, every frame). Returns a handle for chaos_unschedule(), or -1. */
+int EMSCRIPTEN_KEEPALIVE chaos_schedule(int id, int line, int every, float intensity);
+void EMSCRIPTEN_KEEPALIVE chaos_unschedule(int handle);
+
+/* Apply effect 'id' when the 68k reaches master cycle 'cycle' of the active
+ * display (MCYCLES_PER_LINE per line), every frame if 'repeat', else once.
+ * Returns a handle for chaos_unschedule(), or -1. */
+int EMSCRIPTEN_KEEPALIVE chaos_at_cycle(int id, int cycle, int repeat, float intensity);
+void EMSCRIPTEN_KEEPALIVE chaos_schedule_clear(void);
+
+/* Handle the next schedule will get (session recordings store handles
+ * relative to it) */
+int chaos_schedule_next_handle(void);
+
+/* Schedule effect 'id' on 'line' of the current frame only */
+int chaos_schedule_once(int id, int line, float intensity);
+
+/* Rewind all events to their first line (called before the active display) */
+void chaos_schedule_begin_frame(void);
+
+/* Apply events due on 'line' (called when line == chaos_next_line) */
+void chaos_line_hook(int line);
+
+#endif /* _CHAOS_SCHEDULE_H_ */
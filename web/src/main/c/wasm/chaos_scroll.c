@@ -0,0 +1,96 @@
+/**
+ * ChaosDrive - scroll offset tables
+ *
+ * Only the renderer reads the tables; the effects write them once. The
+ * per-frame cost is the phase step and, after a held effect, one clear.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_scroll.h"
+
+uint8 chaos_scroll_on;
+uint8 chaos_scroll_phase;
+uint32 chaos_hscroll[CHAOS_SCROLL_LINE_COUNT];
+
+static uint32 offsets[CHAOS_SCROLL_COLUMN_COUNT];
+static uint32 columns[CHAOS_SCROLL_COLUMN_COUNT];
+static uint8 speed;
+static uint8 transient; /* tables to clear next frame */
+
+/* plane A / plane B in the layout of the H-scroll and VSRAM entries */
+static uint32 pack(int a, int b)
+{
+#ifdef LSB_FIRST
+    return (a & 0xFFFF) | ((uint32)(b & 0xFFFF) << 16);
+#else
+    return (b & 0xFFFF) | ((uint32)(a & 0xFFFF) << 16);
+#endif
+}
+
+uint32 *chaos_scroll_columns(void)
+{
+    const uint32 *vs = (const uint32 *)&vsram[0];
+    int per_column = reg[11] & 4;
+    int i;
+
+    for (i = 0; i < CHAOS_SCROLL_COLUMN_COUNT; i++)
+    {
+        uint32 v = vs[per_column ? i : 0];
+        uint32 o = offsets[i];
+        columns[i] = ((v + o) & 0xFFFF) | ((v & 0xFFFF0000) + (o & 0xFFFF0000));
+    }
+    return columns;
+}
+
+void chaos_scroll_line(int index, int a, int b, int temporary)
+{
+    chaos_hscroll[index & (CHAOS_SCROLL_LINE_COUNT - 1)] = pack(a, b);
+    chaos_scroll_on |= CHAOS_SCROLL_LINES;
+    if (temporary)
+        transient |= CHAOS_SCROLL_LINES;
+    else
+        transient &= ~CHAOS_SCROLL_LINES;
+}
+
+void chaos_scroll_column(int column, int a, int b, int temporary)
+{
+    if ((unsigned int)column >= CHAOS_SCROLL_COLUMN_COUNT)
+        return;
+
+    offsets[column] = pack(a, b);
+    chaos_scroll_on |= CHAOS_SCROLL_COLUMNS;
+    if (temporary)
+        transient |= CHAOS_SCROLL_COLUMNS;
+    else
+        transient &= ~CHAOS_SCROLL_COLUMNS;
+}
+
+void chaos_scroll_speed(int lines)
+{
+    speed = lines;
+    if (!speed)
+        chaos_scroll_phase = 0;
+}
+
+void chaos_scroll_clear(int tables)
+{
+    if (tables & CHAOS_SCROLL_LINES)
+    {
+        memset(chaos_hscroll, 0, sizeof(chaos_hscroll));
+        chaos_scroll_speed(0);
+    }
+    if (tables & CHAOS_SCROLL_COLUMNS)
+        memset(offsets, 0, sizeof(offsets));
+
+    chaos_scroll_on &= ~tables;
+    transient &= ~tables;
+}
+
+void chaos_scroll_frame(void)
+{
+    if (transient)
+        chaos_scroll_clear(transient);
+
+    chaos_scroll_phase += speed;
+}
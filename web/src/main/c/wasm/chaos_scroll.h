@@ -0,0 +1,53 @@
+#ifndef _CHAOS_SCROLL_H_
+#define _CHAOS_SCROLL_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos scroll offsets.
+ *
+ * The Mode 5 background renderer adds these to the scroll values it fetches
+ * from the H-scroll table and VSRAM, so the game's own scroll data is never
+ * touched: no VRAM writes, nothing for the next DMA to undo, nothing to redo
+ * every frame. Offsets are signed pixels per plane, one per display line
+ * (horizontal) and one per 2-cell column (vertical); column offsets turn on
+ * per-column vertical scrolling on top of whatever mode the game uses.
+ *
+ * Line offsets are read at (line + phase) & 0xFF: a non-zero speed moves
+ * the pattern down the screen by that many lines per frame, the only work
+ * done per frame. Transient offsets (held effects) are cleared at the start
+ * of the next frame unless set again.
+ */
+
+#define CHAOS_SCROLL_LINES   0x01
+#define CHAOS_SCROLL_COLUMNS 0x02
+
+#define CHAOS_SCROLL_LINE_COUNT   256
+#define CHAOS_SCROLL_COLUMN_COUNT 20
+
+/* Renderer side (core/vdp_render.c): active tables, current phase, and
+ * offsets packed like the scroll entries (plane A in the low half with
+ * LSB_FIRST, 16-bit wrap per plane) */
+extern uint8_t chaos_scroll_on;
+extern uint8_t chaos_scroll_phase;
+extern uint32_t chaos_hscroll[CHAOS_SCROLL_LINE_COUNT];
+
+/* VSRAM as the renderer sees it this line: the game's per-column values (or
+ * its full-screen value for every column) plus the column offsets */
+uint32_t *chaos_scroll_columns(void);
+
+/* Offsets of table line 'index' / of 'column' for planes A and B; a
+ * temporary offset only lasts until the next frame */
+void chaos_scroll_line(int index, int a, int b, int temporary);
+void chaos_scroll_column(int column, int a, int b, int temporary);
+
+/* Lines moved per frame (wraps at 256) */
+void EMSCRIPTEN_KEEPALIVE chaos_scroll_speed(int lines);
+
+/* Drop the line or column offsets (CHAOS_SCROLL_LINES / COLUMNS) */
+void EMSCRIPTEN_KEEPALIVE chaos_scroll_clear(int tables);
+
+/* Phase and transient offsets (pre-render hook) */
+void chaos_scroll_frame(void);
+
+#endif /* _CHAOS_SCROLL_H_ */
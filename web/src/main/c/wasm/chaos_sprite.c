@@ -0,0 +1,102 @@
+/**
+ * ChaosDrive - sprite offset tables
+ *
+ * Only the sprite parser reads the tables; the effects write the entries
+ * they touch. Y and size offsets are taken when the sprite line index is
+ * built, so changing one marks the index dirty; X offsets are read as each
+ * line's sprites are parsed.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_rand.h"
+#include "chaos_sprite.h"
+
+uint8 chaos_sprite_on;
+int16 chaos_sprite_dx[CHAOS_SPRITE_COUNT];
+int16 chaos_sprite_dy[CHAOS_SPRITE_COUNT];
+uint8 chaos_sprite_size[CHAOS_SPRITE_COUNT];
+
+static uint8 transient; /* offsets to clear next frame */
+
+void chaos_sprite_offset(int entry, int dx, int dy, int size, int temporary)
+{
+    if ((unsigned int)entry >= CHAOS_SPRITE_COUNT)
+        return;
+
+    chaos_sprite_dx[entry] = dx;
+    chaos_sprite_dy[entry] = dy;
+    chaos_sprite_size[entry] = size & 0x0F;
+    chaos_sprite_on = 1;
+    transient = temporary;
+    obj_index_dirty = 1;
+}
+
+void chaos_sprite_jitter(int count, int range, int temporary)
+{
+    int list[CHAOS_SPRITE_COUNT];
+    int total = render_obj_chain(list);
+
+    if (!total || (range < 1))
+        return;
+
+    while (count--)
+    {
+        int entry = list[chaos_rand_below(CHAOS_RNG_VRAM, total)];
+        int dx = chaos_rand_below(CHAOS_RNG_VRAM, range * 2 + 1) - range;
+        int dy = chaos_rand_below(CHAOS_RNG_VRAM, range * 2 + 1) - range;
+        int size = (chaos_rand_below(CHAOS_RNG_VRAM, 4) == 0) ? chaos_rand_below(CHAOS_RNG_VRAM, 16) : 0;
+
+        chaos_sprite_offset(entry, dx, dy, size, temporary);
+    }
+}
+
+void chaos_sprite_clear(void)
+{
+    if (!chaos_sprite_on)
+        return;
+
+    memset(chaos_sprite_dx, 0, sizeof(chaos_sprite_dx));
+    memset(chaos_sprite_dy, 0, sizeof(chaos_sprite_dy));
+    memset(chaos_sprite_size, 0, sizeof(chaos_sprite_size));
+    chaos_sprite_on = 0;
+    transient = 0;
+    obj_index_dirty = 1;
+}
+
+void chaos_sprite_frame(void)
+{
+    if (transient)
+        chaos_sprite_clear();
+}
+
+int chaos_sprite_save(uint8_t *state)
+{
+    int size = 0;
+
+    memcpy(state + size, chaos_sprite_dx, sizeof(chaos_sprite_dx));
+    size += sizeof(chaos_sprite_dx);
+    memcpy(state + size, chaos_sprite_dy, sizeof(chaos_sprite_dy));
+    size += sizeof(chaos_sprite_dy);
+    memcpy(state + size, chaos_sprite_size, sizeof(chaos_sprite_size));
+    size += sizeof(chaos_sprite_size);
+    state[size++] = chaos_sprite_on;
+    state[size++] = transient;
+    return size;
+}
+
+int chaos_sprite_load(const uint8_t *state)
+{
+    int size = 0;
+
+    memcpy(chaos_sprite_dx, state + size, sizeof(chaos_sprite_dx));
+    size += sizeof(chaos_sprite_dx);
+    memcpy(chaos_sprite_dy, state + size, sizeof(chaos_sprite_dy));
+    size += sizeof(chaos_sprite_dy);
+    memcpy(chaos_sprite_size, state + size, sizeof(chaos_sprite_size));
+    size += sizeof(chaos_sprite_size);
+    chaos_sprite_on = state[size++];
+    transient = state[size++];
+    obj_index_dirty = 1;
+    return size;
+}
@@ -0,0 +1,49 @@
+#ifndef _CHAOS_SPRITE_H_
+#define _CHAOS_SPRITE_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos sprite offsets.
+ *
+ * The Mode 5 sprite parser (parse_satb_m5()) adds these to what it reads
+ * for each SAT entry: Y and size from the internal SAT cache, X from VRAM.
+ * The game's sprite table is never written, so no VRAM or pattern cache
+ * work follows and its next SAT upload does not undo the glitch; changing
+ * an entry costs one write and a rebuild of the sprite line index. Sprite
+ * collision and overflow follow the moved sprites, as they would on
+ * hardware, so the offsets are part of the chaos context.
+ *
+ * Offsets are signed pixels per SAT entry (0-79), the size a mask XORed
+ * with the size bits (horizontal in bits 2-3, vertical in bits 0-1).
+ * Transient offsets (held effects) are cleared at the start of the next
+ * frame unless set again.
+ */
+
+#define CHAOS_SPRITE_COUNT 80
+
+/* Renderer side (core/vdp_render.c): offsets applied, offsets per entry */
+extern uint8_t chaos_sprite_on;
+extern int16_t chaos_sprite_dx[CHAOS_SPRITE_COUNT];
+extern int16_t chaos_sprite_dy[CHAOS_SPRITE_COUNT];
+extern uint8_t chaos_sprite_size[CHAOS_SPRITE_COUNT];
+
+/* Offsets of SAT entry 'entry'; a temporary offset only lasts until the
+ * next frame */
+void chaos_sprite_offset(int entry, int dx, int dy, int size, int temporary);
+
+/* Up to 'count' sprites of the link chain moved by up to 'range' pixels
+ * each way, one in four also resized */
+void chaos_sprite_jitter(int count, int range, int temporary);
+
+/* Drop all offsets */
+void EMSCRIPTEN_KEEPALIVE chaos_sprite_clear(void);
+
+/* Transient offsets (pre-render hook) */
+void chaos_sprite_frame(void);
+
+/* Offsets (chaos_context_save()); return the bytes written / read */
+int chaos_sprite_save(uint8_t *state);
+int chaos_sprite_load(const uint8_t *state);
+
+#endif /* _CHAOS_SPRITE_H_ */
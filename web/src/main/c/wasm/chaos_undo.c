@@ -0,0 +1,379 @@
+/**
+ * ChaosDrive - chaos undo log
+ *
+ * Records are appended to one buffer, each one's data (if any) followed by
+ * its header, so the log is walked back from its end. The start of each
+ * step is kept apart; dropping the oldest steps moves the rest down, which
+ * only happens when the log is full.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos_dirty.h"
+#include "chaos_kernels.h"
+#include "chaos_palette.h"
+#include "chaos_record.h"
+#include "chaos_undo.h"
+#include "memmap.h"
+
+#define OP_BYTES    0 /* data: the old bytes */
+#define OP_SWAP_XOR 1 /* param: swap << 8 | mask */
+#define OP_ROTATE   2 /* param: amount */
+#define OP_SHIFT    3 /* param: amount, data: the edge bytes of each block */
+
+typedef struct
+{
+    uint32 offset;
+    uint32 len;
+    int32 param;
+    uint32 size;  /* data bytes before the header */
+    uint16 block;
+    uint8 region;
+    uint8 op;
+} undo_record_t;
+
+static uint8 log_data[CHAOS_UNDO_SIZE];
+static int used;
+
+static int step_start[CHAOS_UNDO_STEPS]; /* oldest first */
+static int step_count;
+
+static int depth; /* nested chaos_undo_begin() */
+static int lost;  /* the open step did not fit */
+
+static uint8 *region_base(int region)
+{
+    switch (region)
+    {
+        case CHAOS_UNDO_VRAM:     return vram;
+        case CHAOS_UNDO_CRAM:     return cram;
+        case CHAOS_UNDO_VSRAM:    return vsram;
+        case CHAOS_UNDO_WORK_RAM: return work_ram;
+        case CHAOS_UNDO_ZRAM:     return zram;
+        case CHAOS_UNDO_VDP_REGS: return reg;
+    }
+    return NULL;
+}
+
+/* Drop the oldest step */
+static void drop_oldest(void)
+{
+    int i, shift = (step_count > 1) ? step_start[1] : used;
+
+    memmove(log_data, log_data + shift, used - shift);
+    used -= shift;
+
+    for (i = 1; i < step_count; i++)
+        step_start[i - 1] = step_start[i] - shift;
+    step_count--;
+}
+
+/* Room for a record with 'size' data bytes in the open step: returns where
+   the data goes (the header is written by the caller), NULL if no step is
+   open or the step cannot fit */
+static uint8 *reserve(int size)
+{
+    int total = size + sizeof(undo_record_t);
+
+    if (!depth || lost)
+        return NULL;
+
+    while ((used + total > CHAOS_UNDO_SIZE) && (step_count > 1))
+        drop_oldest();
+
+    /* the open step alone is too large: nothing before it can be undone */
+    if (used + total > CHAOS_UNDO_SIZE)
+    {
+        used = 0;
+        step_count = 0;
+        lost = 1;
+        return NULL;
+    }
+
+    return log_data + used;
+}
+
+static void append(int region, int op, int offset, int len, int param, int block, int size)
+{
+    undo_record_t r;
+
+    r.offset = offset;
+    r.len = len;
+    r.param = param;
+    r.size = size;
+    r.block = block;
+    r.region = region;
+    r.op = op;
+
+    memcpy(log_data + used + size, &r, sizeof(r));
+    used += size + sizeof(r);
+}
+
+/* Last record of the open step, 0 if it has none */
+static int last_record(undo_record_t *r)
+{
+    if (!step_count || (used == step_start[step_count - 1]))
+        return 0;
+
+    memcpy(r, log_data + used - sizeof(*r), sizeof(*r));
+    return 1;
+}
+
+/* Old bytes of 'region' (registers and the palette layer through their
+   accessors) */
+static void read_old(int region, int offset, int len, uint8 *data)
+{
+    int i;
+
+    if (region == CHAOS_UNDO_CPU_REGS)
+    {
+        for (i = 0; i < len; i++)
+        {
+            uint32 value = m68k_get_reg((m68k_register_t)(M68K_REG_D0 + offset + i));
+            memcpy(data + i * 4, &value, 4);
+        }
+    }
+    else if (region == CHAOS_UNDO_PALETTE)
+    {
+        chaos_palette_save(data);
+    }
+    else
+    {
+        memcpy(data, region_base(region) + offset, len);
+    }
+}
+
+static int data_size(int region, int len)
+{
+    if (region == CHAOS_UNDO_CPU_REGS)
+        return len * 4;
+    if (region == CHAOS_UNDO_PALETTE)
+        return CHAOS_PALETTE_STATE_SIZE;
+    return len;
+}
+
+void chaos_undo_save(int region, int offset, int len)
+{
+    undo_record_t r;
+    uint8 *data;
+    int size;
+
+    if (!depth || lost || (len <= 0))
+        return;
+
+    /* right after the last one: extend it */
+    if ((region <= CHAOS_UNDO_VDP_REGS) && last_record(&r) && (r.op == OP_BYTES) &&
+        (r.region == region) && (r.offset + r.len == (uint32)offset) && (used + len <= CHAOS_UNDO_SIZE))
+    {
+        used -= sizeof(r);
+        memcpy(log_data + used, region_base(region) + offset, len);
+        used -= r.size;
+        append(region, OP_BYTES, r.offset, r.len + len, 0, 0, r.size + len);
+        return;
+    }
+
+    size = data_size(region, len);
+    data = reserve(size);
+    if (!data)
+        return;
+
+    read_old(region, offset, len, data);
+    append(region, OP_BYTES, offset, len, 0, 0, size);
+}
+
+void chaos_undo_swap_xor(int region, int offset, int len, int swap, int mask)
+{
+    if ((len <= 0) || (!swap && !(mask & 0xFF)) || !reserve(0))
+        return;
+
+    append(region, OP_SWAP_XOR, offset, len, ((swap ? 1 : 0) << 8) | (mask & 0xFF), 0, 0);
+}
+
+void chaos_undo_rotate(int region, int offset, int len, int amount)
+{
+    if ((len <= 0) || !(amount % len) || !reserve(0))
+        return;
+
+    append(region, OP_ROTATE, offset, len, amount, 0, 0);
+}
+
+void chaos_undo_shift(int region, int offset, int len, int block, int amount)
+{
+    int n = (amount < 0) ? -amount : amount;
+    int pos, size, blocks;
+    uint8 *data, *base = region_base(region);
+
+    if (!depth || lost || (len <= 0) || !n)
+        return;
+
+    if (!block || (block > len))
+        block = len;
+
+    /* a block losing all its bytes (the shorter last one included) */
+    if ((n >= block) || ((len % block) && (n >= len % block)))
+    {
+        chaos_undo_save(region, offset, len);
+        return;
+    }
+
+    blocks = (len + block - 1) / block;
+    size = blocks * n;
+    data = reserve(size);
+    if (!data)
+        return;
+
+    /* the bytes pushed out of each block */
+    for (pos = 0; pos < len; pos += block, data += n)
+    {
+        int end = (pos + block < len) ? (pos + block) : len;
+        memcpy(data, base + offset + ((amount > 0) ? (end - n) : pos), n);
+    }
+
+    append(region, OP_SHIFT, offset, len, amount, block, size);
+}
+
+/* ======================================================================== */
+/* Steps                                                                    */
+/* ======================================================================== */
+
+void chaos_undo_begin(void)
+{
+    if (depth++)
+        return;
+
+    if (step_count == CHAOS_UNDO_STEPS)
+        drop_oldest();
+
+    step_start[step_count++] = used;
+    lost = 0;
+}
+
+void chaos_undo_end(void)
+{
+    if (!depth || --depth)
+        return;
+
+    /* nothing logged (or nothing left) */
+    if (lost || (used == step_start[step_count - 1]))
+    {
+        if (step_count && !lost)
+            step_count--;
+        lost = 0;
+    }
+}
+
+/* Restore what 'r' recorded */
+static void undo_record(const undo_record_t *r, const uint8 *data)
+{
+    uint8 *base = region_base(r->region);
+    int i;
+
+    switch (r->op)
+    {
+        case OP_BYTES:
+            if (r->region == CHAOS_UNDO_CPU_REGS)
+            {
+                for (i = 0; i < r->len; i++)
+                {
+                    uint32 value;
+                    memcpy(&value, data + i * 4, 4);
+                    m68k_set_reg((m68k_register_t)(M68K_REG_D0 + r->offset + i), value);
+                }
+                return;
+            }
+            if (r->region == CHAOS_UNDO_PALETTE)
+            {
+                chaos_palette_load(data);
+                return;
+            }
+            memcpy(base + r->offset, data, r->len);
+            break;
+
+        case OP_SWAP_XOR:
+        {
+            /* swap(x) ^ m backwards: swap(y ^ m) = swap(y) ^ swap(m) */
+            int swap = r->param >> 8;
+            int mask = r->param & 0xFF;
+
+            if (swap)
+                mask = ((mask << 4) | (mask >> 4)) & 0xFF;
+            chaos_kernel_swap_xor(base + r->offset, r->len, swap, mask);
+            break;
+        }
+
+        case OP_ROTATE:
+            chaos_kernel_rotate(base + r->offset, r->len, -r->param);
+            break;
+
+        case OP_SHIFT:
+        {
+            int n = (r->param < 0) ? -r->param : r->param;
+            int pos;
+
+            /* shift back, then the bytes pushed out go back to the edge */
+            for (pos = 0; pos < r->len; pos += r->block, data += n)
+            {
+                int end = (pos + r->block < r->len) ? (pos + r->block) : r->len;
+
+                chaos_kernel_shift(base + r->offset + pos, end - pos, -r->param, 0);
+                memcpy(base + r->offset + ((r->param > 0) ? (end - n) : pos), data, n);
+            }
+            break;
+        }
+    }
+
+    if (r->region == CHAOS_UNDO_VRAM)
+    {
+        chaos_dirty_vram(r->offset, r->len);
+    }
+    else if (r->region == CHAOS_UNDO_CRAM)
+    {
+        chaos_dirty_cram(r->offset, r->len);
+    }
+    else if (r->region == CHAOS_UNDO_VDP_REGS)
+    {
+        satb = (reg[5] << 9) & 0xFE00;
+        bitmap.viewport.changed |= 2;
+    }
+}
+
+int chaos_undo(int count)
+{
+    int done = 0;
+
+    chaos_record_call(CHAOS_RECORD_UNDO, count, 0, 0, 0);
+
+    while ((done < count) && step_count && !depth)
+    {
+        int start = step_start[--step_count];
+
+        while (used > start)
+        {
+            undo_record_t r;
+
+            memcpy(&r, log_data + used - sizeof(r), sizeof(r));
+            used -= sizeof(r) + r.size;
+            undo_record(&r, log_data + used);
+        }
+        done++;
+    }
+
+    return done;
+}
+
+int chaos_undo_steps(void)
+{
+    return step_count - ((depth && !lost) ? 1 : 0);
+}
+
+void chaos_undo_clear(void)
+{
+    used = 0;
+    step_count = 0;
+    lost = depth ? 1 : 0;
+}
+
+void chaos_undo_memory_report(void)
+{
+    memory_region("chaos undo log", log_data, sizeof(log_data));
+}
@@ -0,0 +1,74 @@
+#ifndef _CHAOS_UNDO_H_
+#define _CHAOS_UNDO_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Chaos undo log.
+ *
+ * Each effect chaos_apply() runs (and each slice of a spread effect) is a
+ * step. While a step is open, the code changing the machine records how to
+ * take the change back: the bytes it is about to overwrite, or only the
+ * operation to run backwards for the effects that can be inverted (XOR,
+ * nibble swap, rotation) and the edge bytes a shift pushes out. Undoing the
+ * last steps then costs the size of what they changed, where a checkpoint
+ * restore compares and copies every page.
+ *
+ * The log holds CHAOS_UNDO_SIZE bytes and CHAOS_UNDO_STEPS steps; the oldest
+ * steps make room for new ones. Taking or restoring a checkpoint empties it
+ * (the checkpoint covers what came before), so the two make one history:
+ * undo steps back to the checkpoint, chaos_restore() goes the rest of the
+ * way. Loading a state, rewinding and a reset empty it too.
+ *
+ * Undo writes the old bytes back over what is there now, as a checkpoint
+ * restore does: what the game wrote since to the same places is lost, and
+ * an inverted operation is applied to the game's new bytes. Renderer layers
+ * (scroll, sprite and line palette offsets, hidden planes), the FM and PSG
+ * registers, the ROM and the presets are not logged; they have their own
+ * off and restore effects. The palette layer is.
+ */
+
+#define CHAOS_UNDO_SIZE  0x40000
+#define CHAOS_UNDO_STEPS 64
+
+/* Regions (the chaos VM memories first, chaos_vm.h) */
+#define CHAOS_UNDO_VRAM     0
+#define CHAOS_UNDO_CRAM     1
+#define CHAOS_UNDO_VSRAM    2
+#define CHAOS_UNDO_WORK_RAM 3
+#define CHAOS_UNDO_ZRAM     4
+#define CHAOS_UNDO_VDP_REGS 5
+#define CHAOS_UNDO_CPU_REGS 6 /* 4 bytes per register, M68K_REG_D0 order */
+#define CHAOS_UNDO_PALETTE  7 /* the whole palette layer: offset 0, length 1 */
+
+/* Open and close a step (nested calls join the open one) */
+void chaos_undo_begin(void);
+void chaos_undo_end(void);
+
+/* Before a write: [offset, offset + len) of 'region' */
+void chaos_undo_save(int region, int offset, int len);
+
+/* After chaos_kernel_swap_xor(swap, mask) on a range */
+void chaos_undo_swap_xor(int region, int offset, int len, int swap, int mask);
+
+/* After chaos_kernel_rotate(amount) on a range */
+void chaos_undo_rotate(int region, int offset, int len, int amount);
+
+/* Before chaos_kernel_shift(amount) on each 'block' bytes of a range (0:
+ * the whole range), the last block possibly shorter */
+void chaos_undo_shift(int region, int offset, int len, int block, int amount);
+
+/* Take back the last 'count' steps, newest first; returns how many were
+ * (fewer when the log runs out) */
+int EMSCRIPTEN_KEEPALIVE chaos_undo(int count);
+
+/* Steps in the log */
+int EMSCRIPTEN_KEEPALIVE chaos_undo_steps(void);
+
+/* Empty the log */
+void chaos_undo_clear(void);
+
+/* Add the log to the memory report */
+void chaos_undo_memory_report(void);
+
+#endif /* _CHAOS_UNDO_H_ */
@@ -0,0 +1,175 @@
+/**
+ * ChaosDrive - VDP write log consumers
+ *
+ * The VDP only appends records while a consumer bit is set; everything that
+ * needs to know what the game wrote is derived here from one pass over the
+ * records of the frame. SAT writes are matched against the table base at the
+ * end of the frame (games do not move it mid-frame), DMA runs are matched by
+ * the span of bytes they cover.
+ */
+
+#include "shared.h"
+#include "chaos_vdplog.h"
+
+/* frames since each SAT entry was changed, saturating, and its contents then */
+static uint8 sprite_age[CHAOS_VDPLOG_SPRITES];
+static uint8 sprite_prev[CHAOS_VDPLOG_SPRITES][8];
+
+static uint16 heat[0x800];
+
+/* ======================================================================== */
+/* Digest                                                                   */
+/* ======================================================================== */
+
+static void stamp_sprites(int start, int end)
+{
+    int sat_start = satb;
+    int sat_end = satb + ((reg[12] & 0x01) ? 0x280 : 0x200);
+    int i;
+
+    if (start < sat_start)
+        start = sat_start;
+    if (end > sat_end)
+        end = sat_end;
+
+    if (start >= end)
+        return;
+
+    /* most games send the whole table every frame: only count the entries
+       that differ from the last time they were written */
+    for (i = (start - sat_start) >> 3; i <= ((end - 1 - sat_start) >> 3); i++)
+    {
+        const uint8 *entry = &vram[sat_start + (i << 3)];
+
+        if (memcmp(sprite_prev[i], entry, 8))
+        {
+            memcpy(sprite_prev[i], entry, 8);
+            sprite_age[i] = 0;
+        }
+    }
+}
+
+static void heat_patterns(int start, int end)
+{
+    int name;
+
+    for (name = start >> 5; name <= ((end - 1) >> 5); name++)
+    {
+        if (heat[name & 0x7FF] != 0xFFFF)
+            heat[name & 0x7FF]++;
+    }
+}
+
+/* VRAM bytes [start, end) written, end may pass 0x10000 for wrapping runs */
+static void vram_written(int start, int end, int tools)
+{
+    if (end > 0x10000)
+    {
+        vram_written(0, end - 0x10000, tools);
+        end = 0x10000;
+    }
+
+    stamp_sprites(start, end);
+    if (tools)
+        heat_patterns(start, end);
+}
+
+static void run_written(const vdp_log_t *entry, int tools)
+{
+    int count = entry->data + 1;
+    int i;
+
+    /* increments up to a pattern size hit every pattern of the span */
+    if (entry->step <= 32)
+    {
+        vram_written(entry->addr, entry->addr + (count - 1) * entry->step + 1, tools);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        int addr = (entry->addr + i * entry->step) & 0xFFFF;
+        vram_written(addr, addr + 1, tools);
+    }
+}
+
+void chaos_vdplog_frame(void)
+{
+    int tools = vdp_log_users & CHAOS_VDPLOG_TOOLS;
+    uint32 first = (vdp_log_count > VDP_LOG_SIZE) ? (vdp_log_count - VDP_LOG_SIZE) : 0;
+    uint32 n;
+    int i;
+
+    for (i = 0; i < CHAOS_VDPLOG_SPRITES; i++)
+    {
+        if (sprite_age[i] != 0xFF)
+            sprite_age[i]++;
+    }
+
+    for (n = first; n < vdp_log_count; n++)
+    {
+        const vdp_log_t *entry = &vdp_log[n & (VDP_LOG_SIZE - 1)];
+
+        if (entry->target == VDP_LOG_VRAM)
+            vram_written(entry->addr, entry->addr + 2, tools);
+        else if (entry->target == VDP_LOG_VRAM_RUN)
+            run_written(entry, tools);
+    }
+
+    vdp_log_count = 0;
+}
+
+void chaos_vdplog_clear(void)
+{
+    memset(sprite_age, 0xFF, sizeof(sprite_age));
+    memset(sprite_prev, 0, sizeof(sprite_prev));
+    memset(heat, 0, sizeof(heat));
+    vdp_log_count = 0;
+    vdp_log_users |= CHAOS_VDPLOG_CHAOS;
+}
+
+int chaos_vdplog_sprites(int frames, int *list)
+{
+    int count = 0;
+    int max = (reg[12] & 0x01) ? 80 : 64;
+    int i;
+
+    for (i = 0; i < max; i++)
+    {
+        if (sprite_age[i] < frames)
+            list[count++] = i;
+    }
+    return count;
+}
+
+/* ======================================================================== */
+/* Front-end                                                                */
+/* ======================================================================== */
+
+void chaos_vdplog_watch(int on)
+{
+    if (on)
+        vdp_log_users |= CHAOS_VDPLOG_TOOLS;
+    else
+        vdp_log_users &= ~CHAOS_VDPLOG_TOOLS;
+}
+
+int chaos_vdplog_count(void)
+{
+    return vdp_log_count;
+}
+
+const uint8_t *chaos_vdplog_records(void)
+{
+    return (const uint8_t *)vdp_log;
+}
+
+const uint16_t *chaos_vdplog_heat(void)
+{
+    return heat;
+}
+
+void chaos_vdplog_heat_reset(void)
+{
+    memset(heat, 0, sizeof(heat));
+}
@@ -0,0 +1,46 @@
+#ifndef _CHAOS_VDPLOG_H_
+#define _CHAOS_VDPLOG_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Consumers of the VDP write log (vdp_log[] in vdp_ctrl.c).
+ *
+ * The log is walked once per frame, before the next one runs, instead of
+ * rescanning VRAM: the SAT entries the game changed are stamped for the
+ * sprite effects and, while the front-end watches, every pattern written is
+ * counted in a heatmap. Between two frames the records of the last one stay
+ * readable from the front-end.
+ */
+
+#define CHAOS_VDPLOG_CHAOS 0x01 /* SAT stamps, always on */
+#define CHAOS_VDPLOG_TOOLS 0x02 /* heatmap (chaos_vdplog_watch) */
+
+#define CHAOS_VDPLOG_SPRITES 80
+
+/* Digest the records of the last frame and clear the log (called once per
+ * frame, before emulation) */
+void chaos_vdplog_frame(void);
+
+/* Forget the stamps and the heatmap (new ROM loaded) */
+void chaos_vdplog_clear(void);
+
+/* Sprites whose SAT entry the game changed in the last 'frames' frames, in
+ * table order; returns their count */
+int chaos_vdplog_sprites(int frames, int *list);
+
+/* Front-end: turn the heatmap on or off */
+void EMSCRIPTEN_KEEPALIVE chaos_vdplog_watch(int on);
+
+/* Records of the last frame (vdp_log_t, 8 bytes each), oldest first once
+ * unwrapped: the n-th one at [n & (VDP_LOG_SIZE - 1)]; the count includes
+ * records lost to the ring wrapping */
+int EMSCRIPTEN_KEEPALIVE chaos_vdplog_count(void);
+const uint8_t* EMSCRIPTEN_KEEPALIVE chaos_vdplog_records(void);
+
+/* Writes per 32-byte VRAM pattern (0x800 counters, saturating) since the
+ * last reset, while watched */
+const uint16_t* EMSCRIPTEN_KEEPALIVE chaos_vdplog_heat(void);
+void EMSCRIPTEN_KEEPALIVE chaos_vdplog_heat_reset(void);
+
+#endif /* _CHAOS_VDPLOG_H_ */
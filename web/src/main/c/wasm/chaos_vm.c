@@ -0,0 +1,430 @@
+/**
+ * ChaosDrive - user-defined chaos effects
+ *
+ * Loading does all the checking: each instruction's operands are range
+ * checked and the loop nesting is resolved into a jump table, so the
+ * interpreter loop only decodes and runs. VRAM and CRAM writes are
+ * gathered into one dirty span each and reported once at the end of a run.
+ */
+
+#include <string.h>
+#include "shared.h"
+#include "chaos.h"
+#include "chaos_dirty.h"
+#include "chaos_fm.h"
+#include "chaos_kernels.h"
+#include "chaos_undo.h"
+#include "chaos_rand.h"
+#include "chaos_record.h"
+#include "chaos_vm.h"
+
+typedef struct
+{
+    uint8_t op, a, b, c;
+} chaos_insn_t;
+
+typedef struct
+{
+    int count;       /* 0: free slot */
+    int targets;
+    chaos_insn_t code[CHAOS_VM_CODE_MAX];
+    uint16_t match[CHAOS_VM_CODE_MAX]; /* REP: its END, END: its REP */
+} chaos_program_t;
+
+static chaos_program_t programs[CHAOS_VM_PROGRAMS];
+
+static uint8_t staging[2 + CHAOS_VM_CODE_MAX * 4];
+static int load_error = -1;
+
+static uint32_t frame;
+
+static const int mem_sizes[CHAOS_VM_MEMS] = {0x10000, 0x80, 0x80, 0x10000, 0x2000, 0x20};
+
+static const int mem_targets[CHAOS_VM_MEMS] =
+{
+    CHAOS_TARGET_VRAM, CHAOS_TARGET_CRAM, CHAOS_TARGET_VSRAM,
+    CHAOS_TARGET_WORK_RAM, CHAOS_TARGET_ZRAM, CHAOS_TARGET_VDP_REGS
+};
+
+static uint8_t *mem_base(int mem)
+{
+    switch (mem)
+    {
+        case CHAOS_VM_VRAM:     return vram;
+        case CHAOS_VM_CRAM:     return cram;
+        case CHAOS_VM_VSRAM:    return vsram;
+        case CHAOS_VM_WORK_RAM: return work_ram;
+        case CHAOS_VM_ZRAM:     return zram;
+        default:                return reg;
+    }
+}
+
+/* ======================================================================== */
+/* Loading                                                                  */
+/* ======================================================================== */
+
+uint8_t *chaos_vm_buffer(void)
+{
+    return staging;
+}
+
+int chaos_vm_error(void)
+{
+    return load_error;
+}
+
+#define REG(x) ((x) < CHAOS_VM_REGS)
+
+/* operands of one instruction, and the memory it writes (-1: none) */
+static int check(const chaos_insn_t *i, int *written)
+{
+    *written = -1;
+
+    switch (i->op)
+    {
+        case CHAOS_OP_HALT:
+        case CHAOS_OP_JMP:
+        case CHAOS_OP_END:
+            return 1;
+
+        case CHAOS_OP_LDI:
+        case CHAOS_OP_LDIH:
+        case CHAOS_OP_REP:
+            return REG(i->a);
+
+        case CHAOS_OP_MOV:
+        case CHAOS_OP_ADDI:
+        case CHAOS_OP_RAND:
+            return REG(i->a) && REG(i->b);
+
+        case CHAOS_OP_ADD:
+        case CHAOS_OP_SUB:
+        case CHAOS_OP_AND:
+        case CHAOS_OP_OR:
+        case CHAOS_OP_XOR:
+        case CHAOS_OP_SHL:
+        case CHAOS_OP_SHR:
+        case CHAOS_OP_MUL:
+            return REG(i->a) && REG(i->b) && REG(i->c);
+
+        case CHAOS_OP_LD:
+            return REG(i->a) && (i->b < CHAOS_VM_MEMS) && REG(i->c);
+
+        case CHAOS_OP_ST:
+            *written = i->b;
+            return REG(i->a) && (i->b < CHAOS_VM_MEMS) && REG(i->c);
+
+        case CHAOS_OP_XORR:
+        case CHAOS_OP_SHIFTR:
+        case CHAOS_OP_ROTR:
+        case CHAOS_OP_NIBR:
+        case CHAOS_OP_FILLR:
+        case CHAOS_OP_RANDR:
+            *written = i->c & 15;
+            return REG(i->a) && REG(i->b) && ((i->c & 15) < CHAOS_VM_VDP_REGS);
+
+        case CHAOS_OP_FMW:
+            return REG(i->a) && REG(i->b) && (i->c < 2);
+
+        case CHAOS_OP_BEQ:
+        case CHAOS_OP_BNE:
+        case CHAOS_OP_BLT:
+            return REG(i->a) && REG(i->b);
+
+        default:
+            return 0;
+    }
+}
+
+/* 0 if 'p' is valid; otherwise 1 + the index of the first bad instruction */
+static int validate(chaos_program_t *p)
+{
+    int stack[CHAOS_VM_DEPTH];
+    int loop[CHAOS_VM_CODE_MAX]; /* innermost REP around each instruction, -1: none */
+    int depth = 0;
+    int pc;
+
+    p->targets = 0;
+    for (pc = 0; pc < p->count; pc++)
+    {
+        const chaos_insn_t *i = &p->code[pc];
+        int written;
+
+        if (!check(i, &written))
+            return pc + 1;
+        if (written >= 0)
+            p->targets |= mem_targets[written];
+        if (i->op == CHAOS_OP_FMW)
+            p->targets |= CHAOS_TARGET_FM;
+
+        loop[pc] = depth ? stack[depth - 1] : -1;
+
+        if (i->op == CHAOS_OP_REP)
+        {
+            if (depth == CHAOS_VM_DEPTH)
+                return pc + 1;
+            stack[depth++] = pc;
+        }
+        else if (i->op == CHAOS_OP_END)
+        {
+            if (!depth)
+                return pc + 1;
+            depth--;
+            p->match[pc] = stack[depth];
+            p->match[stack[depth]] = pc;
+        }
+    }
+    if (depth)
+        return stack[depth - 1] + 1;
+
+    /* branches land forward, in the same loop body (its END continues) */
+    for (pc = 0; pc < p->count; pc++)
+    {
+        const chaos_insn_t *i = &p->code[pc];
+        int target = pc + 1 + i->c;
+
+        if ((i->op < CHAOS_OP_BEQ) || (i->op > CHAOS_OP_JMP))
+            continue;
+        if (target > p->count)
+            return pc + 1;
+        if (target < p->count)
+        {
+            int inside = (p->code[target].op == CHAOS_OP_END) ? p->match[target] : loop[target];
+            if (inside != loop[pc])
+                return pc + 1;
+        }
+        else if (loop[pc] >= 0)
+        {
+            return pc + 1;
+        }
+    }
+    return 0;
+}
+
+int chaos_vm_load(int slot)
+{
+    chaos_program_t *p;
+    int count = staging[0] | (staging[1] << 8);
+    int bad;
+
+    load_error = -1;
+    if (((unsigned int)slot >= CHAOS_VM_PROGRAMS) || (count > CHAOS_VM_CODE_MAX))
+        return 0;
+
+    p = &programs[slot];
+    p->count = count;
+    memcpy(p->code, staging + 2, count * sizeof(chaos_insn_t));
+
+    bad = validate(p);
+    if (bad)
+    {
+        load_error = bad - 1;
+        p->count = 0;
+        return 0;
+    }
+
+    chaos_record_bytes(CHAOS_RECORD_VM_LOAD, slot, staging, 2 + count * sizeof(chaos_insn_t));
+    return 1;
+}
+
+int chaos_vm_targets(int slot)
+{
+    return ((unsigned int)slot < CHAOS_VM_PROGRAMS) ? programs[slot].targets : 0;
+}
+
+void chaos_vm_frame(void)
+{
+    frame++;
+}
+
+void chaos_vm_reset(void)
+{
+    frame = 0;
+}
+
+/* ======================================================================== */
+/* Execution                                                                */
+/* ======================================================================== */
+
+/* written VRAM and CRAM spans of the current run */
+static int dirty_lo[2], dirty_hi[2];
+
+static void touch(int mem, int addr, int len)
+{
+    if (mem > CHAOS_VM_CRAM)
+        return;
+    if (addr < dirty_lo[mem])
+        dirty_lo[mem] = addr;
+    if (addr + len > dirty_hi[mem])
+        dirty_hi[mem] = addr + len;
+}
+
+static void store(int mem, uint32_t addr, int value)
+{
+    addr &= mem_sizes[mem] - 1;
+    chaos_undo_save(mem, addr, 1);
+
+    if (mem == CHAOS_VM_VDP_REGS)
+    {
+        reg[addr] = value;
+        if (addr == 5)
+            satb = (reg[5] << 9) & 0xFE00;
+        else if (addr == 12)
+            bitmap.viewport.changed |= 2;
+        return;
+    }
+
+    mem_base(mem)[addr] = value;
+    touch(mem, addr, 1);
+}
+
+/* range op on mem, returns its cost */
+static int range(int op, int mem, int32_t start, int32_t len, int32_t param)
+{
+    int size = mem_sizes[mem];
+    uint8_t *buf;
+
+    start &= size - 1;
+    if (len > size - start)
+        len = size - start;
+    if (len <= 0)
+        return 1;
+
+    buf = mem_base(mem) + start;
+    switch (op)
+    {
+        case CHAOS_OP_XORR:
+            chaos_undo_swap_xor(mem, start, len, 0, param);
+            chaos_kernel_xor(buf, len, (uint8_t)param);
+            break;
+
+        case CHAOS_OP_SHIFTR:
+            chaos_undo_shift(mem, start, len, 0, param % len);
+            chaos_kernel_shift(buf, len, param % len, 0);
+            break;
+
+        case CHAOS_OP_ROTR:
+            chaos_undo_rotate(mem, start, len, param % len);
+            chaos_kernel_rotate(buf, len, param % len);
+            break;
+
+        case CHAOS_OP_NIBR:
+            chaos_undo_swap_xor(mem, start, len, 1, 0);
+            chaos_kernel_nibble_swap(buf, len);
+            break;
+
+        case CHAOS_OP_FILLR:
+            chaos_undo_save(mem, start, len);
+            memset(buf, (uint8_t)param, len);
+            break;
+
+        case CHAOS_OP_RANDR:
+        {
+            int i;
+            chaos_undo_save(mem, start, len);
+            for (i = 0; i < len; i++)
+                buf[i] = chaos_rand(CHAOS_RNG_VM) >> 24;
+            break;
+        }
+    }
+
+    touch(mem, start, len);
+    return 1 + (len >> 4);
+}
+
+int chaos_vm_run(int slot, float intensity)
+{
+    const chaos_program_t *p;
+    int32_t r[CHAOS_VM_REGS];
+    int loops[CHAOS_VM_DEPTH];
+    int depth = 0;
+    int budget = CHAOS_VM_BUDGET;
+    int pc = 0;
+
+    if (((unsigned int)slot >= CHAOS_VM_PROGRAMS) || !programs[slot].count)
+        return 0;
+
+    p = &programs[slot];
+    memset(r, 0, sizeof(r));
+    r[0] = (int32_t)(((intensity > 1.0f) ? 1.0f : (intensity < 0.0f) ? 0.0f : intensity) * 256.0f);
+    r[1] = frame;
+    r[2] = v_counter;
+    dirty_lo[0] = dirty_lo[1] = 0x10000;
+    dirty_hi[0] = dirty_hi[1] = 0;
+
+    while ((pc < p->count) && (budget > 0))
+    {
+        const chaos_insn_t *i = &p->code[pc++];
+
+        budget--;
+        switch (i->op)
+        {
+            case CHAOS_OP_HALT:  pc = p->count; break;
+            case CHAOS_OP_LDI:   r[i->a] = i->b | (i->c << 8); break;
+            case CHAOS_OP_LDIH:  r[i->a] = (r[i->a] & 0xFFFF) | ((uint32_t)(i->b | (i->c << 8)) << 16); break;
+            case CHAOS_OP_MOV:   r[i->a] = r[i->b]; break;
+            case CHAOS_OP_ADD:   r[i->a] = (uint32_t)r[i->b] + (uint32_t)r[i->c]; break;
+            case CHAOS_OP_SUB:   r[i->a] = (uint32_t)r[i->b] - (uint32_t)r[i->c]; break;
+            case CHAOS_OP_AND:   r[i->a] = r[i->b] & r[i->c]; break;
+            case CHAOS_OP_OR:    r[i->a] = r[i->b] | r[i->c]; break;
+            case CHAOS_OP_XOR:   r[i->a] = r[i->b] ^ r[i->c]; break;
+            case CHAOS_OP_SHL:   r[i->a] = (uint32_t)r[i->b] << (r[i->c] & 31); break;
+            case CHAOS_OP_SHR:   r[i->a] = (uint32_t)r[i->b] >> (r[i->c] & 31); break;
+            case CHAOS_OP_MUL:   r[i->a] = (uint32_t)r[i->b] * (uint32_t)r[i->c]; break;
+            case CHAOS_OP_ADDI:  r[i->a] = (uint32_t)r[i->b] + (int8_t)i->c; break;
+
+            case CHAOS_OP_RAND:
+                r[i->a] = (r[i->b] > 0) ? chaos_rand_below(CHAOS_RNG_VM, r[i->b]) : (int32_t)chaos_rand(CHAOS_RNG_VM);
+                break;
+
+            case CHAOS_OP_LD:
+                r[i->a] = mem_base(i->b)[r[i->c] & (mem_sizes[i->b] - 1)];
+                break;
+
+            case CHAOS_OP_ST:
+                store(i->b, r[i->c], r[i->a]);
+                break;
+
+            case CHAOS_OP_XORR:
+            case CHAOS_OP_SHIFTR:
+            case CHAOS_OP_ROTR:
+            case CHAOS_OP_NIBR:
+            case CHAOS_OP_FILLR:
+            case CHAOS_OP_RANDR:
+                budget -= range(i->op, i->c & 15, r[i->a], r[i->b], r[i->c >> 4]) - 1;
+                break;
+
+            case CHAOS_OP_FMW:
+                chaos_fm_write(v_counter, i->c ? 2 : 0, r[i->a] & 0xFF, r[i->b] & 0xFF);
+                break;
+
+            case CHAOS_OP_BEQ:   if (r[i->a] == r[i->b]) pc += i->c; break;
+            case CHAOS_OP_BNE:   if (r[i->a] != r[i->b]) pc += i->c; break;
+            case CHAOS_OP_BLT:   if (r[i->a] < r[i->b]) pc += i->c; break;
+            case CHAOS_OP_JMP:   pc += i->c; break;
+
+            case CHAOS_OP_REP:
+            {
+                int n = (r[i->a] > CHAOS_VM_LOOP_MAX) ? CHAOS_VM_LOOP_MAX : r[i->a];
+                if (n <= 0)
+                    pc = p->match[pc - 1] + 1;
+                else
+                    loops[depth++] = n;
+                break;
+            }
+
+            case CHAOS_OP_END:
+                if (--loops[depth - 1] > 0)
+                    pc = p->match[pc - 1] + 1;
+                else
+                    depth--;
+                break;
+        }
+    }
+
+    if (dirty_hi[0])
+        chaos_dirty_vram(dirty_lo[0], dirty_hi[0] - dirty_lo[0]);
+    if (dirty_hi[1])
+        chaos_dirty_cram(dirty_lo[1], dirty_hi[1] - dirty_lo[1]);
+    return 1;
+}
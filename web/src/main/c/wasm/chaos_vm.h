@@ -0,0 +1,125 @@
+#ifndef _CHAOS_VM_H_
+#define _CHAOS_VM_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* User-defined chaos effects.
+ *
+ * A user effect is a small program for a register machine: 16 int32
+ * registers and 4-byte instructions { op, a, b, c }. Programs are checked
+ * once when loaded (chaos_vm_load()): registers and memories in range,
+ * branches forward only and within their loop, REP/END balanced, so a
+ * program always terminates; a cost budget per run bounds nested loops.
+ *
+ * Program slot n is effect id CHAOS_FX_USER + n (chaos.h): it goes through
+ * chaos_apply() like the built-in effects, so bindings, raster schedules and
+ * the command queue run it at the same sync points. On entry r0 is the
+ * intensity (0-256), r1 the frame counter and r2 the current line.
+ *
+ * The range ops work on whole byte ranges with the bulk kernels
+ * (chaos_kernels.h), so a program pays the interpreter once per range, not
+ * once per byte. Loading a program is recorded in chaos sessions.
+ *
+ * Instructions (rX: register X, imm16: b | c << 8):
+ *   HALT                         end of the program
+ *   LDI   rd, imm16              rd = imm16
+ *   LDIH  rd, imm16              rd bits 16-31 = imm16
+ *   MOV   rd, rs                 rd = rs
+ *   ADD/SUB/AND/OR/XOR/SHL/SHR/MUL rd, rs, rt
+ *   ADDI  rd, rs, imm8           rd = rs + (signed) c
+ *   RAND  rd, rs                 rd = 0 to rs - 1 (rs <= 0: 32 random bits)
+ *   LD    rd, mem, raddr         rd = mem[raddr]
+ *   ST    rs, mem, raddr         mem[raddr] = rs
+ *   XORR/SHIFTR/ROTR/NIBR/FILLR/RANDR rstart, rlen, mem | rparam << 4
+ *                                range [rstart, rstart + rlen) of mem,
+ *                                clipped to it: xor with rparam, shift or
+ *                                rotate by rparam bytes, swap nibbles, fill
+ *                                with rparam, random bytes
+ *   FMW   rreg, rval, bank       YM2612 port 'bank' (0, 1) register rreg =
+ *                                rval, on the current line
+ *   BEQ/BNE/BLT ra, rb, skip     skip the next 'skip' instructions if
+ *                                ra == rb, != or < (signed)
+ *   JMP   skip                   skip the next 'skip' instructions (in c)
+ *   REP   rcount                 run the body up to the matching END rcount
+ *                                times (clamped to CHAOS_VM_LOOP_MAX)
+ *   END
+ * Memories: VRAM, CRAM, VSRAM, 68k work RAM, Z80 RAM, VDP registers (not
+ * for the range ops). Addresses wrap around the memory size.
+ */
+
+#define CHAOS_VM_PROGRAMS  16
+#define CHAOS_VM_CODE_MAX  256  /* instructions per program */
+#define CHAOS_VM_REGS      16
+#define CHAOS_VM_DEPTH     4    /* nested REP */
+#define CHAOS_VM_LOOP_MAX  4096
+#define CHAOS_VM_BUDGET    0x40000 /* per run: 1 per instruction, 1 per 16 range bytes */
+
+/* Opcodes */
+enum
+{
+    CHAOS_OP_HALT = 0,
+    CHAOS_OP_LDI,
+    CHAOS_OP_LDIH,
+    CHAOS_OP_MOV,
+    CHAOS_OP_ADD,
+    CHAOS_OP_SUB,
+    CHAOS_OP_AND,
+    CHAOS_OP_OR,
+    CHAOS_OP_XOR,
+    CHAOS_OP_SHL,
+    CHAOS_OP_SHR,
+    CHAOS_OP_MUL,
+    CHAOS_OP_ADDI,
+    CHAOS_OP_RAND,
+    CHAOS_OP_LD,
+    CHAOS_OP_ST,
+    CHAOS_OP_XORR,
+    CHAOS_OP_SHIFTR,
+    CHAOS_OP_ROTR,
+    CHAOS_OP_NIBR,
+    CHAOS_OP_FILLR,
+    CHAOS_OP_RANDR,
+    CHAOS_OP_FMW,
+    CHAOS_OP_BEQ,
+    CHAOS_OP_BNE,
+    CHAOS_OP_BLT,
+    CHAOS_OP_JMP,
+    CHAOS_OP_REP,
+    CHAOS_OP_END,
+    CHAOS_OP_COUNT
+};
+
+/* Memories */
+#define CHAOS_VM_VRAM     0
+#define CHAOS_VM_CRAM     1
+#define CHAOS_VM_VSRAM    2
+#define CHAOS_VM_WORK_RAM 3
+#define CHAOS_VM_ZRAM     4
+#define CHAOS_VM_VDP_REGS 5
+#define CHAOS_VM_MEMS     6
+
+/* Staging buffer for the front-end: uint16 instruction count, then the
+ * instructions; chaos_vm_load() copies it into a slot */
+uint8_t* EMSCRIPTEN_KEEPALIVE chaos_vm_buffer(void);
+
+/* Check and load the staged program into 'slot' (0 instructions: free the
+ * slot); returns 0 if it is rejected, see chaos_vm_error() */
+int EMSCRIPTEN_KEEPALIVE chaos_vm_load(int slot);
+
+/* Index of the instruction the last chaos_vm_load() rejected, -1 if none
+ * (or the slot or count itself) */
+int EMSCRIPTEN_KEEPALIVE chaos_vm_error(void);
+
+/* Run program 'slot' (chaos_apply()); returns 0 if the slot is empty */
+int chaos_vm_run(int slot, float intensity);
+
+/* CHAOS_TARGET_* written by program 'slot', 0 if the slot is empty */
+int chaos_vm_targets(int slot);
+
+/* Frame counter (frame start) and its reset (chaos_reset(): the programs
+ * are kept, like the binding table) */
+void chaos_vm_frame(void);
+void chaos_vm_reset(void);
+
+#endif /* _CHAOS_VM_H_ */
@@ -0,0 +1,158 @@
+/**
+ * ChaosDrive - VRAM usage map
+ *
+ * Tables are marked last, so a pattern overlapping a table is never counted
+ * as tiles: corrupting it would garble names or sprites instead of pixels,
+ * and the renderer reads those areas raw (see chaos_dirty.c).
+ */
+
+#include "shared.h"
+#include "chaos_vram.h"
+
+static uint8 map[0x800];
+static int map_valid;
+
+/* ======================================================================== */
+/* Classifier                                                               */
+/* ======================================================================== */
+
+static int window_enabled(void)
+{
+    return (reg[17] & 0x1F) || (reg[18] & 0x9F);
+}
+
+static void mark_table(int base, int size, int type)
+{
+    int name;
+
+    for (name = base >> 5; name <= ((base + size - 1) >> 5); name++)
+    {
+        map[name & 0x7FF] = type;
+    }
+}
+
+static void mark_pattern(int name)
+{
+    /* interlace mode 2 patterns are 64 bytes */
+    if (im2_flag)
+    {
+        name = (name & 0x3FF) << 1;
+        map[name] = CHAOS_VRAM_TILES;
+        map[name | 1] = CHAOS_VRAM_TILES;
+    }
+    else
+    {
+        map[name & 0x7FF] = CHAOS_VRAM_TILES;
+    }
+}
+
+static void mark_names(int base, int size)
+{
+    int addr;
+
+    for (addr = base; addr < base + size; addr += 2)
+    {
+        mark_pattern(*(uint16 *)&vram[addr & 0xFFFE]);
+    }
+}
+
+static void mark_sprites(void)
+{
+    const uint16 *q = (const uint16 *)sat;
+    const uint16 *p = (const uint16 *)&vram[satb];
+    int max = (reg[12] & 0x01) ? 80 : 64;
+    int link = 0;
+    int count = 0;
+
+    /* same chain as parse_satb_m5(): size & link from the SAT cache,
+       pattern from VRAM */
+    do
+    {
+        int size = q[link + 1] >> 8;
+        int tiles = (((size >> 2) & 3) + 1) * ((size & 3) + 1);
+        int name = p[link + 2];
+
+        while (tiles--)
+        {
+            mark_pattern(name++);
+        }
+
+        link = (q[link + 1] & 0x7F) << 2;
+    }
+    while (link && (link < (max << 2)) && (++count < max));
+}
+
+static int plane_size(void)
+{
+    /* row size is 1 << playfield_shift bytes (see chaos_dirty.c) */
+    int size = ((playfield_row_mask + 1) >> 3) << (playfield_shift ? playfield_shift : 6);
+    return (size > 0x2000) ? 0x2000 : size;
+}
+
+static void build_map(void)
+{
+    int size = plane_size();
+    int window = (reg[12] & 0x01) ? 0x1000 : 0x800;
+
+    memset(map, CHAOS_VRAM_UNUSED, sizeof(map));
+    map_valid = 1;
+
+    if (!(reg[1] & 0x04))
+        return;
+
+    mark_names(ntab, size);
+    mark_names(ntbb, size);
+    if (window_enabled())
+        mark_names(ntwb, window);
+    mark_sprites();
+
+    mark_table(hscb, 0x3C0, CHAOS_VRAM_HSCROLL);
+    mark_table(satb, (reg[12] & 0x01) ? 0x280 : 0x200, CHAOS_VRAM_SAT);
+    if (window_enabled())
+        mark_table(ntwb, window, CHAOS_VRAM_WINDOW);
+    mark_table(ntbb, size, CHAOS_VRAM_PLANE_B);
+    mark_table(ntab, size, CHAOS_VRAM_PLANE_A);
+}
+
+/* ======================================================================== */
+/* Queries                                                                  */
+/* ======================================================================== */
+
+void chaos_vram_invalidate(void)
+{
+    map_valid = 0;
+}
+
+const uint8_t *chaos_vram_map(void)
+{
+    if (!map_valid)
+        build_map();
+    return map;
+}
+
+int chaos_vram_runs(int type, chaos_vram_run_t *runs)
+{
+    int count = 0;
+    int name = 0;
+
+    chaos_vram_map();
+
+    while (name < 0x800)
+    {
+        int first;
+
+        if (map[name] != type)
+        {
+            name++;
+            continue;
+        }
+
+        for (first = name; (name < 0x800) && (map[name] == type); name++);
+
+        runs[count].start = first << 5;
+        runs[count].len = (name - first) << 5;
+        count++;
+    }
+
+    return count;
+}
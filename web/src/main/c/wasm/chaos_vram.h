@@ -0,0 +1,41 @@
+#ifndef _CHAOS_VRAM_H_
+#define _CHAOS_VRAM_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* VRAM usage map for the VRAM effects.
+ *
+ * Each 32-byte pattern of VRAM is classified from the table bases (reg[2],
+ * reg[3], reg[4], reg[5] and reg[13]) and from the names the renderer
+ * fetches: the plane A, B and window name entries and the sprites linked
+ * from sprite #0. The map is built on first use in a frame and again after
+ * VBlank, so effects can corrupt the tiles on screen rather than all 64KB.
+ * Mode 5 only; in Mode 4 no pattern is classified.
+ */
+
+#define CHAOS_VRAM_UNUSED  0
+#define CHAOS_VRAM_TILES   1  /* pattern named by a plane or a sprite */
+#define CHAOS_VRAM_PLANE_A 2
+#define CHAOS_VRAM_PLANE_B 3
+#define CHAOS_VRAM_WINDOW  4
+#define CHAOS_VRAM_SAT     5
+#define CHAOS_VRAM_HSCROLL 6
+
+typedef struct
+{
+    int start;  /* VRAM address */
+    int len;    /* bytes, a multiple of 32 */
+} chaos_vram_run_t;
+
+/* Rebuild the map on next use (called at frame start and after VBlank) */
+void chaos_vram_invalidate(void);
+
+/* Runs of consecutive patterns of class 'type'; returns their count (at
+ * most 0x400) */
+int chaos_vram_runs(int type, chaos_vram_run_t *runs);
+
+/* Class of each pattern (0x800 entries) */
+const uint8_t* EMSCRIPTEN_KEEPALIVE chaos_vram_map(void);
+
+#endif /* _CHAOS_VRAM_H_ */
@@ -0,0 +1,154 @@
+/**
+ * ChaosDrive - crash watchdog
+ *
+ * Each sign has its own run of frames. The PC is only looked at once per
+ * frame: a loop run keeps going while the samples stay within LOOP_RANGE
+ * bytes, which a game's own idle loop does too, so one also needs the PC
+ * outside ROM and work RAM, or an error exception just before it started (a
+ * crash handler looping on itself). Interrupts masked are not enough: a
+ * program drawing its screen once and spinning with them masked looks the
+ * same.
+ */
+
+#include "shared.h"
+#include "chaos_checkpoint.h"
+#include "chaos_watchdog.h"
+
+/* m68kcpu.h values (private to the core) */
+#define STOPPED_STOP 1
+#define STOPPED_HALT 2
+#define RUN_MODE_NORMAL 0
+
+#define LOOP_RANGE   0x100
+#define STORM_FAULTS 8 /* error exceptions per frame */
+
+static int window;
+static int restore;
+static int state;
+static int restores;
+
+static uint last_faults;
+static uint last_lockups;
+static int last_faulted;
+
+static int storm_run;
+static int lockup_run;
+static int loop_run;
+static uint loop_min, loop_max;
+static int loop_after_fault;
+
+static void runs_clear(void)
+{
+    last_faults = m68k.faults;
+    last_lockups = m68k.lockups;
+    last_faulted = 0;
+    storm_run = 0;
+    lockup_run = 0;
+    loop_run = 0;
+}
+
+/* Code where no game runs from: past the ROM, below work RAM */
+static int outside(uint pc)
+{
+    if (system_hw == SYSTEM_MCD)
+        return 0;
+    return (pc < 0xE00000) && ((pc >= 0x400000) || (pc >= cart.romsize));
+}
+
+/* Next frame of the loop run, 1 once it is dead */
+static int loop_frame(uint pc, int faulted)
+{
+    uint min = (pc < loop_min) ? pc : loop_min;
+    uint max = (pc > loop_max) ? pc : loop_max;
+
+    if (loop_run && (max - min < LOOP_RANGE))
+    {
+        loop_min = min;
+        loop_max = max;
+    }
+    else
+    {
+        loop_run = 0;
+        loop_min = loop_max = pc;
+        loop_after_fault = faulted || last_faulted;
+    }
+
+    if (!outside(pc) && !loop_after_fault)
+    {
+        loop_run = 0;
+        return 0;
+    }
+
+    return ++loop_run >= window;
+}
+
+void chaos_watchdog_set(int frames, int restore_checkpoint)
+{
+    window = (frames < 0) ? CHAOS_WATCHDOG_FRAMES : frames;
+    restore = restore_checkpoint;
+    state = CHAOS_WATCHDOG_ALIVE;
+    runs_clear();
+}
+
+int chaos_watchdog_state(void)
+{
+    return state;
+}
+
+int chaos_watchdog_restores(void)
+{
+    return restores;
+}
+
+void chaos_watchdog_frame(void)
+{
+    uint faults, lockups;
+    uint pc = m68k.pc & 0xFFFFFF;
+
+    if (!window)
+        return;
+
+    faults = m68k.faults - last_faults;
+    lockups = m68k.lockups - last_lockups;
+    last_faults = m68k.faults;
+    last_lockups = m68k.lockups;
+
+    storm_run = (faults >= STORM_FAULTS) ? (storm_run + 1) : 0;
+    lockup_run = lockups ? (lockup_run + 1) : 0;
+
+    /* halted or stopped for good count at once */
+    if (m68k.stopped & STOPPED_HALT)
+        state = CHAOS_WATCHDOG_HALT;
+    else if ((m68k.stopped & STOPPED_STOP) && (m68k.int_mask >= 0x600))
+        state = CHAOS_WATCHDOG_STOP;
+    else if (storm_run >= window)
+        state = CHAOS_WATCHDOG_STORM;
+    else if (lockup_run >= window)
+        state = CHAOS_WATCHDOG_LOCKUP;
+    else if (loop_frame(pc, faults != 0))
+        state = CHAOS_WATCHDOG_LOOP;
+    else
+        state = CHAOS_WATCHDOG_ALIVE;
+
+    last_faulted = (faults != 0);
+
+    if ((state == CHAOS_WATCHDOG_ALIVE) || !restore)
+        return;
+
+    if (chaos_restore() < 0)
+        return;
+
+    /* the checkpoint does not hold the stopped state */
+    m68k.stopped = 0;
+    m68k.run_mode = RUN_MODE_NORMAL;
+    m68k.aerr_pending = 0;
+    restores++;
+    runs_clear();
+}
+
+void chaos_watchdog_clear(void)
+{
+    state = CHAOS_WATCHDOG_ALIVE;
+    restores = 0;
+    runs_clear();
+}
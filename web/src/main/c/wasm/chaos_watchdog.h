@@ -0,0 +1,51 @@
+#ifndef _CHAOS_WATCHDOG_H_
+#define _CHAOS_WATCHDOG_H_
+
+#include <emscripten/emscripten.h>
+
+/* Crash watchdog.
+ *
+ * Effects like program_counter_increment and random_register_corruption
+ * often leave the 68k dead behind a frozen screen: halted by a double
+ * address error or a lockup area access (mem68k.c), stopped with VBlank
+ * masked, taking an address error after another, or looping on a few bytes
+ * outside ROM and work RAM or in its crash handler. The watchdog tells them
+ * apart at the start of each frame from what the core counts anyway (the
+ * error exceptions and lockup accesses of m68ki_cpu_core, the stopped
+ * state, the PC and interrupt mask), a few compares per frame.
+ *
+ * Halted, or stopped with VBlank masked, is final and counts at once. The
+ * other states have to last the whole window, so a game recovering from one
+ * address error is left alone.
+ * With auto restore on, a dead game goes back to the last chaos checkpoint
+ * (chaos_checkpoint.h) and the CPU is woken up; without a checkpoint it is
+ * only reported. Mega Drive and Mega CD main CPU only.
+ */
+
+#define CHAOS_WATCHDOG_FRAMES 60 /* default window */
+
+/* States */
+#define CHAOS_WATCHDOG_ALIVE  0
+#define CHAOS_WATCHDOG_HALT   1 /* halted: double address error, lockup area access */
+#define CHAOS_WATCHDOG_STOP   2 /* STOP with VBlank masked */
+#define CHAOS_WATCHDOG_STORM  3 /* error exceptions every frame */
+#define CHAOS_WATCHDOG_LOCKUP 4 /* lockup area accesses every frame (config.force_dtack) */
+#define CHAOS_WATCHDOG_LOOP   5 /* a few bytes of code, outside ROM and RAM or after an error */
+
+/* Watch over 'frames' frames (0: off, -1: CHAOS_WATCHDOG_FRAMES), restoring the checkpoint when the
+ * game is found dead if 'restore' is set */
+void EMSCRIPTEN_KEEPALIVE chaos_watchdog_set(int frames, int restore);
+
+/* State found at the start of the last frame */
+int EMSCRIPTEN_KEEPALIVE chaos_watchdog_state(void);
+
+/* Checkpoints restored since the game was started */
+int EMSCRIPTEN_KEEPALIVE chaos_watchdog_restores(void);
+
+/* Look at the last frame (called once per frame, before the chaos commands) */
+void chaos_watchdog_frame(void);
+
+/* Start over (reset, new ROM), the settings kept */
+void chaos_watchdog_clear(void);
+
+#endif /* _CHAOS_WATCHDOG_H_ */
@@ -0,0 +1,528 @@
+/**
+ * ChaosDrive - Z80 sound driver structure discovery
+ *
+ * Same layout as chaos_ram.c: one table per statistic indexed like zram[],
+ * and chaos_kernel_diff() to skip the 16-byte blocks found unchanged. A word
+ * statistic is kept at the offset of its low byte, which changes with every
+ * step of a pointer. Counters are halved every 255 passes of a half.
+ */
+
+#include "shared.h"
+#include "chaos_kernels.h"
+#include "chaos_rand.h"
+#include "chaos_undo.h"
+#include "chaos_zdrv.h"
+#include "memmap.h"
+
+#define HALF        0x1000
+
+/* pointer steps: track data is read a few bytes per note, samples a few
+   hundred bytes per frame (8 to 32 kHz) */
+#define TRACK_STEP  16
+#define SAMPLE_STEP_MIN 0x40
+#define SAMPLE_STEP_MAX 0x1000
+
+/* passes of steady change before a byte is taken for a tempo accumulator,
+   and steps before a word is taken for a pointer (track pointers stepping
+   on 7 passes in 8 or more are counters) */
+#define TEMPO_RUN   48
+#define TRACK_MIN   4
+#define SAMPLE_MIN  8
+
+/* frames between two picks of the results and table searches */
+#define DISCOVER_FRAMES 32
+
+/* search distance of the tempo byte around its accumulator */
+#define TEMPO_REACH 32
+
+/* Z80 code map: one bit per 32-byte block */
+#define CODE_SHIFT  5
+
+/* note tables: at least 12 words a semitone apart (2^(1/12) = 1.0595, to
+   about 1.5%), at most 96 */
+#define NOTES_MIN   12
+#define NOTES_MAX   96
+#define RATIO_LOW   10440
+#define RATIO_HIGH  10750
+
+chaos_zdrv_t chaos_zdrv;
+
+static uint8 prev[0x2000];          /* zram[] at the last pass */
+static uint8 changes[0x2000];       /* passes where the byte changed */
+static uint8 delta[0x2000];         /* its last change */
+static uint8 steady[0x2000];        /* passes in a row with the same change */
+static uint8 track_steps[0x2000];   /* word advanced by 1 to TRACK_STEP */
+static uint8 track_keys[0x2000];    /* ... with YM2612 key on events since the last pass */
+static uint8 sample_steps[0x2000];  /* word advanced like a sample pointer while the DAC was fed */
+static uint8 jumps[0x2000];         /* word changed in any other way */
+static uint8 code[0x2000 >> (CODE_SHIFT + 3)];
+
+static uint8 passes[2];
+static uint8 keys_seen[2];          /* key on events since the last pass of each half */
+static uint8 dac_seen[2];           /* DAC writes ... */
+static int primed;
+static int half;
+static int frames;
+
+void chaos_zdrv_clear(void)
+{
+    memset(changes, 0, sizeof(changes));
+    memset(delta, 0, sizeof(delta));
+    memset(steady, 0, sizeof(steady));
+    memset(track_steps, 0, sizeof(track_steps));
+    memset(track_keys, 0, sizeof(track_keys));
+    memset(sample_steps, 0, sizeof(sample_steps));
+    memset(jumps, 0, sizeof(jumps));
+    memset(code, 0, sizeof(code));
+    memset(passes, 0, sizeof(passes));
+    memset(keys_seen, 0, sizeof(keys_seen));
+    memset(dac_seen, 0, sizeof(dac_seen));
+    primed = 0;
+    half = 0;
+    frames = 0;
+
+    memset(&chaos_zdrv, 0, sizeof(chaos_zdrv));
+    chaos_zdrv.tempo = chaos_zdrv.tempo_counter = -1;
+    chaos_zdrv.fm_table = chaos_zdrv.psg_table = -1;
+    chaos_zdrv.sample_pointer = -1;
+}
+
+void chaos_zdrv_memory_report(void)
+{
+    memory_region("chaos zdrv prev", prev, sizeof(prev));
+    memory_region("chaos zdrv changes", changes, sizeof(changes));
+    memory_region("chaos zdrv delta", delta, sizeof(delta));
+    memory_region("chaos zdrv steady", steady, sizeof(steady));
+    memory_region("chaos zdrv track_steps", track_steps, sizeof(track_steps));
+    memory_region("chaos zdrv track_keys", track_keys, sizeof(track_keys));
+    memory_region("chaos zdrv sample_steps", sample_steps, sizeof(sample_steps));
+    memory_region("chaos zdrv jumps", jumps, sizeof(jumps));
+}
+
+INLINE int is_code(int offset)
+{
+    offset >>= CODE_SHIFT;
+    return code[offset >> 3] & (1 << (offset & 7));
+}
+
+INLINE int word_at(int offset)
+{
+    return zram[offset] | (zram[offset + 1] << 8);
+}
+
+INLINE uint8 saturate(uint8 count)
+{
+    return (count < 255) ? (count + 1) : 255;
+}
+
+/* halve the counters of a half */
+static void decay_half(int h)
+{
+    int i;
+
+    for (i = h * HALF; i < (h + 1) * HALF; i++)
+    {
+        changes[i] >>= 1;
+        track_steps[i] >>= 1;
+        track_keys[i] >>= 1;
+        sample_steps[i] >>= 1;
+        jumps[i] >>= 1;
+    }
+    passes[h] >>= 1;
+}
+
+/* 'count' words from 'offset' a semitone apart, rising (step 1) or falling */
+static int note_run(int offset, int step)
+{
+    int count = 1;
+    int last = word_at(offset);
+
+    while ((count < NOTES_MAX) && (offset + count * 2 + 1 < 0x2000))
+    {
+        int next = word_at(offset + count * 2);
+        int ratio;
+
+        if (!last || !next)
+            break;
+        ratio = (step > 0) ? ((next * 10000) / last) : ((last * 10000) / next);
+        if ((ratio < RATIO_LOW) || (ratio > RATIO_HIGH))
+            break;
+        last = next;
+        count++;
+    }
+    return count;
+}
+
+/* first note table of zram[] in each direction: F-numbers fit 11 bits, the
+   PSG periods 10 */
+static void find_tables(void)
+{
+    int i;
+
+    chaos_zdrv.fm_table = chaos_zdrv.psg_table = -1;
+    chaos_zdrv.fm_notes = chaos_zdrv.psg_notes = 0;
+
+    for (i = 0; i + NOTES_MIN * 2 <= 0x2000; i++)
+    {
+        int first = word_at(i);
+        int count;
+
+        if ((chaos_zdrv.fm_table < 0) && (first >= 0x100) && (first < 0x400))
+        {
+            count = note_run(i, 1);
+            if ((count >= NOTES_MIN) && (word_at(i + (count - 1) * 2) < 0x800))
+            {
+                chaos_zdrv.fm_table = i;
+                chaos_zdrv.fm_notes = count;
+                i += count * 2 - 1;
+                continue;
+            }
+        }
+
+        if ((chaos_zdrv.psg_table < 0) && (first >= 0x100) && (first < 0x400))
+        {
+            count = note_run(i, -1);
+            if (count >= NOTES_MIN)
+            {
+                chaos_zdrv.psg_table = i;
+                chaos_zdrv.psg_notes = count;
+                i += count * 2 - 1;
+            }
+        }
+    }
+}
+
+/* the constant byte closest to a tempo accumulator which, added every
+   frame, gives its change over a pass (two frames) */
+static int find_tempo(int counter)
+{
+    int d, i;
+
+    for (d = 1; d <= TEMPO_REACH; d++)
+    {
+        for (i = counter - d; i <= counter + d; i += 2 * d)
+        {
+            if ((i < 0) || (i >= 0x2000) || changes[i] || is_code(i))
+                continue;
+            if (zram[i] && (((zram[i] * 2) & 0xFF) == delta[counter]))
+                return i;
+        }
+    }
+    return -1;
+}
+
+static void insert_track(int offset, int score, int *scores)
+{
+    int i, count = chaos_zdrv.track_count;
+
+    if ((count == CHAOS_ZDRV_TRACKS) && (score <= scores[count - 1]))
+        return;
+    if (count < CHAOS_ZDRV_TRACKS)
+        chaos_zdrv.track_count = ++count;
+
+    for (i = count - 1; (i > 0) && (scores[i - 1] < score); i--)
+    {
+        chaos_zdrv.tracks[i] = chaos_zdrv.tracks[i - 1];
+        scores[i] = scores[i - 1];
+    }
+    chaos_zdrv.tracks[i] = offset;
+    scores[i] = score;
+}
+
+/* pick the structures from the statistics */
+static void discover(void)
+{
+    int scores[CHAOS_ZDRV_TRACKS];
+    int best_tempo = 0, best_sample = 0;
+    int i;
+
+    chaos_zdrv.tempo = chaos_zdrv.tempo_counter = -1;
+    chaos_zdrv.sample_pointer = -1;
+    chaos_zdrv.track_count = 0;
+
+    for (i = 0; i < 0x2000 - 1; i++)
+    {
+        if (!changes[i] || is_code(i))
+            continue;
+
+        /* steps of one a frame are frame counters */
+        if ((steady[i] >= TEMPO_RUN) && (steady[i] > best_tempo) && (delta[i] != 2) && (delta[i] != 0xFE))
+        {
+            int tempo = find_tempo(i);
+            if (tempo >= 0)
+            {
+                chaos_zdrv.tempo = tempo;
+                chaos_zdrv.tempo_counter = i;
+                best_tempo = steady[i];
+            }
+        }
+
+        /* not counters stepping every pass, nor the high byte of a busier
+           pointer */
+        if ((track_steps[i] >= TRACK_MIN) && (track_steps[i] >= jumps[i]) &&
+            (changes[i] * 8 < passes[i / HALF] * 7) &&
+            (!i || (track_steps[i - 1] + sample_steps[i - 1] < track_steps[i])))
+        {
+            /* Z80 RAM or the 68k bank window */
+            int pointer = word_at(i);
+            if ((pointer < 0x2000) || (pointer >= 0x8000))
+                insert_track(i, track_steps[i] + track_keys[i], scores);
+        }
+
+        if ((sample_steps[i] >= SAMPLE_MIN) && (sample_steps[i] > jumps[i]) && (sample_steps[i] > best_sample))
+        {
+            chaos_zdrv.sample_pointer = i;
+            best_sample = sample_steps[i];
+        }
+    }
+
+    find_tables();
+
+    chaos_zdrv.flags &= CHAOS_ZDRV_RUNNING;
+    if ((chaos_zdrv.tempo >= 0) || chaos_zdrv.track_count)
+        chaos_zdrv.flags |= CHAOS_ZDRV_SEQUENCER;
+    if ((chaos_zdrv.sample_pointer >= 0) || (chaos_zdrv.dac_writes >= 100))
+        chaos_zdrv.flags |= CHAOS_ZDRV_STREAMER;
+}
+
+void chaos_zdrv_sample(void)
+{
+    uint8 blocks[HALF >> 7];
+    int h = half;
+    int base = h * HALF;
+    int end = base + HALF;
+    int i, j;
+
+    /* what the sound chip did last frame, seen by the next pass of each half */
+    if (sound_meter.key_on)
+        keys_seen[0] = keys_seen[1] = 1;
+    if (sound_meter.dac_writes)
+        dac_seen[0] = dac_seen[1] = 1;
+    chaos_zdrv.dac_writes += (sound_meter.dac_writes - chaos_zdrv.dac_writes) / 8;
+
+    /* a Z80 held in reset or off the bus runs no driver, and the 68k may be
+       loading one: start over from a new copy once it runs */
+    if (zstate != 1)
+    {
+        chaos_zdrv.flags &= ~CHAOS_ZDRV_RUNNING;
+        primed = 0;
+        return;
+    }
+    chaos_zdrv.flags |= CHAOS_ZDRV_RUNNING;
+
+    i = (Z80.pc.w.l & 0x1FFF) >> CODE_SHIFT;
+    code[i >> 3] |= 1 << (i & 7);
+
+    if (++frames == DISCOVER_FRAMES)
+    {
+        frames = 0;
+        discover();
+    }
+
+    half ^= 1;
+    if (!(primed & (1 << h)))
+    {
+        memcpy(prev + base, zram + base, HALF);
+        primed |= 1 << h;
+        keys_seen[h] = dac_seen[h] = 0;
+        return;
+    }
+
+    if (passes[h] == 255)
+        decay_half(h);
+    passes[h]++;
+    chaos_zdrv.passes++;
+
+    if (chaos_kernel_diff(zram + base, prev + base, HALF, blocks))
+    {
+        for (i = 0; i < HALF; i += 16)
+        {
+            if (!(blocks[i >> 7] & (1 << ((i >> 4) & 7))))
+                continue;
+
+            for (j = base + i; j < base + i + 16; j++)
+            {
+                uint8 d = zram[j] - prev[j];
+
+                if (!d)
+                {
+                    steady[j] = 0;
+                    continue;
+                }
+
+                changes[j] = saturate(changes[j]);
+                steady[j] = (d == delta[j]) ? saturate(steady[j]) : 0;
+                delta[j] = d;
+
+                /* the word this byte is the low byte of (prev[j + 1] is
+                   still the old high byte) */
+                if (j + 1 < end)
+                {
+                    int step = (uint16)(word_at(j) - (prev[j] | (prev[j + 1] << 8)));
+
+                    if (step <= TRACK_STEP)
+                    {
+                        track_steps[j] = saturate(track_steps[j]);
+                        if (keys_seen[h])
+                            track_keys[j] = saturate(track_keys[j]);
+                    }
+                    else if (dac_seen[h] && (step >= SAMPLE_STEP_MIN) && (step <= SAMPLE_STEP_MAX))
+                        sample_steps[j] = saturate(sample_steps[j]);
+                    else
+                        jumps[j] = saturate(jumps[j]);
+                }
+
+                prev[j] = zram[j];
+            }
+        }
+    }
+
+    keys_seen[h] = dac_seen[h] = 0;
+}
+
+/* ======================================================================== */
+/* Effects                                                                  */
+/* ======================================================================== */
+
+INLINE void add_word(int offset, int amount)
+{
+    int value = word_at(offset) + amount;
+    chaos_undo_save(CHAOS_UNDO_ZRAM, offset, 2);
+    zram[offset] = value & 0xFF;
+    zram[offset + 1] = (value >> 8) & 0xFF;
+}
+
+/* -range to range, not 0 */
+static int nudge(int range)
+{
+    int n = chaos_rand_below(CHAOS_RNG_AUDIO, range) + 1;
+    return chaos_rand_below(CHAOS_RNG_AUDIO, 2) ? n : -n;
+}
+
+int chaos_zdrv_corrupt(int writes, int range)
+{
+    int tracks = chaos_zdrv.track_count;
+    int tempo = (chaos_zdrv.tempo >= 0);
+    int sample = (chaos_zdrv.sample_pointer >= 0);
+    int notes = chaos_zdrv.fm_notes + chaos_zdrv.psg_notes;
+    int targets = tracks + tempo + sample + (notes ? 1 : 0);
+    int i;
+
+    if (!targets)
+        return 0;
+
+    for (i = 0; i < writes; i++)
+    {
+        int target = chaos_rand_below(CHAOS_RNG_AUDIO, targets);
+
+        if (target < tracks)
+        {
+            /* the sequence is read from the middle of a note or command */
+            add_word(chaos_zdrv.tracks[target], nudge(range));
+            continue;
+        }
+        target -= tracks;
+
+        if (target < tempo)
+        {
+            int value = zram[chaos_zdrv.tempo] + nudge(range);
+            chaos_undo_save(CHAOS_UNDO_ZRAM, chaos_zdrv.tempo, 1);
+            zram[chaos_zdrv.tempo] = (value < 1) ? 1 : ((value > 255) ? 255 : value);
+            continue;
+        }
+        target -= tempo;
+
+        if (target < sample)
+        {
+            add_word(chaos_zdrv.sample_pointer, nudge(range * 32));
+            continue;
+        }
+
+        /* one detuned note */
+        target = chaos_rand_below(CHAOS_RNG_AUDIO, notes);
+        if (target < chaos_zdrv.fm_notes)
+            add_word(chaos_zdrv.fm_table + target * 2, nudge(range * 4));
+        else
+            add_word(chaos_zdrv.psg_table + (target - chaos_zdrv.fm_notes) * 2, nudge(range * 4));
+    }
+    return 1;
+}
+
+int chaos_zdrv_bitcrush(int bits)
+{
+    int mask = 0xFFFF << bits;
+    int i;
+
+    if (!chaos_zdrv.fm_notes && !chaos_zdrv.psg_notes)
+        return 0;
+
+    /* pitches quantized to steps of 2^bits */
+    chaos_undo_save(CHAOS_UNDO_ZRAM, chaos_zdrv.fm_table, chaos_zdrv.fm_notes * 2);
+    chaos_undo_save(CHAOS_UNDO_ZRAM, chaos_zdrv.psg_table, chaos_zdrv.psg_notes * 2);
+    for (i = 0; i < chaos_zdrv.fm_notes; i++)
+    {
+        zram[chaos_zdrv.fm_table + i * 2] &= mask;
+    }
+    for (i = 0; i < chaos_zdrv.psg_notes; i++)
+    {
+        zram[chaos_zdrv.psg_table + i * 2] &= mask;
+    }
+    return 1;
+}
+
+/* every note of a table takes the value of the next one up (or down); the
+   entry left at the end gets the next semitone out of the table, within
+   'limit'. 'rising': the values rise with the pitch */
+static void shift_table(int table, int notes, int up, int rising, int limit)
+{
+    int i, value;
+
+    if (up)
+    {
+        value = word_at(table + (notes - 1) * 2);
+        for (i = 0; i < notes - 1; i++)
+        {
+            add_word(table + i * 2, word_at(table + i * 2 + 2) - word_at(table + i * 2));
+        }
+    }
+    else
+    {
+        value = word_at(table);
+        for (i = notes - 1; i > 0; i--)
+        {
+            add_word(table + i * 2, word_at(table + i * 2 - 2) - word_at(table + i * 2));
+        }
+    }
+
+    value = (rising == up) ? ((value * 10595) / 10000) : ((value * 10000) / 10595);
+    if (value > limit)
+        value = limit;
+    if (value < 1)
+        value = 1;
+    i = up ? (notes - 1) : 0;
+    add_word(table + i * 2, value - word_at(table + i * 2));
+}
+
+int chaos_zdrv_transpose(int semitones)
+{
+    int up = (semitones > 0);
+    int n = up ? semitones : -semitones;
+
+    if (!chaos_zdrv.fm_notes && !chaos_zdrv.psg_notes)
+        return 0;
+
+    /* F-numbers rise with the pitch, PSG periods fall */
+    while (n--)
+    {
+        if (chaos_zdrv.fm_notes)
+            shift_table(chaos_zdrv.fm_table, chaos_zdrv.fm_notes, up, 1, 0x7FF);
+        if (chaos_zdrv.psg_notes)
+            shift_table(chaos_zdrv.psg_table, chaos_zdrv.psg_notes, up, 0, 0x3FF);
+    }
+    return 1;
+}
+
+chaos_zdrv_t *chaos_zdrv_ref(void)
+{
+    return &chaos_zdrv;
+}
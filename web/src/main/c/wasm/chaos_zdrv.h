@@ -0,0 +1,75 @@
+#ifndef _CHAOS_ZDRV_H_
+#define _CHAOS_ZDRV_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Z80 sound driver structure discovery for the Z80 RAM effects.
+ *
+ * While the Z80 runs, one half of zram[] is compared every frame with its
+ * copy from the previous pass (2 frames ago), and per-byte statistics are
+ * kept: bytes stepping by the same amount every pass (tempo accumulators),
+ * 16-bit little endian words advancing a few bytes at a time, more often
+ * while the YM2612 keys notes on (sequence/track pointers) or by hundreds of
+ * bytes while the DAC is fed (sample pointers). Every 32 frames the results
+ * are picked again and zram[] is searched for a table of 12 words a
+ * semitone apart (FM F-numbers rising, PSG periods falling). The Z80 PC is
+ * sampled once a frame so that bytes in blocks the driver runs from are
+ * never taken for variables.
+ *
+ * The driver is classified by what it does, not by signatures: a sequencer
+ * (tempo or track pointers found) and/or a sample streamer (sample pointer
+ * found, or many DAC writes a frame). corrupt_dac_data, bitcrush_audio_memory
+ * and shift_audio_memory_up/down make a few writes to what was found, and
+ * fall back to their blind zram[] versions when nothing was.
+ *
+ * Offsets are zram[] indices (Z80 addresses 0x0000-0x1FFF).
+ */
+
+#define CHAOS_ZDRV_TRACKS 8
+
+/* flags */
+#define CHAOS_ZDRV_RUNNING   1  /* Z80 running at the last frame */
+#define CHAOS_ZDRV_SEQUENCER 2
+#define CHAOS_ZDRV_STREAMER  4
+
+/* 32-bit fields only, JS reads it through an Int32Array view; -1 for not found */
+typedef struct
+{
+    int32_t flags;
+    int32_t passes;                     /* passes analysed since the last clear */
+    int32_t tempo;                      /* tempo byte */
+    int32_t tempo_counter;              /* accumulator it is added to every frame */
+    int32_t fm_table;                   /* first F-number of the FM note table */
+    int32_t fm_notes;                   /* its length in words */
+    int32_t psg_table;                  /* first period of the PSG note table */
+    int32_t psg_notes;
+    int32_t sample_pointer;             /* DAC sample pointer (low byte) */
+    int32_t dac_writes;                 /* DAC writes a frame, running average */
+    int32_t track_count;
+    int32_t tracks[CHAOS_ZDRV_TRACKS];  /* track pointers (low byte), best first */
+} chaos_zdrv_t;
+
+extern chaos_zdrv_t chaos_zdrv;
+
+/* Analyse the next half of zram[] (called once per frame) */
+void chaos_zdrv_sample(void);
+
+/* Forget all statistics (new ROM loaded) */
+void chaos_zdrv_clear(void);
+
+/* Add the statistics to the memory report */
+void chaos_zdrv_memory_report(void);
+
+/* Effects: return 0 when nothing usable was found (the caller falls back to
+ * its blind version). chaos_zdrv_corrupt() makes 'writes' nudges of up to
+ * 'range' units (track bytes, tempo units; 4 times that in note table
+ * units, 32 times that in sample bytes) to the structures found. */
+int chaos_zdrv_corrupt(int writes, int range);
+int chaos_zdrv_bitcrush(int bits);
+int chaos_zdrv_transpose(int semitones);
+
+/* chaos_zdrv, for the front-end */
+chaos_zdrv_t* EMSCRIPTEN_KEEPALIVE chaos_zdrv_ref(void);
+
+#endif /* _CHAOS_ZDRV_H_ */
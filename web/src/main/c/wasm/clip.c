@@ -0,0 +1,65 @@
+/**
+ * ChaosDrive - instant replay frame
+ *
+ * See clip.h. The palette is the one in effect at the end of the frame:
+ * lines drawn before a mid-frame palette change come out in the new
+ * colours, which a per-frame palette cannot avoid.
+ */
+
+#include "shared.h"
+#include "clip.h"
+#include "memmap.h"
+
+uint8 wasm_clip_pixels[WASM_CLIP_PITCH * WASM_CLIP_LINES];
+int wasm_clip_output;
+
+static clip_info_t info;
+
+void clip_enable(int enabled)
+{
+    /* lines kept by the line cache are not drawn again: draw them all once */
+    render_line_cache_dirty();
+    wasm_clip_output = enabled;
+}
+
+clip_info_t* clip_info(void)
+{
+    return &info;
+}
+
+uint8_t* clip_pixels(void)
+{
+    return wasm_clip_pixels;
+}
+
+int clip_pitch(void)
+{
+    return WASM_CLIP_PITCH;
+}
+
+int clip_lines(void)
+{
+    return WASM_CLIP_LINES;
+}
+
+void clip_frame(void)
+{
+    if (!wasm_clip_output)
+        return;
+
+    info.x = bitmap.viewport.x;
+    info.y = bitmap.viewport.y;
+    info.w = bitmap.viewport.w;
+    info.h = bitmap.viewport.h;
+    if (info.x + info.w > WASM_CLIP_PITCH)
+        info.w = WASM_CLIP_PITCH - info.x;
+    if (info.y + info.h > WASM_CLIP_LINES)
+        info.h = WASM_CLIP_LINES - info.y;
+    memcpy(info.palette, render_palette_ref(), sizeof(info.palette));
+    info.frame++;
+}
+
+void clip_memory_report(void)
+{
+    memory_region("clip frame", wasm_clip_pixels, sizeof(wasm_clip_pixels));
+}
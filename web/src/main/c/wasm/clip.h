@@ -0,0 +1,43 @@
+#ifndef _CLIP_H_
+#define _CLIP_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Instant replay: the last drawn frame as 8-bit pixel indices plus its
+ * palette, for the front-end's ring of the last seconds (clip.js).
+ *
+ * While enabled, remap_line() also copies every drawn line to
+ * wasm_clip_pixels[] (CLIP_LINE() in vdp_render.h) whatever the output
+ * mode, and clip_frame() takes the palette and active area at the end of
+ * the run and bumps 'frame'. The front-end copies the frame out after every
+ * run: 75KB instead of 300KB of RGBA, kept in JS memory because the fixed
+ * heap of the Mega Drive only core (memmap.h) could not hold seconds of
+ * them. Skipped frames are not drawn, so the ring gets the frames shown.
+ */
+
+#define CLIP_PALETTE_SIZE 256
+
+typedef struct
+{
+    uint32_t frame;                      /* drawn frames recorded */
+    int32_t x, y, w, h;                  /* active area in wasm_clip_pixels[] */
+    uint32_t palette[CLIP_PALETTE_SIZE]; /* 0xAARRGGBB, at the end of the frame */
+} clip_info_t;
+
+/* Start or stop copying the drawn frames */
+void EMSCRIPTEN_KEEPALIVE clip_enable(int enabled);
+
+/* Last frame: info and pixels (WASM_CLIP_PITCH bytes per line) */
+clip_info_t* EMSCRIPTEN_KEEPALIVE clip_info(void);
+uint8_t* EMSCRIPTEN_KEEPALIVE clip_pixels(void);
+int EMSCRIPTEN_KEEPALIVE clip_pitch(void);
+int EMSCRIPTEN_KEEPALIVE clip_lines(void);
+
+/* End of a run whose last frame was drawn */
+void clip_frame(void);
+
+/* Add the frame to the memory report */
+void clip_memory_report(void);
+
+#endif /* _CLIP_H_ */
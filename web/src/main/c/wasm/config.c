@@ -26,12 +26,13 @@ void set_config_defaults(void)
   config.mono           = 0;
 
   /* system options */
-  config.system         = SYSTEM_MD; /* = AUTO (or SYSTEM_SG, SYSTEM_MARKIII, SYSTEM_SMS, SYSTEM_SMS2, SYSTEM_GG, SYSTEM_MD) */
+  config.system         = 0;         /* = AUTO (or SYSTEM_SG, SYSTEM_MARKIII, SYSTEM_SMS, SYSTEM_SMS2, SYSTEM_GG, SYSTEM_MD) */
   config.region_detect  = 3;         /* = AUTO (1 = USA, 2 = EUROPE, 3 = JAPAN/NTSC, 4 = JAPAN/PAL) */
   config.vdp_mode       = 1;         /* = AUTO (1 = NTSC, 2 = PAL) */
   config.master_clock   = 1;         /* = AUTO (1 = NTSC, 2 = PAL) */
   config.force_dtack    = 0;
   config.addr_error     = 1;
+  config.idle_skip      = 1; /* = RAM loops only (0 = OFF, 2 = also VDP status polling, see m68k.h) */
   config.bios           = 0;
   config.lock_on        = 0; /* = OFF (can be TYPE_SK, TYPE_GG & TYPE_AR) */
   config.ntsc           = 0;
@@ -40,7 +41,7 @@ void set_config_defaults(void)
   /* display options */
   config.overscan = 0;       /* 3 = all borders (0 = no borders , 1 = vertical borders only, 2 = horizontal borders only) */
   config.gg_extra = 0;       /* 1 = show extended Game Gear screen (256x192) */
-  config.render   = 0;       /* 1 = double resolution output (only when interlaced mode 2 is enabled) */
+  config.render   = 1;       /* 1 = double resolution output (only when interlaced mode 2 is enabled) */
 
   /* controllers options */
   input.system[0]       = SYSTEM_GAMEPAD;
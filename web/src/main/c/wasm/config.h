@@ -36,6 +36,7 @@ typedef struct
   uint8 master_clock;
   uint8 force_dtack;
   uint8 addr_error;
+  uint8 idle_skip;
   uint8 bios;
   uint8 lock_on;
   uint8 hot_swap;
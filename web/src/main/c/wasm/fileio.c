@@ -1,25 +1,21 @@
 #include <emscripten/emscripten.h>
 #include "shared.h"
 
-uint8_t *rom_buffer;
-uint32_t rom_size;
-
+// there is no file system: cartridge ROMs are streamed into cart.rom before start()
+// (rom_stream_begin/rom_stream_write in wasm.c); the CD BIOS comes with the disc files
+// (cdstream.h), other BIOS and lock-on ROM files are not found
 int load_archive(char *filename, unsigned char *buffer, int maxsize, char *extension)
 {
+    if(extension) {
+        strncpy(extension, "BIN", 3);
+        extension[3] = 0;
+    }
+#ifndef MD_ONLY
+    return cd_stream_load(filename, buffer, maxsize);
+#else
     (void) filename;
-    memcpy(buffer, rom_buffer, rom_size);
-    strncpy(extension, "BIN", 3);
-    extension[3] = 0;
-
-    // // 53 45 47 41
-    // for(int i = 0; i < 4; i++) {
-    //     EM_ASM_({
-    //         console.log('rom_buffer: ' + $0.toString(16));
-    //     }, buffer[0x100 + i]);
-    // }
-    // EM_ASM_({
-    //     console.log('rom_size: ' + $0);
-    // }, rom_size);
-
-    return rom_size;
+    (void) buffer;
+    (void) maxsize;
+    return 0;
+#endif
 }
@@ -44,7 +44,5 @@
 
 /* Function prototypes */
 extern int load_archive(char *filename, unsigned char *buffer, int maxsize, char *extension);
-extern uint8_t *rom_buffer;
-extern uint32_t rom_size;
 
 #endif /* _FILEIO_H_ */
@@ -0,0 +1,172 @@
+/**
+ * ChaosDrive - quality governor
+ *
+ * See governor.h. The load is the cost of emulating, not the time between
+ * runs: a device spending 80% of every frame in the core is stepped down
+ * before it starts dropping frames, not after.
+ */
+
+#include "shared.h"
+#include "governor.h"
+#include "capture.h"
+
+static int enabled;
+static int level;
+static int minimum;
+static int changed = -1;
+static int audio_fixed;
+
+/* configuration start() set, the full quality level */
+static uint8 base_ym3438;
+static uint8 base_hq_fm;
+static uint8 base_hq_psg;
+static uint8 base_filter;
+
+static double load;
+static int over;
+static int under;
+static int hold;
+static int up_runs = GOVERNOR_UP_RUNS;
+static int since_up = -1;   /* runs since the last step up, -1 once past GOVERNOR_BOUNCE_RUNS */
+static int skip_phase;
+
+/* 1 when 'rung' changes something in the running game */
+static int active(int rung)
+{
+    switch (rung)
+    {
+        case GOVERNOR_FM_MAME:
+            return !audio_fixed && base_ym3438 && ((system_hw & SYSTEM_PBC) == SYSTEM_MD);
+        case GOVERNOR_FM_LINEAR:
+            return !audio_fixed && base_hq_fm;
+        case GOVERNOR_PSG_LINEAR:
+            return !audio_fixed && base_hq_psg;
+        case GOVERNOR_NO_FILTER:
+            return !audio_fixed && base_filter;
+        case GOVERNOR_FRAME_SKIP:
+            return 1;
+    }
+    return 0;
+}
+
+static int lowered(int rung)
+{
+    return (level >= rung) && active(rung);
+}
+
+static void apply(void)
+{
+    config.hq_fm = lowered(GOVERNOR_FM_LINEAR) ? 0 : base_hq_fm;
+    config.hq_psg = lowered(GOVERNOR_PSG_LINEAR) ? 0 : base_hq_psg;
+    config.filter = lowered(GOVERNOR_NO_FILTER) ? 0 : base_filter;
+    sound_fm_switch(lowered(GOVERNOR_FM_MAME) ? 0 : base_ym3438, capture_fm_regs());
+}
+
+static void step(int to)
+{
+    level = to;
+    changed = to;
+    over = under = 0;
+    hold = GOVERNOR_HOLD_RUNS;
+    apply();
+}
+
+void governor_enable(int enable)
+{
+    enabled = enable;
+    if (!enabled && (level != minimum))
+        step(minimum);
+}
+
+void governor_set_minimum(int to)
+{
+    if ((to < GOVERNOR_FULL) || (to >= GOVERNOR_LEVELS))
+        return;
+    minimum = to;
+    if ((level < minimum) || (!enabled && (level != minimum)))
+        step(minimum);
+}
+
+int governor_level(void)
+{
+    return level;
+}
+
+int governor_take_change(void)
+{
+    int to = changed;
+    changed = -1;
+    return to;
+}
+
+void governor_start(int fixed)
+{
+    audio_fixed = fixed;
+    base_ym3438 = config.ym3438;
+    base_hq_fm = config.hq_fm;
+    base_hq_psg = config.hq_psg;
+    base_filter = config.filter;
+    if (level != minimum)
+        changed = minimum;
+    level = minimum;
+    if (minimum != GOVERNOR_FULL)
+        apply();
+    load = 0;
+    over = under = 0;
+    hold = GOVERNOR_HOLD_RUNS;
+    up_runs = GOVERNOR_UP_RUNS;
+    since_up = -1;
+}
+
+void governor_reset(void)
+{
+    if (level != GOVERNOR_FULL)
+        step(GOVERNOR_FULL);
+    governor_start(0);
+}
+
+void governor_run(double run_load)
+{
+    int to;
+
+    if (!enabled || (run_load <= 0))
+        return;
+
+    load += (run_load - load) * GOVERNOR_SMOOTHING;
+    if ((since_up >= 0) && (++since_up > GOVERNOR_BOUNCE_RUNS))
+        since_up = -1;
+    if (hold)
+    {
+        hold--;
+        return;
+    }
+
+    over = (load > GOVERNOR_DOWN_LOAD) ? over + 1 : 0;
+    under = (load < GOVERNOR_UP_LOAD) ? under + 1 : 0;
+
+    if (over >= GOVERNOR_DOWN_RUNS)
+    {
+        for (to = level + 1; (to < GOVERNOR_LEVELS) && !active(to); to++);
+        if (to == GOVERNOR_LEVELS)
+            return;
+        /* the level just stepped up to was too much: wait longer next time */
+        if ((since_up >= 0) && (up_runs < GOVERNOR_UP_RUNS_MAX))
+            up_runs *= 2;
+        since_up = -1;
+        step(to);
+    }
+    else if ((under >= up_runs) && (level > minimum))
+    {
+        for (to = level - 1; (to > minimum) && !active(to); to--);
+        since_up = 0;
+        step(to);
+    }
+}
+
+int governor_skip(void)
+{
+    if (!lowered(GOVERNOR_FRAME_SKIP))
+        return 0;
+    skip_phase ^= 1;
+    return skip_phase;
+}
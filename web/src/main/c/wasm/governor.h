@@ -0,0 +1,75 @@
+#ifndef _GOVERNOR_H_
+#define _GOVERNOR_H_
+
+#include <emscripten/emscripten.h>
+
+/* Quality governor: trades accuracy for speed when the device cannot keep up.
+ *
+ * Every run (tick() or tick_n() and its sound() call) reports its wall time
+ * over the real time of its frames. A smoothed load over GOVERNOR_DOWN_LOAD
+ * for GOVERNOR_DOWN_RUNS runs in a row steps one level down the ladder
+ * below, under GOVERNOR_UP_LOAD for 'up' runs in a row one level back up.
+ * After a step the load of the new level settles for GOVERNOR_HOLD_RUNS
+ * runs before it counts. A level stepped up to that has to be left again
+ * within GOVERNOR_BOUNCE_RUNS doubles the runs the next step up waits for,
+ * so a device on the edge of a level settles below it instead of switching
+ * back and forth.
+ *
+ * Levels that would change nothing are passed over: YM3438 when the game
+ * runs the MAME core already, and all the audio ones in recorded, replayed
+ * and online sessions, whose audio output has to be the same everywhere.
+ * Off by default (the benchmark harness runs at full quality); start()
+ * goes back to full quality.
+ *
+ * A minimum level (battery saver) holds the ladder at or below it, with the
+ * governor on or off: load only steps further down, start() and reset go
+ * back to the minimum instead of full quality.
+ */
+
+enum
+{
+    GOVERNOR_FULL,
+    GOVERNOR_FM_MAME,       /* YM3438 (Nuked OPN2) to the MAME YM2612 */
+    GOVERNOR_FM_LINEAR,     /* hq_fm off: linear interpolation */
+    GOVERNOR_PSG_LINEAR,    /* hq_psg off */
+    GOVERNOR_NO_FILTER,     /* low-pass filter / EQ off */
+    GOVERNOR_FRAME_SKIP,    /* every other frame run without rendering */
+    GOVERNOR_LEVELS
+};
+
+#define GOVERNOR_SMOOTHING    0.125 /* weight of a run in the smoothed load */
+#define GOVERNOR_DOWN_LOAD    0.9
+#define GOVERNOR_UP_LOAD      0.5
+#define GOVERNOR_DOWN_RUNS    30
+#define GOVERNOR_UP_RUNS      300
+#define GOVERNOR_UP_RUNS_MAX  4800
+#define GOVERNOR_HOLD_RUNS    60
+#define GOVERNOR_BOUNCE_RUNS  600
+
+/* Turn the governor on or off (off: back to full quality) */
+void EMSCRIPTEN_KEEPALIVE governor_enable(int enabled);
+
+/* Never above 'level' (GOVERNOR_FULL: no minimum), stepped to at once */
+void EMSCRIPTEN_KEEPALIVE governor_set_minimum(int level);
+
+/* Current level (GOVERNOR_*) */
+int EMSCRIPTEN_KEEPALIVE governor_level(void);
+
+/* Level stepped to since the last call, -1 if none (UI report) */
+int EMSCRIPTEN_KEEPALIVE governor_take_change(void);
+
+/* start(): full quality (or the minimum) with the configuration just set,
+ * 'audio_fixed' in sessions */
+void governor_start(int audio_fixed);
+
+/* soft_reset(): back to full quality (or the minimum) with the
+ * configuration of the last start(), outside of a session */
+void governor_reset(void);
+
+/* End of a run, 'load' from telemetry_run_end() */
+void governor_run(double load);
+
+/* Frame about to run: 1 to skip its rendering */
+int governor_skip(void);
+
+#endif /* _GOVERNOR_H_ */
@@ -0,0 +1,420 @@
+/**
+ * ChaosDrive - GPU compositing line log
+ *
+ * See gpu_log.h. gpu_log_compose() is the reference for the shader in
+ * js/gpurender.js: both resolve each pixel from the line record on its
+ * own, where the software renderer draws whole columns over each other.
+ */
+
+#include "shared.h"
+#include "gpu_log.h"
+
+/* rows are only logged while a frame runs */
+enum
+{
+    FRAME_IDLE,
+    FRAME_RUN,
+    FRAME_STOPPED   /* logged rows composited on the CPU: rest of the frame in software */
+};
+
+/* line with its borders, as the line buffer */
+#define ROW_MAX 0x200
+
+int gpu_log_on;
+int gpu_log_pending;
+
+static uint16_t lines[GPU_LOG_LINES][GPU_LINE_WORDS];
+static uint32_t palettes[GPU_LOG_PALETTES][256];
+static uint8_t vram_copy[0x10000];
+static int palette_count;
+static int last_users;  /* rows showing the last snapshot */
+static int state;
+static int drawn;
+static int layers_changed = 1;
+static uint32_t stat_logged;
+static uint32_t stat_lines;
+
+void set_gpu_render(int enabled)
+{
+    int row;
+
+    if (!enabled && gpu_log_on)
+    {
+        GPU_LOG_INVALIDATE();
+        for (row = 0; row < GPU_LOG_LINES; row++)
+            lines[row][GPU_LINE_FLAGS] = 0;
+    }
+
+    /* the line cache was not kept up to date */
+    render_line_cache_dirty();
+    gpu_log_on = enabled;
+    layers_changed = 1;
+}
+
+uint16_t *gpu_log_lines_ref(void)
+{
+    return &lines[0][0];
+}
+
+uint32_t *gpu_log_palettes_ref(void)
+{
+    return &palettes[0][0];
+}
+
+uint8_t *gpu_log_vram_ref(void)
+{
+    return vram_copy;
+}
+
+uint8_t *gpu_log_patterns_ref(void)
+{
+    return render_pattern_cache_ref();
+}
+
+uint8_t *gpu_log_layers_ref(void)
+{
+    return render_layer_lut_ref();
+}
+
+int gpu_log_take(void)
+{
+    int row, count = 0;
+
+    if (!drawn)
+        return -1;
+    drawn = 0;
+
+    for (row = 0; row < GPU_LOG_LINES; row++)
+        count += lines[row][GPU_LINE_FLAGS] & GPU_LINE_LOGGED;
+    return count;
+}
+
+int gpu_log_palette_count(void)
+{
+    return palette_count;
+}
+
+int gpu_log_layers_changed(void)
+{
+    int changed = layers_changed;
+    layers_changed = 0;
+    return changed;
+}
+
+void gpu_log_stats(uint32_t *logged, uint32_t *total)
+{
+    *logged = stat_logged;
+    *total = stat_lines;
+    stat_logged = stat_lines = 0;
+}
+
+/* ======================================================================== */
+/* Compositing                                                              */
+/* ======================================================================== */
+
+/* Pattern pixel of name table word 'word' | priority and palette bits */
+static int tile_pixel(const uint8_t *cache, unsigned int word, int x, int y)
+{
+    if (word & 0x800)
+        x ^= 7;
+    if (word & 0x1000)
+        y ^= 7;
+    return cache[((word & 0x7FF) << 6) | (y << 3) | x] | ((word >> 9) & 0x70);
+}
+
+static unsigned int vram_word(int addr)
+{
+    return *(uint16_t *)&vram_copy[addr & 0xFFFE];
+}
+
+/* Plane pixel at plane position 'px', 'v' */
+static int plane_pixel(const uint16_t *rec, const uint8_t *cache, int table, int px, int v)
+{
+    px &= (rec[GPU_LINE_COLS] << 4) | 15;
+    v &= rec[GPU_LINE_ROWS];
+    return tile_pixel(cache, vram_word(table + (((v >> 3) << rec[GPU_LINE_SHIFT]) & 0x1FC0) + ((px >> 3) << 1)), px & 7, v & 7);
+}
+
+/* Planes and window at screen pixel 'x' (before sprites) */
+static int bg_pixel(const uint16_t *rec, const uint8_t *cache, const uint8_t *table, int x)
+{
+    int y = rec[GPU_LINE_Y];
+    int hs, k, px, a, b;
+
+    /* Window over plane A */
+    if (((x >> 4) >= rec[GPU_LINE_W_LEFT]) && ((x >> 4) < rec[GPU_LINE_W_RIGHT]))
+    {
+        a = tile_pixel(cache, vram_word(rec[GPU_LINE_WINDOW] + ((x >> 3) << 1)), x & 7, y & 7);
+    }
+    else if (rec[GPU_LINE_A_RIGHT] > rec[GPU_LINE_A_LEFT])
+    {
+        /* 2-cell column, 0 for the partly shown one */
+        hs = rec[GPU_LINE_HSCROLL_A];
+        k = (x - (hs & 15) + 16) >> 4;
+        px = x - hs;
+        if (k <= rec[GPU_LINE_A_LEFT])
+        {
+            /* window bug: the partly shown column right of the window shows the next one */
+            if (rec[GPU_LINE_A_LEFT])
+                px += 16;
+            k = 0;
+        }
+        a = plane_pixel(rec, cache, rec[GPU_LINE_NTAB], px, y + rec[GPU_LINE_VSCROLL + (k << 1)]);
+    }
+    else
+    {
+        a = 0;
+    }
+
+    hs = rec[GPU_LINE_HSCROLL_B];
+    k = (x - (hs & 15) + 16) >> 4;
+    b = plane_pixel(rec, cache, rec[GPU_LINE_NTBB], x - hs, y + rec[GPU_LINE_VSCROLL + (k << 1) + 1]);
+
+    return table[(b << 8) | a];
+}
+
+void gpu_log_compose(int row, uint8_t *dst)
+{
+    const uint16_t *rec = lines[row];
+    const uint8_t *cache = render_pattern_cache_ref();
+    const uint8_t *lut = render_layer_lut_ref();
+    int ste = rec[GPU_LINE_FLAGS] & GPU_LINE_OBJ_STE;
+    int width = rec[GPU_LINE_WIDTH];
+    int border = rec[GPU_LINE_BORDER];
+    uint8_t obj[ROW_MAX];
+    const uint16_t *spr;
+    int x, i, p;
+
+    memset(dst, 0x40, border);
+    dst += border;
+
+    for (x = 0; x < width; x++)
+        dst[x] = bg_pixel(rec, cache, lut + ((rec[GPU_LINE_FLAGS] & GPU_LINE_STE) ? 2 : 0) * 0x10000, x);
+
+    /* Sprites in list order, each pixel over the ones before (S/TE: on their own line, then merged) */
+    if (ste)
+        memset(obj, 0, width);
+    spr = &rec[GPU_LINE_SPRITE];
+    for (i = 0; i < rec[GPU_LINE_SPRITES]; i++, spr += 4)
+    {
+        int xpos = (int16_t)spr[0];
+        int attr = spr[1];
+        int size = spr[2] & 0x0F;
+        int yoff = spr[2] >> 8;
+        int h = size & 3;
+        int atex = (attr >> 9) & 0x70;
+        uint8_t *lb = ste ? obj : dst;
+        const uint8_t *table = lut + (ste ? 3 : 1) * 0x10000;
+
+        for (p = 0; p < spr[3]; p++)
+        {
+            int col = p >> 3;
+            int cell = yoff >> 3;
+            int name, pixel;
+
+            x = xpos + p;
+            if ((x < 0) || (x >= width))
+                continue;
+
+            if (attr & 0x800)
+                col = ((size >> 2) & 3) - col;
+            if (attr & 0x1000)
+                cell = h - cell;
+            name = ((attr & 0x7FF) + cell + col * (h + 1)) & 0x7FF;
+            pixel = tile_pixel(cache, (attr & 0x1800) | name, p & 7, yoff & 7) & 0x0F;
+            if (pixel)
+                lb[x] = table[(lb[x] << 8) | pixel | atex];
+        }
+    }
+    if (ste)
+    {
+        for (x = 0; x < width; x++)
+            dst[x] = lut[4 * 0x10000 + ((dst[x] << 8) | obj[x])];
+    }
+
+    if ((rec[GPU_LINE_FLAGS] & GPU_LINE_BLANK_LEFT) && (width >= 8))
+        memset(dst, 0x40, 8);
+
+    memset(dst + width, 0x40, border);
+}
+
+/* Composite row 'row' into the output, as remap_line() would have drawn it
+   with pixel table 'palette' */
+static void output_row(int row, const uint32_t *palette)
+{
+    const uint16_t *rec = lines[row];
+    int width = rec[GPU_LINE_WIDTH] + 2 * rec[GPU_LINE_BORDER];
+    uint8_t src[ROW_MAX];
+
+    gpu_log_compose(row, src);
+
+    if (wasm_clip_output && (row < WASM_CLIP_LINES))
+        memcpy(&wasm_clip_pixels[row * WASM_CLIP_PITCH], src, (width < WASM_CLIP_PITCH) ? width : WASM_CLIP_PITCH);
+
+    if (wasm_indexed_output)
+    {
+        uint8_t *idx = &wasm_index_buffer[row * WASM_INDEX_PITCH];
+        if (memcmp(idx, src, width))
+        {
+            memcpy(idx, src, width);
+            wasm_dirty_lines[row] = 1;
+        }
+    }
+    else
+    {
+        /* logged rows are never field rows */
+        int rows = wasm_output_scale;
+        int pitch_px = bitmap.pitch / (int)sizeof(uint32_t);
+        uint32_t *dst = (uint32_t *)&bitmap.data[row * rows * bitmap.pitch];
+
+        /* the blitter caches the palette it was last given */
+        blit_palette_dirty = 1;
+        if (blit_line(dst, pitch_px, rows, wasm_output_scale, src, width, palette))
+            wasm_dirty_lines[row] = 1;
+        blit_palette_dirty = 1;
+    }
+
+    lines[row][GPU_LINE_FLAGS] = 0;
+}
+
+/* ======================================================================== */
+/* Frames                                                                   */
+/* ======================================================================== */
+
+void gpu_log_flush(void)
+{
+    int row;
+
+    for (row = 0; row < GPU_LOG_LINES; row++)
+    {
+        if (lines[row][GPU_LINE_FLAGS] & GPU_LINE_LOGGED)
+            output_row(row, palettes[lines[row][GPU_LINE_PALETTE]]);
+    }
+    gpu_log_pending = 0;
+    if (state == FRAME_RUN)
+        state = FRAME_STOPPED;
+}
+
+void gpu_log_layers(void)
+{
+    GPU_LOG_INVALIDATE();
+    layers_changed = 1;
+}
+
+void gpu_log_frame(int skip)
+{
+    int row;
+
+    if (!gpu_log_on)
+        return;
+
+    if (skip)
+    {
+        /* the rows logged in the frame before would be shown with this frame's patterns */
+        GPU_LOG_INVALIDATE();
+        state = FRAME_IDLE;
+        return;
+    }
+
+    /* every row of the frame is logged or drawn again */
+    for (row = 0; row < GPU_LOG_LINES; row++)
+        lines[row][GPU_LINE_FLAGS] = 0;
+    palette_count = last_users = 0;
+    gpu_log_pending = 0;
+    state = FRAME_RUN;
+    drawn = 1;
+}
+
+void gpu_log_frame_end(void)
+{
+    if (!wasm_indexed_output)
+        GPU_LOG_INVALIDATE();
+    gpu_log_pending = 0;
+    state = FRAME_IDLE;
+}
+
+/* Current pixel table for row 'row' ('kept': the row has one already), 0
+   when out of snapshots */
+static int snapshot(int row, int kept)
+{
+    const uint32_t *palette = render_palette_ref();
+    uint16_t *rec = lines[row];
+    int last = palette_count - 1;
+    int on_last = kept && (rec[GPU_LINE_PALETTE] == last);
+
+    if (palette_count && !memcmp(palettes[last], palette, sizeof(palettes[0])))
+    {
+        if (!on_last)
+            last_users++;
+    }
+    else if (on_last && (last_users == 1))
+    {
+        /* colors changed again for the row that took the snapshot */
+        memcpy(palettes[last], palette, sizeof(palettes[0]));
+    }
+    else
+    {
+        if (palette_count == GPU_LOG_PALETTES)
+            return 0;
+        memcpy(palettes[palette_count++], palette, sizeof(palettes[0]));
+        last_users = 1;
+    }
+    rec[GPU_LINE_PALETTE] = palette_count - 1;
+    return 1;
+}
+
+int gpu_log_line(int line)
+{
+    uint16_t *rec;
+    int row;
+
+    if ((state != FRAME_RUN) || WASM_FIELD_ROWS)
+        return 0;
+
+    /* output row, as remap_line() */
+    row = (line + bitmap.viewport.y) % lines_per_frame;
+    if ((row < 0) || (row >= GPU_LOG_LINES))
+        return 0;
+
+    stat_lines++;
+    rec = lines[row];
+    if (!render_log_line(line, rec) || !snapshot(row, 0))
+    {
+        rec[GPU_LINE_FLAGS] = 0;
+        return 0;
+    }
+
+    if (!gpu_log_pending)
+    {
+        memcpy(vram_copy, vram, sizeof(vram_copy));
+        gpu_log_pending = 1;
+    }
+
+    stat_logged++;
+    return 1;
+}
+
+void gpu_log_blank(int line, uint8_t *dst)
+{
+    int row = (line + bitmap.viewport.y) % lines_per_frame;
+
+    if ((row >= 0) && (row < GPU_LOG_LINES) && (lines[row][GPU_LINE_FLAGS] & GPU_LINE_LOGGED))
+    {
+        gpu_log_compose(row, dst);
+        lines[row][GPU_LINE_FLAGS] = 0;
+    }
+}
+
+int gpu_log_remap(int row, uint8_t *dst)
+{
+    if ((row >= GPU_LOG_LINES) || !(lines[row][GPU_LINE_FLAGS] & GPU_LINE_LOGGED))
+        return 0;
+
+    /* CRAM written in the line's HBLANK: same pixels, the new colors */
+    if (snapshot(row, 1))
+        return 1;
+
+    gpu_log_compose(row, dst);
+    lines[row][GPU_LINE_FLAGS] = 0;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#ifndef _GPU_LOG_H_
+#define _GPU_LOG_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* GPU compositing (set_gpu_render()): Mode 5 lines are logged instead of
+ * drawn, and the front-end composites them in a shader (js/gpurender.js).
+ *
+ * For each line render_line() would draw, the renderer records what it
+ * reads besides VRAM and the pattern cache: registers resolved into name
+ * table addresses and plane sizes, the line's horizontal scroll values and
+ * vertical scroll of each 2-cell column (with the chaos scroll offsets), the
+ * window and plane A column ranges, and the sprites found on the line with
+ * the width each one is drawn at (sprite masking and the pixel limit
+ * applied). The sprite layer still runs over an empty line, so collision
+ * and overflow stay exact. The line's output row points to a snapshot of
+ * the pixel table, taken again whenever CRAM changed since the last row.
+ *
+ * Lines the log does not cover (interlace mode 2, double resolution output,
+ * the LCD ghosting and NTSC filters, display off, the borders above and
+ * below) are drawn as before into wasm_index_buffer, their rows flagged
+ * unlogged. VRAM is copied at the first logged line of a frame. A VRAM
+ * write, a pattern cache glitch or a layer table change while lines are
+ * logged composites them on the CPU first (gpu_log_compose(), the same
+ * algorithm as the shader) and the rest of the frame is drawn in software.
+ *
+ * Without indexed output the logged rows are composited on the CPU at the
+ * end of the run, which is how genplus_bench -r compares the compositor
+ * with the software renderer.
+ */
+
+#define GPU_LOG_LINES     256   /* output rows, as wasm_index_buffer */
+#define GPU_LOG_SPRITES   20    /* sprites per line (H40) */
+#define GPU_LOG_PALETTES  256   /* pixel table snapshots per frame, one per row at most */
+
+/* Line record: 16-bit words */
+enum
+{
+    GPU_LINE_FLAGS,         /* GPU_LINE_* below */
+    GPU_LINE_PALETTE,       /* pixel table snapshot */
+    GPU_LINE_WIDTH,         /* active pixels */
+    GPU_LINE_BORDER,        /* border pixels on each side */
+    GPU_LINE_Y,             /* active display line */
+    GPU_LINE_NTAB,          /* plane A name table */
+    GPU_LINE_NTBB,          /* plane B name table */
+    GPU_LINE_WINDOW,        /* window name table row of the line */
+    GPU_LINE_COLS,          /* plane column pair mask (playfield_col_mask) */
+    GPU_LINE_ROWS,          /* plane line mask (playfield_row_mask) */
+    GPU_LINE_SHIFT,         /* name table row shift (playfield_shift) */
+    GPU_LINE_HSCROLL_A,
+    GPU_LINE_HSCROLL_B,
+    GPU_LINE_A_LEFT,        /* plane A columns (16 pixels), window bug at the left one */
+    GPU_LINE_A_RIGHT,
+    GPU_LINE_W_LEFT,        /* window columns, drawn over plane A */
+    GPU_LINE_W_RIGHT,
+    GPU_LINE_SPRITES,       /* sprite count */
+    GPU_LINE_VSCROLL,       /* plane A, B vertical scroll of the partly shown column, then of columns 0-19 */
+    GPU_LINE_SPRITE = GPU_LINE_VSCROLL + 42,    /* x - 128, attributes, size | line in sprite << 8, drawn width */
+    GPU_LINE_WORDS = GPU_LINE_SPRITE + 4 * GPU_LOG_SPRITES
+};
+
+#define GPU_LINE_LOGGED      0x01   /* composited from the record, not wasm_index_buffer */
+#define GPU_LINE_STE         0x02   /* shadow / highlight planes */
+#define GPU_LINE_BLANK_LEFT  0x04   /* left-most column blanked (reg 0 bit 5) */
+#define GPU_LINE_OBJ_STE     0x08   /* shadow / highlight sprite layer (can differ from the planes) */
+
+/* Log on or off (off: every line drawn in software again) */
+extern int gpu_log_on;
+void EMSCRIPTEN_KEEPALIVE set_gpu_render(int enabled);
+
+/* Line records (GPU_LOG_LINES x GPU_LINE_WORDS), pixel table snapshots
+ * (GPU_LOG_PALETTES x 256 0xAARRGGBB words), the VRAM the lines were logged
+ * with (64KB, host order words), the pattern cache (2048 patterns of 8x8
+ * pixels, one byte each) and the five Mode 5 layer tables (64KB each) */
+uint16_t* EMSCRIPTEN_KEEPALIVE gpu_log_lines_ref(void);
+uint32_t* EMSCRIPTEN_KEEPALIVE gpu_log_palettes_ref(void);
+uint8_t* EMSCRIPTEN_KEEPALIVE gpu_log_vram_ref(void);
+uint8_t* EMSCRIPTEN_KEEPALIVE gpu_log_patterns_ref(void);
+uint8_t* EMSCRIPTEN_KEEPALIVE gpu_log_layers_ref(void);
+
+/* Logged rows of the last frame drawn, -1 when no frame was drawn since the
+ * last call (the data above still holds the one before) */
+int EMSCRIPTEN_KEEPALIVE gpu_log_take(void);
+
+/* Pixel table snapshots used by the rows */
+int EMSCRIPTEN_KEEPALIVE gpu_log_palette_count(void);
+
+/* 1 when the layer tables changed since the last call */
+int EMSCRIPTEN_KEEPALIVE gpu_log_layers_changed(void);
+
+/* Logged and drawn lines since the last call (bench report) */
+void gpu_log_stats(uint32_t *logged, uint32_t *lines);
+
+/* Pixel indices of logged row 'row' into 'dst' (borders included) */
+void gpu_log_compose(int row, uint8_t *dst);
+
+/* Frame about to run ('skip': without rendering), run end (frame_run(),
+ * frame_end()) */
+void gpu_log_frame(int skip);
+void gpu_log_frame_end(void);
+
+/* render_line(): 1 when the line was logged (nothing to draw) */
+int gpu_log_line(int line);
+
+/* blank_line(): line partially blanked, its pixels composited into 'dst'
+ * (line buffer, borders included) if it was logged */
+void gpu_log_blank(int line, uint8_t *dst);
+
+/* remap_line(): 1 when output row 'row' is logged, its colors taken again
+ * from the pixel table, 0 when it is drawn in software from 'dst' (the
+ * line buffer, where a logged row is composited when out of snapshots) */
+int gpu_log_remap(int row, uint8_t *dst);
+
+/* VRAM or the pattern cache is about to change / has changed: composite
+ * the lines logged so far on the CPU */
+extern int gpu_log_pending;
+void gpu_log_flush(void);
+#define GPU_LOG_INVALIDATE() { if (gpu_log_pending) gpu_log_flush(); }
+
+/* render_layers(): same, the front-end uploads the tables again */
+void gpu_log_layers(void);
+
+#endif /* _GPU_LOG_H_ */
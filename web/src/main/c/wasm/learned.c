@@ -0,0 +1,130 @@
+/**
+ * ChaosDrive - per-ROM learned profile
+ *
+ * Saving walks the ranked RAM candidates and the trace cache slots, a few
+ * microseconds every so often; loading happens once, before the first frame.
+ */
+
+#include "shared.h"
+#include "learned.h"
+#include "chaos_ram.h"
+#include "chaos_record.h"
+#include "netplay.h"
+
+#define HEADER_SIZE   12
+#define PAGE_BYTES    (0x1000000 >> (M68K_CACHE_PAGE_SHIFT + 3))
+
+static uint8 buffer[LEARNED_SIZE];
+static int applied;
+
+static void put16(uint8 *p, int value)
+{
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static int get16(const uint8 *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+/* ROM page bits worth keeping: the cartridge area */
+static int page_bytes(void)
+{
+    int size = (cart.romsize + (1 << (M68K_CACHE_PAGE_SHIFT + 3)) - 1) >> (M68K_CACHE_PAGE_SHIFT + 3);
+    return (size < PAGE_BYTES) ? size : PAGE_BYTES;
+}
+
+uint8_t *learned_buffer(void)
+{
+    return buffer;
+}
+
+int learned_save(void)
+{
+    uint32_t crc = get_rom_crc();
+    const unsigned char *pages = m68k_cache_pages();
+    unsigned int hot[M68K_JIT_WARM];
+    uint8 *p = buffer;
+    int size, i;
+
+    memcpy(p, "CDLP", 4);
+    p[4] = LEARNED_VERSION;
+    p[5] = p[6] = p[7] = 0;
+    for (i = 0; i < 4; i++)
+        p[8 + i] = (crc >> (i * 8)) & 0xFF;
+    p += HEADER_SIZE;
+
+    size = chaos_ram_export(p + 2);
+    put16(p, size);
+    p += 2 + size;
+
+    size = pages ? page_bytes() : 0;
+    put16(p, size);
+    if (size)
+        memcpy(p + 2, pages, size);
+    p += 2 + size;
+
+    size = m68k_jit_hot(hot, M68K_JIT_WARM);
+    put16(p, size * 4);
+    for (p += 2, i = 0; i < size; i++, p += 4)
+    {
+        p[0] = hot[i] & 0xFF;
+        p[1] = (hot[i] >> 8) & 0xFF;
+        p[2] = (hot[i] >> 16) & 0xFF;
+        p[3] = hot[i] >> 24;
+    }
+
+    return p - buffer;
+}
+
+int learned_load(int size)
+{
+    const uint8 *p = buffer + HEADER_SIZE;
+    const uint8 *end = buffer + size;
+    const uint8 *ram, *pages, *hot;
+    int ram_size, page_size, hot_size, i;
+    unsigned int pcs[M68K_JIT_WARM];
+    uint32_t crc = 0;
+
+    if ((size < HEADER_SIZE) || (size > LEARNED_SIZE) || memcmp(buffer, "CDLP", 4) || (buffer[4] != LEARNED_VERSION))
+        return 0;
+    for (i = 0; i < 4; i++)
+        crc |= (uint32_t)buffer[8 + i] << (i * 8);
+    if ((crc != get_rom_crc()) || (chaos_record_mode() != CHAOS_RECORD_IDLE) || netplay_active())
+        return 0;
+
+    /* sections, checked before any is applied */
+    if (end - p < 2) return 0;
+    ram_size = get16(p);
+    ram = p + 2;
+    p = ram + ram_size;
+    if (end - p < 2) return 0;
+    page_size = get16(p);
+    pages = p + 2;
+    p = pages + page_size;
+    if (end - p < 2) return 0;
+    hot_size = get16(p);
+    hot = p + 2;
+    if ((hot + hot_size != end) || (hot_size & 3) || (hot_size > M68K_JIT_WARM * 4) || (page_size > PAGE_BYTES))
+        return 0;
+
+    if (!chaos_ram_import(ram, ram_size))
+        return 0;
+    m68k_cache_mark_pages(pages, page_size);
+    for (i = 0; i < hot_size / 4; i++)
+        pcs[i] = hot[i * 4] | (hot[i * 4 + 1] << 8) | (hot[i * 4 + 2] << 16) | ((unsigned int)hot[i * 4 + 3] << 24);
+    m68k_jit_warm(pcs, hot_size / 4);
+    applied = 1;
+    return 1;
+}
+
+int learned_applied(void)
+{
+    return applied;
+}
+
+void learned_clear(void)
+{
+    applied = 0;
+}
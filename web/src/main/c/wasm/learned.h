@@ -0,0 +1,46 @@
+#ifndef _LEARNED_H_
+#define _LEARNED_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Per-ROM learned profile (learned.js).
+ *
+ * A few things the core works out about a game as it runs used to be lost
+ * with the page: the work RAM variables the RAM effects aim at
+ * (chaos_ram.h), the ROM pages code runs from, where the ROM effects land
+ * (chaos_rom.h), and in trace compiler builds the traces hot enough to be
+ * compiled. The front end stores them per ROM CRC every so often and hands
+ * them back right after start(), before the first frame, so a game played
+ * before starts with all of it.
+ *
+ * Idle loops need no profile: a loop is caught on its second pass, and the
+ * per-game idle mode is kept by idle.js already.
+ *
+ * Layout: "CDLP", version, ROM CRC, then the RAM statistics, the ROM page
+ * bits and the hot trace PCs, each preceded by its 16-bit size. A profile
+ * is not taken in a recorded, replayed or online session, whose start has
+ * to be the same everywhere; those start from a reset that forgets it.
+ */
+
+#define LEARNED_SIZE     4096
+#define LEARNED_VERSION  1
+
+/* Profile buffer (LEARNED_SIZE bytes) */
+uint8_t* EMSCRIPTEN_KEEPALIVE learned_buffer(void);
+
+/* Profile of the running game into learned_buffer(); returns its size */
+int EMSCRIPTEN_KEEPALIVE learned_save(void);
+
+/* Apply the 'size' bytes of learned_buffer(); 1 when they were taken (same
+ * ROM and version, no session running) */
+int EMSCRIPTEN_KEEPALIVE learned_load(int size);
+
+/* 1 when a profile was taken since the last start() or reset: until then
+ * the front end does not write over the stored one with less */
+int EMSCRIPTEN_KEEPALIVE learned_applied(void);
+
+/* start(), soft_reset(), session resets: what was learned is forgotten */
+void learned_clear(void);
+
+#endif /* _LEARNED_H_ */
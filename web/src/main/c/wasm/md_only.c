@@ -0,0 +1,61 @@
+/**
+ * ChaosDrive - subsystems left out of the Mega Drive only core
+ *
+ * The default build (CHAOS_FULL_CORE=OFF) links neither the Mega CD hardware
+ * (cd_hw/, sub 68k), the SVP, the Master System cartridge mappers nor the
+ * YM2413. The core still calls into them on paths selected by system_hw and
+ * svp, which load_rom() never lets a MD_ONLY build take (see
+ * load_rom_stream_needs_full_core()), so these do nothing.
+ */
+
+#include "shared.h"
+
+m68ki_cpu_core s68k;
+svp_t *svp;
+
+/* ext has no room for the CD hardware (genesis.h), scd is never dereferenced */
+cd_hw_t *const scd_none = NULL;
+
+/* Mega CD */
+void s68k_init(void) {}
+void s68k_pulse_reset(void) {}
+void s68k_run(unsigned int cycles) {}
+void s68k_update_irq(unsigned int mask) {}
+void s68k_pulse_halt(void) {}
+void s68k_clear_halt(void) {}
+void scd_init(void) {}
+void scd_reset(int hard) {}
+void scd_update(unsigned int cycles) {}
+void scd_end_frame(unsigned int cycles) {}
+int scd_context_load(uint8 *state) { return 0; }
+int scd_context_save(uint8 *state) { return 0; }
+unsigned short cdc_host_r(void) { return 0xffff; }
+void cdd_init(int samplerate) {}
+int cdd_load(char *filename, char *header) { return 0; }
+void cdd_unload(void) {}
+void cdd_read_audio(unsigned int samples) {}
+void pcm_init(double clock, int rate) {}
+void pcm_update(unsigned int samples) {}
+
+/* SVP */
+void svp_init(void) {}
+void svp_reset(void) {}
+void ssp1601_run(int cycles) {}
+void ssp1601_invalidate(void) {}
+
+/* Master System cartridges */
+void sms_cart_init(void) {}
+void sms_cart_reset(void) {}
+void sms_cart_switch(uint8 mode) {}
+int sms_cart_region_detect(void) { return REGION_USA; }
+int sms_cart_context_save(uint8 *state) { return 0; }
+int sms_cart_context_load(uint8 *state) { return 0; }
+
+/* YM2413 */
+void YM2413Init(void) {}
+void YM2413ResetChip(void) {}
+void YM2413Update(int *buffer, int length) {}
+void YM2413Write(unsigned int a, unsigned int v) {}
+unsigned int YM2413Read(void) { return 0; }
+unsigned char *YM2413GetContextPtr(void) { return NULL; }
+unsigned int YM2413GetContextSize(void) { return 0; }
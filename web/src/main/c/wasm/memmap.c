@@ -0,0 +1,94 @@
+/**
+ * ChaosDrive - memory layout report
+ *
+ * Regions are listed in no particular order, the front-end sorts them.
+ * The layout figures come from the wasm-ld symbols: static data ends at
+ * __data_end, the stack follows, then the malloc() heap from __heap_base
+ * up to sbrk(0).
+ */
+
+#include "shared.h"
+#include "memmap.h"
+#include "capture.h"
+#include "clip.h"
+#include "chaos_checkpoint.h"
+#include "chaos_preset.h"
+#include "chaos_ram.h"
+#include "chaos_zdrv.h"
+#include "chaos_rom.h"
+#include "chaos_undo.h"
+#include "netplay.h"
+#include "backup.h"
+#include "rewind.h"
+#ifdef __EMSCRIPTEN__
+#include <emscripten/heap.h>
+#include <unistd.h>
+
+extern unsigned char __data_end;
+extern unsigned char __heap_base;
+#endif
+
+static memory_region_t regions[MEMORY_REGIONS_MAX];
+static int count;
+static uint32_t layout[4];
+
+void memory_region(const char *name, const void *data, uint32_t size)
+{
+    if (count < MEMORY_REGIONS_MAX)
+    {
+        regions[count].name = name;
+        regions[count].address = (uint32_t)(uintptr_t)data;
+        regions[count].size = size;
+        count++;
+    }
+}
+
+int memory_report(void)
+{
+    count = 0;
+
+    /* core */
+    memory_region("cartridge (ext)", &ext, sizeof(ext));
+    memory_region("work_ram", work_ram, sizeof(work_ram));
+    memory_region("vram", vram, sizeof(vram));
+    memory_region("vdp_log", vdp_log, sizeof(vdp_log_t) * VDP_LOG_SIZE);
+    render_memory_report();
+    m68k_memory_report();
+    z80_memory_report();
+    sound_memory_report();
+
+    /* front-end buffers */
+    wasm_memory_report();
+    rewind_memory_report();
+    capture_memory_report();
+#ifndef MD_ONLY
+    cd_stream_memory_report();
+#endif
+    clip_memory_report();
+    chaos_checkpoint_memory_report();
+    chaos_preset_memory_report();
+    chaos_ram_memory_report();
+    chaos_zdrv_memory_report();
+    chaos_rom_memory_report();
+    chaos_undo_memory_report();
+    netplay_memory_report();
+    backup_memory_report();
+
+    return count;
+}
+
+const memory_region_t* get_memory_report_ref(void)
+{
+    return regions;
+}
+
+const uint32_t* get_memory_layout_ref(void)
+{
+#ifdef __EMSCRIPTEN__
+    layout[0] = (uint32_t)(uintptr_t)&__data_end;
+    layout[1] = (uint32_t)(uintptr_t)&__heap_base;
+    layout[2] = (uint32_t)(uintptr_t)sbrk(0);
+    layout[3] = (uint32_t)emscripten_get_heap_size();
+#endif
+    return layout;
+}
@@ -0,0 +1,37 @@
+#ifndef _MEMMAP_H_
+#define _MEMMAP_H_
+
+#include <emscripten/emscripten.h>
+#include <stdint.h>
+
+/* Memory layout report (chaosMemory() in index.js).
+ *
+ * The Mega Drive only web core runs in a fixed CHAOS_MEMORY heap that is
+ * never grown (JS heap views are never detached): the large buffers are
+ * static arrays, so the layout is settled at link time and only small or
+ * transient allocations are left to malloc(). memory_report() lists the
+ * large regions; modules keeping theirs private add them from a
+ * *_memory_report() function.
+ */
+
+#define MEMORY_REGIONS_MAX 48
+
+typedef struct
+{
+    const char *name;
+    uint32_t address;
+    uint32_t size;
+} memory_region_t;
+
+/* Add a region to the report being built */
+void memory_region(const char *name, const void *data, uint32_t size);
+
+/* Build the report; returns the number of regions */
+int EMSCRIPTEN_KEEPALIVE memory_report(void);
+const memory_region_t* EMSCRIPTEN_KEEPALIVE get_memory_report_ref(void);
+
+/* Layout of the linear memory: end of the static data, start and top of
+ * the malloc() heap, memory size (all 0 in native builds) */
+const uint32_t* EMSCRIPTEN_KEEPALIVE get_memory_layout_ref(void);
+
+#endif /* _MEMMAP_H_ */
@@ -0,0 +1,108 @@
+/**
+ * ChaosDrive - rollback netplay snapshots and input
+ *
+ * The snapshot ring is indexed by frame number; a slot remembers which
+ * frame it holds, so a rollback past the window is refused instead of
+ * loading a newer frame.
+ */
+
+#include "shared.h"
+#include "chaos.h"
+#include "chaos_ram.h"
+#include "chaos_undo.h"
+#include "chaos_zdrv.h"
+#include "memmap.h"
+#include "netplay.h"
+
+typedef struct
+{
+    int frame;  /* -1: empty */
+    uint8 chaos[CHAOS_CONTEXT_MAX];
+    uint8 state[STATE_SIZE];
+} netplay_snapshot_t;
+
+static netplay_snapshot_t snapshots[NETPLAY_FRAMES];
+static netplay_input_t inputs[NETPLAY_FRAMES];
+static int active;
+static int frame;
+
+void netplay_begin(void)
+{
+    int i;
+
+    for (i = 0; i < NETPLAY_FRAMES; i++)
+        snapshots[i].frame = -1;
+    memset(inputs, 0, sizeof(inputs));
+    frame = 0;
+    active = 1;
+
+    /* both peers rank from nothing, each had its own history */
+    chaos_ram_clear();
+    chaos_zdrv_clear();
+}
+
+void netplay_end(void)
+{
+    active = 0;
+}
+
+int netplay_active(void)
+{
+    return active;
+}
+
+int netplay_frame(void)
+{
+    return frame;
+}
+
+netplay_input_t *netplay_input(int n)
+{
+    return &inputs[n & (NETPLAY_FRAMES - 1)];
+}
+
+void netplay_frame_begin(void)
+{
+    netplay_snapshot_t *snapshot = &snapshots[frame & (NETPLAY_FRAMES - 1)];
+    const netplay_input_t *in = &inputs[frame & (NETPLAY_FRAMES - 1)];
+    uint32 i;
+
+    if (!active)
+        return;
+
+    state_save(snapshot->state, 0);
+    chaos_context_save(snapshot->chaos);
+    snapshot->frame = frame;
+
+    input.pad[0] = in->pad[0];
+    input.pad[4] = in->pad[1];
+    for (i = 0; (i < in->count) && (i < NETPLAY_PLAYERS * NETPLAY_COMMANDS); i++)
+        chaos_queue_submit(&in->cmd[i]);
+}
+
+void netplay_frame_end(void)
+{
+    if (active)
+        frame++;
+}
+
+int netplay_load(int n)
+{
+    netplay_snapshot_t *snapshot = &snapshots[n & (NETPLAY_FRAMES - 1)];
+
+    if (!active || (n < 0) || (n >= frame) || (snapshot->frame != n))
+        return 0;
+
+    /* same game and session: no reset, audio keeps playing */
+    if (!state_load(snapshot->state, STATE_INPLACE))
+        return 0;
+    chaos_context_load(snapshot->chaos);
+    chaos_undo_clear();
+    frame = n;
+    return 1;
+}
+
+void netplay_memory_report(void)
+{
+    memory_region("netplay snapshots", snapshots, sizeof(snapshots));
+}
@@ -0,0 +1,66 @@
+#ifndef _NETPLAY_H_
+#define _NETPLAY_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+#include "chaos_queue.h"
+
+/* Rollback netplay (netplay.js).
+ *
+ * Two peers run the same ROM from the same reset and chaos seed and only
+ * exchange what the emulation depends on: the pads and the chaos commands
+ * of each frame. A frame runs as soon as the local input is known, with the
+ * remote pad predicted; when the real one turns out different, the core
+ * goes back to the start of the first frame that was wrong and runs the
+ * frames since again without rendering (netplay_rollback() in wasm.c).
+ *
+ * A snapshot is taken at the start of each frame and the last
+ * NETPLAY_FRAMES are kept: the sectioned save state, unpacked and loaded in
+ * place, and the chaos state that carries over to the next frame
+ * (chaos_context_save()). Saving or loading one takes tens of
+ * microseconds. The work RAM and sound driver analysers (chaos_ram.h,
+ * chaos_zdrv.h) are not in the snapshot, far too large for it: they start
+ * over with the session and do not sample while it runs, so a rolled back
+ * peer aims its effects at the same bytes as the other one.
+ *
+ * The front end writes the input of frame n to netplay_input(n) before the
+ * frame runs; the slot is reused NETPLAY_FRAMES frames later.
+ */
+
+#define NETPLAY_FRAMES   8  /* rollback window, must be a power of 2 */
+#define NETPLAY_PLAYERS  2
+#define NETPLAY_COMMANDS 8  /* chaos commands per player and frame */
+
+typedef struct
+{
+    uint16_t pad[NETPLAY_PLAYERS];  /* INPUT_* bits of input.pad[0] and input.pad[4] */
+    uint32_t count;                 /* commands */
+    chaos_cmd_t cmd[NETPLAY_PLAYERS * NETPLAY_COMMANDS];
+} netplay_input_t;
+
+/* Start counting frames from 0 (the system was just reset and seeded) */
+void netplay_begin(void);
+
+/* End the session; the pads are read from the front end again */
+void EMSCRIPTEN_KEEPALIVE netplay_end(void);
+
+int EMSCRIPTEN_KEEPALIVE netplay_active(void);
+
+/* Next frame to run */
+int EMSCRIPTEN_KEEPALIVE netplay_frame(void);
+
+/* Input slot of 'frame' */
+netplay_input_t* EMSCRIPTEN_KEEPALIVE netplay_input(int frame);
+
+/* Frame hooks (wasm.c frame loop): the snapshot, then the pads and the
+ * commands of the frame go in before the chaos queue is consumed */
+void netplay_frame_begin(void);
+void netplay_frame_end(void);
+
+/* Back to the start of 'frame'; 0 when it is not in the window */
+int netplay_load(int frame);
+
+/* Add the snapshots to the memory report */
+void netplay_memory_report(void);
+
+#endif /* _NETPLAY_H_ */
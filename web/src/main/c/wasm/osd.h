@@ -2,6 +2,7 @@
 #ifndef _OSD_H_
 #define _OSD_H_
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
@@ -9,13 +10,17 @@
 
 #include <stdlib.h>
 
+/* before anything including macros.h, which defaults the cdStream functions to stdio */
+#include "cdstream.h"
 #include "wasm.h"
 #include "config.h"
 #include "error.h"
 #include "fileio.h"
 #include "scrc32.h"
+#include "memmap.h"
 
 #define osd_input_update wasm_input_update
+#define osd_input_poll wasm_input_poll
 
 #define GG_ROM      "./ggenie.bin"
 #define AR_ROM      "./areplay.bin"
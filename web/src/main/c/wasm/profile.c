@@ -0,0 +1,106 @@
+/**
+ * ChaosDrive - frame time profiling
+ *
+ * performance.now() through emscripten_get_now() in the browser, a
+ * monotonic clock in native builds.
+ */
+
+#include "profile.h"
+
+#ifdef CHAOS_PROFILE
+
+#include <string.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/emscripten.h>
+#else
+#include <time.h>
+#endif
+
+frame_profile_t frame_profile;
+uint32_t vdp_count[VDP_COUNTERS];
+uint32_t vdp_counters[VDP_COUNTERS];
+
+static double counters[PROF_COUNT];
+static int current;
+static double mark;
+static double run_start;
+
+static const char *names[PROF_COUNT] =
+{
+    "other", "68k", "z80", "dma", "svp", "bg", "obj", "satb", "remap", "audio", "analysis", "chaos", "rewind"
+};
+
+static const char *vdp_names[VDP_COUNTERS] =
+{
+    "dma ext", "dma ram", "dma io", "dma fill", "dma copy",
+    "dma ext len", "dma ram len", "dma io len", "dma fill len", "dma copy len",
+    "dma stall", "data w", "data r", "ctrl w", "status r", "fifo stalls", "fifo wait", "hint", "vint"
+};
+
+static double profile_now(void)
+{
+#ifdef __EMSCRIPTEN__
+    return emscripten_get_now() * 1000.0;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+#endif
+}
+
+int profile_enter(int id)
+{
+    double now = profile_now();
+    int prev = current;
+
+    counters[current] += now - mark;
+    mark = now;
+    current = id;
+    return prev;
+}
+
+void profile_leave(int prev)
+{
+    double now = profile_now();
+
+    counters[current] += now - mark;
+    mark = now;
+    current = prev;
+}
+
+void profile_frame_begin(void)
+{
+    memset(counters, 0, sizeof(counters));
+    memset(vdp_count, 0, sizeof(vdp_count));
+    current = PROF_OTHER;
+    mark = run_start = profile_now();
+}
+
+void profile_frame_end(int frames)
+{
+    int i;
+    double now = profile_now();
+
+    counters[current] += now - mark;
+    mark = now;
+
+    for (i = 0; i < PROF_COUNT; i++)
+    {
+        frame_profile.usec[i] = (float)counters[i];
+    }
+    frame_profile.total = (float)(now - run_start);
+    frame_profile.frames = (float)frames;
+    memcpy(vdp_counters, vdp_count, sizeof(vdp_counters));
+}
+
+const char *profile_name(int id)
+{
+    return (id >= 0 && id < PROF_COUNT) ? names[id] : "";
+}
+
+const char *profile_vdp_name(int id)
+{
+    return (id >= 0 && id < VDP_COUNTERS) ? vdp_names[id] : "";
+}
+
+#endif /* CHAOS_PROFILE */
@@ -0,0 +1,109 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+
+#include <stdint.h>
+
+/* Frame time profiling (CHAOS_PROFILE builds).
+ *
+ * Time is attributed exclusively: PROFILE_CALL() switches the current
+ * counter for the duration of the call, so nested work (e.g. a DMA started
+ * by a 68k write) is only counted once. Everything outside a profiled call
+ * is counted as PROF_OTHER. Without CHAOS_PROFILE, PROFILE_CALL() is just
+ * the call itself.
+ */
+
+enum
+{
+    PROF_OTHER,
+    PROF_M68K,
+    PROF_Z80,
+    PROF_DMA,
+    PROF_SVP,
+    PROF_RENDER_BG,
+    PROF_RENDER_OBJ,
+    PROF_PARSE_SATB,
+    PROF_REMAP,
+    PROF_AUDIO,
+    PROF_ANALYSIS,
+    PROF_CHAOS,
+    PROF_REWIND,
+    PROF_COUNT
+};
+
+/* Counters of the last profiled run (one tick + its sound() call) */
+typedef struct
+{
+    float usec[PROF_COUNT];
+    float total;    /* wall-clock time of the run, usec */
+    float frames;   /* frames emulated in the run */
+} frame_profile_t;
+
+/* VDP traffic, counted over the same runs: what a slow frame spent its time
+ * on besides rendering. DMA slices are vdp_dma_update() calls, one per line
+ * a DMA runs on (or one for a whole VBlank); their length is in words for
+ * DMA from the 68k bus, bytes for fill and copy. Stalls and waits are in
+ * master clock cycles (7 per 68k cycle). Interrupts are the ones the 68k
+ * took. */
+enum
+{
+    VDP_DMA_EXT,            /* DMA from cartridge / external area, slices */
+    VDP_DMA_RAM,            /* DMA from 68k RAM */
+    VDP_DMA_IO,             /* DMA from the I/O area */
+    VDP_DMA_FILL,
+    VDP_DMA_COPY,
+    VDP_DMA_EXT_LENGTH,     /* same order, length */
+    VDP_DMA_RAM_LENGTH,
+    VDP_DMA_IO_LENGTH,
+    VDP_DMA_FILL_LENGTH,
+    VDP_DMA_COPY_LENGTH,
+    VDP_DMA_STALL,          /* 68k frozen by DMA from the 68k bus */
+    VDP_DATA_WRITES,        /* data port, 68k and Z80 */
+    VDP_DATA_READS,
+    VDP_CTRL_WRITES,        /* control port */
+    VDP_STATUS_READS,
+    VDP_FIFO_STALLS,        /* data writes that found the FIFO full */
+    VDP_FIFO_WAIT,          /* 68k halted on those */
+    VDP_HINT,
+    VDP_VINT,
+    VDP_COUNTERS
+};
+
+#ifdef CHAOS_PROFILE
+
+extern frame_profile_t frame_profile;
+
+/* Make 'id' the current counter, returns the previous one */
+int profile_enter(int id);
+
+/* Restore the counter returned by profile_enter() */
+void profile_leave(int prev);
+
+/* Start a new run: clear counters */
+void profile_frame_begin(void);
+
+/* End the run: publish counters to frame_profile */
+void profile_frame_end(int frames);
+
+/* Counter name (for the front-end) */
+const char *profile_name(int id);
+
+#define PROFILE_CALL(id, call) do { int prof_prev_ = profile_enter(id); call; profile_leave(prof_prev_); } while (0)
+
+/* VDP counters: live ones, and those of the last run (published by
+ * profile_frame_end()) */
+extern uint32_t vdp_count[VDP_COUNTERS];
+extern uint32_t vdp_counters[VDP_COUNTERS];
+
+/* VDP counter name (for the front-end) */
+const char *profile_vdp_name(int id);
+
+#define PROFILE_COUNT(id, n) (vdp_count[id] += (uint32_t)(n))
+
+#else
+
+#define PROFILE_CALL(id, call) do { call; } while (0)
+#define PROFILE_COUNT(id, n)
+
+#endif /* CHAOS_PROFILE */
+
+#endif /* _PROFILE_H_ */
@@ -0,0 +1,292 @@
+/**
+ * ChaosDrive - rewind buffer
+ *
+ * Deltas are XORs of two consecutive snapshots, coded as 32-bit words:
+ * (varint equal words, varint literal words, literal words...) tokens.
+ * Most of the machine state does not change within a few frames, so a
+ * delta is a small fraction of the snapshot and stepping back is a single
+ * pass XORing the newest delta into the full snapshot.
+ *
+ * Deltas live in a circular arena, newest after oldest; the space needed
+ * for a new one is freed by dropping deltas from the old end.
+ */
+
+#include "shared.h"
+#include "rewind.h"
+#include "memmap.h"
+#include "chaos_record.h"
+#include "chaos_undo.h"
+#include "netplay.h"
+
+/* state_save() size rounded up to whole words */
+#define REWIND_WORDS ((STATE_SIZE + 3) >> 2)
+
+/* worst case delta size: a token never costs more than the equal words it skips */
+#define REWIND_DELTA_MAX (REWIND_WORDS * 4 + 16)
+
+typedef struct
+{
+    int offset;
+    int size;
+} rewind_delta_t;
+
+/* newest full snapshot and the capture buffer */
+static uint32 snapshot[2][REWIND_WORDS];
+static int current;
+static int snapshot_size;
+
+static uint8 arena[REWIND_BUDGET];
+static uint8 scratch[REWIND_DELTA_MAX];
+static int write_pos;
+
+static rewind_delta_t deltas[REWIND_MAX_SNAPSHOTS];
+static int first;
+static int count;
+
+static int interval = REWIND_INTERVAL;
+static int frames;
+
+/* set once the emulator was rewound to the full snapshot */
+static int at_snapshot;
+
+static int put_varint(uint8 *p, uint32 value)
+{
+    int n = 0;
+
+    while (value >= 0x80)
+    {
+        p[n++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    p[n++] = value;
+    return n;
+}
+
+static uint32 get_varint(const uint8 **p)
+{
+    uint32 value = 0;
+    int shift = 0;
+
+    while (**p & 0x80)
+    {
+        value |= (*(*p)++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= *(*p)++ << shift;
+    return value;
+}
+
+#define SAME(i) (((i) >= words) || (cur[i] == prev[i]))
+
+static int delta_encode(uint8 *out, const uint32 *cur, const uint32 *prev, int words)
+{
+    uint8 *p = out;
+    int i = 0;
+
+    while (i < words)
+    {
+        int skip = i;
+        int lits;
+
+        while ((i < words) && (cur[i] == prev[i]))
+            i++;
+        skip = i - skip;
+
+        /* literal runs only stop at two equal words, single ones are cheaper inline */
+        lits = i;
+        while ((i < words) && !(SAME(i) && SAME(i + 1)))
+            i++;
+        lits = i - lits;
+
+        p += put_varint(p, skip);
+        p += put_varint(p, lits);
+        for (; lits > 0; lits--, p += 4)
+        {
+            uint32 x = cur[i - lits] ^ prev[i - lits];
+            memcpy(p, &x, 4);
+        }
+    }
+
+    return p - out;
+}
+
+static void delta_apply(uint32 *state, const uint8 *p, int size)
+{
+    const uint8 *end = p + size;
+    uint32 i = 0;
+
+    while (p < end)
+    {
+        uint32 lits;
+
+        i += get_varint(&p);
+        lits = get_varint(&p);
+        for (; lits > 0; lits--, p += 4)
+        {
+            uint32 x;
+            memcpy(&x, p, 4);
+            state[i++] ^= x;
+        }
+    }
+}
+
+/* find room for 'size' bytes, dropping the oldest deltas as needed */
+static int arena_alloc(int size)
+{
+    if (size > REWIND_BUDGET)
+        return -1;
+
+    if (count == REWIND_MAX_SNAPSHOTS)
+    {
+        first = (first + 1) & (REWIND_MAX_SNAPSHOTS - 1);
+        count--;
+    }
+
+    for (;;)
+    {
+        int tail;
+
+        if (!count)
+        {
+            if (write_pos + size > REWIND_BUDGET)
+                write_pos = 0;
+            break;
+        }
+
+        tail = deltas[first].offset;
+        if (tail < write_pos)
+        {
+            /* free: [write_pos, end) and [0, tail) */
+            if (write_pos + size <= REWIND_BUDGET)
+                break;
+            if (size <= tail)
+            {
+                write_pos = 0;
+                break;
+            }
+        }
+        else if (write_pos + size <= tail)
+        {
+            /* free: [write_pos, tail) */
+            break;
+        }
+
+        first = (first + 1) & (REWIND_MAX_SNAPSHOTS - 1);
+        count--;
+    }
+
+    return write_pos;
+}
+
+static void capture(void)
+{
+    uint32 *next = snapshot[current ^ 1];
+    int size = state_save((unsigned char *)next, 0);
+
+    memset((uint8 *)next + size, 0, (REWIND_WORDS * 4) - size);
+
+    /* the state layout changed (or first snapshot): restart the history */
+    if (size != snapshot_size)
+    {
+        count = 0;
+        write_pos = 0;
+    }
+    else
+    {
+        /* XOR of the previous snapshot with the new one: steps back from 'next' */
+        int delta = delta_encode(scratch, next, snapshot[current], (size + 3) >> 2);
+        int offset = arena_alloc(delta);
+
+        if (offset < 0)
+        {
+            count = 0;
+            write_pos = 0;
+        }
+        else
+        {
+            rewind_delta_t *d = &deltas[(first + count) & (REWIND_MAX_SNAPSHOTS - 1)];
+            memcpy(arena + offset, scratch, delta);
+            d->offset = offset;
+            d->size = delta;
+            count++;
+            write_pos = offset + delta;
+        }
+    }
+
+    current ^= 1;
+    snapshot_size = size;
+    at_snapshot = 0;
+}
+
+void rewind_memory_report(void)
+{
+    memory_region("rewind snapshots", snapshot, sizeof(snapshot));
+    memory_region("rewind scratch", scratch, sizeof(scratch));
+    memory_region("rewind arena", arena, sizeof(arena));
+}
+
+void rewind_reset(void)
+{
+    count = 0;
+    first = 0;
+    write_pos = 0;
+    snapshot_size = 0;
+    frames = 0;
+    at_snapshot = 0;
+}
+
+void rewind_frame(void)
+{
+    if (!interval)
+        return;
+
+    if (++frames >= interval)
+    {
+        frames = 0;
+        capture();
+    }
+}
+
+int rewind_step(void)
+{
+    int stepped = 0;
+
+    if (!snapshot_size)
+        return 0;
+
+    /* the session cannot be replayed (or kept in step with the other player) across a jump back */
+    chaos_record_stop();
+    netplay_end();
+    chaos_undo_clear();
+
+    /* first go back to the full snapshot, then one delta per call */
+    if (at_snapshot && count)
+    {
+        const rewind_delta_t *d = &deltas[(first + count - 1) & (REWIND_MAX_SNAPSHOTS - 1)];
+        delta_apply(snapshot[current], arena + d->offset, d->size);
+        count--;
+        write_pos = d->offset;
+        stepped = 1;
+    }
+    else if (!at_snapshot)
+    {
+        stepped = 1;
+    }
+
+    /* same game and session: no reset needed, audio keeps playing */
+    state_load((unsigned char *)snapshot[current], STATE_INPLACE);
+    at_snapshot = 1;
+    frames = 0;
+    return stepped;
+}
+
+int rewind_frames(void)
+{
+    return snapshot_size ? (count * interval + frames) : 0;
+}
+
+void rewind_set_interval(int value)
+{
+    interval = (value > 0) ? value : 0;
+    rewind_reset();
+}
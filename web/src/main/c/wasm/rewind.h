@@ -0,0 +1,46 @@
+#ifndef _REWIND_H_
+#define _REWIND_H_
+
+#include <emscripten/emscripten.h>
+
+/* Rewind buffer.
+ *
+ * A state_save() snapshot is taken every REWIND_INTERVAL frames. Only the
+ * newest snapshot is kept in full; older ones are stored as the XOR with
+ * their successor, run-length coded, in a REWIND_BUDGET byte arena. The
+ * oldest deltas are dropped when the arena is full.
+ */
+
+#ifndef REWIND_INTERVAL
+#define REWIND_INTERVAL 10 /* frames between snapshots */
+#endif
+
+#ifndef REWIND_BUDGET
+#ifdef MD_ONLY
+#define REWIND_BUDGET (3 << 18) /* delta arena size, bytes (fits the fixed heap, memmap.h) */
+#else
+#define REWIND_BUDGET (4 << 20) /* delta arena size, bytes */
+#endif
+#endif
+
+#define REWIND_MAX_SNAPSHOTS 1024 /* must be a power of 2 */
+
+/* Add the buffers to the memory report */
+void rewind_memory_report(void);
+
+/* Drop the history (new ROM loaded) */
+void rewind_reset(void);
+
+/* Count an emulated frame, take a snapshot when due */
+void rewind_frame(void);
+
+/* Load the previous snapshot; returns 0 once the oldest one is reached */
+int EMSCRIPTEN_KEEPALIVE rewind_step(void);
+
+/* Frames of history available */
+int EMSCRIPTEN_KEEPALIVE rewind_frames(void);
+
+/* Frames between snapshots (0 disables rewind) */
+void EMSCRIPTEN_KEEPALIVE rewind_set_interval(int frames);
+
+#endif /* _REWIND_H_ */
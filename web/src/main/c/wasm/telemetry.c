@@ -0,0 +1,90 @@
+/**
+ * ChaosDrive - session performance telemetry
+ *
+ * A handful of clock reads per run, plus two per rendered line on sampled
+ * runs; the histograms are bumped once per run.
+ */
+
+#include <string.h>
+#include "telemetry.h"
+
+double telemetry_time[TELEMETRY_HISTOGRAMS];
+int telemetry_sampling;
+
+static telemetry_t session = { TELEMETRY_VERSION, TELEMETRY_BUCKETS };
+static double run_start;
+static double run_budget;   /* real time of the frames of the run, ms */
+static int run_count;
+static int run_open;
+
+/* quarter octave buckets: 0-3 us one each, then 4 per power of 2 */
+static int bucket(double ms)
+{
+    uint32_t usec;
+    int octave = 2;
+
+    if (ms <= 0)
+        return 0;
+    usec = (ms < 1000000.0) ? (uint32_t)(ms * 1000.0) : 0xFFFFFFFF;
+    if (usec < 4)
+        return usec;
+    while ((usec >> (octave + 1)) && (octave < 17))
+        octave++;
+    octave = ((octave - 1) << 2) | ((usec >> (octave - 2)) & 3);
+    return (octave < TELEMETRY_BUCKETS) ? octave : TELEMETRY_BUCKETS - 1;
+}
+
+void telemetry_run_begin(int frames, int fps)
+{
+    memset(telemetry_time, 0, sizeof(telemetry_time));
+    telemetry_sampling = (run_count++ % TELEMETRY_SAMPLE_RUNS) == 0;
+    session.counters[TELEMETRY_FRAMES] += frames;
+    run_budget = frames * 1000.0 / fps;
+    run_open = 1;
+    run_start = emscripten_get_now();
+}
+
+double telemetry_run_end(void)
+{
+    double total = emscripten_get_now() - run_start;
+
+    if (!run_open)
+        return 0;
+    run_open = 0;
+    session.counters[TELEMETRY_RUNS]++;
+    session.histogram[TELEMETRY_RUN][bucket(total)]++;
+    if (total > run_budget)
+        session.counters[TELEMETRY_LATE]++;
+
+    if (telemetry_sampling)
+    {
+        int i;
+
+        telemetry_time[TELEMETRY_EMULATION] = total - telemetry_time[TELEMETRY_RENDER] -
+                                              telemetry_time[TELEMETRY_AUDIO] - telemetry_time[TELEMETRY_CHAOS];
+        for (i = TELEMETRY_EMULATION; i < TELEMETRY_HISTOGRAMS; i++)
+            session.histogram[i][bucket(telemetry_time[i])]++;
+        session.counters[TELEMETRY_SAMPLED]++;
+        telemetry_sampling = 0;
+    }
+    return total / run_budget;
+}
+
+void telemetry_count(int counter, int count)
+{
+    if ((unsigned int)counter < TELEMETRY_COUNTERS)
+        session.counters[counter] += count;
+}
+
+const telemetry_t *telemetry_export(void)
+{
+    return &session;
+}
+
+void telemetry_reset(void)
+{
+    memset(session.counters, 0, sizeof(session.counters));
+    memset(session.histogram, 0, sizeof(session.histogram));
+    run_count = 0;
+    run_open = 0;
+}
@@ -0,0 +1,81 @@
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <stdint.h>
+#include <emscripten/emscripten.h>
+
+/* Session performance telemetry (always built, unlike CHAOS_PROFILE).
+ *
+ * Each run (one tick() or tick_n() and the sound() call that follows it) is
+ * one sample. Its wall time goes into a histogram, and so do its emulation,
+ * render, audio and chaos parts. Render is timed per line, so that split is
+ * only taken on every TELEMETRY_SAMPLE_RUNS-th run; emulation is what is left
+ * of the run. With the render thread, render is the time the emulation
+ * thread spends handing lines over.
+ *
+ * The histograms have fixed buckets, a quarter octave of microseconds each
+ * (1 us up to 131 ms, longer runs land in the last one), so a session of any
+ * length takes the same memory and nothing is allocated. The counters add
+ * the runs slower than the frames they emulate, and what the front end
+ * reports: frames run late and skipped to catch up, and audio underruns.
+ */
+
+#define TELEMETRY_BUCKETS       64
+#define TELEMETRY_SAMPLE_RUNS   4
+
+enum
+{
+    TELEMETRY_RUN,
+    TELEMETRY_EMULATION,
+    TELEMETRY_RENDER,
+    TELEMETRY_AUDIO,
+    TELEMETRY_CHAOS,
+    TELEMETRY_HISTOGRAMS
+};
+
+/* counters (telemetry_count() for the ones the front end reports) */
+enum
+{
+    TELEMETRY_RUNS,         /* runs, TELEMETRY_RUN histogram total */
+    TELEMETRY_FRAMES,       /* frames emulated */
+    TELEMETRY_SAMPLED,      /* runs with the split, total of the others */
+    TELEMETRY_LATE,         /* runs slower than real time */
+    TELEMETRY_MISSED,       /* frames skipped by the front end to catch up */
+    TELEMETRY_UNDERRUNS,    /* audio output starved */
+    TELEMETRY_COUNTERS
+};
+
+/* the export: version, counters and histograms, all little endian uint32 */
+#define TELEMETRY_VERSION 1
+
+typedef struct
+{
+    uint32_t version;
+    uint32_t buckets;
+    uint32_t counters[TELEMETRY_COUNTERS];
+    uint32_t histogram[TELEMETRY_HISTOGRAMS][TELEMETRY_BUCKETS];
+} telemetry_t;
+
+/* Part of the current run spent in 'id', nonzero while the split is sampled */
+extern double telemetry_time[TELEMETRY_HISTOGRAMS];
+extern int telemetry_sampling;
+
+#define TELEMETRY_CALL(id, call) do { \
+        if (telemetry_sampling) { double tel_start_ = emscripten_get_now(); call; telemetry_time[id] += emscripten_get_now() - tel_start_; } \
+        else { call; } \
+    } while (0)
+
+/* Run of 'frames' frames at 'fps' starts / ends (sound() returned); the end
+ * returns the run's wall time over the real time of its frames, 0 when no
+ * run was started */
+void telemetry_run_begin(int frames, int fps);
+double telemetry_run_end(void);
+
+/* Add 'count' to a counter */
+void EMSCRIPTEN_KEEPALIVE telemetry_count(int counter, int count);
+
+/* Session so far, and back to an empty session */
+const telemetry_t* EMSCRIPTEN_KEEPALIVE telemetry_export(void);
+void EMSCRIPTEN_KEEPALIVE telemetry_reset(void);
+
+#endif /* _TELEMETRY_H_ */
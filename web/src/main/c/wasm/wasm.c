@@ -4,124 +4,771 @@
 #include "md_ntsc.h"
 #include "sms_ntsc.h"
 #include "chaos.h"
+#include "chaos_rand.h"
+#include "profile.h"
+#include "telemetry.h"
+#include "governor.h"
+#include "learned.h"
+#include "rewind.h"
+#include "chaos_checkpoint.h"
+#include "chaos_cheat.h"
+#include "chaos_ram.h"
+#include "chaos_zdrv.h"
+#include "chaos_rom.h"
+#include "chaos_fm.h"
+#include "chaos_audio.h"
+#include "chaos_record.h"
+#include "chaos_queue.h"
+#include "chaos_vdplog.h"
+#include "chaos_undo.h"
+#include "chaos_watchdog.h"
+#include "capture.h"
+#include "clip.h"
+#include "gpu_log.h"
+#include "netplay.h"
+#include "backup.h"
+#include "memmap.h"
+#ifdef HOOK_CPU
+#include "watch.h"
+#endif
+#ifdef CHAOS_PC_PROFILE
+#include "pcprof.h"
+#endif
 
+// output rate until the front end sets the device's (set_audio_rate()), and of sessions
 #define SOUND_FREQUENCY 44100
-#define SOUND_SAMPLES_SIZE 2048
+#define SOUND_SAMPLES_SIZE 8192
 
-#define VIDEO_WIDTH  640
-#define VIDEO_HEIGHT 480
+// output rate limits: a frame must fit in SOUND_SAMPLES_SIZE / 2 samples and in the
+// blip_max_frame samples of the resampler (PAL, skew -1%, SOUND_SPEED_MIN)
+#define SOUND_RATE_MIN 8000
+#define SOUND_RATE_MAX 48000
+#define SOUND_SKEW_MAX 0.01
 
-#define GAMEPAD_API_INDEX 32
+// set_audio_speed() range
+#define SOUND_SPEED_MIN 0.25
+#define SOUND_SPEED_MAX 4.0
 
-uint32_t *frame_buffer;
-int16_t *sound_frame;
-float_t *input_buffer;
+// output samples per channel kept between two sound() calls (several frames with tick_n)
+#define WEB_AUDIO_SIZE (SOUND_SAMPLES_SIZE * 4)
 
-float_t *web_audio_l;
-float_t *web_audio_r;
+// tick_n: frames per call, and its render argument
+#define TICK_MAX_FRAMES 16
+#define TICK_RENDER_ALL  0
+#define TICK_RENDER_LAST 1
+#define TICK_RENDER_NONE 2   // hidden tab playing audio: nothing is shown
+
+// frame size before scaling; the frame buffer rows are VIDEO_WIDTH * scale pixels
+#define VIDEO_WIDTH  320
+#define VIDEO_HEIGHT 240
+#define VIDEO_SCALE_MAX 4
+
+// static, like the rest of the core state: the layout is fixed at link time (memmap.h)
+uint32_t frame_buffer[VIDEO_WIDTH * VIDEO_HEIGHT * VIDEO_SCALE_MAX * VIDEO_SCALE_MAX];
+
+float_t web_audio_l[WEB_AUDIO_SIZE];
+float_t web_audio_r[WEB_AUDIO_SIZE];
+int web_audio_count;
+
+// frame lines (before scaling) changed since the previous tick
+uint8 wasm_dirty_lines[VIDEO_HEIGHT];
+
+// output scale of the RGB frame buffer (set_output_scale())
+int wasm_output_scale = 2;
+
+// active area: viewport x, y, w, h (frame lines/pixels before scaling)
+int32_t frame_info[4];
+
+// indexed output: 8-bit pixel indices per frame line, looked up in the palette by the front-end
+uint8 wasm_index_buffer[WASM_INDEX_PITCH * WASM_INDEX_LINES];
+int wasm_indexed_output;
+
+// NTSC filter kernels (set_ntsc()), allocated on first use
+md_ntsc_t *md_ntsc;
 
 struct _zbank_memory_map zbank_memory_map[256];
 
+// output rate and resampler skew (set_audio_rate())
+static int sound_rate = SOUND_FREQUENCY;
+static double sound_skew;
+// tape-style playback speed (set_audio_speed())
+static double sound_speed = 1.0;
+
+// sessions (recorded, replayed or played online) run at SOUND_FREQUENCY without skew whatever
+// set_audio_rate() asked: audio-reactive chaos reads the output samples, they must be the same
+// on every machine
+static int audio_pinned;
+
+// set_idle_skip() mode, -1 until set (config default)
+static int idle_skip = -1;
+
+// CRC32 of the running ROM, set by start() (save state slots are keyed by it)
+static uint32_t rom_crc;
+
+// skew 0 at speed 1 keeps the exact master clock ratio; otherwise blip_set_rates() gets the
+// nominal frame rate scaled by the speed and 1 + skew, as if the console ran that much faster
+static void audio_skew_apply(void) {
+    double fps = (double)system_clock / (MCYCLES_PER_LINE * (vdp_pal ? 313 : 262));
+    if(audio_pinned) audio_set_rate(SOUND_FREQUENCY, 0);
+    else if(sound_skew || sound_speed != 1.0) audio_set_rate(sound_rate, fps * sound_speed * (1.0 + sound_skew));
+    else audio_set_rate(sound_rate, 0);
+}
+
 void EMSCRIPTEN_KEEPALIVE init(void)
 {
-    // vram & sampling malloc
-    rom_buffer = malloc(sizeof(uint8_t) * MAXROMSIZE);
-    frame_buffer = malloc(sizeof(uint32_t) * VIDEO_WIDTH * VIDEO_HEIGHT);
-    sound_frame = malloc(sizeof(int16_t) * SOUND_SAMPLES_SIZE);
-    web_audio_l = malloc(sizeof(float_t) * SOUND_SAMPLES_SIZE);
-    web_audio_r = malloc(sizeof(float_t) * SOUND_SAMPLES_SIZE);
-    input_buffer = malloc(sizeof(float_t) * GAMEPAD_API_INDEX);
+    // chaos parameters at their defaults, default chaos seed, front-end may reseed
+    chaos_reset();
+    chaos_seed(0);
 }
 
-void EMSCRIPTEN_KEEPALIVE start(void)
+// frame loop and per-frame chaos of the loaded hardware, chosen once per game: a Master
+// System or Game Gear cartridge runs the Z80 alone, without the 68k and YM2612 of the
+// Mega Drive loop
+static void (*frame_gen)(int do_skip) = system_frame_gen;
+static void (*frame_chaos)(void) = chaos_per_frame_update;
+
+// machine state at the end of the last start(), for soft_reset(1)
+static uint8_t boot_state[STATE_SIZE];
+static int boot_size;
+
+// chaos state of the machine as start() leaves it
+static void chaos_clear(void) {
+    rewind_reset();
+    chaos_checkpoint_clear();
+    chaos_undo_clear();
+    chaos_watchdog_clear();
+    chaos_ram_clear();
+    chaos_zdrv_clear();
+    chaos_cheat_clear();
+    chaos_rom_clear();
+    learned_clear();
+    chaos_vdplog_clear();
+    chaos_fm_clear();
+    chaos_audio_reset();
+}
+
+static void system_start(int session)
 {
+    // a reset or another ROM ends the session being recorded, replayed or played online
+    chaos_record_stop();
+    netplay_end();
+    audio_pinned = session;
+    // another game, or a session's blank backup memory: the front end attaches the player's
+    backup_detach();
+
     // system init
     error_init();
     set_config_defaults();
+    if(idle_skip >= 0) config.idle_skip = idle_skip;
 
     // video ram init
     memset(&bitmap, 0, sizeof(bitmap));
-    bitmap.width      = VIDEO_WIDTH;
-    bitmap.height     = VIDEO_HEIGHT;
-    bitmap.pitch      = VIDEO_WIDTH * 4;
+    bitmap.width      = VIDEO_WIDTH * wasm_output_scale;
+    bitmap.height     = VIDEO_HEIGHT * wasm_output_scale;
+    bitmap.pitch      = bitmap.width * 4;
     bitmap.data       = (uint8_t *)frame_buffer;
     bitmap.viewport.changed = 3;
 
+    // double resolution interlaced output needs whole rows per field line
+    config.render = !(wasm_output_scale & 1);
+
     // load rom
     load_rom("dummy.bin");
+    rom_crc = crc32(0, cart.rom, cart.romsize);
+    if(system_hw == SYSTEM_MCD) {
+        frame_gen = system_frame_scd;
+        frame_chaos = chaos_per_frame_update;
+    } else if((system_hw & SYSTEM_PBC) == SYSTEM_MD) {
+        frame_gen = system_frame_gen;
+        frame_chaos = chaos_per_frame_update;
+    } else {
+        frame_gen = system_frame_sms;
+        frame_chaos = chaos_per_frame_update_sms;
+    }
 
     // emurator init
-    audio_init(SOUND_FREQUENCY, 0);
+    audio_init(audio_pinned ? SOUND_FREQUENCY : sound_rate, 0);
     system_init();
     system_reset();
+    if((sound_skew || sound_speed != 1.0) && !audio_pinned) audio_skew_apply();
+    chaos_clear();
+    governor_start(session);
+    boot_size = state_save(boot_state, 0);
+}
+
+void EMSCRIPTEN_KEEPALIVE start(void)
+{
+    system_start(0);
 }
 
-float_t convert_sample_i2f(int16_t i) {
-    float_t f;
-    if(i < 0) {
-        f = ((float) i) / (float) 32768;
+// Tab: start() over without loading the game again. The ROM, the chip cores, the lookup
+// tables, the resampler and the attached battery save are kept; the hardware is reset, or
+// with 'boot' put back in the state start() left it in, and the chaos state is cleared as
+// start() does. Ends any recorded, replayed or online session.
+void EMSCRIPTEN_KEEPALIVE soft_reset(int boot) {
+    chaos_record_stop();
+    netplay_end();
+    chaos_queue_clear();
+    chaos_reset();
+    // nothing to take back: the memory map is not built again
+    chaos_rom_restore();
+    // the configuration start() set, before the reset picks the FM core
+    governor_reset();
+    if(audio_pinned) {
+        audio_pinned = 0;
+        audio_skew_apply();
+    }
+    if(boot && boot_size) {
+        state_load(boot_state, 0);
+        render_line_cache_dirty();
     } else {
-        f = ((float) i) / (float) 32767;
+        system_reset();
+    }
+    chaos_clear();
+}
+
+// a frame is at most SOUND_SAMPLES_SIZE / 2 samples; resampled here once web_audio_l/r
+// has no room left for one (the part that does not fit is dropped)
+static float_t audio_overflow[2][SOUND_SAMPLES_SIZE / 2];
+
+// append the samples of the last frame to web_audio_l/r (dropped once full)
+static void audio_frame(void) {
+    int size;
+    int room = WEB_AUDIO_SIZE - web_audio_count;
+    float_t *l = web_audio_l + web_audio_count;
+    float_t *r = web_audio_r + web_audio_count;
+    if(room < SOUND_SAMPLES_SIZE / 2) {
+        l = audio_overflow[0];
+        r = audio_overflow[1];
+    }
+    // resampled (and mixed with the Mega CD PCM & CD-DA streams) and filtered straight to float
+    PROFILE_CALL(PROF_AUDIO, size = audio_update_f32(l, r));
+    // levels, spectrum and key on events for audio-reactive chaos
+    PROFILE_CALL(PROF_ANALYSIS, chaos_audio_update(l, r, size));
+    // VGM wait up to the frame end, PCM capture
+    capture_frame(mcycles_vdp, l, r, size);
+    if(size > room) size = room;
+    if(l == audio_overflow[0]) {
+        memcpy(web_audio_l + web_audio_count, l, size * sizeof(float_t));
+        memcpy(web_audio_r + web_audio_count, r, size * sizeof(float_t));
     }
-    if( f > 1 ) f = 1;
-    if( f < -1 ) f = -1;
-    return f;
+    web_audio_count += size;
+}
+
+static void frame_end(void) {
+    // switching between line doubled and double resolution output: rows written
+    // by the other mode are only compared on the first one, resend the frame
+    static int field_rows;
+    if(field_rows != (interlaced && config.render)) {
+        field_rows = interlaced && config.render;
+        memset(wasm_dirty_lines, 1, sizeof(wasm_dirty_lines));
+    }
+    frame_info[0] = bitmap.viewport.x;
+    frame_info[1] = bitmap.viewport.y;
+    frame_info[2] = bitmap.viewport.w;
+    frame_info[3] = bitmap.viewport.h;
+    gpu_log_frame_end();
+    clip_frame();
+}
+
+#ifdef CHAOS_PROFILE
+// frames run since the last sound() call
+static int profile_frames;
+#endif
+
+static void frame_run(int skip) {
+    gpu_log_frame(skip);
+    chaos_record_frame_begin();
+    netplay_frame_begin();
+    TELEMETRY_CALL(TELEMETRY_CHAOS, PROFILE_CALL(PROF_CHAOS, frame_chaos()));
+    frame_gen(skip);
+    netplay_frame_end();
+    chaos_record_frame_end();
+    PROFILE_CALL(PROF_REWIND, rewind_frame());
 }
 
 void EMSCRIPTEN_KEEPALIVE tick(void) {
-    chaos_per_frame_update();
-    system_frame_gen(0);
+#ifdef CHAOS_PROFILE
+    profile_frame_begin();
+    profile_frames = 1;
+#endif
+    telemetry_run_begin(1, vdp_pal ? 50 : 60);
+    memset(wasm_dirty_lines, 0, sizeof(wasm_dirty_lines));
+    frame_run(governor_skip());
+    frame_end();
 }
 
-int EMSCRIPTEN_KEEPALIVE sound(void) {
-    int size = audio_update(sound_frame);
-    int p = 0;
-    for(int i = 0; i < size * 2; i += 2) {
-        web_audio_l[p] = convert_sample_i2f(sound_frame[i]);
-        web_audio_r[p] = convert_sample_i2f(sound_frame[i + 1]);
-        p++;
+// run several frames in one call (fast-forward, frame skip); with TICK_RENDER_LAST
+// only the last frame is drawn, with TICK_RENDER_NONE none, sprite collision/overflow
+// flags are still updated (the governor may skip drawing it too, see governor.h)
+int EMSCRIPTEN_KEEPALIVE tick_n(int frames, int render) {
+    if(frames > TICK_MAX_FRAMES) frames = TICK_MAX_FRAMES;
+#ifdef CHAOS_PROFILE
+    profile_frame_begin();
+    profile_frames = frames;
+#endif
+    telemetry_run_begin(frames, vdp_pal ? 50 : 60);
+    memset(wasm_dirty_lines, 0, sizeof(wasm_dirty_lines));
+    for(int i = 0; i < frames; i++) {
+        int last = (i == frames - 1) && (render != TICK_RENDER_NONE);
+        frame_run((render != TICK_RENDER_ALL && !last) || governor_skip());
+        // keep the blip buffers from overflowing, sound() returns the whole run
+        if(i < frames - 1) TELEMETRY_CALL(TELEMETRY_AUDIO, audio_frame());
     }
-    return p;
+    frame_end();
+    return frames;
 }
 
-int EMSCRIPTEN_KEEPALIVE wasm_input_update(void) {
-    // reset input
-    input.pad[0] = 0;
-    // read button
-    if(input_buffer[8 + 2]) input.pad[0] |= INPUT_A;
-    if(input_buffer[8 + 3]) input.pad[0] |= INPUT_B;
-    if(input_buffer[8 + 1]) input.pad[0] |= INPUT_C;
-    if(input_buffer[8 + 7]) input.pad[0] |= INPUT_START;
-    if(input_buffer[8 + 0]) input.pad[0] |= INPUT_X;
-    if(input_buffer[8 + 4]) input.pad[0] |= INPUT_Y;
-    if(input_buffer[8 + 5]) input.pad[0] |= INPUT_Z;
-    if(input_buffer[8 + 6]) input.pad[0] |= INPUT_MODE;
-    // read axes
-    if(input_buffer[7] == -1) {
-        input.pad[0] |= INPUT_UP;
-    } else if(input_buffer[7] == 1) {
-        input.pad[0] |= INPUT_DOWN;
+// samples per channel since the last call
+int EMSCRIPTEN_KEEPALIVE sound(void) {
+    int count;
+    TELEMETRY_CALL(TELEMETRY_AUDIO, audio_frame());
+    count = web_audio_count;
+    web_audio_count = 0;
+#ifdef CHAOS_PROFILE
+    profile_frame_end(profile_frames);
+#endif
+    governor_run(telemetry_run_end());
+    return count;
+}
+
+#ifdef CHAOS_PROFILE
+// counters of the last tick()/tick_n() + sound(): frame_profile_t (float usec[count], total, frames)
+frame_profile_t* EMSCRIPTEN_KEEPALIVE get_frame_profile_ref(void) {
+    return &frame_profile;
+}
+
+int EMSCRIPTEN_KEEPALIVE frame_profile_count(void) {
+    return PROF_COUNT;
+}
+
+const char* EMSCRIPTEN_KEEPALIVE frame_profile_name(int id) {
+    return profile_name(id);
+}
+
+// VDP traffic of the same run: uint32 counters[vdp_counter_count()] (VDP_* in profile.h)
+uint32_t* EMSCRIPTEN_KEEPALIVE get_vdp_counters_ref(void) {
+    return vdp_counters;
+}
+
+int EMSCRIPTEN_KEEPALIVE vdp_counter_count(void) {
+    return VDP_COUNTERS;
+}
+
+const char* EMSCRIPTEN_KEEPALIVE vdp_counter_name(int id) {
+    return profile_vdp_name(id);
+}
+#endif
+
+#ifdef CHAOS_JIT
+// 68k trace compiler (jit.js): 'callback' is a table index from addFunction(), 0 turns it off
+void EMSCRIPTEN_KEEPALIVE set_m68k_jit(int callback) {
+    m68k_set_jit_callback((m68k_jit_block (*)(int, const unsigned char *, const unsigned int *, int))(size_t)callback);
+}
+
+// addresses used by the compiled traces (M68K_JIT_* in m68k.h)
+const unsigned int* EMSCRIPTEN_KEEPALIVE get_m68k_jit_layout(void) {
+    return m68k_jit_layout();
+}
+#endif
+
+// 68k idle loop skipping: M68K_IDLE_OFF, M68K_IDLE_RAM (exact, default) or M68K_IDLE_VDP
+// (also VDP status polling, per game); kept by start() for the next ROMs
+void EMSCRIPTEN_KEEPALIVE set_idle_skip(int mode) {
+    idle_skip = mode;
+    config.idle_skip = mode;
+    m68k_idle_skip(mode);
+}
+
+// 68k master cycles skipped since the last call
+unsigned int EMSCRIPTEN_KEEPALIVE get_idle_skipped(void) {
+    return m68k_idle_skipped();
+}
+
+// save states (state.h): save_state() fills get_state_buffer_ref() and returns the size,
+// load_state() restores it (flags: STATE_PACK, STATE_INPLACE), 0 on error
+static uint8_t state_buffer[STATE_SIZE];
+
+void wasm_memory_report(void) {
+    memory_region("frame buffer", frame_buffer, sizeof(frame_buffer));
+    memory_region("index buffer", wasm_index_buffer, sizeof(wasm_index_buffer));
+    memory_region("web audio left", web_audio_l, sizeof(web_audio_l));
+    memory_region("web audio right", web_audio_r, sizeof(web_audio_r));
+    memory_region("state buffer", state_buffer, sizeof(state_buffer));
+    memory_region("boot state", boot_state, sizeof(boot_state));
+}
+
+int EMSCRIPTEN_KEEPALIVE get_state_size(void) {
+    return STATE_SIZE;
+}
+
+uint8_t* EMSCRIPTEN_KEEPALIVE get_state_buffer_ref(void) {
+    return state_buffer;
+}
+
+int EMSCRIPTEN_KEEPALIVE save_state(int flags) {
+    return state_save(state_buffer, flags);
+}
+
+int EMSCRIPTEN_KEEPALIVE load_state(int flags) {
+    chaos_record_stop();
+    netplay_end();
+    chaos_undo_clear();
+    return state_load(state_buffer, flags);
+}
+
+uint32_t EMSCRIPTEN_KEEPALIVE get_rom_crc(void) {
+    return rom_crc;
+}
+
+// session recording (chaos_record.h): both start from a reset with the chaos seed of the
+// session; chaos_record_stop() returns the size of chaos_record_data()
+static void session_reset(uint32_t seed) {
+    // the 68k reset keeps D0-D7/A0-A6 and the flags, clear them as at the first power-on
+    memset(m68k.dar, 0, sizeof(m68k.dar));
+    m68k.x_flag = m68k.n_flag = m68k.not_z_flag = m68k.v_flag = m68k.c_flag = 0;
+    chaos_queue_clear();
+    chaos_reset();
+    chaos_seed(seed);
+    system_start(1);
+}
+
+void EMSCRIPTEN_KEEPALIVE record_start(uint32_t seed) {
+    session_reset(seed);
+    chaos_record_begin(seed, rom_crc, config.idle_skip);
+}
+
+// replays the stream written to chaos_replay_buffer(); 0 if it is not valid or was
+// recorded with another ROM. The recorded idle skip mode is kept afterwards.
+int EMSCRIPTEN_KEEPALIVE replay_start(void) {
+    const chaos_record_header_t *header = chaos_replay_header();
+    if(!header || header->rom_crc != rom_crc) return 0;
+    set_idle_skip(header->idle_skip);
+    session_reset(header->seed);
+    return chaos_replay_begin();
+}
+
+// run the replay without rendering up to 'frame' (or its end); the audio of these
+// frames is dropped. Returns the frame reached, the next tick() draws it.
+int EMSCRIPTEN_KEEPALIVE replay_seek(int frame) {
+    while(chaos_record_mode() == CHAOS_RECORD_REPLAY && chaos_record_frame() < frame) {
+        frame_run(1);
+        audio_frame();
+        web_audio_count = 0;
     }
-    if(input_buffer[6] == -1) {
-        input.pad[0] |= INPUT_LEFT;
-    } else if(input_buffer[6] == 1) {
-        input.pad[0] |= INPUT_RIGHT;
+    return chaos_record_frame();
+}
+
+// rollback netplay (netplay.h, netplay.js): both peers start from a reset with the same chaos
+// seed, then frame n runs with the pads and chaos commands written to netplay_input(n)
+int EMSCRIPTEN_KEEPALIVE netplay_start(uint32_t seed) {
+    session_reset(seed);
+    netplay_begin();
+    return NETPLAY_FRAMES;
+}
+
+// go back to the start of 'frame' and run up to the current frame again without rendering,
+// with the input corrected since; the audio of these frames was played already and is
+// dropped, the next tick() draws. Returns the frames run, -1 once 'frame' left the window
+int EMSCRIPTEN_KEEPALIVE netplay_rollback(int frame) {
+    int current = netplay_frame();
+    int count = web_audio_count;
+    if(!netplay_load(frame)) return -1;
+    while(netplay_frame() < current) {
+        frame_run(1);
+        audio_frame();
     }
-    // EM_ASM_({
-    //     console.log('input_buffer[4 + 7]: ' + $0);
-    // }, input_buffer[8 + 7]);
+    web_audio_count = count;
+    return current - frame;
+}
+
+#ifdef HOOK_CPU
+// 68k watchpoints/tracepoints (CHAOS_WATCH=ON, see watch.h): type HOOK_M68K_E/R/W bits,
+// cond watch_cond_t; returns the watch id, 0 if none is left
+int EMSCRIPTEN_KEEPALIVE add_watch(int type, unsigned int start, unsigned int end, int cond, unsigned int ref, unsigned int mask) {
+    return watch_add(type, start, end, cond, ref, mask);
+}
+
+void EMSCRIPTEN_KEEPALIVE remove_watch(int id) {
+    watch_remove(id);
+}
+
+void EMSCRIPTEN_KEEPALIVE clear_watches(void) {
+    watch_clear();
+}
+
+unsigned int EMSCRIPTEN_KEEPALIVE get_watch_count(int id) {
+    return watch_count(id);
+}
+
+// watch_hit_t ring (7 uint32 per hit), the n-th hit at n % WATCH_HITS
+const watch_hit_t* EMSCRIPTEN_KEEPALIVE get_watch_hits_ref(void) {
+    return watch_hits();
+}
+
+unsigned int EMSCRIPTEN_KEEPALIVE get_watch_total(void) {
+    return watch_total();
+}
+#endif
+
+#ifdef CHAOS_PC_PROFILE
+// sampling 68k PC profiler (CHAOS_PC_PROFILE=ON, see pcprof.h): a sample every 'period'
+// master clock cycles of 68k time, 0 stops; samples add up until reset_pc_profile()
+static pcprof_spot_t pc_profile_spots[256];
+
+void EMSCRIPTEN_KEEPALIVE set_pc_profile(unsigned int period) {
+    pcprof_start(period);
+}
+
+void EMSCRIPTEN_KEEPALIVE reset_pc_profile(void) {
+    pcprof_reset();
+}
+
+// hottest 256-byte regions (exact = 0, address 0xffffffff: outside ROM and work RAM) or
+// PCs (exact = 1), most samples first, into get_pc_profile_ref() (address, samples pairs)
+int EMSCRIPTEN_KEEPALIVE pc_profile_report(int max, int exact) {
+    return pcprof_report(pc_profile_spots, (max < 256) ? max : 256, exact);
+}
+
+const pcprof_spot_t* EMSCRIPTEN_KEEPALIVE get_pc_profile_ref(void) {
+    return pc_profile_spots;
+}
+
+unsigned int EMSCRIPTEN_KEEPALIVE get_pc_profile_total(void) {
+    return pcprof_total();
+}
+#endif
+
+// pad 1 as INPUT_* bits. With set_input_live(1) the front end keeps the bits in Module.inputBits
+// (an Int32Array, shared with the page in worker mode) and updates them as its input events
+// arrive; the core reads them when the game reads the pad, not only once per frame. Otherwise
+// (twin) input_bits is written before each tick.
+int32_t input_bits;
+static int input_live;
+
+// INPUT_* bits of pad 1 read by the game since the last input_seen_take() (input.js)
+static int32_t input_seen;
+
+static unsigned int input_latest(void) {
+    if(input_live) return EM_ASM_INT({ return Atomics.load(Module['inputBits'], 0); });
+    return input_bits;
+}
+
+void EMSCRIPTEN_KEEPALIVE set_input_live(int enabled) {
+    input_live = enabled;
+}
+
+int32_t* EMSCRIPTEN_KEEPALIVE get_input_bits_ref(void) {
+    return &input_bits;
+}
+
+int EMSCRIPTEN_KEEPALIVE input_seen_take(void) {
+    int seen = input_seen;
+    input_seen = 0;
+    return seen;
+}
+
+// frame start (just before VINT)
+int EMSCRIPTEN_KEEPALIVE wasm_input_update(void) {
+    // netplay sets both pads at the frame start
+    if(!netplay_active()) input.pad[0] = input_latest();
+    // logged while recording, replaced while replaying
+    chaos_record_input();
     return 1;
 }
 
-uint8_t* EMSCRIPTEN_KEEPALIVE get_rom_buffer_ref(uint32_t size) {
-    rom_size = size;
-    return rom_buffer;
+// pad read (gamepad.c): the latest state, unless a session is recorded, replayed or played
+// online, which keeps the input of the frame start
+unsigned int wasm_input_poll(int port) {
+    if(port == 0) {
+        if(chaos_record_mode() == CHAOS_RECORD_IDLE && !netplay_active()) input.pad[0] = input_latest();
+        input_seen |= input.pad[0];
+    }
+    return input.pad[port];
+}
+
+// stream a ROM file of 'size' bytes straight into cart.rom: write each chunk at the returned
+// address and report its length to rom_stream_write(), which converts the bytes received so
+// far (.smd, byte-swapped dumps, checksum) and returns where the next chunk goes, NULL once
+// the file is complete; then call start(). Nothing may be written past the file size.
+uint8_t* EMSCRIPTEN_KEEPALIVE rom_stream_begin(uint32_t size) {
+    return load_rom_stream_begin(size);
+}
+
+uint8_t* EMSCRIPTEN_KEEPALIVE rom_stream_write(uint32_t len) {
+    return load_rom_stream_write(len);
+}
+
+// 1 once the streamed ROM turns out to need the Mega CD, SVP or 8-bit hardware, which the default
+// Mega Drive only build leaves out (-DCHAOS_FULL_CORE=ON, see core.js): start() would not run it
+int EMSCRIPTEN_KEEPALIVE rom_needs_full_core(void) {
+    return load_rom_stream_needs_full_core();
 }
 
 uint32_t* EMSCRIPTEN_KEEPALIVE get_frame_buffer_ref(void) {
     return frame_buffer;
 }
 
+uint8_t* EMSCRIPTEN_KEEPALIVE get_dirty_lines_ref(void) {
+    return wasm_dirty_lines;
+}
+
+int32_t* EMSCRIPTEN_KEEPALIVE get_frame_info_ref(void) {
+    return frame_info;
+}
+
+void EMSCRIPTEN_KEEPALIVE set_indexed_output(int enabled) {
+    wasm_indexed_output = enabled;
+    // next frame must be uploaded in full
+    memset(wasm_index_buffer, 0, sizeof(wasm_index_buffer));
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    render_line_cache_dirty();
+}
+
+// Integer scale of the RGB frame buffer, 1 to 4: each frame pixel is written as a scale x scale
+// block and the buffer is packed at VIDEO_WIDTH * scale pixels per row, so the front-end can
+// show it on a canvas of that size without resampling. The NTSC filter needs an even scale,
+// so does the double resolution interlaced output (odd scales show one field at a time like
+// progressive frames). The indexed output is not scaled. Returns the scale in effect.
+int EMSCRIPTEN_KEEPALIVE set_output_scale(int scale) {
+    if(scale < 1) scale = 1;
+    if(scale > VIDEO_SCALE_MAX) scale = VIDEO_SCALE_MAX;
+    // waits for the lines still being rendered
+    render_line_cache_dirty();
+    wasm_output_scale = scale;
+    config.render = !(scale & 1);
+    bitmap.width  = VIDEO_WIDTH * scale;
+    bitmap.height = VIDEO_HEIGHT * scale;
+    bitmap.pitch  = bitmap.width * 4;
+    // next frame must be uploaded in full
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    memset(wasm_dirty_lines, 1, sizeof(wasm_dirty_lines));
+    return scale;
+}
+
+// Per-line render cache (render_line_cache()): lines drawn from the same inputs as in the
+// previous frame keep their output, are not rendered again and are not flagged dirty
+void EMSCRIPTEN_KEEPALIVE set_line_cache(int enabled) {
+    render_line_cache(enabled);
+}
+
+// NTSC composite video filter on the RGB output: 0 off, 1 composite, 2 S-video, 3 RGB,
+// 4 monochrome. The filtered lines are 2x wide like the regular ones at scale 2 (widened
+// again at 4x, skipped at odd scales); the indexed output is never filtered. Returns 0 when the kernels cannot be allocated.
+int EMSCRIPTEN_KEEPALIVE set_ntsc(int mode) {
+    static const md_ntsc_setup_t *const setups[] = {
+        &md_ntsc_composite, &md_ntsc_svideo, &md_ntsc_rgb, &md_ntsc_monochrome
+    };
+
+    render_line_cache_dirty();
+    if (mode < 1 || mode > 4) {
+        config.ntsc = 0;
+        return 1;
+    }
+    if (!md_ntsc && !(md_ntsc = malloc(sizeof(md_ntsc_t))))
+        return 0;
+    md_ntsc_init(md_ntsc, setups[mode - 1]);
+    config.ntsc = mode;
+    return 1;
+}
+
+uint8_t* EMSCRIPTEN_KEEPALIVE get_index_buffer_ref(void) {
+    return wasm_index_buffer;
+}
+
+uint32_t* EMSCRIPTEN_KEEPALIVE get_palette_ref(void) {
+    return render_palette_ref();
+}
+
+// live memory for the memory view (memview.js), read between runs: 0 VRAM, 1 CRAM, 2 VSRAM,
+// 3 68k work RAM, 4 Z80 RAM. VRAM, CRAM, VSRAM and work RAM hold 16-bit words in host order,
+// so on little endian hosts the byte at an even 68k address is the second one
+static const struct {
+    uint8 *data;
+    uint32_t size;
+} memory_views[] = {
+    { vram, sizeof(vram) },
+    { cram, sizeof(cram) },
+    { vsram, sizeof(vsram) },
+    { work_ram, sizeof(work_ram) },
+    { zram, sizeof(zram) },
+};
+
+uint8_t* EMSCRIPTEN_KEEPALIVE get_memory_view_ref(int region) {
+    return ((unsigned int)region < sizeof(memory_views) / sizeof(memory_views[0])) ? memory_views[region].data : NULL;
+}
+
+uint32_t EMSCRIPTEN_KEEPALIVE get_memory_view_size(int region) {
+    return ((unsigned int)region < sizeof(memory_views) / sizeof(memory_views[0])) ? memory_views[region].size : 0;
+}
+
+// Output sample rate and resampler skew, for front-ends pacing the frames on audio demand:
+// a skew > 0 produces slightly fewer samples per frame, < 0 slightly more (at most 1%, the
+// pitch change is not audible). A new rate takes effect at the next start(), the skew at
+// once. Both wait for the end of a session (audio_pinned). Returns the samples of one frame
+// at the current video mode.
+int EMSCRIPTEN_KEEPALIVE set_audio_rate(int rate, double skew) {
+    double fps = (double)system_clock / (MCYCLES_PER_LINE * (vdp_pal ? 313 : 262));
+    if(rate < SOUND_RATE_MIN) rate = SOUND_RATE_MIN;
+    if(rate > SOUND_RATE_MAX) rate = SOUND_RATE_MAX;
+    if(skew > SOUND_SKEW_MAX) skew = SOUND_SKEW_MAX;
+    if(skew < -SOUND_SKEW_MAX) skew = -SOUND_SKEW_MAX;
+    sound_rate = rate;
+    sound_skew = skew;
+    // the session is over: the front end has the rate again
+    if(audio_pinned && chaos_record_mode() == CHAOS_RECORD_IDLE && !netplay_active()) audio_pinned = 0;
+    if(audio_pinned) {
+        rate = SOUND_FREQUENCY;
+        skew = 0;
+    }
+    // same rate as the running blip buffers: only the clock ratio changes
+    if(snd.enabled && snd.sample_rate == rate) audio_skew_apply();
+    return (int)(rate / (fps * (audio_pinned ? 1.0 : sound_speed) * (1.0 + skew)) + 0.5);
+}
+
+// Rate the samples of sound() are at: the set_audio_rate() one, or SOUND_FREQUENCY in a session
+// (the front end converts them when its output runs at another rate)
+int EMSCRIPTEN_KEEPALIVE get_audio_rate(void) {
+    return snd.enabled ? snd.sample_rate : audio_pinned ? SOUND_FREQUENCY : sound_rate;
+}
+
+// Tape-style variable speed: the samples of a frame are played over 1 / speed of its time
+// (0.25 to 4), so the pitch follows the speed the front end runs the frames at. 1 for
+// pitch-correct playback, the AudioWorklet then time-stretches the stream instead. Takes
+// effect at once, sessions play at speed 1 (audio_pinned). Returns the samples of one frame.
+int EMSCRIPTEN_KEEPALIVE set_audio_speed(double speed) {
+    if(speed < SOUND_SPEED_MIN) speed = SOUND_SPEED_MIN;
+    if(speed > SOUND_SPEED_MAX) speed = SOUND_SPEED_MAX;
+    sound_speed = speed;
+    return set_audio_rate(sound_rate, sound_skew);
+}
+
+// Stem mode: FM channels, DAC and PSG channels resampled separately and mixed with per-stem
+// gains (mute / solo without re-emulating). Needs the MAME YM2612 core, not available in Mega
+// CD mode; returns 1 when stems are generated.
+int EMSCRIPTEN_KEEPALIVE set_audio_stems(int enabled) {
+    return sound_stems_enable(enabled);
+}
+
+int EMSCRIPTEN_KEEPALIVE audio_stem_count(void) {
+    return SOUND_STEMS;
+}
+
+// mix gains, one float per stem (SOUND_STEM_FM + 0..5, SOUND_STEM_DAC, SOUND_STEM_PSG + 0..3)
+float* EMSCRIPTEN_KEEPALIVE get_audio_stem_gain_ref(void) {
+    return sound_stems.gain;
+}
+
+// last frame of a stem (before gains and filters), 'right' selects the channel; NULL unless enabled
+float* EMSCRIPTEN_KEEPALIVE get_audio_stem_ref(int stem, int right) {
+    if(stem < 0 || stem >= SOUND_STEMS) return NULL;
+    return sound_stems.out[stem][right ? 1 : 0];
+}
+
+int EMSCRIPTEN_KEEPALIVE get_web_audio_size(void) {
+    return WEB_AUDIO_SIZE;
+}
+
 float_t* EMSCRIPTEN_KEEPALIVE get_web_audio_l_ref(void) {
     return web_audio_l;
 }
@@ -130,6 +777,3 @@ float_t* EMSCRIPTEN_KEEPALIVE get_web_audio_r_ref(void) {
     return web_audio_r;
 }
 
-float_t* EMSCRIPTEN_KEEPALIVE get_input_buffer_ref(void) {
-    return input_buffer;
-}
@@ -2,10 +2,15 @@
 #ifndef _MAIN_H_
 #define _MAIN_H_
 
+#include <stdint.h>
+
 #define MAX_INPUTS 8
 
 extern int debug_on;
 extern int log_error;
 extern int wasm_input_update(void);
+extern unsigned int wasm_input_poll(int port);
+extern void wasm_memory_report(void);
+extern uint32_t get_rom_crc(void);
 
 #endif /* _MAIN_H_ */
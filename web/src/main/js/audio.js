@@ -0,0 +1,421 @@
+// AudioWorklet output fed by a single-producer/single-consumer ring buffer.
+//
+// Ring layout: Int32 [write, read] frame counters and the underrun count, Float32 output
+// effect levels and the time-stretch speed, followed by interleaved stereo float samples. With cross-origin isolation
+// the ring lives in a SharedArrayBuffer read directly by the worklet; otherwise sample
+// blocks are posted to the worklet, which keeps the same ring privately.
+//
+// Output effects (the audio_* effects of the core registry, levels from
+// chaos_audio_out_params_ref()) work on the stream itself: the last HISTORY_FRAMES played
+// frames stay in the ring, and the worklet reads them again instead of the live ones.
+// Stutter loops the segment just played a few times, then grabs the next one, reverse
+// plays chunks backwards and decimate holds every sample for up to 16 frames. Each jump of
+// the read position fades the old one out over FADE_FRAMES, so nothing clicks.
+//
+// Pitch-correct variable speed (stretch(speed), 0 or 1: off) time-stretches the stream
+// instead: WSOLA, 512-frame Hann grains overlap-added every 256 output frames, each taken
+// within 64 frames of its nominal position (speed * 256 frames after the previous one) where
+// it best matches the continuation of the previous grain. Stutter and reverse pause meanwhile.
+
+const RING_FRAMES = 32768; // must be a power of 2 (~743ms at 44.1kHz)
+const HISTORY_FRAMES = 16384; // played frames the producer never writes over
+const HEADER_BYTES = 28;
+const EFFECT_LEVELS = 3; // stutter, reverse, decimate
+// output rates the core can generate (SOUND_RATE_MIN / MAX, wasm.c)
+const CORE_RATE_MIN = 8000;
+const CORE_RATE_MAX = 48000;
+
+// worklet side, loaded from a Blob URL so the bundler does not have to know about it
+const PROCESSOR_SOURCE = `
+const RING_FRAMES = ${RING_FRAMES};
+const HISTORY_FRAMES = ${HISTORY_FRAMES};
+const FADE_FRAMES = 128;
+const STUTTER_LOOPS = 4;
+const LIVE = 0, STUTTER = 1, REVERSE = 2;
+const GRAIN = 512, HOP = 256, SEEK = 64;
+class ChaosAudioProcessor extends AudioWorkletProcessor {
+    constructor() {
+        super();
+        this.attach(new ArrayBuffer(${HEADER_BYTES} + RING_FRAMES * 8), false);
+        this.port.onmessage = (e) => {
+            if(e.data.ring) this.attach(e.data.ring, true);
+            if(e.data.samples) this.write(e.data.samples);
+            if(e.data.latency) this.latency = e.data.latency;
+            if(e.data.effects) this.levels.set(e.data.effects);
+            if(e.data.stretch !== undefined) this.speed[0] = e.data.stretch;
+        };
+        this.latency = 2048;
+        this.primed = false;
+        // effect voice: ring position and direction, frames left in its segment
+        this.mode = LIVE;
+        this.pos = 0;
+        this.step = 1;
+        this.left = 0;
+        this.start = 0;
+        this.length = 0;
+        this.loops = 0;
+        // voice fading out after a jump
+        this.fadePos = 0;
+        this.fadeStep = 1;
+        this.fade = 0;
+        this.hold = 0;
+        this.heldL = 0;
+        this.heldR = 0;
+        // time-stretch: nominal ring position of the next grain, position of the last one,
+        // output of the current hop and the second half of the last grain
+        this.stretching = false;
+        this.inPos = 0;
+        this.grain = 0;
+        this.outL = new Float32Array(HOP);
+        this.outR = new Float32Array(HOP);
+        this.out = HOP;
+        this.tailL = new Float32Array(HOP);
+        this.tailR = new Float32Array(HOP);
+        this.window = new Float32Array(GRAIN);
+        for(let i = 0; i < GRAIN; i++) this.window[i] = 0.5 - 0.5 * Math.cos(2 * Math.PI * i / GRAIN);
+    }
+    attach(buffer, shared) {
+        this.header = new Int32Array(buffer, 0, 3);
+        this.levels = new Float32Array(buffer, 12, ${EFFECT_LEVELS});
+        this.speed = new Float32Array(buffer, 24, 1);
+        this.data = new Float32Array(buffer, ${HEADER_BYTES}, RING_FRAMES * 2);
+        this.shared = shared;
+    }
+    write(samples) {
+        let w = this.header[0];
+        if(((w - this.header[1]) | 0) + samples.length / 2 > RING_FRAMES - HISTORY_FRAMES) return;
+        for(let i = 0; i < samples.length; i += 2, w++) {
+            const p = (w & (RING_FRAMES - 1)) * 2;
+            this.data[p] = samples[i];
+            this.data[p + 1] = samples[i + 1];
+        }
+        this.header[0] = w;
+    }
+    // move the voice to 'mode' at live position r, the old one fades out from where it is
+    jump(mode, r) {
+        this.fadePos = this.mode === LIVE ? r : this.pos;
+        this.fadeStep = this.mode === LIVE ? 1 : this.step;
+        this.fade = FADE_FRAMES;
+        this.mode = mode;
+        if(mode === STUTTER) {
+            // 12-70ms segments, the one that just played
+            this.length = 512 + Math.round(this.levels[0] * 2560);
+            this.start = r - this.length;
+            this.pos = this.start;
+            this.step = 1;
+            this.left = this.length;
+            this.loops = 0;
+        } else if(mode === REVERSE) {
+            // 46-140ms chunks, back from the live position
+            this.pos = r - 1;
+            this.step = -1;
+            this.left = 2048 + Math.round(this.levels[1] * 4096);
+        }
+    }
+    // end of a segment: loop the stutter while it stays in the history, otherwise grab the next
+    next(r) {
+        if(this.mode === STUTTER && ++this.loops < STUTTER_LOOPS &&
+            ((r - this.start) | 0) + this.length + FADE_FRAMES < HISTORY_FRAMES - 128) {
+            this.fadePos = this.pos;
+            this.fadeStep = 1;
+            this.fade = FADE_FRAMES;
+            this.pos = this.start;
+            this.left = this.length;
+        } else {
+            this.jump(this.mode, r);
+        }
+    }
+    // time-stretch from live position r on, as if the last grain had been [r - HOP, r + HOP)
+    stretchAt(r) {
+        const data = this.data;
+        this.inPos = r;
+        this.grain = r - HOP;
+        this.out = HOP;
+        for(let i = 0; i < HOP; i++) {
+            const p = ((r + i) & (RING_FRAMES - 1)) * 2;
+            this.tailL[i] = data[p] * this.window[HOP + i];
+            this.tailR[i] = data[p + 1] * this.window[HOP + i];
+        }
+    }
+    // next HOP output frames: the grain around the nominal position that best continues the last
+    hop(speed) {
+        const data = this.data;
+        const mask = RING_FRAMES - 1;
+        const nominal = Math.floor(this.inPos);
+        const next = this.grain + HOP;
+        let best = 0;
+        let bestScore = -Infinity;
+        for(let k = -SEEK; k <= SEEK; k++) {
+            let score = 0;
+            for(let j = 0; j < HOP; j += 4) {
+                const a = ((nominal + k + j) & mask) * 2;
+                const b = ((next + j) & mask) * 2;
+                score += (data[a] + data[a + 1]) * (data[b] + data[b + 1]);
+            }
+            if(score > bestScore) {
+                bestScore = score;
+                best = k;
+            }
+        }
+        const g = nominal + best;
+        const window = this.window;
+        for(let j = 0; j < HOP; j++) {
+            const a = ((g + j) & mask) * 2;
+            const b = ((g + HOP + j) & mask) * 2;
+            this.outL[j] = this.tailL[j] + data[a] * window[j];
+            this.outR[j] = this.tailR[j] + data[a + 1] * window[j];
+            this.tailL[j] = data[b] * window[HOP + j];
+            this.tailR[j] = data[b + 1] * window[HOP + j];
+        }
+        this.grain = g;
+        this.inPos += HOP * speed;
+        this.out = 0;
+    }
+    // stretched output into left/right while the ring holds the next grain; frames written
+    stretchBlock(left, right, w, speed) {
+        let i = 0;
+        while(i < left.length) {
+            if(this.out === HOP) {
+                if(((w - Math.floor(this.inPos)) | 0) < SEEK + GRAIN) break;
+                this.hop(speed);
+            }
+            left[i] = this.outL[this.out];
+            right[i++] = this.outR[this.out++];
+        }
+        return i;
+    }
+    process(inputs, outputs) {
+        const left = outputs[0][0];
+        const right = outputs[0][1] || left;
+        const w = this.shared ? Atomics.load(this.header, 0) : this.header[0];
+        let r = this.header[1];
+        let avail = (w - r) | 0;
+        // producer got too far ahead (tab was in background, frame burst): drop to target latency
+        if(avail > this.latency * 2) {
+            r = w - this.latency;
+            avail = this.latency;
+            // the history behind the new position is not the one the voices were playing
+            this.mode = LIVE;
+            this.fade = 0;
+            if(this.stretching) this.stretchAt(r);
+        }
+        // after an underrun, wait for the target latency to build up again
+        if(!this.primed && avail < this.latency) avail = 0;
+        const levels = this.levels;
+        const speed = this.speed[0];
+        const stretching = speed > 0 && speed !== 1;
+        if(stretching !== this.stretching) {
+            this.stretching = stretching;
+            if(stretching) this.stretchAt(r);
+            else r = Math.floor(this.inPos);
+            this.mode = LIVE;
+            this.fade = 0;
+        }
+        let count;
+        if(stretching) {
+            count = avail ? this.stretchBlock(left, right, w, speed) : 0;
+            r = Math.floor(this.inPos);
+        } else {
+            count = Math.min(avail, left.length);
+        }
+        // ran dry while playing: counted for the session telemetry
+        if(this.primed && count < left.length) {
+            if(this.shared) Atomics.add(this.header, 2, 1);
+            else this.port.postMessage({ underrun: true });
+        }
+        this.primed = count === left.length;
+        const mode = stretching ? LIVE : levels[0] > 0 ? STUTTER : levels[1] > 0 ? REVERSE : LIVE;
+        if(mode !== this.mode) this.jump(mode, r);
+        const data = this.data;
+        for(let i = 0; i < count && !stretching; i++, r++) {
+            let p = ((this.mode === LIVE ? r : this.pos) & (RING_FRAMES - 1)) * 2;
+            let l = data[p];
+            let rr = data[p + 1];
+            if(this.fade) {
+                const f = this.fade-- / FADE_FRAMES;
+                p = (this.fadePos & (RING_FRAMES - 1)) * 2;
+                l = l * (1 - f) + data[p] * f;
+                rr = rr * (1 - f) + data[p + 1] * f;
+                this.fadePos += this.fadeStep;
+            }
+            if(this.mode !== LIVE) {
+                this.pos += this.step;
+                if(--this.left === 0) this.next(r + 1);
+            }
+            left[i] = l;
+            right[i] = rr;
+        }
+        const hold = 1 + Math.floor(Math.min(levels[2], 1) * 15);
+        for(let i = 0; i < count && hold > 1; i++) {
+            if(this.hold++ % hold) {
+                left[i] = this.heldL;
+                right[i] = this.heldR;
+            } else {
+                this.heldL = left[i];
+                this.heldR = right[i];
+            }
+        }
+        left.fill(0, count);
+        right.fill(0, count);
+        if(this.shared) Atomics.store(this.header, 1, r);
+        else this.header[1] = r;
+        return true;
+    }
+}
+registerProcessor('chaos-audio', ChaosAudioProcessor);
+`;
+
+// AudioContext at the device's own rate, so the core's resampler (blip_buf, set_audio_rate())
+// is the only one between the master clock and the output; a rate the core cannot generate
+// is asked for at the nearest one it can, the browser converts that
+export const createAudioContext = function() {
+    const Context = window.AudioContext || window.webkitAudioContext;
+    const context = new Context();
+    const rate = Math.max(CORE_RATE_MIN, Math.min(CORE_RATE_MAX, context.sampleRate));
+    if(rate === context.sampleRate) return context;
+    context.close();
+    return new Context({ sampleRate: rate });
+};
+
+// Linear rate conversion for the blocks pushed to the ring while the core is not at the
+// output rate: sessions pin it to 44.1kHz (get_audio_rate()), their samples must be the same
+// on every machine. convert(left, right, count, from, to) returns the frames written to
+// .left / .right; the fractional position carries over to the next block.
+export const createRateConverter = function() {
+    let pos = 0;
+    let lastL = 0;
+    let lastR = 0;
+    const converter = {
+        left: new Float32Array(0),
+        right: new Float32Array(0),
+        convert: function(left, right, count, from, to) {
+            const step = from / to;
+            const size = Math.ceil(count / step) + 2;
+            if(converter.left.length < size) {
+                converter.left = new Float32Array(size);
+                converter.right = new Float32Array(size);
+            }
+            const outL = converter.left;
+            const outR = converter.right;
+            let n = 0;
+            // pos -1: the last frame of the previous block
+            for(; pos < count - 1; pos += step, n++) {
+                const i = Math.floor(pos);
+                const f = pos - i;
+                const l0 = i < 0 ? lastL : left[i];
+                const r0 = i < 0 ? lastR : right[i];
+                outL[n] = l0 + (left[i + 1] - l0) * f;
+                outR[n] = r0 + (right[i + 1] - r0) * f;
+            }
+            pos -= count;
+            if(count > 0) {
+                lastL = left[count - 1];
+                lastR = right[count - 1];
+            }
+            return n;
+        }
+    };
+    return converter;
+};
+
+// returns null when AudioWorklet is not supported, the caller keeps the AudioBuffer path
+export const createAudioRing = async function(audioContext, latencyFrames) {
+    if(!audioContext.audioWorklet) return null;
+    const url = URL.createObjectURL(new Blob([PROCESSOR_SOURCE], { type: 'application/javascript' }));
+    try {
+        await audioContext.audioWorklet.addModule(url);
+    } catch(e) {
+        console.warn('AudioWorklet unavailable: ' + e);
+        return null;
+    } finally {
+        URL.revokeObjectURL(url);
+    }
+
+    const node = new AudioWorkletNode(audioContext, 'chaos-audio', { outputChannelCount: [2] });
+    node.connect(audioContext.destination);
+    node.port.postMessage({ latency: latencyFrames });
+
+    const shared = typeof SharedArrayBuffer !== 'undefined' && self.crossOriginIsolated;
+    if(shared) {
+        const ring = new SharedArrayBuffer(HEADER_BYTES + RING_FRAMES * 8);
+        node.port.postMessage({ ring: ring });
+        const push = createRingWriter(ring);
+        return { shared: true, ring: ring, push: push, underruns: push.underruns, effects: push.effects, stretch: push.stretch };
+    }
+
+    let underruns = 0;
+    const levels = new Float32Array(EFFECT_LEVELS);
+    node.port.onmessage = function(e) {
+        if(e.data.underrun) underruns++;
+    };
+    return {
+        shared: false,
+        ring: null,
+        // times the output ran dry so far
+        underruns: function() {
+            return underruns;
+        },
+        // append 'count' frames from planar left/right buffers
+        push: function(left, right, count) {
+            const samples = new Float32Array(count * 2);
+            for(let i = 0; i < count; i++) {
+                samples[i * 2] = left[i];
+                samples[i * 2 + 1] = right[i];
+            }
+            node.port.postMessage({ samples: samples }, [samples.buffer]);
+        },
+        // output effect levels (EFFECT_LEVELS floats), posted when they change
+        effects: function(next) {
+            if(next.every((level, i) => level === levels[i])) return;
+            levels.set(next);
+            node.port.postMessage({ effects: levels.slice() });
+        },
+        // pitch-correct playback speed (0 or 1: off)
+        stretch: function(speed) {
+            node.port.postMessage({ stretch: speed });
+        }
+    };
+};
+
+// producer side of a shared ring, usable from any thread (see worker.js)
+export const AUDIO_EFFECT_LEVELS = EFFECT_LEVELS;
+
+export const createRingWriter = function(ring) {
+    const header = new Int32Array(ring, 0, 3);
+    const levels = new Float32Array(ring, 12, EFFECT_LEVELS);
+    const speed = new Float32Array(ring, 24, 1);
+    const data = new Float32Array(ring, HEADER_BYTES, RING_FRAMES * 2);
+    const push = function(left, right, count) {
+        let w = Atomics.load(header, 0);
+        const r = Atomics.load(header, 1);
+        // ring full: drop the block rather than overwrite unread samples or the history
+        if(((w - r) | 0) + count > RING_FRAMES - HISTORY_FRAMES) return;
+        for(let i = 0; i < count; i++, w++) {
+            const p = (w & (RING_FRAMES - 1)) * 2;
+            data[p] = left[i];
+            data[p + 1] = right[i];
+        }
+        Atomics.store(header, 0, w);
+    };
+    // frames written but not yet played
+    push.fill = function() {
+        return (Atomics.load(header, 0) - Atomics.load(header, 1)) | 0;
+    };
+    // frames consumed by the worklet so far
+    push.played = function() {
+        return Atomics.load(header, 1);
+    };
+    // times the worklet ran dry so far
+    push.underruns = function() {
+        return Atomics.load(header, 2);
+    };
+    // output effect levels (EFFECT_LEVELS floats), read by the worklet every block
+    push.effects = function(next) {
+        levels.set(next);
+    };
+    // pitch-correct playback speed (0 or 1: off)
+    push.stretch = function(next) {
+        speed[0] = next;
+    };
+    return push;
+};
@@ -0,0 +1,122 @@
+// Battery saves (see backup.h): SRAM and EEPROM contents survive a reload. The core marks the
+// 256-byte blocks the game writes; after each run of frames the marked blocks are copied out and
+// kept here, and written to IndexedDB once the game has left them alone for FLUSH_DELAY ms (at
+// most FLUSH_MAX ms after the first change), in one transaction, keyed by ROM CRC and block.
+// Blocks are copied when taken, so a reset or another game afterwards does not change what is
+// written. Usable from the page and from worker.js.
+
+const DB_NAME = 'chaosdrive-backup';
+const DB_STORE = 'blocks';
+const BLOCK = 256;
+const BLOCKS = 256;
+const FLUSH_DELAY = 1000;
+const FLUSH_MAX = 5000;
+
+let db = null;
+
+const openDb = function() {
+    if(!db) {
+        db = new Promise(function(resolve, reject) {
+            const request = indexedDB.open(DB_NAME, 1);
+            request.onupgradeneeded = () => request.result.createObjectStore(DB_STORE);
+            request.onsuccess = () => resolve(request.result);
+            request.onerror = () => reject(request.error);
+        });
+    }
+    return db;
+};
+
+const romKey = crc => (crc >>> 0).toString(16).padStart(8, '0');
+const blockKey = (crc, block) => romKey(crc) + '/' + block.toString(16).padStart(2, '0');
+
+// resolves to the stored blocks of a ROM: [block, Uint8Array] pairs
+const readBlocks = function(crc) {
+    return openDb().then(db => new Promise(function(resolve, reject) {
+        const blocks = [];
+        const range = IDBKeyRange.bound(romKey(crc) + '/', romKey(crc) + '/~');
+        const request = db.transaction(DB_STORE, 'readonly').objectStore(DB_STORE).openCursor(range);
+        request.onsuccess = function() {
+            const cursor = request.result;
+            if(!cursor) {
+                resolve(blocks);
+                return;
+            }
+            blocks.push([parseInt(cursor.key.split('/')[1], 16), new Uint8Array(cursor.value)]);
+            cursor.continue();
+        };
+        request.onerror = () => reject(request.error);
+    }));
+};
+
+const writeBlocks = function(crc, blocks) {
+    return openDb().then(db => new Promise(function(resolve, reject) {
+        const transaction = db.transaction(DB_STORE, 'readwrite');
+        const store = transaction.objectStore(DB_STORE);
+        blocks.forEach((bytes, block) => store.put(bytes.buffer, blockKey(crc, block)));
+        transaction.oncomplete = () => resolve(blocks.size);
+        transaction.onerror = () => reject(transaction.error);
+    }));
+};
+
+// the backup memory of the game just started in 'gens': 'ready' resolves once the saved blocks
+// are back in the core (run no frame before), then call frames() after each run of frames
+export const openBackup = function(gens) {
+    const crc = gens._get_rom_crc();
+    // block -> bytes, waiting for the flush
+    let pending = new Map();
+    let timer = 0;
+    let firstChange = 0;
+    let closed = false;
+
+    const flush = function() {
+        clearTimeout(timer);
+        timer = 0;
+        if(!pending.size) return Promise.resolve(0);
+        const blocks = pending;
+        pending = new Map();
+        return writeBlocks(crc, blocks).catch(error => console.warn('backup: ' + error.message));
+    };
+
+    const ready = gens._backup_size() ? readBlocks(crc).then(function(blocks) {
+        // another game or reset meanwhile
+        if(closed) return 0;
+        const data = gens._backup_data();
+        blocks.forEach(([block, bytes]) => {
+            if(block < BLOCKS && bytes.length === BLOCK) gens.HEAPU8.set(bytes, data + block * BLOCK);
+        });
+        gens._backup_attach();
+        return blocks.length;
+    }, function(error) {
+        console.warn('backup: ' + error.message);
+        if(!closed) gens._backup_attach();
+        return 0;
+    }) : Promise.resolve(0);
+
+    return {
+        ready: ready,
+        frames: function() {
+            const ptr = gens._backup_take();
+            if(!ptr) return;
+            const marks = new Uint32Array(gens.HEAPU8.buffer, ptr, BLOCKS / 32);
+            const data = gens._backup_data();
+            for(let block = 0; block < BLOCKS; block++) {
+                if(marks[block >> 5] & (1 << (block & 31))) {
+                    pending.set(block, gens.HEAPU8.slice(data + block * BLOCK, data + (block + 1) * BLOCK));
+                }
+            }
+            // debounced, but not past FLUSH_MAX for a game writing all the time
+            const now = performance.now();
+            if(!timer) firstChange = now;
+            clearTimeout(timer);
+            timer = setTimeout(flush, Math.max(0, Math.min(FLUSH_DELAY, firstChange + FLUSH_MAX - now)));
+        },
+        // write what is pending now (page hidden)
+        flush: flush,
+        // before another game or a reset: what is pending is written, the stored blocks are
+        // read again by the next openBackup()
+        close: function() {
+            closed = true;
+            return flush();
+        }
+    };
+};
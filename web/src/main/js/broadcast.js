@@ -0,0 +1,187 @@
+// Spectator streaming of a chaos session (see chaos_record.h). Instead of video, the broadcaster
+// sends its session recording as it grows: the ROM CRC, chaos seed and idle mode of the reset it
+// started from, then the pad changes, chaos commands and calls of each frame, a few bytes per
+// second when nothing happens. Viewers replay it in their own core, which draws and plays the
+// session by itself; every CHAOS_RECORD_HASH_FRAMES frames the stream carries a hash of the
+// broadcaster's state, a viewer whose state differs reports the frame (onDesync).
+//
+// The transport is any object with send(data) and 'message' events: a BroadcastChannel (tabs of
+// this origin) or a WebSocket to a relay forwarding each message to every other client (see
+// openTransport(); no relay is shipped). A viewer joining late gets the stream from the start and
+// runs the frames it missed without drawing, a few thousand per second, before it plays along.
+//
+// Messages: strings are JSON control messages ('join' from a viewer, 'end' from the broadcaster),
+// binary ones a piece of the stream: uint32 offset of the piece in the stream, uint32 frames the
+// stream has up to its end, then the bytes. A viewer ignores a piece that does not follow what it
+// has (it joined later, or asked for the start again).
+
+const CHAOS_RECORD_ACTIVE = 1;
+const CHAOS_RECORD_REPLAY = 2;
+// frames between two pieces sent by the broadcaster
+const TAKE_FRAMES = 6;
+// frames a viewer keeps ahead before it plays again after running out (network jitter)
+const BUFFER_FRAMES = 12;
+// a viewer further behind than this catches up without drawing, at most CATCH_UP_FRAMES per call
+const BEHIND_FRAMES = 60;
+const CATCH_UP_FRAMES = 240;
+
+const piece = function(offset, frames, bytes) {
+    const message = new Uint8Array(8 + bytes.length);
+    const view = new DataView(message.buffer);
+    view.setUint32(0, offset, true);
+    view.setUint32(4, frames, true);
+    message.set(bytes, 8);
+    return message.buffer;
+};
+
+// a BroadcastChannel for a name, a WebSocket for a ws:// or wss:// address (sends wait for the
+// connection)
+export const openTransport = function(address) {
+    if(!/^wss?:\/\//.test(address)) return new BroadcastChannel(address);
+    const socket = new WebSocket(address);
+    const queue = [];
+    socket.binaryType = 'arraybuffer';
+    socket.addEventListener('open', () => queue.splice(0).forEach(data => socket.send(data)));
+    return {
+        send: data => socket.readyState === WebSocket.OPEN ? socket.send(data) : queue.push(data),
+        addEventListener: (type, listener) => socket.addEventListener(type, listener),
+        close: () => socket.close()
+    };
+};
+
+// restarts the game with 'seed' and broadcasts the session on 'channel' until stop(), a reset or
+// a state load; call frames() after running frames
+export const startBroadcast = function(gens, channel, seed) {
+    const pieces = [];
+    let size = 0;
+    let frames = 0;
+    let live = true;
+
+    const take = function() {
+        const count = gens._chaos_record_take();
+        if(!count) return;
+        const ptr = gens._chaos_record_chunk();
+        const bytes = gens.HEAPU8.slice(ptr, ptr + count);
+        frames = gens._chaos_record_frame();
+        channel.send(piece(size, frames, bytes));
+        pieces.push(bytes);
+        size += count;
+    };
+
+    const end = function() {
+        if(!live) return;
+        live = false;
+        // the end tag of the stopped recording
+        take();
+        channel.send(JSON.stringify({ type: 'end' }));
+    };
+
+    const listener = function(e) {
+        if(typeof e.data !== 'string' || !live) return;
+        if(JSON.parse(e.data).type === 'join') {
+            const stream = new Uint8Array(size);
+            let offset = 0;
+            pieces.forEach(bytes => {
+                stream.set(bytes, offset);
+                offset += bytes.length;
+            });
+            channel.send(piece(0, frames, stream));
+        }
+    };
+
+    gens._record_start(seed >>> 0);
+    channel.addEventListener('message', listener);
+    take();
+
+    return {
+        live: () => live,
+        frames: function() {
+            if(!live) return;
+            if(gens._chaos_record_mode() !== CHAOS_RECORD_ACTIVE) end();
+            else if(gens._chaos_record_frame() - frames >= TAKE_FRAMES) take();
+        },
+        stats: () => ({ frame: gens._chaos_record_frame(), bytes: size }),
+        stop: function() {
+            if(live) gens._chaos_record_stop();
+            end();
+        }
+    };
+};
+
+// watches the broadcast on 'channel'; the game restarts when the stream arrives. 'events':
+// onStart(), onEnd(reason) and onDesync(frame), all optional
+export const watchBroadcast = function(gens, channel, events) {
+    let received = 0;
+    let available = 0;
+    let started = false;
+    let buffering = true;
+    let watching = true;
+    let desync = -1;
+
+    const end = function(reason) {
+        if(!watching) return;
+        watching = false;
+        gens._chaos_replay_live(0);
+        if(events.onEnd) events.onEnd(reason);
+    };
+
+    channel.addEventListener('message', function(e) {
+        if(!watching) return;
+        if(typeof e.data === 'string') {
+            // the end tag came with the last piece, the replay stops there
+            if(JSON.parse(e.data).type === 'end') gens._chaos_replay_live(0);
+            return;
+        }
+        const view = new DataView(e.data);
+        const offset = view.getUint32(0, true);
+        const bytes = new Uint8Array(e.data, 8);
+        if(offset !== received || (!started && offset)) return;
+        if(!started) {
+            const ptr = gens._chaos_replay_buffer(bytes.length);
+            if(!ptr) return;
+            gens.HEAPU8.set(bytes, ptr);
+            if(!gens._replay_start()) {
+                end('the broadcast runs another ROM');
+                return;
+            }
+            gens._chaos_replay_live(1);
+            started = true;
+            if(events.onStart) events.onStart();
+        } else {
+            const ptr = gens._chaos_replay_append(bytes.length);
+            if(!ptr) return;
+            gens.HEAPU8.set(bytes, ptr);
+        }
+        received = offset + bytes.length;
+        available = view.getUint32(4, true);
+    });
+    channel.send(JSON.stringify({ type: 'join' }));
+
+    return {
+        watching: () => watching,
+        // before running 'frames' frames: returns the frames that may run now, the ones the
+        // stream has (0 while it is buffering)
+        frames: function(frames) {
+            if(!watching) return frames;
+            if(!started) return 0;
+            if(gens._chaos_record_mode() !== CHAOS_RECORD_REPLAY) {
+                end('broadcast over');
+                return frames;
+            }
+            if(desync < 0 && (desync = gens._chaos_replay_desync()) >= 0 && events.onDesync) events.onDesync(desync);
+            let current = gens._chaos_record_frame();
+            if(available - current > BEHIND_FRAMES) {
+                current = gens._replay_seek(Math.min(current + CATCH_UP_FRAMES, available - BUFFER_FRAMES));
+            }
+            if(current >= available) buffering = true;
+            if(buffering && available - current < BUFFER_FRAMES) return 0;
+            buffering = false;
+            return Math.min(frames, available - current);
+        },
+        stats: () => ({ frame: gens._chaos_record_frame(), available: available, bytes: received, desync: desync }),
+        close: function() {
+            if(watching && started) gens._chaos_record_stop();
+            end('closed');
+        }
+    };
+};
@@ -0,0 +1,77 @@
+// Session capture (see capture.h). The core fills a ring of chunks per stream in WASM memory:
+// uint32 head, uint32 tail, uint32 dropped, uint32 length[chunks], then the chunk data.
+// Sealed chunks are copied out after every frame run and appended to a Blob, so a long
+// capture never sits in the WASM heap. The file header is only known once the capture is
+// stopped and goes in front of the data.
+
+export const CAPTURE_VGM = 1;
+export const CAPTURE_WAV = 2;
+
+export const CAPTURE_TYPES = {
+    [CAPTURE_VGM]: { extension: 'vgm', mime: 'audio/x-vgm' },
+    [CAPTURE_WAV]: { extension: 'wav', mime: 'audio/wav' },
+};
+
+// ?capture=vgm|wav|both -> stream mask
+export const captureStreams = function(param) {
+    if(param === 'wav') return CAPTURE_WAV;
+    if(param === 'both') return CAPTURE_VGM | CAPTURE_WAV;
+    return CAPTURE_VGM;
+};
+
+// copy the sealed chunks of a stream out of the core and release them: array of ArrayBuffers
+export const drainCapture = function(gens, stream) {
+    const base = gens._capture_ring(stream);
+    const chunks = gens._capture_chunk_count();
+    const chunkSize = gens._capture_chunk_size();
+    const heap = gens.HEAPU8.buffer;
+    const ring = new Uint32Array(heap, base, 3 + chunks);
+    const parts = [];
+    const head = Atomics.load(ring, 0);
+    let tail = ring[1];
+    for(; tail !== head; tail = (tail + 1) >>> 0) {
+        const chunk = tail & (chunks - 1);
+        const data = base + (3 + chunks) * 4 + chunk * chunkSize;
+        // slice() copies into a plain ArrayBuffer, also when the heap is shared
+        parts.push(new Uint8Array(heap, data, ring[3 + chunk]).slice().buffer);
+    }
+    Atomics.store(ring, 1, tail);
+    return parts;
+};
+
+// header of a stopped stream, and the bytes dropped while the ring was full
+export const finishCapture = function(gens, stream) {
+    const ptr = gens._capture_header(stream);
+    const heap = gens.HEAPU8.buffer;
+    return {
+        header: new Uint8Array(heap, ptr, gens._capture_header_size(stream)).slice().buffer,
+        dropped: new Uint32Array(heap, gens._capture_ring(stream), 3)[2],
+    };
+};
+
+// drained chunks of one stream; folded into a Blob every few MB so the browser can move them
+// out of the JS heap
+export const createCaptureFile = function(stream) {
+    const type = CAPTURE_TYPES[stream];
+    let body = new Blob([]);
+    let pending = [];
+    let pendingBytes = 0;
+    return {
+        append: function(parts) {
+            for(const part of parts) {
+                pending.push(part);
+                pendingBytes += part.byteLength;
+            }
+            if(pendingBytes >= (4 << 20)) {
+                body = new Blob([body].concat(pending));
+                pending = [];
+                pendingBytes = 0;
+            }
+        },
+        finish: function(end) {
+            if(end.dropped) console.warn('capture: ' + end.dropped + ' bytes dropped (' + type.extension + ')');
+            return new Blob([end.header, body].concat(pending), { type: type.mime });
+        },
+        extension: type.extension,
+    };
+};
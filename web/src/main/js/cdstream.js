@@ -0,0 +1,93 @@
+// Mega CD discs (see cdstream.h), main thread mode: the files picked with the disc (cue sheet,
+// tracks, CD BIOS) are registered with the full core by name and size and stay on disk. The
+// core asks for 32KB blocks as the drive gets near them, read here with Blob.slice() and
+// written into its cache between two frames, so a whole disc never has to be in memory.
+
+const BLOCK = 0x8000;
+const NAME_BYTES = 256;
+// load_bios() file names (osd.h); a single picked file with "bios" in its name stands in for
+// the missing ones
+const BIOS_NAMES = ['bios_CD_U.bin', 'bios_CD_E.bin', 'bios_CD_J.bin'];
+// start() passes while its synchronous reads still miss (cue sheet, then the tracks it names,
+// then the BIOS...)
+const BOOT_TRIES = 16;
+
+// the file to mount among the picked ones: the cue sheet, else an .iso; null for a cartridge
+export const discImage = function(files) {
+    return files.find(f => /\.cue$/i.test(f.name)) || files.find(f => /\.iso$/i.test(f.name)) || null;
+};
+
+export const openDisc = function(gens, files) {
+    const image = discImage(files);
+    // file id (cd_stream_add()) -> File
+    const registered = [];
+    // bumped by close(): blocks read for the previous disc are dropped
+    let generation = 0;
+
+    const writeName = function(name) {
+        const bytes = new TextEncoder().encode(name).subarray(0, NAME_BYTES - 1);
+        const ptr = gens._cd_stream_name();
+        gens.HEAPU8.set(bytes, ptr);
+        gens.HEAPU8[ptr + bytes.length] = 0;
+    };
+    const add = function(name, file) {
+        writeName(name);
+        if(gens._cd_stream_add(file.size) >= 0) registered.push(file);
+    };
+
+    gens._cd_stream_clear();
+    files.forEach(f => add(f.name, f));
+    const bios = files.filter(f => /bios/i.test(f.name));
+    if(bios.length === 1) {
+        const names = files.map(f => f.name.toLowerCase());
+        BIOS_NAMES.filter(n => !names.includes(n.toLowerCase())).forEach(n => add(n, bios[0]));
+    }
+    writeName(image.name);
+    gens._cd_stream_mount();
+
+    // read the blocks the core asked for; resolves once they are in
+    const serve = function() {
+        const count = gens._cd_stream_take_requests();
+        if(!count) return Promise.resolve();
+        const requests = new Int32Array(gens.HEAPU8.buffer, gens._cd_stream_requests(), count * 3).slice();
+        const current = generation;
+        const loads = [];
+        for(let i = 0; i < count; i++) {
+            const slot = requests[i * 3];
+            const block = requests[i * 3 + 2];
+            const file = registered[requests[i * 3 + 1]];
+            loads.push(file.slice(block * BLOCK, (block + 1) * BLOCK).arrayBuffer().then(function(data) {
+                if(current !== generation) return;
+                // HEAPU8 can be replaced by memory growth while the block is read
+                gens.HEAPU8.set(new Uint8Array(data), gens._cd_stream_block(slot));
+                gens._cd_stream_loaded(slot);
+            }));
+        }
+        return Promise.all(loads);
+    };
+
+    return {
+        name: image.name,
+        // run start() until it no longer misses a block; false when the disc does not load
+        boot: async function() {
+            for(let i = 0; i < BOOT_TRIES; i++) {
+                gens._start();
+                const loads = serve();
+                if(!gens._cd_stream_misses()) return gens._cd_stream_booted() !== 0;
+                await loads;
+            }
+            return false;
+        },
+        // before every run of frames: false while the drive is about to read a block still
+        // being read here (the frames wait)
+        ready: function() {
+            const ready = gens._cd_stream_ready();
+            serve();
+            return ready !== 0;
+        },
+        close: function() {
+            generation++;
+            gens._cd_stream_clear();
+        },
+    };
+};
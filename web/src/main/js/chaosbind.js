@@ -0,0 +1,48 @@
+// Chaos key bindings as a table for the core (see chaos_bind.h): 8-byte entries
+// { uint8 slot, uint8 effect, uint8 mode, uint8 repeat, float32 intensity }, uploaded once.
+// Each distinct key or gamepad button code gets a slot, its bit in the input block's chaos
+// key words (input.js writeChaosKeys()); the core fires the effects itself, once per frame.
+
+export const CHAOS_BIND_MAX = 64;
+
+export const CHAOS_BIND_PRESS = 0;
+export const CHAOS_BIND_HOLD = 1;
+export const CHAOS_BIND_TOGGLE = 2;
+
+// frames between two repeats of a held binding, unless it sets its own 'repeat'
+export const CHAOS_BIND_REPEAT = 3;
+
+const MODES = { press: CHAOS_BIND_PRESS, hold: CHAOS_BIND_HOLD, toggle: CHAOS_BIND_TOGGLE };
+
+// bindings: { code, id, mode ('press', 'hold' or 'toggle'), repeat, intensity } with a
+// registry id -> { bytes, slots: code -> slot, bindings: those in the table, in table order
+// (chaos_bind_take_fired() indexes) }; bindings past CHAOS_BIND_MAX (or past
+// CHAOS_BIND_MAX distinct codes) are left out
+export const encodeChaosBindings = function(bindings) {
+    const slots = new Map();
+    const entries = [];
+    for(const binding of bindings) {
+        if(entries.length === CHAOS_BIND_MAX) break;
+        if(!slots.has(binding.code)) {
+            if(slots.size === CHAOS_BIND_MAX) continue;
+            slots.set(binding.code, slots.size);
+        }
+        entries.push(binding);
+    }
+    const bytes = new ArrayBuffer(entries.length * 8);
+    const view = new DataView(bytes);
+    entries.forEach((binding, i) => {
+        view.setUint8(i * 8, slots.get(binding.code));
+        view.setUint8(i * 8 + 1, binding.id);
+        view.setUint8(i * 8 + 2, MODES[binding.mode] || CHAOS_BIND_PRESS);
+        view.setUint8(i * 8 + 3, binding.mode === 'hold' ? (binding.repeat === undefined ? CHAOS_BIND_REPEAT : binding.repeat) : 0);
+        view.setFloat32(i * 8 + 4, binding.intensity === undefined ? 1 : binding.intensity, true);
+    });
+    return { bytes: bytes, slots: slots, bindings: entries };
+};
+
+// copy the table into the core; returns the number of bindings it took
+export const uploadChaosBindings = function(gens, bytes) {
+    gens.HEAPU8.set(new Uint8Array(bytes), gens._chaos_bind_table());
+    return gens._chaos_bind_commit(bytes.byteLength / 8);
+};
@@ -0,0 +1,145 @@
+// Live controllers for chaos (chaosMidi() / chaosAxis() on the console, main thread mode): MIDI
+// notes and controllers (WebMIDI) and gamepad axes mapped to chaos effects and parameters, for
+// playing the glitches like an instrument. An event goes straight into the core's command ring
+// as one 8-byte record (chaosqueue.js createChaosWriter()): no call into the core, and nothing
+// allocated on the way, the mappings being looked up in typed arrays filled beforehand. The core
+// takes the records at the start of its next frame.
+//
+// A mapping on an effect fires it at an intensity scaled by the note velocity or controller
+// value, at the effect's own sync point, or with 'line' at the line of the next frame matching
+// the point of the frame interval the event came in (event timestamps against the start of the
+// last run of frames, which the audio output clocks in ?latency=low): one frame late, but the
+// timing within the frame is kept. A mapping on a parameter (CHAOS_OP_PARAM) sets its base at
+// the next frame start. Gamepad axes have no events and are read on every animation frame.
+
+import { CHAOS_SYNC_LINE, CHAOS_OP_PARAM } from './chaosqueue.js';
+
+export const CONTROL_MAX = 128;
+
+const MIDI_NOTE = 0;
+const MIDI_CC = 1;
+// (kind, channel, number) keys, then the axes of the first gamepad
+const MIDI_KEYS = 2 * 16 * 128;
+export const AXIS_MAX = 16;
+// smaller axis moves are noise
+const AXIS_STEP = 1 / 256;
+
+// write(op, sync, intensity, line) appends a command (createChaosWriter()), or is null while the
+// commands cannot go to the local core; 'lines' returns the active display lines
+export const createChaosControls = function(target, lines) {
+    // key -> mapping, -1: none
+    const keys = new Int16Array(MIDI_KEYS + AXIS_MAX).fill(-1);
+    const ops = new Uint8Array(CONTROL_MAX);
+    const params = new Uint16Array(CONTROL_MAX);
+    const syncs = new Uint8Array(CONTROL_MAX);
+    const lineSynced = new Uint8Array(CONTROL_MAX);
+    const low = new Float32Array(CONTROL_MAX);
+    const high = new Float32Array(CONTROL_MAX);
+    const axisLast = new Float32Array(AXIS_MAX).fill(NaN);
+    let count = 0;
+    let frameStart = 0;
+    let frameTime = 0;
+    let access = null;
+
+    // line of the next frame at the point of the frame interval 'time' falls on, -1 when the
+    // interval is over (the next frame start is sooner)
+    const lineAt = function(time) {
+        if(!frameTime) return -1;
+        const position = (time - frameStart) / frameTime;
+        if(position >= 1) return -1;
+        return position <= 0 ? 0 : Math.floor(position * lines());
+    };
+
+    // 'value' 0..1
+    const fire = function(i, value, time) {
+        const write = target();
+        if(!write) return;
+        const intensity = low[i] + (high[i] - low[i]) * value;
+        if(ops[i] === CHAOS_OP_PARAM) {
+            write(CHAOS_OP_PARAM, 0, intensity, params[i]);
+            return;
+        }
+        // a note off or a controller down to 0 does not fire
+        if(!value) return;
+        const line = lineSynced[i] ? lineAt(time) : -1;
+        if(line >= 0) write(ops[i], CHAOS_SYNC_LINE, intensity, line);
+        else write(ops[i], syncs[i], intensity, 0);
+    };
+
+    const onMidi = function(e) {
+        const data = e.data;
+        const status = data[0] & 0xf0;
+        let kind;
+        if(status === 0x90 && data[2]) kind = MIDI_NOTE;
+        else if(status === 0xb0) kind = MIDI_CC;
+        else return;
+        const i = keys[(kind << 11) | ((data[0] & 0x0f) << 7) | data[1]];
+        if(i >= 0) fire(i, data[2] / 127, e.timeStamp);
+    };
+
+    const listen = function() {
+        access.inputs.forEach(input => { input.onmidimessage = onMidi; });
+    };
+
+    const controls = {
+        // map a note ('note') or controller ('cc') number, on 'channel' (0-15) or all of them, or
+        // gamepad axis 'number' ('axis'), to effect id 'op' with its 'sync', or to parameter
+        // 'param' (op CHAOS_OP_PARAM); the value goes to [range[0], range[1]]; 'line': line
+        // timing for effects. Returns false once CONTROL_MAX mappings are taken
+        map: function(kind, number, channel, op, param, sync, range, line) {
+            if(count === CONTROL_MAX) return false;
+            const i = count++;
+            ops[i] = op;
+            params[i] = param;
+            syncs[i] = sync;
+            lineSynced[i] = line ? 1 : 0;
+            low[i] = range[0];
+            high[i] = range[1];
+            if(kind === 'axis') {
+                keys[MIDI_KEYS + number] = i;
+                axisLast[number] = NaN;
+                return true;
+            }
+            const midi = kind === 'cc' ? MIDI_CC : MIDI_NOTE;
+            for(let c = 0; c < 16; c++) {
+                if(channel === undefined || c === channel) keys[(midi << 11) | (c << 7) | number] = i;
+            }
+            return true;
+        },
+        clear: function() {
+            keys.fill(-1);
+            count = 0;
+        },
+        // the MIDI inputs, those plugged in later included; resolves to false without WebMIDI
+        // or permission
+        midi: async function() {
+            if(access) return true;
+            if(!navigator.requestMIDIAccess) return false;
+            try {
+                access = await navigator.requestMIDIAccess();
+            } catch(e) {
+                return false;
+            }
+            access.onstatechange = listen;
+            listen();
+            return true;
+        },
+        // on every animation frame: axes of 'gamepad' (null when none)
+        poll: function(gamepad) {
+            if(!gamepad) return;
+            const axes = gamepad.axes;
+            for(let a = 0; a < axes.length && a < AXIS_MAX; a++) {
+                const i = keys[MIDI_KEYS + a];
+                if(i < 0 || Math.abs(axes[a] - axisLast[a]) < AXIS_STEP) continue;
+                axisLast[a] = axes[a];
+                fire(i, (axes[a] + 1) / 2, gamepad.timestamp);
+            }
+        },
+        // before a run of frames, 'time' (performance.now()) and the time of a frame
+        frame: function(time, interval) {
+            frameStart = time;
+            frameTime = interval;
+        }
+    };
+    return controls;
+};
@@ -0,0 +1,59 @@
+// Chaos command queue records (see chaos_queue.h): uint32 head, uint32 tail,
+// then 8-byte commands { uint8 op, uint8 sync, uint16 line, float32 intensity }.
+// head/tail go through Atomics so the same code works on a SharedArrayBuffer.
+// op CHAOS_OP_PARAM sets the base of parameter 'line' (chaos_mod.h) to 'intensity'.
+
+export const CHAOS_QUEUE_SIZE = 256;
+export const CHAOS_QUEUE_BYTES = 8 + CHAOS_QUEUE_SIZE * 8;
+
+export const CHAOS_SYNC_LINE = 2;
+export const CHAOS_OP_PARAM = 0xFE;
+
+// append a command to the queue at 'base' in 'buffer' ('line': CHAOS_SYNC_LINE and CHAOS_OP_PARAM)
+export const writeChaosCommand = function(buffer, base, size, op, sync, intensity, line) {
+    const header = new Int32Array(buffer, base, 2);
+    const view = new DataView(buffer);
+    const head = Atomics.load(header, 0);
+    const cmd = base + 8 + (head & (size - 1)) * 8;
+    view.setUint8(cmd, op);
+    view.setUint8(cmd + 1, sync);
+    view.setUint16(cmd + 2, line || 0, true);
+    view.setFloat32(cmd + 4, intensity, true);
+    Atomics.store(header, 0, head + 1);
+};
+
+// writeChaosCommand() for event handlers that must not allocate: the views are kept and only
+// taken again when the buffer returned by 'source' changes (memory growth)
+export const createChaosWriter = function(source, base, size) {
+    let buffer = null;
+    let header = null;
+    let view = null;
+    return function(op, sync, intensity, line) {
+        if(source() !== buffer) {
+            buffer = source();
+            header = new Int32Array(buffer, base, 2);
+            view = new DataView(buffer);
+        }
+        const head = Atomics.load(header, 0);
+        const cmd = base + 8 + (head & (size - 1)) * 8;
+        view.setUint8(cmd, op);
+        view.setUint8(cmd + 1, sync);
+        view.setUint16(cmd + 2, line, true);
+        view.setFloat32(cmd + 4, intensity, true);
+        Atomics.store(header, 0, head + 1);
+    };
+};
+
+// move pending commands from a shared queue (main thread) into the core's queue
+export const moveChaosCommands = function(shared, buffer, base, size) {
+    const header = new Int32Array(shared, 0, 2);
+    const view = new DataView(shared);
+    const head = Atomics.load(header, 0);
+    let tail = Atomics.load(header, 1);
+    for(; tail !== head; tail = (tail + 1) | 0) {
+        const cmd = 8 + (tail & (CHAOS_QUEUE_SIZE - 1)) * 8;
+        writeChaosCommand(buffer, base, size, view.getUint8(cmd), view.getUint8(cmd + 1), view.getFloat32(cmd + 4, true),
+            view.getUint16(cmd + 2, true));
+    }
+    Atomics.store(header, 1, tail);
+};
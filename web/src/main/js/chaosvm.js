@@ -0,0 +1,96 @@
+// Assembler for the core's user effect programs (see chaos_vm.h): one instruction per line,
+// 'op operand, ...', registers r0-r15, memories vram/cram/vsram/ram/zram/vdp, numbers in
+// decimal or 0x hex, ';' comments. Branches take a label ('name:' on its own line or before an
+// instruction) further down; r0 holds the intensity (0-256), r1 the frame and r2 the line.
+//
+//   ldi r3, 0x100
+//   ldi r5, 0xff
+//   xorr r3, r3, vram, r5   ; invert VRAM 0x100-0x1ff
+
+export const CHAOS_VM_PROGRAMS = 16;
+export const CHAOS_VM_CODE_MAX = 256;
+
+const OPS = ['halt', 'ldi', 'ldih', 'mov', 'add', 'sub', 'and', 'or', 'xor', 'shl', 'shr', 'mul', 'addi',
+    'rand', 'ld', 'st', 'xorr', 'shiftr', 'rotr', 'nibr', 'fillr', 'randr', 'fmw', 'beq', 'bne', 'blt',
+    'jmp', 'rep', 'end'];
+
+const MEMS = { vram: 0, cram: 1, vsram: 2, ram: 3, zram: 4, vdp: 5 };
+
+// operand kinds per op: r register, m memory, i8/i16 immediate, l label
+const FORMS = {
+    halt: '', ldi: 'r i16', ldih: 'r i16', mov: 'r r', addi: 'r r i8', rand: 'r r',
+    ld: 'r m r', st: 'r m r', fmw: 'r r i8', jmp: 'l', rep: 'r', end: ''
+};
+for(const op of ['add', 'sub', 'and', 'or', 'xor', 'shl', 'shr', 'mul']) FORMS[op] = 'r r r';
+for(const op of ['xorr', 'shiftr', 'rotr', 'fillr', 'randr']) FORMS[op] = 'r r m r';
+FORMS.nibr = 'r r m';
+for(const op of ['beq', 'bne', 'blt']) FORMS[op] = 'r r l';
+
+// source -> ArrayBuffer for chaos_vm_buffer() (uint16 count, 4-byte instructions); throws
+// with the line number on a syntax error
+export const assembleChaosProgram = function(source) {
+    const lines = [];
+    const labels = {};
+    source.split('\n').forEach((text, n) => {
+        text = text.replace(/;.*/, '').trim();
+        const label = text.match(/^(\w+):\s*(.*)$/);
+        if(label) {
+            labels[label[1].toLowerCase()] = lines.length;
+            text = label[2];
+        }
+        if(text) lines.push({ text: text, n: n + 1 });
+    });
+    if(lines.length > CHAOS_VM_CODE_MAX) throw new Error('program longer than ' + CHAOS_VM_CODE_MAX + ' instructions');
+
+    const bytes = new ArrayBuffer(2 + lines.length * 4);
+    const view = new DataView(bytes);
+    view.setUint16(0, lines.length, true);
+    lines.forEach((line, pc) => {
+        const fail = message => { throw new Error('line ' + line.n + ': ' + message); };
+        const [name, ...rest] = line.text.toLowerCase().split(/[\s,]+/);
+        const form = FORMS[name];
+        if(form === undefined) fail('unknown op ' + name);
+        const kinds = form ? form.split(' ') : [];
+        if(rest.length !== kinds.length) fail(name + ' takes ' + kinds.length + ' operands');
+
+        const values = kinds.map((kind, i) => {
+            const arg = rest[i];
+            if(kind === 'r') {
+                const reg = arg.match(/^r(\d+)$/);
+                if(!reg || +reg[1] > 15) fail('bad register ' + arg);
+                return +reg[1];
+            }
+            if(kind === 'm') {
+                if(!(arg in MEMS)) fail('bad memory ' + arg);
+                return MEMS[arg];
+            }
+            if(kind === 'l') {
+                if(!(arg in labels) || labels[arg] <= pc) fail('label ' + arg + ' must be further down');
+                return labels[arg] - pc - 1;
+            }
+            const value = Number(arg);
+            if(!Number.isInteger(value)) fail('bad number ' + arg);
+            return value;
+        });
+
+        // operand slots: ranges put the memory and the parameter register in c
+        let a = 0, b = 0, c = 0;
+        if(form === 'r i16') [a, b, c] = [values[0], values[1] & 0xFF, (values[1] >> 8) & 0xFF];
+        else if(form === 'r r m r') [a, b, c] = [values[0], values[1], values[2] | (values[3] << 4)];
+        else if(form === 'l') c = values[0];
+        else [a = 0, b = 0, c = 0] = values;
+        if(c > 0xFF) fail('branch too far');
+        view.setUint8(2 + pc * 4, OPS.indexOf(name));
+        view.setUint8(3 + pc * 4, a);
+        view.setUint8(4 + pc * 4, b);
+        view.setUint8(5 + pc * 4, c & 0xFF);
+    });
+    return bytes;
+};
+
+// copy an assembled program into the core's slot; returns true if the core accepted it,
+// otherwise the index of the instruction it rejected
+export const loadChaosProgram = function(gens, slot, bytes) {
+    gens.HEAPU8.set(new Uint8Array(bytes), gens._chaos_vm_buffer());
+    return gens._chaos_vm_load(slot) ? true : gens._chaos_vm_error();
+};
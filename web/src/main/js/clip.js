@@ -0,0 +1,76 @@
+// Instant replay (see clip.h): the core keeps the last drawn frame as 8-bit pixel indices plus
+// its palette, copied after every run into a ring of the last CLIP_SECONDS here, in JS memory
+// (75KB a frame, allocated as the ring fills). Exporting hands the frames over to clipworker.js
+// (transferred, not copied) and starts the ring again, so neither recording nor encoding holds
+// up the frames.
+
+export const CLIP_SECONDS = 10;
+const CLIP_RATE = 60;
+const INFO_WORDS = 5;
+const PALETTE_SIZE = 256;
+
+export const createClipRing = function(gens) {
+    const size = CLIP_SECONDS * CLIP_RATE;
+    const pitch = gens._clip_pitch();
+    const lines = gens._clip_lines();
+    let slots = [];
+    let next = 0;
+    let lastFrame = -1;
+    gens._clip_enable(1);
+
+    // frame: { x, y, w, h, pitch, pixels: Uint8Array, palette: Uint32Array (0xAARRGGBB) }
+    const latest = function() {
+        return slots.length ? slots[(next + size - 1) % size] : null;
+    };
+
+    return {
+        // copy the last frame, if one was drawn since the previous call
+        record: function() {
+            const heap = gens.HEAPU8.buffer;
+            const info = new Int32Array(heap, gens._clip_info(), INFO_WORDS);
+            if(info[0] === lastFrame) return;
+            lastFrame = info[0];
+            let slot = slots[next];
+            if(!slot) slot = slots[next] = { pixels: new Uint8Array(pitch * lines), palette: new Uint32Array(PALETTE_SIZE), pitch: pitch };
+            slot.pixels.set(new Uint8Array(heap, gens._clip_pixels(), pitch * lines));
+            slot.palette.set(new Uint32Array(heap, gens._clip_info() + INFO_WORDS * 4, PALETTE_SIZE));
+            slot.x = info[1];
+            slot.y = info[2];
+            slot.w = info[3];
+            slot.h = info[4];
+            next = (next + 1) % size;
+        },
+        // the frames recorded, oldest first, and the buffers to transfer with them; the ring
+        // starts again empty
+        take: function() {
+            const frames = slots.slice(next).concat(slots.slice(0, next));
+            slots = [];
+            next = 0;
+            return { frames: frames, buffers: frames.flatMap(f => [f.pixels.buffer, f.palette.buffer]) };
+        },
+        // copy of the last frame (screenshots)
+        latest: function() {
+            const frame = latest();
+            return frame ? Object.assign({}, frame, { pixels: frame.pixels.slice(), palette: frame.palette.slice() }) : null;
+        },
+        close: function() {
+            gens._clip_enable(0);
+            slots = [];
+        },
+    };
+};
+
+// encoder worker: 'gif' ({ frames, fps }) and 'png' ({ frame }) messages, answered with
+// { type, blob }. PNGs are drawn on an OffscreenCanvas, 'png' is null without one
+export const createClipEncoder = function(onBlob) {
+    const worker = new Worker(new URL('./clipworker.js', import.meta.url));
+    worker.onmessage = e => onBlob(e.data.type, e.data.blob);
+    return {
+        gif: function(clip, fps) {
+            worker.postMessage({ type: 'gif', frames: clip.frames, fps: fps }, clip.buffers);
+        },
+        png: typeof OffscreenCanvas === 'undefined' ? null : function(frame) {
+            worker.postMessage({ type: 'png', frame: frame }, [frame.pixels.buffer, frame.palette.buffer]);
+        },
+    };
+};
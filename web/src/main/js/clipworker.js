@@ -0,0 +1,211 @@
+// Instant replay encoder (see clip.js): frames of 8-bit pixel indices + palette in, a looping
+// GIF or a PNG screenshot out. The frames map straight onto GIF images with their palette as
+// local colour table, so nothing is quantized. GIF delays are in 1/100 s and browsers slow
+// down delays under 2, so the GIF keeps every other frame.
+
+const GIF_STEP = 2;
+
+// growable byte output
+const createWriter = function() {
+    let bytes = new Uint8Array(1 << 20);
+    let length = 0;
+    const room = function(n) {
+        if(length + n <= bytes.length) return;
+        const grown = new Uint8Array(Math.max(bytes.length * 2, length + n));
+        grown.set(bytes.subarray(0, length));
+        bytes = grown;
+    };
+    return {
+        byte: function(b) {
+            room(1);
+            bytes[length++] = b;
+        },
+        word: function(w) {
+            room(2);
+            bytes[length++] = w & 0xff;
+            bytes[length++] = w >> 8;
+        },
+        string: function(s) {
+            room(s.length);
+            for(let i = 0; i < s.length; i++) bytes[length++] = s.charCodeAt(i);
+        },
+        result: () => bytes.subarray(0, length),
+    };
+};
+
+// GIF LZW (8-bit codes), hashed string table as in the classic compress / GIF encoders
+const HSIZE = 5003;
+const MAX_CODES = 4096;
+const htab = new Int32Array(HSIZE);
+const codetab = new Int32Array(HSIZE);
+
+const lzw = function(out, pixels, count) {
+    const clearCode = 256;
+    const endCode = 257;
+    let bits = 9;
+    let maxCode = (1 << bits) - 1;
+    let free = endCode + 1;
+    let clearFlag = false;
+    let acc = 0;
+    let accBits = 0;
+    const block = new Uint8Array(255);
+    let blockLength = 0;
+
+    const flushBlock = function() {
+        if(!blockLength) return;
+        out.byte(blockLength);
+        for(let i = 0; i < blockLength; i++) out.byte(block[i]);
+        blockLength = 0;
+    };
+    const emit = function(code) {
+        acc |= code << accBits;
+        accBits += bits;
+        while(accBits >= 8) {
+            block[blockLength++] = acc & 0xff;
+            if(blockLength === 255) flushBlock();
+            acc >>>= 8;
+            accBits -= 8;
+        }
+        if(free > maxCode || clearFlag) {
+            if(clearFlag) {
+                bits = 9;
+                clearFlag = false;
+            } else {
+                bits++;
+            }
+            maxCode = bits === 12 ? MAX_CODES : (1 << bits) - 1;
+        }
+        if(code === endCode) {
+            if(accBits > 0) block[blockLength++] = acc & 0xff;
+            flushBlock();
+        }
+    };
+
+    out.byte(8);
+    htab.fill(-1);
+    emit(clearCode);
+    let ent = pixels[0];
+    for(let i = 1; i < count; i++) {
+        const c = pixels[i];
+        const fcode = (c << 12) + ent;
+        let h = (c << 4) ^ ent;
+        if(htab[h] === fcode) {
+            ent = codetab[h];
+            continue;
+        }
+        if(htab[h] >= 0) {
+            const disp = h === 0 ? 1 : HSIZE - h;
+            let found = false;
+            do {
+                h -= disp;
+                if(h < 0) h += HSIZE;
+                if(htab[h] === fcode) {
+                    found = true;
+                    break;
+                }
+            } while(htab[h] >= 0);
+            if(found) {
+                ent = codetab[h];
+                continue;
+            }
+        }
+        emit(ent);
+        ent = c;
+        if(free < MAX_CODES) {
+            codetab[h] = free++;
+            htab[h] = fcode;
+        } else {
+            htab.fill(-1);
+            free = endCode + 1;
+            clearFlag = true;
+            emit(clearCode);
+        }
+    }
+    emit(ent);
+    emit(endCode);
+    out.byte(0);
+};
+
+// active area of a frame, packed
+const framePixels = function(frame) {
+    const pixels = new Uint8Array(frame.w * frame.h);
+    for(let y = 0; y < frame.h; y++) {
+        const start = (frame.y + y) * frame.pitch + frame.x;
+        pixels.set(frame.pixels.subarray(start, start + frame.w), y * frame.w);
+    }
+    return pixels;
+};
+
+const encodeGif = function(frames, fps) {
+    const out = createWriter();
+    const width = Math.max(...frames.map(f => f.w));
+    const height = Math.max(...frames.map(f => f.h));
+    out.string('GIF89a');
+    out.word(width);
+    out.word(height);
+    out.byte(0);
+    out.byte(0);
+    out.byte(0);
+    // loop forever
+    out.byte(0x21);
+    out.byte(0xff);
+    out.byte(11);
+    out.string('NETSCAPE2.0');
+    out.byte(3);
+    out.byte(1);
+    out.word(0);
+    out.byte(0);
+    let shown = 0;
+    for(let i = 0; i < frames.length; i += GIF_STEP) {
+        const frame = frames[i];
+        // delays rounded on the running time so they add up to the clip length
+        const delay = Math.round((shown + 1) * GIF_STEP * 100 / fps) - Math.round(shown * GIF_STEP * 100 / fps);
+        shown++;
+        out.byte(0x21);
+        out.byte(0xf9);
+        out.byte(4);
+        out.byte(frame.w < width || frame.h < height ? 0x08 : 0x04);
+        out.word(delay);
+        out.byte(0);
+        out.byte(0);
+        out.byte(0x2c);
+        out.word(0);
+        out.word(0);
+        out.word(frame.w);
+        out.word(frame.h);
+        out.byte(0x87);
+        for(let c = 0; c < 256; c++) {
+            const rgb = frame.palette[c];
+            out.byte((rgb >> 16) & 0xff);
+            out.byte((rgb >> 8) & 0xff);
+            out.byte(rgb & 0xff);
+        }
+        lzw(out, framePixels(frame), frame.w * frame.h);
+    }
+    out.byte(0x3b);
+    return new Blob([out.result()], { type: 'image/gif' });
+};
+
+const encodePng = function(frame) {
+    const canvas = new OffscreenCanvas(frame.w, frame.h);
+    const context = canvas.getContext('2d');
+    const image = context.createImageData(frame.w, frame.h);
+    const pixels = framePixels(frame);
+    const rgba = new Uint32Array(image.data.buffer);
+    for(let i = 0; i < pixels.length; i++) {
+        // 0xAARRGGBB -> bytes R, G, B, A
+        const c = frame.palette[pixels[i]];
+        rgba[i] = 0xff000000 | ((c & 0xff) << 16) | (c & 0xff00) | ((c >> 16) & 0xff);
+    }
+    context.putImageData(image, 0, 0);
+    return canvas.convertToBlob({ type: 'image/png' });
+};
+
+self.onmessage = function(e) {
+    const msg = e.data;
+    if(msg.type === 'gif' && msg.frames.length) {
+        self.postMessage({ type: 'gif', blob: encodeGif(msg.frames, msg.fps) });
+    } else if(msg.type === 'png') {
+        encodePng(msg.frame).then(blob => self.postMessage({ type: 'png', blob: blob }));
+    }
+};
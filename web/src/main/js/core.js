@@ -0,0 +1,82 @@
+// Emulator core selection. genplus.js is the -Oz size build; genplus_fast.js is the
+// optional -O3/LTO speed build (emcmake cmake -DCHAOS_BUILD_PROFILE=speed) with a fixed
+// memory size. The speed build is used when it was built and instantiates in this
+// browser (e.g. a SIMD build needs WebAssembly SIMD), otherwise the size build.
+// Both are Mega Drive only: a ROM needing the Mega CD, SVP or Master System / Game Gear
+// hardware (rom_needs_full_core()) runs on the full core instead, genplus_full.js or
+// genplus_fast_full.js (-DCHAOS_FULL_CORE=ON), whose glue is a separate chunk fetched on
+// first use.
+// The .wasm is compiled while it downloads (compileStreaming, needs the application/wasm
+// MIME type) and the compiled module is kept, so the twin and a second loadCore() call
+// only instantiate it again.
+import wasm from './genplus.js';
+import wasmUrl from './genplus.wasm';
+
+// only bundled when present next to genplus.js
+const fastBuild = require.context('./', false, /^\.\/genplus_fast\.(js|wasm)$/);
+const fullWasm = require.context('./', false, /^\.\/genplus(_fast)?_full\.wasm$/);
+const fullGlue = require.context('./', false, /^\.\/genplus(_fast)?_full\.js$/, 'lazy');
+
+// url -> promise of the compiled WebAssembly.Module
+const compiled = {};
+
+const compile = function(url) {
+    if(!compiled[url]) {
+        compiled[url] = fetch(url).then(function(response) {
+            if(!response.ok) throw new Error(url + ': HTTP ' + response.status);
+            const type = response.headers.get('Content-Type') || '';
+            if(WebAssembly.compileStreaming && type.startsWith('application/wasm')) {
+                return WebAssembly.compileStreaming(response);
+            }
+            console.warn(url + ' is served as "' + type + '", not application/wasm: compiling after the download');
+            return response.arrayBuffer().then(bytes => WebAssembly.compile(bytes));
+        });
+        // a failed compile is retried by the next call
+        compiled[url].catch(() => delete compiled[url]);
+    }
+    return compiled[url];
+};
+
+// runs the Emscripten factory on the compiled module instead of letting it fetch the .wasm
+const instantiate = function(factory, url) {
+    return compile(url).then(module => new Promise(function(resolve, reject) {
+        factory({
+            instantiateWasm: function(imports, receive) {
+                WebAssembly.instantiate(module, imports).then(instance => receive(instance, module), reject);
+                return {};
+            }
+        }).then(resolve, reject);
+    }));
+};
+
+const loadFast = function() {
+    if(!fastBuild.keys().includes('./genplus_fast.js')) return Promise.reject(new Error('not built'));
+    const url = fastBuild('./genplus_fast.wasm');
+    const factory = fastBuild('./genplus_fast.js');
+    return instantiate(factory.default || factory, url.default || url);
+};
+
+// the full core builds in order of preference, the size build last
+const loadFull = function(build) {
+    const names = (build === 'small' ? ['genplus_full'] : ['genplus_fast_full', 'genplus_full'])
+        .filter(name => fullGlue.keys().includes('./' + name + '.js'));
+    if(!names.length) return Promise.reject(new Error('full core not built (-DCHAOS_FULL_CORE=ON)'));
+    return names.reduce((previous, name) => previous.catch(function() {
+        const url = fullWasm('./' + name + '.wasm');
+        return fullGlue('./' + name + '.js').then(factory => instantiate(factory.default || factory, url.default || url));
+    }), Promise.reject(null));
+};
+
+// build: 'fast' (default when available) or 'small' (?build=small); full: the core with the
+// Mega CD and SVP hardware
+export const loadCore = function(build, full) {
+    if(full) return loadFull(build);
+    if(build === 'small') return instantiate(wasm, wasmUrl);
+    return loadFast().then(function(module) {
+        console.log('using the speed build');
+        return module;
+    }, function(error) {
+        if(build === 'fast') console.warn('speed build not available, using the size build:', error);
+        return instantiate(wasm, wasmUrl);
+    });
+};
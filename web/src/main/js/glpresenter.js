@@ -0,0 +1,249 @@
+// WebGL presentation path: the core outputs 8-bit pixel indices (see set_indexed_output)
+// and the palette lookup + 2x scaling is done in a fragment shader.
+//
+// Presentation chaos effects (the post_* effects of the core registry, levels from
+// chaos_post_params_ref()) add two passes while any of them is on: the palette lookup goes
+// to a frame texture, and a post shader combines it with its own previous output (kept in
+// a pair of textures) into the canvas. RGB split offsets the red and blue channels, trails
+// blend the previous output in, block smear drags 8x8 blocks of the previous output along a
+// per-block vector (datamosh) and scanline jitter shifts random lines sideways. All of it
+// runs at the core's resolution on the GPU; with every level at 0 the frame is drawn in the
+// single pass.
+
+const INDEX_PITCH = 512;
+const INDEX_LINES = 256;
+const PALETTE_SIZE = 256;
+const POST_LEVELS = 4;
+
+const VERTEX_SHADER = `
+attribute vec2 a_position;
+uniform vec2 u_area;
+varying vec2 v_uv;
+void main() {
+    v_uv = (a_position * vec2(0.5, -0.5) + 0.5) * u_area;
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}`;
+
+// palette entries are 0xAARRGGBB words, so texels come out as BGRA
+const FRAGMENT_SHADER = `
+precision mediump float;
+uniform sampler2D u_index;
+uniform sampler2D u_palette;
+varying vec2 v_uv;
+void main() {
+    float index = texture2D(u_index, v_uv).r * 255.0;
+    vec4 color = texture2D(u_palette, vec2((index + 0.5) / ${PALETTE_SIZE}.0, 0.5));
+    gl_FragColor = vec4(color.bgr, 1.0);
+}`;
+
+const POST_VERTEX_SHADER = `
+attribute vec2 a_position;
+uniform vec2 u_area;
+varying vec2 v_st;
+void main() {
+    v_st = (a_position * 0.5 + 0.5) * u_area;
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}`;
+
+// u_levels: rgb split, trails, block smear, scanline jitter (0..1); u_size: frame in pixels
+const POST_FRAGMENT_SHADER = `
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+uniform sampler2D u_frame;
+uniform sampler2D u_prev;
+uniform vec4 u_levels;
+uniform vec2 u_area;
+uniform vec2 u_size;
+uniform float u_time;
+varying vec2 v_st;
+float hash(vec2 p) {
+    return fract(sin(dot(p, vec2(12.9898, 78.233))) * 43758.5453);
+}
+void main() {
+    vec2 texel = u_area / u_size;
+    vec2 px = v_st / texel;
+    float line = floor(px.y);
+    if(hash(vec2(line, u_time)) < u_levels.w * 0.25)
+        px.x += (hash(vec2(u_time, line)) - 0.5) * 32.0 * u_levels.w;
+    vec2 st = clamp(px * texel, texel * 0.5, u_area - texel * 0.5);
+    vec2 block = floor(px / 8.0);
+    vec3 color;
+    if(hash(block + floor(u_time / 4.0)) < u_levels.z * 0.5) {
+        vec2 motion = floor((vec2(hash(block * 1.7), hash(block * 2.3)) - 0.5) * 5.0);
+        color = texture2D(u_prev, clamp(st + motion * texel, vec2(0.0), u_area)).rgb;
+    } else {
+        vec2 split = vec2(u_levels.x * 4.0, 0.0) * texel;
+        color = vec3(texture2D(u_frame, st + split).r, texture2D(u_frame, st).g, texture2D(u_frame, st - split).b);
+    }
+    gl_FragColor = vec4(mix(color, texture2D(u_prev, v_st).rgb, u_levels.y * 0.9), 1.0);
+}`;
+
+const compile = function(gl, type, source) {
+    const shader = gl.createShader(type);
+    gl.shaderSource(shader, source);
+    gl.compileShader(shader);
+    if(!gl.getShaderParameter(shader, gl.COMPILE_STATUS)) {
+        console.warn(gl.getShaderInfoLog(shader));
+        return null;
+    }
+    return shader;
+};
+
+// both programs take the quad at attribute 0
+const link = function(gl, vertexSource, fragmentSource) {
+    const vs = compile(gl, gl.VERTEX_SHADER, vertexSource);
+    const fs = compile(gl, gl.FRAGMENT_SHADER, fragmentSource);
+    if(!vs || !fs) return null;
+    const program = gl.createProgram();
+    gl.attachShader(program, vs);
+    gl.attachShader(program, fs);
+    gl.bindAttribLocation(program, 0, 'a_position');
+    gl.linkProgram(program);
+    return gl.getProgramParameter(program, gl.LINK_STATUS) ? program : null;
+};
+
+const createTexture = function(gl, unit, format, width, height) {
+    const texture = gl.createTexture();
+    gl.activeTexture(gl.TEXTURE0 + unit);
+    gl.bindTexture(gl.TEXTURE_2D, texture);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MIN_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MAG_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_S, gl.CLAMP_TO_EDGE);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_T, gl.CLAMP_TO_EDGE);
+    gl.texImage2D(gl.TEXTURE_2D, 0, format, width, height, 0, format, gl.UNSIGNED_BYTE, null);
+    return texture;
+};
+
+// returns null when WebGL is not available, the caller keeps the 2D canvas path
+export const createGLPresenter = function(scale) {
+    // plain canvas on the main thread, OffscreenCanvas inside the emulator worker
+    const canvas = typeof document !== 'undefined' ? document.createElement('canvas') : new OffscreenCanvas(1, 1);
+    const gl = canvas.getContext('webgl', { alpha: false, antialias: false });
+    if(!gl) return null;
+
+    const program = link(gl, VERTEX_SHADER, FRAGMENT_SHADER);
+    if(!program) return null;
+    gl.useProgram(program);
+
+    const quad = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, quad);
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 1, -1, -1, 1, 1, 1]), gl.STATIC_DRAW);
+    gl.enableVertexAttribArray(0);
+    gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0);
+
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 1);
+    const indexTexture = createTexture(gl, 0, gl.LUMINANCE, INDEX_PITCH, INDEX_LINES);
+    const paletteTexture = createTexture(gl, 1, gl.RGBA, PALETTE_SIZE, 1);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_index'), 0);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_palette'), 1);
+    const area = gl.getUniformLocation(program, 'u_area');
+
+    // post effect passes, set up on first use: the frame and the previous outputs are RGBA
+    // textures of the index texture's size on units 2 and 3 (null when the program fails)
+    let post;
+    let postOn = false;
+    let postTime = 0;
+    const createPost = function() {
+        const postProgram = link(gl, POST_VERTEX_SHADER, POST_FRAGMENT_SHADER);
+        if(!postProgram) return null;
+        const target = function(unit) {
+            const texture = createTexture(gl, unit, gl.RGBA, INDEX_PITCH, INDEX_LINES);
+            const framebuffer = gl.createFramebuffer();
+            gl.bindFramebuffer(gl.FRAMEBUFFER, framebuffer);
+            gl.framebufferTexture2D(gl.FRAMEBUFFER, gl.COLOR_ATTACHMENT0, gl.TEXTURE_2D, texture, 0);
+            return { texture: texture, framebuffer: framebuffer };
+        };
+        const result = { program: postProgram, frame: target(2), history: [target(3), target(3)], current: 0 };
+        gl.bindFramebuffer(gl.FRAMEBUFFER, null);
+        gl.useProgram(postProgram);
+        gl.uniform1i(gl.getUniformLocation(postProgram, 'u_frame'), 2);
+        gl.uniform1i(gl.getUniformLocation(postProgram, 'u_prev'), 3);
+        result.levels = gl.getUniformLocation(postProgram, 'u_levels');
+        result.area = gl.getUniformLocation(postProgram, 'u_area');
+        result.size = gl.getUniformLocation(postProgram, 'u_size');
+        result.time = gl.getUniformLocation(postProgram, 'u_time');
+        gl.useProgram(program);
+        return result;
+    };
+
+    // palette lookup into the frame texture, then the post shader into the next history
+    // texture and the canvas
+    const drawPost = function(levels, areaW, areaH) {
+        gl.bindFramebuffer(gl.FRAMEBUFFER, post.frame.framebuffer);
+        gl.viewport(0, 0, areaW, areaH);
+        gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+
+        const prev = post.history[post.current];
+        const next = post.history[post.current ^ 1];
+        if(!postOn) {
+            // the history of the last time the effects were on is stale
+            for(const target of post.history) {
+                gl.bindFramebuffer(gl.FRAMEBUFFER, target.framebuffer);
+                gl.clear(gl.COLOR_BUFFER_BIT);
+            }
+            postOn = true;
+        }
+        gl.useProgram(post.program);
+        gl.activeTexture(gl.TEXTURE3);
+        gl.bindTexture(gl.TEXTURE_2D, prev.texture);
+        gl.uniform4f(post.levels, levels[0], levels[1], levels[2], levels[3]);
+        gl.uniform2f(post.area, areaW / INDEX_PITCH, areaH / INDEX_LINES);
+        gl.uniform2f(post.size, areaW, areaH);
+        gl.uniform1f(post.time, postTime = (postTime + 1) & 4095);
+        gl.bindFramebuffer(gl.FRAMEBUFFER, next.framebuffer);
+        gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+        gl.bindFramebuffer(gl.FRAMEBUFFER, null);
+        gl.viewport(0, 0, canvas.width, canvas.height);
+        gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+        post.current ^= 1;
+        gl.useProgram(program);
+    };
+
+    return {
+        canvas: canvas,
+        // upload changed lines + the palette and draw an (areaW x areaH) frame at 'scale',
+        // through the post effects while one of the POST_LEVELS 'levels' is above 0
+        draw: function(indices, palette, dirtyLines, areaW, areaH, full, levels) {
+            const lines = Math.min(areaH, INDEX_LINES);
+            gl.activeTexture(gl.TEXTURE0);
+            gl.bindTexture(gl.TEXTURE_2D, indexTexture);
+            let first = -1;
+            for(let line = 0; line <= lines; line++) {
+                if(line < lines && (full || dirtyLines[line])) {
+                    if(first < 0) first = line;
+                } else if(first >= 0) {
+                    gl.texSubImage2D(gl.TEXTURE_2D, 0, 0, first, INDEX_PITCH, line - first, gl.LUMINANCE, gl.UNSIGNED_BYTE,
+                        indices.subarray(first * INDEX_PITCH, line * INDEX_PITCH));
+                    first = -1;
+                }
+            }
+            gl.activeTexture(gl.TEXTURE1);
+            gl.bindTexture(gl.TEXTURE_2D, paletteTexture);
+            gl.texSubImage2D(gl.TEXTURE_2D, 0, 0, 0, PALETTE_SIZE, 1, gl.RGBA, gl.UNSIGNED_BYTE, palette);
+
+            if(canvas.width !== areaW * scale || canvas.height !== areaH * scale) {
+                canvas.width = areaW * scale;
+                canvas.height = areaH * scale;
+            }
+            gl.uniform2f(area, areaW / INDEX_PITCH, areaH / INDEX_LINES);
+            if(levels && levels.some(level => level > 0)) {
+                if(post === undefined) post = createPost();
+                if(post) {
+                    drawPost(levels, areaW, areaH);
+                    return;
+                }
+            }
+            postOn = false;
+            gl.viewport(0, 0, canvas.width, canvas.height);
+            gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+        }
+    };
+};
+
+export const GL_INDEX_PITCH = INDEX_PITCH;
+export const GL_INDEX_LINES = INDEX_LINES;
+export const GL_PALETTE_SIZE = PALETTE_SIZE;
+export const GL_POST_LEVELS = POST_LEVELS;
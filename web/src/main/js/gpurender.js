@@ -0,0 +1,306 @@
+// GPU compositing path (?renderer=gpu): Mode 5 lines are not drawn by the core but logged
+// (set_gpu_render, see core gpu_log.h), and a WebGL2 fragment shader composites them from
+// their line records, the VRAM they were logged with, the decoded pattern cache and the
+// layer tables. Rows the log does not cover come from the palette index buffer as in the
+// WebGL presenter. Each logged row is colored with the pixel table snapshot of its line, so
+// raster palette changes show as in the 2D canvas path.
+//
+// The shader is gpu_log_compose() of the core pixel for pixel, except that it resolves
+// every pixel on its own. Same draw() as createGLPresenter(), without the post effects;
+// attach() takes the core again after each start (its heap views).
+
+import { GL_INDEX_PITCH, GL_INDEX_LINES, GL_PALETTE_SIZE } from './glpresenter.js';
+
+// core gpu_log.h
+const LOG_LINES = 256;
+const LOG_PALETTES = 256;
+const LINE_WORDS = 140;
+const LINE_LOGGED = 0x01;
+const VRAM_SIZE = 0x10000;
+// 2048 patterns of 8x8 pixels, unflipped
+const PATTERN_SIZE = 0x20000;
+// five 64KB tables
+const LAYER_SIZE = 0x50000;
+
+const VERTEX_SHADER = `#version 300 es
+in vec2 a_position;
+void main() {
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}`;
+
+// line record words as GPU_LINE_* of gpu_log.h
+const FRAGMENT_SHADER = `#version 300 es
+precision highp float;
+precision highp int;
+precision highp usampler2D;
+uniform usampler2D u_lines;
+uniform usampler2D u_vram;
+uniform usampler2D u_patterns;
+uniform usampler2D u_layers;
+uniform usampler2D u_index;
+uniform sampler2D u_palettes;
+uniform sampler2D u_palette;
+uniform int u_scale;
+uniform int u_height;
+out vec4 o_color;
+
+const int FLAGS = 0;
+const int PALETTE = 1;
+const int WIDTH = 2;
+const int BORDER = 3;
+const int Y = 4;
+const int NTAB = 5;
+const int NTBB = 6;
+const int WINDOW = 7;
+const int COLS = 8;
+const int ROWS = 9;
+const int SHIFT = 10;
+const int HSCROLL_A = 11;
+const int HSCROLL_B = 12;
+const int A_LEFT = 13;
+const int A_RIGHT = 14;
+const int W_LEFT = 15;
+const int W_RIGHT = 16;
+const int SPRITES = 17;
+const int VSCROLL = 18;
+const int SPRITE = 60;
+
+int row;
+
+int word(int i) {
+    return int(texelFetch(u_lines, ivec2(i, row), 0).r);
+}
+
+int vramWord(int addr) {
+    addr = (addr & 0xFFFF) >> 1;
+    return int(texelFetch(u_vram, ivec2(addr & 255, addr >> 8), 0).r);
+}
+
+int layer(int table, int index) {
+    int offset = (table << 16) | index;
+    return int(texelFetch(u_layers, ivec2(offset & 255, offset >> 8), 0).r);
+}
+
+// pattern pixel of name table word w | priority and palette bits
+int tilePixel(int w, int x, int y) {
+    if((w & 0x800) != 0) x ^= 7;
+    if((w & 0x1000) != 0) y ^= 7;
+    int offset = ((w & 0x7FF) << 6) | (y << 3) | x;
+    return int(texelFetch(u_patterns, ivec2(offset & 511, offset >> 9), 0).r) | ((w >> 9) & 0x70);
+}
+
+int planePixel(int table, int px, int v) {
+    px &= (word(COLS) << 4) | 15;
+    v &= word(ROWS);
+    return tilePixel(vramWord(table + (((v >> 3) << word(SHIFT)) & 0x1FC0) + ((px >> 3) << 1)), px & 7, v & 7);
+}
+
+int bgPixel(int table, int x) {
+    int y = word(Y);
+    int a = 0;
+    if((x >> 4) >= word(W_LEFT) && (x >> 4) < word(W_RIGHT)) {
+        a = tilePixel(vramWord(word(WINDOW) + ((x >> 3) << 1)), x & 7, y & 7);
+    } else if(word(A_RIGHT) > word(A_LEFT)) {
+        int hs = word(HSCROLL_A);
+        int k = (x - (hs & 15) + 16) >> 4;
+        int px = x - hs;
+        if(k <= word(A_LEFT)) {
+            if(word(A_LEFT) != 0) px += 16;
+            k = 0;
+        }
+        a = planePixel(word(NTAB), px, y + word(VSCROLL + (k << 1)));
+    }
+    int hs = word(HSCROLL_B);
+    int k = (x - (hs & 15) + 16) >> 4;
+    int b = planePixel(word(NTBB), x - hs, y + word(VSCROLL + (k << 1) + 1));
+    return layer(table, (b << 8) | a);
+}
+
+int compose(int x) {
+    int flags = word(FLAGS);
+    int width = word(WIDTH);
+    x -= word(BORDER);
+    if(x < 0 || x >= width || ((flags & 4) != 0 && width >= 8 && x < 8)) return 0x40;
+
+    int bg = bgPixel((flags & 2) != 0 ? 2 : 0, x);
+    bool ste = (flags & 8) != 0;
+    int lb = ste ? 0 : bg;
+    int table = ste ? 3 : 1;
+    int count = word(SPRITES);
+    for(int i = 0; i < 20; i++) {
+        if(i >= count) break;
+        int s = SPRITE + (i << 2);
+        int xpos = word(s);
+        if(xpos >= 0x8000) xpos -= 0x10000;
+        int p = x - xpos;
+        if(p < 0 || p >= word(s + 3)) continue;
+        int attr = word(s + 1);
+        int size = word(s + 2) & 15;
+        int yoff = word(s + 2) >> 8;
+        int h = size & 3;
+        int col = p >> 3;
+        int cell = yoff >> 3;
+        if((attr & 0x800) != 0) col = ((size >> 2) & 3) - col;
+        if((attr & 0x1000) != 0) cell = h - cell;
+        int name = ((attr & 0x7FF) + cell + col * (h + 1)) & 0x7FF;
+        int pixel = tilePixel((attr & 0x1800) | name, p & 7, yoff & 7) & 15;
+        if(pixel != 0) lb = layer(table, (lb << 8) | pixel | ((attr >> 9) & 0x70));
+    }
+    return ste ? layer(4, (bg << 8) | lb) : lb;
+}
+
+void main() {
+    int x = int(gl_FragCoord.x) / u_scale;
+    row = (u_height - 1 - int(gl_FragCoord.y)) / u_scale;
+    vec4 color;
+    if((word(FLAGS) & ${LINE_LOGGED}) != 0) {
+        color = texelFetch(u_palettes, ivec2(compose(x), word(PALETTE)), 0);
+    } else {
+        color = texelFetch(u_palette, ivec2(int(texelFetch(u_index, ivec2(x, row), 0).r), 0), 0);
+    }
+    // palette entries are 0xAARRGGBB words, so texels come out as BGRA
+    o_color = vec4(color.bgr, 1.0);
+}`;
+
+const compile = function(gl, type, source) {
+    const shader = gl.createShader(type);
+    gl.shaderSource(shader, source);
+    gl.compileShader(shader);
+    if(!gl.getShaderParameter(shader, gl.COMPILE_STATUS)) {
+        console.warn(gl.getShaderInfoLog(shader));
+        return null;
+    }
+    return shader;
+};
+
+const link = function(gl) {
+    const vs = compile(gl, gl.VERTEX_SHADER, VERTEX_SHADER);
+    const fs = compile(gl, gl.FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if(!vs || !fs) return null;
+    const program = gl.createProgram();
+    gl.attachShader(program, vs);
+    gl.attachShader(program, fs);
+    gl.bindAttribLocation(program, 0, 'a_position');
+    gl.linkProgram(program);
+    return gl.getProgramParameter(program, gl.LINK_STATUS) ? program : null;
+};
+
+// integer textures are never filtered
+const createTexture = function(gl, unit, internalFormat, format, type, width, height) {
+    const texture = gl.createTexture();
+    gl.activeTexture(gl.TEXTURE0 + unit);
+    gl.bindTexture(gl.TEXTURE_2D, texture);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MIN_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MAG_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_S, gl.CLAMP_TO_EDGE);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_T, gl.CLAMP_TO_EDGE);
+    gl.texStorage2D(gl.TEXTURE_2D, 1, internalFormat, width, height);
+    return { texture: texture, unit: unit, format: format, type: type, pitch: width * (format === gl.RGBA ? 4 : 1), width: width };
+};
+
+// returns null when WebGL2 is not available, the caller keeps the 2D canvas path
+export const createGPURenderer = function(scale) {
+    const canvas = typeof document !== 'undefined' ? document.createElement('canvas') : new OffscreenCanvas(1, 1);
+    const gl = canvas.getContext('webgl2', { alpha: false, antialias: false });
+    if(!gl) return null;
+
+    const program = link(gl);
+    if(!program) return null;
+    gl.useProgram(program);
+
+    const quad = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, quad);
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 1, -1, -1, 1, 1, 1]), gl.STATIC_DRAW);
+    gl.enableVertexAttribArray(0);
+    gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0);
+
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 1);
+    const textures = {
+        lines: createTexture(gl, 0, gl.R16UI, gl.RED_INTEGER, gl.UNSIGNED_SHORT, LINE_WORDS, LOG_LINES),
+        vram: createTexture(gl, 1, gl.R16UI, gl.RED_INTEGER, gl.UNSIGNED_SHORT, 256, VRAM_SIZE / 512),
+        patterns: createTexture(gl, 2, gl.R8UI, gl.RED_INTEGER, gl.UNSIGNED_BYTE, 512, PATTERN_SIZE / 512),
+        layers: createTexture(gl, 3, gl.R8UI, gl.RED_INTEGER, gl.UNSIGNED_BYTE, 256, LAYER_SIZE / 256),
+        index: createTexture(gl, 4, gl.R8UI, gl.RED_INTEGER, gl.UNSIGNED_BYTE, GL_INDEX_PITCH, GL_INDEX_LINES),
+        palettes: createTexture(gl, 5, gl.RGBA8, gl.RGBA, gl.UNSIGNED_BYTE, GL_PALETTE_SIZE, LOG_PALETTES),
+        palette: createTexture(gl, 6, gl.RGBA8, gl.RGBA, gl.UNSIGNED_BYTE, GL_PALETTE_SIZE, 1)
+    };
+    gl.uniform1i(gl.getUniformLocation(program, 'u_lines'), 0);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_vram'), 1);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_patterns'), 2);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_layers'), 3);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_index'), 4);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_palettes'), 5);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_palette'), 6);
+    gl.uniform1i(gl.getUniformLocation(program, 'u_scale'), scale);
+    const height = gl.getUniformLocation(program, 'u_height');
+
+    // rows 'top' to 'bottom' of a texture from 'data' (whole rows, 'pitch' elements each)
+    const upload = function(target, data, top, bottom) {
+        gl.activeTexture(gl.TEXTURE0 + target.unit);
+        gl.bindTexture(gl.TEXTURE_2D, target.texture);
+        gl.texSubImage2D(gl.TEXTURE_2D, 0, 0, top, target.width, bottom - top, target.format, target.type,
+            data.subarray(top * target.pitch, bottom * target.pitch));
+    };
+
+    let core = null;
+    let views = null;
+    let layersLoaded = false;
+
+    return {
+        canvas: canvas,
+        // core module after start(): views of its log, which set_gpu_render(1) turns on
+        attach: function(gens) {
+            const heap = gens.HEAPU8.buffer;
+            core = gens;
+            views = {
+                lines: new Uint16Array(heap, gens._gpu_log_lines_ref(), LOG_LINES * LINE_WORDS),
+                palettes: new Uint8Array(heap, gens._gpu_log_palettes_ref(), LOG_PALETTES * GL_PALETTE_SIZE * 4),
+                vram: new Uint16Array(heap, gens._gpu_log_vram_ref(), VRAM_SIZE / 2),
+                patterns: new Uint8Array(heap, gens._gpu_log_patterns_ref(), PATTERN_SIZE),
+                layers: new Uint8Array(heap, gens._gpu_log_layers_ref(), LAYER_SIZE)
+            };
+            layersLoaded = false;
+            gens._set_gpu_render(1);
+        },
+        // upload the log of the last frame drawn, the changed index buffer lines + the palette,
+        // and composite an (areaW x areaH) frame at 'scale' (no post effects: 'levels' unused)
+        draw: function(indices, palette, dirtyLines, areaW, areaH, full) {
+            const lines = Math.min(areaH, GL_INDEX_LINES);
+            let first = -1;
+            for(let line = 0; line <= lines; line++) {
+                if(line < lines && (full || dirtyLines[line])) {
+                    if(first < 0) first = line;
+                } else if(first >= 0) {
+                    upload(textures.index, indices, first, line);
+                    first = -1;
+                }
+            }
+            upload(textures.palette, palette, 0, 1);
+
+            // -1: no frame drawn since the last call, the textures still hold its log
+            const logged = core ? core._gpu_log_take() : -1;
+            if(core && (core._gpu_log_layers_changed() || !layersLoaded)) {
+                // the layer tables move when a layer glitch starts or ends
+                views.layers = new Uint8Array(core.HEAPU8.buffer, core._gpu_log_layers_ref(), LAYER_SIZE);
+                upload(textures.layers, views.layers, 0, LAYER_SIZE / 256);
+                layersLoaded = true;
+            }
+            if(logged >= 0) {
+                upload(textures.lines, views.lines, 0, lines);
+            }
+            if(logged > 0) {
+                upload(textures.vram, views.vram, 0, VRAM_SIZE / 512);
+                upload(textures.patterns, views.patterns, 0, PATTERN_SIZE / 512);
+                upload(textures.palettes, views.palettes, 0, Math.max(1, core._gpu_log_palette_count()));
+            }
+
+            if(canvas.width !== areaW * scale || canvas.height !== areaH * scale) {
+                canvas.width = areaW * scale;
+                canvas.height = areaH * scale;
+            }
+            gl.uniform1i(height, canvas.height);
+            gl.viewport(0, 0, canvas.width, canvas.height);
+            gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+        }
+    };
+};
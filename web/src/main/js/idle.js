@@ -0,0 +1,50 @@
+// Per-game 68k idle loop skipping (set_idle_skip(), see m68k_idle_skip() in m68k.h).
+// Loops that only read RAM or ROM are skipped for every game (exact); loops polling the
+// VDP status port only for the games whitelisted with 'vdp', and nothing for the ones
+// blacklisted with 'off'. The list is kept in localStorage, keyed by the cartridge header
+// product code and checksum; ?idle=off|ram|vdp overrides it for the session.
+
+export const IDLE_MODES = ['off', 'ram', 'vdp'];
+const IDLE_DEFAULT = 1;
+const STORAGE_KEY = 'chaosdrive.idle';
+
+const idleParam = IDLE_MODES.indexOf(new URLSearchParams(location.search).get('idle'));
+
+// 'GM 00001009-00/264a' from the header at $180 ($18e: checksum)
+const romKey = function(bytes) {
+    const rom = new Uint8Array(bytes);
+    if(rom.length < 0x190) return null;
+    let key = '';
+    for(let i = 0x180; i < 0x18e; i++) key += String.fromCharCode(rom[i]);
+    return key.trim() + '/' + ((rom[0x18e] << 8) | rom[0x18f]).toString(16).padStart(4, '0');
+};
+
+const loadList = function() {
+    try {
+        return JSON.parse(localStorage.getItem(STORAGE_KEY)) || {};
+    } catch(error) {
+        return {};
+    }
+};
+
+// mode for a ROM about to be started
+export const idleMode = function(bytes) {
+    if(idleParam >= 0) return idleParam;
+    const mode = IDLE_MODES.indexOf(loadList()[romKey(bytes)]);
+    return mode >= 0 ? mode : IDLE_DEFAULT;
+};
+
+// adds the ROM to the list ('off', 'vdp'), or removes it ('ram' or null); returns the key
+export const setIdleMode = function(bytes, name) {
+    const key = romKey(bytes);
+    if(!key) return null;
+    const list = loadList();
+    if(name === 'off' || name === 'vdp') list[key] = name;
+    else delete list[key];
+    try {
+        localStorage.setItem(STORAGE_KEY, JSON.stringify(list));
+    } catch(error) {
+        console.warn('idle: cannot save the list,', error);
+    }
+    return key;
+};
@@ -1,28 +1,154 @@
-import wasm from './genplus.js';
-import './genplus.wasm';
-
-const CANVAS_WIDTH = 640;
-const CANVAS_HEIGHT = 480;
-const SOUND_FREQUENCY = 44100;
-const SAMPLING_PER_FPS = 736;
-const GAMEPAD_API_INDEX = 32;
+import { loadCore } from './core.js';
+import { createAudioContext, createAudioRing, createRateConverter, AUDIO_EFFECT_LEVELS } from './audio.js';
+import { createAudioPacer } from './pacer.js';
+import { createGLPresenter, GL_INDEX_PITCH, GL_INDEX_LINES, GL_PALETTE_SIZE, GL_POST_LEVELS } from './glpresenter.js';
+import { createGPURenderer } from './gpurender.js';
+import { createCanvasPresenter, FRAME_WIDTH, FRAME_HEIGHT, SCALE_MAX } from './presenter.js';
+import { writeChaosCommand, createChaosWriter, CHAOS_QUEUE_SIZE, CHAOS_QUEUE_BYTES, CHAOS_OP_PARAM } from './chaosqueue.js';
+import { createChaosControls, AXIS_MAX } from './chaoscontrols.js';
+import { captureStreams, drainCapture, finishCapture, createCaptureFile, CAPTURE_VGM, CAPTURE_WAV } from './capture.js';
+import { createClipRing, createClipEncoder, CLIP_SECONDS } from './clip.js';
+import { enableJit } from './jit.js';
+import { idleMode, setIdleMode, IDLE_MODES } from './idle.js';
+import { STATE_SLOTS, storeState, fetchState, saveCoreState, loadCoreState } from './states.js';
+import { streamRom } from './romstream.js';
+import { discImage, openDisc } from './cdstream.js';
+import { openRom, readRomStart } from './romarchive.js';
+import { createTwin } from './twin.js';
+import { createVariations } from './variations.js';
+import { createInputBlock, createLatencyMeter, writeInput, writeChaosKeys, keyBits, gamepadBits, gamepadCodes, inputNow, INPUT_BLOCK_BYTES } from './input.js';
+import { encodeChaosBindings, uploadChaosBindings } from './chaosbind.js';
+import { assembleChaosProgram, loadChaosProgram, CHAOS_VM_PROGRAMS } from './chaosvm.js';
+import { createMemoryView } from './memview.js';
+import { readTelemetry, createUnderrunReporter, TELEMETRY_MISSED, QUALITY_LEVELS } from './telemetry.js';
+import { hostNetplay, joinNetplay } from './netplay.js';
+import { openTransport, startBroadcast, watchBroadcast } from './broadcast.js';
+import { openBackup } from './backup.js';
+import { openLearned } from './learned.js';
+import { backgroundState, backgroundParam, powerParam, POWER_MODES, POWER_LEVELS, TICK_RENDER_LAST, TICK_RENDER_NONE } from './power.js';
 
 // emulator
 let gens;
-let romdata;
+// header of the running ROM (per-game idle skipping list, see idle.js)
+let romHeader = null;
 let vram;
-let input;
+let dirtyLines;
+let frameInfo;
 let initialized = false;
 let pause = false;
 
 // canvas member
 let canvas;
 let canvasContext;
-let canvasImageData;
+let presenter;
+// optional WebGL path (?renderer=webgl): core outputs palette indices, lookup done on the GPU
+const useWebGL = new URLSearchParams(location.search).get('renderer') === 'webgl';
+// optional GPU compositing (?renderer=gpu, WebGL2): Mode 5 lines are composited in a shader
+// from the core's line log (gpurender.js); no instant replay, the core draws no full frames
+const useGPU = new URLSearchParams(location.search).get('renderer') === 'gpu';
+let glPresenter = null;
+let indexBuffer;
+// presentation chaos effect levels (post_* effects), WebGL path only
+let postLevels;
+// optional frame profile bar (?profile=1, needs a -DCHAOS_PROFILE=ON build for the counters,
+// the input latency figure is always measured)
+const useProfile = new URLSearchParams(location.search).get('profile') === '1';
+let frameProfile = null;
+let profileNames = [];
+let palette;
+// optional NTSC filter (?ntsc=composite|svideo|rgb|mono or chaosNtsc() in the console), RGB
+// output only: the WebGL renderer gets palette indices and is never filtered
+const NTSC_MODES = ['off', 'composite', 'svideo', 'rgb', 'mono'];
+let ntscMode = Math.max(0, NTSC_MODES.indexOf(new URLSearchParams(location.search).get('ntsc')));
+// core output scale (?scale=1..4): the canvas is the frame at that scale and CSS stretches it
+// with nearest neighbour filtering. 1 (the default) uploads the smallest image and leaves the
+// scaling to the compositor; the NTSC filter needs 2 or 4
+const scaleParam = parseInt(new URLSearchParams(location.search).get('scale'), 10);
+const outputScale = scaleParam >= 1 ? Math.min(scaleParam, SCALE_MAX) : (ntscMode ? 2 : 1);
+// optional line cache (?linecache=1): lines drawn from the same inputs as in the previous
+// frame are not rendered or uploaded again
+const useLineCache = new URLSearchParams(location.search).get('linecache') === '1';
+
+// optional worker mode (?worker=1): the core runs in worker.js and draws into an OffscreenCanvas.
+// Needs cross-origin isolation for the shared input / chaos / audio buffers.
+const useWorker = new URLSearchParams(location.search).get('worker') === '1' &&
+    self.crossOriginIsolated && typeof Worker !== 'undefined' &&
+    'transferControlToOffscreen' in HTMLCanvasElement.prototype;
+let worker = null;
+let chaosShared = null;
+
+// optional clean twin (?twin=1 or chaosTwin(true), main thread mode): a second core instance
+// running the same ROM and input without chaos, drawn next to the main screen (see twin.js)
+const useTwin = new URLSearchParams(location.search).get('twin') === '1';
+let twin = null;
+// two-player rollback session over WebRTC (chaosNetHost() / chaosNetJoin(), main thread mode,
+// see netplay.js), set while it runs
+let netplay = null;
+// spectator streaming (chaosBroadcast() / chaosSpectate(), main thread mode, see broadcast.js):
+// the session being sent, or the one being watched
+let broadcast = null;
+let spectator = null;
+let twinCanvas = null;
+// ROM file, idle mode and core (full or Mega Drive only) of the running game, loaded again by the twin
+let romFile = null;
+let romIdle = 1;
+let fullCore = false;
+// Mega CD disc being streamed from the picked files (cdstream.js, main thread mode), null for a cartridge
+let disc = null;
+// live memory view (Digit9 or chaosMemoryView(), memview.js, main thread mode): drawn after every
+// run while shown, next to the screen like the twin
+let memoryView = null;
+let memoryViewShown = false;
+// variations grid being played (chaosVariations(), variations.js, main thread mode)
+let variations = null;
+
+// core build (?build=small forces the -Oz build, see core.js)
+const coreBuild = new URLSearchParams(location.search).get('build');
+// 68k trace compiler (?jit=1, needs a -DCHAOS_JIT=ON build, see jit.js)
+const useJit = new URLSearchParams(location.search).get('jit') === '1';
+// quality governor (see governor.h): audio accuracy, then rendering, traded for speed when the
+// core cannot keep up; ?governor=0 keeps full quality
+const useGovernor = new URLSearchParams(location.search).get('governor') !== '0';
+// battery saver (power.js): POWER_MODES index, ?power=saver or chaosPower()
+let powerMode = powerParam;
+// hidden tab (power.js): null while shown, 'run' (frames run for the audio, nothing drawn) or 'pause'
+let background = null;
+
+// session capture (Digit4 starts/stops): ?capture=vgm (default), wav or both
+const captureMask = captureStreams(new URLSearchParams(location.search).get('capture'));
+// stream -> capture file while recording, null otherwise
+let captureFiles = null;
+// instant replay (Digit8 saves the last CLIP_SECONDS as a GIF): ring of the frames drawn in main
+// thread mode (the worker keeps its own), and the encoder worker of both, created on first use
+let clip = null;
+let clipEncoder = null;
+
+// save state slots (Digit5 saves, Digit6 loads, Digit7 selects the next one), kept per ROM CRC
+let stateSlot = 0;
+let romCrc = null;
+// battery save of the running game (backup.js, main thread mode); no frame runs until it is
+// back in the core
+let backup = null;
+let backupReady = false;
+// learned profile of the running game (learned.js, main thread mode), back in the core with the
+// battery save; closed before every gens._start()
+let learned = null;
 
 // fps control
 const FPS = 60;
 const INTERVAL = 1000 / FPS;
+// frames run per tick while behind (drawn once) and while fast-forwarding (hold Backquote)
+const MAX_FRAME_SKIP = 4;
+const TURBO_FRAMES = 8;
+let turbo = false;
+// playback speed (Minus / Equal or chaosSpeed()): frames run at speed x 60Hz, drawn at most once
+// per display refresh. Tape-style audio plays the samples of a frame over 1 / speed of its time
+// (the core's resampler), pitch-correct audio is time-stretched by the AudioWorklet instead
+const SPEEDS = [0.25, 0.5, 1, 2, 4];
+let speed = 1;
+let speedTape = true;
+// hold Backspace: step back one rewind snapshot per drawn frame
+let rewinding = false;
 let now;
 let then;
 let delta;
@@ -35,14 +161,32 @@ const SOUND_DELAY_FRAME = 8;
 let audioContext;
 let audio_l;
 let audio_r;
+// audio output chaos effect levels (audio_* effects), AudioWorklet path only
+let audioEffects;
 let soundShedTime = 0;
-let soundDelayTime = SAMPLING_PER_FPS * SOUND_DELAY_FRAME / SOUND_FREQUENCY;
+let soundDelayTime = SOUND_DELAY_FRAME / FPS;
+// AudioWorklet output (null until ready, or when unsupported: AudioBuffer scheduling above is used)
+// ?latency=low: 2 frames queued, and on the main thread frames are run on audio demand (pacer.js)
+// instead of from requestAnimationFrame; needs the shared ring (cross-origin isolation)
+const lowLatency = new URLSearchParams(location.search).get('latency') === 'low';
+const AUDIO_LATENCY_FRAMES = lowLatency ? 2 : 3;
+let audioRing = null;
+let reportUnderruns = null;
+let audioPacer = null;
+// ring blocks of a session, whose core output stays at 44.1kHz (get_audio_rate())
+const rateConverter = createRateConverter();
 
 // for iOS
 let isSafari = false;
 
 // keyboard state
 const keys = new Set();
+// pad bits shared with the core (input.js), the gamepad's as of the last animation frame
+const inputBlock = createInputBlock(useWorker ? new SharedArrayBuffer(INPUT_BLOCK_BYTES) : new ArrayBuffer(INPUT_BLOCK_BYTES));
+const latencyMeter = useWorker ? null : createLatencyMeter(inputBlock);
+let padBits = 0;
+// pressed gamepad buttons, for chaos bindings
+let padCodes = [];
 const prevKeys = new Set(); // for single-press detection
 
 // ChaosDrive status message
@@ -51,12 +195,26 @@ let chaosMessageTimer = 0;
 function showChaosMessage(msg) {
     chaosMessage = msg;
     chaosMessageTimer = 120; // ~2 seconds at 60fps
+    if(worker) worker.postMessage({ type: 'message', text: msg });
 }
 
 document.addEventListener('keydown', function(e) {
     keys.add(e.code);
+    writeInput(inputBlock, keyBits(keys) | padBits, performance.timeOrigin + e.timeStamp);
+    writeChaosKeys(inputBlock, chaosKeySlots, keys, padCodes);
+    // the core leaves the bindings to netplay, which sends their effects to the other player too
+    // (once per press; toggles alternate here)
+    if(netplay && !e.repeat) {
+        chaosBound.forEach(binding => {
+            if(binding.code !== e.code) return;
+            if(binding.mode === 'toggle') binding.toggled = !binding.toggled;
+            const intensity = binding.intensity === undefined ? 1 : binding.intensity;
+            chaosSubmit(binding.id, binding.mode === 'toggle' && !binding.toggled ? 0 : intensity);
+            showChaosMessage(binding.message);
+        });
+    }
     // prevent arrow keys / tab from scrolling
-    if(['ArrowUp','ArrowDown','ArrowLeft','ArrowRight','Tab'].includes(e.code)) {
+    if(['ArrowUp','ArrowDown','ArrowLeft','ArrowRight','Tab','Backspace'].includes(e.code)) {
         e.preventDefault();
     }
     // Prevent default for chaos keys too
@@ -64,14 +222,21 @@ document.addEventListener('keydown', function(e) {
         'Comma','Period'].includes(e.code)) {
         e.preventDefault();
     }
-    if(e.code === 'Tab' && gens) {
-        gens._chaos_reset();
-        gens._start();
-        showChaosMessage('RESET');
+    // Tab: reset, Shift+Tab: back to the state the game was started in
+    if(e.code === 'Tab' && worker && initialized) {
+        worker.postMessage({ type: 'reset', boot: e.shiftKey });
+        showChaosMessage(e.shiftKey ? 'RESET TO BOOT' : 'RESET');
+    } else if(e.code === 'Tab' && gens) {
+        gens._soft_reset(e.shiftKey ? 1 : 0);
+        if(learned) learned.reset();
+        if(twin) twin.reset(e.shiftKey);
+        showChaosMessage(e.shiftKey ? 'RESET TO BOOT' : 'RESET');
     }
 });
 document.addEventListener('keyup', function(e) {
     keys.delete(e.code);
+    writeInput(inputBlock, keyBits(keys) | padBits, performance.timeOrigin + e.timeStamp);
+    writeChaosKeys(inputBlock, chaosKeySlots, keys, padCodes);
 });
 
 const message = function(mes) {
@@ -85,81 +250,946 @@ const message = function(mes) {
 
 const initAudio = function() {
     if(audioContext) return;
-    audioContext = new (window.AudioContext || window.webkitAudioContext)({
-        sampleRate: SOUND_FREQUENCY
-    });
+    // the device's rate, the core generates its samples at it (the worker's at 'rom')
+    audioContext = createAudioContext();
+    const rate = audioContext.sampleRate;
+    const samplesPerFrame = Math.round(rate / FPS);
+    if(!worker) gens._set_audio_rate(rate, 0);
     // iOS dummy audio to unlock audio context
-    let audioBuffer = audioContext.createBuffer(2, SAMPLING_PER_FPS, SOUND_FREQUENCY);
-    let dummy = new Float32Array(SAMPLING_PER_FPS);
+    let audioBuffer = audioContext.createBuffer(2, samplesPerFrame, rate);
+    let dummy = new Float32Array(samplesPerFrame);
     dummy.fill(0);
     audioBuffer.getChannelData(0).set(dummy);
     audioBuffer.getChannelData(1).set(dummy);
     sound(audioBuffer);
+    // the worklet only uses the latency to refill after an underrun, the nominal NTSC frame will do
+    createAudioRing(audioContext, samplesPerFrame * AUDIO_LATENCY_FRAMES).then(function(ring) {
+        audioRing = ring;
+        if(ring) reportUnderruns = createUnderrunReporter(ring.underruns);
+        if(ring) console.log('audio: AudioWorklet' + (ring.shared ? ' (shared ring)' : ''));
+        if(worker && ring && ring.shared) {
+            worker.postMessage({ type: 'audio', ring: ring.ring, rate: rate, latency: AUDIO_LATENCY_FRAMES });
+        } else if(lowLatency && ring && ring.shared) {
+            audioPacer = createAudioPacer(gens, ring.push, rate, AUDIO_LATENCY_FRAMES);
+            audioStep();
+        } else if(lowLatency) {
+            console.warn('?latency=low needs a cross-origin isolated page and AudioWorklet');
+        }
+    });
+};
+
+// console helper: chaosIdle('vdp') also skips VDP status polling loops in this game,
+// chaosIdle('off') disables idle skipping for it, chaosIdle('ram') restores the default
+window.chaosIdle = function(name) {
+    const mode = IDLE_MODES.indexOf(name);
+    if(!romHeader || mode < 0) return false;
+    setIdleMode(romHeader, name);
+    if(worker) worker.postMessage({ type: 'idle', mode: mode });
+    else gens._set_idle_skip(mode);
+    return true;
+};
+
+// speed and audio mode to the core (or the worker) and the AudioWorklet; pitch-correct audio
+// needs the AudioWorklet, tape-style is used without it
+const applySpeed = function() {
+    const tape = speedTape || !audioRing;
+    if(worker) worker.postMessage({ type: 'speed', speed: speed, tape: tape });
+    else if(gens) gens._set_audio_speed(tape ? speed : 1);
+    if(audioRing) audioRing.stretch(tape ? 0 : speed);
+    if(audioPacer) audioPacer.reset();
 };
 
-const loadRom = function(bytes) {
-    romdata = new Uint8Array(gens.HEAPU8.buffer, gens._get_rom_buffer_ref(bytes.byteLength), bytes.byteLength);
-    romdata.set(new Uint8Array(bytes));
+// console helper: chaosSpeed(0.5) -> slow motion, chaosSpeed(2, 'pitch') -> double speed at the
+// normal pitch; 0.25 to 4, the mode ('tape' or 'pitch') is kept when left out
+window.chaosSpeed = function(next, mode) {
+    speed = Math.max(SPEEDS[0], Math.min(SPEEDS[SPEEDS.length - 1], next || 1));
+    if(mode) speedTape = mode !== 'pitch';
+    applySpeed();
+    return speed;
+};
+
+// console helper: chaosNtsc('composite'), 'svideo', 'rgb', 'mono' or 'off'
+window.chaosNtsc = function(name) {
+    const mode = NTSC_MODES.indexOf(name);
+    if(mode < 0) return false;
+    if(mode && (outputScale & 1)) console.warn('chaosNtsc() needs ?scale=2 or ?scale=4');
+    ntscMode = mode;
+    if(worker) worker.postMessage({ type: 'ntsc', mode: mode });
+    else if(initialized) return gens._set_ntsc(mode) !== 0;
+    return true;
+};
+
+// 'file' (a ROM, .zip or .gz) is streamed into the core (romstream.js), by the worker in
+// worker mode
+const loadRom = async function(file) {
+    const rom = await openRom(file);
+    if(!rom) return;
+    romHeader = await readRomStart(rom, 0x200);
+    const idle = idleMode(romHeader);
+    // picked before the core was ready: the ROM waits for it
+    await coreReady;
+    if(worker) {
+        canvas.style.display = 'block';
+        initialized = true;
+        initAudio();
+        worker.postMessage({ type: 'rom', file: file, idle: idle, rate: audioContext.sampleRate });
+        if(ntscMode) worker.postMessage({ type: 'ntsc', mode: ntscMode });
+        then = Date.now();
+        loop();
+        return;
+    }
+    if(disc) {
+        disc.close();
+        disc = null;
+    }
+    let loaded = await streamRom(gens, file);
+    if(loaded && gens._rom_needs_full_core()) {
+        // Mega CD BOOTROM or SVP cartridge: the ROM goes again into the full core (core.js)
+        console.log('rom: ' + file.name + ' needs the full core');
+        fullCore = true;
+        try {
+            initCore(await loadCore(coreBuild, true));
+            loaded = await streamRom(gens, file);
+        } catch(error) {
+            console.warn('rom: ' + file.name + ',', error);
+            loaded = false;
+        }
+    }
+    if(!loaded) {
+        console.warn('rom: cannot load ' + file.name);
+        return;
+    }
+    gens._set_idle_skip(idle);
+    romFile = file;
+    romIdle = idle;
     canvas.style.display = 'block';
     initialized = true;
     // init audio (user gesture from file picker satisfies browser policy)
     initAudio();
     // start immediately
     start();
+    if(useTwin) startTwin();
+};
+
+// 'files' (a cue sheet or .iso, its tracks and the CD BIOS) are streamed into the full core
+// as the drive reads them (cdstream.js); the twin does not run discs
+const loadDisc = async function(files) {
+    await coreReady;
+    if(worker) {
+        console.warn('disc: Mega CD discs need main thread mode');
+        return;
+    }
+    if(disc) disc.close();
+    disc = null;
+    try {
+        if(!fullCore) {
+            fullCore = true;
+            initCore(await loadCore(coreBuild, true));
+        }
+        disc = openDisc(gens, files);
+        if(!await disc.boot()) {
+            console.warn('disc: cannot load ' + disc.name + ' (is the CD BIOS among the picked files?)');
+            disc.close();
+            disc = null;
+            return;
+        }
+    } catch(error) {
+        console.warn('disc: ' + discImage(files).name + ',', error);
+        return;
+    }
+    romHeader = null;
+    romFile = null;
+    canvas.style.display = 'block';
+    initialized = true;
+    initAudio();
+    start();
+};
+
+// the twin canvas sits right of the main one, at the same size
+const startTwin = async function() {
+    if(!twinCanvas) {
+        twinCanvas = document.createElement('canvas');
+        twinCanvas.setAttribute('width', canvas.width);
+        twinCanvas.setAttribute('height', canvas.height);
+        twinCanvas.title = 'clean twin (no chaos)';
+        canvas.after(twinCanvas);
+    }
+    twinCanvas.style.cssText = canvas.style.cssText;
+    twinCanvas.style.display = 'inline-block';
+    canvas.style.display = 'inline-block';
+    twin = null;
+    const instance = await createTwin(coreBuild, fullCore, romFile, romIdle, twinCanvas, outputScale);
+    if(!instance) {
+        console.warn('twin: cannot load ' + romFile.name);
+        return;
+    }
+    // both start from power on: reset the main core like Tab does
+    gens._chaos_queue_clear();
+    gens._chaos_reset();
+    if(learned) learned.close();
+    gens._start();
+    openGameBackup();
+    twin = instance;
+};
+
+// shows or hides the memory view; false when it cannot be shown
+const showMemoryView = function(on) {
+    if(on && worker) {
+        showChaosMessage('Memory view: main thread only');
+        return false;
+    }
+    if(on && !memoryView) {
+        const view = document.createElement('canvas');
+        view.title = 'VRAM tiles, palettes (click for the next), 68k RAM, Z80 RAM, VSRAM';
+        view.style.width = '512px';
+        view.style.height = '512px';
+        view.style.imageRendering = 'pixelated';
+        view.style.verticalAlign = 'top';
+        memoryView = createMemoryView(view);
+        if(!memoryView) {
+            showChaosMessage('Memory view: no WebGL');
+            return false;
+        }
+        view.addEventListener('click', () => memoryView.nextPalette());
+        canvas.after(view);
+    }
+    memoryViewShown = on;
+    if(memoryView) memoryView.canvas.style.display = on ? 'inline-block' : 'none';
+    if(on) canvas.style.display = 'inline-block';
+    return true;
 };
 
 // canvas setting
 (function() {
     canvas = document.getElementById('screen');
-    canvas.setAttribute('width', CANVAS_WIDTH);
-    canvas.setAttribute('height', CANVAS_HEIGHT);
-    canvas.style.width = '1280px';
-    canvas.style.height = '960px';
+    canvas.setAttribute('width', FRAME_WIDTH * outputScale);
+    canvas.setAttribute('height', FRAME_HEIGHT * outputScale);
+    canvas.style.width = FRAME_WIDTH * 4 + 'px';
+    canvas.style.height = FRAME_HEIGHT * 4 + 'px';
+    canvas.style.imageRendering = 'pixelated';
     let pixelRatio = window.devicePixelRatio ? window.devicePixelRatio : 1;
-    if(pixelRatio > 1 && window.screen.width < CANVAS_WIDTH) {
-        canvas.style.width = CANVAS_WIDTH + "px";
-        canvas.style.height = CANVAS_HEIGHT + "px";
+    if(pixelRatio > 1 && window.screen.width < FRAME_WIDTH * 2) {
+        canvas.style.width = FRAME_WIDTH * 2 + "px";
+        canvas.style.height = FRAME_HEIGHT * 2 + "px";
+    }
+    if(!useWorker) {
+        canvasContext = canvas.getContext('2d');
     }
-    canvasContext = canvas.getContext('2d');
-    canvasImageData = canvasContext.createImageData(CANVAS_WIDTH, CANVAS_HEIGHT);
     // for fps print
     fps = 0;
     frame = FPS;
     startTime = new Date().getTime();
 })();
 
-// init wasm module
-wasm().then(function(module) {
+// chaos PRNG seed: pass ?seed=N to replay a glitch session
+const seedParam = new URLSearchParams(location.search).get('seed');
+const chaosSeed = seedParam !== null ? (parseInt(seedParam, 10) >>> 0) : ((Math.random() * 0x100000000) >>> 0);
+console.log('chaos seed: ' + chaosSeed);
+
+// resolved once the core is initialized (main thread) or the worker reports ready
+let coreLoaded;
+const coreReady = new Promise(resolve => { coreLoaded = resolve; });
+// time of the ROM selection, until its first frame is drawn (logged in main thread mode)
+let romPickedTime = 0;
+
+// listen for ROM file selection, from the start: a ROM picked while the core is still
+// compiling is opened right away and streamed in once the core is ready (loadRom()); a
+// selection with a cue sheet or .iso in it is a Mega CD disc (loadDisc())
+const listenRomFile = function() {
+    document.getElementById('rom-file').addEventListener('change', function(e) {
+        const files = Array.from(e.target.files);
+        if(!files.length) return;
+        document.getElementById('rom-picker').style.display = 'none';
+        romPickedTime = performance.now();
+        if(discImage(files)) loadDisc(files);
+        else loadRom(files[0]);
+    });
+};
+listenRomFile();
+
+// battery saves are written a little after the game, and at once when the page goes away
+document.addEventListener('visibilitychange', function() {
+    setBackground(document.visibilityState === 'hidden');
+    if(document.visibilityState !== 'hidden') return;
+    if(worker) worker.postMessage({ type: 'backup-flush' });
+    else if(backup) backup.flush();
+    if(learned) learned.flush();
+});
+
+// hidden tab: run on without drawing, or pause with the audio output (see power.js); shown
+// again, the clocks restart from now instead of catching up on the time spent hidden
+const setBackground = function(hidden) {
+    const next = hidden && initialized ? backgroundState(backgroundParam, audioContext, netplay || broadcast) : null;
+    if(next === background) return;
+    if(audioContext && next === 'pause') audioContext.suspend();
+    else if(audioContext && background === 'pause') audioContext.resume();
+    background = next;
+    if(worker) {
+        worker.postMessage({ type: 'background', state: next });
+        return;
+    }
+    if(next === 'run') backgroundLoop();
+    if(next) return;
+    then = Date.now();
+    soundShedTime = 0;
+    // the sound hack reads the fps of the last second
+    fps = FPS;
+    frame = 0;
+    startTime = then;
+    if(audioPacer) audioPacer.reset();
+    if(presenter) presenter.invalidate();
+};
+
+// console helper: chaosPower('saver') holds the governor at frame skip with the lower audio
+// quality, chaosPower('normal') lets it go back to full quality
+window.chaosPower = function(name) {
+    const mode = POWER_MODES.indexOf(name);
+    if(mode < 0) return false;
+    powerMode = mode;
+    if(worker) worker.postMessage({ type: 'power', level: POWER_LEVELS[mode] });
+    else if(gens) gens._governor_set_minimum(POWER_LEVELS[mode]);
+    return true;
+};
+
+// worker mode: input and chaos commands are shared with the worker, screenshots come back as blobs
+if(useWorker) {
+    worker = new Worker(new URL('./worker.js', import.meta.url));
+    chaosShared = new SharedArrayBuffer(CHAOS_QUEUE_BYTES);
+    const offscreen = canvas.transferControlToOffscreen();
+    worker.postMessage({ type: 'init', canvas: offscreen, input: inputBlock.bits.buffer, chaos: chaosShared,
+        seed: chaosSeed, webgl: useWebGL, gpu: useGPU, profile: useProfile, build: coreBuild, jit: useJit, governor: useGovernor,
+        lineCache: useLineCache, scale: outputScale, power: POWER_LEVELS[powerMode] }, [offscreen]);
+    worker.onmessage = function(e) {
+        if(e.data.type === 'ready') {
+            chaosRegister(e.data.effects);
+            coreLoaded();
+        } else if(e.data.type === 'started') {
+            romCrc = e.data.crc;
+        } else if(e.data.type === 'state') {
+            if(e.data.bytes) storeSlotState(e.data.crc, e.data.slot, e.data.bytes);
+            else showChaosMessage('State ' + (e.data.slot + 1) + ' not saved');
+        } else if(e.data.type === 'state-loaded') {
+            showChaosMessage('State ' + (e.data.slot + 1) + (e.data.loaded ? ' loaded' : ' not loaded'));
+        } else if(e.data.type === 'screenshot') {
+            saveScreenshot(URL.createObjectURL(e.data.blob));
+        } else if(e.data.type === 'clip') {
+            clipEncoderRef().gif(e.data, FPS);
+        } else if(e.data.type === 'capture-data' && captureFiles && captureFiles[e.data.stream]) {
+            captureFiles[e.data.stream].append(e.data.parts);
+        } else if(e.data.type === 'capture-end' && captureFiles && captureFiles[e.data.stream]) {
+            const file = captureFiles[e.data.stream];
+            delete captureFiles[e.data.stream];
+            saveCapture(file.finish(e.data.end), file.extension);
+            if(!Object.keys(captureFiles).length) captureFiles = null;
+        }
+    };
+    let ua = navigator.userAgent
+    if(ua.match(/Safari/) && !ua.match(/Chrome/) && !ua.match(/Edge/)) {
+        isSafari = true;
+    }
+    console.log('emulator running in worker');
+}
+
+// set up a core instance as 'gens'; also run for the full core when it replaces the default one
+// (loadRom()), the console helpers below always use the current 'gens'
+const initCore = function(module) {
     gens = module;
     gens._init();
+    if(useJit && !enableJit(gens)) console.warn('jit: not available in this build');
+    gens._governor_enable(useGovernor ? 1 : 0);
+    gens._governor_set_minimum(POWER_LEVELS[powerMode]);
+    if(audioContext) gens._set_audio_rate(audioContext.sampleRate, 0);
+    gens._chaos_seed(chaosSeed);
+    gens.inputBits = inputBlock.bits;
+    gens.chaosKeys = inputBlock.keys;
+    gens._set_input_live(1);
+    chaosQueue = gens._chaos_command_queue();
+    chaosQueueSize = gens._chaos_command_queue_size();
+    chaosWrite = createChaosWriter(() => gens.HEAPU8.buffer, chaosQueue, chaosQueueSize);
+    if(chaosBindTable) uploadChaosBindings(gens, chaosBindTable);
+};
+
+// init wasm module
+if(!useWorker) loadCore(coreBuild).then(function(module) {
+    initCore(module);
     console.log(gens);
 
-    // listen for ROM file selection
-    document.getElementById('rom-file').addEventListener('change', function(e) {
-        let file = e.target.files[0];
-        if(!file) return;
-        let reader = new FileReader();
-        reader.onload = function() {
-            document.getElementById('rom-picker').style.display = 'none';
-            loadRom(reader.result);
+    // console helper: chaosBenchKernels(iterations) -> ns per KB for each bulk kernel
+    window.chaosBenchKernels = function(iterations) {
+        const names = ['shift', 'shift_blocks', 'rotate', 'xor', 'nibble_swap'];
+        const results = new Float32Array(gens.HEAPF32.buffer, gens._chaos_bench_kernels(iterations || 100), names.length);
+        const table = {};
+        names.forEach((name, i) => { table[name] = results[i].toFixed(1) + ' ns/KB'; });
+        console.table(table);
+        return table;
+    };
+
+    const effects = [];
+    for(let id = 0; id < gens._chaos_effect_count(); id++) {
+        effects.push({ name: cString(gens._chaos_effect_name(id)),
+            kind: gens._chaos_effect_kind(id), targets: gens._chaos_effect_targets(id) });
+    }
+    chaosRegister(effects);
+
+    // console helper: chaosSchedule('randomize_cram', 112, 0) -> raster-timed effect, returns a handle
+    window.chaosSchedule = function(name, line, every, intensity) {
+        const id = chaosEffects.findIndex(effect => effect.name === name);
+        if(id < 0) return -1;
+        return gens._chaos_schedule(id, line, every || 0, intensity === undefined ? 1 : intensity);
+    };
+    // console helper: chaosAtCycle('random_register_corruption', 100 * 3420 + 1200, true) -> effect
+    // applied at that master cycle of the active display (3420 per line), every frame if repeat;
+    // returns a handle for chaosUnschedule()
+    window.chaosAtCycle = function(name, cycle, repeat, intensity) {
+        const id = chaosEffects.findIndex(effect => effect.name === name);
+        if(id < 0) return -1;
+        return gens._chaos_at_cycle(id, cycle, repeat ? 1 : 0, intensity === undefined ? 1 : intensity);
+    };
+    // console helper: chaosUndo(3) -> takes back the last 3 chaos effects, returns how many were
+    // (the log empties at each checkpoint)
+    window.chaosUndo = function(count) {
+        return gens._chaos_undo(count === undefined ? 1 : count);
+    };
+    // console helper: chaosWatchdog(true) -> the last checkpoint is restored whenever the game
+    // has been dead for 60 frames (halted, stopped, an exception storm or a stuck loop), or over
+    // 'frames' frames; false only reports; returns the checkpoints restored so far
+    window.chaosWatchdog = function(restore, frames) {
+        gens._chaos_watchdog_set(frames === undefined ? -1 : frames, restore ? 1 : 0);
+        return gens._chaos_watchdog_restores();
+    };
+    // console helper: chaosCheat(n) -> makes cheat code set n (0-255, filled by random_cheats or
+    // cycle_cheats) the active one, -1 turns the codes off
+    window.chaosCheat = function(set) {
+        gens._chaos_cheat_select(set);
+        return gens._chaos_cheat_active();
+    };
+    // console helper: chaosSpread('invert_vram', 16) -> the bulk VRAM effect sweeps VRAM over
+    // 16 frames (4KB per frame) instead of all at once; 1 restores it
+    window.chaosSpread = function(name, frames) {
+        const id = chaosEffects.findIndex(effect => effect.name === name);
+        return id >= 0 && gens._chaos_set_spread(id, frames) !== 0;
+    };
+    window.chaosUnschedule = function(handle) {
+        if(handle === undefined) gens._chaos_schedule_clear();
+        else gens._chaos_unschedule(handle);
+    };
+
+    // console helpers: chaosPresetBaseline() on a clean frame, some chaos, chaosPresetCapture(0) ->
+    // patch size of what changed in VRAM/CRAM/VSRAM/VDP registers since (chaos_preset.h), then
+    // chaosPresetApply(0) or chaosPresetSticky(0, true) (every frame) on any scene;
+    // chaosPreset(0) -> the patch bytes to keep, chaosPreset(0, bytes) loads them back
+    const CHAOS_PRESET_SIZE = 0x4000;
+    window.chaosPresetBaseline = function() {
+        gens._chaos_preset_baseline();
+    };
+    window.chaosPresetCapture = function(slot) {
+        return gens._chaos_preset_capture(slot);
+    };
+    window.chaosPresetApply = function(slot) {
+        return gens._chaos_preset_apply(slot) !== 0;
+    };
+    window.chaosPresetSticky = function(slot, on) {
+        gens._chaos_preset_sticky(slot, on ? 1 : 0);
+    };
+    window.chaosPreset = function(slot, bytes) {
+        const data = gens._chaos_preset_data(slot);
+        if(!data) return null;
+        if(bytes) {
+            if(bytes.length > CHAOS_PRESET_SIZE) return false;
+            gens.HEAPU8.set(bytes, data);
+            return gens._chaos_preset_commit(slot, bytes.length) !== 0;
+        }
+        return gens.HEAPU8.slice(data, data + gens._chaos_preset_size(slot));
+    };
+
+    // console helper: chaosProgram(0, 'stripes', source) -> effect id of a user effect written
+    // in the core's bytecode (chaosvm.js, chaos_vm.h), then chaosApply('stripes') or a binding
+    // to that id runs it like a built-in one; an empty source frees the slot
+    window.chaosProgram = function(slot, name, source) {
+        if(slot < 0 || slot >= CHAOS_VM_PROGRAMS) return -1;
+        const result = loadChaosProgram(gens, slot, assembleChaosProgram(source || ''));
+        if(result !== true) throw new Error('instruction ' + result + ' rejected by the core');
+        const id = chaosEffects.length + slot;
+        chaosPrograms[slot] = source ? { name: name, sync: gens._chaos_effect_targets(id) & CHAOS_TARGET_VIDEO ? CHAOS_SYNC_VBLANK : CHAOS_SYNC_FRAME } : undefined;
+        return id;
+    };
+
+    // console helpers: chaosMod('fm_corruption_level', 'lfo', { rate: 1 / 120 }) -> slot of a
+    // modulator on a chaos parameter (chaos_mod.h): an effect name (its gain) or a named one.
+    // Sources 'lfo' (shape 0-3 sine/triangle/square/saw, rate in cycles per frame), 'env' (rate,
+    // rate2: 1 / attack and release frames, shape: key on channel bits, or chaosModTrigger()),
+    // 'walk' (rate: step) and 'audio' (shape: 0 rms, 1 fm, 2 psg, 3 dac, 4+ band; rate: gain,
+    // rate2: smoothing); options.line: also per raster event line, options.fire: fire the effect
+    // every frame at its gain. chaosParam(name, base) sets a base value, chaosModClear() resets
+    const chaosParamIndex = function(name) {
+        for(let i = 0; gens._chaos_param_name(i); i++) {
+            if(cString(gens._chaos_param_name(i)) === name) return i;
+        }
+        return -1;
+    };
+    const MOD_SOURCES = { lfo: 1, env: 2, walk: 3, audio: 4 };
+    window.chaosMod = function(param, source, options) {
+        const target = chaosParamIndex(param);
+        options = options || {};
+        if(target < 0 || !MOD_SOURCES[source]) return -1;
+        const flags = (options.line ? 1 : 0) | (options.fire ? 2 : 0);
+        return gens._chaos_mod_add(MOD_SOURCES[source], options.shape || 0, target, flags,
+            options.rate || 0, options.rate2 || 0, options.depth === undefined ? 1 : options.depth);
+    };
+    window.chaosModTrigger = function(slot) {
+        gens._chaos_mod_trigger(slot);
+    };
+    window.chaosModClear = function(slot) {
+        if(slot === undefined) gens._chaos_mod_clear();
+        else gens._chaos_mod_set(slot, 0, 0, 0, 0, 0, 0, 0);
+    };
+    window.chaosParam = function(name, base) {
+        const param = chaosParamIndex(name);
+        if(param < 0) return undefined;
+        if(base !== undefined) gens._chaos_param_set(param, base);
+        return gens._chaos_param_base(param);
+    };
+
+    // console helpers: chaosMidi('note', 36, 'invert_vram', { line: true }) -> a MIDI note fires the
+    // effect (velocity as intensity, line timing), chaosMidi('cc', 74, 'fm_corruption_level') ->
+    // a knob sets the parameter (an effect name: its gain); options.channel (0-15, all by
+    // default), options.range ([0, 1] by default). chaosAxis(2, 'post_rgb_split_level') maps
+    // axis 2 of the gamepad the same way, chaosControlsClear() drops the mappings
+    const chaosControlMap = function(kind, number, name, options) {
+        options = options || {};
+        const effect = chaosEffects.findIndex(effect => effect.name === name);
+        const param = chaosParamIndex(name);
+        const range = options.range || [0, 1];
+        // notes fire effects, knobs and axes set parameters, whichever the name has
+        if(effect >= 0 && (kind === 'note' || param < 0)) {
+            return chaosControls.map(kind, number, options.channel, effect, 0, chaosEffects[effect].sync, range, options.line);
+        }
+        return param >= 0 && chaosControls.map(kind, number, options.channel, CHAOS_OP_PARAM, param, 0, range, false);
+    };
+    window.chaosMidi = async function(kind, number, name, options) {
+        if((kind !== 'note' && kind !== 'cc') || number >>> 0 > 127) return false;
+        if(!await chaosControls.midi()) return false;
+        return chaosControlMap(kind, number, name, options);
+    };
+    window.chaosAxis = function(axis, name, options) {
+        return axis >>> 0 < AXIS_MAX && chaosControlMap('axis', axis, name, options);
+    };
+    window.chaosControlsClear = function() {
+        chaosControls.clear();
+    };
+
+    // console helper: chaosStats() -> call count and total time per chaos effect
+    window.chaosStats = function() {
+        const stats = new Float32Array(gens.HEAPF32.buffer, gens._chaos_stats(), chaosEffects.length * 2);
+        const table = {};
+        chaosEffects.forEach((effect, i) => {
+            if(stats[i * 2]) table[effect.name] = { calls: stats[i * 2], usec: stats[i * 2 + 1].toFixed(1) };
+        });
+        console.table(table);
+        return table;
+    };
+
+    // console helper: chaosTelemetry() -> this session's frame time histograms (run, emulation,
+    // render, audio, chaos) and counters; 'bytes' is the compact export for the site to report
+    window.chaosTelemetry = function() {
+        const telemetry = readTelemetry(gens);
+        const table = {};
+        for(const name in telemetry.histograms) {
+            const histogram = telemetry.histograms[name];
+            table[name] = { samples: histogram.samples, p50: histogram.p50 + ' us', p95: histogram.p95 + ' us', p99: histogram.p99 + ' us' };
+        }
+        console.table(table);
+        console.table(telemetry.counters);
+        return telemetry;
+    };
+
+    // console helper: chaosVdpCounters() -> VDP port accesses, DMA transfers (count and length)
+    // and FIFO stalls of the last frame (CHAOS_PROFILE builds)
+    window.chaosVdpCounters = function() {
+        if(!gens._get_vdp_counters_ref) {
+            console.warn('VDP counters need a CHAOS_PROFILE build');
+            return null;
+        }
+        const counts = new Uint32Array(gens.HEAPU8.buffer, gens._get_vdp_counters_ref(), gens._vdp_counter_count());
+        const table = {};
+        counts.forEach((count, id) => table[cString(gens._vdp_counter_name(id))] = count);
+        console.table(table);
+        return table;
+    };
+
+    // console helper: chaosRamCandidates() -> work RAM bytes ranked as game variables, which
+    // flip_game_logic_variables and critical_ram_scramble aim at
+    window.chaosRamCandidates = function() {
+        const count = gens._chaos_ram_candidate_count();
+        const ranked = new Uint32Array(gens.HEAPU8.buffer, gens._chaos_ram_candidates(), count);
+        const rows = Array.from(ranked, entry => ({
+            address: (0xff0000 + ((entry & 0xffff) ^ 1)).toString(16), score: entry >>> 16 }));
+        console.table(rows);
+        return rows;
+    };
+
+    // console helper: chaosSoundDriver() -> what the Z80 RAM effects aim at: the sound driver
+    // structures found in Z80 RAM (offsets, -1 when not found), see chaos_zdrv.h
+    window.chaosSoundDriver = function() {
+        const fields = new Int32Array(gens.HEAPU8.buffer, gens._chaos_zdrv_ref(), 19);
+        const hex = offset => offset < 0 ? null : offset.toString(16).padStart(4, '0');
+        const info = {
+            running: (fields[0] & 1) !== 0, sequencer: (fields[0] & 2) !== 0, streamer: (fields[0] & 4) !== 0,
+            passes: fields[1], tempo: hex(fields[2]), tempoCounter: hex(fields[3]),
+            fmTable: hex(fields[4]), fmNotes: fields[5], psgTable: hex(fields[6]), psgNotes: fields[7],
+            samplePointer: hex(fields[8]), dacWrites: fields[9],
+            tracks: Array.from(fields.subarray(11, 11 + fields[10]), hex)
         };
-        reader.readAsArrayBuffer(file);
-    });
+        console.log(info);
+        return info;
+    };
+
+    // console helper: chaosVdpLog() -> the VDP writes of the last frame (ports, DMA runs, registers)
+    window.chaosVdpLog = function() {
+        const targets = ['vram', 'cram', 'vsram', 'reg', 'vram_run'];
+        const logSize = 0x1000;
+        const count = gens._chaos_vdplog_count();
+        const records = new DataView(gens.HEAPU8.buffer, gens._chaos_vdplog_records(), logSize * 8);
+        const rows = [];
+        for(let n = Math.max(0, count - logSize); n < count; n++) {
+            const offset = (n & (logSize - 1)) * 8;
+            const target = records.getUint8(offset);
+            rows.push({ line: records.getUint16(offset + 6, true), target: targets[target],
+                addr: records.getUint16(offset + 2, true).toString(16), data: records.getUint16(offset + 4, true).toString(16),
+                step: target === 4 ? records.getUint8(offset + 1) : undefined });
+        }
+        if(count > logSize) console.warn('vdp log: ' + (count - logSize) + ' older records lost');
+        return rows;
+    };
+
+    // console helper: chaosVramHeat() starts counting the writes to each VRAM pattern and returns
+    // the counts so far (Uint16Array, 0x800 patterns); chaosVramHeat(false) stops and clears them
+    window.chaosVramHeat = function(on) {
+        if(on === false) {
+            gens._chaos_vdplog_watch(0);
+            gens._chaos_vdplog_heat_reset();
+            return null;
+        }
+        gens._chaos_vdplog_watch(1);
+        return new Uint16Array(gens.HEAPU8.buffer, gens._chaos_vdplog_heat(), 0x800).slice();
+    };
+
+    // console helper: chaosVramMap() -> patterns per class in the VRAM usage map the tile
+    // effects use, and the map itself (one class per 32-byte pattern)
+    window.chaosVramMap = function() {
+        const classes = ['unused', 'tiles', 'plane_a', 'plane_b', 'window', 'sat', 'hscroll'];
+        const map = new Uint8Array(gens.HEAPU8.buffer, gens._chaos_vram_map(), 0x800).slice();
+        const table = {};
+        classes.forEach(name => { table[name] = 0; });
+        map.forEach(type => { table[classes[type]]++; });
+        console.table(table);
+        return map;
+    };
+
+    // console helpers: chaosRecord(seed) restarts the ROM and records the session (pads, chaos
+    // commands and calls) until chaosRecordStop(), which saves it as a .cdrm file;
+    // chaosReplay(file, frame) restarts and replays one, skipping ahead to 'frame' without drawing
+    window.chaosRecord = function(seed) {
+        if(!initialized) return false;
+        gens._record_start(seed === undefined ? chaosSeed : seed >>> 0);
+        if(audioPacer) audioPacer.reset();
+        showChaosMessage('Recording');
+        return true;
+    };
+    window.chaosRecordStop = function() {
+        const size = gens._chaos_record_stop();
+        if(!size) return 0;
+        const ptr = gens._chaos_record_data();
+        saveCapture(new Blob([gens.HEAPU8.slice(ptr, ptr + size)]), 'cdrm');
+        showChaosMessage('Recording saved');
+        return size;
+    };
+    window.chaosReplay = async function(file, frame) {
+        const bytes = new Uint8Array(file instanceof Blob ? await file.arrayBuffer() : file);
+        const ptr = gens._chaos_replay_buffer(bytes.length);
+        if(!initialized || !ptr) return false;
+        gens.HEAPU8.set(bytes, ptr);
+        if(!gens._replay_start()) {
+            console.warn('replay: not a recording of this ROM');
+            return false;
+        }
+        if(audioPacer) audioPacer.reset();
+        if(frame) gens._replay_seek(frame);
+        showChaosMessage('Replay');
+        return gens._chaos_record_frame();
+    };
+
+    // console helpers (CHAOS_WATCH=ON builds): chaosWatch('w', 0xff0000, 0xffffff, 'dec') -> watch id,
+    // logging the 68k accesses ('e'xecute, 'r'ead, 'w'rite) in the range that match the condition
+    // (any, eq, ne, lt, gt, changed, inc, dec; against ref & mask); chaosWatchHits() -> last hits
+    if(gens._add_watch) {
+        const conds = ['any', 'eq', 'ne', 'lt', 'gt', 'changed', 'inc', 'dec'];
+        window.chaosWatch = function(kinds, start, end, cond, ref, mask) {
+            const type = (kinds.includes('e') ? 1 : 0) | (kinds.includes('r') ? 2 : 0) | (kinds.includes('w') ? 4 : 0);
+            return gens._add_watch(type, start, end === undefined ? start : end, Math.max(conds.indexOf(cond || 'any'), 0),
+                ref || 0, mask === undefined ? 0xffffffff : mask);
+        };
+        window.chaosUnwatch = function(id) {
+            if(id === undefined) gens._clear_watches();
+            else gens._remove_watch(id);
+        };
+        window.chaosWatchHits = function(count) {
+            const size = 256, total = gens._get_watch_total();
+            const hits = new Uint32Array(gens.HEAPU8.buffer, gens._get_watch_hits_ref(), size * 7);
+            const rows = [];
+            for(let n = Math.max(total - Math.min(count || 32, size), 0); n < total; n++) {
+                const hit = hits.subarray((n % size) * 7, (n % size) * 7 + 7);
+                rows.push({ id: hit[0], kind: hit[1] === 1 ? 'e' : hit[1] === 2 ? 'r' : 'w', width: hit[2],
+                    address: hit[3].toString(16), value: hit[4].toString(16), old: hit[5].toString(16), pc: hit[6].toString(16) });
+            }
+            console.table(rows);
+            return rows;
+        };
+    }
 
+    // console helpers (CHAOS_PC_PROFILE=ON builds): chaosProfilePC(4096) samples the 68k PC every
+    // 4096 master clock cycles until chaosProfilePC(0), chaosHotspots(20) -> hottest 256-byte regions,
+    // chaosHotspots(20, true) -> hottest PCs, over everything sampled since chaosProfilePC('reset')
+    if(gens._set_pc_profile) {
+        window.chaosProfilePC = function(period) {
+            if(period === 'reset') gens._reset_pc_profile();
+            else gens._set_pc_profile(period === undefined ? 4096 : period);
+        };
+        window.chaosHotspots = function(count, exact) {
+            const total = gens._get_pc_profile_total();
+            const found = gens._pc_profile_report(count || 20, exact ? 1 : 0);
+            const spots = new Uint32Array(gens.HEAPU8.buffer, gens._get_pc_profile_ref(), found * 2);
+            const rows = [];
+            for(let i = 0; i < found; i++) {
+                const address = spots[i * 2];
+                rows.push({ address: address === 0xffffffff ? 'elsewhere' : address.toString(16).padStart(6, '0'),
+                    samples: spots[i * 2 + 1], percent: +(spots[i * 2 + 1] * 100 / Math.max(total, 1)).toFixed(2) });
+            }
+            console.table(rows);
+            return rows;
+        };
+    }
+
+    // console helper: chaosStems({ fm6: 0, psg: 0.5 }) -> stem mode with per-stem gains
+    // (keys fm1-fm6, dac, psg1-psg3, noise, or fm / psg for the whole chip), chaosStems(false) -> mixed output
+    window.chaosStems = function(gains) {
+        if(gains === false) return !gens._set_audio_stems(0);
+        if(!gens._set_audio_stems(1)) return false;
+        const names = ['fm1', 'fm2', 'fm3', 'fm4', 'fm5', 'fm6', 'dac', 'psg1', 'psg2', 'psg3', 'noise'];
+        const groups = { fm: names.slice(0, 6), psg: names.slice(7) };
+        const gain = new Float32Array(gens.HEAPF32.buffer, gens._get_audio_stem_gain_ref(), gens._audio_stem_count());
+        Object.entries(gains || {}).forEach(([name, value]) => {
+            (groups[name] || [name]).forEach(stem => {
+                const i = names.indexOf(stem);
+                if(i >= 0) gain[i] = value;
+            });
+        });
+        return true;
+    };
+
+    // console helper: chaosMemoryView(true) shows the live memory view, chaosMemoryView(false)
+    // hides it
+    window.chaosMemoryView = function(on) {
+        return showMemoryView(on !== false);
+    };
+
+    // console helper: chaosTwin(true) restarts the game next to a clean copy of itself,
+    // chaosTwin(false) drops the copy
+    window.chaosTwin = function(on) {
+        if(!on) {
+            twin = null;
+            if(twinCanvas) twinCanvas.style.display = 'none';
+            canvas.style.display = 'block';
+            return true;
+        }
+        if(!romFile) return false;
+        startTwin();
+        return true;
+    };
+
+    // console helper: chaosVariations('random_register_corruption', [0.2, 1], 3) -> the game
+    // as it is now plays 3 seconds in up to 9 instances, each with that effect on another seed
+    // (and intensity along the range, or the one given), in a grid under the screen; clicking
+    // a cell loads its state. Returns the instance count; chaosVariations(false) closes the grid
+    window.chaosVariations = function(name, intensity, seconds) {
+        if(variations) variations.close();
+        variations = null;
+        if(name === false) return 0;
+        const id = chaosEffects.findIndex(effect => effect.name === name);
+        // the instances start from a state and the ROM file, which a disc does not have
+        if(id < 0 || !romFile || disc) return 0;
+        variations = createVariations({
+            build: coreBuild, full: fullCore, file: romFile, idle: romIdle, state: saveCoreState(gens),
+            effect: id, sync: chaosEffects[id].sync, seed: (Math.random() * 0x100000000) >>> 0,
+            intensity: intensity === undefined ? 1 : intensity, seconds: seconds || 3
+        }, canvas, function(bytes, seed) {
+            variations = null;
+            showChaosMessage(loadCoreState(gens, bytes) ? 'Variation ' + seed + ' loaded' : 'Variation not loaded');
+        });
+        return variations.count;
+    };
+
+    // console helpers: chaosNetHost() -> an offer for the other player, who pastes it into
+    // chaosNetJoin(offer) -> an answer to paste back into chaosNetAccept(answer); the game is
+    // restarted on both sides (same ROM needed) and the guest plays pad 2. chaosNetStats() ->
+    // frame, last remote frame and rollbacks; chaosNetLeave() ends the session
+    let netplayHost = null;
+    let netplaySession = null;
+    const netplayEvents = {
+        onStart: function() {
+            netplay = netplaySession;
+            if(audioPacer) audioPacer.reset();
+            showChaosMessage('Netplay: player ' + (netplay.player + 1));
+        },
+        onEnd: function(reason) {
+            netplay = null;
+            netplaySession = null;
+            showChaosMessage('Netplay ended: ' + reason);
+        }
+    };
+    window.chaosNetHost = async function() {
+        // a disc holds frames back while blocks come in, which the rollback cannot follow
+        if(!initialized || disc) return null;
+        netplayHost = await hostNetplay(gens, chaosSeed, idleMode(romHeader), netplayEvents);
+        netplaySession = netplayHost.session;
+        return netplayHost.offer;
+    };
+    window.chaosNetAccept = function(answer) {
+        if(!netplayHost) return false;
+        netplayHost.accept(answer);
+        netplayHost = null;
+        return true;
+    };
+    window.chaosNetJoin = async function(offer) {
+        if(!initialized || disc) return null;
+        const guest = await joinNetplay(gens, offer, netplayEvents);
+        guest.session.then(session => { netplaySession = session; });
+        return guest.answer;
+    };
+    window.chaosNetStats = function() {
+        return netplay ? netplay.stats() : null;
+    };
+    window.chaosNetLeave = function() {
+        if(netplaySession) netplaySession.close();
+    };
+
+    // console helpers: chaosBroadcast(address, seed) restarts the game and streams the session
+    // (not the video) to the viewers of 'address', a BroadcastChannel name or a ws:// relay;
+    // chaosSpectate(address) watches it, the game restarts and replays it here.
+    // chaosBroadcastStats() -> frame and stream size; chaosBroadcastStop() ends either side
+    let broadcastChannel = null;
+    const closeBroadcast = function() {
+        if(broadcast) broadcast.stop();
+        if(spectator) spectator.close();
+        if(broadcastChannel) broadcastChannel.close();
+        broadcast = spectator = broadcastChannel = null;
+    };
+    window.chaosBroadcast = function(address, seed) {
+        if(!initialized) return false;
+        closeBroadcast();
+        broadcastChannel = openTransport(address || 'chaosdrive');
+        broadcast = startBroadcast(gens, broadcastChannel, seed === undefined ? chaosSeed : seed);
+        if(audioPacer) audioPacer.reset();
+        showChaosMessage('Broadcasting');
+        return true;
+    };
+    window.chaosSpectate = function(address) {
+        if(!initialized) return false;
+        closeBroadcast();
+        broadcastChannel = openTransport(address || 'chaosdrive');
+        spectator = watchBroadcast(gens, broadcastChannel, {
+            onStart: function() {
+                if(audioPacer) audioPacer.reset();
+                showChaosMessage('Watching');
+            },
+            onEnd: reason => showChaosMessage('Broadcast ended: ' + reason),
+            onDesync: frame => console.warn('broadcast: desynchronized at frame ' + frame)
+        });
+        return true;
+    };
+    window.chaosBroadcastStats = function() {
+        return broadcast ? broadcast.stats() : spectator ? spectator.stats() : null;
+    };
+    window.chaosBroadcastStop = closeBroadcast;
+
+    // console helper: chaosMemory() -> linear memory of each core instance, in bytes (all of the
+    // emulated state and caches of an instance live in its own memory), then the layout of the
+    // main one: its large regions (memory_report()) and the static data / stack / heap split
+    window.chaosMemory = function() {
+        const sizes = { main: gens.HEAPU8.length };
+        if(twin) sizes.twin = twin.gens.HEAPU8.length;
+        console.table(sizes);
+        const count = gens._memory_report();
+        const report = new Uint32Array(gens.HEAPU8.buffer, gens._get_memory_report_ref(), count * 3);
+        const regions = [];
+        for(let i = 0; i < count; i++) {
+            regions.push({ name: cString(report[i * 3]), address: '0x' + report[i * 3 + 1].toString(16), size: report[i * 3 + 2] });
+        }
+        console.table(regions.sort((a, b) => b.size - a.size));
+        const layout = new Uint32Array(gens.HEAPU8.buffer, gens._get_memory_layout_ref(), 4);
+        console.table({ static: layout[0], stack: layout[1] - layout[0], heap: layout[2] - layout[1], free: layout[3] - layout[2] });
+        return sizes;
+    };
+
+    coreLoaded();
 });
 
+// after every gens._start(): the core starts with blank backup memory and nothing learned, the
+// battery save and the learned profile come back from IndexedDB before the next frame
+const openGameBackup = function() {
+    if(backup) backup.close();
+    const opened = backup = openBackup(gens);
+    learned = openLearned(gens);
+    backupReady = false;
+    Promise.all([backup.ready, learned.ready]).then(function([blocks]) {
+        if(backup !== opened) return;
+        backupReady = true;
+        if(blocks) showChaosMessage('Battery save loaded');
+    });
+};
+
 const start = function() {
     if(!initialized) return;
     canvasContext.clearRect(0, 0, canvas.width, canvas.height);
     // emulator start
+    gens._set_output_scale(outputScale);
+    if(learned) learned.close();
     gens._start();
+    romCrc = gens._get_rom_crc();
+    openGameBackup();
+    if(clip) clip.close();
+    clip = useGPU ? null : createClipRing(gens);
+    applySpeed();
     // vram view
-    vram = new Uint8ClampedArray(gens.HEAPU8.buffer, gens._get_frame_buffer_ref(), CANVAS_WIDTH * CANVAS_HEIGHT * 4);
+    vram = new Uint8ClampedArray(gens.HEAPU8.buffer, gens._get_frame_buffer_ref(), FRAME_WIDTH * FRAME_HEIGHT * outputScale * outputScale * 4);
+    dirtyLines = new Uint8Array(gens.HEAPU8.buffer, gens._get_dirty_lines_ref(), FRAME_HEIGHT);
+    frameInfo = new Int32Array(gens.HEAPU8.buffer, gens._get_frame_info_ref(), 4);
+    if(!presenter) {
+        glPresenter = useWebGL ? createGLPresenter(outputScale) : useGPU ? createGPURenderer(outputScale) : null;
+        if((useWebGL || useGPU) && !glPresenter) console.warn((useGPU ? 'WebGL2' : 'WebGL') + ' not available, using 2D canvas');
+        presenter = createCanvasPresenter(canvasContext, glPresenter, outputScale);
+    }
+    presenter.invalidate();
+    gens._set_indexed_output(glPresenter ? 1 : 0);
+    if(ntscMode && glPresenter) console.warn('?ntsc needs the 2D canvas renderer');
+    if(ntscMode) gens._set_ntsc(ntscMode);
+    if(useLineCache) gens._set_line_cache(1);
+    if(glPresenter) {
+        indexBuffer = new Uint8Array(gens.HEAPU8.buffer, gens._get_index_buffer_ref(), GL_INDEX_PITCH * GL_INDEX_LINES);
+        palette = new Uint8Array(gens.HEAPU8.buffer, gens._get_palette_ref(), GL_PALETTE_SIZE * 4);
+        postLevels = new Float32Array(gens.HEAPF32.buffer, gens._chaos_post_params_ref(), GL_POST_LEVELS);
+        if(useGPU) glPresenter.attach(gens);
+    }
+    if(useProfile && !gens._get_frame_profile_ref) console.warn('frame profile needs a CHAOS_PROFILE build');
+    if(useProfile && gens._get_frame_profile_ref) {
+        profileNames = [];
+        for(let id = 0; id < gens._frame_profile_count(); id++) profileNames.push(cString(gens._frame_profile_name(id)));
+        frameProfile = new Float32Array(gens.HEAPF32.buffer, gens._get_frame_profile_ref(), profileNames.length + 2);
+    }
     // audio view
-    audio_l = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_l_ref(), SAMPLING_PER_FPS);
-    audio_r = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_r_ref(), SAMPLING_PER_FPS);
-    // input
-    input = new Float32Array(gens.HEAPF32.buffer, gens._get_input_buffer_ref(), GAMEPAD_API_INDEX);
+    audio_l = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_l_ref(), gens._get_web_audio_size());
+    audio_r = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_r_ref(), gens._get_web_audio_size());
+    audioEffects = new Float32Array(gens.HEAPF32.buffer, gens._chaos_audio_out_params_ref(), AUDIO_EFFECT_LEVELS);
     // iOS
     let ua = navigator.userAgent
     if(ua.match(/Safari/) && !ua.match(/Chrome/) && !ua.match(/Edge/)) {
@@ -170,41 +1200,14 @@ const start = function() {
     loop();
 };
 
+// gamepads have no events: polled on every animation frame
 const keyscan = function() {
-    input.fill(0);
-    // gamepad
-    let gamepads = navigator.getGamepads();
-    if(gamepads.length > 0) {
-        let gamepad = gamepads[0];
-        if(gamepad != null) {
-            if(isSafari) {
-                input[7] = gamepad.axes[5] * -1;
-                input[6] = gamepad.axes[4];
-            } else if(gamepad.id.match(/Microsoft/)) {
-                gamepad.axes.forEach((value, index) => {
-                    input[index] = value;
-                });
-            } else {
-                input[7] = gamepad.axes[1];
-                input[6] = gamepad.axes[0];
-            }
-            gamepad.buttons.forEach((button, index) => {
-                input[index + 8] = button.value;
-            });
-        }
-    }
-    // keyboard
-    // D-Pad: arrow keys
-    if(keys.has('ArrowUp'))    input[7] = -1;
-    if(keys.has('ArrowDown'))  input[7] = 1;
-    if(keys.has('ArrowLeft'))  input[6] = -1;
-    if(keys.has('ArrowRight')) input[6] = 1;
-    // A, B, C
-    if(keys.has('KeyA')) input[8 + 2] = 1; // A
-    if(keys.has('KeyS')) input[8 + 3] = 1; // B
-    if(keys.has('KeyD')) input[8 + 1] = 1; // C
-    // START
-    if(keys.has('Enter')) input[8 + 7] = 1;
+    const gamepad = navigator.getGamepads()[0];
+    padBits = gamepad ? gamepadBits(gamepad, isSafari) : 0;
+    padCodes = gamepadCodes(gamepad);
+    chaosControls.poll(gamepad);
+    writeInput(inputBlock, keyBits(keys) | padBits, inputNow());
+    writeChaosKeys(inputBlock, chaosKeySlots, keys, padCodes);
 };
 
 const sound = function(audioBuffer) {
@@ -221,90 +1224,229 @@ const sound = function(audioBuffer) {
     }
 };
 
-// ChaosDrive: process chaos key bindings each frame
-const chaosScan = function() {
-    if(!gens) return;
-
+// ChaosDrive: key bindings, resolved to registry ids once the module is loaded and uploaded
+// to the core as a table (chaosbind.js), which fires the effects from the shared key state.
+// Held effects repeat every CHAOS_BIND_REPEAT frames while the key is down (mode 'hold',
+// 'repeat' sets another rate), the others fire once per press; mode 'toggle' alternates a
+// persistent effect on and off. A 'Gamepad<index>' code binds a gamepad button.
+const chaosBindings = [
     // --- VSRAM / H-Scroll / VDP mode / PSG ---
-    if(keys.has('KeyQ'))         { gens._chaos_corrupt_vsram();          showChaosMessage('VSRAM corrupted (melt)'); }
-    if(keys.has('KeyW'))         { gens._chaos_hscroll_waviness();       showChaosMessage('H-scroll waviness'); }
-    if(keys.has('KeyE') && !prevKeys.has('KeyE')) {
-        gens._chaos_flip_vdp_mode(); showChaosMessage('VDP mode flipped');
-    }
-    if(keys.has('KeyZ'))         { gens._chaos_psg_noise_blast();        showChaosMessage('PSG NOISE BLAST'); }
+    { code: 'KeyQ',         effect: 'corrupt_vsram',              message: 'VSRAM corrupted (melt)' },
+    { code: 'KeyW',         effect: 'hscroll_waviness',           message: 'H-scroll waviness' },
+    { code: 'KeyE',         effect: 'flip_vdp_mode',              message: 'VDP mode flipped' },
+    { code: 'KeyZ',         effect: 'psg_noise_blast',            message: 'PSG NOISE BLAST' },
+    // --- VRAM ---
+    { code: 'KeyO',         effect: 'shift_vram_up',              message: 'VRAM shifted up' },
+    { code: 'KeyL',         effect: 'shift_vram_down',            message: 'VRAM shifted down' },
+    { code: 'KeyK',         effect: 'shift_vram_left',            message: 'VRAM shifted left' },
+    { code: 'Semicolon',    effect: 'shift_vram_right',           message: 'VRAM shifted right' },
+    { code: 'KeyI',         effect: 'shift_vram_down_random',     message: 'VRAM shifted random' },
+    { code: 'KeyP',         effect: 'corrupt_vram_one_byte',      message: 'VRAM corrupted (1 byte)' },
+    { code: 'Backslash',    effect: 'invert_vram',                message: 'VRAM inverted' },
+    // --- CRAM ---
+    { code: 'BracketLeft',  effect: 'randomize_cram',             message: 'CRAM randomized' },
+    { code: 'BracketRight', effect: 'shift_cram_up',              message: 'CRAM shifted up' },
+    { code: 'KeyY',         effect: 'cram_corruption', intensity: 1, message: 'CRAM corruption ON' },
+    { code: 'KeyU',         effect: 'cram_corruption', intensity: 0, message: 'CRAM corruption OFF' },
+    // --- Sprite / Scroll ---
+    { code: 'KeyR',         effect: 'scroll_register_fuzzing',    message: 'Scroll registers fuzzed' },
+    { code: 'KeyT',         effect: 'sprite_attribute_scramble',  message: 'Sprite attributes scrambled' },
+    // --- Audio ---
+    { code: 'KeyX',         effect: 'fm_corruption', intensity: 1, message: 'FM corruption ON' },
+    { code: 'KeyC',         effect: 'fm_corruption', intensity: 0, message: 'FM corruption OFF' },
+    { code: 'KeyV',         effect: 'corrupt_dac_data',           message: 'DAC data corrupted' },
+    { code: 'KeyB',         effect: 'bitcrush_audio_memory',      message: 'Audio bitcrushed' },
+    { code: 'KeyN',         effect: 'detune_fm_registers',        message: 'FM detuned' },
+    { code: 'Comma',        effect: 'shift_audio_memory_up',      message: 'Audio memory shifted up' },
+    { code: 'Period',       effect: 'shift_audio_memory_down',    message: 'Audio memory shifted down' },
+    // --- General Mayhem ---
+    { code: 'KeyF',         effect: 'corrupt_68k_ram_one_byte',   message: '68K RAM corrupted' },
+    { code: 'KeyG',         effect: 'critical_ram_scramble',      message: 'Critical RAM scrambled' },
+    { code: 'KeyH',         effect: 'program_counter_increment',  message: 'PC incremented' },
+    { code: 'KeyJ',         effect: 'random_register_corruption', message: 'Register corrupted' },
+    { code: 'Slash',        effect: 'flip_game_logic_variables',  message: 'Game variables flipped' },
+];
 
-    // --- VRAM manipulation (hold-to-repeat) ---
-    if(keys.has('KeyO'))         { gens._chaos_shift_vram_up();          showChaosMessage('VRAM shifted up'); }
-    if(keys.has('KeyL'))         { gens._chaos_shift_vram_down();        showChaosMessage('VRAM shifted down'); }
-    if(keys.has('KeyK'))         { gens._chaos_shift_vram_left();        showChaosMessage('VRAM shifted left'); }
-    if(keys.has('Semicolon'))    { gens._chaos_shift_vram_right();       showChaosMessage('VRAM shifted right'); }
-    if(keys.has('KeyI'))         { gens._chaos_shift_vram_down_random(); showChaosMessage('VRAM shifted random'); }
-    if(keys.has('KeyP'))         { gens._chaos_corrupt_vram_one_byte();  showChaosMessage('VRAM corrupted (1 byte)'); }
+const CHAOS_KIND_HELD = 1;
+const CHAOS_TARGET_VIDEO = 0x000F; // VRAM | CRAM | VSRAM | VDP registers
+const CHAOS_SYNC_FRAME = 0;
+const CHAOS_SYNC_VBLANK = 1;
+const chaosEffects = [];
+// user programs by slot, effect id chaosEffects.length + slot ({ name, sync })
+const chaosPrograms = [];
+let chaosQueue = 0;
+let chaosQueueSize = 0;
+// MIDI and gamepad axis mappings (chaoscontrols.js), writing into the core's queue; the commands
+// of a netplay session go through the session, the controllers are left out of it
+let chaosWrite = null;
+const chaosControls = createChaosControls(() => netplay || spectator ? null : chaosWrite, () => frameInfo[3]);
+// binding table (kept for the full core), the bindings in it and their key slots
+let chaosBindTable = null;
+let chaosBound = [];
+let chaosKeySlots = new Map();
 
-    // --- VRAM invert (single press) ---
-    if(keys.has('Backslash') && !prevKeys.has('Backslash')) {
-        gens._chaos_invert_vram_contents(); showChaosMessage('VRAM inverted');
+// append a command to the core's chaos queue (applied by the next _tick()), chaosApply() on the console:
+// video effects run after VBlank DMA, everything else at the start of the frame
+// (in worker mode the shared queue is moved into the core's one before each frame)
+const chaosSubmit = function(id, intensity) {
+    const sync = (chaosEffects[id] || chaosPrograms[id - chaosEffects.length]).sync;
+    if(netplay) {
+        netplay.command(id, sync, intensity);
+    } else if(chaosShared) {
+        writeChaosCommand(chaosShared, 0, CHAOS_QUEUE_SIZE, id, sync, intensity);
+    } else {
+        writeChaosCommand(gens.HEAPU8.buffer, chaosQueue, chaosQueueSize, id, sync, intensity);
     }
+};
 
-    // --- CRAM (hold-to-repeat for [ and ]) ---
-    if(keys.has('BracketLeft'))  { gens._chaos_randomize_cram();  showChaosMessage('CRAM randomized'); }
-    if(keys.has('BracketRight')) { gens._chaos_shift_cram_up();   showChaosMessage('CRAM shifted up'); }
+window.chaosApply = function(name, intensity) {
+    let id = chaosEffects.findIndex(effect => effect.name === name);
+    if(id < 0) {
+        const slot = chaosPrograms.findIndex(program => program && program.name === name);
+        if(slot < 0) return false;
+        id = chaosEffects.length + slot;
+    }
+    chaosSubmit(id, intensity === undefined ? 1 : intensity);
+    return true;
+};
 
-    // --- CRAM persistent corruption (single press) ---
-    if(keys.has('KeyY') && !prevKeys.has('KeyY')) {
-        gens._chaos_enable_cram_corruption(); showChaosMessage('CRAM corruption ON');
+const cString = function(ptr) {
+    let str = '';
+    while(ptr && gens.HEAPU8[ptr]) str += String.fromCharCode(gens.HEAPU8[ptr++]);
+    return str;
+};
+
+// bind keys to effect ids from the registry ({ name, kind, targets } per id)
+const chaosRegister = function(effects) {
+    const ids = {};
+    effects.forEach((effect, id) => {
+        const video = effect.targets & CHAOS_TARGET_VIDEO;
+        chaosEffects.push({ name: effect.name, kind: effect.kind, sync: video ? CHAOS_SYNC_VBLANK : CHAOS_SYNC_FRAME });
+        ids[effect.name] = id;
+    });
+    const resolved = [];
+    for(const binding of chaosBindings) {
+        const id = ids[binding.effect];
+        if(id === undefined) {
+            console.warn('unknown chaos effect: ' + binding.effect);
+            continue;
+        }
+        resolved.push(Object.assign({ id: id, mode: effects[id].kind === CHAOS_KIND_HELD ? 'hold' : 'press' }, binding));
     }
-    if(keys.has('KeyU') && !prevKeys.has('KeyU')) {
-        gens._chaos_disable_cram_corruption(); showChaosMessage('CRAM corruption OFF');
+    const table = encodeChaosBindings(resolved);
+    chaosBindTable = table.bytes;
+    chaosBound = table.bindings;
+    chaosKeySlots = table.slots;
+    if(worker) {
+        worker.postMessage({ type: 'bindings', table: chaosBindTable, messages: chaosBound.map(binding => binding.message) });
+    } else {
+        uploadChaosBindings(gens, chaosBindTable);
     }
+};
 
-    // --- Sprite/Scroll (single press) ---
-    if(keys.has('KeyR') && !prevKeys.has('KeyR')) {
-        gens._chaos_scroll_register_fuzzing(); showChaosMessage('Scroll registers fuzzed');
+// ChaosDrive: front-end keys (screenshot, checkpoint, capture, states, replay clip, fast-forward, rewind),
+// checked each frame; the chaos bindings are evaluated by the core
+const chaosScan = function() {
+    if(!gens && !worker) return;
+
+    // --- Screenshot (single press) ---
+    if(keys.has('Digit1') && !prevKeys.has('Digit1')) {
+        // the last frame drawn, at 1x, encoded by the clip worker
+        const shot = !worker && clip && clipEncoderRef().png && clip.latest();
+        if(worker) worker.postMessage({ type: 'screenshot' });
+        else if(shot) clipEncoderRef().png(shot);
+        else canvas.toBlob(blob => saveCapture(blob, 'png'));
+        showChaosMessage('Screenshot saved');
     }
-    if(keys.has('KeyT') && !prevKeys.has('KeyT')) {
-        gens._chaos_sprite_attribute_scramble(); showChaosMessage('Sprite attributes scrambled');
+
+    // --- Instant replay clip (single press) ---
+    if(keys.has('Digit8') && !prevKeys.has('Digit8')) {
+        if(worker) worker.postMessage({ type: 'clip' });
+        else if(clip) clipEncoderRef().gif(clip.take(), FPS);
+        showChaosMessage('Saving the last ' + CLIP_SECONDS + 's');
     }
 
-    // --- Audio (single press for X, C; hold for V, B, N) ---
-    if(keys.has('KeyX') && !prevKeys.has('KeyX')) {
-        gens._chaos_enable_fm_corruption(); showChaosMessage('FM corruption ON');
+    // --- Memory view (single press) ---
+    if(keys.has('Digit9') && !prevKeys.has('Digit9')) {
+        if(showMemoryView(!memoryViewShown)) showChaosMessage(memoryViewShown ? 'Memory view' : 'Memory view off');
     }
-    if(keys.has('KeyC') && !prevKeys.has('KeyC')) {
-        gens._chaos_disable_fm_corruption(); showChaosMessage('FM corruption OFF');
+
+    // --- Undo the last chaos effect (single press) ---
+    if(keys.has('Digit0') && !prevKeys.has('Digit0')) {
+        if(worker) {
+            worker.postMessage({ type: 'undo' });
+            showChaosMessage('Chaos effect undone');
+        } else {
+            showChaosMessage(gens._chaos_undo(1) ? 'Chaos effect undone' : 'Nothing to undo');
+        }
     }
-    if(keys.has('KeyV'))         { gens._chaos_corrupt_dac_data();       showChaosMessage('DAC data corrupted'); }
-    if(keys.has('KeyB'))         { gens._chaos_bitcrush_audio_memory();  showChaosMessage('Audio bitcrushed'); }
-    if(keys.has('KeyN'))         { gens._chaos_detune_fm_registers();    showChaosMessage('FM detuned'); }
 
-    // --- Audio memory shift (single press) ---
-    if(keys.has('Comma') && !prevKeys.has('Comma')) {
-        gens._chaos_shift_audio_memory_up(); showChaosMessage('Audio memory shifted up');
+    // --- Chaos checkpoint / restore (single press) ---
+    if(keys.has('Digit2') && !prevKeys.has('Digit2')) {
+        if(worker) worker.postMessage({ type: 'checkpoint' });
+        else gens._chaos_checkpoint();
+        showChaosMessage('Checkpoint saved');
     }
-    if(keys.has('Period') && !prevKeys.has('Period')) {
-        gens._chaos_shift_audio_memory_down(); showChaosMessage('Audio memory shifted down');
+    if(keys.has('Digit3') && !prevKeys.has('Digit3')) {
+        if(worker) {
+            worker.postMessage({ type: 'restore' });
+            showChaosMessage('Checkpoint restored');
+        } else {
+            showChaosMessage(gens._chaos_restore() < 0 ? 'No checkpoint' : 'Checkpoint restored');
+        }
     }
 
-    // --- General mayhem (F, G hold; H, J, / single press) ---
-    if(keys.has('KeyF'))         { gens._chaos_corrupt_68k_ram_one_byte(); showChaosMessage('68K RAM corrupted'); }
-    if(keys.has('KeyG'))         { gens._chaos_critical_ram_scramble();    showChaosMessage('Critical RAM scrambled'); }
-    if(keys.has('KeyH') && !prevKeys.has('KeyH')) {
-        gens._chaos_program_counter_increment(); showChaosMessage('PC incremented');
+    // --- Session capture (single press) ---
+    if(keys.has('Digit4') && !prevKeys.has('Digit4')) {
+        if(captureFiles) {
+            stopCapture();
+            showChaosMessage('Capture saved');
+        } else {
+            startCapture();
+            showChaosMessage('Capture started');
+        }
     }
-    if(keys.has('KeyJ') && !prevKeys.has('KeyJ')) {
-        gens._chaos_random_register_corruption(); showChaosMessage('Register corrupted');
+
+    // --- Save state slots (single press) ---
+    if(keys.has('Digit5') && !prevKeys.has('Digit5') && romCrc !== null) {
+        if(worker) {
+            worker.postMessage({ type: 'state-save', slot: stateSlot });
+        } else {
+            const bytes = saveCoreState(gens);
+            if(bytes) storeSlotState(romCrc, stateSlot, bytes);
+            else showChaosMessage('State ' + (stateSlot + 1) + ' not saved');
+        }
+    }
+    if(keys.has('Digit6') && !prevKeys.has('Digit6') && romCrc !== null) {
+        loadSlotState(romCrc, stateSlot);
     }
-    if(keys.has('Slash') && !prevKeys.has('Slash')) {
-        gens._chaos_flip_game_logic_variables(); showChaosMessage('Game variables flipped');
+    if(keys.has('Digit7') && !prevKeys.has('Digit7')) {
+        stateSlot = (stateSlot + 1) % STATE_SLOTS;
+        showChaosMessage('State slot ' + (stateSlot + 1));
     }
 
-    // --- Screenshot (single press) ---
-    if(keys.has('Digit1') && !prevKeys.has('Digit1')) {
-        const link = document.createElement('a');
-        link.download = 'chaosdrive-' + Date.now() + '.png';
-        link.href = canvas.toDataURL('image/png');
-        link.click();
-        showChaosMessage('Screenshot saved');
+    // --- Fast-forward (held) ---
+    if(keys.has('Backquote') !== turbo) {
+        turbo = keys.has('Backquote');
+        if(worker) worker.postMessage({ type: 'turbo', on: turbo });
+        showChaosMessage(turbo ? 'Fast-forward' : 'Normal speed');
+    }
+
+    // --- Playback speed (single press) ---
+    for(const [code, dir] of [['Minus', -1], ['Equal', 1]]) {
+        if(keys.has(code) && !prevKeys.has(code)) {
+            const index = SPEEDS.indexOf(speed);
+            const next = SPEEDS[Math.max(0, Math.min(SPEEDS.length - 1, (index < 0 ? SPEEDS.indexOf(1) : index) + dir))];
+            if(next !== speed) window.chaosSpeed(next);
+            showChaosMessage('Speed ' + speed + 'x');
+        }
+    }
+
+    // --- Rewind (held) ---
+    if(keys.has('Backspace') !== rewinding) {
+        rewinding = keys.has('Backspace');
+        if(worker) worker.postMessage({ type: 'rewind', on: rewinding });
+        if(rewinding) showChaosMessage('Rewind');
     }
 
     // Update previous key state
@@ -312,45 +1454,205 @@ const chaosScan = function() {
     for(const k of keys) prevKeys.add(k);
 };
 
+// the serialized state is compressed and written by the store worker
+const storeSlotState = function(crc, slot, bytes) {
+    storeState(crc, slot, bytes).then(function() {
+        showChaosMessage('State ' + (slot + 1) + ' saved');
+    }, function(error) {
+        console.warn('state save: ' + error.message);
+        showChaosMessage('State ' + (slot + 1) + ' not saved');
+    });
+};
+
+// applied between two frames once fetched, unless another ROM was started meanwhile
+const loadSlotState = function(crc, slot) {
+    fetchState(crc, slot).then(function(bytes) {
+        if(crc !== romCrc) return;
+        if(!bytes) {
+            showChaosMessage('State ' + (slot + 1) + ' empty');
+        } else if(worker) {
+            worker.postMessage({ type: 'state-load', slot: slot, bytes: bytes }, [bytes]);
+        } else {
+            showChaosMessage(loadCoreState(gens, bytes) ? 'State ' + (slot + 1) + ' loaded' : 'State ' + (slot + 1) + ' not loaded');
+        }
+    }, function(error) {
+        console.warn('state load: ' + error.message);
+        showChaosMessage('State ' + (slot + 1) + ' not loaded');
+    });
+};
+
+const saveScreenshot = function(url) {
+    const link = document.createElement('a');
+    link.download = 'chaosdrive-' + Date.now() + '.png';
+    link.href = url;
+    link.click();
+};
+
+// GIFs and PNGs come back from the encoder worker
+const clipEncoderRef = function() {
+    if(!clipEncoder) clipEncoder = createClipEncoder((type, blob) => saveCapture(blob, type));
+    return clipEncoder;
+};
+
+const saveCapture = function(blob, extension) {
+    const link = document.createElement('a');
+    link.download = 'chaosdrive-' + Date.now() + '.' + extension;
+    link.href = URL.createObjectURL(blob);
+    link.click();
+    setTimeout(() => URL.revokeObjectURL(link.href), 1000);
+};
+
+// in worker mode the worker drains the rings and posts the chunks here
+const startCapture = function() {
+    captureFiles = {};
+    const streams = worker ? captureMask : gens._capture_start(captureMask);
+    for(const stream of [CAPTURE_VGM, CAPTURE_WAV]) {
+        if(streams & stream) captureFiles[stream] = createCaptureFile(stream);
+    }
+    if(worker) worker.postMessage({ type: 'capture', streams: streams });
+};
+
+const drainCaptureFiles = function() {
+    for(const stream in captureFiles) captureFiles[stream].append(drainCapture(gens, stream));
+};
+
+const stopCapture = function() {
+    if(worker) {
+        // files are saved on the worker's capture-end messages
+        worker.postMessage({ type: 'capture', streams: 0 });
+        return;
+    }
+    gens._capture_stop();
+    drainCaptureFiles();
+    for(const stream in captureFiles) {
+        const file = captureFiles[stream];
+        saveCapture(file.finish(finishCapture(gens, stream)), file.extension);
+    }
+    captureFiles = null;
+};
+
 const loop = function() {
     requestAnimationFrame(loop);
+    if(!background) clockStep();
+};
+
+// hidden tab running on (setBackground()): no animation frames, the clock is polled from a
+// timer, which is not throttled while the page plays audio
+const backgroundLoop = function() {
+    if(background !== 'run') return;
+    setTimeout(backgroundLoop, 4);
+    clockStep();
+};
+
+const clockStep = function() {
     now = Date.now();
     delta = now - then;
-    if (delta > INTERVAL && !pause) {
+    if(worker || audioPacer) {
+        // the worker paces itself, audioStep() runs the frames; only poll the gamepad and feed chaos commands from here
         keyscan();
         chaosScan();
-        // update
-        gens._tick();
-        then = now - (delta % INTERVAL);
-        // draw
-        canvasImageData.data.set(vram);
-        canvasContext.putImageData(canvasImageData, 0, 0);
-        // fps
-        frame++;
-        if(new Date().getTime() - startTime >= 1000) {
-            fps = frame;
-            frame = 0;
-            startTime = new Date().getTime();
-        }
-        // sound
-        gens._sound();
+        return;
+    }
+    const interval = INTERVAL / speed;
+    if (delta > interval && !pause) {
+        keyscan();
+        chaosScan();
+        // update: frames missed since the last tick are emulated without being drawn, as are
+        // all but the last of the frames of a refresh above 1x
+        const expected = Math.ceil(speed);
+        const frames = turbo ? TURBO_FRAMES : Math.min(Math.floor(delta / interval), MAX_FRAME_SKIP * expected);
+        if(!turbo && frames > expected) gens._telemetry_count(TELEMETRY_MISSED, frames - expected);
+        runFrames(frames);
+        then = now - (delta % interval);
+    }
+};
+
+// ?latency=low: polled from a timer so the ring is topped up between display refreshes; runs
+// the frames the audio output asks for, or on the 60Hz clock while it is not consuming
+// (suspended context) and when fast-forwarding
+const audioStep = function() {
+    setTimeout(audioStep, 2);
+    if(pause || background === 'pause' || !initialized) return;
+    let frames = turbo ? -1 : audioPacer.frames(MAX_FRAME_SKIP * Math.ceil(speed));
+    now = Date.now();
+    if(frames < 0) {
+        const interval = INTERVAL / speed;
+        delta = now - then;
+        if(delta <= interval) return;
+        frames = turbo ? TURBO_FRAMES : Math.min(Math.floor(delta / interval), MAX_FRAME_SKIP * Math.ceil(speed));
+        then = now - (delta % interval);
+    } else {
+        then = now;
+    }
+    if(frames > 0) runFrames(frames);
+};
+
+// emulate 'frames' frames (only the last one is drawn), then draw, sound and overlay
+const runFrames = function(frames) {
+    if(!backupReady) return;
+    // 0 while the disc drive waits for a block
+    if(disc && !disc.ready()) return;
+    if(rewinding) {
+        if(!gens._rewind_step()) showChaosMessage('Rewind limit');
+        frames = 1;
+    }
+    if(netplay) {
+        // 0 while the other player is a whole rollback window behind
+        frames = netplay.frames(frames, Atomics.load(inputBlock.bits, 0));
+        if(!frames) return;
+    }
+    if(spectator) {
+        // 0 while waiting for more of the stream
+        frames = spectator.frames(frames);
+        if(!frames) return;
+    }
+    chaosControls.frame(performance.now(), INTERVAL / speed);
+    gens._tick_n(frames, background ? TICK_RENDER_NONE : TICK_RENDER_LAST);
+    if(clip && !background) clip.record();
+    backup.frames();
+    if(broadcast) broadcast.frames();
+    const fired = gens._chaos_bind_take_fired();
+    if(fired >= 0) showChaosMessage(chaosBound[fired].message);
+    if(twin) twin.run(frames, Atomics.load(inputBlock.bits, 0));
+    // draw
+    if(!background) presenter.draw({ vram: vram, dirtyLines: dirtyLines, frameInfo: frameInfo, indexBuffer: indexBuffer, palette: palette, postLevels: postLevels });
+    if(memoryViewShown && !background) memoryView.draw(gens);
+    latencyMeter.frame(gens._input_seen_take());
+    if(romPickedTime) {
+        console.log('first frame ' + (performance.now() - romPickedTime).toFixed(0) + 'ms after the ROM selection');
+        romPickedTime = 0;
+    }
+    // fps
+    frame++;
+    if(new Date().getTime() - startTime >= 1000) {
+        fps = frame;
+        frame = 0;
+        startTime = new Date().getTime();
+    }
+    // sound
+    const samples = gens._sound();
+    const quality = gens._governor_take_change();
+    if(quality >= 0) showChaosMessage('Quality: ' + QUALITY_LEVELS[quality]);
+    if(captureFiles) drainCaptureFiles();
+    const rate = gens._get_audio_rate();
+    if(audioRing) {
+        if(rate === audioContext.sampleRate) audioRing.push(audio_l, audio_r, samples);
+        else audioRing.push(rateConverter.left, rateConverter.right, rateConverter.convert(audio_l, audio_r, samples, rate, audioContext.sampleRate));
+        audioRing.effects(audioEffects);
+        reportUnderruns(gens);
+    } else if(fps < Math.min(FPS, Math.floor(FPS * speed)) || turbo) {
         // sound hack
-        if(fps < FPS) {
-            soundShedTime = 0;
-        } else {
-            let audioBuffer = audioContext.createBuffer(2, SAMPLING_PER_FPS, SOUND_FREQUENCY);
-            audioBuffer.getChannelData(0).set(audio_l);
-            audioBuffer.getChannelData(1).set(audio_r);
-            sound(audioBuffer);
-        }
-        // ChaosDrive status + FPS
-        canvasContext.font = "12px monospace";
-        canvasContext.fillStyle = "#0f0";
-        canvasContext.fillText("FPS " + fps, 0, 480 - 16);
-        if(chaosMessageTimer > 0) {
-            canvasContext.fillStyle = "#ff0";
-            canvasContext.fillText(chaosMessage, 0, 480 - 32);
-            chaosMessageTimer--;
-        }
+        soundShedTime = 0;
+    } else if(samples > 0) {
+        let audioBuffer = audioContext.createBuffer(2, samples, rate);
+        audioBuffer.getChannelData(0).set(audio_l.subarray(0, samples));
+        audioBuffer.getChannelData(1).set(audio_r.subarray(0, samples));
+        sound(audioBuffer);
+    }
+    if(!background) {
+        presenter.overlay(fps, chaosMessageTimer > 0 ? chaosMessage : '');
+        if(frameProfile) presenter.profile(frameProfile, profileNames);
+        if(useProfile) presenter.latency(latencyMeter.average());
     }
+    if(chaosMessageTimer > 0) chaosMessageTimer--;
 };
@@ -0,0 +1,138 @@
+// Pad 1 input as the core's INPUT_* bits (core/input_hw/input.h). The bits are kept in a small
+// block that the key handlers update as soon as the events fire (gamepads, which have no
+// events, on every animation frame); the core reads it whenever the game reads the pad
+// (set_input_live(), Module.inputBits), so a press reaches the game without waiting for the
+// next tick. The block is a SharedArrayBuffer in worker mode.
+//
+// The same block carries the keys and gamepad buttons bound to chaos effects, one bit per key
+// slot (chaosbind.js), which the core evaluates its binding table against once per frame
+// (Module.chaosKeys).
+//
+// Block layout: Int32 [0] pad bits, [1] bits of the press being timed (0: none),
+// Float64 [1] time of that press (performance.timeOrigin + now, comparable across threads),
+// Int32 [4] [5] chaos key slots 0-31, 32-63.
+
+export const INPUT_UP = 0x0001;
+export const INPUT_DOWN = 0x0002;
+export const INPUT_LEFT = 0x0004;
+export const INPUT_RIGHT = 0x0008;
+export const INPUT_B = 0x0010;
+export const INPUT_C = 0x0020;
+export const INPUT_A = 0x0040;
+export const INPUT_START = 0x0080;
+export const INPUT_Z = 0x0100;
+export const INPUT_Y = 0x0200;
+export const INPUT_X = 0x0400;
+export const INPUT_MODE = 0x0800;
+
+export const INPUT_BLOCK_BYTES = 24;
+
+// latency figure: average of the last presses; a press the game never read (released
+// before the next pad read) is dropped after the timeout
+const LATENCY_SAMPLES = 16;
+const LATENCY_TIMEOUT = 500;
+
+const KEY_BITS = {
+    ArrowUp: INPUT_UP, ArrowDown: INPUT_DOWN, ArrowLeft: INPUT_LEFT, ArrowRight: INPUT_RIGHT,
+    KeyA: INPUT_A, KeyS: INPUT_B, KeyD: INPUT_C, Enter: INPUT_START
+};
+
+// standard gamepad buttons 0-7
+const BUTTON_BITS = [INPUT_X, INPUT_C, INPUT_A, INPUT_B, INPUT_Y, INPUT_Z, INPUT_MODE, INPUT_START];
+
+export const createInputBlock = function(buffer) {
+    return { bits: new Int32Array(buffer, 0, 2), time: new Float64Array(buffer, 8, 1),
+        keys: new Int32Array(buffer, 16, 2) };
+};
+
+export const inputNow = function() {
+    return performance.timeOrigin + performance.now();
+};
+
+// bits of the held keys (a Set of KeyboardEvent.code)
+export const keyBits = function(keys) {
+    let bits = 0;
+    for(const code of keys) bits |= KEY_BITS[code] || 0;
+    return bits;
+};
+
+// bits of a gamepad: the D-pad axes are digital (exactly -1 / 1)
+export const gamepadBits = function(gamepad, isSafari) {
+    let x, y;
+    if(isSafari) {
+        x = gamepad.axes[4];
+        y = -gamepad.axes[5];
+    } else if(gamepad.id.match(/Microsoft/)) {
+        x = gamepad.axes[6];
+        y = gamepad.axes[7];
+    } else {
+        x = gamepad.axes[0];
+        y = gamepad.axes[1];
+    }
+    let bits = 0;
+    if(y === -1) bits |= INPUT_UP;
+    else if(y === 1) bits |= INPUT_DOWN;
+    if(x === -1) bits |= INPUT_LEFT;
+    else if(x === 1) bits |= INPUT_RIGHT;
+    gamepad.buttons.forEach((button, index) => {
+        if(index < BUTTON_BITS.length && button.value) bits |= BUTTON_BITS[index];
+    });
+    return bits;
+};
+
+// codes of the pressed gamepad buttons ('Gamepad<index>'), for chaos bindings
+export const gamepadCodes = function(gamepad) {
+    const codes = [];
+    if(gamepad) gamepad.buttons.forEach((button, index) => {
+        if(button.pressed) codes.push('Gamepad' + index);
+    });
+    return codes;
+};
+
+// store the chaos key slots held down ('codes': iterables of key and button codes, 'slots':
+// code -> slot)
+export const writeChaosKeys = function(block, slots, ...codes) {
+    const words = [0, 0];
+    for(const list of codes) {
+        for(const code of list) {
+            const slot = slots.get(code);
+            if(slot !== undefined) words[slot >> 5] |= 1 << (slot & 31);
+        }
+    }
+    Atomics.store(block.keys, 0, words[0]);
+    Atomics.store(block.keys, 1, words[1]);
+};
+
+// store the pad bits; a new press starts a latency measurement unless one is running
+export const writeInput = function(block, bits, time) {
+    const pressed = bits & ~Atomics.exchange(block.bits, 0, bits);
+    if(pressed && !Atomics.load(block.bits, 1)) {
+        block.time[0] = time;
+        Atomics.store(block.bits, 1, pressed);
+    }
+};
+
+// input-to-photon estimate, on the side presenting the frames: from the press event to the
+// hand-over to the compositor of the first frame whose emulation read the pressed bits
+// (input_seen_take() of the core); the display's own scan-out comes on top
+export const createLatencyMeter = function(block) {
+    const samples = [];
+    return {
+        // after each presented frame, seen: the bits the game read while emulating it
+        frame: function(seen) {
+            const pending = Atomics.load(block.bits, 1);
+            if(!pending) return;
+            const elapsed = inputNow() - block.time[0];
+            if(!(seen & pending) && elapsed < LATENCY_TIMEOUT) return;
+            if(Atomics.compareExchange(block.bits, 1, pending, 0) !== pending) return;
+            if(seen & pending) {
+                samples.push(elapsed);
+                if(samples.length > LATENCY_SAMPLES) samples.shift();
+            }
+        },
+        // ms, 0 before the first press
+        average: function() {
+            return samples.length ? samples.reduce((sum, value) => sum + value, 0) / samples.length : 0;
+        }
+    };
+};
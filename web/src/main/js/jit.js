@@ -0,0 +1,155 @@
+// 68k trace compiler (CHAOS_JIT builds, ?jit=1). The core's decode cache hands over every
+// trace of ROM instructions that was entered M68K_JIT_THRESHOLD times (see m68k.h); it is
+// turned into a small WebAssembly module that does what m68k_run() does for each of them
+// (set REG_PC/REG_IR, call the handler, which adds its cycles) with a direct call to each handler
+// instead of the jump table's call_indirect, and stops after the first instruction that
+// leaves the trace, switches the bank or reaches the target cycle count. The handlers are the
+// core's own functions, imported from its table, so the interpreter still does all the work.
+
+// m68k_jit_layout() (enum in m68k.h)
+const LAYOUT_PC = 0;
+const LAYOUT_IR = 1;
+const LAYOUT_CYCLES = 2;
+const LAYOUT_END = 3;
+const LAYOUT_MEMORY_MAP = 4;
+const LAYOUT_MAP_STRIDE = 5;
+const LAYOUT_SIZE = 6;
+
+const OP_BR_IF = 0x0d;
+const OP_CALL = 0x10;
+const OP_END = 0x0b;
+const OP_I32_LOAD = 0x28;
+const OP_I32_STORE = 0x36;
+const OP_I32_CONST = 0x41;
+const OP_I32_NE = 0x47;
+const OP_I32_GE_U = 0x4f;
+
+const uleb = function(out, value) {
+    value >>>= 0;
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if(value) byte |= 0x80;
+        out.push(byte);
+    } while(value);
+};
+
+const sleb = function(out, value) {
+    value |= 0;
+    for(;;) {
+        const byte = value & 0x7f;
+        value >>= 7;
+        if((value === 0 && !(byte & 0x40)) || (value === -1 && (byte & 0x40))) {
+            out.push(byte);
+            return;
+        }
+        out.push(byte | 0x80);
+    }
+};
+
+const name = function(out, text) {
+    uleb(out, text.length);
+    for(let i = 0; i < text.length; i++) out.push(text.charCodeAt(i));
+};
+
+const section = function(out, id, body) {
+    out.push(id);
+    uleb(out, body.length);
+    for(const byte of body) out.push(byte);
+};
+
+// module for one trace: imports the memory and the handlers, exports run()
+const assemble = function(layout, base, ops, count) {
+    const handlers = [];
+    const imports = new Map();
+    const code = [0]; // no locals
+    const constant = value => { code.push(OP_I32_CONST); sleb(code, value); };
+    const load = address => { constant(address); code.push(OP_I32_LOAD, 2); uleb(code, 0); };
+    const store = (address, value) => { constant(address); constant(value); code.push(OP_I32_STORE, 2); uleb(code, 0); };
+
+    for(let i = 0; i < count; i++) {
+        const pc = ops[i * 3], ir = ops[i * 3 + 1], handler = ops[i * 3 + 2];
+        if(!imports.has(handler)) {
+            imports.set(handler, handlers.length);
+            handlers.push(handler);
+        }
+        // decode from the cache, execute (the handler uses up its cycles)
+        store(layout[LAYOUT_PC], pc + 2);
+        store(layout[LAYOUT_IR], ir);
+        code.push(OP_CALL);
+        uleb(code, imports.get(handler));
+        if(i === count - 1) break;
+        // stop when out of cycles, off the trace or the bank was switched
+        const next = ops[(i + 1) * 3];
+        load(layout[LAYOUT_CYCLES]);
+        load(layout[LAYOUT_END]);
+        code.push(OP_I32_GE_U, OP_BR_IF, 0);
+        load(layout[LAYOUT_PC]);
+        constant(next);
+        code.push(OP_I32_NE, OP_BR_IF, 0);
+        load(layout[LAYOUT_MEMORY_MAP] + ((next >>> 16) & 0xff) * layout[LAYOUT_MAP_STRIDE]);
+        constant(base);
+        code.push(OP_I32_NE, OP_BR_IF, 0);
+    }
+    code.push(OP_END);
+
+    const out = [0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00];
+    section(out, 1, [1, 0x60, 0, 0]); // type 0: [] -> []
+    const importSection = [];
+    uleb(importSection, handlers.length + 1);
+    name(importSection, 'env');
+    name(importSection, 'memory');
+    importSection.push(0x02, 0x00, 0x00); // memory, min 0 pages
+    handlers.forEach((handler, i) => {
+        name(importSection, 'h');
+        name(importSection, String(i));
+        importSection.push(0x00, 0x00); // function of type 0
+    });
+    section(out, 2, importSection);
+    section(out, 3, [1, 0]);
+    const exportSection = [1];
+    name(exportSection, 'run');
+    exportSection.push(0x00);
+    uleb(exportSection, handlers.length);
+    section(out, 7, exportSection);
+    const codeSection = [1];
+    uleb(codeSection, code.length);
+    section(out, 10, codeSection.concat(code));
+    return { bytes: new Uint8Array(out), handlers: handlers };
+};
+
+// installs the compiler into a core built with -DCHAOS_JIT=ON; false when not available
+export const enableJit = function(gens) {
+    if(!gens._set_m68k_jit || !gens.addFunction || !gens.wasmTable || !gens.wasmMemory) return false;
+    // a shared memory can only be imported with its maximum size: not handled
+    if(typeof SharedArrayBuffer !== 'undefined' && gens.wasmMemory.buffer instanceof SharedArrayBuffer) return false;
+    const layoutRef = gens._get_m68k_jit_layout();
+    if(!layoutRef) return false;
+    const layout = new Uint32Array(gens.HEAPU8.buffer, layoutRef, LAYOUT_SIZE).slice();
+    const slots = [];
+    let failed = false;
+
+    // called from inside m68k_run(): compiled synchronously (a trace of up to 32 instructions
+    // stays well below the 4KB limit browsers put on synchronous compiles on the main thread)
+    const compile = function(slot, base, opsRef, count) {
+        if(failed || !count) return 0;
+        try {
+            const ops = new Uint32Array(gens.HEAPU8.buffer, opsRef, count * 3);
+            const trace = assemble(layout, base, ops, count);
+            const imports = { env: { memory: gens.wasmMemory }, h: {} };
+            trace.handlers.forEach((handler, i) => { imports.h[i] = gens.wasmTable.get(handler); });
+            const instance = new WebAssembly.Instance(new WebAssembly.Module(trace.bytes), imports);
+            if(slots[slot]) gens.removeFunction(slots[slot]);
+            slots[slot] = gens.addFunction(instance.exports.run, 'v');
+            return slots[slot];
+        } catch(error) {
+            // keep interpreting
+            console.warn('jit: disabled,', error);
+            failed = true;
+            return 0;
+        }
+    };
+
+    gens._set_m68k_jit(gens.addFunction(compile, 'iiiii'));
+    return true;
+};
@@ -0,0 +1,98 @@
+// Per-ROM learned profile (see learned.h): what the core worked out about a game (its RAM
+// variables, the ROM pages its code runs from, its hot traces) goes back into the core right
+// after start(), before the first frame, and is written again every SAVE_INTERVAL ms, when the
+// page is hidden and before another start(), if it changed. Keyed by ROM CRC, one small record
+// per game. Usable from the page and from worker.js.
+
+const DB_NAME = 'chaosdrive-learned';
+const DB_STORE = 'profiles';
+const LEARNED_SIZE = 4096;
+const SAVE_INTERVAL = 30000;
+
+let db = null;
+
+const openDb = function() {
+    if(!db) {
+        db = new Promise(function(resolve, reject) {
+            const request = indexedDB.open(DB_NAME, 1);
+            request.onupgradeneeded = () => request.result.createObjectStore(DB_STORE);
+            request.onsuccess = () => resolve(request.result);
+            request.onerror = () => reject(request.error);
+        });
+    }
+    return db;
+};
+
+const romKey = crc => (crc >>> 0).toString(16).padStart(8, '0');
+
+// one request on the profile store
+const storeRequest = function(mode, run) {
+    return openDb().then(db => new Promise(function(resolve, reject) {
+        const request = run(db.transaction(DB_STORE, mode).objectStore(DB_STORE));
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+    }));
+};
+
+const sameBytes = function(a, b) {
+    if(a.length !== b.length) return false;
+    for(let i = 0; i < a.length; i++) {
+        if(a[i] !== b[i]) return false;
+    }
+    return true;
+};
+
+// the profile of the game just started in 'gens': 'ready' resolves (true when one was taken)
+// once the stored one is back in the core (run no frame before); close() before the next start()
+export const openLearned = function(gens) {
+    const crc = gens._get_rom_crc();
+    // bytes last read or written
+    let stored = null;
+    // nothing is written before the stored profile was read
+    let settled = false;
+    let closed = false;
+
+    const apply = function() {
+        if(!stored || closed) return false;
+        gens.HEAPU8.set(stored, gens._learned_buffer());
+        return gens._learned_load(stored.length) !== 0;
+    };
+
+    const ready = storeRequest('readonly', store => store.get(romKey(crc))).then(function(buffer) {
+        settled = true;
+        if(buffer && buffer.byteLength <= LEARNED_SIZE) stored = new Uint8Array(buffer);
+        return apply();
+    }, function(error) {
+        settled = true;
+        console.warn('learned: ' + error.message);
+        return false;
+    });
+
+    // not over a stored profile the core did not take (a session reset forgot it)
+    const flush = function() {
+        if(!settled || closed || (stored && !gens._learned_applied())) return Promise.resolve(false);
+        const ptr = gens._learned_buffer();
+        const bytes = gens.HEAPU8.slice(ptr, ptr + gens._learned_save());
+        if(stored && sameBytes(stored, bytes)) return Promise.resolve(false);
+        stored = bytes;
+        return storeRequest('readwrite', store => store.put(bytes.buffer, romKey(crc))).then(() => true, function(error) {
+            console.warn('learned: ' + error.message);
+            return false;
+        });
+    };
+    const timer = setInterval(flush, SAVE_INTERVAL);
+
+    return {
+        ready: ready,
+        flush: flush,
+        // after a soft reset, which forgets what was learned
+        reset: apply,
+        // before the next start(): written one last time, from the game that ran
+        close: function() {
+            const done = flush();
+            closed = true;
+            clearInterval(timer);
+            return done;
+        }
+    };
+};
@@ -0,0 +1,278 @@
+// Live memory view (Digit9 or chaosMemoryView(), main thread mode): VRAM as tiles in one of the
+// four CRAM palettes (click to pick the next), the palettes, and heatmaps of 68k work RAM, Z80
+// RAM and VSRAM where every byte that changed lights up and fades over the next second. The
+// regions are read in place from the core (get_memory_view_ref()), uploaded once per frame as
+// one texture each and decoded in fragment shaders, so JS never touches a pixel.
+
+const VIEW_VRAM = 0;
+const VIEW_CRAM = 1;
+const VIEW_VSRAM = 2;
+const VIEW_WORK_RAM = 3;
+const VIEW_ZRAM = 4;
+
+const WIDTH = 512;
+const HEIGHT = 512;
+// heat kept per frame: gone after about a second
+const HEAT_DECAY = 0.93;
+
+const VERTEX_SHADER = `
+attribute vec2 a_position;
+uniform float u_flip;
+varying vec2 v_uv;
+void main() {
+    v_uv = a_position * 0.5 + 0.5;
+    if(u_flip > 0.5) v_uv.y = 1.0 - v_uv.y;
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}`;
+
+// byte textures are LUMINANCE, one texel per byte; addresses need more than mediump
+const HEADER = `
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+varying vec2 v_uv;
+float byteAt(sampler2D t, vec2 size, float addr) {
+    vec2 texel = vec2(mod(addr, size.x), floor(addr / size.x));
+    return floor(texture2D(t, (texel + 0.5) / size).r * 255.0 + 0.5);
+}
+// CRAM entries are 9-bit BBBGGGRRR words in host (little endian) order
+vec3 cramColor(sampler2D cram, float entry) {
+    float word = byteAt(cram, vec2(128.0, 1.0), entry * 2.0) + byteAt(cram, vec2(128.0, 1.0), entry * 2.0 + 1.0) * 256.0;
+    return vec3(mod(word, 8.0), mod(floor(word / 8.0), 8.0), mod(floor(word / 64.0), 8.0)) / 7.0;
+}
+`;
+
+// 2048 tiles of 8x8 4bpp pixels, 32 per row; VRAM words are in host order too
+const TILES_SHADER = HEADER + `
+uniform sampler2D u_vram;
+uniform sampler2D u_cram;
+uniform float u_palette;
+void main() {
+    vec2 pixel = floor(v_uv * vec2(256.0, 512.0));
+    vec2 tile = floor(pixel / 8.0);
+    vec2 inTile = pixel - tile * 8.0;
+    float addr = (tile.y * 32.0 + tile.x) * 32.0 + inTile.y * 4.0 + floor(inTile.x / 2.0);
+    addr += 1.0 - 2.0 * mod(addr, 2.0);
+    float byte = byteAt(u_vram, vec2(256.0, 256.0), addr);
+    float index = mod(inTile.x, 2.0) < 0.5 ? floor(byte / 16.0) : mod(byte, 16.0);
+    gl_FragColor = vec4(cramColor(u_cram, u_palette * 16.0 + index), 1.0);
+}`;
+
+// 4 rows of 16 swatches, the palette the tiles use is framed
+const PALETTE_SHADER = HEADER + `
+uniform sampler2D u_cram;
+uniform float u_palette;
+void main() {
+    vec2 cell = floor(v_uv * vec2(16.0, 4.0));
+    vec2 inCell = fract(v_uv * vec2(16.0, 4.0));
+    float edge = min(min(inCell.x, 1.0 - inCell.x) * 16.0, min(inCell.y, 1.0 - inCell.y) * 16.0);
+    vec3 color = cramColor(u_cram, cell.y * 16.0 + cell.x);
+    if(cell.y == u_palette && edge < 1.5) color = vec3(1.0);
+    gl_FragColor = vec4(color, 1.0);
+}`;
+
+// heat pass, drawn into the region's heat texture: 1 where the byte changed since the last
+// frame, the previous heat faded otherwise
+const HEAT_SHADER = HEADER + `
+uniform sampler2D u_data;
+uniform sampler2D u_previous;
+uniform sampler2D u_heat;
+uniform float u_decay;
+void main() {
+    float changed = abs(texture2D(u_data, v_uv).r - texture2D(u_previous, v_uv).r) > 0.5 / 255.0 ? 1.0 : 0.0;
+    gl_FragColor = vec4(max(texture2D(u_heat, v_uv).r * u_decay, changed), 0.0, 0.0, 1.0);
+}`;
+
+// bytes as grey levels, heat in orange; u_swap puts the bytes of host order words back in
+// 68k address order
+const HEATMAP_SHADER = HEADER + `
+uniform sampler2D u_data;
+uniform sampler2D u_heat;
+uniform vec2 u_size;
+uniform float u_swap;
+void main() {
+    vec2 texel = floor(v_uv * u_size);
+    if(u_swap > 0.5) texel.x += 1.0 - 2.0 * mod(texel.x, 2.0);
+    vec2 uv = (texel + 0.5) / u_size;
+    float value = texture2D(u_data, uv).r;
+    float heat = texture2D(u_heat, uv).r;
+    gl_FragColor = vec4(mix(vec3(value * 0.7), vec3(1.0, 0.45, 0.1), heat), 1.0);
+}`;
+
+// region -> texture size (one texel per byte), panel (x, y from the top left, w, h) and
+// whether its words are byte swapped
+const HEATMAPS = [
+    { region: VIEW_WORK_RAM, width: 256, height: 256, panel: [256, 64, 256, 256], swap: true },
+    { region: VIEW_ZRAM, width: 128, height: 64, panel: [256, 320, 256, 128], swap: false },
+    { region: VIEW_VSRAM, width: 128, height: 1, panel: [256, 448, 256, 32], swap: true },
+];
+const TILES_PANEL = [0, 0, 256, 512];
+const PALETTE_PANEL = [256, 0, 256, 64];
+
+const compile = function(gl, source) {
+    const link = function(type, text) {
+        const shader = gl.createShader(type);
+        gl.shaderSource(shader, text);
+        gl.compileShader(shader);
+        if(!gl.getShaderParameter(shader, gl.COMPILE_STATUS)) {
+            console.warn(gl.getShaderInfoLog(shader));
+            return null;
+        }
+        return shader;
+    };
+    const vs = link(gl.VERTEX_SHADER, VERTEX_SHADER);
+    const fs = link(gl.FRAGMENT_SHADER, source);
+    if(!vs || !fs) return null;
+    const program = gl.createProgram();
+    gl.attachShader(program, vs);
+    gl.attachShader(program, fs);
+    gl.bindAttribLocation(program, 0, 'a_position');
+    gl.linkProgram(program);
+    if(!gl.getProgramParameter(program, gl.LINK_STATUS)) return null;
+    const uniforms = {};
+    for(let i = 0; i < gl.getProgramParameter(program, gl.ACTIVE_UNIFORMS); i++) {
+        const name = gl.getActiveUniform(program, i).name;
+        uniforms[name] = gl.getUniformLocation(program, name);
+    }
+    return { program: program, uniforms: uniforms };
+};
+
+const createTexture = function(gl, format, width, height) {
+    const texture = gl.createTexture();
+    gl.bindTexture(gl.TEXTURE_2D, texture);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MIN_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_MAG_FILTER, gl.NEAREST);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_S, gl.CLAMP_TO_EDGE);
+    gl.texParameteri(gl.TEXTURE_2D, gl.TEXTURE_WRAP_T, gl.CLAMP_TO_EDGE);
+    gl.texImage2D(gl.TEXTURE_2D, 0, format, width, height, 0, format, gl.UNSIGNED_BYTE, null);
+    return texture;
+};
+
+// null when WebGL is not available; 'canvas' is the view's own canvas, shown by the caller
+export const createMemoryView = function(canvas) {
+    canvas.width = WIDTH;
+    canvas.height = HEIGHT;
+    const gl = canvas.getContext('webgl', { alpha: false, antialias: false });
+    if(!gl) return null;
+    const programs = {
+        tiles: compile(gl, TILES_SHADER),
+        palette: compile(gl, PALETTE_SHADER),
+        heat: compile(gl, HEAT_SHADER),
+        heatmap: compile(gl, HEATMAP_SHADER),
+    };
+    if(Object.values(programs).some(p => !p)) return null;
+
+    gl.bindBuffer(gl.ARRAY_BUFFER, gl.createBuffer());
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 1, -1, -1, 1, 1, 1]), gl.STATIC_DRAW);
+    gl.enableVertexAttribArray(0);
+    gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, 0);
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 1);
+
+    const vram = createTexture(gl, gl.LUMINANCE, 256, 256);
+    const cram = createTexture(gl, gl.LUMINANCE, 128, 1);
+    // per heatmap: this frame's and the last frame's bytes, and the heat, each twice (ping-pong)
+    const heatmaps = HEATMAPS.map(h => Object.assign({
+        data: [createTexture(gl, gl.LUMINANCE, h.width, h.height), createTexture(gl, gl.LUMINANCE, h.width, h.height)],
+        heat: [0, 1].map(function() {
+            const texture = createTexture(gl, gl.RGBA, h.width, h.height);
+            const framebuffer = gl.createFramebuffer();
+            gl.bindFramebuffer(gl.FRAMEBUFFER, framebuffer);
+            gl.framebufferTexture2D(gl.FRAMEBUFFER, gl.COLOR_ATTACHMENT0, gl.TEXTURE_2D, texture, 0);
+            gl.clearColor(0, 0, 0, 1);
+            gl.clear(gl.COLOR_BUFFER_BIT);
+            return { texture: texture, framebuffer: framebuffer };
+        }),
+        current: 0,
+        primed: false,
+    }, h));
+    gl.bindFramebuffer(gl.FRAMEBUFFER, null);
+
+    let palette = 0;
+    // HEAPU8 views of the regions, made again when the core or its memory changes
+    let views = null;
+    let viewsOf = null;
+
+    const bind = function(unit, texture) {
+        gl.activeTexture(gl.TEXTURE0 + unit);
+        gl.bindTexture(gl.TEXTURE_2D, texture);
+    };
+    const upload = function(texture, width, height, bytes) {
+        gl.bindTexture(gl.TEXTURE_2D, texture);
+        gl.texSubImage2D(gl.TEXTURE_2D, 0, 0, 0, width, height, gl.LUMINANCE, gl.UNSIGNED_BYTE, bytes);
+    };
+    const use = function(p, flip) {
+        gl.useProgram(p.program);
+        gl.uniform1f(p.uniforms.u_flip, flip);
+        return p.uniforms;
+    };
+    const panel = function(rect) {
+        gl.viewport(rect[0], HEIGHT - rect[1] - rect[3], rect[2], rect[3]);
+        gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+    };
+
+    return {
+        canvas: canvas,
+        // next of the four palettes for the tiles
+        nextPalette: function() {
+            palette = (palette + 1) & 3;
+        },
+        // upload the regions of 'gens' and draw, once per run of frames
+        draw: function(gens) {
+            if(viewsOf !== gens || views[0].buffer !== gens.HEAPU8.buffer) {
+                views = [VIEW_VRAM, VIEW_CRAM, VIEW_VSRAM, VIEW_WORK_RAM, VIEW_ZRAM].map(region =>
+                    new Uint8Array(gens.HEAPU8.buffer, gens._get_memory_view_ref(region), gens._get_memory_view_size(region)));
+                viewsOf = gens;
+            }
+            gl.activeTexture(gl.TEXTURE0);
+            upload(vram, 256, 256, views[VIEW_VRAM]);
+            upload(cram, 128, 1, views[VIEW_CRAM]);
+
+            // heat of each heatmap, in its own texture
+            let u = use(programs.heat, 0);
+            gl.uniform1i(u.u_data, 0);
+            gl.uniform1i(u.u_previous, 1);
+            gl.uniform1i(u.u_heat, 2);
+            gl.uniform1f(u.u_decay, HEAT_DECAY);
+            for(const h of heatmaps) {
+                const bytes = views[h.region].subarray(0, h.width * h.height);
+                h.current ^= 1;
+                gl.activeTexture(gl.TEXTURE0);
+                upload(h.data[h.current], h.width, h.height, bytes);
+                // nothing to compare the first frame with
+                if(!h.primed) upload(h.data[h.current ^ 1], h.width, h.height, bytes);
+                h.primed = true;
+                bind(1, h.data[h.current ^ 1]);
+                bind(2, h.heat[h.current ^ 1].texture);
+                gl.bindFramebuffer(gl.FRAMEBUFFER, h.heat[h.current].framebuffer);
+                gl.viewport(0, 0, h.width, h.height);
+                gl.drawArrays(gl.TRIANGLE_STRIP, 0, 4);
+            }
+            gl.bindFramebuffer(gl.FRAMEBUFFER, null);
+
+            u = use(programs.heatmap, 1);
+            gl.uniform1i(u.u_data, 0);
+            gl.uniform1i(u.u_heat, 1);
+            for(const h of heatmaps) {
+                bind(0, h.data[h.current]);
+                bind(1, h.heat[h.current].texture);
+                gl.uniform2f(u.u_size, h.width, h.height);
+                gl.uniform1f(u.u_swap, h.swap ? 1 : 0);
+                panel(h.panel);
+            }
+
+            bind(0, vram);
+            bind(1, cram);
+            u = use(programs.tiles, 1);
+            gl.uniform1i(u.u_vram, 0);
+            gl.uniform1i(u.u_cram, 1);
+            gl.uniform1f(u.u_palette, palette);
+            panel(TILES_PANEL);
+            u = use(programs.palette, 1);
+            gl.uniform1i(u.u_cram, 1);
+            gl.uniform1f(u.u_palette, palette);
+            panel(PALETTE_PANEL);
+        },
+    };
+};
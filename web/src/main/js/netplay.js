@@ -0,0 +1,234 @@
+// Rollback netplay over a WebRTC data channel (see netplay.h). Both peers run the same ROM from
+// the same reset and seed; each frame they send each other their pad and the chaos commands they
+// fired, nothing else. A frame runs as soon as the local input is known, with the remote pad
+// predicted (the last one received) and no remote commands; when the real input turns out
+// different, the core goes back to the first wrong frame and runs the frames since again without
+// drawing (netplay_rollback()). A peer waits for the other rather than run more than
+// NETPLAY_FRAMES frames past the last input it has from it.
+//
+// The local input goes DELAY frames ahead, which hides that much of the round trip without any
+// rollback. Signalling is left to the users: the host's offer and the guest's answer are
+// strings to pass on by any means (chat, mail), no server is involved.
+//
+// Messages: strings are JSON control messages, binary ones a frame of input:
+// uint32 frame, uint16 pad, uint8 count, then count 8-byte commands as in the chaos queue.
+
+export const NETPLAY_FRAMES = 8;
+const NETPLAY_COMMANDS = 8;
+const DELAY = 2;
+// netplay_input_t: uint16 pad[2], uint32 count, both players' commands
+const INPUT_BYTES = 8 + 2 * NETPLAY_COMMANDS * 8;
+
+const encodeFrame = function(frame, input) {
+    const bytes = new ArrayBuffer(7 + input.commands.length * 8);
+    const view = new DataView(bytes);
+    view.setUint32(0, frame, true);
+    view.setUint16(4, input.pad, true);
+    view.setUint8(6, input.commands.length);
+    input.commands.forEach((cmd, i) => {
+        view.setUint8(7 + i * 8, cmd.op);
+        view.setUint8(8 + i * 8, cmd.sync);
+        view.setUint16(9 + i * 8, 0, true);
+        view.setFloat32(11 + i * 8, cmd.intensity, true);
+    });
+    return bytes;
+};
+
+const decodeFrame = function(bytes) {
+    const view = new DataView(bytes);
+    const commands = [];
+    for(let i = 0; i < Math.min(view.getUint8(6), NETPLAY_COMMANDS); i++) {
+        commands.push({ op: view.getUint8(7 + i * 8), sync: view.getUint8(8 + i * 8), intensity: view.getFloat32(11 + i * 8, true) });
+    }
+    return { frame: view.getUint32(0, true), input: { pad: view.getUint16(4, true), commands: commands } };
+};
+
+// resolves once ICE gathering is over, the description then has all the candidates
+const gathered = function(peer) {
+    if(peer.iceGatheringState === 'complete') return Promise.resolve();
+    return new Promise(resolve => peer.addEventListener('icegatheringstatechange', function() {
+        if(peer.iceGatheringState === 'complete') resolve();
+    }));
+};
+
+// 'player' 0 (host, pad 1) or 1 (guest, pad 2); 'events': onStart(), onEnd(reason) and
+// onRollback(frames), all optional
+const createSession = function(gens, channel, player, events) {
+    const local = new Map();
+    const remote = new Map();
+    const predicted = new Map();
+    const pending = [];
+    let localNext = 0;
+    let lastRemote = -1;
+    let rollbackFrom = Infinity;
+    let running = false;
+    let rollbacks = 0;
+    let rolledFrames = 0;
+
+    const slot = function(frame) {
+        return new DataView(gens.HEAPU8.buffer, gens._netplay_input(frame), INPUT_BYTES);
+    };
+
+    // pads and commands of 'frame' into the core, player 0's commands first on both peers
+    const writeInput = function(frame) {
+        const view = slot(frame);
+        const mine = local.get(frame);
+        const theirs = remote.get(frame);
+        const remotePad = theirs ? theirs.pad : (remote.has(lastRemote) ? remote.get(lastRemote).pad : 0);
+        const players = player === 0 ? [mine, theirs] : [theirs, mine];
+        predicted.set(frame, remotePad);
+        view.setUint16(player * 2, mine.pad, true);
+        view.setUint16((1 - player) * 2, remotePad, true);
+        let count = 0;
+        players.forEach(input => {
+            if(!input) return;
+            input.commands.forEach(cmd => {
+                const at = 8 + count++ * 8;
+                view.setUint8(at, cmd.op);
+                view.setUint8(at + 1, cmd.sync);
+                view.setUint16(at + 2, 0, true);
+                view.setFloat32(at + 4, cmd.intensity, true);
+            });
+        });
+        view.setUint32(4, count, true);
+    };
+
+    const receive = function(frame, input) {
+        remote.set(frame, input);
+        lastRemote = frame;
+        // already run with a wrong guess
+        if(frame < gens._netplay_frame() && (predicted.get(frame) !== input.pad || input.commands.length)) {
+            rollbackFrom = Math.min(rollbackFrom, frame);
+        }
+    };
+
+    const start = function(seed) {
+        gens._netplay_start(seed);
+        running = true;
+        if(events.onStart) events.onStart();
+    };
+
+    const end = function(reason) {
+        if(!running) return;
+        running = false;
+        gens._netplay_end();
+        if(events.onEnd) events.onEnd(reason);
+    };
+
+    channel.binaryType = 'arraybuffer';
+    channel.addEventListener('message', function(e) {
+        if(typeof e.data !== 'string') {
+            const message = decodeFrame(e.data);
+            if(running) receive(message.frame, message.input);
+            return;
+        }
+        const message = JSON.parse(e.data);
+        if(message.type === 'hello') {
+            // the guest checks the game, then both start from the host's seed
+            if(message.rom !== gens._get_rom_crc()) {
+                channel.send(JSON.stringify({ type: 'bye', reason: 'another ROM' }));
+                end('the host runs another ROM');
+                return;
+            }
+            gens._set_idle_skip(message.idle);
+            channel.send(JSON.stringify({ type: 'ready' }));
+            start(message.seed);
+        } else if(message.type === 'ready') {
+            start(session.seed);
+        } else if(message.type === 'bye') {
+            end(message.reason);
+        }
+    });
+    channel.addEventListener('close', () => end('connection closed'));
+
+    const session = {
+        player: player,
+        seed: 0,
+        // host: offer the running game to the guest
+        hello: function(seed, idle) {
+            session.seed = seed >>> 0;
+            channel.send(JSON.stringify({ type: 'hello', rom: gens._get_rom_crc(), seed: session.seed, idle: idle }));
+        },
+        running: () => running,
+        // a chaos command of this peer, sent with its next input frame
+        command: function(op, sync, intensity) {
+            pending.push({ op: op, sync: sync, intensity: intensity });
+        },
+        // before running 'frames' frames with the local pad 'bits': sends the local input, rolls
+        // back what arrived late and writes the input of the frames; returns the frames that may
+        // run now (0 while waiting for the other peer)
+        frames: function(frames, bits) {
+            if(!running) return 0;
+            if(!gens._netplay_active()) {
+                // reset or state load here
+                channel.send(JSON.stringify({ type: 'bye', reason: 'the other player left the session' }));
+                end('session left');
+                return frames;
+            }
+            const current = gens._netplay_frame();
+            for(; localNext < current + frames + DELAY; localNext++) {
+                const input = { pad: bits & 0xffff, commands: pending.splice(0, NETPLAY_COMMANDS) };
+                local.set(localNext, input);
+                channel.send(encodeFrame(localNext, input));
+            }
+            if(rollbackFrom < current) {
+                for(let frame = rollbackFrom; frame < current; frame++) writeInput(frame);
+                const run = gens._netplay_rollback(rollbackFrom);
+                if(run < 0) {
+                    channel.send(JSON.stringify({ type: 'bye', reason: 'desynchronized' }));
+                    end('desynchronized');
+                    return 0;
+                }
+                rollbacks++;
+                rolledFrames += run;
+                if(events.onRollback) events.onRollback(run);
+            }
+            rollbackFrom = Infinity;
+            const allowed = Math.max(0, Math.min(frames, lastRemote + 1 + NETPLAY_FRAMES - current));
+            for(let frame = current; frame < current + allowed; frame++) writeInput(frame);
+            // the window behind
+            for(const map of [local, remote, predicted]) {
+                for(const frame of map.keys()) {
+                    if(frame < current - 2 * NETPLAY_FRAMES) map.delete(frame);
+                }
+            }
+            return allowed;
+        },
+        stats: () => ({ frame: gens._netplay_frame(), remote: lastRemote, rollbacks: rollbacks, rolledFrames: rolledFrames }),
+        close: function() {
+            if(running && channel.readyState === 'open') channel.send(JSON.stringify({ type: 'bye', reason: 'the other player left' }));
+            end('closed');
+            channel.close();
+        }
+    };
+    return session;
+};
+
+// host side: resolves to { offer, accept(answer), session }; the session starts once the guest
+// answered and checked that it runs the same game
+export const hostNetplay = async function(gens, seed, idle, events) {
+    const peer = new RTCPeerConnection({ iceServers: [{ urls: 'stun:stun.l.google.com:19302' }] });
+    const channel = peer.createDataChannel('netplay', { ordered: true });
+    const session = createSession(gens, channel, 0, events || {});
+    channel.addEventListener('open', () => session.hello(seed, idle));
+    await peer.setLocalDescription(await peer.createOffer());
+    await gathered(peer);
+    return {
+        offer: btoa(JSON.stringify(peer.localDescription)),
+        accept: answer => peer.setRemoteDescription(JSON.parse(atob(answer.trim()))),
+        session: session
+    };
+};
+
+// guest side: resolves to { answer, session } for the host's offer, 'session' a promise of the
+// session, settled once the host's channel comes in
+export const joinNetplay = async function(gens, offer, events) {
+    const peer = new RTCPeerConnection({ iceServers: [{ urls: 'stun:stun.l.google.com:19302' }] });
+    const session = new Promise(resolve => peer.addEventListener('datachannel', function(e) {
+        resolve(createSession(gens, e.channel, 1, events || {}));
+    }));
+    await peer.setRemoteDescription(JSON.parse(atob(offer.trim())));
+    await peer.setLocalDescription(await peer.createAnswer());
+    await gathered(peer);
+    return { answer: btoa(JSON.stringify(peer.localDescription)), session: session };
+};
@@ -0,0 +1,52 @@
+// Audio-clocked frame pacing with dynamic rate control (worker.js, index.js ?latency=low).
+//
+// The AudioWorklet drains the ring at the output rate; a frame is run whenever the fill
+// drops below the target, so the audio clock sets the game speed and the latency stays
+// at 'latencyFrames' frames whatever the display refresh rate. Running on demand alone
+// leaves the fill wandering with timer jitter: the resampler ratio (set_audio_rate() skew)
+// is also nudged in proportion to the smoothed fill error, at most RATE_SKEW_MAX, so the
+// core produces slightly fewer samples per frame while the ring is above target and
+// slightly more below.
+
+const RATE_SKEW_MAX = 0.005;
+// only call into the core once the skew moved this much
+const RATE_SKEW_STEP = 0.0001;
+// fill smoothing (per poll), the sawtooth of one frame must not reach the skew
+const FILL_SMOOTHING = 1 / 64;
+
+export const createAudioPacer = function(gens, push, rate, latencyFrames) {
+    let samplesPerFrame = 0;
+    let skew = 0;
+    let average = 0;
+    let lastPlayed = -1;
+    const pacer = {
+        // after start(): video mode may have changed, restart the controller
+        reset: function() {
+            skew = 0;
+            samplesPerFrame = gens._set_audio_rate(rate, 0);
+            // a run tops the ring up to [target, target + 1 frame): that is the mean fill
+            average = samplesPerFrame * (latencyFrames + 0.5);
+            lastPlayed = -1;
+        },
+        // frames to run now (0 while the ring holds enough), or -1 while the worklet is not
+        // consuming (context suspended, tab muted): the caller falls back to its own clock
+        frames: function(max) {
+            if(!samplesPerFrame) pacer.reset();
+            const played = push.played();
+            if(played === lastPlayed) return -1;
+            lastPlayed = played;
+            const fill = push.fill();
+            const target = samplesPerFrame * latencyFrames;
+            const mean = target + samplesPerFrame / 2;
+            average += (fill - average) * FILL_SMOOTHING;
+            const next = Math.max(-RATE_SKEW_MAX, Math.min(RATE_SKEW_MAX, RATE_SKEW_MAX * (average - mean) / mean));
+            if(Math.abs(next - skew) >= RATE_SKEW_STEP) {
+                skew = next;
+                samplesPerFrame = gens._set_audio_rate(rate, skew);
+            }
+            if(fill >= target) return 0;
+            return Math.min(Math.ceil((target - fill) / samplesPerFrame), max);
+        },
+    };
+    return pacer;
+};
@@ -0,0 +1,33 @@
+// Battery saver and background tab modes (index.js, worker.js).
+//
+// Battery saver (?power=saver or chaosPower('saver')) holds the quality governor (governor.h)
+// at its frame skip level: every other frame is run without rendering and the audio rungs
+// above it (MAME FM, linear FM and PSG, no filter) are taken, with or without ?governor=0.
+// Load still steps it down, nothing steps it back above the minimum.
+//
+// A hidden tab gets no animation frames and throttled timers, so it used to stall and then
+// catch up on return. Instead it is either paused (the audio output suspended with it) or,
+// while audio is playing or a peer is waiting on the session, run on for the sound with
+// nothing rendered or drawn. ?background=pause always pauses. Either way the frame clocks
+// start again from the moment the tab is shown: missed time is not caught up.
+
+export const POWER_MODES = ['normal', 'saver'];
+export const BACKGROUND_MODES = ['auto', 'pause'];
+
+// governor_set_minimum() level of each power mode (GOVERNOR_FULL, GOVERNOR_FRAME_SKIP)
+export const POWER_LEVELS = [0, 5];
+
+// tick_n() render argument (wasm.c)
+export const TICK_RENDER_LAST = 1;
+export const TICK_RENDER_NONE = 2;
+
+const params = new URLSearchParams(location.search);
+export const powerParam = Math.max(0, POWER_MODES.indexOf(params.get('power')));
+export const backgroundParam = params.get('background') === 'pause' ? 'pause' : 'auto';
+
+// what a hidden tab does: 'run' (nothing drawn) or 'pause'; 'online' while a session peer
+// waits on the frames
+export const backgroundState = function(mode, audioContext, online) {
+    if(mode === 'pause') return 'pause';
+    return online || (audioContext && audioContext.state === 'running') ? 'run' : 'pause';
+};
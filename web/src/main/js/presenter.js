@@ -0,0 +1,109 @@
+// Frame presentation onto a 2D canvas context (HTMLCanvasElement or OffscreenCanvas).
+// The canvas is the core frame buffer at its output scale (set_output_scale()), stretched
+// further by CSS with nearest neighbour filtering only. Only frame lines flagged by the core
+// are uploaded; each frame line is 'scale' canvas rows.
+
+// frame size before scaling (core VIDEO_WIDTH / VIDEO_HEIGHT)
+export const FRAME_WIDTH = 320;
+export const FRAME_HEIGHT = 240;
+export const SCALE_MAX = 4;
+const PROFILE_COLORS = ['#888', '#e44', '#e94', '#ee4', '#e84', '#4c4', '#4cc', '#48e', '#a4e', '#e4a', '#fff', '#4e8'];
+
+export const createCanvasPresenter = function(context, glPresenter, scale) {
+    const canvasWidth = FRAME_WIDTH * scale;
+    const canvasHeight = FRAME_HEIGHT * scale;
+    // overlay sizes are given for the 2x canvas
+    const px = n => Math.round(n * scale / 2);
+    const font = n => Math.max(8, px(n)) + 'px monospace';
+    // rows covered by the FPS / chaos message overlay, restored every frame
+    const overlayTop = canvasHeight - px(48);
+    // frame profile bar: full width = 2 frames at 60Hz
+    const profileScale = canvasWidth / (2 * 1000000 / 60);
+    const imageData = context.createImageData(canvasWidth, canvasHeight);
+    let fullUpdate = true;
+    let areaW = 0;
+    let areaH = 0;
+
+    // upload rows of the frame buffer into the canvas
+    const putRows = function(vram, top, bottom, width) {
+        const start = top * canvasWidth * 4;
+        const end = bottom * canvasWidth * 4;
+        imageData.data.set(vram.subarray(start, end), start);
+        context.putImageData(imageData, 0, 0, 0, top, width, bottom - top);
+    };
+
+    return {
+        // next draw uploads the whole frame
+        invalidate: function() {
+            fullUpdate = true;
+        },
+        // frame: { vram, dirtyLines, frameInfo } (+ indexBuffer, palette, postLevels with a GL presenter)
+        draw: function(frame) {
+            const info = frame.frameInfo;
+            const w = Math.min(canvasWidth, (info[2] + 2 * info[0]) * scale);
+            const h = Math.min(canvasHeight, (info[3] + 2 * info[1]) * scale);
+            const full = fullUpdate || w !== areaW || h !== areaH;
+            fullUpdate = false;
+            areaW = w;
+            areaH = h;
+            if(glPresenter) {
+                glPresenter.draw(frame.indexBuffer, frame.palette, frame.dirtyLines, w / scale, h / scale, full, frame.postLevels);
+                context.clearRect(0, overlayTop, canvasWidth, canvasHeight - overlayTop);
+                context.drawImage(glPresenter.canvas, 0, 0);
+                return;
+            }
+            if(full) {
+                imageData.data.set(frame.vram);
+                context.putImageData(imageData, 0, 0);
+                return;
+            }
+            const lines = Math.floor(Math.min(h, overlayTop) / scale);
+            let first = -1;
+            for(let line = 0; line <= lines; line++) {
+                if(line < lines && frame.dirtyLines[line]) {
+                    if(first < 0) first = line;
+                } else if(first >= 0) {
+                    putRows(frame.vram, first * scale, line * scale, w);
+                    first = -1;
+                }
+            }
+            if(h > overlayTop) putRows(frame.vram, overlayTop, h, w);
+            // overlay band below the active area is never written by the core
+            if(h < canvasHeight) putRows(frame.vram, Math.max(h, overlayTop), canvasHeight, canvasWidth);
+        },
+        // ChaosDrive status + FPS
+        overlay: function(fps, message) {
+            context.font = font(12);
+            context.fillStyle = "#0f0";
+            context.fillText("FPS " + fps, 0, canvasHeight - px(16));
+            if(message) {
+                context.fillStyle = "#ff0";
+                context.fillText(message, 0, canvasHeight - px(32));
+            }
+        },
+        // frame time stacked bar, profile = [usec per counter..., total, frames] (see core profile.h)
+        profile: function(profile, names) {
+            const frames = Math.max(1, profile[names.length + 1]);
+            let x = 0;
+            context.font = font(10);
+            for(let i = 0; i < names.length; i++) {
+                const w = profile[i] / frames * profileScale;
+                context.fillStyle = PROFILE_COLORS[i % PROFILE_COLORS.length];
+                context.fillRect(x, canvasHeight - px(10), w, px(8));
+                if(w > px(30)) {
+                    context.fillStyle = "#000";
+                    context.fillText(names[i], x + px(2), canvasHeight - px(3));
+                }
+                x += w;
+            }
+            context.fillStyle = "#0f0";
+            context.fillText((profile[names.length] / frames / 1000).toFixed(2) + " ms/frame", canvasWidth - px(100), canvasHeight - px(16));
+        },
+        // input-to-photon estimate (input.js), ms
+        latency: function(ms) {
+            context.font = font(10);
+            context.fillStyle = "#0f0";
+            context.fillText("input " + (ms ? ms.toFixed(1) + " ms" : "-"), canvasWidth - px(200), canvasHeight - px(16));
+        }
+    };
+};
@@ -0,0 +1,117 @@
+// Compressed ROMs: .zip (stored or deflated) and .gz files are recognized by their magic bytes
+// and inflated with DecompressionStream while they are read, so the ROM is never held twice.
+// The uncompressed size has to be known before the first byte goes in (see romstream.js):
+// a zip gives it in its central directory, a gzip file in its last 4 bytes.
+// .7z archives are recognized but not supported.
+
+const ROM_EXTENSIONS = /\.(bin|md|smd|gen|sms)$/i;
+// end of central directory record, followed by an up to 64KB comment
+const ZIP_EOCD_SIZE = 22;
+const ZIP_COMMENT_MAX = 0xFFFF;
+
+const u16 = (view, offset) => view.getUint16(offset, true);
+const u32 = (view, offset) => view.getUint32(offset, true);
+
+const readView = async function(blob, start, end) {
+    return new DataView(await blob.slice(start, end).arrayBuffer());
+};
+
+const inflate = function(blob, format) {
+    return blob.stream().pipeThrough(new DecompressionStream(format));
+};
+
+// first ROM file of the archive (by extension), or its first file
+const zipEntry = async function(file) {
+    const tailStart = Math.max(0, file.size - ZIP_EOCD_SIZE - ZIP_COMMENT_MAX);
+    const tail = await readView(file, tailStart, file.size);
+    let eocd = tail.byteLength - ZIP_EOCD_SIZE;
+    while(eocd >= 0 && u32(tail, eocd) !== 0x06054b50) eocd--;
+    if(eocd < 0) return null;
+
+    const count = u16(tail, eocd + 10);
+    const dirStart = u32(tail, eocd + 16);
+    const dir = await readView(file, dirStart, dirStart + u32(tail, eocd + 12));
+    let found = null;
+    for(let i = 0, p = 0; i < count && p + 46 <= dir.byteLength && u32(dir, p) === 0x02014b50; i++) {
+        const nameLength = u16(dir, p + 28);
+        const name = new TextDecoder().decode(new Uint8Array(dir.buffer, p + 46, nameLength));
+        const entry = {
+            name: name,
+            flags: u16(dir, p + 8),
+            method: u16(dir, p + 10),
+            packed: u32(dir, p + 20),
+            size: u32(dir, p + 24),
+            header: u32(dir, p + 42)
+        };
+        p += 46 + nameLength + u16(dir, p + 30) + u16(dir, p + 32);
+        if(name.endsWith('/') || !entry.size) continue;
+        if(ROM_EXTENSIONS.test(name)) return entry;
+        if(!found) found = entry;
+    }
+    return found;
+};
+
+const openZip = async function(file) {
+    const entry = await zipEntry(file);
+    if(!entry) {
+        console.warn('rom: no file in ' + file.name);
+        return null;
+    }
+    // bit 0: encrypted
+    if((entry.flags & 1) || (entry.method !== 0 && entry.method !== 8)) {
+        console.warn('rom: ' + entry.name + ' is encrypted or not stored/deflated');
+        return null;
+    }
+    // the local header repeats the name, its extra field may differ from the central one
+    const local = await readView(file, entry.header, entry.header + 30);
+    const start = entry.header + 30 + u16(local, 26) + u16(local, 28);
+    const data = file.slice(start, start + entry.packed);
+    return {
+        name: entry.name,
+        size: entry.size,
+        open: () => entry.method === 8 ? inflate(data, 'deflate-raw') : data.stream()
+    };
+};
+
+// { name, size, open() } where open() returns a new stream of the ROM bytes, or null;
+// 'source' is a Blob/File or a fetch() Response (not decompressed)
+export const openRom = async function(source) {
+    if(!(source instanceof Blob)) {
+        const size = parseInt(source.headers.get('content-length'), 10);
+        // no length up front: the size is needed to recognize .smd files
+        if(!(size > 0)) return openRom(await source.blob());
+        return { name: source.url, size: size, open: () => source.body };
+    }
+    const magic = new Uint8Array(await source.slice(0, 6).arrayBuffer());
+    const name = source.name || 'rom';
+    if(magic[0] === 0x50 && magic[1] === 0x4b && magic[2] === 0x03 && magic[3] === 0x04) {
+        return openZip(source);
+    }
+    if(magic[0] === 0x1f && magic[1] === 0x8b) {
+        // ISIZE: size modulo 4GB, single member files only
+        const size = u32(await readView(source, source.size - 4, source.size), 0);
+        return { name: name, size: size, open: () => inflate(source, 'gzip') };
+    }
+    if(magic[0] === 0x37 && magic[1] === 0x7a && magic[2] === 0xbc && magic[3] === 0xaf) {
+        console.warn('rom: .7z archives are not supported, use .zip or .gz');
+        return null;
+    }
+    return { name: name, size: source.size, open: () => source.stream() };
+};
+
+// first 'length' bytes of the ROM (cartridge header for idle.js); only the start of a
+// compressed file is inflated
+export const readRomStart = async function(rom, length) {
+    const bytes = new Uint8Array(length);
+    const reader = rom.open().getReader();
+    let got = 0;
+    while(got < length) {
+        const { done, value } = await reader.read();
+        if(done) break;
+        const n = Math.min(value.length, length - got);
+        bytes.set(value.subarray(0, n), got);
+        got += n;
+    }
+    reader.cancel();
+    return bytes.buffer;
+};
@@ -0,0 +1,36 @@
+// ROM loading: the file is streamed straight into the core's cartridge area (rom_stream_begin
+// and rom_stream_write in wasm.c). Each chunk is converted in place as soon as it is in
+// (.smd deinterleaving, byte-swapped dumps, checksum), so neither a whole-file ArrayBuffer
+// nor a staging copy in the core is needed. Zip and gzip files are inflated on the way
+// (romarchive.js), the core only sees the ROM bytes.
+// 'source' is a Blob/File (file picker) or a fetch() Response.
+
+import { openRom } from './romarchive.js';
+
+// resolves to true once the whole ROM is in the core, false when it is empty, too large,
+// in an unsupported archive or ends early; start() can then be called
+export const streamRom = async function(gens, source) {
+    const rom = await openRom(source);
+    if(!rom || !rom.size) return false;
+    let ptr = gens._rom_stream_begin(rom.size);
+    if(!ptr) return false;
+    const reader = rom.open().getReader();
+    let left = rom.size;
+    try {
+        while(ptr) {
+            const { done, value } = await reader.read();
+            if(done) break;
+            const chunk = value.length > left ? value.subarray(0, left) : value;
+            // HEAPU8 can be replaced by memory growth between two chunks
+            gens.HEAPU8.set(chunk, ptr);
+            left -= chunk.length;
+            ptr = gens._rom_stream_write(chunk.length);
+        }
+    } catch(error) {
+        // corrupt archive
+        console.warn('rom: ' + rom.name + ',', error);
+        return false;
+    }
+    if(left) reader.cancel();
+    return !left;
+};
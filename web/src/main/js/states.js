@@ -0,0 +1,58 @@
+// Save state slots. The core serializes into its own state buffer between two frames
+// (save_state(): a flat copy of the sections, well under a millisecond); the copy is then
+// compressed and written to IndexedDB by statestore.js, keyed by ROM CRC and slot number.
+// Loading goes the other way and is applied once the bytes are back.
+
+export const STATE_SLOTS = 8;
+
+let store = null;
+let nextId = 1;
+// request id -> { resolve, reject }
+const pending = new Map();
+
+const storeCall = function(msg, transfer) {
+    if(!store) {
+        store = new Worker(new URL('./statestore.js', import.meta.url));
+        store.onmessage = function(e) {
+            const job = pending.get(e.data.id);
+            pending.delete(e.data.id);
+            if(e.data.error) job.reject(new Error(e.data.error));
+            else job.resolve(e.data);
+        };
+    }
+    msg.id = nextId++;
+    return new Promise(function(resolve, reject) {
+        pending.set(msg.id, { resolve: resolve, reject: reject });
+        store.postMessage(msg, transfer);
+    });
+};
+
+const slotKey = function(crc, slot) {
+    return (crc >>> 0).toString(16).padStart(8, '0') + '/' + slot;
+};
+
+// 'bytes' (ArrayBuffer) is transferred; resolves to the stored (compressed) size
+export const storeState = function(crc, slot, bytes) {
+    return storeCall({ op: 'put', key: slotKey(crc, slot), bytes: bytes }, [bytes]).then(reply => reply.size);
+};
+
+// resolves to the state (ArrayBuffer), null for an empty slot
+export const fetchState = function(crc, slot) {
+    return storeCall({ op: 'get', key: slotKey(crc, slot) }, []).then(reply => reply.bytes);
+};
+
+// copy of the current core state (ArrayBuffer), null on error
+export const saveCoreState = function(gens) {
+    const size = gens._save_state(0);
+    if(!size) return null;
+    const ptr = gens._get_state_buffer_ref();
+    return gens.HEAPU8.slice(ptr, ptr + size).buffer;
+};
+
+// false when the state does not fit or is refused by the core (other ROM type, old version)
+export const loadCoreState = function(gens, bytes) {
+    const ptr = gens._get_state_buffer_ref();
+    if(!ptr || bytes.byteLength > gens._get_state_size()) return false;
+    gens.HEAPU8.set(new Uint8Array(bytes), ptr);
+    return gens._load_state(0) > 0;
+};
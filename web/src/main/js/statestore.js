@@ -0,0 +1,60 @@
+// Save state store (worker started by states.js): states are gzip compressed with
+// CompressionStream on the way into IndexedDB and inflated on the way out, so neither
+// step runs on the emulator thread.
+// Requests: { id, op: 'put', key, bytes } and { id, op: 'get', key }; replies carry the same id
+// and { size } (stored bytes), { bytes } (null for an unknown key) or { error }.
+
+const DB_NAME = 'chaosdrive';
+const DB_VERSION = 1;
+const DB_STORE = 'states';
+
+let db = null;
+
+const openDb = function() {
+    if(!db) {
+        db = new Promise(function(resolve, reject) {
+            const request = indexedDB.open(DB_NAME, DB_VERSION);
+            request.onupgradeneeded = () => request.result.createObjectStore(DB_STORE);
+            request.onsuccess = () => resolve(request.result);
+            request.onerror = () => reject(request.error);
+        });
+    }
+    return db;
+};
+
+// one request on the state store
+const storeRequest = function(mode, run) {
+    return openDb().then(db => new Promise(function(resolve, reject) {
+        const request = run(db.transaction(DB_STORE, mode).objectStore(DB_STORE));
+        request.onsuccess = () => resolve(request.result);
+        request.onerror = () => reject(request.error);
+    }));
+};
+
+// bytes through a (de)compression stream, resolves to an ArrayBuffer
+const transform = function(bytes, stream) {
+    return new Response(new Blob([bytes]).stream().pipeThrough(stream)).arrayBuffer();
+};
+
+const put = function(key, bytes) {
+    return transform(bytes, new CompressionStream('gzip')).then(packed =>
+        storeRequest('readwrite', store => store.put({ bytes: packed, size: bytes.byteLength, time: Date.now() }, key))
+            .then(() => ({ size: packed.byteLength })));
+};
+
+const get = function(key) {
+    return storeRequest('readonly', store => store.get(key)).then(entry => entry ?
+        transform(entry.bytes, new DecompressionStream('gzip')).then(bytes => ({ bytes: bytes })) : { bytes: null });
+};
+
+self.onmessage = function(e) {
+    const msg = e.data;
+    const job = msg.op === 'put' ? put(msg.key, msg.bytes) :
+        msg.op === 'get' ? get(msg.key) : Promise.reject(new Error('unknown op: ' + msg.op));
+    job.then(function(reply) {
+        reply.id = msg.id;
+        self.postMessage(reply, reply.bytes ? [reply.bytes] : []);
+    }, function(error) {
+        self.postMessage({ id: msg.id, error: String(error) });
+    });
+};
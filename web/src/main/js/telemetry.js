@@ -0,0 +1,58 @@
+// Session performance telemetry (see telemetry.h). The core keeps fixed-bucket histograms of
+// the time of each frame run and of its emulation, render, audio and chaos parts, and a few
+// counters; the front end adds the frames it skipped and the audio underruns.
+
+export const TELEMETRY_MISSED = 4;
+export const TELEMETRY_UNDERRUNS = 5;
+
+// quality governor levels (governor.h), shown when the core steps to one
+export const QUALITY_LEVELS = ['full', 'MAME FM', 'linear FM', 'linear PSG', 'no audio filter', 'frame skip'];
+
+const COUNTERS = ['runs', 'frames', 'sampled', 'late', 'missed', 'underruns'];
+const HISTOGRAMS = ['run', 'emulation', 'render', 'audio', 'chaos'];
+
+// lower bound of a bucket in microseconds: 0-3 one each, then a quarter octave each
+export const telemetryBucketFloor = function(bucket) {
+    return bucket < 4 ? bucket : (4 | (bucket & 3)) << ((bucket >> 2) - 1);
+};
+
+// bucket floor (usec) at which 'fraction' of the samples are reached
+const percentile = function(counts, total, fraction) {
+    let seen = 0;
+    for(let b = 0; b < counts.length; b++) {
+        seen += counts[b];
+        if(seen > 0 && seen >= total * fraction) return telemetryBucketFloor(b);
+    }
+    return 0;
+};
+
+// the session so far: counters, p50/p95/p99 and the non-empty buckets ([usec floor, count]) of
+// each histogram, and the raw export (uint32 version, buckets, counters, histograms) to report
+export const readTelemetry = function(gens) {
+    const ptr = gens._telemetry_export();
+    const header = new Uint32Array(gens.HEAPU8.buffer, ptr, 2);
+    const buckets = header[1];
+    const words = 2 + COUNTERS.length + HISTOGRAMS.length * buckets;
+    const raw = new Uint32Array(gens.HEAPU8.buffer, ptr, words).slice();
+    const result = { version: raw[0], counters: {}, histograms: {}, bytes: new Uint8Array(raw.buffer) };
+    COUNTERS.forEach((name, i) => { result.counters[name] = raw[2 + i]; });
+    HISTOGRAMS.forEach((name, h) => {
+        const counts = raw.subarray(2 + COUNTERS.length + h * buckets, 2 + COUNTERS.length + (h + 1) * buckets);
+        const total = counts.reduce((sum, count) => sum + count, 0);
+        const filled = [];
+        counts.forEach((count, b) => { if(count) filled.push([telemetryBucketFloor(b), count]); });
+        result.histograms[name] = { samples: total, p50: percentile(counts, total, 0.5),
+            p95: percentile(counts, total, 0.95), p99: percentile(counts, total, 0.99), buckets: filled };
+    });
+    return result;
+};
+
+// keeps a running underrun total (underruns()) and adds what is new to the core counter
+export const createUnderrunReporter = function(underruns) {
+    let seen = underruns();
+    return function(gens) {
+        const total = underruns();
+        if(total !== seen) gens._telemetry_count(TELEMETRY_UNDERRUNS, (total - seen) | 0);
+        seen = total;
+    };
+};
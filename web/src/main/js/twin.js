@@ -0,0 +1,55 @@
+// Clean twin for side-by-side comparisons (?twin=1 or chaosTwin(true), main thread mode).
+// Every loadCore() call instantiates the module again with its own linear memory, so the
+// twin owns a full copy of the emulated state (work RAM, VDP and its pattern cache, sound
+// chips, cartridge area) and shares nothing with the main core. It loads the same ROM,
+// gets the same input and runs the same frames, but never takes chaos commands: what the
+// game would show without the glitches. It follows resets, not state loads or rewinds.
+
+import { loadCore } from './core.js';
+import { streamRom } from './romstream.js';
+import { createCanvasPresenter, FRAME_WIDTH, FRAME_HEIGHT } from './presenter.js';
+
+// resolves to the twin once its ROM is loaded and started, or null; 'full' is the core
+// the main one runs (loadCore()), 'scale' its output scale
+export const createTwin = async function(build, full, file, idle, canvas, scale) {
+    const gens = await loadCore(build, full);
+    gens._init();
+    if(!await streamRom(gens, file)) return null;
+    gens._set_idle_skip(idle);
+    gens._set_output_scale(scale);
+
+    const presenter = createCanvasPresenter(canvas.getContext('2d'), null, scale);
+    let frame = null;
+    let inputBits = null;
+
+    const start = function() {
+        gens._start();
+        // views are taken after start(), like the main core's
+        const heap = gens.HEAPU8.buffer;
+        frame = {
+            vram: new Uint8ClampedArray(heap, gens._get_frame_buffer_ref(), FRAME_WIDTH * FRAME_HEIGHT * scale * scale * 4),
+            dirtyLines: new Uint8Array(heap, gens._get_dirty_lines_ref(), FRAME_HEIGHT),
+            frameInfo: new Int32Array(heap, gens._get_frame_info_ref(), 4)
+        };
+        inputBits = new Int32Array(heap, gens._get_input_bits_ref(), 1);
+        presenter.invalidate();
+    };
+    start();
+
+    return {
+        gens: gens,
+        // soft_reset() keeps the heap views
+        reset: function(boot) {
+            gens._soft_reset(boot ? 1 : 0);
+            presenter.invalidate();
+        },
+        // same frames as the main core with its pad bits of this tick (the twin does not
+        // read them live); the audio is dropped
+        run: function(frames, bits) {
+            inputBits[0] = bits;
+            gens._tick_n(frames, 1);
+            gens._sound();
+            presenter.draw(frame);
+        }
+    };
+};
@@ -0,0 +1,86 @@
+// Variations grid (chaosVariations() on the console, main thread mode): the running game is
+// forked into up to 9 core instances, each in a worker of its own (variationworker.js) and
+// started from a save state of the main core with one variant of a chaos effect: its own
+// seed, and an intensity along a range if one is given. Each plays a few seconds without
+// input; the frames come back as 8-bit pixel indices plus palette (a quarter of the RGBA
+// bytes) and are drawn into a 3x3 grid of small canvases as they arrive. Clicking a cell
+// takes that instance's state as it is, the grid closes and the workers end.
+// The chaos ROM changes (cartridge patches, clones) are not in save states and stay out.
+
+export const VARIATION_CELLS = 9;
+
+const CELL_WIDTH = 160;
+const CELL_HEIGHT = 112;
+
+// one instance per hardware thread, the main one kept
+const variationCount = function() {
+    return Math.max(1, Math.min(VARIATION_CELLS, (navigator.hardwareConcurrency || 2) - 1));
+};
+
+// options: { build, full, file, idle: the running game (loadCore(), streamRom()),
+//  state: ArrayBuffer of saveCoreState(), effect: id, sync, seed: of the first cell,
+//  intensity: a value or [low, high] spread over the cells, seconds }
+// the grid goes after 'anchor'; onPick(bytes, seed) gets the state of the clicked cell
+export const createVariations = function(options, anchor, onPick) {
+    const count = variationCount();
+    const [low, high] = Array.isArray(options.intensity) ? options.intensity : [options.intensity, options.intensity];
+    const grid = document.createElement('div');
+    grid.style.cssText = 'display: grid; grid-template-columns: repeat(3, ' + CELL_WIDTH + 'px); gap: 4px;';
+    anchor.after(grid);
+    const workers = [];
+
+    const close = function() {
+        workers.forEach(worker => worker.terminate());
+        workers.length = 0;
+        grid.remove();
+    };
+
+    for(let i = 0; i < count; i++) {
+        const seed = (options.seed + i) >>> 0;
+        const intensity = count > 1 ? low + (high - low) * i / (count - 1) : low;
+        const canvas = document.createElement('canvas');
+        canvas.style.cssText = 'width: ' + CELL_WIDTH + 'px; height: ' + CELL_HEIGHT + 'px; image-rendering: pixelated; cursor: pointer;';
+        canvas.title = 'seed ' + seed + ', intensity ' + intensity.toFixed(2);
+        grid.append(canvas);
+        const context = canvas.getContext('2d');
+        const colors = new Uint32Array(256);
+        let image = null;
+
+        const worker = new Worker(new URL('./variationworker.js', import.meta.url));
+        worker.onmessage = function(e) {
+            const msg = e.data;
+            if(msg.type === 'frame') {
+                if(!image || image.width !== msg.w || image.height !== msg.h) {
+                    canvas.width = msg.w;
+                    canvas.height = msg.h;
+                    image = context.createImageData(msg.w, msg.h);
+                }
+                // 0xAARRGGBB to the RGBA byte order of ImageData
+                for(let c = 0; c < 256; c++) {
+                    const color = msg.palette[c];
+                    colors[c] = 0xff000000 | ((color & 0xff) << 16) | (color & 0xff00) | ((color >> 16) & 0xff);
+                }
+                const out = new Uint32Array(image.data.buffer);
+                const pixels = msg.pixels;
+                for(let p = 0; p < pixels.length; p++) out[p] = colors[pixels[p]];
+                context.putImageData(image, 0, 0);
+            } else if(msg.type === 'state') {
+                if(!workers.length || !msg.bytes) return;
+                close();
+                onPick(msg.bytes, seed);
+            } else if(msg.type === 'error') {
+                canvas.title += ' (' + msg.error + ')';
+            }
+        };
+        const state = options.state.slice(0);
+        worker.postMessage({
+            type: 'start', build: options.build, full: options.full, file: options.file, idle: options.idle,
+            state: state, effect: options.effect, sync: options.sync, seed: seed, intensity: intensity,
+            frames: Math.max(1, Math.round(options.seconds * 60))
+        }, [state]);
+        canvas.addEventListener('click', () => worker.postMessage({ type: 'state' }));
+        workers.push(worker);
+    }
+
+    return { count: count, close: close };
+};
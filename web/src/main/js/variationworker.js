@@ -0,0 +1,82 @@
+// Variations grid instance (see variations.js): a core of its own, started from the main
+// session's save state with one chaos variant and played for a few seconds at real speed,
+// without input. Every drawn frame goes back as 8-bit pixel indices of the active area plus
+// its palette (clip.h), transferred; the state is sent on request until the worker ends.
+
+import { loadCore } from './core.js';
+import { streamRom } from './romstream.js';
+import { saveCoreState, loadCoreState } from './states.js';
+import { writeChaosCommand } from './chaosqueue.js';
+import { TICK_RENDER_LAST } from './power.js';
+
+const INFO_WORDS = 5;
+const PALETTE_SIZE = 256;
+// frames per step, one step every STEP_FRAMES / 60 s
+const STEP_FRAMES = 2;
+
+let gens = null;
+let timer = null;
+
+// the last drawn frame, cropped to its active area
+const sendFrame = function() {
+    const heap = gens.HEAPU8.buffer;
+    const info = new Int32Array(heap, gens._clip_info(), INFO_WORDS);
+    const pitch = gens._clip_pitch();
+    const source = new Uint8Array(heap, gens._clip_pixels(), pitch * gens._clip_lines());
+    const w = info[3];
+    const h = info[4];
+    const pixels = new Uint8Array(w * h);
+    for(let y = 0; y < h; y++) {
+        const start = (info[2] + y) * pitch + info[1];
+        pixels.set(source.subarray(start, start + w), y * w);
+    }
+    const palette = new Uint32Array(heap, gens._clip_info() + INFO_WORDS * 4, PALETTE_SIZE).slice();
+    self.postMessage({ type: 'frame', w: w, h: h, pixels: pixels, palette: palette }, [pixels.buffer, palette.buffer]);
+};
+
+// msg: { build, full, file, idle, state, effect, sync, seed, intensity, frames }
+const start = async function(msg) {
+    gens = await loadCore(msg.build, msg.full);
+    gens._init();
+    // same work for every variant, whatever the load
+    gens._governor_enable(0);
+    if(!await streamRom(gens, msg.file)) {
+        self.postMessage({ type: 'error', error: 'cannot load ' + msg.file.name });
+        return;
+    }
+    gens._set_idle_skip(msg.idle);
+    // no RGB conversion, the frames are sent as indices
+    gens._set_indexed_output(1);
+    gens._start();
+    if(!loadCoreState(gens, msg.state)) {
+        self.postMessage({ type: 'error', error: 'state not loaded' });
+        return;
+    }
+    gens._chaos_seed(msg.seed);
+    gens._clip_enable(1);
+    writeChaosCommand(gens.HEAPU8.buffer, gens._chaos_command_queue(), gens._chaos_command_queue_size(),
+        msg.effect, msg.sync, msg.intensity);
+    let left = msg.frames;
+    timer = setInterval(function() {
+        const frames = Math.min(STEP_FRAMES, left);
+        gens._tick_n(frames, TICK_RENDER_LAST);
+        // the audio is dropped
+        gens._sound();
+        sendFrame();
+        left -= frames;
+        if(!left) {
+            clearInterval(timer);
+            timer = null;
+        }
+    }, STEP_FRAMES * 1000 / 60);
+};
+
+self.onmessage = function(e) {
+    const msg = e.data;
+    if(msg.type === 'start') {
+        start(msg);
+    } else if(msg.type === 'state') {
+        const bytes = gens && saveCoreState(gens);
+        self.postMessage({ type: 'state', bytes: bytes }, bytes ? [bytes] : []);
+    }
+};
@@ -0,0 +1,424 @@
+// Worker-hosted emulator (index.js ?worker=1): runs genplus.wasm off the main thread and
+// renders into an OffscreenCanvas. Input, chaos key state and chaos commands arrive through
+// shared memory.
+// Frames are paced on AudioWorklet ring demand when audio is playing (see pacer.js),
+// otherwise against a 60Hz clock, so the display refresh rate does not change the game speed.
+// When behind, the missing frames are run in one tick_n() call and only the last is drawn.
+
+import { loadCore } from './core.js';
+import { createRingWriter, createRateConverter, AUDIO_EFFECT_LEVELS } from './audio.js';
+import { createAudioPacer } from './pacer.js';
+import { createGLPresenter, GL_INDEX_PITCH, GL_INDEX_LINES, GL_PALETTE_SIZE, GL_POST_LEVELS } from './glpresenter.js';
+import { createGPURenderer } from './gpurender.js';
+import { createCanvasPresenter, FRAME_WIDTH, FRAME_HEIGHT } from './presenter.js';
+import { moveChaosCommands } from './chaosqueue.js';
+import { drainCapture, finishCapture, CAPTURE_VGM, CAPTURE_WAV } from './capture.js';
+import { createClipRing } from './clip.js';
+import { enableJit } from './jit.js';
+import { createInputBlock, createLatencyMeter } from './input.js';
+import { uploadChaosBindings } from './chaosbind.js';
+import { saveCoreState, loadCoreState } from './states.js';
+import { openBackup } from './backup.js';
+import { openLearned } from './learned.js';
+import { streamRom } from './romstream.js';
+import { createUnderrunReporter, TELEMETRY_MISSED, QUALITY_LEVELS } from './telemetry.js';
+import { TICK_RENDER_LAST, TICK_RENDER_NONE } from './power.js';
+
+const SOUND_FREQUENCY = 44100;
+const FRAME_MS = 1000 / 60;
+const MAX_FRAMES_PER_STEP = 4;
+const TURBO_FRAMES = 8;
+// playback speed and audio mode (index.js applySpeed())
+let speed = 1;
+let speedTape = true;
+
+let gens;
+// init message (core build, jit, seed), kept for the full core
+let initMsg;
+let offscreen;
+// palette index output for the WebGL presenter
+let indexedOutput = 0;
+let presenter;
+// GPU compositing presenter (?renderer=gpu), attached to the core at each start
+let gpuRenderer = null;
+// pad bits written by the page (input.js), read by the core at the pad reads
+let inputBlock;
+let latencyMeter;
+let sharedChaos;
+// chaos binding table from the page (chaosbind.js) and the message of each binding
+let chaosBindTable = null;
+let chaosBindMessages = [];
+let audioPush = null;
+let reportUnderruns = null;
+let audioPacer = null;
+let audioRate = SOUND_FREQUENCY;
+// ring blocks of a session, whose core output stays at 44.1kHz (get_audio_rate())
+const rateConverter = createRateConverter();
+let audioLatencyFrames = 3;
+let running = false;
+// hidden page (index.js setBackground()): null, 'run' (nothing rendered or drawn) or 'pause';
+// step() stops rescheduling itself while paused ('parked') until the page is shown again
+let background = null;
+let parked = false;
+let turbo = false;
+let rewinding = false;
+// streams being captured (see capture.js), drained after every frame run
+let captureMask = 0;
+// frames drawn over the last seconds (clip.js), handed to the page on 'clip'
+let clip = null;
+// battery save of the running game (backup.js); no frame runs until it is back in the core
+let backup = null;
+let backupReady = false;
+// learned profile of the running game (learned.js), back in the core with the battery save
+let learned = null;
+
+// views into the core
+let frame;
+let audio_l;
+let audio_r;
+// audio output chaos effect levels (audio_* effects)
+let audioEffects;
+let chaosQueue;
+let chaosQueueSize;
+// dirty lines accumulated over the frames run since the last present
+const dirtyLines = new Uint8Array(FRAME_HEIGHT);
+
+// overlay
+let fps = 0;
+let frameCount = 0;
+let fpsTime = 0;
+let chaosMessage = '';
+let chaosMessageTimer = 0;
+
+let nextFrame = 0;
+
+// frame profile bar (CHAOS_PROFILE builds)
+let useProfile = false;
+let frameProfile = null;
+let profileNames = [];
+
+const cString = function(ptr) {
+    let str = '';
+    while(ptr && gens.HEAPU8[ptr]) str += String.fromCharCode(gens.HEAPU8[ptr++]);
+    return str;
+};
+
+const start = function() {
+    if(learned) learned.close();
+    gens._start();
+    if(clip) clip.close();
+    clip = gpuRenderer ? null : createClipRing(gens);
+    if(backup) backup.close();
+    const opened = backup = openBackup(gens);
+    learned = openLearned(gens);
+    backupReady = false;
+    Promise.all([backup.ready, learned.ready]).then(() => { if(backup === opened) backupReady = true; });
+    const heap = gens.HEAPU8.buffer;
+    const scale = initMsg.scale;
+    frame.vram = new Uint8ClampedArray(heap, gens._get_frame_buffer_ref(), FRAME_WIDTH * FRAME_HEIGHT * scale * scale * 4);
+    frame.coreDirtyLines = new Uint8Array(heap, gens._get_dirty_lines_ref(), FRAME_HEIGHT);
+    frame.frameInfo = new Int32Array(heap, gens._get_frame_info_ref(), 4);
+    frame.indexBuffer = new Uint8Array(heap, gens._get_index_buffer_ref(), GL_INDEX_PITCH * GL_INDEX_LINES);
+    frame.palette = new Uint8Array(heap, gens._get_palette_ref(), GL_PALETTE_SIZE * 4);
+    frame.postLevels = new Float32Array(heap, gens._chaos_post_params_ref(), GL_POST_LEVELS);
+    if(gpuRenderer) gpuRenderer.attach(gens);
+    audio_l = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_l_ref(), gens._get_web_audio_size());
+    audio_r = new Float32Array(gens.HEAPF32.buffer, gens._get_web_audio_r_ref(), gens._get_web_audio_size());
+    audioEffects = new Float32Array(gens.HEAPF32.buffer, gens._chaos_audio_out_params_ref(), AUDIO_EFFECT_LEVELS);
+    if(useProfile && gens._get_frame_profile_ref) {
+        profileNames = [];
+        for(let id = 0; id < gens._frame_profile_count(); id++) profileNames.push(cString(gens._frame_profile_name(id)));
+        frameProfile = new Float32Array(gens.HEAPF32.buffer, gens._get_frame_profile_ref(), profileNames.length + 2);
+    }
+    presenter.invalidate();
+    if(audioPush && !audioPacer) audioPacer = createAudioPacer(gens, audioPush, audioRate, audioLatencyFrames);
+    gens._set_audio_speed(speedTape ? speed : 1);
+    if(audioPacer) audioPacer.reset();
+    nextFrame = performance.now();
+    if(!running) {
+        running = true;
+        step();
+    }
+};
+
+// run 'count' frames in one core call, only the last one is rendered
+const runFrames = function(count) {
+    moveChaosCommands(sharedChaos, gens.HEAPU8.buffer, chaosQueue, chaosQueueSize);
+    gens._tick_n(count, background ? TICK_RENDER_NONE : TICK_RENDER_LAST);
+    if(clip && !background) clip.record();
+    const fired = gens._chaos_bind_take_fired();
+    if(fired >= 0) {
+        chaosMessage = chaosBindMessages[fired];
+        chaosMessageTimer = 120;
+    }
+    for(let i = 0; i < FRAME_HEIGHT; i++) dirtyLines[i] |= frame.coreDirtyLines[i];
+    const samples = gens._sound();
+    const quality = gens._governor_take_change();
+    if(quality >= 0) {
+        chaosMessage = 'Quality: ' + QUALITY_LEVELS[quality];
+        chaosMessageTimer = 120;
+    }
+    if(audioPush) {
+        const rate = gens._get_audio_rate();
+        if(rate === audioRate) audioPush(audio_l, audio_r, samples);
+        else audioPush(rateConverter.left, rateConverter.right, rateConverter.convert(audio_l, audio_r, samples, rate, audioRate));
+        audioPush.effects(audioEffects);
+        reportUnderruns(gens);
+    }
+    if(captureMask) postCapture();
+    backup.frames();
+    frameCount++;
+};
+
+// sealed capture chunks go to the page, which keeps the files
+const postCapture = function() {
+    for(const stream of [CAPTURE_VGM, CAPTURE_WAV]) {
+        if(!(captureMask & stream)) continue;
+        const parts = drainCapture(gens, stream);
+        if(parts.length) self.postMessage({ type: 'capture-data', stream: stream, parts: parts }, parts);
+    }
+};
+
+const present = function() {
+    presenter.draw({ vram: frame.vram, dirtyLines: dirtyLines, frameInfo: frame.frameInfo,
+        indexBuffer: frame.indexBuffer, palette: frame.palette, postLevels: frame.postLevels });
+    dirtyLines.fill(0);
+    latencyMeter.frame(gens._input_seen_take());
+    const now = performance.now();
+    if(now - fpsTime >= 1000) {
+        fps = frameCount;
+        frameCount = 0;
+        fpsTime = now;
+    }
+    presenter.overlay(fps, chaosMessageTimer > 0 ? chaosMessage : '');
+    if(frameProfile) presenter.profile(frameProfile, profileNames);
+    if(useProfile) presenter.latency(latencyMeter.average());
+    if(chaosMessageTimer > 0) chaosMessageTimer--;
+};
+
+const step = function() {
+    if(background === 'pause') {
+        parked = true;
+        return;
+    }
+    const now = performance.now();
+    let frames = 0;
+    // audio clock: keep the ring at the target latency while the worklet is consuming
+    // above 1x, the frames of a step but the last are run without being drawn
+    const expected = Math.ceil(speed);
+    const frameMs = FRAME_MS / speed;
+    const demand = audioPacer && !turbo ? audioPacer.frames(MAX_FRAMES_PER_STEP * expected) : -1;
+    if(turbo) {
+        frames = TURBO_FRAMES;
+        nextFrame = now + frameMs;
+    } else if(demand >= 0) {
+        frames = demand;
+        nextFrame = now + frameMs;
+    } else {
+        while(now >= nextFrame && frames < MAX_FRAMES_PER_STEP * expected) {
+            frames++;
+            nextFrame += frameMs;
+        }
+        // too far behind (tab hidden, long stall): resync instead of catching up
+        if(now - nextFrame > 100) nextFrame = now;
+        if(frames > expected) gens._telemetry_count(TELEMETRY_MISSED, frames - expected);
+    }
+    // frames behind are skipped (emulated but not drawn)
+    if(frames > 0 && backupReady) {
+        // rewinding: back one snapshot, then draw a single frame from it
+        if(rewinding) {
+            if(!gens._rewind_step()) {
+                chaosMessage = 'Rewind limit';
+                chaosMessageTimer = 120;
+            }
+            frames = 1;
+        }
+        runFrames(frames);
+        if(!background) present();
+    }
+    setTimeout(step, 2);
+};
+
+// set up a core instance as 'gens' (msg: the init message); the full core replaces the
+// default one when the ROM needs it
+const initCore = function(module, msg) {
+    gens = module;
+    gens._init();
+    if(msg.jit && !enableJit(gens)) console.warn('jit: not available in this build');
+    gens._governor_enable(msg.governor ? 1 : 0);
+    gens._governor_set_minimum(msg.power);
+    gens._chaos_seed(msg.seed);
+    gens.inputBits = inputBlock.bits;
+    gens.chaosKeys = inputBlock.keys;
+    gens._set_input_live(1);
+    chaosQueue = gens._chaos_command_queue();
+    chaosQueueSize = gens._chaos_command_queue_size();
+    if(chaosBindTable) uploadChaosBindings(gens, chaosBindTable);
+    if(audioPush) audioPacer = createAudioPacer(gens, audioPush, audioRate, audioLatencyFrames);
+};
+
+// streams 'file' into the core, into the full core when it needs the Mega CD or SVP hardware
+const loadRom = async function(file) {
+    const loaded = await streamRom(gens, file);
+    if(!loaded || !gens._rom_needs_full_core()) return loaded;
+    console.log('rom: ' + file.name + ' needs the full core');
+    try {
+        initCore(await loadCore(initMsg.build, true), initMsg);
+    } catch(error) {
+        console.warn('rom: ' + file.name + ',', error);
+        return false;
+    }
+    gens._set_indexed_output(indexedOutput);
+    gens._set_output_scale(initMsg.scale);
+    if(initMsg.lineCache) gens._set_line_cache(1);
+    return streamRom(gens, file);
+};
+
+self.onmessage = function(e) {
+    const msg = e.data;
+    switch(msg.type) {
+    case 'init':
+        inputBlock = createInputBlock(msg.input);
+        latencyMeter = createLatencyMeter(inputBlock);
+        sharedChaos = msg.chaos;
+        useProfile = msg.profile;
+        initMsg = msg;
+        loadCore(msg.build).then(function(module) {
+            initCore(module, msg);
+            offscreen = msg.canvas;
+            const context = offscreen.getContext('2d');
+            if(msg.gpu) gpuRenderer = createGPURenderer(msg.scale);
+            const glPresenter = msg.webgl ? createGLPresenter(msg.scale) : gpuRenderer;
+            indexedOutput = glPresenter ? 1 : 0;
+            gens._set_indexed_output(indexedOutput);
+            gens._set_output_scale(msg.scale);
+            if(msg.lineCache) gens._set_line_cache(1);
+            presenter = createCanvasPresenter(context, glPresenter, msg.scale);
+            frame = {};
+            const effects = [];
+            for(let id = 0; id < gens._chaos_effect_count(); id++) {
+                effects.push({ name: cString(gens._chaos_effect_name(id)),
+                    kind: gens._chaos_effect_kind(id), targets: gens._chaos_effect_targets(id) });
+            }
+            self.postMessage({ type: 'ready', effects: effects });
+        });
+        break;
+    case 'audio':
+        // latency in frames, the samples per frame come from the core; the pacer is created
+        // by start() when the core is not loaded yet
+        audioPush = createRingWriter(msg.ring);
+        reportUnderruns = createUnderrunReporter(audioPush.underruns);
+        audioRate = msg.rate;
+        audioLatencyFrames = msg.latency;
+        audioPacer = gens ? createAudioPacer(gens, audioPush, audioRate, audioLatencyFrames) : null;
+        break;
+    case 'rom':
+        loadRom(msg.file).then(function(loaded) {
+            if(!loaded) {
+                console.warn('rom: cannot load ' + msg.file.name);
+                return;
+            }
+            gens._set_idle_skip(msg.idle);
+            // the page's output rate, before start() sets up the resampler
+            gens._set_audio_rate(msg.rate, 0);
+            start();
+            self.postMessage({ type: 'started', crc: gens._get_rom_crc() });
+        });
+        break;
+    case 'idle':
+        gens._set_idle_skip(msg.mode);
+        break;
+    case 'ntsc':
+        gens._set_ntsc(msg.mode);
+        break;
+    case 'reset':
+        gens._soft_reset(msg.boot ? 1 : 0);
+        if(learned) learned.reset();
+        break;
+    case 'turbo':
+        turbo = msg.on;
+        break;
+    case 'speed':
+        speed = msg.speed;
+        speedTape = msg.tape;
+        if(gens) gens._set_audio_speed(speedTape ? speed : 1);
+        if(audioPacer) audioPacer.reset();
+        break;
+    case 'power':
+        initMsg.power = msg.level;
+        if(gens) gens._governor_set_minimum(msg.level);
+        break;
+    case 'background':
+        background = msg.state;
+        if(background) break;
+        // shown again: the clocks restart from now, nothing hidden is caught up
+        nextFrame = fpsTime = performance.now();
+        frameCount = 0;
+        if(audioPacer) audioPacer.reset();
+        if(presenter) presenter.invalidate();
+        if(parked) {
+            parked = false;
+            step();
+        }
+        break;
+    case 'rewind':
+        rewinding = msg.on;
+        break;
+    case 'checkpoint':
+        gens._chaos_checkpoint();
+        break;
+    case 'restore':
+        gens._chaos_restore();
+        break;
+    case 'undo':
+        gens._chaos_undo(1);
+        break;
+    case 'state-save': {
+        // serialized here between two steps, compressed and stored from the page (states.js)
+        const bytes = saveCoreState(gens);
+        self.postMessage({ type: 'state', slot: msg.slot, crc: gens._get_rom_crc(), bytes: bytes }, bytes ? [bytes] : []);
+        break;
+    }
+    case 'state-load':
+        self.postMessage({ type: 'state-loaded', slot: msg.slot, loaded: loadCoreState(gens, msg.bytes) });
+        break;
+    case 'bindings':
+        // sent once the page has the registry, so the core is loaded
+        chaosBindTable = msg.table;
+        chaosBindMessages = msg.messages;
+        uploadChaosBindings(gens, chaosBindTable);
+        break;
+    case 'message':
+        chaosMessage = msg.text;
+        chaosMessageTimer = 120;
+        break;
+    case 'capture':
+        if(msg.streams) {
+            captureMask = gens._capture_start(msg.streams);
+        } else if(captureMask) {
+            gens._capture_stop();
+            postCapture();
+            for(const stream of [CAPTURE_VGM, CAPTURE_WAV]) {
+                if(captureMask & stream) self.postMessage({ type: 'capture-end', stream: stream, end: finishCapture(gens, stream) });
+            }
+            captureMask = 0;
+        }
+        break;
+    case 'backup-flush':
+        if(backup) backup.flush();
+        if(learned) learned.flush();
+        break;
+    case 'clip': {
+        if(!clip) break;
+        // encoded by the page's clip worker, not here between two frames
+        const taken = clip.take();
+        self.postMessage({ type: 'clip', frames: taken.frames, buffers: taken.buffers }, taken.buffers);
+        break;
+    }
+    case 'screenshot':
+        offscreen.convertToBlob({ type: 'image/png' }).then(function(blob) {
+            self.postMessage({ type: 'screenshot', blob: blob });
+        });
+        break;
+    }
+};
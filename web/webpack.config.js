@@ -1,9 +1,16 @@
+const fs = require('fs');
 const path = require('path');
 const HtmlWebpackPlugin = require('html-webpack-plugin')
 const webpack = require('webpack');
 
+// common configuration, built with webpack.dev.js (dev server) or webpack.prod.js (docs/)
+
+// the .wasm core.js will load by default, preloaded by index.html so its download starts
+// while the page is parsed (see core.js)
+const coreWasm = fs.existsSync(path.join(__dirname, 'src/main/js/genplus_fast.wasm')) ? // eslint-disable-line
+    'genplus_fast.wasm' : 'genplus.wasm';
+
 module.exports = {
-    mode: 'development',
     entry: {
         index: './src/main/js/index.js',
     },
@@ -13,7 +20,10 @@ module.exports = {
     },
     plugins: [
         new HtmlWebpackPlugin({
-            template: './src/main/html/index.html'
+            template: './src/main/html/index.html',
+            templateParameters: {
+                coreWasm: coreWasm
+            }
         }),
         new webpack.EnvironmentPlugin({
             'ROM_PATH': 'rom/sonic2.bin',
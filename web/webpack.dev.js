@@ -4,6 +4,7 @@ const common = require('./webpack.config.js');
 const process = require('process');
 
 module.exports = merge(common, {
+    mode: 'development',
     devtool: 'source-map',
     devServer: {
         static: [
@@ -12,6 +13,11 @@ module.exports = merge(common, {
             path.join(__dirname, '/'), // eslint-disable-line
         ],
         port: process.env['PORT'],
+        // cross-origin isolation enables SharedArrayBuffer (AudioWorklet shared ring)
+        headers: {
+            'Cross-Origin-Opener-Policy': 'same-origin',
+            'Cross-Origin-Embedder-Policy': 'require-corp'
+        },
         open: true,
         // host: '0.0.0.0',
         // disableHostCheck: true
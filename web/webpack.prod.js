@@ -0,0 +1,11 @@
+const { merge } = require('webpack-merge');
+const common = require('./webpack.config.js');
+
+// docs/ build (deploy.sh): minified bundle, no source maps
+module.exports = merge(common, {
+    mode: 'production',
+    devtool: false,
+    optimization: {
+        minimize: true
+    }
+});